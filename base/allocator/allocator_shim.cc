@@ -8,6 +8,7 @@
 
 #include <new>
 
+#include "base/allocator/buildflags.h"
 #include "base/atomicops.h"
 #include "base/bits.h"
 #include "base/logging.h"
@@ -347,10 +348,10 @@ ALWAYS_INLINE void ShimAlignedFree(void* address, void* context) {
 #include "base/allocator/allocator_shim_override_libc_symbols.h"
 #endif
 
-// In the case of tcmalloc we also want to plumb into the glibc hooks
-// to avoid that allocations made in glibc itself (e.g., strdup()) get
-// accidentally performed on the glibc heap instead of the tcmalloc one.
-#if defined(USE_TCMALLOC)
+// In the case of tcmalloc (or PartitionAlloc) we also want to plumb into the
+// glibc hooks to avoid that allocations made in glibc itself (e.g., strdup())
+// get accidentally performed on the glibc heap instead of the tcmalloc one.
+#if defined(USE_TCMALLOC) || BUILDFLAG(USE_PARTITION_ALLOC_AS_MALLOC)
 #include "base/allocator/allocator_shim_override_glibc_weak_symbols.h"
 #endif
 
@@ -0,0 +1,176 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/allocator/allocator_shim_default_dispatch_to_partition_alloc.h"
+
+#include <pthread.h>
+
+#include <algorithm>
+
+#include "base/allocator/allocator_shim_internals.h"
+#include "base/allocator/partition_allocator/partition_alloc.h"
+#include "base/bits.h"
+#include "base/logging.h"
+#include "base/no_destructor.h"
+#include "base/numerics/checked_math.h"
+
+// This translation unit defines a default dispatch for the allocator shim which
+// routes allocations to a dedicated PartitionAlloc partition.
+//
+// Nothing here may allocate through malloc(): it would re-enter the shim.
+
+namespace {
+
+using base::allocator::AllocatorDispatch;
+
+// Like glibc on 64-bit platforms, malloc() returns memory aligned for any
+// fundamental type. Slots of a size multiple of this are aligned to it, since
+// each order of buckets has a bucket for every such size.
+constexpr size_t kMallocAlignment = 2 * sizeof(void*);
+
+// The partition is used by all threads, which don't get a thread cache: it
+// would allocate its storage, and its thread-local slot, through malloc().
+class MallocPartition {
+ public:
+  MallocPartition() {
+    allocator_.init();
+    // A fork() while another thread holds the partition lock would leave it
+    // held forever in the child, so the forking thread holds it across fork(),
+    // like glibc does with its arenas. glibc registers the first handlers
+    // without allocating, so this doesn't re-enter malloc(). Handlers
+    // registered later run before these ones, and may still allocate.
+    root_for_fork_ = allocator_.root();
+    int result = pthread_atfork(&LockBeforeFork, &UnlockAfterFork,
+                                &UnlockAfterFork);
+    CHECK_EQ(0, result);
+  }
+
+  base::PartitionRootGeneric* root() { return allocator_.root(); }
+
+ private:
+  static void LockBeforeFork() { root_for_fork_->lock.lock(); }
+  // The lock has no owner, so the child can release it like the parent.
+  static void UnlockAfterFork() { root_for_fork_->lock.unlock(); }
+
+  static base::PartitionRootGeneric* root_for_fork_;
+
+  base::PartitionAllocatorGeneric allocator_;
+};
+
+base::PartitionRootGeneric* MallocPartition::root_for_fork_ = nullptr;
+
+size_t MallocSize(size_t size) {
+  // Aligning the largest sizes would overflow. They can't be allocated in any
+  // case.
+  if (size > base::kGenericMaxDirectMapped)
+    return size;
+  // malloc(0) would otherwise get a slot from the smallest bucket.
+  return base::bits::Align(std::max(size, size_t{1}), kMallocAlignment);
+}
+
+}  // namespace
+
+namespace base {
+namespace internal {
+
+// static
+PartitionRootGeneric* PartitionAllocMalloc::Allocator() {
+  // Function-local statics don't allocate, and neither does the partition's
+  // initialization.
+  static NoDestructor<MallocPartition> partition;
+  return partition->root();
+}
+
+void* PartitionMalloc(const AllocatorDispatch*, size_t size, void* context) {
+  return PartitionAllocGenericFlags(PartitionAllocMalloc::Allocator(),
+                                    PartitionAllocReturnNull, MallocSize(size),
+                                    nullptr);
+}
+
+void* PartitionCalloc(const AllocatorDispatch*,
+                      size_t n,
+                      size_t size,
+                      void* context) {
+  size_t total;
+  if (!CheckMul(n, size).AssignIfValid(&total))
+    return nullptr;
+  return PartitionAllocGenericFlags(
+      PartitionAllocMalloc::Allocator(),
+      PartitionAllocReturnNull | PartitionAllocZeroFill, MallocSize(total),
+      nullptr);
+}
+
+void* PartitionMemalign(const AllocatorDispatch*,
+                        size_t alignment,
+                        size_t size,
+                        void* context) {
+  // PartitionAlloc has no aligned allocation primitive. Instead, this relies
+  // on slot spans and direct mappings starting at a partition page boundary:
+  // slots whose size is a power of two are then aligned to their size, up to
+  // kPartitionPageSize, and direct mapped allocations to kPartitionPageSize.
+  DCHECK(bits::IsPowerOfTwo(alignment));
+  if (alignment > kPartitionPageSize)
+    return nullptr;
+  if (size <= kGenericMaxBucketed && alignment > kMallocAlignment) {
+    size = std::max(size, alignment);
+    size = size_t{1} << bits::Log2Ceiling(static_cast<uint32_t>(size));
+  }
+  return PartitionAllocGenericFlags(PartitionAllocMalloc::Allocator(),
+                                    PartitionAllocReturnNull, MallocSize(size),
+                                    nullptr);
+}
+
+void* PartitionRealloc(const AllocatorDispatch*,
+                       void* address,
+                       size_t size,
+                       void* context) {
+  // Like glibc, realloc(address, 0) frees |address| and returns nullptr.
+  return PartitionReallocGenericFlags(PartitionAllocMalloc::Allocator(),
+                                      PartitionAllocReturnNull, address,
+                                      size ? MallocSize(size) : 0, nullptr);
+}
+
+void PartitionFree(const AllocatorDispatch*, void* address, void* context) {
+  PartitionAllocMalloc::Allocator()->Free(address);
+}
+
+size_t PartitionGetSizeEstimate(const AllocatorDispatch*,
+                                void* address,
+                                void* context) {
+  if (!address)
+    return 0;
+  return PartitionAllocGetSize(address);
+}
+
+}  // namespace internal
+}  // namespace base
+
+const AllocatorDispatch AllocatorDispatch::default_dispatch = {
+    &internal::PartitionMalloc,          /* alloc_function */
+    &internal::PartitionCalloc,          /* alloc_zero_initialized_function */
+    &internal::PartitionMemalign,        /* alloc_aligned_function */
+    &internal::PartitionRealloc,         /* realloc_function */
+    &internal::PartitionFree,            /* free_function */
+    &internal::PartitionGetSizeEstimate, /* get_size_estimate_function */
+    nullptr,                             /* batch_malloc_function */
+    nullptr,                             /* batch_free_function */
+    nullptr,                             /* free_definite_size_function */
+    nullptr,                             /* aligned_malloc_function */
+    nullptr,                             /* aligned_realloc_function */
+    nullptr,                             /* aligned_free_function */
+    nullptr,                             /* next */
+};
+
+// glibc's malloc_usable_size() can't handle PartitionAlloc's pointers. The
+// other diagnostic symbols (mallinfo() & co) are left to glibc, and only
+// describe its own, mostly unused, heap. See MallocDumpProvider for the
+// partition's statistics.
+
+extern "C" {
+
+SHIM_ALWAYS_EXPORT size_t malloc_usable_size(void* address) __THROW {
+  return base::internal::PartitionGetSizeEstimate(nullptr, address, nullptr);
+}
+
+}  // extern "C"
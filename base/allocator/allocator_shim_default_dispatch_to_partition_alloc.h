@@ -0,0 +1,57 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef BASE_ALLOCATOR_ALLOCATOR_SHIM_DEFAULT_DISPATCH_TO_PARTITION_ALLOC_H_
+#define BASE_ALLOCATOR_ALLOCATOR_SHIM_DEFAULT_DISPATCH_TO_PARTITION_ALLOC_H_
+
+#include <stddef.h>
+
+#include "base/allocator/allocator_shim.h"
+#include "base/base_export.h"
+
+namespace base {
+
+struct PartitionRootGeneric;
+
+namespace internal {
+
+class BASE_EXPORT PartitionAllocMalloc {
+ public:
+  // Returns the partition backing malloc(), initializing it on first use.
+  static PartitionRootGeneric* Allocator();
+};
+
+// The functions of AllocatorDispatch::default_dispatch, exposed for testing.
+BASE_EXPORT void* PartitionMalloc(const allocator::AllocatorDispatch*,
+                                  size_t size,
+                                  void* context);
+
+BASE_EXPORT void* PartitionCalloc(const allocator::AllocatorDispatch*,
+                                  size_t n,
+                                  size_t size,
+                                  void* context);
+
+BASE_EXPORT void* PartitionMemalign(const allocator::AllocatorDispatch*,
+                                    size_t alignment,
+                                    size_t size,
+                                    void* context);
+
+BASE_EXPORT void* PartitionRealloc(const allocator::AllocatorDispatch*,
+                                   void* address,
+                                   size_t size,
+                                   void* context);
+
+BASE_EXPORT void PartitionFree(const allocator::AllocatorDispatch*,
+                               void* address,
+                               void* context);
+
+BASE_EXPORT size_t
+PartitionGetSizeEstimate(const allocator::AllocatorDispatch*,
+                         void* address,
+                         void* context);
+
+}  // namespace internal
+}  // namespace base
+
+#endif  // BASE_ALLOCATOR_ALLOCATOR_SHIM_DEFAULT_DISPATCH_TO_PARTITION_ALLOC_H_
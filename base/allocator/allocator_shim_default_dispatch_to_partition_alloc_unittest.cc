@@ -0,0 +1,164 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/allocator/allocator_shim_default_dispatch_to_partition_alloc.h"
+
+#include <stdint.h>
+#include <string.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <limits>
+
+#include "base/allocator/partition_allocator/partition_alloc.h"
+#include "base/posix/eintr_wrapper.h"
+#include "base/threading/platform_thread.h"
+#include "base/time/time.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace base {
+namespace internal {
+
+namespace {
+
+bool IsAligned(void* ptr, size_t alignment) {
+  return !(reinterpret_cast<uintptr_t>(ptr) & (alignment - 1));
+}
+
+}  // namespace
+
+TEST(PartitionAllocAsMallocTest, Malloc) {
+  for (size_t size = 0; size < 1000; ++size) {
+    void* ptr = PartitionMalloc(nullptr, size, nullptr);
+    ASSERT_TRUE(ptr);
+    // Like glibc's.
+    EXPECT_TRUE(IsAligned(ptr, 2 * sizeof(void*))) << size;
+    EXPECT_GE(PartitionGetSizeEstimate(nullptr, ptr, nullptr), size);
+    memset(ptr, 0xbd, size);
+    PartitionFree(nullptr, ptr, nullptr);
+  }
+  EXPECT_EQ(0u, PartitionGetSizeEstimate(nullptr, nullptr, nullptr));
+}
+
+TEST(PartitionAllocAsMallocTest, MallocTooLarge) {
+  EXPECT_FALSE(
+      PartitionMalloc(nullptr, std::numeric_limits<size_t>::max(), nullptr));
+}
+
+TEST(PartitionAllocAsMallocTest, Calloc) {
+  constexpr size_t kSize = 4000;
+  char* ptr = static_cast<char*>(PartitionCalloc(nullptr, 4, kSize, nullptr));
+  ASSERT_TRUE(ptr);
+  for (size_t i = 0; i < 4 * kSize; ++i)
+    ASSERT_EQ(0, ptr[i]);
+  PartitionFree(nullptr, ptr, nullptr);
+
+  // The size overflows.
+  EXPECT_FALSE(PartitionCalloc(nullptr, std::numeric_limits<size_t>::max(), 2,
+                               nullptr));
+}
+
+TEST(PartitionAllocAsMallocTest, Memalign) {
+  for (size_t alignment = 1; alignment <= kPartitionPageSize; alignment <<= 1) {
+    for (size_t size : {size_t{1}, alignment - 1, alignment, alignment + 1,
+                        size_t{100000}, kGenericMaxBucketed + 1}) {
+      void* ptr = PartitionMemalign(nullptr, alignment, size, nullptr);
+      ASSERT_TRUE(ptr);
+      EXPECT_TRUE(IsAligned(ptr, alignment))
+          << "alignment: " << alignment << " size: " << size;
+      memset(ptr, 0xbd, size);
+      PartitionFree(nullptr, ptr, nullptr);
+    }
+  }
+  EXPECT_FALSE(PartitionMemalign(nullptr, 2 * kPartitionPageSize, 1, nullptr));
+}
+
+TEST(PartitionAllocAsMallocTest, Realloc) {
+  char* ptr =
+      static_cast<char*>(PartitionRealloc(nullptr, nullptr, 10, nullptr));
+  ASSERT_TRUE(ptr);
+  memset(ptr, 'a', 10);
+
+  ptr = static_cast<char*>(PartitionRealloc(nullptr, ptr, 100000, nullptr));
+  ASSERT_TRUE(ptr);
+  EXPECT_TRUE(IsAligned(ptr, 2 * sizeof(void*)));
+  for (size_t i = 0; i < 10; ++i)
+    EXPECT_EQ('a', ptr[i]);
+
+  EXPECT_FALSE(PartitionRealloc(nullptr, ptr, 0, nullptr));
+}
+
+TEST(PartitionAllocAsMallocTest, DumpStats) {
+  class TotalsDumper : public PartitionStatsDumper {
+   public:
+    void PartitionDumpTotals(const char* partition_name,
+                             const PartitionMemoryStats* stats) override {
+      active_bytes = stats->total_active_bytes;
+    }
+    void PartitionsDumpBucketStats(
+        const char* partition_name,
+        const PartitionBucketMemoryStats* bucket_stats) override {}
+
+    size_t active_bytes = 0;
+  };
+
+  // Direct mapped allocations don't count as active bytes.
+  constexpr size_t kSize = 100000;
+  TotalsDumper before;
+  PartitionAllocMalloc::Allocator()->DumpStats(
+      "malloc", true /* is_light_dump */, &before);
+  void* ptr = PartitionMalloc(nullptr, kSize, nullptr);
+  TotalsDumper during;
+  PartitionAllocMalloc::Allocator()->DumpStats(
+      "malloc", true /* is_light_dump */, &during);
+  EXPECT_GE(during.active_bytes, before.active_bytes + kSize);
+  PartitionFree(nullptr, ptr, nullptr);
+}
+
+TEST(PartitionAllocAsMallocTest, ForkWhileLockIsHeld) {
+  // Holds the partition lock for a while on another thread.
+  class LockHolder : public PlatformThread::Delegate {
+   public:
+    void ThreadMain() override {
+      PartitionAllocMalloc::Allocator()->lock.lock();
+      locked.store(true);
+      PlatformThread::Sleep(TimeDelta::FromMilliseconds(100));
+      PartitionAllocMalloc::Allocator()->lock.unlock();
+    }
+
+    std::atomic<bool> locked{false};
+  };
+
+  LockHolder lock_holder;
+  PlatformThreadHandle handle;
+  ASSERT_TRUE(PlatformThread::Create(0, &lock_holder, &handle));
+  while (!lock_holder.locked.load())
+    PlatformThread::YieldCurrentThread();
+
+  // fork() waits for the lock, so the child gets it released.
+  pid_t pid = fork();
+  ASSERT_NE(-1, pid);
+  if (!pid) {
+    // Ends the child with SIGALRM if it deadlocks.
+    alarm(10);
+    void* ptr = PartitionMalloc(nullptr, 16, nullptr);
+    PartitionFree(nullptr, ptr, nullptr);
+    _exit(ptr ? 0 : 1);
+  }
+
+  int status;
+  ASSERT_EQ(pid, HANDLE_EINTR(waitpid(pid, &status, 0)));
+  EXPECT_TRUE(WIFEXITED(status));
+  EXPECT_EQ(0, WEXITSTATUS(status));
+  PlatformThread::Join(handle);
+
+  // The parent can still allocate.
+  void* ptr = PartitionMalloc(nullptr, 16, nullptr);
+  EXPECT_TRUE(ptr);
+  PartitionFree(nullptr, ptr, nullptr);
+}
+
+}  // namespace internal
+}  // namespace base
@@ -53,7 +53,19 @@ internal::PartitionRootBase::~PartitionRootBase() = default;
 PartitionRoot::PartitionRoot() = default;
 PartitionRoot::~PartitionRoot() = default;
 PartitionRootGeneric::PartitionRootGeneric() = default;
-PartitionRootGeneric::~PartitionRootGeneric() = default;
+PartitionRootGeneric::~PartitionRootGeneric() {
+  if (!with_thread_cache)
+    return;
+  // Freeing the slot first guarantees that exiting threads don't access their
+  // cache anymore. The slots cached by other threads stay allocated.
+  thread_cache_slot.reset();
+  subtle::SpinLock::Guard guard(this->lock);
+  while (internal::PartitionThreadCache* cache = thread_caches) {
+    thread_caches = cache->next_;
+    delete cache;
+  }
+}
+
 PartitionAllocatorGeneric::PartitionAllocatorGeneric() = default;
 PartitionAllocatorGeneric::~PartitionAllocatorGeneric() = default;
 
@@ -192,6 +204,46 @@ void PartitionRootGeneric::Init() {
   *bucket_ptr = internal::PartitionBucket::get_sentinel_bucket();
 }
 
+void PartitionRootGeneric::EnableThreadCache() {
+  DCHECK(this->initialized);
+  DCHECK(!with_thread_cache);
+  thread_cache_slot =
+      std::make_unique<ThreadLocalStorage::Slot>(&OnThreadCacheOwnerExit);
+  with_thread_cache = true;
+}
+
+internal::PartitionThreadCache* PartitionRootGeneric::CreateThreadCache() {
+  internal::PartitionThreadCache* cache =
+      new internal::PartitionThreadCache(this);
+  {
+    subtle::SpinLock::Guard guard(this->lock);
+    cache->next_ = thread_caches;
+    if (thread_caches)
+      thread_caches->prev_ = cache;
+    thread_caches = cache;
+  }
+  thread_cache_slot->Set(cache);
+  return cache;
+}
+
+// static
+void PartitionRootGeneric::OnThreadCacheOwnerExit(void* thread_cache) {
+  internal::PartitionThreadCache* cache =
+      static_cast<internal::PartitionThreadCache*>(thread_cache);
+  PartitionRootGeneric* root = cache->root_;
+  {
+    subtle::SpinLock::Guard guard(root->lock);
+    cache->FlushAllLocked();
+    if (cache->prev_)
+      cache->prev_->next_ = cache->next_;
+    else
+      root->thread_caches = cache->next_;
+    if (cache->next_)
+      cache->next_->prev_ = cache->prev_;
+  }
+  delete cache;
+}
+
 bool PartitionReallocDirectMappedInPlace(PartitionRootGeneric* root,
                                          internal::PartitionPage* page,
                                          size_t raw_size) {
@@ -507,6 +559,17 @@ void PartitionRoot::PurgeMemory(int flags) {
 
 void PartitionRootGeneric::PurgeMemory(int flags) {
   subtle::SpinLock::Guard guard(this->lock);
+  if (with_thread_cache) {
+    // Drained slots may leave pages empty, so do this first.
+    for (internal::PartitionThreadCache* cache = thread_caches; cache;
+         cache = cache->next_) {
+      cache->RequestPurgeLocked();
+    }
+    internal::PartitionThreadCache* current_thread_cache =
+        static_cast<internal::PartitionThreadCache*>(thread_cache_slot->Get());
+    if (current_thread_cache)
+      current_thread_cache->FlushAllLocked();
+  }
   if (flags & PartitionPurgeDecommitEmptyPages)
     DecommitEmptyPages();
   if (flags & PartitionPurgeDiscardUnusedSystemPages) {
@@ -63,12 +63,15 @@
 #include <limits.h>
 #include <string.h>
 
+#include <memory>
+
 #include "base/allocator/partition_allocator/page_allocator.h"
 #include "base/allocator/partition_allocator/partition_alloc_constants.h"
 #include "base/allocator/partition_allocator/partition_bucket.h"
 #include "base/allocator/partition_allocator/partition_cookie.h"
 #include "base/allocator/partition_allocator/partition_page.h"
 #include "base/allocator/partition_allocator/partition_root_base.h"
+#include "base/allocator/partition_allocator/partition_thread_cache.h"
 #include "base/allocator/partition_allocator/spin_lock.h"
 #include "base/base_export.h"
 #include "base/bits.h"
@@ -76,6 +79,7 @@
 #include "base/logging.h"
 #include "base/stl_util.h"
 #include "base/sys_byteorder.h"
+#include "base/threading/thread_local_storage.h"
 #include "build/build_config.h"
 
 #if defined(MEMORY_TOOL_REPLACES_ALLOCATOR)
@@ -141,10 +145,23 @@ struct BASE_EXPORT PartitionRootGeneric : public internal::PartitionRootBase {
       bucket_lookups[((kBitsPerSizeT + 1) * kGenericNumBucketsPerOrder) + 1] =
           {};
   internal::PartitionBucket buckets[kGenericNumBuckets] = {};
+  // Set by EnableThreadCache().
+  bool with_thread_cache = false;
+  std::unique_ptr<ThreadLocalStorage::Slot> thread_cache_slot;
+  // All the thread caches of this partition, guarded by |lock|.
+  internal::PartitionThreadCache* thread_caches = nullptr;
 
   // Public API.
   void Init();
 
+  // Makes each thread keep a cache of free small slots in front of the
+  // buckets, so that most allocations and frees don't take |lock|. Must be
+  // called after Init(), before the partition is used by multiple threads.
+  // Cached slots are returned to the partition when their thread exits, or
+  // by PurgeMemory(). The partition must outlive the threads which use it,
+  // other than the one destroying it.
+  void EnableThreadCache();
+
   ALWAYS_INLINE void* Alloc(size_t size, const char* type_name);
   ALWAYS_INLINE void* AllocFlags(int flags, size_t size, const char* type_name);
   ALWAYS_INLINE void Free(void* ptr);
@@ -156,11 +173,23 @@ struct BASE_EXPORT PartitionRootGeneric : public internal::PartitionRootBase {
 
   ALWAYS_INLINE size_t ActualSize(size_t size);
 
+  // Also drains the thread cache of the calling thread, and makes the other
+  // threads drain theirs the next time they allocate or free.
   void PurgeMemory(int flags);
 
   void DumpStats(const char* partition_name,
                  bool is_light_dump,
                  PartitionStatsDumper* partition_stats_dumper);
+
+  // Returns the thread cache of the calling thread, creating it if needed.
+  // Requires |with_thread_cache|.
+  ALWAYS_INLINE internal::PartitionThreadCache* GetThreadCache();
+  ALWAYS_INLINE size_t BucketIndex(const internal::PartitionBucket* bucket);
+
+ private:
+  NOINLINE internal::PartitionThreadCache* CreateThreadCache();
+  // TLS destructor of |thread_cache_slot|.
+  static void OnThreadCacheOwnerExit(void* thread_cache);
 };
 
 // Struct used to retrieve total memory usage of a partition. Used by
@@ -368,7 +397,11 @@ ALWAYS_INLINE void* PartitionAllocGenericFlags(PartitionRootGeneric* root,
   size = internal::PartitionCookieSizeAdjustAdd(size);
   internal::PartitionBucket* bucket = PartitionGenericSizeToBucket(root, size);
   void* ret = nullptr;
-  {
+  if (root->with_thread_cache &&
+      internal::PartitionThreadCache::IsCacheable(bucket)) {
+    ret = root->GetThreadCache()->Alloc(root->BucketIndex(bucket), bucket,
+                                        flags, size);
+  } else {
     subtle::SpinLock::Guard guard(root->lock);
     ret = root->AllocFromBucket(bucket, flags, size);
   }
@@ -403,6 +436,11 @@ ALWAYS_INLINE void PartitionRootGeneric::Free(void* ptr) {
   internal::PartitionPage* page = internal::PartitionPage::FromPointer(ptr);
   // TODO(palmer): See if we can afford to make this a CHECK.
   DCHECK(IsValidPage(page));
+  if (with_thread_cache &&
+      internal::PartitionThreadCache::IsCacheable(page->bucket)) {
+    GetThreadCache()->Free(BucketIndex(page->bucket), page->bucket, ptr);
+    return;
+  }
   {
     subtle::SpinLock::Guard guard(this->lock);
     page->Free(ptr);
@@ -410,6 +448,22 @@ ALWAYS_INLINE void PartitionRootGeneric::Free(void* ptr) {
 #endif
 }
 
+ALWAYS_INLINE internal::PartitionThreadCache*
+PartitionRootGeneric::GetThreadCache() {
+  DCHECK(with_thread_cache);
+  internal::PartitionThreadCache* cache =
+      static_cast<internal::PartitionThreadCache*>(thread_cache_slot->Get());
+  if (LIKELY(cache))
+    return cache;
+  return CreateThreadCache();
+}
+
+ALWAYS_INLINE size_t
+PartitionRootGeneric::BucketIndex(const internal::PartitionBucket* bucket) {
+  DCHECK(bucket >= buckets && bucket < buckets + kGenericNumBuckets);
+  return static_cast<size_t>(bucket - buckets);
+}
+
 BASE_EXPORT void* PartitionReallocGenericFlags(PartitionRootGeneric* root,
                                                int flags,
                                                void* ptr,
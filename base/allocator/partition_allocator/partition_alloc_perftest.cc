@@ -2,8 +2,12 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include <memory>
+#include <string>
 #include <vector>
 #include "base/allocator/partition_allocator/partition_alloc.h"
+#include "base/strings/stringprintf.h"
+#include "base/threading/platform_thread.h"
 #include "base/time/time.h"
 #include "base/timer/lap_timer.h"
 
@@ -27,6 +31,8 @@ constexpr int kMultiBucketMinimumSize = 24;
 constexpr int kMultiBucketIncrement = 13;
 // Final size is 24 + (13 * 22) = 310 bytes.
 constexpr int kMultiBucketRounds = 22;
+// Number of multi-bucket rounds done by each thread of a multi-threaded test.
+constexpr int kMultiThreadedIterations = 20000;
 
 class MemoryAllocationPerfTest : public testing::Test {
  public:
@@ -165,6 +171,81 @@ TEST_F(MemoryAllocationPerfTest, MultiBucketWithFree) {
       timer_.LapsPerSecond() * kMultiBucketRounds, "runs/s", true);
 }
 
+// Repeatedly allocates and frees one object per multi-bucket size.
+class MultiBucketAllocatingThread : public PlatformThread::Delegate {
+ public:
+  explicit MultiBucketAllocatingThread(PartitionRootGeneric* root)
+      : root_(root) {}
+
+  void ThreadMain() override {
+    void* ptrs[kMultiBucketRounds];
+    for (int iteration = 0; iteration < kMultiThreadedIterations;
+         ++iteration) {
+      for (int i = 0; i < kMultiBucketRounds; i++) {
+        ptrs[i] = root_->Alloc(
+            kMultiBucketMinimumSize + (i * kMultiBucketIncrement), "<testing>");
+        CHECK_NE(ptrs[i], nullptr);
+      }
+      for (int i = 0; i < kMultiBucketRounds; i++)
+        root_->Free(ptrs[i]);
+    }
+  }
+
+ private:
+  PartitionRootGeneric* const root_;
+};
+
+void RunMultiThreadedTest(PartitionRootGeneric* root,
+                          int num_threads,
+                          bool with_thread_cache) {
+  if (with_thread_cache)
+    root->EnableThreadCache();
+
+  std::vector<std::unique_ptr<MultiBucketAllocatingThread>> delegates;
+  std::vector<PlatformThreadHandle> handles(num_threads);
+  const TimeTicks start = TimeTicks::Now();
+  for (int i = 0; i < num_threads; i++) {
+    delegates.push_back(std::make_unique<MultiBucketAllocatingThread>(root));
+    ASSERT_TRUE(PlatformThread::Create(0, delegates.back().get(), &handles[i]));
+  }
+  for (PlatformThreadHandle& handle : handles)
+    PlatformThread::Join(handle);
+  const TimeDelta elapsed = TimeTicks::Now() - start;
+
+  const double num_allocations = static_cast<double>(num_threads) *
+                                 kMultiThreadedIterations * kMultiBucketRounds;
+  perf_test::PrintResult(
+      "MemoryAllocationPerfTest",
+      StringPrintf(" multi-bucket allocation + free, %d threads%s", num_threads,
+                   with_thread_cache ? ", thread cache" : ""),
+      "", num_allocations / elapsed.InSecondsF(), "runs/s", true);
+}
+
+TEST_F(MemoryAllocationPerfTest, MultiBucketWithFreeOneThread) {
+  RunMultiThreadedTest(alloc_.root(), 1, false);
+}
+
+TEST_F(MemoryAllocationPerfTest, MultiBucketWithFreeOneThreadThreadCache) {
+  RunMultiThreadedTest(alloc_.root(), 1, true);
+}
+
+TEST_F(MemoryAllocationPerfTest, MultiBucketWithFreeFourThreads) {
+  RunMultiThreadedTest(alloc_.root(), 4, false);
+}
+
+TEST_F(MemoryAllocationPerfTest, MultiBucketWithFreeFourThreadsThreadCache) {
+  RunMultiThreadedTest(alloc_.root(), 4, true);
+}
+
+TEST_F(MemoryAllocationPerfTest, MultiBucketWithFreeSixteenThreads) {
+  RunMultiThreadedTest(alloc_.root(), 16, false);
+}
+
+TEST_F(MemoryAllocationPerfTest,
+       MultiBucketWithFreeSixteenThreadsThreadCache) {
+  RunMultiThreadedTest(alloc_.root(), 16, true);
+}
+
 }  // anonymous namespace
 
 }  // namespace base
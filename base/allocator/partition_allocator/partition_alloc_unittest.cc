@@ -13,10 +13,12 @@
 
 #include "base/allocator/partition_allocator/address_space_randomization.h"
 #include "base/allocator/partition_allocator/partition_alloc.h"
+#include "base/bind.h"
 #include "base/logging.h"
 #include "base/rand_util.h"
 #include "base/stl_util.h"
 #include "base/system/sys_info.h"
+#include "base/threading/thread.h"
 #include "build/build_config.h"
 #include "testing/gtest/include/gtest/gtest.h"
 
@@ -33,6 +35,7 @@
 // code unreadable. Prefer using directives instead.
 using base::internal::PartitionBucket;
 using base::internal::PartitionPage;
+using base::internal::PartitionThreadCache;
 
 namespace {
 
@@ -2226,6 +2229,113 @@ TEST_F(PartitionAllocTest, Bug_897585) {
   PartitionFree(ptr);
 }
 
+TEST_F(PartitionAllocTest, ThreadCacheReusesFreedSlots) {
+  PartitionRootGeneric* root = generic_allocator.root();
+  root->EnableThreadCache();
+
+  void* ptr = root->Alloc(kTestAllocSize, type_name);
+  EXPECT_TRUE(ptr);
+  PartitionPage* page =
+      PartitionPage::FromPointer(PartitionCookieFreePointerAdjust(ptr));
+  size_t bucket_index = root->BucketIndex(page->bucket);
+  PartitionThreadCache* cache = root->GetThreadCache();
+  // The magazine was refilled with a whole batch, which is allocated from the
+  // page's point of view.
+  EXPECT_EQ(PartitionThreadCache::kBatchSize - 1u,
+            cache->GetCachedCountForTesting(bucket_index));
+  EXPECT_EQ(PartitionThreadCache::kBatchSize, page->num_allocated_slots);
+
+  root->Free(ptr);
+  EXPECT_EQ(PartitionThreadCache::kBatchSize,
+            cache->GetCachedCountForTesting(bucket_index));
+  void* new_ptr = root->Alloc(kTestAllocSize, type_name);
+  EXPECT_EQ(ptr, new_ptr);
+  root->Free(new_ptr);
+
+  // Purging returns the cached slots to the page.
+  root->PurgeMemory(PartitionPurgeDecommitEmptyPages);
+  EXPECT_EQ(0u, cache->GetCachedCountForTesting(bucket_index));
+  EXPECT_EQ(0, page->num_allocated_slots);
+}
+
+TEST_F(PartitionAllocTest, ThreadCacheMagazineIsBounded) {
+  PartitionRootGeneric* root = generic_allocator.root();
+  root->EnableThreadCache();
+
+  std::vector<void*> ptrs;
+  for (size_t i = 0; i < 4 * PartitionThreadCache::kMaxCountPerBucket; ++i)
+    ptrs.push_back(root->Alloc(kTestAllocSize, type_name));
+  PartitionPage* page =
+      PartitionPage::FromPointer(PartitionCookieFreePointerAdjust(ptrs[0]));
+  size_t bucket_index = root->BucketIndex(page->bucket);
+  for (void* ptr : ptrs) {
+    root->Free(ptr);
+    EXPECT_LE(root->GetThreadCache()->GetCachedCountForTesting(bucket_index),
+              PartitionThreadCache::kMaxCountPerBucket);
+  }
+  EXPECT_LE(static_cast<size_t>(page->num_allocated_slots),
+            PartitionThreadCache::kMaxCountPerBucket);
+
+  root->PurgeMemory(PartitionPurgeDecommitEmptyPages);
+  EXPECT_EQ(0, page->num_allocated_slots);
+}
+
+TEST_F(PartitionAllocTest, ThreadCacheZeroFill) {
+  PartitionRootGeneric* root = generic_allocator.root();
+  root->EnableThreadCache();
+
+  char* ptr = static_cast<char*>(root->Alloc(kTestAllocSize, type_name));
+  memset(ptr, 0xbd, kTestAllocSize);
+  root->Free(ptr);
+  ptr = static_cast<char*>(PartitionAllocGenericFlags(
+      root, PartitionAllocZeroFill, kTestAllocSize, type_name));
+  for (size_t i = 0; i < kTestAllocSize; ++i)
+    EXPECT_EQ(0, ptr[i]);
+  root->Free(ptr);
+}
+
+TEST_F(PartitionAllocTest, ThreadCacheOfOtherThread) {
+  PartitionRootGeneric* root = generic_allocator.root();
+  root->EnableThreadCache();
+  Thread thread("PartitionThreadCacheTest");
+  thread.Start();
+
+  void* ptr = nullptr;
+  thread.task_runner()->PostTask(
+      FROM_HERE, BindOnce(
+                     [](PartitionRootGeneric* root, void** ptr) {
+                       *ptr = root->Alloc(kTestAllocSize, type_name);
+                     },
+                     root, &ptr));
+  thread.FlushForTesting();
+  PartitionPage* page =
+      PartitionPage::FromPointer(PartitionCookieFreePointerAdjust(ptr));
+  EXPECT_EQ(PartitionThreadCache::kBatchSize, page->num_allocated_slots);
+
+  // The other thread drains its cache as soon as it uses it.
+  root->PurgeMemory(PartitionPurgeDecommitEmptyPages);
+  EXPECT_EQ(PartitionThreadCache::kBatchSize, page->num_allocated_slots);
+  thread.task_runner()->PostTask(
+      FROM_HERE,
+      BindOnce([](PartitionRootGeneric* root, void* ptr) { root->Free(ptr); },
+               root, ptr));
+  thread.FlushForTesting();
+  EXPECT_EQ(0, page->num_allocated_slots);
+
+  // The cache is drained when its thread exits.
+  thread.task_runner()->PostTask(
+      FROM_HERE, BindOnce(
+                     [](PartitionRootGeneric* root) {
+                       root->Free(root->Alloc(kTestAllocSize, type_name));
+                     },
+                     root));
+  thread.FlushForTesting();
+  EXPECT_EQ(PartitionThreadCache::kBatchSize, page->num_allocated_slots);
+  thread.Stop();
+  EXPECT_EQ(0, page->num_allocated_slots);
+  EXPECT_FALSE(root->thread_caches);
+}
+
 }  // namespace internal
 }  // namespace base
 
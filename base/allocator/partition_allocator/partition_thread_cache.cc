@@ -0,0 +1,96 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/allocator/partition_allocator/partition_thread_cache.h"
+
+#include "base/allocator/partition_allocator/partition_alloc.h"
+#include "base/allocator/partition_allocator/partition_page.h"
+#include "base/allocator/partition_allocator/spin_lock.h"
+
+namespace base {
+namespace internal {
+
+constexpr size_t PartitionThreadCache::kMaxSlotSize;
+constexpr uint16_t PartitionThreadCache::kBatchSize;
+constexpr uint16_t PartitionThreadCache::kMaxCountPerBucket;
+
+PartitionThreadCache::PartitionThreadCache(PartitionRootGeneric* root)
+    : root_(root) {}
+
+// Cached slots are either flushed by the owning thread when it exits, or
+// belong to a partition which is being destroyed.
+PartitionThreadCache::~PartitionThreadCache() = default;
+
+void PartitionThreadCache::FlushAllLocked() {
+  for (Magazine& magazine : magazines_)
+    FlushMagazineLocked(&magazine, 0);
+  should_purge_.store(false, std::memory_order_relaxed);
+}
+
+void* PartitionThreadCache::AllocSlowPath(size_t bucket_index,
+                                          PartitionBucket* bucket,
+                                          int flags,
+                                          size_t size) {
+  subtle::SpinLock::Guard guard(root_->lock);
+  if (should_purge_.load(std::memory_order_relaxed))
+    FlushAllLocked();
+
+  // The slot returned to the caller honors |flags|. The ones allocated in
+  // advance are allowed to fail, the magazine is then only partially refilled.
+  void* ret = root_->AllocFromBucket(bucket, flags, size);
+  if (!ret)
+    return nullptr;
+
+  Magazine& magazine = magazines_[bucket_index];
+  DCHECK(!magazine.head);
+  for (uint16_t i = 1; i < kBatchSize; ++i) {
+    void* extra =
+        root_->AllocFromBucket(bucket, PartitionAllocReturnNull, size);
+    if (!extra)
+      break;
+    CachedSlot* slot =
+        static_cast<CachedSlot*>(PartitionCookieFreePointerAdjust(extra));
+    slot->next = magazine.head;
+    magazine.head = slot;
+    ++magazine.count;
+  }
+  return ret;
+}
+
+void PartitionThreadCache::FreeSlowPath(size_t bucket_index) {
+  subtle::SpinLock::Guard guard(root_->lock);
+  if (should_purge_.load(std::memory_order_relaxed)) {
+    FlushAllLocked();
+    return;
+  }
+  // Keep the most recently freed slots, which are likely to be in the CPU
+  // cache.
+  FlushMagazineLocked(&magazines_[bucket_index], kMaxCountPerBucket / 2);
+}
+
+// static
+void PartitionThreadCache::FlushMagazineLocked(Magazine* magazine,
+                                               uint16_t keep) {
+  if (magazine->count <= keep)
+    return;
+
+  CachedSlot** link = &magazine->head;
+  for (uint16_t i = 0; i < keep; ++i)
+    link = &(*link)->next;
+  CachedSlot* slot = *link;
+  *link = nullptr;
+  magazine->count = keep;
+
+  while (slot) {
+    CachedSlot* next = slot->next;
+    PartitionCookieWriteValue(slot);
+    PartitionPage* page = PartitionPage::FromPointer(slot);
+    DCHECK(PartitionRootBase::IsValidPage(page));
+    page->Free(slot);
+    slot = next;
+  }
+}
+
+}  // namespace internal
+}  // namespace base
@@ -0,0 +1,182 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef BASE_ALLOCATOR_PARTITION_ALLOCATOR_PARTITION_THREAD_CACHE_H_
+#define BASE_ALLOCATOR_PARTITION_ALLOCATOR_PARTITION_THREAD_CACHE_H_
+
+#include <stdint.h>
+#include <string.h>
+
+#include <atomic>
+
+#include "base/allocator/partition_allocator/partition_alloc_constants.h"
+#include "base/allocator/partition_allocator/partition_bucket.h"
+#include "base/allocator/partition_allocator/partition_cookie.h"
+#include "base/base_export.h"
+#include "base/compiler_specific.h"
+#include "base/logging.h"
+#include "base/macros.h"
+
+namespace base {
+
+struct PartitionRootGeneric;
+
+namespace internal {
+
+// A per-thread, per-partition cache of free slots, see
+// PartitionRootGeneric::EnableThreadCache().
+//
+// Each bucket of small slots has a "magazine": a singly linked list of slots
+// which were freed by the owning thread, or allocated in advance on its
+// behalf. Most allocations and frees only push or pop a magazine without
+// taking the partition lock. Empty magazines are refilled, and full magazines
+// are flushed, a batch of slots at a time under a single lock acquisition.
+//
+// Cached slots are allocated from the point of view of their partition page,
+// so they are accounted as active memory until the cache is drained.
+//
+// Only the owning thread accesses the magazines. Other threads only touch the
+// |next_|/|prev_| links (PartitionRootGeneric::thread_caches) and
+// |should_purge_|, under the partition lock.
+class BASE_EXPORT PartitionThreadCache {
+ public:
+  // Larger slots are rarer and hold more memory, they aren't cached.
+  static constexpr size_t kMaxSlotSize = 1024;
+  // Number of slots moved at once from a bucket to an empty magazine.
+  static constexpr uint16_t kBatchSize = 16;
+  // A magazine which grows beyond this many slots is flushed back to its
+  // bucket, down to half this count.
+  static constexpr uint16_t kMaxCountPerBucket = 64;
+
+  explicit PartitionThreadCache(PartitionRootGeneric* root);
+  ~PartitionThreadCache();
+
+  ALWAYS_INLINE static bool IsCacheable(const PartitionBucket* bucket) {
+    // The sentinel bucket, used for direct mapped allocations, is direct
+    // mapped as well.
+    return !bucket->is_direct_mapped() && bucket->slot_size <= kMaxSlotSize;
+  }
+
+  // Returns a slot of |bucket|, whose index in the partition's buckets is
+  // |bucket_index|. |size| and |flags| are as in
+  // PartitionRootBase::AllocFromBucket(): |size| includes the cookies.
+  ALWAYS_INLINE void* Alloc(size_t bucket_index,
+                            PartitionBucket* bucket,
+                            int flags,
+                            size_t size);
+
+  // Caches the slot of |bucket| starting at |slot_start|. Contrary to the
+  // pointers returned by Alloc(), |slot_start| points to the leading cookie.
+  // Cached slots are linked through their first word, which is why the
+  // leading cookie is written again when they get allocated or flushed.
+  ALWAYS_INLINE void Free(size_t bucket_index,
+                          const PartitionBucket* bucket,
+                          void* slot_start);
+
+  // Returns all the cached slots to their partition pages. The partition lock
+  // must be held.
+  void FlushAllLocked();
+
+  // Makes the owning thread drain the cache the next time it allocates or
+  // frees a slot. The partition lock must be held.
+  void RequestPurgeLocked() {
+    should_purge_.store(true, std::memory_order_relaxed);
+  }
+
+  size_t GetCachedCountForTesting(size_t bucket_index) const {
+    return magazines_[bucket_index].count;
+  }
+
+ private:
+  friend struct base::PartitionRootGeneric;
+
+  struct CachedSlot {
+    CachedSlot* next;
+  };
+
+  struct Magazine {
+    CachedSlot* head = nullptr;
+    uint16_t count = 0;
+  };
+
+  // Refills the magazine of |bucket| and returns a slot of it, or nullptr if
+  // the allocation failed and |flags| allow returning nullptr.
+  NOINLINE void* AllocSlowPath(size_t bucket_index,
+                               PartitionBucket* bucket,
+                               int flags,
+                               size_t size);
+
+  // Flushes magazines which grew too much, or the whole cache if a purge was
+  // requested.
+  NOINLINE void FreeSlowPath(size_t bucket_index);
+
+  // Returns the slots after the |keep| first ones of |magazine| to their
+  // partition pages. The partition lock must be held.
+  static void FlushMagazineLocked(Magazine* magazine, uint16_t keep);
+
+  PartitionRootGeneric* const root_;
+  Magazine magazines_[kGenericNumBuckets];
+  std::atomic<bool> should_purge_{false};
+
+  // Links in PartitionRootGeneric::thread_caches, guarded by the partition
+  // lock.
+  PartitionThreadCache* next_ = nullptr;
+  PartitionThreadCache* prev_ = nullptr;
+
+  DISALLOW_COPY_AND_ASSIGN(PartitionThreadCache);
+};
+
+ALWAYS_INLINE void* PartitionThreadCache::Alloc(size_t bucket_index,
+                                                PartitionBucket* bucket,
+                                                int flags,
+                                                size_t size) {
+  DCHECK_LT(bucket_index, kGenericNumBuckets);
+  Magazine& magazine = magazines_[bucket_index];
+  CachedSlot* slot = magazine.head;
+  if (UNLIKELY(!slot || should_purge_.load(std::memory_order_relaxed)))
+    return AllocSlowPath(bucket_index, bucket, flags, size);
+
+  magazine.head = slot->next;
+  --magazine.count;
+  void* ret = slot;
+#if DCHECK_IS_ON()
+  // The link overwrote the leading cookie, the trailing one is intact.
+  PartitionCookieWriteValue(ret);
+  ret = reinterpret_cast<char*>(ret) + kCookieSize;
+#endif
+  if (flags & PartitionAllocZeroFill)
+    memset(ret, 0, PartitionCookieSizeAdjustSubtract(size));
+  return ret;
+}
+
+ALWAYS_INLINE void PartitionThreadCache::Free(size_t bucket_index,
+                                              const PartitionBucket* bucket,
+                                              void* slot_start) {
+  DCHECK_LT(bucket_index, kGenericNumBuckets);
+  Magazine& magazine = magazines_[bucket_index];
+  // Catches an immediate double free, like PartitionPage::Free().
+  CHECK(slot_start != magazine.head);
+#if DCHECK_IS_ON()
+  // Check the cookies now, the slot may stay in the cache for a while.
+  char* char_slot = static_cast<char*>(slot_start);
+  const size_t no_cookie_size =
+      PartitionCookieSizeAdjustSubtract(bucket->slot_size);
+  PartitionCookieCheckValue(char_slot);
+  PartitionCookieCheckValue(char_slot + kCookieSize + no_cookie_size);
+  memset(char_slot + kCookieSize, kFreedByte, no_cookie_size);
+#endif
+  CachedSlot* slot = static_cast<CachedSlot*>(slot_start);
+  slot->next = magazine.head;
+  magazine.head = slot;
+  ++magazine.count;
+  if (UNLIKELY(magazine.count > kMaxCountPerBucket ||
+               should_purge_.load(std::memory_order_relaxed))) {
+    FreeSlowPath(bucket_index);
+  }
+}
+
+}  // namespace internal
+}  // namespace base
+
+#endif  // BASE_ALLOCATOR_PARTITION_ALLOCATOR_PARTITION_THREAD_CACHE_H_
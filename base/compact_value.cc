@@ -0,0 +1,251 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/compact_value.h"
+
+#include <algorithm>
+#include <unordered_map>
+#include <utility>
+
+#include "base/logging.h"
+#include "base/numerics/safe_conversions.h"
+
+namespace base {
+
+// static
+const CompactValue::Node CompactValue::kMissingNode = {Value::Type::NONE,
+                                                       0,
+                                                       0,
+                                                       0,
+                                                       {false}};
+
+// Fills the nodes and strings of a CompactValue from a Value tree, depth
+// first, so that the children of each container are allocated together.
+class CompactValue::Builder {
+ public:
+  explicit Builder(CompactValue* compact) : compact_(compact) {}
+
+  void Build(const Value& value) {
+    compact_->nodes_.emplace_back();
+    Fill(0, value);
+    compact_->nodes_.shrink_to_fit();
+    compact_->strings_.shrink_to_fit();
+  }
+
+ private:
+  // Sets the node at |index| to |value|, except for its key. This may resize
+  // |nodes_|, so nodes are only referenced by index while building.
+  void Fill(size_t index, const Value& value) {
+    Node node = {};
+    node.type = value.type();
+    switch (value.type()) {
+      case Value::Type::NONE:
+        break;
+      case Value::Type::BOOLEAN:
+        node.bool_value = value.GetBool();
+        break;
+      case Value::Type::INTEGER:
+        node.int_value = value.GetInt();
+        break;
+      case Value::Type::DOUBLE:
+        node.double_value = value.GetDouble();
+        break;
+      case Value::Type::STRING:
+        node.size = checked_cast<uint32_t>(value.GetString().size());
+        node.offset = AppendString(value.GetString());
+        break;
+      case Value::Type::BINARY: {
+        const Value::BlobStorage& blob = value.GetBlob();
+        node.size = checked_cast<uint32_t>(blob.size());
+        node.offset = AppendString(StringPiece(
+            reinterpret_cast<const char*>(blob.data()), blob.size()));
+        break;
+      }
+      case Value::Type::DICTIONARY: {
+        node.size = checked_cast<uint32_t>(value.DictSize());
+        node.offset = AllocateChildren(node.size);
+        uint32_t child = node.offset;
+        for (const auto& item : value.DictItems()) {
+          Fill(child, item.second);
+          compact_->nodes_[child].key_offset = InternKey(item.first);
+          compact_->nodes_[child].key_length =
+              checked_cast<uint32_t>(item.first.size());
+          ++child;
+        }
+        break;
+      }
+      case Value::Type::LIST: {
+        const Value::ListStorage& list = value.GetList();
+        node.size = checked_cast<uint32_t>(list.size());
+        node.offset = AllocateChildren(node.size);
+        for (uint32_t i = 0; i < node.size; ++i)
+          Fill(node.offset + i, list[i]);
+        break;
+      }
+      // TODO(crbug.com/859477): Remove after root cause is found.
+      case Value::Type::DEAD:
+        CHECK(false);
+        break;
+    }
+    compact_->nodes_[index] = node;
+  }
+
+  // Returns the index of the first of |count| new nodes.
+  uint32_t AllocateChildren(uint32_t count) {
+    const uint32_t first = checked_cast<uint32_t>(compact_->nodes_.size());
+    compact_->nodes_.resize(compact_->nodes_.size() + count);
+    return first;
+  }
+
+  // Returns the offset of |str|, which is added to |strings_|.
+  uint32_t AppendString(StringPiece str) {
+    const uint32_t offset = checked_cast<uint32_t>(compact_->strings_.size());
+    str.AppendToString(&compact_->strings_);
+    return offset;
+  }
+
+  // Returns the offset of |key| in |strings_|, which is only added the first
+  // time it is used. |key| must outlive the builder.
+  uint32_t InternKey(StringPiece key) {
+    auto result = key_offsets_.emplace(key, 0);
+    if (result.second)
+      result.first->second = AppendString(key);
+    return result.first->second;
+  }
+
+  CompactValue* const compact_;
+  std::unordered_map<StringPiece, uint32_t, StringPieceHash> key_offsets_;
+
+  DISALLOW_COPY_AND_ASSIGN(Builder);
+};
+
+CompactValue::View::View(const CompactValue* owner, const Node* node)
+    : owner_(owner), node_(node) {}
+
+Value::Type CompactValue::View::type() const {
+  return node_->type;
+}
+
+bool CompactValue::View::GetBool() const {
+  CHECK(is_bool());
+  return node_->bool_value;
+}
+
+int CompactValue::View::GetInt() const {
+  CHECK(is_int());
+  return node_->int_value;
+}
+
+double CompactValue::View::GetDouble() const {
+  if (is_double())
+    return node_->double_value;
+  if (is_int())
+    return node_->int_value;
+  CHECK(false);
+  return 0.0;
+}
+
+StringPiece CompactValue::View::GetString() const {
+  CHECK(is_string());
+  return StringPiece(owner_->strings_.data() + node_->offset, node_->size);
+}
+
+span<const uint8_t> CompactValue::View::GetBlob() const {
+  CHECK(is_blob());
+  return make_span(
+      reinterpret_cast<const uint8_t*>(owner_->strings_.data()) + node_->offset,
+      node_->size);
+}
+
+size_t CompactValue::View::size() const {
+  CHECK(is_dict() || is_list());
+  return node_->size;
+}
+
+CompactValue::View CompactValue::View::GetChild(size_t index) const {
+  CHECK_LT(index, size());
+  return View(owner_, &owner_->nodes_[node_->offset + index]);
+}
+
+StringPiece CompactValue::View::key() const {
+  return StringPiece(owner_->strings_.data() + node_->key_offset,
+                     node_->key_length);
+}
+
+CompactValue::View CompactValue::View::FindKey(StringPiece key) const {
+  CHECK(is_dict());
+  // The entries are in the order of the keys of the Value they were built
+  // from, which is a flat_map.
+  const Node* begin = &owner_->nodes_[node_->offset];
+  const Node* end = begin + node_->size;
+  const Node* it = std::lower_bound(
+      begin, end, key, [this](const Node& node, StringPiece key) {
+        return View(owner_, &node).key() < key;
+      });
+  if (it == end || View(owner_, it).key() != key)
+    return View(owner_, &kMissingNode);
+  return View(owner_, it);
+}
+
+Value CompactValue::View::ToValue() const {
+  switch (type()) {
+    case Value::Type::NONE:
+      return Value();
+    case Value::Type::BOOLEAN:
+      return Value(GetBool());
+    case Value::Type::INTEGER:
+      return Value(GetInt());
+    case Value::Type::DOUBLE:
+      return Value(GetDouble());
+    case Value::Type::STRING:
+      return Value(GetString());
+    case Value::Type::BINARY:
+      return Value(GetBlob());
+    case Value::Type::DICTIONARY: {
+      std::vector<Value::DictStorage::value_type> dict_storage;
+      dict_storage.reserve(size());
+      for (size_t i = 0; i < size(); ++i) {
+        const View child = GetChild(i);
+        dict_storage.emplace_back(child.key().as_string(),
+                                  std::make_unique<Value>(child.ToValue()));
+      }
+      return Value(Value::DictStorage(std::move(dict_storage),
+                                      KEEP_FIRST_OF_DUPES));
+    }
+    case Value::Type::LIST: {
+      Value::ListStorage list_storage;
+      list_storage.reserve(size());
+      for (size_t i = 0; i < size(); ++i)
+        list_storage.push_back(GetChild(i).ToValue());
+      return Value(std::move(list_storage));
+    }
+    // TODO(crbug.com/859477): Remove after root cause is found.
+    case Value::Type::DEAD:
+      CHECK(false);
+      return Value();
+  }
+
+  NOTREACHED();
+  return Value();
+}
+
+CompactValue::CompactValue(const Value& value) {
+  Builder(this).Build(value);
+}
+
+CompactValue::CompactValue(CompactValue&& other) noexcept = default;
+
+CompactValue& CompactValue::operator=(CompactValue&& other) noexcept = default;
+
+CompactValue::~CompactValue() = default;
+
+CompactValue::View CompactValue::root() const {
+  return View(this, &nodes_[0]);
+}
+
+size_t CompactValue::EstimateMemoryUsage() const {
+  return nodes_.capacity() * sizeof(Node) + strings_.capacity();
+}
+
+}  // namespace base
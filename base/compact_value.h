@@ -0,0 +1,132 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef BASE_COMPACT_VALUE_H_
+#define BASE_COMPACT_VALUE_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <string>
+#include <vector>
+
+#include "base/base_export.h"
+#include "base/containers/span.h"
+#include "base/macros.h"
+#include "base/strings/string_piece.h"
+#include "base/values.h"
+
+namespace base {
+
+// An immutable copy of a Value tree that is cheap to hold and to read.
+//
+// A Value allocates every dictionary entry, key and string separately. A
+// CompactValue instead stores all nodes of the tree in one array, with the
+// children of each list or dictionary next to each other, and all strings in
+// one buffer, in which each distinct dictionary key is stored only once. This
+// makes it a good fit for large trees that are mostly read, such as default
+// preferences or parsed JSON responses: build it once, read it through View,
+// and only convert the parts that need to be modified back to Values.
+//
+//   CompactValue compact(*JSONReader::Read(json));
+//   CompactValue::View name = compact.root().FindKey("name");
+//   if (name.is_string())
+//     UseName(name.GetString());
+class BASE_EXPORT CompactValue {
+ private:
+  struct Node;
+
+ public:
+  // A read-only reference to a value of a CompactValue. Views are small and
+  // meant to be passed by value. They must not outlive their CompactValue.
+  class BASE_EXPORT View {
+   public:
+    Value::Type type() const;
+    bool is_none() const { return type() == Value::Type::NONE; }
+    bool is_bool() const { return type() == Value::Type::BOOLEAN; }
+    bool is_int() const { return type() == Value::Type::INTEGER; }
+    bool is_double() const { return type() == Value::Type::DOUBLE; }
+    bool is_string() const { return type() == Value::Type::STRING; }
+    bool is_blob() const { return type() == Value::Type::BINARY; }
+    bool is_dict() const { return type() == Value::Type::DICTIONARY; }
+    bool is_list() const { return type() == Value::Type::LIST; }
+
+    // These must only be called for a value of the matching type, except that
+    // GetDouble() also converts integers, like Value::GetDouble().
+    bool GetBool() const;
+    int GetInt() const;
+    double GetDouble() const;
+    StringPiece GetString() const;
+    span<const uint8_t> GetBlob() const;
+
+    // Returns the number of elements of a list or entries of a dictionary.
+    size_t size() const;
+
+    // Returns the |index|th element of a list or entry of a dictionary, in key
+    // order for the latter. |index| must be less than size().
+    View GetChild(size_t index) const;
+
+    // Returns the key of a child of a dictionary.
+    StringPiece key() const;
+
+    // Returns the value of |key| in a dictionary, or a NONE value that is not
+    // a child of any dictionary if there is no such key. Takes O(log(size())).
+    View FindKey(StringPiece key) const;
+
+    // Returns a Value copy of this value and all of its children.
+    Value ToValue() const;
+
+   private:
+    friend class CompactValue;
+
+    View(const CompactValue* owner, const Node* node);
+
+    const CompactValue* owner_;
+    const Node* node_;
+  };
+
+  // Builds a compact copy of |value|.
+  explicit CompactValue(const Value& value);
+  CompactValue(CompactValue&& other) noexcept;
+  CompactValue& operator=(CompactValue&& other) noexcept;
+  ~CompactValue();
+
+  View root() const;
+
+  // Returns the memory used by the nodes and strings, in bytes.
+  size_t EstimateMemoryUsage() const;
+
+ private:
+  struct Node {
+    Value::Type type;
+    // The key of a dictionary entry, in |strings_|.
+    uint32_t key_offset;
+    uint32_t key_length;
+    // The length of a string or blob, or the number of children of a list or
+    // dictionary.
+    uint32_t size;
+    union {
+      bool bool_value;
+      int int_value;
+      double double_value;
+      // The first byte of a string or blob in |strings_|, or the index of the
+      // first child of a list or dictionary in |nodes_|.
+      uint32_t offset;
+    };
+  };
+
+  class Builder;
+
+  // What FindKey() returns for a missing key.
+  static const Node kMissingNode;
+
+  std::vector<Node> nodes_;
+  std::string strings_;
+
+  DISALLOW_COPY_AND_ASSIGN(CompactValue);
+};
+
+}  // namespace base
+
+#endif  // BASE_COMPACT_VALUE_H_
@@ -0,0 +1,122 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/compact_value.h"
+
+#include <stdint.h>
+
+#include <utility>
+#include <vector>
+
+#include "base/values.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace base {
+
+namespace {
+
+Value CreateTestValue() {
+  Value list(Value::Type::LIST);
+  list.GetList().emplace_back(1);
+  list.GetList().emplace_back("two");
+  list.GetList().emplace_back(Value::Type::DICTIONARY);
+  list.GetList().emplace_back(Value::Type::LIST);
+
+  Value nested(Value::Type::DICTIONARY);
+  nested.SetKey("bool", Value(true));
+  nested.SetKey("string", Value("nested"));
+
+  Value dict(Value::Type::DICTIONARY);
+  dict.SetKey("null", Value());
+  dict.SetKey("bool", Value(false));
+  dict.SetKey("int", Value(42));
+  dict.SetKey("double", Value(3.5));
+  dict.SetKey("string", Value("a string"));
+  dict.SetKey("blob", Value(Value::BlobStorage{0, 1, 2, 255}));
+  dict.SetKey("list", std::move(list));
+  dict.SetKey("nested", std::move(nested));
+  return dict;
+}
+
+}  // namespace
+
+TEST(CompactValueTest, Scalars) {
+  EXPECT_TRUE(CompactValue(Value()).root().is_none());
+  EXPECT_TRUE(CompactValue(Value(true)).root().GetBool());
+  EXPECT_EQ(-7, CompactValue(Value(-7)).root().GetInt());
+  EXPECT_EQ(-7.0, CompactValue(Value(-7)).root().GetDouble());
+  EXPECT_EQ(0.25, CompactValue(Value(0.25)).root().GetDouble());
+  EXPECT_EQ("", CompactValue(Value("")).root().GetString());
+  EXPECT_EQ("foo", CompactValue(Value("foo")).root().GetString());
+}
+
+TEST(CompactValueTest, Containers) {
+  const CompactValue compact(CreateTestValue());
+  const CompactValue::View root = compact.root();
+  ASSERT_TRUE(root.is_dict());
+  EXPECT_EQ(8u, root.size());
+
+  // Entries are in key order.
+  EXPECT_EQ("blob", root.GetChild(0).key());
+  EXPECT_EQ("string", root.GetChild(7).key());
+
+  EXPECT_TRUE(root.FindKey("null").is_none());
+  EXPECT_FALSE(root.FindKey("bool").GetBool());
+  EXPECT_EQ(42, root.FindKey("int").GetInt());
+  EXPECT_EQ(3.5, root.FindKey("double").GetDouble());
+  EXPECT_EQ("a string", root.FindKey("string").GetString());
+  const std::vector<uint8_t> blob = {0, 1, 2, 255};
+  EXPECT_EQ(blob, std::vector<uint8_t>(root.FindKey("blob").GetBlob().begin(),
+                                       root.FindKey("blob").GetBlob().end()));
+
+  const CompactValue::View list = root.FindKey("list");
+  ASSERT_TRUE(list.is_list());
+  ASSERT_EQ(4u, list.size());
+  EXPECT_EQ(1, list.GetChild(0).GetInt());
+  EXPECT_EQ("two", list.GetChild(1).GetString());
+  EXPECT_EQ(0u, list.GetChild(2).size());
+  EXPECT_EQ(0u, list.GetChild(3).size());
+
+  const CompactValue::View nested = root.FindKey("nested");
+  ASSERT_TRUE(nested.is_dict());
+  EXPECT_TRUE(nested.FindKey("bool").GetBool());
+  EXPECT_EQ("nested", nested.FindKey("string").GetString());
+
+  EXPECT_TRUE(root.FindKey("missing").is_none());
+  EXPECT_TRUE(root.FindKey("").is_none());
+  EXPECT_TRUE(nested.FindKey("int").is_none());
+}
+
+TEST(CompactValueTest, KeysAreInterned) {
+  const CompactValue compact(CreateTestValue());
+  const CompactValue::View root = compact.root();
+  const CompactValue::View nested = root.FindKey("nested");
+
+  // "bool" and "string" are keys of both dictionaries, but stored once.
+  EXPECT_EQ(root.GetChild(1).key().data(), nested.GetChild(0).key().data());
+  EXPECT_EQ(root.GetChild(7).key().data(), nested.GetChild(1).key().data());
+}
+
+TEST(CompactValueTest, ToValue) {
+  const Value value = CreateTestValue();
+  const CompactValue compact(value);
+  EXPECT_EQ(value, compact.root().ToValue());
+  EXPECT_EQ(*value.FindKey("nested"),
+            compact.root().FindKey("nested").ToValue());
+}
+
+TEST(CompactValueTest, Move) {
+  CompactValue compact(CreateTestValue());
+  const size_t memory_usage = compact.EstimateMemoryUsage();
+  EXPECT_GT(memory_usage, 0u);
+
+  CompactValue moved(std::move(compact));
+  EXPECT_EQ(memory_usage, moved.EstimateMemoryUsage());
+  EXPECT_EQ(CreateTestValue(), moved.root().ToValue());
+
+  compact = std::move(moved);
+  EXPECT_EQ(42, compact.root().FindKey("int").GetInt());
+}
+
+}  // namespace base
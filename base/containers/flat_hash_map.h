@@ -0,0 +1,227 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef BASE_CONTAINERS_FLAT_HASH_MAP_H_
+#define BASE_CONTAINERS_FLAT_HASH_MAP_H_
+
+#include <functional>
+#include <initializer_list>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "base/containers/flat_hash_table.h"
+#include "base/logging.h"
+
+namespace base {
+
+namespace internal {
+
+// An implementation of the FlatHashTable GetKeyFromValue template parameter
+// that extracts the key as the first element of a pair with a const key.
+template <class Key, class Mapped>
+struct GetKeyFromValueConstPairFirst {
+  const Key& operator()(const std::pair<const Key, Mapped>& p) const {
+    return p.first;
+  }
+};
+
+}  // namespace internal
+
+// FlatHashMap is a container with a std::unordered_map-like interface that
+// stores its contents in one array, without a separate allocation per entry.
+//
+// Please see //base/containers/README.md for an overview of which container
+// to select.
+//
+// PROS
+//
+//  - Fast lookups and insertions in large maps: a lookup usually compares the
+//    hashes of 16 entries at once and the key of only one.
+//  - Good memory locality, and low overhead per entry.
+//
+// CONS
+//
+//  - Values are moved when the map grows, so pointers and references to them
+//    are invalidated, unlike with std::unordered_map.
+//  - Erased entries use up their slot until the map is rehashed.
+//  - For small maps, flat_map is usually smaller and as fast.
+//
+// IMPORTANT NOTES
+//
+//  - Iterators and references are invalidated by insertions.
+//  - Iterators are checked; using an invalid end iterator CHECKs.
+//  - The iteration order is unspecified and changes when the map grows.
+//
+// QUICK REFERENCE
+//
+// Most of the core functionality is inherited from FlatHashTable. Please see
+// flat_hash_table.h for more details. As a quick reference, the functions
+// available are:
+//
+// Constructors:
+//   FlatHashMap(InputIterator first, InputIterator last);
+//   FlatHashMap(const FlatHashMap&);
+//   FlatHashMap(FlatHashMap&&);
+//   FlatHashMap(std::initializer_list<value_type>);
+//
+// Assignment functions:
+//   FlatHashMap& operator=(const FlatHashMap&);
+//   FlatHashMap& operator=(FlatHashMap&&);
+//   FlatHashMap& operator=(initializer_list<value_type>);
+//
+// Memory management functions:
+//   void   reserve(size_t);
+//   size_t capacity() const;
+//
+// Size management functions:
+//   void   clear();
+//   size_t size() const;
+//   bool   empty() const;
+//
+// Iterator functions:
+//   iterator       begin();
+//   const_iterator begin() const;
+//   const_iterator cbegin() const;
+//   iterator       end();
+//   const_iterator end() const;
+//   const_iterator cend() const;
+//
+// Insert and accessor functions:
+//   mapped_type&         operator[](const key_type&);
+//   mapped_type&         operator[](key_type&&);
+//   mapped_type&         at(const key_type&);
+//   const mapped_type&   at(const key_type&) const;
+//   pair<iterator, bool> insert(const value_type&);
+//   pair<iterator, bool> insert(value_type&&);
+//   void                 insert(InputIterator first, InputIterator last);
+//   pair<iterator, bool> insert_or_assign(K&&, M&&);
+//   pair<iterator, bool> emplace(Args&&...);
+//   pair<iterator, bool> try_emplace(K&&, Args&&...);
+//
+// Erase functions:
+//   iterator erase(iterator);
+//   iterator erase(const_iterator);
+//   size_t   erase(const key_type& key);
+//
+// Search functions:
+//   size_t         count(const key_type&) const;
+//   iterator       find(const key_type&);
+//   const_iterator find(const key_type&) const;
+//   bool           contains(const key_type&) const;
+//
+// General functions:
+//   void swap(FlatHashMap&&);
+//
+// Non-member operators:
+//   bool operator==(const FlatHashMap&, const FlatHashMap);
+//   bool operator!=(const FlatHashMap&, const FlatHashMap);
+//
+template <class Key,
+          class Mapped,
+          class Hash = std::hash<Key>,
+          class KeyEqual = std::equal_to<Key>>
+class FlatHashMap
+    : public ::base::internal::FlatHashTable<
+          Key,
+          std::pair<const Key, Mapped>,
+          ::base::internal::GetKeyFromValueConstPairFirst<Key, Mapped>,
+          Hash,
+          KeyEqual> {
+ private:
+  using table = typename ::base::internal::FlatHashTable<
+      Key,
+      std::pair<const Key, Mapped>,
+      ::base::internal::GetKeyFromValueConstPairFirst<Key, Mapped>,
+      Hash,
+      KeyEqual>;
+
+ public:
+  using key_type = typename table::key_type;
+  using mapped_type = Mapped;
+  using value_type = typename table::value_type;
+  using iterator = typename table::iterator;
+  using const_iterator = typename table::const_iterator;
+
+  // --------------------------------------------------------------------------
+  // Lifetime and assignments.
+
+  FlatHashMap() = default;
+
+  template <class InputIterator>
+  FlatHashMap(InputIterator first, InputIterator last) : table(first, last) {}
+
+  FlatHashMap(std::initializer_list<value_type> ilist) : table(ilist) {}
+
+  FlatHashMap(const FlatHashMap&) = default;
+  FlatHashMap(FlatHashMap&&) noexcept = default;
+
+  ~FlatHashMap() = default;
+
+  FlatHashMap& operator=(const FlatHashMap&) = default;
+  FlatHashMap& operator=(FlatHashMap&&) = default;
+  FlatHashMap& operator=(std::initializer_list<value_type> ilist) {
+    table::operator=(ilist);
+    return *this;
+  }
+
+  // --------------------------------------------------------------------------
+  // Map-specific insert and accessor operations.
+  //
+  // Normal insert() functions are inherited from FlatHashTable.
+
+  mapped_type& operator[](const key_type& key) {
+    return try_emplace(key).first->second;
+  }
+
+  mapped_type& operator[](key_type&& key) {
+    return try_emplace(std::move(key)).first->second;
+  }
+
+  // CHECKs that |key| is present.
+  mapped_type& at(const key_type& key) {
+    iterator found = table::find(key);
+    CHECK(found != table::end());
+    return found->second;
+  }
+
+  const mapped_type& at(const key_type& key) const {
+    const_iterator found = table::find(key);
+    CHECK(found != table::end());
+    return found->second;
+  }
+
+  template <class K, class M>
+  std::pair<iterator, bool> insert_or_assign(K&& key, M&& obj) {
+    auto result =
+        table::emplace_key_args(key, std::forward<K>(key), std::forward<M>(obj));
+    if (!result.second)
+      result.first->second = std::forward<M>(obj);
+    return result;
+  }
+
+  // Unlike emplace(), only constructs the value if |key| is not present.
+  template <class K, class... Args>
+  std::enable_if_t<std::is_constructible<key_type, K&&>::value,
+                   std::pair<iterator, bool>>
+  try_emplace(K&& key, Args&&... args) {
+    return table::emplace_key_args(
+        key, std::piecewise_construct,
+        std::forward_as_tuple(std::forward<K>(key)),
+        std::forward_as_tuple(std::forward<Args>(args)...));
+  }
+
+  // --------------------------------------------------------------------------
+  // General operations.
+
+  void swap(FlatHashMap& other) noexcept { table::swap(other); }
+
+  friend void swap(FlatHashMap& lhs, FlatHashMap& rhs) noexcept {
+    lhs.swap(rhs);
+  }
+};
+
+}  // namespace base
+
+#endif  // BASE_CONTAINERS_FLAT_HASH_MAP_H_
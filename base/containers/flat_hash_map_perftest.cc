@@ -0,0 +1,117 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "base/containers/flat_hash_map.h"
+#include "base/containers/flat_map.h"
+#include "base/rand_util.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/time/time.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "testing/perf/perf_test.h"
+
+namespace base {
+
+namespace {
+
+constexpr int kSizes[] = {10, 1000, 100000};
+
+// Returns |count| distinct keys, and as many other keys that are not among
+// them.
+void GenerateKeys(int count, std::vector<int>* keys, std::vector<int>* misses) {
+  for (int i = 0; i < count; ++i) {
+    keys->push_back(2 * i);
+    misses->push_back(2 * i + 1);
+  }
+  // Insert and look up the keys out of order.
+  RandomShuffle(keys->begin(), keys->end());
+  RandomShuffle(misses->begin(), misses->end());
+}
+
+void GenerateKeys(int count,
+                  std::vector<std::string>* keys,
+                  std::vector<std::string>* misses) {
+  std::vector<int> int_keys;
+  std::vector<int> int_misses;
+  GenerateKeys(count, &int_keys, &int_misses);
+  for (int i = 0; i < count; ++i) {
+    keys->push_back("key_" + NumberToString(int_keys[i]));
+    misses->push_back("key_" + NumberToString(int_misses[i]));
+  }
+}
+
+// Times inserting |count| keys into a Map, then looking up every key, then
+// looking up as many keys that are not in it.
+template <class Map>
+void RunTest(const std::string& map_name,
+             const std::string& key_name,
+             int count) {
+  using Key = typename Map::key_type;
+  std::vector<Key> keys;
+  std::vector<Key> misses;
+  GenerateKeys(count, &keys, &misses);
+  const std::string trace = key_name + "_" + NumberToString(count);
+  // Repeat small tests so that they take measurable time.
+  const int iterations = 1000000 / count;
+
+  TimeDelta insert_time;
+  TimeDelta find_time;
+  TimeDelta miss_time;
+  size_t found = 0;
+  for (int i = 0; i < iterations; ++i) {
+    Map map;
+    TimeTicks start = TimeTicks::Now();
+    for (const Key& key : keys)
+      map[key] = 1;
+    TimeTicks end_insert = TimeTicks::Now();
+    for (const Key& key : keys)
+      found += map.count(key);
+    TimeTicks end_find = TimeTicks::Now();
+    for (const Key& key : misses)
+      found += map.count(key);
+    TimeTicks end_miss = TimeTicks::Now();
+
+    insert_time += end_insert - start;
+    find_time += end_find - end_insert;
+    miss_time += end_miss - end_find;
+  }
+  EXPECT_EQ(keys.size() * iterations, found);
+
+  const double operations = static_cast<double>(count) * iterations;
+  perf_test::PrintResult(map_name + "_insert", "", trace,
+                         insert_time.InNanoseconds() / operations,
+                         "ns/operation", true);
+  perf_test::PrintResult(map_name + "_find", "", trace,
+                         find_time.InNanoseconds() / operations,
+                         "ns/operation", true);
+  perf_test::PrintResult(map_name + "_find_missing", "", trace,
+                         miss_time.InNanoseconds() / operations,
+                         "ns/operation", true);
+}
+
+template <class Key>
+void RunTests(const std::string& key_name) {
+  for (int count : kSizes) {
+    RunTest<FlatHashMap<Key, int>>("FlatHashMap", key_name, count);
+    RunTest<std::unordered_map<Key, int>>("unordered_map", key_name, count);
+    // Inserting into a large flat_map one key at a time is quadratic.
+    if (count <= 1000)
+      RunTest<flat_map<Key, int>>("flat_map", key_name, count);
+  }
+}
+
+}  // namespace
+
+TEST(FlatHashMapPerfTest, IntKeys) {
+  RunTests<int>("int");
+}
+
+TEST(FlatHashMapPerfTest, StringKeys) {
+  RunTests<std::string>("string");
+}
+
+}  // namespace base
@@ -0,0 +1,224 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/containers/flat_hash_map.h"
+
+#include <map>
+#include <string>
+#include <utility>
+
+#include "base/macros.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/test/move_only_int.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace base {
+
+namespace {
+
+// A hash function that puts all keys into the same probe sequence.
+struct CollidingHash {
+  size_t operator()(int) const { return 0; }
+};
+
+struct MoveOnlyIntHash {
+  size_t operator()(const MoveOnlyInt& key) const { return key.data(); }
+};
+
+}  // namespace
+
+TEST(FlatHashMap, Empty) {
+  FlatHashMap<int, int> map;
+  EXPECT_TRUE(map.empty());
+  EXPECT_EQ(0u, map.size());
+  EXPECT_EQ(0u, map.capacity());
+  EXPECT_TRUE(map.begin() == map.end());
+  EXPECT_TRUE(map.find(1) == map.end());
+  EXPECT_FALSE(map.contains(1));
+  EXPECT_EQ(0u, map.erase(1));
+}
+
+TEST(FlatHashMap, InsertFindErase) {
+  FlatHashMap<int, std::string> map;
+  auto result = map.insert({1, "one"});
+  EXPECT_TRUE(result.second);
+  EXPECT_EQ(1, result.first->first);
+  EXPECT_EQ("one", result.first->second);
+
+  // Inserting an existing key returns the existing value.
+  result = map.insert({1, "uno"});
+  EXPECT_FALSE(result.second);
+  EXPECT_EQ("one", result.first->second);
+
+  EXPECT_TRUE(map.emplace(2, "two").second);
+  EXPECT_EQ(2u, map.size());
+  EXPECT_EQ("two", map.find(2)->second);
+  EXPECT_EQ(1u, map.count(1));
+  EXPECT_EQ(0u, map.count(3));
+
+  EXPECT_EQ(1u, map.erase(1));
+  EXPECT_EQ(0u, map.erase(1));
+  EXPECT_FALSE(map.contains(1));
+  EXPECT_TRUE(map.contains(2));
+  EXPECT_EQ(1u, map.size());
+}
+
+TEST(FlatHashMap, ManyElements) {
+  constexpr int kCount = 10000;
+  FlatHashMap<int, int> map;
+  for (int i = 0; i < kCount; ++i)
+    EXPECT_TRUE(map.insert({i, -i}).second);
+  EXPECT_EQ(static_cast<size_t>(kCount), map.size());
+  // At most 7/8 of the slots are used.
+  EXPECT_GE(map.capacity() * 7 / 8, map.size());
+
+  for (int i = 0; i < kCount; ++i)
+    EXPECT_EQ(-i, map.at(i));
+  EXPECT_FALSE(map.contains(kCount));
+
+  // Every element is visited exactly once.
+  std::map<int, int> visited;
+  for (const auto& item : map)
+    EXPECT_TRUE(visited.insert(item).second);
+  EXPECT_EQ(static_cast<size_t>(kCount), visited.size());
+
+  for (int i = 0; i < kCount; i += 2)
+    EXPECT_EQ(1u, map.erase(i));
+  EXPECT_EQ(static_cast<size_t>(kCount / 2), map.size());
+  for (int i = 0; i < kCount; ++i)
+    EXPECT_EQ(i % 2 == 1, map.contains(i));
+}
+
+TEST(FlatHashMap, EraseAndReinsertDoesNotGrow) {
+  FlatHashMap<int, int> map;
+  map.reserve(100);
+  const size_t capacity = map.capacity();
+
+  // Erased slots are reclaimed rather than growing the map.
+  for (int i = 0; i < 100000; ++i) {
+    map[i] = i;
+    if (i >= 50) {
+      EXPECT_EQ(1u, map.erase(i - 50));
+    }
+  }
+  EXPECT_EQ(50u, map.size());
+  EXPECT_EQ(capacity, map.capacity());
+  for (int i = 100000 - 50; i < 100000; ++i)
+    EXPECT_EQ(i, map.at(i));
+}
+
+TEST(FlatHashMap, Collisions) {
+  FlatHashMap<int, int, CollidingHash> map;
+  for (int i = 0; i < 100; ++i)
+    map[i] = i;
+  for (int i = 0; i < 100; i += 3)
+    map.erase(i);
+  for (int i = 0; i < 100; ++i) {
+    if (i % 3)
+      EXPECT_EQ(i, map.at(i));
+    else
+      EXPECT_FALSE(map.contains(i));
+  }
+}
+
+TEST(FlatHashMap, EraseWhileIterating) {
+  FlatHashMap<int, int> map;
+  for (int i = 0; i < 100; ++i)
+    map[i] = i;
+  for (auto it = map.begin(); it != map.end();) {
+    if (it->first % 2)
+      it = map.erase(it);
+    else
+      ++it;
+  }
+  EXPECT_EQ(50u, map.size());
+  for (const auto& item : map)
+    EXPECT_EQ(0, item.first % 2);
+}
+
+TEST(FlatHashMap, StringKeys) {
+  FlatHashMap<std::string, int> map;
+  for (int i = 0; i < 1000; ++i)
+    map[NumberToString(i)] = i;
+  for (int i = 0; i < 1000; ++i)
+    EXPECT_EQ(i, map.at(NumberToString(i)));
+  EXPECT_FALSE(map.contains("1000"));
+}
+
+// Growing the table moves the keys, so they don't need to be copyable.
+TEST(FlatHashMap, MoveOnlyKeys) {
+  FlatHashMap<MoveOnlyInt, int, MoveOnlyIntHash> map;
+  for (int i = 0; i < 1000; ++i)
+    EXPECT_TRUE(map.try_emplace(MoveOnlyInt(i), i).second);
+  for (int i = 0; i < 1000; ++i)
+    EXPECT_EQ(i, map.at(MoveOnlyInt(i)));
+}
+
+TEST(FlatHashMap, SubscriptTryEmplaceInsertOrAssign) {
+  FlatHashMap<int, MoveOnlyInt> map;
+  EXPECT_EQ(MoveOnlyInt(1), map[1]);
+  map[1] = MoveOnlyInt(2);
+  EXPECT_EQ(MoveOnlyInt(2), map.at(1));
+
+  auto result = map.try_emplace(1, 3);
+  EXPECT_FALSE(result.second);
+  EXPECT_EQ(MoveOnlyInt(2), result.first->second);
+  result = map.try_emplace(4, 4);
+  EXPECT_TRUE(result.second);
+  EXPECT_EQ(MoveOnlyInt(4), result.first->second);
+
+  result = map.insert_or_assign(4, MoveOnlyInt(5));
+  EXPECT_FALSE(result.second);
+  EXPECT_EQ(MoveOnlyInt(5), map.at(4));
+  result = map.insert_or_assign(6, MoveOnlyInt(6));
+  EXPECT_TRUE(result.second);
+  EXPECT_EQ(3u, map.size());
+}
+
+TEST(FlatHashMap, CopyMoveSwap) {
+  FlatHashMap<int, std::string> original = {{1, "a"}, {2, "b"}, {3, "c"}};
+  FlatHashMap<int, std::string> copy(original);
+  EXPECT_EQ(original, copy);
+
+  copy[4] = "d";
+  EXPECT_NE(original, copy);
+  EXPECT_EQ(3u, original.size());
+
+  FlatHashMap<int, std::string> moved(std::move(copy));
+  EXPECT_EQ(4u, moved.size());
+  EXPECT_EQ("d", moved.at(4));
+
+  swap(original, moved);
+  EXPECT_EQ(4u, original.size());
+  EXPECT_EQ(3u, moved.size());
+
+  moved = original;
+  EXPECT_EQ(original, moved);
+  moved.clear();
+  EXPECT_TRUE(moved.empty());
+  EXPECT_FALSE(moved.contains(1));
+}
+
+TEST(FlatHashMap, ConstIterators) {
+  const FlatHashMap<int, int> map = {{1, 10}, {2, 20}};
+  int sum = 0;
+  for (FlatHashMap<int, int>::const_iterator it = map.cbegin();
+       it != map.cend(); ++it) {
+    sum += it->second;
+  }
+  EXPECT_EQ(30, sum);
+  EXPECT_EQ(20, map.at(2));
+  EXPECT_TRUE(map.find(3) == map.end());
+}
+
+TEST(FlatHashMap, CheckedIterators) {
+  FlatHashMap<int, int> map = {{1, 1}};
+  FlatHashMap<int, int> other = {{1, 1}};
+  ASSERT_DEATH_IF_SUPPORTED(*map.end(), "");
+  ASSERT_DEATH_IF_SUPPORTED(++map.end(), "");
+  ASSERT_DEATH_IF_SUPPORTED(ignore_result(map.begin() == other.begin()), "");
+  ASSERT_DEATH_IF_SUPPORTED(map.at(2), "");
+}
+
+}  // namespace base
@@ -0,0 +1,42 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef BASE_CONTAINERS_FLAT_HASH_SET_H_
+#define BASE_CONTAINERS_FLAT_HASH_SET_H_
+
+#include <functional>
+
+#include "base/containers/flat_hash_table.h"
+#include "base/containers/flat_tree.h"
+
+namespace base {
+
+// FlatHashSet is a container with a std::unordered_set-like interface that
+// stores its contents in one array, without a separate allocation per
+// element. It is to FlatHashMap what flat_set is to flat_map; see
+// flat_hash_map.h for its pros and cons.
+//
+// Please see //base/containers/README.md for an overview of which container
+// to select.
+//
+// The elements are const, so iterator and const_iterator both give const
+// access, and the functions available are those of FlatHashTable (see
+// flat_hash_table.h).
+//
+//   base::FlatHashSet<std::string> seen;
+//   if (!seen.insert(name).second)
+//     return;  // Duplicate.
+template <class Key,
+          class Hash = std::hash<Key>,
+          class KeyEqual = std::equal_to<Key>>
+using FlatHashSet = typename ::base::internal::FlatHashTable<
+    Key,
+    Key,
+    ::base::internal::GetKeyFromValueIdentity<Key>,
+    Hash,
+    KeyEqual>;
+
+}  // namespace base
+
+#endif  // BASE_CONTAINERS_FLAT_HASH_SET_H_
@@ -0,0 +1,51 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/containers/flat_hash_set.h"
+
+#include <set>
+#include <string>
+#include <type_traits>
+
+#include "testing/gtest/include/gtest/gtest.h"
+
+// A FlatHashSet is a FlatHashTable whose values are their keys. Most of the
+// table is tested through FlatHashMap in flat_hash_map_unittest.cc.
+
+namespace base {
+
+TEST(FlatHashSet, ConstIterators) {
+  using Set = FlatHashSet<int>;
+  static_assert(std::is_same<Set::iterator, Set::const_iterator>::value,
+                "The elements of a set must not be modified");
+  static_assert(std::is_same<const int&, Set::iterator::reference>::value,
+                "The elements of a set must not be modified");
+}
+
+TEST(FlatHashSet, InsertFindErase) {
+  FlatHashSet<std::string> set = {"a", "b", "c"};
+  EXPECT_EQ(3u, set.size());
+  EXPECT_FALSE(set.insert("a").second);
+  EXPECT_TRUE(set.insert("d").second);
+  EXPECT_TRUE(set.contains("d"));
+  EXPECT_EQ("b", *set.find("b"));
+
+  EXPECT_EQ(1u, set.erase("a"));
+  EXPECT_FALSE(set.contains("a"));
+  EXPECT_EQ(3u, set.size());
+
+  std::set<std::string> elements(set.begin(), set.end());
+  EXPECT_EQ((std::set<std::string>{"b", "c", "d"}), elements);
+}
+
+TEST(FlatHashSet, ManyElements) {
+  FlatHashSet<int> set;
+  for (int i = 0; i < 1000; ++i)
+    set.insert(i * 7);
+  EXPECT_EQ(1000u, set.size());
+  for (int i = 0; i < 7000; ++i)
+    EXPECT_EQ(i % 7 == 0, set.contains(i));
+}
+
+}  // namespace base
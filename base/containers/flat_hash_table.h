@@ -0,0 +1,638 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef BASE_CONTAINERS_FLAT_HASH_TABLE_H_
+#define BASE_CONTAINERS_FLAT_HASH_TABLE_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+#include "base/bits.h"
+#include "base/logging.h"
+#include "base/sys_byteorder.h"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace base {
+namespace internal {
+
+// The control byte of a slot of a FlatHashTable. A full slot stores the low 7
+// bits of the hash of its key ("H2"), so that most slots with another key can
+// be skipped without looking at them. Empty and deleted slots have the high
+// bit set.
+using HashCtrl = int8_t;
+constexpr HashCtrl kHashCtrlEmpty = -128;
+constexpr HashCtrl kHashCtrlDeleted = -2;
+
+inline bool IsHashCtrlFull(HashCtrl ctrl) {
+  return ctrl >= 0;
+}
+
+// A group of consecutive control bytes that are matched all at once. The
+// matches are returned as a bit mask, which HashGroup::LowestIndex() and
+// |mask &= mask - 1| turn into slot offsets from the start of the group.
+#if defined(__SSE2__)
+
+class HashGroup {
+ public:
+  using Mask = uint32_t;
+  static constexpr size_t kWidth = 16;
+
+  explicit HashGroup(const HashCtrl* ctrl)
+      : ctrl_(_mm_loadu_si128(reinterpret_cast<const __m128i*>(ctrl))) {}
+
+  // Returns the bytes equal to |h2|.
+  Mask Match(HashCtrl h2) const {
+    return static_cast<Mask>(
+        _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(h2), ctrl_)));
+  }
+
+  Mask MatchEmpty() const { return Match(kHashCtrlEmpty); }
+
+  Mask MatchEmptyOrDeleted() const {
+    return static_cast<Mask>(_mm_movemask_epi8(ctrl_));
+  }
+
+  static size_t LowestIndex(Mask mask) {
+    return bits::CountTrailingZeroBits(mask);
+  }
+
+ private:
+  __m128i ctrl_;
+};
+
+#else  // defined(__SSE2__)
+
+// Matches 8 bytes at once with 64-bit integer arithmetic. The result has the
+// high bit of each matching byte set.
+class HashGroup {
+ public:
+  using Mask = uint64_t;
+  static constexpr size_t kWidth = 8;
+
+  explicit HashGroup(const HashCtrl* ctrl) {
+    memcpy(&ctrl_, ctrl, sizeof(ctrl_));
+    ctrl_ = ByteSwapToLE64(ctrl_);
+  }
+
+  // Returns the bytes equal to |h2|. A byte that follows a match may be a
+  // false positive, so callers must still compare the keys.
+  Mask Match(HashCtrl h2) const {
+    const uint64_t x = ctrl_ ^ (kLsbs * static_cast<uint8_t>(h2));
+    return (x - kLsbs) & ~x & kMsbs;
+  }
+
+  // kHashCtrlEmpty is the only control byte with the high bit set and bit 1
+  // clear.
+  Mask MatchEmpty() const { return (ctrl_ & (~ctrl_ << 6)) & kMsbs; }
+
+  Mask MatchEmptyOrDeleted() const { return ctrl_ & kMsbs; }
+
+  static size_t LowestIndex(Mask mask) {
+    return bits::CountTrailingZeroBits(mask) >> 3;
+  }
+
+ private:
+  static constexpr uint64_t kLsbs = 0x0101010101010101ULL;
+  static constexpr uint64_t kMsbs = 0x8080808080808080ULL;
+
+  uint64_t ctrl_;
+};
+
+#endif  // defined(__SSE2__)
+
+// Implementation of an open addressing hash table, the shared part of
+// FlatHashMap and FlatHashSet.
+//
+// The table is an array of slots, each holding either a value or nothing, and
+// a parallel array of control bytes (see HashCtrl). A key is looked up by
+// probing groups of control bytes, starting at a position derived from the
+// high bits of its hash ("H1"), for bytes matching the low 7 bits of its hash,
+// until a group with an empty slot is found. Groups are matched with SSE2 when
+// available, and 8 bytes at a time otherwise.
+//
+// The capacity is a power of two, and at least one group. The control bytes
+// of the first group are repeated after the last slot, so that a group can be
+// loaded at any slot without wrapping around. At most 7/8 of the slots are
+// used, which keeps probe sequences short and guarantees that every probe
+// sequence ends at an empty slot.
+//
+// Erased slots are marked as deleted rather than empty, so that probe
+// sequences going past them are not cut short. They are reused by insertions,
+// and dropped when the table is rehashed.
+//
+// Iterators are checked: using an iterator past the end, or comparing
+// iterators of different tables, CHECKs. As with std::unordered_map, any
+// insertion may invalidate all iterators.
+template <class Key, class Value, class GetKeyFromValue, class Hash,
+          class KeyEqual>
+class FlatHashTable {
+ private:
+  template <bool kIsConst>
+  class IteratorImpl;
+
+ public:
+  using key_type = Key;
+  using value_type = Value;
+  using hasher = Hash;
+  using key_equal = KeyEqual;
+  using size_type = size_t;
+  using difference_type = ptrdiff_t;
+  using reference = value_type&;
+  using const_reference = const value_type&;
+  using pointer = value_type*;
+  using const_pointer = const value_type*;
+  // The values of a set are its keys, which must not be modified.
+  using iterator = IteratorImpl<std::is_same<Key, Value>::value>;
+  using const_iterator = IteratorImpl<true>;
+
+  // --------------------------------------------------------------------------
+  // Lifetime.
+
+  FlatHashTable() = default;
+
+  template <class InputIterator>
+  FlatHashTable(InputIterator first, InputIterator last) {
+    insert(first, last);
+  }
+
+  FlatHashTable(std::initializer_list<value_type> ilist)
+      : FlatHashTable(ilist.begin(), ilist.end()) {}
+
+  FlatHashTable(const FlatHashTable& other)
+      : hash_(other.hash_), key_equal_(other.key_equal_) {
+    reserve(other.size());
+    for (const value_type& value : other)
+      emplace_key_args(GetKeyFromValue()(value), value);
+  }
+
+  FlatHashTable(FlatHashTable&& other) noexcept
+      : hash_(std::move(other.hash_)), key_equal_(std::move(other.key_equal_)) {
+    swap(other);
+  }
+
+  ~FlatHashTable() { DestroyAndDeallocate(); }
+
+  FlatHashTable& operator=(const FlatHashTable& other) {
+    if (this != &other) {
+      FlatHashTable copy(other);
+      swap(copy);
+    }
+    return *this;
+  }
+
+  FlatHashTable& operator=(FlatHashTable&& other) noexcept {
+    FlatHashTable moved(std::move(other));
+    swap(moved);
+    return *this;
+  }
+
+  FlatHashTable& operator=(std::initializer_list<value_type> ilist) {
+    clear();
+    insert(ilist);
+    return *this;
+  }
+
+  // --------------------------------------------------------------------------
+  // Memory management.
+
+  // Makes room for |new_size| values without rehashing.
+  void reserve(size_type new_size) {
+    if (new_size <= size_ + growth_left_)
+      return;
+    size_type new_capacity = HashGroup::kWidth;
+    while (MaxSizeForCapacity(new_capacity) < new_size)
+      new_capacity *= 2;
+    Resize(new_capacity);
+  }
+
+  // Returns the number of slots.
+  size_type capacity() const { return capacity_; }
+
+  // --------------------------------------------------------------------------
+  // Size management.
+
+  void clear() {
+    DestroyAndDeallocate();
+    ctrl_ = nullptr;
+    slots_ = nullptr;
+    capacity_ = 0;
+    size_ = 0;
+    growth_left_ = 0;
+  }
+
+  size_type size() const { return size_; }
+  bool empty() const { return size_ == 0; }
+
+  // --------------------------------------------------------------------------
+  // Iterators. The iteration order is unspecified.
+
+  iterator begin() { return iterator(this, FirstFullSlot(0)); }
+  const_iterator begin() const {
+    return const_iterator(this, FirstFullSlot(0));
+  }
+  const_iterator cbegin() const { return begin(); }
+
+  iterator end() { return iterator(this, capacity_); }
+  const_iterator end() const { return const_iterator(this, capacity_); }
+  const_iterator cend() const { return end(); }
+
+  // --------------------------------------------------------------------------
+  // Insert operations.
+  //
+  // As with std::unordered_map, these return the existing value rather than
+  // replacing it if the key is already present.
+
+  std::pair<iterator, bool> insert(const value_type& value) {
+    return emplace_key_args(GetKeyFromValue()(value), value);
+  }
+
+  std::pair<iterator, bool> insert(value_type&& value) {
+    return emplace_key_args(GetKeyFromValue()(value), std::move(value));
+  }
+
+  template <class InputIterator>
+  void insert(InputIterator first, InputIterator last) {
+    for (; first != last; ++first)
+      insert(*first);
+  }
+
+  void insert(std::initializer_list<value_type> ilist) {
+    insert(ilist.begin(), ilist.end());
+  }
+
+  // Constructs the value before looking it up, which does extra work if the
+  // key is already present. Prefer try_emplace() for maps.
+  template <class... Args>
+  std::pair<iterator, bool> emplace(Args&&... args) {
+    return insert(value_type(std::forward<Args>(args)...));
+  }
+
+  // --------------------------------------------------------------------------
+  // Erase operations.
+
+  // Returns the iterator following |position|.
+  iterator erase(const_iterator position) {
+    CHECK(position.table_ == this);
+    CHECK_LT(position.index_, capacity_);
+    CHECK(IsHashCtrlFull(ctrl_[position.index_]));
+    EraseSlot(position.index_);
+    return iterator(this, FirstFullSlot(position.index_ + 1));
+  }
+
+  size_type erase(const key_type& key) {
+    const size_type index = FindIndex(key);
+    if (index == kNotFound)
+      return 0;
+    EraseSlot(index);
+    return 1;
+  }
+
+  // --------------------------------------------------------------------------
+  // Search operations.
+
+  iterator find(const key_type& key) {
+    const size_type index = FindIndex(key);
+    return iterator(this, index == kNotFound ? capacity_ : index);
+  }
+
+  const_iterator find(const key_type& key) const {
+    const size_type index = FindIndex(key);
+    return const_iterator(this, index == kNotFound ? capacity_ : index);
+  }
+
+  size_type count(const key_type& key) const {
+    return FindIndex(key) == kNotFound ? 0 : 1;
+  }
+
+  bool contains(const key_type& key) const {
+    return FindIndex(key) != kNotFound;
+  }
+
+  // --------------------------------------------------------------------------
+  // General operations.
+
+  void swap(FlatHashTable& other) noexcept {
+    using std::swap;
+    swap(ctrl_, other.ctrl_);
+    swap(slots_, other.slots_);
+    swap(capacity_, other.capacity_);
+    swap(size_, other.size_);
+    swap(growth_left_, other.growth_left_);
+    swap(hash_, other.hash_);
+    swap(key_equal_, other.key_equal_);
+  }
+
+  hasher hash_function() const { return hash_; }
+  key_equal key_eq() const { return key_equal_; }
+
+  friend bool operator==(const FlatHashTable& lhs, const FlatHashTable& rhs) {
+    if (lhs.size() != rhs.size())
+      return false;
+    for (const value_type& value : lhs) {
+      const_iterator it = rhs.find(GetKeyFromValue()(value));
+      if (it == rhs.end() || !(*it == value))
+        return false;
+    }
+    return true;
+  }
+
+  friend bool operator!=(const FlatHashTable& lhs, const FlatHashTable& rhs) {
+    return !(lhs == rhs);
+  }
+
+  friend void swap(FlatHashTable& lhs, FlatHashTable& rhs) noexcept {
+    lhs.swap(rhs);
+  }
+
+ protected:
+  static constexpr size_type kNotFound = static_cast<size_type>(-1);
+
+  // Returns the slot holding |key|, or kNotFound.
+  size_type FindIndex(const key_type& key) const {
+    return capacity_ ? FindIndex(key, HashOf(key)) : kNotFound;
+  }
+
+  // As above, with |hash| the result of HashOf(key).
+  size_type FindIndex(const key_type& key, size_t hash) const {
+    if (!capacity_)
+      return kNotFound;
+    const HashCtrl h2 = H2(hash);
+    ProbeSequence probe(H1(hash), capacity_);
+    while (true) {
+      const HashGroup group(ctrl_ + probe.offset());
+      for (auto mask = group.Match(h2); mask; mask &= mask - 1) {
+        const size_type index = probe.offset(HashGroup::LowestIndex(mask));
+        if (key_equal_(GetKeyFromValue()(slots_[index]), key))
+          return index;
+      }
+      if (group.MatchEmpty())
+        return kNotFound;
+      probe.Next();
+    }
+  }
+
+  // Constructs a value from |args| if |key|, which must be its key, is not
+  // present yet. Returns the value with |key| and whether it was inserted.
+  template <class... Args>
+  std::pair<iterator, bool> emplace_key_args(const key_type& key,
+                                             Args&&... args) {
+    const size_t hash = HashOf(key);
+    const size_type found = FindIndex(key, hash);
+    if (found != kNotFound)
+      return {iterator(this, found), false};
+    const size_type index = PrepareInsert(hash);
+    new (&slots_[index]) value_type(std::forward<Args>(args)...);
+    return {iterator(this, index), true};
+  }
+
+ private:
+  // Visits the groups of a table with triangular steps, which reaches every
+  // group of a table whose capacity is a power of two.
+  class ProbeSequence {
+   public:
+    ProbeSequence(size_t h1, size_type capacity)
+        : mask_(capacity - 1), offset_(h1 & mask_) {}
+
+    size_type offset() const { return offset_; }
+    size_type offset(size_type i) const { return (offset_ + i) & mask_; }
+
+    void Next() {
+      step_ += HashGroup::kWidth;
+      offset_ = (offset_ + step_) & mask_;
+    }
+
+   private:
+    const size_type mask_;
+    size_type offset_;
+    size_type step_ = 0;
+  };
+
+  // Mixes the bits of the hash so that H1 and H2 are independent even for
+  // hash functions, like std::hash<int>, that return their input.
+  size_t HashOf(const key_type& key) const {
+    const uint64_t hash =
+        static_cast<uint64_t>(hash_(key)) * 0x9E3779B97F4A7C15ULL;
+    return static_cast<size_t>(hash ^ (hash >> 32));
+  }
+
+  static size_t H1(size_t hash) { return hash >> 7; }
+  static HashCtrl H2(size_t hash) { return static_cast<HashCtrl>(hash & 0x7F); }
+
+  static size_type MaxSizeForCapacity(size_type capacity) {
+    return capacity - capacity / 8;
+  }
+
+  // Sets the control byte of |index|, and its copy after the last slot.
+  void SetCtrl(size_type index, HashCtrl ctrl) {
+    ctrl_[index] = ctrl;
+    if (index < HashGroup::kWidth - 1)
+      ctrl_[capacity_ + index] = ctrl;
+  }
+
+  // Returns the first empty or deleted slot in the probe sequence of |hash|.
+  size_type FindFirstNonFull(size_t hash) const {
+    ProbeSequence probe(H1(hash), capacity_);
+    while (true) {
+      const auto mask = HashGroup(ctrl_ + probe.offset()).MatchEmptyOrDeleted();
+      if (mask)
+        return probe.offset(HashGroup::LowestIndex(mask));
+      probe.Next();
+    }
+  }
+
+  // Returns a slot for a new value with |hash|, marked as full.
+  size_type PrepareInsert(size_t hash) {
+    size_type index = capacity_ ? FindFirstNonFull(hash) : 0;
+    // Reusing a deleted slot never runs out of empty slots.
+    if (!capacity_ ||
+        (growth_left_ == 0 && ctrl_[index] == kHashCtrlEmpty)) {
+      RehashAndGrowIfNecessary();
+      index = FindFirstNonFull(hash);
+    }
+    ++size_;
+    if (ctrl_[index] == kHashCtrlEmpty)
+      --growth_left_;
+    SetCtrl(index, H2(hash));
+    return index;
+  }
+
+  void RehashAndGrowIfNecessary() {
+    if (!capacity_) {
+      Resize(HashGroup::kWidth);
+    } else if (size_ <= MaxSizeForCapacity(capacity_) / 2) {
+      // Most of the used slots are deleted, so reclaim them instead of
+      // growing.
+      Resize(capacity_);
+    } else {
+      Resize(capacity_ * 2);
+    }
+  }
+
+  // Moves all values to new arrays with |new_capacity| slots, dropping the
+  // deleted slots.
+  void Resize(size_type new_capacity) {
+    DCHECK(bits::IsPowerOfTwo(new_capacity));
+    DCHECK_GE(new_capacity, HashGroup::kWidth);
+    HashCtrl* const old_ctrl = ctrl_;
+    value_type* const old_slots = slots_;
+    const size_type old_capacity = capacity_;
+
+    capacity_ = new_capacity;
+    ctrl_ = new HashCtrl[capacity_ + HashGroup::kWidth - 1];
+    memset(ctrl_, kHashCtrlEmpty, capacity_ + HashGroup::kWidth - 1);
+    slots_ = std::allocator<value_type>().allocate(capacity_);
+    growth_left_ = MaxSizeForCapacity(capacity_) - size_;
+
+    for (size_type i = 0; i < old_capacity; ++i) {
+      if (!IsHashCtrlFull(old_ctrl[i]))
+        continue;
+      const size_t hash = HashOf(GetKeyFromValue()(old_slots[i]));
+      const size_type index = FindFirstNonFull(hash);
+      SetCtrl(index, H2(hash));
+      RelocateValue(&old_slots[i], &slots_[index]);
+    }
+
+    if (old_capacity) {
+      delete[] old_ctrl;
+      std::allocator<value_type>().deallocate(old_slots, old_capacity);
+    }
+  }
+
+  // Moves the value at |from| to the uninitialized slot |to|, and destroys
+  // |from|.
+  template <class V>
+  static void RelocateValue(V* from, V* to) {
+    new (to) V(std::move(*from));
+    from->~V();
+  }
+
+  // The key of a map value is const, so moving the pair would copy the key.
+  // It is moved anyway, since |from| is destroyed right after.
+  template <class K, class M>
+  static void RelocateValue(std::pair<const K, M>* from,
+                            std::pair<const K, M>* to) {
+    new (to) std::pair<const K, M>(std::move(const_cast<K&>(from->first)),
+                                   std::move(from->second));
+    from->~pair();
+  }
+
+  void EraseSlot(size_type index) {
+    slots_[index].~value_type();
+    SetCtrl(index, kHashCtrlDeleted);
+    --size_;
+  }
+
+  // Returns the first full slot at or after |index|, or |capacity_|.
+  size_type FirstFullSlot(size_type index) const {
+    while (index < capacity_ && !IsHashCtrlFull(ctrl_[index]))
+      ++index;
+    return index;
+  }
+
+  void DestroyAndDeallocate() {
+    if (!capacity_)
+      return;
+    for (size_type i = 0; i < capacity_; ++i) {
+      if (IsHashCtrlFull(ctrl_[i]))
+        slots_[i].~value_type();
+    }
+    delete[] ctrl_;
+    std::allocator<value_type>().deallocate(slots_, capacity_);
+  }
+
+  // |capacity_| + HashGroup::kWidth - 1 control bytes, or null if there are
+  // no slots yet.
+  HashCtrl* ctrl_ = nullptr;
+  value_type* slots_ = nullptr;
+  size_type capacity_ = 0;
+  size_type size_ = 0;
+  // The number of values that can be inserted into empty slots before
+  // rehashing.
+  size_type growth_left_ = 0;
+
+  Hash hash_;
+  KeyEqual key_equal_;
+};
+
+template <class Key, class Value, class GetKeyFromValue, class Hash,
+          class KeyEqual>
+template <bool kIsConst>
+class FlatHashTable<Key, Value, GetKeyFromValue, Hash, KeyEqual>::IteratorImpl {
+ private:
+  using Table = FlatHashTable<Key, Value, GetKeyFromValue, Hash, KeyEqual>;
+  using TablePtr = std::conditional_t<kIsConst, const Table*, Table*>;
+
+ public:
+  using iterator_category = std::forward_iterator_tag;
+  using value_type = Value;
+  using difference_type = ptrdiff_t;
+  using reference = std::conditional_t<kIsConst, const Value&, Value&>;
+  using pointer = std::conditional_t<kIsConst, const Value*, Value*>;
+
+  IteratorImpl() = default;
+
+  // Converts an iterator to a const_iterator.
+  template <bool kOtherIsConst,
+            class = std::enable_if_t<kIsConst && !kOtherIsConst>>
+  IteratorImpl(const IteratorImpl<kOtherIsConst>& other)
+      : table_(other.table_), index_(other.index_) {}
+
+  reference operator*() const {
+    CHECK(table_);
+    CHECK_LT(index_, table_->capacity_);
+    CHECK(IsHashCtrlFull(table_->ctrl_[index_]));
+    return table_->slots_[index_];
+  }
+
+  pointer operator->() const { return &**this; }
+
+  IteratorImpl& operator++() {
+    CHECK(table_);
+    CHECK_LT(index_, table_->capacity_);
+    index_ = table_->FirstFullSlot(index_ + 1);
+    return *this;
+  }
+
+  IteratorImpl operator++(int) {
+    IteratorImpl result = *this;
+    ++*this;
+    return result;
+  }
+
+  friend bool operator==(const IteratorImpl& lhs, const IteratorImpl& rhs) {
+    CHECK_EQ(lhs.table_, rhs.table_);
+    return lhs.index_ == rhs.index_;
+  }
+
+  friend bool operator!=(const IteratorImpl& lhs, const IteratorImpl& rhs) {
+    return !(lhs == rhs);
+  }
+
+ private:
+  friend class FlatHashTable;
+  template <bool>
+  friend class IteratorImpl;
+
+  IteratorImpl(TablePtr table, size_type index)
+      : table_(table), index_(index) {}
+
+  TablePtr table_ = nullptr;
+  size_type index_ = 0;
+};
+
+}  // namespace internal
+}  // namespace base
+
+#endif  // BASE_CONTAINERS_FLAT_HASH_TABLE_H_
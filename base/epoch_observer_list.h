@@ -0,0 +1,329 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef BASE_EPOCH_OBSERVER_LIST_H_
+#define BASE_EPOCH_OBSERVER_LIST_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <algorithm>
+#include <iterator>
+#include <limits>
+#include <vector>
+
+#include "base/logging.h"
+#include "base/macros.h"
+#include "base/observer_list.h"
+#include "base/observer_list_internal.h"
+#include "base/sequence_checker.h"
+#include "base/stl_util.h"
+
+///////////////////////////////////////////////////////////////////////////////
+//
+// OVERVIEW:
+//
+//   A variant of ObserverList for hot notification paths. Observers live in a
+//   single contiguous vector and, like ObserverList, may be added or removed
+//   (including reentrantly, from inside a notification) without invalidating
+//   in-progress iterations.
+//
+//   Instead of registering every live iterator in a linked list of weak
+//   nodes, the list only counts how deeply it is being iterated. Removals
+//   made while the count is non-zero leave a tombstone behind, and the
+//   tombstones are compacted away when the outermost iteration finishes.
+//   Each compaction starts a new epoch; iterators remember the epoch they
+//   were created in so that DCHECK builds catch any index invalidated under
+//   them.
+//
+//   With ::Unchecked storage, advancing an iterator is a null check on a raw
+//   pointer and the whole iteration is inlined from this header.
+//
+//
+// WARNING:
+//
+//   Unlike ObserverList, an EpochObserverList must not be destroyed while it
+//   is being iterated, e.g. by an observer that deletes the list's owner.
+//   Use ObserverList where that can happen.
+//
+//   EpochObserverList is not thread-compatible; see ObserverList.
+//
+//
+// TYPICAL USAGE:
+//
+//   Same as ObserverList:
+//
+//     base::EpochObserverList<Observer>::Unchecked observers_;
+//     ...
+//     for (Observer& obs : observers_)
+//       obs.OnFoo(this);
+//
+///////////////////////////////////////////////////////////////////////////////
+
+namespace base {
+
+// When check_empty is true, assert that the list is empty on destruction.
+template <class ObserverType,
+          bool check_empty = false,
+          class ObserverStorageType = internal::CheckedObserverAdapter>
+class EpochObserverList {
+ public:
+  // See ObserverList::Unchecked.
+  using Unchecked = EpochObserverList<ObserverType,
+                                      check_empty,
+                                      internal::UncheckedObserverAdapter>;
+
+  // An iterator class that can be used to access the list of observers.
+  class Iter {
+   public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = ObserverType;
+    using difference_type = ptrdiff_t;
+    using pointer = ObserverType*;
+    using reference = ObserverType&;
+
+    Iter() = default;
+
+    explicit Iter(const EpochObserverList* list)
+        : list_(const_cast<EpochObserverList*>(list)),
+          max_index_(list->policy_ == ObserverListPolicy::ALL
+                         ? std::numeric_limits<size_t>::max()
+                         : list->observers_.size()) {
+      DCHECK(list);
+      Attach();
+      EnsureValidIndex();
+    }
+
+    ~Iter() { Detach(); }
+
+    Iter(const Iter& other)
+        : list_(other.list_),
+          index_(other.index_),
+          max_index_(other.max_index_) {
+      Attach();
+    }
+
+    Iter& operator=(const Iter& other) {
+      if (&other == this)
+        return *this;
+
+      Detach();
+      list_ = other.list_;
+      index_ = other.index_;
+      max_index_ = other.max_index_;
+      Attach();
+      return *this;
+    }
+
+    bool operator==(const Iter& other) const {
+      return (is_end() && other.is_end()) ||
+             (list_ == other.list_ && index_ == other.index_);
+    }
+
+    bool operator!=(const Iter& other) const { return !(*this == other); }
+
+    Iter& operator++() {
+      if (list_) {
+        ++index_;
+        EnsureValidIndex();
+      }
+      return *this;
+    }
+
+    Iter operator++(int) {
+      Iter it(*this);
+      ++(*this);
+      return it;
+    }
+
+    ObserverType* operator->() const {
+      ObserverType* const current = GetCurrent();
+      DCHECK(current);
+      return current;
+    }
+
+    ObserverType& operator*() const {
+      ObserverType* const current = GetCurrent();
+      DCHECK(current);
+      return *current;
+    }
+
+   private:
+    void Attach() {
+      if (!list_)
+        return;
+      if (list_->iteration_depth_++ == 0) {
+        // Bind to this sequence when creating the first iterator.
+        DCHECK_CALLED_ON_VALID_SEQUENCE(list_->iteration_sequence_checker_);
+      }
+      epoch_ = list_->epoch_;
+    }
+
+    void Detach() {
+      if (!list_)
+        return;
+      DCHECK_GT(list_->iteration_depth_, 0u);
+      if (--list_->iteration_depth_ == 0)
+        list_->OnIterationsFinished();
+      list_ = nullptr;
+    }
+
+    ObserverType* GetCurrent() const {
+      DCHECK(list_);
+      DCHECK_EQ(epoch_, list_->epoch_);
+      DCHECK_LT(index_, clamped_max_index());
+      return ObserverStorageType::template Get<ObserverType>(
+          list_->observers_[index_]);
+    }
+
+    void EnsureValidIndex() {
+      DCHECK(list_);
+      DCHECK_EQ(epoch_, list_->epoch_);
+      const size_t max_index = clamped_max_index();
+      while (index_ < max_index &&
+             list_->observers_[index_].IsMarkedForRemoval()) {
+        ++index_;
+      }
+    }
+
+    size_t clamped_max_index() const {
+      return std::min(max_index_, list_->observers_.size());
+    }
+
+    bool is_end() const { return !list_ || index_ == clamped_max_index(); }
+
+    EpochObserverList* list_ = nullptr;
+
+    // When initially constructed and each time the iterator is incremented,
+    // |index_| is guaranteed to point to a non-null index if the iterator
+    // has not reached the end of the list.
+    size_t index_ = 0;
+    size_t max_index_ = 0;
+
+    // Epoch of |list_| when this iterator was attached, checked on access.
+    uint32_t epoch_ = 0;
+  };
+
+  using iterator = Iter;
+  using const_iterator = Iter;
+  using value_type = ObserverType;
+
+  const_iterator begin() const {
+    return observers_.empty() ? const_iterator() : const_iterator(this);
+  }
+
+  const_iterator end() const { return const_iterator(); }
+
+  explicit EpochObserverList(
+      ObserverListPolicy policy = ObserverListPolicy::ALL)
+      : policy_(policy) {
+    // Sequence checks only apply when iterators are live.
+    DETACH_FROM_SEQUENCE(iteration_sequence_checker_);
+  }
+
+  ~EpochObserverList() {
+    DCHECK_EQ(0u, iteration_depth_)
+        << "EpochObserverList destroyed during iteration";
+    if (check_empty) {
+      Compact();
+      DCHECK(observers_.empty());
+    }
+  }
+
+  // Add an observer to this list. An observer should not be added to the same
+  // list more than once. Appending never moves existing observers relative to
+  // the indices held by live iterators, so it is safe during iteration.
+  //
+  // Precondition: obs != nullptr
+  // Precondition: !HasObserver(obs)
+  void AddObserver(ObserverType* obs) {
+    DCHECK(obs);
+    if (HasObserver(obs)) {
+      NOTREACHED() << "Observers can only be added once!";
+      return;
+    }
+    observers_.emplace_back(ObserverStorageType(obs));
+  }
+
+  // Removes the given observer from this list. Does nothing if this observer is
+  // not in this list.
+  void RemoveObserver(const ObserverType* obs) {
+    DCHECK(obs);
+    const auto it =
+        std::find_if(observers_.begin(), observers_.end(),
+                     [obs](const auto& o) { return o.IsEqual(obs); });
+    if (it == observers_.end())
+      return;
+
+    if (iteration_depth_ == 0) {
+      observers_.erase(it);
+    } else {
+      DCHECK_CALLED_ON_VALID_SEQUENCE(iteration_sequence_checker_);
+      it->MarkForRemoval();
+      has_tombstones_ = true;
+    }
+  }
+
+  // Determine whether a particular observer is in the list.
+  bool HasObserver(const ObserverType* obs) const {
+    if (obs == nullptr)
+      return false;
+    return std::find_if(observers_.begin(), observers_.end(),
+                        [obs](const auto& o) { return o.IsEqual(obs); }) !=
+           observers_.end();
+  }
+
+  // Removes all the observers from this list.
+  void Clear() {
+    if (iteration_depth_ == 0) {
+      observers_.clear();
+    } else {
+      DCHECK_CALLED_ON_VALID_SEQUENCE(iteration_sequence_checker_);
+      for (auto& observer : observers_)
+        observer.MarkForRemoval();
+      has_tombstones_ = !observers_.empty();
+    }
+  }
+
+  bool might_have_observers() const { return !observers_.empty(); }
+
+ private:
+  // Called when the last live iterator goes away.
+  void OnIterationsFinished() {
+    // Detaching is safe because no iterator is left to be on another sequence.
+    DETACH_FROM_SEQUENCE(iteration_sequence_checker_);
+    if (has_tombstones_)
+      Compact();
+  }
+
+  // Compacts list of observers by removing those marked for removal.
+  void Compact() {
+    DCHECK_EQ(0u, iteration_depth_);
+    EraseIf(observers_, [](const auto& o) { return o.IsMarkedForRemoval(); });
+    has_tombstones_ = false;
+    ++epoch_;
+  }
+
+  std::vector<ObserverStorageType> observers_;
+
+  // Number of live iterators. Removals are deferred while this is non-zero.
+  size_t iteration_depth_ = 0;
+
+  // Whether |observers_| has entries marked for removal.
+  bool has_tombstones_ = false;
+
+  // Incremented every time entries are compacted away, which is the only time
+  // indices into |observers_| are invalidated.
+  uint32_t epoch_ = 0;
+
+  const ObserverListPolicy policy_;
+
+  SEQUENCE_CHECKER(iteration_sequence_checker_);
+
+  DISALLOW_COPY_AND_ASSIGN(EpochObserverList);
+};
+
+}  // namespace base
+
+#endif  // BASE_EPOCH_OBSERVER_LIST_H_
@@ -0,0 +1,266 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/epoch_observer_list.h"
+
+#include <memory>
+
+#include "base/observer_list_types.h"
+#include "base/test/gtest_util.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace base {
+namespace {
+
+class Foo {
+ public:
+  virtual void Observe(int x) = 0;
+  virtual ~Foo() = default;
+  virtual int GetValue() const { return 0; }
+};
+
+class Adder : public Foo {
+ public:
+  explicit Adder(int scaler) : scaler_(scaler) {}
+  ~Adder() override = default;
+
+  void Observe(int x) override { total += x * scaler_; }
+  int GetValue() const override { return total; }
+
+  int total = 0;
+
+ private:
+  int scaler_;
+};
+
+class CheckedAdder : public CheckedObserver, public Adder {
+ public:
+  explicit CheckedAdder(int scaler) : Adder(scaler) {}
+};
+
+using List = EpochObserverList<Foo>::Unchecked;
+
+// Removes |doomed| from |list| (which may be itself) when notified.
+class Disrupter : public Foo {
+ public:
+  Disrupter(List* list, Foo* doomed) : list_(list), doomed_(doomed) {}
+  ~Disrupter() override = default;
+
+  void Observe(int x) override {
+    ++count;
+    if (doomed_)
+      list_->RemoveObserver(doomed_);
+  }
+
+  int count = 0;
+
+ private:
+  List* list_;
+  Foo* doomed_;
+};
+
+// Adds |to_add| to |list| the first time it is notified.
+class AddInObserve : public Foo {
+ public:
+  AddInObserve(List* list, Foo* to_add) : list_(list), to_add_(to_add) {}
+  ~AddInObserve() override = default;
+
+  void Observe(int x) override {
+    if (to_add_) {
+      list_->AddObserver(to_add_);
+      to_add_ = nullptr;
+    }
+  }
+
+ private:
+  List* list_;
+  Foo* to_add_;
+};
+
+}  // namespace
+
+TEST(EpochObserverListTest, BasicTest) {
+  List list;
+  Adder a(1), b(-1), c(1), d(-1), e(-1);
+  Disrupter evil(&list, &c);
+
+  list.AddObserver(&a);
+  list.AddObserver(&b);
+  EXPECT_TRUE(list.HasObserver(&a));
+  EXPECT_FALSE(list.HasObserver(&c));
+
+  for (auto& observer : list)
+    observer.Observe(10);
+
+  list.AddObserver(&evil);
+  list.AddObserver(&c);
+  list.AddObserver(&d);
+
+  // Removing an observer not in the list should do nothing.
+  list.RemoveObserver(&e);
+
+  for (auto& observer : list)
+    observer.Observe(10);
+
+  EXPECT_EQ(20, a.total);
+  EXPECT_EQ(-20, b.total);
+  EXPECT_EQ(0, c.total);
+  EXPECT_EQ(-10, d.total);
+  EXPECT_EQ(0, e.total);
+  EXPECT_EQ(1, evil.count);
+
+  // The tombstone left by |evil| is compacted once the iteration is over.
+  int count = 0;
+  for (auto& observer : list) {
+    observer.GetValue();
+    ++count;
+  }
+  EXPECT_EQ(4, count);
+}
+
+TEST(EpochObserverListTest, CheckedObservers) {
+  EpochObserverList<CheckedAdder> list;
+  CheckedAdder a(1), b(-1);
+
+  list.AddObserver(&a);
+  list.AddObserver(&b);
+  for (auto& observer : list)
+    observer.Observe(10);
+  list.RemoveObserver(&a);
+  for (auto& observer : list)
+    observer.Observe(10);
+
+  EXPECT_EQ(10, a.total);
+  EXPECT_EQ(-20, b.total);
+  EXPECT_TRUE(b.IsInObserverList());
+}
+
+TEST(EpochObserverListTest, RemoveLaterObserverDuringIteration) {
+  List list;
+  Adder a(1), b(1);
+  Disrupter doomed(&list, nullptr);
+  Disrupter remover(&list, &doomed);
+
+  list.AddObserver(&a);
+  list.AddObserver(&remover);
+  list.AddObserver(&b);
+  list.AddObserver(&doomed);
+
+  for (auto& observer : list)
+    observer.Observe(1);
+
+  EXPECT_EQ(1, a.total);
+  EXPECT_EQ(1, b.total);
+  EXPECT_EQ(1, remover.count);
+  EXPECT_EQ(0, doomed.count);
+  EXPECT_FALSE(list.HasObserver(&doomed));
+}
+
+TEST(EpochObserverListTest, AddDuringIteration) {
+  List list;
+  List existing_only(ObserverListPolicy::EXISTING_ONLY);
+  Adder a(1), b(1);
+  AddInObserve adder(&list, &b);
+  AddInObserve existing_adder(&existing_only, &b);
+
+  list.AddObserver(&a);
+  list.AddObserver(&adder);
+  existing_only.AddObserver(&a);
+  existing_only.AddObserver(&existing_adder);
+
+  // Observers appended mid-iteration are notified by default, and the vector
+  // growing under the iteration does not invalidate it.
+  for (auto& observer : list)
+    observer.Observe(1);
+  EXPECT_EQ(1, a.total);
+  EXPECT_EQ(1, b.total);
+
+  for (auto& observer : existing_only)
+    observer.Observe(1);
+  EXPECT_EQ(2, a.total);
+  EXPECT_EQ(1, b.total);
+  EXPECT_TRUE(existing_only.HasObserver(&b));
+}
+
+TEST(EpochObserverListTest, NestedIteration) {
+  List list;
+  Adder a(1), b(1), c(1);
+  list.AddObserver(&a);
+  list.AddObserver(&b);
+  list.AddObserver(&c);
+
+  int outer = 0;
+  for (auto& observer : list) {
+    ++outer;
+    int inner = 0;
+    for (auto& nested : list) {
+      nested.Observe(1);
+      ++inner;
+    }
+    // Removal inside the nested loop must not disturb the outer one.
+    if (&observer == &a)
+      list.RemoveObserver(&b);
+    EXPECT_EQ(&observer == &a ? 3 : 2, inner);
+  }
+  EXPECT_EQ(2, outer);
+  EXPECT_EQ(2, a.total);
+  EXPECT_EQ(1, b.total);
+  EXPECT_EQ(2, c.total);
+  EXPECT_FALSE(list.HasObserver(&b));
+}
+
+TEST(EpochObserverListTest, ClearDuringIteration) {
+  List list;
+  Adder a(1), b(1);
+  list.AddObserver(&a);
+  list.AddObserver(&b);
+
+  for (auto& observer : list) {
+    observer.Observe(1);
+    list.Clear();
+  }
+
+  EXPECT_EQ(1, a.total);
+  EXPECT_EQ(0, b.total);
+  EXPECT_FALSE(list.might_have_observers());
+}
+
+TEST(EpochObserverListTest, IteratorOutlivesLoop) {
+  List list;
+  Adder a(1), b(1);
+  list.AddObserver(&a);
+  list.AddObserver(&b);
+
+  // A copied iterator keeps removals deferred until it is gone too.
+  auto it = std::make_unique<List::Iter>(list.begin());
+  list.RemoveObserver(&a);
+  EXPECT_TRUE(list.might_have_observers());
+  EXPECT_FALSE(list.HasObserver(&a));
+  ++(*it);
+  EXPECT_EQ(&b, &**it);
+  it.reset();
+
+  int count = 0;
+  for (auto& observer : list) {
+    EXPECT_EQ(&b, &observer);
+    ++count;
+  }
+  EXPECT_EQ(1, count);
+}
+
+TEST(EpochObserverListTest, DestroyDuringIteration) {
+  auto list = std::make_unique<List>();
+  Adder a(1);
+  list->AddObserver(&a);
+
+  EXPECT_DCHECK_DEATH({
+    for (auto& observer : *list) {
+      observer.Observe(1);
+      list.reset();
+      break;
+    }
+  });
+}
+
+}  // namespace base
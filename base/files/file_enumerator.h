@@ -73,6 +73,10 @@ class BASE_EXPORT FileEnumerator {
 #elif defined(OS_POSIX) || defined(OS_FUCHSIA)
     struct stat stat_;
     FilePath filename_;
+
+    // Whether |stat_| has been filled in. Until then, only the S_IFDIR bit of
+    // its mode is valid.
+    bool has_stat_ = false;
 #endif
   };
 
@@ -134,7 +138,8 @@ class BASE_EXPORT FileEnumerator {
   // then so will be the result of Next().
   FilePath Next();
 
-  // Write the file info into |info|.
+  // Write the file info into |info|. On POSIX, this may need to stat() the
+  // current file, so callers that only need names should not call it.
   FileInfo GetInfo() const;
 
  private:
@@ -0,0 +1,68 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/files/file_enumerator.h"
+
+#include "base/files/file_path.h"
+#include "base/files/file_util.h"
+#include "base/files/scoped_temp_dir.h"
+#include "base/strings/stringprintf.h"
+#include "base/time/time.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "testing/perf/perf_test.h"
+
+namespace base {
+
+namespace {
+
+constexpr int kNumFiles = 100000;
+
+class FileEnumeratorPerfTest : public testing::Test {
+ public:
+  void SetUp() override {
+    ASSERT_TRUE(temp_dir_.CreateUniqueTempDir());
+    for (int i = 0; i < kNumFiles; ++i) {
+      ASSERT_EQ(0, WriteFile(temp_dir_.GetPath().AppendASCII(
+                                 StringPrintf("file%d", i)),
+                             "", 0));
+    }
+  }
+
+ protected:
+  // Enumerates the files of the directory, calling GetInfo() for each if
+  // |get_info| is true, and reports how long that took.
+  void MeasureEnumeration(const char* story, bool get_info) {
+    int num_files = 0;
+    int64_t total_size = 0;
+    TimeTicks start = TimeTicks::Now();
+    FileEnumerator enumerator(temp_dir_.GetPath(), false /* recursive */,
+                              FileEnumerator::FILES);
+    for (FilePath path = enumerator.Next(); !path.empty();
+         path = enumerator.Next()) {
+      ++num_files;
+      if (get_info)
+        total_size += enumerator.GetInfo().GetSize();
+    }
+    TimeDelta elapsed = TimeTicks::Now() - start;
+    EXPECT_EQ(kNumFiles, num_files);
+    EXPECT_EQ(0, total_size);
+    perf_test::PrintResult("file_enumerator", "", story,
+                           elapsed.InMillisecondsF(), "ms", true);
+  }
+
+ private:
+  ScopedTempDir temp_dir_;
+};
+
+}  // namespace
+
+TEST_F(FileEnumeratorPerfTest, Names) {
+  MeasureEnumeration("names", false /* get_info */);
+}
+
+TEST_F(FileEnumeratorPerfTest, NamesAndInfo) {
+  MeasureEnumeration("names_and_info", true /* get_info */);
+}
+
+}  // namespace base
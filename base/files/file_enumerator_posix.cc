@@ -6,9 +6,11 @@
 
 #include <dirent.h>
 #include <errno.h>
+#include <fcntl.h>
 #include <fnmatch.h>
 #include <stdint.h>
 #include <string.h>
+#include <sys/stat.h>
 
 #include "base/logging.h"
 #include "base/threading/scoped_blocking_call.h"
@@ -30,6 +32,23 @@ void GetStat(const FilePath& path, bool show_links, struct stat* st) {
   }
 }
 
+// Same as GetStat(), for the entry |name| of the open directory |dir|. This
+// avoids resolving the full path of every entry of large directories.
+void GetStatAt(DIR* dir,
+               const char* name,
+               const FilePath& path,
+               bool show_links,
+               struct stat* st) {
+  DCHECK(st);
+  const int res = fstatat(dirfd(dir), name, st,
+                          show_links ? AT_SYMLINK_NOFOLLOW : 0);
+  if (res < 0) {
+    if (!(errno == ENOENT && !show_links))
+      DPLOG(ERROR) << "Couldn't stat" << path.value();
+    memset(st, 0, sizeof(*st));
+  }
+}
+
 }  // namespace
 
 // FileEnumerator::FileInfo ----------------------------------------------------
@@ -129,6 +148,7 @@ FilePath FileEnumerator::Next() {
     // is useful it should be resolvable locally.
     FileInfo dotdot;
     dotdot.stat_.st_mode = S_IFDIR;
+    dotdot.has_stat_ = true;
     dotdot.filename_ = FilePath("..");
     if (!ShouldSkip(dotdot.filename_)) {
       directory_entries_.push_back(std::move(dotdot));
@@ -161,9 +181,25 @@ FilePath FileEnumerator::Next() {
 
       const FilePath full_path = root_path_.Append(info.filename_);
       const bool show_sym_links = file_type_ & SHOW_SYM_LINKS;
-      GetStat(full_path, show_sym_links, &info.stat_);
 
-      const bool is_dir = info.IsDirectory();
+      // The type of the entry usually comes with it, in which case stat() is
+      // deferred until GetInfo() is called for it, if ever. Symlinks that are
+      // followed need stat() to find what they point to, and so do directories
+      // when recursing through symlinks, to detect cycles by inode.
+      const bool type_known =
+          dent->d_type != DT_UNKNOWN &&
+          (show_sym_links || dent->d_type != DT_LNK);
+      bool is_dir;
+      if (type_known &&
+          (show_sym_links || !recursive_ || dent->d_type != DT_DIR)) {
+        is_dir = dent->d_type == DT_DIR;
+        if (is_dir)
+          info.stat_.st_mode = S_IFDIR;
+      } else {
+        GetStatAt(dir, dent->d_name, full_path, show_sym_links, &info.stat_);
+        info.has_stat_ = true;
+        is_dir = info.IsDirectory();
+      }
 
       // Recursive mode: schedule traversal of a directory if either
       // SHOW_SYM_LINKS is on or we haven't visited the directory yet.
@@ -189,7 +225,13 @@ FilePath FileEnumerator::Next() {
 }
 
 FileEnumerator::FileInfo FileEnumerator::GetInfo() const {
-  return directory_entries_[current_directory_entry_];
+  FileInfo info = directory_entries_[current_directory_entry_];
+  if (!info.has_stat_) {
+    GetStat(root_path_.Append(info.filename_), file_type_ & SHOW_SYM_LINKS,
+            &info.stat_);
+    info.has_stat_ = true;
+  }
+  return info;
 }
 
 bool FileEnumerator::IsPatternMatched(const FilePath& path) const {
@@ -231,6 +231,39 @@ TEST(FileEnumerator, FolderAndFileInFolder) {
   }
 }
 
+TEST(FileEnumerator, GetInfo) {
+  ScopedTempDir temp_dir;
+  ASSERT_TRUE(temp_dir.CreateUniqueTempDir());
+
+  const FilePath& path = temp_dir.GetPath();
+
+  const FilePath subdir = path.AppendASCII("subdir");
+  ASSERT_TRUE(CreateDirectory(subdir));
+  const FilePath file = path.AppendASCII("test.txt");
+  ASSERT_TRUE(CreateDummyFile(file));
+
+  for (bool recursive : {false, true}) {
+    FileEnumerator enumerator(
+        path, recursive, FileEnumerator::FILES | FileEnumerator::DIRECTORIES);
+    int num_entries = 0;
+    for (FilePath entry = enumerator.Next(); !entry.empty();
+         entry = enumerator.Next()) {
+      ++num_entries;
+      FileEnumerator::FileInfo info = enumerator.GetInfo();
+      EXPECT_EQ(entry.BaseName(), info.GetName());
+      if (entry == subdir) {
+        EXPECT_TRUE(info.IsDirectory());
+      } else {
+        EXPECT_EQ(file, entry);
+        EXPECT_FALSE(info.IsDirectory());
+        EXPECT_EQ(static_cast<int64_t>(sizeof("42")), info.GetSize());
+        EXPECT_FALSE(info.GetLastModifiedTime().is_null());
+      }
+    }
+    EXPECT_EQ(2, num_entries);
+  }
+}
+
 TEST(FileEnumerator, FilesInParentFolderAlwaysFirst) {
   ScopedTempDir temp_dir;
   ASSERT_TRUE(temp_dir.CreateUniqueTempDir());
@@ -75,8 +75,9 @@ class InotifyReader {
   // Remove |watch| if it's valid.
   void RemoveWatch(Watch watch, FilePathWatcherImpl* watcher);
 
-  // Callback for InotifyReaderTask.
-  void OnInotifyEvent(const inotify_event* event);
+  // Callback for InotifyReaderTask. |events| are all the events read from the
+  // inotify fd at once, so that each watcher is notified once per batch.
+  void OnInotifyEvents(const std::vector<const inotify_event*>& events);
 
  private:
   friend struct LazyInstanceTraitsBase<InotifyReader>;
@@ -109,28 +110,41 @@ class InotifyReader {
 
 class FilePathWatcherImpl : public FilePathWatcher::PlatformDelegate {
  public:
-  FilePathWatcherImpl();
-  ~FilePathWatcherImpl() override;
-
-  // Called for each event coming from the watch. |fired_watch| identifies the
-  // watch that fired, |child| indicates what has changed, and is relative to
-  // the currently watched path for |fired_watch|.
+  // An event coming from a watch. |fired_watch| identifies the watch that
+  // fired, |child| indicates what has changed, and is relative to the
+  // currently watched path for |fired_watch|.
   //
   // |created| is true if the object appears.
   // |deleted| is true if the object disappears.
   // |is_dir| is true if the object is a directory.
-  void OnFilePathChanged(InotifyReader::Watch fired_watch,
-                         const FilePath::StringType& child,
-                         bool created,
-                         bool deleted,
-                         bool is_dir);
+  struct Change {
+    bool operator==(const Change& other) const {
+      return fired_watch == other.fired_watch && child == other.child &&
+             created == other.created && deleted == other.deleted &&
+             is_dir == other.is_dir;
+    }
+
+    InotifyReader::Watch fired_watch;
+    FilePath::StringType child;
+    bool created;
+    bool deleted;
+    bool is_dir;
+  };
+
+  FilePathWatcherImpl();
+  ~FilePathWatcherImpl() override;
+
+  // Called with the events read from the watches in one batch, in order.
+  void OnFilePathChanged(std::vector<Change> changes);
 
  private:
-  void OnFilePathChangedOnOriginSequence(InotifyReader::Watch fired_watch,
-                                         const FilePath::StringType& child,
-                                         bool created,
-                                         bool deleted,
-                                         bool is_dir);
+  void OnFilePathChangedOnOriginSequence(const std::vector<Change>& changes);
+
+  // Updates the watches for |change|. Returns true if |change| affects
+  // |target_| and so must be reported. |updated_watches| is set once
+  // UpdateWatches() has run, after which the other changes in the same batch
+  // don't need to run it again.
+  bool ProcessChange(const Change& change, bool* updated_watches);
 
   // Start watching |path| for changes and notify |delegate| on each change.
   // Returns true if watch for |path| has been added successfully.
@@ -223,6 +237,10 @@ void InotifyReaderThreadDelegate::ThreadMain() {
   CHECK_LE(0, inotify_fd_);
   CHECK_GT(FD_SETSIZE, inotify_fd_);
 
+  // Reused across reads to avoid reallocating for every batch of events.
+  std::vector<char> buffer;
+  std::vector<const inotify_event*> events;
+
   while (true) {
     fd_set rfds;
     FD_ZERO(&rfds);
@@ -248,7 +266,7 @@ void InotifyReaderThreadDelegate::ThreadMain() {
       return;
     }
 
-    std::vector<char> buffer(buffer_size);
+    buffer.resize(buffer_size);
 
     ssize_t bytes_read =
         HANDLE_EINTR(read(inotify_fd_, &buffer[0], buffer_size));
@@ -258,14 +276,16 @@ void InotifyReaderThreadDelegate::ThreadMain() {
       return;
     }
 
+    events.clear();
     ssize_t i = 0;
     while (i < bytes_read) {
       inotify_event* event = reinterpret_cast<inotify_event*>(&buffer[i]);
       size_t event_size = sizeof(inotify_event) + event->len;
       DCHECK(i + event_size <= static_cast<size_t>(bytes_read));
-      g_inotify_reader.Get().OnInotifyEvent(event);
+      events.push_back(event);
       i += event_size;
     }
+    g_inotify_reader.Get().OnInotifyEvents(events);
   }
 }
 
@@ -326,18 +346,42 @@ void InotifyReader::RemoveWatch(Watch watch, FilePathWatcherImpl* watcher) {
   }
 }
 
-void InotifyReader::OnInotifyEvent(const inotify_event* event) {
-  if (event->mask & IN_IGNORED)
-    return;
+void InotifyReader::OnInotifyEvents(
+    const std::vector<const inotify_event*>& events) {
+  std::unordered_map<FilePathWatcherImpl*,
+                     std::vector<FilePathWatcherImpl::Change>>
+      changes_by_watcher;
 
-  FilePath::StringType child(event->len ? event->name : FILE_PATH_LITERAL(""));
   AutoLock auto_lock(lock_);
 
-  auto& watcher_set = watchers_[event->wd];
-  for (FilePathWatcherImpl* watcher : watcher_set) {
-    watcher->OnFilePathChanged(
-        event->wd, child, event->mask & (IN_CREATE | IN_MOVED_TO),
-        event->mask & (IN_DELETE | IN_MOVED_FROM), event->mask & IN_ISDIR);
+  for (const inotify_event* event : events) {
+    if (event->mask & IN_IGNORED)
+      continue;
+
+    auto it = watchers_.find(event->wd);
+    if (it == watchers_.end())
+      continue;
+
+    FilePathWatcherImpl::Change change = {
+        event->wd,
+        event->len ? event->name : FILE_PATH_LITERAL(""),
+        (event->mask & (IN_CREATE | IN_MOVED_TO)) != 0,
+        (event->mask & (IN_DELETE | IN_MOVED_FROM)) != 0,
+        (event->mask & IN_ISDIR) != 0};
+    for (FilePathWatcherImpl* watcher : it->second) {
+      std::vector<FilePathWatcherImpl::Change>& changes =
+          changes_by_watcher[watcher];
+      // Coalesce repeated events, e.g. for a file that is written in several
+      // chunks, since they are handled identically.
+      if (!changes.empty() && changes.back() == change)
+        continue;
+      changes.push_back(change);
+    }
+  }
+
+  for (auto& watcher_and_changes : changes_by_watcher) {
+    watcher_and_changes.first->OnFilePathChanged(
+        std::move(watcher_and_changes.second));
   }
 }
 
@@ -349,11 +393,7 @@ FilePathWatcherImpl::~FilePathWatcherImpl() {
   DCHECK(!task_runner() || task_runner()->RunsTasksInCurrentSequence());
 }
 
-void FilePathWatcherImpl::OnFilePathChanged(InotifyReader::Watch fired_watch,
-                                            const FilePath::StringType& child,
-                                            bool created,
-                                            bool deleted,
-                                            bool is_dir) {
+void FilePathWatcherImpl::OnFilePathChanged(std::vector<Change> changes) {
   DCHECK(!task_runner()->RunsTasksInCurrentSequence());
 
   // This method is invoked on the Inotify thread. Switch to task_runner() to
@@ -362,19 +402,34 @@ void FilePathWatcherImpl::OnFilePathChanged(InotifyReader::Watch fired_watch,
   task_runner()->PostTask(
       FROM_HERE,
       BindOnce(&FilePathWatcherImpl::OnFilePathChangedOnOriginSequence,
-               weak_ptr_, fired_watch, child, created, deleted, is_dir));
+               weak_ptr_, std::move(changes)));
 }
 
 void FilePathWatcherImpl::OnFilePathChangedOnOriginSequence(
-    InotifyReader::Watch fired_watch,
-    const FilePath::StringType& child,
-    bool created,
-    bool deleted,
-    bool is_dir) {
+    const std::vector<Change>& changes) {
   DCHECK(task_runner()->RunsTasksInCurrentSequence());
   DCHECK(!watches_.empty());
   DCHECK(HasValidWatchVector());
 
+  // All the changes are processed before |callback_| runs, at most once for
+  // the whole batch, since it may delete |this|.
+  bool updated_watches = false;
+  bool target_changed = false;
+  for (const Change& change : changes)
+    target_changed |= ProcessChange(change, &updated_watches);
+
+  if (target_changed)
+    callback_.Run(target_, false /* error */);
+}
+
+bool FilePathWatcherImpl::ProcessChange(const Change& change,
+                                        bool* updated_watches) {
+  const InotifyReader::Watch fired_watch = change.fired_watch;
+  const FilePath::StringType& child = change.child;
+  const bool created = change.created;
+  const bool deleted = change.deleted;
+  const bool is_dir = change.is_dir;
+
   // Used below to avoid multiple recursive updates.
   bool did_update = false;
 
@@ -423,7 +478,10 @@ void FilePathWatcherImpl::OnFilePathChangedOnOriginSequence(
     // to symlinks on the target path will not have IN_ISDIR set in the event
     // masks. As a result we may sometimes call UpdateWatches() unnecessarily.
     if (change_on_target_path && (created || deleted) && !did_update) {
-      UpdateWatches();
+      if (!*updated_watches) {
+        UpdateWatches();
+        *updated_watches = true;
+      }
       did_update = true;
     }
 
@@ -437,20 +495,18 @@ void FilePathWatcherImpl::OnFilePathChangedOnOriginSequence(
     if (target_changed ||
         (change_on_target_path && deleted) ||
         (change_on_target_path && created && PathExists(target_))) {
-      if (!did_update) {
+      if (!did_update)
         UpdateRecursiveWatches(fired_watch, is_dir);
-        did_update = true;
-      }
-      callback_.Run(target_, false /* error */);
-      return;
+      return true;
     }
   }
 
   if (ContainsKey(recursive_paths_by_watch_, fired_watch)) {
     if (!did_update)
       UpdateRecursiveWatches(fired_watch, is_dir);
-    callback_.Run(target_, false /* error */);
+    return true;
   }
+  return false;
 }
 
 bool FilePathWatcherImpl::Watch(const FilePath& path,
@@ -541,6 +541,37 @@ TEST_F(FilePathWatcherTest, RecursiveWatch) {
   ASSERT_TRUE(WaitForEvents());
 }
 
+// Creates a directory tree and writes files at once, so that the watcher gets
+// many events together, and verifies that the new directories are watched.
+TEST_F(FilePathWatcherTest, RecursiveWatchNestedDirectories) {
+  FilePathWatcher watcher;
+  FilePath dir(temp_dir_.GetPath().AppendASCII("dir"));
+  ASSERT_TRUE(base::CreateDirectory(dir));
+  std::unique_ptr<TestDelegate> delegate(new TestDelegate(collector()));
+  bool setup_result = SetupWatch(dir, &watcher, delegate.get(), true);
+  if (!FilePathWatcher::RecursiveWatchAvailable()) {
+    ASSERT_FALSE(setup_result);
+    return;
+  }
+  ASSERT_TRUE(setup_result);
+
+  // Create "$dir/a/b/c" and a few files in each directory.
+  FilePath deepest_dir(dir.AppendASCII("a").AppendASCII("b").AppendASCII("c"));
+  ASSERT_TRUE(base::CreateDirectory(deepest_dir));
+  for (FilePath current = deepest_dir; current != dir;
+       current = current.DirName()) {
+    for (int i = 0; i < 3; ++i) {
+      ASSERT_TRUE(
+          WriteFile(current.AppendASCII(StringPrintf("file%d", i)), "content"));
+    }
+  }
+  ASSERT_TRUE(WaitForEvents());
+
+  // Write into "$dir/a/b/c/file0".
+  ASSERT_TRUE(WriteFile(deepest_dir.AppendASCII("file0"), "content v2"));
+  ASSERT_TRUE(WaitForEvents());
+}
+
 #if defined(OS_POSIX) && !defined(OS_ANDROID)
 // Apps cannot create symlinks on Android in /sdcard as /sdcard uses the
 // "fuse" file system, while /data uses "ext4".  Running these tests in /data
@@ -0,0 +1,118 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/hash/crc32c.h"
+
+#include <string.h>
+
+#include "build/build_config.h"
+
+// NaCl does not allow intrinsics.
+#if defined(ARCH_CPU_X86_FAMILY) && !defined(OS_NACL)
+#include <nmmintrin.h>
+
+#include "base/cpu.h"
+
+// The SSE 4.2 version is compiled for SSE 4.2 regardless of the target CPU,
+// and is only used when base::CPU reports support for it.
+#define SSE42_FUNCTION __attribute__((target("sse4.2")))
+#elif defined(ARCH_CPU_ARM64) && defined(__ARM_FEATURE_CRC32)
+#include <arm_acle.h>
+#endif
+
+namespace base {
+
+namespace {
+
+// The reflected Castagnoli polynomial.
+constexpr uint32_t kPolynomial = 0x82F63B78;
+
+struct Table {
+  uint32_t entries[256];
+};
+
+constexpr Table MakeTable() {
+  Table table = {};
+  for (uint32_t i = 0; i < 256; ++i) {
+    uint32_t crc = i;
+    for (int bit = 0; bit < 8; ++bit)
+      crc = (crc >> 1) ^ (crc & 1 ? kPolynomial : 0);
+    table.entries[i] = crc;
+  }
+  return table;
+}
+
+constexpr Table kTable = MakeTable();
+
+// These update the internal state of the CRC, which is the complement of the
+// checksum.
+uint32_t UpdatePortable(uint32_t state, const uint8_t* data, size_t length) {
+  for (size_t i = 0; i < length; ++i)
+    state = kTable.entries[(state ^ data[i]) & 0xff] ^ (state >> 8);
+  return state;
+}
+
+#if defined(ARCH_CPU_X86_FAMILY) && !defined(OS_NACL)
+SSE42_FUNCTION
+uint32_t UpdateSSE42(uint32_t state, const uint8_t* data, size_t length) {
+#if defined(ARCH_CPU_X86_64)
+  uint64_t state64 = state;
+  for (; length >= sizeof(uint64_t); length -= sizeof(uint64_t)) {
+    uint64_t word;
+    memcpy(&word, data, sizeof(word));
+    state64 = _mm_crc32_u64(state64, word);
+    data += sizeof(word);
+  }
+  state = static_cast<uint32_t>(state64);
+#endif
+  for (; length >= sizeof(uint32_t); length -= sizeof(uint32_t)) {
+    uint32_t word;
+    memcpy(&word, data, sizeof(word));
+    state = _mm_crc32_u32(state, word);
+    data += sizeof(word);
+  }
+  for (; length; --length)
+    state = _mm_crc32_u8(state, *data++);
+  return state;
+}
+
+bool HasSSE42() {
+  static const bool has_sse42 = base::CPU().has_sse42();
+  return has_sse42;
+}
+#elif defined(ARCH_CPU_ARM64) && defined(__ARM_FEATURE_CRC32)
+uint32_t UpdateARMv8(uint32_t state, const uint8_t* data, size_t length) {
+  for (; length >= sizeof(uint64_t); length -= sizeof(uint64_t)) {
+    uint64_t word;
+    memcpy(&word, data, sizeof(word));
+    state = __crc32cd(state, word);
+    data += sizeof(word);
+  }
+  for (; length; --length)
+    state = __crc32cb(state, *data++);
+  return state;
+}
+#endif
+
+uint32_t Update(uint32_t state, const uint8_t* data, size_t length) {
+#if defined(ARCH_CPU_X86_FAMILY) && !defined(OS_NACL)
+  if (HasSSE42())
+    return UpdateSSE42(state, data, length);
+#elif defined(ARCH_CPU_ARM64) && defined(__ARM_FEATURE_CRC32)
+  return UpdateARMv8(state, data, length);
+#endif
+  return UpdatePortable(state, data, length);
+}
+
+}  // namespace
+
+uint32_t Crc32c(const void* data, size_t length) {
+  return ExtendCrc32c(0, data, length);
+}
+
+uint32_t ExtendCrc32c(uint32_t crc, const void* data, size_t length) {
+  return ~Update(~crc, static_cast<const uint8_t*>(data), length);
+}
+
+}  // namespace base
@@ -0,0 +1,35 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef BASE_HASH_CRC32C_H_
+#define BASE_HASH_CRC32C_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "base/base_export.h"
+
+namespace base {
+
+// Computes the CRC-32C (Castagnoli) checksum of a memory buffer, as used by
+// iSCSI, ext4 and LevelDB. The CRC32 instructions of SSE 4.2 and ARMv8 are
+// used where available, which makes it several times faster than the zlib
+// CRC-32 in software.
+//
+// WARNING: This checksum should not be used for any cryptographic purpose.
+BASE_EXPORT uint32_t Crc32c(const void* data, size_t length);
+
+// Extends |crc|, the CRC-32C of some data, to the CRC-32C of that data
+// followed by |data|. This allows computing a checksum incrementally:
+//
+//   uint32_t crc = Crc32c(first, first_length);
+//   crc = ExtendCrc32c(crc, second, second_length);
+//
+// The CRC-32C of no data is 0, so |crc| may start at 0 as well.
+BASE_EXPORT uint32_t ExtendCrc32c(uint32_t crc, const void* data,
+                                  size_t length);
+
+}  // namespace base
+
+#endif  // BASE_HASH_CRC32C_H_
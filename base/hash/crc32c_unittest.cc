@@ -0,0 +1,61 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/hash/crc32c.h"
+
+#include <stdint.h>
+
+#include <string>
+#include <vector>
+
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace base {
+
+TEST(Crc32cTest, KnownValues) {
+  EXPECT_EQ(0u, Crc32c(nullptr, 0));
+  EXPECT_EQ(0xE3069283u, Crc32c("123456789", 9));
+
+  // Test vectors from RFC 3720, section B.4.
+  std::vector<uint8_t> data(32, 0);
+  EXPECT_EQ(0x8A9136AAu, Crc32c(data.data(), data.size()));
+
+  data.assign(32, 0xff);
+  EXPECT_EQ(0x62A8AB43u, Crc32c(data.data(), data.size()));
+
+  for (size_t i = 0; i < data.size(); ++i)
+    data[i] = i;
+  EXPECT_EQ(0x46DD794Eu, Crc32c(data.data(), data.size()));
+
+  for (size_t i = 0; i < data.size(); ++i)
+    data[i] = 31 - i;
+  EXPECT_EQ(0x113FDB5Cu, Crc32c(data.data(), data.size()));
+}
+
+TEST(Crc32cTest, Extend) {
+  const std::string data =
+      "The quick brown fox jumps over the lazy dog, again and again.";
+  const uint32_t crc = Crc32c(data.data(), data.size());
+
+  // Splitting the data anywhere, including within the words that are
+  // processed at once, gives the same checksum.
+  for (size_t split = 0; split <= data.size(); ++split) {
+    SCOPED_TRACE(split);
+    uint32_t extended = Crc32c(data.data(), split);
+    extended = ExtendCrc32c(extended, data.data() + split, data.size() - split);
+    EXPECT_EQ(crc, extended);
+  }
+}
+
+TEST(Crc32cTest, UnalignedData) {
+  std::vector<uint8_t> buffer(100);
+  for (size_t i = 0; i < buffer.size(); ++i)
+    buffer[i] = i * 7;
+
+  std::vector<uint8_t> copy(buffer.begin() + 3, buffer.end());
+  EXPECT_EQ(Crc32c(copy.data(), copy.size()),
+            Crc32c(buffer.data() + 3, buffer.size() - 3));
+}
+
+}  // namespace base
@@ -4,13 +4,17 @@
 
 #include "base/json/json_parser.h"
 
+#include <string.h>
+
 #include <cmath>
 #include <utility>
 #include <vector>
 
 #include "base/logging.h"
+#include "base/auto_reset.h"
 #include "base/macros.h"
 #include "base/numerics/safe_conversions.h"
+#include "base/stl_util.h"
 #include "base/strings/string_number_conversions.h"
 #include "base/strings/string_piece.h"
 #include "base/strings/string_util.h"
@@ -50,6 +54,30 @@ class StackMarker {
 
 constexpr uint32_t kUnicodeReplacementPoint = 0xFFFD;
 
+// Returns the length of the longest prefix of |str| that is a multiple of
+// eight bytes long and holds only ASCII characters other than '"' and '\\',
+// which are part of a string as they are. Eight bytes are checked at a time,
+// since such runs make up most of the strings of typical documents.
+size_t CountPlainASCIIWords(const char* str, size_t length) {
+  constexpr uint64_t kOnes = 0x0101010101010101ull;
+  constexpr uint64_t kHighBits = 0x8080808080808080ull;
+
+  size_t count = 0;
+  for (; count + sizeof(uint64_t) <= length; count += sizeof(uint64_t)) {
+    uint64_t word;
+    memcpy(&word, str + count, sizeof(word));
+    // (x - kOnes) & ~x has the high bit of a byte set if x has a zero byte,
+    // so these find the bytes that equal '"' or '\\'.
+    const uint64_t quotes = word ^ (kOnes * '"');
+    const uint64_t backslashes = word ^ (kOnes * '\\');
+    const uint64_t special = word | ((quotes - kOnes) & ~quotes) |
+                             ((backslashes - kOnes) & ~backslashes);
+    if (special & kHighBits)
+      break;
+  }
+  return count;
+}
+
 }  // namespace
 
 // This is U+FFFD.
@@ -62,6 +90,8 @@ JSONParser::JSONParser(int options, int max_depth)
       stack_depth_(0),
       line_number_(0),
       index_last_line_(0),
+      root_keys_(nullptr),
+      materialize_values_(true),
       error_code_(JSONReader::JSON_NO_ERROR),
       error_line_(0),
       error_column_(0) {
@@ -71,39 +101,12 @@ JSONParser::JSONParser(int options, int max_depth)
 JSONParser::~JSONParser() = default;
 
 Optional<Value> JSONParser::Parse(StringPiece input) {
-  input_ = input;
-  index_ = 0;
-  line_number_ = 1;
-  index_last_line_ = 0;
-
-  error_code_ = JSONReader::JSON_NO_ERROR;
-  error_line_ = 0;
-  error_column_ = 0;
-
-  // ICU and ReadUnicodeCharacter() use int32_t for lengths, so ensure
-  // that the index_ will not overflow when parsing.
-  if (!base::IsValueInRangeForNumericType<int32_t>(input.length())) {
-    ReportError(JSONReader::JSON_TOO_LARGE, 0);
-    return nullopt;
-  }
-
-  // When the input JSON string starts with a UTF-8 Byte-Order-Mark,
-  // advance the start position to avoid the ParseNextToken function mis-
-  // treating a Unicode BOM as an invalid character and returning NULL.
-  ConsumeIfMatch("\xEF\xBB\xBF");
-
-  // Parse the first and any nested tokens.
-  Optional<Value> root(ParseNextToken());
-  if (!root)
-    return nullopt;
-
-  // Make sure the input stream is at an end.
-  if (GetNextToken() != T_END_OF_INPUT) {
-    ReportError(JSONReader::JSON_UNEXPECTED_DATA_AFTER_ROOT, 1);
-    return nullopt;
-  }
+  return ParseInternal(input, nullptr);
+}
 
-  return root;
+Optional<Value> JSONParser::ParseKeys(StringPiece input,
+                                      const std::vector<StringPiece>& keys) {
+  return ParseInternal(input, &keys);
 }
 
 JSONReader::JsonParseError JSONParser::error_code() const {
@@ -151,6 +154,17 @@ void JSONParser::StringBuilder::Append(uint32_t point) {
   }
 }
 
+void JSONParser::StringBuilder::AppendASCII(StringPiece str) {
+  DCHECK(IsStringASCII(str));
+
+  if (!string_) {
+    DCHECK_EQ(str.data(), pos_ + length_);
+    length_ += str.length();
+  } else {
+    str.AppendToString(&*string_);
+  }
+}
+
 void JSONParser::StringBuilder::Convert() {
   if (string_)
     return;
@@ -165,6 +179,53 @@ std::string JSONParser::StringBuilder::DestructiveAsString() {
 
 // JSONParser private //////////////////////////////////////////////////////////
 
+Optional<Value> JSONParser::ParseInternal(
+    StringPiece input,
+    const std::vector<StringPiece>* keys) {
+  input_ = input;
+  index_ = 0;
+  line_number_ = 1;
+  index_last_line_ = 0;
+  root_keys_ = keys;
+  materialize_values_ = true;
+
+  error_code_ = JSONReader::JSON_NO_ERROR;
+  error_line_ = 0;
+  error_column_ = 0;
+
+  // ICU and ReadUnicodeCharacter() use int32_t for lengths, so ensure
+  // that the index_ will not overflow when parsing.
+  if (!base::IsValueInRangeForNumericType<int32_t>(input.length())) {
+    ReportError(JSONReader::JSON_TOO_LARGE, 0);
+    return nullopt;
+  }
+
+  // When the input JSON string starts with a UTF-8 Byte-Order-Mark,
+  // advance the start position to avoid the ParseNextToken function mis-
+  // treating a Unicode BOM as an invalid character and returning NULL.
+  ConsumeIfMatch("\xEF\xBB\xBF");
+
+  // Only the keys of an object can be selected.
+  Token token = GetNextToken();
+  if (root_keys_ && token != T_OBJECT_BEGIN) {
+    ReportError(JSONReader::JSON_UNEXPECTED_TOKEN, 1);
+    return nullopt;
+  }
+
+  // Parse the first and any nested tokens.
+  Optional<Value> root(ParseToken(token));
+  if (!root)
+    return nullopt;
+
+  // Make sure the input stream is at an end.
+  if (GetNextToken() != T_END_OF_INPUT) {
+    ReportError(JSONReader::JSON_UNEXPECTED_DATA_AFTER_ROOT, 1);
+    return nullopt;
+  }
+
+  return root;
+}
+
 Optional<StringPiece> JSONParser::PeekChars(size_t count) {
   if (index_ + count > input_.length())
     return nullopt;
@@ -359,16 +420,32 @@ Optional<Value> JSONParser::ConsumeDictionary() {
       return nullopt;
     }
 
+    // Keys are only needed for the values that are built, which at the top
+    // level may be limited to |root_keys_|.
+    bool materialize_value = materialize_values_;
+    std::string key_string;
+    if (materialize_values_) {
+      key_string = key.DestructiveAsString();
+      if (root_keys_ && stack_depth_ == 1)
+        materialize_value = ContainsValue(*root_keys_, key_string);
+    }
+
     // The next token is the value. Ownership transfers to |dict|.
     ConsumeChar();
-    Optional<Value> value = ParseNextToken();
+    Optional<Value> value;
+    {
+      AutoReset<bool> materialize(&materialize_values_, materialize_value);
+      value = ParseNextToken();
+    }
     if (!value) {
       // ReportError from deeper level.
       return nullopt;
     }
 
-    dict_storage.emplace_back(key.DestructiveAsString(),
-                              std::make_unique<Value>(std::move(*value)));
+    if (materialize_value) {
+      dict_storage.emplace_back(std::move(key_string),
+                                std::make_unique<Value>(std::move(*value)));
+    }
 
     token = GetNextToken();
     if (token == T_LIST_SEPARATOR) {
@@ -411,7 +488,8 @@ Optional<Value> JSONParser::ConsumeList() {
       return nullopt;
     }
 
-    list_storage.push_back(std::move(*item));
+    if (materialize_values_)
+      list_storage.push_back(std::move(*item));
 
     token = GetNextToken();
     if (token == T_LIST_SEPARATOR) {
@@ -437,6 +515,8 @@ Optional<Value> JSONParser::ConsumeString() {
   if (!ConsumeStringRaw(&string))
     return nullopt;
 
+  if (!materialize_values_)
+    return Value();
   return Value(string.DestructiveAsString());
 }
 
@@ -452,6 +532,13 @@ bool JSONParser::ConsumeStringRaw(StringBuilder* out) {
   StringBuilder string(pos());
 
   while (PeekChar()) {
+    const size_t plain_length =
+        CountPlainASCIIWords(pos(), input_.length() - index_);
+    if (plain_length) {
+      string.AppendASCII(*ConsumeChars(plain_length));
+      continue;
+    }
+
     uint32_t next_char = 0;
     if (!ReadUnicodeCharacter(input_.data(),
                               static_cast<int32_t>(input_.length()),
@@ -10,6 +10,7 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "base/base_export.h"
 #include "base/compiler_specific.h"
@@ -52,6 +53,14 @@ class BASE_EXPORT JSONParser {
   // convert to a FooValue at the same time.
   Optional<Value> Parse(StringPiece input);
 
+  // Parses the input string like Parse(), but only builds the values of the
+  // top-level |keys|, which the result holds. The input must be an object, and
+  // all of it is still validated, but the values of the other keys are
+  // skipped without being materialized, which is much cheaper when only a few
+  // fields of a large document are needed.
+  Optional<Value> ParseKeys(StringPiece input,
+                            const std::vector<StringPiece>& keys);
+
   // Returns the error code.
   JSONReader::JsonParseError error_code() const;
 
@@ -105,6 +114,10 @@ class BASE_EXPORT JSONParser {
     // converted, or by appending the UTF8 bytes for the code point.
     void Append(uint32_t point);
 
+    // Appends |str|, which must consist of ASCII characters and, unless the
+    // string has been converted, directly follow the string in the input.
+    void AppendASCII(StringPiece str);
+
     // Converts the builder from its default StringPiece to a full std::string,
     // performing a copy. Once a builder is converted, it cannot be made a
     // StringPiece again.
@@ -131,6 +144,10 @@ class BASE_EXPORT JSONParser {
   // than |count| bytes remain.
   Optional<StringPiece> PeekChars(size_t count);
 
+  // Implements Parse() and ParseKeys(), with a null |keys| for Parse().
+  Optional<Value> ParseInternal(StringPiece input,
+                                const std::vector<StringPiece>* keys);
+
   // Calls PeekChars() with a |count| of 1.
   Optional<char> PeekChar();
 
@@ -232,6 +249,13 @@ class BASE_EXPORT JSONParser {
   // The last value of |index_| on the previous line.
   int index_last_line_;
 
+  // The top-level keys whose values are built, or null to build all values.
+  const std::vector<StringPiece>* root_keys_;
+
+  // False while parsing a value that is skipped because of |root_keys_|. The
+  // Consume functions then return placeholder values.
+  bool materialize_values_;
+
   // Error information.
   JSONReader::JsonParseError error_code_;
   int error_line_;
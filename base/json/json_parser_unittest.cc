@@ -7,6 +7,8 @@
 #include <stddef.h>
 
 #include <memory>
+#include <string>
+#include <vector>
 
 #include "base/json/json_reader.h"
 #include "base/memory/ptr_util.h"
@@ -441,5 +443,62 @@ TEST_F(JSONParserTest, UnterminatedInputs) {
   }
 }
 
+TEST_F(JSONParserTest, LongStrings) {
+  // Plain ASCII runs are scanned a word at a time, so put the characters that
+  // end them at every offset within a word.
+  for (size_t length = 0; length < 40; ++length) {
+    SCOPED_TRACE(length);
+    const std::string plain(length, 'a');
+
+    Optional<Value> value = JSONReader::Read("\"" + plain + "\"");
+    ASSERT_TRUE(value);
+    EXPECT_EQ(plain, value->GetString());
+
+    value = JSONReader::Read("\"" + plain + "\\n" + plain + "\"");
+    ASSERT_TRUE(value);
+    EXPECT_EQ(plain + "\n" + plain, value->GetString());
+
+    value = JSONReader::Read("\"" + plain + "\xC3\xA9" + plain + "\"");
+    ASSERT_TRUE(value);
+    EXPECT_EQ(plain + "\xC3\xA9" + plain, value->GetString());
+
+    std::unique_ptr<char[]> input_owner;
+    const std::string unterminated = "\"" + plain;
+    EXPECT_FALSE(JSONReader::Read(
+        MakeNotNullTerminatedInput(unterminated.c_str(), &input_owner)));
+  }
+}
+
+TEST_F(JSONParserTest, ParseKeys) {
+  const char kInput[] =
+      R"({"skipped": {"list": [1, "two", {"three": 3.0}], "flag": true},)"
+      R"( "wanted": {"nested": ["value"]}, "string": "s\u00e9",)"
+      R"( "number": 42, "wanted": "last"})";
+  const std::vector<StringPiece> keys = {"wanted", "number", "missing"};
+
+  JSONParser parser(JSON_PARSE_RFC);
+  Optional<Value> value = parser.ParseKeys(kInput, keys);
+  ASSERT_TRUE(value);
+  ASSERT_TRUE(value->is_dict());
+  EXPECT_EQ(2u, value->DictSize());
+  EXPECT_EQ(Value("last"), *value->FindKey("wanted"));
+  EXPECT_EQ(Value(42), *value->FindKey("number"));
+
+  // Skipped values are still validated.
+  EXPECT_FALSE(parser.ParseKeys(R"({"skipped": [1 2], "wanted": 1})", keys));
+  EXPECT_EQ(JSONReader::JSON_SYNTAX_ERROR, parser.error_code());
+  EXPECT_FALSE(parser.ParseKeys(R"({"skipped": "\q", "wanted": 1})", keys));
+  EXPECT_EQ(JSONReader::JSON_INVALID_ESCAPE, parser.error_code());
+
+  // Only the keys of an object can be selected.
+  EXPECT_FALSE(parser.ParseKeys("[1, 2]", keys));
+  EXPECT_EQ(JSONReader::JSON_UNEXPECTED_TOKEN, parser.error_code());
+
+  // A parser used for ParseKeys() still parses everything afterwards.
+  value = parser.Parse(kInput);
+  ASSERT_TRUE(value);
+  EXPECT_EQ(4u, value->DictSize());
+}
+
 }  // namespace internal
 }  // namespace base
@@ -2,6 +2,9 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include <string>
+#include <vector>
+
 #include "base/json/json_reader.h"
 #include "base/json/json_writer.h"
 #include "base/memory/ptr_util.h"
@@ -72,6 +75,15 @@ class JSONPerfTest : public testing::Test {
     perf_test::PrintResult("Read", "", description,
                            (end_read - start_read).InMillisecondsF(), "ms",
                            true);
+
+    // Only reads the scalar values of the root, skipping the nested
+    // dictionaries.
+    TimeTicks start_read_keys = TimeTicks::Now();
+    JSONReader::ReadKeys(json, {"Double", "Bool", "Int", "String"});
+    TimeTicks end_read_keys = TimeTicks::Now();
+    perf_test::PrintResult("ReadKeys", "", description,
+                           (end_read_keys - start_read_keys).InMillisecondsF(),
+                           "ms", true);
   }
 };
 
@@ -89,4 +101,29 @@ TEST_F(JSONPerfTest, MAYBE_StressTest) {
   }
 }
 
+TEST_F(JSONPerfTest, WriteAndReadLongStrings) {
+  // Strings that are mostly plain ASCII, with an occasional escape sequence
+  // and non-ASCII character, like the text in manifests and policies.
+  ListValue list;
+  for (int i = 0; i < 10000; ++i) {
+    list.GetList().emplace_back(
+        "A string of plain ASCII text that needs no decoding, "
+        "\"quoted\", caf\xC3\xA9 " +
+        base::NumberToString(i));
+  }
+  std::string json;
+  TimeTicks start_write = TimeTicks::Now();
+  JSONWriter::Write(list, &json);
+  TimeTicks end_write = TimeTicks::Now();
+  perf_test::PrintResult("Write", "", "LongStrings",
+                         (end_write - start_write).InMillisecondsF(), "ms",
+                         true);
+
+  TimeTicks start_read = TimeTicks::Now();
+  JSONReader::Read(json);
+  TimeTicks end_read = TimeTicks::Now();
+  perf_test::PrintResult("Read", "", "LongStrings",
+                         (end_read - start_read).InMillisecondsF(), "ms", true);
+}
+
 }  // namespace base
@@ -60,6 +60,14 @@ Optional<Value> JSONReader::Read(StringPiece json, int options, int max_depth) {
   return parser.Parse(json);
 }
 
+// static
+Optional<Value> JSONReader::ReadKeys(StringPiece json,
+                                     const std::vector<StringPiece>& keys,
+                                     int options) {
+  internal::JSONParser parser(options);
+  return parser.ParseKeys(json, keys);
+}
+
 std::unique_ptr<Value> JSONReader::ReadDeprecated(StringPiece json,
                                                   int options,
                                                   int max_depth) {
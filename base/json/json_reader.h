@@ -30,6 +30,7 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "base/base_export.h"
 #include "base/optional.h"
@@ -115,6 +116,14 @@ class BASE_EXPORT JSONReader {
                               int options = JSON_PARSE_RFC,
                               int max_depth = kStackMaxDepth);
 
+  // Reads and parses |json|, which must hold an object, like Read(), but only
+  // builds the values of the top-level |keys|. The returned dictionary holds
+  // those of them that |json| has. Use this to extract a few fields of a large
+  // document without building the rest of it.
+  static Optional<Value> ReadKeys(StringPiece json,
+                                  const std::vector<StringPiece>& keys,
+                                  int options = JSON_PARSE_RFC);
+
   // Deprecated. Use the Read() method above.
   // Reads and parses |json|, returning a Value.
   // If |json| is not a properly formed JSON string, returns nullptr.
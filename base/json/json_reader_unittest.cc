@@ -663,6 +663,20 @@ TEST(JSONReaderTest, IllegalTrailingNull) {
   EXPECT_EQ(JSONReader::JSON_UNEXPECTED_DATA_AFTER_ROOT, reader.error_code());
 }
 
+TEST(JSONReaderTest, ReadKeys) {
+  Optional<Value> value = JSONReader::ReadKeys(
+      R"({"name": "ext", "permissions": ["tabs"], "version": "1.0"})",
+      {"name", "version"});
+  ASSERT_TRUE(value);
+  EXPECT_EQ(2u, value->DictSize());
+  EXPECT_EQ(Value("ext"), *value->FindKey("name"));
+  EXPECT_EQ(Value("1.0"), *value->FindKey("version"));
+
+  EXPECT_FALSE(JSONReader::ReadKeys(R"({"name": "ext",})", {"name"}));
+  EXPECT_TRUE(JSONReader::ReadKeys(R"({"name": "ext",})", {"name"},
+                                   JSON_ALLOW_TRAILING_COMMAS));
+}
+
 TEST(JSONReaderTest, MaxNesting) {
   std::string json(R"({"outer": { "inner": {"foo": true}}})");
   EXPECT_FALSE(JSONReader::Read(json, JSON_PARSE_RFC, 3));
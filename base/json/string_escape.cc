@@ -6,6 +6,7 @@
 
 #include <stddef.h>
 #include <stdint.h>
+#include <string.h>
 
 #include <limits>
 #include <string>
@@ -77,6 +78,41 @@ bool EscapeSpecialCodePoint(uint32_t code_point, std::string* dest) {
   return true;
 }
 
+// Appends the longest prefix of the |length| bytes at |str| that is a multiple
+// of eight bytes long and needs no escaping, and returns its length. Eight
+// bytes are checked at a time, so that strings that need few escapes are
+// mostly copied in bulk.
+size_t AppendUnescapedWords(const char* str, size_t length, std::string* dest) {
+  constexpr uint64_t kOnes = 0x0101010101010101ull;
+  constexpr uint64_t kHighBits = 0x8080808080808080ull;
+
+  size_t count = 0;
+  for (; count + sizeof(uint64_t) <= length; count += sizeof(uint64_t)) {
+    uint64_t word;
+    memcpy(&word, str + count, sizeof(word));
+    // (x - kOnes * n) & ~x has the high bit of a byte set if x has a byte
+    // less than n, for n up to 0x80. Comparing with zero finds equal bytes.
+    const uint64_t quotes = word ^ (kOnes * '"');
+    const uint64_t backslashes = word ^ (kOnes * '\\');
+    const uint64_t less_thans = word ^ (kOnes * '<');
+    const uint64_t special = word | ((word - kOnes * 0x20) & ~word) |
+                             ((quotes - kOnes) & ~quotes) |
+                             ((backslashes - kOnes) & ~backslashes) |
+                             ((less_thans - kOnes) & ~less_thans);
+    if (special & kHighBits)
+      break;
+  }
+  dest->append(str, count);
+  return count;
+}
+
+// UTF-16 strings are always escaped one character at a time.
+size_t AppendUnescapedWords(const char16* str,
+                            size_t length,
+                            std::string* dest) {
+  return 0;
+}
+
 template <typename S>
 bool EscapeJSONStringImpl(const S& str, bool put_in_quotes, std::string* dest) {
   bool did_replacement = false;
@@ -90,6 +126,13 @@ bool EscapeJSONStringImpl(const S& str, bool put_in_quotes, std::string* dest) {
   const int32_t length = static_cast<int32_t>(str.length());
 
   for (int32_t i = 0; i < length; ++i) {
+    const size_t unescaped =
+        AppendUnescapedWords(str.data() + i, length - i, dest);
+    if (unescaped) {
+      i += unescaped - 1;
+      continue;
+    }
+
     uint32_t code_point;
     if (!ReadUnicodeCharacter(str.data(), length, &i, &code_point) ||
         code_point == static_cast<decltype(code_point)>(CBU_SENTINEL) ||
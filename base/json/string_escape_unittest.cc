@@ -6,6 +6,8 @@
 
 #include <stddef.h>
 
+#include <string>
+
 #include "base/stl_util.h"
 #include "base/strings/string_util.h"
 #include "base/strings/utf_string_conversions.h"
@@ -72,6 +74,35 @@ TEST(JSONStringEscapeTest, EscapeUTF8) {
   EXPECT_TRUE(IsStringUTF8(out));
 }
 
+TEST(JSONStringEscapeTest, EscapeLongUTF8) {
+  // Strings are copied eight bytes at a time until a character needs to be
+  // escaped, so put such characters at every offset within a word.
+  const struct {
+    const char* to_escape;
+    const char* escaped;
+  } cases[] = {
+      {"\"", "\\\""},
+      {"\\", "\\\\"},
+      {"<", "\\u003C"},
+      {"\n", "\\n"},
+      {"\x1f", "\\u001F"},
+      {"\x7f", "\x7f"},
+      {"\xc3\xa9", "\xc3\xa9"},
+      {"\xe2\x80\xa8", "\\u2028"},
+      {"\xff", "\xEF\xBF\xBD"},
+  };
+
+  for (const auto& test_case : cases) {
+    for (size_t length = 0; length < 20; ++length) {
+      SCOPED_TRACE(length);
+      const std::string plain(length, 'a');
+      std::string out;
+      EscapeJSONString(plain + test_case.to_escape + plain, false, &out);
+      EXPECT_EQ(plain + test_case.escaped + plain, out);
+    }
+  }
+}
+
 TEST(JSONStringEscapeTest, EscapeUTF16) {
   const struct {
     const wchar_t* to_escape;
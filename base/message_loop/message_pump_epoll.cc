@@ -0,0 +1,362 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/message_loop/message_pump_epoll.h"
+
+#include <errno.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <utility>
+
+#include "base/auto_reset.h"
+#include "base/logging.h"
+#include "base/numerics/safe_conversions.h"
+#include "base/posix/eintr_wrapper.h"
+#include "base/stl_util.h"
+#include "base/trace_event/trace_event.h"
+
+namespace base {
+
+namespace {
+
+uint32_t EpollEventsForMode(int mode) {
+  uint32_t events = 0;
+  if (mode & WatchableIOMessagePumpPosix::WATCH_READ)
+    events |= EPOLLIN;
+  if (mode & WatchableIOMessagePumpPosix::WATCH_WRITE)
+    events |= EPOLLOUT;
+  return events;
+}
+
+}  // namespace
+
+MessagePumpEpoll::FdWatchController::FdWatchController(
+    const Location& from_here)
+    : FdWatchControllerInterface(from_here) {}
+
+MessagePumpEpoll::FdWatchController::~FdWatchController() {
+  StopWatchingFileDescriptor();
+  if (was_destroyed_) {
+    DCHECK(!*was_destroyed_);
+    *was_destroyed_ = true;
+  }
+}
+
+bool MessagePumpEpoll::FdWatchController::StopWatchingFileDescriptor() {
+  if (!pump_)
+    return true;
+  return pump_->StopWatchingFileDescriptor(this);
+}
+
+void MessagePumpEpoll::FdWatchController::Init(WeakPtr<MessagePumpEpoll> pump,
+                                               int fd,
+                                               int mode,
+                                               bool persistent,
+                                               FdWatcher* watcher) {
+  DCHECK_NE(fd, -1);
+  DCHECK(watcher);
+  DCHECK(pump);
+  fd_ = fd;
+  mode_ = mode;
+  persistent_ = persistent;
+  watcher_ = watcher;
+  pump_ = pump;
+}
+
+void MessagePumpEpoll::FdWatchController::Reset() {
+  fd_ = -1;
+  mode_ = 0;
+  persistent_ = false;
+  watcher_ = nullptr;
+  pump_ = nullptr;
+}
+
+MessagePumpEpoll::Entry::Entry() = default;
+
+MessagePumpEpoll::Entry::Entry(Entry&&) = default;
+
+MessagePumpEpoll::Entry::~Entry() = default;
+
+MessagePumpEpoll::MessagePumpEpoll()
+    : epoll_(epoll_create1(EPOLL_CLOEXEC)),
+      wakeup_(eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC)),
+      events_(1),
+      weak_factory_(this) {
+  PCHECK(epoll_.is_valid()) << "epoll_create1";
+  PCHECK(wakeup_.is_valid()) << "eventfd";
+
+  epoll_event event{};
+  event.events = EPOLLIN;
+  event.data.fd = wakeup_.get();
+  int rv = epoll_ctl(epoll_.get(), EPOLL_CTL_ADD, wakeup_.get(), &event);
+  PCHECK(rv == 0) << "epoll_ctl";
+}
+
+MessagePumpEpoll::~MessagePumpEpoll() = default;
+
+void MessagePumpEpoll::Run(Delegate* delegate) {
+  AutoReset<bool> reset_keep_running(&keep_running_, true);
+
+  while (keep_running_) {
+    bool do_more_work = DoInternalWork(nullptr);
+    if (!keep_running_)
+      break;
+
+    Delegate::NextWorkInfo next_work_info = delegate->DoSomeWork();
+    do_more_work |= next_work_info.is_immediate();
+    if (!keep_running_)
+      break;
+
+    if (do_more_work)
+      continue;
+
+    do_more_work |= delegate->DoIdleWork();
+    if (!keep_running_)
+      break;
+
+    if (do_more_work)
+      continue;
+
+    DoInternalWork(&next_work_info);
+  }
+}
+
+void MessagePumpEpoll::Quit() {
+  keep_running_ = false;
+  ScheduleWork();
+}
+
+void MessagePumpEpoll::ScheduleWork() {
+  const uint64_t value = 1;
+  ssize_t nwrite = HANDLE_EINTR(write(wakeup_.get(), &value, sizeof(value)));
+  DPCHECK(nwrite == static_cast<ssize_t>(sizeof(value)) || errno == EAGAIN)
+      << "nwrite:" << nwrite;
+}
+
+void MessagePumpEpoll::ScheduleDelayedWork(
+    const TimeTicks& delayed_work_time) {
+  // Nothing to do. This MessagePump uses DoSomeWork().
+}
+
+bool MessagePumpEpoll::WatchFileDescriptor(int fd,
+                                           bool persistent,
+                                           int mode,
+                                           FdWatchController* controller,
+                                           FdWatcher* delegate) {
+  DCHECK_GE(fd, 0);
+  DCHECK(controller);
+  DCHECK(delegate);
+  DCHECK(mode == WATCH_READ || mode == WATCH_WRITE || mode == WATCH_READ_WRITE);
+  // WatchFileDescriptor should be called on the pump thread. It is not
+  // threadsafe, and your watcher may never be registered.
+  DCHECK(watch_file_descriptor_caller_checker_.CalledOnValidThread());
+
+  if (controller->fd_ != -1 && controller->fd_ != fd) {
+    DLOG(ERROR) << "Cannot use the same FdWatchController on two different FDs";
+    return false;
+  }
+
+  // As with MessagePumpLibevent, watching with a controller that is already
+  // watching adds onto its existing watch.
+  if (controller->pump_) {
+    DCHECK_EQ(this, controller->pump_.get());
+    mode |= controller->mode_;
+    persistent |= controller->persistent_;
+  }
+
+  Entry& entry = entries_[fd];
+  if (!ContainsValue(entry.controllers, controller))
+    entry.controllers.push_back(controller);
+  controller->Init(weak_factory_.GetWeakPtr(), fd, mode, persistent, delegate);
+
+  if (!UpdateEpollEvents(fd, &entry)) {
+    StopWatchingFileDescriptor(controller);
+    return false;
+  }
+  return true;
+}
+
+bool MessagePumpEpoll::StopWatchingFileDescriptor(
+    FdWatchController* controller) {
+  int fd = controller->fd_;
+  controller->Reset();
+
+  if (fd == -1)
+    return true;
+
+  auto it = entries_.find(fd);
+  if (it == entries_.end())
+    return true;
+
+  std::vector<FdWatchController*>& controllers = it->second.controllers;
+  controllers.erase(
+      std::remove(controllers.begin(), controllers.end(), controller),
+      controllers.end());
+  return UpdateEpollEvents(fd, &it->second);
+}
+
+bool MessagePumpEpoll::UpdateEpollEvents(int fd, Entry* entry) {
+  uint32_t events = 0;
+  for (FdWatchController* controller : entry->controllers)
+    events |= EpollEventsForMode(controller->mode_);
+
+  if (!events) {
+    int rv = 0;
+    if (entry->registered_events) {
+      rv = epoll_ctl(epoll_.get(), EPOLL_CTL_DEL, fd, nullptr);
+      // Closing the FD already removed it from |epoll_|.
+      if (rv < 0 && (errno == EBADF || errno == ENOENT))
+        rv = 0;
+      DPLOG_IF(ERROR, rv < 0) << "epoll_ctl(EPOLL_CTL_DEL, fd=" << fd << ")";
+    }
+    entries_.erase(fd);
+    return rv == 0;
+  }
+
+  // Persistent watches don't need to be re-armed, so this is usually a no-op.
+  if (events == entry->registered_events)
+    return true;
+
+  epoll_event event{};
+  event.events = events;
+  event.data.fd = fd;
+  int rv;
+  if (entry->registered_events) {
+    rv = epoll_ctl(epoll_.get(), EPOLL_CTL_MOD, fd, &event);
+    // The FD was closed and reopened since it was registered, which removed
+    // it from |epoll_|.
+    if (rv < 0 && errno == ENOENT)
+      rv = epoll_ctl(epoll_.get(), EPOLL_CTL_ADD, fd, &event);
+  } else {
+    rv = epoll_ctl(epoll_.get(), EPOLL_CTL_ADD, fd, &event);
+    // |fd| is still registered, e.g. because removing it failed.
+    if (rv < 0 && errno == EEXIST)
+      rv = epoll_ctl(epoll_.get(), EPOLL_CTL_MOD, fd, &event);
+  }
+  if (rv < 0) {
+    DPLOG(ERROR) << "epoll_ctl(fd=" << fd << ")";
+    return false;
+  }
+
+  entry->registered_events = events;
+  return true;
+}
+
+bool MessagePumpEpoll::DoInternalWork(Delegate::NextWorkInfo* next_work_info) {
+  if (events_.size() < entries_.size() + 1)
+    events_.resize(entries_.size() + 1);
+
+  bool poll = next_work_info == nullptr;
+  bool indefinite =
+      next_work_info != nullptr && next_work_info->delayed_run_time.is_max();
+
+  int rv = 0;
+  do {
+    int timeout_ms = 0;
+    if (indefinite) {
+      timeout_ms = -1;
+    } else if (!poll) {
+      if (rv != 0) {
+        // The wait was interrupted and made |next_work_info|'s view of
+        // TimeTicks::Now() stale. Refresh it before doing another wait.
+        next_work_info->recent_now = TimeTicks::Now();
+      }
+      // Round up, so that the pump doesn't wake up and spin just before the
+      // delayed work is due.
+      timeout_ms = saturated_cast<int>(std::max<int64_t>(
+          0, next_work_info->remaining_delay().InMillisecondsRoundedUp()));
+    }
+    // This does not use HANDLE_EINTR, since retrying the syscall requires
+    // adjusting the timeout to account for time already waited.
+    rv = epoll_wait(epoll_.get(), events_.data(),
+                    saturated_cast<int>(events_.size()), timeout_ms);
+  } while (rv < 0 && errno == EINTR);
+
+  PCHECK(rv >= 0) << "epoll_wait";
+  return ProcessEvents(rv);
+}
+
+bool MessagePumpEpoll::ProcessEvents(int count) {
+  bool did_work = false;
+
+  for (int i = 0; i < count; ++i) {
+    const epoll_event& event = events_[i];
+    if (event.data.fd == wakeup_.get()) {
+      // The wakeup event has been received, do not treat this as "doing
+      // work", this just wakes up the pump.
+      uint64_t value;
+      ssize_t nread = HANDLE_EINTR(read(wakeup_.get(), &value, sizeof(value)));
+      DPCHECK(nread == static_cast<ssize_t>(sizeof(value)) || errno == EAGAIN)
+          << "nread:" << nread;
+      continue;
+    }
+
+    did_work = true;
+    DispatchEvents(event.data.fd, event.events);
+  }
+
+  return did_work;
+}
+
+void MessagePumpEpoll::DispatchEvents(int fd, uint32_t events) {
+  TRACE_EVENT1("toplevel", "MessagePumpEpoll::DispatchEvents", "fd", fd);
+
+  // Errors and hangups are reported to both readers and writers, which find
+  // out about them when they next access the FD.
+  int ready_mode = 0;
+  if (events & (EPOLLIN | EPOLLERR | EPOLLHUP))
+    ready_mode |= WATCH_READ;
+  if (events & (EPOLLOUT | EPOLLERR | EPOLLHUP))
+    ready_mode |= WATCH_WRITE;
+
+  auto it = entries_.find(fd);
+  if (it == entries_.end()) {
+    // The controllers were removed by some other work callout before this
+    // event could be processed.
+    return;
+  }
+
+  // The callbacks may stop and start watches, or destroy controllers, so work
+  // on a copy of the controllers and skip those that stopped watching |fd| in
+  // the meantime.
+  const std::vector<FdWatchController*> controllers = it->second.controllers;
+  for (FdWatchController* controller : controllers) {
+    it = entries_.find(fd);
+    if (it == entries_.end())
+      return;
+    if (!ContainsValue(it->second.controllers, controller))
+      continue;
+
+    const int mode = controller->mode_ & ready_mode;
+    if (!mode)
+      continue;
+
+    FdWatcher* watcher = controller->watcher_;
+    const bool persistent = controller->persistent_;
+    if (!persistent) {
+      // A one-shot watch ends with its first event, before the callbacks so
+      // that they can watch again.
+      StopWatchingFileDescriptor(controller);
+    }
+
+    bool controller_was_destroyed = false;
+    controller->was_destroyed_ = &controller_was_destroyed;
+    // As with MessagePumpLibevent, writability is reported first.
+    if (mode & WATCH_WRITE)
+      watcher->OnFileCanWriteWithoutBlocking(fd);
+    if (!controller_was_destroyed && (mode & WATCH_READ)) {
+      // The write callback may have stopped the persistent watch.
+      if (!persistent)
+        watcher->OnFileCanReadWithoutBlocking(fd);
+      else if (controller->watcher_)
+        controller->watcher_->OnFileCanReadWithoutBlocking(fd);
+    }
+    if (!controller_was_destroyed)
+      controller->was_destroyed_ = nullptr;
+  }
+}
+
+}  // namespace base
@@ -0,0 +1,142 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef BASE_MESSAGE_LOOP_MESSAGE_PUMP_EPOLL_H_
+#define BASE_MESSAGE_LOOP_MESSAGE_PUMP_EPOLL_H_
+
+#include <stdint.h>
+#include <sys/epoll.h>
+
+#include <unordered_map>
+#include <vector>
+
+#include "base/files/scoped_file.h"
+#include "base/location.h"
+#include "base/macros.h"
+#include "base/memory/weak_ptr.h"
+#include "base/message_loop/message_pump.h"
+#include "base/message_loop/watchable_io_message_pump_posix.h"
+#include "base/threading/thread_checker.h"
+
+namespace base {
+
+// MessagePumpEpoll drives an IO MessageLoop with epoll directly, rather than
+// through libevent. It is used on Linux and Android instead of
+// MessagePumpLibevent when the |use_epoll_message_pump| GN arg is set.
+//
+// Watches are level-triggered, as FdWatcher implementations expect to be
+// called again for as long as their FD stays ready, but persistent watches are
+// registered with the kernel only once: the epoll interest set of an FD is
+// only changed when the union of the modes watched on it changes. All the
+// events returned by one epoll_wait() are dispatched before the pump goes
+// back to its delegate.
+class BASE_EXPORT MessagePumpEpoll : public MessagePump,
+                                     public WatchableIOMessagePumpPosix {
+ public:
+  class FdWatchController : public FdWatchControllerInterface {
+   public:
+    explicit FdWatchController(const Location& from_here);
+    ~FdWatchController() override;
+
+    // FdWatchControllerInterface:
+    bool StopWatchingFileDescriptor() override;
+
+   private:
+    friend class MessagePumpEpoll;
+
+    void Init(WeakPtr<MessagePumpEpoll> pump,
+              int fd,
+              int mode,
+              bool persistent,
+              FdWatcher* watcher);
+    void Reset();
+
+    int fd_ = -1;
+    int mode_ = 0;
+    bool persistent_ = false;
+    FdWatcher* watcher_ = nullptr;
+    WeakPtr<MessagePumpEpoll> pump_;
+
+    // If this pointer is non-null, the pointee is set to true in the
+    // destructor.
+    bool* was_destroyed_ = nullptr;
+
+    DISALLOW_COPY_AND_ASSIGN(FdWatchController);
+  };
+
+  MessagePumpEpoll();
+  ~MessagePumpEpoll() override;
+
+  // MessagePump:
+  void Run(Delegate* delegate) override;
+  void Quit() override;
+  void ScheduleWork() override;
+  void ScheduleDelayedWork(const TimeTicks& delayed_work_time) override;
+
+  // WatchableIOMessagePumpPosix:
+  bool WatchFileDescriptor(int fd,
+                           bool persistent,
+                           int mode,
+                           FdWatchController* controller,
+                           FdWatcher* delegate);
+
+ private:
+  // The controllers watching an FD, and the events the FD is registered for
+  // in |epoll_|.
+  struct Entry {
+    Entry();
+    Entry(Entry&&);
+    ~Entry();
+
+    std::vector<FdWatchController*> controllers;
+    uint32_t registered_events = 0;
+  };
+
+  // Called by FdWatchController::StopWatchingFileDescriptor().
+  bool StopWatchingFileDescriptor(FdWatchController* controller);
+
+  // Updates the registration of |fd| in |epoll_| to match the controllers of
+  // |entry|, removing |entry| once it has none. Returns false on error.
+  bool UpdateEpollEvents(int fd, Entry* entry);
+
+  // Checks |epoll_| for events. If |next_work_info| is null, then |epoll_| is
+  // polled for events. If it is non-null, it waits for the amount of time
+  // specified by the NextWorkInfo or until an event is triggered. Returns
+  // whether any events were dispatched.
+  bool DoInternalWork(Delegate::NextWorkInfo* next_work_info);
+
+  // Dispatches the first |count| events of |events_|. Returns true if work
+  // was done, i.e. some FdWatcher was notified.
+  bool ProcessEvents(int count);
+
+  // Notifies the controllers of |fd| that the FD is ready for |events|.
+  void DispatchEvents(int fd, uint32_t events);
+
+  // The epoll instance that drives the pump.
+  ScopedFD epoll_;
+
+  // eventfd written to by ScheduleWork() to wake up the pump.
+  ScopedFD wakeup_;
+
+  // Whether the pump has been Quit() or not.
+  bool keep_running_ = true;
+
+  // The watched FDs.
+  std::unordered_map<int, Entry> entries_;
+
+  // Buffer used by DoInternalWork() to be notified of triggered events. It is
+  // resized to have room for an event per watched FD, so that a single
+  // epoll_wait() returns all the FDs that are ready.
+  std::vector<epoll_event> events_;
+
+  ThreadChecker watch_file_descriptor_caller_checker_;
+
+  WeakPtrFactory<MessagePumpEpoll> weak_factory_;
+
+  DISALLOW_COPY_AND_ASSIGN(MessagePumpEpoll);
+};
+
+}  // namespace base
+
+#endif  // BASE_MESSAGE_LOOP_MESSAGE_PUMP_EPOLL_H_
@@ -0,0 +1,188 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/message_loop/message_pump_epoll.h"
+
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <memory>
+#include <utility>
+
+#include "base/bind.h"
+#include "base/bind_helpers.h"
+#include "base/files/file_util.h"
+#include "base/files/scoped_file.h"
+#include "base/memory/ptr_util.h"
+#include "base/message_loop/message_loop.h"
+#include "base/posix/eintr_wrapper.h"
+#include "base/run_loop.h"
+#include "base/test/bind_test_util.h"
+#include "base/threading/thread_task_runner_handle.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace base {
+namespace {
+
+class MessagePumpEpollTest : public testing::Test {
+ public:
+  MessagePumpEpollTest()
+      : pump_(new MessagePumpEpoll()), loop_(WrapUnique(pump_)) {}
+
+  void SetUp() override {
+    int fds[2];
+    ASSERT_EQ(0, pipe(fds));
+    receiver_.reset(fds[0]);
+    sender_.reset(fds[1]);
+    ASSERT_TRUE(SetNonBlocking(receiver_.get()));
+    ASSERT_TRUE(SetNonBlocking(sender_.get()));
+  }
+
+  MessagePumpEpoll* pump() { return pump_; }
+
+  void WriteByte() {
+    char c = 'x';
+    ASSERT_EQ(1, HANDLE_EINTR(write(sender_.get(), &c, 1)));
+  }
+
+  static void ReadByte(int fd) {
+    char c;
+    ASSERT_EQ(1, HANDLE_EINTR(read(fd, &c, 1)));
+  }
+
+ protected:
+  ScopedFD receiver_;
+  ScopedFD sender_;
+
+ private:
+  MessagePumpEpoll* pump_;  // Weak, owned by |loop_|.
+  MessageLoop loop_;
+};
+
+// Reads a byte from its FD every time it is readable, and runs |callback|.
+class ReadWatcher : public MessagePumpEpoll::FdWatcher {
+ public:
+  explicit ReadWatcher(RepeatingClosure callback)
+      : callback_(std::move(callback)) {}
+  ~ReadWatcher() override {}
+
+  void OnFileCanReadWithoutBlocking(int fd) override {
+    MessagePumpEpollTest::ReadByte(fd);
+    ++read_count_;
+    callback_.Run();
+  }
+
+  void OnFileCanWriteWithoutBlocking(int fd) override {
+    ++write_count_;
+    callback_.Run();
+  }
+
+  int read_count_ = 0;
+  int write_count_ = 0;
+
+ private:
+  RepeatingClosure callback_;
+};
+
+TEST_F(MessagePumpEpollTest, PersistentWatch) {
+  RunLoop run_loop;
+  int callback_count = 0;
+  MessagePumpEpoll::FdWatchController controller(FROM_HERE);
+  ReadWatcher watcher(BindLambdaForTesting([&]() {
+    if (++callback_count == 3)
+      run_loop.Quit();
+  }));
+  ASSERT_TRUE(pump()->WatchFileDescriptor(receiver_.get(), true,
+                                          MessagePumpEpoll::WATCH_READ,
+                                          &controller, &watcher));
+
+  // Bytes written before and after the loop starts are all reported, one per
+  // callback, since the watch is level-triggered.
+  WriteByte();
+  WriteByte();
+  ThreadTaskRunnerHandle::Get()->PostTask(
+      FROM_HERE, BindOnce(&MessagePumpEpollTest::WriteByte, Unretained(this)));
+  run_loop.Run();
+
+  EXPECT_EQ(3, watcher.read_count_);
+  EXPECT_EQ(0, watcher.write_count_);
+  EXPECT_TRUE(controller.StopWatchingFileDescriptor());
+}
+
+TEST_F(MessagePumpEpollTest, OneShotWatch) {
+  MessagePumpEpoll::FdWatchController controller(FROM_HERE);
+  ReadWatcher watcher(DoNothing());
+  ASSERT_TRUE(pump()->WatchFileDescriptor(receiver_.get(), false,
+                                          MessagePumpEpoll::WATCH_READ,
+                                          &controller, &watcher));
+
+  WriteByte();
+  WriteByte();
+  RunLoop().RunUntilIdle();
+
+  // The second byte is left unread once the watch has fired.
+  EXPECT_EQ(1, watcher.read_count_);
+
+  ASSERT_TRUE(pump()->WatchFileDescriptor(receiver_.get(), false,
+                                          MessagePumpEpoll::WATCH_READ,
+                                          &controller, &watcher));
+  RunLoop().RunUntilIdle();
+  EXPECT_EQ(2, watcher.read_count_);
+}
+
+TEST_F(MessagePumpEpollTest, ReadAndWriteControllersOnSameFd) {
+  int fds[2];
+  ASSERT_EQ(0, socketpair(AF_UNIX, SOCK_STREAM, 0, fds));
+  ScopedFD socket(fds[0]);
+  ScopedFD peer(fds[1]);
+  ASSERT_TRUE(SetNonBlocking(socket.get()));
+
+  MessagePumpEpoll::FdWatchController read_controller(FROM_HERE);
+  MessagePumpEpoll::FdWatchController write_controller(FROM_HERE);
+  ReadWatcher read_watcher(DoNothing());
+  ReadWatcher write_watcher(DoNothing());
+  ASSERT_TRUE(pump()->WatchFileDescriptor(socket.get(), true,
+                                          MessagePumpEpoll::WATCH_READ,
+                                          &read_controller, &read_watcher));
+  ASSERT_TRUE(pump()->WatchFileDescriptor(socket.get(), false,
+                                          MessagePumpEpoll::WATCH_WRITE,
+                                          &write_controller, &write_watcher));
+
+  char c = 'x';
+  ASSERT_EQ(1, HANDLE_EINTR(write(peer.get(), &c, 1)));
+  RunLoop().RunUntilIdle();
+
+  // Each controller only hears about the mode it watches, and stopping the
+  // one-shot write watch leaves the read watch registered.
+  EXPECT_EQ(1, read_watcher.read_count_);
+  EXPECT_EQ(0, read_watcher.write_count_);
+  EXPECT_EQ(0, write_watcher.read_count_);
+  EXPECT_EQ(1, write_watcher.write_count_);
+
+  ASSERT_EQ(1, HANDLE_EINTR(write(peer.get(), &c, 1)));
+  RunLoop().RunUntilIdle();
+  EXPECT_EQ(2, read_watcher.read_count_);
+  EXPECT_EQ(1, write_watcher.write_count_);
+}
+
+TEST_F(MessagePumpEpollTest, DeleteControllerInCallback) {
+  auto controller =
+      std::make_unique<MessagePumpEpoll::FdWatchController>(FROM_HERE);
+  ReadWatcher watcher(BindLambdaForTesting([&]() { controller.reset(); }));
+  ASSERT_TRUE(pump()->WatchFileDescriptor(receiver_.get(), true,
+                                          MessagePumpEpoll::WATCH_READ_WRITE,
+                                          controller.get(), &watcher));
+
+  // The pipe's read end is never writable, so only the read callback runs, and
+  // it destroys the controller.
+  WriteByte();
+  WriteByte();
+  RunLoop().RunUntilIdle();
+
+  EXPECT_FALSE(controller);
+  EXPECT_EQ(1, watcher.read_count_);
+}
+
+}  // namespace
+}  // namespace base
@@ -7,6 +7,7 @@
 #include <type_traits>
 
 #include "base/message_loop/message_loop.h"
+#include "base/message_loop/message_pump_buildflags.h"
 #include "base/message_loop/message_pump_for_io.h"
 #include "base/message_loop/message_pump_for_ui.h"
 #include "base/test/bind_test_util.h"
@@ -62,7 +63,9 @@ bool PumpTypeUsesDoSomeWork(MessageLoopBase::Type type) {
 #elif defined(OS_POSIX) && !defined(OS_NACL_SFI)
       // MessagePumpLibevent was migrated (ref. message_pump_for_io.h and
       // |use_libevent| in base/BUILD.gn for enabled conditions).
-      return std::is_same<MessagePumpForIO, MessagePumpLibevent>::value;
+      // MessagePumpEpoll uses DoSomeWork() from the start.
+      return std::is_same<MessagePumpForIO, MessagePumpLibevent>::value ||
+             BUILDFLAG(USE_EPOLL_MESSAGE_PUMP);
 #else
       // TODO(gab): Complete migration of all IO pumps to DoSomeWork() as part
       // of crbug.com/885371.
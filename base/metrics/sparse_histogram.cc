@@ -16,12 +16,20 @@
 #include "base/pickle.h"
 #include "base/strings/stringprintf.h"
 #include "base/synchronization/lock.h"
+#include "base/threading/platform_thread.h"
 
 namespace base {
 
 typedef HistogramBase::Count Count;
 typedef HistogramBase::Sample Sample;
 
+struct SparseHistogram::Shard {
+  base::Lock lock;
+  // Replaced with an empty map when merged, since a SampleMap can't subtract
+  // itself.
+  std::unique_ptr<SampleMap> samples;
+};
+
 // static
 HistogramBase* SparseHistogram::FactoryGet(const std::string& name,
                                            int32_t flags) {
@@ -85,7 +93,9 @@ std::unique_ptr<HistogramBase> SparseHistogram::PersistentCreate(
       new SparseHistogram(allocator, name, meta, logged_meta));
 }
 
-SparseHistogram::~SparseHistogram() = default;
+SparseHistogram::~SparseHistogram() {
+  delete[] shards_.load(std::memory_order_acquire);
+}
 
 uint64_t SparseHistogram::name_hash() const {
   return unlogged_samples_->id();
@@ -112,9 +122,22 @@ void SparseHistogram::AddCount(Sample value, int count) {
     NOTREACHED();
     return;
   }
-  {
+  // Threads recording the same histogram at a high rate would otherwise wait
+  // on each other for |lock_|. Rather than waiting, record into the shard of
+  // the current thread, which is merged into |unlogged_samples_| before the
+  // next snapshot.
+  if (!use_shards_) {
     base::AutoLock auto_lock(lock_);
     unlogged_samples_->Accumulate(value, count);
+  } else if (lock_.Try()) {
+    base::AutoLock auto_lock(lock_, base::AutoLock::AlreadyAcquired());
+    unlogged_samples_->Accumulate(value, count);
+  } else {
+    Shard* shard = GetShardForCurrentThread();
+    base::AutoLock shard_lock(shard->lock);
+    if (!shard->samples)
+      shard->samples = std::make_unique<SampleMap>(name_hash());
+    shard->samples->Accumulate(value, count);
   }
 
   FindAndRunCallback(value);
@@ -124,6 +147,7 @@ std::unique_ptr<HistogramSamples> SparseHistogram::SnapshotSamples() const {
   std::unique_ptr<SampleMap> snapshot(new SampleMap(name_hash()));
 
   base::AutoLock auto_lock(lock_);
+  MergeShards();
   snapshot->Add(*unlogged_samples_);
   snapshot->Add(*logged_samples_);
   return std::move(snapshot);
@@ -134,6 +158,7 @@ std::unique_ptr<HistogramSamples> SparseHistogram::SnapshotDelta() {
 
   std::unique_ptr<SampleMap> snapshot(new SampleMap(name_hash()));
   base::AutoLock auto_lock(lock_);
+  MergeShards();
   snapshot->Add(*unlogged_samples_);
 
   unlogged_samples_->Subtract(*snapshot);
@@ -147,6 +172,7 @@ std::unique_ptr<HistogramSamples> SparseHistogram::SnapshotFinalDelta() const {
 
   std::unique_ptr<SampleMap> snapshot(new SampleMap(name_hash()));
   base::AutoLock auto_lock(lock_);
+  MergeShards();
   snapshot->Add(*unlogged_samples_);
 
   return std::move(snapshot);
@@ -157,6 +183,38 @@ void SparseHistogram::AddSamples(const HistogramSamples& samples) {
   unlogged_samples_->Add(samples);
 }
 
+SparseHistogram::Shard* SparseHistogram::GetShardForCurrentThread() {
+  Shard* shards = shards_.load(std::memory_order_acquire);
+  if (!shards) {
+    Shard* new_shards = new Shard[kShardCount];
+    if (shards_.compare_exchange_strong(shards, new_shards,
+                                        std::memory_order_acq_rel)) {
+      shards = new_shards;
+    } else {
+      // Another thread allocated them first, and |shards| now holds theirs.
+      delete[] new_shards;
+    }
+  }
+  const size_t thread_id = static_cast<size_t>(PlatformThread::CurrentId());
+  return &shards[thread_id % kShardCount];
+}
+
+void SparseHistogram::MergeShards() const {
+  lock_.AssertAcquired();
+  Shard* shards = shards_.load(std::memory_order_acquire);
+  if (!shards)
+    return;
+  for (size_t i = 0; i < kShardCount; ++i) {
+    std::unique_ptr<SampleMap> samples;
+    {
+      base::AutoLock shard_lock(shards[i].lock);
+      samples = std::move(shards[i].samples);
+    }
+    if (samples)
+      unlogged_samples_->Add(*samples);
+  }
+}
+
 bool SparseHistogram::AddSamplesFromPickle(PickleIterator* iter) {
   base::AutoLock auto_lock(lock_);
   return unlogged_samples_->AddFromPickle(iter);
@@ -179,6 +237,7 @@ void SparseHistogram::SerializeInfoImpl(Pickle* pickle) const {
 
 SparseHistogram::SparseHistogram(const char* name)
     : HistogramBase(name),
+      use_shards_(true),
       unlogged_samples_(new SampleMap(HashMetricName(name))),
       logged_samples_(new SampleMap(unlogged_samples_->id())) {}
 
@@ -187,6 +246,7 @@ SparseHistogram::SparseHistogram(PersistentHistogramAllocator* allocator,
                                  HistogramSamples::Metadata* meta,
                                  HistogramSamples::Metadata* logged_meta)
     : HistogramBase(name),
+      use_shards_(false),
       // While other histogram types maintain a static vector of values with
       // sufficient space for both "active" and "logged" samples, with each
       // SampleVector being given the appropriate half, sparse histograms
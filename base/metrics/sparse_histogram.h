@@ -8,6 +8,7 @@
 #include <stddef.h>
 #include <stdint.h>
 
+#include <atomic>
 #include <map>
 #include <memory>
 #include <string>
@@ -88,12 +89,34 @@ class BASE_EXPORT SparseHistogram : public HistogramBase {
   void WriteAsciiHeader(const Count total_count,
                         std::string* output) const;
 
+  // Samples that AddCount() could not record in |unlogged_samples_| because
+  // another thread held |lock_|, accumulated in a shard picked by thread.
+  struct Shard;
+  static constexpr size_t kShardCount = 8;
+
+  // Returns the shard of the current thread, allocating the shards the first
+  // time one is needed.
+  Shard* GetShardForCurrentThread();
+
+  // Moves the samples of all shards into |unlogged_samples_|. Must be called
+  // with |lock_| held, by every function that reads |unlogged_samples_|.
+  void MergeShards() const;
+
   // For constuctor calling.
   friend class SparseHistogramTest;
 
   // Protects access to |samples_|.
   mutable base::Lock lock_;
 
+  // Whether AddCount() may record into |shards_| under contention. This is
+  // false for persistent histograms, whose samples must always be in
+  // persistent memory, since other processes read them without a snapshot.
+  const bool use_shards_;
+
+  // An array of kShardCount shards, or null until there is contention. Never
+  // freed until the histogram is.
+  std::atomic<Shard*> shards_{nullptr};
+
   // Flag to indicate if PrepareFinalDelta has been previously called.
   mutable bool final_delta_created_ = false;
 
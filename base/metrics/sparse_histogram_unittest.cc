@@ -18,6 +18,7 @@
 #include "base/pickle.h"
 #include "base/stl_util.h"
 #include "base/strings/stringprintf.h"
+#include "base/threading/simple_thread.h"
 #include "testing/gmock/include/gmock/gmock.h"
 #include "testing/gtest/include/gtest/gtest.h"
 
@@ -378,6 +379,52 @@ TEST_P(SparseHistogramTest, ExtremeValues) {
   }
 }
 
+TEST_P(SparseHistogramTest, ContendedSamplesAreMergedAtSnapshot) {
+  std::unique_ptr<SparseHistogram> histogram(NewSparseHistogram("Sparse"));
+  histogram->Add(1);
+
+  // While the lock is held, samples go to the shard of the current thread.
+  histogram->lock_.Acquire();
+  histogram->AddCount(1, 2);
+  histogram->AddCount(2, 3);
+  histogram->lock_.Release();
+
+  std::unique_ptr<HistogramSamples> snapshot(histogram->SnapshotDelta());
+  EXPECT_EQ(6, snapshot->TotalCount());
+  EXPECT_EQ(3, snapshot->GetCount(1));
+  EXPECT_EQ(3, snapshot->GetCount(2));
+  EXPECT_EQ(0, histogram->SnapshotDelta()->TotalCount());
+  EXPECT_EQ(6, histogram->SnapshotSamples()->TotalCount());
+}
+
+TEST_P(SparseHistogramTest, ConcurrentAdds) {
+  constexpr int kThreadCount = 4;
+  constexpr int kSamplesPerThread = 10000;
+  std::unique_ptr<SparseHistogram> histogram(NewSparseHistogram("Sparse"));
+
+  class AddDelegate : public DelegateSimpleThread::Delegate {
+   public:
+    explicit AddDelegate(SparseHistogram* histogram) : histogram_(histogram) {}
+    void Run() override {
+      for (int i = 0; i < kSamplesPerThread; ++i)
+        histogram_->Add(i % 10);
+    }
+
+   private:
+    SparseHistogram* const histogram_;
+  } delegate(histogram.get());
+
+  DelegateSimpleThreadPool pool("SparseHistogramTest", kThreadCount);
+  pool.AddWork(&delegate, kThreadCount);
+  pool.Start();
+  pool.JoinAll();
+
+  std::unique_ptr<HistogramSamples> snapshot(histogram->SnapshotSamples());
+  EXPECT_EQ(kThreadCount * kSamplesPerThread, snapshot->TotalCount());
+  for (int i = 0; i < 10; ++i)
+    EXPECT_EQ(kThreadCount * kSamplesPerThread / 10, snapshot->GetCount(i));
+}
+
 TEST_P(SparseHistogramTest, HistogramNameHash) {
   const char kName[] = "TestName";
   HistogramBase* histogram = SparseHistogram::FactoryGet(
@@ -6,6 +6,7 @@
 
 #include <memory>
 
+#include "base/epoch_observer_list.h"
 #include "base/logging.h"
 #include "base/observer_list.h"
 #include "base/strings/stringprintf.h"
@@ -33,6 +34,10 @@ class UnsafeObserver : public ObserverInterface {};
 
 class TestCheckedObserver : public CheckedObserver, public ObserverInterface {};
 
+// Observers of the same kinds, notified through an EpochObserverList.
+class UnsafeEpochObserver : public UnsafeObserver {};
+class TestCheckedEpochObserver : public TestCheckedObserver {};
+
 template <class ObserverType>
 struct Pick {
   // The ObserverList type to use. Checked observers need to be in a checked
@@ -45,6 +50,16 @@ struct Pick<UnsafeObserver> {
   using ObserverListType = ObserverList<ObserverInterface>::Unchecked;
   static const char* GetName() { return "UnsafeObserver"; }
 };
+template <>
+struct Pick<UnsafeEpochObserver> {
+  using ObserverListType = EpochObserverList<ObserverInterface>::Unchecked;
+  static const char* GetName() { return "UnsafeEpochObserver"; }
+};
+template <>
+struct Pick<TestCheckedEpochObserver> {
+  using ObserverListType = EpochObserverList<TestCheckedObserver>;
+  static const char* GetName() { return "CheckedEpochObserver"; }
+};
 
 template <class ObserverType>
 class ObserverListPerfTest : public ::testing::Test {
@@ -57,10 +72,15 @@ class ObserverListPerfTest : public ::testing::Test {
   DISALLOW_COPY_AND_ASSIGN(ObserverListPerfTest);
 };
 
-typedef ::testing::Types<UnsafeObserver, TestCheckedObserver> ObserverTypes;
+typedef ::testing::Types<UnsafeObserver,
+                         TestCheckedObserver,
+                         UnsafeEpochObserver,
+                         TestCheckedEpochObserver>
+    ObserverTypes;
 TYPED_TEST_SUITE(ObserverListPerfTest, ObserverTypes);
 
-// Performance test for base::ObserverList and Checked Observers.
+// Performance test for base::ObserverList, base::EpochObserverList and Checked
+// Observers.
 TYPED_TEST(ObserverListPerfTest, NotifyPerformance) {
   constexpr int kMaxObservers = 128;
 #if DCHECK_IS_ON()
@@ -263,6 +263,16 @@ Pickle::Pickle(const Pickle& other)
   memcpy(header_, other.header_, header_size_ + other.header_->payload_size);
 }
 
+Pickle::Pickle(Pickle&& other)
+    : header_(other.header_),
+      header_size_(other.header_size_),
+      capacity_after_header_(other.capacity_after_header_),
+      write_offset_(other.write_offset_) {
+  other.header_ = nullptr;
+  other.capacity_after_header_ = 0;
+  other.write_offset_ = 0;
+}
+
 Pickle::~Pickle() {
   if (capacity_after_header_ != kCapacityReadOnly)
     free(header_);
@@ -288,6 +298,21 @@ Pickle& Pickle::operator=(const Pickle& other) {
   return *this;
 }
 
+Pickle& Pickle::operator=(Pickle&& other) {
+  if (this == &other)
+    return *this;
+  if (capacity_after_header_ != kCapacityReadOnly)
+    free(header_);
+  header_ = other.header_;
+  header_size_ = other.header_size_;
+  capacity_after_header_ = other.capacity_after_header_;
+  write_offset_ = other.write_offset_;
+  other.header_ = nullptr;
+  other.capacity_after_header_ = 0;
+  other.write_offset_ = 0;
+  return *this;
+}
+
 void Pickle::WriteString(const StringPiece& value) {
   WriteInt(static_cast<int>(value.size()));
   WriteBytes(value.data(), static_cast<int>(value.size()));
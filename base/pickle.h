@@ -159,6 +159,10 @@ class BASE_EXPORT Pickle {
   // Initializes a Pickle as a deep copy of another Pickle.
   Pickle(const Pickle& other);
 
+  // Initializes a Pickle by taking the buffer of another Pickle, without
+  // copying it. |other| may then only be destroyed or assigned to.
+  Pickle(Pickle&& other);
+
   // Note: There are no virtual methods in this class.  This destructor is
   // virtual as an element of defensive coding.  Other classes have derived from
   // this class, and there is a *chance* that they will cast into this base
@@ -169,6 +173,9 @@ class BASE_EXPORT Pickle {
   // Performs a deep copy.
   Pickle& operator=(const Pickle& other);
 
+  // Takes the buffer of |other|, as the move constructor does.
+  Pickle& operator=(Pickle&& other);
+
   // Returns the number of bytes written in the Pickle, including the header.
   size_t size() const { return header_size_ + header_->payload_size; }
 
@@ -10,6 +10,7 @@
 
 #include <memory>
 #include <string>
+#include <utility>
 
 #include "base/stl_util.h"
 #include "base/strings/string16.h"
@@ -524,6 +525,35 @@ TEST(PickleTest, DeepCopyResize) {
   EXPECT_EQ(pickle.capacity_after_header(), pickle2.capacity_after_header());
 }
 
+TEST(PickleTest, Move) {
+  Pickle pickle;
+  pickle.WriteInt(1);
+  pickle.WriteString("two");
+  const void* data = pickle.data();
+
+  // Moving takes the buffer rather than copying it.
+  Pickle pickle2(std::move(pickle));
+  EXPECT_EQ(data, pickle2.data());
+
+  Pickle pickle3;
+  pickle3.WriteInt(3);
+  pickle3 = std::move(pickle2);
+  EXPECT_EQ(data, pickle3.data());
+
+  PickleIterator iter(pickle3);
+  int int_result;
+  std::string string_result;
+  EXPECT_TRUE(iter.ReadInt(&int_result));
+  EXPECT_EQ(1, int_result);
+  EXPECT_TRUE(iter.ReadString(&string_result));
+  EXPECT_EQ("two", string_result);
+
+  // A moved-from pickle can be written to again once assigned to.
+  pickle = Pickle();
+  pickle.WriteInt(4);
+  EXPECT_EQ(sizeof(int), pickle.payload_size());
+}
+
 namespace {
 
 // Publicly exposes the ClaimBytes interface for testing.
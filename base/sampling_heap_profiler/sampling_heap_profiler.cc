@@ -17,6 +17,7 @@
 #include "base/no_destructor.h"
 #include "base/partition_alloc_buildflags.h"
 #include "base/sampling_heap_profiler/lock_free_address_hash_set.h"
+#include "base/stl_util.h"
 #include "base/threading/thread_id_name_manager.h"
 #include "base/threading/thread_local_storage.h"
 #include "base/trace_event/heap_profiler_allocation_context_tracker.h"
@@ -85,14 +86,46 @@ const char* UpdateAndGetThreadName(const char* name) {
 
 }  // namespace
 
+// Samples of a thread which weren't published yet, see SetBatchSamples().
+// |lock| is only contended when another thread reads the profile or frees one
+// of the buffered allocations.
+class SamplingHeapProfiler::ThreadSampleBuffer {
+ public:
+  ThreadSampleBuffer() { samples.reserve(kSampleBatchSize); }
+
+  // Removes the sample of |address|, if any. |lock| must be held.
+  bool Erase(void* address) {
+    lock.AssertAcquired();
+    auto it = std::find_if(samples.begin(), samples.end(),
+                           [address](const std::pair<void*, Sample>& entry) {
+                             return entry.first == address;
+                           });
+    if (it == samples.end())
+      return false;
+    samples.erase(it);
+    return true;
+  }
+
+  Lock lock;
+  std::vector<std::pair<void*, Sample>> samples;
+};
+
+constexpr size_t SamplingHeapProfiler::kSampleBatchSize;
+
 SamplingHeapProfiler::Sample::Sample(size_t size,
                                      size_t total,
                                      uint32_t ordinal)
     : size(size), total(total), ordinal(ordinal) {}
 
 SamplingHeapProfiler::Sample::Sample(const Sample&) = default;
+SamplingHeapProfiler::Sample::Sample(Sample&&) = default;
 SamplingHeapProfiler::Sample::~Sample() = default;
 
+SamplingHeapProfiler::Sample& SamplingHeapProfiler::Sample::operator=(
+    const Sample&) = default;
+SamplingHeapProfiler::Sample& SamplingHeapProfiler::Sample::operator=(
+    Sample&&) = default;
+
 SamplingHeapProfiler::SamplingHeapProfiler() = default;
 SamplingHeapProfiler::~SamplingHeapProfiler() = default;
 
@@ -131,6 +164,14 @@ void SamplingHeapProfiler::SetRecordThreadNames(bool value) {
   }
 }
 
+void SamplingHeapProfiler::SetStackUnwinder(StackUnwinder unwinder) {
+  stack_unwinder_ = unwinder;
+}
+
+void SamplingHeapProfiler::SetBatchSamples(bool value) {
+  batch_samples_ = value;
+}
+
 // static
 const char* SamplingHeapProfiler::CachedThreadName() {
   return UpdateAndGetThreadName(nullptr);
@@ -174,7 +215,6 @@ void SamplingHeapProfiler::SampleAdded(
   if (UNLIKELY(base::ThreadLocalStorage::HasBeenDestroyed()))
     return;
   DCHECK(PoissonAllocationSampler::ScopedMuteThreadSamples::IsMuted());
-  AutoLock lock(mutex_);
   Sample sample(size, total, ++last_sample_ordinal_);
   sample.allocator = type;
   using CaptureMode = trace_event::AllocationContextTracker::CaptureMode;
@@ -182,10 +222,20 @@ void SamplingHeapProfiler::SampleAdded(
       trace_event::AllocationContextTracker::capture_mode();
   if (capture_mode == CaptureMode::PSEUDO_STACK ||
       capture_mode == CaptureMode::MIXED_STACK) {
+    // Pseudo stack frames are recorded in |strings_|.
+    AutoLock lock(mutex_);
     CaptureMixedStack(context, &sample);
-  } else {
-    CaptureNativeStack(context, &sample);
+    RecordString(sample.context);
+    samples_.emplace(address, std::move(sample));
+    return;
+  }
+
+  CaptureNativeStack(context, &sample);
+  if (batch_samples_.load(std::memory_order_relaxed)) {
+    BufferSample(address, std::move(sample));
+    return;
   }
+  AutoLock lock(mutex_);
   RecordString(sample.context);
   samples_.emplace(address, std::move(sample));
 }
@@ -222,9 +272,20 @@ void SamplingHeapProfiler::CaptureNativeStack(const char* context,
                                               Sample* sample) {
   void* stack[kMaxStackEntries];
   size_t frame_count;
+  void** first_frame;
   // One frame is reserved for the thread name.
-  void** first_frame =
-      CaptureStackTrace(stack, kMaxStackEntries - 1, &frame_count);
+#if BUILDFLAG(CAN_UNWIND_WITH_FRAME_POINTERS)
+  if (stack_unwinder_.load(std::memory_order_relaxed) ==
+      StackUnwinder::kFramePointers) {
+    // Skip this function and SampleAdded(), like CaptureStackTrace() does.
+    frame_count = base::debug::TraceStackFramePointers(
+        const_cast<const void**>(stack), kMaxStackEntries - 1, 2);
+    first_frame = stack;
+  } else
+#endif
+  {
+    first_frame = CaptureStackTrace(stack, kMaxStackEntries - 1, &frame_count);
+  }
   DCHECK_LT(frame_count, kMaxStackEntries);
   sample->stack.assign(first_frame, first_frame + frame_count);
 
@@ -244,10 +305,74 @@ const char* SamplingHeapProfiler::RecordString(const char* string) {
   return string ? *strings_.insert(string).first : nullptr;
 }
 
+void SamplingHeapProfiler::BufferSample(void* address, Sample sample) {
+  auto* buffer = static_cast<ThreadSampleBuffer*>(thread_buffer_slot_.Get());
+  if (UNLIKELY(!buffer)) {
+    buffer = new ThreadSampleBuffer();
+    thread_buffer_slot_.Set(buffer);
+    AutoLock lock(mutex_);
+    thread_buffers_.push_back(buffer);
+  }
+  {
+    AutoLock buffer_lock(buffer->lock);
+    buffer->samples.emplace_back(address, std::move(sample));
+    if (buffer->samples.size() < kSampleBatchSize)
+      return;
+  }
+  // |mutex_| is acquired before the buffer locks.
+  AutoLock lock(mutex_);
+  PublishBufferLocked(buffer);
+}
+
+bool SamplingHeapProfiler::RemoveSampleFromCurrentThreadBuffer(
+    void* address) {
+  if (UNLIKELY(base::ThreadLocalStorage::HasBeenDestroyed()))
+    return false;
+  auto* buffer = static_cast<ThreadSampleBuffer*>(thread_buffer_slot_.Get());
+  if (!buffer)
+    return false;
+  AutoLock buffer_lock(buffer->lock);
+  return buffer->Erase(address);
+}
+
+void SamplingHeapProfiler::PublishBufferLocked(ThreadSampleBuffer* buffer) {
+  mutex_.AssertAcquired();
+  AutoLock buffer_lock(buffer->lock);
+  for (auto& entry : buffer->samples) {
+    RecordString(entry.second.context);
+    samples_.emplace(entry.first, std::move(entry.second));
+  }
+  buffer->samples.clear();
+}
+
+// static
+void SamplingHeapProfiler::OnThreadExit(void* buffer) {
+  auto* thread_buffer = static_cast<ThreadSampleBuffer*>(buffer);
+  SamplingHeapProfiler* profiler = Get();
+  {
+    PoissonAllocationSampler::ScopedMuteThreadSamples no_samples_scope;
+    AutoLock lock(profiler->mutex_);
+    profiler->PublishBufferLocked(thread_buffer);
+    base::Erase(profiler->thread_buffers_, thread_buffer);
+  }
+  delete thread_buffer;
+}
+
 void SamplingHeapProfiler::SampleRemoved(void* address) {
   DCHECK(base::PoissonAllocationSampler::ScopedMuteThreadSamples::IsMuted());
+  // Sampled allocations are often freed by the thread which made them.
+  if (RemoveSampleFromCurrentThreadBuffer(address))
+    return;
   base::AutoLock lock(mutex_);
-  samples_.erase(address);
+  if (samples_.erase(address))
+    return;
+  // The allocation may have been sampled by a thread which didn't publish its
+  // buffer yet.
+  for (ThreadSampleBuffer* buffer : thread_buffers_) {
+    AutoLock buffer_lock(buffer->lock);
+    if (buffer->Erase(address))
+      return;
+  }
 }
 
 std::vector<SamplingHeapProfiler::Sample> SamplingHeapProfiler::GetSamples(
@@ -257,6 +382,8 @@ std::vector<SamplingHeapProfiler::Sample> SamplingHeapProfiler::GetSamples(
   // See crbug.com/882495
   PoissonAllocationSampler::ScopedMuteThreadSamples no_samples_scope;
   AutoLock lock(mutex_);
+  for (ThreadSampleBuffer* buffer : thread_buffers_)
+    PublishBufferLocked(buffer);
   std::vector<Sample> samples;
   samples.reserve(samples_.size());
   for (auto& it : samples_) {
@@ -270,6 +397,8 @@ std::vector<SamplingHeapProfiler::Sample> SamplingHeapProfiler::GetSamples(
 std::vector<const char*> SamplingHeapProfiler::GetStrings() {
   PoissonAllocationSampler::ScopedMuteThreadSamples no_samples_scope;
   AutoLock lock(mutex_);
+  for (ThreadSampleBuffer* buffer : thread_buffers_)
+    PublishBufferLocked(buffer);
   return std::vector<const char*>(strings_.begin(), strings_.end());
 }
 
@@ -14,6 +14,7 @@
 #include "base/macros.h"
 #include "base/sampling_heap_profiler/poisson_allocation_sampler.h"
 #include "base/synchronization/lock.h"
+#include "base/threading/thread_local_storage.h"
 
 namespace base {
 
@@ -30,8 +31,12 @@ class BASE_EXPORT SamplingHeapProfiler
   class BASE_EXPORT Sample {
    public:
     Sample(const Sample&);
+    Sample(Sample&&);
     ~Sample();
 
+    Sample& operator=(const Sample&);
+    Sample& operator=(Sample&&);
+
     // Allocation size.
     size_t size;
     // Total size attributed to the sample.
@@ -58,6 +63,21 @@ class BASE_EXPORT SamplingHeapProfiler
     uint32_t ordinal;
   };
 
+  // Unwinders used to capture the native call stack of the samples.
+  enum class StackUnwinder {
+    // The most reliable unwinder available on the platform.
+    kDefault,
+    // Only follows frame pointers. This is much cheaper than unwinding with
+    // CFI tables, but stacks stop at the first frame built without frame
+    // pointers. Same as kDefault if the build can't unwind with frame
+    // pointers.
+    kFramePointers,
+  };
+
+  // Number of samples a thread accumulates before publishing them, see
+  // SetBatchSamples().
+  static constexpr size_t kSampleBatchSize = 16;
+
   // Starts collecting allocation samples. Returns the current profile_id.
   // This value can then be passed to |GetSamples| to retrieve only samples
   // recorded since the corresponding |Start| invocation.
@@ -72,6 +92,16 @@ class BASE_EXPORT SamplingHeapProfiler
   // Enables recording thread name that made the sampled allocation.
   void SetRecordThreadNames(bool value);
 
+  // Selects the unwinder used for native call stacks.
+  void SetStackUnwinder(StackUnwinder unwinder);
+
+  // Enables accumulating the samples of each thread in a per-thread buffer,
+  // which is published to the profile every |kSampleBatchSize| samples, when
+  // the thread exits, or when the profile is read. This avoids contending on
+  // the profile lock for each sample. Samples with pseudo stacks, see
+  // AllocationContextTracker::CaptureMode, are never buffered.
+  void SetBatchSamples(bool value);
+
   // Returns the current thread name.
   static const char* CachedThreadName();
 
@@ -96,6 +126,8 @@ class BASE_EXPORT SamplingHeapProfiler
   static SamplingHeapProfiler* Get();
 
  private:
+  class ThreadSampleBuffer;
+
   SamplingHeapProfiler();
   ~SamplingHeapProfiler() override;
 
@@ -111,6 +143,20 @@ class BASE_EXPORT SamplingHeapProfiler
   void CaptureNativeStack(const char* context, Sample* sample);
   const char* RecordString(const char* string);
 
+  // Adds |sample| to the buffer of the current thread, and publishes the
+  // buffer if it is full.
+  void BufferSample(void* address, Sample sample);
+
+  // Removes the sample of |address| from the buffer of the current thread.
+  // Returns false if the buffer doesn't have it.
+  bool RemoveSampleFromCurrentThreadBuffer(void* address);
+
+  // Moves the samples of |buffer| to |samples_|. |mutex_| must be held.
+  void PublishBufferLocked(ThreadSampleBuffer* buffer);
+
+  // Publishes and unregisters the buffer of an exiting thread.
+  static void OnThreadExit(void* buffer);
+
   // Mutex to access |samples_| and |strings_|.
   Lock mutex_;
 
@@ -125,6 +171,13 @@ class BASE_EXPORT SamplingHeapProfiler
   // deleted.
   std::unordered_set<const char*> strings_;
 
+  // Buffers of the threads which recorded samples while SetBatchSamples() was
+  // enabled, guarded by |mutex_|. Their samples aren't in |samples_| yet.
+  std::vector<ThreadSampleBuffer*> thread_buffers_;
+
+  // Holds the buffer of the current thread.
+  ThreadLocalStorage::Slot thread_buffer_slot_{&OnThreadExit};
+
   // Mutex to make |running_sessions_| and Add/Remove samples observer access
   // atomic.
   Lock start_stop_mutex_;
@@ -138,6 +191,11 @@ class BASE_EXPORT SamplingHeapProfiler
   // Whether it should record thread names.
   std::atomic<bool> record_thread_names_{false};
 
+  // Whether samples are accumulated in per-thread buffers.
+  std::atomic<bool> batch_samples_{false};
+
+  std::atomic<StackUnwinder> stack_unwinder_{StackUnwinder::kDefault};
+
   friend class NoDestructor<SamplingHeapProfiler>;
   friend class SamplingHeapProfilerTest;
 
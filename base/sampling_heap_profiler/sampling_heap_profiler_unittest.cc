@@ -5,6 +5,7 @@
 #include "base/sampling_heap_profiler/sampling_heap_profiler.h"
 
 #include <stdlib.h>
+#include <algorithm>
 #include <cinttypes>
 
 #include "base/allocator/allocator_shim.h"
@@ -34,6 +35,15 @@ class SamplingHeapProfilerTest : public ::testing::Test {
     return SamplingHeapProfiler::Get()->running_sessions_;
   }
 
+  static size_t CountSamplesOfSize(uint32_t profile_id, size_t size) {
+    std::vector<SamplingHeapProfiler::Sample> samples =
+        SamplingHeapProfiler::Get()->GetSamples(profile_id);
+    return std::count_if(samples.begin(), samples.end(),
+                         [size](const SamplingHeapProfiler::Sample& sample) {
+                           return sample.size == size;
+                         });
+  }
+
   static void RunStartStopLoop(SamplingHeapProfiler* profiler) {
     for (int i = 0; i < 100000; ++i) {
       profiler->Start();
@@ -285,4 +295,120 @@ TEST_F(SamplingHeapProfilerTest, StartStop) {
   EXPECT_EQ(0, GetRunningSessionsCount());
 }
 
+// Allocates |size| bytes, and frees them after |free_event| is signaled if
+// it isn't null.
+class AllocatingThread : public SimpleThread {
+ public:
+  AllocatingThread(size_t size, WaitableEvent* free_event)
+      : SimpleThread("AllocatingThread"),
+        size_(size),
+        free_event_(free_event) {}
+
+  void Run() override {
+    // The first allocations of a thread may not be sampled.
+    free(malloc(size_));
+    address_ = malloc(size_);
+    allocated_event.Signal();
+    if (!free_event_)
+      return;
+    free_event_->Wait();
+    free(address_);
+  }
+
+  void* address() const { return address_; }
+
+  WaitableEvent allocated_event;
+
+ private:
+  const size_t size_;
+  WaitableEvent* const free_event_;
+  void* volatile address_ = nullptr;
+};
+
+TEST_F(SamplingHeapProfilerTest, BatchSamples) {
+  constexpr size_t kSize = 12345;
+  auto* profiler = SamplingHeapProfiler::Get();
+  PoissonAllocationSampler::Get()->SuppressRandomnessForTest(true);
+  profiler->SetSamplingInterval(1024);
+  profiler->SetBatchSamples(true);
+  uint32_t id = profiler->Start();
+
+  // Buffered samples are published when the profile is read.
+  void* volatile p = malloc(kSize);
+  EXPECT_EQ(1u, CountSamplesOfSize(id, kSize));
+  free(p);
+  EXPECT_EQ(0u, CountSamplesOfSize(id, kSize));
+
+  // Samples removed before being published never show up.
+  p = malloc(kSize);
+  free(p);
+  EXPECT_EQ(0u, CountSamplesOfSize(id, kSize));
+
+  // Samples of full batches are kept as well.
+  std::vector<void*> allocations;
+  for (size_t i = 0; i < SamplingHeapProfiler::kSampleBatchSize + 1; ++i)
+    allocations.push_back(malloc(kSize));
+  EXPECT_EQ(SamplingHeapProfiler::kSampleBatchSize + 1,
+            CountSamplesOfSize(id, kSize));
+  for (void* allocation : allocations)
+    free(allocation);
+  EXPECT_EQ(0u, CountSamplesOfSize(id, kSize));
+
+  profiler->Stop();
+  profiler->SetBatchSamples(false);
+}
+
+TEST_F(SamplingHeapProfilerTest, BatchSamplesOfOtherThreads) {
+  constexpr size_t kSize = 23456;
+  auto* profiler = SamplingHeapProfiler::Get();
+  PoissonAllocationSampler::Get()->SuppressRandomnessForTest(true);
+  profiler->SetSamplingInterval(1024);
+  profiler->SetBatchSamples(true);
+  uint32_t id = profiler->Start();
+
+  // The buffer of a thread is published when it exits.
+  AllocatingThread exiting_thread(kSize, nullptr);
+  exiting_thread.Start();
+  exiting_thread.Join();
+  EXPECT_EQ(1u, CountSamplesOfSize(id, kSize));
+  free(exiting_thread.address());
+  EXPECT_EQ(0u, CountSamplesOfSize(id, kSize));
+
+  // An allocation freed by another thread is removed from the buffer of the
+  // thread which sampled it.
+  WaitableEvent free_event;
+  AllocatingThread thread(kSize, &free_event);
+  thread.Start();
+  thread.allocated_event.Wait();
+  free(thread.address());
+  free_event.Signal();
+  thread.Join();
+  EXPECT_EQ(0u, CountSamplesOfSize(id, kSize));
+
+  profiler->Stop();
+  profiler->SetBatchSamples(false);
+}
+
+TEST_F(SamplingHeapProfilerTest, FramePointerUnwinder) {
+  constexpr size_t kSize = 34567;
+  auto* profiler = SamplingHeapProfiler::Get();
+  PoissonAllocationSampler::Get()->SuppressRandomnessForTest(true);
+  profiler->SetSamplingInterval(1024);
+  profiler->SetStackUnwinder(
+      SamplingHeapProfiler::StackUnwinder::kFramePointers);
+  uint32_t id = profiler->Start();
+
+  void* volatile p = malloc(kSize);
+  std::vector<SamplingHeapProfiler::Sample> samples = profiler->GetSamples(id);
+  free(p);
+  auto it = std::find_if(
+      samples.begin(), samples.end(),
+      [](const SamplingHeapProfiler::Sample& s) { return s.size == kSize; });
+  ASSERT_NE(samples.end(), it);
+  EXPECT_FALSE(it->stack.empty());
+
+  profiler->Stop();
+  profiler->SetStackUnwinder(SamplingHeapProfiler::StackUnwinder::kDefault);
+}
+
 }  // namespace base
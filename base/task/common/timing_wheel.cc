@@ -0,0 +1,288 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/task/common/timing_wheel.h"
+
+#include <algorithm>
+#include <limits>
+
+#include "base/bits.h"
+
+namespace base {
+namespace internal {
+
+namespace {
+
+constexpr int kWheelBits =
+    TimingWheelBase::kSlotBits * TimingWheelBase::kNumLevels;
+
+// Returns a mask of the bits of a slot bitmap above |slot|.
+uint64_t MaskAbove(int slot) {
+  if (slot == TimingWheelBase::kNumSlots - 1)
+    return 0;
+  return ~uint64_t{0} << (slot + 1);
+}
+
+}  // namespace
+
+constexpr int TimingWheelBase::kSlotBits;
+constexpr int TimingWheelBase::kNumSlots;
+constexpr int TimingWheelBase::kNumLevels;
+constexpr int TimingWheelBase::kReadyLevel;
+constexpr int TimingWheelBase::kOverflowLevel;
+
+TimingWheelBase::TimingWheelBase(TimeDelta granularity)
+    : granularity_us_(granularity.InMicroseconds()) {
+  DCHECK_GT(granularity_us_, 0);
+}
+
+TimingWheelBase::~TimingWheelBase() {
+  // TimingWheel deletes the nodes.
+  DCHECK(empty());
+}
+
+void TimingWheelBase::Advance(TimeTicks now) {
+  const int64_t target_tick = TickForTime(now, /* round_up=*/false);
+  if (target_tick <= current_tick_)
+    return;
+
+  // Jump from one non-empty slot to the next rather than visiting every tick,
+  // so that a long idle period doesn't cost anything.
+  for (;;) {
+    const int64_t event_tick = NextEventTick();
+    if (event_tick > target_tick)
+      break;
+    current_tick_ = event_tick;
+    ProcessEventTick(event_tick);
+  }
+  current_tick_ = target_tick;
+}
+
+TimeTicks TimingWheelBase::NextRunTime() const {
+  if (empty())
+    return TimeTicks::Max();
+  if (next_tick_valid_)
+    return TimeForTick(next_tick_);
+
+  if (ready_.head) {
+    // |ready_| is sorted by run time, and ready nodes are due before all the
+    // others.
+    next_tick_ = ready_.head->tick;
+  } else {
+    next_tick_ = std::numeric_limits<int64_t>::max();
+    // The first non-empty slot of the lowest non-empty level holds the
+    // earliest nodes. All the nodes of a level 0 slot share a tick, but a
+    // higher level slot spans multiple ticks.
+    for (int level = 0; level < kNumLevels; ++level) {
+      const int shift = kSlotBits * level;
+      const int current_slot = (current_tick_ >> shift) & (kNumSlots - 1);
+      DCHECK(!(occupied_[level] & ~MaskAbove(current_slot)));
+      const uint64_t occupied = occupied_[level] & MaskAbove(current_slot);
+      if (occupied) {
+        next_tick_ = MinTick(slots_[level][bits::CountTrailingZeroBits(
+            occupied)]);
+        break;
+      }
+    }
+    if (next_tick_ == std::numeric_limits<int64_t>::max())
+      next_tick_ = MinTick(overflow_);
+  }
+  next_tick_valid_ = true;
+  return TimeForTick(next_tick_);
+}
+
+void TimingWheelBase::Link(TimingWheelNode* node, TimeTicks run_time) {
+  DCHECK(!run_time.is_max());
+  node->run_time = run_time;
+  node->tick = TickForTime(run_time, /* round_up=*/true);
+  Place(node);
+  ++size_;
+  if (next_tick_valid_)
+    next_tick_ = std::min(next_tick_, node->tick);
+}
+
+void TimingWheelBase::Unlink(TimingWheelNode* node) {
+  DCHECK_GT(size_, 0u);
+  Remove(ListFor(node->level, node->slot), node);
+  if (node->level != kReadyLevel && node->level != kOverflowLevel &&
+      !slots_[node->level][node->slot].head) {
+    occupied_[node->level] &= ~(uint64_t{1} << node->slot);
+  }
+  --size_;
+  if (next_tick_valid_ && node->tick == next_tick_)
+    next_tick_valid_ = false;
+}
+
+TimingWheelNode* TimingWheelBase::UnlinkAny() {
+  TimingWheelNode* node = ready_.head;
+  for (int level = 0; !node && level < kNumLevels; ++level) {
+    if (occupied_[level]) {
+      node =
+          slots_[level][bits::CountTrailingZeroBits(occupied_[level])].head;
+    }
+  }
+  if (!node)
+    node = overflow_.head;
+  if (node)
+    Unlink(node);
+  return node;
+}
+
+TimingWheelBase::List* TimingWheelBase::ListFor(int level, int slot) {
+  if (level == kReadyLevel)
+    return &ready_;
+  if (level == kOverflowLevel)
+    return &overflow_;
+  return &slots_[level][slot];
+}
+
+// static
+void TimingWheelBase::Append(List* list, TimingWheelNode* node) {
+  node->prev = list->tail;
+  node->next = nullptr;
+  if (list->tail)
+    list->tail->next = node;
+  else
+    list->head = node;
+  list->tail = node;
+}
+
+// static
+void TimingWheelBase::Remove(List* list, TimingWheelNode* node) {
+  if (node->prev)
+    node->prev->next = node->next;
+  else
+    list->head = node->next;
+  if (node->next)
+    node->next->prev = node->prev;
+  else
+    list->tail = node->prev;
+  node->prev = nullptr;
+  node->next = nullptr;
+}
+
+int64_t TimingWheelBase::TickForTime(TimeTicks time, bool round_up) const {
+  const int64_t us = (time - TimeTicks()).InMicroseconds();
+  DCHECK_GE(us, 0);
+  return (us + (round_up ? granularity_us_ - 1 : 0)) / granularity_us_;
+}
+
+TimeTicks TimingWheelBase::TimeForTick(int64_t tick) const {
+  return TimeTicks() + TimeDelta::FromMicroseconds(tick * granularity_us_);
+}
+
+void TimingWheelBase::Place(TimingWheelNode* node) {
+  const int64_t tick = node->tick;
+  if (tick <= current_tick_) {
+    node->level = kReadyLevel;
+    // Nodes usually become ready in order of run time, in which case this
+    // doesn't walk the list.
+    TimingWheelNode* previous = ready_.tail;
+    while (previous && previous->run_time > node->run_time)
+      previous = previous->prev;
+    if (!previous) {
+      node->prev = nullptr;
+      node->next = ready_.head;
+      if (ready_.head)
+        ready_.head->prev = node;
+      else
+        ready_.tail = node;
+      ready_.head = node;
+    } else if (previous == ready_.tail) {
+      Append(&ready_, node);
+    } else {
+      node->prev = previous;
+      node->next = previous->next;
+      previous->next->prev = node;
+      previous->next = node;
+    }
+    return;
+  }
+
+  // A node goes in the lowest level in which it is in the same rotation as
+  // |current_tick_|. It is then always in a slot after the current one.
+  for (int level = 0; level < kNumLevels; ++level) {
+    const int shift = kSlotBits * (level + 1);
+    if ((tick >> shift) == (current_tick_ >> shift)) {
+      const int slot = (tick >> (kSlotBits * level)) & (kNumSlots - 1);
+      node->level = level;
+      node->slot = slot;
+      Append(&slots_[level][slot], node);
+      occupied_[level] |= uint64_t{1} << slot;
+      return;
+    }
+  }
+  node->level = kOverflowLevel;
+  Append(&overflow_, node);
+}
+
+int64_t TimingWheelBase::NextEventTick() const {
+  for (int level = 0; level < kNumLevels; ++level) {
+    const int shift = kSlotBits * level;
+    const int current_slot = (current_tick_ >> shift) & (kNumSlots - 1);
+    const uint64_t occupied = occupied_[level] & MaskAbove(current_slot);
+    if (occupied) {
+      const int64_t rotation_start =
+          (current_tick_ >> (shift + kSlotBits)) << (shift + kSlotBits);
+      return rotation_start |
+             (int64_t{bits::CountTrailingZeroBits(occupied)} << shift);
+    }
+  }
+  if (overflow_.head) {
+    // Overflow nodes are re-placed once |current_tick_| reaches the rotation
+    // of the earliest of them.
+    const int64_t rotation_start = (MinTick(overflow_) >> kWheelBits)
+                                   << kWheelBits;
+    return std::max(current_tick_ + 1, rotation_start);
+  }
+  return std::numeric_limits<int64_t>::max();
+}
+
+void TimingWheelBase::ProcessEventTick(int64_t tick) {
+  DCHECK_EQ(tick, current_tick_);
+
+  // Re-places all the nodes of |list|. |list| must have been detached from
+  // the wheel.
+  auto replace_all = [this](List list) {
+    TimingWheelNode* node = list.head;
+    while (node) {
+      TimingWheelNode* next = node->next;
+      Place(node);
+      node = next;
+    }
+  };
+
+  if (overflow_.head &&
+      (MinTick(overflow_) >> kWheelBits) <= (tick >> kWheelBits)) {
+    List overflow = overflow_;
+    overflow_ = List();
+    replace_all(overflow);
+  }
+
+  // Process higher levels first: their nodes cascade down to the lower levels,
+  // possibly into a slot which is due at |tick| as well.
+  for (int level = kNumLevels - 1; level >= 0; --level) {
+    const int shift = kSlotBits * level;
+    if (tick & ((int64_t{1} << shift) - 1))
+      continue;
+    const int slot = (tick >> shift) & (kNumSlots - 1);
+    if (!(occupied_[level] & (uint64_t{1} << slot)))
+      continue;
+    List list = slots_[level][slot];
+    slots_[level][slot] = List();
+    occupied_[level] &= ~(uint64_t{1} << slot);
+    replace_all(list);
+  }
+}
+
+// static
+int64_t TimingWheelBase::MinTick(const List& list) {
+  int64_t min_tick = std::numeric_limits<int64_t>::max();
+  for (const TimingWheelNode* node = list.head; node; node = node->next)
+    min_tick = std::min(min_tick, node->tick);
+  return min_tick;
+}
+
+}  // namespace internal
+}  // namespace base
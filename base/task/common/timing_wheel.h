@@ -0,0 +1,243 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef BASE_TASK_COMMON_TIMING_WHEEL_H_
+#define BASE_TASK_COMMON_TIMING_WHEEL_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <utility>
+
+#include "base/base_export.h"
+#include "base/logging.h"
+#include "base/macros.h"
+#include "base/time/time.h"
+
+namespace base {
+namespace internal {
+
+class TimingWheelBase;
+template <typename T>
+class TimingWheel;
+
+// Links an entry of a TimingWheel into the list of its slot. Only meant to be
+// used by TimingWheel.
+struct TimingWheelNode {
+  TimingWheelNode* prev = nullptr;
+  TimingWheelNode* next = nullptr;
+  TimeTicks run_time;
+  // |run_time| rounded up to the wheel's granularity.
+  int64_t tick = 0;
+  // Location of the node, see TimingWheelBase::ListFor().
+  int level = 0;
+  int slot = 0;
+};
+
+// Intended as an opaque wrapper around a TimingWheel entry.
+class TimingWheelHandle {
+ public:
+  TimingWheelHandle() = default;
+
+  bool IsValid() const { return node_ != nullptr; }
+
+ private:
+  friend class TimingWheelBase;
+  template <typename T>
+  friend class TimingWheel;
+
+  explicit TimingWheelHandle(TimingWheelNode* node) : node_(node) {}
+
+  TimingWheelNode* node_ = nullptr;
+};
+
+// Type-independent part of TimingWheel.
+class BASE_EXPORT TimingWheelBase {
+ public:
+  // Each level has 64 slots and covers 64 times the range of the level below
+  // it. With a granularity of 1ms, the four levels cover ~4.6 hours. Entries
+  // further in the future are kept in an overflow list, which is scanned
+  // linearly.
+  static constexpr int kSlotBits = 6;
+  static constexpr int kNumSlots = 1 << kSlotBits;
+  static constexpr int kNumLevels = 4;
+
+  size_t size() const { return size_; }
+  bool empty() const { return size_ == 0; }
+
+  TimeDelta granularity() const {
+    return TimeDelta::FromMicroseconds(granularity_us_);
+  }
+
+  // Makes ready all entries whose run time, rounded up to the granularity, is
+  // <= |now|. Cost is proportional to the number of entries that are moved
+  // between levels, not to the time elapsed since the last call.
+  void Advance(TimeTicks now);
+
+  // Returns the rounded up run time of the earliest entry, or
+  // TimeTicks::Max() if the wheel is empty. Entries which round up to the same
+  // time share a wake-up.
+  TimeTicks NextRunTime() const;
+
+  // Returns true if Advance() made entries ready which weren't removed yet.
+  bool HasReady() const { return ready_.head != nullptr; }
+
+ protected:
+  explicit TimingWheelBase(TimeDelta granularity);
+  ~TimingWheelBase();
+
+  // Adds |node|, due at |run_time|, to the wheel. O(1), unless |node| is due
+  // already and other ready nodes are due later than it.
+  void Link(TimingWheelNode* node, TimeTicks run_time);
+
+  // Removes |node| from the wheel. O(1).
+  void Unlink(TimingWheelNode* node);
+
+  // Returns the ready node with the earliest run time.
+  TimingWheelNode* ready_front() const { return ready_.head; }
+
+  // Unlinks and returns an arbitrary node, or nullptr if the wheel is empty.
+  TimingWheelNode* UnlinkAny();
+
+ private:
+  struct List {
+    TimingWheelNode* head = nullptr;
+    TimingWheelNode* tail = nullptr;
+  };
+
+  // Values of TimingWheelNode::level for nodes which aren't in a slot.
+  static constexpr int kReadyLevel = -1;
+  static constexpr int kOverflowLevel = kNumLevels;
+
+  List* ListFor(int level, int slot);
+  static void Append(List* list, TimingWheelNode* node);
+  static void Remove(List* list, TimingWheelNode* node);
+
+  int64_t TickForTime(TimeTicks time, bool round_up) const;
+  TimeTicks TimeForTick(int64_t tick) const;
+
+  // Links |node| in the slot matching |node->tick| relative to
+  // |current_tick_|, or in |ready_| (sorted by run time) if it's due.
+  void Place(TimingWheelNode* node);
+
+  // Returns the first tick after |current_tick_| at which a slot (or the
+  // overflow list) has to be processed. This is a lower bound of the earliest
+  // tick of the entries in that slot.
+  int64_t NextEventTick() const;
+
+  // Re-places the nodes of all the slots due at |tick|.
+  void ProcessEventTick(int64_t tick);
+
+  // Returns the earliest tick of the nodes in |list|.
+  static int64_t MinTick(const List& list);
+
+  const int64_t granularity_us_;
+
+  // All the ticks <= |current_tick_| have been processed: their nodes are in
+  // |ready_|.
+  int64_t current_tick_ = 0;
+
+  List slots_[kNumLevels][kNumSlots];
+  // Bit i of |occupied_[level]| is set iff |slots_[level][i]| isn't empty.
+  uint64_t occupied_[kNumLevels] = {};
+  List overflow_;
+  List ready_;
+  size_t size_ = 0;
+
+  // Caches the result of NextRunTime(), which may have to scan a slot.
+  mutable bool next_tick_valid_ = false;
+  mutable int64_t next_tick_ = 0;
+
+  DISALLOW_COPY_AND_ASSIGN(TimingWheelBase);
+};
+
+// A hierarchical timing wheel: a priority queue keyed by TimeTicks with O(1)
+// insertion and removal, at the cost of only ordering entries with a
+// resolution of |granularity|. This is a good fit for a large number of
+// timeouts that are mostly cancelled before they expire. Entries become ready
+// once Advance() is called with a time >= their run time rounded up to the
+// granularity, which coalesces the wake-ups of nearby entries. Ready entries
+// are ordered by run time.
+//
+// Like IntrusiveHeap, T must have:
+// 1. A method void SetTimingWheelHandle(TimingWheelHandle handle)
+// 2. A method void ClearTimingWheelHandle()
+// 3. A move constructor and a move assignment operator
+template <typename T>
+class TimingWheel : public TimingWheelBase {
+ public:
+  explicit TimingWheel(TimeDelta granularity) : TimingWheelBase(granularity) {}
+
+  ~TimingWheel() {
+    while (TimingWheelNode* node = UnlinkAny())
+      DeleteNode(static_cast<Node*>(node));
+  }
+
+  // Adds |value| which is due at |run_time|.
+  void insert(TimeTicks run_time, T value) {
+    Node* node = new Node(std::move(value));
+    Link(node, run_time);
+    node->value.SetTimingWheelHandle(TimingWheelHandle(node));
+  }
+
+  // Replaces the entry for |handle| with |value|, due at |run_time|.
+  void ChangeKey(TimingWheelHandle handle, TimeTicks run_time, T value) {
+    DCHECK(handle.IsValid());
+    Node* node = static_cast<Node*>(handle.node_);
+    Unlink(node);
+    node->value = std::move(value);
+    Link(node, run_time);
+    node->value.SetTimingWheelHandle(handle);
+  }
+
+  void erase(TimingWheelHandle handle) {
+    DCHECK(handle.IsValid());
+    Node* node = static_cast<Node*>(handle.node_);
+    Unlink(node);
+    DeleteNode(node);
+  }
+
+  const T& at(TimingWheelHandle handle) const {
+    DCHECK(handle.IsValid());
+    return static_cast<const Node*>(handle.node_)->value;
+  }
+
+  // Returns the ready entry with the earliest run time. Must only be called
+  // if HasReady().
+  const T& ReadyMin() const {
+    DCHECK(HasReady());
+    return static_cast<const Node*>(ready_front())->value;
+  }
+
+  // Removes and returns the ready entry with the earliest run time. Must only
+  // be called if HasReady().
+  T TakeReadyMin() {
+    DCHECK(HasReady());
+    Node* node = static_cast<Node*>(ready_front());
+    Unlink(node);
+    node->value.ClearTimingWheelHandle();
+    T value = std::move(node->value);
+    delete node;
+    return value;
+  }
+
+ private:
+  struct Node : public TimingWheelNode {
+    explicit Node(T value) : value(std::move(value)) {}
+
+    T value;
+  };
+
+  static void DeleteNode(Node* node) {
+    node->value.ClearTimingWheelHandle();
+    delete node;
+  }
+
+  DISALLOW_COPY_AND_ASSIGN(TimingWheel);
+};
+
+}  // namespace internal
+}  // namespace base
+
+#endif  // BASE_TASK_COMMON_TIMING_WHEEL_H_
@@ -0,0 +1,102 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/task/common/timing_wheel.h"
+
+#include <vector>
+
+#include "base/task/common/intrusive_heap.h"
+#include "base/time/time.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "testing/perf/perf_test.h"
+
+namespace base {
+namespace internal {
+
+namespace {
+
+constexpr int kNumWakeUps = 10000;
+
+// The scheduled wake-up of a timer, as kept by a scheduler time domain.
+struct ScheduledWakeUp {
+  TimeTicks run_time;
+  HeapHandle* heap_handle = nullptr;
+  TimingWheelHandle* wheel_handle = nullptr;
+
+  bool operator<=(const ScheduledWakeUp& other) const {
+    return run_time <= other.run_time;
+  }
+
+  void SetHeapHandle(HeapHandle handle) { *heap_handle = handle; }
+  void ClearHeapHandle() { *heap_handle = HeapHandle(); }
+
+  void SetTimingWheelHandle(TimingWheelHandle handle) {
+    *wheel_handle = handle;
+  }
+  void ClearTimingWheelHandle() { *wheel_handle = TimingWheelHandle(); }
+};
+
+// Run times of wake-ups spread over the next second, like those of timers.
+std::vector<TimeTicks> GetRunTimes(TimeTicks now) {
+  std::vector<TimeTicks> run_times(kNumWakeUps);
+  for (int i = 0; i < kNumWakeUps; i++)
+    run_times[i] = now + TimeDelta::FromMilliseconds(i % 1000);
+  return run_times;
+}
+
+void PrintResults(const std::string& trace,
+                  TimeDelta schedule_time,
+                  TimeDelta cancel_time) {
+  perf_test::PrintResult("schedule_wake_up", "", trace,
+                         schedule_time.InNanoseconds() /
+                             static_cast<double>(kNumWakeUps),
+                         "ns/operation", true);
+  perf_test::PrintResult("cancel_wake_up", "", trace,
+                         cancel_time.InNanoseconds() /
+                             static_cast<double>(kNumWakeUps),
+                         "ns/operation", true);
+}
+
+}  // namespace
+
+// Schedules and then cancels ten thousand wake-ups in the heap that time
+// domains use by default. Compare with the TimingWheel results below, which
+// time domains use after TimeDomain::UseTimingWheel().
+TEST(TimingWheelPerfTest, ScheduleThenCancelWakeUpsInHeap) {
+  const std::vector<TimeTicks> run_times = GetRunTimes(TimeTicks::Now());
+  std::vector<HeapHandle> handles(kNumWakeUps);
+  IntrusiveHeap<ScheduledWakeUp> heap;
+
+  ThreadTicks schedule_start = ThreadTicks::Now();
+  for (int i = 0; i < kNumWakeUps; i++)
+    heap.insert({run_times[i], &handles[i], nullptr});
+  ThreadTicks cancel_start = ThreadTicks::Now();
+  for (int i = 0; i < kNumWakeUps; i++)
+    heap.erase(handles[i]);
+  ThreadTicks cancel_end = ThreadTicks::Now();
+
+  PrintResults("heap", cancel_start - schedule_start, cancel_end - cancel_start);
+}
+
+TEST(TimingWheelPerfTest, ScheduleThenCancelWakeUpsInTimingWheel) {
+  const TimeTicks now = TimeTicks::Now();
+  const std::vector<TimeTicks> run_times = GetRunTimes(now);
+  std::vector<TimingWheelHandle> handles(kNumWakeUps);
+  TimingWheel<ScheduledWakeUp> wheel(TimeDelta::FromMilliseconds(1));
+  wheel.Advance(now);
+
+  ThreadTicks schedule_start = ThreadTicks::Now();
+  for (int i = 0; i < kNumWakeUps; i++)
+    wheel.insert(run_times[i], {run_times[i], nullptr, &handles[i]});
+  ThreadTicks cancel_start = ThreadTicks::Now();
+  for (int i = 0; i < kNumWakeUps; i++)
+    wheel.erase(handles[i]);
+  ThreadTicks cancel_end = ThreadTicks::Now();
+
+  PrintResults("timing_wheel", cancel_start - schedule_start,
+               cancel_end - cancel_start);
+}
+
+}  // namespace internal
+}  // namespace base
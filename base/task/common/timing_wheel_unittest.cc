@@ -0,0 +1,173 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/task/common/timing_wheel.h"
+
+#include <vector>
+
+#include "base/stl_util.h"
+#include "testing/gmock/include/gmock/gmock.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+using testing::ElementsAre;
+
+namespace base {
+namespace internal {
+
+namespace {
+
+struct TestElement {
+  int id;
+  TimingWheelHandle* handle;
+
+  void SetTimingWheelHandle(TimingWheelHandle h) {
+    if (handle)
+      *handle = h;
+  }
+
+  void ClearTimingWheelHandle() {
+    if (handle)
+      *handle = TimingWheelHandle();
+  }
+};
+
+constexpr TimeDelta kGranularity = TimeDelta::FromMilliseconds(1);
+
+class TimingWheelTest : public testing::Test {
+ protected:
+  TimingWheelTest() : wheel_(kGranularity) { wheel_.Advance(start_); }
+
+  TimeTicks At(int64_t ms) const {
+    return start_ + TimeDelta::FromMilliseconds(ms);
+  }
+
+  TimeTicks AtMicroseconds(int64_t us) const {
+    return start_ + TimeDelta::FromMicroseconds(us);
+  }
+
+  // Returns the ids of the ready elements, after advancing to |now|.
+  std::vector<int> AdvanceAndTakeReady(TimeTicks now) {
+    wheel_.Advance(now);
+    std::vector<int> ready;
+    while (wheel_.HasReady())
+      ready.push_back(wheel_.TakeReadyMin().id);
+    return ready;
+  }
+
+  const TimeTicks start_ = TimeTicks() + TimeDelta::FromSeconds(1000);
+  TimingWheel<TestElement> wheel_;
+};
+
+}  // namespace
+
+TEST_F(TimingWheelTest, Basic) {
+  EXPECT_TRUE(wheel_.empty());
+  EXPECT_EQ(0u, wheel_.size());
+  EXPECT_EQ(TimeTicks::Max(), wheel_.NextRunTime());
+  EXPECT_FALSE(wheel_.HasReady());
+}
+
+TEST_F(TimingWheelTest, InsertAndAdvance) {
+  TimingWheelHandle handle;
+  wheel_.insert(At(10), {1, &handle});
+  EXPECT_TRUE(handle.IsValid());
+  EXPECT_EQ(1u, wheel_.size());
+  EXPECT_EQ(At(10), wheel_.NextRunTime());
+
+  EXPECT_THAT(AdvanceAndTakeReady(At(9)), ElementsAre());
+  EXPECT_THAT(AdvanceAndTakeReady(At(10)), ElementsAre(1));
+  EXPECT_FALSE(handle.IsValid());
+  EXPECT_TRUE(wheel_.empty());
+}
+
+TEST_F(TimingWheelTest, RunTimesAreRoundedUp) {
+  wheel_.insert(AtMicroseconds(2100), {1, nullptr});
+  wheel_.insert(AtMicroseconds(2900), {2, nullptr});
+  // Both elements share a wake-up at the next multiple of the granularity.
+  EXPECT_EQ(At(3), wheel_.NextRunTime());
+
+  EXPECT_THAT(AdvanceAndTakeReady(AtMicroseconds(2999)), ElementsAre());
+  EXPECT_THAT(AdvanceAndTakeReady(At(3)), ElementsAre(1, 2));
+}
+
+TEST_F(TimingWheelTest, ReadyElementsAreOrderedByRunTime) {
+  wheel_.insert(AtMicroseconds(2900), {1, nullptr});
+  wheel_.insert(At(5000), {2, nullptr});
+  wheel_.insert(At(70), {3, nullptr});
+  wheel_.insert(AtMicroseconds(2100), {4, nullptr});
+  wheel_.insert(At(4), {5, nullptr});
+
+  EXPECT_THAT(AdvanceAndTakeReady(At(10000)), ElementsAre(4, 1, 5, 3, 2));
+}
+
+TEST_F(TimingWheelTest, InsertInThePast) {
+  wheel_.Advance(At(100));
+  wheel_.insert(At(50), {1, nullptr});
+  EXPECT_TRUE(wheel_.HasReady());
+  EXPECT_EQ(At(50), wheel_.NextRunTime());
+  EXPECT_THAT(AdvanceAndTakeReady(At(100)), ElementsAre(1));
+}
+
+TEST_F(TimingWheelTest, Erase) {
+  TimingWheelHandle handle1;
+  TimingWheelHandle handle2;
+  wheel_.insert(At(10), {1, &handle1});
+  wheel_.insert(At(20), {2, &handle2});
+  EXPECT_EQ(At(10), wheel_.NextRunTime());
+
+  wheel_.erase(handle1);
+  EXPECT_FALSE(handle1.IsValid());
+  EXPECT_EQ(1u, wheel_.size());
+  EXPECT_EQ(At(20), wheel_.NextRunTime());
+
+  EXPECT_THAT(AdvanceAndTakeReady(At(100)), ElementsAre(2));
+}
+
+TEST_F(TimingWheelTest, ChangeKey) {
+  TimingWheelHandle handle;
+  wheel_.insert(At(10), {1, &handle});
+  wheel_.ChangeKey(handle, At(30000), {2, &handle});
+  EXPECT_TRUE(handle.IsValid());
+  EXPECT_EQ(1u, wheel_.size());
+  EXPECT_EQ(At(30000), wheel_.NextRunTime());
+  EXPECT_EQ(2, wheel_.at(handle).id);
+
+  EXPECT_THAT(AdvanceAndTakeReady(At(29999)), ElementsAre());
+  EXPECT_THAT(AdvanceAndTakeReady(At(30000)), ElementsAre(2));
+}
+
+// Elements far in the future go through every level of the wheel, and through
+// the overflow list, before becoming ready.
+TEST_F(TimingWheelTest, Cascade) {
+  const TimeDelta kDelays[] = {
+      TimeDelta::FromMilliseconds(63), TimeDelta::FromMilliseconds(64),
+      TimeDelta::FromSeconds(5),       TimeDelta::FromMinutes(5),
+      TimeDelta::FromHours(3),         TimeDelta::FromDays(2)};
+  for (size_t i = 0; i < base::size(kDelays); ++i)
+    wheel_.insert(start_ + kDelays[i], {static_cast<int>(i), nullptr});
+
+  for (size_t i = 0; i < base::size(kDelays); ++i) {
+    EXPECT_EQ(start_ + kDelays[i], wheel_.NextRunTime());
+    EXPECT_THAT(AdvanceAndTakeReady(start_ + kDelays[i] - kGranularity),
+                ElementsAre());
+    EXPECT_THAT(AdvanceAndTakeReady(start_ + kDelays[i]),
+                ElementsAre(static_cast<int>(i)));
+  }
+  EXPECT_TRUE(wheel_.empty());
+}
+
+TEST_F(TimingWheelTest, DeleteWithPendingElements) {
+  TimingWheelHandle handle1;
+  TimingWheelHandle handle2;
+  {
+    TimingWheel<TestElement> wheel(kGranularity);
+    wheel.insert(At(10), {1, &handle1});
+    wheel.insert(At(100000), {2, &handle2});
+  }
+  EXPECT_FALSE(handle1.IsValid());
+  EXPECT_FALSE(handle2.IsValid());
+}
+
+}  // namespace internal
+}  // namespace base
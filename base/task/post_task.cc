@@ -62,6 +62,10 @@ bool PostDelayedTask(const Location& from_here,
                                    delay);
 }
 
+bool PostTasks(const Location& from_here, std::vector<OnceClosure> tasks) {
+  return PostTasksWithTraits(from_here, TaskTraits(), std::move(tasks));
+}
+
 bool PostTaskAndReply(const Location& from_here,
                       OnceClosure task,
                       OnceClosure reply) {
@@ -86,6 +90,14 @@ bool PostDelayedTaskWithTraits(const Location& from_here,
                                   delay);
 }
 
+bool PostTasksWithTraits(const Location& from_here,
+                         const TaskTraits& traits,
+                         std::vector<OnceClosure> tasks) {
+  const TaskTraits adjusted_traits = GetTaskTraitsWithExplicitPriority(traits);
+  return GetTaskExecutorForTraits(adjusted_traits)
+      ->PostTasksWithTraits(from_here, adjusted_traits, std::move(tasks));
+}
+
 bool PostTaskWithTraitsAndReply(const Location& from_here,
                                 const TaskTraits& traits,
                                 OnceClosure task,
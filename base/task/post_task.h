@@ -7,6 +7,7 @@
 
 #include <memory>
 #include <utility>
+#include <vector>
 
 #include "base/base_export.h"
 #include "base/bind.h"
@@ -87,6 +88,10 @@ BASE_EXPORT bool PostDelayedTask(const Location& from_here,
                                  OnceClosure task,
                                  TimeDelta delay);
 
+// Equivalent to calling PostTasksWithTraits with default TaskTraits.
+BASE_EXPORT bool PostTasks(const Location& from_here,
+                           std::vector<OnceClosure> tasks);
+
 // Equivalent to calling PostTaskWithTraitsAndReply with default TaskTraits.
 BASE_EXPORT bool PostTaskAndReply(const Location& from_here,
                                   OnceClosure task,
@@ -122,6 +127,16 @@ BASE_EXPORT bool PostTaskWithTraits(const Location& from_here,
                                     const TaskTraits& traits,
                                     OnceClosure task);
 
+// Posts all of |tasks| with specific |traits|. This is equivalent to calling
+// PostTaskWithTraits() for each task, but is cheaper when posting many tasks at
+// once (e.g. fanning out work) as the ThreadPool schedules the whole batch with
+// a single lock acquisition. Tasks may run in any order and in parallel.
+// Returns false if at least one task definitely won't run because of current
+// shutdown state.
+BASE_EXPORT bool PostTasksWithTraits(const Location& from_here,
+                                     const TaskTraits& traits,
+                                     std::vector<OnceClosure> tasks);
+
 // Posts |task| with specific |traits|. |task| will not run before |delay|
 // expires. Returns false if the task definitely won't run because of current
 // shutdown state.
@@ -187,6 +187,29 @@ TEST_F(PostTaskTestWithExecutor, PostTaskToTaskExecutor) {
   }
 }
 
+TEST_F(PostTaskTestWithExecutor, PostTasksToTaskExecutor) {
+  // A batch of tasks with extension should go to the executor, which posts
+  // them one by one by default.
+  TaskTraits traits = {TestExtensionBoolTrait()};
+  TaskTraits traits_with_explicit_priority = traits;
+  traits_with_explicit_priority.UpdatePriority(TaskPriority::USER_VISIBLE);
+  EXPECT_CALL(executor_, PostDelayedTaskWithTraitsMock(
+                             _, traits_with_explicit_priority, _, TimeDelta()))
+      .Times(3);
+  std::vector<OnceClosure> tasks;
+  for (int i = 0; i < 3; ++i)
+    tasks.push_back(DoNothing());
+  EXPECT_TRUE(PostTasksWithTraits(FROM_HERE, traits, std::move(tasks)));
+  EXPECT_EQ(3U, executor_.runner()->NumPendingTasks());
+  executor_.runner()->ClearPendingTasks();
+
+  // Tasks without extension should not go to the executor.
+  tasks.clear();
+  tasks.push_back(DoNothing());
+  EXPECT_TRUE(PostTasks(FROM_HERE, std::move(tasks)));
+  EXPECT_FALSE(executor_.runner()->HasPendingTask());
+}
+
 TEST_F(PostTaskTestWithExecutor, RegisterExecutorTwice) {
   testing::FLAGS_gtest_death_test_style = "threadsafe";
   EXPECT_DCHECK_DEATH(
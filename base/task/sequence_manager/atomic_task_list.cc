@@ -0,0 +1,86 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/task/sequence_manager/atomic_task_list.h"
+
+#include <memory>
+#include <utility>
+
+#include "base/logging.h"
+
+namespace base {
+namespace sequence_manager {
+namespace internal {
+
+AtomicTaskList::Node::Node(Task task, EnqueueOrder enqueue_order)
+    : task(std::move(task)), enqueue_order(enqueue_order) {}
+
+AtomicTaskList::AtomicTaskList() : head_(&stub_), tail_(&stub_) {}
+
+AtomicTaskList::~AtomicTaskList() {
+  while (Node* node = PopNode())
+    delete node;
+  DCHECK_EQ(size(), 0u);
+}
+
+void AtomicTaskList::Push(Task task, EnqueueOrder enqueue_order) {
+  Node* node = new Node(std::move(task), enqueue_order);
+  size_.fetch_add(1, std::memory_order_relaxed);
+  PushNode(node);
+}
+
+Optional<Task> AtomicTaskList::Pop(EnqueueOrder* enqueue_order) {
+  std::unique_ptr<Node> node(PopNode());
+  if (!node)
+    return nullopt;
+  *enqueue_order = node->enqueue_order;
+  return std::move(node->task);
+}
+
+void AtomicTaskList::PushNode(NodeBase* node) {
+  node->next.store(nullptr, std::memory_order_relaxed);
+  // Publishing |node| as the new head serializes producers. The previous head
+  // is only linked to |node| afterwards, so the consumer can't reach |node|
+  // (nor any node pushed after it) until the store below.
+  NodeBase* previous = head_.exchange(node, std::memory_order_acq_rel);
+  previous->next.store(node, std::memory_order_release);
+}
+
+AtomicTaskList::Node* AtomicTaskList::PopNode() {
+  NodeBase* tail = tail_;
+  NodeBase* next = tail->next.load(std::memory_order_acquire);
+  if (tail == &stub_) {
+    if (!next)
+      return nullptr;
+    tail_ = next;
+    tail = next;
+    next = next->next.load(std::memory_order_acquire);
+  }
+
+  if (next) {
+    tail_ = next;
+    size_.fetch_sub(1, std::memory_order_release);
+    return static_cast<Node*>(tail);
+  }
+
+  // |tail| is the last linked node. If it isn't also the head, a producer is
+  // between its exchange and its link in PushNode().
+  if (tail != head_.load(std::memory_order_acquire))
+    return nullptr;
+
+  // Re-insert |stub_| behind |tail| so that |tail| can be handed out without
+  // leaving the list without a node.
+  PushNode(&stub_);
+  next = tail->next.load(std::memory_order_acquire);
+  if (next) {
+    tail_ = next;
+    size_.fetch_sub(1, std::memory_order_release);
+    return static_cast<Node*>(tail);
+  }
+  return nullptr;
+}
+
+}  // namespace internal
+}  // namespace sequence_manager
+}  // namespace base
@@ -0,0 +1,96 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef BASE_TASK_SEQUENCE_MANAGER_ATOMIC_TASK_LIST_H_
+#define BASE_TASK_SEQUENCE_MANAGER_ATOMIC_TASK_LIST_H_
+
+#include <stddef.h>
+
+#include <atomic>
+
+#include "base/base_export.h"
+#include "base/macros.h"
+#include "base/optional.h"
+#include "base/task/sequence_manager/enqueue_order.h"
+#include "base/task/sequence_manager/tasks.h"
+
+namespace base {
+namespace sequence_manager {
+namespace internal {
+
+// A lock-free multi-producer single-consumer FIFO of Tasks. Push() can be
+// called concurrently from any thread and never blocks: it costs one
+// allocation and one atomic exchange. Pop() and empty() must only be called
+// from a single consumer thread (or with external synchronization).
+//
+// Tasks pushed by a given thread are popped in the order they were pushed.
+// While a producer is in the middle of a Push(), Pop() may not return tasks
+// that were pushed after it by other threads until that Push() completes.
+//
+// This is an intrusive variant of Dmitry Vyukov's MPSC queue, see
+// http://www.1024cores.net/home/lock-free-algorithms/queues/intrusive-mpsc-node-based-queue
+class BASE_EXPORT AtomicTaskList {
+ public:
+  AtomicTaskList();
+
+  // Deletes all the remaining tasks. Push() must not be called concurrently.
+  ~AtomicTaskList();
+
+  // Can be called on any thread. Appends |task|, which was assigned
+  // |enqueue_order| when posted, to the list.
+  void Push(Task task, EnqueueOrder enqueue_order);
+
+  // Must be called on the consumer thread. Removes and returns the oldest task,
+  // and stores the EnqueueOrder it was pushed with in |enqueue_order|. Returns
+  // nullopt if no task is available.
+  Optional<Task> Pop(EnqueueOrder* enqueue_order);
+
+  // Must be called on the consumer thread. Returns true if there are no tasks
+  // in the list. May return false while the only pending Push() hasn't
+  // completed yet.
+  bool empty() const { return size() == 0; }
+
+  // Can be called on any thread. Returns the number of tasks in the list. The
+  // value may be stale by the time it is used.
+  size_t size() const { return size_.load(std::memory_order_acquire); }
+
+ private:
+  struct NodeBase {
+    std::atomic<NodeBase*> next{nullptr};
+  };
+
+  struct Node : public NodeBase {
+    Node(Task task, EnqueueOrder enqueue_order);
+
+    Task task;
+    const EnqueueOrder enqueue_order;
+  };
+
+  void PushNode(NodeBase* node);
+
+  // Returns the oldest node, or nullptr if none is available.
+  Node* PopNode();
+
+  // Most recently pushed node. Written by producers.
+  std::atomic<NodeBase*> head_;
+
+  // Number of Nodes which were pushed but not popped yet. Incremented before
+  // the Node is linked, so it never underflows.
+  std::atomic<size_t> size_{0};
+
+  // Oldest node. Only accessed by the consumer.
+  NodeBase* tail_;
+
+  // Placeholder node which allows the list to never be truly empty, which
+  // keeps producers from having to touch |tail_|.
+  NodeBase stub_;
+
+  DISALLOW_COPY_AND_ASSIGN(AtomicTaskList);
+};
+
+}  // namespace internal
+}  // namespace sequence_manager
+}  // namespace base
+
+#endif  // BASE_TASK_SEQUENCE_MANAGER_ATOMIC_TASK_LIST_H_
@@ -0,0 +1,123 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "base/task/sequence_manager/atomic_task_list.h"
+
+#include <memory>
+#include <vector>
+
+#include "base/bind_helpers.h"
+#include "base/threading/simple_thread.h"
+#include "testing/gmock/include/gmock/gmock.h"
+
+using testing::ElementsAre;
+
+namespace base {
+namespace sequence_manager {
+namespace internal {
+
+namespace {
+
+Task CreateTask(int id) {
+  PostedTask posted_task(DoNothing(), FROM_HERE);
+  return Task(std::move(posted_task), TimeTicks(),
+              EnqueueOrder::FromIntForTesting(id));
+}
+
+class PushingThread : public SimpleThread {
+ public:
+  PushingThread(AtomicTaskList* list, int first_id, int num_tasks)
+      : SimpleThread("PushingThread"),
+        list_(list),
+        first_id_(first_id),
+        num_tasks_(num_tasks) {}
+
+  void Run() override {
+    for (int id = first_id_; id < first_id_ + num_tasks_; ++id)
+      list_->Push(CreateTask(id), EnqueueOrder::FromIntForTesting(id));
+  }
+
+ private:
+  AtomicTaskList* const list_;
+  const int first_id_;
+  const int num_tasks_;
+
+  DISALLOW_COPY_AND_ASSIGN(PushingThread);
+};
+
+}  // namespace
+
+TEST(AtomicTaskListTest, PopEmpty) {
+  AtomicTaskList list;
+  EnqueueOrder enqueue_order;
+  EXPECT_TRUE(list.empty());
+  EXPECT_FALSE(list.Pop(&enqueue_order));
+}
+
+TEST(AtomicTaskListTest, PushPop) {
+  AtomicTaskList list;
+  list.Push(CreateTask(1), EnqueueOrder::FromIntForTesting(1));
+  list.Push(CreateTask(2), EnqueueOrder::FromIntForTesting(2));
+  EXPECT_EQ(2u, list.size());
+
+  std::vector<int> popped;
+  EnqueueOrder enqueue_order;
+  while (Optional<Task> task = list.Pop(&enqueue_order)) {
+    EXPECT_EQ(static_cast<int>(enqueue_order), task->sequence_num);
+    popped.push_back(task->sequence_num);
+  }
+  EXPECT_THAT(popped, ElementsAre(1, 2));
+  EXPECT_TRUE(list.empty());
+
+  // The list remains usable after being emptied.
+  list.Push(CreateTask(3), EnqueueOrder::FromIntForTesting(3));
+  Optional<Task> task = list.Pop(&enqueue_order);
+  ASSERT_TRUE(task);
+  EXPECT_EQ(3, task->sequence_num);
+  EXPECT_TRUE(list.empty());
+}
+
+TEST(AtomicTaskListTest, DeleteWithPendingTasks) {
+  AtomicTaskList list;
+  list.Push(CreateTask(1), EnqueueOrder::FromIntForTesting(1));
+  list.Push(CreateTask(2), EnqueueOrder::FromIntForTesting(2));
+  // Shouldn't leak.
+}
+
+// Verifies that tasks pushed concurrently are all popped exactly once, and that
+// the tasks pushed by each thread are popped in order.
+TEST(AtomicTaskListTest, ConcurrentPush) {
+  constexpr int kNumThreads = 4;
+  constexpr int kNumTasksPerThread = 10000;
+
+  AtomicTaskList list;
+  std::vector<std::unique_ptr<PushingThread>> threads;
+  for (int i = 0; i < kNumThreads; ++i) {
+    threads.push_back(std::make_unique<PushingThread>(
+        &list, i * kNumTasksPerThread + 1, kNumTasksPerThread));
+    threads.back()->Start();
+  }
+
+  std::vector<int> last_id_per_thread(kNumThreads, 0);
+  int num_popped = 0;
+  while (num_popped < kNumThreads * kNumTasksPerThread) {
+    EnqueueOrder enqueue_order;
+    Optional<Task> task = list.Pop(&enqueue_order);
+    if (!task)
+      continue;
+    const int id = task->sequence_num;
+    const int thread_index = (id - 1) / kNumTasksPerThread;
+    EXPECT_LT(last_id_per_thread[thread_index], id);
+    last_id_per_thread[thread_index] = id;
+    ++num_popped;
+  }
+
+  for (auto& thread : threads)
+    thread->Join();
+  EXPECT_TRUE(list.empty());
+}
+
+}  // namespace internal
+}  // namespace sequence_manager
+}  // namespace base
@@ -69,6 +69,11 @@ class SequenceManager {
     bool randomised_sampling_enabled = false;
     const TickClock* clock = DefaultTickClock::GetInstance();
 
+    // If non-zero, the real time domain keeps delayed wake-ups in a timing
+    // wheel with this granularity rather than in a heap. See
+    // TimeDomain::UseTimingWheel().
+    TimeDelta timing_wheel_granularity;
+
 #if DCHECK_IS_ON()
     // TODO(alexclarke): Consider adding command line flags to control these.
     enum class TaskLogging {
@@ -212,6 +212,8 @@ SequenceManagerImpl::MainThreadOnly::MainThreadOnly(
     const SequenceManager::Settings& settings)
     : selector(associated_thread, settings),
       real_time_domain(new internal::RealTimeDomain()) {
+  if (!settings.timing_wheel_granularity.is_zero())
+    real_time_domain->UseTimingWheel(settings.timing_wheel_granularity);
   if (settings.randomised_sampling_enabled) {
     random_generator = std::mt19937_64(RandUint64());
     uniform_distribution = std::uniform_real_distribution<double>(0.0, 1.0);
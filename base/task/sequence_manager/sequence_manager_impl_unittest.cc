@@ -597,6 +597,35 @@ TEST_P(SequenceManagerTest, SingleQueuePosting) {
   EXPECT_THAT(run_order, ElementsAre(1u, 2u, 3u));
 }
 
+TEST_P(SequenceManagerTest, SingleQueueBatchPosting) {
+  auto queue = CreateTaskQueue();
+
+  std::vector<EnqueueOrder> run_order;
+  queue->task_runner()->PostTask(FROM_HERE, BindOnce(&TestTask, 1, &run_order));
+  std::vector<OnceClosure> tasks;
+  tasks.push_back(BindOnce(&TestTask, 2, &run_order));
+  tasks.push_back(BindOnce(&TestTask, 3, &run_order));
+  tasks.push_back(BindOnce(&TestTask, 4, &run_order));
+  EXPECT_TRUE(queue->PostTasks(FROM_HERE, std::move(tasks)));
+  queue->task_runner()->PostTask(FROM_HERE, BindOnce(&TestTask, 5, &run_order));
+
+  RunLoop().RunUntilIdle();
+  EXPECT_THAT(run_order, ElementsAre(1u, 2u, 3u, 4u, 5u));
+}
+
+TEST_P(SequenceManagerTest, BatchPostingAfterShutdownTaskQueue) {
+  auto queue = CreateTaskQueue();
+  queue->ShutdownTaskQueue();
+
+  std::vector<EnqueueOrder> run_order;
+  std::vector<OnceClosure> tasks;
+  tasks.push_back(BindOnce(&TestTask, 1, &run_order));
+  EXPECT_FALSE(queue->PostTasks(FROM_HERE, std::move(tasks)));
+
+  RunLoop().RunUntilIdle();
+  EXPECT_TRUE(run_order.empty());
+}
+
 TEST_P(SequenceManagerTest, MultiQueuePosting) {
   auto queues = CreateTaskQueues(3u);
 
@@ -863,6 +892,32 @@ TEST_P(SequenceManagerTest, DelayedTaskPosting_MultipleTasks_AscendingOrder) {
   EXPECT_THAT(run_order, ElementsAre(1u, 2u, 3u));
 }
 
+TEST_P(SequenceManagerTest, DelayedTaskPosting_TimingWheel) {
+  constexpr TimeDelta kGranularity = TimeDelta::FromMilliseconds(10);
+  sequence_manager()->GetRealTimeDomain()->UseTimingWheel(kGranularity);
+  auto queue = CreateTaskQueue();
+
+  // Both tasks are due before the same multiple of |kGranularity|, and share a
+  // wake-up at that time.
+  TimeTicks now = mock_tick_clock()->NowTicks();
+  TimeTicks wake_up =
+      TimeTicks() + kGranularity * ((now - TimeTicks()) / kGranularity + 2);
+  std::vector<EnqueueOrder> run_order;
+  queue->task_runner()->PostDelayedTask(
+      FROM_HERE, BindOnce(&TestTask, 1, &run_order),
+      wake_up - now - TimeDelta::FromMilliseconds(7));
+  queue->task_runner()->PostDelayedTask(
+      FROM_HERE, BindOnce(&TestTask, 2, &run_order),
+      wake_up - now - TimeDelta::FromMilliseconds(1));
+  EXPECT_EQ(wake_up - now, NextPendingTaskDelay());
+
+  FastForwardBy(wake_up - now - TimeDelta::FromMilliseconds(1));
+  EXPECT_TRUE(run_order.empty());
+
+  FastForwardBy(TimeDelta::FromMilliseconds(1));
+  EXPECT_THAT(run_order, ElementsAre(1u, 2u));
+}
+
 TEST(SequenceManagerTestWithMockTaskRunner,
      PostDelayedTask_SharesUnderlyingDelayedTasks) {
   FixtureWithMockTaskRunner fixture;
@@ -1461,6 +1516,68 @@ TEST_P(SequenceManagerTest, PostFromThread) {
   EXPECT_THAT(run_order, ElementsAre(1u));
 }
 
+TEST_P(SequenceManagerTest, PostFromThreadLockFree) {
+  auto queue = CreateTaskQueue(
+      TaskQueue::Spec("test").SetLockFreeCrossThreadPosting(true));
+
+  std::vector<EnqueueOrder> run_order;
+  queue->task_runner()->PostTask(FROM_HERE, BindOnce(&TestTask, 1, &run_order));
+  Thread thread("TestThread");
+  thread.Start();
+  thread.task_runner()->PostTask(FROM_HERE, BindLambdaForTesting([&]() {
+                                   queue->task_runner()->PostTask(
+                                       FROM_HERE,
+                                       BindOnce(&TestTask, 2, &run_order));
+                                   queue->task_runner()->PostTask(
+                                       FROM_HERE,
+                                       BindOnce(&TestTask, 3, &run_order));
+                                 }));
+  thread.Stop();
+  // Tasks posted from the main thread are ordered after cross-thread tasks
+  // which were posted before them.
+  queue->task_runner()->PostTask(FROM_HERE, BindOnce(&TestTask, 4, &run_order));
+  EXPECT_EQ(4u, queue->GetNumberOfPendingTasks());
+  EXPECT_TRUE(queue->HasTaskToRunImmediately());
+
+  RunLoop().RunUntilIdle();
+  EXPECT_THAT(run_order, ElementsAre(1u, 2u, 3u, 4u));
+  EXPECT_TRUE(queue->IsEmpty());
+}
+
+TEST_P(SequenceManagerTest, PostFromManyThreadsLockFree) {
+  constexpr int kNumThreads = 4;
+  constexpr int kNumTasksPerThread = 100;
+  auto queue = CreateTaskQueue(
+      TaskQueue::Spec("test").SetLockFreeCrossThreadPosting(true));
+
+  std::vector<std::vector<int>> run_order(kNumThreads);
+  std::vector<std::unique_ptr<Thread>> threads;
+  for (int i = 0; i < kNumThreads; ++i) {
+    threads.push_back(std::make_unique<Thread>("TestThread"));
+    threads.back()->Start();
+    threads.back()->task_runner()->PostTask(
+        FROM_HERE, BindLambdaForTesting([&, i]() {
+          for (int j = 0; j < kNumTasksPerThread; ++j) {
+            queue->task_runner()->PostTask(
+                FROM_HERE, BindOnce(
+                               [](std::vector<int>* run_order, int j) {
+                                 run_order->push_back(j);
+                               },
+                               &run_order[i], j));
+          }
+        }));
+  }
+  for (auto& thread : threads)
+    thread->Stop();
+
+  RunLoop().RunUntilIdle();
+  std::vector<int> expected_run_order(kNumTasksPerThread);
+  for (int j = 0; j < kNumTasksPerThread; ++j)
+    expected_run_order[j] = j;
+  for (int i = 0; i < kNumThreads; ++i)
+    EXPECT_EQ(expected_run_order, run_order[i]);
+}
+
 void RePostingTestTask(scoped_refptr<TestTaskQueue> runner, int* run_count) {
   (*run_count)++;
   runner->task_runner()->PostTask(
@@ -5,6 +5,7 @@
 #include "base/task/sequence_manager/sequence_manager.h"
 
 #include <stddef.h>
+#include <algorithm>
 #include <memory>
 
 #include "base/bind.h"
@@ -104,6 +105,30 @@ class PerfTestDelegate {
 
   virtual scoped_refptr<TaskRunner> CreateTaskRunner() = 0;
 
+  // Makes the time domain used by task runners keep wake-ups in a timing
+  // wheel. Must only be called if VirtualTimeIsSupported(), before any task
+  // runner is created.
+  virtual void UseTimingWheel(TimeDelta granularity) { NOTREACHED(); }
+
+  virtual bool LockFreeCrossThreadPostingSupported() const { return false; }
+
+  // Returns a TaskRunner for a queue created with
+  // TaskQueue::Spec::SetLockFreeCrossThreadPosting(). Must only be called if
+  // LockFreeCrossThreadPostingSupported().
+  virtual scoped_refptr<TaskRunner> CreateLockFreeCrossThreadTaskRunner() {
+    NOTREACHED();
+    return nullptr;
+  }
+
+  virtual bool BatchPostingSupported() const { return false; }
+
+  // Returns a TaskQueue, for TaskQueue::PostTasks(). Must only be called if
+  // BatchPostingSupported().
+  virtual scoped_refptr<TaskQueue> CreateTaskQueue() {
+    NOTREACHED();
+    return nullptr;
+  }
+
   virtual void WaitUntilDone() = 0;
 
   virtual void SignalDone() = 0;
@@ -127,6 +152,32 @@ class BaseSequenceManagerPerfTestDelegate : public PerfTestDelegate {
     return task_queue->task_runner();
   }
 
+  void UseTimingWheel(TimeDelta granularity) override {
+    time_domain_->UseTimingWheel(granularity);
+  }
+
+  bool LockFreeCrossThreadPostingSupported() const override { return true; }
+
+  scoped_refptr<TaskRunner> CreateLockFreeCrossThreadTaskRunner() override {
+    scoped_refptr<TestTaskQueue> task_queue =
+        manager_->CreateTaskQueueWithType<TestTaskQueue>(
+            TaskQueue::Spec("test")
+                .SetTimeDomain(time_domain_.get())
+                .SetLockFreeCrossThreadPosting(true));
+    owned_task_queues_.push_back(task_queue);
+    return task_queue->task_runner();
+  }
+
+  bool BatchPostingSupported() const override { return true; }
+
+  scoped_refptr<TaskQueue> CreateTaskQueue() override {
+    scoped_refptr<TestTaskQueue> task_queue =
+        manager_->CreateTaskQueueWithType<TestTaskQueue>(
+            TaskQueue::Spec("test").SetTimeDomain(time_domain_.get()));
+    owned_task_queues_.push_back(task_queue);
+    return task_queue;
+  }
+
   void WaitUntilDone() override {
     run_loop_.reset(new RunLoop());
     run_loop_->Run();
@@ -580,6 +631,167 @@ class TwoThreadTestCase : public TestCase {
   int done_count_ = 0;
 };
 
+// Posts tasks from |num_threads| auxiliary threads concurrently.
+class MultiThreadTestCase : public TestCase {
+ public:
+  MultiThreadTestCase(PerfTestDelegate* delegate,
+                      std::vector<scoped_refptr<TaskRunner>> task_runners,
+                      size_t num_threads)
+      : TestCase(delegate), task_runners_(std::move(task_runners)) {
+    for (size_t i = 0; i < num_threads; i++) {
+      auxiliary_threads_.push_back(
+          std::make_unique<Thread>("auxiliary thread"));
+      auxiliary_threads_.back()->Start();
+    }
+  }
+
+  ~MultiThreadTestCase() override {
+    for (auto& thread : auxiliary_threads_)
+      thread->Stop();
+  }
+
+ protected:
+  void Start() override {
+    done_count_ = 0;
+    task_sources_.clear();
+    const size_t num_tasks_per_thread = kNumTasks / auxiliary_threads_.size();
+    for (auto& thread : auxiliary_threads_) {
+      task_sources_.push_back(std::make_unique<CrossThreadImmediateTaskSource>(
+          this, task_runners_, num_tasks_per_thread));
+      thread->task_runner()->PostTask(
+          FROM_HERE,
+          base::BindOnce(&CrossThreadImmediateTaskSource::Start,
+                         Unretained(task_sources_.back().get())));
+    }
+  }
+
+  class CrossThreadImmediateTaskSource : public CrossThreadTaskSource {
+   public:
+    CrossThreadImmediateTaskSource(
+        MultiThreadTestCase* multi_thread_test_case,
+        std::vector<scoped_refptr<TaskRunner>> task_runners,
+        size_t num_tasks)
+        : CrossThreadTaskSource(std::move(task_runners), num_tasks),
+          multi_thread_test_case_(multi_thread_test_case) {}
+
+    ~CrossThreadImmediateTaskSource() override = default;
+
+    void PostTask(unsigned int queue) override {
+      task_runners_[queue]->PostTask(FROM_HERE, task_closure_);
+    }
+
+    // Will be called on the main thread.
+    void SignalDone() override { multi_thread_test_case_->SignalDone(); }
+
+    MultiThreadTestCase* multi_thread_test_case_;  // NOT OWNED.
+  };
+
+  void SignalDone() {
+    if (++done_count_ == task_sources_.size())
+      delegate_->SignalDone();
+  }
+
+ private:
+  const std::vector<scoped_refptr<TaskRunner>> task_runners_;
+  std::vector<std::unique_ptr<Thread>> auxiliary_threads_;
+  std::vector<std::unique_ptr<CrossThreadImmediateTaskSource>> task_sources_;
+  size_t done_count_ = 0;
+};
+
+// Like MultiThreadTestCase, but each auxiliary thread posts its tasks in
+// batches of |batch_size| with TaskQueue::PostTasks().
+class MultiThreadBatchTestCase : public TestCase {
+ public:
+  MultiThreadBatchTestCase(PerfTestDelegate* delegate,
+                           scoped_refptr<TaskQueue> task_queue,
+                           size_t num_threads,
+                           size_t batch_size)
+      : TestCase(delegate),
+        task_queue_(std::move(task_queue)),
+        batch_size_(batch_size) {
+    for (size_t i = 0; i < num_threads; i++) {
+      auxiliary_threads_.push_back(
+          std::make_unique<Thread>("auxiliary thread"));
+      auxiliary_threads_.back()->Start();
+    }
+  }
+
+  ~MultiThreadBatchTestCase() override {
+    for (auto& thread : auxiliary_threads_)
+      thread->Stop();
+  }
+
+ protected:
+  void Start() override {
+    done_count_ = 0;
+    task_sources_.clear();
+    const size_t num_tasks_per_thread = kNumTasks / auxiliary_threads_.size();
+    for (auto& thread : auxiliary_threads_) {
+      task_sources_.push_back(std::make_unique<CrossThreadBatchTaskSource>(
+          this, task_queue_, num_tasks_per_thread, batch_size_));
+      thread->task_runner()->PostTask(
+          FROM_HERE,
+          base::BindOnce(&CrossThreadBatchTaskSource::Start,
+                         Unretained(task_sources_.back().get())));
+    }
+  }
+
+  class CrossThreadBatchTaskSource : public CrossThreadTaskSource {
+   public:
+    CrossThreadBatchTaskSource(
+        MultiThreadBatchTestCase* multi_thread_batch_test_case,
+        scoped_refptr<TaskQueue> task_queue,
+        size_t num_tasks,
+        size_t batch_size)
+        : CrossThreadTaskSource({task_queue->task_runner()}, num_tasks),
+          multi_thread_batch_test_case_(multi_thread_batch_test_case),
+          task_queue_(std::move(task_queue)),
+          batch_size_(batch_size) {}
+
+    ~CrossThreadBatchTaskSource() override = default;
+
+    void Start() override {
+      num_tasks_in_flight_ = 0;
+      num_tasks_to_run_ = num_tasks_;
+
+      for (size_t i = 0; i < num_tasks_; i += batch_size_) {
+        while (num_tasks_in_flight_.load(std::memory_order_acquire) >
+               max_tasks_in_flight_) {
+          PlatformThread::YieldCurrentThread();
+        }
+        const size_t num_tasks_in_batch = std::min(batch_size_, num_tasks_ - i);
+        std::vector<OnceClosure> tasks;
+        tasks.reserve(num_tasks_in_batch);
+        for (size_t j = 0; j < num_tasks_in_batch; j++)
+          tasks.push_back(task_closure_);
+        num_tasks_in_flight_ += num_tasks_in_batch;
+        task_queue_->PostTasks(FROM_HERE, std::move(tasks));
+      }
+    }
+
+    void PostTask(unsigned int queue) override { NOTREACHED(); }
+
+    // Will be called on the main thread.
+    void SignalDone() override { multi_thread_batch_test_case_->SignalDone(); }
+
+    MultiThreadBatchTestCase* multi_thread_batch_test_case_;  // NOT OWNED.
+    const scoped_refptr<TaskQueue> task_queue_;
+    const size_t batch_size_;
+  };
+
+  void SignalDone() {
+    if (++done_count_ == task_sources_.size())
+      delegate_->SignalDone();
+  }
+
+ private:
+  const scoped_refptr<TaskQueue> task_queue_;
+  const size_t batch_size_;
+  std::vector<std::unique_ptr<Thread>> auxiliary_threads_;
+  std::vector<std::unique_ptr<CrossThreadBatchTaskSource>> task_sources_;
+  size_t done_count_ = 0;
+};
+
 class SequenceManagerPerfTest : public testing::TestWithParam<PerfTestType> {
  public:
   SequenceManagerPerfTest() = default;
@@ -659,6 +871,15 @@ class SequenceManagerPerfTest : public testing::TestWithParam<PerfTestType> {
     return task_runners;
   }
 
+  std::vector<scoped_refptr<TaskRunner>> CreateLockFreeCrossThreadTaskRunners(
+      int num) {
+    std::vector<scoped_refptr<TaskRunner>> task_runners;
+    for (int i = 0; i < num; i++) {
+      task_runners.push_back(delegate_->CreateLockFreeCrossThreadTaskRunner());
+    }
+    return task_runners;
+  }
+
   void Benchmark(const std::string& trace, TestCase* TestCase) {
     TimeTicks start = TimeTicks::Now();
     TimeTicks now;
@@ -738,6 +959,19 @@ TEST_P(SequenceManagerPerfTest, PostDelayedTasks_ThirtyTwoQueues) {
   Benchmark("post delayed tasks with thirty two queues", &task_source);
 }
 
+TEST_P(SequenceManagerPerfTest, PostDelayedTasks_ThirtyTwoQueuesTimingWheel) {
+  if (!delegate_->VirtualTimeIsSupported() || !ShouldMeasureQueueScaling()) {
+    LOG(INFO) << "Unsupported";
+    return;
+  }
+
+  delegate_->UseTimingWheel(TimeDelta::FromMilliseconds(1));
+  SingleThreadDelayedTestCase task_source(delegate_.get(),
+                                          CreateTaskRunners(32));
+  Benchmark("post delayed tasks with thirty two queues and a timing wheel",
+            &task_source);
+}
+
 TEST_P(SequenceManagerPerfTest, PostImmediateTasks_OneQueue) {
   SingleThreadImmediateTestCase task_source(delegate_.get(),
                                             CreateTaskRunners(1));
@@ -817,6 +1051,39 @@ TEST_P(SequenceManagerPerfTest,
             &task_source);
 }
 
+TEST_P(SequenceManagerPerfTest, PostImmediateTasksFromFourThreads_OneQueue) {
+  MultiThreadTestCase task_source(delegate_.get(), CreateTaskRunners(1), 4);
+  Benchmark("post immediate tasks with one queue from four threads",
+            &task_source);
+}
+
+TEST_P(SequenceManagerPerfTest,
+       PostImmediateTasksFromFourThreads_OneLockFreeQueue) {
+  if (!delegate_->LockFreeCrossThreadPostingSupported()) {
+    LOG(INFO) << "Unsupported";
+    return;
+  }
+
+  MultiThreadTestCase task_source(delegate_.get(),
+                                  CreateLockFreeCrossThreadTaskRunners(1), 4);
+  Benchmark("post immediate tasks with one lock-free queue from four threads",
+            &task_source);
+}
+
+TEST_P(SequenceManagerPerfTest,
+       PostImmediateTaskBatchesFromFourThreads_OneQueue) {
+  if (!delegate_->BatchPostingSupported()) {
+    LOG(INFO) << "Unsupported";
+    return;
+  }
+
+  MultiThreadBatchTestCase task_source(delegate_.get(),
+                                       delegate_->CreateTaskQueue(), 4, 16);
+  Benchmark(
+      "post immediate tasks in batches of 16 with one queue from four threads",
+      &task_source);
+}
+
 // TODO(alexclarke): Add additional tests with different mixes of non-delayed vs
 // delayed tasks.
 
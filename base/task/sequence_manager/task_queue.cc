@@ -183,6 +183,16 @@ scoped_refptr<SingleThreadTaskRunner> TaskQueue::CreateTaskRunner(
   return impl_->CreateTaskRunner(task_type);
 }
 
+bool TaskQueue::PostTasks(const Location& from_here,
+                          std::vector<OnceClosure> tasks) {
+  // Reading |impl_| from a thread other than the main thread requires a lock.
+  base::internal::AutoSchedulerLockMaybe lock(IsOnMainThread() ? nullptr
+                                                               : &impl_lock_);
+  if (!impl_)
+    return false;
+  return impl_->PostTasks(from_here, std::move(tasks));
+}
+
 std::unique_ptr<TaskQueue::QueueEnabledVoter>
 TaskQueue::CreateQueueEnabledVoter() {
   DCHECK_CALLED_ON_VALID_THREAD(associated_thread_->thread_checker);
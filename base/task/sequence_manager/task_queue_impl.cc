@@ -57,6 +57,16 @@ bool TaskQueueImpl::GuardedTaskPoster::PostTask(PostedTask task) {
   return true;
 }
 
+bool TaskQueueImpl::GuardedTaskPoster::PostTasks(
+    std::vector<PostedTask> tasks) {
+  auto token = operations_controller_.TryBeginOperation();
+  if (!token)
+    return false;
+
+  outer_->PostTasksImpl(std::move(tasks));
+  return true;
+}
+
 TaskQueueImpl::TaskRunner::TaskRunner(
     scoped_refptr<GuardedTaskPoster> task_poster,
     scoped_refptr<AssociatedThreadId> associated_thread,
@@ -103,7 +113,8 @@ TaskQueueImpl::TaskQueueImpl(SequenceManagerImpl* sequence_manager,
               : AtomicFlagSet::AtomicFlag()),
       should_monitor_quiescence_(spec.should_monitor_quiescence),
       should_notify_observers_(spec.should_notify_observers),
-      delayed_fence_allowed_(spec.delayed_fence_allowed) {
+      delayed_fence_allowed_(spec.delayed_fence_allowed),
+      lock_free_cross_thread_posting_(spec.lock_free_cross_thread_posting) {
   DCHECK(time_domain);
   UpdateCrossThreadQueueStateLocked();
   // SequenceManager can't be set later, so we need to prevent task runners
@@ -163,6 +174,7 @@ void TaskQueueImpl::UnregisterTaskQueue() {
     base::internal::AutoSchedulerLock lock(any_thread_lock_);
     any_thread_.unregistered = true;
     any_thread_.time_domain = nullptr;
+    MoveImmediateIncomingListToQueueLocked();
     immediate_incoming_queue.swap(any_thread_.immediate_incoming_queue);
   }
 
@@ -217,6 +229,46 @@ void TaskQueueImpl::PostTask(PostedTask task) {
   }
 }
 
+bool TaskQueueImpl::PostTasks(const Location& from_here,
+                              std::vector<OnceClosure> tasks) {
+  std::vector<PostedTask> posted_tasks;
+  posted_tasks.reserve(tasks.size());
+  for (OnceClosure& task : tasks) {
+    posted_tasks.emplace_back(std::move(task), from_here, TimeDelta(),
+                              Nestable::kNestable);
+  }
+  return task_poster_->PostTasks(std::move(posted_tasks));
+}
+
+void TaskQueueImpl::PostTasksImpl(std::vector<PostedTask> tasks) {
+  CurrentThread current_thread =
+      associated_thread_->IsBoundToCurrentThread()
+          ? TaskQueueImpl::CurrentThread::kMainThread
+          : TaskQueueImpl::CurrentThread::kNotMainThread;
+
+#if DCHECK_IS_ON()
+  // Delays injected to diagnose flakiness apply to each task individually, in
+  // which case the tasks can't be posted as a batch.
+  bool has_adjusted_delay = false;
+  for (PostedTask& task : tasks) {
+    MaybeLogPostTask(&task);
+    MaybeAdjustTaskDelay(&task, current_thread);
+    has_adjusted_delay |= !task.delay.is_zero();
+  }
+  if (has_adjusted_delay) {
+    for (PostedTask& task : tasks) {
+      if (task.delay.is_zero())
+        PostImmediateTaskImpl(std::move(task), current_thread);
+      else
+        PostDelayedTaskImpl(std::move(task), current_thread);
+    }
+    return;
+  }
+#endif  // DCHECK_IS_ON()
+
+  PostImmediateTasksImpl(std::move(tasks), current_thread);
+}
+
 void TaskQueueImpl::MaybeLogPostTask(PostedTask* task) {
 #if DCHECK_IS_ON()
   if (!sequence_manager_->settings().log_post_task)
@@ -251,11 +303,19 @@ void TaskQueueImpl::PostImmediateTaskImpl(PostedTask task,
   // for details.
   CHECK(task.callback);
 
+  if (current_thread == CurrentThread::kNotMainThread &&
+      lock_free_cross_thread_posting_) {
+    PushOntoImmediateIncomingList(std::move(task));
+    return;
+  }
+
   bool should_schedule_work = false;
   {
     // TODO(alexclarke): Maybe add a main thread only immediate_incoming_queue
     // See https://crbug.com/901800
     base::internal::AutoSchedulerLock lock(any_thread_lock_);
+    if (current_thread == CurrentThread::kMainThread)
+      MoveImmediateIncomingListToQueueLocked();
     TimeTicks now;
     bool add_queue_time_to_tasks = sequence_manager_->GetAddQueueTimeToTasks();
     if (delayed_fence_allowed_ || add_queue_time_to_tasks) {
@@ -263,35 +323,8 @@ void TaskQueueImpl::PostImmediateTaskImpl(PostedTask task,
       if (add_queue_time_to_tasks)
         task.queue_time = now;
     }
-
-    // The sequence number must be incremented atomically with pushing onto the
-    // incoming queue. Otherwise if there are several threads posting task we
-    // risk breaking the assumption that sequence numbers increase monotonically
-    // within a queue.
-    EnqueueOrder sequence_number = sequence_manager_->GetNextSequenceNumber();
-    bool was_immediate_incoming_queue_empty =
-        any_thread_.immediate_incoming_queue.empty();
-    any_thread_.immediate_incoming_queue.push_back(
-        Task(std::move(task), now, sequence_number, sequence_number));
-
-#if DCHECK_IS_ON()
-    any_thread_.immediate_incoming_queue.back().cross_thread_ =
-        (current_thread == TaskQueueImpl::CurrentThread::kNotMainThread);
-#endif
-
-    sequence_manager_->WillQueueTask(
-        &any_thread_.immediate_incoming_queue.back(), name_);
-
-    // If this queue was completely empty, then the SequenceManager needs to be
-    // informed so it can reload the work queue and add us to the
-    // TaskQueueSelector which can only be done from the main thread. In
-    // addition it may need to schedule a DoWork if this queue isn't blocked.
-    if (was_immediate_incoming_queue_empty &&
-        any_thread_.immediate_work_queue_empty) {
-      empty_queues_to_reload_handle_.SetActive(true);
-      should_schedule_work =
-          any_thread_.post_immediate_task_should_schedule_work;
-    }
+    should_schedule_work = PushOntoImmediateIncomingQueueLocked(
+        std::move(task), now, current_thread);
   }
 
   // On windows it's important to call this outside of a lock because calling a
@@ -311,6 +344,156 @@ void TaskQueueImpl::PostImmediateTaskImpl(PostedTask task,
   TraceQueueSize();
 }
 
+void TaskQueueImpl::PostImmediateTasksImpl(std::vector<PostedTask> tasks,
+                                           CurrentThread current_thread) {
+  if (tasks.empty())
+    return;
+
+  if (current_thread == CurrentThread::kNotMainThread &&
+      lock_free_cross_thread_posting_) {
+    for (PostedTask& task : tasks) {
+      // Use CHECK instead of DCHECK to crash earlier. See
+      // http://crbug.com/711167 for details.
+      CHECK(task.callback);
+      PushOntoImmediateIncomingList(std::move(task));
+    }
+    return;
+  }
+
+  bool should_schedule_work = false;
+  {
+    base::internal::AutoSchedulerLock lock(any_thread_lock_);
+    if (current_thread == CurrentThread::kMainThread)
+      MoveImmediateIncomingListToQueueLocked();
+    TimeTicks now;
+    bool add_queue_time_to_tasks = sequence_manager_->GetAddQueueTimeToTasks();
+    if (delayed_fence_allowed_ || add_queue_time_to_tasks)
+      now = any_thread_.time_domain->Now();
+    for (PostedTask& task : tasks) {
+      // Use CHECK instead of DCHECK to crash earlier. See
+      // http://crbug.com/711167 for details.
+      CHECK(task.callback);
+      if (add_queue_time_to_tasks)
+        task.queue_time = now;
+      should_schedule_work |= PushOntoImmediateIncomingQueueLocked(
+          std::move(task), now, current_thread);
+    }
+  }
+
+  // Called outside of the lock, see PostImmediateTaskImpl().
+  if (should_schedule_work)
+    sequence_manager_->ScheduleWork();
+
+  TraceQueueSize();
+}
+
+bool TaskQueueImpl::PushOntoImmediateIncomingQueueLocked(
+    PostedTask task,
+    TimeTicks now,
+    CurrentThread current_thread) {
+  // The sequence number must be incremented atomically with pushing onto the
+  // incoming queue. Otherwise if there are several threads posting task we
+  // risk breaking the assumption that sequence numbers increase monotonically
+  // within a queue.
+  EnqueueOrder sequence_number = sequence_manager_->GetNextSequenceNumber();
+  bool was_immediate_incoming_queue_empty =
+      any_thread_.immediate_incoming_queue.empty();
+  any_thread_.immediate_incoming_queue.push_back(
+      Task(std::move(task), now, sequence_number, sequence_number));
+
+#if DCHECK_IS_ON()
+  any_thread_.immediate_incoming_queue.back().cross_thread_ =
+      (current_thread == TaskQueueImpl::CurrentThread::kNotMainThread);
+#endif
+
+  sequence_manager_->WillQueueTask(
+      &any_thread_.immediate_incoming_queue.back(), name_);
+
+  // If this queue was completely empty, then the SequenceManager needs to be
+  // informed so it can reload the work queue and add us to the
+  // TaskQueueSelector which can only be done from the main thread. In
+  // addition it may need to schedule a DoWork if this queue isn't blocked.
+  if (was_immediate_incoming_queue_empty &&
+      any_thread_.immediate_work_queue_empty) {
+    empty_queues_to_reload_handle_.SetActive(true);
+    return any_thread_.post_immediate_task_should_schedule_work;
+  }
+  return false;
+}
+
+void TaskQueueImpl::PushOntoImmediateIncomingList(PostedTask task) {
+  DCHECK(lock_free_cross_thread_posting_);
+
+  TimeTicks now;
+  bool add_queue_time_to_tasks = sequence_manager_->GetAddQueueTimeToTasks();
+  if (delayed_fence_allowed_ || add_queue_time_to_tasks) {
+    // The time domain can only be read under the lock.
+    base::internal::AutoSchedulerLock lock(any_thread_lock_);
+    now = any_thread_.time_domain->Now();
+  }
+  if (add_queue_time_to_tasks)
+    task.queue_time = now;
+
+  // Unlike in PushOntoImmediateIncomingQueueLocked(), the sequence number isn't
+  // obtained atomically with the push. The enqueue order is only set by
+  // MoveImmediateIncomingListToQueueLocked(), which restores monotonicity.
+  EnqueueOrder sequence_number = sequence_manager_->GetNextSequenceNumber();
+  Task pending_task(std::move(task), now, sequence_number);
+#if DCHECK_IS_ON()
+  pending_task.cross_thread_ = true;
+#endif
+  sequence_manager_->WillQueueTask(&pending_task, name_);
+  immediate_incoming_list_.Push(std::move(pending_task), sequence_number);
+
+  // Only the first task pushed since the list was last drained needs to ask for
+  // a reload. The list is drained by the main thread after resetting the flag,
+  // so tasks pushed by threads which observe the flag as set will be seen.
+  if (immediate_incoming_list_has_pending_reload_.exchange(
+          true, std::memory_order_acq_rel)) {
+    return;
+  }
+
+  bool should_schedule_work = false;
+  {
+    base::internal::AutoSchedulerLock lock(any_thread_lock_);
+    // If |immediate_work_queue| isn't empty, the list will be drained when it
+    // becomes empty (see WorkQueue::TakeTaskFromWorkQueue()).
+    if (any_thread_.immediate_work_queue_empty) {
+      empty_queues_to_reload_handle_.SetActive(true);
+      should_schedule_work =
+          any_thread_.post_immediate_task_should_schedule_work;
+    }
+  }
+
+  // Called outside of the lock, see PostImmediateTaskImpl().
+  if (should_schedule_work)
+    sequence_manager_->ScheduleWork();
+}
+
+void TaskQueueImpl::MoveImmediateIncomingListToQueueLocked() const {
+  if (!lock_free_cross_thread_posting_)
+    return;
+  DCHECK(associated_thread_->IsBoundToCurrentThread() ||
+         !associated_thread_->IsBound());
+
+  immediate_incoming_list_has_pending_reload_.exchange(
+      false, std::memory_order_acq_rel);
+
+  TaskDeque& queue = any_thread_.immediate_incoming_queue;
+  EnqueueOrder enqueue_order;
+  while (Optional<Task> task = immediate_incoming_list_.Pop(&enqueue_order)) {
+    // Threads posting concurrently may push their tasks in a different order
+    // than they obtained sequence numbers, or after the main thread posted a
+    // task with a higher sequence number. Such tasks get a new sequence number
+    // to keep enqueue orders increasing within the queue. This never reorders
+    // the tasks posted by a given thread.
+    if (!queue.empty() && enqueue_order <= queue.back().enqueue_order())
+      enqueue_order = sequence_manager_->GetNextSequenceNumber();
+    task->set_enqueue_order(enqueue_order);
+    queue.push_back(std::move(*task));
+  }
+}
+
 void TaskQueueImpl::PostDelayedTaskImpl(PostedTask task,
                                         CurrentThread current_thread) {
   // Use CHECK instead of DCHECK to crash earlier. See http://crbug.com/711167
@@ -435,6 +618,7 @@ void TaskQueueImpl::ReloadEmptyImmediateWorkQueue() {
 void TaskQueueImpl::TakeImmediateIncomingQueueTasks(TaskDeque* queue) {
   base::internal::AutoSchedulerLock lock(any_thread_lock_);
   DCHECK(queue->empty());
+  MoveImmediateIncomingListToQueueLocked();
   queue->swap(any_thread_.immediate_incoming_queue);
 
   // Since |immediate_incoming_queue| is empty, now is a good time to consider
@@ -474,6 +658,7 @@ bool TaskQueueImpl::IsEmpty() const {
   }
 
   base::internal::AutoSchedulerLock lock(any_thread_lock_);
+  MoveImmediateIncomingListToQueueLocked();
   return any_thread_.immediate_incoming_queue.empty();
 }
 
@@ -484,6 +669,7 @@ size_t TaskQueueImpl::GetNumberOfPendingTasks() const {
   task_count += main_thread_only().immediate_work_queue->Size();
 
   base::internal::AutoSchedulerLock lock(any_thread_lock_);
+  MoveImmediateIncomingListToQueueLocked();
   task_count += any_thread_.immediate_incoming_queue.size();
   return task_count;
 }
@@ -505,6 +691,7 @@ bool TaskQueueImpl::HasTaskToRunImmediately() const {
 
   // Finally tasks on |immediate_incoming_queue| count as immediate work.
   base::internal::AutoSchedulerLock lock(any_thread_lock_);
+  MoveImmediateIncomingListToQueueLocked();
   return !any_thread_.immediate_incoming_queue.empty();
 }
 
@@ -566,6 +753,7 @@ void TaskQueueImpl::TraceQueueSize() const {
     return;
 
   base::internal::AutoSchedulerLock lock(any_thread_lock_);
+  MoveImmediateIncomingListToQueueLocked();
   TRACE_COUNTER1(TRACE_DISABLED_BY_DEFAULT("sequence_manager"), GetName(),
                  any_thread_.immediate_incoming_queue.size() +
                      main_thread_only().immediate_work_queue->Size() +
@@ -606,6 +794,7 @@ void TaskQueueImpl::AsValueInto(TimeTicks now,
       StringPrintf("0x%" PRIx64,
                    static_cast<uint64_t>(reinterpret_cast<uintptr_t>(this))));
   state->SetBoolean("enabled", IsQueueEnabled());
+  MoveImmediateIncomingListToQueueLocked();
   state->SetString("time_domain_name",
                    main_thread_only().time_domain->GetName());
   state->SetInteger("any_thread_.immediate_incoming_queuesize",
@@ -742,6 +931,7 @@ void TaskQueueImpl::InsertFence(TaskQueue::InsertFencePosition position) {
 
   {
     base::internal::AutoSchedulerLock lock(any_thread_lock_);
+    MoveImmediateIncomingListToQueueLocked();
     if (!task_unblocked && previous_fence && previous_fence < current_fence) {
       if (!any_thread_.immediate_incoming_queue.empty() &&
           any_thread_.immediate_incoming_queue.front().enqueue_order() >
@@ -779,6 +969,7 @@ void TaskQueueImpl::RemoveFence() {
 
   {
     base::internal::AutoSchedulerLock lock(any_thread_lock_);
+    MoveImmediateIncomingListToQueueLocked();
     if (!task_unblocked && previous_fence) {
       if (!any_thread_.immediate_incoming_queue.empty() &&
           any_thread_.immediate_incoming_queue.front().enqueue_order() >
@@ -804,6 +995,7 @@ bool TaskQueueImpl::BlockedByFence() const {
   }
 
   base::internal::AutoSchedulerLock lock(any_thread_lock_);
+  MoveImmediateIncomingListToQueueLocked();
   if (any_thread_.immediate_incoming_queue.empty())
     return true;
 
@@ -1028,10 +1220,12 @@ bool TaskQueueImpl::HasPendingImmediateWork() {
 
   // Finally tasks on |immediate_incoming_queue| count as immediate work.
   base::internal::AutoSchedulerLock lock(any_thread_lock_);
+  MoveImmediateIncomingListToQueueLocked();
   return !any_thread_.immediate_incoming_queue.empty();
 }
 
 bool TaskQueueImpl::HasPendingImmediateWorkLocked() {
+  MoveImmediateIncomingListToQueueLocked();
   return !main_thread_only().delayed_work_queue->Empty() ||
          !main_thread_only().immediate_work_queue->Empty() ||
          !any_thread_.immediate_incoming_queue.empty();
@@ -1097,6 +1291,7 @@ void TaskQueueImpl::DeletePendingTasks() {
     // Limit the scope of the lock to ensure that the deque is destroyed
     // outside of the lock to allow it to post tasks.
     base::internal::AutoSchedulerLock lock(any_thread_lock_);
+    MoveImmediateIncomingListToQueueLocked();
     deque.swap(any_thread_.immediate_incoming_queue);
     any_thread_.immediate_work_queue_empty = true;
   }
@@ -1114,6 +1309,7 @@ bool TaskQueueImpl::HasTasks() const {
     return true;
 
   base::internal::AutoSchedulerLock lock(any_thread_lock_);
+  MoveImmediateIncomingListToQueueLocked();
   if (!any_thread_.immediate_incoming_queue.empty())
     return true;
 
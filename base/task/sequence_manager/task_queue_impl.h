@@ -7,9 +7,11 @@
 
 #include <stddef.h>
 
+#include <atomic>
 #include <memory>
 #include <queue>
 #include <set>
+#include <vector>
 
 #include "base/callback.h"
 #include "base/macros.h"
@@ -17,8 +19,10 @@
 #include "base/pending_task.h"
 #include "base/task/common/intrusive_heap.h"
 #include "base/task/common/operations_controller.h"
+#include "base/task/common/timing_wheel.h"
 #include "base/task/sequence_manager/associated_thread_id.h"
 #include "base/task/sequence_manager/atomic_flag_set.h"
+#include "base/task/sequence_manager/atomic_task_list.h"
 #include "base/task/sequence_manager/enqueue_order.h"
 #include "base/task/sequence_manager/lazily_deallocated_deque.h"
 #include "base/task/sequence_manager/sequenced_task_source.h"
@@ -98,6 +102,11 @@ class BASE_EXPORT TaskQueueImpl {
   scoped_refptr<SingleThreadTaskRunner> CreateTaskRunner(
       TaskType task_type) const;
 
+  // Posts |tasks| as immediate nestable tasks with a single acquisition of
+  // |any_thread_lock_|. Returns false if the queue doesn't accept tasks.
+  // May be called from any thread.
+  bool PostTasks(const Location& from_here, std::vector<OnceClosure> tasks);
+
   // TaskQueue implementation.
   const char* GetName() const;
   bool IsQueueEnabled() const;
@@ -182,6 +191,15 @@ class BASE_EXPORT TaskQueueImpl {
     main_thread_only().heap_handle = heap_handle;
   }
 
+  base::internal::TimingWheelHandle timing_wheel_handle() const {
+    return main_thread_only().timing_wheel_handle;
+  }
+
+  void set_timing_wheel_handle(
+      base::internal::TimingWheelHandle timing_wheel_handle) {
+    main_thread_only().timing_wheel_handle = timing_wheel_handle;
+  }
+
   // Pushes |task| onto the front of the specified work queue. Caution must be
   // taken with this API because you could easily starve out other work.
   // TODO(kraynov): Simplify non-nestable task logic https://crbug.com/845437.
@@ -239,6 +257,7 @@ class BASE_EXPORT TaskQueueImpl {
     explicit GuardedTaskPoster(TaskQueueImpl* outer);
 
     bool PostTask(PostedTask task);
+    bool PostTasks(std::vector<PostedTask> tasks);
 
     void StartAcceptingOperations() {
       operations_controller_.StartAcceptingOperations();
@@ -334,6 +353,7 @@ class BASE_EXPORT TaskQueueImpl {
     DelayedIncomingQueue delayed_incoming_queue;
     ObserverList<TaskObserver>::Unchecked task_observers;
     base::internal::HeapHandle heap_handle;
+    base::internal::TimingWheelHandle timing_wheel_handle;
     bool is_enabled;
     trace_event::BlameContext* blame_context;  // Not owned.
     EnqueueOrder current_fence;
@@ -348,8 +368,33 @@ class BASE_EXPORT TaskQueueImpl {
   };
 
   void PostTask(PostedTask task);
+  void PostTasksImpl(std::vector<PostedTask> tasks);
 
   void PostImmediateTaskImpl(PostedTask task, CurrentThread current_thread);
+  void PostImmediateTasksImpl(std::vector<PostedTask> tasks,
+                              CurrentThread current_thread);
+
+  // Pushes |task| onto |any_thread_.immediate_incoming_queue|. Returns true if
+  // the SequenceManager must be asked to schedule work once |any_thread_lock_|
+  // is released.
+  bool PushOntoImmediateIncomingQueueLocked(PostedTask task,
+                                            TimeTicks now,
+                                            CurrentThread current_thread)
+      EXCLUSIVE_LOCKS_REQUIRED(any_thread_lock_);
+
+  // Pushes |task|, posted from another thread, onto |immediate_incoming_list_|.
+  // |any_thread_lock_| is only acquired by the first task pushed since the
+  // list was last drained, to request a reload from the main thread.
+  void PushOntoImmediateIncomingList(PostedTask task);
+
+  // Moves the tasks of |immediate_incoming_list_| to the back of
+  // |any_thread_.immediate_incoming_queue|. Must be called on the main thread
+  // before |any_thread_.immediate_incoming_queue| is read or pushed to from the
+  // main thread. This is const because both containers hold the immediate
+  // incoming tasks; moving tasks between them isn't observable.
+  void MoveImmediateIncomingListToQueueLocked() const
+      EXCLUSIVE_LOCKS_REQUIRED(any_thread_lock_);
+
   void PostDelayedTaskImpl(PostedTask task, CurrentThread current_thread);
 
   // Push the task onto the |delayed_incoming_queue|. Lock-free main thread
@@ -423,7 +468,9 @@ class BASE_EXPORT TaskQueueImpl {
     // locked before accessing from other threads.
     TimeDomain* time_domain;
 
-    TaskDeque immediate_incoming_queue;
+    // Mutable so that MoveImmediateIncomingListToQueueLocked() can be called
+    // from const methods.
+    mutable TaskDeque immediate_incoming_queue;
 
     // True if main_thread_only().immediate_work_queue is empty.
     bool immediate_work_queue_empty = true;
@@ -460,6 +507,16 @@ class BASE_EXPORT TaskQueueImpl {
   const bool should_monitor_quiescence_;
   const bool should_notify_observers_;
   const bool delayed_fence_allowed_;
+  const bool lock_free_cross_thread_posting_;
+
+  // If |lock_free_cross_thread_posting_|, immediate tasks posted from other
+  // threads are pushed here and moved to |any_thread_.immediate_incoming_queue|
+  // by the main thread, the only consumer.
+  mutable AtomicTaskList immediate_incoming_list_;
+
+  // Set by the first task pushed onto |immediate_incoming_list_| since the
+  // list was last drained. Reset when the main thread drains the list.
+  mutable std::atomic<bool> immediate_incoming_list_has_pending_reload_{false};
 
   DISALLOW_COPY_AND_ASSIGN(TaskQueueImpl);
 };
@@ -46,6 +46,12 @@ void TimeDomain::RequestDoWork() {
   sequence_manager_->ScheduleWork();
 }
 
+void TimeDomain::UseTimingWheel(TimeDelta granularity) {
+  DCHECK(Empty());
+  delayed_wake_up_wheel_ = std::make_unique<
+      base::internal::TimingWheel<ScheduledDelayedWakeUp>>(granularity);
+}
+
 void TimeDomain::UnregisterQueue(internal::TaskQueueImpl* queue) {
   DCHECK_CALLED_ON_VALID_THREAD(associated_thread_->thread_checker);
   DCHECK_EQ(queue->GetTimeDomain(), this);
@@ -63,16 +69,29 @@ void TimeDomain::SetNextWakeUpForQueue(
   DCHECK_EQ(queue->GetTimeDomain(), this);
   DCHECK(queue->IsQueueEnabled() || !wake_up);
 
-  Optional<TimeTicks> previous_wake_up;
+  Optional<TimeTicks> previous_wake_up = EarliestWakeUpTime();
   Optional<internal::WakeUpResolution> previous_queue_resolution;
-  if (!delayed_wake_up_queue_.empty())
-    previous_wake_up = delayed_wake_up_queue_.Min().wake_up.time;
   if (queue->heap_handle().IsValid()) {
     previous_queue_resolution =
         delayed_wake_up_queue_.at(queue->heap_handle()).resolution;
+  } else if (queue->timing_wheel_handle().IsValid()) {
+    previous_queue_resolution =
+        delayed_wake_up_wheel_->at(queue->timing_wheel_handle()).resolution;
   }
 
-  if (wake_up) {
+  if (delayed_wake_up_wheel_) {
+    // O(1)
+    if (wake_up && queue->timing_wheel_handle().IsValid()) {
+      delayed_wake_up_wheel_->ChangeKey(queue->timing_wheel_handle(),
+                                        wake_up->time,
+                                        {wake_up.value(), resolution, queue});
+    } else if (wake_up) {
+      delayed_wake_up_wheel_->insert(wake_up->time,
+                                     {wake_up.value(), resolution, queue});
+    } else if (queue->timing_wheel_handle().IsValid()) {
+      delayed_wake_up_wheel_->erase(queue->timing_wheel_handle());
+    }
+  } else if (wake_up) {
     // Insert a new wake-up into the heap.
     if (queue->heap_handle().IsValid()) {
       // O(log n)
@@ -88,9 +107,7 @@ void TimeDomain::SetNextWakeUpForQueue(
       delayed_wake_up_queue_.erase(queue->heap_handle());
   }
 
-  Optional<TimeTicks> new_wake_up;
-  if (!delayed_wake_up_queue_.empty())
-    new_wake_up = delayed_wake_up_queue_.Min().wake_up.time;
+  Optional<TimeTicks> new_wake_up = EarliestWakeUpTime();
 
   if (previous_queue_resolution &&
       *previous_queue_resolution == internal::WakeUpResolution::kHigh) {
@@ -123,6 +140,17 @@ void TimeDomain::SetNextWakeUpForQueue(
 
 void TimeDomain::MoveReadyDelayedTasksToWorkQueues(LazyNow* lazy_now) {
   DCHECK_CALLED_ON_VALID_THREAD(associated_thread_->thread_checker);
+  if (delayed_wake_up_wheel_) {
+    // Waking up a queue reschedules its wake-up, which removes it from the
+    // ready entries.
+    delayed_wake_up_wheel_->Advance(lazy_now->Now());
+    while (delayed_wake_up_wheel_->HasReady()) {
+      internal::TaskQueueImpl* queue = delayed_wake_up_wheel_->ReadyMin().queue;
+      queue->MoveReadyDelayedTasksToWorkQueue(lazy_now);
+    }
+    return;
+  }
+
   // Wake up any queues with pending delayed work.  Note std::multimap stores
   // the elements sorted by key, so the begin() iterator points to the earliest
   // queue to wake-up.
@@ -135,6 +163,15 @@ void TimeDomain::MoveReadyDelayedTasksToWorkQueues(LazyNow* lazy_now) {
 
 Optional<TimeTicks> TimeDomain::NextScheduledRunTime() const {
   DCHECK_CALLED_ON_VALID_THREAD(associated_thread_->thread_checker);
+  return EarliestWakeUpTime();
+}
+
+Optional<TimeTicks> TimeDomain::EarliestWakeUpTime() const {
+  if (delayed_wake_up_wheel_) {
+    if (delayed_wake_up_wheel_->empty())
+      return nullopt;
+    return delayed_wake_up_wheel_->NextRunTime();
+  }
   if (delayed_wake_up_queue_.empty())
     return nullopt;
   return delayed_wake_up_queue_.Min().wake_up.time;
@@ -143,9 +180,10 @@ Optional<TimeTicks> TimeDomain::NextScheduledRunTime() const {
 void TimeDomain::AsValueInto(trace_event::TracedValue* state) const {
   state->BeginDictionary();
   state->SetString("name", GetName());
-  state->SetInteger("registered_delay_count", delayed_wake_up_queue_.size());
-  if (!delayed_wake_up_queue_.empty()) {
-    TimeDelta delay = delayed_wake_up_queue_.Min().wake_up.time - Now();
+  state->SetInteger("registered_delay_count", NumberOfScheduledWakeUps());
+  Optional<TimeTicks> next_wake_up = EarliestWakeUpTime();
+  if (next_wake_up) {
+    TimeDelta delay = *next_wake_up - Now();
     state->SetDouble("next_delay_ms", delay.InMillisecondsF());
   }
   AsValueIntoInternal(state);
@@ -161,7 +199,7 @@ bool TimeDomain::HasPendingHighResolutionTasks() const {
 }
 
 bool TimeDomain::Empty() const {
-  return delayed_wake_up_queue_.empty();
+  return NumberOfScheduledWakeUps() == 0;
 }
 
 }  // namespace sequence_manager
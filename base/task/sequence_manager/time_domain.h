@@ -6,11 +6,13 @@
 #define BASE_TASK_SEQUENCE_MANAGER_TIME_DOMAIN_H_
 
 #include <map>
+#include <memory>
 
 #include "base/callback.h"
 #include "base/logging.h"
 #include "base/macros.h"
 #include "base/task/common/intrusive_heap.h"
+#include "base/task/common/timing_wheel.h"
 #include "base/task/sequence_manager/lazy_now.h"
 #include "base/task/sequence_manager/task_queue_impl.h"
 #include "base/time/time.h"
@@ -62,6 +64,13 @@ class BASE_EXPORT TimeDomain {
   // Returns true if there are no pending delayed tasks.
   bool Empty() const;
 
+  // Keeps wake-ups in a hierarchical timing wheel instead of a heap, which
+  // makes scheduling and cancelling a wake-up O(1) rather than O(log n). Wake-
+  // ups are rounded up to a multiple of |granularity|, so that wake-ups which
+  // are less than |granularity| apart are coalesced, and delayed tasks may run
+  // up to |granularity| late. Must be called before any wake-up is scheduled.
+  void UseTimingWheel(TimeDelta granularity);
+
   // This is the signal that virtual time should step forward. If
   // RunLoop::QuitWhenIdle has been called then |quit_when_idle_requested| will
   // be true. Returns true if time advanced and there is now a task to run.
@@ -76,7 +85,8 @@ class BASE_EXPORT TimeDomain {
   Optional<TimeTicks> NextScheduledRunTime() const;
 
   size_t NumberOfScheduledWakeUps() const {
-    return delayed_wake_up_queue_.size();
+    return delayed_wake_up_wheel_ ? delayed_wake_up_wheel_->size()
+                                  : delayed_wake_up_queue_.size();
   }
 
   // Tells SequenceManager to schedule delayed work, use TimeTicks::Max()
@@ -142,10 +152,27 @@ class BASE_EXPORT TimeDomain {
       DCHECK(queue->heap_handle().IsValid());
       queue->set_heap_handle(base::internal::HeapHandle());
     }
+
+    void SetTimingWheelHandle(base::internal::TimingWheelHandle handle) {
+      DCHECK(handle.IsValid());
+      queue->set_timing_wheel_handle(handle);
+    }
+
+    void ClearTimingWheelHandle() {
+      DCHECK(queue->timing_wheel_handle().IsValid());
+      queue->set_timing_wheel_handle(base::internal::TimingWheelHandle());
+    }
   };
 
+  // Returns the earliest scheduled wake-up time, or nullopt if there is none.
+  // With a timing wheel, this is rounded up to the wheel's granularity.
+  Optional<TimeTicks> EarliestWakeUpTime() const;
+
   internal::SequenceManagerImpl* sequence_manager_;  // Not owned.
   base::internal::IntrusiveHeap<ScheduledDelayedWakeUp> delayed_wake_up_queue_;
+  // If set, used instead of |delayed_wake_up_queue_|. See UseTimingWheel().
+  std::unique_ptr<base::internal::TimingWheel<ScheduledDelayedWakeUp>>
+      delayed_wake_up_wheel_;
   int pending_high_res_wake_up_count_ = 0;
 
   scoped_refptr<internal::AssociatedThreadId> associated_thread_;
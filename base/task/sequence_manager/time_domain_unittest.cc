@@ -391,6 +391,63 @@ TEST_F(TimeDomainTest, HighResolutionWakeUps) {
   q2.UnregisterTaskQueue();
 }
 
+class TimeDomainWithTimingWheelTest : public TimeDomainTest {
+ public:
+  TestTimeDomain* CreateTestTimeDomain() override {
+    TestTimeDomain* time_domain = new TestTimeDomain();
+    time_domain->UseTimingWheel(TimeDelta::FromMilliseconds(1));
+    return time_domain;
+  }
+};
+
+TEST_F(TimeDomainWithTimingWheelTest, CoalescesWakeUps) {
+  std::unique_ptr<TaskQueueImplForTest> task_queue2 =
+      std::make_unique<TaskQueueImplForTest>(nullptr, time_domain_.get(),
+                                             TaskQueue::Spec("test"));
+
+  TimeTicks now = time_domain_->Now();
+  TimeTicks wake_up1 = now + TimeDelta::FromMicroseconds(10200);
+  TimeTicks wake_up2 = now + TimeDelta::FromMicroseconds(10700);
+  TimeTicks coalesced_wake_up = now + TimeDelta::FromMilliseconds(11);
+
+  // Both wake-ups are rounded up to the same time, so SetNextDelayedDoWork is
+  // only called once.
+  EXPECT_CALL(*time_domain_.get(), SetNextDelayedDoWork(_, coalesced_wake_up))
+      .Times(1);
+  task_queue_->SetDelayedWakeUpForTesting(internal::DelayedWakeUp{wake_up1, 0});
+  task_queue2->SetDelayedWakeUpForTesting(internal::DelayedWakeUp{wake_up2, 1});
+  EXPECT_EQ(coalesced_wake_up, time_domain_->NextScheduledRunTime());
+  Mock::VerifyAndClearExpectations(time_domain_.get());
+
+  // The queues aren't woken up before the coalesced wake-up.
+  time_domain_->SetNow(wake_up2);
+  LazyNow lazy_now_1(time_domain_->CreateLazyNow());
+  time_domain_->MoveReadyDelayedTasksToWorkQueues(&lazy_now_1);
+  EXPECT_EQ(coalesced_wake_up, time_domain_->NextScheduledRunTime());
+
+  EXPECT_CALL(*time_domain_.get(), SetNextDelayedDoWork(_, TimeTicks::Max()));
+  time_domain_->SetNow(coalesced_wake_up);
+  LazyNow lazy_now_2(time_domain_->CreateLazyNow());
+  time_domain_->MoveReadyDelayedTasksToWorkQueues(&lazy_now_2);
+  EXPECT_TRUE(time_domain_->Empty());
+
+  task_queue2->UnregisterTaskQueue();
+}
+
+TEST_F(TimeDomainWithTimingWheelTest, CancelDelayedWork) {
+  TimeTicks run_time = time_domain_->Now() + TimeDelta::FromMilliseconds(20);
+
+  EXPECT_CALL(*time_domain_.get(), SetNextDelayedDoWork(_, run_time));
+  task_queue_->SetDelayedWakeUpForTesting(internal::DelayedWakeUp{run_time, 0});
+  EXPECT_TRUE(task_queue_->timing_wheel_handle().IsValid());
+  EXPECT_FALSE(task_queue_->heap_handle().IsValid());
+
+  EXPECT_CALL(*time_domain_.get(), SetNextDelayedDoWork(_, TimeTicks::Max()));
+  task_queue_->SetDelayedWakeUpForTesting(nullopt);
+  EXPECT_FALSE(task_queue_->timing_wheel_handle().IsValid());
+  EXPECT_TRUE(time_domain_->Empty());
+}
+
 TEST_F(TimeDomainTest, SetNextWakeUpForQueueInThePast) {
   constexpr auto kType = MessageLoop::TYPE_DEFAULT;
   constexpr auto kDelay = TimeDelta::FromMilliseconds(20);
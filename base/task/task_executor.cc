@@ -5,6 +5,7 @@
 #include "base/task/task_executor.h"
 
 #include <type_traits>
+#include <utility>
 
 #include "base/task/task_traits.h"
 #include "base/task/task_traits_extension.h"
@@ -30,6 +31,18 @@ static_assert(
 
 }  // namespace
 
+bool TaskExecutor::PostTasksWithTraits(const Location& from_here,
+                                       const TaskTraits& traits,
+                                       std::vector<OnceClosure> tasks) {
+  bool all_tasks_posted = true;
+  for (OnceClosure& task : tasks) {
+    all_tasks_posted &=
+        PostDelayedTaskWithTraits(from_here, traits, std::move(task),
+                                  TimeDelta());
+  }
+  return all_tasks_posted;
+}
+
 void RegisterTaskExecutor(uint8_t extension_id, TaskExecutor* task_executor) {
   DCHECK_NE(extension_id, TaskTraitsExtensionStorage::kInvalidExtensionId);
   DCHECK_LE(extension_id, TaskTraitsExtensionStorage::kMaxExtensionId);
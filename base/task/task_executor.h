@@ -7,6 +7,8 @@
 
 #include <stdint.h>
 
+#include <vector>
+
 #include "base/base_export.h"
 #include "base/memory/ref_counted.h"
 #include "base/sequenced_task_runner.h"
@@ -35,6 +37,15 @@ class BASE_EXPORT TaskExecutor {
                                          OnceClosure task,
                                          TimeDelta delay) = 0;
 
+  // Posts all of |tasks| with specific |traits|, without delay. Tasks may run
+  // in any order and in parallel. Returns false if at least one task definitely
+  // won't run because of current shutdown state. Implementations can override
+  // this to amortize the cost of posting over the whole batch; the default
+  // implementation posts each task with PostDelayedTaskWithTraits().
+  virtual bool PostTasksWithTraits(const Location& from_here,
+                                   const TaskTraits& traits,
+                                   std::vector<OnceClosure> tasks);
+
   // Returns a TaskRunner whose PostTask invocations result in scheduling tasks
   // using |traits|. Tasks may run in any order and in parallel.
   virtual scoped_refptr<TaskRunner> CreateTaskRunnerWithTraits(
@@ -23,6 +23,12 @@ const Feature kNoDetachBelowInitialCapacity = {
 const Feature kMayBlockWithoutDelay = {"MayBlockWithoutDelay",
                                        base::FEATURE_DISABLED_BY_DEFAULT};
 
+const Feature kUseWorkerLocalSequence = {"UseWorkerLocalSequence",
+                                         base::FEATURE_DISABLED_BY_DEFAULT};
+
+const Feature kUseTimingWheelForDelayedTasks = {
+    "UseTimingWheelForDelayedTasks", base::FEATURE_DISABLED_BY_DEFAULT};
+
 #if defined(OS_WIN) || defined(OS_MACOSX)
 const Feature kUseNativeThreadPool = {"UseNativeThreadPool",
                                       base::FEATURE_DISABLED_BY_DEFAULT};
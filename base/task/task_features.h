@@ -24,6 +24,18 @@ extern const BASE_EXPORT Feature kNoDetachBelowInitialCapacity;
 // instead of waiting for a threshold.
 extern const BASE_EXPORT Feature kMayBlockWithoutDelay;
 
+// Under this feature, a worker that runs a task from a Sequence which would be
+// the next Sequence popped from its pool's PriorityQueue keeps that Sequence
+// and runs its next task without going through the PriorityQueue. This saves
+// a lock acquisition per task when a worker runs consecutive tasks from the
+// same Sequence.
+extern const BASE_EXPORT Feature kUseWorkerLocalSequence;
+
+// Under this feature, the ThreadPool's DelayedTaskManager keeps delayed tasks
+// in a hierarchical timing wheel instead of a heap. Delayed tasks which become
+// ripe within the same millisecond are forwarded together.
+extern const BASE_EXPORT Feature kUseTimingWheelForDelayedTasks;
+
 #if defined(OS_WIN) || defined(OS_MACOSX)
 // Under this feature, ThreadPool will use a SchedulerWorkerPool backed by a
 // native thread pool implementation. The Windows Thread Pool API and
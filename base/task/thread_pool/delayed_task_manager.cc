@@ -71,6 +71,24 @@ void DelayedTaskManager::Start(
   ScheduleProcessRipeTasksOnServiceThread(process_ripe_tasks_time);
 }
 
+void DelayedTaskManager::UseTimingWheel(TimeDelta granularity) {
+  AutoSchedulerLock auto_lock(queue_lock_);
+  DCHECK(!service_thread_task_runner_);
+  DCHECK(!delayed_task_wheel_);
+  delayed_task_wheel_ =
+      std::make_unique<TimingWheel<DelayedTask>>(granularity);
+  // Move the tasks which were added before this was called.
+  while (!delayed_task_queue_.empty()) {
+    // The const_cast on top is okay since the DelayedTask is transactionally
+    // being popped from |delayed_task_queue_| right after.
+    DelayedTask& delayed_task =
+        const_cast<DelayedTask&>(delayed_task_queue_.Min());
+    const TimeTicks delayed_run_time = delayed_task.task.delayed_run_time;
+    delayed_task_wheel_->insert(delayed_run_time, std::move(delayed_task));
+    delayed_task_queue_.Pop();
+  }
+}
+
 void DelayedTaskManager::AddDelayedTask(
     Task task,
     PostTaskNowCallback post_task_now_callback,
@@ -84,9 +102,17 @@ void DelayedTaskManager::AddDelayedTask(
   TimeTicks process_ripe_tasks_time;
   {
     AutoSchedulerLock auto_lock(queue_lock_);
-    delayed_task_queue_.insert(DelayedTask(std::move(task),
-                                           std::move(post_task_now_callback),
-                                           std::move(task_runner)));
+    if (delayed_task_wheel_) {
+      const TimeTicks delayed_run_time = task.delayed_run_time;
+      delayed_task_wheel_->insert(
+          delayed_run_time,
+          DelayedTask(std::move(task), std::move(post_task_now_callback),
+                      std::move(task_runner)));
+    } else {
+      delayed_task_queue_.insert(DelayedTask(std::move(task),
+                                             std::move(post_task_now_callback),
+                                             std::move(task_runner)));
+    }
     // Not started yet.
     if (service_thread_task_runner_ == nullptr)
       return;
@@ -102,6 +128,13 @@ void DelayedTaskManager::ProcessRipeTasks() {
   {
     AutoSchedulerLock auto_lock(queue_lock_);
     const TimeTicks now = tick_clock_->NowTicks();
+    if (delayed_task_wheel_) {
+      process_ripe_tasks_time_ = TimeTicks::Max();
+      // Ripe tasks are taken in order of |delayed_run_time|.
+      delayed_task_wheel_->Advance(now);
+      while (delayed_task_wheel_->HasReady())
+        ripe_delayed_tasks.push_back(delayed_task_wheel_->TakeReadyMin());
+    }
     while (!delayed_task_queue_.empty() &&
            delayed_task_queue_.Min().task.delayed_run_time <= now) {
       // The const_cast on top is okay since the DelayedTask is
@@ -122,6 +155,15 @@ void DelayedTaskManager::ProcessRipeTasks() {
 
 TimeTicks DelayedTaskManager::GetTimeToScheduleProcessRipeTasksLockRequired() {
   queue_lock_.AssertAcquired();
+  if (delayed_task_wheel_) {
+    // Tasks which are ripe at the same rounded up time share a call to
+    // ProcessRipeTasks().
+    const TimeTicks next_run_time = delayed_task_wheel_->NextRunTime();
+    if (next_run_time >= process_ripe_tasks_time_)
+      return TimeTicks::Max();
+    process_ripe_tasks_time_ = next_run_time;
+    return next_run_time;
+  }
   if (delayed_task_queue_.empty())
     return TimeTicks::Max();
   // The const_cast on top is okay since |IsScheduled()| and |SetScheduled()|
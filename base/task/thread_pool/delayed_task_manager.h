@@ -15,6 +15,7 @@
 #include "base/memory/ref_counted.h"
 #include "base/synchronization/atomic_flag.h"
 #include "base/task/common/intrusive_heap.h"
+#include "base/task/common/timing_wheel.h"
 #include "base/task/thread_pool/scheduler_lock.h"
 #include "base/task/thread_pool/task.h"
 #include "base/time/default_tick_clock.h"
@@ -45,6 +46,13 @@ class BASE_EXPORT DelayedTaskManager {
   // thread.
   void Start(scoped_refptr<TaskRunner> service_thread_task_runner);
 
+  // Keeps delayed tasks in a hierarchical timing wheel instead of a heap,
+  // which makes adding a delayed task O(1). The ripe time of each task is
+  // rounded up to a multiple of |granularity|, so that tasks which are ripe
+  // less than |granularity| apart are forwarded together. Must be called
+  // before Start().
+  void UseTimingWheel(TimeDelta granularity);
+
   // Schedules a call to |post_task_now_callback| with |task| as argument when
   // |task| is ripe for execution. |task_runner| is passed to retain a
   // reference until |task| is ripe.
@@ -84,6 +92,12 @@ class BASE_EXPORT DelayedTaskManager {
     // Required by IntrusiveHeap.
     void ClearHeapHandle() {}
 
+    // Required by TimingWheel.
+    void SetTimingWheelHandle(const TimingWheelHandle& handle) {}
+
+    // Required by TimingWheel.
+    void ClearTimingWheelHandle() {}
+
    private:
     bool scheduled_ = false;
     DISALLOW_COPY_AND_ASSIGN(DelayedTask);
@@ -111,11 +125,18 @@ class BASE_EXPORT DelayedTaskManager {
 
   IntrusiveHeap<DelayedTask> delayed_task_queue_;
 
-  // Synchronizes access to |delayed_task_queue_| and the setting of
-  // |service_thread_task_runner|. Once |service_thread_task_runner_| is set,
-  // it is never modified. It is therefore safe to access
-  // |service_thread_task_runner_| without synchronization once it is observed
-  // that it is non-null.
+  // If set, used instead of |delayed_task_queue_|. See UseTimingWheel().
+  std::unique_ptr<TimingWheel<DelayedTask>> delayed_task_wheel_;
+
+  // With |delayed_task_wheel_|, the earliest time at which ProcessRipeTasks()
+  // is scheduled to run, or TimeTicks::Max() if it isn't scheduled.
+  TimeTicks process_ripe_tasks_time_ = TimeTicks::Max();
+
+  // Synchronizes access to |delayed_task_queue_|, |delayed_task_wheel_|,
+  // |process_ripe_tasks_time_| and the setting of |service_thread_task_runner|.
+  // Once |service_thread_task_runner_| is set, it is never modified. It is
+  // therefore safe to access |service_thread_task_runner_| without
+  // synchronization once it is observed that it is non-null.
   SchedulerLock queue_lock_;
 
   DISALLOW_COPY_AND_ASSIGN(DelayedTaskManager);
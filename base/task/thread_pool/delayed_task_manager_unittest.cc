@@ -196,6 +196,56 @@ TEST_F(ThreadPoolDelayedTaskManagerTest, DelayedTasksRunAfterDelay) {
   testing::Mock::VerifyAndClear(&mock_task_b);
 }
 
+// Verify that with a timing wheel, delayed tasks whose ripe times round up to
+// the same multiple of the granularity are forwarded together, in order of
+// ripe time.
+TEST_F(ThreadPoolDelayedTaskManagerTest, DelayedTasksRunAfterDelayTimingWheel) {
+  constexpr TimeDelta kGranularity = TimeDelta::FromMilliseconds(10);
+  delayed_task_manager_.UseTimingWheel(kGranularity);
+  delayed_task_manager_.Start(service_thread_task_runner_);
+
+  const TimeTicks now = service_thread_task_runner_->NowTicks();
+  const TimeTicks coalesced_run_time =
+      TimeTicks() + kGranularity * ((now - TimeTicks()) / kGranularity + 2);
+
+  testing::StrictMock<MockTask> mock_task_a;
+  Task task_a = ConstructMockedTask(
+      mock_task_a, now,
+      coalesced_run_time - now - TimeDelta::FromMilliseconds(1));
+
+  testing::StrictMock<MockTask> mock_task_b;
+  Task task_b = ConstructMockedTask(
+      mock_task_b, now,
+      coalesced_run_time - now - TimeDelta::FromMilliseconds(7));
+
+  delayed_task_manager_.AddDelayedTask(std::move(task_a), BindOnce(&RunTask),
+                                       nullptr);
+  delayed_task_manager_.AddDelayedTask(std::move(task_b), BindOnce(&RunTask),
+                                       nullptr);
+
+  // Both tasks are ripe, but aren't forwarded before |coalesced_run_time|.
+  service_thread_task_runner_->FastForwardBy(coalesced_run_time - now -
+                                             TimeDelta::FromMilliseconds(1));
+
+  testing::InSequence sequence;
+  EXPECT_CALL(mock_task_b, Run());
+  EXPECT_CALL(mock_task_a, Run());
+  service_thread_task_runner_->FastForwardBy(TimeDelta::FromMilliseconds(1));
+}
+
+// Verify that a delayed task added before UseTimingWheel() is forwarded when
+// it is ripe for execution.
+TEST_F(ThreadPoolDelayedTaskManagerTest,
+       DelayedTaskAddedBeforeUseTimingWheelRunsAfterDelay) {
+  delayed_task_manager_.AddDelayedTask(std::move(task_), BindOnce(&RunTask),
+                                       nullptr);
+  delayed_task_manager_.UseTimingWheel(TimeDelta::FromMilliseconds(1));
+  delayed_task_manager_.Start(service_thread_task_runner_);
+
+  EXPECT_CALL(mock_task_, Run());
+  service_thread_task_runner_->FastForwardBy(kLongDelay);
+}
+
 TEST_F(ThreadPoolDelayedTaskManagerTest, PostTaskDuringStart) {
   Thread other_thread("Test");
   other_thread.StartAndWaitForTesting();
@@ -119,6 +119,13 @@ void PlatformNativeWorkerPool::PushSequenceAndWakeUpWorkers(
                                    std::move(sequence_and_transaction));
 }
 
+void PlatformNativeWorkerPool::PushSequencesAndWakeUpWorkers(
+    std::vector<SequenceAndSortKey> sequences_and_sort_keys) {
+  ScopedWorkersExecutor executor(this);
+  PushSequencesAndWakeUpWorkersImpl(&executor,
+                                    std::move(sequences_and_sort_keys));
+}
+
 void PlatformNativeWorkerPool::EnsureEnoughWorkersLockRequired(
     BaseScopedWorkersExecutor* executor) {
   if (!started_)
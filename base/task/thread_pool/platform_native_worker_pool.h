@@ -50,6 +50,8 @@ class BASE_EXPORT PlatformNativeWorkerPool : public SchedulerWorkerPool {
   void UpdateSortKey(SequenceAndTransaction sequence_and_transaction) override;
   void PushSequenceAndWakeUpWorkers(
       SequenceAndTransaction sequence_and_transaction) override;
+  void PushSequencesAndWakeUpWorkers(
+      std::vector<SequenceAndSortKey> sequences_and_sort_keys) override;
   void EnsureEnoughWorkersLockRequired(BaseScopedWorkersExecutor* executor)
       override EXCLUSIVE_LOCKS_REQUIRED(lock_);
 
@@ -43,17 +43,17 @@ SchedulerWorker::SchedulerWorker(
     std::unique_ptr<Delegate> delegate,
     TrackedRef<TaskTracker> task_tracker,
     const SchedulerLock* predecessor_lock,
-    SchedulerBackwardCompatibility backward_compatibility)
+    SchedulerBackwardCompatibility backward_compatibility,
+    ThreadCpuAffinity cpu_affinity)
     : thread_lock_(predecessor_lock),
       delegate_(std::move(delegate)),
       task_tracker_(std::move(task_tracker)),
       priority_hint_(priority_hint),
-      current_thread_priority_(GetDesiredThreadPriority())
+      current_thread_priority_(GetDesiredThreadPriority()),
 #if defined(OS_WIN) && !defined(COM_INIT_CHECK_HOOK_ENABLED)
-      ,
-      backward_compatibility_(backward_compatibility)
+      backward_compatibility_(backward_compatibility),
 #endif
-{
+      cpu_affinity_(cpu_affinity) {
   DCHECK(delegate_);
   DCHECK(task_tracker_);
   DCHECK(CanUseBackgroundPriorityForSchedulerWorker() ||
@@ -184,6 +184,22 @@ void SchedulerWorker::UpdateThreadPriority(
   current_thread_priority_ = desired_thread_priority;
 }
 
+void SchedulerWorker::ApplyCpuAffinity() {
+  if (cpu_affinity_ == ThreadCpuAffinity::ANY)
+    return;
+
+#if defined(OS_LINUX) || defined(OS_ANDROID)
+  const bool applied =
+      PlatformThread::SetCurrentThreadCpuAffinity(cpu_affinity_);
+#else
+  const bool applied = false;
+#endif
+  TRACE_EVENT_INSTANT2(TRACE_DISABLED_BY_DEFAULT("thread_pool_placement"),
+                       "SchedulerWorkerThread placement",
+                       TRACE_EVENT_SCOPE_THREAD, "cpu_affinity",
+                       static_cast<int>(cpu_affinity_), "applied", applied);
+}
+
 void SchedulerWorker::ThreadMain() {
   if (priority_hint_ == ThreadPriority::BACKGROUND) {
     switch (delegate_->GetThreadLabel()) {
@@ -296,6 +312,10 @@ void SchedulerWorker::RunWorker() {
                        TRACE_EVENT_SCOPE_THREAD);
   TRACE_EVENT_BEGIN0("thread_pool", "SchedulerWorkerThread active");
 
+  // Placement is applied before OnMainEntry() so that the sysfs reads performed
+  // to discover the core topology aren't reported to the pool as blocking work.
+  ApplyCpuAffinity();
+
   if (scheduler_worker_observer_)
     scheduler_worker_observer_->OnSchedulerWorkerMainEntry();
 
@@ -108,14 +108,17 @@ class BASE_EXPORT SchedulerWorker
   // capabilities. |task_tracker| is used to handle shutdown behavior of Tasks.
   // |predecessor_lock| is a lock that is allowed to be held when calling
   // methods on this SchedulerWorker. |backward_compatibility| indicates
-  // whether backward compatibility is enabled. Either JoinForTesting() or
-  // Cleanup() must be called before releasing the last external reference.
+  // whether backward compatibility is enabled. |cpu_affinity| restricts the
+  // cores the thread may run on (Linux and Android only). Either
+  // JoinForTesting() or Cleanup() must be called before releasing the last
+  // external reference.
   SchedulerWorker(ThreadPriority priority_hint,
                   std::unique_ptr<Delegate> delegate,
                   TrackedRef<TaskTracker> task_tracker,
                   const SchedulerLock* predecessor_lock = nullptr,
                   SchedulerBackwardCompatibility backward_compatibility =
-                      SchedulerBackwardCompatibility::DISABLED);
+                      SchedulerBackwardCompatibility::DISABLED,
+                  ThreadCpuAffinity cpu_affinity = ThreadCpuAffinity::ANY);
 
   // Creates a thread to back the SchedulerWorker. The thread will be in a wait
   // state pending a WakeUp() call. No thread will be created if Cleanup() was
@@ -180,6 +183,10 @@ class BASE_EXPORT SchedulerWorker
   // the thread managed by |this|.
   void UpdateThreadPriority(ThreadPriority desired_thread_priority);
 
+  // Restricts the thread to the cores designated by |cpu_affinity_|. Must be
+  // called on the thread managed by |this|.
+  void ApplyCpuAffinity();
+
   // PlatformThread::Delegate:
   void ThreadMain() override;
 
@@ -245,6 +252,9 @@ class BASE_EXPORT SchedulerWorker
   const SchedulerBackwardCompatibility backward_compatibility_;
 #endif
 
+  // Cores the thread may run on.
+  const ThreadCpuAffinity cpu_affinity_;
+
   // Set once JoinForTesting() has been called.
   AtomicFlag join_called_for_testing_;
 
@@ -148,6 +148,20 @@ void SchedulerWorkerPool::PushSequenceAndWakeUpWorkersImpl(
   EnsureEnoughWorkersLockRequired(executor);
 }
 
+void SchedulerWorkerPool::PushSequencesAndWakeUpWorkersImpl(
+    BaseScopedWorkersExecutor* executor,
+    std::vector<SequenceAndSortKey> sequences_and_sort_keys) {
+  if (sequences_and_sort_keys.empty())
+    return;
+  AutoSchedulerLock auto_lock(lock_);
+  DCHECK(!replacement_pool_);
+  for (SequenceAndSortKey& sequence_and_sort_key : sequences_and_sort_keys) {
+    priority_queue_.Push(std::move(sequence_and_sort_key.sequence),
+                         sequence_and_sort_key.sort_key);
+  }
+  EnsureEnoughWorkersLockRequired(executor);
+}
+
 void SchedulerWorkerPool::InvalidateAndHandoffAllSequencesToOtherPool(
     SchedulerWorkerPool* destination_pool) {
   AutoSchedulerLock current_pool_lock(lock_);
@@ -5,12 +5,15 @@
 #ifndef BASE_TASK_THREAD_POOL_SCHEDULER_WORKER_POOL_H_
 #define BASE_TASK_THREAD_POOL_SCHEDULER_WORKER_POOL_H_
 
+#include <vector>
+
 #include "base/base_export.h"
 #include "base/memory/ref_counted.h"
 #include "base/task/thread_pool/can_schedule_sequence_observer.h"
 #include "base/task/thread_pool/priority_queue.h"
 #include "base/task/thread_pool/scheduler_lock.h"
 #include "base/task/thread_pool/sequence.h"
+#include "base/task/thread_pool/sequence_sort_key.h"
 #include "base/task/thread_pool/task.h"
 #include "base/task/thread_pool/tracked_ref.h"
 #include "build/build_config.h"
@@ -35,6 +38,12 @@ class BASE_EXPORT SchedulerWorkerPool : public CanScheduleSequenceObserver {
         const TaskTraits& traits) = 0;
   };
 
+  // A Sequence and the sort key with which it is pushed in a PriorityQueue.
+  struct SequenceAndSortKey {
+    scoped_refptr<Sequence> sequence;
+    SequenceSortKey sort_key;
+  };
+
   enum class WorkerEnvironment {
     // No special worker environment required.
     NONE,
@@ -86,6 +95,16 @@ class BASE_EXPORT SchedulerWorkerPool : public CanScheduleSequenceObserver {
   virtual void PushSequenceAndWakeUpWorkers(
       SequenceAndTransaction sequence_and_transaction) = 0;
 
+  // Pushes all Sequences in |sequences_and_sort_keys| into this pool's
+  // PriorityQueue with a single acquisition of the pool's lock and wakes up
+  // workers as appropriate. The Sequences must have been allowed to be
+  // scheduled by TaskTracker::WillScheduleSequence().
+  //
+  // Implementations should instantiate a concrete ScopedWorkersExecutor and
+  // invoke PushSequencesAndWakeUpWorkersImpl().
+  virtual void PushSequencesAndWakeUpWorkers(
+      std::vector<SequenceAndSortKey> sequences_and_sort_keys) = 0;
+
   // Removes all sequences from this pool's PriorityQueue and enqueues them in
   // another |destination_pool|. After this method is called, any sequences
   // posted to this pool will be forwarded to |destination_pool|.
@@ -175,6 +194,9 @@ class BASE_EXPORT SchedulerWorkerPool : public CanScheduleSequenceObserver {
   void PushSequenceAndWakeUpWorkersImpl(
       BaseScopedWorkersExecutor* executor,
       SequenceAndTransaction sequence_and_transaction);
+  void PushSequencesAndWakeUpWorkersImpl(
+      BaseScopedWorkersExecutor* executor,
+      std::vector<SequenceAndSortKey> sequences_and_sort_keys);
 
   // Synchronizes accesses to all members of this class which are neither const,
   // atomic, nor immutable after start. Since this lock is a bottleneck to post
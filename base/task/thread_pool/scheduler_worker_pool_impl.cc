@@ -26,6 +26,7 @@
 #include "base/task/task_features.h"
 #include "base/task/task_traits.h"
 #include "base/task/thread_pool/scheduler_worker_pool_params.h"
+#include "base/task/thread_pool/sequence_sort_key.h"
 #include "base/task/thread_pool/task_tracker.h"
 #include "base/threading/platform_thread.h"
 #include "base/threading/scoped_blocking_call.h"
@@ -262,6 +263,13 @@ class SchedulerWorkerPoolImpl::SchedulerWorkerDelegateImpl
   void OnWorkerBecomesIdleLockRequired(SchedulerWorker* worker)
       EXCLUSIVE_LOCKS_REQUIRED(outer_->lock_);
 
+  // Returns true if the worker can keep the Sequence locked by |transaction|,
+  // from which it just ran a task, and run its next task without reenqueuing
+  // it in |outer_->priority_queue_|. This is only allowed if GetWork() would
+  // have returned that Sequence to this worker after it was reenqueued.
+  bool CanKeepSequenceLockRequired(const Sequence::Transaction& transaction)
+      EXCLUSIVE_LOCKS_REQUIRED(outer_->lock_);
+
   // Accessed only from the worker thread.
   struct WorkerOnly {
     // Number of tasks executed since the last time the
@@ -274,8 +282,14 @@ class SchedulerWorkerPoolImpl::SchedulerWorkerDelegateImpl
 
     // Whether the worker is currently running a task (i.e. GetWork() has
     // returned a non-empty sequence and DidRunTask() hasn't been called yet).
+    // Remains true while |kept_sequence| is set.
     bool is_running_task = false;
 
+    // Sequence kept by DidRunTask() to be returned by the next GetWork()
+    // without acquiring |outer_->lock_|. The running task bookkeeping of the
+    // pool still accounts for this Sequence while it is set.
+    scoped_refptr<Sequence> kept_sequence;
+
 #if defined(OS_WIN)
     std::unique_ptr<win::ScopedWindowsThreadEnvironment> win_thread_environment;
 #endif  // defined(OS_WIN)
@@ -400,6 +414,8 @@ void SchedulerWorkerPoolImpl::Start(
 
   in_start().may_block_without_delay =
       FeatureList::IsEnabled(kMayBlockWithoutDelay);
+  in_start().use_worker_local_sequence =
+      FeatureList::IsEnabled(kUseWorkerLocalSequence);
   in_start().may_block_threshold =
       may_block_threshold ? may_block_threshold.value()
                           : (priority_hint_ == ThreadPriority::NORMAL
@@ -416,6 +432,7 @@ void SchedulerWorkerPoolImpl::Start(
   max_best_effort_tasks_ = max_best_effort_tasks;
   in_start().suggested_reclaim_time = params.suggested_reclaim_time();
   in_start().backward_compatibility = params.backward_compatibility();
+  in_start().cpu_affinity = params.cpu_affinity();
   in_start().worker_environment = worker_environment;
   in_start().service_thread_task_runner = std::move(service_thread_task_runner);
   in_start().scheduler_worker_observer = scheduler_worker_observer;
@@ -448,6 +465,13 @@ void SchedulerWorkerPoolImpl::PushSequenceAndWakeUpWorkers(
                                    std::move(sequence_and_transaction));
 }
 
+void SchedulerWorkerPoolImpl::PushSequencesAndWakeUpWorkers(
+    std::vector<SequenceAndSortKey> sequences_and_sort_keys) {
+  ScopedWorkersExecutor executor(this);
+  PushSequencesAndWakeUpWorkersImpl(&executor,
+                                    std::move(sequences_and_sort_keys));
+}
+
 size_t SchedulerWorkerPoolImpl::GetMaxConcurrentNonBlockedTasksDeprecated()
     const {
 #if DCHECK_IS_ON()
@@ -602,6 +626,14 @@ scoped_refptr<Sequence>
 SchedulerWorkerPoolImpl::SchedulerWorkerDelegateImpl::GetWork(
     SchedulerWorker* worker) {
   DCHECK_CALLED_ON_VALID_THREAD(worker_thread_checker_);
+
+  // Run the next task from the Sequence kept by DidRunTask(), if any. The
+  // running task bookkeeping was left untouched when it was kept.
+  if (worker_only().kept_sequence) {
+    DCHECK(worker_only().is_running_task);
+    return std::move(worker_only().kept_sequence);
+  }
+
   DCHECK(!worker_only().is_running_task);
   DCHECK(!read_worker().is_running_best_effort_task);
 
@@ -682,6 +714,14 @@ void SchedulerWorkerPoolImpl::SchedulerWorkerDelegateImpl::DidRunTask(
 
   DCHECK(!incremented_max_tasks_since_blocked_);
 
+  if (sequence_and_transaction &&
+      CanKeepSequenceLockRequired(sequence_and_transaction->transaction)) {
+    worker_only().kept_sequence =
+        std::move(sequence_and_transaction->sequence);
+    outer_->EnsureEnoughWorkersLockRequired(&workers_executor);
+    return;
+  }
+
   // Running task bookkeeping.
   DCHECK_GT(outer_->num_running_tasks_, 0U);
   --outer_->num_running_tasks_;
@@ -792,10 +832,67 @@ void SchedulerWorkerPoolImpl::SchedulerWorkerDelegateImpl::
   outer_->idle_workers_stack_cv_for_testing_->Broadcast();
 }
 
+bool SchedulerWorkerPoolImpl::SchedulerWorkerDelegateImpl::
+    CanKeepSequenceLockRequired(const Sequence::Transaction& transaction) {
+  DCHECK_CALLED_ON_VALID_THREAD(worker_thread_checker_);
+
+  if (!outer_->after_start().use_worker_local_sequence)
+    return false;
+
+  // The Sequence must be reenqueued in this pool.
+  if (outer_->delegate_->GetWorkerPoolForTraits(transaction.traits()) !=
+      outer_.get()) {
+    return false;
+  }
+
+  // The BEST_EFFORT bookkeeping of this worker must remain accurate and
+  // |max_best_effort_tasks_| must be respected (it may have been decremented
+  // while the task was running).
+  const SequenceSortKey sort_key = transaction.GetSortKey();
+  const bool is_best_effort = sort_key.priority() == TaskPriority::BEST_EFFORT;
+  if (is_best_effort != read_worker().is_running_best_effort_task)
+    return false;
+  if (is_best_effort && outer_->num_running_best_effort_tasks_ >
+                            outer_->max_best_effort_tasks_) {
+    return false;
+  }
+
+  // Excess workers should not get work (ref. CanGetWorkLockRequired()).
+  if (outer_->GetNumAwakeWorkersLockRequired() >
+      outer_->GetDesiredNumAwakeWorkersLockRequired()) {
+    return false;
+  }
+
+  // The Sequence must be at least as important as the Sequences that other
+  // workers could get from the PriorityQueue.
+  return outer_->priority_queue_.IsEmpty() ||
+         sort_key <= outer_->priority_queue_.PeekSortKey();
+}
+
 void SchedulerWorkerPoolImpl::SchedulerWorkerDelegateImpl::OnMainExit(
     SchedulerWorker* worker) {
   DCHECK_CALLED_ON_VALID_THREAD(worker_thread_checker_);
 
+  // The worker may be asked to exit (e.g. JoinForTesting()) while it keeps a
+  // Sequence. Undo its running task bookkeeping and give the Sequence back to
+  // the pool.
+  if (worker_only().kept_sequence) {
+    auto sequence_and_transaction = SequenceAndTransaction::FromSequence(
+        std::move(worker_only().kept_sequence));
+    AutoSchedulerLock auto_lock(outer_->lock_);
+    DCHECK_GT(outer_->num_running_tasks_, 0U);
+    --outer_->num_running_tasks_;
+    worker_only().is_running_task = false;
+    if (read_worker().is_running_best_effort_task) {
+      DCHECK_GT(outer_->num_running_best_effort_tasks_, 0U);
+      --outer_->num_running_best_effort_tasks_;
+      write_worker().is_running_best_effort_task = false;
+    }
+    outer_->priority_queue_.Push(
+        std::move(sequence_and_transaction.sequence),
+        sequence_and_transaction.transaction.GetSortKey());
+  }
+
 #if DCHECK_IS_ON()
   {
     bool shutdown_complete = outer_->task_tracker_->IsShutdownComplete();
@@ -1006,7 +1103,8 @@ SchedulerWorkerPoolImpl::CreateAndRegisterWorkerLockRequired(
       priority_hint_,
       std::make_unique<SchedulerWorkerDelegateImpl>(
           tracked_ref_factory_.GetTrackedRef()),
-      task_tracker_, &lock_, after_start().backward_compatibility);
+      task_tracker_, &lock_, after_start().backward_compatibility,
+      after_start().cpu_affinity);
 
   workers_.push_back(worker);
   executor->ScheduleStart(worker);
@@ -147,6 +147,8 @@ class BASE_EXPORT SchedulerWorkerPoolImpl : public SchedulerWorkerPool {
   void UpdateSortKey(SequenceAndTransaction sequence_and_transaction) override;
   void PushSequenceAndWakeUpWorkers(
       SequenceAndTransaction sequence_and_transaction) override;
+  void PushSequencesAndWakeUpWorkers(
+      std::vector<SequenceAndSortKey> sequences_and_sort_keys) override;
   void EnsureEnoughWorkersLockRequired(BaseScopedWorkersExecutor* executor)
       override EXCLUSIVE_LOCKS_REQUIRED(lock_);
 
@@ -228,6 +230,9 @@ class BASE_EXPORT SchedulerWorkerPoolImpl : public SchedulerWorkerPool {
 
     SchedulerBackwardCompatibility backward_compatibility;
 
+    // Cores the workers' threads may run on.
+    ThreadCpuAffinity cpu_affinity = ThreadCpuAffinity::ANY;
+
     // Environment to be initialized per worker.
     WorkerEnvironment worker_environment = WorkerEnvironment::NONE;
 
@@ -238,6 +243,10 @@ class BASE_EXPORT SchedulerWorkerPoolImpl : public SchedulerWorkerPool {
 
     bool may_block_without_delay;
 
+    // Whether workers can keep the Sequence from which they just ran a task
+    // instead of reenqueuing it in |priority_queue_| (kUseWorkerLocalSequence).
+    bool use_worker_local_sequence = false;
+
     // Threshold after which the max tasks is increased to compensate for a
     // worker that is within a MAY_BLOCK ScopedBlockingCall.
     TimeDelta may_block_threshold;
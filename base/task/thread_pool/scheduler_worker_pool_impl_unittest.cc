@@ -1791,6 +1791,45 @@ TEST_F(ThreadPoolWorkerPoolImplStartInBodyTest, RacyCleanup) {
   worker_pool_.reset();
 }
 
+// Verify that under kUseWorkerLocalSequence, a worker keeps running tasks from
+// a Sequence that is alone in the pool, and that the tasks run in order.
+TEST_F(ThreadPoolWorkerPoolImplStartInBodyTest, WorkerLocalSequence) {
+  base::test::ScopedFeatureList feature_list;
+  feature_list.InitAndEnableFeature(kUseWorkerLocalSequence);
+  StartWorkerPool(TimeDelta::Max(), kMaxTasks);
+
+  const scoped_refptr<SequencedTaskRunner> sequenced_task_runner =
+      test::CreateSequencedTaskRunnerWithTraits(
+          {}, &mock_scheduler_task_runner_delegate_);
+
+  constexpr size_t kNumTasks = 50;
+  std::vector<size_t> run_order;
+  PlatformThreadRef first_task_thread_ref;
+  bool all_tasks_ran_on_first_task_thread = true;
+  WaitableEvent tasks_posted;
+  sequenced_task_runner->PostTask(FROM_HERE, BindLambdaForTesting([&]() {
+                                    first_task_thread_ref =
+                                        PlatformThread::CurrentRef();
+                                    test::WaitWithoutBlockingObserver(
+                                        &tasks_posted);
+                                  }));
+  for (size_t i = 0; i < kNumTasks; ++i) {
+    sequenced_task_runner->PostTask(
+        FROM_HERE, BindLambdaForTesting([&, i]() {
+          run_order.push_back(i);
+          if (PlatformThread::CurrentRef() != first_task_thread_ref)
+            all_tasks_ran_on_first_task_thread = false;
+        }));
+  }
+  tasks_posted.Signal();
+  task_tracker_.FlushForTesting();
+
+  ASSERT_EQ(kNumTasks, run_order.size());
+  for (size_t i = 0; i < kNumTasks; ++i)
+    EXPECT_EQ(i, run_order[i]);
+  EXPECT_TRUE(all_tasks_ran_on_first_task_thread);
+}
+
 TEST_P(ThreadPoolWorkerPoolImplTestParam, ReportHeartbeatMetrics) {
   HistogramTester tester;
   worker_pool_->ReportHeartbeatMetrics();
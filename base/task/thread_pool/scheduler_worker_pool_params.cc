@@ -9,10 +9,12 @@ namespace base {
 SchedulerWorkerPoolParams::SchedulerWorkerPoolParams(
     int max_tasks,
     TimeDelta suggested_reclaim_time,
-    SchedulerBackwardCompatibility backward_compatibility)
+    SchedulerBackwardCompatibility backward_compatibility,
+    ThreadCpuAffinity cpu_affinity)
     : max_tasks_(max_tasks),
       suggested_reclaim_time_(suggested_reclaim_time),
-      backward_compatibility_(backward_compatibility) {}
+      backward_compatibility_(backward_compatibility),
+      cpu_affinity_(cpu_affinity) {}
 
 SchedulerWorkerPoolParams::SchedulerWorkerPoolParams(
     const SchedulerWorkerPoolParams& other) = default;
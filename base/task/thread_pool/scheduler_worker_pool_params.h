@@ -6,6 +6,7 @@
 #define BASE_TASK_THREAD_POOL_SCHEDULER_WORKER_POOL_PARAMS_H_
 
 #include "base/task/thread_pool/scheduler_worker_params.h"
+#include "base/threading/platform_thread.h"
 #include "base/time/time.h"
 
 namespace base {
@@ -17,12 +18,15 @@ class BASE_EXPORT SchedulerWorkerPoolParams final {
   // |suggested_reclaim_time| sets a suggestion on when to reclaim idle threads.
   // The pool is free to ignore this value for performance or correctness
   // reasons. |backward_compatibility| indicates whether backward compatibility
-  // is enabled.
+  // is enabled. |cpu_affinity| restricts the cores the pool's threads may run
+  // on; it is only honored on Linux and Android. Typically, a foreground pool
+  // uses PERFORMANCE_CORES and a background pool uses EFFICIENCY_CORES.
   SchedulerWorkerPoolParams(
       int max_tasks,
       TimeDelta suggested_reclaim_time,
       SchedulerBackwardCompatibility backward_compatibility =
-          SchedulerBackwardCompatibility::DISABLED);
+          SchedulerBackwardCompatibility::DISABLED,
+      ThreadCpuAffinity cpu_affinity = ThreadCpuAffinity::ANY);
 
   SchedulerWorkerPoolParams(const SchedulerWorkerPoolParams& other);
   SchedulerWorkerPoolParams& operator=(const SchedulerWorkerPoolParams& other);
@@ -32,11 +36,13 @@ class BASE_EXPORT SchedulerWorkerPoolParams final {
   SchedulerBackwardCompatibility backward_compatibility() const {
     return backward_compatibility_;
   }
+  ThreadCpuAffinity cpu_affinity() const { return cpu_affinity_; }
 
  private:
   int max_tasks_;
   TimeDelta suggested_reclaim_time_;
   SchedulerBackwardCompatibility backward_compatibility_;
+  ThreadCpuAffinity cpu_affinity_;
 };
 
 }  // namespace base
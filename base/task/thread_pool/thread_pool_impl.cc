@@ -38,6 +38,11 @@ constexpr EnvironmentParams kForegroundPoolEnvironmentParams{
 constexpr EnvironmentParams kBackgroundPoolEnvironmentParams{
     "Background", base::ThreadPriority::BACKGROUND};
 
+// Granularity of the DelayedTaskManager's timing wheel, when
+// kUseTimingWheelForDelayedTasks is enabled.
+constexpr TimeDelta kDelayedTaskTimingWheelGranularity =
+    TimeDelta::FromMilliseconds(1);
+
 }  // namespace
 
 ThreadPoolImpl::ThreadPoolImpl(StringPiece histogram_label)
@@ -128,6 +133,9 @@ void ThreadPoolImpl::Start(const ThreadPool::InitParams& init_params,
   // Needs to happen after starting the service thread to get its task_runner().
   scoped_refptr<TaskRunner> service_thread_task_runner =
       service_thread_->task_runner();
+  if (FeatureList::IsEnabled(kUseTimingWheelForDelayedTasks)) {
+    delayed_task_manager_.UseTimingWheel(kDelayedTaskTimingWheelGranularity);
+  }
   delayed_task_manager_.Start(service_thread_task_runner);
 
   single_thread_task_runner_manager_.Start(scheduler_worker_observer);
@@ -184,6 +192,47 @@ bool ThreadPoolImpl::PostDelayedTaskWithTraits(const Location& from_here,
                                TaskSourceExecutionMode::kParallel));
 }
 
+bool ThreadPoolImpl::PostTasksWithTraits(const Location& from_here,
+                                         const TaskTraits& traits,
+                                         std::vector<OnceClosure> tasks) {
+  // Post each task as part of a one-off single-task Sequence, like
+  // PostDelayedTaskWithTraits(). The Sequences are only pushed in the worker
+  // pool once they are all ready, so that the pool's lock is acquired and
+  // workers are woken up once for the whole batch.
+  const TaskTraits new_traits = SetUserBlockingPriorityIfNeeded(traits);
+  SchedulerWorkerPool* const worker_pool = GetWorkerPoolForTraits(new_traits);
+
+  std::vector<SchedulerWorkerPool::SequenceAndSortKey> sequences_and_sort_keys;
+  sequences_and_sort_keys.reserve(tasks.size());
+  bool all_tasks_posted = true;
+  for (OnceClosure& closure : tasks) {
+    Task task(from_here, std::move(closure), TimeDelta());
+    // Use CHECK instead of DCHECK to crash earlier. See http://crbug.com/711167
+    // for details.
+    CHECK(task.task);
+    auto sequence = MakeRefCounted<Sequence>(
+        new_traits, nullptr, TaskSourceExecutionMode::kParallel);
+    if (!task_tracker_->WillPostTask(&task, sequence->shutdown_behavior())) {
+      all_tasks_posted = false;
+      continue;
+    }
+
+    Sequence::Transaction transaction(sequence->BeginTransaction());
+    const bool sequence_should_be_queued = transaction.PushTask(std::move(task));
+    DCHECK(sequence_should_be_queued);
+    // If the Sequence can't be scheduled yet, |worker_pool| is notified via
+    // OnCanScheduleSequence() when it can.
+    if (!task_tracker_->WillScheduleSequence(transaction, worker_pool))
+      continue;
+    sequences_and_sort_keys.push_back(
+        {std::move(sequence), transaction.GetSortKey()});
+  }
+
+  worker_pool->PushSequencesAndWakeUpWorkers(
+      std::move(sequences_and_sort_keys));
+  return all_tasks_posted;
+}
+
 scoped_refptr<TaskRunner> ThreadPoolImpl::CreateTaskRunnerWithTraits(
     const TaskTraits& traits) {
   const TaskTraits new_traits = SetUserBlockingPriorityIfNeeded(traits);
@@ -85,6 +85,9 @@ class BASE_EXPORT ThreadPoolImpl : public ThreadPool,
                                  const TaskTraits& traits,
                                  OnceClosure task,
                                  TimeDelta delay) override;
+  bool PostTasksWithTraits(const Location& from_here,
+                           const TaskTraits& traits,
+                           std::vector<OnceClosure> tasks) override;
   scoped_refptr<TaskRunner> CreateTaskRunnerWithTraits(
       const TaskTraits& traits) override;
   scoped_refptr<SequencedTaskRunner> CreateSequencedTaskRunnerWithTraits(
@@ -11,6 +11,7 @@
 #include <utility>
 #include <vector>
 
+#include "base/barrier_closure.h"
 #include "base/bind.h"
 #include "base/bind_helpers.h"
 #include "base/callback.h"
@@ -366,6 +367,30 @@ TEST_P(ThreadPoolImplTest, PostTasksViaTaskRunner) {
   factory.WaitForAllTasksToRun();
 }
 
+// Verifies that Tasks posted as a batch via PostTasksWithTraits all run on a
+// thread with the expected priority and I/O restrictions.
+TEST_P(ThreadPoolImplTest, PostTasksWithTraits) {
+  StartThreadPool();
+
+  constexpr size_t kNumTasks = 150;
+  WaitableEvent all_tasks_ran;
+  RepeatingClosure all_tasks_ran_barrier = BarrierClosure(
+      kNumTasks, BindOnce(&WaitableEvent::Signal, Unretained(&all_tasks_ran)));
+  std::vector<OnceClosure> tasks;
+  for (size_t i = 0; i < kNumTasks; ++i) {
+    tasks.push_back(BindOnce(
+        [](const TaskTraits& traits, test::PoolType pool_type,
+           RepeatingClosure barrier) {
+          VerifyTaskEnvironment(traits, pool_type);
+          barrier.Run();
+        },
+        GetParam().traits, GetParam().pool_type, all_tasks_ran_barrier));
+  }
+  EXPECT_TRUE(thread_pool_.PostTasksWithTraits(FROM_HERE, GetParam().traits,
+                                               std::move(tasks)));
+  all_tasks_ran.Wait();
+}
+
 // Verifies that a task posted via PostDelayedTaskWithTraits without a delay
 // doesn't run before Start() is called.
 TEST_P(ThreadPoolImplTest, PostDelayedTaskWithTraitsNoDelayBeforeStart) {
@@ -3,6 +3,7 @@
 // found in the LICENSE file.
 
 #include <stddef.h>
+#include <algorithm>
 #include <atomic>
 #include <memory>
 #include <vector>
@@ -14,7 +15,11 @@
 #include "base/optional.h"
 #include "base/synchronization/waitable_event.h"
 #include "base/task/post_task.h"
+#include "base/task/task_features.h"
+#include "base/task/thread_pool/delayed_task_manager.h"
+#include "base/task/thread_pool/task.h"
 #include "base/task/thread_pool/thread_pool.h"
+#include "base/test/scoped_feature_list.h"
 #include "base/threading/simple_thread.h"
 #include "base/time/time.h"
 #include "testing/gtest/include/gtest/gtest.h"
@@ -94,6 +99,35 @@ class ThreadPoolPerfTest : public testing::Test {
     }
   }
 
+  void ContinuouslyPostNoOpTasksToSequence(size_t num_tasks) {
+    scoped_refptr<SequencedTaskRunner> task_runner =
+        CreateSequencedTaskRunnerWithTraits({});
+    base::RepeatingClosure closure = base::BindRepeating(
+        [](std::atomic_size_t* num_task_pending) { (*num_task_pending)--; },
+        &num_tasks_pending_);
+    for (size_t i = 0; i < num_tasks; ++i) {
+      ++num_tasks_pending_;
+      ++num_posted_tasks_;
+      task_runner->PostTask(FROM_HERE, closure);
+    }
+  }
+
+  void ContinuouslyPostNoOpTasksInBatches(size_t num_tasks,
+                                          size_t batch_size) {
+    base::RepeatingClosure closure = base::BindRepeating(
+        [](std::atomic_size_t* num_task_pending) { (*num_task_pending)--; },
+        &num_tasks_pending_);
+    for (size_t i = 0; i < num_tasks; i += batch_size) {
+      std::vector<OnceClosure> tasks;
+      for (size_t j = i; j < std::min(num_tasks, i + batch_size); ++j) {
+        ++num_tasks_pending_;
+        ++num_posted_tasks_;
+        tasks.push_back(closure);
+      }
+      PostTasksWithTraits(FROM_HERE, {}, std::move(tasks));
+    }
+  }
+
   void ContinuouslyPostBusyWaitTasks(size_t num_tasks,
                                      base::TimeDelta duration) {
     scoped_refptr<TaskRunner> task_runner = CreateTaskRunnerWithTraits({});
@@ -194,6 +228,30 @@ class ThreadPoolPerfTest : public testing::Test {
   DISALLOW_COPY_AND_ASSIGN(ThreadPoolPerfTest);
 };
 
+// Measures the cost of adding delayed tasks which don't become ripe during the
+// test, like timeouts which are cancelled before they expire.
+void BenchmarkAddDelayedTasks(const std::string& trace,
+                              bool use_timing_wheel) {
+  constexpr size_t kNumTasks = 1000000;
+  DelayedTaskManager delayed_task_manager;
+  if (use_timing_wheel)
+    delayed_task_manager.UseTimingWheel(TimeDelta::FromMilliseconds(1));
+
+  const TimeTicks start = TimeTicks::Now();
+  for (size_t i = 0; i < kNumTasks; ++i) {
+    // Spread the delays over 30 seconds.
+    const TimeDelta delay =
+        TimeDelta::FromMicroseconds(1 + (i * 7919) % 30000000);
+    delayed_task_manager.AddDelayedTask(Task(FROM_HERE, DoNothing(), delay),
+                                        DoNothing(), nullptr);
+  }
+  const TimeDelta duration = TimeTicks::Now() - start;
+
+  perf_test::PrintResult("Adding delayed tasks throughput", "", trace,
+                         kNumTasks / duration.InMillisecondsF(), "tasks/ms",
+                         true);
+}
+
 }  // namespace
 
 TEST_F(ThreadPoolPerfTest, BindPostThenRunNoOpTasks) {
@@ -227,6 +285,15 @@ TEST_F(ThreadPoolPerfTest, PostThenRunNoOpTasksMorePostingThanRunningThreads) {
             ExecutionMode::kPostThenRun);
 }
 
+TEST_F(ThreadPoolPerfTest, PostThenRunNoOpTasksInBatchesManyThreads) {
+  StartThreadPool(
+      4, 4,
+      BindRepeating(&ThreadPoolPerfTest::ContinuouslyPostNoOpTasksInBatches,
+                    Unretained(this), 10000, 100));
+  Benchmark("Post-then-run no-op tasks in batches many threads",
+            ExecutionMode::kPostThenRun);
+}
+
 TEST_F(ThreadPoolPerfTest, PostRunNoOpTasks) {
   StartThreadPool(1, 1,
                   BindRepeating(&ThreadPoolPerfTest::ContinuouslyPostNoOpTasks,
@@ -250,5 +317,35 @@ TEST_F(ThreadPoolPerfTest, PostRunBusyTasksManyThreads) {
   Benchmark("Post/run busy tasks many threads", ExecutionMode::kPostAndRun);
 }
 
+TEST_F(ThreadPoolPerfTest, PostThenRunNoOpSequencedTasksManyThreads) {
+  StartThreadPool(
+      4, 4,
+      BindRepeating(&ThreadPoolPerfTest::ContinuouslyPostNoOpTasksToSequence,
+                    Unretained(this), 10000));
+  Benchmark("Post-then-run no-op sequenced tasks many threads",
+            ExecutionMode::kPostThenRun);
+}
+
+TEST_F(ThreadPoolPerfTest,
+       PostThenRunNoOpSequencedTasksManyThreadsWorkerLocalSequence) {
+  base::test::ScopedFeatureList feature_list;
+  feature_list.InitAndEnableFeature(kUseWorkerLocalSequence);
+  StartThreadPool(
+      4, 4,
+      BindRepeating(&ThreadPoolPerfTest::ContinuouslyPostNoOpTasksToSequence,
+                    Unretained(this), 10000));
+  Benchmark("Post-then-run no-op sequenced tasks many threads worker local "
+            "sequence",
+            ExecutionMode::kPostThenRun);
+}
+
+TEST(ThreadPoolDelayedTaskManagerPerfTest, AddDelayedTasks) {
+  BenchmarkAddDelayedTasks("Add delayed tasks", false);
+}
+
+TEST(ThreadPoolDelayedTaskManagerPerfTest, AddDelayedTasksTimingWheel) {
+  BenchmarkAddDelayedTasks("Add delayed tasks timing wheel", true);
+}
+
 }  // namespace internal
 }  // namespace base
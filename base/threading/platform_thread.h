@@ -116,6 +116,18 @@ enum class ThreadPriority : int {
   REALTIME_AUDIO,
 };
 
+// Valid values for PlatformThread::SetCurrentThreadCpuAffinity().
+enum class ThreadCpuAffinity : int {
+  // The thread may run on any core.
+  ANY,
+  // The thread is restricted to the big cores of a heterogeneous (big.LITTLE)
+  // system. On a homogeneous system with more than one NUMA node, the thread is
+  // restricted to the cores of the first node instead.
+  PERFORMANCE_CORES,
+  // The thread is restricted to the little cores of a heterogeneous system.
+  EFFICIENCY_CORES,
+};
+
 // A namespace for low-level thread functions.
 class BASE_EXPORT PlatformThread {
  public:
@@ -234,6 +246,15 @@ class BASE_EXPORT PlatformThread {
                                 ThreadPriority priority);
 #endif
 
+#if defined(OS_LINUX) || defined(OS_ANDROID)
+  // Restricts the cores the current thread may run on to |affinity|. The core
+  // topology is read from sysfs once per process. Returns false if the system
+  // has no cores matching |affinity| (e.g. EFFICIENCY_CORES on a homogeneous
+  // system) or if the affinity couldn't be changed, in which case the thread's
+  // affinity is left untouched.
+  static bool SetCurrentThreadCpuAffinity(ThreadCpuAffinity affinity);
+#endif
+
   // Returns the default thread stack size set by chrome. If we do not
   // explicitly set default size then returns 0.
   static size_t GetDefaultThreadStackSize();
@@ -32,6 +32,19 @@
 #include <sys/syscall.h>
 #endif
 
+#if defined(OS_LINUX) || defined(OS_ANDROID)
+#include <algorithm>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "base/files/file_path.h"
+#include "base/files/file_util.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/strings/string_split.h"
+#include "base/strings/string_util.h"
+#endif
+
 #if defined(OS_FUCHSIA)
 #include <zircon/process.h>
 #else
@@ -155,6 +168,107 @@ class InitAtFork {
 
 #endif  // defined(OS_LINUX)
 
+#if defined(OS_LINUX) || defined(OS_ANDROID)
+
+// Cores of the system, grouped by ThreadCpuAffinity.
+struct CpuTopology {
+  std::vector<int> all_cores;
+  std::vector<int> performance_cores;
+  std::vector<int> efficiency_cores;
+};
+
+// Parses a sysfs cpu list, e.g. "0-3,8,10-11". Returns an empty vector if
+// |cpu_list| is malformed.
+std::vector<int> ParseCpuList(StringPiece cpu_list) {
+  std::vector<int> cpus;
+  for (StringPiece range : SplitStringPiece(cpu_list, ",", TRIM_WHITESPACE,
+                                            SPLIT_WANT_NONEMPTY)) {
+    std::vector<StringPiece> bounds =
+        SplitStringPiece(range, "-", TRIM_WHITESPACE, SPLIT_WANT_NONEMPTY);
+    int first = 0;
+    int last = 0;
+    if (bounds.empty() || bounds.size() > 2 ||
+        !StringToInt(bounds.front(), &first) ||
+        !StringToInt(bounds.back(), &last) || first < 0 || last < first ||
+        last >= CPU_SETSIZE) {
+      return std::vector<int>();
+    }
+    for (int cpu = first; cpu <= last; ++cpu)
+      cpus.push_back(cpu);
+  }
+  return cpus;
+}
+
+std::vector<int> ReadCpuList(const FilePath& path) {
+  std::string cpu_list;
+  if (!ReadFileToString(path, &cpu_list))
+    return std::vector<int>();
+  return ParseCpuList(cpu_list);
+}
+
+CpuTopology ComputeCpuTopology() {
+  const FilePath cpu_directory("/sys/devices/system/cpu");
+  CpuTopology topology;
+  topology.all_cores = ReadCpuList(cpu_directory.Append("online"));
+  if (topology.all_cores.empty())
+    return topology;
+
+  // On heterogeneous systems, the little cores are those with the lowest
+  // maximum frequency. Every other core is considered a performance core.
+  std::vector<std::pair<int, int64_t>> max_frequencies;
+  for (int cpu : topology.all_cores) {
+    std::string max_frequency_string;
+    int64_t max_frequency = 0;
+    if (!ReadFileToString(cpu_directory.Append("cpu" + NumberToString(cpu))
+                              .Append("cpufreq")
+                              .Append("cpuinfo_max_freq"),
+                          &max_frequency_string) ||
+        !StringToInt64(
+            TrimWhitespaceASCII(max_frequency_string, TRIM_ALL),
+            &max_frequency)) {
+      max_frequencies.clear();
+      break;
+    }
+    max_frequencies.emplace_back(cpu, max_frequency);
+  }
+  if (!max_frequencies.empty()) {
+    const auto minmax = std::minmax_element(
+        max_frequencies.begin(), max_frequencies.end(),
+        [](const std::pair<int, int64_t>& a, const std::pair<int, int64_t>& b) {
+          return a.second < b.second;
+        });
+    const int64_t lowest_max_frequency = minmax.first->second;
+    if (lowest_max_frequency != minmax.second->second) {
+      for (const auto& cpu_and_frequency : max_frequencies) {
+        if (cpu_and_frequency.second == lowest_max_frequency)
+          topology.efficiency_cores.push_back(cpu_and_frequency.first);
+        else
+          topology.performance_cores.push_back(cpu_and_frequency.first);
+      }
+      return topology;
+    }
+  }
+
+  // On homogeneous systems with more than one NUMA node, keep performance
+  // threads on the first node so that they share a last-level cache and local
+  // memory.
+  const FilePath node_directory("/sys/devices/system/node");
+  std::vector<int> nodes = ReadCpuList(node_directory.Append("online"));
+  if (nodes.size() > 1) {
+    topology.performance_cores = ReadCpuList(
+        node_directory.Append("node" + NumberToString(nodes.front()))
+            .Append("cpulist"));
+  }
+  return topology;
+}
+
+const CpuTopology& GetCpuTopology() {
+  static const NoDestructor<CpuTopology> topology(ComputeCpuTopology());
+  return *topology;
+}
+
+#endif  // defined(OS_LINUX) || defined(OS_ANDROID)
+
 }  // namespace
 
 #if defined(OS_LINUX)
@@ -351,6 +465,38 @@ ThreadPriority PlatformThread::GetCurrentThreadPriority() {
 
 #endif  // !defined(OS_MACOSX) && !defined(OS_FUCHSIA)
 
+#if defined(OS_LINUX) || defined(OS_ANDROID)
+// static
+bool PlatformThread::SetCurrentThreadCpuAffinity(ThreadCpuAffinity affinity) {
+  const CpuTopology& topology = GetCpuTopology();
+  const std::vector<int>* cores = nullptr;
+  switch (affinity) {
+    case ThreadCpuAffinity::ANY:
+      cores = &topology.all_cores;
+      break;
+    case ThreadCpuAffinity::PERFORMANCE_CORES:
+      cores = &topology.performance_cores;
+      break;
+    case ThreadCpuAffinity::EFFICIENCY_CORES:
+      cores = &topology.efficiency_cores;
+      break;
+  }
+  if (!cores || cores->empty())
+    return false;
+
+  cpu_set_t cpu_set;
+  CPU_ZERO(&cpu_set);
+  for (int core : *cores)
+    CPU_SET(core, &cpu_set);
+  // A pid of 0 designates the calling thread.
+  if (sched_setaffinity(0, sizeof(cpu_set), &cpu_set) != 0) {
+    DVPLOG(1) << "Failed to set the CPU affinity of the current thread";
+    return false;
+  }
+  return true;
+}
+#endif  // defined(OS_LINUX) || defined(OS_ANDROID)
+
 // static
 size_t PlatformThread::GetDefaultThreadStackSize() {
   pthread_attr_t attributes;
@@ -19,6 +19,10 @@
 #include "base/threading/platform_thread_win.h"
 #endif
 
+#if defined(OS_LINUX) || defined(OS_ANDROID)
+#include <sched.h>
+#endif
+
 namespace base {
 
 // Trivial tests that thread runs and doesn't crash on create, join, or detach -
@@ -404,6 +408,65 @@ TEST(PlatformThreadTest, GetNiceValueToThreadPriority) {
 #endif  // defined(OS_POSIX) && !defined(OS_MACOSX) && !defined(OS_IOS) &&
         // !defined(OS_FUCHSIA)
 
+#if defined(OS_LINUX) || defined(OS_ANDROID)
+
+namespace {
+
+// Applies a ThreadCpuAffinity on its own thread so that the affinity of the
+// test's main thread isn't affected.
+class CpuAffinityThread : public PlatformThread::Delegate {
+ public:
+  explicit CpuAffinityThread(ThreadCpuAffinity affinity)
+      : affinity_(affinity) {}
+
+  void ThreadMain() override {
+    applied_ = PlatformThread::SetCurrentThreadCpuAffinity(affinity_);
+    cpu_set_t cpu_set;
+    CPU_ZERO(&cpu_set);
+    if (sched_getaffinity(0, sizeof(cpu_set), &cpu_set) == 0)
+      num_allowed_cores_ = CPU_COUNT(&cpu_set);
+  }
+
+  bool applied() const { return applied_; }
+  int num_allowed_cores() const { return num_allowed_cores_; }
+
+ private:
+  const ThreadCpuAffinity affinity_;
+  bool applied_ = false;
+  int num_allowed_cores_ = 0;
+
+  DISALLOW_COPY_AND_ASSIGN(CpuAffinityThread);
+};
+
+int GetNumAllowedCoresForAffinity(ThreadCpuAffinity affinity) {
+  CpuAffinityThread thread(affinity);
+  PlatformThreadHandle handle;
+  EXPECT_TRUE(PlatformThread::Create(0, &thread, &handle));
+  PlatformThread::Join(handle);
+  return thread.applied() ? thread.num_allowed_cores() : 0;
+}
+
+}  // namespace
+
+// The core topology depends on the machine running the test, so only verify
+// that restricted affinities never allow more cores than ANY.
+TEST(PlatformThreadTest, SetCurrentThreadCpuAffinity) {
+  const int num_any_cores =
+      GetNumAllowedCoresForAffinity(ThreadCpuAffinity::ANY);
+  if (num_any_cores == 0)
+    return;
+
+  const int num_performance_cores =
+      GetNumAllowedCoresForAffinity(ThreadCpuAffinity::PERFORMANCE_CORES);
+  const int num_efficiency_cores =
+      GetNumAllowedCoresForAffinity(ThreadCpuAffinity::EFFICIENCY_CORES);
+  EXPECT_LE(num_performance_cores, num_any_cores);
+  EXPECT_LE(num_efficiency_cores, num_any_cores);
+  EXPECT_LE(num_performance_cores + num_efficiency_cores, num_any_cores);
+}
+
+#endif  // defined(OS_LINUX) || defined(OS_ANDROID)
+
 TEST(PlatformThreadTest, SetHugeThreadName) {
   // Construct an excessively long thread name.
   std::string long_name(1024, 'a');
@@ -116,6 +116,7 @@ class VideoFrameResourceProvider;
 namespace cc {
 class CompletionEvent;
 class SingleThreadTaskGraphRunner;
+class WorkStealingTaskGraphRunner;
 }
 namespace chromeos {
 class BlockingMethodCaller;
@@ -469,6 +470,7 @@ class BASE_EXPORT ScopedAllowBaseSyncPrimitivesOutsideBlockingScope {
   friend class base::Thread;                      // http://crbug.com/918039
   friend class cc::CompletionEvent;               // http://crbug.com/902653
   friend class cc::SingleThreadTaskGraphRunner;   // http://crbug.com/902823
+  friend class cc::WorkStealingTaskGraphRunner;   // http://crbug.com/902823
   friend class content::
       BrowserGpuChannelHostFactory;                 // http://crbug.com/125248
   friend class content::CategorizedWorkerPool;      // http://crbug.com/902823
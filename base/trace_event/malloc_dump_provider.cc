@@ -24,6 +24,11 @@
 #include <windows.h>
 #endif
 
+#if BUILDFLAG(USE_PARTITION_ALLOC_AS_MALLOC)
+#include "base/allocator/allocator_shim_default_dispatch_to_partition_alloc.h"
+#include "base/allocator/partition_allocator/partition_alloc.h"
+#endif
+
 namespace base {
 namespace trace_event {
 
@@ -59,6 +64,26 @@ void WinHeapMemoryDumpImpl(WinHeapInfo* crt_heap_info) {
   CHECK(::HeapUnlock(crt_heap) == TRUE);
 }
 #endif  // defined(OS_WIN)
+
+#if BUILDFLAG(USE_PARTITION_ALLOC_AS_MALLOC)
+// Keeps the totals of the partition backing malloc().
+class MallocPartitionStatsDumper : public PartitionStatsDumper {
+ public:
+  void PartitionDumpTotals(const char* partition_name,
+                           const PartitionMemoryStats* stats) override {
+    stats_ = *stats;
+  }
+
+  void PartitionsDumpBucketStats(
+      const char* partition_name,
+      const PartitionBucketMemoryStats* bucket_stats) override {}
+
+  const PartitionMemoryStats& stats() const { return stats_; }
+
+ private:
+  PartitionMemoryStats stats_ = {};
+};
+#endif  // BUILDFLAG(USE_PARTITION_ALLOC_AS_MALLOC)
 }  // namespace
 
 // static
@@ -97,6 +122,16 @@ bool MallocDumpProvider::OnMemoryDump(const MemoryDumpArgs& args,
   res = allocator::GetNumericProperty("generic.current_allocated_bytes",
                                       &allocated_objects_size);
   DCHECK(res);
+#elif BUILDFLAG(USE_PARTITION_ALLOC_AS_MALLOC)
+  // Only the totals are needed, which a light dump provides without
+  // allocating.
+  MallocPartitionStatsDumper partition_stats_dumper;
+  internal::PartitionAllocMalloc::Allocator()->DumpStats(
+      "malloc", true /* is_light_dump */, &partition_stats_dumper);
+  const PartitionMemoryStats& partition_stats = partition_stats_dumper.stats();
+  total_virtual_size = partition_stats.total_mmapped_bytes;
+  resident_size = partition_stats.total_committed_bytes;
+  allocated_objects_size = partition_stats.total_active_bytes;
 #elif defined(OS_MACOSX) || defined(OS_IOS)
   malloc_statistics_t stats = {0};
   malloc_zone_statistics(nullptr, &stats);
@@ -17,8 +17,11 @@
 #include "base/debug/alias.h"
 #include "base/debug/stack_trace.h"
 #include "base/memory/ptr_util.h"
+#include "base/pickle.h"
 #include "base/sequenced_task_runner.h"
+#include "base/stl_util.h"
 #include "base/strings/string_util.h"
+#include "base/task/post_task.h"
 #include "base/third_party/dynamic_annotations/dynamic_annotations.h"
 #include "base/threading/thread.h"
 #include "base/threading/thread_task_runner_handle.h"
@@ -61,6 +64,24 @@ void DoGlobalDumpWithoutCallback(
   global_dump_fn.Run(dump_type, level_of_detail);
 }
 
+// Returns a string that identifies the contents of |mad|, to tell whether it
+// changed between incremental dumps.
+std::string GetFingerprint(const MemoryAllocatorDump& mad) {
+  Pickle pickle;
+  pickle.WriteUInt64(mad.guid().ToUint64());
+  pickle.WriteInt(mad.flags());
+  for (const MemoryAllocatorDump::Entry& entry : mad.entries()) {
+    pickle.WriteString(entry.name);
+    pickle.WriteString(entry.units);
+    pickle.WriteInt(entry.entry_type);
+    if (entry.entry_type == MemoryAllocatorDump::Entry::kUint64)
+      pickle.WriteUInt64(entry.value_uint64);
+    else
+      pickle.WriteString(entry.value_string);
+  }
+  return std::string(static_cast<const char*>(pickle.data()), pickle.size());
+}
+
 }  // namespace
 
 // static
@@ -179,6 +200,10 @@ void MemoryDumpManager::RegisterDumpProviderInternal(
   if (dumper_registrations_ignored_for_testing_)
     return;
 
+  DCHECK(!options.supports_concurrent_dumps || !task_runner)
+      << "MemoryDumpProvider \"" << name << "\" supports concurrent dumps "
+      << "but has a task runner affinity.";
+
   // Only a handful of MDPs are required to compute the memory metrics. These
   // have small enough performance overhead that it is resonable to run them
   // in the background while the user is doing other things. Those MDPs are
@@ -310,6 +335,8 @@ void MemoryDumpManager::CreateProcessDump(
         args, dump_providers_, callback, GetOrCreateBgTaskRunnerLocked()));
   }
 
+  StartConcurrentDumps(pmd_async_state.get());
+
   // Start the process dump. This involves task runner hops as specified by the
   // MemoryDumpProvider(s) in RegisterDumpProvider()).
   ContinueAsyncProcessDump(pmd_async_state.release());
@@ -398,6 +425,42 @@ void MemoryDumpManager::ContinueAsyncProcessDump(
   FinishAsyncProcessDump(std::move(pmd_async_state));
 }
 
+void MemoryDumpManager::StartConcurrentDumps(
+    ProcessMemoryDumpAsyncState* pmd_async_state) {
+  std::vector<scoped_refptr<MemoryDumpProviderInfo>> concurrent_providers;
+  std::vector<scoped_refptr<MemoryDumpProviderInfo>> sequential_providers;
+  for (auto& mdpinfo : pmd_async_state->pending_dump_providers) {
+    if (mdpinfo->options.supports_concurrent_dumps)
+      concurrent_providers.push_back(std::move(mdpinfo));
+    else
+      sequential_providers.push_back(std::move(mdpinfo));
+  }
+  pmd_async_state->pending_dump_providers = std::move(sequential_providers);
+
+  // As in ContinueAsyncProcessDump(), only the whitelisted providers are
+  // invoked for background dumps.
+  if (pmd_async_state->req_args.level_of_detail ==
+      MemoryDumpLevelOfDetail::BACKGROUND) {
+    base::EraseIf(concurrent_providers, [](const auto& mdpinfo) {
+      return !mdpinfo->whitelisted_for_background_mode;
+    });
+  }
+  if (concurrent_providers.empty())
+    return;
+
+  pmd_async_state->concurrent_dumps =
+      MakeRefCounted<ConcurrentDumpState>(concurrent_providers.size());
+  const MemoryDumpArgs& args =
+      pmd_async_state->process_memory_dump->dump_args();
+  for (auto& mdpinfo : concurrent_providers) {
+    base::PostTaskWithTraits(
+        FROM_HERE, {TaskPriority::USER_VISIBLE},
+        BindOnce(&MemoryDumpManager::InvokeOnMemoryDumpConcurrently,
+                 Unretained(this), std::move(mdpinfo), args,
+                 pmd_async_state->concurrent_dumps));
+  }
+}
+
 // This function is called on the right task runner for current MDP. It is
 // either the task runner specified by MDP or |dump_thread_task_runner| if the
 // MDP did not specify task runner. Invokes the dump provider's OnMemoryDump()
@@ -452,10 +515,36 @@ void MemoryDumpManager::InvokeOnMemoryDump(MemoryDumpProviderInfo* mdpinfo,
         !*(static_cast<volatile bool*>(&mdpinfo->disabled)));
   bool dump_successful =
       mdpinfo->dump_provider->OnMemoryDump(pmd->dump_args(), pmd);
+
+  // A locked access is required since providers that support concurrent dumps
+  // can be invoked by several dumps at once.
+  AutoLock lock(lock_);
   mdpinfo->consecutive_failures =
       dump_successful ? 0 : mdpinfo->consecutive_failures + 1;
 }
 
+void MemoryDumpManager::InvokeOnMemoryDumpConcurrently(
+    scoped_refptr<MemoryDumpProviderInfo> mdpinfo,
+    MemoryDumpArgs args,
+    scoped_refptr<ConcurrentDumpState> concurrent_dumps) {
+  HEAP_PROFILER_SCOPED_IGNORE;
+  // See ContinueAsyncProcessDump().
+  TraceLog::GetInstance()->InitializeThreadLocalEventBufferIfSupported();
+
+  auto pmd = std::make_unique<ProcessMemoryDump>(args);
+  InvokeOnMemoryDump(mdpinfo.get(), pmd.get());
+
+  OnceClosure on_done;
+  {
+    AutoLock lock(concurrent_dumps->lock);
+    concurrent_dumps->dumps.push_back(std::move(pmd));
+    if (--concurrent_dumps->pending_count == 0)
+      on_done = std::move(concurrent_dumps->on_done);
+  }
+  if (on_done)
+    std::move(on_done).Run();
+}
+
 void MemoryDumpManager::FinishAsyncProcessDump(
     std::unique_ptr<ProcessMemoryDumpAsyncState> pmd_async_state) {
   HEAP_PROFILER_SCOPED_IGNORE;
@@ -470,8 +559,27 @@ void MemoryDumpManager::FinishAsyncProcessDump(
     return;
   }
 
+  if (pmd_async_state->concurrent_dumps) {
+    scoped_refptr<ConcurrentDumpState> concurrent_dumps =
+        pmd_async_state->concurrent_dumps;
+    AutoLock lock(concurrent_dumps->lock);
+    if (concurrent_dumps->pending_count) {
+      // The last concurrent provider to finish will call back into here.
+      concurrent_dumps->on_done =
+          BindOnce(&MemoryDumpManager::FinishAsyncProcessDump,
+                   Unretained(this), std::move(pmd_async_state));
+      return;
+    }
+    for (auto& pmd : concurrent_dumps->dumps)
+      pmd_async_state->process_memory_dump->TakeAllDumpsFrom(pmd.get());
+    concurrent_dumps->dumps.clear();
+  }
+
   TRACE_EVENT0(kTraceCategory, "MemoryDumpManager::FinishAsyncProcessDump");
 
+  if (pmd_async_state->req_args.incremental)
+    RemoveUnchangedAllocatorDumps(pmd_async_state->process_memory_dump.get());
+
   if (!pmd_async_state->callback.is_null()) {
     pmd_async_state->callback.Run(
         true /* success */, dump_guid,
@@ -483,6 +591,31 @@ void MemoryDumpManager::FinishAsyncProcessDump(
                                   TRACE_ID_LOCAL(dump_guid));
 }
 
+void MemoryDumpManager::RemoveUnchangedAllocatorDumps(ProcessMemoryDump* pmd) {
+  std::map<std::string, std::string> fingerprints;
+  for (const auto& it : pmd->allocator_dumps())
+    fingerprints.emplace(it.first, GetFingerprint(*it.second));
+
+  std::map<std::string, std::string> previous_fingerprints;
+  {
+    AutoLock lock(lock_);
+    std::swap(previous_fingerprints,
+              incremental_dump_fingerprints_[pmd->dump_args().level_of_detail]);
+  }
+
+  for (const auto& it : fingerprints) {
+    auto previous = previous_fingerprints.find(it.first);
+    if (previous != previous_fingerprints.end() &&
+        previous->second == it.second) {
+      pmd->RemoveUnchangedAllocatorDump(it.first);
+    }
+  }
+
+  AutoLock lock(lock_);
+  incremental_dump_fingerprints_[pmd->dump_args().level_of_detail] =
+      std::move(fingerprints);
+}
+
 void MemoryDumpManager::SetupForTracing(
     const TraceConfig::MemoryDumpConfig& memory_dump_config) {
   AutoLock lock(lock_);
@@ -519,6 +652,12 @@ void MemoryDumpManager::TeardownForTracing() {
   MemoryDumpScheduler::GetInstance()->Stop();
 }
 
+MemoryDumpManager::ConcurrentDumpState::ConcurrentDumpState(
+    size_t pending_count)
+    : pending_count(pending_count) {}
+
+MemoryDumpManager::ConcurrentDumpState::~ConcurrentDumpState() = default;
+
 MemoryDumpManager::ProcessMemoryDumpAsyncState::ProcessMemoryDumpAsyncState(
     MemoryDumpRequestArgs req_args,
     const MemoryDumpProviderInfo::OrderedSet& dump_providers,
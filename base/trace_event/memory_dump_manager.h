@@ -9,10 +9,12 @@
 
 #include <map>
 #include <memory>
+#include <string>
 #include <unordered_set>
 #include <vector>
 
 #include "base/atomicops.h"
+#include "base/callback.h"
 #include "base/macros.h"
 #include "base/memory/ref_counted.h"
 #include "base/memory/singleton.h"
@@ -150,6 +152,34 @@ class BASE_EXPORT MemoryDumpManager {
   FRIEND_TEST_ALL_PREFIXES(MemoryDumpManagerTest,
                            NoStackOverflowWithTooManyMDPs);
 
+  // Collects the dumps of the providers that support concurrent dumps, which
+  // are invoked in parallel on the thread pool while the other providers are
+  // invoked one by one by ContinueAsyncProcessDump().
+  struct ConcurrentDumpState
+      : public RefCountedThreadSafe<ConcurrentDumpState> {
+    explicit ConcurrentDumpState(size_t pending_count);
+
+    Lock lock;
+
+    // The fields below are guarded by |lock|.
+
+    // The number of concurrent providers that haven't finished dumping yet.
+    size_t pending_count;
+
+    // A ProcessMemoryDump for each of the concurrent providers that finished.
+    std::vector<std::unique_ptr<ProcessMemoryDump>> dumps;
+
+    // Set by FinishAsyncProcessDump() when the other providers finish first,
+    // and run by the last concurrent provider to finish.
+    OnceClosure on_done;
+
+   private:
+    friend class RefCountedThreadSafe<ConcurrentDumpState>;
+    ~ConcurrentDumpState();
+
+    DISALLOW_COPY_AND_ASSIGN(ConcurrentDumpState);
+  };
+
   // Holds the state of a process memory dump that needs to be carried over
   // across task runners in order to fulfill an asynchronous CreateProcessDump()
   // request. At any time exactly one task runner owns a
@@ -173,6 +203,10 @@ class BASE_EXPORT MemoryDumpManager {
     // and becomes empty at the end, when all dump providers have been invoked.
     std::vector<scoped_refptr<MemoryDumpProviderInfo>> pending_dump_providers;
 
+    // The dumps of the providers that support concurrent dumps. Null if there
+    // are none.
+    scoped_refptr<ConcurrentDumpState> concurrent_dumps;
+
     // Callback passed to the initial call to CreateProcessDump().
     ProcessMemoryDumpCallback callback;
 
@@ -210,11 +244,27 @@ class BASE_EXPORT MemoryDumpManager {
   void ContinueAsyncProcessDump(
       ProcessMemoryDumpAsyncState* owned_pmd_async_state);
 
+  // Moves the providers that support concurrent dumps out of
+  // |pmd_async_state|'s pending providers and posts their OnMemoryDump() calls
+  // to the thread pool.
+  void StartConcurrentDumps(ProcessMemoryDumpAsyncState* pmd_async_state);
+
   // Invokes OnMemoryDump() of the given MDP. Should be called on the MDP task
   // runner.
   void InvokeOnMemoryDump(MemoryDumpProviderInfo* mdpinfo,
                           ProcessMemoryDump* pmd);
 
+  // Invokes OnMemoryDump() of the given concurrent MDP on a ProcessMemoryDump
+  // of its own, which is later merged into the process dump.
+  void InvokeOnMemoryDumpConcurrently(
+      scoped_refptr<MemoryDumpProviderInfo> mdpinfo,
+      MemoryDumpArgs args,
+      scoped_refptr<ConcurrentDumpState> concurrent_dumps);
+
+  // Leaves the allocator dumps that haven't changed since the previous
+  // incremental dump out of |pmd|, and remembers the current ones.
+  void RemoveUnchangedAllocatorDumps(ProcessMemoryDump* pmd);
+
   void FinishAsyncProcessDump(
       std::unique_ptr<ProcessMemoryDumpAsyncState> pmd_async_state);
 
@@ -251,6 +301,11 @@ class BASE_EXPORT MemoryDumpManager {
   // affinity.
   std::unique_ptr<Thread> dump_thread_;
 
+  // For each level of detail, maps the names of the allocator dumps in the
+  // previous incremental dump to a fingerprint of their contents.
+  std::map<MemoryDumpLevelOfDetail, std::map<std::string, std::string>>
+      incremental_dump_fingerprints_;
+
   // The unique id of the child process. This is created only for tracing and is
   // expected to be valid only when tracing is enabled.
   uint64_t tracing_process_id_;
@@ -7,6 +7,7 @@
 #include <stdint.h>
 
 #include <memory>
+#include <string>
 #include <utility>
 #include <vector>
 
@@ -224,6 +225,29 @@ class MemoryDumpManagerTest : public testing::Test {
     return success;
   }
 
+  // Like RequestProcessDumpAndWait(), but returns the ProcessMemoryDump.
+  std::unique_ptr<ProcessMemoryDump> RequestProcessDumpAndGetResult(
+      MemoryDumpLevelOfDetail level_of_detail,
+      bool incremental) {
+    RunLoop run_loop;
+    std::unique_ptr<ProcessMemoryDump> result;
+    MemoryDumpRequestArgs request_args{
+        1, MemoryDumpType::EXPLICITLY_TRIGGERED, level_of_detail, incremental};
+    mdm_->CreateProcessDump(
+        request_args,
+        Bind(
+            [](std::unique_ptr<ProcessMemoryDump>* curried_result,
+               Closure curried_quit_closure, bool success, uint64_t dump_guid,
+               std::unique_ptr<ProcessMemoryDump> pmd) {
+              EXPECT_TRUE(success);
+              *curried_result = std::move(pmd);
+              curried_quit_closure.Run();
+            },
+            Unretained(&result), run_loop.QuitClosure()));
+    run_loop.Run();
+    return result;
+  }
+
   void EnableForTracing() {
     mdm_->SetupForTracing(TraceConfig::MemoryDumpConfig());
   }
@@ -797,6 +821,90 @@ class SimpleMockMemoryDumpProvider : public MemoryDumpProvider {
   int num_dump_calls_;
 };
 
+// Checks that providers that support concurrent dumps are invoked in parallel,
+// and that their dumps end up in the process dump.
+TEST_F(MemoryDumpManagerTest, ConcurrentDumpers) {
+  MemoryDumpProvider::Options options;
+  options.supports_concurrent_dumps = true;
+  MockMemoryDumpProvider mdp1;
+  MockMemoryDumpProvider mdp2;
+  RegisterDumpProvider(&mdp1, nullptr, options);
+  RegisterDumpProvider(&mdp2, nullptr, options);
+
+  // Each provider waits for the other to start dumping, which would deadlock if
+  // they were invoked one after the other.
+  WaitableEvent mdp1_started;
+  WaitableEvent mdp2_started;
+  EXPECT_CALL(mdp1, OnMemoryDump(_, _))
+      .WillOnce(Invoke([&](const MemoryDumpArgs&, ProcessMemoryDump* pmd) {
+        mdp1_started.Signal();
+        mdp2_started.Wait();
+        pmd->CreateAllocatorDump("mdp1");
+        return true;
+      }));
+  EXPECT_CALL(mdp2, OnMemoryDump(_, _))
+      .WillOnce(Invoke([&](const MemoryDumpArgs&, ProcessMemoryDump* pmd) {
+        mdp2_started.Signal();
+        mdp1_started.Wait();
+        pmd->CreateAllocatorDump("mdp2");
+        return true;
+      }));
+
+  std::unique_ptr<ProcessMemoryDump> pmd = RequestProcessDumpAndGetResult(
+      MemoryDumpLevelOfDetail::DETAILED, false /* incremental */);
+  ASSERT_TRUE(pmd);
+  EXPECT_TRUE(pmd->GetAllocatorDump("mdp1"));
+  EXPECT_TRUE(pmd->GetAllocatorDump("mdp2"));
+}
+
+// Checks that incremental dumps leave out the allocator dumps that haven't
+// changed since the previous incremental dump.
+TEST_F(MemoryDumpManagerTest, IncrementalDumps) {
+  MockMemoryDumpProvider mdp;
+  RegisterDumpProvider(&mdp, ThreadTaskRunnerHandle::Get());
+  uint64_t changing_size = 0;
+  EXPECT_CALL(mdp, OnMemoryDump(_, _))
+      .WillRepeatedly(
+          Invoke([&](const MemoryDumpArgs&, ProcessMemoryDump* pmd) {
+            pmd->CreateAllocatorDump("constant")
+                ->AddScalar(MemoryAllocatorDump::kNameSize,
+                            MemoryAllocatorDump::kUnitsBytes, 1024);
+            pmd->CreateAllocatorDump("changing")
+                ->AddScalar(MemoryAllocatorDump::kNameSize,
+                            MemoryAllocatorDump::kUnitsBytes, ++changing_size);
+            return true;
+          }));
+
+  // The first incremental dump is complete.
+  std::unique_ptr<ProcessMemoryDump> pmd = RequestProcessDumpAndGetResult(
+      MemoryDumpLevelOfDetail::DETAILED, true /* incremental */);
+  ASSERT_TRUE(pmd);
+  EXPECT_TRUE(pmd->GetAllocatorDump("constant"));
+  EXPECT_TRUE(pmd->GetAllocatorDump("changing"));
+  EXPECT_TRUE(pmd->unchanged_allocator_dumps().empty());
+
+  pmd = RequestProcessDumpAndGetResult(MemoryDumpLevelOfDetail::DETAILED,
+                                       true /* incremental */);
+  ASSERT_TRUE(pmd);
+  EXPECT_FALSE(pmd->GetAllocatorDump("constant"));
+  EXPECT_TRUE(pmd->GetAllocatorDump("changing"));
+  EXPECT_EQ(std::vector<std::string>{"constant"},
+            pmd->unchanged_allocator_dumps());
+
+  // Other levels of detail and non-incremental dumps are unaffected.
+  pmd = RequestProcessDumpAndGetResult(MemoryDumpLevelOfDetail::LIGHT,
+                                       true /* incremental */);
+  ASSERT_TRUE(pmd);
+  EXPECT_TRUE(pmd->GetAllocatorDump("constant"));
+  pmd = RequestProcessDumpAndGetResult(MemoryDumpLevelOfDetail::DETAILED,
+                                       false /* incremental */);
+  ASSERT_TRUE(pmd);
+  EXPECT_TRUE(pmd->GetAllocatorDump("constant"));
+  EXPECT_TRUE(pmd->unchanged_allocator_dumps().empty());
+
+  mdm_->UnregisterDumpProvider(&mdp);
+}
+
 TEST_F(MemoryDumpManagerTest, NoStackOverflowWithTooManyMDPs) {
   SetDumpProviderWhitelistForTesting(kTestMDPWhitelist);
 
@@ -20,12 +20,21 @@ class BASE_EXPORT MemoryDumpProvider {
  public:
   // Optional arguments for MemoryDumpManager::RegisterDumpProvider().
   struct Options {
-    Options() : dumps_on_single_thread_task_runner(false) {}
+    Options()
+        : dumps_on_single_thread_task_runner(false),
+          supports_concurrent_dumps(false) {}
 
     // |dumps_on_single_thread_task_runner| is true if the dump provider runs on
     // a SingleThreadTaskRunner, which is usually the case. It is faster to run
     // all providers that run on the same thread together without thread hops.
     bool dumps_on_single_thread_task_runner;
+
+    // |supports_concurrent_dumps| is true if OnMemoryDump() is thread-safe,
+    // and can run on a thread pool thread concurrently with other dump
+    // providers and with other calls to itself. Such providers are invoked in
+    // parallel at the start of each dump, rather than one after the other on
+    // the dump thread. Only for providers registered without a task runner.
+    bool supports_concurrent_dumps;
   };
 
   virtual ~MemoryDumpProvider() = default;
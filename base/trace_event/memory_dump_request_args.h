@@ -68,6 +68,13 @@ struct BASE_EXPORT MemoryDumpRequestArgs {
 
   MemoryDumpType dump_type;
   MemoryDumpLevelOfDetail level_of_detail;
+
+  // When true, allocator dumps that haven't changed since the previous
+  // incremental dump with the same |level_of_detail| are left out of the
+  // ProcessMemoryDump, and only listed in its unchanged_allocator_dumps(). The
+  // first incremental dump of each level of detail is complete. Only for
+  // in-process consumers, which keep the previous dumps around.
+  bool incremental = false;
 };
 
 // Args for ProcessMemoryDump and passed to OnMemoryDump calls for memory dump
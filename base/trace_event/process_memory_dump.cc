@@ -347,9 +347,17 @@ void ProcessMemoryDump::SetAllEdgesForSerialization(
   }
 }
 
+void ProcessMemoryDump::RemoveUnchangedAllocatorDump(
+    const std::string& absolute_name) {
+  size_t removed = allocator_dumps_.erase(absolute_name);
+  DCHECK(removed);
+  unchanged_allocator_dumps_.push_back(absolute_name);
+}
+
 void ProcessMemoryDump::Clear() {
   allocator_dumps_.clear();
   allocator_dumps_edges_.clear();
+  unchanged_allocator_dumps_.clear();
 }
 
 void ProcessMemoryDump::TakeAllDumpsFrom(ProcessMemoryDump* other) {
@@ -8,6 +8,7 @@
 #include <stddef.h>
 
 #include <map>
+#include <string>
 #include <unordered_map>
 #include <vector>
 
@@ -210,6 +211,16 @@ class BASE_EXPORT ProcessMemoryDump {
   void AddSuballocation(const MemoryAllocatorDumpGuid& source,
                         const std::string& target_node_name);
 
+  // Removes the MemoryAllocatorDump named |absolute_name| from an incremental
+  // dump (see MemoryDumpRequestArgs::incremental), because it hasn't changed
+  // since the previous one. Its name is kept in unchanged_allocator_dumps().
+  void RemoveUnchangedAllocatorDump(const std::string& absolute_name);
+
+  // The names of the MemoryAllocatorDump(s) left out of an incremental dump.
+  const std::vector<std::string>& unchanged_allocator_dumps() const {
+    return unchanged_allocator_dumps_;
+  }
+
   // Removes all the MemoryAllocatorDump(s) contained in this instance. This
   // ProcessMemoryDump can be safely reused as if it was new once this returns.
   void Clear();
@@ -263,6 +274,9 @@ class BASE_EXPORT ProcessMemoryDump {
   // Keeps track of relationships between MemoryAllocatorDump(s).
   AllocatorDumpEdgesMap allocator_dumps_edges_;
 
+  // See unchanged_allocator_dumps().
+  std::vector<std::string> unchanged_allocator_dumps_;
+
   // Level of detail of the current dump.
   MemoryDumpArgs dump_args_;
 
@@ -0,0 +1,93 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base/bind.h"
+#include "base/location.h"
+#include "base/single_thread_task_runner.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/threading/thread.h"
+#include "base/time/time.h"
+#include "base/trace_event/trace_event.h"
+#include "base/trace_event/trace_log.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "testing/perf/perf_test.h"
+
+namespace base {
+namespace trace_event {
+
+namespace {
+
+constexpr int kEventsPerThread = 1000000;
+
+void AddIntArgEvents() {
+  for (int i = 0; i < kEventsPerThread; ++i) {
+    TRACE_EVENT_INSTANT1("perf", "IntArgEvent", TRACE_EVENT_SCOPE_THREAD,
+                         "value", i);
+  }
+}
+
+void AddStringArgEvents() {
+  for (int i = 0; i < kEventsPerThread; ++i) {
+    TRACE_EVENT_INSTANT1("perf", "StringArgEvent", TRACE_EVENT_SCOPE_THREAD,
+                         "value", "a constant string");
+  }
+}
+
+}  // namespace
+
+// Measures the cost of adding events from threads with a message loop, which
+// record into thread-local buffers.
+class TraceEventPerfTest : public testing::Test {
+ public:
+  void SetUp() override {
+    // Record continuously so that the buffer never fills up.
+    TraceLog::GetInstance()->SetEnabled(
+        TraceConfig("perf", RECORD_CONTINUOUSLY), TraceLog::RECORDING_MODE);
+  }
+
+  void TearDown() override { TraceLog::GetInstance()->SetDisabled(); }
+
+  // Runs |add_events| on |thread_count| threads at once, and prints the
+  // average time per event.
+  void RunTest(const std::string& name,
+               int thread_count,
+               void (*add_events)()) {
+    std::vector<std::unique_ptr<Thread>> threads;
+    for (int i = 0; i < thread_count; ++i) {
+      threads.push_back(
+          std::make_unique<Thread>("TraceEventPerfTest" + NumberToString(i)));
+      ASSERT_TRUE(threads.back()->Start());
+    }
+
+    const TimeTicks start = TimeTicks::Now();
+    for (const auto& thread : threads)
+      thread->task_runner()->PostTask(FROM_HERE, BindOnce(add_events));
+    for (const auto& thread : threads)
+      thread->Stop();
+    const TimeDelta elapsed = TimeTicks::Now() - start;
+
+    perf_test::PrintResult(
+        name, "", NumberToString(thread_count) + "_threads",
+        elapsed.InNanoseconds() /
+            static_cast<double>(kEventsPerThread * thread_count),
+        "ns/event", true);
+  }
+};
+
+TEST_F(TraceEventPerfTest, IntArgs) {
+  for (int thread_count : {1, 4})
+    RunTest("IntArgs", thread_count, &AddIntArgEvents);
+}
+
+TEST_F(TraceEventPerfTest, StringArgs) {
+  for (int thread_count : {1, 4})
+    RunTest("StringArgs", thread_count, &AddStringArgEvents);
+}
+
+}  // namespace trace_event
+}  // namespace base
@@ -273,13 +273,11 @@ TraceEvent* TraceLog::ThreadLocalEventBuffer::AddTraceEvent(
     TraceEventHandle* handle) {
   CheckThisIsCurrentBuffer();
 
-  if (chunk_ && chunk_->IsFull()) {
+  if (!chunk_ || chunk_->IsFull()) {
+    // Return the full chunk and get the next one under a single acquisition
+    // of the lock shared by all threads, which is only taken once per chunk.
     AutoLock lock(trace_log_->lock_);
     FlushWhileLocked();
-    chunk_.reset();
-  }
-  if (!chunk_) {
-    AutoLock lock(trace_log_->lock_);
     chunk_ = trace_log_->logged_events_->GetChunk(&chunk_index_);
     trace_log_->CheckIfBufferIsFullWhileLocked();
   }
@@ -332,6 +330,11 @@ void TraceLog::SetAddTraceEventOverrides(
   update_duration_callback_.store(update_duration_callback);
 }
 
+void TraceLog::SetAddTraceEventDirectOverride(
+    const AddTraceEventDirectCallback& add_event_direct_override) {
+  add_trace_event_direct_override_.store(add_event_direct_override);
+}
+
 struct TraceLog::RegisteredAsyncObserver {
   explicit RegisteredAsyncObserver(WeakPtr<AsyncEnabledStateObserver> observer)
       : observer(observer), task_runner(ThreadTaskRunnerHandle::Get()) {}
@@ -1158,6 +1161,24 @@ TraceEventHandle TraceLog::AddTraceEventWithThreadIdAndTimestamp(
   if (!*category_group_enabled)
     return handle;
 
+  // Events that need neither filtering, ETW export, nor id mangling can skip
+  // the bookkeeping below if the override writes them directly.
+  if ((*category_group_enabled & RECORDING_MODE) &&
+      !(*category_group_enabled & (TraceCategory::ENABLED_FOR_FILTERING |
+                                   TraceCategory::ENABLED_FOR_ETW_EXPORT)) &&
+      !(flags &
+        (TRACE_EVENT_FLAG_MANGLE_ID | TRACE_EVENT_FLAG_HAS_PROCESS_ID))) {
+    auto trace_event_direct_override =
+        add_trace_event_direct_override_.load(std::memory_order_relaxed);
+    if (trace_event_direct_override &&
+        thread_id == static_cast<int>(PlatformThread::CurrentId()) &&
+        trace_event_direct_override(
+            phase, category_group_enabled, name, scope, id, bind_id,
+            OffsetTimestamp(timestamp), args, flags, &handle)) {
+      return handle;
+    }
+  }
+
   // Avoid re-entrance of AddTraceEvent. This may happen in GPU process when
   // ECHO_TO_CONSOLE is enabled: AddTraceEvent -> LOG(ERROR) ->
   // GpuProcessLogMessageHandler -> PostPendingTask -> TRACE_EVENT ...
@@ -1188,10 +1209,12 @@ TraceEventHandle TraceLog::AddTraceEventWithThreadIdAndTimestamp(
   }
 
   // Check and update the current thread name only if the event is for the
-  // current thread to avoid locks in most cases.
+  // current thread to avoid locks in most cases. The name is read from
+  // thread-local storage, since ThreadIdNameManager::GetName() would take a
+  // process-wide lock for every event.
   if (thread_id == static_cast<int>(PlatformThread::CurrentId())) {
     const char* new_name =
-        ThreadIdNameManager::GetInstance()->GetName(thread_id);
+        ThreadIdNameManager::GetInstance()->GetNameForCurrentThread();
     // Check if the thread name has been set or changed since the previous
     // call (if any), but don't bother if the new name is empty. Note this will
     // not detect a thread name change within the same char* buffer address: we
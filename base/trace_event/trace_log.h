@@ -210,6 +210,25 @@ class BASE_EXPORT TraceLog : public MemoryDumpProvider {
       const OnFlushCallback& on_flush_callback,
       const UpdateDurationCallback& update_duration_callback);
 
+  // Like the AddTraceEventOverrideCallback, but called with the arguments of
+  // the TRACE_EVENT macros before TraceLog does any bookkeeping or constructs a
+  // TraceEvent, so that the event can be written straight into the override's
+  // own buffer. Only called for events on the current thread. If it returns
+  // false, the event takes the regular path, e.g. to create per-thread state.
+  using AddTraceEventDirectCallback =
+      bool (*)(char phase,
+               const unsigned char* category_group_enabled,
+               const char* name,
+               const char* scope,
+               unsigned long long id,
+               unsigned long long bind_id,
+               const TimeTicks& timestamp,
+               TraceArguments* args,
+               unsigned int flags,
+               TraceEventHandle* handle);
+  void SetAddTraceEventDirectOverride(
+      const AddTraceEventDirectCallback& add_event_direct_override);
+
   // Called by TRACE_EVENT* macros, don't call this directly.
   // The name parameter is a category group for example:
   // TRACE_EVENT0("renderer,webkit", "WebViewImpl::HandleInputEvent")
@@ -538,6 +557,7 @@ class BASE_EXPORT TraceLog : public MemoryDumpProvider {
   subtle::AtomicWord generation_;
   bool use_worker_thread_;
   std::atomic<AddTraceEventOverrideCallback> add_trace_event_override_;
+  std::atomic<AddTraceEventDirectCallback> add_trace_event_direct_override_;
   std::atomic<OnFlushCallback> on_flush_callback_;
   std::atomic<UpdateDurationCallback> update_duration_callback_;
 
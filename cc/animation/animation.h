@@ -130,6 +130,9 @@ class CC_ANIMATION_EXPORT Animation : public base::RefCounted<Animation> {
 
   virtual bool IsWorkletAnimation() const;
   void AddKeyframeEffect(std::unique_ptr<KeyframeEffect>);
+  const std::vector<std::unique_ptr<KeyframeEffect>>& keyframe_effects() const {
+    return keyframe_effects_;
+  }
 
   KeyframeEffect* GetKeyframeEffectById(
       KeyframeEffectId keyframe_effect_id) const;
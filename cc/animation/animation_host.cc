@@ -14,6 +14,7 @@
 #include "base/trace_event/trace_event.h"
 #include "base/trace_event/traced_value.h"
 #include "cc/animation/animation.h"
+#include "cc/animation/animation_curve.h"
 #include "cc/animation/animation_delegate.h"
 #include "cc/animation/animation_events.h"
 #include "cc/animation/animation_id_provider.h"
@@ -389,10 +390,7 @@ bool AnimationHost::TickAnimations(base::TimeTicks monotonic_time,
 
   // Worklet animations are ticked at a later stage. See above comment for
   // details.
-  bool animated = TickAnimationsIf(ticking_animations_, monotonic_time,
-                                   [](const Animation& animation) {
-                                     return !animation.IsWorkletAnimation();
-                                   });
+  bool animated = TickKeyframeEffects(monotonic_time);
 
   // TODO(majidvp): At the moment we call this for both active and pending
   // trees similar to other animations. However our final goal is to only call
@@ -406,6 +404,87 @@ bool AnimationHost::TickAnimations(base::TimeTicks monotonic_time,
   return animated;
 }
 
+bool AnimationHost::TickKeyframeEffects(base::TimeTicks monotonic_time) {
+  bool did_tick = false;
+  ticked_keyframe_effects_.clear();
+  for (auto& animation : ticking_animations_) {
+    if (animation->IsWorkletAnimation())
+      continue;
+    DCHECK(!monotonic_time.is_null());
+    did_tick = true;
+    for (auto& keyframe_effect : animation->keyframe_effects()) {
+      if (keyframe_effect->BeginTick(monotonic_time))
+        ticked_keyframe_effects_.push_back(keyframe_effect.get());
+    }
+  }
+
+  // Evaluate the curves of all the keyframe models in effect. This does not
+  // touch the client, so that the (costly) transform interpolation runs as
+  // one tight loop. The entries of |ticked_keyframe_models_| are overwritten
+  // rather than cleared so that their transform operations keep their
+  // storage.
+  size_t ticked_count = 0;
+  for (KeyframeEffect* keyframe_effect : ticked_keyframe_effects_) {
+    ElementAnimations* target = keyframe_effect->element_animations().get();
+    for (auto& keyframe_model : keyframe_effect->keyframe_models()) {
+      if (!KeyframeEffect::ShouldTickKeyframeModel(monotonic_time,
+                                                   *keyframe_model)) {
+        continue;
+      }
+      if (ticked_count == ticked_keyframe_models_.size())
+        ticked_keyframe_models_.emplace_back();
+      TickedKeyframeModel& ticked = ticked_keyframe_models_[ticked_count++];
+      ticked.keyframe_model = keyframe_model.get();
+      ticked.target = target;
+      ticked.trimmed_time =
+          keyframe_model->TrimTimeToCurrentIteration(monotonic_time);
+
+      const AnimationCurve* curve = keyframe_model->curve();
+      switch (curve->Type()) {
+        case AnimationCurve::TRANSFORM:
+          ticked.transform_value =
+              curve->ToTransformAnimationCurve()->GetValue(
+                  ticked.trimmed_time);
+          break;
+        case AnimationCurve::FLOAT:
+          ticked.float_value =
+              curve->ToFloatAnimationCurve()->GetValue(ticked.trimmed_time);
+          break;
+        default:
+          // Evaluated when applied.
+          break;
+      }
+    }
+  }
+
+  // Apply the values in the order the keyframe models were ticked in.
+  for (size_t i = 0; i < ticked_count; ++i) {
+    TickedKeyframeModel& ticked = ticked_keyframe_models_[i];
+    KeyframeModel* keyframe_model = ticked.keyframe_model;
+    switch (keyframe_model->curve()->Type()) {
+      case AnimationCurve::TRANSFORM:
+        ticked.target->NotifyClientTransformOperationsAnimated(
+            ticked.transform_value, keyframe_model->target_property_id(),
+            keyframe_model);
+        break;
+      case AnimationCurve::FLOAT:
+        ticked.target->NotifyClientFloatAnimated(
+            ticked.float_value, keyframe_model->target_property_id(),
+            keyframe_model);
+        break;
+      default:
+        KeyframeEffect::TickKeyframeModel(monotonic_time, keyframe_model,
+                                          ticked.target);
+        break;
+    }
+  }
+
+  for (KeyframeEffect* keyframe_effect : ticked_keyframe_effects_)
+    keyframe_effect->EndTick(monotonic_time);
+
+  return did_tick;
+}
+
 void AnimationHost::TickScrollAnimations(base::TimeTicks monotonic_time,
                                          const ScrollTree& scroll_tree) {
   // TODO(majidvp): We need to return a boolean here so that LTHI knows
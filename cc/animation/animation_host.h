@@ -14,6 +14,7 @@
 #include "base/time/time.h"
 #include "cc/animation/animation_export.h"
 #include "cc/animation/keyframe_model.h"
+#include "cc/animation/transform_operations.h"
 #include "cc/trees/mutator_host.h"
 #include "cc/trees/mutator_host_client.h"
 #include "ui/gfx/geometry/box_f.h"
@@ -208,6 +209,11 @@ class CC_ANIMATION_EXPORT AnimationHost : public MutatorHost,
 
   void EraseTimeline(scoped_refptr<AnimationTimeline> timeline);
 
+  // Ticks the non-worklet animations as one batch: the keyframe models of all
+  // ticking keyframe effects are evaluated first, and their values are then
+  // applied to the client in bulk. Returns true if any animation was ticked.
+  bool TickKeyframeEffects(base::TimeTicks monotonic_time);
+
   // Return true if there are any animations that get mutated.
   void TickMutator(base::TimeTicks monotonic_time,
                    const ScrollTree& scroll_tree,
@@ -222,6 +228,21 @@ class CC_ANIMATION_EXPORT AnimationHost : public MutatorHost,
   ElementToAnimationsMap element_to_animations_map_;
   AnimationsList ticking_animations_;
 
+  // A keyframe model ticked by TickKeyframeEffects(), along with its value
+  // for the curve types that are evaluated ahead of being applied.
+  struct TickedKeyframeModel {
+    KeyframeModel* keyframe_model;
+    ElementAnimations* target;
+    base::TimeDelta trimmed_time;
+    float float_value;
+    TransformOperations transform_value;
+  };
+
+  // Scratch space of TickKeyframeEffects(), kept to reuse its allocations from
+  // one frame to the next.
+  std::vector<KeyframeEffect*> ticked_keyframe_effects_;
+  std::vector<TickedKeyframeModel> ticked_keyframe_models_;
+
   // A list of all timelines which this host owns.
   using IdToTimelineMap =
       std::unordered_map<int, scoped_refptr<AnimationTimeline>>;
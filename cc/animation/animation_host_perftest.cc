@@ -10,12 +10,14 @@
 #include "cc/animation/animation_timeline.h"
 #include "cc/animation/keyframe_effect.h"
 #include "cc/animation/single_keyframe_effect_animation.h"
+#include "cc/test/animation_test_common.h"
 #include "cc/test/fake_impl_task_runner_provider.h"
 #include "cc/test/fake_layer_tree_host.h"
 #include "cc/test/fake_layer_tree_host_client.h"
 #include "cc/test/fake_layer_tree_host_impl.h"
 #include "cc/test/stub_layer_tree_host_single_thread_client.h"
 #include "cc/test/test_task_graph_runner.h"
+#include "cc/trees/property_tree.h"
 #include "testing/gtest/include/gtest/gtest.h"
 #include "testing/perf/perf_test.h"
 
@@ -91,6 +93,16 @@ class AnimationHostPerfTest : public testing::Test {
       EXPECT_TRUE(timeline_impl->GetAnimationById(i));
   }
 
+  // Adds a transform and an opacity keyframe model to each animation created
+  // by CreateAnimations().
+  void AddKeyframeModelsToAnimations() {
+    for (int i = first_animation_id_; i < last_animation_id_; ++i) {
+      Animation* animation = all_animations_timeline_->GetAnimationById(i);
+      AddAnimatedTransformToAnimation(animation, 1.0, 100, 100);
+      AddOpacityTransitionToAnimation(animation, 1.0, 0.f, 1.f, true);
+    }
+  }
+
   void CreateTimelines(int num_timelines) {
     first_timeline_id_ = AnimationIdProvider::NextTimelineId();
     last_timeline_id_ = first_timeline_id_;
@@ -134,6 +146,24 @@ class AnimationHostPerfTest : public testing::Test {
                            "runs/s", true);
   }
 
+  void DoTickTest() {
+    ScrollTree scroll_tree;
+    base::TimeTicks start_time = base::TimeTicks::Now();
+    int frame = 0;
+    timer_.Reset();
+    do {
+      // Stay within the 1s duration of the keyframe models, so that they keep
+      // producing values.
+      base::TimeTicks frame_time =
+          start_time + base::TimeDelta::FromMilliseconds(16 * (frame++ % 60));
+      host()->TickAnimations(frame_time, scroll_tree, false);
+      timer_.NextLap();
+    } while (!timer_.HasTimeLimitExpired());
+
+    perf_test::PrintResult("tick_animations", "", "", timer_.LapsPerSecond(),
+                           "runs/s", true);
+  }
+
  private:
   StubLayerTreeHostSingleThreadClient single_thread_client_;
   FakeLayerTreeHostClient fake_client_;
@@ -158,6 +188,12 @@ TEST_F(AnimationHostPerfTest, Push1000AnimationsPropertiesTo) {
   DoTest();
 }
 
+TEST_F(AnimationHostPerfTest, Tick1000Animations) {
+  CreateAnimations(1000);
+  AddKeyframeModelsToAnimations();
+  DoTickTest();
+}
+
 TEST_F(AnimationHostPerfTest, Push10TimelinesPropertiesTo) {
   CreateTimelines(10);
   DoTest();
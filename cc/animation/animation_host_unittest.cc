@@ -8,6 +8,7 @@
 #include "cc/animation/animation_id_provider.h"
 #include "cc/animation/animation_timeline.h"
 #include "cc/animation/scroll_timeline.h"
+#include "cc/animation/single_keyframe_effect_animation.h"
 #include "cc/animation/worklet_animation.h"
 #include "cc/test/animation_test_common.h"
 #include "cc/test/animation_timelines_test_common.h"
@@ -147,6 +148,48 @@ TEST_F(AnimationHostTest, ImplOnlyScrollAnimationUpdateTargetIfDetached) {
       element_id_, scroll_delta, max_scroll_offset, time, base::TimeDelta()));
 }
 
+// Tests that the keyframe models of all the ticking animations are applied
+// when they are ticked as one batch.
+TEST_F(AnimationHostTest, TickAnimationsAppliesAllKeyframeModels) {
+  const ElementId other_element_id(NextTestLayerId());
+  for (ElementId element_id : {element_id_, other_element_id}) {
+    client_.RegisterElement(element_id, ElementListType::ACTIVE);
+    client_impl_.RegisterElement(element_id, ElementListType::PENDING);
+    client_impl_.RegisterElement(element_id, ElementListType::ACTIVE);
+  }
+
+  AttachTimelineAnimationLayer();
+  scoped_refptr<SingleKeyframeEffectAnimation> other_animation =
+      SingleKeyframeEffectAnimation::Create(
+          AnimationIdProvider::NextAnimationId());
+  timeline_->AttachAnimation(other_animation);
+  other_animation->AttachElement(other_element_id);
+
+  const double duration = 1.;
+  AddOpacityTransitionToAnimation(animation_.get(), duration, .7f, .3f, false);
+  AddAnimatedTransformToAnimation(animation_.get(), duration, 10, 20);
+  AddAnimatedTransformToAnimation(other_animation.get(), duration, 30, 40);
+  AddAnimatedFilterToAnimation(other_animation.get(), duration, .6f, .4f);
+
+  host_->PushPropertiesTo(host_impl_);
+  host_impl_->ActivateAnimations();
+
+  base::TimeTicks time;
+  time += base::TimeDelta::FromSecondsD(0.1);
+  TickAnimationsTransferEvents(time, 4u);
+  time += base::TimeDelta::FromSecondsD(duration);
+  TickAnimationsTransferEvents(time, 4u);
+
+  client_impl_.ExpectOpacityPropertyMutated(element_id_,
+                                            ElementListType::ACTIVE, .3f);
+  client_impl_.ExpectTransformPropertyMutated(
+      element_id_, ElementListType::ACTIVE, 10, 20);
+  client_impl_.ExpectTransformPropertyMutated(
+      other_element_id, ElementListType::ACTIVE, 30, 40);
+  client_impl_.ExpectFilterPropertyMutated(other_element_id,
+                                           ElementListType::ACTIVE, .4f);
+}
+
 // Tests that verify interaction of AnimationHost with LayerTreeMutator.
 
 TEST_F(AnimationHostTest, FastLayerTreeMutatorUpdateTakesEffectInSameFrame) {
@@ -105,31 +105,46 @@ void KeyframeEffect::DetachElement() {
 }
 
 void KeyframeEffect::Tick(base::TimeTicks monotonic_time) {
-  DCHECK(has_bound_element_animations());
-  if (!element_animations_->has_element_in_any_list())
+  if (!BeginTick(monotonic_time))
     return;
 
-  if (needs_to_start_keyframe_models_)
-    StartKeyframeModels(monotonic_time);
-
   for (auto& keyframe_model : keyframe_models_) {
     TickKeyframeModel(monotonic_time, keyframe_model.get(),
                       element_animations_.get());
   }
 
+  EndTick(monotonic_time);
+}
+
+bool KeyframeEffect::BeginTick(base::TimeTicks monotonic_time) {
+  DCHECK(has_bound_element_animations());
+  if (!element_animations_->has_element_in_any_list())
+    return false;
+
+  if (needs_to_start_keyframe_models_)
+    StartKeyframeModels(monotonic_time);
+  return true;
+}
+
+void KeyframeEffect::EndTick(base::TimeTicks monotonic_time) {
   last_tick_time_ = monotonic_time;
   element_animations_->UpdateClientAnimationState();
 }
 
+bool KeyframeEffect::ShouldTickKeyframeModel(
+    base::TimeTicks monotonic_time,
+    const KeyframeModel& keyframe_model) {
+  return (keyframe_model.run_state() == KeyframeModel::STARTING ||
+          keyframe_model.run_state() == KeyframeModel::RUNNING ||
+          keyframe_model.run_state() == KeyframeModel::PAUSED) &&
+         keyframe_model.InEffect(monotonic_time);
+}
+
 void KeyframeEffect::TickKeyframeModel(base::TimeTicks monotonic_time,
                                        KeyframeModel* keyframe_model,
                                        AnimationTarget* target) {
-  if ((keyframe_model->run_state() != KeyframeModel::STARTING &&
-       keyframe_model->run_state() != KeyframeModel::RUNNING &&
-       keyframe_model->run_state() != KeyframeModel::PAUSED) ||
-      !keyframe_model->InEffect(monotonic_time)) {
+  if (!ShouldTickKeyframeModel(monotonic_time, *keyframe_model))
     return;
-  }
 
   AnimationCurve* curve = keyframe_model->curve();
   base::TimeDelta trimmed =
@@ -86,6 +86,19 @@ class CC_ANIMATION_EXPORT KeyframeEffect {
   static void TickKeyframeModel(base::TimeTicks monotonic_time,
                                 KeyframeModel* keyframe_model,
                                 AnimationTarget* target);
+  // Returns true if |keyframe_model| produces a value at |monotonic_time|.
+  static bool ShouldTickKeyframeModel(base::TimeTicks monotonic_time,
+                                      const KeyframeModel& keyframe_model);
+
+  // Tick() split in two, so that AnimationHost can tick many keyframe effects
+  // as one batch. BeginTick() starts the keyframe models that are ready to,
+  // and returns false if there is nothing to tick. Otherwise the caller ticks
+  // keyframe_models() and then calls EndTick().
+  bool BeginTick(base::TimeTicks monotonic_time);
+  void EndTick(base::TimeTicks monotonic_time);
+  const std::vector<std::unique_ptr<KeyframeModel>>& keyframe_models() const {
+    return keyframe_models_;
+  }
   void RemoveFromTicking();
   bool is_ticking() const { return is_ticking_; }
 
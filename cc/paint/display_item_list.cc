@@ -23,6 +23,10 @@ namespace cc {
 
 namespace {
 
+// Records with at least this many ops get a spatial index when released, so
+// that rastering a tile of them only replays the ops that intersect it.
+constexpr size_t kMinOpsForSpatialIndex = 1000;
+
 bool GetCanvasClipBounds(SkCanvas* canvas, gfx::Rect* clip_bounds) {
   SkRect canvas_clip_bounds;
   if (!canvas->getLocalClipBounds(&canvas_clip_bounds))
@@ -220,6 +224,8 @@ void DisplayItemList::Reset() {
 sk_sp<PaintRecord> DisplayItemList::ReleaseAsRecord() {
   sk_sp<PaintRecord> record =
       sk_make_sp<PaintOpBuffer>(std::move(paint_op_buffer_));
+  if (record->size() >= kMinOpsForSpatialIndex)
+    record->BuildSpatialIndex();
 
   Reset();
   return record;
@@ -4,6 +4,8 @@
 
 #include "cc/paint/image_transfer_cache_entry.h"
 
+#include <string.h>
+
 #include <utility>
 #include <vector>
 
@@ -107,6 +109,17 @@ uint32_t ClientImageTransferCacheEntry::Id() const {
 }
 
 bool ClientImageTransferCacheEntry::Serialize(base::span<uint8_t> data) const {
+  uint8_t* pixels = nullptr;
+  if (!SerializeWithoutPixels(data, &pixels))
+    return false;
+
+  memcpy(pixels, pixmap_->addr(), pixmap_->computeByteSize());
+  return true;
+}
+
+bool ClientImageTransferCacheEntry::SerializeWithoutPixels(
+    base::span<uint8_t> data,
+    uint8_t** pixels) const {
   DCHECK_GE(data.size(), SerializedSize());
   DCHECK_GT(pixmap_->width(), 0);
   DCHECK_GT(pixmap_->height(), 0);
@@ -126,12 +139,12 @@ bool ClientImageTransferCacheEntry::Serialize(base::span<uint8_t> data) const {
   writer.Write(pixmap_->colorSpace());
   writer.Write(target_color_space_);
   writer.AlignMemory(4);
-  writer.WriteData(pixmap_size, pixmap_->addr());
 
   // Size can't be 0 after serialization unless the writer has become invalid.
-  if (writer.size() == 0u)
+  if (writer.size() == 0u || data.size() - writer.size() < pixmap_size)
     return false;
 
+  *pixels = data.data() + writer.size();
   return true;
 }
 
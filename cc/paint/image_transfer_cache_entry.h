@@ -41,6 +41,13 @@ class CC_PAINT_EXPORT ClientImageTransferCacheEntry
   uint32_t SerializedSize() const final;
   bool Serialize(base::span<uint8_t> data) const final;
 
+  // Serializes everything but the pixels into |data|, and sets |pixels| to
+  // where the pixels of |pixmap| belong in |data| so that they can be written
+  // there directly, e.g. by decoding the image into them. The address of the
+  // pixmap passed to the constructor isn't used.
+  bool SerializeWithoutPixels(base::span<uint8_t> data,
+                              uint8_t** pixels) const;
+
  private:
   uint32_t id_;
   const SkPixmap* const pixmap_;
@@ -103,6 +103,15 @@ SkPath* ServicePaintCache::GetPath(PaintCacheId id) {
   return it == cached_paths_.end() ? nullptr : &it->second;
 }
 
+void ServicePaintCache::PutRecord(PaintCacheId id, sk_sp<PaintRecord> record) {
+  cached_records_.emplace(id, std::move(record));
+}
+
+sk_sp<PaintRecord> ServicePaintCache::GetRecord(PaintCacheId id) {
+  auto it = cached_records_.find(id);
+  return it == cached_records_.end() ? nullptr : it->second;
+}
+
 void ServicePaintCache::Purge(PaintCacheDataType type,
                               size_t n,
                               const volatile PaintCacheId* ids) {
@@ -113,6 +122,9 @@ void ServicePaintCache::Purge(PaintCacheDataType type,
     case PaintCacheDataType::kPath:
       EraseFromMap(&cached_paths_, n, ids);
       return;
+    case PaintCacheDataType::kRecord:
+      EraseFromMap(&cached_records_, n, ids);
+      return;
   }
 
   NOTREACHED();
@@ -121,6 +133,7 @@ void ServicePaintCache::Purge(PaintCacheDataType type,
 void ServicePaintCache::PurgeAll() {
   cached_blobs_.clear();
   cached_paths_.clear();
+  cached_records_.clear();
 }
 
 }  // namespace cc
@@ -11,18 +11,20 @@
 #include "base/containers/mru_cache.h"
 #include "base/containers/stack_container.h"
 #include "cc/paint/paint_export.h"
+#include "cc/paint/paint_record.h"
 #include "third_party/skia/include/core/SkPath.h"
 #include "third_party/skia/include/core/SkTextBlob.h"
 
 namespace cc {
 
 // PaintCache is used to cache high frequency small paint data types, like
-// SkTextBlob and SkPath in the GPU service. The ClientPaintCache budgets and
-// controls the cache state in the ServicePaintCache, regularly purging old
-// entries returned in ClientPaintCache::Purge from the service side cache. In
-// addition to this, the complete cache is cleared during the raster context
-// idle cleanup. This effectively means that the cache budget is used as working
-// memory that is only kept while we are actively rasterizing.
+// SkTextBlob, SkPath and small nested PaintRecords in the GPU service. The
+// ClientPaintCache budgets and controls the cache state in the
+// ServicePaintCache, regularly purging old entries returned in
+// ClientPaintCache::Purge from the service side cache. In addition to this,
+// the complete cache is cleared during the raster context idle cleanup. This
+// effectively means that the cache budget is used as working memory that is
+// only kept while we are actively rasterizing.
 //
 // The entries are serialized by the caller during paint op serialization, and
 // the cache assumes the deserialization and purging to be done in order for
@@ -36,7 +38,12 @@ namespace cc {
 
 using PaintCacheId = uint32_t;
 using PaintCacheIds = std::vector<PaintCacheId>;
-enum class PaintCacheDataType : uint32_t { kTextBlob, kPath, kLast = kPath };
+enum class PaintCacheDataType : uint32_t {
+  kTextBlob,
+  kPath,
+  kRecord,
+  kLast = kRecord
+};
 enum class PaintCacheEntryState : uint32_t {
   kEmpty,
   kCached,
@@ -109,17 +116,25 @@ class CC_PAINT_EXPORT ServicePaintCache {
   void PutPath(PaintCacheId, SkPath path);
   SkPath* GetPath(PaintCacheId id);
 
+  void PutRecord(PaintCacheId id, sk_sp<PaintRecord> record);
+  sk_sp<PaintRecord> GetRecord(PaintCacheId id);
+
   void Purge(PaintCacheDataType type,
              size_t n,
              const volatile PaintCacheId* ids);
   void PurgeAll();
-  bool empty() const { return cached_blobs_.empty() && cached_paths_.empty(); }
+  bool empty() const {
+    return cached_blobs_.empty() && cached_paths_.empty() &&
+           cached_records_.empty();
+  }
 
  private:
   using BlobMap = std::map<PaintCacheId, sk_sp<SkTextBlob>>;
   BlobMap cached_blobs_;
   using PathMap = std::map<PaintCacheId, SkPath>;
   PathMap cached_paths_;
+  using RecordMap = std::map<PaintCacheId, sk_sp<PaintRecord>>;
+  RecordMap cached_records_;
 };
 
 }  // namespace cc
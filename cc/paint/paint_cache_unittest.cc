@@ -114,6 +114,18 @@ TEST_P(PaintCacheTest, ServiceBasic) {
 
       service_cache.PutPath(id, path);
     } break;
+    case PaintCacheDataType::kRecord: {
+      auto record = sk_make_sp<PaintRecord>();
+      record->push<DrawRectOp>(SkRect::MakeWH(10, 10), PaintFlags());
+      auto id = record->unique_id();
+      EXPECT_EQ(nullptr, service_cache.GetRecord(id));
+      service_cache.PutRecord(id, record);
+      EXPECT_EQ(record, service_cache.GetRecord(id));
+      service_cache.Purge(GetType(), 1, &id);
+      EXPECT_EQ(nullptr, service_cache.GetRecord(id));
+
+      service_cache.PutRecord(id, record);
+    } break;
   }
 
   EXPECT_FALSE(service_cache.empty());
@@ -125,7 +137,7 @@ INSTANTIATE_TEST_SUITE_P(
     P,
     PaintCacheTest,
     ::testing::Range(static_cast<uint32_t>(0),
-                     static_cast<uint32_t>(PaintCacheDataType::kLast)));
+                     static_cast<uint32_t>(PaintCacheDataTypeCount)));
 
 }  // namespace
 }  // namespace cc
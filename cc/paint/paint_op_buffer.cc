@@ -4,10 +4,12 @@
 
 #include "cc/paint/paint_op_buffer.h"
 
+#include "base/atomic_sequence_num.h"
 #include "cc/paint/decoded_draw_image.h"
 #include "cc/paint/display_item_list.h"
 #include "cc/paint/image_provider.h"
 #include "cc/paint/paint_image_builder.h"
+#include "cc/paint/paint_op_buffer_spatial_index.h"
 #include "cc/paint/paint_op_reader.h"
 #include "cc/paint/paint_op_writer.h"
 #include "cc/paint/paint_record.h"
@@ -17,6 +19,8 @@
 #include "third_party/skia/include/core/SkRegion.h"
 #include "third_party/skia/include/core/SkSerialProcs.h"
 #include "third_party/skia/include/gpu/GrContext.h"
+#include "ui/gfx/geometry/rect_conversions.h"
+#include "ui/gfx/skia_util.h"
 
 namespace cc {
 namespace {
@@ -46,6 +50,17 @@ SkRect AdjustSrcRectForScale(SkRect original, SkSize scale_adjustment) {
                           original.height() * y_scale);
 }
 
+// The largest record that is cached in the GPU service with OOP raster, so
+// that records sent by reference stay cheap to check for cacheability.
+constexpr size_t kMaxCachedRecordOps = 64;
+
+base::AtomicSequenceNumber g_next_buffer_id;
+
+uint32_t NextBufferId() {
+  // Ids start at 1, like other paint cache ids.
+  return static_cast<uint32_t>(g_next_buffer_id.GetNext()) + 1;
+}
+
 }  // namespace
 
 #define TYPES(M)      \
@@ -554,14 +569,17 @@ size_t DrawPathOp::Serialize(const PaintOp* base_op,
   return helper.size();
 }
 
-size_t DrawRecordOp::Serialize(const PaintOp* op,
+size_t DrawRecordOp::Serialize(const PaintOp* base_op,
                                void* memory,
                                size_t size,
                                const SerializeOptions& options) {
-  // TODO(enne): these must be flattened.  Serializing this will not do
-  // anything.
-  NOTREACHED();
-  return 0u;
+  // Records are flattened when they're serialized, except for small ones
+  // which are cached in the GPU service.
+  auto* op = static_cast<const DrawRecordOp*>(base_op);
+  DCHECK(CanCacheRecord(op->record.get()));
+  PaintOpWriter helper(memory, size, options);
+  helper.WriteCachedRecord(op->record.get());
+  return helper.size();
 }
 
 size_t DrawRectOp::Serialize(const PaintOp* base_op,
@@ -968,9 +986,19 @@ PaintOp* DrawRecordOp::Deserialize(const volatile void* input,
                                    void* output,
                                    size_t output_size,
                                    const DeserializeOptions& options) {
-  // TODO(enne): these must be flattened and not sent directly.
-  // TODO(enne): could also consider caching these service side.
-  return nullptr;
+  DCHECK_GE(output_size, sizeof(DrawRecordOp));
+  DrawRecordOp* op = new (output) DrawRecordOp;
+
+  PaintOpReader helper(input, input_size, options);
+  sk_sp<PaintRecord> record;
+  helper.ReadCachedRecord(&record);
+  if (!helper.valid()) {
+    op->~DrawRecordOp();
+    return nullptr;
+  }
+  op->record = std::move(record);
+  UpdateTypeAndSkip(op);
+  return op;
 }
 
 PaintOp* DrawRectOp::Deserialize(const volatile void* input,
@@ -2178,6 +2206,32 @@ DrawRecordOp::DrawRecordOp(sk_sp<const PaintRecord> record)
 
 DrawRecordOp::~DrawRecordOp() = default;
 
+// static
+bool DrawRecordOp::CanCacheRecord(const PaintRecord* record) {
+  if (record->size() == 0u || record->size() > kMaxCachedRecordOps ||
+      record->total_op_count() != record->size() ||
+      record->HasDiscardableImages()) {
+    return false;
+  }
+
+  for (const PaintOp* op : PaintOpBuffer::Iterator(record)) {
+    switch (op->GetType()) {
+      case PaintOpType::DrawImage:
+      case PaintOpType::DrawImageRect:
+      case PaintOpType::DrawTextBlob:
+        return false;
+      default:
+        break;
+    }
+    if (op->IsPaintOpWithFlags()) {
+      const PaintFlags& flags = static_cast<const PaintOpWithFlags*>(op)->flags;
+      if (flags.getShader() || flags.getImageFilter())
+        return false;
+    }
+  }
+  return true;
+}
+
 size_t DrawRecordOp::AdditionalBytesUsed() const {
   return record->bytes_used();
 }
@@ -2236,7 +2290,9 @@ PaintOpBuffer::CompositeIterator::CompositeIterator(CompositeIterator&& other) =
     default;
 
 PaintOpBuffer::PaintOpBuffer()
-    : has_non_aa_paint_(false), has_discardable_images_(false) {}
+    : unique_id_(NextBufferId()),
+      has_non_aa_paint_(false),
+      has_discardable_images_(false) {}
 
 PaintOpBuffer::PaintOpBuffer(PaintOpBuffer&& other) {
   *this = std::move(other);
@@ -2256,11 +2312,14 @@ PaintOpBuffer& PaintOpBuffer::operator=(PaintOpBuffer&& other) {
   subrecord_op_count_ = other.subrecord_op_count_;
   has_non_aa_paint_ = other.has_non_aa_paint_;
   has_discardable_images_ = other.has_discardable_images_;
+  spatial_index_ = std::move(other.spatial_index_);
+  unique_id_ = other.unique_id_;
 
   // Make sure the other pob can destruct safely.
   other.used_ = 0;
   other.op_count_ = 0;
   other.reserved_ = 0;
+  other.unique_id_ = NextBufferId();
   return *this;
 }
 
@@ -2277,6 +2336,8 @@ void PaintOpBuffer::Reset() {
   subrecord_bytes_used_ = 0;
   subrecord_op_count_ = 0;
   has_discardable_images_ = false;
+  spatial_index_.reset();
+  unique_id_ = NextBufferId();
 }
 
 // When |op| is a nested PaintOpBuffer, this returns the PaintOp inside
@@ -2400,6 +2461,21 @@ void PaintOpBuffer::Playback(SkCanvas* canvas,
   if (offsets && offsets->empty())
     return;
 
+  // Only replay the ops that may draw inside the clip.
+  std::vector<size_t> culled_offsets;
+  if (!offsets && spatial_index_) {
+    SkRect clip_bounds;
+    gfx::Rect query_rect;
+    if (canvas->getLocalClipBounds(&clip_bounds))
+      query_rect = gfx::ToEnclosingRect(gfx::SkRectToRectF(clip_bounds));
+    if (spatial_index_->CanCull(query_rect)) {
+      spatial_index_->Search(*this, query_rect, &culled_offsets);
+      if (culled_offsets.empty())
+        return;
+      offsets = &culled_offsets;
+    }
+  }
+
   // Prevent PaintOpBuffers from having side effects back into the canvas.
   SkAutoCanvasRestore save_restore(canvas, true);
 
@@ -2515,6 +2591,10 @@ void* PaintOpBuffer::AllocatePaintOp(size_t skip) {
   return op;
 }
 
+void PaintOpBuffer::BuildSpatialIndex() {
+  spatial_index_ = std::make_unique<PaintOpBufferSpatialIndex>(*this);
+}
+
 void PaintOpBuffer::ShrinkToFit() {
   if (used_ == reserved_)
     return;
@@ -8,6 +8,7 @@
 #include <stdint.h>
 
 #include <limits>
+#include <memory>
 #include <string>
 #include <type_traits>
 
@@ -192,6 +193,9 @@ class CC_PAINT_EXPORT PaintOp {
     bool crash_dump_on_failure = false;
     // Used to memcpy Skia flattenables into to avoid TOCTOU issues.
     std::vector<uint8_t>* scratch_buffer = nullptr;
+    // Set while deserializing a record for the paint cache, which can't have
+    // nested records.
+    bool is_cached_record = false;
   };
 
   // Indicates how PaintImages are serialized.
@@ -652,6 +656,10 @@ class CC_PAINT_EXPORT DrawRecordOp final : public PaintOp {
   static constexpr bool kIsDrawOp = true;
   explicit DrawRecordOp(sk_sp<const PaintRecord> record);
   ~DrawRecordOp();
+  // Whether the record is small and self-contained enough to be cached in
+  // the GPU service with OOP raster. Cacheable records don't draw text or
+  // images, whose serialization depends on the transform they're drawn with.
+  static bool CanCacheRecord(const PaintRecord* record);
   static void Raster(const DrawRecordOp* op,
                      SkCanvas* canvas,
                      const PlaybackParams& params);
@@ -665,6 +673,9 @@ class CC_PAINT_EXPORT DrawRecordOp final : public PaintOp {
   HAS_SERIALIZATION_FUNCTIONS();
 
   sk_sp<const PaintRecord> record;
+
+ private:
+  DrawRecordOp() : PaintOp(kType) {}
 };
 
 class CC_PAINT_EXPORT DrawRectOp final : public PaintOpWithFlags {
@@ -911,6 +922,8 @@ using LargestPaintOp =
                               DrawImageRectOp,
                               DrawDRRectOp>::type;
 
+class PaintOpBufferSpatialIndex;
+
 class CC_PAINT_EXPORT PaintOpBuffer : public SkRefCnt {
  public:
   enum { kInitialBufferSize = 4096 };
@@ -949,6 +962,9 @@ class CC_PAINT_EXPORT PaintOpBuffer : public SkRefCnt {
   size_t total_op_count() const { return op_count_ + subrecord_op_count_; }
 
   size_t next_op_offset() const { return used_; }
+  // Identifies the ops of this buffer, for caching them in the GPU service
+  // with OOP raster. Buffers get a new id when they are reset.
+  uint32_t unique_id() const { return unique_id_; }
   int numSlowPaths() const { return num_slow_paths_; }
   bool HasNonAAPaint() const { return has_non_aa_paint_; }
   bool HasDiscardableImages() const { return has_discardable_images_; }
@@ -961,6 +977,14 @@ class CC_PAINT_EXPORT PaintOpBuffer : public SkRefCnt {
   // Resize the PaintOpBuffer to exactly fit the current amount of used space.
   void ShrinkToFit();
 
+  // Builds a spatial index of the ops, which Playback() uses to skip the ops
+  // that draw outside of the canvas clip. No ops may be added afterwards. This
+  // must be called before the buffer is shared with other threads.
+  void BuildSpatialIndex();
+  const PaintOpBufferSpatialIndex* spatial_index() const {
+    return spatial_index_.get();
+  }
+
   const PaintOp* GetFirstOp() const {
     return reinterpret_cast<const PaintOp*>(data_.get());
   }
@@ -971,6 +995,7 @@ class CC_PAINT_EXPORT PaintOpBuffer : public SkRefCnt {
     static_assert(alignof(T) <= PaintOpAlign, "");
     static_assert(sizeof(T) < std::numeric_limits<uint16_t>::max(),
                   "Cannot fit op code in skip");
+    DCHECK(!spatial_index_);
     uint16_t skip = static_cast<uint16_t>(ComputeOpSkip(sizeof(T)));
     T* op = reinterpret_cast<T*>(AllocatePaintOp(skip));
 
@@ -1237,6 +1262,9 @@ class CC_PAINT_EXPORT PaintOpBuffer : public SkRefCnt {
   // Record total op count of referenced sub-record and display lists.
   size_t subrecord_op_count_ = 0;
 
+  std::unique_ptr<PaintOpBufferSpatialIndex> spatial_index_;
+  uint32_t unique_id_;
+
   bool has_non_aa_paint_ : 1;
   bool has_discardable_images_ : 1;
 };
@@ -302,10 +302,18 @@ void PaintOpBufferSerializer::SerializeBuffer(
       continue;
     }
 
+    // Small records are sent once and referenced by id from then on, since the
+    // same records are often drawn by many tiles and frames.
+    const auto* record = static_cast<const DrawRecordOp*>(op)->record.get();
+    if (DrawRecordOp::CanCacheRecord(record)) {
+      if (!SerializeOp(op, options, params))
+        return;
+      continue;
+    }
+
     int save_count = text_blob_canvas_.getSaveCount();
     Save(options, params);
-    SerializeBuffer(static_cast<const DrawRecordOp*>(op)->record.get(),
-                    nullptr);
+    SerializeBuffer(record, nullptr);
     RestoreToCount(save_count, options, params);
   }
 }
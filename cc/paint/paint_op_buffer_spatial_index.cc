@@ -0,0 +1,208 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "cc/paint/paint_op_buffer_spatial_index.h"
+
+#include "cc/paint/paint_op_buffer.h"
+#include "third_party/skia/include/core/SkMatrix.h"
+#include "ui/gfx/geometry/rect_conversions.h"
+#include "ui/gfx/skia_util.h"
+
+namespace cc {
+namespace {
+
+// Computes the bounds of a draw op in its local coordinate space, including
+// the effect of its flags, the same way PaintOp::QuickRejectDraw does.
+bool GetDrawOpBounds(const PaintOp* op, SkRect* bounds) {
+  if (op->GetType() == PaintOpType::DrawRecord) {
+    return PaintOpBufferSpatialIndex::ComputeBounds(
+        *static_cast<const DrawRecordOp*>(op)->record, bounds);
+  }
+
+  if (!PaintOp::GetBounds(op, bounds))
+    return false;
+
+  if (op->IsPaintOpWithFlags()) {
+    SkPaint paint = static_cast<const PaintOpWithFlags*>(op)->flags.ToSkPaint();
+    if (!paint.canComputeFastBounds())
+      return false;
+    // Lines are always stroked, whatever the style of the paint.
+    if (op->GetType() == PaintOpType::DrawLine)
+      paint.computeFastStrokeBounds(*bounds, bounds);
+    else
+      paint.computeFastBounds(*bounds, bounds);
+  }
+  return true;
+}
+
+}  // namespace
+
+PaintOpBufferSpatialIndex::PaintOpBufferSpatialIndex(
+    const PaintOpBuffer& buffer) {
+  ComputeBlocks(buffer, &blocks_);
+
+  std::vector<size_t> bounded_blocks;
+  for (size_t i = 0; i < blocks_.size(); ++i) {
+    if (blocks_[i].kind == Block::Kind::kBounded) {
+      bounded_blocks.push_back(i);
+    } else {
+      unculled_blocks_.push_back(i);
+      has_unbounded_blocks_ |= blocks_[i].kind == Block::Kind::kUnbounded;
+    }
+  }
+
+  rtree_.Build(
+      bounded_blocks,
+      [this](const std::vector<size_t>& indices, size_t i) {
+        return gfx::ToEnclosingRect(
+            gfx::SkRectToRectF(blocks_[indices[i]].bounds));
+      },
+      [](const std::vector<size_t>& indices, size_t i) { return indices[i]; });
+}
+
+PaintOpBufferSpatialIndex::~PaintOpBufferSpatialIndex() = default;
+
+bool PaintOpBufferSpatialIndex::CanCull(const gfx::Rect& rect) const {
+  gfx::Rect bounds = rtree_.GetBounds();
+  return !bounds.IsEmpty() && !rect.Contains(bounds);
+}
+
+void PaintOpBufferSpatialIndex::Search(const PaintOpBuffer& buffer,
+                                       const gfx::Rect& rect,
+                                       std::vector<size_t>* offsets) const {
+  std::vector<size_t> bounded_blocks;
+  rtree_.Search(rect, &bounded_blocks);
+
+  // Both lists of blocks are in increasing order, so merge them to replay the
+  // blocks in order.
+  const char* data = reinterpret_cast<const char*>(buffer.GetFirstOp());
+  auto bounded_it = bounded_blocks.begin();
+  auto unculled_it = unculled_blocks_.begin();
+  while (bounded_it != bounded_blocks.end() ||
+         unculled_it != unculled_blocks_.end()) {
+    size_t index;
+    if (unculled_it == unculled_blocks_.end() ||
+        (bounded_it != bounded_blocks.end() && *bounded_it < *unculled_it)) {
+      index = *bounded_it++;
+    } else {
+      index = *unculled_it++;
+    }
+
+    const Block& block = blocks_[index];
+    for (size_t offset = block.begin; offset < block.end;) {
+      offsets->push_back(offset);
+      offset += reinterpret_cast<const PaintOp*>(data + offset)->skip;
+    }
+  }
+}
+
+// static
+bool PaintOpBufferSpatialIndex::ComputeBounds(const PaintOpBuffer& buffer,
+                                              SkRect* bounds) {
+  if (const auto* index = buffer.spatial_index()) {
+    if (index->has_unbounded_blocks_)
+      return false;
+    *bounds = SkRect::MakeEmpty();
+    for (const Block& block : index->blocks_)
+      bounds->join(block.bounds);
+    return true;
+  }
+
+  std::vector<Block> blocks;
+  ComputeBlocks(buffer, &blocks);
+  *bounds = SkRect::MakeEmpty();
+  for (const Block& block : blocks) {
+    if (block.kind == Block::Kind::kUnbounded)
+      return false;
+    bounds->join(block.bounds);
+  }
+  return true;
+}
+
+// static
+void PaintOpBufferSpatialIndex::ComputeBlocks(const PaintOpBuffer& buffer,
+                                              std::vector<Block>* blocks) {
+  // The transform from the current op to the buffer, and the transforms that
+  // are restored by the Restore ops matching the open Save ops.
+  SkMatrix matrix = SkMatrix::I();
+  std::vector<SkMatrix> saved_matrices;
+
+  size_t offset = 0;
+  for (const PaintOp* op : PaintOpBuffer::Iterator(&buffer)) {
+    if (saved_matrices.empty())
+      blocks->push_back({offset, offset});
+    Block& block = blocks->back();
+    offset += op->skip;
+    block.end = offset;
+
+    bool unbounded = false;
+    switch (op->GetType()) {
+      case PaintOpType::Save:
+      case PaintOpType::SaveLayerAlpha:
+        saved_matrices.push_back(matrix);
+        break;
+      case PaintOpType::SaveLayer: {
+        // Filters may draw outside the bounds of the content of the layer.
+        const PaintFlags& flags = static_cast<const SaveLayerOp*>(op)->flags;
+        unbounded = flags.getImageFilter() || flags.getColorFilter();
+        saved_matrices.push_back(matrix);
+        break;
+      }
+      case PaintOpType::Restore:
+        if (!saved_matrices.empty()) {
+          matrix = saved_matrices.back();
+          saved_matrices.pop_back();
+        }
+        break;
+      case PaintOpType::Concat:
+        matrix.preConcat(static_cast<const ConcatOp*>(op)->matrix);
+        break;
+      case PaintOpType::Rotate:
+        matrix.preRotate(static_cast<const RotateOp*>(op)->degrees);
+        break;
+      case PaintOpType::Scale: {
+        auto* scale_op = static_cast<const ScaleOp*>(op);
+        matrix.preScale(scale_op->sx, scale_op->sy);
+        break;
+      }
+      case PaintOpType::SetMatrix:
+        // SetMatrixOp is relative to the transform at the start of playback.
+        matrix = static_cast<const SetMatrixOp*>(op)->matrix;
+        break;
+      case PaintOpType::Translate: {
+        auto* translate_op = static_cast<const TranslateOp*>(op);
+        matrix.preTranslate(translate_op->dx, translate_op->dy);
+        break;
+      }
+      case PaintOpType::ClipPath:
+      case PaintOpType::ClipRect:
+      case PaintOpType::ClipRRect:
+      case PaintOpType::Noop:
+        break;
+      case PaintOpType::Annotate:
+      case PaintOpType::CustomData:
+        // These are not culled by the canvas.
+        unbounded = true;
+        break;
+      default: {
+        DCHECK(op->IsDrawOp());
+        SkRect bounds;
+        if (matrix.hasPerspective() || !GetDrawOpBounds(op, &bounds)) {
+          unbounded = true;
+          break;
+        }
+        matrix.mapRect(&bounds);
+        if (block.kind == Block::Kind::kState)
+          block.kind = Block::Kind::kBounded;
+        block.bounds.join(bounds);
+        break;
+      }
+    }
+
+    if (unbounded)
+      block.kind = Block::Kind::kUnbounded;
+  }
+}
+
+}  // namespace cc
@@ -0,0 +1,87 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef CC_PAINT_PAINT_OP_BUFFER_SPATIAL_INDEX_H_
+#define CC_PAINT_PAINT_OP_BUFFER_SPATIAL_INDEX_H_
+
+#include <stddef.h>
+
+#include <vector>
+
+#include "cc/base/rtree.h"
+#include "cc/paint/paint_export.h"
+#include "third_party/skia/include/core/SkRect.h"
+#include "ui/gfx/geometry/rect.h"
+
+namespace cc {
+
+class PaintOpBuffer;
+
+// A spatial index of the ops of a PaintOpBuffer, which PaintOpBuffer::Playback
+// uses to replay only the ops that may draw inside the canvas clip.
+//
+// Ops are indexed in blocks that are replayed or skipped together: each
+// balanced Save/Restore range at the top level of the buffer, and each draw op
+// at the top level. The bounds of a block are computed in the coordinate space
+// of the buffer by following its transform ops, and include the bounds of
+// nested records. Top level transform and clip ops, and blocks whose bounds
+// can't be computed (such as a DrawColorOp, or a SaveLayerOp with an image
+// filter), are always replayed.
+class CC_PAINT_EXPORT PaintOpBufferSpatialIndex {
+ public:
+  explicit PaintOpBufferSpatialIndex(const PaintOpBuffer& buffer);
+  PaintOpBufferSpatialIndex(const PaintOpBufferSpatialIndex&) = delete;
+  ~PaintOpBufferSpatialIndex();
+
+  PaintOpBufferSpatialIndex& operator=(const PaintOpBufferSpatialIndex&) =
+      delete;
+
+  // Returns whether some blocks can be skipped when drawing |rect|.
+  bool CanCull(const gfx::Rect& rect) const;
+
+  // Appends to |offsets|, in increasing order, the offsets of the ops of
+  // |buffer| that need to be replayed to draw |rect|. |buffer| must be the
+  // buffer this index was built for.
+  void Search(const PaintOpBuffer& buffer,
+              const gfx::Rect& rect,
+              std::vector<size_t>* offsets) const;
+
+  // Computes the bounds of everything drawn by |buffer|, in its coordinate
+  // space. Returns false if some of the ops draw with unknown bounds. This uses
+  // the spatial index of |buffer| if it has one.
+  static bool ComputeBounds(const PaintOpBuffer& buffer, SkRect* bounds);
+
+ private:
+  struct Block {
+    enum class Kind {
+      // The block doesn't draw anything, but changes the state of the canvas.
+      kState,
+      // Everything drawn by the block is inside |bounds|.
+      kBounded,
+      // The block draws with unknown bounds.
+      kUnbounded,
+    };
+
+    // Offsets of the first op of the block and of the op following the block.
+    size_t begin;
+    size_t end;
+    Kind kind = Kind::kState;
+    SkRect bounds = SkRect::MakeEmpty();
+  };
+
+  static void ComputeBlocks(const PaintOpBuffer& buffer,
+                            std::vector<Block>* blocks);
+
+  std::vector<Block> blocks_;
+  // Indices into |blocks_| of the blocks that are always replayed, in
+  // increasing order.
+  std::vector<size_t> unculled_blocks_;
+  // Indices into |blocks_| of the bounded blocks.
+  RTree<size_t> rtree_;
+  bool has_unbounded_blocks_ = false;
+};
+
+}  // namespace cc
+
+#endif  // CC_PAINT_PAINT_OP_BUFFER_SPATIAL_INDEX_H_
@@ -13,6 +13,7 @@
 #include "cc/paint/image_transfer_cache_entry.h"
 #include "cc/paint/paint_image_builder.h"
 #include "cc/paint/paint_op_buffer_serializer.h"
+#include "cc/paint/paint_op_buffer_spatial_index.h"
 #include "cc/paint/paint_op_reader.h"
 #include "cc/paint/paint_op_writer.h"
 #include "cc/paint/shader_transfer_cache_entry.h"
@@ -897,6 +898,84 @@ TEST_F(PaintOpBufferOffsetsTest,
   }
 }
 
+// Pushes a block of ops drawing a 10x10 rect with |color| at (x, 0).
+void PushTranslatedRect(PaintOpBuffer* buffer, SkScalar x, SkColor color) {
+  PaintFlags flags;
+  flags.setColor(color);
+  buffer->push<SaveOp>();
+  buffer->push<TranslateOp>(x, 0.f);
+  buffer->push<DrawRectOp>(SkRect::MakeWH(10, 10), flags);
+  buffer->push<RestoreOp>();
+}
+
+TEST(PaintOpBufferTest, SpatialIndexSkipsBlocksOutsideClip) {
+  PaintOpBuffer buffer;
+  for (SkColor i = 0; i < 10; ++i)
+    PushTranslatedRect(&buffer, i * 20.f, i);
+  buffer.BuildSpatialIndex();
+
+  testing::NiceMock<MockCanvas> canvas;
+  canvas.clipRect(SkRect::MakeXYWH(35, 0, 10, 10));
+  EXPECT_CALL(canvas, OnDrawRectWithColor(_)).Times(0);
+  EXPECT_CALL(canvas, OnDrawRectWithColor(2u));
+  buffer.Playback(&canvas);
+}
+
+TEST(PaintOpBufferTest, SpatialIndexReplaysUnboundedBlocks) {
+  PaintOpBuffer buffer;
+  buffer.push<DrawColorOp>(11u, SkBlendMode::kSrcOver);
+  for (SkColor i = 0; i < 10; ++i)
+    PushTranslatedRect(&buffer, i * 20.f, i);
+
+  // The filter of the layer may move its content inside the clip.
+  PaintFlags layer_flags;
+  layer_flags.setImageFilter(
+      sk_make_sp<OffsetPaintFilter>(-500.f, 0.f, nullptr));
+  buffer.push<SaveLayerOp>(nullptr, &layer_flags);
+  PushTranslatedRect(&buffer, 500.f, 12u);
+  buffer.push<RestoreOp>();
+  buffer.BuildSpatialIndex();
+
+  testing::NiceMock<MockCanvas> canvas;
+  canvas.clipRect(SkRect::MakeXYWH(0, 0, 10, 10));
+  testing::Sequence s;
+  EXPECT_CALL(canvas, OnDrawPaintWithColor(11u)).InSequence(s);
+  EXPECT_CALL(canvas, OnDrawRectWithColor(0u)).InSequence(s);
+  EXPECT_CALL(canvas, OnDrawRectWithColor(12u)).InSequence(s);
+  buffer.Playback(&canvas);
+}
+
+TEST(PaintOpBufferTest, SpatialIndexUsesBoundsOfNestedRecords) {
+  auto record = sk_make_sp<PaintOpBuffer>();
+  for (SkColor i = 0; i < 10; ++i)
+    PushTranslatedRect(record.get(), i * 20.f, i);
+  record->BuildSpatialIndex();
+
+  // The nested record is drawn at x = 200, so it's outside of the clip.
+  PaintOpBuffer buffer;
+  PushTranslatedRect(&buffer, 0.f, 10u);
+  buffer.push<TranslateOp>(200.f, 0.f);
+  buffer.push<DrawRecordOp>(record);
+  buffer.BuildSpatialIndex();
+
+  SkRect bounds;
+  ASSERT_TRUE(PaintOpBufferSpatialIndex::ComputeBounds(buffer, &bounds));
+  EXPECT_EQ(SkRect::MakeLTRB(0, 0, 390, 10), bounds);
+
+  testing::NiceMock<MockCanvas> canvas;
+  canvas.clipRect(SkRect::MakeXYWH(0, 0, 10, 10));
+  EXPECT_CALL(canvas, OnDrawRectWithColor(_)).Times(0);
+  EXPECT_CALL(canvas, OnDrawRectWithColor(10u));
+  buffer.Playback(&canvas);
+  Mock::VerifyAndClearExpectations(&canvas);
+
+  // Inside the nested record, only the block in the clip is replayed.
+  canvas.translate(-200.f - 60.f, 0.f);
+  EXPECT_CALL(canvas, OnDrawRectWithColor(_)).Times(0);
+  EXPECT_CALL(canvas, OnDrawRectWithColor(3u));
+  buffer.Playback(&canvas);
+}
+
 TEST(PaintOpBufferTest, SaveLayerAlphaDrawRestoreWithBadBlendMode) {
   PaintOpBuffer buffer;
   testing::StrictMock<MockCanvas> canvas;
@@ -1701,9 +1780,10 @@ class PaintOpSerializationTest : public ::testing::TestWithParam<uint8_t> {
   }
 
   bool IsTypeSupported() {
-    // DrawRecordOps and DrawSkottieOps must be flattened and are not currently
-    // serialized. All other types must push non-zero amounts of ops in
-    // PushTestOps.
+    // DrawRecordOps are flattened unless they can be cached, which is covered
+    // by SerializesSmallNestedRecordsByReference. DrawSkottieOps are not
+    // currently serialized. All other types must push non-zero amounts of ops
+    // in PushTestOps.
     return GetParamType() != PaintOpType::DrawRecord &&
            GetParamType() != PaintOpType::DrawSkottie;
   }
@@ -2123,9 +2203,12 @@ TEST(PaintOpSerializationTest, Preamble) {
 }
 
 TEST(PaintOpSerializationTest, SerializesNestedRecords) {
+  // Use a record that is too large to be cached, so that it's flattened.
   auto record = sk_make_sp<PaintOpBuffer>();
   record->push<ScaleOp>(0.5f, 0.75f);
-  record->push<DrawRectOp>(SkRect::MakeWH(10.f, 20.f), PaintFlags());
+  for (int i = 0; i < 64; ++i)
+    record->push<DrawRectOp>(SkRect::MakeWH(10.f, 20.f + i), PaintFlags());
+  EXPECT_FALSE(DrawRecordOp::CanCacheRecord(record.get()));
   PaintOpBuffer buffer;
   buffer.push<DrawRecordOp>(record);
 
@@ -2184,6 +2267,56 @@ TEST(PaintOpSerializationTest, SerializesNestedRecords) {
   }
 }
 
+TEST(PaintOpSerializationTest, SerializesSmallNestedRecordsByReference) {
+  auto record = sk_make_sp<PaintOpBuffer>();
+  record->push<ScaleOp>(0.5f, 0.75f);
+  record->push<DrawRectOp>(SkRect::MakeWH(10.f, 20.f), PaintFlags());
+  EXPECT_TRUE(DrawRecordOp::CanCacheRecord(record.get()));
+  PaintOpBuffer buffer;
+  buffer.push<DrawRecordOp>(record);
+  buffer.push<DrawRecordOp>(record);
+
+  std::unique_ptr<char, base::AlignedFreeDeleter> memory(
+      static_cast<char*>(base::AlignedAlloc(PaintOpBuffer::kInitialBufferSize,
+                                            PaintOpBuffer::PaintOpAlign)));
+  TestOptionsProvider options_provider;
+  SimpleBufferSerializer serializer(
+      memory.get(), PaintOpBuffer::kInitialBufferSize,
+      options_provider.image_provider(),
+      options_provider.transfer_cache_helper(),
+      options_provider.client_paint_cache(), options_provider.strike_server(),
+      options_provider.color_space(), options_provider.can_use_lcd_text(),
+      options_provider.context_supports_distance_field_text(),
+      options_provider.max_texture_size(),
+      options_provider.max_texture_bytes());
+  serializer.Serialize(&buffer);
+  ASSERT_TRUE(serializer.valid());
+  EXPECT_TRUE(options_provider.client_paint_cache()->Get(
+      PaintCacheDataType::kRecord, record->unique_id()));
+
+  auto deserialized_buffer =
+      PaintOpBuffer::MakeFromMemory(memory.get(), serializer.written(),
+                                    options_provider.deserialize_options());
+  ASSERT_TRUE(deserialized_buffer);
+  ASSERT_EQ(deserialized_buffer->size(), 2u);
+
+  // The second op references the record cached by the first one.
+  sk_sp<PaintRecord> cached_record =
+      options_provider.service_paint_cache()->GetRecord(record->unique_id());
+  ASSERT_TRUE(cached_record);
+  for (const auto* op : PaintOpBuffer::Iterator(deserialized_buffer.get())) {
+    ASSERT_EQ(op->GetType(), PaintOpType::DrawRecord);
+    EXPECT_EQ(static_cast<const DrawRecordOp*>(op)->record, cached_record);
+  }
+
+  ASSERT_EQ(cached_record->size(), record->size());
+  auto cached_iter = PaintOpBuffer::Iterator(cached_record.get());
+  for (const auto* op : PaintOpBuffer::Iterator(record.get())) {
+    EXPECT_EQ(**cached_iter, *op);
+    ++cached_iter;
+  }
+}
+
 TEST(PaintOpBufferTest, ClipsImagesDuringSerialization) {
   struct {
     gfx::Rect clip_rect;
@@ -11,6 +11,8 @@
 #include "cc/paint/paint_op_buffer_serializer.h"
 #include "cc/test/test_options_provider.h"
 #include "testing/perf/perf_test.h"
+#include "third_party/skia/include/core/SkBitmap.h"
+#include "third_party/skia/include/core/SkCanvas.h"
 #include "third_party/skia/include/core/SkMaskFilter.h"
 #include "third_party/skia/include/effects/SkColorMatrixFilter.h"
 #include "third_party/skia/include/effects/SkDashPathEffect.h"
@@ -180,5 +182,52 @@ TEST_F(PaintOpPerfTest, TextOps) {
   RunTest("text", buffer);
 }
 
+// Replays one tile of a 100k-op page, with and without a spatial index.
+TEST_F(PaintOpPerfTest, PlaybackTileOfLargeRecord) {
+  constexpr int kTileSize = 256;
+  constexpr int kColumns = 100;
+  constexpr int kRows = 250;
+
+  // Each block of 4 ops draws a 20x20 rect in a 25x25 cell of the page.
+  auto make_record = [&](bool build_index) {
+    auto record = sk_make_sp<PaintOpBuffer>();
+    PaintFlags flags;
+    for (int y = 0; y < kRows; ++y) {
+      for (int x = 0; x < kColumns; ++x) {
+        record->push<SaveOp>();
+        record->push<TranslateOp>(x * 25.f, y * 25.f);
+        record->push<DrawRectOp>(SkRect::MakeWH(20, 20), flags);
+        record->push<RestoreOp>();
+      }
+    }
+    if (build_index)
+      record->BuildSpatialIndex();
+    return record;
+  };
+
+  SkBitmap bitmap;
+  bitmap.allocN32Pixels(kTileSize, kTileSize);
+  SkCanvas canvas(bitmap);
+
+  for (bool build_index : {false, true}) {
+    sk_sp<PaintOpBuffer> record = make_record(build_index);
+    CHECK_EQ(100000u, record->size());
+
+    timer_.Reset();
+    do {
+      // Raster a tile in the middle of the page.
+      canvas.save();
+      canvas.translate(-1024.f, -2048.f);
+      record->Playback(&canvas);
+      canvas.restore();
+      timer_.NextLap();
+    } while (!timer_.HasTimeLimitExpired());
+
+    perf_test::PrintResult("playback_tile_of_large_record",
+                           build_index ? "_indexed" : "", "",
+                           timer_.LapsPerSecond(), "runs/s", true);
+  }
+}
+
 }  // namespace
 }  // namespace cc
@@ -255,6 +255,61 @@ void PaintOpReader::Read(SkPath* path) {
   }
 }
 
+void PaintOpReader::ReadCachedRecord(sk_sp<PaintRecord>* record) {
+  uint32_t record_id;
+  ReadSimple(&record_id);
+  if (!valid_)
+    return;
+
+  uint32_t entry_state_int = 0u;
+  ReadSimple(&entry_state_int);
+  if (entry_state_int > static_cast<uint32_t>(PaintCacheEntryState::kLast)) {
+    valid_ = false;
+    return;
+  }
+
+  auto entry_state = static_cast<PaintCacheEntryState>(entry_state_int);
+  switch (entry_state) {
+    case PaintCacheEntryState::kEmpty:
+      SetInvalid();
+      return;
+    case PaintCacheEntryState::kCached:
+      *record = options_.paint_cache->GetRecord(record_id);
+      if (!*record)
+        SetInvalid();
+      return;
+    case PaintCacheEntryState::kInlined: {
+      // Cached records don't have nested records, which also bounds the
+      // recursion here.
+      if (options_.is_cached_record || enable_security_constraints_) {
+        SetInvalid();
+        return;
+      }
+
+      size_t size_bytes = 0;
+      ReadSize(&size_bytes);
+      AlignMemory(PaintOpBuffer::PaintOpAlign);
+      if (size_bytes > remaining_bytes_)
+        SetInvalid();
+      if (!valid_)
+        return;
+
+      PaintOp::DeserializeOptions record_options = options_;
+      record_options.is_cached_record = true;
+      *record =
+          PaintOpBuffer::MakeFromMemory(memory_, size_bytes, record_options);
+      if (!*record) {
+        SetInvalid();
+        return;
+      }
+      options_.paint_cache->PutRecord(record_id, *record);
+      memory_ += size_bytes;
+      remaining_bytes_ -= size_bytes;
+      return;
+    }
+  }
+}
+
 void PaintOpReader::Read(PaintFlags* flags) {
   ReadSimple(&flags->color_);
   Read(&flags->width_);
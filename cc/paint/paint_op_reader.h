@@ -57,6 +57,7 @@ class CC_PAINT_EXPORT PaintOpReader {
   void Read(SkRRect* rect);
 
   void Read(SkPath* path);
+  void ReadCachedRecord(sk_sp<PaintRecord>* record);
   void Read(PaintFlags* flags);
   void Read(PaintImage* image);
   void Read(sk_sp<SkData>* data);
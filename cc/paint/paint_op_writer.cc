@@ -202,6 +202,24 @@ void PaintOpWriter::Write(const SkPath& path) {
   remaining_bytes_ -= bytes_written;
 }
 
+void PaintOpWriter::WriteCachedRecord(const PaintRecord* record) {
+  auto id = record->unique_id();
+  Write(id);
+
+  if (options_.paint_cache->Get(PaintCacheDataType::kRecord, id)) {
+    Write(static_cast<uint32_t>(PaintCacheEntryState::kCached));
+    return;
+  }
+
+  Write(static_cast<uint32_t>(PaintCacheEntryState::kInlined));
+  size_t remaining_bytes_before_record = remaining_bytes_;
+  Write(record, gfx::Rect(), gfx::SizeF(1.f, 1.f), SkMatrix::I());
+  if (!valid_)
+    return;
+  options_.paint_cache->Put(PaintCacheDataType::kRecord, id,
+                            remaining_bytes_before_record - remaining_bytes_);
+}
+
 void PaintOpWriter::Write(const PaintFlags& flags) {
   WriteSimple(flags.color_);
   Write(flags.width_);
@@ -55,6 +55,10 @@ class CC_PAINT_EXPORT PaintOpWriter {
   void Write(const SkRRect& rect);
 
   void Write(const SkPath& path);
+  // Writes |record| inline the first time it's written, and as a reference to
+  // the copy in the service side paint cache afterwards. |record| must pass
+  // DrawRecordOp::CanCacheRecord.
+  void WriteCachedRecord(const PaintRecord* record);
   void Write(const PaintFlags& flags);
   void Write(const sk_sp<SkData>& data);
   void Write(const SkColorSpace* data);
@@ -147,6 +147,11 @@ bool BitmapRasterBufferProvider::CanPartialRasterIntoProvidedResource() const {
   return true;
 }
 
+bool BitmapRasterBufferProvider::CanRasterIntoCompressedResource() const {
+  // Software compositing can't draw compressed resources.
+  return false;
+}
+
 bool BitmapRasterBufferProvider::IsResourceReadyToDraw(
     const ResourcePool::InUsePoolResource& resource) const {
   // Bitmap resources are immediately ready to draw.
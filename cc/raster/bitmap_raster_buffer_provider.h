@@ -39,6 +39,7 @@ class CC_EXPORT BitmapRasterBufferProvider : public RasterBufferProvider {
   bool IsResourceSwizzleRequired() const override;
   bool IsResourcePremultiplied() const override;
   bool CanPartialRasterIntoProvidedResource() const override;
+  bool CanRasterIntoCompressedResource() const override;
   bool IsResourceReadyToDraw(
       const ResourcePool::InUsePoolResource& resource) const override;
   uint64_t SetReadyToDrawCallback(
@@ -0,0 +1,193 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "cc/raster/etc1_encoder.h"
+
+#include <stdlib.h>
+
+#include <algorithm>
+#include <limits>
+
+#include "base/logging.h"
+#include "third_party/skia/include/core/SkColorPriv.h"
+#include "third_party/skia/include/core/SkPixmap.h"
+
+namespace cc {
+namespace {
+
+// The modifiers of the ETC1 intensity tables, in the order of the pixel index
+// values that select them.
+constexpr int kModifiers[8][4] = {
+    {2, 8, -2, -8},       {5, 17, -5, -17},     {9, 29, -9, -29},
+    {13, 42, -13, -42},   {18, 60, -18, -60},   {24, 80, -24, -80},
+    {33, 106, -33, -106}, {47, 183, -47, -183}};
+
+// The pixels of the two halves of a block, for each value of the flip bit.
+// Pixels are numbered x * 4 + y, like the pixel index bits of a block.
+constexpr int kSubblockPixels[2][2][8] = {
+    {{0, 1, 2, 3, 4, 5, 6, 7}, {8, 9, 10, 11, 12, 13, 14, 15}},
+    {{0, 1, 4, 5, 8, 9, 12, 13}, {2, 3, 6, 7, 10, 11, 14, 15}}};
+
+using Color = int[3];
+
+struct SubblockEncoding {
+  int table = 0;
+  int indices[8] = {};
+  int error = std::numeric_limits<int>::max();
+};
+
+int Clamp255(int value) {
+  return std::min(std::max(value, 0), 255);
+}
+
+int Quantize4(int value) {
+  return (value * 15 + 127) / 255;
+}
+
+int Expand4(int value) {
+  return (value << 4) | value;
+}
+
+int Quantize5(int value) {
+  return (value * 31 + 127) / 255;
+}
+
+int Expand5(int value) {
+  return (value << 3) | (value >> 2);
+}
+
+// Chooses the intensity table and the modifier of each of the |pixels| of a
+// half block with the color |base|.
+SubblockEncoding EncodeSubblock(const Color (&pixels)[8], const Color& base) {
+  SubblockEncoding best;
+  for (int table = 0; table < 8; ++table) {
+    SubblockEncoding encoding;
+    encoding.table = table;
+    encoding.error = 0;
+    for (int i = 0; i < 8 && encoding.error < best.error; ++i) {
+      // A modifier is added to all channels, so use the one that is closest to
+      // their average difference from |base|. With clamping another one may be
+      // slightly better, which is not worth the time to check.
+      int difference = pixels[i][0] - base[0] + pixels[i][1] - base[1] +
+                       pixels[i][2] - base[2];
+      int best_distance = std::numeric_limits<int>::max();
+      for (int index = 0; index < 4; ++index) {
+        int distance = abs(difference - 3 * kModifiers[table][index]);
+        if (distance < best_distance) {
+          best_distance = distance;
+          encoding.indices[i] = index;
+        }
+      }
+
+      int modifier = kModifiers[table][encoding.indices[i]];
+      for (int c = 0; c < 3; ++c) {
+        int error = Clamp255(base[c] + modifier) - pixels[i][c];
+        encoding.error += error * error;
+      }
+    }
+    if (encoding.error < best.error)
+      best = encoding;
+  }
+  return best;
+}
+
+void EncodeBlock(const Color (&block)[16], uint8_t* dst) {
+  int best_error = std::numeric_limits<int>::max();
+  for (int flip = 0; flip < 2; ++flip) {
+    Color pixels[2][8];
+    Color averages[2];
+    for (int s = 0; s < 2; ++s) {
+      int sums[3] = {};
+      for (int i = 0; i < 8; ++i) {
+        const Color& pixel = block[kSubblockPixels[flip][s][i]];
+        for (int c = 0; c < 3; ++c) {
+          pixels[s][i][c] = pixel[c];
+          sums[c] += pixel[c];
+        }
+      }
+      for (int c = 0; c < 3; ++c)
+        averages[s][c] = (sums[c] + 4) / 8;
+    }
+
+    // Use the differential mode, which has more precision, if the colors of
+    // the halves are close enough to each other.
+    int quantized[2][3];
+    bool differential = true;
+    for (int c = 0; c < 3; ++c) {
+      quantized[0][c] = Quantize5(averages[0][c]);
+      quantized[1][c] = Quantize5(averages[1][c]);
+      int delta = quantized[1][c] - quantized[0][c];
+      differential &= delta >= -4 && delta <= 3;
+    }
+    Color bases[2];
+    for (int s = 0; s < 2; ++s) {
+      for (int c = 0; c < 3; ++c) {
+        if (!differential)
+          quantized[s][c] = Quantize4(averages[s][c]);
+        bases[s][c] = differential ? Expand5(quantized[s][c])
+                                   : Expand4(quantized[s][c]);
+      }
+    }
+
+    SubblockEncoding encodings[2] = {EncodeSubblock(pixels[0], bases[0]),
+                                     EncodeSubblock(pixels[1], bases[1])};
+    int error = encodings[0].error + encodings[1].error;
+    if (error >= best_error)
+      continue;
+    best_error = error;
+
+    for (int c = 0; c < 3; ++c) {
+      if (differential) {
+        int delta = quantized[1][c] - quantized[0][c];
+        dst[c] = (quantized[0][c] << 3) | (delta & 7);
+      } else {
+        dst[c] = (quantized[0][c] << 4) | quantized[1][c];
+      }
+    }
+    dst[3] = (encodings[0].table << 5) | (encodings[1].table << 2) |
+             (differential << 1) | flip;
+
+    uint16_t msb = 0;
+    uint16_t lsb = 0;
+    for (int s = 0; s < 2; ++s) {
+      for (int i = 0; i < 8; ++i) {
+        int bit = kSubblockPixels[flip][s][i];
+        int index = encodings[s].indices[i];
+        msb |= ((index >> 1) & 1) << bit;
+        lsb |= (index & 1) << bit;
+      }
+    }
+    dst[4] = msb >> 8;
+    dst[5] = msb & 0xff;
+    dst[6] = lsb >> 8;
+    dst[7] = lsb & 0xff;
+  }
+}
+
+}  // namespace
+
+void EncodeETC1(const SkPixmap& src, uint8_t* dst) {
+  DCHECK_EQ(src.colorType(), kN32_SkColorType);
+  DCHECK_EQ(src.width() % 4, 0);
+  DCHECK_EQ(src.height() % 4, 0);
+
+  for (int block_y = 0; block_y < src.height(); block_y += 4) {
+    for (int block_x = 0; block_x < src.width(); block_x += 4) {
+      Color block[16];
+      for (int y = 0; y < 4; ++y) {
+        const uint32_t* row = src.addr32(block_x, block_y + y);
+        for (int x = 0; x < 4; ++x) {
+          Color& pixel = block[x * 4 + y];
+          pixel[0] = SkGetPackedR32(row[x]);
+          pixel[1] = SkGetPackedG32(row[x]);
+          pixel[2] = SkGetPackedB32(row[x]);
+        }
+      }
+      EncodeBlock(block, dst);
+      dst += kETC1BlockSizeInBytes;
+    }
+  }
+}
+
+}  // namespace cc
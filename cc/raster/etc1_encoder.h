@@ -0,0 +1,31 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef CC_RASTER_ETC1_ENCODER_H_
+#define CC_RASTER_ETC1_ENCODER_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "cc/cc_export.h"
+
+class SkPixmap;
+
+namespace cc {
+
+// The size of an ETC1 block of 4x4 pixels, in bytes.
+constexpr size_t kETC1BlockSizeInBytes = 8;
+
+// Encodes the opaque N32 pixels of |src| as ETC1 into |dst|, which must have
+// room for kETC1BlockSizeInBytes for each block of 4x4 pixels. The width and
+// height of |src| must be multiples of 4. The alpha channel is ignored.
+//
+// This trades quality for speed so that tiles can be encoded as they are
+// rastered: each half of a block is encoded with the average of its pixels as
+// the base color, rather than by searching for the best base color.
+CC_EXPORT void EncodeETC1(const SkPixmap& src, uint8_t* dst);
+
+}  // namespace cc
+
+#endif  // CC_RASTER_ETC1_ENCODER_H_
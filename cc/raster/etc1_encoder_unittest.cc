@@ -0,0 +1,130 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "cc/raster/etc1_encoder.h"
+
+#include <stdlib.h>
+
+#include <algorithm>
+#include <vector>
+
+#include "testing/gtest/include/gtest/gtest.h"
+#include "third_party/skia/include/core/SkBitmap.h"
+#include "third_party/skia/include/core/SkColor.h"
+
+namespace cc {
+namespace {
+
+constexpr int kModifiers[8][4] = {
+    {2, 8, -2, -8},       {5, 17, -5, -17},     {9, 29, -9, -29},
+    {13, 42, -13, -42},   {18, 60, -18, -60},   {24, 80, -24, -80},
+    {33, 106, -33, -106}, {47, 183, -47, -183}};
+
+int ExtendSign3(int value) {
+  return value >= 4 ? value - 8 : value;
+}
+
+// Decodes the pixel at (|x|, |y|) of an ETC1 |block|, as specified by
+// OES_compressed_ETC1_RGB8_texture.
+SkColor DecodePixel(const uint8_t* block, int x, int y) {
+  bool differential = block[3] & 2;
+  bool flip = block[3] & 1;
+  bool second = flip ? y >= 2 : x >= 2;
+
+  int base[3];
+  for (int c = 0; c < 3; ++c) {
+    if (differential) {
+      int value = block[c] >> 3;
+      if (second)
+        value += ExtendSign3(block[c] & 7);
+      base[c] = (value << 3) | (value >> 2);
+    } else {
+      int value = second ? block[c] & 0xf : block[c] >> 4;
+      base[c] = (value << 4) | value;
+    }
+  }
+
+  int table = second ? (block[3] >> 2) & 7 : block[3] >> 5;
+  int bit = x * 4 + y;
+  int msb = ((block[4] << 8) | block[5]) >> bit & 1;
+  int lsb = ((block[6] << 8) | block[7]) >> bit & 1;
+  int modifier = kModifiers[table][(msb << 1) | lsb];
+
+  int color[3];
+  for (int c = 0; c < 3; ++c)
+    color[c] = std::min(std::max(base[c] + modifier, 0), 255);
+  return SkColorSetRGB(color[0], color[1], color[2]);
+}
+
+// Encodes |bitmap| and returns the largest difference of a channel of a
+// decoded pixel from the original.
+int EncodeAndGetMaxError(const SkBitmap& bitmap) {
+  int blocks_wide = bitmap.width() / 4;
+  std::vector<uint8_t> encoded(blocks_wide * (bitmap.height() / 4) *
+                               kETC1BlockSizeInBytes);
+  EncodeETC1(bitmap.pixmap(), encoded.data());
+
+  int max_error = 0;
+  for (int y = 0; y < bitmap.height(); ++y) {
+    for (int x = 0; x < bitmap.width(); ++x) {
+      const uint8_t* block =
+          &encoded[((y / 4) * blocks_wide + x / 4) * kETC1BlockSizeInBytes];
+      SkColor decoded = DecodePixel(block, x % 4, y % 4);
+      SkColor original = bitmap.getColor(x, y);
+      max_error = std::max(
+          {max_error, abs(static_cast<int>(SkColorGetR(decoded)) -
+                          static_cast<int>(SkColorGetR(original))),
+           abs(static_cast<int>(SkColorGetG(decoded)) -
+               static_cast<int>(SkColorGetG(original))),
+           abs(static_cast<int>(SkColorGetB(decoded)) -
+               static_cast<int>(SkColorGetB(original)))});
+    }
+  }
+  return max_error;
+}
+
+TEST(ETC1EncoderTest, SolidColors) {
+  const SkColor colors[] = {SK_ColorWHITE, SK_ColorBLACK, SK_ColorRED,
+                            SkColorSetRGB(0x12, 0x34, 0x56),
+                            SkColorSetRGB(0xfe, 0x80, 0x01)};
+  for (SkColor color : colors) {
+    SkBitmap bitmap;
+    bitmap.allocN32Pixels(8, 8, /*isOpaque=*/true);
+    bitmap.eraseColor(color);
+    EXPECT_LE(EncodeAndGetMaxError(bitmap), 6) << color;
+  }
+}
+
+TEST(ETC1EncoderTest, SplitBlocks) {
+  // Halves of different colors, split either way, are encoded as separate
+  // subblocks.
+  for (bool horizontal : {false, true}) {
+    SkBitmap bitmap;
+    bitmap.allocN32Pixels(4, 4, /*isOpaque=*/true);
+    for (int y = 0; y < 4; ++y) {
+      for (int x = 0; x < 4; ++x) {
+        bool second = horizontal ? y >= 2 : x >= 2;
+        *bitmap.getAddr32(x, y) = SkPreMultiplyColor(
+            second ? SkColorSetRGB(0xf0, 0x20, 0x20)
+                   : SkColorSetRGB(0x20, 0x20, 0xf0));
+      }
+    }
+    EXPECT_LE(EncodeAndGetMaxError(bitmap), 12) << horizontal;
+  }
+}
+
+TEST(ETC1EncoderTest, Gradient) {
+  SkBitmap bitmap;
+  bitmap.allocN32Pixels(64, 64, /*isOpaque=*/true);
+  for (int y = 0; y < 64; ++y) {
+    for (int x = 0; x < 64; ++x) {
+      *bitmap.getAddr32(x, y) =
+          SkPreMultiplyColor(SkColorSetRGB(x * 4, y * 4, 128));
+    }
+  }
+  EXPECT_LE(EncodeAndGetMaxError(bitmap), 16);
+}
+
+}  // namespace
+}  // namespace cc
@@ -402,6 +402,11 @@ bool GpuRasterBufferProvider::CanPartialRasterIntoProvidedResource() const {
   return msaa_sample_count_ == 0;
 }
 
+bool GpuRasterBufferProvider::CanRasterIntoCompressedResource() const {
+  // The GPU can't raster into compressed formats.
+  return false;
+}
+
 bool GpuRasterBufferProvider::IsResourceReadyToDraw(
     const ResourcePool::InUsePoolResource& resource) const {
   const gpu::SyncToken& sync_token = resource.gpu_backing()->mailbox_sync_token;
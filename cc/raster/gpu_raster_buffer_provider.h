@@ -51,6 +51,7 @@ class CC_EXPORT GpuRasterBufferProvider : public RasterBufferProvider {
   bool IsResourceSwizzleRequired() const override;
   bool IsResourcePremultiplied() const override;
   bool CanPartialRasterIntoProvidedResource() const override;
+  bool CanRasterIntoCompressedResource() const override;
   bool IsResourceReadyToDraw(
       const ResourcePool::InUsePoolResource& resource) const override;
   uint64_t SetReadyToDrawCallback(
@@ -9,7 +9,9 @@
 #include <algorithm>
 #include <limits>
 #include <utility>
+#include <vector>
 
+#include "base/containers/span.h"
 #include "base/debug/alias.h"
 #include "base/metrics/histogram_macros.h"
 #include "base/strings/stringprintf.h"
@@ -21,6 +23,7 @@
 #include "components/viz/common/gpu/raster_context_provider.h"
 #include "components/viz/common/resources/platform_color.h"
 #include "components/viz/common/resources/resource_format.h"
+#include "components/viz/common/resources/resource_format_utils.h"
 #include "components/viz/common/resources/resource_sizes.h"
 #include "gpu/GLES2/gl2extchromium.h"
 #include "gpu/command_buffer/client/context_support.h"
@@ -78,13 +81,15 @@ OneCopyRasterBufferProvider::RasterBufferImpl::RasterBufferImpl(
     gpu::GpuMemoryBufferManager* gpu_memory_buffer_manager,
     const ResourcePool::InUsePoolResource& in_use_resource,
     OneCopyGpuBacking* backing,
-    uint64_t previous_content_id)
+    uint64_t previous_content_id,
+    bool resource_has_previous_content)
     : client_(client),
       backing_(backing),
       resource_size_(in_use_resource.size()),
       resource_format_(in_use_resource.format()),
       color_space_(in_use_resource.color_space()),
       previous_content_id_(previous_content_id),
+      resource_has_previous_content_(resource_has_previous_content),
       before_raster_sync_token_(backing->returned_sync_token),
       mailbox_(backing->mailbox),
       mailbox_texture_target_(backing->texture_target),
@@ -119,7 +124,8 @@ void OneCopyRasterBufferProvider::RasterBufferImpl::Playback(
       &mailbox_, mailbox_texture_target_, mailbox_texture_is_overlay_candidate_,
       before_raster_sync_token_, raster_source, raster_full_rect,
       raster_dirty_rect, transform, resource_size_, resource_format_,
-      color_space_, playback_settings, previous_content_id_, new_content_id);
+      color_space_, playback_settings, previous_content_id_, new_content_id,
+      resource_has_previous_content_);
 }
 
 OneCopyRasterBufferProvider::OneCopyRasterBufferProvider(
@@ -131,7 +137,8 @@ OneCopyRasterBufferProvider::OneCopyRasterBufferProvider(
     bool use_partial_raster,
     bool use_gpu_memory_buffer_resources,
     int max_staging_buffer_usage_in_bytes,
-    viz::ResourceFormat tile_format)
+    viz::ResourceFormat tile_format,
+    bool use_compressed_resources)
     : compositor_context_provider_(compositor_context_provider),
       worker_context_provider_(worker_context_provider),
       gpu_memory_buffer_manager_(gpu_memory_buffer_manager),
@@ -144,6 +151,7 @@ OneCopyRasterBufferProvider::OneCopyRasterBufferProvider(
       use_gpu_memory_buffer_resources_(use_gpu_memory_buffer_resources),
       bytes_scheduled_since_last_flush_(0),
       tile_format_(tile_format),
+      use_compressed_resources_(use_compressed_resources),
       staging_pool_(std::move(task_runner),
                     worker_context_provider,
                     use_partial_raster,
@@ -170,10 +178,12 @@ OneCopyRasterBufferProvider::AcquireBufferForRaster(
   }
   OneCopyGpuBacking* backing =
       static_cast<OneCopyGpuBacking*>(resource.gpu_backing());
-  // TODO(danakj): If resource_content_id != 0, we only need to copy/upload
-  // the dirty rect.
-  return std::make_unique<RasterBufferImpl>(
-      this, gpu_memory_buffer_manager_, resource, backing, previous_content_id);
+  bool resource_has_previous_content =
+      resource_content_id && resource_content_id == previous_content_id;
+  return std::make_unique<RasterBufferImpl>(this, gpu_memory_buffer_manager_,
+                                            resource, backing,
+                                            previous_content_id,
+                                            resource_has_previous_content);
 }
 
 void OneCopyRasterBufferProvider::Flush() {
@@ -200,10 +210,13 @@ bool OneCopyRasterBufferProvider::IsResourcePremultiplied() const {
 }
 
 bool OneCopyRasterBufferProvider::CanPartialRasterIntoProvidedResource() const {
-  // While OneCopyRasterBufferProvider has an internal partial raster
-  // implementation, it cannot directly partial raster into the externally
-  // owned resource provided in AcquireBufferForRaster.
-  return false;
+  // Only the dirty rect of the staging buffer is copied into a resource that
+  // already holds the previous content.
+  return use_partial_raster_;
+}
+
+bool OneCopyRasterBufferProvider::CanRasterIntoCompressedResource() const {
+  return use_compressed_resources_;
 }
 
 bool OneCopyRasterBufferProvider::IsResourceReadyToDraw(
@@ -263,7 +276,14 @@ gpu::SyncToken OneCopyRasterBufferProvider::PlaybackAndCopyOnWorkerThread(
     const gfx::ColorSpace& color_space,
     const RasterSource::PlaybackSettings& playback_settings,
     uint64_t previous_content_id,
-    uint64_t new_content_id) {
+    uint64_t new_content_id,
+    bool resource_has_previous_content) {
+  if (viz::IsResourceFormatCompressed(resource_format)) {
+    return PlaybackAndUploadCompressedOnWorkerThread(
+        mailbox, sync_token, raster_source, raster_full_rect, transform,
+        resource_size, resource_format, color_space, playback_settings);
+  }
+
   std::unique_ptr<StagingBuffer> staging_buffer =
       staging_pool_.AcquireStagingBuffer(resource_size, resource_format,
                                          previous_content_id);
@@ -271,10 +291,20 @@ gpu::SyncToken OneCopyRasterBufferProvider::PlaybackAndCopyOnWorkerThread(
   PlaybackToStagingBuffer(staging_buffer.get(), raster_source, raster_full_rect,
                           raster_dirty_rect, transform, resource_format,
                           color_space, playback_settings, previous_content_id,
-                          new_content_id);
+                          new_content_id, resource_has_previous_content);
+
+  // The copy is done in resource space, where the tile is at the origin.
+  gfx::Rect rect_to_copy(raster_full_rect.size());
+  if (resource_has_previous_content) {
+    gfx::Rect dirty_rect = raster_dirty_rect;
+    dirty_rect.Intersect(raster_full_rect);
+    dirty_rect.Offset(-raster_full_rect.OffsetFromOrigin());
+    if (!dirty_rect.IsEmpty())
+      rect_to_copy = dirty_rect;
+  }
 
   gpu::SyncToken sync_token_after_upload = CopyOnWorkerThread(
-      staging_buffer.get(), raster_source, raster_full_rect, resource_format,
+      staging_buffer.get(), raster_source, rect_to_copy, resource_format,
       resource_size, mailbox, mailbox_texture_target,
       mailbox_texture_is_overlay_candidate, sync_token, color_space);
   staging_pool_.ReleaseStagingBuffer(std::move(staging_buffer));
@@ -291,7 +321,8 @@ void OneCopyRasterBufferProvider::PlaybackToStagingBuffer(
     const gfx::ColorSpace& dst_color_space,
     const RasterSource::PlaybackSettings& playback_settings,
     uint64_t previous_content_id,
-    uint64_t new_content_id) {
+    uint64_t new_content_id,
+    bool resource_has_previous_content) {
   // Allocate GpuMemoryBuffer if necessary. If using partial raster, we
   // must allocate a buffer with BufferUsage CPU_READ_WRITE_PERSISTENT.
   if (!staging_buffer->gpu_memory_buffer) {
@@ -302,11 +333,18 @@ void OneCopyRasterBufferProvider::PlaybackToStagingBuffer(
   }
 
   gfx::Rect playback_rect = raster_full_rect;
+  bool staging_buffer_is_complete = true;
   if (use_partial_raster_ && previous_content_id) {
     // Reduce playback rect to dirty region if the content id of the staging
-    // buffer matches the prevous content id.
-    if (previous_content_id == staging_buffer->content_id)
+    // buffer matches the prevous content id. If it doesn't, but the resource
+    // holds the previous content, only the dirty region is copied out of the
+    // staging buffer, so the rest of it need not be rastered either.
+    if (previous_content_id == staging_buffer->content_id) {
       playback_rect.Intersect(raster_dirty_rect);
+    } else if (resource_has_previous_content) {
+      playback_rect.Intersect(raster_dirty_rect);
+      staging_buffer_is_complete = false;
+    }
   }
 
   // Log a histogram of the percentage of pixels that were saved due to
@@ -350,7 +388,10 @@ void OneCopyRasterBufferProvider::PlaybackToStagingBuffer(
         raster_source, raster_full_rect, playback_rect, transform,
         dst_color_space, /*gpu_compositing=*/true, playback_settings);
     buffer->Unmap();
-    staging_buffer->content_id = new_content_id;
+    // A partially rastered staging buffer can't be reused for partial raster
+    // of a later tile.
+    staging_buffer->content_id =
+        staging_buffer_is_complete ? new_content_id : 0;
   }
 }
 
@@ -445,15 +486,16 @@ gpu::SyncToken OneCopyRasterBufferProvider::CopyOnWorkerThread(
       std::max(1, max_bytes_per_copy_operation_ / bytes_per_row);
   // Align chunk size to 4. Required to support compressed texture formats.
   chunk_size_in_rows = MathUtil::UncheckedRoundUp(chunk_size_in_rows, 4);
-  int y = 0;
-  int height = rect_to_copy.height();
-  while (y < height) {
+  int x = rect_to_copy.x();
+  int y = rect_to_copy.y();
+  int bottom = rect_to_copy.bottom();
+  while (y < bottom) {
     // Copy at most |chunk_size_in_rows|.
-    int rows_to_copy = std::min(chunk_size_in_rows, height - y);
+    int rows_to_copy = std::min(chunk_size_in_rows, bottom - y);
     DCHECK_GT(rows_to_copy, 0);
 
     ri->CopySubTexture(staging_buffer->mailbox, *mailbox,
-                       mailbox_texture_target, 0, y, 0, y, rect_to_copy.width(),
+                       mailbox_texture_target, x, y, x, y, rect_to_copy.width(),
                        rows_to_copy);
     y += rows_to_copy;
 
@@ -483,6 +525,50 @@ gpu::SyncToken OneCopyRasterBufferProvider::CopyOnWorkerThread(
   return out_sync_token;
 }
 
+gpu::SyncToken
+OneCopyRasterBufferProvider::PlaybackAndUploadCompressedOnWorkerThread(
+    gpu::Mailbox* mailbox,
+    const gpu::SyncToken& sync_token,
+    const RasterSource* raster_source,
+    const gfx::Rect& raster_full_rect,
+    const gfx::AxisTransform2d& transform,
+    const gfx::Size& resource_size,
+    viz::ResourceFormat resource_format,
+    const gfx::ColorSpace& color_space,
+    const RasterSource::PlaybackSettings& playback_settings) {
+  TRACE_EVENT0("cc",
+               "OneCopyRasterBufferProvider::"
+               "PlaybackAndUploadCompressedOnWorkerThread");
+  // Compressed resources are always rastered and encoded in full, on this
+  // worker thread. They are not staged in GpuMemoryBuffers.
+  std::vector<uint8_t> pixels(
+      viz::ResourceSizes::CheckedSizeInBytes<size_t>(resource_size,
+                                                     resource_format));
+  RasterBufferProvider::PlaybackToMemory(
+      pixels.data(), resource_format, resource_size, /*stride=*/0,
+      raster_source, raster_full_rect, raster_full_rect, transform,
+      color_space, /*gpu_compositing=*/true, playback_settings);
+
+  // The content of a shared image can only be provided when it is created, so
+  // the shared image is replaced by one with the new content.
+  auto* sii = worker_context_provider_->SharedImageInterface();
+  DCHECK(sii);
+  if (!mailbox->IsZero())
+    sii->DestroySharedImage(sync_token, *mailbox);
+  *mailbox = sii->CreateSharedImage(
+      resource_format, resource_size, color_space,
+      gpu::SHARED_IMAGE_USAGE_DISPLAY, base::span<const uint8_t>(pixels));
+
+  // Generate the sync token on the worker context, like after a copy, so that
+  // it can be used to tell whether the resource is ready to draw.
+  viz::RasterContextProvider::ScopedRasterContextLock scoped_context(
+      worker_context_provider_);
+  gpu::raster::RasterInterface* ri = scoped_context.RasterInterface();
+  DCHECK(ri);
+  ri->WaitSyncTokenCHROMIUM(sii->GenUnverifiedSyncToken().GetConstData());
+  return viz::ClientResourceProvider::GenerateSyncTokenHelper(ri);
+}
+
 gfx::BufferUsage OneCopyRasterBufferProvider::StagingBufferUsage() const {
   return use_partial_raster_
              ? gfx::BufferUsage::GPU_READ_CPU_READ_WRITE_PERSISTENT
@@ -37,7 +37,8 @@ class CC_EXPORT OneCopyRasterBufferProvider : public RasterBufferProvider {
       bool use_partial_raster,
       bool use_gpu_memory_buffer_resources,
       int max_staging_buffer_usage_in_bytes,
-      viz::ResourceFormat tile_format);
+      viz::ResourceFormat tile_format,
+      bool use_compressed_resources);
   OneCopyRasterBufferProvider(const OneCopyRasterBufferProvider&) = delete;
   ~OneCopyRasterBufferProvider() override;
 
@@ -54,6 +55,7 @@ class CC_EXPORT OneCopyRasterBufferProvider : public RasterBufferProvider {
   bool IsResourceSwizzleRequired() const override;
   bool IsResourcePremultiplied() const override;
   bool CanPartialRasterIntoProvidedResource() const override;
+  bool CanRasterIntoCompressedResource() const override;
   bool IsResourceReadyToDraw(
       const ResourcePool::InUsePoolResource& resource) const override;
   uint64_t SetReadyToDrawCallback(
@@ -78,7 +80,8 @@ class CC_EXPORT OneCopyRasterBufferProvider : public RasterBufferProvider {
       const gfx::ColorSpace& color_space,
       const RasterSource::PlaybackSettings& playback_settings,
       uint64_t previous_content_id,
-      uint64_t new_content_id);
+      uint64_t new_content_id,
+      bool resource_has_previous_content);
 
  private:
   class OneCopyGpuBacking;
@@ -89,7 +92,8 @@ class CC_EXPORT OneCopyRasterBufferProvider : public RasterBufferProvider {
                      gpu::GpuMemoryBufferManager* gpu_memory_buffer_manager,
                      const ResourcePool::InUsePoolResource& in_use_resource,
                      OneCopyGpuBacking* backing,
-                     uint64_t previous_content_id);
+                     uint64_t previous_content_id,
+                     bool resource_has_previous_content);
     RasterBufferImpl(const RasterBufferImpl&) = delete;
     ~RasterBufferImpl() override;
 
@@ -114,6 +118,9 @@ class CC_EXPORT OneCopyRasterBufferProvider : public RasterBufferProvider {
     const viz::ResourceFormat resource_format_;
     const gfx::ColorSpace color_space_;
     const uint64_t previous_content_id_;
+    // Whether |mailbox_| already holds the content of |previous_content_id_|,
+    // in which case only the dirty rect needs to be rastered and copied.
+    const bool resource_has_previous_content_;
     const gpu::SyncToken before_raster_sync_token_;
     gpu::Mailbox mailbox_;
     const GLenum mailbox_texture_target_;
@@ -133,7 +140,8 @@ class CC_EXPORT OneCopyRasterBufferProvider : public RasterBufferProvider {
       const gfx::ColorSpace& dst_color_space,
       const RasterSource::PlaybackSettings& playback_settings,
       uint64_t previous_content_id,
-      uint64_t new_content_id);
+      uint64_t new_content_id,
+      bool resource_has_previous_content);
   gpu::SyncToken CopyOnWorkerThread(StagingBuffer* staging_buffer,
                                     const RasterSource* raster_source,
                                     const gfx::Rect& rect_to_copy,
@@ -144,6 +152,18 @@ class CC_EXPORT OneCopyRasterBufferProvider : public RasterBufferProvider {
                                     bool mailbox_texture_is_overlay_candidate,
                                     const gpu::SyncToken& sync_token,
                                     const gfx::ColorSpace& color_space);
+  // Plays back the raster source into memory, encodes it and uploads it into
+  // a new compressed shared image that replaces |mailbox|.
+  gpu::SyncToken PlaybackAndUploadCompressedOnWorkerThread(
+      gpu::Mailbox* mailbox,
+      const gpu::SyncToken& sync_token,
+      const RasterSource* raster_source,
+      const gfx::Rect& raster_full_rect,
+      const gfx::AxisTransform2d& transform,
+      const gfx::Size& resource_size,
+      viz::ResourceFormat resource_format,
+      const gfx::ColorSpace& color_space,
+      const RasterSource::PlaybackSettings& playback_settings);
   gfx::BufferUsage StagingBufferUsage() const;
 
   viz::ContextProvider* const compositor_context_provider_;
@@ -157,6 +177,7 @@ class CC_EXPORT OneCopyRasterBufferProvider : public RasterBufferProvider {
   int bytes_scheduled_since_last_flush_;
 
   const viz::ResourceFormat tile_format_;
+  const bool use_compressed_resources_;
   StagingBufferPool staging_pool_;
 };
 
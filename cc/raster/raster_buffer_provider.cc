@@ -7,11 +7,13 @@
 #include <stddef.h>
 
 #include "base/trace_event/trace_event.h"
+#include "cc/raster/etc1_encoder.h"
 #include "cc/raster/raster_source.h"
 #include "components/viz/common/resources/platform_color.h"
 #include "components/viz/common/resources/resource_format_utils.h"
 #include "third_party/skia/include/core/SkCanvas.h"
 #include "third_party/skia/include/core/SkMath.h"
+#include "third_party/skia/include/core/SkPixmap.h"
 #include "third_party/skia/include/core/SkSurface.h"
 #include "ui/gfx/geometry/axis_transform2d.h"
 
@@ -28,11 +30,11 @@ bool IsSupportedPlaybackToMemoryFormat(viz::ResourceFormat format) {
     case viz::RGBA_4444:
     case viz::RGBA_8888:
     case viz::BGRA_8888:
+    case viz::ETC1:
       return true;
     case viz::ALPHA_8:
     case viz::LUMINANCE_8:
     case viz::RGB_565:
-    case viz::ETC1:
     case viz::RED_8:
     case viz::LUMINANCE_F16:
     case viz::RGBA_F16:
@@ -126,7 +128,22 @@ void RasterBufferProvider::PlaybackToMemory(
       surface->draw(dst_canvas.get(), 0, 0, &paint);
       return;
     }
-    case viz::ETC1:
+    case viz::ETC1: {
+      // ETC1 has no alpha, so only opaque content is rastered into it. It is
+      // encoded in whole blocks, so |stride| is not used and the full bitmap
+      // is played back.
+      sk_sp<SkSurface> surface = SkSurface::MakeRaster(
+          info.makeAlphaType(kOpaque_SkAlphaType), &surface_props);
+      raster_source->PlaybackToCanvas(surface->getCanvas(), content_size,
+                                      canvas_bitmap_rect, canvas_bitmap_rect,
+                                      transform, playback_settings);
+
+      TRACE_EVENT0("cc", "RasterBufferProvider::PlaybackToMemory::EncodeETC1");
+      SkPixmap pixmap;
+      CHECK(surface->peekPixels(&pixmap));
+      EncodeETC1(pixmap, static_cast<uint8_t*>(memory));
+      return;
+    }
     case viz::ALPHA_8:
     case viz::LUMINANCE_8:
     case viz::RGB_565:
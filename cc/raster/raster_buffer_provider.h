@@ -71,6 +71,11 @@ class CC_EXPORT RasterBufferProvider {
   // the Resource provided in AcquireBufferForRaster.
   virtual bool CanPartialRasterIntoProvidedResource() const = 0;
 
+  // Determine if the RasterBufferProvider can raster opaque tiles into
+  // resources of the compressed format viz::ETC1, instead of the format
+  // returned by GetResourceFormat().
+  virtual bool CanRasterIntoCompressedResource() const = 0;
+
   // Returns true if the indicated resource is ready to draw.
   virtual bool IsResourceReadyToDraw(
       const ResourcePool::InUsePoolResource& resource) const = 0;
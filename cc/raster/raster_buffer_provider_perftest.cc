@@ -365,7 +365,7 @@ class RasterBufferProviderPerfTest
             task_runner_.get(), compositor_context_provider_.get(),
             worker_context_provider_.get(), &gpu_memory_buffer_manager_,
             std::numeric_limits<int>::max(), false, false,
-            std::numeric_limits<int>::max(), viz::RGBA_8888);
+            std::numeric_limits<int>::max(), viz::RGBA_8888, false);
         break;
       case RASTER_BUFFER_PROVIDER_TYPE_GPU:
         Create3dResourceProvider();
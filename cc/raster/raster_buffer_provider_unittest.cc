@@ -168,7 +168,7 @@ class RasterBufferProviderTest
             base::ThreadTaskRunnerHandle::Get().get(), context_provider_.get(),
             worker_context_provider_.get(), &gpu_memory_buffer_manager_,
             kMaxBytesPerCopyOperation, false, false, kMaxStagingBuffers,
-            viz::RGBA_8888);
+            viz::RGBA_8888, false);
         break;
       case RASTER_BUFFER_PROVIDER_TYPE_GPU:
         Create3dResourceProvider();
@@ -524,5 +524,26 @@ INSTANTIATE_TEST_SUITE_P(
                       RASTER_BUFFER_PROVIDER_TYPE_GPU,
                       RASTER_BUFFER_PROVIDER_TYPE_BITMAP));
 
+TEST(OneCopyRasterBufferProviderTest, PartialRasterIntoProvidedResource) {
+  auto context_provider = viz::TestContextProvider::Create();
+  ASSERT_EQ(context_provider->BindToCurrentThread(),
+            gpu::ContextResult::kSuccess);
+  auto worker_context_provider = viz::TestContextProvider::CreateWorker();
+  viz::TestGpuMemoryBufferManager gpu_memory_buffer_manager;
+
+  // The resource is reused for partial raster only when the provider was
+  // created with partial raster enabled.
+  for (bool use_partial_raster : {false, true}) {
+    OneCopyRasterBufferProvider provider(
+        base::ThreadTaskRunnerHandle::Get().get(), context_provider.get(),
+        worker_context_provider.get(), &gpu_memory_buffer_manager,
+        kMaxBytesPerCopyOperation, use_partial_raster, false,
+        kMaxStagingBuffers, viz::RGBA_8888);
+    EXPECT_EQ(use_partial_raster,
+              provider.CanPartialRasterIntoProvidedResource());
+    provider.Shutdown();
+  }
+}
+
 }  // namespace
 }  // namespace cc
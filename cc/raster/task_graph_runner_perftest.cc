@@ -6,6 +6,7 @@
 #include <stdint.h>
 
 #include <memory>
+#include <string>
 #include <vector>
 
 #include "base/memory/ptr_util.h"
@@ -13,6 +14,8 @@
 #include "base/timer/lap_timer.h"
 #include "cc/base/completion_event.h"
 #include "cc/raster/synchronous_task_graph_runner.h"
+#include "cc/raster/task_category.h"
+#include "cc/raster/work_stealing_task_graph_runner.h"
 #include "testing/gtest/include/gtest/gtest.h"
 #include "testing/perf/perf_test.h"
 
@@ -216,6 +219,41 @@ class TaskGraphRunnerPerfTest : public testing::Test {
                            true);
   }
 
+  // Runs |num_tasks| independent foreground tasks on |num_threads| workers.
+  // The tasks don't do any work, so this measures how much the workers contend
+  // for tasks.
+  void RunExecuteTasksOnWorkersTest(const std::string& test_name,
+                                    int num_threads,
+                                    int num_tasks) {
+    WorkStealingTaskGraphRunner task_graph_runner;
+    task_graph_runner.Start(num_threads, "PerfTestWorker");
+    NamespaceToken token = task_graph_runner.GenerateNamespaceToken();
+
+    PerfTaskImpl::Vector tasks;
+    CreateTasks(num_tasks, &tasks);
+
+    TaskGraph graph;
+    Task::Vector completed_tasks;
+
+    timer_.Reset();
+    do {
+      graph.Reset();
+      ResetTasks(tasks);
+      for (auto& task : tasks)
+        graph.nodes.emplace_back(task, TASK_CATEGORY_FOREGROUND, 0u, 0u);
+      task_graph_runner.ScheduleTasks(token, &graph);
+      task_graph_runner.WaitForTasksToFinishRunning(token);
+      task_graph_runner.CollectCompletedTasks(token, &completed_tasks);
+      completed_tasks.clear();
+      timer_.NextLap();
+    } while (!timer_.HasTimeLimitExpired());
+
+    task_graph_runner.Shutdown();
+
+    perf_test::PrintResult("execute_tasks_on_workers", TestModifierString(),
+                           test_name, timer_.LapsPerSecond(), "runs/s", true);
+  }
+
  private:
   static std::string TestModifierString() {
     return std::string("_task_graph_runner");
@@ -312,5 +350,12 @@ TEST_F(TaskGraphRunnerPerfTest, ScheduleAndExecuteTasks) {
   RunScheduleAndExecuteTasksTest("2_32_1", 2, 32, 1);
 }
 
+TEST_F(TaskGraphRunnerPerfTest, ExecuteTasksOnWorkers) {
+  RunExecuteTasksOnWorkersTest("1_32", 1, 32);
+  RunExecuteTasksOnWorkersTest("4_32", 4, 32);
+  RunExecuteTasksOnWorkersTest("4_256", 4, 256);
+  RunExecuteTasksOnWorkersTest("8_256", 8, 256);
+}
+
 }  // namespace
 }  // namespace cc
@@ -0,0 +1,392 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "cc/raster/work_stealing_task_graph_runner.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "base/containers/circular_deque.h"
+#include "base/strings/stringprintf.h"
+#include "base/threading/simple_thread.h"
+#include "base/threading/thread_restrictions.h"
+#include "base/trace_event/trace_event.h"
+#include "build/build_config.h"
+
+namespace cc {
+
+// A worker thread, with the deque of the tasks it has taken from the work
+// queue but not started yet. The deque is in priority order.
+class WorkStealingTaskGraphRunner::Worker : public base::SimpleThread {
+ public:
+  Worker(WorkStealingTaskGraphRunner* runner,
+         const std::string& name,
+         const Options& options,
+         std::vector<TaskCategory> categories,
+         base::ConditionVariable* has_ready_to_run_tasks_cv)
+      : SimpleThread(name, options),
+        runner_(runner),
+        categories_(std::move(categories)),
+        has_ready_to_run_tasks_cv_(has_ready_to_run_tasks_cv) {}
+  Worker(const Worker&) = delete;
+  ~Worker() override = default;
+
+  Worker& operator=(const Worker&) = delete;
+
+  // base::SimpleThread:
+  void Run() override { runner_->RunWorker(this); }
+
+  // Categories this worker runs, in order of priority.
+  const std::vector<TaskCategory>& categories() const { return categories_; }
+  bool is_background() const {
+    return categories_.front() == TASK_CATEGORY_BACKGROUND;
+  }
+  base::ConditionVariable* has_ready_to_run_tasks_cv() const {
+    return has_ready_to_run_tasks_cv_;
+  }
+
+  // Tasks this worker has run, to be completed with the runner's lock. Only
+  // accessed by this worker.
+  std::vector<PrioritizedTask>& run_tasks() { return run_tasks_; }
+
+  // Takes the highest priority task from the deque. Used by this worker.
+  base::Optional<PrioritizedTask> PopTask() {
+    base::AutoLock lock(lock_);
+    if (tasks_.empty())
+      return base::nullopt;
+    PrioritizedTask task = std::move(tasks_.front());
+    tasks_.pop_front();
+    return std::move(task);
+  }
+
+  // Takes the lowest priority task from the deque. Used by other workers, so
+  // that they don't contend with this worker for the front of the deque.
+  base::Optional<PrioritizedTask> StealTask() {
+    base::AutoLock lock(lock_);
+    if (tasks_.empty())
+      return base::nullopt;
+    PrioritizedTask task = std::move(tasks_.back());
+    tasks_.pop_back();
+    return std::move(task);
+  }
+
+  void PushTask(PrioritizedTask task) {
+    base::AutoLock lock(lock_);
+    tasks_.push_back(std::move(task));
+  }
+
+  bool HasTasks() {
+    base::AutoLock lock(lock_);
+    return !tasks_.empty();
+  }
+
+ private:
+  WorkStealingTaskGraphRunner* const runner_;
+  const std::vector<TaskCategory> categories_;
+  base::ConditionVariable* const has_ready_to_run_tasks_cv_;
+  std::vector<PrioritizedTask> run_tasks_;
+
+  base::Lock lock_;
+  base::circular_deque<PrioritizedTask> tasks_;
+};
+
+constexpr size_t WorkStealingTaskGraphRunner::kMaxTasksPerBatch;
+
+WorkStealingTaskGraphRunner::WorkStealingTaskGraphRunner()
+    : has_ready_to_run_foreground_tasks_cv_(&lock_),
+      has_ready_to_run_background_tasks_cv_(&lock_),
+      has_namespaces_with_finished_running_tasks_cv_(&lock_) {
+  has_ready_to_run_foreground_tasks_cv_.declare_only_used_while_idle();
+  has_ready_to_run_background_tasks_cv_.declare_only_used_while_idle();
+}
+
+WorkStealingTaskGraphRunner::~WorkStealingTaskGraphRunner() {
+  DCHECK(workers_.empty());
+}
+
+void WorkStealingTaskGraphRunner::Start(int num_foreground_threads,
+                                        const std::string& thread_name_prefix) {
+  DCHECK(workers_.empty());
+  DCHECK_GT(num_foreground_threads, 0);
+
+  for (int i = 0; i < num_foreground_threads; i++) {
+    workers_.push_back(std::make_unique<Worker>(
+        this, base::StringPrintf("%s%d", thread_name_prefix.c_str(), i + 1),
+        base::SimpleThread::Options(),
+        std::vector<TaskCategory>{TASK_CATEGORY_NONCONCURRENT_FOREGROUND,
+                                  TASK_CATEGORY_FOREGROUND},
+        &has_ready_to_run_foreground_tasks_cv_));
+  }
+
+  base::SimpleThread::Options background_options;
+#if !defined(OS_MACOSX)
+  background_options.priority = base::ThreadPriority::BACKGROUND;
+#endif
+  workers_.push_back(std::make_unique<Worker>(
+      this, thread_name_prefix + "Background", background_options,
+      std::vector<TaskCategory>{TASK_CATEGORY_BACKGROUND},
+      &has_ready_to_run_background_tasks_cv_));
+
+  // Workers look at each other, so start them once they all exist.
+  for (auto& worker : workers_)
+    worker->StartAsync();
+}
+
+void WorkStealingTaskGraphRunner::Shutdown() {
+  {
+    base::AutoLock lock(lock_);
+
+    DCHECK(!work_queue_.HasReadyToRunTasks());
+    DCHECK(!work_queue_.HasAnyNamespaces());
+
+    DCHECK(!shutdown_);
+    shutdown_ = true;
+
+    // Wake up all workers so they exit.
+    has_ready_to_run_foreground_tasks_cv_.Broadcast();
+    has_ready_to_run_background_tasks_cv_.Broadcast();
+  }
+  for (auto& worker : workers_)
+    worker->Join();
+  workers_.clear();
+}
+
+NamespaceToken WorkStealingTaskGraphRunner::GenerateNamespaceToken() {
+  base::AutoLock lock(lock_);
+  return work_queue_.GenerateNamespaceToken();
+}
+
+void WorkStealingTaskGraphRunner::ScheduleTasks(NamespaceToken token,
+                                                TaskGraph* graph) {
+  TRACE_EVENT2("disabled-by-default-cc.debug",
+               "WorkStealingTaskGraphRunner::ScheduleTasks", "num_nodes",
+               graph->nodes.size(), "num_edges", graph->edges.size());
+
+  DCHECK(token.IsValid());
+  DCHECK(!TaskGraphWorkQueue::DependencyMismatch(graph));
+
+  {
+    base::AutoLock lock(lock_);
+
+    DCHECK(!shutdown_);
+
+    work_queue_.ScheduleTasks(token, graph);
+
+    // There may be more work available, so wake up another worker thread.
+    SignalHasReadyToRunTasksWithLockAcquired();
+  }
+}
+
+void WorkStealingTaskGraphRunner::WaitForTasksToFinishRunning(
+    NamespaceToken token) {
+  TRACE_EVENT0("disabled-by-default-cc.debug",
+               "WorkStealingTaskGraphRunner::WaitForTasksToFinishRunning");
+
+  DCHECK(token.IsValid());
+
+  {
+    base::AutoLock lock(lock_);
+    // http://crbug.com/902823
+    base::ScopedAllowBaseSyncPrimitivesOutsideBlockingScope allow_wait;
+
+    auto* task_namespace = work_queue_.GetNamespaceForToken(token);
+
+    if (!task_namespace)
+      return;
+
+    while (!work_queue_.HasFinishedRunningTasksInNamespace(task_namespace))
+      has_namespaces_with_finished_running_tasks_cv_.Wait();
+
+    // There may be other namespaces that have finished running tasks, so wake
+    // up another origin thread.
+    has_namespaces_with_finished_running_tasks_cv_.Signal();
+  }
+}
+
+void WorkStealingTaskGraphRunner::CollectCompletedTasks(
+    NamespaceToken token,
+    Task::Vector* completed_tasks) {
+  TRACE_EVENT0("disabled-by-default-cc.debug",
+               "WorkStealingTaskGraphRunner::CollectCompletedTasks");
+
+  DCHECK(token.IsValid());
+
+  {
+    base::AutoLock lock(lock_);
+    work_queue_.CollectCompletedTasks(token, completed_tasks);
+  }
+}
+
+void WorkStealingTaskGraphRunner::RunWorker(Worker* worker) {
+  while (true) {
+    base::Optional<PrioritizedTask> task = worker->PopTask();
+    if (!task && !worker->is_background())
+      task = StealTask(worker);
+
+    if (!task) {
+      base::AutoLock lock(lock_);
+
+      // Complete the tasks that were run before this worker waits, so that
+      // their dependents can run.
+      CompleteTasksWithLockAcquired(worker);
+
+      task = TakeTasksWithLockAcquired(worker);
+      if (!task) {
+        // Another worker may have taken a batch of tasks since this worker
+        // looked for tasks to steal.
+        if (!worker->is_background() && HasQueuedTasksWithLockAcquired())
+          continue;
+
+        // Exit when shutdown is set and no more tasks are pending.
+        if (shutdown_)
+          break;
+
+        // Wait for more tasks.
+        worker->has_ready_to_run_tasks_cv()->Wait();
+        continue;
+      }
+    }
+
+    TRACE_EVENT1("toplevel", "TaskGraphRunner::RunTask", "source_frame_number_",
+                 task->task->frame_number());
+    task->task->RunOnWorkerThread();
+    worker->run_tasks().push_back(std::move(*task));
+
+    // Complete the task right away unless that would wait for another thread.
+    if (lock_.Try()) {
+      CompleteTasksWithLockAcquired(worker);
+      lock_.Release();
+    }
+  }
+}
+
+base::Optional<WorkStealingTaskGraphRunner::PrioritizedTask>
+WorkStealingTaskGraphRunner::StealTask(Worker* worker) {
+  // The last worker is the background worker, which has no deque of tasks.
+  size_t num_foreground_workers = workers_.size() - 1;
+  size_t index = std::find_if(workers_.begin(), workers_.end(),
+                              [worker](const std::unique_ptr<Worker>& other) {
+                                return other.get() == worker;
+                              }) -
+                 workers_.begin();
+  DCHECK_LT(index, num_foreground_workers);
+
+  // Start with the next worker, so that workers don't all steal from the
+  // first one.
+  for (size_t i = 1; i < num_foreground_workers; ++i) {
+    Worker* victim = workers_[(index + i) % num_foreground_workers].get();
+    if (auto task = victim->StealTask())
+      return task;
+  }
+  return base::nullopt;
+}
+
+base::Optional<WorkStealingTaskGraphRunner::PrioritizedTask>
+WorkStealingTaskGraphRunner::TakeTasksWithLockAcquired(Worker* worker) {
+  lock_.AssertAcquired();
+
+  for (TaskCategory category : worker->categories()) {
+    if (!ShouldRunTaskForCategoryWithLockAcquired(category))
+      continue;
+
+    PrioritizedTask task = work_queue_.GetNextTaskToRun(category);
+
+    // Nonconcurrent and background tasks run one at a time, so they are never
+    // queued where they could be stolen.
+    if (category == TASK_CATEGORY_FOREGROUND) {
+      for (size_t i = 1; i < kMaxTasksPerBatch &&
+                         work_queue_.HasReadyToRunTasksForCategory(category);
+           ++i) {
+        worker->PushTask(work_queue_.GetNextTaskToRun(category));
+      }
+    }
+
+    // There may be more work available, so wake up another worker thread.
+    SignalHasReadyToRunTasksWithLockAcquired();
+    return std::move(task);
+  }
+  return base::nullopt;
+}
+
+void WorkStealingTaskGraphRunner::CompleteTasksWithLockAcquired(
+    Worker* worker) {
+  lock_.AssertAcquired();
+
+  if (worker->run_tasks().empty())
+    return;
+
+  for (PrioritizedTask& task : worker->run_tasks()) {
+    auto* task_namespace = task.task_namespace;
+    work_queue_.CompleteTask(std::move(task));
+
+    // If namespace has finished running all tasks, wake up origin threads.
+    if (work_queue_.HasFinishedRunningTasksInNamespace(task_namespace))
+      has_namespaces_with_finished_running_tasks_cv_.Signal();
+  }
+  worker->run_tasks().clear();
+
+  // The completed tasks may have dependents that are now ready to run, and
+  // no longer prevent other categories from running.
+  SignalHasReadyToRunTasksWithLockAcquired();
+}
+
+bool WorkStealingTaskGraphRunner::HasQueuedTasksWithLockAcquired() {
+  lock_.AssertAcquired();
+
+  // Tasks are only queued with |lock_| acquired, so this doesn't miss tasks
+  // that are queued after it returns false.
+  return std::any_of(workers_.begin(), workers_.end(),
+                     [](const std::unique_ptr<Worker>& worker) {
+                       return worker->HasTasks();
+                     });
+}
+
+bool WorkStealingTaskGraphRunner::ShouldRunTaskForCategoryWithLockAcquired(
+    TaskCategory category) {
+  lock_.AssertAcquired();
+
+  if (!work_queue_.HasReadyToRunTasksForCategory(category))
+    return false;
+
+  if (category == TASK_CATEGORY_BACKGROUND) {
+    // Only run background tasks if there are no foreground tasks running or
+    // ready to run. Queued foreground tasks count as running.
+    size_t num_running_foreground_tasks =
+        work_queue_.NumRunningTasksForCategory(
+            TASK_CATEGORY_NONCONCURRENT_FOREGROUND) +
+        work_queue_.NumRunningTasksForCategory(TASK_CATEGORY_FOREGROUND);
+    bool has_ready_to_run_foreground_tasks =
+        work_queue_.HasReadyToRunTasksForCategory(
+            TASK_CATEGORY_NONCONCURRENT_FOREGROUND) ||
+        work_queue_.HasReadyToRunTasksForCategory(TASK_CATEGORY_FOREGROUND);
+
+    if (num_running_foreground_tasks > 0 || has_ready_to_run_foreground_tasks)
+      return false;
+  }
+
+  // Enforce that only one nonconcurrent task runs at a time.
+  if (category == TASK_CATEGORY_NONCONCURRENT_FOREGROUND &&
+      work_queue_.NumRunningTasksForCategory(
+          TASK_CATEGORY_NONCONCURRENT_FOREGROUND) > 0) {
+    return false;
+  }
+
+  return true;
+}
+
+void WorkStealingTaskGraphRunner::SignalHasReadyToRunTasksWithLockAcquired() {
+  lock_.AssertAcquired();
+
+  if (ShouldRunTaskForCategoryWithLockAcquired(TASK_CATEGORY_FOREGROUND) ||
+      ShouldRunTaskForCategoryWithLockAcquired(
+          TASK_CATEGORY_NONCONCURRENT_FOREGROUND) ||
+      HasQueuedTasksWithLockAcquired()) {
+    has_ready_to_run_foreground_tasks_cv_.Signal();
+  }
+
+  if (ShouldRunTaskForCategoryWithLockAcquired(TASK_CATEGORY_BACKGROUND))
+    has_ready_to_run_background_tasks_cv_.Signal();
+}
+
+}  // namespace cc
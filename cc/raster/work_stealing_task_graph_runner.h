@@ -0,0 +1,105 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef CC_RASTER_WORK_STEALING_TASK_GRAPH_RUNNER_H_
+#define CC_RASTER_WORK_STEALING_TASK_GRAPH_RUNNER_H_
+
+#include <stddef.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base/optional.h"
+#include "base/synchronization/condition_variable.h"
+#include "base/synchronization/lock.h"
+#include "cc/raster/task_category.h"
+#include "cc/raster/task_graph_runner.h"
+#include "cc/raster/task_graph_work_queue.h"
+
+namespace cc {
+
+// Runs TaskGraphs on a pool of foreground worker threads and a background
+// worker thread, with the TaskCategory semantics of the renderer's
+// CategorizedWorkerPool:
+//
+//   - TASK_CATEGORY_NONCONCURRENT_FOREGROUND tasks run one at a time.
+//   - TASK_CATEGORY_FOREGROUND tasks run concurrently on foreground workers.
+//   - TASK_CATEGORY_BACKGROUND tasks run on the background worker while no
+//     foreground tasks are running or ready to run.
+//
+// Instead of taking |lock_| for each task, foreground workers take batches of
+// ready to run foreground tasks from the TaskGraphWorkQueue and keep them in a
+// deque of their own, which idle workers steal from. Workers also complete
+// tasks opportunistically, whenever |lock_| is free. Within a category tasks
+// still start in priority order, except that up to kMaxTasksPerBatch tasks per
+// worker are taken ahead of tasks that are scheduled later. Tasks that have
+// been taken can't be canceled, like running tasks.
+class CC_EXPORT WorkStealingTaskGraphRunner : public TaskGraphRunner {
+ public:
+  // The largest number of foreground tasks a worker takes at once.
+  static constexpr size_t kMaxTasksPerBatch = 4;
+
+  WorkStealingTaskGraphRunner();
+  WorkStealingTaskGraphRunner(const WorkStealingTaskGraphRunner&) = delete;
+  ~WorkStealingTaskGraphRunner() override;
+
+  WorkStealingTaskGraphRunner& operator=(const WorkStealingTaskGraphRunner&) =
+      delete;
+
+  // Overridden from TaskGraphRunner:
+  NamespaceToken GenerateNamespaceToken() override;
+  void ScheduleTasks(NamespaceToken token, TaskGraph* graph) override;
+  void WaitForTasksToFinishRunning(NamespaceToken token) override;
+  void CollectCompletedTasks(NamespaceToken token,
+                             Task::Vector* completed_tasks) override;
+
+  // Starts |num_foreground_threads| foreground workers and the background
+  // worker.
+  void Start(int num_foreground_threads, const std::string& thread_name_prefix);
+  // All namespaces must have finished running their tasks.
+  void Shutdown();
+
+ private:
+  class Worker;
+  using PrioritizedTask = TaskGraphWorkQueue::PrioritizedTask;
+
+  // Runs tasks on |worker| until shutdown.
+  void RunWorker(Worker* worker);
+
+  // Steals a task from the deque of another foreground worker.
+  base::Optional<PrioritizedTask> StealTask(Worker* worker);
+
+  // Takes the next task for |worker| from |work_queue_|, and for foreground
+  // tasks a batch of tasks that follow it into the deque of |worker|.
+  base::Optional<PrioritizedTask> TakeTasksWithLockAcquired(Worker* worker);
+
+  // Completes the tasks |worker| has run since it last completed tasks.
+  void CompleteTasksWithLockAcquired(Worker* worker);
+
+  bool HasQueuedTasksWithLockAcquired();
+  bool ShouldRunTaskForCategoryWithLockAcquired(TaskCategory category);
+  void SignalHasReadyToRunTasksWithLockAcquired();
+
+  // Foreground workers, followed by the background worker. This is not
+  // modified while the workers are running.
+  std::vector<std::unique_ptr<Worker>> workers_;
+
+  // Lock to exclusively access all the following members. Workers take it
+  // before the locks of their deques.
+  base::Lock lock_;
+  TaskGraphWorkQueue work_queue_;
+  base::ConditionVariable has_ready_to_run_foreground_tasks_cv_;
+  base::ConditionVariable has_ready_to_run_background_tasks_cv_;
+  // Condition variable that is waited on by origin threads until a namespace
+  // has finished running all associated tasks.
+  base::ConditionVariable has_namespaces_with_finished_running_tasks_cv_;
+  // Set during shutdown. Tells workers to return when no more tasks are
+  // pending.
+  bool shutdown_ = false;
+};
+
+}  // namespace cc
+
+#endif  // CC_RASTER_WORK_STEALING_TASK_GRAPH_RUNNER_H_
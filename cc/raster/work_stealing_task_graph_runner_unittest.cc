@@ -0,0 +1,56 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "cc/raster/work_stealing_task_graph_runner.h"
+
+#include "cc/test/task_graph_runner_test_template.h"
+
+namespace cc {
+namespace {
+
+template <int NumThreads>
+class WorkStealingTaskGraphRunnerTestDelegate {
+ public:
+  WorkStealingTaskGraphRunnerTestDelegate() = default;
+
+  void StartTaskGraphRunner() {
+    work_stealing_task_graph_runner_.Start(
+        NumThreads, "WorkStealingTaskGraphRunnerTestDelegate");
+  }
+
+  TaskGraphRunner* GetTaskGraphRunner() {
+    return &work_stealing_task_graph_runner_;
+  }
+
+  void StopTaskGraphRunner() {}
+
+  ~WorkStealingTaskGraphRunnerTestDelegate() {
+    work_stealing_task_graph_runner_.Shutdown();
+  }
+
+ private:
+  WorkStealingTaskGraphRunner work_stealing_task_graph_runner_;
+};
+
+// Multithreaded tests.
+INSTANTIATE_TYPED_TEST_SUITE_P(WorkStealingTaskGraphRunner_1_Threads,
+                               TaskGraphRunnerTest,
+                               WorkStealingTaskGraphRunnerTestDelegate<1>);
+INSTANTIATE_TYPED_TEST_SUITE_P(WorkStealingTaskGraphRunner_2_Threads,
+                               TaskGraphRunnerTest,
+                               WorkStealingTaskGraphRunnerTestDelegate<2>);
+INSTANTIATE_TYPED_TEST_SUITE_P(WorkStealingTaskGraphRunner_4_Threads,
+                               TaskGraphRunnerTest,
+                               WorkStealingTaskGraphRunnerTestDelegate<4>);
+INSTANTIATE_TYPED_TEST_SUITE_P(WorkStealingTaskGraphRunner_5_Threads,
+                               TaskGraphRunnerTest,
+                               WorkStealingTaskGraphRunnerTestDelegate<5>);
+
+// Single threaded tests.
+INSTANTIATE_TYPED_TEST_SUITE_P(WorkStealingTaskGraphRunner,
+                               SingleThreadTaskGraphRunnerTest,
+                               WorkStealingTaskGraphRunnerTestDelegate<1>);
+
+}  // namespace
+}  // namespace cc
@@ -217,6 +217,11 @@ bool ZeroCopyRasterBufferProvider::CanPartialRasterIntoProvidedResource()
   return false;
 }
 
+bool ZeroCopyRasterBufferProvider::CanRasterIntoCompressedResource() const {
+  // GpuMemoryBuffers can't hold compressed formats.
+  return false;
+}
+
 bool ZeroCopyRasterBufferProvider::IsResourceReadyToDraw(
     const ResourcePool::InUsePoolResource& resource) const {
   // Zero-copy resources are immediately ready to draw.
@@ -12,6 +12,8 @@
 #include "base/stl_util.h"
 #include "base/trace_event/trace_event.h"
 #include "cc/debug/rendering_stats_instrumentation.h"
+#include "components/viz/common/quads/compositor_frame_metadata.h"
+#include "ui/gfx/presentation_feedback.h"
 
 namespace cc {
 
@@ -46,6 +48,9 @@ class CompositorTimingHistory::UMAReporter {
   virtual void AddActivateDuration(base::TimeDelta duration) = 0;
   virtual void AddDrawDuration(base::TimeDelta duration) = 0;
   virtual void AddSubmitToAckLatency(base::TimeDelta duration) = 0;
+  virtual void AddSubmitToPresentationLatency(base::TimeDelta duration) = 0;
+  virtual void AddBeginMainFrameToPresentationLatency(
+      base::TimeDelta duration) = 0;
 
   // crbug.com/758439: the following 3 functions are used to report timing in
   // certain conditions targeting blink / compositor animations.
@@ -79,6 +84,11 @@ const double kDrawEstimationPercentile = 90.0;
 constexpr base::TimeDelta kSubmitAckWatchdogTimeout =
     base::TimeDelta::FromSeconds(8);
 
+// The most frames to keep the stages of until they are presented. Frames are
+// normally presented within a few vsyncs, so this only limits the memory used
+// when presentation feedback doesn't arrive, e.g. for frames that get dropped.
+constexpr size_t kMaxSubmittedFrameStages = 25;
+
 // This macro is deprecated since its bucket count uses too much bandwidth.
 // It also has sub-optimal range and bucket distribution.
 // TODO(brianderson): Delete this macro and associated UMAs once there is
@@ -130,6 +140,14 @@ const int kUMADurationBuckets[] = {
                          kUMAVSyncBuckets + base::size(kUMAVSyncBuckets))); \
   } while (false)
 
+#define UMA_HISTOGRAM_CUSTOM_TIMES_PRESENTATION(name, sample)                \
+  do {                                                                      \
+    UMA_HISTOGRAM_CUSTOM_ENUMERATION(                                       \
+        name, sample.InMicroseconds(),                                      \
+        std::vector<int>(kUMAVSyncBuckets,                                  \
+                         kUMAVSyncBuckets + base::size(kUMAVSyncBuckets))); \
+  } while (false)
+
 #define UMA_HISTOGRAM_CUSTOM_TIMES_DURATION_SUFFIX(name, suffix, sample) \
   do {                                                                   \
     UMA_HISTOGRAM_CUSTOM_ENUMERATION(                                    \
@@ -268,6 +286,17 @@ class RendererUMAReporter : public CompositorTimingHistory::UMAReporter {
                                         duration);
   }
 
+  void AddSubmitToPresentationLatency(base::TimeDelta duration) override {
+    UMA_HISTOGRAM_CUSTOM_TIMES_PRESENTATION(
+        "Scheduling.Renderer.SubmitToPresentationLatency", duration);
+  }
+
+  void AddBeginMainFrameToPresentationLatency(
+      base::TimeDelta duration) override {
+    UMA_HISTOGRAM_CUSTOM_TIMES_PRESENTATION(
+        "Scheduling.Renderer.BeginMainFrameToPresentationLatency", duration);
+  }
+
   void AddMainAndImplFrameTimeDelta(base::TimeDelta delta) override {
     UMA_HISTOGRAM_CUSTOM_TIMES_VSYNC_ALIGNED(
         "Scheduling.Renderer.MainAndImplFrameTimeDelta", delta);
@@ -359,6 +388,17 @@ class BrowserUMAReporter : public CompositorTimingHistory::UMAReporter {
                                         duration);
   }
 
+  void AddSubmitToPresentationLatency(base::TimeDelta duration) override {
+    UMA_HISTOGRAM_CUSTOM_TIMES_PRESENTATION(
+        "Scheduling.Browser.SubmitToPresentationLatency", duration);
+  }
+
+  void AddBeginMainFrameToPresentationLatency(
+      base::TimeDelta duration) override {
+    UMA_HISTOGRAM_CUSTOM_TIMES_PRESENTATION(
+        "Scheduling.Browser.BeginMainFrameToPresentationLatency", duration);
+  }
+
   void AddMainAndImplFrameTimeDelta(base::TimeDelta delta) override {}
 };
 
@@ -393,6 +433,9 @@ class NullUMAReporter : public CompositorTimingHistory::UMAReporter {
   void AddActivateDuration(base::TimeDelta duration) override {}
   void AddDrawDuration(base::TimeDelta duration) override {}
   void AddSubmitToAckLatency(base::TimeDelta duration) override {}
+  void AddSubmitToPresentationLatency(base::TimeDelta duration) override {}
+  void AddBeginMainFrameToPresentationLatency(
+      base::TimeDelta duration) override {}
   void AddMainAndImplFrameTimeDelta(base::TimeDelta delta) override {}
 };
 
@@ -645,6 +688,11 @@ void CompositorTimingHistory::DidCommit() {
 
   SetBeginMainFrameCommittingContinuously(true);
   base::TimeTicks begin_main_frame_end_time = Now();
+  pending_tree_stages_ = FrameStageTimes();
+  pending_tree_stages_.begin_main_frame_sent = begin_main_frame_sent_time_;
+  pending_tree_stages_.begin_main_frame_start = begin_main_frame_start_time_;
+  pending_tree_stages_.commit_start = commit_start_time_;
+  pending_tree_stages_.commit_end = begin_main_frame_end_time;
   DidBeginMainFrame(begin_main_frame_end_time);
   commit_duration_history_.InsertSample(begin_main_frame_end_time -
                                         commit_start_time_);
@@ -724,6 +772,7 @@ void CompositorTimingHistory::WillInvalidateOnImplSide() {
 
   pending_tree_is_impl_side_ = true;
   pending_tree_creation_time_ = base::TimeTicks::Now();
+  pending_tree_stages_ = FrameStageTimes();
 }
 
 void CompositorTimingHistory::WillPrepareTiles() {
@@ -747,6 +796,7 @@ void CompositorTimingHistory::ReadyToActivate() {
   DCHECK_EQ(pending_tree_ready_to_activate_time_, base::TimeTicks());
 
   pending_tree_ready_to_activate_time_ = Now();
+  pending_tree_stages_.ready_to_activate = pending_tree_ready_to_activate_time_;
   if (pending_tree_is_impl_side_) {
     base::TimeDelta time_since_invalidation =
         pending_tree_ready_to_activate_time_ - pending_tree_creation_time_;
@@ -778,6 +828,7 @@ void CompositorTimingHistory::WillActivate() {
   DCHECK_EQ(base::TimeTicks(), activate_start_time_);
 
   activate_start_time_ = Now();
+  pending_tree_stages_.activate_start = activate_start_time_;
 
   // Its possible to activate the pending tree before it is ready for
   // activation, for instance in the case of a context loss or visibility
@@ -796,7 +847,8 @@ void CompositorTimingHistory::WillActivate() {
 
 void CompositorTimingHistory::DidActivate() {
   DCHECK_NE(base::TimeTicks(), activate_start_time_);
-  base::TimeDelta activate_duration = Now() - activate_start_time_;
+  base::TimeTicks activate_end_time = Now();
+  base::TimeDelta activate_duration = activate_end_time - activate_start_time_;
 
   uma_reporter_->AddActivateDuration(activate_duration);
   if (enabled_)
@@ -806,6 +858,9 @@ void CompositorTimingHistory::DidActivate() {
   if (!using_synchronous_renderer_compositor_)
     DCHECK_EQ(base::TimeTicks(), active_tree_main_frame_time_);
   active_tree_main_frame_time_ = pending_tree_main_frame_time_;
+  active_tree_stages_ = pending_tree_stages_;
+  active_tree_stages_.activate_end = activate_end_time;
+  pending_tree_stages_ = FrameStageTimes();
 
   activate_start_time_ = base::TimeTicks();
   pending_tree_main_frame_time_ = base::TimeTicks();
@@ -905,10 +960,21 @@ void CompositorTimingHistory::DidDraw(
   draw_start_time_ = base::TimeTicks();
 }
 
-void CompositorTimingHistory::DidSubmitCompositorFrame() {
+void CompositorTimingHistory::DidSubmitCompositorFrame(uint32_t frame_token) {
   DCHECK_EQ(base::TimeTicks(), submit_start_time_);
   submit_start_time_ = Now();
   submit_ack_watchdog_enabled_ = true;
+
+  // Only the first frame drawn from an active tree shows its main frame and
+  // activation, later ones are attributed to drawing alone.
+  FrameStageTimes stages = active_tree_stages_;
+  stages.draw_start = draw_start_time_;
+  stages.submit = submit_start_time_;
+  active_tree_stages_ = FrameStageTimes();
+
+  if (submitted_frame_stages_.size() == kMaxSubmittedFrameStages)
+    submitted_frame_stages_.pop_front();
+  submitted_frame_stages_.emplace_back(frame_token, stages);
 }
 
 void CompositorTimingHistory::DidReceiveCompositorFrameAck() {
@@ -920,6 +986,70 @@ void CompositorTimingHistory::DidReceiveCompositorFrameAck() {
   submit_start_time_ = base::TimeTicks();
 }
 
+void CompositorTimingHistory::DidPresentCompositorFrame(
+    uint32_t frame_token,
+    const gfx::PresentationFeedback& feedback) {
+  // Feedback for a frame implies that the frames submitted before it won't
+  // get any.
+  while (!submitted_frame_stages_.empty()) {
+    const auto& submitted = submitted_frame_stages_.front();
+    if (viz::FrameTokenGT(submitted.first, frame_token))
+      break;
+    if (submitted.first == frame_token &&
+        !(feedback.flags & gfx::PresentationFeedback::kFailure)) {
+      ReportFrameStages(submitted.first, submitted.second, feedback.timestamp);
+    }
+    submitted_frame_stages_.pop_front();
+  }
+}
+
+void CompositorTimingHistory::ReportFrameStages(
+    uint32_t frame_token,
+    const FrameStageTimes& stages,
+    base::TimeTicks presentation_time) {
+  // The time from submission to presentation covers surface aggregation,
+  // drawing and swapping in the display compositor.
+  uma_reporter_->AddSubmitToPresentationLatency(presentation_time -
+                                                stages.submit);
+  if (!stages.begin_main_frame_sent.is_null()) {
+    uma_reporter_->AddBeginMainFrameToPresentationLatency(
+        presentation_time - stages.begin_main_frame_sent);
+  }
+
+  // Lay the stages out as a track, one step per stage, for the trace viewer.
+  const struct {
+    base::TimeTicks time;
+    const char* name;
+  } steps[] = {
+      {stages.begin_main_frame_sent, "BeginMainFrameQueue"},
+      {stages.begin_main_frame_start, "BeginMainFrame"},
+      {stages.commit_start, "Commit"},
+      {stages.commit_end, "Raster"},
+      {stages.ready_to_activate, "WaitForActivation"},
+      {stages.activate_start, "Activation"},
+      {stages.activate_end, "WaitForDraw"},
+      {stages.draw_start, "Draw"},
+      {stages.submit, "SubmitToPresentation"},
+  };
+  bool began = false;
+  for (const auto& step : steps) {
+    if (step.time.is_null())
+      continue;
+    if (!began) {
+      TRACE_EVENT_ASYNC_BEGIN_WITH_TIMESTAMP0(
+          "cc,benchmark", "Graphics.Pipeline.FrameStages", frame_token,
+          step.time);
+      began = true;
+    }
+    TRACE_EVENT_ASYNC_STEP_INTO_WITH_TIMESTAMP0(
+        "cc,benchmark", "Graphics.Pipeline.FrameStages", frame_token,
+        step.name, step.time);
+  }
+  TRACE_EVENT_ASYNC_END_WITH_TIMESTAMP0("cc,benchmark",
+                                        "Graphics.Pipeline.FrameStages",
+                                        frame_token, presentation_time);
+}
+
 void CompositorTimingHistory::SetTreePriority(TreePriority priority) {
   tree_priority_ = priority;
 }
@@ -5,8 +5,12 @@
 #ifndef CC_SCHEDULER_COMPOSITOR_TIMING_HISTORY_H_
 #define CC_SCHEDULER_COMPOSITOR_TIMING_HISTORY_H_
 
+#include <stdint.h>
+
 #include <memory>
+#include <utility>
 
+#include "base/containers/circular_deque.h"
 #include "cc/base/rolling_time_delta_history.h"
 #include "cc/cc_export.h"
 #include "cc/tiles/tile_priority.h"
@@ -18,6 +22,10 @@ class TracedValue;
 }  // namespace trace_event
 }  // namespace base
 
+namespace gfx {
+struct PresentationFeedback;
+}  // namespace gfx
+
 namespace cc {
 
 class RenderingStatsInstrumentation;
@@ -86,8 +94,10 @@ class CC_EXPORT CompositorTimingHistory {
                size_t main_thread_animations_count,
                bool current_frame_had_raf,
                bool next_frame_has_pending_raf);
-  void DidSubmitCompositorFrame();
+  void DidSubmitCompositorFrame(uint32_t frame_token);
   void DidReceiveCompositorFrameAck();
+  void DidPresentCompositorFrame(uint32_t frame_token,
+                                 const gfx::PresentationFeedback& feedback);
   void WillInvalidateOnImplSide();
   void SetTreePriority(TreePriority priority);
 
@@ -105,7 +115,25 @@ class CC_EXPORT CompositorTimingHistory {
   }
 
  protected:
+  // The times at which the stages of producing a frame started, from sending
+  // the BeginMainFrame whose content the frame shows, if any, to submitting
+  // the frame. Stages that didn't happen for the frame are null.
+  struct FrameStageTimes {
+    base::TimeTicks begin_main_frame_sent;
+    base::TimeTicks begin_main_frame_start;
+    base::TimeTicks commit_start;
+    base::TimeTicks commit_end;
+    base::TimeTicks ready_to_activate;
+    base::TimeTicks activate_start;
+    base::TimeTicks activate_end;
+    base::TimeTicks draw_start;
+    base::TimeTicks submit;
+  };
+
   void DidBeginMainFrame(base::TimeTicks begin_main_frame_end_time);
+  void ReportFrameStages(uint32_t frame_token,
+                         const FrameStageTimes& stages,
+                         base::TimeTicks presentation_time);
 
   void SetBeginMainFrameNeededContinuously(bool active);
   void SetBeginMainFrameCommittingContinuously(bool active);
@@ -156,6 +184,13 @@ class CC_EXPORT CompositorTimingHistory {
 
   bool pending_tree_is_impl_side_;
 
+  // The stages of the content of the pending and active trees, and of the
+  // frames that were submitted but not presented yet, by frame token.
+  FrameStageTimes pending_tree_stages_;
+  FrameStageTimes active_tree_stages_;
+  base::circular_deque<std::pair<uint32_t, FrameStageTimes>>
+      submitted_frame_stages_;
+
   // Watchdog timers.
   bool submit_ack_watchdog_enabled_;
 
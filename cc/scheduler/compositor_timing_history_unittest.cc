@@ -7,6 +7,7 @@
 #include "base/test/metrics/histogram_tester.h"
 #include "cc/debug/rendering_stats_instrumentation.h"
 #include "testing/gtest/include/gtest/gtest.h"
+#include "ui/gfx/presentation_feedback.h"
 
 namespace cc {
 namespace {
@@ -439,5 +440,62 @@ TEST_F(CompositorTimingHistoryTest, AnimationsWithNewActiveTreeNotUsed) {
       "Scheduling.Renderer.DrawIntervalWithCompositedAnimations2", 123, 1);
 }
 
+TEST_F(CompositorTimingHistoryTest, FrameStagesReportedOnPresentation) {
+  base::HistogramTester histogram_tester;
+
+  // A main frame, whose content is drawn in the frame with token 1.
+  timing_history_.WillBeginMainFrame(true, Now());
+  timing_history_.BeginMainFrameStarted(Now());
+  AdvanceNowBy(base::TimeDelta::FromMilliseconds(4));
+  timing_history_.WillCommit();
+  timing_history_.DidCommit();
+  timing_history_.ReadyToActivate();
+  timing_history_.WillActivate();
+  timing_history_.DidActivate();
+  timing_history_.WillDraw();
+  AdvanceNowBy(base::TimeDelta::FromMilliseconds(2));
+  timing_history_.DidSubmitCompositorFrame(1u);
+  timing_history_.DidDraw(true, Now(), 0, 0, false, false);
+  timing_history_.DidReceiveCompositorFrameAck();
+
+  // Frames 2 and 3 are drawn from the same active tree.
+  for (uint32_t frame_token : {2u, 3u}) {
+    timing_history_.WillDraw();
+    timing_history_.DidSubmitCompositorFrame(frame_token);
+    timing_history_.DidDraw(false, Now(), 0, 0, false, false);
+    timing_history_.DidReceiveCompositorFrameAck();
+  }
+
+  AdvanceNowBy(base::TimeDelta::FromMilliseconds(10));
+  timing_history_.DidPresentCompositorFrame(
+      1u, gfx::PresentationFeedback(Now(), base::TimeDelta(), 0));
+  histogram_tester.ExpectUniqueSample(
+      "Scheduling.Renderer.SubmitToPresentationLatency", 10000, 1);
+  histogram_tester.ExpectUniqueSample(
+      "Scheduling.Renderer.BeginMainFrameToPresentationLatency", 16000, 1);
+
+  // Frame 2 is skipped by the feedback for frame 3, which only has the stages
+  // of drawing.
+  AdvanceNowBy(base::TimeDelta::FromMilliseconds(10));
+  timing_history_.DidPresentCompositorFrame(
+      3u, gfx::PresentationFeedback(Now(), base::TimeDelta(), 0));
+  histogram_tester.ExpectTotalCount(
+      "Scheduling.Renderer.SubmitToPresentationLatency", 2);
+  histogram_tester.ExpectBucketCount(
+      "Scheduling.Renderer.SubmitToPresentationLatency", 20000, 1);
+  histogram_tester.ExpectTotalCount(
+      "Scheduling.Renderer.BeginMainFrameToPresentationLatency", 1);
+
+  // Failed presentations aren't reported.
+  timing_history_.WillDraw();
+  timing_history_.DidSubmitCompositorFrame(4u);
+  timing_history_.DidDraw(false, Now(), 0, 0, false, false);
+  timing_history_.DidReceiveCompositorFrameAck();
+  timing_history_.DidPresentCompositorFrame(
+      4u, gfx::PresentationFeedback::Failure());
+  histogram_tester.ExpectTotalCount(
+      "Scheduling.Renderer.SubmitToPresentationLatency", 2);
+}
+
 }  // namespace
 }  // namespace cc
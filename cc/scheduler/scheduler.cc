@@ -136,8 +136,8 @@ void Scheduler::SetNeedsPrepareTiles() {
   ProcessScheduledActions();
 }
 
-void Scheduler::DidSubmitCompositorFrame() {
-  compositor_timing_history_->DidSubmitCompositorFrame();
+void Scheduler::DidSubmitCompositorFrame(uint32_t frame_token) {
+  compositor_timing_history_->DidSubmitCompositorFrame(frame_token);
   state_machine_.DidSubmitCompositorFrame();
 
   // There is no need to call ProcessScheduledActions here because
@@ -154,6 +154,12 @@ void Scheduler::DidReceiveCompositorFrameAck() {
   ProcessScheduledActions();
 }
 
+void Scheduler::DidPresentCompositorFrame(
+    uint32_t frame_token,
+    const gfx::PresentationFeedback& feedback) {
+  compositor_timing_history_->DidPresentCompositorFrame(frame_token, feedback);
+}
+
 void Scheduler::SetTreePrioritiesAndScrollState(
     TreePriority tree_priority,
     ScrollHandlerState scroll_handler_state) {
@@ -519,6 +525,26 @@ void Scheduler::BeginImplFrameWithDeadline(const viz::BeginFrameArgs& args) {
       CanBeginMainFrameAndActivateBeforeDeadline(adjusted_args,
                                                  bmf_to_activate_estimate, now);
 
+  if (settings_.frame_pacing_mode == FramePacingMode::kLowLatency) {
+    // A main frame that is already in flight is predicted from when it was
+    // sent, rather than from now.
+    base::TimeTicks predicted_activation_time = now + bmf_to_activate_estimate;
+    if (IsBeginMainFrameSentOrStarted()) {
+      base::TimeDelta commit_to_activate_estimate =
+          compositor_timing_history_->CommitDurationEstimate() +
+          compositor_timing_history_
+              ->CommitToReadyToActivateDurationEstimate() +
+          compositor_timing_history_->ActivateDurationEstimate();
+      predicted_activation_time =
+          compositor_timing_history_->begin_main_frame_sent_time() +
+          bmf_sent_to_ready_to_commit_estimate + commit_to_activate_estimate;
+    }
+    predicted_activation_time_ =
+        predicted_activation_time < adjusted_args.deadline
+            ? predicted_activation_time
+            : adjusted_args.frame_time;
+  }
+
   if (ShouldRecoverMainLatency(adjusted_args, can_activate_before_deadline)) {
     TRACE_EVENT_INSTANT0("cc", "SkipBeginMainFrameToReduceLatency",
                          TRACE_EVENT_SCOPE_THREAD);
@@ -659,6 +685,10 @@ void Scheduler::ScheduleBeginImplFrameDeadline() {
     case DeadlineMode::REGULAR:
       // We are animating the active tree but we're also waiting for commit.
       new_deadline = begin_impl_frame_tracker_.Current().deadline;
+      // In low latency mode, only wait for as long as the commit is predicted
+      // to take, and not at all if it isn't expected in this frame.
+      if (settings_.frame_pacing_mode == FramePacingMode::kLowLatency)
+        new_deadline = std::min(new_deadline, predicted_activation_time_);
       break;
     case DeadlineMode::IMMEDIATE:
       // Avoid using Now() for immediate deadlines because it's expensive, and
@@ -951,8 +981,11 @@ bool Scheduler::ShouldRecoverMainLatency(
     bool can_activate_before_deadline) const {
   DCHECK(!settings_.using_synchronous_renderer_compositor);
 
-  if (!settings_.enable_latency_recovery)
+  // Skipping frames to recover latency costs throughput.
+  if (!settings_.enable_latency_recovery ||
+      settings_.frame_pacing_mode == FramePacingMode::kThroughput) {
     return false;
+  }
 
   // The main thread is in a low latency mode and there's no need to recover.
   if (!state_machine_.main_thread_missed_last_deadline())
@@ -983,8 +1016,11 @@ bool Scheduler::ShouldRecoverImplLatency(
     bool can_activate_before_deadline) const {
   DCHECK(!settings_.using_synchronous_renderer_compositor);
 
-  if (!settings_.enable_latency_recovery)
+  // Skipping frames to recover latency costs throughput.
+  if (!settings_.enable_latency_recovery ||
+      settings_.frame_pacing_mode == FramePacingMode::kThroughput) {
     return false;
+  }
 
   // Disable impl thread latency recovery when using the unthrottled
   // begin frame source since we will always get a BeginFrame before
@@ -27,6 +27,10 @@ class ConvertableToTraceFormat;
 class SingleThreadTaskRunner;
 }
 
+namespace gfx {
+struct PresentationFeedback;
+}
+
 namespace cc {
 
 class CompositorTimingHistory;
@@ -143,10 +147,14 @@ class CC_EXPORT Scheduler : public viz::BeginFrameObserverBase {
 
   // Drawing should result in submitting a CompositorFrame to the
   // LayerTreeFrameSink and then calling this.
-  void DidSubmitCompositorFrame();
+  void DidSubmitCompositorFrame(uint32_t frame_token);
   // The LayerTreeFrameSink acks when it is ready for a new frame which
   // should result in this getting called to unblock the next draw.
   void DidReceiveCompositorFrameAck();
+  // Called with the presentation feedback of a submitted CompositorFrame, to
+  // attribute its latency to the stages that produced it.
+  void DidPresentCompositorFrame(uint32_t frame_token,
+                                 const gfx::PresentationFeedback& feedback);
 
   void SetTreePrioritiesAndScrollState(TreePriority tree_priority,
                                        ScrollHandlerState scroll_handler_state);
@@ -240,6 +248,11 @@ class CC_EXPORT Scheduler : public viz::BeginFrameObserverBase {
   base::TimeTicks deadline_scheduled_at_;
   SchedulerStateMachine::BeginImplFrameDeadlineMode deadline_mode_;
 
+  // When the main frame is predicted to activate in the current BeginImplFrame,
+  // or the frame time if it isn't expected to activate before the deadline.
+  // Used for the REGULAR deadline in FramePacingMode::kLowLatency.
+  base::TimeTicks predicted_activation_time_;
+
   BeginFrameTracker begin_impl_frame_tracker_;
   viz::BeginFrameAck last_begin_frame_ack_;
   viz::BeginFrameArgs begin_main_frame_args_;
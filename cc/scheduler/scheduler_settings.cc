@@ -4,10 +4,24 @@
 
 #include "cc/scheduler/scheduler_settings.h"
 
+#include "base/logging.h"
 #include "base/trace_event/traced_value.h"
 
 namespace cc {
 
+const char* FramePacingModeToString(FramePacingMode mode) {
+  switch (mode) {
+    case FramePacingMode::kSmoothness:
+      return "Smoothness";
+    case FramePacingMode::kLowLatency:
+      return "LowLatency";
+    case FramePacingMode::kThroughput:
+      return "Throughput";
+  }
+  NOTREACHED();
+  return "???";
+}
+
 SchedulerSettings::SchedulerSettings() = default;
 
 SchedulerSettings::SchedulerSettings(const SchedulerSettings& other) = default;
@@ -38,6 +52,8 @@ SchedulerSettings::AsValue() const {
                     enable_surface_synchronization);
   state->SetBoolean("compositor_threaded_scrollbar_scrolling",
                     compositor_threaded_scrollbar_scrolling);
+  state->SetString("frame_pacing_mode",
+                   FramePacingModeToString(frame_pacing_mode));
   return std::move(state);
 }
 
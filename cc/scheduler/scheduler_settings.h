@@ -20,6 +20,21 @@ class ConvertableToTraceFormat;
 
 namespace cc {
 
+// How the scheduler trades off latency against smoothness and throughput.
+enum class FramePacingMode {
+  // Waits for the main thread until a fixed point in the frame, and skips
+  // frames to recover when the main thread falls a frame behind.
+  kSmoothness,
+  // Only waits for the main thread for as long as its commit is predicted to
+  // take, so impl-side updates in response to input draw as soon as possible.
+  kLowLatency,
+  // Never skips frames to recover latency, and lets the main thread start a
+  // new frame before the previous one is activated to keep the pipeline full.
+  kThroughput,
+};
+
+CC_EXPORT const char* FramePacingModeToString(FramePacingMode mode);
+
 class CC_EXPORT SchedulerSettings {
  public:
   SchedulerSettings();
@@ -35,6 +50,7 @@ class CC_EXPORT SchedulerSettings {
   bool wait_for_all_pipeline_stages_before_draw = false;
   bool enable_surface_synchronization = false;
   bool compositor_threaded_scrollbar_scrolling = false;
+  FramePacingMode frame_pacing_mode = FramePacingMode::kSmoothness;
 
   int maximum_number_of_failed_draws_before_draw_is_forced = 3;
   base::TimeDelta background_frame_interval = base::TimeDelta::FromSeconds(1);
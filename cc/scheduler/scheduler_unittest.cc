@@ -163,7 +163,7 @@ class FakeSchedulerClient : public SchedulerClient,
         draw_will_happen_ && swap_will_happen_if_draw_happens_;
     if (swap_will_happen) {
       last_begin_frame_ack_ = scheduler_->CurrentBeginFrameAckForActiveTree();
-      scheduler_->DidSubmitCompositorFrame();
+      scheduler_->DidSubmitCompositorFrame(++last_frame_token_);
 
       if (automatic_ack_)
         scheduler_->DidReceiveCompositorFrameAck();
@@ -279,6 +279,7 @@ class FakeSchedulerClient : public SchedulerClient,
   int num_draws_;
   viz::BeginFrameArgs last_begin_main_frame_args_;
   viz::BeginFrameAck last_begin_frame_ack_;
+  uint32_t last_frame_token_ = 0;
   base::TimeTicks posted_begin_impl_frame_deadline_;
   std::vector<const char*> actions_;
   std::vector<std::unique_ptr<base::trace_event::ConvertableToTraceFormat>>
@@ -1676,6 +1677,57 @@ TEST_F(SchedulerTest, MainFrameNotSkippedAfterLateCommit_DrawEstimateTooLong) {
       CheckMainFrameSkippedAfterLateCommit(expect_send_begin_main_frame));
 }
 
+TEST_F(SchedulerTest, MainFrameNotSkippedAfterLateCommitInThroughputMode) {
+  scheduler_settings_.frame_pacing_mode = FramePacingMode::kThroughput;
+  SetUpScheduler(EXTERNAL_BFS);
+  fake_compositor_timing_history_->SetAllEstimatesTo(kFastDuration);
+
+  bool expect_send_begin_main_frame = true;
+  EXPECT_SCOPED(
+      CheckMainFrameSkippedAfterLateCommit(expect_send_begin_main_frame));
+}
+
+TEST_F(SchedulerTest, LowLatencyModeDeadlineWaitsForPredictedActivation) {
+  scheduler_settings_.frame_pacing_mode = FramePacingMode::kLowLatency;
+  SetUpScheduler(EXTERNAL_BFS);
+  fake_compositor_timing_history_->SetAllEstimatesTo(kFastDuration);
+
+  // With an impl-side redraw and a main frame both pending, the deadline only
+  // waits for as long as the main frame is predicted to take to activate.
+  client_->Reset();
+  scheduler_->SetNeedsRedraw();
+  scheduler_->SetNeedsBeginMainFrame();
+  EXPECT_SCOPED(AdvanceFrame());
+  EXPECT_ACTIONS("WillBeginImplFrame", "ScheduledActionSendBeginMainFrame");
+  EXPECT_GT(scheduler_->deadline(), task_runner_->NowTicks());
+  EXPECT_LT(scheduler_->deadline(),
+            client_->last_begin_main_frame_args().deadline);
+
+  // The draw happens at that deadline if the main frame is late.
+  client_->Reset();
+  task_runner_->RunPendingTasks();
+  EXPECT_ACTIONS("ScheduledActionDrawIfPossible");
+  EXPECT_LT(task_runner_->NowTicks(),
+            client_->last_begin_main_frame_args().deadline);
+}
+
+TEST_F(SchedulerTest, LowLatencyModeDrawsImmediatelyForSlowMainFrame) {
+  scheduler_settings_.frame_pacing_mode = FramePacingMode::kLowLatency;
+  SetUpScheduler(EXTERNAL_BFS);
+  fake_compositor_timing_history_->SetAllEstimatesTo(kFastDuration);
+  fake_compositor_timing_history_
+      ->SetBeginMainFrameStartToReadyToCommitDurationEstimate(kSlowDuration);
+
+  // The main frame isn't expected to activate in this frame, so there is no
+  // reason to wait for it before drawing.
+  client_->Reset();
+  scheduler_->SetNeedsRedraw();
+  scheduler_->SetNeedsBeginMainFrame();
+  EXPECT_SCOPED(AdvanceFrame());
+  EXPECT_ACTIONS("WillBeginImplFrame", "ScheduledActionSendBeginMainFrame");
+  EXPECT_LE(scheduler_->deadline(), task_runner_->NowTicks());
+}
+
 // If the BeginMainFrame aborts, it doesn't actually insert a frame into the
 // queue, which means there is no latency to recover.
 TEST_F(SchedulerTest, MainFrameNotSkippedAfterLateBeginMainFrameAbort) {
@@ -51,6 +51,10 @@ bool FakeRasterBufferProviderImpl::CanPartialRasterIntoProvidedResource()
   return true;
 }
 
+bool FakeRasterBufferProviderImpl::CanRasterIntoCompressedResource() const {
+  return false;
+}
+
 bool FakeRasterBufferProviderImpl::IsResourceReadyToDraw(
     const ResourcePool::InUsePoolResource& resource) const {
   return true;
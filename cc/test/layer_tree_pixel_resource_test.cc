@@ -108,7 +108,7 @@ LayerTreeHostPixelResourceTest::CreateRasterBufferProvider(
       return std::make_unique<OneCopyRasterBufferProvider>(
           task_runner, compositor_context_provider, worker_context_provider,
           gpu_memory_buffer_manager, max_bytes_per_copy_operation, false, false,
-          max_staging_buffer_usage_in_bytes, sw_raster_format);
+          max_staging_buffer_usage_in_bytes, sw_raster_format, false);
     case SKIA_GL:
       EXPECT_TRUE(compositor_context_provider);
       EXPECT_TRUE(worker_context_provider);
@@ -114,6 +114,8 @@ class TestScheduler : public Scheduler {
     return state_machine_.needs_impl_side_invalidation();
   }
 
+  base::TimeTicks deadline() const { return deadline_; }
+
   ~TestScheduler() override;
 
   base::TimeDelta BeginImplFrameInterval() {
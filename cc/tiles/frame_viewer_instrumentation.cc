@@ -21,6 +21,9 @@ const char kSourceFrameNumber[] = "sourceFrameNumber";
 
 const char kAnalyzeTask[] = "AnalyzeTask";
 const char kRasterTask[] = "RasterTask";
+const char kRasterSchedule[] = "RasterSchedule";
+const char kScheduledRasterArea[] = "scheduledRasterArea";
+const char kPredictedCheckerboardArea[] = "predictedCheckerboardArea";
 
 std::unique_ptr<base::trace_event::ConvertableToTraceFormat> TileDataAsValue(
     const void* tile_id,
@@ -70,5 +73,18 @@ bool IsTracingLayerTreeSnapshots() {
   return category_enabled;
 }
 
+bool IsTracingRasterScheduleMetrics() {
+  bool category_enabled;
+  TRACE_EVENT_CATEGORY_GROUP_ENABLED(kCategory, &category_enabled);
+  return category_enabled;
+}
+
+void RecordRasterScheduleMetrics(int64_t scheduled_raster_area,
+                                 int64_t predicted_checkerboard_area) {
+  TRACE_COUNTER2(kCategory, kRasterSchedule, kScheduledRasterArea,
+                 scheduled_raster_area, kPredictedCheckerboardArea,
+                 predicted_checkerboard_area);
+}
+
 }  // namespace frame_viewer_instrumentation
 }  // namespace cc
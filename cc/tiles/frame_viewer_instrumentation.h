@@ -5,6 +5,8 @@
 #ifndef CC_TILES_FRAME_VIEWER_INSTRUMENTATION_H_
 #define CC_TILES_FRAME_VIEWER_INSTRUMENTATION_H_
 
+#include <stdint.h>
+
 #include "base/trace_event/trace_event.h"
 #include "cc/tiles/tile_priority.h"
 
@@ -44,6 +46,13 @@ class ScopedRasterTask {
 
 bool IsTracingLayerTreeSnapshots();
 
+bool IsTracingRasterScheduleMetrics();
+// Records the content area of the tiles that were scheduled for raster, and
+// of the tiles that were not but are predicted to become visible soon, which
+// are likely to checkerboard.
+void RecordRasterScheduleMetrics(int64_t scheduled_raster_area,
+                                 int64_t predicted_checkerboard_area);
+
 }  // namespace frame_viewer_instrumentation
 }  // namespace cc
 
@@ -50,6 +50,17 @@ static const int kSuspendedMaxItemsInCacheForGpu = 0;
 // memory spikes.
 static const int kMaxItemsInWorkingSet = 256;
 
+// The maximum number of bytes of unlocked decoded memory to keep for images
+// that were evicted from the cache, or that were uploaded to the GPU. This
+// memory can be purged by the discardable system at any time, so the limit
+// only bounds how much of it we hold on to.
+static const size_t kMaxSpilledDecodeBytes = 64 * 1024 * 1024;
+
+// The minimum size of a decode for it to be written directly into the
+// transfer cache when it is needed at raster. Below this, copying the decode
+// is cheap and keeping it for a re-upload is worth more.
+static const size_t kMinBytesToDecodeIntoTransferCache = 1024 * 1024;
+
 // lock_count │ used  │ result state
 // ═══════════╪═══════╪══════════════════
 //  1         │ false │ WASTED_ONCE
@@ -453,6 +464,27 @@ size_t GpuImageDecodeCache::InUseCacheKeyHash::operator()(
                                        cache_key.filter_quality));
 }
 
+bool GpuImageDecodeCache::SpilledDecodeKey::operator==(
+    const SpilledDecodeKey& other) const {
+  return frame_key == other.frame_key &&
+         upload_scale_mip_level == other.upload_scale_mip_level;
+}
+
+size_t GpuImageDecodeCache::SpilledDecodeKeyHash::operator()(
+    const SpilledDecodeKey& key) const {
+  return base::HashInts(key.frame_key.hash(), key.upload_scale_mip_level);
+}
+
+GpuImageDecodeCache::SpilledDecode::SpilledDecode(
+    std::unique_ptr<base::DiscardableMemory> data,
+    const SkImageInfo& image_info)
+    : data(std::move(data)), image_info(image_info) {}
+GpuImageDecodeCache::SpilledDecode::SpilledDecode(SpilledDecode&& other) =
+    default;
+GpuImageDecodeCache::SpilledDecode::~SpilledDecode() = default;
+GpuImageDecodeCache::SpilledDecode& GpuImageDecodeCache::SpilledDecode::
+operator=(SpilledDecode&& other) = default;
+
 GpuImageDecodeCache::InUseCacheEntry::InUseCacheEntry(
     scoped_refptr<ImageData> image_data)
     : image_data(std::move(image_data)) {}
@@ -679,6 +711,22 @@ void GpuImageDecodeCache::DecodedImageData::ResetData() {
   OnResetData();
 }
 
+std::unique_ptr<base::DiscardableMemory>
+GpuImageDecodeCache::DecodedImageData::TakeData(SkImageInfo* image_info) {
+  DCHECK(data_);
+  DCHECK(image_);
+  DCHECK(!is_yuv());
+  DCHECK(!is_bitmap_backed_);
+  if (is_locked_)
+    Unlock();
+  ReportUsageStats();
+  *image_info = image_->imageInfo();
+  std::unique_ptr<base::DiscardableMemory> data = std::move(data_);
+  image_ = nullptr;
+  OnResetData();
+  return data;
+}
+
 void GpuImageDecodeCache::DecodedImageData::ReportUsageStats() const {
   UMA_HISTOGRAM_ENUMERATION("Renderer4.GpuImageDecodeState",
                             static_cast<ImageUsageState>(UsageState()),
@@ -861,6 +909,7 @@ GpuImageDecodeCache::GpuImageDecodeCache(
       max_texture_size_(max_texture_size),
       generator_client_id_(generator_client_id),
       persistent_cache_(PersistentCache::NO_AUTO_EVICT),
+      spilled_decodes_(SpilledDecodeCache::NO_AUTO_EVICT),
       max_working_set_bytes_(max_working_set_bytes),
       max_working_set_items_(kMaxItemsInWorkingSet),
       target_color_space_(std::move(target_color_space)) {
@@ -1037,8 +1086,10 @@ DecodedDrawImage GpuImageDecodeCache::GetDecodedImageForDraw(
 
   // We may or may not need to decode and upload the image we've found, the
   // following functions early-out to if we already decoded.
-  DecodeImageIfNecessary(draw_image, image_data, TaskType::kInRaster);
-  UploadImageIfNecessary(draw_image, image_data);
+  if (!DecodeIntoTransferCacheIfPossible(draw_image, image_data)) {
+    DecodeImageIfNecessary(draw_image, image_data, TaskType::kInRaster);
+    UploadImageIfNecessary(draw_image, image_data);
+  }
   // Unref the image decode, but not the image. The image ref will be released
   // in DrawWithImageFinished.
   UnrefImageDecode(draw_image, cache_key);
@@ -1144,6 +1195,8 @@ void GpuImageDecodeCache::ClearCache() {
     it = RemoveFromPersistentCache(it);
   DCHECK(persistent_cache_.empty());
   paint_image_entries_.clear();
+  spilled_decodes_.Clear();
+  spilled_decodes_bytes_ = 0u;
 }
 
 void GpuImageDecodeCache::AddToPersistentCache(const DrawImage& draw_image,
@@ -1173,6 +1226,10 @@ Iterator GpuImageDecodeCache::RemoveFromPersistentCache(Iterator it) {
     // Free the uploaded image if it exists.
     if (it->second->HasUploadedData())
       DeleteImage(it->second.get());
+
+    // Keep the decoded data around in case the image is needed again.
+    if (it->second->decode.data())
+      SpillDecodedData(it->first, it->second.get());
   }
 
   auto entries_it = paint_image_entries_.find(it->second->paint_image_id);
@@ -1290,6 +1347,17 @@ bool GpuImageDecodeCache::OnMemoryDump(
     }
   }
 
+  // Spilled decodes are always unlocked, so there is no "locked_size".
+  for (const auto& spilled_pair : spilled_decodes_) {
+    std::string spilled_dump_name = base::StringPrintf(
+        "cc/image_memory/cache_0x%" PRIXPTR "/spilled/image_%d_%d",
+        reinterpret_cast<uintptr_t>(this),
+        static_cast<int>(spilled_pair.first.frame_key.hash()),
+        spilled_pair.first.upload_scale_mip_level);
+    spilled_pair.second.data->CreateMemoryAllocatorDump(
+        spilled_dump_name.c_str(), pmd);
+  }
+
   return true;
 }
 
@@ -1519,7 +1587,10 @@ void GpuImageDecodeCache::OwnershipChanged(const DrawImage& draw_image,
   if (image_data->decode.ref_count == 0 &&
       image_data->mode != DecodedDataMode::kCpu &&
       image_data->HasUploadedData()) {
-    image_data->decode.ResetData();
+    if (image_data->decode.data())
+      SpillDecodedData(draw_image.frame_key(), image_data);
+    else
+      image_data->decode.ResetData();
   }
 
   // If we have no refs on an uploaded image, it should be unlocked. Do this
@@ -1529,9 +1600,12 @@ void GpuImageDecodeCache::OwnershipChanged(const DrawImage& draw_image,
     UnlockImage(image_data);
   }
 
-  // Don't keep around orphaned images.
+  // Don't keep around orphaned images, but keep their decoded data in case
+  // the image is needed again.
   if (image_data->is_orphaned && !has_any_refs) {
     DeleteImage(image_data);
+    if (image_data->decode.data())
+      SpillDecodedData(draw_image.frame_key(), image_data);
   }
 
   // Don't keep CPU images if they are unused, these images can be recreated by
@@ -1604,6 +1678,7 @@ bool GpuImageDecodeCache::EnsureCapacity(size_t required_size) {
     it = RemoveFromPersistentCache(it);
   }
 
+  EnsureSpilledDecodesCapacity();
   return CanFitInWorkingSet(required_size);
 }
 
@@ -1669,6 +1744,9 @@ void GpuImageDecodeCache::DecodeImageIfNecessary(const DrawImage& draw_image,
     return;
   }
 
+  if (TryUseSpilledDecode(draw_image, image_data, task_type))
+    return;
+
   TRACE_EVENT0("cc", "GpuImageDecodeCache::DecodeImage");
   RecordImageMipLevelUMA(image_data->upload_scale_mip_level);
 
@@ -1755,6 +1833,87 @@ void GpuImageDecodeCache::DecodeImageIfNecessary(const DrawImage& draw_image,
   }
 }
 
+void GpuImageDecodeCache::SpillDecodedData(
+    const PaintImage::FrameKey& frame_key,
+    ImageData* image_data) {
+  lock_.AssertAcquired();
+  DCHECK(image_data->decode.data());
+
+  // YUV planes and bitmap backed images are not spilled, and neither is
+  // anything while we are freeing resources.
+  if (image_data->is_yuv || image_data->is_bitmap_backed ||
+      aggressively_freeing_resources_ ||
+      image_data->size > kMaxSpilledDecodeBytes) {
+    image_data->decode.ResetData();
+    return;
+  }
+
+  SkImageInfo image_info;
+  std::unique_ptr<base::DiscardableMemory> data =
+      image_data->decode.TakeData(&image_info);
+  SpilledDecodeKey key = {frame_key, image_data->upload_scale_mip_level};
+  auto found = spilled_decodes_.Peek(key);
+  if (found != spilled_decodes_.end()) {
+    spilled_decodes_bytes_ -= found->second.image_info.computeMinByteSize();
+    spilled_decodes_.Erase(found);
+  }
+  spilled_decodes_bytes_ += image_info.computeMinByteSize();
+  spilled_decodes_.Put(key, SpilledDecode(std::move(data), image_info));
+  EnsureSpilledDecodesCapacity();
+}
+
+bool GpuImageDecodeCache::TryUseSpilledDecode(const DrawImage& draw_image,
+                                              ImageData* image_data,
+                                              TaskType task_type) {
+  lock_.AssertAcquired();
+
+  if (image_data->is_yuv)
+    return false;
+
+  auto found = spilled_decodes_.Peek(
+      {draw_image.frame_key(), image_data->upload_scale_mip_level});
+  if (found == spilled_decodes_.end())
+    return false;
+
+  // The entry is removed even if it can't be used, since it would not match
+  // next time either.
+  SpilledDecode spilled = std::move(found->second);
+  spilled_decodes_bytes_ -= spilled.image_info.computeMinByteSize();
+  spilled_decodes_.Erase(found);
+
+  // The decode must have been done into the same color space.
+  SkImageInfo image_info =
+      CreateImageInfoForDrawImage(draw_image,
+                                  image_data->upload_scale_mip_level)
+          .makeColorSpace(
+              ColorSpaceForImageDecode(draw_image, image_data->mode));
+  if (image_info != spilled.image_info || !spilled.data->Lock())
+    return false;
+
+  TRACE_EVENT0("cc", "GpuImageDecodeCache::UseSpilledDecode");
+  image_data->decode.ResetData();
+  SkPixmap pixmap(image_info, spilled.data->data(), image_info.minRowBytes());
+  auto release_proc = [](const void*, void*) {};
+  image_data->decode.SetLockedData(
+      std::move(spilled.data),
+      SkImage::MakeFromRaster(pixmap, release_proc, nullptr),
+      task_type == TaskType::kOutOfRaster);
+  return true;
+}
+
+void GpuImageDecodeCache::EnsureSpilledDecodesCapacity() {
+  lock_.AssertAcquired();
+
+  size_t bytes_limit =
+      aggressively_freeing_resources_ ? 0u : kMaxSpilledDecodeBytes;
+  while (spilled_decodes_bytes_ > bytes_limit) {
+    auto it = spilled_decodes_.rbegin();
+    DCHECK(it != spilled_decodes_.rend());
+    spilled_decodes_bytes_ -= it->second.image_info.computeMinByteSize();
+    spilled_decodes_.Erase(it);
+  }
+}
+
 void GpuImageDecodeCache::UploadImageIfNecessary(const DrawImage& draw_image,
                                                  ImageData* image_data) {
   CheckContextLockAcquiredIfNecessary();
@@ -1973,6 +2132,89 @@ void GpuImageDecodeCache::UploadImageIfNecessary(const DrawImage& draw_image,
   }
 }
 
+bool GpuImageDecodeCache::DecodeIntoTransferCacheIfPossible(
+    const DrawImage& draw_image,
+    ImageData* image_data) {
+  CheckContextLockAcquiredIfNecessary();
+  lock_.AssertAcquired();
+
+  if (image_data->mode != DecodedDataMode::kTransferCache ||
+      image_data->is_yuv || image_data->is_bitmap_backed ||
+      image_data->decode.decode_failure || image_data->decode.data() ||
+      image_data->HasUploadedData() ||
+      image_data->size < kMinBytesToDecodeIntoTransferCache) {
+    return false;
+  }
+
+  // A spilled decode avoids decoding again, which is worth more than the copy.
+  if (spilled_decodes_.Peek({draw_image.frame_key(),
+                             image_data->upload_scale_mip_level}) !=
+      spilled_decodes_.end()) {
+    return false;
+  }
+
+  TRACE_EVENT0("cc", "GpuImageDecodeCache::DecodeIntoTransferCache");
+  DCHECK(use_transfer_cache_);
+  DCHECK_GT(image_data->upload.ref_count, 0u);
+  RunPendingContextThreadOperations();
+  RecordImageMipLevelUMA(image_data->upload_scale_mip_level);
+
+  sk_sp<SkColorSpace> decode_color_space =
+      ColorSpaceForImageDecode(draw_image, image_data->mode);
+  sk_sp<SkColorSpace> target_color_space =
+      SupportsColorSpaceConversion() ? target_color_space_ : nullptr;
+  if (target_color_space && SkColorSpace::Equals(target_color_space.get(),
+                                                 decode_color_space.get())) {
+    target_color_space = nullptr;
+  }
+
+  SkImageInfo image_info =
+      CreateImageInfoForDrawImage(draw_image,
+                                  image_data->upload_scale_mip_level)
+          .makeColorSpace(std::move(decode_color_space));
+  SkPixmap pixmap(image_info, nullptr, image_info.minRowBytes());
+  ClientImageTransferCacheEntry image_entry(&pixmap, target_color_space.get(),
+                                            image_data->needs_mips);
+  uint32_t size = image_entry.SerializedSize();
+  void* data = context_->ContextSupport()->MapTransferCacheEntry(size);
+  if (!data) {
+    // See UploadImageIfNecessary.
+    image_data->decode.decode_failure = true;
+    return true;
+  }
+
+  uint8_t* pixels = nullptr;
+  bool succeeded = image_entry.SerializeWithoutPixels(
+      base::make_span(reinterpret_cast<uint8_t*>(data), size), &pixels);
+  DCHECK(succeeded);
+  pixmap.reset(image_info, pixels, image_info.minRowBytes());
+
+  bool decoded;
+  {
+    base::AutoUnlock unlock(lock_);
+    decoded = DrawAndScaleImage(draw_image, &pixmap, generator_client_id_,
+                                /*do_yuv_decode=*/false);
+  }
+
+  // The entry has to be created to unmap the memory, even if the decode
+  // failed.
+  context_->ContextSupport()->UnmapAndCreateTransferCacheEntry(
+      image_entry.UnsafeType(), image_entry.Id());
+  if (!decoded || image_data->HasUploadedData()) {
+    // The image could not be decoded, or another thread uploaded it while the
+    // lock was released.
+    DLOG_IF(ERROR, !decoded) << "DrawAndScaleImage failed.";
+    context_->ContextSupport()->DeleteTransferCacheEntry(
+        image_entry.UnsafeType(), image_entry.Id());
+    if (!decoded)
+      image_data->decode.decode_failure = true;
+    return true;
+  }
+
+  image_data->upload.SetTransferCacheId(image_entry.Id());
+  return true;
+}
+
 scoped_refptr<GpuImageDecodeCache::ImageData>
 GpuImageDecodeCache::CreateImageData(const DrawImage& draw_image) {
   TRACE_EVENT0(TRACE_DISABLED_BY_DEFAULT("cc.debug"),
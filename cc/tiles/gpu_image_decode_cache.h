@@ -17,6 +17,7 @@
 #include "base/trace_event/memory_dump_provider.h"
 #include "cc/cc_export.h"
 #include "cc/tiles/image_decode_cache.h"
+#include "third_party/skia/include/core/SkImageInfo.h"
 #include "third_party/skia/include/core/SkRefCnt.h"
 #include "third_party/skia/include/core/SkYUVAIndex.h"
 #include "third_party/skia/include/gpu/gl/GrGLTypes.h"
@@ -75,6 +76,17 @@ namespace cc {
 //
 // For examples of raster-scale caching, see https://goo.gl/0zCd9Z
 //
+// SPILLED DECODES:
+//
+// Below these two caches is |spilled_decodes_|, which keeps the unlocked
+// discardable memory of RGBX decodes once their ImageData stops holding it:
+// either because the ImageData was evicted from the |persistent_cache_|, or
+// because a GPU image was uploaded and its CPU-side data is no longer needed.
+// Spilled decodes are keyed by frame and upload scale mip level, and are taken
+// back (without a copy) the next time that image has to be decoded at that
+// scale, which avoids a full decode if the memory hasn't been purged. They are
+// budgeted separately from the working set, and dropped under memory pressure.
+//
 // REF COUNTING:
 //
 // In dealing with the two caches in GpuImageDecodeCache, there are three
@@ -163,6 +175,9 @@ class CC_EXPORT GpuImageDecodeCache
   size_t GetNumCacheEntriesForTesting() const {
     return persistent_cache_.size();
   }
+  size_t GetNumSpilledDecodesForTesting() const {
+    return spilled_decodes_.size();
+  }
   size_t GetInUseCacheEntriesForTesting() const { return in_use_cache_.size(); }
   size_t GetDrawImageSizeForTesting(const DrawImage& image);
   void SetImageDecodingFailedForTesting(const DrawImage& image);
@@ -232,6 +247,10 @@ class CC_EXPORT GpuImageDecodeCache
                        sk_sp<SkImage> image_v,
                        bool out_of_raster);
     void ResetData();
+    // Resets the data like ResetData, but returns its memory, unlocked, rather
+    // than freeing it. Sets |image_info| to the info of the decoded image. Not
+    // supported for YUV or bitmap backed images.
+    std::unique_ptr<base::DiscardableMemory> TakeData(SkImageInfo* image_info);
     base::DiscardableMemory* data() const { return data_.get(); }
 
     void SetBitmapImage(sk_sp<SkImage> image);
@@ -590,6 +609,16 @@ class CC_EXPORT GpuImageDecodeCache
   void UploadImageIfNecessary(const DrawImage& draw_image,
                               ImageData* image_data);
 
+  // For large images that need to be decoded and uploaded through the
+  // transfer cache, decodes |draw_image| directly into the mapped memory of a
+  // new transfer cache entry, skipping the discardable decode and its copy
+  // into the transfer buffer. The decode isn't kept on the CPU, so if the
+  // upload is purged the image is decoded again. Returns false if the image
+  // should be decoded and uploaded separately instead. Requires that the
+  // |context_| lock be held when calling.
+  bool DecodeIntoTransferCacheIfPossible(const DrawImage& draw_image,
+                                         ImageData* image_data);
+
   // Runs pending operations that required the |context_| lock to be held, but
   // were queued up during a time when the |context_| lock was unavailable.
   // These including deleting, unlocking, and locking textures.
@@ -610,6 +639,46 @@ class CC_EXPORT GpuImageDecodeCache
   template <typename Iterator>
   Iterator RemoveFromPersistentCache(Iterator it);
 
+  // |spilled_decodes_| holds decoded memory which was released by ImageDatas,
+  // so that it can be re-used if the same image is decoded at the same scale
+  // again.
+  struct SpilledDecodeKey {
+    bool operator==(const SpilledDecodeKey& other) const;
+
+    PaintImage::FrameKey frame_key;
+    int upload_scale_mip_level;
+  };
+  struct SpilledDecodeKeyHash {
+    size_t operator()(const SpilledDecodeKey&) const;
+  };
+  struct SpilledDecode {
+    SpilledDecode(std::unique_ptr<base::DiscardableMemory> data,
+                  const SkImageInfo& image_info);
+    SpilledDecode(SpilledDecode&& other);
+    ~SpilledDecode();
+
+    SpilledDecode& operator=(SpilledDecode&& other);
+
+    std::unique_ptr<base::DiscardableMemory> data;
+    SkImageInfo image_info;
+  };
+  using SpilledDecodeCache = base::HashingMRUCache<SpilledDecodeKey,
+                                                   SpilledDecode,
+                                                   SpilledDecodeKeyHash>;
+
+  // Frees the decoded data of |image_data|, moving it to |spilled_decodes_| if
+  // it can be re-used.
+  void SpillDecodedData(const PaintImage::FrameKey& frame_key,
+                        ImageData* image_data);
+  // Sets the decoded data of |image_data| from |spilled_decodes_|, if there is
+  // a matching entry whose memory can still be locked. Returns true on
+  // success.
+  bool TryUseSpilledDecode(const DrawImage& draw_image,
+                           ImageData* image_data,
+                           TaskType task_type);
+  // Evicts spilled decodes in LRU order until they fit in their budget.
+  void EnsureSpilledDecodesCapacity();
+
   // Adds mips to an image if required.
   void UpdateMipsIfNeeded(const DrawImage& draw_image, ImageData* image_data);
 
@@ -644,6 +713,9 @@ class CC_EXPORT GpuImageDecodeCache
       std::unordered_map<InUseCacheKey, InUseCacheEntry, InUseCacheKeyHash>;
   InUseCache in_use_cache_;
 
+  SpilledDecodeCache spilled_decodes_;
+  size_t spilled_decodes_bytes_ = 0;
+
   size_t max_working_set_bytes_ = 0;
   size_t max_working_set_items_ = 0;
   size_t working_set_bytes_ = 0;
@@ -8,6 +8,7 @@
 #include "cc/paint/draw_image.h"
 #include "cc/paint/paint_image_builder.h"
 #include "cc/raster/tile_task.h"
+#include "cc/test/skia_common.h"
 #include "cc/test/test_in_process_context_provider.h"
 #include "cc/tiles/gpu_image_decode_cache.h"
 #include "gpu/command_buffer/client/raster_interface.h"
@@ -187,5 +188,35 @@ TEST_P(GpuImageDecodeCachePerfTest, AcquireExistingImages) {
                          "runs/s", true);
 }
 
+TEST_P(GpuImageDecodeCachePerfTest, AcquireEvictedImages) {
+  CreateCache();
+  // Only the last 2 content ids of an image are cached, so cycling through 3
+  // of them evicts the one that is needed next every time.
+  const PaintImage::Id paint_image_id = PaintImage::GetNextId();
+  std::vector<DrawImage> images;
+  for (int i = 0; i < 3; ++i) {
+    PaintImage paint_image = CreateDiscardablePaintImage(
+        gfx::Size(1024, 2048), nullptr /* color_space */,
+        true /* allocate_encoded_data */, paint_image_id);
+    images.emplace_back(paint_image, SkIRect::MakeWH(1024, 2048),
+                        kMedium_SkFilterQuality,
+                        CreateMatrix(SkSize::Make(1.0f, 1.0f)), 0u);
+  }
+
+  timer_.Reset();
+  size_t index = 0;
+  do {
+    const DrawImage& image = images[index];
+    DecodedDrawImage decoded_image = cache_->GetDecodedImageForDraw(image);
+    cache_->DrawWithImageFinished(image, decoded_image);
+    index = (index + 1) % images.size();
+    timer_.NextLap();
+  } while (!timer_.HasTimeLimitExpired());
+
+  perf_test::PrintResult("gpu_image_decode_cache_acquire_evicted_images",
+                         ParamName(), "result", timer_.LapsPerSecond(),
+                         "runs/s", true);
+}
+
 }  // namespace
 }  // namespace cc
@@ -996,6 +996,44 @@ TEST_P(GpuImageDecodeCacheTest, GetDecodedImageForDraw) {
   cache->UnrefImage(draw_image);
 }
 
+TEST_P(GpuImageDecodeCacheTest, GetDecodedImageForDrawIntoTransferCache) {
+  // Large images decoded at raster are decoded directly into the transfer
+  // cache entry.
+  if (!use_transfer_cache_ || do_yuv_decode_)
+    return;
+
+  auto cache = CreateCache();
+  bool is_decomposable = true;
+  SkFilterQuality quality = kHigh_SkFilterQuality;
+
+  int dimension = std::min(1024, max_texture_size_ - 1);
+  PaintImage image = CreatePaintImageInternal(gfx::Size(dimension, dimension));
+  DrawImage draw_image(image, SkIRect::MakeWH(image.width(), image.height()),
+                       quality,
+                       CreateMatrix(SkSize::Make(1.0f, 1.0f), is_decomposable),
+                       PaintImage::kDefaultFrameIndex);
+
+  viz::ContextProvider::ScopedContextLock context_lock(context_provider());
+  DecodedDrawImage decoded_draw_image =
+      EnsureImageBacked(cache->GetDecodedImageForDraw(draw_image));
+  ASSERT_TRUE(decoded_draw_image.image());
+  EXPECT_TRUE(decoded_draw_image.image()->isTextureBacked());
+  EXPECT_EQ(decoded_draw_image.image()->width(), dimension);
+  EXPECT_EQ(decoded_draw_image.image()->height(), dimension);
+  if (GetBytesNeededForSingleImage(gfx::Size(dimension, dimension)) >=
+      1024 * 1024) {
+    EXPECT_FALSE(cache->GetSWImageDecodeForTesting(draw_image));
+  }
+
+  cache->DrawWithImageFinished(draw_image, decoded_draw_image);
+
+  // The upload is reused the next time the image is drawn.
+  DecodedDrawImage second_decoded_draw_image =
+      EnsureImageBacked(cache->GetDecodedImageForDraw(draw_image));
+  EXPECT_EQ(decoded_draw_image.image(), second_decoded_draw_image.image());
+  cache->DrawWithImageFinished(draw_image, second_decoded_draw_image);
+}
+
 TEST_P(GpuImageDecodeCacheTest, GetLargeDecodedImageForDraw) {
   auto cache = CreateCache();
   bool is_decomposable = true;
@@ -2476,6 +2514,59 @@ TEST_P(GpuImageDecodeCacheTest, KeepOnlyLast2ContentIds) {
   EXPECT_EQ(cache->paint_image_entries_count_for_testing(), 0u);
 }
 
+TEST_P(GpuImageDecodeCacheTest, EvictedDecodesAreReused) {
+  // YUV decodes are not kept once evicted.
+  if (do_yuv_decode_)
+    return;
+
+  auto cache = CreateCache();
+  bool is_decomposable = true;
+  SkFilterQuality quality = kHigh_SkFilterQuality;
+
+  viz::ContextProvider::ScopedContextLock context_lock(context_provider());
+  const PaintImage::Id paint_image_id = PaintImage::GetNextId();
+  const gfx::Size test_image_size = GetNormalImageSize();
+  SkImageInfo info =
+      SkImageInfo::Make(test_image_size.width(), test_image_size.height(),
+                        color_type_, kPremul_SkAlphaType);
+  std::vector<sk_sp<FakePaintImageGenerator>> generators;
+  std::vector<DrawImage> draw_images;
+
+  // Only the last 2 content ids of an image are cached, so the third one
+  // evicts the first.
+  for (int i = 0; i < 3; ++i) {
+    generators.push_back(sk_make_sp<FakePaintImageGenerator>(info));
+    PaintImage image = PaintImageBuilder::WithDefault()
+                           .set_id(paint_image_id)
+                           .set_paint_image_generator(generators.back())
+                           .TakePaintImage();
+    draw_images.emplace_back(
+        image, SkIRect::MakeWH(image.width(), image.height()), quality,
+        CreateMatrix(SkSize::Make(1.0f, 1.0f), is_decomposable),
+        PaintImage::kDefaultFrameIndex);
+    DecodedDrawImage decoded_draw_image =
+        EnsureImageBacked(cache->GetDecodedImageForDraw(draw_images.back()));
+    ASSERT_TRUE(decoded_draw_image.image());
+    cache->DrawWithImageFinished(draw_images.back(), decoded_draw_image);
+    EXPECT_EQ(generators.back()->frames_decoded().size(), 1u);
+  }
+  EXPECT_FALSE(cache->IsInPersistentCacheForTesting(draw_images[0]));
+  EXPECT_GT(cache->GetNumSpilledDecodesForTesting(), 0u);
+
+  // Drawing the first image again uses its decode from before it was evicted.
+  generators[0]->reset_frames_decoded();
+  DecodedDrawImage decoded_draw_image =
+      EnsureImageBacked(cache->GetDecodedImageForDraw(draw_images[0]));
+  ASSERT_TRUE(decoded_draw_image.image());
+  EXPECT_TRUE(generators[0]->frames_decoded().empty());
+  cache->DrawWithImageFinished(draw_images[0], decoded_draw_image);
+
+  // Spilled decodes are dropped under memory pressure.
+  cache->OnMemoryPressure(
+      base::MemoryPressureListener::MEMORY_PRESSURE_LEVEL_CRITICAL);
+  EXPECT_EQ(cache->GetNumSpilledDecodesForTesting(), 0u);
+}
+
 TEST_P(GpuImageDecodeCacheTest, DecodeToScale) {
   if (do_yuv_decode_) {
     // TODO(crbug.com/927437): Modify test after decoding to scale for YUV is
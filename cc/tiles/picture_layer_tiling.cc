@@ -29,6 +29,41 @@
 #include "ui/gfx/geometry/size_conversions.h"
 
 namespace cc {
+namespace {
+
+// Returns the time it takes for |visible_rect| moving at |velocity| to reach
+// the span [|begin|, |end|) along one axis, or infinity if it never does.
+float TimeToReachSpan(int visible_begin,
+                      int visible_end,
+                      int begin,
+                      int end,
+                      float velocity) {
+  if (begin < visible_end && visible_begin < end)
+    return 0.f;
+  if (end <= visible_begin && velocity < 0.f)
+    return (visible_begin - end) / -velocity;
+  if (begin >= visible_end && velocity > 0.f)
+    return (begin - visible_end) / velocity;
+  return std::numeric_limits<float>::infinity();
+}
+
+// Returns the time until a tile at |tile_bounds| intersects |visible_rect|,
+// assuming that the visible rect keeps moving at |velocity|.
+float ComputeTimeToVisible(const gfx::Rect& visible_rect,
+                           const gfx::Rect& tile_bounds,
+                           const gfx::Vector2dF& velocity) {
+  // The tile only becomes visible once it is reached along both axes, so this
+  // is the later of the two times. It ignores that one axis can pass the tile
+  // before the other reaches it, which is rare for the soon tiles that this is
+  // used for.
+  return std::max(
+      TimeToReachSpan(visible_rect.x(), visible_rect.right(), tile_bounds.x(),
+                      tile_bounds.right(), velocity.x()),
+      TimeToReachSpan(visible_rect.y(), visible_rect.bottom(), tile_bounds.y(),
+                      tile_bounds.bottom(), velocity.y()));
+}
+
+}  // namespace
 
 PictureLayerTiling::PictureLayerTiling(
     WhichTree tree,
@@ -163,6 +198,8 @@ void PictureLayerTiling::TakeTilesAndPropertiesFrom(
                        pending_twin->current_soon_border_rect_,
                        pending_twin->current_eventually_rect_,
                        pending_twin->current_occlusion_in_layer_space_);
+  current_scroll_velocity_in_content_space_ =
+      pending_twin->current_scroll_velocity_in_content_space_;
 }
 
 void PictureLayerTiling::SetRasterSourceAndResize(
@@ -597,6 +634,9 @@ void PictureLayerTiling::ComputeTilePriorityRects(
   SetTilePriorityRects(content_to_screen_scale, output_rects[0],
                        output_rects[1], output_rects[2], output_rects[3],
                        occlusion_in_layer_space);
+  current_scroll_velocity_in_content_space_ =
+      gfx::ScaleVector2d(scroll_velocity_in_layer_space_,
+                         raster_transform_.scale());
   SetLiveTilesRect(output_rects[3]);
 }
 
@@ -921,8 +961,12 @@ TilePriority PictureLayerTiling::ComputePriorityForTile(
   float distance_to_visible =
       current_content_to_screen_scale_ *
       current_visible_rect_.ManhattanInternalDistance(tile_bounds);
+  float time_to_visible_in_seconds =
+      ComputeTimeToVisible(current_visible_rect_, tile_bounds,
+                           current_scroll_velocity_in_content_space_);
 
-  return TilePriority(resolution_, priority_bin, distance_to_visible);
+  return TilePriority(resolution_, priority_bin, distance_to_visible,
+                      time_to_visible_in_seconds);
 }
 
 PictureLayerTiling::PriorityRectType
@@ -22,6 +22,7 @@
 #include "cc/trees/occlusion.h"
 #include "ui/gfx/geometry/axis_transform2d.h"
 #include "ui/gfx/geometry/rect.h"
+#include "ui/gfx/geometry/vector2d_f.h"
 
 namespace base {
 namespace trace_event {
@@ -192,6 +193,13 @@ class CC_EXPORT PictureLayerTiling {
   std::map<const Tile*, PrioritizedTile>
   UpdateAndGetAllPrioritizedTilesForTesting() const;
 
+  // The velocity of the visible rect in layer space pixels per second, used to
+  // estimate when tiles outside of the visible rect become visible. It is
+  // applied by the next call to ComputeTilePriorityRects().
+  void set_scroll_velocity_in_layer_space(const gfx::Vector2dF& velocity) {
+    scroll_velocity_in_layer_space_ = velocity;
+  }
+
   void SetAllTilesOccludedForTesting() {
     gfx::Rect viewport_in_layer_space =
         EnclosingLayerRectFromContentsRect(current_visible_rect_);
@@ -387,6 +395,8 @@ class CC_EXPORT PictureLayerTiling {
   // Other properties used for tile iteration and prioritization.
   float current_content_to_screen_scale_ = 0.f;
   Occlusion current_occlusion_in_layer_space_;
+  gfx::Vector2dF scroll_velocity_in_layer_space_;
+  gfx::Vector2dF current_scroll_velocity_in_content_space_;
   float max_skewport_extent_in_screen_space_ = 0.f;
 
   bool has_visible_rect_tiles_ = false;
@@ -464,6 +464,28 @@ gfx::Rect PictureLayerTilingSet::ComputeSkewport(
   return skewport;
 }
 
+gfx::Vector2dF PictureLayerTilingSet::ComputeScrollVelocity(
+    const gfx::Rect& visible_rect_in_layer_space,
+    double current_frame_time_in_seconds) const {
+  if (visible_rect_in_layer_space.IsEmpty() || visible_rect_history_.empty())
+    return gfx::Vector2dF();
+
+  // Use the same history as the skewport, so that the two agree on where the
+  // visible rect is heading.
+  const auto& historical_frame = visible_rect_history_.back();
+  if (historical_frame.visible_rect_in_layer_space.IsEmpty())
+    return gfx::Vector2dF();
+  double time_delta =
+      current_frame_time_in_seconds - historical_frame.frame_time_in_seconds;
+  if (time_delta <= 0.)
+    return gfx::Vector2dF();
+
+  gfx::Vector2dF velocity(visible_rect_in_layer_space.origin() -
+                          historical_frame.visible_rect_in_layer_space.origin());
+  velocity.Scale(1.f / time_delta);
+  return velocity;
+}
+
 gfx::Rect PictureLayerTilingSet::ComputeSoonBorderRect(
     const gfx::Rect& visible_rect,
     float ideal_contents_scale) {
@@ -504,6 +526,9 @@ void PictureLayerTilingSet::UpdatePriorityRects(
   DCHECK(skewport_in_layer_space_.Contains(visible_rect_in_layer_space_));
   DCHECK(eventually_rect_in_layer_space_.Contains(skewport_in_layer_space_));
 
+  scroll_velocity_in_layer_space_ = ComputeScrollVelocity(
+      visible_rect_in_layer_space_, current_frame_time_in_seconds);
+
   soon_border_rect_in_layer_space_ =
       ComputeSoonBorderRect(visible_rect_in_layer_space_, ideal_contents_scale);
   DCHECK(
@@ -540,6 +565,7 @@ bool PictureLayerTilingSet::UpdateTilePriorities(
   for (const auto& tiling : tilings_) {
     tiling->set_can_require_tiles_for_activation(
         can_require_tiles_for_activation);
+    tiling->set_scroll_velocity_in_layer_space(scroll_velocity_in_layer_space_);
     tiling->ComputeTilePriorityRects(
         visible_rect_in_layer_space_, skewport_in_layer_space_,
         soon_border_rect_in_layer_space_, eventually_rect_in_layer_space_,
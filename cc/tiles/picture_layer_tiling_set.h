@@ -237,6 +237,9 @@ class CC_EXPORT PictureLayerTilingSet {
   gfx::Rect ComputeSkewport(const gfx::Rect& visible_rect_in_layer_space,
                             double current_frame_time_in_seconds,
                             float ideal_contents_scale);
+  gfx::Vector2dF ComputeScrollVelocity(
+      const gfx::Rect& visible_rect_in_layer_space,
+      double current_frame_time_in_seconds) const;
   gfx::Rect ComputeSoonBorderRect(const gfx::Rect& visible_rect_in_layer_space,
                                   float ideal_contents_scale);
   void UpdatePriorityRects(const gfx::Rect& visible_rect_in_layer_space,
@@ -262,6 +265,8 @@ class CC_EXPORT PictureLayerTilingSet {
   gfx::Rect skewport_in_layer_space_;
   gfx::Rect soon_border_rect_in_layer_space_;
   gfx::Rect eventually_rect_in_layer_space_;
+  // Layer space pixels per second that the visible rect moves by.
+  gfx::Vector2dF scroll_velocity_in_layer_space_;
 
   friend class Iterator;
 };
@@ -902,6 +902,54 @@ TEST(ComputeTilePriorityRectsTest, OffscreenTiles) {
   EXPECT_GT(right.distance_to_visible, left.distance_to_visible);
 }
 
+TEST(ComputeTilePriorityRectsTest, ScrollingTowardsOffscreenTiles) {
+  // Offscreen tiles that the viewport is moving towards should have a finite
+  // time_to_visible, and go before tiles at the same distance behind it.
+  FakePictureLayerTilingClient client;
+  client.SetTileSize(gfx::Size(100, 100));
+
+  scoped_refptr<FakeRasterSource> raster_source =
+      FakeRasterSource::CreateFilled(gfx::Size(400, 100));
+  std::unique_ptr<TestablePictureLayerTiling> tiling =
+      TestablePictureLayerTiling::Create(ACTIVE_TREE, gfx::AxisTransform2d(),
+                                         raster_source, &client,
+                                         LayerTreeSettings());
+  tiling->set_resolution(HIGH_RESOLUTION);
+
+  gfx::Rect visible_rect(150, 0, 100, 100);
+  gfx::Rect eventually_rect(0, 0, 400, 100);
+  tiling->set_scroll_velocity_in_layer_space(gfx::Vector2dF(200.f, 0.f));
+  tiling->ComputeTilePriorityRects(visible_rect, visible_rect, eventually_rect,
+                                   eventually_rect, 1.f, Occlusion());
+  auto prioritized_tiles = tiling->UpdateAndGetAllPrioritizedTilesForTesting();
+
+  ASSERT_TRUE(tiling->TileAt(0, 0));
+  ASSERT_TRUE(tiling->TileAt(3, 0));
+
+  TilePriority visible = prioritized_tiles[tiling->TileAt(1, 0)].priority();
+  EXPECT_EQ(0.f, visible.time_to_visible_in_seconds);
+
+  TilePriority behind = prioritized_tiles[tiling->TileAt(0, 0)].priority();
+  TilePriority ahead = prioritized_tiles[tiling->TileAt(3, 0)].priority();
+  EXPECT_EQ(TilePriority::SOON, behind.priority_bin);
+  EXPECT_EQ(TilePriority::SOON, ahead.priority_bin);
+  EXPECT_EQ(std::numeric_limits<float>::infinity(),
+            behind.time_to_visible_in_seconds);
+  EXPECT_GT(ahead.time_to_visible_in_seconds, 0.f);
+  EXPECT_LT(ahead.time_to_visible_in_seconds, 1.f);
+  EXPECT_TRUE(ahead.IsHigherPriorityThan(behind));
+  EXPECT_FALSE(behind.IsHigherPriorityThan(ahead));
+
+  // Without movement, the order only depends on the distance to visible.
+  tiling->set_scroll_velocity_in_layer_space(gfx::Vector2dF());
+  tiling->ComputeTilePriorityRects(visible_rect, visible_rect, eventually_rect,
+                                   eventually_rect, 1.f, Occlusion());
+  prioritized_tiles = tiling->UpdateAndGetAllPrioritizedTilesForTesting();
+  ahead = prioritized_tiles[tiling->TileAt(3, 0)].priority();
+  EXPECT_EQ(std::numeric_limits<float>::infinity(),
+            ahead.time_to_visible_in_seconds);
+}
+
 TEST(ComputeTilePriorityRectsTest, PartiallyOffscreenLayer) {
   // Sanity check that a layer with some tiles visible and others offscreen has
   // correct TilePriorities for each tile.
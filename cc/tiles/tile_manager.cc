@@ -29,6 +29,7 @@
 #include "cc/raster/task_category.h"
 #include "cc/tiles/frame_viewer_instrumentation.h"
 #include "cc/tiles/tile.h"
+#include "components/viz/common/resources/resource_format_utils.h"
 #include "components/viz/common/resources/resource_sizes.h"
 #include "ui/gfx/geometry/axis_transform2d.h"
 #include "ui/gfx/geometry/rect_conversions.h"
@@ -388,6 +389,41 @@ class DidFinishRunningAllTilesTask : public TileTask {
   CompletionCb completion_cb_;
 };
 
+// Tiles that the viewport is predicted to reach within this time, but that
+// could not be scheduled for raster, are likely to checkerboard.
+const float kPredictedCheckerboardTimeInSeconds = 1.f;
+
+// Records the raster schedule metrics for |tiles_to_raster|, given that the
+// remaining tiles in |raster_priority_queue| were not scheduled. This consumes
+// the queue.
+void RecordRasterScheduleMetrics(
+    const std::vector<PrioritizedTile>& tiles_to_raster,
+    RasterTilePriorityQueue* raster_priority_queue) {
+  int64_t scheduled_raster_area = 0;
+  for (const auto& prioritized_tile : tiles_to_raster)
+    scheduled_raster_area +=
+        prioritized_tile.tile()->content_rect().size().GetArea();
+
+  int64_t predicted_checkerboard_area = 0;
+  for (; !raster_priority_queue->IsEmpty(); raster_priority_queue->Pop()) {
+    const PrioritizedTile& prioritized_tile = raster_priority_queue->Top();
+    const TilePriority& priority = prioritized_tile.priority();
+    if (priority.priority_bin == TilePriority::EVENTUALLY)
+      break;
+    if (priority.time_to_visible_in_seconds >
+        kPredictedCheckerboardTimeInSeconds) {
+      continue;
+    }
+    if (!prioritized_tile.tile()->draw_info().NeedsRaster())
+      continue;
+    predicted_checkerboard_area +=
+        prioritized_tile.tile()->content_rect().size().GetArea();
+  }
+
+  frame_viewer_instrumentation::RecordRasterScheduleMetrics(
+      scheduled_raster_area, predicted_checkerboard_area);
+}
+
 }  // namespace
 
 RasterTaskCompletionStats::RasterTaskCompletionStats()
@@ -844,6 +880,10 @@ TileManager::PrioritizedWorkToSchedule TileManager::AssignGpuMemoryToTiles() {
     work_to_schedule.tiles_to_raster.push_back(prioritized_tile);
   }
 
+  if (frame_viewer_instrumentation::IsTracingRasterScheduleMetrics())
+    RecordRasterScheduleMetrics(work_to_schedule.tiles_to_raster,
+                                raster_priority_queue.get());
+
   // Note that we should try and further reduce memory in case the above loop
   // didn't reduce memory. This ensures that we always release as many resources
   // as possible to stay within the memory limit.
@@ -1164,6 +1204,7 @@ scoped_refptr<TileTask> TileManager::CreateRasterTask(
                "TileManager::CreateRasterTask", "Tile", tile->id());
 
   // Get the resource.
+  const viz::ResourceFormat resource_format = DetermineResourceFormat(tile);
   ResourcePool::InUsePoolResource resource;
   uint64_t resource_content_id = 0;
   gfx::Rect invalidated_rect = tile->invalidated_content_rect();
@@ -1171,17 +1212,19 @@ scoped_refptr<TileTask> TileManager::CreateRasterTask(
     resource = resource_pool_->TryAcquireResourceForPartialRaster(
         tile->id(), tile->invalidated_content_rect(), tile->invalidated_id(),
         &invalidated_rect);
+    // The previous content may be in a compressed resource, which can't be
+    // partially rastered into.
+    if (resource && resource.format() != resource_format)
+      resource_pool_->ReleaseResource(std::move(resource));
   }
   const gfx::ColorSpace& raster_color_space = client_->GetRasterColorSpace();
   bool partial_tile_decode = false;
   if (resource) {
     resource_content_id = tile->invalidated_id();
-    DCHECK_EQ(DetermineResourceFormat(tile), resource.format());
     partial_tile_decode = true;
   } else {
-    resource = resource_pool_->AcquireResource(tile->desired_texture_size(),
-                                               DetermineResourceFormat(tile),
-                                               raster_color_space);
+    resource = resource_pool_->AcquireResource(
+        tile->desired_texture_size(), resource_format, raster_color_space);
     DCHECK(resource);
   }
 
@@ -1340,7 +1383,10 @@ void TileManager::OnRasterTaskCompleted(
 
   TileDrawInfo& draw_info = tile->draw_info();
   if (exported) {
-    bool needs_swizzle = raster_buffer_provider_->IsResourceSwizzleRequired();
+    // Compressed resources are encoded in the order of the texture format.
+    bool needs_swizzle =
+        !viz::IsResourceFormatCompressed(resource.format()) &&
+        raster_buffer_provider_->IsResourceSwizzleRequired();
     bool is_premultiplied = raster_buffer_provider_->IsResourcePremultiplied();
     draw_info.SetResource(std::move(resource),
                           raster_task_was_scheduled_with_checker_images,
@@ -1619,6 +1665,17 @@ void TileManager::NeedsInvalidationForCheckerImagedTiles() {
 
 viz::ResourceFormat TileManager::DetermineResourceFormat(
     const Tile* tile) const {
+  // A compressed resource is encoded again whenever its tile is rastered, so
+  // it is only used for opaque tiles that don't replace an invalidated tile,
+  // since those are likely to be invalidated again. Its size must be whole
+  // ETC1 blocks, with rows that need no padding.
+  const gfx::Size& size = tile->desired_texture_size();
+  if (raster_buffer_provider_->CanRasterIntoCompressedResource() &&
+      !tile->invalidated_id() &&
+      !tile->tiling()->raster_source()->requires_clear() &&
+      size.width() % 8 == 0 && size.height() % 4 == 0) {
+    return viz::ETC1;
+  }
   return raster_buffer_provider_->GetResourceFormat();
 }
 
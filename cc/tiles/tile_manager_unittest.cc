@@ -2170,6 +2170,89 @@ TEST_F(TileManagerTest, PartialRasterSuccessfullyDisabled) {
   RunPartialRasterCheck(TakeHostImpl(), false /* partial_raster_enabled */);
 }
 
+class VerifyResourceFormatRasterBufferProvider
+    : public FakeRasterBufferProviderImpl {
+ public:
+  explicit VerifyResourceFormatRasterBufferProvider(
+      viz::ResourceFormat expected_format)
+      : expected_format_(expected_format) {}
+  ~VerifyResourceFormatRasterBufferProvider() override = default;
+
+  // RasterBufferProvider methods.
+  bool CanRasterIntoCompressedResource() const override { return true; }
+  std::unique_ptr<RasterBuffer> AcquireBufferForRaster(
+      const ResourcePool::InUsePoolResource& resource,
+      uint64_t resource_content_id,
+      uint64_t previous_content_id) override {
+    EXPECT_EQ(expected_format_, resource.format());
+    ++num_acquired_buffers_;
+    return nullptr;
+  }
+
+  int num_acquired_buffers() const { return num_acquired_buffers_; }
+
+ private:
+  viz::ResourceFormat expected_format_;
+  int num_acquired_buffers_ = 0;
+};
+
+// Runs a test to ensure that opaque tiles are rastered into compressed
+// resources, unless they replace an invalidated tile.
+void RunCompressedResourceCheck(std::unique_ptr<LayerTreeHostImpl> host_impl,
+                                bool invalidated) {
+  const int kLayerId = 7;
+  const uint64_t kInvalidatedId = 43;
+  const gfx::Size kTileSize(128, 128);
+
+  host_impl->tile_manager()->SetTileTaskManagerForTesting(
+      std::make_unique<FakeTileTaskManagerImpl>());
+
+  VerifyResourceFormatRasterBufferProvider raster_buffer_provider(
+      invalidated ? viz::RGBA_8888 : viz::ETC1);
+  host_impl->tile_manager()->SetRasterBufferProviderForTesting(
+      &raster_buffer_provider);
+
+  // This raster source doesn't require clearing, so its content is opaque.
+  scoped_refptr<FakeRasterSource> pending_raster_source =
+      FakeRasterSource::CreateFilled(kTileSize);
+  ASSERT_FALSE(pending_raster_source->requires_clear());
+  host_impl->CreatePendingTree();
+  LayerTreeImpl* pending_tree = host_impl->pending_tree();
+  pending_tree->SetDeviceViewportSize(
+      host_impl->active_tree()->GetDeviceViewport().size());
+
+  std::unique_ptr<FakePictureLayerImpl> pending_layer =
+      FakePictureLayerImpl::CreateWithRasterSource(pending_tree, kLayerId,
+                                                   pending_raster_source);
+  pending_layer->SetDrawsContent(true);
+  pending_layer->SetBounds(pending_layer->raster_source()->GetSize());
+  pending_tree->SetRootLayerForTesting(std::move(pending_layer));
+
+  host_impl->pending_tree()->BuildLayerListAndPropertyTreesForTesting();
+  host_impl->pending_tree()->UpdateDrawProperties();
+
+  std::unique_ptr<RasterTilePriorityQueue> queue(host_impl->BuildRasterQueue(
+      SAME_PRIORITY_FOR_BOTH_TREES, RasterTilePriorityQueue::Type::ALL));
+  ASSERT_FALSE(queue->IsEmpty());
+  if (invalidated)
+    queue->Top().tile()->SetInvalidated(gfx::Rect(), kInvalidatedId);
+
+  host_impl->tile_manager()->PrepareTiles(host_impl->global_tile_state());
+  EXPECT_GT(raster_buffer_provider.num_acquired_buffers(), 0);
+
+  // Free our host_impl before the raster buffer provider we passed it, as it
+  // will use that class in clean up.
+  host_impl = nullptr;
+}
+
+TEST_F(TileManagerTest, OpaqueTilesUseCompressedResources) {
+  RunCompressedResourceCheck(TakeHostImpl(), false /* invalidated */);
+}
+
+TEST_F(TileManagerTest, InvalidatedTilesDontUseCompressedResources) {
+  RunCompressedResourceCheck(TakeHostImpl(), true /* invalidated */);
+}
+
 class InvalidResourceRasterBufferProvider
     : public FakeRasterBufferProviderImpl {
  public:
@@ -44,26 +44,46 @@ struct CC_EXPORT TilePriority {
   TilePriority()
       : resolution(NON_IDEAL_RESOLUTION),
         priority_bin(EVENTUALLY),
-        distance_to_visible(std::numeric_limits<float>::infinity()) {}
+        distance_to_visible(std::numeric_limits<float>::infinity()),
+        time_to_visible_in_seconds(std::numeric_limits<float>::infinity()) {}
 
   TilePriority(TileResolution resolution,
                PriorityBin bin,
                float distance_to_visible)
+      : TilePriority(resolution,
+                     bin,
+                     distance_to_visible,
+                     distance_to_visible == 0.f
+                         ? 0.f
+                         : std::numeric_limits<float>::infinity()) {}
+
+  TilePriority(TileResolution resolution,
+               PriorityBin bin,
+               float distance_to_visible,
+               float time_to_visible_in_seconds)
       : resolution(resolution),
         priority_bin(bin),
-        distance_to_visible(distance_to_visible) {}
+        distance_to_visible(distance_to_visible),
+        time_to_visible_in_seconds(time_to_visible_in_seconds) {}
 
   void AsValueInto(base::trace_event::TracedValue* dict) const;
 
+  // Within a bin, tiles that the viewport is predicted to reach sooner go
+  // first, and the rest are ordered by their distance to the viewport.
   bool IsHigherPriorityThan(const TilePriority& other) const {
-    return priority_bin < other.priority_bin ||
-           (priority_bin == other.priority_bin &&
-            distance_to_visible < other.distance_to_visible);
+    if (priority_bin != other.priority_bin)
+      return priority_bin < other.priority_bin;
+    if (time_to_visible_in_seconds != other.time_to_visible_in_seconds)
+      return time_to_visible_in_seconds < other.time_to_visible_in_seconds;
+    return distance_to_visible < other.distance_to_visible;
   }
 
   TileResolution resolution;
   PriorityBin priority_bin;
   float distance_to_visible;
+  // The predicted time until the tile becomes visible, from the velocity of
+  // the viewport. Infinity if the viewport is not moving towards the tile.
+  float time_to_visible_in_seconds;
 };
 
 std::string TilePriorityBinToString(TilePriority::PriorityBin bin);
@@ -6,14 +6,20 @@
 
 #include <stddef.h>
 
+#include <utility>
 #include <vector>
 
 #include "base/containers/stack.h"
+#include "base/macros.h"
+#include "base/trace_event/trace_event.h"
 #include "cc/base/math_util.h"
 #include "cc/layers/draw_properties.h"
 #include "cc/layers/layer.h"
 #include "cc/layers/layer_impl.h"
 #include "cc/layers/picture_layer.h"
+#include "cc/raster/task.h"
+#include "cc/raster/task_category.h"
+#include "cc/raster/task_graph_runner.h"
 #include "cc/trees/clip_node.h"
 #include "cc/trees/effect_node.h"
 #include "cc/trees/layer_tree_impl.h"
@@ -761,6 +767,80 @@ static void ComputeClips(PropertyTrees* property_trees) {
   clip_tree->set_needs_update(false);
 }
 
+// The number of groups visible layers are split into when their transforms are
+// computed in parallel.
+constexpr size_t kNumTransformPartitions = 4;
+
+static void ComputeLayerTransforms(const std::vector<LayerImpl*>& layers,
+                                   PropertyTrees* property_trees) {
+  for (LayerImpl* layer : layers) {
+    const TransformNode* transform_node =
+        property_trees->transform_tree.Node(layer->transform_tree_index());
+
+    layer->draw_properties().screen_space_transform =
+        ScreenSpaceTransformInternal(layer, property_trees->transform_tree);
+    layer->draw_properties().target_space_transform = DrawTransform(
+        layer, property_trees->transform_tree, property_trees->effect_tree);
+    layer->draw_properties().screen_space_transform_is_animating =
+        transform_node->to_screen_is_potentially_animated;
+  }
+}
+
+class ComputeLayerTransformsTask : public Task {
+ public:
+  ComputeLayerTransformsTask(std::vector<LayerImpl*> layers,
+                             PropertyTrees* property_trees)
+      : layers_(std::move(layers)), property_trees_(property_trees) {}
+
+  // Task:
+  void RunOnWorkerThread() override {
+    TRACE_EVENT1("cc", "ComputeLayerTransformsTask", "layers", layers_.size());
+    ComputeLayerTransforms(layers_, property_trees_);
+  }
+
+ private:
+  ~ComputeLayerTransformsTask() override = default;
+
+  const std::vector<LayerImpl*> layers_;
+  PropertyTrees* const property_trees_;
+
+  DISALLOW_COPY_AND_ASSIGN(ComputeLayerTransformsTask);
+};
+
+// Computing a layer's draw transform fills in the draw transform cache of its
+// transform node, and reads nothing else that isn't already up to date. So the
+// transforms of layers with different transform nodes can be computed
+// concurrently, and the results don't depend on how the work is split.
+static void ComputeLayerTransformsInParallel(
+    const LayerImplList& layer_list,
+    PropertyTrees* property_trees,
+    TaskGraphRunner* task_graph_runner) {
+  std::vector<std::vector<LayerImpl*>> partitions(kNumTransformPartitions);
+  for (LayerImpl* layer : layer_list) {
+    partitions[layer->transform_tree_index() % kNumTransformPartitions]
+        .push_back(layer);
+  }
+
+  NamespaceToken token = task_graph_runner->GenerateNamespaceToken();
+  TaskGraph graph;
+  for (size_t i = 1; i < partitions.size(); ++i) {
+    if (partitions[i].empty())
+      continue;
+    graph.nodes.emplace_back(base::MakeRefCounted<ComputeLayerTransformsTask>(
+                                 std::move(partitions[i]), property_trees),
+                             TASK_CATEGORY_FOREGROUND, 0u /* priority */,
+                             0u /* dependencies */);
+  }
+  task_graph_runner->ScheduleTasks(token, &graph);
+
+  // The calling thread takes care of the first partition while it waits.
+  ComputeLayerTransforms(partitions[0], property_trees);
+
+  task_graph_runner->WaitForTasksToFinishRunning(token);
+  Task::Vector completed_tasks;
+  task_graph_runner->CollectCompletedTasks(token, &completed_tasks);
+}
+
 }  // namespace
 
 void ConcatInverseSurfaceContentsScale(const EffectNode* effect_node,
@@ -937,29 +1017,26 @@ gfx::Transform ScreenSpaceTransform(const LayerImpl* layer,
 }
 
 void ComputeDrawPropertiesOfVisibleLayers(const LayerImplList* layer_list,
-                                          PropertyTrees* property_trees) {
+                                          PropertyTrees* property_trees,
+                                          TaskGraphRunner* task_graph_runner) {
   // Compute transforms
-  for (LayerImpl* layer : *layer_list) {
-    const TransformNode* transform_node =
-        property_trees->transform_tree.Node(layer->transform_tree_index());
+  if (task_graph_runner && layer_list->size() > 1) {
+    ComputeLayerTransformsInParallel(*layer_list, property_trees,
+                                     task_graph_runner);
+  } else {
+    ComputeLayerTransforms(*layer_list, property_trees);
+  }
 
-    layer->draw_properties().screen_space_transform =
-        ScreenSpaceTransformInternal(layer, property_trees->transform_tree);
-    layer->draw_properties().target_space_transform = DrawTransform(
-        layer, property_trees->transform_tree, property_trees->effect_tree);
-    layer->draw_properties().screen_space_transform_is_animating =
-        transform_node->to_screen_is_potentially_animated;
+  // Compute effects and determine if render surfaces have contributing layers
+  // that escape clip. Rounded corners are computed here rather than with the
+  // transforms since they may use the draw transforms of other transform nodes.
+  for (LayerImpl* layer : *layer_list) {
     auto rounded_corner_info =
         GetRoundedCornerRRect(property_trees, layer->effect_tree_index(),
                               /*from_render_surface*/ false);
     layer->draw_properties().rounded_corner_bounds = rounded_corner_info.first;
     layer->draw_properties().is_fast_rounded_corner =
         rounded_corner_info.second;
-  }
-
-  // Compute effects and determine if render surfaces have contributing layers
-  // that escape clip.
-  for (LayerImpl* layer : *layer_list) {
     layer->draw_properties().opacity =
         LayerDrawOpacity(layer, property_trees->effect_tree);
     RenderSurfaceImpl* render_target = layer->render_target();
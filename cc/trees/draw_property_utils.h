@@ -20,6 +20,7 @@ class LayerImpl;
 class LayerTreeHost;
 class LayerTreeImpl;
 class RenderSurfaceImpl;
+class TaskGraphRunner;
 class EffectTree;
 class TransformTree;
 class PropertyTrees;
@@ -56,9 +57,12 @@ FindLayersThatNeedUpdates(LayerTreeImpl* layer_tree_impl,
                           const PropertyTrees* property_trees,
                           std::vector<LayerImpl*>* visible_layer_list);
 
+// If |task_graph_runner| is non-null, the transforms of the layers are computed
+// in parallel on it.
 void CC_EXPORT
 ComputeDrawPropertiesOfVisibleLayers(const LayerImplList* layer_list,
-                                     PropertyTrees* property_trees);
+                                     PropertyTrees* property_trees,
+                                     TaskGraphRunner* task_graph_runner);
 
 void CC_EXPORT ComputeMaskDrawProperties(LayerImpl* mask_layer,
                                          PropertyTrees* property_trees);
@@ -601,7 +601,8 @@ void CalculateDrawPropertiesInternal(
                  "draw_property_utils::ComputeDrawPropertiesOfVisibleLayers",
                  "visible_layers", visible_layer_list.size());
     draw_property_utils::ComputeDrawPropertiesOfVisibleLayers(
-        &visible_layer_list, inputs->property_trees);
+        &visible_layer_list, inputs->property_trees,
+        inputs->task_graph_runner);
   }
 
   {
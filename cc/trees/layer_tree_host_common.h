@@ -31,6 +31,7 @@ class LayerImpl;
 class Layer;
 class SwapPromise;
 class PropertyTrees;
+class TaskGraphRunner;
 
 class CC_EXPORT LayerTreeHostCommon {
  public:
@@ -94,6 +95,9 @@ class CC_EXPORT LayerTreeHostCommon {
     RenderSurfaceList* render_surface_list;
     PropertyTrees* property_trees;
     TransformNode* page_scale_transform_node;
+    // If set, the draw properties of visible layers are computed in parallel
+    // on this runner.
+    TaskGraphRunner* task_graph_runner = nullptr;
   };
 
   struct CC_EXPORT CalcDrawPropsImplInputsForTesting
@@ -77,6 +77,18 @@ class CalcDrawPropsTest : public LayerTreeHostCommonPerfTest {
  public:
   void RunCalcDrawProps() { RunTest(CompositorMode::SINGLE_THREADED); }
 
+  void RunCalcDrawPropsInParallel() {
+    compute_in_parallel_ = true;
+    RunCalcDrawProps();
+  }
+
+  // Forces the transform tree to be recomputed on every lap, which is what
+  // happens when a transform animates.
+  void RunCalcDrawPropsWithTransformUpdates() {
+    update_transforms_ = true;
+    RunCalcDrawProps();
+  }
+
   void BeginTest() override { PostSetNeedsCommitToMainThread(); }
 
   void DrawLayersOnThread(LayerTreeHostImpl* host_impl) override {
@@ -84,6 +96,8 @@ class CalcDrawPropsTest : public LayerTreeHostCommonPerfTest {
     LayerTreeImpl* active_tree = host_impl->active_tree();
 
     do {
+      if (update_transforms_)
+        active_tree->property_trees()->transform_tree.set_needs_update(true);
       int max_texture_size = 8096;
       DoCalcDrawPropertiesImpl(max_texture_size, active_tree, host_impl);
 
@@ -112,8 +126,14 @@ class CalcDrawPropsTest : public LayerTreeHostCommonPerfTest {
         active_tree->property_trees()->transform_tree.Node(
             active_tree->InnerViewportContainerLayer()
                 ->transform_tree_index()));
+    if (compute_in_parallel_)
+      inputs.task_graph_runner = task_graph_runner();
     LayerTreeHostCommon::CalculateDrawProperties(&inputs);
   }
+
+ private:
+  bool compute_in_parallel_ = false;
+  bool update_transforms_ = false;
 };
 
 TEST_F(CalcDrawPropsTest, TenTen) {
@@ -128,6 +148,18 @@ TEST_F(CalcDrawPropsTest, HeavyPage) {
   RunCalcDrawProps();
 }
 
+TEST_F(CalcDrawPropsTest, HeavyPageParallel) {
+  SetTestName("heavy_page_parallel");
+  ReadTestFile("heavy_layer_tree");
+  RunCalcDrawPropsInParallel();
+}
+
+TEST_F(CalcDrawPropsTest, HeavyPageTransformUpdates) {
+  SetTestName("heavy_page_transform_updates");
+  ReadTestFile("heavy_layer_tree");
+  RunCalcDrawPropsWithTransformUpdates();
+}
+
 TEST_F(CalcDrawPropsTest, TouchRegionLight) {
   SetTestName("touch_region_light");
   ReadTestFile("touch_region_light");
@@ -140,5 +172,11 @@ TEST_F(CalcDrawPropsTest, TouchRegionHeavy) {
   RunCalcDrawProps();
 }
 
+TEST_F(CalcDrawPropsTest, TouchRegionHeavyParallel) {
+  SetTestName("touch_region_heavy_parallel");
+  ReadTestFile("touch_region_heavy");
+  RunCalcDrawPropsInParallel();
+}
+
 }  // namespace
 }  // namespace cc
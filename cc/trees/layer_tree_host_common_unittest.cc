@@ -235,6 +235,12 @@ class LayerTreeHostCommonTestBase : public LayerTestCommon::LayerImplTest {
 
   void ExecuteCalculateDrawPropertiesAndSaveUpdateLayerList(
       LayerImpl* root_layer) {
+    ExecuteCalculateDrawPropertiesAndSaveUpdateLayerList(root_layer, nullptr);
+  }
+
+  void ExecuteCalculateDrawPropertiesAndSaveUpdateLayerList(
+      LayerImpl* root_layer,
+      TaskGraphRunner* task_graph_runner) {
     DCHECK(root_layer->layer_tree_impl());
     bool can_adjust_raster_scales = true;
 
@@ -268,7 +274,7 @@ class LayerTreeHostCommonTestBase : public LayerTestCommon::LayerImplTest {
         root_layer->layer_tree_impl(), property_trees,
         update_layer_impl_list_.get());
     draw_property_utils::ComputeDrawPropertiesOfVisibleLayers(
-        update_layer_impl_list(), property_trees);
+        update_layer_impl_list(), property_trees, task_graph_runner);
   }
 
   void ExecuteCalculateDrawPropertiesWithoutAdjustingRasterScales(
@@ -615,6 +621,45 @@ TEST_F(LayerTreeHostCommonTest, TransformsAboutScrollOffset) {
                                   sublayer->DrawTransform());
 }
 
+TEST_F(LayerTreeHostCommonTest, ParallelTransformsMatchSerialTransforms) {
+  LayerImpl* root = root_layer_for_testing();
+  root->SetBounds(gfx::Size(500, 500));
+
+  // A mix of nested and sibling layers with distinct transforms, some of which
+  // have render surfaces, spread over all the transform partitions.
+  std::vector<LayerImpl*> layers;
+  LayerImpl* parent = root;
+  for (int i = 0; i < 20; ++i) {
+    LayerImpl* layer = AddChild<LayerImpl>(i % 4 ? parent : root);
+    layer->test_properties()->transform.Translate(i, 2 * i);
+    layer->test_properties()->transform.Scale(1 + 0.1 * i, 1);
+    layer->test_properties()->force_render_surface = i % 5 == 0;
+    layer->SetBounds(gfx::Size(50, 50));
+    layer->SetDrawsContent(true);
+    layers.push_back(layer);
+    parent = layer;
+  }
+
+  ExecuteCalculateDrawPropertiesAndSaveUpdateLayerList(root);
+  std::vector<gfx::Transform> draw_transforms;
+  std::vector<gfx::Transform> screen_space_transforms;
+  for (LayerImpl* layer : layers) {
+    draw_transforms.push_back(layer->DrawTransform());
+    screen_space_transforms.push_back(layer->ScreenSpaceTransform());
+  }
+
+  TestTaskGraphRunner task_graph_runner;
+  host_impl()->active_tree()->property_trees()->needs_rebuild = true;
+  ExecuteCalculateDrawPropertiesAndSaveUpdateLayerList(root,
+                                                       &task_graph_runner);
+  for (size_t i = 0; i < layers.size(); ++i) {
+    EXPECT_TRANSFORMATION_MATRIX_EQ(draw_transforms[i],
+                                    layers[i]->DrawTransform());
+    EXPECT_TRANSFORMATION_MATRIX_EQ(screen_space_transforms[i],
+                                    layers[i]->ScreenSpaceTransform());
+  }
+}
+
 TEST_F(LayerTreeHostCommonTest, TransformsForSimpleHierarchy) {
   LayerImpl* root = root_layer_for_testing();
   LayerImpl* parent = AddChild<LayerImpl>(root);
@@ -3167,7 +3167,9 @@ LayerTreeHostImpl::CreateRasterBufferProvider() {
       layer_tree_frame_sink_->gpu_memory_buffer_manager(),
       max_copy_texture_chromium_size, settings_.use_partial_raster,
       settings_.resource_settings.use_gpu_memory_buffer_resources,
-      settings_.max_staging_buffer_usage_in_bytes, tile_format);
+      settings_.max_staging_buffer_usage_in_bytes, tile_format,
+      settings_.use_compressed_tile_resources && caps.texture_format_etc1 &&
+          caps.texture_format_etc1_npot);
 }
 
 void LayerTreeHostImpl::SetLayerTreeMutator(
@@ -5865,6 +5867,7 @@ void LayerTreeHostImpl::InitializeUkm(
     std::unique_ptr<ukm::UkmRecorder> recorder) {
   DCHECK(!ukm_manager_);
   ukm_manager_ = std::make_unique<UkmManager>(std::move(recorder));
+  ukm_manager_->set_frame_pacing_mode(settings_.frame_pacing_mode);
 }
 
 void LayerTreeHostImpl::SetActiveURL(const GURL& url) {
@@ -582,6 +582,7 @@ class CC_EXPORT LayerTreeHostImpl
   }
 
   MutatorHost* mutator_host() const { return mutator_host_.get(); }
+  TaskGraphRunner* task_graph_runner() const { return task_graph_runner_; }
 
   void SetDebugState(const LayerTreeDebugState& new_debug_state);
   const LayerTreeDebugState& debug_state() const { return debug_state_; }
@@ -1290,6 +1290,11 @@ bool LayerTreeImpl::UpdateDrawProperties(
         OverscrollElasticityElementId(), max_texture_size(),
         settings().layer_transforms_should_scale_layer_contents,
         &render_surface_list_, &property_trees_, PageScaleTransformNode());
+    if (settings().enable_parallel_draw_properties &&
+        layer_list_.size() >=
+            settings().min_layers_for_parallel_draw_properties) {
+      inputs.task_graph_runner = host_impl_->task_graph_runner();
+    }
     LayerTreeHostCommon::CalculateDrawProperties(&inputs);
     if (const char* client_name = GetClientNameForMetrics()) {
       UMA_HISTOGRAM_COUNTS_1M(
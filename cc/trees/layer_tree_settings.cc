@@ -23,7 +23,8 @@ LayerTreeSettings::~LayerTreeSettings() = default;
 SchedulerSettings LayerTreeSettings::ToSchedulerSettings() const {
   SchedulerSettings scheduler_settings;
   scheduler_settings.main_frame_before_activation_enabled =
-      main_frame_before_activation_enabled;
+      main_frame_before_activation_enabled ||
+      frame_pacing_mode == FramePacingMode::kThroughput;
   scheduler_settings.timeout_and_draw_when_animation_checkerboards =
       timeout_and_draw_when_animation_checkerboards;
   scheduler_settings.using_synchronous_renderer_compositor =
@@ -37,6 +38,7 @@ SchedulerSettings LayerTreeSettings::ToSchedulerSettings() const {
       enable_surface_synchronization;
   scheduler_settings.compositor_threaded_scrollbar_scrolling =
       compositor_threaded_scrollbar_scrolling;
+  scheduler_settings.frame_pacing_mode = frame_pacing_mode;
   return scheduler_settings;
 }
 
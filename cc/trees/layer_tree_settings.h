@@ -95,6 +95,9 @@ class CC_EXPORT LayerTreeSettings {
   size_t decoded_image_working_set_budget_bytes = 128 * 1024 * 1024;
   int max_preraster_distance_in_screen_pixels = 1000;
   bool use_rgba_4444 = false;
+  // If set to true, opaque tiles that are not expected to change are rastered
+  // into compressed resources, when the raster buffer provider supports it.
+  bool use_compressed_tile_resources = false;
   bool unpremultiply_and_dither_low_bit_depth_tiles = false;
 
   bool enable_mask_tiling = true;
@@ -136,6 +139,10 @@ class CC_EXPORT LayerTreeSettings {
   // on the compositor thread.
   bool compositor_threaded_scrollbar_scrolling = false;
 
+  // How the Scheduler paces frames. See FramePacingMode. The throughput mode
+  // implies |main_frame_before_activation_enabled|.
+  FramePacingMode frame_pacing_mode = FramePacingMode::kSmoothness;
+
   // Whether layer tree commits should be made directly to the active
   // tree on the impl thread. If |false| LayerTreeHostImpl creates a
   // pending layer tree and produces that as the 'sync tree' with
@@ -177,6 +184,12 @@ class CC_EXPORT LayerTreeSettings {
   // necessary. If false, it is clients generate LocalSurfaceIds as necessary.
   // TODO(sky): remove this once https://crbug.com/921129 is fixed.
   bool automatically_allocate_surface_ids = true;
+
+  // If true, the draw properties of trees with at least
+  // |min_layers_for_parallel_draw_properties| layers are computed in parallel
+  // on the TaskGraphRunner.
+  bool enable_parallel_draw_properties = false;
+  size_t min_layers_for_parallel_draw_properties = 1000;
 };
 
 }  // namespace cc
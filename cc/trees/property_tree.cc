@@ -54,7 +54,7 @@ TransformTree::TransformTree()
       page_scale_factor_(1.f),
       device_scale_factor_(1.f),
       device_transform_scale_factor_(1.f) {
-  cached_data_.push_back(TransformCachedNodeData());
+  AddCachedData();
 }
 
 TransformTree::~TransformTree() = default;
@@ -107,9 +107,9 @@ template class PropertyTree<ScrollNode>;
 
 int TransformTree::Insert(const TransformNode& tree_node, int parent_id) {
   int node_id = PropertyTree<TransformNode>::Insert(tree_node, parent_id);
-  DCHECK_EQ(node_id, static_cast<int>(cached_data_.size()));
+  DCHECK_EQ(node_id, static_cast<int>(to_screen_.size()));
 
-  cached_data_.push_back(TransformCachedNodeData());
+  AddCachedData();
   return node_id;
 }
 
@@ -120,8 +120,10 @@ void TransformTree::clear() {
   device_scale_factor_ = 1.f;
   device_transform_scale_factor_ = 1.f;
   nodes_affected_by_outer_viewport_bounds_delta_.clear();
-  cached_data_.clear();
-  cached_data_.push_back(TransformCachedNodeData());
+  to_screen_.clear();
+  from_screen_.clear();
+  is_showing_backface_.clear();
+  AddCachedData();
   sticky_position_data_.clear();
 
 #if DCHECK_IS_ON()
@@ -695,25 +697,36 @@ bool TransformTree::HasNodesAffectedByOuterViewportBoundsDelta() const {
 }
 
 const gfx::Transform& TransformTree::FromScreen(int node_id) const {
-  DCHECK(static_cast<int>(cached_data_.size()) > node_id);
-  return cached_data_[node_id].from_screen;
+  DCHECK(static_cast<int>(from_screen_.size()) > node_id);
+  return from_screen_[node_id];
 }
 
 void TransformTree::SetFromScreen(int node_id,
                                   const gfx::Transform& transform) {
-  DCHECK(static_cast<int>(cached_data_.size()) > node_id);
-  cached_data_[node_id].from_screen = transform;
+  DCHECK(static_cast<int>(from_screen_.size()) > node_id);
+  from_screen_[node_id] = transform;
 }
 
 const gfx::Transform& TransformTree::ToScreen(int node_id) const {
-  DCHECK(static_cast<int>(cached_data_.size()) > node_id);
-  return cached_data_[node_id].to_screen;
+  DCHECK(static_cast<int>(to_screen_.size()) > node_id);
+  return to_screen_[node_id];
 }
 
 void TransformTree::SetToScreen(int node_id, const gfx::Transform& transform) {
-  DCHECK(static_cast<int>(cached_data_.size()) > node_id);
-  cached_data_[node_id].to_screen = transform;
-  cached_data_[node_id].is_showing_backface = transform.IsBackFaceVisible();
+  DCHECK(static_cast<int>(to_screen_.size()) > node_id);
+  to_screen_[node_id] = transform;
+  is_showing_backface_[node_id] = transform.IsBackFaceVisible();
+}
+
+bool TransformTree::IsShowingBackface(int node_id) const {
+  DCHECK(static_cast<int>(is_showing_backface_.size()) > node_id);
+  return is_showing_backface_[node_id];
+}
+
+void TransformTree::AddCachedData() {
+  to_screen_.emplace_back();
+  from_screen_.emplace_back();
+  is_showing_backface_.push_back(false);
 }
 
 bool TransformTree::operator==(const TransformTree& other) const {
@@ -726,7 +739,8 @@ bool TransformTree::operator==(const TransformTree& other) const {
              other.device_transform_scale_factor() &&
          nodes_affected_by_outer_viewport_bounds_delta_ ==
              other.nodes_affected_by_outer_viewport_bounds_delta() &&
-         cached_data_ == other.cached_data();
+         to_screen_ == other.to_screen_ && from_screen_ == other.from_screen_ &&
+         is_showing_backface_ == other.is_showing_backface_;
 }
 
 StickyPositionNodeData* TransformTree::StickyPositionData(int node_id) {
@@ -820,9 +834,7 @@ void EffectTree::UpdateBackfaceVisibility(EffectNode* node,
     return;
   }
   node->hidden_by_backface_visibility =
-      property_trees()
-          ->transform_tree.cached_data()[node->transform_id]
-          .is_showing_backface;
+      property_trees()->transform_tree.IsShowingBackface(node->transform_id);
 }
 
 void EffectTree::UpdateHasMaskingChild(EffectNode* node,
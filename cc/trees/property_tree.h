@@ -42,7 +42,6 @@ struct EffectNode;
 struct ScrollAndScaleSet;
 struct ScrollNode;
 struct TransformNode;
-struct TransformCachedNodeData;
 
 typedef SyncedProperty<AdditionGroup<gfx::ScrollOffset>> SyncedScrollOffset;
 
@@ -121,7 +120,7 @@ class CC_EXPORT TransformTree final : public PropertyTree<TransformNode> {
   // These C++ special member functions cannot be implicit inline because
   // they are exported by CC_EXPORT. They will be instantiated in every
   // compilation units that included this header, and compilation can fail
-  // because TransformCachedNodeData may be incomplete.
+  // because StickyPositionNodeData may be incomplete.
   TransformTree(const TransformTree&) = delete;
   ~TransformTree() final;
   TransformTree& operator=(const TransformTree&);
@@ -210,16 +209,15 @@ class CC_EXPORT TransformTree final : public PropertyTree<TransformNode> {
   const gfx::Transform& ToScreen(int node_id) const;
   void SetToScreen(int node_id, const gfx::Transform& transform);
 
+  // Whether the back face of the node's to_screen transform is visible.
+  bool IsShowingBackface(int node_id) const;
+
   int TargetId(int node_id) const;
   void SetTargetId(int node_id, int target_id);
 
   int ContentTargetId(int node_id) const;
   void SetContentTargetId(int node_id, int content_target_id);
 
-  const std::vector<TransformCachedNodeData>& cached_data() const {
-    return cached_data_;
-  }
-
   StickyPositionNodeData* StickyPositionData(int node_id);
 
   // Computes the combined transform between |source_id| and |dest_id|. These
@@ -252,6 +250,9 @@ class CC_EXPORT TransformTree final : public PropertyTree<TransformNode> {
       TransformNode* parent_node);
   bool NeedsSourceToParentUpdate(TransformNode* node);
 
+  // Appends cached data for a new node.
+  void AddCachedData();
+
   bool source_to_parent_updates_allowed_;
   // When to_screen transform has perspective, the transform node's sublayer
   // scale is calculated using page scale factor, device scale factor and the
@@ -260,7 +261,12 @@ class CC_EXPORT TransformTree final : public PropertyTree<TransformNode> {
   float device_scale_factor_;
   float device_transform_scale_factor_;
   std::vector<int> nodes_affected_by_outer_viewport_bounds_delta_;
-  std::vector<TransformCachedNodeData> cached_data_;
+  // Per-node cached data, indexed by node id. Each field has its own vector
+  // so that passes touching one of them, such as the screen space transform
+  // update, don't pull the others through the cache.
+  std::vector<gfx::Transform> to_screen_;
+  std::vector<gfx::Transform> from_screen_;
+  std::vector<bool> is_showing_backface_;
   std::vector<StickyPositionNodeData> sticky_position_data_;
 };
 
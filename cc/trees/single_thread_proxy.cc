@@ -521,6 +521,8 @@ void SingleThreadProxy::DidPresentCompositorFrameOnImplThread(
     uint32_t frame_token,
     std::vector<LayerTreeHost::PresentationTimeCallback> callbacks,
     const gfx::PresentationFeedback& feedback) {
+  if (scheduler_on_impl_thread_)
+    scheduler_on_impl_thread_->DidPresentCompositorFrame(frame_token, feedback);
   layer_tree_host_->DidPresentCompositorFrame(frame_token, std::move(callbacks),
                                               feedback);
 }
@@ -675,9 +677,11 @@ DrawResult SingleThreadProxy::DoComposite(LayerTreeHostImpl::FrameData* frame) {
     draw_frame = draw_result == DRAW_SUCCESS;
     if (draw_frame) {
       if (host_impl_->DrawLayers(frame)) {
-        if (scheduler_on_impl_thread_)
+        if (scheduler_on_impl_thread_) {
           // Drawing implies we submitted a frame to the LayerTreeFrameSink.
-          scheduler_on_impl_thread_->DidSubmitCompositorFrame();
+          scheduler_on_impl_thread_->DidSubmitCompositorFrame(
+              host_impl_->next_frame_token());
+        }
         single_thread_client_->DidSubmitCompositorFrame();
       }
     }
@@ -117,18 +117,4 @@ void TransformNode::AsValueInto(base::trace_event::TracedValue* value) const {
   MathUtil::AddToTracedValue("snap_amount", snap_amount, value);
 }
 
-TransformCachedNodeData::TransformCachedNodeData()
-    : is_showing_backface(false) {}
-
-TransformCachedNodeData::TransformCachedNodeData(
-    const TransformCachedNodeData& other) = default;
-
-TransformCachedNodeData::~TransformCachedNodeData() = default;
-
-bool TransformCachedNodeData::operator==(
-    const TransformCachedNodeData& other) const {
-  return from_screen == other.from_screen && to_screen == other.to_screen &&
-         is_showing_backface == other.is_showing_backface;
-}
-
 }  // namespace cc
@@ -156,20 +156,6 @@ struct CC_EXPORT TransformNode {
   void AsValueInto(base::trace_event::TracedValue* value) const;
 };
 
-// TODO(sunxd): move this into PropertyTrees::cached_data_.
-struct CC_EXPORT TransformCachedNodeData {
-  TransformCachedNodeData();
-  TransformCachedNodeData(const TransformCachedNodeData& other);
-  ~TransformCachedNodeData();
-
-  gfx::Transform from_screen;
-  gfx::Transform to_screen;
-
-  bool is_showing_backface : 1;
-
-  bool operator==(const TransformCachedNodeData& other) const;
-};
-
 }  // namespace cc
 
 #endif  // CC_TREES_TRANSFORM_NODE_H_
@@ -87,6 +87,7 @@ void UkmManager::RecordRenderingUkm() {
 
   ukm::builders::Compositor_Rendering(source_id_)
       .SetCheckerboardedImagesCount(total_num_of_checkerboarded_images_)
+      .SetFramePacingMode(static_cast<int64_t>(frame_pacing_mode_))
       .Record(recorder_.get());
   total_num_of_checkerboarded_images_ = 0;
 }
@@ -6,6 +6,7 @@
 #define CC_TREES_UKM_MANAGER_H_
 
 #include "cc/cc_export.h"
+#include "cc/scheduler/scheduler_settings.h"
 #include "services/metrics/public/cpp/ukm_source_id.h"
 #include "url/gurl.h"
 
@@ -38,6 +39,12 @@ class CC_EXPORT UkmManager {
   // These metrics are recorded until the source URL changes.
   void AddCheckerboardedImages(int num_of_checkerboarded_images);
 
+  // Recorded with the metrics above, to tell apart pages that use a
+  // non-default frame pacing mode.
+  void set_frame_pacing_mode(FramePacingMode mode) {
+    frame_pacing_mode_ = mode;
+  }
+
   ukm::UkmRecorder* recorder_for_testing() { return recorder_.get(); }
 
  private:
@@ -52,6 +59,7 @@ class CC_EXPORT UkmManager {
   int64_t num_of_frames_ = 0;
 
   int total_num_of_checkerboarded_images_ = 0;
+  FramePacingMode frame_pacing_mode_ = FramePacingMode::kSmoothness;
 
   ukm::SourceId source_id_ = ukm::kInvalidSourceId;
   std::unique_ptr<ukm::UkmRecorder> recorder_;
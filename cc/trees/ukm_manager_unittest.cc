@@ -20,6 +20,7 @@ const char kCheckerboardArea[] = "CheckerboardedContentArea";
 const char kCheckerboardAreaRatio[] = "CheckerboardedContentAreaRatio";
 const char kMissingTiles[] = "NumMissingTiles";
 const char kCheckerboardedImagesCount[] = "CheckerboardedImagesCount";
+const char kFramePacingMode[] = "FramePacingMode";
 
 class UkmManagerTest : public testing::Test {
  public:
@@ -90,6 +91,22 @@ TEST_F(UkmManagerTest, Basic) {
   for (const auto* entry : entries_rendering) {
     EXPECT_EQ(original_id, entry->source_id);
     test_ukm_recorder_->ExpectEntryMetric(entry, kCheckerboardedImagesCount, 6);
+    test_ukm_recorder_->ExpectEntryMetric(
+        entry, kFramePacingMode,
+        static_cast<int64_t>(FramePacingMode::kSmoothness));
+  }
+}
+
+TEST_F(UkmManagerTest, FramePacingMode) {
+  manager_->set_frame_pacing_mode(FramePacingMode::kLowLatency);
+  manager_.reset();
+
+  const auto& entries = test_ukm_recorder_->GetEntriesByName(kRendering);
+  EXPECT_EQ(1u, entries.size());
+  for (const auto* entry : entries) {
+    test_ukm_recorder_->ExpectEntryMetric(
+        entry, kFramePacingMode,
+        static_cast<int64_t>(FramePacingMode::kLowLatency));
   }
 }
 
@@ -257,6 +257,8 @@ const FeatureEntry::Choice kOverlayStrategiesChoices[] = {
     {flag_descriptions::kOverlayStrategiesOccludedAndUnoccluded,
      switches::kEnableHardwareOverlays,
      "single-fullscreen,single-on-top,underlay"},
+    {flag_descriptions::kOverlayStrategiesMultipleAndOccluded,
+     switches::kEnableHardwareOverlays, "single-fullscreen,multiple,underlay"},
 };
 
 const FeatureEntry::Choice kTouchTextSelectionStrategyChoices[] = {
@@ -59,6 +59,7 @@ class ChromeConfigurator : public update_client::Configurator {
   int NextCheckDelay() const override;
   int OnDemandDelay() const override;
   int UpdateDelay() const override;
+  int MaxParallelUpdates() const override;
   std::vector<GURL> UpdateUrl() const override;
   std::vector<GURL> PingUrl() const override;
   std::string GetProdId() const override;
@@ -125,6 +126,10 @@ int ChromeConfigurator::UpdateDelay() const {
   return configurator_impl_.UpdateDelay();
 }
 
+int ChromeConfigurator::MaxParallelUpdates() const {
+  return configurator_impl_.MaxParallelUpdates();
+}
+
 std::vector<GURL> ChromeConfigurator::UpdateUrl() const {
   return configurator_impl_.UpdateUrl();
 }
@@ -126,6 +126,10 @@ int ChromeUpdateClientConfig::UpdateDelay() const {
   return impl_.UpdateDelay();
 }
 
+int ChromeUpdateClientConfig::MaxParallelUpdates() const {
+  return impl_.MaxParallelUpdates();
+}
+
 std::vector<GURL> ChromeUpdateClientConfig::UpdateUrl() const {
   return impl_.UpdateUrl();
 }
@@ -1545,6 +1545,9 @@ const char kOverlayStrategiesUnoccluded[] =
 const char kOverlayStrategiesOccludedAndUnoccluded[] =
     "Occluded and unoccluded buffers "
     "(single-fullscreen,single-on-top,underlay)";
+const char kOverlayStrategiesMultipleAndOccluded[] =
+    "Multiple unoccluded and occluded buffers "
+    "(single-fullscreen,multiple,underlay)";
 
 const char kUseNewAcceptLanguageHeaderName[] = "Use new Accept-Language header";
 const char kUseNewAcceptLanguageHeaderDescription[] =
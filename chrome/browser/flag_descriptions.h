@@ -933,6 +933,7 @@ extern const char kOverlayStrategiesNone[];
 extern const char kOverlayStrategiesUnoccludedFullscreen[];
 extern const char kOverlayStrategiesUnoccluded[];
 extern const char kOverlayStrategiesOccludedAndUnoccluded[];
+extern const char kOverlayStrategiesMultipleAndOccluded[];
 
 extern const char kUseNewAcceptLanguageHeaderName[];
 extern const char kUseNewAcceptLanguageHeaderDescription[];
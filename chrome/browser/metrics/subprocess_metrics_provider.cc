@@ -5,6 +5,7 @@
 #include "chrome/browser/metrics/subprocess_metrics_provider.h"
 
 #include <utility>
+#include <vector>
 
 #include "base/bind.h"
 #include "base/logging.h"
@@ -30,6 +31,26 @@ SubprocessMetricsProvider* g_subprocess_metrics_provider_for_testing;
 
 }  // namespace
 
+struct SubprocessMetricsProvider::SubprocessAllocator {
+  explicit SubprocessAllocator(
+      std::unique_ptr<base::PersistentHistogramAllocator> allocator)
+      : allocator(std::move(allocator)),
+        histogram_iterator(this->allocator.get()) {}
+
+  std::unique_ptr<base::PersistentHistogramAllocator> allocator;
+
+  // Continues from the last histogram found in |allocator|, so that each
+  // histogram of the subprocess is only created once, when it first appears
+  // in shared memory, rather than on every merge.
+  base::PersistentHistogramAllocator::Iterator histogram_iterator;
+
+  // The histograms found so far. They read their samples directly from the
+  // shared memory of the subprocess.
+  std::vector<std::unique_ptr<base::HistogramBase>> histograms;
+
+  DISALLOW_COPY_AND_ASSIGN(SubprocessAllocator);
+};
+
 SubprocessMetricsProvider::SubprocessMetricsProvider()
     : scoped_observer_(this), weak_ptr_factory_(this) {
   base::StatisticsRecorder::RegisterHistogramProvider(
@@ -65,7 +86,8 @@ void SubprocessMetricsProvider::RegisterSubprocessAllocator(
     return;
 
   // Map is "MapOwnPointer" so transfer ownership to it.
-  allocators_by_id_.AddWithID(std::move(allocator), id);
+  allocators_by_id_.AddWithID(
+      std::make_unique<SubprocessAllocator>(std::move(allocator)), id);
 }
 
 void SubprocessMetricsProvider::DeregisterSubprocessAllocator(int id) {
@@ -76,32 +98,33 @@ void SubprocessMetricsProvider::DeregisterSubprocessAllocator(int id) {
 
   // Extract the matching allocator from the list of active ones. It will
   // be automatically released when this method exits.
-  std::unique_ptr<base::PersistentHistogramAllocator> allocator(
+  std::unique_ptr<SubprocessAllocator> subprocess(
       allocators_by_id_.Replace(id, nullptr));
   allocators_by_id_.Remove(id);
-  DCHECK(allocator);
+  DCHECK(subprocess);
 
   // Merge the last deltas from the allocator before it is released.
-  MergeHistogramDeltasFromAllocator(id, allocator.get());
+  MergeHistogramDeltasFromAllocator(id, subprocess.get());
 }
 
 void SubprocessMetricsProvider::MergeHistogramDeltasFromAllocator(
     int id,
-    base::PersistentHistogramAllocator* allocator) {
-  DCHECK(allocator);
-
-  int histogram_count = 0;
-  base::PersistentHistogramAllocator::Iterator hist_iter(allocator);
-  while (true) {
-    std::unique_ptr<base::HistogramBase> histogram = hist_iter.GetNext();
-    if (!histogram)
-      break;
-    allocator->MergeHistogramDeltaToStatisticsRecorder(histogram.get());
-    ++histogram_count;
+    SubprocessAllocator* subprocess) {
+  DCHECK(subprocess);
+
+  // Pick up the histograms created since the last merge.
+  while (std::unique_ptr<base::HistogramBase> histogram =
+             subprocess->histogram_iterator.GetNext()) {
+    subprocess->histograms.push_back(std::move(histogram));
+  }
+
+  for (const auto& histogram : subprocess->histograms) {
+    subprocess->allocator->MergeHistogramDeltaToStatisticsRecorder(
+        histogram.get());
   }
 
-  DVLOG(1) << "Reported " << histogram_count << " histograms from subprocess #"
-           << id;
+  DVLOG(1) << "Reported " << subprocess->histograms.size()
+           << " histograms from subprocess #" << id;
 }
 
 void SubprocessMetricsProvider::MergeHistogramDeltas() {
@@ -45,6 +45,9 @@ class SubprocessMetricsProvider
  private:
   friend class SubprocessMetricsProviderTest;
 
+  // The allocator of a subprocess, and the histograms found in it so far.
+  struct SubprocessAllocator;
+
   // Indicates subprocess to be monitored with unique id for later reference.
   // Metrics reporting will read histograms from it and upload them to UMA.
   void RegisterSubprocessAllocator(
@@ -58,9 +61,8 @@ class SubprocessMetricsProvider
   // Merge all histograms of a given allocator to the global StatisticsRecorder.
   // This is called periodically during UMA metrics collection (if enabled) and
   // possibly on-demand for other purposes.
-  void MergeHistogramDeltasFromAllocator(
-      int id,
-      base::PersistentHistogramAllocator* allocator);
+  void MergeHistogramDeltasFromAllocator(int id,
+                                         SubprocessAllocator* subprocess);
 
   // metrics::MetricsProvider:
   void MergeHistogramDeltas() override;
@@ -101,7 +103,7 @@ class SubprocessMetricsProvider
 
   // All of the shared-persistent-allocators for known sub-processes.
   using AllocatorByIdMap =
-      base::IDMap<std::unique_ptr<base::PersistentHistogramAllocator>, int>;
+      base::IDMap<std::unique_ptr<SubprocessAllocator>, int>;
   AllocatorByIdMap allocators_by_id_;
 
   // Track all observed render processes to un-observe them on exit.
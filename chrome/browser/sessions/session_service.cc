@@ -16,6 +16,7 @@
 #include "base/command_line.h"
 #include "base/metrics/histogram_macros.h"
 #include "base/pickle.h"
+#include "base/task/post_task.h"
 #include "base/threading/thread.h"
 #include "build/build_config.h"
 #include "chrome/browser/background/background_mode_manager.h"
@@ -80,6 +81,13 @@ SessionService::AppType AppTypeForAppName(const std::string& app_name) {
 
 // SessionService -------------------------------------------------------------
 
+SessionService::ParsedSession::ParsedSession()
+    : active_window_id(SessionID::InvalidValue()) {}
+
+SessionService::ParsedSession::ParsedSession(ParsedSession&& other) = default;
+
+SessionService::ParsedSession::~ParsedSession() = default;
+
 SessionService::SessionService(Profile* profile)
     : profile_(profile),
       should_use_delayed_save_(true),
@@ -540,8 +548,7 @@ base::CancelableTaskTracker::TaskId SessionService::GetLastSession(
   // the callback.
   return base_session_service_->ScheduleGetLastSessionCommands(
       base::Bind(&SessionService::OnGotSessionCommands,
-                 weak_factory_.GetWeakPtr(),
-                 callback),
+                 weak_factory_.GetWeakPtr(), callback, tracker),
       tracker);
 }
 
@@ -628,15 +635,35 @@ void SessionService::OnBrowserSetLastActive(Browser* browser) {
 
 void SessionService::OnGotSessionCommands(
     const sessions::GetLastSessionCallback& callback,
+    base::CancelableTaskTracker* tracker,
     std::vector<std::unique_ptr<sessions::SessionCommand>> commands) {
-  std::vector<std::unique_ptr<sessions::SessionWindow>> valid_windows;
-  SessionID active_window_id = SessionID::InvalidValue();
+  // Parsing a large session is slow, so it is done off the UI thread. This
+  // runs only if |tracker| has not been canceled, so it is still alive.
+  tracker->PostTaskAndReplyWithResult(
+      base::CreateTaskRunnerWithTraits({base::TaskPriority::USER_BLOCKING})
+          .get(),
+      FROM_HERE,
+      base::BindOnce(&SessionService::ParseSessionCommands,
+                     std::move(commands)),
+      base::BindOnce(&SessionService::OnParsedSessionCommands,
+                     weak_factory_.GetWeakPtr(), callback));
+}
+
+// static
+SessionService::ParsedSession SessionService::ParseSessionCommands(
+    std::vector<std::unique_ptr<sessions::SessionCommand>> commands) {
+  ParsedSession session;
+  sessions::RestoreSessionFromCommands(commands, &session.windows,
+                                       &session.active_window_id);
+  return session;
+}
 
-  sessions::RestoreSessionFromCommands(commands, &valid_windows,
-                                       &active_window_id);
-  RemoveUnusedRestoreWindows(&valid_windows);
+void SessionService::OnParsedSessionCommands(
+    const sessions::GetLastSessionCallback& callback,
+    ParsedSession session) {
+  RemoveUnusedRestoreWindows(&session.windows);
 
-  callback.Run(std::move(valid_windows), active_window_id);
+  callback.Run(std::move(session.windows), session.active_window_id);
 }
 
 void SessionService::BuildCommandsForTab(const SessionID& window_id,
@@ -237,6 +237,16 @@ class SessionService : public sessions::BaseSessionServiceDelegate,
 
   typedef std::map<SessionID, std::pair<int, int>> IdToRange;
 
+  // The windows and active window parsed from the last session's commands.
+  struct ParsedSession {
+    ParsedSession();
+    ParsedSession(ParsedSession&& other);
+    ~ParsedSession();
+
+    std::vector<std::unique_ptr<sessions::SessionWindow>> windows;
+    SessionID active_window_id;
+  };
+
   void Init();
 
   // Returns true if a window of given |window_type| and |app_type| should get
@@ -258,9 +268,17 @@ class SessionService : public sessions::BaseSessionServiceDelegate,
   void OnBrowserRemoved(Browser* browser) override {}
   void OnBrowserSetLastActive(Browser* browser) override;
 
-  // Converts |commands| to SessionWindows and notifies the callback.
+  // Converts |commands| to SessionWindows on a worker thread, then notifies
+  // the callback from OnParsedSessionCommands().
   void OnGotSessionCommands(
       const sessions::GetLastSessionCallback& callback,
+      base::CancelableTaskTracker* tracker,
+      std::vector<std::unique_ptr<sessions::SessionCommand>> commands);
+  void OnParsedSessionCommands(const sessions::GetLastSessionCallback& callback,
+                               ParsedSession session);
+
+  // Runs on a worker thread; does not touch any browser state.
+  static ParsedSession ParseSessionCommands(
       std::vector<std::unique_ptr<sessions::SessionCommand>> commands);
 
   // Adds commands to commands that will recreate the state of the specified
@@ -363,22 +363,31 @@ void TabLoader::OnMemoryPressure(
     case base::MemoryPressureListener::MEMORY_PRESSURE_LEVEL_NONE:
       break;
     case base::MemoryPressureListener::MEMORY_PRESSURE_LEVEL_MODERATE:
+      // Keep restoring, but only one tab at a time (see
+      // MaxSimultaneousLoads()), rather than abandoning the remaining tabs.
+      // No notification is sent when the pressure goes away; the level is
+      // polled again each time a load finishes or times out.
+      break;
     case base::MemoryPressureListener::MEMORY_PRESSURE_LEVEL_CRITICAL:
       StopLoadingTabs();
       break;
   }
 }
 
+base::MemoryPressureListener::MemoryPressureLevel
+TabLoader::GetMemoryPressureLevel() const {
+  if (base::MemoryPressureMonitor::Get())
+    return base::MemoryPressureMonitor::Get()->GetCurrentPressureLevel();
+  return base::MemoryPressureListener::MEMORY_PRESSURE_LEVEL_NONE;
+}
+
 bool TabLoader::ShouldStopLoadingTabs() const {
   DCHECK(reentry_depth_ > 0);  // This can only be called internally.
   if (g_max_loaded_tab_count_for_testing != 0 &&
       scheduled_to_load_count_ >= g_max_loaded_tab_count_for_testing)
     return true;
-  if (base::MemoryPressureMonitor::Get()) {
-    return base::MemoryPressureMonitor::Get()->GetCurrentPressureLevel() !=
-           base::MemoryPressureListener::MEMORY_PRESSURE_LEVEL_NONE;
-  }
-  return false;
+  return GetMemoryPressureLevel() ==
+         base::MemoryPressureListener::MEMORY_PRESSURE_LEVEL_CRITICAL;
 }
 
 size_t TabLoader::GetMaxNewTabLoads() const {
@@ -760,7 +769,12 @@ void TabLoader::MoveToSortedPosition(TabVector::iterator it) {
 }
 
 size_t TabLoader::MaxSimultaneousLoads() const {
-  if (max_simultaneous_loads_for_testing_ != 0)
-    return max_simultaneous_loads_for_testing_;
-  return delegate_->GetMaxSimultaneousTabLoads();
+  size_t max_loads = max_simultaneous_loads_for_testing_ != 0
+                         ? max_simultaneous_loads_for_testing_
+                         : delegate_->GetMaxSimultaneousTabLoads();
+  if (GetMemoryPressureLevel() !=
+      base::MemoryPressureListener::MEMORY_PRESSURE_LEVEL_NONE) {
+    max_loads = std::min<size_t>(max_loads, 1);
+  }
+  return max_loads;
 }
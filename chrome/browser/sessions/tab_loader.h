@@ -111,10 +111,16 @@ class TabLoader : public base::RefCounted<TabLoader>,
   void OnStopTracking(content::WebContents* contents,
                       LoadingState loading_state) override;
 
-  // React to memory pressure by stopping to load any more tabs.
+  // React to memory pressure by loading one tab at a time under moderate
+  // pressure, and by stopping to load any more tabs under critical pressure.
   void OnMemoryPressure(
       base::MemoryPressureListener::MemoryPressureLevel memory_pressure_level);
 
+  // Returns the current memory pressure level from the MemoryPressureMonitor,
+  // or MEMORY_PRESSURE_LEVEL_NONE if there is no monitor.
+  base::MemoryPressureListener::MemoryPressureLevel GetMemoryPressureLevel()
+      const;
+
   // Determines whether or not tab loading should stop early due to external
   // factors.
   bool ShouldStopLoadingTabs() const;
@@ -225,8 +231,8 @@ class TabLoader : public base::RefCounted<TabLoader>,
   // The OS specific delegate of the TabLoader.
   std::unique_ptr<TabLoaderDelegate> delegate_;
 
-  // Listens for system under memory pressure notifications and stops loading
-  // of tabs when we start running out of memory.
+  // Listens for system under memory pressure notifications and throttles or
+  // stops loading of tabs when we start running out of memory.
   base::MemoryPressureListener memory_pressure_listener_;
 
   // Used for selecting which timeout to use, and to prevent additional
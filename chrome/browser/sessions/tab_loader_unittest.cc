@@ -7,6 +7,8 @@
 #include <vector>
 
 #include "base/bind.h"
+#include "base/macros.h"
+#include "base/memory/memory_pressure_monitor.h"
 #include "base/run_loop.h"
 #include "base/test/simple_test_tick_clock.h"
 #include "base/time/time.h"
@@ -28,6 +30,34 @@ using resource_coordinator::TabLoadTracker;
 using resource_coordinator::ResourceCoordinatorTabHelper;
 using LoadingState = TabLoadTracker::LoadingState;
 
+namespace {
+
+// A MemoryPressureMonitor whose level can be changed without dispatching a
+// notification, as happens when memory pressure is relieved.
+class TestMemoryPressureMonitor : public base::MemoryPressureMonitor {
+ public:
+  TestMemoryPressureMonitor() = default;
+  ~TestMemoryPressureMonitor() override = default;
+
+  void set_memory_pressure_level(MemoryPressureLevel level) {
+    memory_pressure_level_ = level;
+  }
+
+  // base::MemoryPressureMonitor:
+  MemoryPressureLevel GetCurrentPressureLevel() override {
+    return memory_pressure_level_;
+  }
+  void SetDispatchCallback(const DispatchCallback& callback) override {}
+
+ private:
+  MemoryPressureLevel memory_pressure_level_ =
+      base::MemoryPressureListener::MEMORY_PRESSURE_LEVEL_NONE;
+
+  DISALLOW_COPY_AND_ASSIGN(TestMemoryPressureMonitor);
+};
+
+}  // namespace
+
 class TabLoaderTest : public testing::Test {
  protected:
   using RestoredTab = SessionRestoreDelegate::RestoredTab;
@@ -260,10 +290,11 @@ TEST_F(TabLoaderTest, OnMemoryPressure) {
   StartTabLoader();
   EXPECT_EQ(1u, tab_loader_.scheduled_to_load_count());
 
-  // Simulate memory pressure and expect the tab loader to disable loading.
+  // Simulate critical memory pressure and expect the tab loader to disable
+  // loading.
   EXPECT_TRUE(tab_loader_.IsLoadingEnabled());
   tab_loader_.OnMemoryPressure(
-      base::MemoryPressureListener::MEMORY_PRESSURE_LEVEL_MODERATE);
+      base::MemoryPressureListener::MEMORY_PRESSURE_LEVEL_CRITICAL);
   EXPECT_FALSE(tab_loader_.IsLoadingEnabled());
 
   // Finish loading the tab and expect the tab loader to disconnect.
@@ -271,6 +302,34 @@ TEST_F(TabLoaderTest, OnMemoryPressure) {
   EXPECT_TRUE(TabLoaderTester::shared_tab_loader() == nullptr);
 }
 
+TEST_F(TabLoaderTest, OnModerateMemoryPressure) {
+  TestMemoryPressureMonitor monitor;
+  CreateMultipleRestoredWebContents(0, 5);
+
+  max_simultaneous_loads_ = 3;
+  StartTabLoader();
+  EXPECT_EQ(1u, tab_loader_.scheduled_to_load_count());
+
+  // Under moderate memory pressure, tabs keep loading one at a time.
+  monitor.set_memory_pressure_level(
+      base::MemoryPressureListener::MEMORY_PRESSURE_LEVEL_MODERATE);
+  tab_loader_.OnMemoryPressure(
+      base::MemoryPressureListener::MEMORY_PRESSURE_LEVEL_MODERATE);
+  EXPECT_TRUE(tab_loader_.IsLoadingEnabled());
+  SimulateLoaded(0);
+  EXPECT_EQ(2u, tab_loader_.scheduled_to_load_count());
+  EXPECT_EQ(3u, tab_loader_.tabs_to_load().size());
+
+  // No notification is dispatched when the pressure is relieved. The level is
+  // checked again when the next load finishes, and the remaining loading
+  // slots are used.
+  monitor.set_memory_pressure_level(
+      base::MemoryPressureListener::MEMORY_PRESSURE_LEVEL_NONE);
+  SimulateLoaded(1);
+  EXPECT_EQ(5u, tab_loader_.scheduled_to_load_count());
+  EXPECT_TRUE(tab_loader_.tabs_to_load().empty());
+}
+
 TEST_F(TabLoaderTest, TimeoutCanExceedLoadingSlots) {
   CreateMultipleRestoredWebContents(1, 4);
 
@@ -77,7 +77,7 @@ std::vector<std::string> ParseCategories(base::StringPiece message) {
   return categories;
 }
 
-class TraceCopyTask : public base::MessagePumpLibevent::FdWatcher {
+class TraceCopyTask : public base::MessagePumpForIO::FdWatcher {
  public:
   // Read 64 kB at a time (standard pipe capacity).
   static constexpr size_t kCopyBufferSize = 1UL << 16;
@@ -103,7 +103,7 @@ class TraceCopyTask : public base::MessagePumpLibevent::FdWatcher {
         base::MessagePumpForIO::WATCH_WRITE, &out_watcher_, this);
   }
 
-  // base::MessagePumpLibevent::FdWatcher:
+  // base::MessagePumpForIO::FdWatcher:
   void OnFileCanReadWithoutBlocking(int fd) override { NOTREACHED(); }
   void OnFileCanWriteWithoutBlocking(int fd) override {
     DCHECK_EQ(out_fd_.get(), fd);
@@ -166,13 +166,13 @@ class TraceCopyTask : public base::MessagePumpLibevent::FdWatcher {
 
   // Pipe for trace data.
   base::ScopedFD out_fd_;
-  base::MessagePumpLibevent::FdWatchController out_watcher_;
+  base::MessagePumpForIO::FdWatchController out_watcher_;
 
   // Callback for when copy finishes.
   base::OnceCallback<void(Status, size_t)> callback_;
 };
 
-class TraceConnection : public base::MessagePumpLibevent::FdWatcher {
+class TraceConnection : public base::MessagePumpForIO::FdWatcher {
  public:
   TraceConnection(base::ScopedFD connection_fd, base::OnceClosure callback)
       : recv_buffer_(new char[kMessageSize]),
@@ -188,7 +188,7 @@ class TraceConnection : public base::MessagePumpLibevent::FdWatcher {
         base::MessagePumpForIO::WATCH_READ, &connection_watcher_, this);
   }
 
-  // base::MessagePumpLibevent::FdWatcher:
+  // base::MessagePumpForIO::FdWatcher:
   void OnFileCanReadWithoutBlocking(int fd) override {
     DCHECK_EQ(connection_fd_.get(), fd);
     ReceiveClientMessage();
@@ -320,7 +320,7 @@ class TraceConnection : public base::MessagePumpLibevent::FdWatcher {
 
   // Client connection.
   base::ScopedFD connection_fd_;
-  base::MessagePumpLibevent::FdWatchController connection_watcher_;
+  base::MessagePumpForIO::FdWatchController connection_watcher_;
 
   // Pipe for trace output.
   base::ScopedFD trace_pipe_;
@@ -334,7 +334,7 @@ class TraceConnection : public base::MessagePumpLibevent::FdWatcher {
   base::WeakPtrFactory<TraceConnection> weak_ptr_factory_;
 };
 
-class TracingService : public base::MessagePumpLibevent::FdWatcher {
+class TracingService : public base::MessagePumpForIO::FdWatcher {
  public:
   TracingService()
       : server_socket_watcher_(FROM_HERE), weak_ptr_factory_(this) {}
@@ -352,7 +352,7 @@ class TracingService : public base::MessagePumpLibevent::FdWatcher {
     return true;
   }
 
-  // base::MessagePumpLibevent::FdWatcher:
+  // base::MessagePumpForIO::FdWatcher:
   void OnFileCanReadWithoutBlocking(int fd) override {
     DCHECK_EQ(server_socket_.get(), fd);
     AcceptConnection();
@@ -379,7 +379,7 @@ class TracingService : public base::MessagePumpLibevent::FdWatcher {
 
   // Socket and watcher for listening socket.
   base::ScopedFD server_socket_;
-  base::MessagePumpLibevent::FdWatchController server_socket_watcher_;
+  base::MessagePumpForIO::FdWatchController server_socket_watcher_;
 
   // Currently active tracing connection.
   // There can only be one; ftrace affects the whole system.
@@ -485,6 +485,32 @@ TEST_F(BookmarkIndexTest, ChangeURL) {
   ExpectMatches("blah", expected, base::size(expected));
 }
 
+// Makes sure nodes added during extensive changes are indexed, whether the
+// index is queried before or after the changes end.
+TEST_F(BookmarkIndexTest, ExtensiveChanges) {
+  model_->BeginExtensiveChanges();
+  const char* titles[] = {"fizz", "fuzz", "buzz"};
+  const char* urls[] = {"http://fizz.com", "http://fuzz.com",
+                        "http://buzz.com"};
+  AddBookmarks(titles, urls, base::size(titles));
+
+  const char* expected_before[] = {"fizz"};
+  ExpectMatches("fizz", expected_before, base::size(expected_before));
+
+  // Changes to nodes that are still waiting to be indexed are honored too.
+  const BookmarkNode* other_node = model_->other_node();
+  model_->AddURL(other_node, 3, ASCIIToUTF16("foo"), GURL("http://foo.com"));
+  model_->SetTitle(other_node->GetChild(3), ASCIIToUTF16("blah"));
+  model_->Remove(other_node->GetChild(1));
+  model_->EndExtensiveChanges();
+
+  const char* expected_com[] = {"fizz", "buzz", "blah"};
+  ExpectMatches("com", expected_com, base::size(expected_com));
+  const char* expected_retitled[] = {"blah"};
+  ExpectMatches("blah", expected_retitled, base::size(expected_retitled));
+  ExpectMatches("fuzz", nullptr, 0U);
+}
+
 // Makes sure no more than max queries is returned.
 TEST_F(BookmarkIndexTest, HonorMax) {
   const char* titles[] = { "abcd", "abcde" };
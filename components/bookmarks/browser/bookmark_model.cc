@@ -179,6 +179,7 @@ void BookmarkModel::EndExtensiveChanges() {
   --extensive_changes_;
   DCHECK_GE(extensive_changes_, 0);
   if (extensive_changes_ == 0) {
+    AddPendingNodesToIndex();
     for (BookmarkModelObserver& observer : observers_)
       observer.ExtensiveBookmarkChangesEnded(this);
   }
@@ -372,8 +373,7 @@ void BookmarkModel::SetTitle(const BookmarkNode* node,
   if (node->is_url())
     index_->Remove(node);
   AsMutable(node)->SetTitle(title);
-  if (node->is_url())
-    index_->Add(node);
+  AddNodeToIndex(AsMutable(node));
 
   if (store_)
     store_->ScheduleSave();
@@ -717,6 +717,7 @@ void BookmarkModel::GetBookmarksMatching(
   if (!loaded_)
     return;
 
+  AddPendingNodesToIndex();
   index_->GetResultsMatching(text, max_count, matching_algorithm, matches);
 }
 
@@ -769,7 +770,8 @@ void BookmarkModel::RemoveNode(BookmarkNode* node) {
   DCHECK(loaded_);
   DCHECK(!is_permanent_node(node));
 
-  if (node->is_url())
+  // Nodes still waiting to be indexed are not in |index_| yet.
+  if (node->is_url() && !nodes_pending_index_.erase(node))
     index_->Remove(node);
 
   CancelPendingFaviconLoadRequests(node);
@@ -843,12 +845,30 @@ BookmarkNode* BookmarkModel::AddNode(BookmarkNode* parent,
 }
 
 void BookmarkModel::AddNodeToIndexRecursive(BookmarkNode* node) {
-  if (node->is_url())
-    index_->Add(node);
+  AddNodeToIndex(node);
   for (int i = 0; i < node->child_count(); ++i)
     AddNodeToIndexRecursive(node->GetChild(i));
 }
 
+void BookmarkModel::AddNodeToIndex(BookmarkNode* node) {
+  if (!node->is_url())
+    return;
+  // Indexing one node at a time is quadratic in the number of bookmarks
+  // sharing a term, which dominates large imports and initial syncs.
+  if (IsDoingExtensiveChanges())
+    nodes_pending_index_.insert(node);
+  else
+    index_->Add(node);
+}
+
+void BookmarkModel::AddPendingNodesToIndex() {
+  if (nodes_pending_index_.empty())
+    return;
+  index_->AddNodes(std::vector<const TitledUrlNode*>(
+      nodes_pending_index_.begin(), nodes_pending_index_.end()));
+  nodes_pending_index_.clear();
+}
+
 bool BookmarkModel::IsValidIndex(const BookmarkNode* parent,
                                  int index,
                                  bool allow_end) {
@@ -342,6 +342,13 @@ class BookmarkModel : public BookmarkUndoProvider,
   // Adds |node| to |index_| and recursisvely invokes this for all children.
   void AddNodeToIndexRecursive(BookmarkNode* node);
 
+  // Adds |node| to |index_| if it is a URL. While extensive changes are in
+  // progress the node is queued in |nodes_pending_index_| instead.
+  void AddNodeToIndex(BookmarkNode* node);
+
+  // Adds all of |nodes_pending_index_| to |index_| in one pass.
+  void AddPendingNodesToIndex();
+
   // Returns true if the parent and index are valid.
   bool IsValidIndex(const BookmarkNode* parent, int index, bool allow_end);
 
@@ -420,6 +427,11 @@ class BookmarkModel : public BookmarkUndoProvider,
   // See description of IsDoingExtensiveChanges above.
   int extensive_changes_ = 0;
 
+  // URL nodes added or retitled during extensive changes that have not been
+  // added to |index_| yet. They are indexed in bulk when the changes end, or
+  // before the index is next queried.
+  std::set<const BookmarkNode*> nodes_pending_index_;
+
   std::unique_ptr<BookmarkExpandedStateTracker> expanded_state_tracker_;
 
   std::set<std::string> non_cloned_keys_;
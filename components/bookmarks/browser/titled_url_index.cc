@@ -70,6 +70,24 @@ void TitledUrlIndex::Add(const TitledUrlNode* node) {
     RegisterNode(terms[i], node);
 }
 
+void TitledUrlIndex::AddNodes(const std::vector<const TitledUrlNode*>& nodes) {
+  std::map<base::string16, TitledUrlNodes> additions;
+  for (const TitledUrlNode* node : nodes) {
+    for (const base::string16& term :
+         ExtractQueryWords(Normalize(node->GetTitledUrlNodeTitle()))) {
+      additions[term].push_back(node);
+    }
+    for (const base::string16& term : ExtractQueryWords(
+             CleanUpUrlForMatching(node->GetTitledUrlNodeUrl(), nullptr))) {
+      additions[term].push_back(node);
+    }
+  }
+  for (const auto& addition : additions) {
+    index_[addition.first].insert(addition.second.begin(),
+                                  addition.second.end());
+  }
+}
+
 void TitledUrlIndex::Remove(const TitledUrlNode* node) {
   std::vector<base::string16> terms =
       ExtractQueryWords(Normalize(node->GetTitledUrlNodeTitle()));
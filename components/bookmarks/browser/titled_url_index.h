@@ -42,6 +42,11 @@ class TitledUrlIndex {
   // Invoked when a title/URL pair has been added to the model.
   void Add(const TitledUrlNode* node);
 
+  // Equivalent to calling Add() for each of |nodes|, but merges the nodes into
+  // each term's set once instead of inserting them one at a time, which is
+  // quadratic for common terms such as "com" or "www".
+  void AddNodes(const std::vector<const TitledUrlNode*>& nodes);
+
   // Invoked when a title/URL pair has been removed from the model.
   void Remove(const TitledUrlNode* node);
 
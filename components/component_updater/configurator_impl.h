@@ -50,6 +50,9 @@ class ConfiguratorImpl {
   // components.
   int UpdateDelay() const;
 
+  // The maximum number of components updated at the same time.
+  int MaxParallelUpdates() const;
+
   // The URLs for the update checks. The URLs are tried in order, the first one
   // that succeeds wins.
   std::vector<GURL> UpdateUrl() const;
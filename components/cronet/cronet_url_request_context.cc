@@ -45,6 +45,8 @@
 #include "net/cert/caching_cert_verifier.h"
 #include "net/cert/cert_verifier.h"
 #include "net/cookies/cookie_monster.h"
+#include "net/dns/host_resolver.h"
+#include "net/dns/host_resolver_manager.h"
 #include "net/http/http_auth_handler_factory.h"
 #include "net/log/file_net_log_observer.h"
 #include "net/log/net_log_util.h"
@@ -102,6 +104,43 @@ class NetLogWithNetworkChangeEvents {
 static base::LazyInstance<NetLogWithNetworkChangeEvents>::Leaky g_net_log =
     LAZY_INSTANCE_INITIALIZER;
 
+// The network thread, and the network objects on it, shared by the contexts
+// with the SharedNetworkResources experimental option. Like |g_net_log|, these
+// are never destroyed, as contexts may use them until the process exits.
+class SharedNetworkResources {
+ public:
+  SharedNetworkResources() : network_thread_("shared_network") {
+    base::Thread::Options options;
+    options.message_loop_type = base::MessageLoop::TYPE_IO;
+    network_thread_.StartWithOptions(options);
+  }
+
+  scoped_refptr<base::SingleThreadTaskRunner> network_task_runner() {
+    return network_thread_.task_runner();
+  }
+
+  // Returns the HostResolverManager, and so the HostCache and in-flight
+  // lookups, shared by the contexts. Must be called on the shared network
+  // thread.
+  net::HostResolverManager* GetHostResolverManager(net::NetLog* net_log) {
+    DCHECK(network_thread_.task_runner()->BelongsToCurrentThread());
+    if (!host_resolver_manager_) {
+      host_resolver_manager_ = std::make_unique<net::HostResolverManager>(
+          net::HostResolver::Options(), net_log);
+    }
+    return host_resolver_manager_.get();
+  }
+
+ private:
+  base::Thread network_thread_;
+  std::unique_ptr<net::HostResolverManager> host_resolver_manager_;
+
+  DISALLOW_COPY_AND_ASSIGN(SharedNetworkResources);
+};
+
+static base::LazyInstance<SharedNetworkResources>::Leaky
+    g_shared_network_resources = LAZY_INSTANCE_INITIALIZER;
+
 class BasicNetworkDelegate : public net::NetworkDelegateImpl {
  public:
   BasicNetworkDelegate() {}
@@ -144,10 +183,15 @@ CronetURLRequestContext::CronetURLRequestContext(
     : default_load_flags_(
           net::LOAD_NORMAL |
           (context_config->load_disable_cache ? net::LOAD_DISABLE_CACHE : 0)),
+      share_network_resources_(!network_task_runner &&
+                               context_config->ShouldShareNetworkResources()),
       network_tasks_(
           new NetworkTasks(std::move(context_config), std::move(callback))),
       network_task_runner_(network_task_runner) {
-  if (!network_task_runner_) {
+  if (share_network_resources_) {
+    network_task_runner_ =
+        g_shared_network_resources.Get().network_task_runner();
+  } else if (!network_task_runner_) {
     network_thread_ = std::make_unique<base::Thread>("network");
     base::Thread::Options options;
     options.message_loop_type = base::MessageLoop::TYPE_IO;
@@ -195,7 +239,8 @@ void CronetURLRequestContext::InitRequestContextOnInitThread() {
       base::BindOnce(&CronetURLRequestContext::NetworkTasks::Initialize,
                      base::Unretained(network_tasks_), GetNetworkTaskRunner(),
                      GetFileThread()->task_runner(),
-                     std::move(proxy_config_service)));
+                     std::move(proxy_config_service),
+                     share_network_resources_));
 }
 
 void CronetURLRequestContext::NetworkTasks::
@@ -275,15 +320,22 @@ void CronetURLRequestContext::NetworkTasks::InitializeNQEPrefs() const {
 void CronetURLRequestContext::NetworkTasks::Initialize(
     scoped_refptr<base::SingleThreadTaskRunner> network_task_runner,
     scoped_refptr<base::SequencedTaskRunner> file_task_runner,
-    std::unique_ptr<net::ProxyConfigService> proxy_config_service) {
+    std::unique_ptr<net::ProxyConfigService> proxy_config_service,
+    bool share_network_resources) {
   DCHECK_CALLED_ON_VALID_THREAD(network_thread_checker_);
   DCHECK(!is_context_initialized_);
 
   std::unique_ptr<URLRequestContextConfig> config(std::move(context_config_));
   network_task_runner_ = network_task_runner;
-  if (config->network_thread_priority)
+  // A shared network thread's priority isn't up to any one context.
+  if (config->network_thread_priority && !share_network_resources)
     SetNetworkThreadPriorityOnNetworkThread(
         config->network_thread_priority.value());
+  if (share_network_resources) {
+    config->shared_host_resolver_manager =
+        g_shared_network_resources.Get().GetHostResolverManager(
+            g_net_log.Get().net_log());
+  }
   base::DisallowBlocking();
   net::URLRequestContextBuilder context_builder;
   context_builder.set_network_delegate(
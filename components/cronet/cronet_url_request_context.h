@@ -173,10 +173,13 @@ class CronetURLRequestContext {
     ~NetworkTasks() override;
 
     // Initializes |context_| on the network thread.
+    // If |share_network_resources|, the network thread is shared with other
+    // contexts, and so may be the network objects that live on it.
     void Initialize(
         scoped_refptr<base::SingleThreadTaskRunner> network_task_runner,
         scoped_refptr<base::SequencedTaskRunner> file_task_runner,
-        std::unique_ptr<net::ProxyConfigService> proxy_config_service);
+        std::unique_ptr<net::ProxyConfigService> proxy_config_service,
+        bool share_network_resources);
 
     // Runs a task that might depend on the context being initialized.
     void RunTaskAfterContextInit(
@@ -286,6 +289,10 @@ class CronetURLRequestContext {
 
   const int default_load_flags_;
 
+  // Whether the context runs on the network thread shared by all contexts with
+  // the SharedNetworkResources experimental option, rather than on its own.
+  const bool share_network_resources_;
+
   // File thread should be destroyed last.
   std::unique_ptr<base::Thread> file_thread_;
 
@@ -83,7 +83,8 @@ class Cronet_UploadDataSinkImpl : public Cronet_UploadDataSink {
   UserCallback in_which_user_callback_ = NOT_IN_CALLBACK;
   // Close data provider once it returns from the callback.
   bool close_when_not_in_callback_ = false;
-  // Keeps the net::IOBuffer and Cronet ByteBuffer alive until the next Read().
+  // Keeps the net::IOBuffer and Cronet ByteBuffer alive until the next Read()
+  // with a different net::IOBuffer.
   std::unique_ptr<Cronet_BufferWithIOBuffer> buffer_;
 
   DISALLOW_COPY_AND_ASSIGN(Cronet_UploadDataSinkImpl);
@@ -145,6 +145,11 @@ const char kNetworkErrorLoggingOrigin[] = "origin";
 // Name of key (for above two lists) for header value.
 const char kNetworkErrorLoggingValue[] = "value";
 
+// Runs the context on a network thread shared with other contexts with this
+// option, and shares the network objects on it where possible.
+const char kSharedNetworkResourcesFieldTrialName[] = "SharedNetworkResources";
+const char kSharedNetworkResourcesEnable[] = "enable";
+
 // Disable IPv6 when on WiFi. This is a workaround for a known issue on certain
 // Android phones, and should not be necessary when not on one of those devices.
 // See https://crbug.com/696569 for details.
@@ -286,6 +291,21 @@ URLRequestContextConfig::URLRequestContextConfig(
 
 URLRequestContextConfig::~URLRequestContextConfig() {}
 
+bool URLRequestContextConfig::ShouldShareNetworkResources() const {
+  if (experimental_options.empty())
+    return false;
+  std::unique_ptr<base::DictionaryValue> dict = base::DictionaryValue::From(
+      base::JSONReader::ReadDeprecated(experimental_options));
+  const base::DictionaryValue* shared_network_resources_args = nullptr;
+  bool enable = false;
+  return dict &&
+         dict->GetDictionary(kSharedNetworkResourcesFieldTrialName,
+                             &shared_network_resources_args) &&
+         shared_network_resources_args->GetBoolean(
+             kSharedNetworkResourcesEnable, &enable) &&
+         enable;
+}
+
 void URLRequestContextConfig::ParseAndSetExperimentalOptions(
     net::URLRequestContextBuilder* context_builder,
     net::HttpNetworkSession::Params* session_params,
@@ -661,6 +681,8 @@ void URLRequestContextConfig::ParseAndSetExperimentalOptions(
         }
       }
 
+    } else if (it.key() == kSharedNetworkResourcesFieldTrialName) {
+      // Read by ShouldShareNetworkResources() when the context is created.
     } else {
       LOG(WARNING) << "Unrecognized Cronet experimental option \"" << it.key()
                    << "\" with params \"" << it.value();
@@ -693,6 +715,8 @@ void URLRequestContextConfig::ParseAndSetExperimentalOptions(
       host_resolver = std::move(remapped_resolver);
     }
     context_builder->set_host_resolver(std::move(host_resolver));
+  } else if (shared_host_resolver_manager) {
+    context_builder->set_host_resolver_manager(shared_host_resolver_manager);
   }
 
 #if BUILDFLAG(ENABLE_REPORTING)
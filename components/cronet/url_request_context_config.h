@@ -21,6 +21,7 @@
 
 namespace net {
 class CertVerifier;
+class HostResolverManager;
 class NetLog;
 class URLRequestContextBuilder;
 }  // namespace net
@@ -131,6 +132,12 @@ struct URLRequestContextConfig {
       base::Optional<double> network_thread_priority);
   ~URLRequestContextConfig();
 
+  // Returns true if the SharedNetworkResources experimental option is enabled,
+  // i.e. the context should run on a network thread shared with other such
+  // contexts, and share their network objects where that doesn't leak state
+  // that the other experimental options configure per context.
+  bool ShouldShareNetworkResources() const;
+
   // Configures |context_builder| based on |this|.
   void ConfigureURLRequestContextBuilder(
       net::URLRequestContextBuilder* context_builder,
@@ -180,6 +187,11 @@ struct URLRequestContextConfig {
   // prefs. Only relevant when |enable_host_cache_persistence| is true.
   int host_cache_persistence_delay_ms = 60000;
 
+  // If set, the context's HostResolver uses this manager, and so shares its
+  // HostCache and in-flight lookups, unless a DNS-related experimental option
+  // requires a resolver of its own. Must outlive the context.
+  net::HostResolverManager* shared_host_resolver_manager = nullptr;
+
   // Experimental options that are recognized by the config parser.
   std::unique_ptr<base::DictionaryValue> effective_experimental_options =
       nullptr;
@@ -19,6 +19,7 @@
 #include "net/base/net_errors.h"
 #include "net/cert/cert_verifier.h"
 #include "net/dns/host_resolver.h"
+#include "net/dns/host_resolver_manager.h"
 #include "net/http/http_network_session.h"
 #include "net/log/net_log.h"
 #include "net/log/net_log_with_source.h"
@@ -747,6 +748,80 @@ TEST(URLRequestContextConfigTest, SetQuicStaleDNSracing) {
   EXPECT_TRUE(params->quic_race_stale_dns_on_connection);
 }
 
+TEST(URLRequestContextConfigTest, SetSharedNetworkResources) {
+  base::test::ScopedTaskEnvironment scoped_task_environment_(
+      base::test::ScopedTaskEnvironment::MainThreadType::IO);
+
+  auto create_config = [](const std::string& experimental_options) {
+    return std::make_unique<URLRequestContextConfig>(
+        // Enable QUIC.
+        true,
+        // QUIC User Agent ID.
+        "Default QUIC User Agent ID",
+        // Enable SPDY.
+        true,
+        // Enable Brotli.
+        false,
+        // Type of http cache.
+        URLRequestContextConfig::HttpCacheType::MEMORY,
+        // Max size of http cache in bytes.
+        1024000,
+        // Disable caching for HTTP responses. Other information may be stored
+        // in the cache.
+        false,
+        // Storage path for http cache and cookie storage.
+        "",
+        // Accept-Language request header field.
+        "foreign-language",
+        // User-Agent request header field.
+        "fake agent",
+        // JSON encoded experimental options.
+        experimental_options,
+        // MockCertVerifier to use for testing purposes.
+        std::unique_ptr<net::CertVerifier>(),
+        // Enable network quality estimator.
+        false,
+        // Enable Public Key Pinning bypass for local trust anchors.
+        true,
+        // Optional network thread priority.
+        base::Optional<double>());
+  };
+  auto build_context = [](URLRequestContextConfig* config,
+                          net::NetLog* net_log) {
+    net::URLRequestContextBuilder builder;
+    config->ConfigureURLRequestContextBuilder(&builder, net_log);
+    // Set a ProxyConfigService to avoid DCHECK failure when building.
+    builder.set_proxy_config_service(
+        std::make_unique<net::ProxyConfigServiceFixed>(
+            net::ProxyConfigWithAnnotation::CreateDirect()));
+    return builder.Build();
+  };
+
+  EXPECT_FALSE(create_config("")->ShouldShareNetworkResources());
+  EXPECT_FALSE(create_config("{\"SharedNetworkResources\":{\"enable\":false}}")
+                   ->ShouldShareNetworkResources());
+
+  net::NetLog net_log;
+  net::HostResolverManager manager(net::HostResolver::Options(), &net_log);
+  std::unique_ptr<URLRequestContextConfig> config1 =
+      create_config("{\"SharedNetworkResources\":{\"enable\":true}}");
+  std::unique_ptr<URLRequestContextConfig> config2 =
+      create_config("{\"SharedNetworkResources\":{\"enable\":true}}");
+  EXPECT_TRUE(config1->ShouldShareNetworkResources());
+  config1->shared_host_resolver_manager = &manager;
+  config2->shared_host_resolver_manager = &manager;
+  std::unique_ptr<net::URLRequestContext> context1 =
+      build_context(config1.get(), &net_log);
+  std::unique_ptr<net::URLRequestContext> context2 =
+      build_context(config2.get(), &net_log);
+
+  EXPECT_TRUE(config1->effective_experimental_options->HasKey(
+      "SharedNetworkResources"));
+  ASSERT_TRUE(context1->host_resolver()->GetHostCache());
+  EXPECT_EQ(context1->host_resolver()->GetHostCache(),
+            context2->host_resolver()->GetHostCache());
+}
+
 TEST(URLRequestContextConfigTest, SetQuicHostWhitelist) {
   base::test::ScopedTaskEnvironment scoped_task_environment_(
       base::test::ScopedTaskEnvironment::MainThreadType::IO);
@@ -8,6 +8,7 @@
 #include <memory>
 #include <utility>
 
+#include "base/bits.h"
 #include "base/format_macros.h"
 #include "base/memory/discardable_shared_memory.h"
 #include "base/memory/ptr_util.h"
@@ -26,6 +27,8 @@ bool IsInFreeList(DiscardableSharedMemoryHeap::Span* span) {
   return span->previous() || span->next();
 }
 
+constexpr size_t kBitsPerWord = 64;
+
 }  // namespace
 
 DiscardableSharedMemoryHeap::Span::Span(
@@ -107,6 +110,7 @@ DiscardableSharedMemoryHeap::~DiscardableSharedMemoryHeap() {
                             return !free_spans.empty();
                           }),
             0);
+  DCHECK(large_free_spans_.empty());
 }
 
 std::unique_ptr<DiscardableSharedMemoryHeap::Span>
@@ -192,35 +196,27 @@ std::unique_ptr<DiscardableSharedMemoryHeap::Span>
 DiscardableSharedMemoryHeap::SearchFreeLists(size_t blocks, size_t slack) {
   DCHECK(blocks);
 
-  size_t length = blocks;
   size_t max_length = blocks + slack;
-
-  // Search array of free lists for a suitable span.
-  while (length - 1 < base::size(free_spans_) - 1) {
-    const base::LinkedList<Span>& free_spans = free_spans_[length - 1];
-    if (!free_spans.empty()) {
+  const size_t overflow_index = base::size(free_spans_) - 1;
+
+  // Search array of free lists for the shortest suitable span.
+  if (blocks - 1 < overflow_index) {
+    size_t index = FindNonEmptyFreeList(blocks - 1);
+    if (index < overflow_index) {
+      // Return early after surpassing |max_length|.
+      if (index + 1 > max_length)
+        return nullptr;
       // Return the most recently used span located in tail.
-      return Carve(free_spans.tail()->value(), blocks);
+      return Carve(free_spans_[index].tail()->value(), blocks);
     }
-
-    // Return early after surpassing |max_length|.
-    if (++length > max_length)
-      return nullptr;
-  }
-
-  const base::LinkedList<Span>& overflow_free_spans =
-      free_spans_[base::size(free_spans_) - 1];
-
-  // Search overflow free list for a suitable span. Starting with the most
-  // recently used span located in tail and moving towards head.
-  for (base::LinkNode<Span>* node = overflow_free_spans.tail();
-       node != overflow_free_spans.end(); node = node->previous()) {
-    Span* span = node->value();
-    if (span->length_ >= blocks && span->length_ <= max_length)
-      return Carve(span, blocks);
   }
 
-  return nullptr;
+  // Search overflow free list for the shortest suitable span.
+  auto it = large_free_spans_.lower_bound(
+      std::make_pair(blocks, static_cast<Span*>(nullptr)));
+  if (it == large_free_spans_.end() || it->first > max_length)
+    return nullptr;
+  return Carve(it->second, blocks);
 }
 
 void DiscardableSharedMemoryHeap::ReleaseFreeMemory() {
@@ -266,13 +262,40 @@ void DiscardableSharedMemoryHeap::InsertIntoFreeList(
     std::unique_ptr<DiscardableSharedMemoryHeap::Span> span) {
   DCHECK(!IsInFreeList(span.get()));
   size_t index = std::min(span->length_, base::size(free_spans_)) - 1;
+  if (index == base::size(free_spans_) - 1) {
+    large_free_spans_.insert(std::make_pair(span->length_, span.get()));
+  } else {
+    non_empty_free_lists_[index / kBitsPerWord] |=
+        uint64_t{1} << (index % kBitsPerWord);
+  }
   free_spans_[index].Append(span.release());
 }
 
+size_t DiscardableSharedMemoryHeap::FindNonEmptyFreeList(size_t index) const {
+  size_t word = index / kBitsPerWord;
+  uint64_t bits =
+      non_empty_free_lists_[word] & (~uint64_t{0} << (index % kBitsPerWord));
+  while (!bits) {
+    if (++word == base::size(non_empty_free_lists_))
+      return base::size(free_spans_) - 1;
+    bits = non_empty_free_lists_[word];
+  }
+  return word * kBitsPerWord + base::bits::CountTrailingZeroBits(bits);
+}
+
 std::unique_ptr<DiscardableSharedMemoryHeap::Span>
 DiscardableSharedMemoryHeap::RemoveFromFreeList(Span* span) {
   DCHECK(IsInFreeList(span));
   span->RemoveFromList();
+  size_t index = std::min(span->length_, base::size(free_spans_)) - 1;
+  if (index == base::size(free_spans_) - 1) {
+    auto it = large_free_spans_.find(std::make_pair(span->length_, span));
+    DCHECK(it != large_free_spans_.end());
+    large_free_spans_.erase(it);
+  } else if (free_spans_[index].empty()) {
+    non_empty_free_lists_[index / kBitsPerWord] &=
+        ~(uint64_t{1} << (index % kBitsPerWord));
+  }
   return base::WrapUnique(span);
 }
 
@@ -9,7 +9,9 @@
 #include <stdint.h>
 
 #include <memory>
+#include <set>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include "base/callback.h"
@@ -25,7 +27,9 @@ class DiscardableSharedMemory;
 namespace discardable_memory {
 
 // Implements a heap of discardable shared memory. An array of free lists
-// is used to keep track of free blocks.
+// is used to keep track of free blocks. Short spans are segregated by length,
+// and longer spans are kept ordered by length, so that searches return the
+// best fitting span without scanning the free lists.
 class DISCARDABLE_MEMORY_EXPORT DiscardableSharedMemoryHeap {
  public:
   class DISCARDABLE_MEMORY_EXPORT Span : public base::LinkNode<Span> {
@@ -78,7 +82,8 @@ class DISCARDABLE_MEMORY_EXPORT DiscardableSharedMemoryHeap {
   // memory. If found, the span is removed from the free list and returned.
   // |slack| determines the fitness requirement. Only spans that are less
   // or equal to |blocks| + |slack| are considered, worse fitting spans are
-  // ignored.
+  // ignored. The shortest suitable span is returned, and the most recently
+  // used one among spans of that length when it is shorter than 256 blocks.
   std::unique_ptr<Span> SearchFreeLists(size_t blocks, size_t slack);
 
   // Release free shared memory segments.
@@ -139,6 +144,10 @@ class DISCARDABLE_MEMORY_EXPORT DiscardableSharedMemoryHeap {
   };
 
   void InsertIntoFreeList(std::unique_ptr<Span> span);
+  // Returns the index of the first non-empty free list of spans shorter than
+  // 256 blocks at or after |index|, or the index of the overflow free list if
+  // there is none.
+  size_t FindNonEmptyFreeList(size_t index) const;
   std::unique_ptr<Span> RemoveFromFreeList(Span* span);
   std::unique_ptr<Span> Carve(Span* span, size_t blocks);
   void RegisterSpan(Span* span);
@@ -172,6 +181,14 @@ class DISCARDABLE_MEMORY_EXPORT DiscardableSharedMemoryHeap {
   // free list of runs that have length >= 256 blocks.
   base::LinkedList<Span> free_spans_[256];
 
+  // Bitmap of the free lists above that are not empty, except for the
+  // overflow free list.
+  uint64_t non_empty_free_lists_[256 / 64] = {};
+
+  // The spans of the overflow free list, ordered by length for best-fit
+  // searches.
+  std::set<std::pair<size_t, Span*>> large_free_spans_;
+
   DISALLOW_COPY_AND_ASSIGN(DiscardableSharedMemoryHeap);
 };
 
@@ -26,12 +26,17 @@ const int kTimeCheckInterval = 8192;
 
 void NullTask() {}
 
-TEST(DiscardableSharedMemoryHeapTest, SearchFreeLists) {
+// Allocates and frees spans of exponentially distributed lengths, with a mean
+// of |mean_blocks| blocks, from |segments| segments of |blocks| blocks.
+void RunSearchFreeLists(const char* trace,
+                        size_t blocks,
+                        size_t segments,
+                        size_t mean_blocks) {
   size_t block_size = base::GetPageSize();
   DiscardableSharedMemoryHeap heap(block_size);
 
-  const size_t kBlocks = 4096;
-  const size_t kSegments = 16;
+  const size_t kBlocks = blocks;
+  const size_t kSegments = segments;
   size_t segment_size = block_size * kBlocks;
   int next_discardable_shared_memory_id = 0;
 
@@ -54,9 +59,8 @@ TEST(DiscardableSharedMemoryHeapTest, SearchFreeLists) {
   for (int i = 0; i < kTimeCheckInterval; ++i) {
     random_span[i] = std::rand();
     // Exponentially distributed block size.
-    const double kLambda = 2.0;
     double v = static_cast<double>(std::rand()) / RAND_MAX;
-    random_blocks[i] = 1 + log(1.0 - v) / -kLambda * kBlocks;
+    random_blocks[i] = 1 + log(1.0 - v) * -static_cast<double>(mean_blocks);
   }
 
   std::vector<std::unique_ptr<base::ScopedClosureRunner>> spans;
@@ -92,9 +96,18 @@ TEST(DiscardableSharedMemoryHeapTest, SearchFreeLists) {
 
   spans.clear();
 
-  perf_test::PrintResult("search_free_list", "", "",
+  perf_test::PrintResult("search_free_list", "", trace,
                          count / accumulator.InSecondsF(), "runs/s", true);
 }
 
+TEST(DiscardableSharedMemoryHeapTest, SearchFreeLists) {
+  RunSearchFreeLists("", 4096, 16, 4096 / 2);
+}
+
+// Short spans, as allocated by image decodes and font caches.
+TEST(DiscardableSharedMemoryHeapTest, SearchFreeListsShortSpans) {
+  RunSearchFreeLists("short_spans", 1024, 16, 8);
+}
+
 }  // namespace
 }  // namespace discardable_memory
@@ -281,6 +281,64 @@ TEST(DiscardableSharedMemoryHeapTest, Slack) {
   heap.MergeIntoFreeLists(std::move(span));
 }
 
+TEST(DiscardableSharedMemoryHeapTest, BestFit) {
+  size_t block_size = base::GetPageSize();
+  DiscardableSharedMemoryHeap heap(block_size);
+
+  const size_t kBlocks = 1000;
+  size_t memory_size = block_size * kBlocks;
+  int next_discardable_shared_memory_id = 0;
+
+  std::unique_ptr<base::DiscardableSharedMemory> memory(
+      new base::DiscardableSharedMemory);
+  ASSERT_TRUE(memory->CreateAndMap(memory_size));
+  std::unique_ptr<DiscardableSharedMemoryHeap::Span> large_span =
+      heap.Grow(std::move(memory), memory_size,
+                next_discardable_shared_memory_id++, base::Bind(NullTask));
+
+  // Split the segment into free spans of 600, 300 and 3 blocks, kept apart by
+  // allocated spans.
+  std::unique_ptr<DiscardableSharedMemoryHeap::Span> separator1 =
+      heap.Split(large_span.get(), 600);
+  std::unique_ptr<DiscardableSharedMemoryHeap::Span> medium_span =
+      heap.Split(separator1.get(), 1);
+  std::unique_ptr<DiscardableSharedMemoryHeap::Span> separator2 =
+      heap.Split(medium_span.get(), 300);
+  std::unique_ptr<DiscardableSharedMemoryHeap::Span> small_span =
+      heap.Split(separator2.get(), 1);
+  std::unique_ptr<DiscardableSharedMemoryHeap::Span> separator3 =
+      heap.Split(small_span.get(), 3);
+  size_t medium_span_start = medium_span->start();
+  size_t small_span_start = small_span->start();
+
+  // Free the 300 block span before the 600 block one, so that the latter is
+  // the most recently used.
+  heap.MergeIntoFreeLists(std::move(small_span));
+  heap.MergeIntoFreeLists(std::move(medium_span));
+  heap.MergeIntoFreeLists(std::move(large_span));
+
+  // Short requests are served from the shortest free span.
+  std::unique_ptr<DiscardableSharedMemoryHeap::Span> span =
+      heap.SearchFreeLists(2, kBlocks);
+  ASSERT_TRUE(span);
+  EXPECT_EQ(small_span_start, span->start());
+  heap.MergeIntoFreeLists(std::move(span));
+
+  // So are long requests.
+  span = heap.SearchFreeLists(280, kBlocks);
+  ASSERT_TRUE(span);
+  EXPECT_EQ(medium_span_start, span->start());
+  heap.MergeIntoFreeLists(std::move(span));
+
+  // Spans longer than |blocks| + |slack| are ignored.
+  EXPECT_FALSE(heap.SearchFreeLists(250, 10));
+
+  heap.MergeIntoFreeLists(std::move(separator1));
+  heap.MergeIntoFreeLists(std::move(separator2));
+  heap.MergeIntoFreeLists(std::move(separator3));
+  EXPECT_EQ(memory_size, heap.GetSizeOfFreeLists());
+}
+
 void OnDeleted(bool* deleted) {
   *deleted = true;
 }
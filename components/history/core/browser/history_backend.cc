@@ -308,6 +308,7 @@ SegmentID HistoryBackend::GetLastSegmentID(VisitID from_visit) {
 }
 
 SegmentID HistoryBackend::UpdateSegments(const GURL& url,
+                                         URLID url_id,
                                          VisitID from_visit,
                                          VisitID visit_id,
                                          ui::PageTransition transition_type,
@@ -341,7 +342,6 @@ SegmentID HistoryBackend::UpdateSegments(const GURL& url,
       (transition_type & ui::PAGE_TRANSITION_FORWARD_BACK) == 0) {
     // If so, create or get the segment.
     std::string segment_name = db_->ComputeSegmentName(url);
-    URLID url_id = db_->GetRowForURL(url, nullptr);
     if (!url_id)
       return 0;
 
@@ -395,15 +395,8 @@ void HistoryBackend::UpdateVisitDuration(VisitID visit_id, const Time end_ts) {
   if (!db_)
     return;
 
-  // Get the starting visit_time for visit_id.
-  VisitRow visit_row;
-  if (db_->GetRowForVisit(visit_id, &visit_row)) {
-    // We should never have a negative duration time even when time is skewed.
-    visit_row.visit_duration = end_ts > visit_row.visit_time
-                                   ? end_ts - visit_row.visit_time
-                                   : TimeDelta::FromMicroseconds(0);
-    db_->UpdateVisitRow(visit_row);
-  }
+  // We should never have a negative duration time even when time is skewed.
+  db_->UpdateVisitDuration(visit_id, end_ts);
 }
 
 bool HistoryBackend::IsUntypedIntranetHost(const GURL& url) {
@@ -506,8 +499,8 @@ void HistoryBackend::AddPage(const HistoryAddPageArgs& request) {
     // result in changing most visited, so we don't update segments (most
     // visited db).
     if (!is_keyword_generated && request.consider_for_ntp_most_visited) {
-      UpdateSegments(request.url, from_visit_id, last_ids.second, t,
-                     request.time);
+      UpdateSegments(request.url, last_ids.first, from_visit_id,
+                     last_ids.second, t, request.time);
 
       // Update the referrer's duration.
       UpdateVisitDuration(from_visit_id, request.time);
@@ -614,8 +607,8 @@ void HistoryBackend::AddPage(const HistoryAddPageArgs& request) {
 
       if (t & ui::PAGE_TRANSITION_CHAIN_START) {
         if (request.consider_for_ntp_most_visited) {
-          UpdateSegments(redirects[redirect_index], from_visit_id,
-                         last_ids.second, t, request.time);
+          UpdateSegments(redirects[redirect_index], last_ids.first,
+                         from_visit_id, last_ids.second, t, request.time);
         }
 
         // Update the visit_details for this visit.
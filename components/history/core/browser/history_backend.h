@@ -691,8 +691,10 @@ class HistoryBackend : public base::RefCountedThreadSafe<HistoryBackend>,
   SegmentID GetLastSegmentID(VisitID from_visit);
 
   // Update the segment information. This is called internally when a page is
-  // added. Return the segment id of the segment that has been updated.
+  // added, with the ID that AddPageVisit() returned for |url|. Return the
+  // segment id of the segment that has been updated.
   SegmentID UpdateSegments(const GURL& url,
+                           URLID url_id,
                            VisitID from_visit,
                            VisitID visit_id,
                            ui::PageTransition transition_type,
@@ -260,6 +260,17 @@ bool VisitDatabase::UpdateVisitRow(const VisitRow& visit) {
   return statement.Run();
 }
 
+bool VisitDatabase::UpdateVisitDuration(VisitID visit_id,
+                                        base::Time end_time) {
+  sql::Statement statement(GetDB().GetCachedStatement(
+      SQL_FROM_HERE,
+      "UPDATE visits SET visit_duration=MAX(?-visit_time,0) WHERE id=?"));
+  statement.BindInt64(0, end_time.ToInternalValue());
+  statement.BindInt64(1, visit_id);
+
+  return statement.Run();
+}
+
 bool VisitDatabase::GetVisitsForURL(URLID url_id, VisitVector* visits) {
   visits->clear();
 
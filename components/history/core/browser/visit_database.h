@@ -52,6 +52,12 @@ class VisitDatabase {
   // VisitID as the key. The visit must exist. Returns true on success.
   bool UpdateVisitRow(const VisitRow& visit);
 
+  // Sets the duration of the visit with the given ID to end at |end_time|, or
+  // to zero if |end_time| is before the visit. This is a single statement,
+  // rather than GetRowForVisit() followed by UpdateVisitRow(). Returns true on
+  // success, including when there is no such visit.
+  bool UpdateVisitDuration(VisitID visit_id, base::Time end_time);
+
   // Fills in the given vector with all of the visits for the given page ID,
   // sorted in ascending order of date. Returns true on success (although there
   // may still be no matches).
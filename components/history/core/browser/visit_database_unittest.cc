@@ -160,6 +160,28 @@ TEST_F(VisitDatabaseTest, Update) {
   EXPECT_TRUE(IsVisitInfoEqual(modification, final));
 }
 
+TEST_F(VisitDatabaseTest, UpdateVisitDuration) {
+  const Time visit_time = Time::Now();
+  VisitRow visit(1, visit_time, 0, ui::PAGE_TRANSITION_LINK, 0, false);
+  AddVisit(&visit, SOURCE_BROWSED);
+
+  EXPECT_TRUE(UpdateVisitDuration(visit.visit_id,
+                                  visit_time + TimeDelta::FromSeconds(5)));
+  VisitRow row;
+  ASSERT_TRUE(GetRowForVisit(visit.visit_id, &row));
+  EXPECT_EQ(TimeDelta::FromSeconds(5), row.visit_duration);
+
+  // An end time before the visit, from a skewed clock, gives no duration.
+  EXPECT_TRUE(UpdateVisitDuration(visit.visit_id,
+                                  visit_time - TimeDelta::FromSeconds(5)));
+  ASSERT_TRUE(GetRowForVisit(visit.visit_id, &row));
+  EXPECT_EQ(TimeDelta(), row.visit_duration);
+
+  // Other fields are not changed.
+  EXPECT_EQ(visit.url_id, row.url_id);
+  EXPECT_EQ(visit.visit_time, row.visit_time);
+}
+
 // TODO(brettw) write test for GetMostRecentVisitForURL!
 
 namespace {
@@ -15,6 +15,7 @@
 #include "base/strings/string_number_conversions.h"
 #include "base/strings/string_split.h"
 #include "base/strings/string_util.h"
+#include "base/threading/sequenced_task_runner_handle.h"
 #include "base/threading/thread_checker.h"
 #include "third_party/leveldatabase/env_chromium.h"
 #include "third_party/leveldatabase/leveldb_chrome.h"
@@ -39,7 +40,8 @@ bool PrefixStopCallback(const std::string& prefix, const std::string& key) {
   return base::StartsWith(key, prefix, base::CompareCase::SENSITIVE);
 }
 
-LevelDB::LevelDB(const char* client_name) : open_histogram_(nullptr) {
+LevelDB::LevelDB(const char* client_name)
+    : open_histogram_(nullptr), weak_factory_(this) {
   // Used in lieu of UMA_HISTOGRAM_ENUMERATION because the histogram name is
   // not a constant.
   open_histogram_ = base::LinearHistogram::FactoryGet(
@@ -53,6 +55,7 @@ LevelDB::LevelDB(const char* client_name) : open_histogram_(nullptr) {
 }
 
 LevelDB::~LevelDB() {
+  WriteGroupedSaves();
   DFAKE_SCOPED_LOCK(thread_checker_);
 }
 
@@ -113,6 +116,7 @@ bool LevelDB::Save(const base::StringPairs& entries_to_save,
                    const std::vector<std::string>& keys_to_remove,
                    leveldb::Status* status) {
   DCHECK(status);
+  WriteGroupedSaves();
   DFAKE_SCOPED_LOCK(thread_checker_);
   if (!db_)
     return false;
@@ -136,6 +140,49 @@ bool LevelDB::Save(const base::StringPairs& entries_to_save,
   return false;
 }
 
+void LevelDB::SaveGrouped(const base::StringPairs& entries_to_save,
+                          const std::vector<std::string>& keys_to_remove,
+                          SaveCallback callback) {
+  DFAKE_SCOPED_LOCK(thread_checker_);
+  for (const auto& pair : entries_to_save)
+    grouped_saves_.Put(leveldb::Slice(pair.first), leveldb::Slice(pair.second));
+
+  for (const auto& key : keys_to_remove)
+    grouped_saves_.Delete(leveldb::Slice(key));
+
+  grouped_save_callbacks_.push_back(std::move(callback));
+  if (grouped_save_callbacks_.size() == 1) {
+    base::SequencedTaskRunnerHandle::Get()->PostTask(
+        FROM_HERE, base::BindOnce(&LevelDB::WriteGroupedSaves,
+                                  weak_factory_.GetWeakPtr()));
+  }
+}
+
+void LevelDB::WriteGroupedSaves() {
+  DFAKE_SCOPED_LOCK(thread_checker_);
+  if (grouped_save_callbacks_.empty())
+    return;
+
+  leveldb::Status status;
+  bool success = false;
+  if (db_) {
+    leveldb::WriteOptions options;
+    options.sync = true;
+    status = db_->Write(options, &grouped_saves_);
+    success = status.ok();
+    if (!success) {
+      DLOG(WARNING) << "Failed writing leveldb_proto entries: "
+                    << status.ToString();
+    }
+  }
+  grouped_saves_.Clear();
+
+  std::vector<SaveCallback> callbacks;
+  callbacks.swap(grouped_save_callbacks_);
+  for (auto& callback : callbacks)
+    std::move(callback).Run(success, status);
+}
+
 bool LevelDB::UpdateWithRemoveFilter(const base::StringPairs& entries_to_save,
                                      const KeyFilter& delete_key_filter,
                                      leveldb::Status* status) {
@@ -148,6 +195,7 @@ bool LevelDB::UpdateWithRemoveFilter(const base::StringPairs& entries_to_save,
                                      const std::string& target_prefix,
                                      leveldb::Status* status) {
   DCHECK(status);
+  WriteGroupedSaves();
   DFAKE_SCOPED_LOCK(thread_checker_);
   if (!db_)
     return false;
@@ -234,6 +282,7 @@ bool LevelDB::LoadKeysAndEntriesWhile(
     const leveldb::ReadOptions& options,
     const std::string& start_key,
     const KeyFilter& while_callback) {
+  WriteGroupedSaves();
   DFAKE_SCOPED_LOCK(thread_checker_);
   if (!db_)
     return false;
@@ -281,6 +330,7 @@ bool LevelDB::Get(const std::string& key,
                   std::string* entry,
                   leveldb::Status* status) {
   DCHECK(status);
+  WriteGroupedSaves();
   DFAKE_SCOPED_LOCK(thread_checker_);
   if (!db_)
     return false;
@@ -302,6 +352,7 @@ bool LevelDB::Get(const std::string& key,
 }
 
 leveldb::Status LevelDB::Destroy() {
+  WriteGroupedSaves();
   db_.reset();
   const std::string path = database_dir_.AsUTF8Unsafe();
   leveldb::Status status = leveldb::DestroyDB(path, open_options_);
@@ -10,9 +10,12 @@
 #include <string>
 #include <vector>
 
+#include "base/callback.h"
+#include "base/memory/weak_ptr.h"
 #include "base/strings/string_split.h"
 #include "components/leveldb_proto/public/proto_database.h"
 #include "third_party/leveldatabase/env_chromium.h"
+#include "third_party/leveldatabase/src/include/leveldb/write_batch.h"
 
 namespace base {
 class FilePath;
@@ -31,6 +34,9 @@ namespace leveldb_proto {
 // same thread (not necessarily the same as the constructor).
 class LevelDB {
  public:
+  using SaveCallback =
+      base::OnceCallback<void(bool success, const leveldb::Status& status)>;
+
   // Constructor. Does *not* open a leveldb - only initialize this class.
   // |client_name| is the name of the "client" that owns this instance. Used
   // for UMA statics as so: LevelDB.<value>.<client name>. It is best to not
@@ -50,6 +56,14 @@ class LevelDB {
                     const std::vector<std::string>& keys_to_remove,
                     leveldb::Status* status);
 
+  // Like Save(), but queues the changes so that all saves made in the same
+  // task on this sequence share one synced write. The write happens in a task
+  // posted to the current sequence, or before any other operation on this
+  // database if that comes first. |callback| is then run with the result.
+  void SaveGrouped(const base::StringPairs& entries_to_save,
+                   const std::vector<std::string>& keys_to_remove,
+                   SaveCallback callback);
+
   virtual bool UpdateWithRemoveFilter(const base::StringPairs& entries_to_save,
                                       const KeyFilter& delete_key_filter,
                                       leveldb::Status* status);
@@ -103,6 +117,9 @@ class LevelDB {
   bool GetApproximateMemoryUse(uint64_t* approx_mem);
 
  private:
+  // Writes the changes queued by SaveGrouped(), if any.
+  void WriteGroupedSaves();
+
   DFAKE_MUTEX(thread_checker_);
 
   // The declaration order of these members matters: |db_| depends on |env_| and
@@ -113,6 +130,10 @@ class LevelDB {
   leveldb_env::Options open_options_;
   base::HistogramBase* open_histogram_;
   base::HistogramBase* approx_memtable_mem_histogram_;
+  leveldb::WriteBatch grouped_saves_;
+  std::vector<SaveCallback> grouped_save_callbacks_;
+
+  base::WeakPtrFactory<LevelDB> weak_factory_;
 
   DISALLOW_COPY_AND_ASSIGN(LevelDB);
 };
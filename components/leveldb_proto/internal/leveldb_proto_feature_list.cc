@@ -9,4 +9,7 @@ namespace leveldb_proto {
 const base::Feature kProtoDBSharedMigration{"ProtoDBSharedMigration",
                                             base::FEATURE_DISABLED_BY_DEFAULT};
 
+const base::Feature kProtoDBGroupedWrites{"ProtoDBGroupedWrites",
+                                          base::FEATURE_DISABLED_BY_DEFAULT};
+
 }  // namespace leveldb_proto
@@ -11,6 +11,11 @@ namespace leveldb_proto {
 
 extern const base::Feature kProtoDBSharedMigration;
 
+// Writes all UpdateEntries() calls that reach a database in the same task with
+// one synced LevelDB write, including calls from different clients of a
+// shared database.
+extern const base::Feature kProtoDBGroupedWrites;
+
 }  // namespace leveldb_proto
 
 #endif  // COMPONENTS_LEVELDB_PROTO_FEATURE_LIST_H_
\ No newline at end of file
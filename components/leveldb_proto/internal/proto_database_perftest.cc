@@ -21,9 +21,11 @@
 #include "base/run_loop.h"
 #include "base/strings/string_number_conversions.h"
 #include "base/strings/stringprintf.h"
+#include "base/test/scoped_feature_list.h"
 #include "base/threading/thread.h"
 #include "build/build_config.h"
 #include "components/leveldb_proto/internal/leveldb_database.h"
+#include "components/leveldb_proto/internal/leveldb_proto_feature_list.h"
 #include "components/leveldb_proto/internal/proto_database_impl.h"
 #include "components/leveldb_proto/internal/unique_proto_database.h"
 #include "components/leveldb_proto/testing/proto/test_db.pb.h"
@@ -471,6 +473,51 @@ class ProtoDBPerfTest : public testing::Test {
     return stats;
   }
 
+  // Issues |num_entries| single-entry updates to one database without waiting
+  // for each to finish, as many clients of a shared database do at startup,
+  // and reports the time until all of them have been written.
+  void RunBurstInsertTestAndCleanup(int num_entries,
+                                    bool grouped_writes,
+                                    const std::string& test_modifier) {
+    base::test::ScopedFeatureList feature_list;
+    if (grouped_writes)
+      feature_list.InitAndEnableFeature(kProtoDBGroupedWrites);
+    else
+      feature_list.InitAndDisableFeature(kProtoDBGroupedWrites);
+
+    ScopedTempDir temp_dir;
+    ASSERT_TRUE(temp_dir.CreateUniqueTempDir());
+    InitDB(kSingleDBName, temp_dir);
+    TestDatabase* db;
+    GetDatabase(kSingleDBName, &db);
+
+    auto entries = GenerateTestEntries("burst_", num_entries, kSmallDataSize);
+    base::RunLoop run_update_entries;
+    int remaining = num_entries;
+    base::ElapsedTimer timer;
+    for (const auto& entry : *entries) {
+      db->proto_db()->UpdateEntries(
+          std::make_unique<KeyEntryVector>(1, entry),
+          std::make_unique<std::vector<std::string>>(),
+          base::BindOnce(
+              [](base::OnceClosure signal, int* remaining, bool success) {
+                EXPECT_TRUE(success);
+                if (--*remaining == 0)
+                  std::move(signal).Run();
+              },
+              run_update_entries.QuitClosure(), &remaining));
+    }
+    run_update_entries.Run();
+
+    auto test_modifier_str =
+        base::StringPrintf("%s_%d", test_modifier.c_str(), num_entries);
+    perf_test::PrintResult("ProtoDBPerfTest", test_modifier_str,
+                           "Total time taken",
+                           timer.Elapsed().InMillisecondsF(), "ms", true);
+
+    ShutdownDBs();
+  }
+
   PerfStats CombinePerfStats(const PerfStats& a, const PerfStats& b) {
     PerfStats out;
     out.time_ms = a.time_ms + b.time_ms;
@@ -1099,4 +1146,14 @@ TEST_F(ProtoDBPerfTest, LoadEntriesMulti_DifferingNumDBs_SkipReadCache_Large) {
   ASSERT_NE(num_entries, 0U);
 }
 
+TEST_F(ProtoDBPerfTest, InsertBurst_Separate) {
+  RunBurstInsertTestAndCleanup(kSmallNumEntries, false /* grouped_writes */,
+                               "InsertBurst_Separate");
+}
+
+TEST_F(ProtoDBPerfTest, InsertBurst_Grouped) {
+  RunBurstInsertTestAndCleanup(kSmallNumEntries, true /* grouped_writes */,
+                               "InsertBurst_Grouped");
+}
+
 }  // namespace leveldb_proto
@@ -6,11 +6,13 @@
 
 #include <string>
 
+#include "base/feature_list.h"
 #include "base/sequenced_task_runner.h"
 #include "base/task/post_task.h"
 #include "base/task/task_traits.h"
 #include "base/threading/sequenced_task_runner_handle.h"
 #include "components/leveldb_proto/internal/leveldb_database.h"
+#include "components/leveldb_proto/internal/leveldb_proto_feature_list.h"
 #include "components/leveldb_proto/internal/proto_leveldb_wrapper_metrics.h"
 #include "components/leveldb_proto/public/proto_database.h"
 
@@ -115,6 +117,30 @@ bool UpdateEntriesFromTaskRunner(
   return success;
 }
 
+void OnGroupedUpdateWritten(
+    const std::string& client_id,
+    Callbacks::UpdateCallback callback,
+    scoped_refptr<base::SequencedTaskRunner> callback_task_runner,
+    bool success,
+    const leveldb::Status& status) {
+  ProtoLevelDBWrapperMetrics::RecordUpdate(client_id, success, status);
+  callback_task_runner->PostTask(FROM_HERE,
+                                 base::BindOnce(std::move(callback), success));
+}
+
+void UpdateEntriesGroupedFromTaskRunner(
+    LevelDB* database,
+    std::unique_ptr<KeyValueVector> entries_to_save,
+    std::unique_ptr<KeyVector> keys_to_remove,
+    const std::string& client_id,
+    Callbacks::UpdateCallback callback,
+    scoped_refptr<base::SequencedTaskRunner> callback_task_runner) {
+  database->SaveGrouped(
+      *entries_to_save, *keys_to_remove,
+      base::BindOnce(OnGroupedUpdateWritten, client_id, std::move(callback),
+                     std::move(callback_task_runner)));
+}
+
 bool UpdateEntriesWithRemoveFilterFromTaskRunner(
     LevelDB* database,
     std::unique_ptr<KeyValueVector> entries_to_save,
@@ -213,6 +239,16 @@ void ProtoLevelDBWrapper::UpdateEntries(
     std::unique_ptr<KeyVector> keys_to_remove,
     typename Callbacks::UpdateCallback callback) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  if (base::FeatureList::IsEnabled(kProtoDBGroupedWrites)) {
+    task_runner_->PostTask(
+        FROM_HERE,
+        base::BindOnce(UpdateEntriesGroupedFromTaskRunner,
+                       base::Unretained(db_), std::move(entries_to_save),
+                       std::move(keys_to_remove), metrics_id_,
+                       std::move(callback),
+                       base::SequencedTaskRunnerHandle::Get()));
+    return;
+  }
   base::PostTaskAndReplyWithResult(
       task_runner_.get(), FROM_HERE,
       base::BindOnce(UpdateEntriesFromTaskRunner, base::Unretained(db_),
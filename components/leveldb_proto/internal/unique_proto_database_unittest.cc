@@ -17,10 +17,12 @@
 #include "base/location.h"
 #include "base/memory/ptr_util.h"
 #include "base/run_loop.h"
+#include "base/test/scoped_feature_list.h"
 #include "base/test/scoped_task_environment.h"
 #include "base/threading/thread.h"
 #include "base/threading/thread_task_runner_handle.h"
 #include "components/leveldb_proto/internal/leveldb_database.h"
+#include "components/leveldb_proto/internal/leveldb_proto_feature_list.h"
 #include "components/leveldb_proto/internal/proto_database_impl.h"
 #include "components/leveldb_proto/public/proto_database_provider.h"
 #include "components/leveldb_proto/testing/proto/test_db.pb.h"
@@ -613,6 +615,61 @@ TEST_F(UniqueProtoDatabaseLevelDBTest, TestDBSaveAndLoadKeys) {
   base::RunLoop().RunUntilIdle();
 }
 
+TEST_F(UniqueProtoDatabaseLevelDBTest, TestDBGroupedUpdates) {
+  base::test::ScopedFeatureList feature_list;
+  feature_list.InitAndEnableFeature(kProtoDBGroupedWrites);
+  ScopedTempDir temp_dir;
+  ASSERT_TRUE(temp_dir.CreateUniqueTempDir());
+  base::Thread db_thread("dbthread");
+  ASSERT_TRUE(db_thread.Start());
+  std::unique_ptr<ProtoDatabase<TestProto>> db =
+      ProtoDatabaseProvider::CreateUniqueDB<TestProto>(db_thread.task_runner());
+
+  base::RunLoop init_loop;
+  db->Init(kTestLevelDBClientName, temp_dir.GetPath(), CreateSimpleOptions(),
+           base::BindOnce([](base::OnceClosure closure,
+                             bool success) { std::move(closure).Run(); },
+                          init_loop.QuitClosure()));
+  init_loop.Run();
+
+  // Both updates are written together, in order, before the keys are loaded.
+  int updates = 0;
+  auto expect_update_success = [](int* updates, bool success) {
+    EXPECT_TRUE(success);
+    ++*updates;
+  };
+  TestProto test_proto;
+  test_proto.set_data("some data");
+  ProtoDatabase<TestProto>::KeyEntryVector data_set(
+      {{"0", test_proto}, {"1", test_proto}});
+  db->UpdateEntries(
+      std::make_unique<ProtoDatabase<TestProto>::KeyEntryVector>(data_set),
+      std::make_unique<std::vector<std::string>>(),
+      base::BindOnce(expect_update_success, &updates));
+  data_set = {{"2", test_proto}};
+  db->UpdateEntries(
+      std::make_unique<ProtoDatabase<TestProto>::KeyEntryVector>(data_set),
+      std::make_unique<std::vector<std::string>>(1, "0"),
+      base::BindOnce(expect_update_success, &updates));
+
+  base::RunLoop run_load_keys;
+  auto verify_loaded_keys = base::BindOnce(
+      [](base::OnceClosure signal, bool success,
+         std::unique_ptr<std::vector<std::string>> keys) {
+        EXPECT_TRUE(success);
+        EXPECT_THAT(*keys, UnorderedElementsAre("1", "2"));
+        std::move(signal).Run();
+      },
+      run_load_keys.QuitClosure());
+  db->LoadKeys(std::move(verify_loaded_keys));
+  run_load_keys.Run();
+  EXPECT_EQ(2, updates);
+
+  // Shutdown database.
+  db.reset();
+  base::RunLoop().RunUntilIdle();
+}
+
 TEST_F(UniqueProtoDatabaseTest, TestDBGetNotFound) {
   base::FilePath path(FILE_PATH_LITERAL("/fake/path"));
 
@@ -5,6 +5,7 @@
 #include "components/metrics/call_stack_profile_builder.h"
 
 #include <algorithm>
+#include <limits>
 #include <string>
 #include <tuple>
 #include <utility>
@@ -51,7 +52,8 @@ CallStackProfileBuilder::CallStackProfileBuilder(
     const WorkIdRecorder* work_id_recorder,
     const MetadataRecorder* metadata_recorder,
     base::OnceClosure completed_callback)
-    : work_id_recorder_(work_id_recorder),
+    : profile_params_(profile_params),
+      work_id_recorder_(work_id_recorder),
       metadata_recorder_(metadata_recorder),
       profile_start_time_(base::TimeTicks::Now()) {
   completed_callback_ = std::move(completed_callback);
@@ -64,6 +66,14 @@ CallStackProfileBuilder::CallStackProfileBuilder(
 
 CallStackProfileBuilder::~CallStackProfileBuilder() = default;
 
+void CallStackProfileBuilder::EnableContinuousProfiles(
+    int samples_per_profile,
+    base::TimeDelta sampling_period) {
+  DCHECK_GT(samples_per_profile, 0);
+  continuous_samples_per_profile_ = samples_per_profile;
+  continuous_sampling_period_ = sampling_period;
+}
+
 base::ModuleCache* CallStackProfileBuilder::GetModuleCache() {
   return &module_cache_;
 }
@@ -151,11 +161,36 @@ void CallStackProfileBuilder::OnSampleCompleted(
     item->set_name_hash_index(result.first->second);
     item->set_value(item_value);
   }
+
+  if (continuous_samples_per_profile_ &&
+      call_stack_profile->stack_sample_size() >=
+          continuous_samples_per_profile_) {
+    FinishProfile(base::TimeTicks::Now() - profile_start_time_,
+                  continuous_sampling_period_);
+  }
 }
 
 void CallStackProfileBuilder::OnProfileCompleted(
     base::TimeDelta profile_duration,
     base::TimeDelta sampling_period) {
+  // In continuous mode, the duration is that of the last partial profile, and
+  // there is nothing to pass on if it just ended.
+  if (continuous_samples_per_profile_) {
+    if (sampled_profile_.call_stack_profile().stack_sample_size()) {
+      FinishProfile(base::TimeTicks::Now() - profile_start_time_,
+                    sampling_period);
+    }
+  } else {
+    FinishProfile(profile_duration, sampling_period);
+  }
+
+  // Run the completed callback if there is one.
+  if (!completed_callback_.is_null())
+    std::move(completed_callback_).Run();
+}
+
+void CallStackProfileBuilder::FinishProfile(base::TimeDelta profile_duration,
+                                            base::TimeDelta sampling_period) {
   // Build the SampledProfile protobuf message.
   CallStackProfile* call_stack_profile =
       sampled_profile_.mutable_call_stack_profile();
@@ -174,14 +209,23 @@ void CallStackProfileBuilder::OnProfileCompleted(
 
   PassProfilesToMetricsProvider(std::move(sampled_profile_));
 
-  // Run the completed callback if there is one.
-  if (!completed_callback_.is_null())
-    std::move(completed_callback_).Run();
-
-  // Clear the caches.
+  // Clear the caches, which index into the profile that was passed on, and
+  // start the next profile.
   stack_index_.clear();
   module_index_.clear();
   modules_.clear();
+  metadata_hashes_cache_.clear();
+  // The first sample of a profile does not continue work from the previous
+  // one, which is in another profile.
+  last_work_id_ = std::numeric_limits<unsigned int>::max();
+  sampled_profile_ = SampledProfile();
+  sampled_profile_.set_process(
+      ToExecutionContextProcess(profile_params_.process));
+  sampled_profile_.set_thread(
+      ToExecutionContextThread(profile_params_.thread));
+  sampled_profile_.set_trigger_event(
+      ToSampledProfileTriggerEvent(profile_params_.trigger));
+  profile_start_time_ = base::TimeTicks::Now();
 }
 
 // static
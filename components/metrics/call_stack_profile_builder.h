@@ -72,6 +72,16 @@ class CallStackProfileBuilder : public base::ProfileBuilder {
 
   ~CallStackProfileBuilder() override;
 
+  // Makes the builder pass on a profile of the samples so far every
+  // |samples_per_profile| samples, in addition to when sampling completes.
+  // This is for profilers that sample continuously, with a large
+  // SamplingParams::samples_per_profile: each profile stays small, its
+  // stacks and modules are deduplicated within it, and the memory used by the
+  // builder stays bounded. |sampling_period| is recorded in each of these
+  // profiles, as it is only known to the builder when sampling completes.
+  void EnableContinuousProfiles(int samples_per_profile,
+                                base::TimeDelta sampling_period);
+
   // base::ProfileBuilder:
   base::ModuleCache* GetModuleCache() override;
   void RecordMetadata() override;
@@ -96,6 +106,11 @@ class CallStackProfileBuilder : public base::ProfileBuilder {
   virtual void PassProfilesToMetricsProvider(SampledProfile sampled_profile);
 
  private:
+  // Sets the durations of |sampled_profile_|, adds its modules and passes it
+  // on, then resets the builder for the next profile.
+  void FinishProfile(base::TimeDelta profile_duration,
+                     base::TimeDelta sampling_period);
+
   // The functor for Stack comparison.
   struct StackComparer {
     bool operator()(const CallStackProfile::Stack* stack1,
@@ -108,6 +123,7 @@ class CallStackProfileBuilder : public base::ProfileBuilder {
 
   unsigned int last_work_id_ = std::numeric_limits<unsigned int>::max();
   bool is_continued_work_ = false;
+  const CallStackProfileParams profile_params_;
   const WorkIdRecorder* const work_id_recorder_;
   const MetadataRecorder* const metadata_recorder_;
 
@@ -128,7 +144,12 @@ class CallStackProfileBuilder : public base::ProfileBuilder {
   base::OnceClosure completed_callback_;
 
   // The start time of a profile collection.
-  const base::TimeTicks profile_start_time_;
+  base::TimeTicks profile_start_time_;
+
+  // Set by EnableContinuousProfiles(). 0 if profiles are only passed on when
+  // sampling completes.
+  int continuous_samples_per_profile_ = 0;
+  base::TimeDelta continuous_sampling_period_;
 
   // Maps metadata hash to index in |metadata_name_hash| array.
   std::unordered_map<uint64_t, int> metadata_hashes_cache_;
@@ -58,6 +58,7 @@ class TestingCallStackProfileBuilder : public CallStackProfileBuilder {
   ~TestingCallStackProfileBuilder() override;
 
   const SampledProfile& test_sampled_profile() { return test_sampled_profile_; }
+  int profile_count() const { return profile_count_; }
 
  protected:
   // Overridden for testing.
@@ -66,6 +67,9 @@ class TestingCallStackProfileBuilder : public CallStackProfileBuilder {
  private:
   // The completed profile.
   SampledProfile test_sampled_profile_;
+
+  // The number of profiles passed to the metrics provider.
+  int profile_count_ = 0;
 };
 
 TestingCallStackProfileBuilder::TestingCallStackProfileBuilder(
@@ -83,6 +87,7 @@ TestingCallStackProfileBuilder::~TestingCallStackProfileBuilder() = default;
 void TestingCallStackProfileBuilder::PassProfilesToMetricsProvider(
     SampledProfile sampled_profile) {
   test_sampled_profile_ = std::move(sampled_profile);
+  ++profile_count_;
 }
 
 }  // namespace
@@ -173,6 +178,79 @@ TEST(CallStackProfileBuilderTest, ProfilingCompleted) {
   EXPECT_EQ(100, profile.sampling_period_ms());
 }
 
+TEST(CallStackProfileBuilderTest, ContinuousProfiles) {
+  base::MockCallback<base::OnceClosure> mock_closure;
+  EXPECT_CALL(mock_closure, Run()).Times(1);
+
+  auto profile_builder = std::make_unique<TestingCallStackProfileBuilder>(
+      kProfileParams, nullptr, nullptr, mock_closure.Get());
+  profile_builder->EnableContinuousProfiles(
+      2, base::TimeDelta::FromMilliseconds(100));
+
+#if defined(OS_WIN)
+  base::FilePath module_path(L"c:\\some\\path\\to\\chrome.exe");
+#else
+  base::FilePath module_path("/some/path/to/chrome");
+#endif
+
+  const uintptr_t module_base_address1 = 0x1000;
+  TestModule module1(module_base_address1, "1", module_path);
+  base::Frame frame1 = {module_base_address1 + 0x10, &module1};
+
+  const uintptr_t module_base_address2 = 0x1100;
+  TestModule module2(module_base_address2, "2", module_path);
+  base::Frame frame2 = {module_base_address2 + 0x10, &module2};
+
+  std::vector<base::Frame> frames1 = {frame1};
+  std::vector<base::Frame> frames2 = {frame2};
+
+  profile_builder->RecordMetadata();
+  profile_builder->OnSampleCompleted(frames1);
+  profile_builder->RecordMetadata();
+  profile_builder->OnSampleCompleted(frames1);
+  EXPECT_EQ(1, profile_builder->profile_count());
+  {
+    const SampledProfile& proto = profile_builder->test_sampled_profile();
+    EXPECT_EQ(BROWSER_PROCESS, proto.process());
+    EXPECT_EQ(MAIN_THREAD, proto.thread());
+    EXPECT_EQ(SampledProfile::PROCESS_STARTUP, proto.trigger_event());
+    const CallStackProfile& profile = proto.call_stack_profile();
+    EXPECT_EQ(1, profile.stack_size());
+    EXPECT_EQ(2, profile.stack_sample_size());
+    ASSERT_EQ(1, profile.module_id_size());
+    EXPECT_EQ("1", profile.module_id(0).build_id());
+    EXPECT_EQ(100, profile.sampling_period_ms());
+  }
+
+  // The next profile has its own stacks and modules.
+  profile_builder->RecordMetadata();
+  profile_builder->OnSampleCompleted(frames2);
+  profile_builder->RecordMetadata();
+  profile_builder->OnSampleCompleted(frames1);
+  EXPECT_EQ(2, profile_builder->profile_count());
+  {
+    const CallStackProfile& profile =
+        profile_builder->test_sampled_profile().call_stack_profile();
+    ASSERT_EQ(2, profile.stack_size());
+    ASSERT_EQ(2, profile.stack_sample_size());
+    EXPECT_EQ(0, profile.stack_sample(0).stack_index());
+    EXPECT_EQ(1, profile.stack_sample(1).stack_index());
+    ASSERT_EQ(2, profile.module_id_size());
+    EXPECT_EQ("2", profile.module_id(0).build_id());
+    EXPECT_EQ("1", profile.module_id(1).build_id());
+  }
+
+  // The samples left over when sampling completes make a last profile.
+  profile_builder->RecordMetadata();
+  profile_builder->OnSampleCompleted(frames2);
+  profile_builder->OnProfileCompleted(base::TimeDelta::FromMilliseconds(500),
+                                      base::TimeDelta::FromMilliseconds(100));
+  EXPECT_EQ(3, profile_builder->profile_count());
+  EXPECT_EQ(1, profile_builder->test_sampled_profile()
+                   .call_stack_profile()
+                   .stack_sample_size());
+}
+
 TEST(CallStackProfileBuilderTest, StacksDeduped) {
   auto profile_builder =
       std::make_unique<TestingCallStackProfileBuilder>(kProfileParams);
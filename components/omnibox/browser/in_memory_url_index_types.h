@@ -7,11 +7,13 @@
 
 #include <stddef.h>
 
+#include <algorithm>
 #include <map>
 #include <unordered_map>
 #include <vector>
 
 #include "base/containers/flat_set.h"
+#include "base/stl_util.h"
 #include "base/strings/string16.h"
 #include "components/history/core/browser/history_types.h"
 #include "url/gurl.h"
@@ -26,6 +28,35 @@ typedef std::vector<base::char16> Char16Vector;
 // A vector that contains the offsets at which each word starts within a string.
 typedef std::vector<size_t> WordStarts;
 
+// Removes from the sorted |items| every element not also present in the sorted
+// |other|. Rather than looking up each element with a binary search over all
+// of |other|, this gallops forward from the previous match, which costs
+// O(n log(m/n)) for n |items| and m elements of |other|; the index intersects
+// short posting lists with very long ones (e.g. those for 'h', 't', 'p').
+template <typename Container, typename OtherContainer>
+void IntersectSortedInPlace(Container* items, const OtherContainer& other) {
+  auto lower = other.begin();
+  const auto end = other.end();
+  base::EraseIf(*items, [&lower, end](
+                            const typename Container::value_type& item) {
+    // Double the stride until it passes |item|, then binary search the last
+    // stride.
+    auto upper = lower;
+    size_t stride = 1;
+    while (upper != end && *upper < item) {
+      lower = upper + 1;
+      upper = static_cast<size_t>(end - lower) > stride ? lower + stride : end;
+      stride *= 2;
+    }
+    lower = std::lower_bound(lower, upper, item);
+    if (lower != end && *lower == item) {
+      ++lower;
+      return false;
+    }
+    return true;
+  });
+}
+
 // Matches within URL and Title Strings ----------------------------------------
 
 // Specifies where an omnibox term occurs within a string. Used for specifying
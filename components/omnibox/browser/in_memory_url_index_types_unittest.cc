@@ -163,3 +163,21 @@ TEST_F(InMemoryURLIndexTypesTest, OffsetsAndTermMatches) {
   for (size_t i = 0; i < matches_b.size(); ++i)
     EXPECT_EQ(expected_offsets_b[i], matches_b[i].offset);
 }
+
+TEST_F(InMemoryURLIndexTypesTest, IntersectSortedInPlace) {
+  WordIDSet items = {1, 4, 5, 9, 20, 21, 40};
+  WordIDSet other;
+  for (WordID word_id = 0; word_id < 30; word_id += 2)
+    other.insert(word_id);
+  other.insert(5);
+  IntersectSortedInPlace(&items, other);
+  EXPECT_EQ(WordIDSet({4, 5, 20}), items);
+
+  HistoryIDVector history_ids = {3, 7};
+  IntersectSortedInPlace(&history_ids, HistoryIDSet());
+  EXPECT_TRUE(history_ids.empty());
+
+  history_ids = {0, 1, 2, 3};
+  IntersectSortedInPlace(&history_ids, HistoryIDSet({0, 1, 2, 3, 1000}));
+  EXPECT_EQ(HistoryIDVector({0, 1, 2, 3}), history_ids);
+}
@@ -526,7 +526,6 @@ HistoryIDVector URLIndexPrivateData::HistoryIDsFromWords(
   // to process so save them for last.
   std::sort(words.begin(), words.end(), LengthGreater);
 
-  // TODO(dyaroshev): write a generic algorithm(crbug.com/696167).
   for (auto iter = words.begin(); iter != words.end(); ++iter) {
     HistoryIDSet term_history_set = HistoryIDsForTerm(*iter);
     if (term_history_set.empty())
@@ -535,8 +534,7 @@ HistoryIDVector URLIndexPrivateData::HistoryIDsFromWords(
     if (iter == words.begin()) {
       history_ids = {term_history_set.begin(), term_history_set.end()};
     } else {
-      // set-intersection
-      base::EraseIf(history_ids, base::IsNotIn<HistoryIDSet>(term_history_set));
+      IntersectSortedInPlace(&history_ids, term_history_set);
     }
   }
   return history_ids;
@@ -572,17 +570,15 @@ HistoryIDSet URLIndexPrivateData::HistoryIDsForTerm(
   size_t term_length = term.length();
   WordIDSet word_id_set;
   if (term_length > 1) {
-    // See if this term or a prefix thereof is present in the cache.
-    base::string16 term_lower = base::i18n::ToLower(term);
+    // See if this term or a prefix thereof is present in the cache. Terms
+    // arrive lowercased, so probe the cache for each prefix from the longest
+    // down rather than scanning (and lowercasing) every cached term. Only
+    // terms longer than a single character are ever cached.
     auto best_prefix(search_term_cache_.end());
-    for (auto cache_iter = search_term_cache_.begin();
-         cache_iter != search_term_cache_.end(); ++cache_iter) {
-      if (base::StartsWith(term_lower,
-                           base::i18n::ToLower(cache_iter->first),
-                           base::CompareCase::SENSITIVE) &&
-          (best_prefix == search_term_cache_.end() ||
-           cache_iter->first.length() > best_prefix->first.length()))
-        best_prefix = cache_iter;
+    for (size_t prefix_length = term_length;
+         prefix_length > 1 && best_prefix == search_term_cache_.end();
+         --prefix_length) {
+      best_prefix = search_term_cache_.find(term.substr(0, prefix_length));
     }
 
     // If a prefix was found then determine the leftover characters to be used
@@ -627,8 +623,7 @@ HistoryIDSet URLIndexPrivateData::HistoryIDsForTerm(
       if (prefix_chars.empty()) {
         word_id_set = std::move(leftover_set);
       } else {
-        // set-intersection
-        base::EraseIf(word_id_set, base::IsNotIn<WordIDSet>(leftover_set));
+        IntersectSortedInPlace(&word_id_set, leftover_set);
       }
     }
 
@@ -667,8 +662,6 @@ HistoryIDSet URLIndexPrivateData::HistoryIDsForTerm(
 
 WordIDSet URLIndexPrivateData::WordIDSetForTermChars(
     const Char16Set& term_chars) {
-  // TODO(dyaroshev): write a generic algorithm(crbug.com/696167).
-
   WordIDSet word_id_set;
   for (auto c_iter = term_chars.begin(); c_iter != term_chars.end(); ++c_iter) {
     auto char_iter = char_word_map_.find(*c_iter);
@@ -685,8 +678,7 @@ WordIDSet URLIndexPrivateData::WordIDSetForTermChars(
     if (c_iter == term_chars.begin()) {
       word_id_set = char_word_id_set;
     } else {
-      // set-intersection
-      base::EraseIf(word_id_set, base::IsNotIn<WordIDSet>(char_word_id_set));
+      IntersectSortedInPlace(&word_id_set, char_word_id_set);
     }
   }
   return word_id_set;
@@ -14,6 +14,7 @@
 #include "base/callback.h"
 #include "base/files/file_path.h"
 #include "base/files/file_util.h"
+#include "base/files/memory_mapped_file.h"
 #include "base/json/json_file_value_serializer.h"
 #include "base/json/json_string_value_serializer.h"
 #include "base/macros.h"
@@ -27,6 +28,7 @@
 #include "base/time/default_clock.h"
 #include "base/values.h"
 #include "components/prefs/pref_filter.h"
+#include "components/prefs/pref_snapshot.h"
 
 // Result returned from internal read tasks.
 struct JsonPrefStore::ReadResult {
@@ -38,13 +40,21 @@ struct JsonPrefStore::ReadResult {
   PrefReadError error;
   bool no_dir;
 
+  // Set when |value| was read from an up to date snapshot.
+  bool journal_valid;
+  size_t journal_size;
+  size_t snapshot_size;
+
  private:
   DISALLOW_COPY_AND_ASSIGN(ReadResult);
 };
 
 JsonPrefStore::ReadResult::ReadResult()
-    : error(PersistentPrefStore::PREF_READ_ERROR_NONE), no_dir(false) {
-}
+    : error(PersistentPrefStore::PREF_READ_ERROR_NONE),
+      no_dir(false),
+      journal_valid(false),
+      journal_size(0),
+      snapshot_size(0) {}
 
 JsonPrefStore::ReadResult::~ReadResult() {
 }
@@ -53,6 +63,14 @@ namespace {
 
 // Some extensions we'll tack on to copies of the Preferences files.
 const base::FilePath::CharType kBadExtension[] = FILE_PATH_LITERAL("bad");
+const base::FilePath::CharType kSnapshotExtension[] =
+    FILE_PATH_LITERAL("snapshot");
+const base::FilePath::CharType kJournalExtension[] =
+    FILE_PATH_LITERAL("journal");
+
+// The journal is allowed to grow up to half the size of the snapshot, and at
+// least up to this size, before all the files are rewritten.
+const size_t kMinJournalSizeForRewrite = 64 * 1024;
 
 PersistentPrefStore::PrefReadError HandleReadErrors(
     const base::Value* value,
@@ -112,8 +130,48 @@ void RecordJsonDataSizeHistogram(const base::FilePath& path, size_t size) {
   histogram->Add(static_cast<int>(size) / 1024);
 }
 
-std::unique_ptr<JsonPrefStore::ReadResult> ReadPrefsFromDisk(
+// Returns the prefs from the snapshot and the journal next to the JSON file at
+// |path|, or null if there is no snapshot matching the JSON file.
+std::unique_ptr<JsonPrefStore::ReadResult> ReadPrefsFromSnapshot(
     const base::FilePath& path) {
+  base::File::Info json_info;
+  base::MemoryMappedFile snapshot;
+  if (!base::GetFileInfo(path, &json_info) ||
+      !snapshot.Initialize(path.AddExtension(kSnapshotExtension))) {
+    return nullptr;
+  }
+  std::unique_ptr<base::DictionaryValue> prefs = pref_snapshot::ReadSnapshot(
+      base::StringPiece(reinterpret_cast<const char*>(snapshot.data()),
+                        snapshot.length()),
+      json_info);
+  if (!prefs)
+    return nullptr;
+
+  // A missing journal is the same as an empty one.
+  std::string journal;
+  base::ReadFileToString(path.AddExtension(kJournalExtension), &journal);
+
+  std::unique_ptr<JsonPrefStore::ReadResult> read_result(
+      new JsonPrefStore::ReadResult);
+  read_result->journal_size = pref_snapshot::ApplyJournal(journal, prefs.get());
+  // Records past a corrupt one are lost, so the files have to be rewritten
+  // before appending new records.
+  read_result->journal_valid = read_result->journal_size == journal.size();
+  read_result->snapshot_size = snapshot.length();
+  read_result->value = std::move(prefs);
+  return read_result;
+}
+
+std::unique_ptr<JsonPrefStore::ReadResult> ReadPrefsFromDisk(
+    const base::FilePath& path,
+    bool use_binary_snapshot) {
+  if (use_binary_snapshot) {
+    std::unique_ptr<JsonPrefStore::ReadResult> read_result =
+        ReadPrefsFromSnapshot(path);
+    if (read_result)
+      return read_result;
+  }
+
   int error_code;
   std::string error_msg;
   std::unique_ptr<JsonPrefStore::ReadResult> read_result(
@@ -130,6 +188,33 @@ std::unique_ptr<JsonPrefStore::ReadResult> ReadPrefsFromDisk(
   return read_result;
 }
 
+bool AppendToJournal(const base::FilePath& path, const std::string& records) {
+  base::File journal(path.AddExtension(kJournalExtension),
+                     base::File::FLAG_OPEN_ALWAYS | base::File::FLAG_APPEND);
+  return journal.IsValid() &&
+         journal.WriteAtCurrentPos(records.data(), records.size()) ==
+             static_cast<int>(records.size());
+}
+
+// Writes the JSON file at |path| and the snapshot next to it, and deletes the
+// journal which doesn't apply to the new snapshot.
+bool WriteJsonAndSnapshot(const base::FilePath& path,
+                          const std::string& json,
+                          const std::string& snapshot_contents) {
+  base::File::Info json_info;
+  if (!base::ImportantFileWriter::WriteFileAtomically(path, json) ||
+      !base::GetFileInfo(path, &json_info)) {
+    return false;
+  }
+  // The old snapshot no longer matches the JSON file, so a crash past this
+  // point leaves files that are read as the new JSON file alone.
+  if (!base::DeleteFile(path.AddExtension(kJournalExtension), false))
+    return false;
+  return base::ImportantFileWriter::WriteFileAtomically(
+      path.AddExtension(kSnapshotExtension),
+      pref_snapshot::MakeSnapshot(json_info, snapshot_contents));
+}
+
 }  // namespace
 
 JsonPrefStore::JsonPrefStore(
@@ -222,6 +307,7 @@ void JsonPrefStore::SetValueSilently(const std::string& key,
   prefs_->Get(key, &old_value);
   if (!old_value || !value->Equals(old_value)) {
     prefs_->Set(key, std::move(value));
+    MarkDirty(key);
     ScheduleWrite(flags);
   }
 }
@@ -238,6 +324,7 @@ void JsonPrefStore::RemoveValueSilently(const std::string& key,
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
 
   prefs_->RemovePath(key, nullptr);
+  MarkDirty(key);
   ScheduleWrite(flags);
 }
 
@@ -256,7 +343,7 @@ PersistentPrefStore::PrefReadError JsonPrefStore::GetReadError() const {
 PersistentPrefStore::PrefReadError JsonPrefStore::ReadPrefs() {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
 
-  OnFileRead(ReadPrefsFromDisk(path_));
+  OnFileRead(ReadPrefsFromDisk(path_, UseBinarySnapshot()));
   return filtering_in_progress_ ? PREF_READ_ERROR_ASYNCHRONOUS_TASK_INCOMPLETE
                                 : read_error_;
 }
@@ -269,7 +356,8 @@ void JsonPrefStore::ReadPrefsAsync(ReadErrorDelegate* error_delegate) {
 
   // Weakly binds the read task so that it doesn't kick in during shutdown.
   base::PostTaskAndReplyWithResult(
-      file_task_runner_.get(), FROM_HERE, base::Bind(&ReadPrefsFromDisk, path_),
+      file_task_runner_.get(), FROM_HERE,
+      base::Bind(&ReadPrefsFromDisk, path_, UseBinarySnapshot()),
       base::Bind(&JsonPrefStore::OnFileRead, AsWeakPtr()));
 }
 
@@ -282,6 +370,11 @@ void JsonPrefStore::CommitPendingWrite(
   // they get flushed when this function is called.
   SchedulePendingLossyWrites();
 
+  if (journal_timer_.IsRunning() && !read_only_) {
+    journal_timer_.Stop();
+    WriteJournal();
+  }
+
   if (writer_.HasPendingWrite() && !read_only_)
     writer_.DoScheduledWrite();
 
@@ -302,7 +395,11 @@ void JsonPrefStore::CommitPendingWrite(
 }
 
 void JsonPrefStore::SchedulePendingLossyWrites() {
-  if (pending_lossy_write_)
+  if (!pending_lossy_write_)
+    return;
+  if (UseBinarySnapshot())
+    ScheduleWrite(DEFAULT_PREF_WRITE_FLAGS);
+  else
     writer_.ScheduleWrite(this);
 }
 
@@ -315,6 +412,7 @@ void JsonPrefStore::ReportValueChanged(const std::string& key, uint32_t flags) {
   for (PrefStore::Observer& observer : observers_)
     observer.OnPrefValueChanged(key);
 
+  MarkDirty(key);
   ScheduleWrite(flags);
 }
 
@@ -361,6 +459,10 @@ void JsonPrefStore::RegisterOnNextSuccessfulWriteReply(
   // an empty callback.
   if (!has_pending_write_reply_) {
     has_pending_write_reply_ = true;
+    // Journal writes report to RunOrScheduleNextSuccessfulWriteCallback()
+    // directly.
+    if (UseBinarySnapshot())
+      return;
     writer_.RegisterOnNextWriteCallbacks(
         base::Closure(),
         base::Bind(
@@ -395,6 +497,13 @@ void JsonPrefStore::OnStoreDeletionFromDisk() {
     pref_filter_->OnStoreDeletionFromDisk();
 }
 
+void JsonPrefStore::EnableBinarySnapshot() {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  DCHECK(!initialized_);
+
+  use_binary_snapshot_ = true;
+}
+
 void JsonPrefStore::OnFileRead(std::unique_ptr<ReadResult> read_result) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
 
@@ -404,6 +513,9 @@ void JsonPrefStore::OnFileRead(std::unique_ptr<ReadResult> read_result) {
       new base::DictionaryValue);
 
   read_error_ = read_result->error;
+  journal_valid_ = read_result->journal_valid;
+  journal_size_ = read_result->journal_size;
+  snapshot_size_ = read_result->snapshot_size;
 
   bool initialization_successful = !read_result->no_dir;
 
@@ -496,7 +608,8 @@ void JsonPrefStore::FinalizeFileRead(
 
   initialized_ = true;
 
-  if (schedule_write)
+  // Without a valid snapshot, write one so that the next read is faster.
+  if (schedule_write || (UseBinarySnapshot() && !journal_valid_))
     ScheduleWrite(DEFAULT_PREF_WRITE_FLAGS);
 
   if (error_delegate_ && read_error_ != PREF_READ_ERROR_NONE)
@@ -512,8 +625,76 @@ void JsonPrefStore::ScheduleWrite(uint32_t flags) {
   if (read_only_)
     return;
 
-  if (flags & LOSSY_PREF_WRITE_FLAG)
+  if (flags & LOSSY_PREF_WRITE_FLAG) {
     pending_lossy_write_ = true;
-  else
+  } else if (UseBinarySnapshot()) {
+    if (!journal_timer_.IsRunning()) {
+      journal_timer_.Start(FROM_HERE, writer_.commit_interval(), this,
+                           &JsonPrefStore::WriteJournal);
+    }
+  } else {
     writer_.ScheduleWrite(this);
+  }
+}
+
+bool JsonPrefStore::UseBinarySnapshot() const {
+  return use_binary_snapshot_ && !pref_filter_;
+}
+
+void JsonPrefStore::MarkDirty(const std::string& key) {
+  if (UseBinarySnapshot())
+    dirty_keys_.insert(key);
+}
+
+void JsonPrefStore::WriteJournal() {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  DCHECK(UseBinarySnapshot());
+
+  pending_lossy_write_ = false;
+
+  std::string records;
+  for (const std::string& key : dirty_keys_) {
+    const base::Value* value = nullptr;
+    prefs_->Get(key, &value);
+    pref_snapshot::AppendJournalRecord(key, value, &records);
+  }
+  dirty_keys_.clear();
+
+  if (journal_valid_ &&
+      journal_size_ + records.size() <=
+          std::max(kMinJournalSizeForRewrite, snapshot_size_ / 2)) {
+    journal_size_ += records.size();
+    base::PostTaskAndReplyWithResult(
+        file_task_runner_.get(), FROM_HERE,
+        base::BindOnce(&AppendToJournal, path_, std::move(records)),
+        base::BindOnce(&JsonPrefStore::OnJournalWritten, AsWeakPtr()));
+    return;
+  }
+
+  std::string json;
+  JSONStringValueSerializer serializer(&json);
+  serializer.set_pretty_print(false);
+  bool success = serializer.Serialize(*prefs_);
+  DCHECK(success);
+  std::string snapshot_contents = pref_snapshot::SerializeContents(*prefs_);
+
+  journal_valid_ = true;
+  journal_size_ = 0;
+  snapshot_size_ = snapshot_contents.size();
+  base::PostTaskAndReplyWithResult(
+      file_task_runner_.get(), FROM_HERE,
+      base::BindOnce(&WriteJsonAndSnapshot, path_, std::move(json),
+                     std::move(snapshot_contents)),
+      base::BindOnce(&JsonPrefStore::OnJournalWritten, AsWeakPtr()));
+}
+
+void JsonPrefStore::OnJournalWritten(bool success) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+
+  // The files on disk may be partially written, so rewrite them all next time.
+  if (!success)
+    journal_valid_ = false;
+
+  if (has_pending_write_reply_)
+    RunOrScheduleNextSuccessfulWriteCallback(success);
 }
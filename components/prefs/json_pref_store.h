@@ -21,6 +21,7 @@
 #include "base/observer_list.h"
 #include "base/sequence_checker.h"
 #include "base/task/post_task.h"
+#include "base/timer/timer.h"
 #include "components/prefs/persistent_pref_store.h"
 #include "components/prefs/pref_filter.h"
 #include "components/prefs/prefs_export.h"
@@ -118,6 +119,14 @@ class COMPONENTS_PREFS_EXPORT JsonPrefStore
 
   void OnStoreDeletionFromDisk() override;
 
+  // Makes this store load its prefs from a binary snapshot next to the JSON
+  // file when the snapshot is up to date, and persist changes by appending the
+  // changed prefs to a journal instead of rewriting the whole file. The JSON
+  // file and the snapshot are rewritten together once the journal grows
+  // large. Must be called before reading prefs. Ignored if this store has a
+  // PrefFilter, since filters can change prefs while they are serialized.
+  void EnableBinarySnapshot();
+
  private:
   friend class base::JsonPrefStoreCallbackTest;
   friend class base::JsonPrefStoreLossyWriteTest;
@@ -169,6 +178,20 @@ class COMPONENTS_PREFS_EXPORT JsonPrefStore
   // WriteablePrefStore::LOSSY_PREF_WRITE_FLAG.
   void ScheduleWrite(uint32_t flags);
 
+  // Returns whether prefs are persisted through a snapshot and a journal. See
+  // EnableBinarySnapshot().
+  bool UseBinarySnapshot() const;
+
+  // Records that the pref at |key| needs to be written to the journal.
+  void MarkDirty(const std::string& key);
+
+  // Appends the prefs changed since the last write to the journal, or rewrites
+  // the JSON file and the snapshot if the journal is too large or out of sync.
+  void WriteJournal();
+
+  // Called on the main sequence after WriteJournal() is done with the files.
+  void OnJournalWritten(bool success);
+
   const base::FilePath path_;
   const scoped_refptr<base::SequencedTaskRunner> file_task_runner_;
 
@@ -194,6 +217,20 @@ class COMPONENTS_PREFS_EXPORT JsonPrefStore
   bool has_pending_write_reply_ = true;
   base::Closure on_next_successful_write_reply_;
 
+  bool use_binary_snapshot_ = false;
+
+  // Paths of the prefs changed since the last journal write.
+  std::set<std::string> dirty_keys_;
+
+  // Whether the journal on disk applies to the snapshot on disk, so that new
+  // records can be appended to it.
+  bool journal_valid_ = false;
+  size_t journal_size_ = 0;
+  size_t snapshot_size_ = 0;
+
+  // Delays journal writes, like |writer_| does for JSON writes.
+  base::OneShotTimer journal_timer_;
+
   SEQUENCE_CHECKER(sequence_checker_);
 
   DISALLOW_COPY_AND_ASSIGN(JsonPrefStore);
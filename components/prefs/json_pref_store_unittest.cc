@@ -415,6 +415,57 @@ TEST_P(JsonPrefStoreTest, RemoveClearsEmptyParent) {
   EXPECT_FALSE(has_dict);
 }
 
+// Tests that prefs persisted through a binary snapshot and a journal are read
+// back, and that a snapshot that doesn't match the JSON file is ignored.
+TEST_P(JsonPrefStoreTest, BinarySnapshot) {
+  FilePath pref_file = temp_dir_.GetPath().AppendASCII("snapshot.json");
+  FilePath snapshot_file =
+      pref_file.AddExtension(FILE_PATH_LITERAL("snapshot"));
+  FilePath journal_file = pref_file.AddExtension(FILE_PATH_LITERAL("journal"));
+  ASSERT_LT(0,
+            base::WriteFile(pref_file, kReadJson, base::size(kReadJson) - 1));
+
+  auto pref_store = base::MakeRefCounted<JsonPrefStore>(pref_file);
+  pref_store->EnableBinarySnapshot();
+  ASSERT_EQ(PersistentPrefStore::PREF_READ_ERROR_NONE, pref_store->ReadPrefs());
+
+  // Reading from JSON schedules writing a snapshot.
+  CommitPendingWrite(pref_store.get(), GetParam(), &scoped_task_environment_);
+  EXPECT_TRUE(PathExists(snapshot_file));
+  EXPECT_FALSE(PathExists(journal_file));
+
+  // Later changes are only written to the journal.
+  pref_store->SetValue(kHomePage,
+                       std::make_unique<Value>("http://www.example.com"),
+                       WriteablePrefStore::DEFAULT_PREF_WRITE_FLAGS);
+  pref_store->RemoveValue("tabs.max_tabs",
+                          WriteablePrefStore::DEFAULT_PREF_WRITE_FLAGS);
+  CommitPendingWrite(pref_store.get(), GetParam(), &scoped_task_environment_);
+  EXPECT_TRUE(PathExists(journal_file));
+  std::string json;
+  ASSERT_TRUE(ReadFileToString(pref_file, &json));
+  EXPECT_NE(std::string::npos, json.find("http://www.cnn.com"));
+
+  pref_store = base::MakeRefCounted<JsonPrefStore>(pref_file);
+  pref_store->EnableBinarySnapshot();
+  ASSERT_EQ(PersistentPrefStore::PREF_READ_ERROR_NONE, pref_store->ReadPrefs());
+  const Value* result = nullptr;
+  ASSERT_TRUE(pref_store->GetValue(kHomePage, &result));
+  EXPECT_EQ("http://www.example.com", result->GetString());
+  EXPECT_FALSE(pref_store->GetValue("tabs.max_tabs", nullptr));
+  EXPECT_TRUE(pref_store->GetValue("tabs.new_windows_in_tabs", nullptr));
+
+  // The JSON file wins if it was written without the snapshot.
+  ASSERT_LT(0,
+            base::WriteFile(pref_file, kReadJson, base::size(kReadJson) - 1));
+  pref_store = base::MakeRefCounted<JsonPrefStore>(pref_file);
+  pref_store->EnableBinarySnapshot();
+  ASSERT_EQ(PersistentPrefStore::PREF_READ_ERROR_NONE, pref_store->ReadPrefs());
+  ASSERT_TRUE(pref_store->GetValue(kHomePage, &result));
+  EXPECT_EQ("http://www.cnn.com", result->GetString());
+  EXPECT_TRUE(pref_store->GetValue("tabs.max_tabs", nullptr));
+}
+
 // Tests asynchronous reading of the file when there is no file.
 TEST_P(JsonPrefStoreTest, AsyncNonExistingFile) {
   base::FilePath bogus_input_file = temp_dir_.GetPath().AppendASCII("read.txt");
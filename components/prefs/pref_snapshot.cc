@@ -0,0 +1,245 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "components/prefs/pref_snapshot.h"
+
+#include <stdint.h>
+#include <string.h>
+
+#include <utility>
+
+#include "base/numerics/checked_math.h"
+#include "base/pickle.h"
+#include "base/values.h"
+
+namespace pref_snapshot {
+
+namespace {
+
+const uint32_t kSnapshotMagic = 0x50524546;  // "PREF"
+const int kSnapshotVersion = 1;
+
+// Deeper values can only come from corrupt data, since JSON parsing is limited
+// to the same depth.
+const int kMaxDepth = 200;
+
+std::string PickleToString(const base::Pickle& pickle) {
+  return std::string(static_cast<const char*>(pickle.data()), pickle.size());
+}
+
+// Returns the size of the pickle at the start of |data|, or 0 if |data|
+// doesn't start with a complete pickle.
+size_t PeekPickleSize(base::StringPiece data) {
+  base::Pickle::Header header;
+  if (data.size() < sizeof(header))
+    return 0;
+  memcpy(&header, data.data(), sizeof(header));
+  size_t size = 0;
+  if (!base::CheckAdd(sizeof(header), header.payload_size).AssignIfValid(&size))
+    return 0;
+  return size <= data.size() ? size : 0;
+}
+
+void WriteValue(const base::Value& value, base::Pickle* pickle) {
+  pickle->WriteInt(static_cast<int>(value.type()));
+  switch (value.type()) {
+    case base::Value::Type::NONE:
+      break;
+    case base::Value::Type::BOOLEAN:
+      pickle->WriteBool(value.GetBool());
+      break;
+    case base::Value::Type::INTEGER:
+      pickle->WriteInt(value.GetInt());
+      break;
+    case base::Value::Type::DOUBLE:
+      pickle->WriteDouble(value.GetDouble());
+      break;
+    case base::Value::Type::STRING:
+      pickle->WriteString(value.GetString());
+      break;
+    case base::Value::Type::BINARY:
+      pickle->WriteData(reinterpret_cast<const char*>(value.GetBlob().data()),
+                        static_cast<int>(value.GetBlob().size()));
+      break;
+    case base::Value::Type::DICTIONARY:
+      pickle->WriteInt(static_cast<int>(value.DictSize()));
+      for (const auto& item : value.DictItems()) {
+        pickle->WriteString(item.first);
+        WriteValue(item.second, pickle);
+      }
+      break;
+    case base::Value::Type::LIST:
+      pickle->WriteInt(static_cast<int>(value.GetList().size()));
+      for (const base::Value& item : value.GetList())
+        WriteValue(item, pickle);
+      break;
+  }
+}
+
+bool ReadValue(base::PickleIterator* iter, int depth, base::Value* value) {
+  if (depth > kMaxDepth)
+    return false;
+
+  int type;
+  if (!iter->ReadInt(&type))
+    return false;
+  switch (static_cast<base::Value::Type>(type)) {
+    case base::Value::Type::NONE:
+      *value = base::Value();
+      return true;
+    case base::Value::Type::BOOLEAN: {
+      bool result;
+      if (!iter->ReadBool(&result))
+        return false;
+      *value = base::Value(result);
+      return true;
+    }
+    case base::Value::Type::INTEGER: {
+      int result;
+      if (!iter->ReadInt(&result))
+        return false;
+      *value = base::Value(result);
+      return true;
+    }
+    case base::Value::Type::DOUBLE: {
+      double result;
+      if (!iter->ReadDouble(&result))
+        return false;
+      *value = base::Value(result);
+      return true;
+    }
+    case base::Value::Type::STRING: {
+      std::string result;
+      if (!iter->ReadString(&result))
+        return false;
+      *value = base::Value(std::move(result));
+      return true;
+    }
+    case base::Value::Type::BINARY: {
+      const char* data;
+      int length;
+      if (!iter->ReadData(&data, &length))
+        return false;
+      *value = base::Value(base::Value::BlobStorage(data, data + length));
+      return true;
+    }
+    case base::Value::Type::DICTIONARY: {
+      int size;
+      if (!iter->ReadInt(&size) || size < 0)
+        return false;
+      *value = base::Value(base::Value::Type::DICTIONARY);
+      for (int i = 0; i < size; ++i) {
+        std::string key;
+        base::Value item;
+        if (!iter->ReadString(&key) || !ReadValue(iter, depth + 1, &item))
+          return false;
+        value->SetKey(std::move(key), std::move(item));
+      }
+      return true;
+    }
+    case base::Value::Type::LIST: {
+      int size;
+      if (!iter->ReadInt(&size) || size < 0)
+        return false;
+      base::Value::ListStorage list;
+      for (int i = 0; i < size; ++i) {
+        list.emplace_back();
+        if (!ReadValue(iter, depth + 1, &list.back()))
+          return false;
+      }
+      *value = base::Value(std::move(list));
+      return true;
+    }
+  }
+  return false;
+}
+
+}  // namespace
+
+std::string SerializeContents(const base::DictionaryValue& prefs) {
+  base::Pickle pickle;
+  WriteValue(prefs, &pickle);
+  return PickleToString(pickle);
+}
+
+std::string MakeSnapshot(const base::File::Info& json_info,
+                         base::StringPiece contents) {
+  base::Pickle header;
+  header.WriteUInt32(kSnapshotMagic);
+  header.WriteInt(kSnapshotVersion);
+  header.WriteInt64(json_info.size);
+  header.WriteInt64(
+      json_info.last_modified.ToDeltaSinceWindowsEpoch().InMicroseconds());
+
+  std::string snapshot = PickleToString(header);
+  contents.AppendToString(&snapshot);
+  return snapshot;
+}
+
+std::unique_ptr<base::DictionaryValue> ReadSnapshot(
+    base::StringPiece snapshot,
+    const base::File::Info& json_info) {
+  size_t header_size = PeekPickleSize(snapshot);
+  if (!header_size)
+    return nullptr;
+  base::Pickle header(snapshot.data(), header_size);
+  base::PickleIterator header_iter(header);
+  uint32_t magic;
+  int version;
+  int64_t json_size;
+  int64_t json_last_modified;
+  if (!header_iter.ReadUInt32(&magic) || magic != kSnapshotMagic ||
+      !header_iter.ReadInt(&version) || version != kSnapshotVersion ||
+      !header_iter.ReadInt64(&json_size) || json_size != json_info.size ||
+      !header_iter.ReadInt64(&json_last_modified) ||
+      json_last_modified != json_info.last_modified.ToDeltaSinceWindowsEpoch()
+                                .InMicroseconds()) {
+    return nullptr;
+  }
+
+  base::StringPiece contents = snapshot.substr(header_size);
+  if (PeekPickleSize(contents) != contents.size())
+    return nullptr;
+  base::Pickle pickle(contents.data(), contents.size());
+  base::PickleIterator iter(pickle);
+  auto value = std::make_unique<base::Value>();
+  if (!ReadValue(&iter, 0, value.get()))
+    return nullptr;
+  return base::DictionaryValue::From(std::move(value));
+}
+
+void AppendJournalRecord(base::StringPiece path,
+                         const base::Value* value,
+                         std::string* journal) {
+  base::Pickle record;
+  record.WriteString(path);
+  record.WriteBool(value != nullptr);
+  if (value)
+    WriteValue(*value, &record);
+  journal->append(static_cast<const char*>(record.data()), record.size());
+}
+
+size_t ApplyJournal(base::StringPiece journal, base::DictionaryValue* prefs) {
+  size_t applied_size = 0;
+  while (size_t record_size = PeekPickleSize(journal.substr(applied_size))) {
+    base::Pickle record(journal.data() + applied_size, record_size);
+    base::PickleIterator iter(record);
+    std::string path;
+    bool has_value;
+    if (!iter.ReadString(&path) || !iter.ReadBool(&has_value))
+      break;
+    if (has_value) {
+      auto value = std::make_unique<base::Value>();
+      if (!ReadValue(&iter, 0, value.get()))
+        break;
+      prefs->Set(path, std::move(value));
+    } else {
+      prefs->RemovePath(path, nullptr);
+    }
+    applied_size += record_size;
+  }
+  return applied_size;
+}
+
+}  // namespace pref_snapshot
@@ -0,0 +1,64 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef COMPONENTS_PREFS_PREF_SNAPSHOT_H_
+#define COMPONENTS_PREFS_PREF_SNAPSHOT_H_
+
+#include <stddef.h>
+
+#include <memory>
+#include <string>
+
+#include "base/files/file.h"
+#include "base/strings/string_piece.h"
+#include "components/prefs/prefs_export.h"
+
+namespace base {
+class DictionaryValue;
+class Value;
+}
+
+// Binary formats used by JsonPrefStore to load prefs without parsing JSON,
+// and to persist changes without rewriting all the prefs.
+//
+// A snapshot holds a whole pref dictionary, along with the size and last
+// modification time of the JSON file written at the same time. A snapshot that
+// doesn't match the JSON file, e.g. because the file was written by a version
+// that doesn't know about snapshots, is ignored.
+//
+// A journal is a sequence of records, each setting or removing the value at a
+// pref path. Records are appended on commits and applied in order on top of the
+// snapshot when loading.
+namespace pref_snapshot {
+
+// Returns the serialized |prefs|, to be passed to MakeSnapshot().
+COMPONENTS_PREFS_EXPORT std::string SerializeContents(
+    const base::DictionaryValue& prefs);
+
+// Returns a snapshot of |contents| matching the JSON file described by
+// |json_info|.
+COMPONENTS_PREFS_EXPORT std::string MakeSnapshot(
+    const base::File::Info& json_info,
+    base::StringPiece contents);
+
+// Returns the prefs held by |snapshot|, or null if it is corrupt or doesn't
+// match |json_info|.
+COMPONENTS_PREFS_EXPORT std::unique_ptr<base::DictionaryValue> ReadSnapshot(
+    base::StringPiece snapshot,
+    const base::File::Info& json_info);
+
+// Appends to |journal| a record setting the pref at |path| to |value|, or
+// removing it if |value| is null.
+COMPONENTS_PREFS_EXPORT void AppendJournalRecord(base::StringPiece path,
+                                                 const base::Value* value,
+                                                 std::string* journal);
+
+// Applies the records of |journal| to |prefs| in order, stopping at the first
+// incomplete or corrupt record. Returns the size of the applied records.
+COMPONENTS_PREFS_EXPORT size_t ApplyJournal(base::StringPiece journal,
+                                            base::DictionaryValue* prefs);
+
+}  // namespace pref_snapshot
+
+#endif  // COMPONENTS_PREFS_PREF_SNAPSHOT_H_
@@ -0,0 +1,103 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "components/prefs/pref_snapshot.h"
+
+#include <stdint.h>
+
+#include <memory>
+#include <string>
+
+#include "base/time/time.h"
+#include "base/values.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace pref_snapshot {
+
+namespace {
+
+base::File::Info MakeJsonInfo(int64_t size) {
+  base::File::Info info;
+  info.size = size;
+  info.last_modified = base::Time::FromDoubleT(1500000000);
+  return info;
+}
+
+std::unique_ptr<base::DictionaryValue> MakePrefs() {
+  auto prefs = std::make_unique<base::DictionaryValue>();
+  prefs->SetString("homepage", "http://www.example.com");
+  prefs->SetBoolean("tabs.new_windows_in_tabs", true);
+  prefs->SetInteger("tabs.max_tabs", 20);
+  prefs->SetDouble("zoom", 1.5);
+  prefs->SetKey("key.with.dots", base::Value("value"));
+  prefs->Set("none", std::make_unique<base::Value>());
+  prefs->Set("blob", std::make_unique<base::Value>(
+                         base::Value::BlobStorage({1, 2, 3})));
+  auto list = std::make_unique<base::ListValue>();
+  list->AppendString("a");
+  list->Append(std::make_unique<base::DictionaryValue>());
+  prefs->Set("list", std::move(list));
+  return prefs;
+}
+
+}  // namespace
+
+TEST(PrefSnapshotTest, RoundTrip) {
+  std::unique_ptr<base::DictionaryValue> prefs = MakePrefs();
+  std::string snapshot =
+      MakeSnapshot(MakeJsonInfo(123), SerializeContents(*prefs));
+
+  std::unique_ptr<base::DictionaryValue> result =
+      ReadSnapshot(snapshot, MakeJsonInfo(123));
+  ASSERT_TRUE(result);
+  EXPECT_EQ(*prefs, *result);
+
+  // Snapshots only apply to the JSON file they were written with.
+  EXPECT_FALSE(ReadSnapshot(snapshot, MakeJsonInfo(124)));
+  base::File::Info newer_json_info = MakeJsonInfo(123);
+  newer_json_info.last_modified += base::TimeDelta::FromSeconds(1);
+  EXPECT_FALSE(ReadSnapshot(snapshot, newer_json_info));
+
+  EXPECT_FALSE(ReadSnapshot(snapshot.substr(0, snapshot.size() - 4),
+                            MakeJsonInfo(123)));
+  EXPECT_FALSE(ReadSnapshot(std::string(), MakeJsonInfo(123)));
+}
+
+TEST(PrefSnapshotTest, Journal) {
+  std::string journal;
+  base::Value homepage("http://www.chromium.org");
+  AppendJournalRecord("homepage", &homepage, &journal);
+  AppendJournalRecord("tabs.max_tabs", nullptr, &journal);
+  base::Value new_pref(true);
+  AppendJournalRecord("new.pref", &new_pref, &journal);
+
+  std::unique_ptr<base::DictionaryValue> prefs = MakePrefs();
+  EXPECT_EQ(journal.size(), ApplyJournal(journal, prefs.get()));
+
+  std::unique_ptr<base::DictionaryValue> expected = MakePrefs();
+  expected->SetString("homepage", "http://www.chromium.org");
+  expected->Remove("tabs.max_tabs", nullptr);
+  expected->SetBoolean("new.pref", true);
+  EXPECT_EQ(*expected, *prefs);
+}
+
+TEST(PrefSnapshotTest, TruncatedJournal) {
+  std::string journal;
+  base::Value first(1);
+  AppendJournalRecord("first", &first, &journal);
+  size_t first_record_size = journal.size();
+  base::Value second(2);
+  AppendJournalRecord("second", &second, &journal);
+
+  // Records that were not completely written are ignored.
+  base::DictionaryValue prefs;
+  EXPECT_EQ(first_record_size,
+            ApplyJournal(base::StringPiece(journal).substr(
+                             0, journal.size() - 1),
+                         &prefs));
+  EXPECT_TRUE(prefs.HasKey("first"));
+  EXPECT_FALSE(prefs.HasKey("second"));
+}
+
+}  // namespace pref_snapshot
@@ -9,14 +9,18 @@
 
 #include "base/base64.h"
 #include "base/bind.h"
+#include "base/feature_list.h"
 #include "base/files/file_util.h"
 #include "base/metrics/histogram_functions.h"
 #include "base/metrics/histogram_macros.h"
+#include "base/rand_util.h"
 #include "base/stl_util.h"
+#include "base/strings/string_number_conversions.h"
 #include "base/strings/stringprintf.h"
 #include "components/safe_browsing/db/prefix_iterator.h"
 #include "components/safe_browsing/db/v4_rice.h"
 #include "components/safe_browsing/db/v4_store.pb.h"
+#include "components/safe_browsing/features.h"
 #include "components/safe_browsing/proto/webui.pb.h"
 #include "crypto/secure_hash.h"
 #include "crypto/sha2.h"
@@ -180,6 +184,28 @@ const base::FilePath TemporaryFileForFilename(const base::FilePath& filename) {
   return base::FilePath(filename.value() + FILE_PATH_LITERAL("_new"));
 }
 
+// Returns the path of the hash file with |extension| for the store file at
+// |store_path|.
+base::FilePath HashFilePath(const base::FilePath& store_path,
+                            const std::string& extension) {
+  return store_path.AddExtensionASCII(extension);
+}
+
+// Deletes the hash files in |file_format|, which the store file on disk
+// doesn't refer to.
+void DeleteUnusedHashFiles(const base::FilePath& store_path,
+                           const V4StoreFileFormat& file_format) {
+  for (const HashFile& hash_file : file_format.hash_files()) {
+    base::DeleteFile(HashFilePath(store_path, hash_file.extension()),
+                     /*recursive=*/false);
+  }
+}
+
+base::StringPiece GetMappedHashPrefixes(const base::MemoryMappedFile& file) {
+  return base::StringPiece(reinterpret_cast<const char*>(file.data()),
+                           file.length());
+}
+
 }  // namespace
 
 using ::google::protobuf::RepeatedField;
@@ -224,6 +250,8 @@ V4Store::V4Store(const scoped_refptr<base::SequencedTaskRunner>& task_runner,
 
 V4Store::~V4Store() {
   DCHECK(task_runner_->RunsTasksInCurrentSequence());
+  if (hash_files_superseded_)
+    DeleteHashFiles();
 }
 
 std::string V4Store::DebugString() const {
@@ -245,12 +273,13 @@ void V4Store::Destroy(std::unique_ptr<V4Store> v4_store) {
 void V4Store::Reset() {
   expected_checksum_.clear();
   hash_prefix_map_.clear();
+  mapped_hash_files_.clear();
   state_ = "";
 }
 
 ApplyUpdateResult V4Store::ProcessPartialUpdateAndWriteToDisk(
     const std::string& metric,
-    const HashPrefixMap& hash_prefix_map_old,
+    const HashPrefixMapView& hash_prefix_map_old,
     std::unique_ptr<ListUpdateResponse> response) {
   DCHECK(response->has_response_type());
   DCHECK_EQ(ListUpdateResponse::PARTIAL_UPDATE, response->response_type());
@@ -289,12 +318,13 @@ ApplyUpdateResult V4Store::ProcessFullUpdate(
   // checksum. It might save some CPU cycles to store the full update as-is and
   // walk the list of hash prefixes in lexographical order only for checksum
   // calculation.
-  return ProcessUpdate(metric, HashPrefixMap(), response, delay_checksum_check);
+  return ProcessUpdate(metric, HashPrefixMapView(), response,
+                       delay_checksum_check);
 }
 
 ApplyUpdateResult V4Store::ProcessUpdate(
     const std::string& metric,
-    const HashPrefixMap& hash_prefix_map_old,
+    const HashPrefixMapView& hash_prefix_map_old,
     const std::unique_ptr<ListUpdateResponse>& response,
     bool delay_checksum_check) {
   const RepeatedField<int32>* raw_removals = nullptr;
@@ -352,8 +382,9 @@ ApplyUpdateResult V4Store::ProcessUpdate(
     // reset the store.
     expected_checksum_ = expected_checksum;
   } else {
-    apply_update_result = MergeUpdate(hash_prefix_map_old, hash_prefix_map,
-                                      raw_removals, expected_checksum);
+    apply_update_result =
+        MergeUpdate(hash_prefix_map_old, GetHashPrefixMapView(hash_prefix_map),
+                    raw_removals, expected_checksum);
     if (apply_update_result != APPLY_UPDATE_SUCCESS) {
       return apply_update_result;
     }
@@ -375,7 +406,7 @@ void V4Store::ApplyUpdate(
   if (response->response_type() == ListUpdateResponse::PARTIAL_UPDATE) {
     metric = kProcessPartialUpdate;
     apply_update_result = new_store->ProcessPartialUpdateAndWriteToDisk(
-        metric, hash_prefix_map_, std::move(response));
+        metric, GetHashPrefixMapView(), std::move(response));
   } else if (response->response_type() == ListUpdateResponse::FULL_UPDATE) {
     metric = kProcessFullUpdate;
     apply_update_result =
@@ -392,6 +423,9 @@ void V4Store::ApplyUpdate(
     new_store->last_apply_update_time_millis_ = base::Time::Now();
     new_store->checks_attempted_ = checks_attempted_;
     RecordApplyUpdateTime(metric, TimeTicks::Now() - before, store_path_);
+
+    // The store file on disk no longer refers to the hash files of this store.
+    hash_files_superseded_ = new_store->store_file_written_;
   } else {
     new_store.reset();
     DLOG(WARNING) << "Failure: ApplyUpdate: reason: " << apply_update_result
@@ -496,9 +530,25 @@ ApplyUpdateResult V4Store::AddUnlumpedHashes(PrefixSize prefix_size,
   return APPLY_UPDATE_SUCCESS;
 }
 
+// static
+HashPrefixMapView V4Store::GetHashPrefixMapView(
+    const HashPrefixMap& hash_prefix_map) {
+  HashPrefixMapView view;
+  for (const auto& pair : hash_prefix_map)
+    view[pair.first] = pair.second;
+  return view;
+}
+
+HashPrefixMapView V4Store::GetHashPrefixMapView() const {
+  HashPrefixMapView view = GetHashPrefixMapView(hash_prefix_map_);
+  for (const auto& pair : mapped_hash_files_)
+    view[pair.first] = GetMappedHashPrefixes(*pair.second);
+  return view;
+}
+
 // static
 bool V4Store::GetNextSmallestUnmergedPrefix(
-    const HashPrefixMap& hash_prefix_map,
+    const HashPrefixMapView& hash_prefix_map,
     const IteratorMap& iterator_map,
     HashPrefix* smallest_hash_prefix) {
   HashPrefix current_hash_prefix;
@@ -506,13 +556,14 @@ bool V4Store::GetNextSmallestUnmergedPrefix(
 
   for (const auto& iterator_pair : iterator_map) {
     PrefixSize prefix_size = iterator_pair.first;
-    HashPrefixes::const_iterator start = iterator_pair.second;
+    size_t start = iterator_pair.second;
 
-    const HashPrefixes& hash_prefixes = hash_prefix_map.at(prefix_size);
-    PrefixSize distance = std::distance(start, hash_prefixes.end());
+    base::StringPiece hash_prefixes = hash_prefix_map.at(prefix_size);
+    PrefixSize distance = hash_prefixes.size() - start;
     CHECK_EQ(0u, distance % prefix_size);
     if (prefix_size <= distance) {
-      current_hash_prefix = HashPrefix(start, start + prefix_size);
+      current_hash_prefix =
+          hash_prefixes.substr(start, prefix_size).as_string();
       if (!has_unmerged || *smallest_hash_prefix > current_hash_prefix) {
         has_unmerged = true;
         smallest_hash_prefix->swap(current_hash_prefix);
@@ -523,16 +574,17 @@ bool V4Store::GetNextSmallestUnmergedPrefix(
 }
 
 // static
-void V4Store::InitializeIteratorMap(const HashPrefixMap& hash_prefix_map,
+void V4Store::InitializeIteratorMap(const HashPrefixMapView& hash_prefix_map,
                                     IteratorMap* iterator_map) {
   for (const auto& map_pair : hash_prefix_map) {
-    (*iterator_map)[map_pair.first] = map_pair.second.begin();
+    (*iterator_map)[map_pair.first] = 0;
   }
 }
 
 // static
-void V4Store::ReserveSpaceInPrefixMap(const HashPrefixMap& other_prefixes_map,
-                                      HashPrefixMap* prefix_map_to_update) {
+void V4Store::ReserveSpaceInPrefixMap(
+    const HashPrefixMapView& other_prefixes_map,
+    HashPrefixMap* prefix_map_to_update) {
   for (const auto& pair : other_prefixes_map) {
     PrefixSize prefix_size = pair.first;
     size_t prefix_length_to_add = pair.second.length();
@@ -550,6 +602,16 @@ ApplyUpdateResult V4Store::MergeUpdate(const HashPrefixMap& old_prefixes_map,
                                        const HashPrefixMap& additions_map,
                                        const RepeatedField<int32>* raw_removals,
                                        const std::string& expected_checksum) {
+  return MergeUpdate(GetHashPrefixMapView(old_prefixes_map),
+                     GetHashPrefixMapView(additions_map), raw_removals,
+                     expected_checksum);
+}
+
+ApplyUpdateResult V4Store::MergeUpdate(
+    const HashPrefixMapView& old_prefixes_map,
+    const HashPrefixMapView& additions_map,
+    const RepeatedField<int32>* raw_removals,
+    const std::string& expected_checksum) {
   DCHECK(task_runner_->RunsTasksInCurrentSequence());
   DCHECK(hash_prefix_map_.empty());
 
@@ -720,6 +782,14 @@ StoreReadResult V4Store::ReadFromDisk() {
     return HASH_PREFIX_INFO_MISSING_FAILURE;
   }
 
+  // The hash files, if any, are used in place; only their pages that are
+  // searched are ever read from disk.
+  if (!MapHashFiles(file_format)) {
+    return HASH_FILE_MAPPING_FAILURE;
+  }
+  for (const auto& pair : mapped_hash_files_)
+    file_size += pair.second->length();
+
   std::unique_ptr<ListUpdateResponse> response(new ListUpdateResponse);
   response->Swap(file_format.mutable_list_update_response());
   ApplyUpdateResult apply_update_result = ProcessFullUpdate(
@@ -728,6 +798,7 @@ StoreReadResult V4Store::ReadFromDisk() {
   last_apply_update_result_ = apply_update_result;
   if (apply_update_result != APPLY_UPDATE_SUCCESS) {
     hash_prefix_map_.clear();
+    mapped_hash_files_.clear();
     return HASH_PREFIX_MAP_GENERATION_FAILURE;
   }
   RecordApplyUpdateTime(kReadFromDisk, TimeTicks::Now() - before, store_path_);
@@ -744,14 +815,26 @@ StoreWriteResult V4Store::WriteToDisk(const Checksum& checksum) {
   *(lur->mutable_checksum()) = checksum;
   lur->set_new_client_state(state_);
   lur->set_response_type(ListUpdateResponse::FULL_UPDATE);
-  for (const auto& entry : hash_prefix_map_) {
-    ThreatEntrySet* additions = lur->add_additions();
-    // TODO(vakh): Write RICE encoded hash prefixes on disk. Not doing so
-    // currently since it takes a long time to decode them on startup, which
-    // blocks resource load. See: http://crbug.com/654819
-    additions->set_compression_type(RAW);
-    additions->mutable_raw_hashes()->set_prefix_size(entry.first);
-    additions->mutable_raw_hashes()->set_raw_hashes(entry.second);
+
+  const bool use_hash_files =
+      base::FeatureList::IsEnabled(kMmapSafeBrowsingDatabase);
+  int64_t hash_files_size = 0;
+  if (use_hash_files) {
+    hash_files_size = WriteHashFiles(&file_format);
+    if (hash_files_size < 0) {
+      DeleteUnusedHashFiles(store_path_, file_format);
+      return UNEXPECTED_BYTES_WRITTEN_FAILURE;
+    }
+  } else {
+    for (const auto& entry : hash_prefix_map_) {
+      ThreatEntrySet* additions = lur->add_additions();
+      // TODO(vakh): Write RICE encoded hash prefixes on disk. Not doing so
+      // currently since it takes a long time to decode them on startup, which
+      // blocks resource load. See: http://crbug.com/654819
+      additions->set_compression_type(RAW);
+      additions->mutable_raw_hashes()->set_prefix_size(entry.first);
+      additions->mutable_raw_hashes()->set_raw_hashes(entry.second);
+    }
   }
 
   // Attempt writing to a temporary file first and at the end, swap the files.
@@ -766,20 +849,87 @@ StoreWriteResult V4Store::WriteToDisk(const Checksum& checksum) {
 
   if (file_format_string.size() != written) {
     base::DeleteFile(new_filename, /*recursive=*/false);
+    DeleteUnusedHashFiles(store_path_, file_format);
     return UNEXPECTED_BYTES_WRITTEN_FAILURE;
   }
 
   if (!base::Move(new_filename, store_path_)) {
     base::DeleteFile(new_filename, /*recursive=*/false);
+    DeleteUnusedHashFiles(store_path_, file_format);
     return UNABLE_TO_RENAME_FAILURE;
   }
 
   // Update |file_size_| now because we wrote the file correctly.
-  file_size_ = static_cast<int64_t>(written);
+  file_size_ = static_cast<int64_t>(written) + hash_files_size;
+  store_file_written_ = true;
+
+  // Serve lookups from the hash files from now on, so that the merged hash
+  // prefixes don't need to stay in memory.
+  if (use_hash_files && MapHashFiles(file_format))
+    hash_prefix_map_.clear();
 
   return WRITE_SUCCESS;
 }
 
+int64_t V4Store::WriteHashFiles(V4StoreFileFormat* file_format) {
+  int64_t total_written = 0;
+  for (const auto& entry : hash_prefix_map_) {
+    if (entry.second.empty())
+      continue;
+
+    // Use a new file name on every write so that the hash files mapped by the
+    // store being replaced are never modified.
+    const std::string extension = base::NumberToString(entry.first) + "_" +
+                                  base::NumberToString(base::RandUint64());
+    HashFile* hash_file = file_format->add_hash_files();
+    hash_file->set_prefix_size(entry.first);
+    hash_file->set_extension(extension);
+
+    int written = base::WriteFile(HashFilePath(store_path_, extension),
+                                  entry.second.data(), entry.second.size());
+    if (written < 0 || static_cast<size_t>(written) != entry.second.size())
+      return -1;
+    total_written += written;
+  }
+  return total_written;
+}
+
+bool V4Store::MapHashFiles(const V4StoreFileFormat& file_format) {
+  mapped_hash_files_.clear();
+  hash_file_paths_.clear();
+  for (const HashFile& hash_file : file_format.hash_files()) {
+    hash_file_paths_.push_back(
+        HashFilePath(store_path_, hash_file.extension()));
+  }
+
+  for (int i = 0; i < file_format.hash_files_size(); i++) {
+    const PrefixSize prefix_size = file_format.hash_files(i).prefix_size();
+    if (prefix_size < kMinHashPrefixLength ||
+        prefix_size > kMaxHashPrefixLength ||
+        base::ContainsKey(mapped_hash_files_, prefix_size)) {
+      mapped_hash_files_.clear();
+      return false;
+    }
+
+    auto mapped_file = std::make_unique<base::MemoryMappedFile>();
+    if (!mapped_file->Initialize(hash_file_paths_[i]) ||
+        mapped_file->length() % prefix_size != 0) {
+      mapped_hash_files_.clear();
+      return false;
+    }
+    mapped_hash_files_[prefix_size] = std::move(mapped_file);
+  }
+  return true;
+}
+
+void V4Store::DeleteHashFiles() {
+  // Unmap the files first, since mapped files can't be deleted on Windows.
+  mapped_hash_files_.clear();
+  for (const base::FilePath& path : hash_file_paths_)
+    base::DeleteFile(path, /*recursive=*/false);
+  hash_file_paths_.clear();
+}
+
 HashPrefix V4Store::GetMatchingHashPrefix(const FullHash& full_hash) {
   return GetMatchingHashPrefix(base::StringPiece(full_hash));
 }
@@ -796,11 +946,19 @@ HashPrefix V4Store::GetMatchingHashPrefix(base::StringPiece full_hash) {
     if (HashPrefixMatches(hash_prefix, pair.second, prefix_size))
       return hash_prefix.as_string();
   }
+  for (const auto& pair : mapped_hash_files_) {
+    const PrefixSize& prefix_size = pair.first;
+    base::StringPiece hash_prefix = full_hash.substr(0, prefix_size);
+    if (HashPrefixMatches(hash_prefix, GetMappedHashPrefixes(*pair.second),
+                          prefix_size)) {
+      return hash_prefix.as_string();
+    }
+  }
   return HashPrefix();
 }
 
 bool V4Store::HashPrefixMatches(base::StringPiece prefix,
-                                const HashPrefixes& prefixes,
+                                base::StringPiece prefixes,
                                 const PrefixSize& size) {
   return std::binary_search(
       PrefixIterator(prefixes, 0, size),
@@ -816,12 +974,13 @@ bool V4Store::VerifyChecksum() {
     return true;
   }
 
+  const HashPrefixMapView hash_prefix_map = GetHashPrefixMapView();
   IteratorMap iterator_map;
   HashPrefix next_smallest_prefix;
-  InitializeIteratorMap(hash_prefix_map_, &iterator_map);
-  CHECK_EQ(hash_prefix_map_.size(), iterator_map.size());
+  InitializeIteratorMap(hash_prefix_map, &iterator_map);
+  CHECK_EQ(hash_prefix_map.size(), iterator_map.size());
   bool has_unmerged = GetNextSmallestUnmergedPrefix(
-      hash_prefix_map_, iterator_map, &next_smallest_prefix);
+      hash_prefix_map, iterator_map, &next_smallest_prefix);
 
   std::unique_ptr<crypto::SecureHash> checksum_ctx(
       crypto::SecureHash::Create(crypto::SecureHash::SHA256));
@@ -836,7 +995,7 @@ bool V4Store::VerifyChecksum() {
                          next_smallest_prefix_size);
 
     // Find the next smallest unmerged element in the map.
-    has_unmerged = GetNextSmallestUnmergedPrefix(hash_prefix_map_, iterator_map,
+    has_unmerged = GetNextSmallestUnmergedPrefix(hash_prefix_map, iterator_map,
                                                  &next_smallest_prefix);
   }
 
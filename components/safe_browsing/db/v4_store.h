@@ -10,17 +10,21 @@
 #include <memory>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 #include "base/files/file_path.h"
+#include "base/files/memory_mapped_file.h"
 #include "base/memory/ref_counted.h"
 #include "base/sequenced_task_runner.h"
 #include "base/single_thread_task_runner.h"
+#include "base/strings/string_piece.h"
 #include "components/safe_browsing/db/v4_protocol_manager_util.h"
 #include "components/safe_browsing/proto/webui.pb.h"
 
 namespace safe_browsing {
 
 class V4Store;
+class V4StoreFileFormat;
 
 using UpdatedStoreReadyCallback =
     base::Callback<void(std::unique_ptr<V4Store> new_store)>;
@@ -32,12 +36,15 @@ using HashPrefixes = std::string;
 // For instance: {4: ["abcd", "bcde", "cdef", "gggg"], 5: ["fffff"]}
 using HashPrefixMap = std::unordered_map<PrefixSize, HashPrefixes>;
 
-// Stores the iterator to the last element merged from the HashPrefixMap for a
-// given prefix size.
-// For instance: {4:iter(3), 5:iter(1)} means that we have already merged
-// 3 hash prefixes of length 4, and 1 hash prefix of length 5.
-using IteratorMap =
-    std::unordered_map<PrefixSize, HashPrefixes::const_iterator>;
+// Same as HashPrefixMap, but the sorted hash prefixes are owned elsewhere,
+// either by a HashPrefixMap or by a memory-mapped file.
+using HashPrefixMapView = std::unordered_map<PrefixSize, base::StringPiece>;
+
+// Stores the offset of the next element to merge from the HashPrefixMapView
+// for a given prefix size.
+// For instance: {4:12, 5:5} means that we have already merged 3 hash prefixes
+// of length 4, and 1 hash prefix of length 5.
+using IteratorMap = std::unordered_map<PrefixSize, size_t>;
 
 // Enumerate different failure events while parsing the file read from disk for
 // histogramming purposes.  DO NOT CHANGE THE ORDERING OF THESE VALUES.
@@ -74,6 +81,10 @@ enum StoreReadResult {
   // Unable to generate the hash prefix map from the updates on disk.
   HASH_PREFIX_MAP_GENERATION_FAILURE = 8,
 
+  // One of the hash files referred to by the store file could not be mapped,
+  // or its size is not a multiple of its prefix size.
+  HASH_FILE_MAPPING_FAILURE = 9,
+
   // Memory space for histograms is determined by the max.  ALWAYS
   // ADD NEW VALUES BEFORE THIS ONE.
   STORE_READ_RESULT_MAX
@@ -293,7 +304,11 @@ class V4Store {
   FRIEND_TEST_ALL_PREFIXES(V4StoreTest, TestChecksumErrorOnStartup);
   FRIEND_TEST_ALL_PREFIXES(V4StoreTest, WriteToDiskFails);
   FRIEND_TEST_ALL_PREFIXES(V4StoreTest, FullUpdateFailsChecksumSynchronously);
+  FRIEND_TEST_ALL_PREFIXES(V4StoreTest, MappedHashFilesRoundTrip);
+  FRIEND_TEST_ALL_PREFIXES(V4StoreTest, MappedHashFilesMissing);
+  FRIEND_TEST_ALL_PREFIXES(V4StoreTest, MappedHashFilesMergeUpdate);
   FRIEND_TEST_ALL_PREFIXES(V4StorePerftest, StressTest);
+  FRIEND_TEST_ALL_PREFIXES(V4StorePerftest, ReadFromDisk);
 
   friend class V4StoreTest;
   friend class V4StoreFuzzer;
@@ -313,24 +328,28 @@ class V4Store {
                                              const std::string& raw_hashes,
                                              HashPrefixMap* additions_map);
 
+  // Returns a view of the hash prefixes in |hash_prefix_map|.
+  static HashPrefixMapView GetHashPrefixMapView(
+      const HashPrefixMap& hash_prefix_map);
+
   // Get the next unmerged hash prefix in dictionary order from
   // |hash_prefix_map|. |iterator_map| is used to determine which hash prefixes
   // have been merged already. Returns true if there are any unmerged hash
   // prefixes in the list.
   static bool GetNextSmallestUnmergedPrefix(
-      const HashPrefixMap& hash_prefix_map,
+      const HashPrefixMapView& hash_prefix_map,
       const IteratorMap& iterator_map,
       HashPrefix* smallest_hash_prefix);
 
   // Returns true if |hash_prefix| with PrefixSize |size| exists in |prefixes|.
   // This small method is exposed in the header so it can be tested separately.
   static bool HashPrefixMatches(base::StringPiece prefix,
-                                const HashPrefixes& prefixes,
+                                base::StringPiece prefixes,
                                 const PrefixSize& size);
 
-  // For each key in |hash_prefix_map|, sets the iterator at that key
-  // |iterator_map| to hash_prefix_map[key].begin().
-  static void InitializeIteratorMap(const HashPrefixMap& hash_prefix_map,
+  // For each key in |hash_prefix_map|, sets the offset at that key in
+  // |iterator_map| to 0.
+  static void InitializeIteratorMap(const HashPrefixMapView& hash_prefix_map,
                                     IteratorMap* iterator_map);
 
   // Reserve the appropriate string size so that the string size of the merged
@@ -338,19 +357,32 @@ class V4Store {
   // deletions specified in the update because it is non-trivial to calculate
   // those deletions upfront. This isn't so bad since deletions are supposed to
   // be small and infrequent.
-  static void ReserveSpaceInPrefixMap(const HashPrefixMap& other_prefixes_map,
-                                      HashPrefixMap* prefix_map_to_update);
+  static void ReserveSpaceInPrefixMap(
+      const HashPrefixMapView& other_prefixes_map,
+      HashPrefixMap* prefix_map_to_update);
 
   // Same as the public GetMatchingHashPrefix method, but takes a StringPiece,
   // for performance reasons.
   HashPrefix GetMatchingHashPrefix(base::StringPiece full_hash);
 
+  // Returns a view of all the hash prefixes in this store, whether they are in
+  // |hash_prefix_map_| or in |mapped_hash_files_|.
+  HashPrefixMapView GetHashPrefixMapView() const;
+
   // Merges the prefix map from the old store (|old_hash_prefix_map|) and the
   // update (additions_map) to populate the prefix map for the current store.
   // The indices in the |raw_removals| list, which may be NULL, are not merged.
   // The SHA256 checksum of the final list of hash prefixes, in
   // lexicographically sorted order, must match |expected_checksum| (if it's not
   // empty).
+  ApplyUpdateResult MergeUpdate(
+      const HashPrefixMapView& old_hash_prefix_map,
+      const HashPrefixMapView& additions_map,
+      const ::google::protobuf::RepeatedField<::google::protobuf::int32>*
+          raw_removals,
+      const std::string& expected_checksum);
+
+  // An overloaded version of MergeUpdate that takes HashPrefixMap objects.
   ApplyUpdateResult MergeUpdate(
       const HashPrefixMap& old_hash_prefix_map,
       const HashPrefixMap& additions_map,
@@ -386,7 +418,7 @@ class V4Store {
   // |metric|.
   ApplyUpdateResult ProcessPartialUpdateAndWriteToDisk(
       const std::string& metric,
-      const HashPrefixMap& hash_prefix_map_old,
+      const HashPrefixMapView& hash_prefix_map_old,
       std::unique_ptr<ListUpdateResponse> response);
 
   // Merges the hash prefixes in |hash_prefix_map_old| and |response|, and
@@ -396,7 +428,7 @@ class V4Store {
   // check if |delay_checksum_check| is true.
   ApplyUpdateResult ProcessUpdate(
       const std::string& metric,
-      const HashPrefixMap& hash_prefix_map_old,
+      const HashPrefixMapView& hash_prefix_map_old,
       const std::unique_ptr<ListUpdateResponse>& response,
       bool delay_checksum_check);
 
@@ -413,9 +445,23 @@ class V4Store {
       HashPrefixMap* additions_map);
 
   // Writes the hash_prefix_map_ to disk as a V4StoreFileFormat proto.
-  // |checksum| is used to set the |checksum| field in the final proto.
+  // |checksum| is used to set the |checksum| field in the final proto. If
+  // kMmapSafeBrowsingDatabase is enabled, the hash prefixes are written to
+  // hash files instead, which then replace |hash_prefix_map_| in memory.
   StoreWriteResult WriteToDisk(const Checksum& checksum);
 
+  // Writes |hash_prefix_map_| to a new hash file per prefix size, and adds
+  // them to |file_format|. Returns the number of bytes written, or -1 on
+  // failure.
+  int64_t WriteHashFiles(V4StoreFileFormat* file_format);
+
+  // Memory-maps the hash files in |file_format| into |mapped_hash_files_|.
+  // Returns false if any of them can't be used.
+  bool MapHashFiles(const V4StoreFileFormat& file_format);
+
+  // Unmaps and deletes the hash files in |hash_file_paths_|.
+  void DeleteHashFiles();
+
   // Records the status of the update being applied to the database.
   ApplyUpdateResult last_apply_update_result_ = APPLY_UPDATE_RESULT_MAX;
 
@@ -436,6 +482,21 @@ class V4Store {
   // Records the number of times we have looked up the store.
   size_t checks_attempted_ = 0;
 
+  // The hash prefixes mapped from the hash files on disk, by size. When
+  // non-empty, |hash_prefix_map_| is empty.
+  std::unordered_map<PrefixSize, std::unique_ptr<base::MemoryMappedFile>>
+      mapped_hash_files_;
+
+  // The paths of the hash files that the store file on disk refers to.
+  std::vector<base::FilePath> hash_file_paths_;
+
+  // True if the store file on disk was written by this store.
+  bool store_file_written_ = false;
+
+  // True if a newer store has replaced the store file on disk, so the hash
+  // files of this store can be deleted when it is destroyed.
+  bool hash_files_superseded_ = false;
+
   // The state of the store as returned by the PVer4 server in the last applied
   // update response.
   std::string state_;
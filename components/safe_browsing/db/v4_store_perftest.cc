@@ -2,19 +2,23 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include <algorithm>
 #include <memory>
 #include <string>
 #include <utility>
 #include <vector>
 
+#include "base/files/scoped_temp_dir.h"
 #include "base/macros.h"
 #include "base/memory/ref_counted.h"
 #include "base/numerics/checked_math.h"
 #include "base/strings/stringprintf.h"
+#include "base/test/scoped_feature_list.h"
 #include "base/test/test_simple_task_runner.h"
 #include "base/timer/elapsed_timer.h"
 #include "components/safe_browsing/db/v4_protocol_manager_util.h"
 #include "components/safe_browsing/db/v4_test_util.h"
+#include "components/safe_browsing/features.h"
 #include "crypto/sha2.h"
 #include "testing/gtest/include/gtest/gtest.h"
 #include "testing/perf/perf_test.h"
@@ -66,4 +70,51 @@ TEST_F(V4StorePerftest, StressTest) {
   EXPECT_EQ(kNumPrefixes, matches);
 }
 
+// Measures loading a store from disk, with the hash prefixes stored in the
+// store file itself or in memory-mapped hash files.
+TEST_F(V4StorePerftest, ReadFromDisk) {
+#if defined(NDEBUG)
+  const size_t kNumPrefixes = 2000000;
+#else
+  const size_t kNumPrefixes = 20000;
+#endif
+
+  std::vector<std::string> prefixes;
+  for (size_t i = 0; i < kNumPrefixes; i++) {
+    prefixes.push_back(crypto::SHA256HashString(base::StringPrintf("%zu", i))
+                           .substr(0, kMinHashPrefixLength));
+  }
+  std::sort(prefixes.begin(), prefixes.end());
+  prefixes.erase(std::unique(prefixes.begin(), prefixes.end()),
+                 prefixes.end());
+  std::string hash_prefixes;
+  for (const std::string& prefix : prefixes)
+    hash_prefixes += prefix;
+
+  base::ScopedTempDir temp_dir;
+  ASSERT_TRUE(temp_dir.CreateUniqueTempDir());
+  auto task_runner = base::MakeRefCounted<base::TestSimpleTaskRunner>();
+  for (bool use_hash_files : {false, true}) {
+    base::test::ScopedFeatureList feature_list;
+    feature_list.InitWithFeatureState(kMmapSafeBrowsingDatabase,
+                                      use_hash_files);
+    const base::FilePath store_path = temp_dir.GetPath().AppendASCII(
+        use_hash_files ? "mapped.store" : "inline.store");
+    {
+      V4Store write_store(task_runner, store_path);
+      write_store.hash_prefix_map_[kMinHashPrefixLength] = hash_prefixes;
+      ASSERT_EQ(WRITE_SUCCESS, write_store.WriteToDisk(Checksum()));
+    }
+
+    V4Store read_store(task_runner, store_path);
+    base::ElapsedTimer timer;
+    ASSERT_EQ(READ_SUCCESS, read_store.ReadFromDisk());
+    perf_test::PrintResult("V4StoreReadFromDisk", "",
+                           use_hash_files ? "mapped" : "inline",
+                           timer.Elapsed().InMillisecondsF(), "ms", true);
+    EXPECT_EQ(prefixes[0], read_store.GetMatchingHashPrefix(
+                               prefixes[0] + std::string(28, 'a')));
+  }
+}
+
 }  // namespace safe_browsing
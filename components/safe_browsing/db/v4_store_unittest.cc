@@ -8,9 +8,11 @@
 #include "base/files/file_util.h"
 #include "base/files/scoped_temp_dir.h"
 #include "base/run_loop.h"
+#include "base/test/scoped_feature_list.h"
 #include "base/test/test_simple_task_runner.h"
 #include "base/time/time.h"
 #include "components/safe_browsing/db/v4_store.pb.h"
+#include "components/safe_browsing/features.h"
 #include "content/public/test/test_browser_thread_bundle.h"
 #include "crypto/sha2.h"
 #include "testing/platform_test.h"
@@ -178,7 +180,7 @@ TEST_F(V4StoreTest, TestAddUnlumpedHashes) {
 }
 
 TEST_F(V4StoreTest, TestGetNextSmallestUnmergedPrefixWithEmptyPrefixMap) {
-  HashPrefixMap prefix_map;
+  HashPrefixMapView prefix_map;
   IteratorMap iterator_map;
   V4Store::InitializeIteratorMap(prefix_map, &iterator_map);
 
@@ -193,12 +195,14 @@ TEST_F(V4StoreTest, TestGetNextSmallestUnmergedPrefix) {
             V4Store::AddUnlumpedHashes(5, "-----0000054321abcde", &prefix_map));
   EXPECT_EQ(APPLY_UPDATE_SUCCESS,
             V4Store::AddUnlumpedHashes(4, "*****0000054321abcde", &prefix_map));
+  const HashPrefixMapView prefix_map_view =
+      V4Store::GetHashPrefixMapView(prefix_map);
   IteratorMap iterator_map;
-  V4Store::InitializeIteratorMap(prefix_map, &iterator_map);
+  V4Store::InitializeIteratorMap(prefix_map_view, &iterator_map);
 
   HashPrefix prefix;
-  EXPECT_TRUE(V4Store::GetNextSmallestUnmergedPrefix(prefix_map, iterator_map,
-                                                     &prefix));
+  EXPECT_TRUE(V4Store::GetNextSmallestUnmergedPrefix(
+      prefix_map_view, iterator_map, &prefix));
   EXPECT_EQ("****", prefix);
 }
 
@@ -881,4 +885,116 @@ TEST_F(V4StoreTest, FullUpdateFailsChecksumSynchronously) {
   EXPECT_FALSE(updated_store_);
 }
 
+TEST_F(V4StoreTest, MappedHashFilesRoundTrip) {
+  base::test::ScopedFeatureList feature_list;
+  feature_list.InitAndEnableFeature(kMmapSafeBrowsingDatabase);
+
+  V4Store write_store(task_runner_, store_path_);
+  write_store.hash_prefix_map_[4] = "00000abc";
+  write_store.hash_prefix_map_[5] = "00000abcde";
+  write_store.state_ = "test_client_state";
+  EXPECT_EQ(WRITE_SUCCESS, write_store.WriteToDisk(Checksum()));
+  EXPECT_TRUE(base::PathExists(write_store.store_path_));
+  ASSERT_EQ(2u, write_store.hash_file_paths_.size());
+  EXPECT_TRUE(base::PathExists(write_store.hash_file_paths_[0]));
+  EXPECT_TRUE(base::PathExists(write_store.hash_file_paths_[1]));
+
+  // The store now looks up hash prefixes in the files it wrote.
+  EXPECT_TRUE(write_store.hash_prefix_map_.empty());
+  EXPECT_EQ(2u, write_store.mapped_hash_files_.size());
+  EXPECT_EQ("abcde", write_store.GetMatchingHashPrefix(
+                         FullHash("abcde333344445555666677778888999")));
+
+  V4Store read_store(task_runner_, store_path_);
+  EXPECT_EQ(READ_SUCCESS, read_store.ReadFromDisk());
+  EXPECT_EQ("test_client_state", read_store.state_);
+  EXPECT_TRUE(read_store.hash_prefix_map_.empty());
+  const HashPrefixMapView prefix_map = read_store.GetHashPrefixMapView();
+  ASSERT_EQ(2u, prefix_map.size());
+  EXPECT_EQ("00000abc", prefix_map.at(4));
+  EXPECT_EQ("00000abcde", prefix_map.at(5));
+  EXPECT_EQ(write_store.file_size_, read_store.file_size_);
+
+  EXPECT_EQ("0abc", read_store.GetMatchingHashPrefix(
+                        FullHash("0abc2222333344445555666677778888")));
+  EXPECT_EQ("abcde", read_store.GetMatchingHashPrefix(
+                         FullHash("abcde333344445555666677778888999")));
+  EXPECT_TRUE(read_store
+                  .GetMatchingHashPrefix(
+                      FullHash("11112222333344445555666677778888"))
+                  .empty());
+}
+
+TEST_F(V4StoreTest, MappedHashFilesMissing) {
+  base::test::ScopedFeatureList feature_list;
+  feature_list.InitAndEnableFeature(kMmapSafeBrowsingDatabase);
+
+  std::vector<base::FilePath> hash_file_paths;
+  {
+    V4Store write_store(task_runner_, store_path_);
+    write_store.hash_prefix_map_[4] = "00000abc";
+    write_store.state_ = "test_client_state";
+    EXPECT_EQ(WRITE_SUCCESS, write_store.WriteToDisk(Checksum()));
+    hash_file_paths = write_store.hash_file_paths_;
+  }
+  ASSERT_EQ(1u, hash_file_paths.size());
+  ASSERT_TRUE(base::DeleteFile(hash_file_paths[0], false));
+
+  V4Store read_store(task_runner_, store_path_);
+  EXPECT_EQ(HASH_FILE_MAPPING_FAILURE, read_store.ReadFromDisk());
+  EXPECT_TRUE(read_store.state_.empty());
+  EXPECT_TRUE(read_store.mapped_hash_files_.empty());
+}
+
+TEST_F(V4StoreTest, MappedHashFilesMergeUpdate) {
+  base::test::ScopedFeatureList feature_list;
+  feature_list.InitAndEnableFeature(kMmapSafeBrowsingDatabase);
+
+  auto store = std::make_unique<V4Store>(task_runner_, store_path_);
+  store->hash_prefix_map_[4] = "1111abcdefgh";
+  store->hash_prefix_map_[5] = "22222bcdef";
+  EXPECT_EQ(WRITE_SUCCESS, store->WriteToDisk(Checksum()));
+  EXPECT_TRUE(store->hash_prefix_map_.empty());
+  const std::vector<base::FilePath> old_hash_file_paths =
+      store->hash_file_paths_;
+
+  // Sorted, the store is: 1111, 22222, abcd, bcdef, efgh. Remove 1111 and
+  // bcdef, and add 3333.
+  std::unique_ptr<ListUpdateResponse> lur(new ListUpdateResponse);
+  lur->set_response_type(ListUpdateResponse::PARTIAL_UPDATE);
+  ThreatEntrySet* removal = lur->add_removals();
+  removal->set_compression_type(RAW);
+  removal->mutable_raw_indices()->add_indices(0);
+  removal->mutable_raw_indices()->add_indices(3);
+  ThreatEntrySet* addition = lur->add_additions();
+  addition->set_compression_type(RAW);
+  addition->mutable_raw_hashes()->set_prefix_size(4);
+  addition->mutable_raw_hashes()->set_raw_hashes("3333");
+
+  std::unique_ptr<V4Store> new_store;
+  store->ApplyUpdate(
+      std::move(lur), task_runner_,
+      base::Bind(
+          [](std::unique_ptr<V4Store>* out, std::unique_ptr<V4Store> store) {
+            *out = std::move(store);
+          },
+          &new_store));
+  task_runner_->RunPendingTasks();
+  base::RunLoop().RunUntilIdle();
+
+  ASSERT_TRUE(new_store);
+  EXPECT_TRUE(new_store->hash_prefix_map_.empty());
+  const HashPrefixMapView prefix_map = new_store->GetHashPrefixMapView();
+  ASSERT_EQ(2u, prefix_map.size());
+  EXPECT_EQ("3333abcdefgh", prefix_map.at(4));
+  EXPECT_EQ("22222", prefix_map.at(5));
+
+  // Destroying the replaced store deletes its hash files.
+  store.reset();
+  for (const base::FilePath& path : old_hash_file_paths)
+    EXPECT_FALSE(base::PathExists(path));
+  for (const base::FilePath& path : new_store->hash_file_paths_)
+    EXPECT_TRUE(base::PathExists(path));
+}
+
 }  // namespace safe_browsing
@@ -35,6 +35,9 @@ const base::Feature kCheckByURLLoaderThrottle{
 const base::Feature kCommittedSBInterstitials{
     "SafeBrowsingCommittedInterstitials", base::FEATURE_DISABLED_BY_DEFAULT};
 
+const base::Feature kMmapSafeBrowsingDatabase{
+    "MmapSafeBrowsingDatabase", base::FEATURE_DISABLED_BY_DEFAULT};
+
 const base::Feature kPasswordProtectionForSignedInUsers{
     "SafeBrowsingPasswordProtectionForSignedInUsers",
     base::FEATURE_DISABLED_BY_DEFAULT};
@@ -76,6 +79,7 @@ constexpr struct {
     {&kAdSamplerTriggerFeature, false},
     {&kCheckByURLLoaderThrottle, true},
     {&kCommittedSBInterstitials, true},
+    {&kMmapSafeBrowsingDatabase, false},
     {&kPasswordProtectionForSignedInUsers, true},
     {&kSuspiciousSiteTriggerQuotaFeature, true},
     {&kTelemetryForApkDownloads, true},
@@ -27,6 +27,10 @@ extern const base::Feature kCheckByURLLoaderThrottle;
 // navigations instead of overlays.
 extern const base::Feature kCommittedSBInterstitials;
 
+// Controls whether V4Store writes its hash prefixes to separate files that are
+// memory-mapped and searched in place instead of being read into memory.
+extern const base::Feature kMmapSafeBrowsingDatabase;
+
 // Enable GAIA password protection for signed-in users.
 extern const base::Feature kPasswordProtectionForSignedInUsers;
 
@@ -8,8 +8,10 @@
 #include <tuple>
 #include <utility>
 
+#include "base/bind.h"
 #include "base/logging.h"
 #include "base/stl_util.h"
+#include "base/task/post_task.h"
 #include "components/crash/core/common/crash_key.h"
 #include "components/services/pdf_compositor/public/cpp/pdf_service_mojo_types.h"
 #include "mojo/public/cpp/base/shared_memory_utils.h"
@@ -22,6 +24,48 @@
 
 namespace printing {
 
+namespace {
+
+// Converts |pages| into a PDF document. This runs on the thread pool, so that
+// the pages of different requests, e.g. print preview pages, are converted in
+// parallel. Returns an invalid region on failure.
+base::ReadOnlySharedMemoryRegion ConvertPagesToPdf(
+    const std::string& creator,
+    std::vector<SkDocumentPage> pages) {
+  SkDynamicMemoryWStream wstream;
+  sk_sp<SkDocument> doc = MakePdfDocument(creator, &wstream);
+
+  for (auto& page : pages) {
+    SkCanvas* canvas = doc->beginPage(page.fSize.width(), page.fSize.height());
+    canvas->drawPicture(page.fPicture);
+    doc->endPage();
+    // Release each page's content as soon as it has been written.
+    page.fPicture.reset();
+  }
+  doc->close();
+
+  base::MappedReadOnlyRegion region_mapping =
+      mojo::CreateReadOnlySharedMemoryRegion(wstream.bytesWritten());
+  if (!region_mapping.IsValid()) {
+    DLOG(ERROR) << "ConvertPagesToPdf: Cannot create new shared memory region.";
+    return base::ReadOnlySharedMemoryRegion();
+  }
+
+  wstream.copyToAndReset(region_mapping.mapping.memory());
+  return std::move(region_mapping.region);
+}
+
+void OnPagesConvertedToPdf(
+    mojom::PdfCompositor::CompositePageToPdfCallback callback,
+    base::ReadOnlySharedMemoryRegion region) {
+  auto status = region.IsValid()
+                    ? mojom::PdfCompositor::Status::SUCCESS
+                    : mojom::PdfCompositor::Status::HANDLE_MAP_ERROR;
+  std::move(callback).Run(status, std::move(region));
+}
+
+}  // namespace
+
 PdfCompositorImpl::PdfCompositorImpl(
     std::unique_ptr<service_manager::ServiceContextRef> service_ref)
     : service_ref_(std::move(service_ref)) {}
@@ -202,13 +246,15 @@ void PdfCompositorImpl::HandleCompositionRequest(
       std::move(callback)));
 }
 
-mojom::PdfCompositor::Status PdfCompositorImpl::CompositeToPdf(
+void PdfCompositorImpl::CompositeToPdf(
     base::ReadOnlySharedMemoryMapping shared_mem,
     const ContentToFrameMap& subframe_content_map,
-    base::ReadOnlySharedMemoryRegion* region) {
+    CompositeToPdfCallback callback) {
   if (!shared_mem.IsValid()) {
     DLOG(ERROR) << "CompositeToPdf: Invalid input.";
-    return mojom::PdfCompositor::Status::HANDLE_MAP_ERROR;
+    std::move(callback).Run(mojom::PdfCompositor::Status::HANDLE_MAP_ERROR,
+                            base::ReadOnlySharedMemoryRegion());
+    return;
   }
 
   DeserializationContext subframes =
@@ -219,36 +265,28 @@ mojom::PdfCompositor::Status PdfCompositorImpl::CompositeToPdf(
   int page_count = SkMultiPictureDocumentReadPageCount(&stream);
   if (!page_count) {
     DLOG(ERROR) << "CompositeToPdf: No page is read.";
-    return mojom::PdfCompositor::Status::CONTENT_FORMAT_ERROR;
+    std::move(callback).Run(mojom::PdfCompositor::Status::CONTENT_FORMAT_ERROR,
+                            base::ReadOnlySharedMemoryRegion());
+    return;
   }
 
   std::vector<SkDocumentPage> pages(page_count);
   SkDeserialProcs procs = DeserializationProcs(&subframes);
   if (!SkMultiPictureDocumentRead(&stream, pages.data(), page_count, &procs)) {
     DLOG(ERROR) << "CompositeToPdf: Page reading failed.";
-    return mojom::PdfCompositor::Status::CONTENT_FORMAT_ERROR;
-  }
-
-  SkDynamicMemoryWStream wstream;
-  sk_sp<SkDocument> doc = MakePdfDocument(creator_, &wstream);
-
-  for (const auto& page : pages) {
-    SkCanvas* canvas = doc->beginPage(page.fSize.width(), page.fSize.height());
-    canvas->drawPicture(page.fPicture);
-    doc->endPage();
-  }
-  doc->close();
-
-  base::MappedReadOnlyRegion region_mapping =
-      mojo::CreateReadOnlySharedMemoryRegion(wstream.bytesWritten());
-  if (!region_mapping.IsValid()) {
-    DLOG(ERROR) << "CompositeToPdf: Cannot create new shared memory region.";
-    return mojom::PdfCompositor::Status::HANDLE_MAP_ERROR;
+    std::move(callback).Run(mojom::PdfCompositor::Status::CONTENT_FORMAT_ERROR,
+                            base::ReadOnlySharedMemoryRegion());
+    return;
   }
 
-  wstream.copyToAndReset(region_mapping.mapping.memory());
-  *region = std::move(region_mapping.region);
-  return mojom::PdfCompositor::Status::SUCCESS;
+  // The deserialized pages and subframe pictures are immutable, so they can
+  // be converted to PDF off this sequence, which owns |frame_info_map_|.
+  base::PostTaskWithTraitsAndReplyWithResult(
+      FROM_HERE,
+      {base::TaskPriority::USER_VISIBLE,
+       base::TaskShutdownBehavior::SKIP_ON_SHUTDOWN},
+      base::BindOnce(&ConvertPagesToPdf, creator_, std::move(pages)),
+      base::BindOnce(&OnPagesConvertedToPdf, std::move(callback)));
 }
 
 void PdfCompositorImpl::CompositeSubframe(FrameInfo* frame_info) {
@@ -288,10 +326,8 @@ void PdfCompositorImpl::FulfillRequest(
     base::ReadOnlySharedMemoryMapping serialized_content,
     const ContentToFrameMap& subframe_content_map,
     CompositeToPdfCallback callback) {
-  base::ReadOnlySharedMemoryRegion region;
-  auto status = CompositeToPdf(std::move(serialized_content),
-                               subframe_content_map, &region);
-  std::move(callback).Run(status, std::move(region));
+  CompositeToPdf(std::move(serialized_content), subframe_content_map,
+                 std::move(callback));
 }
 
 PdfCompositorImpl::FrameContentInfo::FrameContentInfo(
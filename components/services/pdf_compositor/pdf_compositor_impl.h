@@ -148,10 +148,11 @@ class PdfCompositorImpl : public mojom::PdfCompositor {
       CompositeToPdfCallback callback);
 
   // The core function for content composition and conversion to a pdf file.
-  mojom::PdfCompositor::Status CompositeToPdf(
-      base::ReadOnlySharedMemoryMapping shared_mem,
-      const ContentToFrameMap& subframe_content_map,
-      base::ReadOnlySharedMemoryRegion* region);
+  // The content is composited on the current sequence, then converted to pdf
+  // on the thread pool before |callback| runs.
+  void CompositeToPdf(base::ReadOnlySharedMemoryMapping shared_mem,
+                      const ContentToFrameMap& subframe_content_map,
+                      CompositeToPdfCallback callback);
 
   // Composite the content of a subframe.
   void CompositeSubframe(FrameInfo* frame_info);
@@ -5,6 +5,7 @@
 #include <memory>
 #include <utility>
 
+#include "base/barrier_closure.h"
 #include "base/bind.h"
 #include "base/callback.h"
 #include "base/memory/read_only_shared_memory_region.h"
@@ -151,6 +152,28 @@ TEST_F(PdfCompositorServiceTest, MultipleCompositors) {
   CallCompositorWithSuccess(std::move(another_compositor));
 }
 
+// Test that all the pages requested back to back are converted, although their
+// conversions to pdf may run in parallel.
+TEST_F(PdfCompositorServiceTest, MultiplePageRequests) {
+  constexpr int kPageCount = 4;
+  base::RepeatingClosure barrier =
+      base::BarrierClosure(kPageCount, run_loop_->QuitClosure());
+  for (int i = 0; i < kPageCount; ++i) {
+    compositor_->CompositePageToPdf(
+        1u, CreateMSKP(), ContentToFrameMap(),
+        base::BindOnce(
+            [](base::RepeatingClosure barrier,
+               mojom::PdfCompositor::Status status,
+               base::ReadOnlySharedMemoryRegion region) {
+              EXPECT_EQ(mojom::PdfCompositor::Status::SUCCESS, status);
+              EXPECT_TRUE(region.IsValid());
+              barrier.Run();
+            },
+            barrier));
+  }
+  run_loop_->Run();
+}
+
 // Test data structures and content of multiple PdfCompositor interface bindings
 // are independent from each other.
 TEST_F(PdfCompositorServiceTest, IndependentCompositors) {
@@ -23,7 +23,8 @@ DocumentSubresourceFilter::DocumentSubresourceFilter(
     scoped_refptr<const MemoryMappedRuleset> ruleset)
     : activation_state_(activation_state),
       ruleset_(std::move(ruleset)),
-      ruleset_matcher_(ruleset_->data(), ruleset_->length()) {
+      ruleset_matcher_(ruleset_->data(), ruleset_->length()),
+      load_decision_cache_(kMaxCachedLoadDecisions) {
   DCHECK_NE(activation_state_.activation_level,
             mojom::ActivationLevel::kDisabled);
   if (!activation_state_.filtering_disabled_for_document)
@@ -32,6 +33,13 @@ DocumentSubresourceFilter::DocumentSubresourceFilter(
 
 DocumentSubresourceFilter::~DocumentSubresourceFilter() = default;
 
+void DocumentSubresourceFilter::set_activation_state(
+    const mojom::ActivationState& state) {
+  activation_state_ = state;
+  // Cached decisions depend on |generic_blocking_rules_disabled|.
+  load_decision_cache_.Clear();
+}
+
 LoadPolicy DocumentSubresourceFilter::GetLoadPolicy(
     const GURL& subresource_url,
     url_pattern_index::proto::ElementType subresource_type) {
@@ -65,9 +73,7 @@ LoadPolicy DocumentSubresourceFilter::GetLoadPolicy(
 
   ++statistics_.num_loads_evaluated;
   DCHECK(document_origin_);
-  if (ruleset_matcher_.ShouldDisallowResourceLoad(
-          subresource_url, *document_origin_, subresource_type,
-          activation_state_.generic_blocking_rules_disabled)) {
+  if (ShouldDisallowResourceLoad(subresource_url, subresource_type)) {
     ++statistics_.num_loads_matching_rules;
     if (activation_state_.activation_level ==
         mojom::ActivationLevel::kEnabled) {
@@ -81,6 +87,21 @@ LoadPolicy DocumentSubresourceFilter::GetLoadPolicy(
   return LoadPolicy::ALLOW;
 }
 
+bool DocumentSubresourceFilter::ShouldDisallowResourceLoad(
+    const GURL& subresource_url,
+    url_pattern_index::proto::ElementType subresource_type) {
+  LoadDecisionKey key(subresource_url.spec(), subresource_type);
+  auto it = load_decision_cache_.Get(key);
+  if (it != load_decision_cache_.end())
+    return it->second;
+
+  bool disallow = ruleset_matcher_.ShouldDisallowResourceLoad(
+      subresource_url, *document_origin_, subresource_type,
+      activation_state_.generic_blocking_rules_disabled);
+  load_decision_cache_.Put(key, disallow);
+  return disallow;
+}
+
 const url_pattern_index::flat::UrlRule*
 DocumentSubresourceFilter::FindMatchingUrlRule(
     const GURL& subresource_url,
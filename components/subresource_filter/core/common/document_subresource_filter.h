@@ -8,8 +8,11 @@
 #include <stddef.h>
 
 #include <memory>
+#include <string>
+#include <utility>
 #include <vector>
 
+#include "base/containers/mru_cache.h"
 #include "base/macros.h"
 #include "base/memory/ref_counted.h"
 #include "components/subresource_filter/core/common/indexed_ruleset.h"
@@ -66,11 +69,23 @@ class DocumentSubresourceFilter {
 
   // Called if the DocumentSubresourceFilter needs to change how it filters
   // subresources.
-  void set_activation_state(const mojom::ActivationState& state) {
-    activation_state_ = state;
-  }
+  void set_activation_state(const mojom::ActivationState& state);
 
  private:
+  // Subresources are often requested repeatedly by a document, so remember
+  // whether the most recently evaluated URLs matched a blocking rule.
+  static constexpr size_t kMaxCachedLoadDecisions = 256;
+
+  using LoadDecisionKey =
+      std::pair<std::string, url_pattern_index::proto::ElementType>;
+
+  // Returns whether loading |subresource_url| as |subresource_type| should be
+  // disallowed according to |ruleset_matcher_|, using |load_decision_cache_|
+  // when possible.
+  bool ShouldDisallowResourceLoad(
+      const GURL& subresource_url,
+      url_pattern_index::proto::ElementType subresource_type);
+
   mojom::ActivationState activation_state_;
   const scoped_refptr<const MemoryMappedRuleset> ruleset_;
   const IndexedRulesetMatcher ruleset_matcher_;
@@ -80,6 +95,9 @@ class DocumentSubresourceFilter {
 
   mojom::DocumentLoadStatistics statistics_;
 
+  // Results of ShouldDisallowResourceLoad() for the current activation state.
+  base::MRUCache<LoadDecisionKey, bool> load_decision_cache_;
+
   DISALLOW_COPY_AND_ASSIGN(DocumentSubresourceFilter);
 };
 
@@ -152,6 +152,31 @@ TEST_F(DocumentSubresourceFilterTest, Enabled) {
   test_impl(false /* measure_performance */);
 }
 
+TEST_F(DocumentSubresourceFilterTest, RepeatedLoads) {
+  mojom::ActivationState activation_state;
+  activation_state.activation_level = kDryRun;
+  DocumentSubresourceFilter filter(url::Origin(), activation_state, ruleset());
+
+  // Repeated loads get the same policy and are counted every time.
+  for (int i = 0; i < 2; ++i) {
+    EXPECT_EQ(LoadPolicy::WOULD_DISALLOW,
+              filter.GetLoadPolicy(GURL(kTestAlphaURL), kImageType));
+    EXPECT_EQ(LoadPolicy::ALLOW,
+              filter.GetLoadPolicy(GURL(kTestBetaURL), kImageType));
+  }
+
+  activation_state.activation_level = kEnabled;
+  filter.set_activation_state(activation_state);
+  EXPECT_EQ(LoadPolicy::DISALLOW,
+            filter.GetLoadPolicy(GURL(kTestAlphaURL), kImageType));
+
+  const auto& statistics = filter.statistics();
+  EXPECT_EQ(5, statistics.num_loads_total);
+  EXPECT_EQ(5, statistics.num_loads_evaluated);
+  EXPECT_EQ(3, statistics.num_loads_matching_rules);
+  EXPECT_EQ(1, statistics.num_loads_disallowed);
+}
+
 TEST_F(DocumentSubresourceFilterTest, MatchingRuleEnabled) {
   mojom::ActivationState activation_state;
   activation_state.activation_level = kEnabled;
@@ -0,0 +1,137 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "components/sync_bookmarks/bookmark_model_merger.h"
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "base/strings/string_number_conversions.h"
+#include "base/strings/utf_string_conversions.h"
+#include "base/time/time.h"
+#include "components/bookmarks/browser/bookmark_model.h"
+#include "components/bookmarks/browser/titled_url_match.h"
+#include "components/bookmarks/test/test_bookmark_client.h"
+#include "components/favicon/core/test/mock_favicon_service.h"
+#include "components/sync/base/unique_position.h"
+#include "components/sync_bookmarks/synced_bookmark_tracker.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "testing/perf/perf_test.h"
+
+namespace sync_bookmarks {
+
+namespace {
+
+constexpr int kNumFolders = 500;
+constexpr int kBookmarksPerFolder = 100;
+
+const char kBookmarkBarId[] = "bookmark_bar_id";
+const char kBookmarkBarTag[] = "bookmark_bar";
+
+std::unique_ptr<syncer::UpdateResponseData> CreateUpdateResponseData(
+    const std::string& server_id,
+    const std::string& parent_id,
+    const std::string& title,
+    const std::string& url,
+    bool is_folder,
+    const syncer::UniquePosition& unique_position) {
+  auto data = std::make_unique<syncer::EntityData>();
+  data->id = server_id;
+  data->parent_id = parent_id;
+  data->unique_position = unique_position.ToProto();
+
+  sync_pb::BookmarkSpecifics* bookmark_specifics =
+      data->specifics.mutable_bookmark();
+  bookmark_specifics->set_title(title);
+  bookmark_specifics->set_url(url);
+
+  data->is_folder = is_folder;
+  auto response_data = std::make_unique<syncer::UpdateResponseData>();
+  response_data->entity = std::move(data);
+  response_data->response_version = 0;
+  return response_data;
+}
+
+std::unique_ptr<syncer::UpdateResponseData> CreateBookmarkBarNodeUpdateData() {
+  auto data = std::make_unique<syncer::EntityData>();
+  data->id = kBookmarkBarId;
+  data->server_defined_unique_tag = kBookmarkBarTag;
+
+  data->specifics.mutable_bookmark();
+
+  auto response_data = std::make_unique<syncer::UpdateResponseData>();
+  response_data->entity = std::move(data);
+  response_data->response_version = 0;
+  return response_data;
+}
+
+// Returns the updates of an initial sync of |kNumFolders| folders holding
+// |kBookmarksPerFolder| bookmarks each, all under the bookmark bar. Titles and
+// URLs share common words, as real bookmarks do.
+syncer::UpdateResponseDataList CreateInitialSyncUpdates() {
+  const std::string suffix = syncer::UniquePosition::RandomSuffix();
+  syncer::UpdateResponseDataList updates;
+  updates.push_back(CreateBookmarkBarNodeUpdateData());
+
+  syncer::UniquePosition folder_position =
+      syncer::UniquePosition::InitialPosition(suffix);
+  for (int i = 0; i < kNumFolders; ++i) {
+    const std::string folder_id = "folder" + base::NumberToString(i);
+    updates.push_back(CreateUpdateResponseData(
+        folder_id, kBookmarkBarId, "Folder " + base::NumberToString(i),
+        /*url=*/std::string(), /*is_folder=*/true, folder_position));
+    folder_position = syncer::UniquePosition::After(folder_position, suffix);
+
+    syncer::UniquePosition position =
+        syncer::UniquePosition::InitialPosition(suffix);
+    for (int j = 0; j < kBookmarksPerFolder; ++j) {
+      const std::string n = base::NumberToString(i * kBookmarksPerFolder + j);
+      updates.push_back(CreateUpdateResponseData(
+          "url" + n, folder_id, "Page " + n + " - Example News",
+          "https://www.example" + n + ".com/news/index.html",
+          /*is_folder=*/false, position));
+      position = syncer::UniquePosition::After(position, suffix);
+    }
+  }
+  return updates;
+}
+
+}  // namespace
+
+TEST(BookmarkModelMergerPerfTest, LargeInitialSync) {
+  syncer::UpdateResponseDataList updates = CreateInitialSyncUpdates();
+  std::unique_ptr<bookmarks::BookmarkModel> bookmark_model =
+      bookmarks::TestBookmarkClient::CreateModel();
+  SyncedBookmarkTracker tracker(std::vector<NodeMetadataPair>(),
+                                std::make_unique<sync_pb::ModelTypeState>());
+  testing::NiceMock<favicon::MockFaviconService> favicon_service;
+
+  // Mirrors BookmarkModelTypeProcessor, which applies remote updates as
+  // extensive changes.
+  base::TimeTicks start = base::TimeTicks::Now();
+  bookmark_model->BeginExtensiveChanges();
+  BookmarkModelMerger(&updates, bookmark_model.get(), &favicon_service,
+                      &tracker)
+      .Merge();
+  bookmark_model->EndExtensiveChanges();
+  const base::TimeDelta merge_time = base::TimeTicks::Now() - start;
+
+  ASSERT_EQ(kNumFolders, bookmark_model->bookmark_bar_node()->child_count());
+
+  start = base::TimeTicks::Now();
+  std::vector<bookmarks::TitledUrlMatch> matches;
+  bookmark_model->GetBookmarksMatching(base::ASCIIToUTF16("example news"),
+                                       /*max_count=*/10, &matches);
+  const base::TimeDelta query_time = base::TimeTicks::Now() - start;
+  EXPECT_EQ(10u, matches.size());
+
+  perf_test::PrintResult("BookmarkModelMerger", "", "initial_sync",
+                         merge_time.InMillisecondsF(), "ms", true);
+  perf_test::PrintResult("BookmarkModelMerger", "", "first_query",
+                         query_time.InMillisecondsF(), "ms", true);
+}
+
+}  // namespace sync_bookmarks
@@ -56,6 +56,11 @@ class Configurator : public base::RefCountedThreadSafe<Configurator> {
   // components.
   virtual int UpdateDelay() const = 0;
 
+  // The maximum number of components which are downloaded and installed at
+  // the same time within one update. The components share the delay
+  // between updates returned by UpdateDelay().
+  virtual int MaxParallelUpdates() const = 0;
+
   // The URLs for the update checks. The URLs are tried in order, the first one
   // that succeeds wins.
   virtual std::vector<GURL> UpdateUrl() const = 0;
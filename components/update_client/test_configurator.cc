@@ -39,6 +39,7 @@ TestConfigurator::TestConfigurator()
     : brand_("TEST"),
       initial_time_(0),
       ondemand_time_(0),
+      max_parallel_updates_(1),
       enabled_cup_signing_(false),
       enabled_component_updates_(true),
       unzip_factory_(base::MakeRefCounted<update_client::UnzipChromiumFactory>(
@@ -77,6 +78,10 @@ int TestConfigurator::UpdateDelay() const {
   return 1;
 }
 
+int TestConfigurator::MaxParallelUpdates() const {
+  return max_parallel_updates_;
+}
+
 std::vector<GURL> TestConfigurator::UpdateUrl() const {
   if (!update_check_url_.is_empty())
     return std::vector<GURL>(1, update_check_url_);
@@ -166,6 +171,10 @@ void TestConfigurator::SetInitialDelay(int seconds) {
   initial_time_ = seconds;
 }
 
+void TestConfigurator::SetMaxParallelUpdates(int max_parallel_updates) {
+  max_parallel_updates_ = max_parallel_updates;
+}
+
 void TestConfigurator::SetEnabledCupSigning(bool enabled_cup_signing) {
   enabled_cup_signing_ = enabled_cup_signing;
 }
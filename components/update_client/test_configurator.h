@@ -79,6 +79,7 @@ class TestConfigurator : public Configurator {
   int NextCheckDelay() const override;
   int OnDemandDelay() const override;
   int UpdateDelay() const override;
+  int MaxParallelUpdates() const override;
   std::vector<GURL> UpdateUrl() const override;
   std::vector<GURL> PingUrl() const override;
   std::string GetProdId() const override;
@@ -108,6 +109,7 @@ class TestConfigurator : public Configurator {
   void SetBrand(const std::string& brand);
   void SetOnDemandTime(int seconds);
   void SetInitialDelay(int seconds);
+  void SetMaxParallelUpdates(int max_parallel_updates);
   void SetDownloadPreference(const std::string& download_preference);
   void SetEnabledCupSigning(bool use_cup_signing);
   void SetEnabledComponentUpdates(bool enabled_component_updates);
@@ -127,6 +129,7 @@ class TestConfigurator : public Configurator {
   std::string brand_;
   int initial_time_;
   int ondemand_time_;
+  int max_parallel_updates_;
   std::string download_preference_;
   bool enabled_cup_signing_;
   bool enabled_component_updates_;
@@ -42,7 +42,8 @@ CrxUpdateItem::~CrxUpdateItem() = default;
 CrxUpdateItem::CrxUpdateItem(const CrxUpdateItem& other) = default;
 
 CrxComponent::CrxComponent()
-    : allows_background_download(true),
+    : update_priority(0),
+      allows_background_download(true),
       requires_network_encryption(true),
       crx_format_requirement(
           crx_file::VerifierFormat::CRX3_WITH_PUBLISHER_PROOF),
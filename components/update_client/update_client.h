@@ -238,6 +238,11 @@ struct CrxComponent {
   // match ^[-.,;+_=a-zA-Z0-9]{0,256}$ .
   InstallerAttributes installer_attributes;
 
+  // Components with a higher priority are downloaded and installed first when
+  // updates are available for several components at once. The default for
+  // this value is 0.
+  int update_priority;
+
   // Specifies that the CRX can be background-downloaded in some cases.
   // The default for this value is |true|.
   bool allows_background_download;
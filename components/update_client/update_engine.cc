@@ -286,7 +286,17 @@ void UpdateEngine::UpdateCheckComplete(
   DCHECK(thread_checker_.CalledOnValidThread());
   DCHECK(update_context);
 
-  for (const auto& id : update_context->components_to_check_for_updates)
+  // Components with the same priority are handled in the order specified by
+  // the caller.
+  std::vector<std::string> ids =
+      update_context->components_to_check_for_updates;
+  const auto& components = update_context->components;
+  std::stable_sort(ids.begin(), ids.end(),
+                   [&components](const std::string& a, const std::string& b) {
+                     return components.at(a)->crx_component()->update_priority >
+                            components.at(b)->crx_component()->update_priority;
+                   });
+  for (const auto& id : ids)
     update_context->component_queue.push(id);
 
   base::ThreadTaskRunnerHandle::Get()->PostTask(
@@ -302,6 +312,10 @@ void UpdateEngine::HandleComponent(
   auto& queue = update_context->component_queue;
 
   if (queue.empty()) {
+    // The last component in progress calls this function again when done.
+    if (update_context->num_components_in_progress)
+      return;
+
     const Error error = update_context->update_check_error
                             ? Error::UPDATE_CHECK_ERROR
                             : Error::NONE;
@@ -313,56 +327,93 @@ void UpdateEngine::HandleComponent(
     return;
   }
 
-  const auto& id = queue.front();
-  DCHECK_EQ(1u, update_context->components.count(id));
-  const auto& component = update_context->components.at(id);
-  DCHECK(component);
+  if (update_context->is_waiting_for_update_delay)
+    return;
 
-  auto& next_update_delay = update_context->next_update_delay;
-  if (!next_update_delay.is_zero() && component->IsUpdateAvailable()) {
-    base::ThreadTaskRunnerHandle::Get()->PostDelayedTask(
-        FROM_HERE,
-        base::BindOnce(&UpdateEngine::HandleComponent, base::Unretained(this),
-                       update_context),
-        next_update_delay);
-    next_update_delay = base::TimeDelta();
+  const size_t max_parallel_updates =
+      std::max(1, config_->MaxParallelUpdates());
+  while (!queue.empty() &&
+         update_context->num_components_in_progress < max_parallel_updates) {
+    const std::string id = queue.front();
+    DCHECK_EQ(1u, update_context->components.count(id));
+    const auto& component = update_context->components.at(id);
+    DCHECK(component);
+
+    auto& next_update_delay = update_context->next_update_delay;
+    if (!next_update_delay.is_zero() && component->IsUpdateAvailable()) {
+      update_context->is_waiting_for_update_delay = true;
+      base::ThreadTaskRunnerHandle::Get()->PostDelayedTask(
+          FROM_HERE,
+          base::BindOnce(&UpdateEngine::UpdateDelayElapsed,
+                         base::Unretained(this), update_context),
+          next_update_delay);
+      next_update_delay = base::TimeDelta();
+
+      notify_observers_callback_.Run(
+          UpdateClient::Observer::Events::COMPONENT_WAIT, id);
+      return;
+    }
 
-    notify_observers_callback_.Run(
-        UpdateClient::Observer::Events::COMPONENT_WAIT, id);
-    return;
+    queue.pop();
+    ++update_context->num_components_in_progress;
+    HandleComponentState(update_context, id);
   }
+}
+
+void UpdateEngine::HandleComponentState(
+    scoped_refptr<UpdateContext> update_context,
+    const std::string& id) {
+  DCHECK(thread_checker_.CalledOnValidThread());
+  DCHECK(update_context);
+
+  DCHECK_EQ(1u, update_context->components.count(id));
+  const auto& component = update_context->components.at(id);
+  DCHECK(component);
 
   component->Handle(base::BindOnce(&UpdateEngine::HandleComponentComplete,
-                                   base::Unretained(this), update_context));
+                                   base::Unretained(this), update_context, id));
 }
 
 void UpdateEngine::HandleComponentComplete(
-    scoped_refptr<UpdateContext> update_context) {
+    scoped_refptr<UpdateContext> update_context,
+    const std::string& id) {
   DCHECK(thread_checker_.CalledOnValidThread());
   DCHECK(update_context);
 
-  auto& queue = update_context->component_queue;
-  DCHECK(!queue.empty());
-
-  const auto& id = queue.front();
   DCHECK_EQ(1u, update_context->components.count(id));
   const auto& component = update_context->components.at(id);
   DCHECK(component);
 
-  if (component->IsHandled()) {
-    update_context->next_update_delay = component->GetUpdateDuration();
+  if (!component->IsHandled()) {
+    base::ThreadTaskRunnerHandle::Get()->PostTask(
+        FROM_HERE,
+        base::BindOnce(&UpdateEngine::HandleComponentState,
+                       base::Unretained(this), update_context, id));
+    return;
+  }
 
-    if (!component->events().empty()) {
-      ping_manager_->SendPing(*component,
-                              base::BindOnce([](int, const std::string&) {}));
-    }
+  update_context->next_update_delay = component->GetUpdateDuration();
 
-    queue.pop();
+  if (!component->events().empty()) {
+    ping_manager_->SendPing(*component,
+                            base::BindOnce([](int, const std::string&) {}));
   }
 
-  base::ThreadTaskRunnerHandle::Get()->PostTask(
-      FROM_HERE, base::BindOnce(&UpdateEngine::HandleComponent,
-                                base::Unretained(this), update_context));
+  DCHECK_GT(update_context->num_components_in_progress, 0u);
+  --update_context->num_components_in_progress;
+
+  // Called synchronously so that only the last component to complete sees an
+  // empty queue with no components in progress.
+  HandleComponent(update_context);
+}
+
+void UpdateEngine::UpdateDelayElapsed(
+    scoped_refptr<UpdateContext> update_context) {
+  DCHECK(thread_checker_.CalledOnValidThread());
+  DCHECK(update_context);
+
+  update_context->is_waiting_for_update_delay = false;
+  HandleComponent(update_context);
 }
 
 void UpdateEngine::UpdateComplete(scoped_refptr<UpdateContext> update_context,
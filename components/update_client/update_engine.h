@@ -35,8 +35,9 @@ class Configurator;
 struct UpdateContext;
 
 // Handles updates for a group of components. Updates for different groups
-// are run concurrently but within the same group of components, updates are
-// applied one at a time.
+// are run concurrently. Within the same group of components, updates are
+// applied in priority order, up to Configurator::MaxParallelUpdates() at a
+// time.
 class UpdateEngine : public base::RefCounted<UpdateEngine> {
  public:
   using Callback = base::OnceCallback<void(Error error)>;
@@ -89,8 +90,14 @@ class UpdateEngine : public base::RefCounted<UpdateEngine> {
       int error,
       int retry_after_sec);
 
+  // Starts handling the components in the queue, as long as the number of
+  // components in progress is below the limit.
   void HandleComponent(scoped_refptr<UpdateContext> update_context);
-  void HandleComponentComplete(scoped_refptr<UpdateContext> update_context);
+  void HandleComponentState(scoped_refptr<UpdateContext> update_context,
+                            const std::string& id);
+  void HandleComponentComplete(scoped_refptr<UpdateContext> update_context,
+                               const std::string& id);
+  void UpdateDelayElapsed(scoped_refptr<UpdateContext> update_context);
 
   // Returns true if the update engine rejects this update call because it
   // occurs too soon.
@@ -174,16 +181,23 @@ struct UpdateContext : public base::RefCounted<UpdateContext> {
   size_t num_components_ready_to_check = 0;
   size_t num_components_checked = 0;
 
-  // Contains the ids of the components that the state machine must handle.
+  // Contains the ids of the components that the state machine must handle
+  // and that have not been started yet.
   base::queue<std::string> component_queue;
 
+  // The number of components started but not handled yet.
+  size_t num_components_in_progress = 0;
+
   // The time to wait before handling the update for a component.
   // The wait time is proportional with the cost incurred by updating
   // the component. The more time it takes to download and apply the
-  // update for the current component, the longer the wait until the engine
-  // is handling the next component in the queue.
+  // update for the last completed component, the longer the wait until the
+  // engine is handling the next component in the queue.
   base::TimeDelta next_update_delay;
 
+  // True while the engine waits for |next_update_delay| to elapse.
+  bool is_waiting_for_update_delay = false;
+
   // The unique session id of this context. The session id is serialized in
   // every protocol request. It is also used as a key in various data stuctures
   // to uniquely identify an update context.
@@ -7,6 +7,7 @@
 #include <stddef.h>
 
 #include <algorithm>
+#include <limits>
 #include <queue>
 
 #include "base/containers/queue.h"
@@ -116,16 +117,20 @@ bool SubstringSetMatcher::Match(const std::string& text,
 
   uint32_t current_node = 0;
   for (std::string::const_iterator i = text.begin(); i != text.end(); ++i) {
-    uint32_t edge_from_current = tree_[current_node].GetEdge(*i);
+    uint32_t edge_from_current = GetEdge(current_node, *i);
     while (edge_from_current == AhoCorasickNode::kNoSuchEdge &&
            current_node != 0) {
       current_node = tree_[current_node].failure();
-      edge_from_current = tree_[current_node].GetEdge(*i);
+      edge_from_current = GetEdge(current_node, *i);
     }
     if (edge_from_current != AhoCorasickNode::kNoSuchEdge) {
       current_node = edge_from_current;
-      matches->insert(tree_[current_node].matches().begin(),
-                      tree_[current_node].matches().end());
+      // Report the patterns ending here and at the nodes on the failure path.
+      for (uint32_t node = current_node; node != AhoCorasickNode::kNoSuchEdge;
+           node = tree_[node].output_link()) {
+        matches->insert(tree_[node].matches().begin(),
+                        tree_[node].matches().end());
+      }
     } else {
       DCHECK_EQ(0u, current_node);
     }
@@ -154,6 +159,11 @@ void SubstringSetMatcher::RebuildAhoCorasickTree(
   }
 
   CreateFailureEdges();
+
+  root_edges_.assign(std::numeric_limits<unsigned char>::max() + 1,
+                     AhoCorasickNode::kNoSuchEdge);
+  for (const auto& edge : tree_[0].edges())
+    root_edges_[static_cast<unsigned char>(edge.first)] = edge.second;
 }
 
 void SubstringSetMatcher::InsertPatternIntoAhoCorasickTree(
@@ -221,7 +231,12 @@ void SubstringSetMatcher::CreateFailureEdges() {
           edge_from_failure != AhoCorasickNode::kNoSuchEdge ? edge_from_failure
                                                             : 0;
       tree_[leads_to].set_failure(follow_in_case_of_failure);
-      tree_[leads_to].AddMatches(tree_[follow_in_case_of_failure].matches());
+      // The root's matches are reported once per Match() call instead.
+      const AhoCorasickNode& failure_node = tree_[follow_in_case_of_failure];
+      if (follow_in_case_of_failure != 0 && !failure_node.matches().empty())
+        tree_[leads_to].set_output_link(follow_in_case_of_failure);
+      else
+        tree_[leads_to].set_output_link(failure_node.output_link());
     }
   }
 }
@@ -229,7 +244,7 @@ void SubstringSetMatcher::CreateFailureEdges() {
 const uint32_t SubstringSetMatcher::AhoCorasickNode::kNoSuchEdge = 0xFFFFFFFF;
 
 SubstringSetMatcher::AhoCorasickNode::AhoCorasickNode()
-    : failure_(kNoSuchEdge) {}
+    : failure_(kNoSuchEdge), output_link_(kNoSuchEdge) {}
 
 SubstringSetMatcher::AhoCorasickNode::~AhoCorasickNode() {}
 
@@ -237,6 +252,7 @@ SubstringSetMatcher::AhoCorasickNode::AhoCorasickNode(
     const SubstringSetMatcher::AhoCorasickNode& other)
     : edges_(other.edges_),
       failure_(other.failure_),
+      output_link_(other.output_link_),
       matches_(other.matches_) {}
 
 SubstringSetMatcher::AhoCorasickNode&
@@ -244,6 +260,7 @@ SubstringSetMatcher::AhoCorasickNode::operator=(
     const SubstringSetMatcher::AhoCorasickNode& other) {
   edges_ = other.edges_;
   failure_ = other.failure_;
+  output_link_ = other.output_link_;
   matches_ = other.matches_;
   return *this;
 }
@@ -258,12 +275,7 @@ void SubstringSetMatcher::AhoCorasickNode::SetEdge(char c, uint32_t node) {
 }
 
 void SubstringSetMatcher::AhoCorasickNode::AddMatch(StringPattern::ID id) {
-  matches_.insert(id);
-}
-
-void SubstringSetMatcher::AhoCorasickNode::AddMatches(
-    const SubstringSetMatcher::AhoCorasickNode::Matches& matches) {
-  matches_.insert(matches.begin(), matches.end());
+  matches_.push_back(id);
 }
 
 }  // namespace url_matcher
@@ -13,6 +13,7 @@
 #include <string>
 #include <vector>
 
+#include "base/containers/flat_map.h"
 #include "base/macros.h"
 #include "components/url_matcher/string_pattern.h"
 #include "components/url_matcher/url_matcher_export.h"
@@ -81,11 +82,17 @@ class URL_MATCHER_EXPORT SubstringSetMatcher {
   // If your brain thinks "Forget it, let's go shopping.", don't worry.
   // Take a nap and read an introductory text on the Aho Corasick algorithm.
   // It will make sense. Eventually.
+  //
+  // Rather than copying the matches of every node on the failure path into
+  // each node, a node only stores the IDs of the patterns ending exactly at it
+  // plus an output link to the closest node on its failure path that has
+  // matches of its own. This keeps the tree small for large pattern sets.
   class AhoCorasickNode {
    public:
     // Key: label of the edge, value: node index in |tree_| of parent class.
-    typedef std::map<char, uint32_t> Edges;
-    typedef std::set<StringPattern::ID> Matches;
+    // Most nodes have very few edges, so these are kept in a sorted vector.
+    typedef base::flat_map<char, uint32_t> Edges;
+    typedef std::vector<StringPattern::ID> Matches;
 
     static const uint32_t kNoSuchEdge;  // Represents an invalid node index.
 
@@ -101,8 +108,10 @@ class URL_MATCHER_EXPORT SubstringSetMatcher {
     uint32_t failure() const { return failure_; }
     void set_failure(uint32_t failure) { failure_ = failure; }
 
+    uint32_t output_link() const { return output_link_; }
+    void set_output_link(uint32_t node) { output_link_ = node; }
+
     void AddMatch(StringPattern::ID id);
-    void AddMatches(const Matches& matches);
     const Matches& matches() const { return matches_; }
 
    private:
@@ -112,7 +121,11 @@ class URL_MATCHER_EXPORT SubstringSetMatcher {
     // Node index that failure edge leads to.
     uint32_t failure_;
 
-    // Identifiers of matches.
+    // Index of the closest node other than the root on the failure path that
+    // has matches, or kNoSuchEdge.
+    uint32_t output_link_;
+
+    // Identifiers of the patterns ending at this node.
     Matches matches_;
   };
 
@@ -128,6 +141,13 @@ class URL_MATCHER_EXPORT SubstringSetMatcher {
   void InsertPatternIntoAhoCorasickTree(const StringPattern* pattern);
   void CreateFailureEdges();
 
+  // Returns the node reached from |node| with label |c|, or kNoSuchEdge. The
+  // root is looked up in |root_edges_|, as matching returns to it often.
+  uint32_t GetEdge(uint32_t node, char c) const {
+    return node == 0 ? root_edges_[static_cast<unsigned char>(c)]
+                     : tree_[node].GetEdge(c);
+  }
+
   // Set of all registered StringPatterns. Used to regenerate the
   // Aho-Corasick tree in case patterns are registered or unregistered.
   SubstringPatternMap patterns_;
@@ -135,6 +155,9 @@ class URL_MATCHER_EXPORT SubstringSetMatcher {
   // The nodes of a Aho-Corasick tree.
   std::vector<AhoCorasickNode> tree_;
 
+  // Dense copy of the root's edges, indexed by label.
+  std::vector<uint32_t> root_edges_;
+
   DISALLOW_COPY_AND_ASSIGN(SubstringSetMatcher);
 };
 
@@ -0,0 +1,72 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "components/url_matcher/substring_set_matcher.h"
+
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "base/strings/string_number_conversions.h"
+#include "base/time/time.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "testing/perf/perf_test.h"
+
+namespace url_matcher {
+
+namespace {
+
+constexpr int kNumPatterns = 100000;
+constexpr int kNumTexts = 10000;
+
+// Returns a host-like pattern, similar to those from content settings and
+// extension URL filters.
+std::string MakePattern(int i) {
+  return "." + base::NumberToString(i * 7919 % 1000003) + "-site.example.com/";
+}
+
+}  // namespace
+
+TEST(SubstringSetMatcherPerfTest, LargePatternSet) {
+  std::vector<std::unique_ptr<StringPattern>> patterns;
+  std::vector<const StringPattern*> pattern_ptrs;
+  for (int i = 0; i < kNumPatterns; ++i) {
+    patterns.push_back(std::make_unique<StringPattern>(MakePattern(i), i));
+    pattern_ptrs.push_back(patterns.back().get());
+  }
+
+  // Half of the texts contain a registered pattern.
+  std::vector<std::string> texts;
+  for (int i = 0; i < kNumTexts; ++i) {
+    texts.push_back("https://www" +
+                    MakePattern(i % 2 ? i * 3 : kNumPatterns + i) +
+                    "path/to/some/resource.html?query=" +
+                    base::NumberToString(i));
+  }
+
+  SubstringSetMatcher matcher;
+  base::TimeTicks start = base::TimeTicks::Now();
+  matcher.RegisterPatterns(pattern_ptrs);
+  const base::TimeDelta register_time = base::TimeTicks::Now() - start;
+
+  size_t num_matches = 0;
+  start = base::TimeTicks::Now();
+  for (const std::string& text : texts) {
+    std::set<StringPattern::ID> matches;
+    matcher.Match(text, &matches);
+    num_matches += matches.size();
+  }
+  const base::TimeDelta match_time = base::TimeTicks::Now() - start;
+  EXPECT_EQ(static_cast<size_t>(kNumTexts / 2), num_matches);
+
+  perf_test::PrintResult("SubstringSetMatcher", "", "register",
+                         register_time.InMillisecondsF(), "ms", true);
+  perf_test::PrintResult(
+      "SubstringSetMatcher", "", "match",
+      match_time.InMicroseconds() / static_cast<double>(kNumTexts), "us/text",
+      true);
+}
+
+}  // namespace url_matcher
@@ -123,6 +123,28 @@ TEST(SubstringSetMatcherTest, TestMatcher) {
   TestTwoPatterns("abcde", std::string(), "abcdef", true, false);
 }
 
+TEST(SubstringSetMatcherTest, MatchesAlongFailurePath) {
+  // Every pattern is a suffix of the next one, so matching "xabcd" has to
+  // report all of them through the failure path of the deepest node.
+  StringPattern pattern_1("d", 1);
+  StringPattern pattern_2("cd", 2);
+  StringPattern pattern_3("abcd", 3);
+  StringPattern pattern_4("xabcd", 4);
+  StringPattern pattern_5("bce", 5);
+  std::vector<const StringPattern*> patterns = {
+      &pattern_1, &pattern_2, &pattern_3, &pattern_4, &pattern_5};
+  SubstringSetMatcher matcher;
+  matcher.RegisterPatterns(patterns);
+
+  std::set<int> matches;
+  EXPECT_TRUE(matcher.Match("xabcd", &matches));
+  EXPECT_EQ(std::set<int>({1, 2, 3, 4}), matches);
+
+  matches.clear();
+  EXPECT_TRUE(matcher.Match("abce", &matches));
+  EXPECT_EQ(std::set<int>({5}), matches);
+}
+
 TEST(SubstringSetMatcherTest, RegisterAndRemove) {
   SubstringSetMatcher matcher;
 
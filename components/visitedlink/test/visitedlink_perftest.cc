@@ -77,6 +77,20 @@ class DummyVisitedLinkEventListener : public VisitedLinkMaster::Listener {
   void Reset(bool invalidate_hashes) override {}
 };
 
+// Counts the tables handed out to slaves, i.e. how often the table is
+// resized.
+class NewTableCountingListener : public DummyVisitedLinkEventListener {
+ public:
+  explicit NewTableCountingListener(int* new_table_count)
+      : new_table_count_(new_table_count) {}
+  void NewTable(base::ReadOnlySharedMemoryRegion*) override {
+    ++*new_table_count_;
+  }
+
+ private:
+  int* new_table_count_;
+};
+
 
 // this checks IsVisited for the URLs starting with the given prefix and
 // within the given range
@@ -139,6 +153,42 @@ TEST_F(VisitedLink, TestAddAndQuery) {
   CheckVisited(master, unadded_prefix, 0, add_count);
 }
 
+// Tests how long the adds that grow the table block for, starting from a small
+// table. While the table is rebuilt, slaves can't use it until they receive
+// the new one, so the longest of these is what a user with a big history
+// would notice.
+TEST_F(VisitedLink, TestResize) {
+  int new_table_count = 0;
+  VisitedLinkMaster master(new NewTableCountingListener(&new_table_count),
+                           nullptr, false, true, db_path_, 0);
+  ASSERT_TRUE(master.Init());
+  content::RunAllTasksUntilIdle();
+  new_table_count = 0;
+
+  TimeDelta total_resize_time;
+  TimeDelta max_resize_time;
+  for (int i = 0; i < load_test_add_count; i++) {
+    int previous_new_table_count = new_table_count;
+    base::ElapsedTimer add_timer;
+    master.AddURL(TestURL(added_prefix, i));
+    TimeDelta elapsed = add_timer.Elapsed();
+    if (new_table_count == previous_new_table_count)
+      continue;
+    total_resize_time += elapsed;
+    max_resize_time = std::max(max_resize_time, elapsed);
+  }
+  ASSERT_GT(new_table_count, 0);
+
+  perf_test::PrintResult("Visited_link_resize_count", std::string(),
+                         std::string(), new_table_count, "count", true);
+  perf_test::PrintResult("Visited_link_total_resize_time", std::string(),
+                         std::string(), total_resize_time.InMillisecondsF(),
+                         "ms", true);
+  perf_test::PrintResult("Visited_link_max_resize_time", std::string(),
+                         std::string(), max_resize_time.InMillisecondsF(), "ms",
+                         true);
+}
+
 // Tests how long it takes to write and read a large database to and from disk.
 // Flaky, see crbug.com/822308.
 TEST_F(VisitedLink, DISABLED_TestLoad) {
@@ -24,6 +24,8 @@ std::vector<OverlayStrategy> ParseOverlayStategies(
       strategies.push_back(OverlayStrategy::kUnderlay);
     } else if (strategy_name == "cast") {
       strategies.push_back(OverlayStrategy::kUnderlayCast);
+    } else if (strategy_name == "multiple") {
+      strategies.push_back(OverlayStrategy::kMultiple);
     } else {
       LOG(ERROR) << "Unrecognized overlay strategy " << strategy_name;
     }
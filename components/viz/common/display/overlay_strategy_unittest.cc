@@ -22,12 +22,14 @@ TEST(ParseOverlayStrategiesTest, ParseEmptyList) {
 
 TEST(ParseOverlayStrategiesTest, ParseFullList) {
   std::vector<OverlayStrategy> strategies =
-      ParseOverlayStategies("single-fullscreen,single-on-top,underlay,cast");
+      ParseOverlayStategies(
+          "single-fullscreen,single-on-top,underlay,cast,multiple");
 
   EXPECT_THAT(strategies, UnorderedElementsAre(OverlayStrategy::kFullscreen,
                                                OverlayStrategy::kSingleOnTop,
                                                OverlayStrategy::kUnderlay,
-                                               OverlayStrategy::kUnderlayCast));
+                                               OverlayStrategy::kUnderlayCast,
+                                               OverlayStrategy::kMultiple));
 }
 
 TEST(ParseOverlayStrategiesTest, BadValue) {
@@ -63,6 +63,19 @@ const base::Feature kUseSkiaRendererNonDDL{"UseSkiaRendererNonDDL",
 const base::Feature kRecordSkPicture{"RecordSkPicture",
                                      base::FEATURE_DISABLED_BY_DEFAULT};
 
+// Draw partially occluded quads as several quads covering only their visible
+// parts, when those don't form a rect.
+const base::Feature kSplitPartiallyOccludedQuads{
+    "SplitPartiallyOccludedQuads", base::FEATURE_DISABLED_BY_DEFAULT};
+
+// Reuse the aggregated render passes of undamaged embedded surfaces.
+const base::Feature kIncrementalSurfaceAggregation{
+    "IncrementalSurfaceAggregation", base::FEATURE_DISABLED_BY_DEFAULT};
+
+bool IsIncrementalSurfaceAggregationEnabled() {
+  return base::FeatureList::IsEnabled(kIncrementalSurfaceAggregation);
+}
+
 bool IsSurfaceSynchronizationEnabled() {
   auto* command_line = base::CommandLine::ForCurrentProcess();
   return IsVizDisplayCompositorEnabled() ||
@@ -141,4 +154,8 @@ bool IsRecordingSkPicture() {
          base::FeatureList::IsEnabled(kRecordSkPicture);
 }
 
+bool ShouldSplitPartiallyOccludedQuads() {
+  return base::FeatureList::IsEnabled(kSplitPartiallyOccludedQuads);
+}
+
 }  // namespace features
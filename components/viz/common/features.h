@@ -13,13 +13,16 @@ namespace features {
 
 VIZ_COMMON_EXPORT extern const base::Feature kEnableSurfaceSynchronization;
 VIZ_COMMON_EXPORT extern const base::Feature kEnableVizHitTest;
+VIZ_COMMON_EXPORT extern const base::Feature kIncrementalSurfaceAggregation;
 VIZ_COMMON_EXPORT extern const base::Feature kEnableVizHitTestDrawQuad;
 VIZ_COMMON_EXPORT extern const base::Feature kEnableVizHitTestSurfaceLayer;
 VIZ_COMMON_EXPORT extern const base::Feature kUseSkiaRenderer;
 VIZ_COMMON_EXPORT extern const base::Feature kUseSkiaRendererNonDDL;
 VIZ_COMMON_EXPORT extern const base::Feature kRecordSkPicture;
+VIZ_COMMON_EXPORT extern const base::Feature kSplitPartiallyOccludedQuads;
 VIZ_COMMON_EXPORT extern const base::Feature kVizDisplayCompositor;
 
+VIZ_COMMON_EXPORT bool IsIncrementalSurfaceAggregationEnabled();
 VIZ_COMMON_EXPORT bool IsSurfaceSynchronizationEnabled();
 VIZ_COMMON_EXPORT bool IsVizDisplayCompositorEnabled();
 VIZ_COMMON_EXPORT bool IsVizHitTestingDebugEnabled();
@@ -29,6 +32,7 @@ VIZ_COMMON_EXPORT bool IsVizHitTestingSurfaceLayerEnabled();
 VIZ_COMMON_EXPORT bool IsUsingSkiaRenderer();
 VIZ_COMMON_EXPORT bool IsUsingSkiaRendererNonDDL();
 VIZ_COMMON_EXPORT bool IsRecordingSkPicture();
+VIZ_COMMON_EXPORT bool ShouldSplitPartiallyOccludedQuads();
 
 }  // namespace features
 
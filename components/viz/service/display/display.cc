@@ -6,7 +6,10 @@
 
 #include <stddef.h>
 #include <limits>
+#include <vector>
 
+#include "base/containers/adapters.h"
+#include "base/containers/flat_map.h"
 #include "base/debug/dump_without_crashing.h"
 #include "base/metrics/histogram_macros.h"
 #include "base/numerics/checked_math.h"
@@ -14,13 +17,18 @@
 #include "base/trace_event/trace_event.h"
 #include "build/build_config.h"
 #include "cc/base/math_util.h"
+#include "cc/base/region.h"
 #include "cc/base/simple_enclosed_region.h"
 #include "cc/benchmarks/benchmark_instrumentation.h"
 #include "components/viz/common/display/renderer_settings.h"
+#include "components/viz/common/features.h"
 #include "components/viz/common/frame_sinks/begin_frame_source.h"
 #include "components/viz/common/quads/compositor_frame.h"
 #include "components/viz/common/quads/draw_quad.h"
+#include "components/viz/common/quads/render_pass_draw_quad.h"
 #include "components/viz/common/quads/shared_quad_state.h"
+#include "components/viz/common/quads/solid_color_draw_quad.h"
+#include "components/viz/common/quads/tile_draw_quad.h"
 #include "components/viz/service/display/direct_renderer.h"
 #include "components/viz/service/display/display_client.h"
 #include "components/viz/service/display/display_scheduler.h"
@@ -115,6 +123,108 @@ gfx::RectF GetOccludingRectForRRectF(const gfx::RRectF& bounds) {
   return occluding_rect;
 }
 
+// Returns the rect in target space that the quads of |sqs| cover with opaque
+// content, or an empty rect if it's not known.
+gfx::Rect GetOccludingRectForSharedQuadState(const SharedQuadState* sqs) {
+  if (sqs->opacity != 1 || !sqs->are_contents_opaque ||
+      !sqs->quad_to_target_transform.Preserves2dAxisAlignment()) {
+    return gfx::Rect();
+  }
+
+  gfx::Rect sqs_rect_in_target =
+      cc::MathUtil::MapEnclosedRectWith2dAxisAlignedTransform(
+          sqs->quad_to_target_transform, sqs->visible_quad_layer_rect);
+
+  // If a rounded corner is being applied then the visible rect for the sqs is
+  // actually even smaller. Reduce the rect size to get a rounded corner
+  // adjusted occluding region.
+  if (!sqs->rounded_corner_bounds.IsEmpty()) {
+    sqs_rect_in_target.Intersect(gfx::ToEnclosedRect(
+        GetOccludingRectForRRectF(sqs->rounded_corner_bounds)));
+  }
+
+  if (sqs->is_clipped)
+    sqs_rect_in_target.Intersect(sqs->clip_rect);
+
+  return sqs_rect_in_target;
+}
+
+// Returns the rect in the space of |embedded_pass| that is occluded by what is
+// drawn in front of |pass_quad|, which draws it. |occlusion_in_target_space|
+// is the occlusion in front of |pass_quad|, not including the quads of
+// |last_sqs| that were visited last.
+gfx::Rect GetOcclusionForEmbeddedPass(
+    const RenderPassDrawQuad& pass_quad,
+    const RenderPass& embedded_pass,
+    const cc::SimpleEnclosedRegion& occlusion_in_target_space,
+    const SharedQuadState* last_sqs) {
+  // The whole output of a pass that is copied, cached, masked or filtered may
+  // be visible, and the pass must be drawn with its output rect mapping to the
+  // quad's rect as is.
+  if (!embedded_pass.filters.IsEmpty() ||
+      !embedded_pass.copy_requests.empty() ||
+      embedded_pass.cache_render_pass || pass_quad.mask_resource_id() ||
+      pass_quad.rect != embedded_pass.output_rect ||
+      pass_quad.tex_coord_rect.size() != gfx::SizeF(pass_quad.rect.size())) {
+    return gfx::Rect();
+  }
+
+  const gfx::Transform& transform =
+      pass_quad.shared_quad_state->quad_to_target_transform;
+  if (!transform.IsPositiveScaleOrTranslation())
+    return gfx::Rect();
+
+  cc::SimpleEnclosedRegion occlusion = occlusion_in_target_space;
+  if (last_sqs && last_sqs != pass_quad.shared_quad_state)
+    occlusion.Union(GetOccludingRectForSharedQuadState(last_sqs));
+  if (occlusion.IsEmpty())
+    return gfx::Rect();
+
+  gfx::Transform reverse_transform;
+  if (!transform.GetInverse(&reverse_transform))
+    return gfx::Rect();
+  return cc::MathUtil::MapEnclosedRectWith2dAxisAlignedTransform(
+      reverse_transform, occlusion.bounds());
+}
+
+// Returns true if |quad| can be drawn as several quads with parts of its
+// visible rect.
+bool CanSplitQuad(const DrawQuad& quad) {
+  return quad.material == DrawQuad::SOLID_COLOR ||
+         quad.material == DrawQuad::TILED_CONTENT;
+}
+
+template <typename QuadType>
+QuadList::Iterator SplitQuadOfType(
+    QuadList* quad_list,
+    QuadList::Iterator quad,
+    const std::vector<gfx::Rect>& visible_rects) {
+  // Inserting the quads invalidates |quad|, so copy it first.
+  QuadType copy = *QuadType::MaterialCast(*quad);
+  quad->visible_rect = visible_rects[0];
+  auto piece = quad_list->InsertAfterAndInvalidateAllPointers<QuadType>(
+      quad, visible_rects.size() - 1);
+  for (size_t i = 1; i < visible_rects.size(); ++i) {
+    QuadType* piece_quad = static_cast<QuadType*>(*piece);
+    *piece_quad = copy;
+    piece_quad->visible_rect = visible_rects[i];
+    ++piece;
+  }
+  return piece;
+}
+
+// Replaces |quad| with one quad for each of |visible_rects|, in place. Returns
+// the iterator following the last of them.
+QuadList::Iterator SplitQuad(QuadList* quad_list,
+                             QuadList::Iterator quad,
+                             const std::vector<gfx::Rect>& visible_rects) {
+  DCHECK(CanSplitQuad(**quad));
+  DCHECK(!visible_rects.empty());
+  if (quad->material == DrawQuad::SOLID_COLOR)
+    return SplitQuadOfType<SolidColorDrawQuad>(quad_list, quad, visible_rects);
+  return SplitQuadOfType<TileDrawQuad>(quad_list, quad, visible_rects);
+}
+
 }  // namespace
 
 Display::Display(
@@ -350,6 +460,8 @@ void Display::InitializeRenderer(bool enable_shared_images) {
       surface_manager_, resource_provider_.get(), output_partial_list,
       needs_surface_occluding_damage_rect));
   aggregator_->set_output_is_secure(output_is_secure_);
+  aggregator_->set_incremental_aggregation(
+      features::IsIncrementalSurfaceAggregationEnabled());
   aggregator_->SetOutputColorSpace(blending_color_space_, device_color_space_);
 }
 
@@ -691,9 +803,6 @@ void Display::RemoveOverdrawQuads(CompositorFrame* frame) {
   if (frame->render_pass_list.empty())
     return;
 
-  const SharedQuadState* last_sqs = nullptr;
-  cc::SimpleEnclosedRegion occlusion_in_target_space;
-  bool current_sqs_intersects_occlusion = false;
   int minimum_draw_occlusion_height =
       settings_.kMinimumDrawOcclusionSize.height() * device_scale_factor_;
   int minimum_draw_occlusion_width =
@@ -705,73 +814,96 @@ void Display::RemoveOverdrawQuads(CompositorFrame* frame) {
   // Total area not draw skipped by draw occlusion.
   base::CheckedNumeric<uint64_t> total_area_saved_in_px = 0;
 
-  for (const auto& pass : frame->render_pass_list) {
+  const bool split_partially_occluded_quads =
+      features::ShouldSplitPartiallyOccludedQuads();
+
+  base::flat_map<RenderPassId, const RenderPass*> passes_by_id;
+  for (const auto& pass : frame->render_pass_list)
+    passes_by_id[pass->id] = pass.get();
+
+  // The occlusion each render pass gets from what is drawn in front of its
+  // RenderPassDrawQuad, in the space of the pass. A pass is drawn before the
+  // passes that embed it, so walking the list backwards visits all of them
+  // before the pass itself.
+  base::flat_map<RenderPassId, gfx::Rect> occlusion_from_embedding_pass;
+
+  for (const auto& pass : base::Reversed(frame->render_pass_list)) {
     // TODO(yiyix): Add filter effects to draw occlusion calculation and perform
     // draw occlusion on render pass.
     if (!pass->filters.IsEmpty() || !pass->backdrop_filters.IsEmpty()) {
       for (auto* const quad : pass->quad_list) {
         total_quad_area_shown_wo_occlusion_px +=
             quad->visible_rect.size().GetCheckedArea();
+        // The filters may move pixels of the embedded passes, so they can't
+        // be occluded.
+        if (quad->material == ContentDrawQuadBase::Material::RENDER_PASS) {
+          occlusion_from_embedding_pass[RenderPassDrawQuad::MaterialCast(quad)
+                                            ->render_pass_id] = gfx::Rect();
+        }
       }
       continue;
     }
 
-    // TODO(yiyix): Perform draw occlusion inside the render pass with
-    // transparent background.
-    if (pass != frame->render_pass_list.back()) {
-      for (auto* const quad : pass->quad_list) {
-        total_quad_area_shown_wo_occlusion_px +=
-            quad->visible_rect.size().GetCheckedArea();
-      }
-      continue;
+    cc::SimpleEnclosedRegion occlusion_in_target_space;
+    auto occlusion_it = occlusion_from_embedding_pass.find(pass->id);
+    if (occlusion_it != occlusion_from_embedding_pass.end()) {
+      occlusion_in_target_space =
+          cc::SimpleEnclosedRegion(occlusion_it->second);
     }
-
-    auto quad_list_end = pass->quad_list.end();
+    const SharedQuadState* last_sqs = nullptr;
+    bool current_sqs_intersects_occlusion = false;
     gfx::Rect occlusion_in_quad_content_space;
-    for (auto quad = pass->quad_list.begin(); quad != quad_list_end;) {
+
+    for (auto quad = pass->quad_list.begin(); quad != pass->quad_list.end();) {
       total_quad_area_shown_wo_occlusion_px +=
           quad->visible_rect.size().GetCheckedArea();
 
       // Skip quad if it is a RenderPassDrawQuad because RenderPassDrawQuad is a
       // special type of DrawQuad where the visible_rect of shared quad state is
-      // not entirely covered by draw quads in it; or the DrawQuad size is
-      // smaller than the kMinimumDrawOcclusionSize; or the DrawQuad is inside
-      // a 3d objects.
-      if (quad->material == ContentDrawQuadBase::Material::RENDER_PASS ||
-          (quad->visible_rect.width() <= minimum_draw_occlusion_width &&
+      // not entirely covered by draw quads in it. What is in front of it can
+      // occlude the quads of the pass it draws instead.
+      if (quad->material == ContentDrawQuadBase::Material::RENDER_PASS) {
+        const auto* pass_quad = RenderPassDrawQuad::MaterialCast(*quad);
+        gfx::Rect occlusion_for_embedded_pass;
+        auto embedded_it = passes_by_id.find(pass_quad->render_pass_id);
+        if (embedded_it != passes_by_id.end()) {
+          const RenderPass& embedded_pass = *embedded_it->second;
+          if (!embedded_pass.backdrop_filters.IsEmpty()) {
+            // The backdrop filters read what is drawn behind the quad, so
+            // what is in front of the quad must not occlude it.
+            occlusion_in_target_space = cc::SimpleEnclosedRegion();
+            last_sqs = nullptr;
+          }
+          occlusion_for_embedded_pass = GetOcclusionForEmbeddedPass(
+              *pass_quad, embedded_pass, occlusion_in_target_space, last_sqs);
+        }
+        // A pass that is drawn more than once can only be occluded where all
+        // of its quads are, which isn't tracked.
+        auto result = occlusion_from_embedding_pass.emplace(
+            pass_quad->render_pass_id, occlusion_for_embedded_pass);
+        if (!result.second)
+          result.first->second = gfx::Rect();
+        ++quad;
+        continue;
+      }
+
+      // Skip quad if the DrawQuad size is smaller than the
+      // kMinimumDrawOcclusionSize; or the DrawQuad is inside a 3d objects.
+      if ((quad->visible_rect.width() <= minimum_draw_occlusion_width &&
            quad->visible_rect.height() <= minimum_draw_occlusion_height) ||
           quad->shared_quad_state->sorting_context_id != 0) {
         ++quad;
         continue;
       }
 
-      if (!last_sqs)
-        last_sqs = quad->shared_quad_state;
-
-      gfx::Transform transform =
+      const gfx::Transform& transform =
           quad->shared_quad_state->quad_to_target_transform;
 
       // TODO(yiyix): Find a rect interior to each transformed quad.
       if (last_sqs != quad->shared_quad_state) {
-        if (last_sqs->opacity == 1 && last_sqs->are_contents_opaque &&
-            last_sqs->quad_to_target_transform.Preserves2dAxisAlignment()) {
-          gfx::Rect sqs_rect_in_target =
-              cc::MathUtil::MapEnclosedRectWith2dAxisAlignedTransform(
-                  last_sqs->quad_to_target_transform,
-                  last_sqs->visible_quad_layer_rect);
-
-          // If a rounded corner is being applied then the visible rect for the
-          // sqs is actually even smaller. Reduce the rect size to get a
-          // rounded corner adjusted occluding region.
-          if (!last_sqs->rounded_corner_bounds.IsEmpty()) {
-            sqs_rect_in_target.Intersect(gfx::ToEnclosedRect(
-                GetOccludingRectForRRectF(last_sqs->rounded_corner_bounds)));
-          }
-
-          if (last_sqs->is_clipped)
-            sqs_rect_in_target.Intersect(last_sqs->clip_rect);
-
-          occlusion_in_target_space.Union(sqs_rect_in_target);
+        if (last_sqs) {
+          occlusion_in_target_space.Union(
+              GetOccludingRectForSharedQuadState(last_sqs));
         }
         // If the visible_rect of the current shared quad state does not
         // intersect with the occlusion rect, we can skip draw occlusion checks
@@ -832,8 +964,24 @@ void Display::RemoveOverdrawQuads(CompositorFrame* frame) {
         if (origin_rect != quad->visible_rect) {
           origin_rect.Subtract(quad->visible_rect);
           total_area_saved_in_px += origin_rect.size().GetCheckedArea();
+          ++quad;
+        } else if (split_partially_occluded_quads && CanSplitQuad(**quad)) {
+          // Otherwise, split the quad into one quad for each rect of the
+          // visible region.
+          cc::Region visible_region(origin_rect);
+          visible_region.Subtract(occlusion_in_quad_content_space);
+          std::vector<gfx::Rect> visible_rects;
+          base::CheckedNumeric<uint64_t> visible_area = 0;
+          for (gfx::Rect visible_rect : visible_region) {
+            visible_rects.push_back(visible_rect);
+            visible_area += visible_rect.size().GetCheckedArea();
+          }
+          total_area_saved_in_px +=
+              origin_rect.size().GetCheckedArea() - visible_area;
+          quad = SplitQuad(&pass->quad_list, quad, visible_rects);
+        } else {
+          ++quad;
         }
-        ++quad;
       } else if (occlusion_in_quad_content_space.IsEmpty() &&
                  occlusion_in_target_space.Contains(
                      cc::MathUtil::MapEnclosingClippedRect(
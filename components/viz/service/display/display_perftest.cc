@@ -12,6 +12,7 @@
 #include "components/viz/common/quads/compositor_frame.h"
 #include "components/viz/common/quads/draw_quad.h"
 #include "components/viz/common/quads/render_pass.h"
+#include "components/viz/common/quads/render_pass_draw_quad.h"
 #include "components/viz/common/quads/texture_draw_quad.h"
 #include "components/viz/common/surfaces/frame_sink_id.h"
 #include "components/viz/service/display/display.h"
@@ -72,8 +73,9 @@ class RemoveOverdrawQuadPerfTest : public testing::Test {
     return state;
   }
 
-  // Append draw quads to a given |shared_quad_state|.
-  void AppendQuads(SharedQuadState* shared_quad_state,
+  // Append draw quads to a given |shared_quad_state| of |render_pass|.
+  void AppendQuads(RenderPass* render_pass,
+                   SharedQuadState* shared_quad_state,
                    int quad_height,
                    int quad_width) {
     bool needs_blending = false;
@@ -94,8 +96,7 @@ class RemoveOverdrawQuadPerfTest : public testing::Test {
     int j = y_top;
     while (i + quad_width <= x_right) {
       while (j + quad_height <= y_bottom) {
-        auto* quad = frame_.render_pass_list.front()
-                         ->CreateAndAppendDrawQuad<TextureDrawQuad>();
+        auto* quad = render_pass->CreateAndAppendDrawQuad<TextureDrawQuad>();
         gfx::Rect rect(i, j, quad_width, quad_height);
         quad->SetNew(shared_quad_state, rect, rect, needs_blending, resource_id,
                      premultiplied_alpha, uv_top_left, uv_bottom_right,
@@ -142,7 +143,8 @@ class RemoveOverdrawQuadPerfTest : public testing::Test {
       gfx::Rect rect(0, 0, kHeight, kWidth);
       SharedQuadState* new_shared_state(
           CreateSharedQuadState(frame_.render_pass_list.front().get(), rect));
-      AppendQuads(new_shared_state, quad_height, quad_width);
+      AppendQuads(frame_.render_pass_list.front().get(), new_shared_state,
+                  quad_height, quad_width);
     }
   }
 
@@ -187,7 +189,8 @@ class RemoveOverdrawQuadPerfTest : public testing::Test {
       gfx::Rect rect(i, j, shared_quad_state_height, shared_quad_state_width);
       SharedQuadState* new_shared_state(
           CreateSharedQuadState(frame_.render_pass_list.front().get(), rect));
-      AppendQuads(new_shared_state, quad_height, quad_width);
+      AppendQuads(frame_.render_pass_list.front().get(), new_shared_state,
+                  quad_height, quad_width);
       j += shared_quad_state_height;
       i += shared_quad_state_width;
     }
@@ -236,7 +239,8 @@ class RemoveOverdrawQuadPerfTest : public testing::Test {
       gfx::Rect rect(i, j, shared_quad_state_height, shared_quad_state_width);
       SharedQuadState* new_shared_state(
           CreateSharedQuadState(frame_.render_pass_list.front().get(), rect));
-      AppendQuads(new_shared_state, quad_height, quad_width);
+      AppendQuads(frame_.render_pass_list.front().get(), new_shared_state,
+                  quad_height, quad_width);
       i += shared_quad_state_width * percentage_overlap;
       j += shared_quad_state_height * percentage_overlap;
     }
@@ -281,7 +285,8 @@ class RemoveOverdrawQuadPerfTest : public testing::Test {
         gfx::Rect rect(i, j, shared_quad_state_height, shared_quad_state_width);
         SharedQuadState* new_shared_state =
             CreateSharedQuadState(frame_.render_pass_list.front().get(), rect);
-        AppendQuads(new_shared_state, quad_height, quad_width);
+        AppendQuads(frame_.render_pass_list.front().get(), new_shared_state,
+                    quad_height, quad_width);
         j += shared_quad_state_height;
       }
       j = 0;
@@ -289,6 +294,70 @@ class RemoveOverdrawQuadPerfTest : public testing::Test {
     }
   }
 
+  // Windows are RenderPasses drawn by RenderPassDrawQuads in the root
+  // RenderPass and stacked as shown in the figure below, with w1 on top.
+  //  +----+
+  //  | w1 |-+
+  //  +----+ |-+
+  //    +----+ |
+  //      +----+
+  void IterateStackedWindows(const std::string& test_name,
+                             int window_count,
+                             int quad_count) {
+    CreateStackedWindows(window_count, quad_count);
+    std::unique_ptr<Display> display = CreateDisplay();
+
+    timer_.Reset();
+    do {
+      display->RemoveOverdrawQuads(&frame_);
+      timer_.NextLap();
+    } while (!timer_.HasTimeLimitExpired());
+
+    perf_test::PrintResult("RemoveOverdrawDraws Iterates stacked windows: ",
+                           "", test_name, timer_.LapsPerSecond(), "runs/s",
+                           true);
+    frame_ = CompositorFrame();
+  }
+
+  void CreateStackedWindows(int window_count, int quad_count) {
+    int window_height = kHeight / 2;
+    int window_width = kWidth / 2;
+    int offset_y = (kHeight - window_height) / window_count;
+    int offset_x = (kWidth - window_width) / window_count;
+    int quad_height = window_height / quad_count;
+    int quad_width = window_width / quad_count;
+    gfx::Rect window_rect(window_width, window_height);
+    RenderPassId root_pass_id = 1;
+    for (int i = 0; i < window_count; i++) {
+      std::unique_ptr<RenderPass> window_pass = RenderPass::Create();
+      window_pass->SetNew(root_pass_id + 1 + i, window_rect, window_rect,
+                          gfx::Transform());
+      SharedQuadState* new_shared_state =
+          CreateSharedQuadState(window_pass.get(), window_rect);
+      new_shared_state->sorting_context_id = 0;
+      AppendQuads(window_pass.get(), new_shared_state, quad_height,
+                  quad_width);
+      frame_.render_pass_list.push_back(std::move(window_pass));
+    }
+
+    std::unique_ptr<RenderPass> root_pass = RenderPass::Create();
+    gfx::Rect root_rect(kWidth, kHeight);
+    root_pass->SetNew(root_pass_id, root_rect, root_rect, gfx::Transform());
+    for (int i = 0; i < window_count; i++) {
+      SharedQuadState* new_shared_state =
+          CreateSharedQuadState(root_pass.get(), window_rect);
+      new_shared_state->quad_to_target_transform.Translate(offset_x * i,
+                                                           offset_y * i);
+      new_shared_state->sorting_context_id = 0;
+      auto* quad = root_pass->CreateAndAppendDrawQuad<RenderPassDrawQuad>();
+      quad->SetNew(new_shared_state, window_rect, window_rect,
+                   root_pass_id + 1 + i, /*mask_resource_id=*/0u,
+                   gfx::RectF(), gfx::Size(), gfx::Vector2dF(1, 1),
+                   gfx::PointF(), gfx::RectF(window_rect), false, 1.0f);
+    }
+    frame_.render_pass_list.push_back(std::move(root_pass));
+  }
+
  private:
   CompositorFrame frame_;
   base::LapTimer timer_;
@@ -325,5 +394,12 @@ TEST_F(RemoveOverdrawQuadPerfTest, IterateAdjacentSharedQuadStates) {
   IterateAdjacentSharedQuadStates("100 sqs with 100 quads", 10, 10);
 }
 
+TEST_F(RemoveOverdrawQuadPerfTest, IterateStackedWindows) {
+  IterateStackedWindows("4 windows with 4 quads", 4, 2);
+  IterateStackedWindows("4 windows with 100 quads", 4, 10);
+  IterateStackedWindows("20 windows with 4 quads", 20, 2);
+  IterateStackedWindows("20 windows with 100 quads", 20, 10);
+}
+
 }  // namespace
 }  // namespace viz
@@ -10,8 +10,10 @@
 #include "base/run_loop.h"
 #include "base/test/metrics/histogram_tester.h"
 #include "base/test/null_task_runner.h"
+#include "base/test/scoped_feature_list.h"
 #include "cc/base/math_util.h"
 #include "cc/test/scheduler_test_common.h"
+#include "components/viz/common/features.h"
 #include "components/viz/common/frame_sinks/begin_frame_source.h"
 #include "components/viz/common/frame_sinks/copy_output_request.h"
 #include "components/viz/common/frame_sinks/copy_output_result.h"
@@ -2595,6 +2597,202 @@ TEST_F(DisplayTest, CompositorFrameWithCoveredRenderPass) {
   TearDownDisplay();
 }
 
+// Check that what is drawn in front of a RenderPassDrawQuad occludes the quads
+// of the RenderPass it draws.
+TEST_F(DisplayTest, DrawOcclusionInEmbeddedRenderPass) {
+  RendererSettings settings;
+  settings.kMinimumDrawOcclusionSize.set_width(0);
+  SetUpGpuDisplay(settings);
+
+  StubDisplayClient client;
+  display_->Initialize(&client, manager_.surface_manager());
+
+  CompositorFrame frame = MakeDefaultCompositorFrame();
+  gfx::Rect child_output_rect(0, 0, 100, 100);
+  RenderPassId child_pass_id = 2;
+  std::unique_ptr<RenderPass> child_pass = RenderPass::Create();
+  child_pass->SetNew(child_pass_id, child_output_rect, child_output_rect,
+                     gfx::Transform());
+  RenderPass* child = child_pass.get();
+  frame.render_pass_list.insert(frame.render_pass_list.begin(),
+                                std::move(child_pass));
+  RenderPass* root = frame.render_pass_list.back().get();
+
+  gfx::Rect rect1(50, 0, 100, 50);
+  gfx::Rect rect2(0, 0, 100, 100);
+  gfx::Transform translate;
+  translate.Translate(50, 0);
+
+  bool is_clipped = false;
+  bool opaque_content = true;
+  float opacity = 1.f;
+  SharedQuadState* shared_quad_state = root->CreateAndAppendSharedQuadState();
+  auto* quad = root->quad_list.AllocateAndConstruct<SolidColorDrawQuad>();
+  SharedQuadState* shared_quad_state2 = root->CreateAndAppendSharedQuadState();
+  auto* pass_quad = root->quad_list.AllocateAndConstruct<RenderPassDrawQuad>();
+  SharedQuadState* shared_quad_state3 = child->CreateAndAppendSharedQuadState();
+  auto* quad3 = child->quad_list.AllocateAndConstruct<SolidColorDrawQuad>();
+  {
+    // The RenderPassDrawQuad draws the child pass translated by (50, 0), and
+    // |rect1| in front of it covers the top half of the child pass.
+    //       +-----+-----+
+    //       |rect1|     |
+    //       +-----+-----+
+    //       |rect2|
+    //       +-----+
+    shared_quad_state->SetAll(gfx::Transform(), rect1, rect1, gfx::RRectF(),
+                              rect1, is_clipped, opaque_content, opacity,
+                              SkBlendMode::kSrcOver, 0);
+    shared_quad_state2->SetAll(translate, child_output_rect, child_output_rect,
+                               gfx::RRectF(), child_output_rect, is_clipped,
+                               opaque_content, opacity, SkBlendMode::kSrcOver,
+                               0);
+    shared_quad_state3->SetAll(gfx::Transform(), rect2, rect2, gfx::RRectF(),
+                               rect2, is_clipped, opaque_content, opacity,
+                               SkBlendMode::kSrcOver, 0);
+    quad->SetNew(shared_quad_state, rect1, rect1, SK_ColorBLACK, false);
+    pass_quad->SetNew(shared_quad_state2, child_output_rect, child_output_rect,
+                      child_pass_id, 0u, gfx::RectF(), gfx::Size(),
+                      gfx::Vector2dF(1, 1), gfx::PointF(),
+                      gfx::RectF(child_output_rect), false, 1.0f);
+    quad3->SetNew(shared_quad_state3, rect2, rect2, SK_ColorBLACK, false);
+    display_->RemoveOverdrawQuads(&frame);
+    // In the space of the child pass, |rect1| covers (0, 0, 100x50), so only
+    // the bottom half of |rect2| is visible.
+    EXPECT_EQ(2u, root->quad_list.size());
+    EXPECT_EQ(1u, child->quad_list.size());
+    EXPECT_EQ(gfx::Rect(0, 50, 100, 50).ToString(),
+              child->quad_list.ElementAt(0)->visible_rect.ToString());
+  }
+
+  {
+    // The backdrop filters of the child pass read what is behind it, so
+    // nothing is occluded.
+    child->backdrop_filters.Append(cc::FilterOperation::CreateBlurFilter(2));
+    quad3->visible_rect = rect2;
+    display_->RemoveOverdrawQuads(&frame);
+    EXPECT_EQ(2u, root->quad_list.size());
+    EXPECT_EQ(1u, child->quad_list.size());
+    EXPECT_EQ(rect2.ToString(),
+              child->quad_list.ElementAt(0)->visible_rect.ToString());
+  }
+
+  {
+    // The whole child pass may be visible through a mask, so nothing is
+    // occluded.
+    child->backdrop_filters.Clear();
+    pass_quad->SetNew(shared_quad_state2, child_output_rect, child_output_rect,
+                      child_pass_id, 2u, gfx::RectF(), gfx::Size(),
+                      gfx::Vector2dF(1, 1), gfx::PointF(),
+                      gfx::RectF(child_output_rect), false, 1.0f);
+    display_->RemoveOverdrawQuads(&frame);
+    EXPECT_EQ(2u, root->quad_list.size());
+    EXPECT_EQ(1u, child->quad_list.size());
+    EXPECT_EQ(rect2.ToString(),
+              child->quad_list.ElementAt(0)->visible_rect.ToString());
+  }
+  TearDownDisplay();
+}
+
+// Check that quads whose visible region is not a rect are split.
+TEST_F(DisplayTest, DrawOcclusionSplitsPartiallyOccludedQuads) {
+  base::test::ScopedFeatureList feature_list;
+  feature_list.InitAndEnableFeature(features::kSplitPartiallyOccludedQuads);
+
+  RendererSettings settings;
+  settings.kMinimumDrawOcclusionSize.set_width(0);
+  SetUpGpuDisplay(settings);
+
+  StubDisplayClient client;
+  display_->Initialize(&client, manager_.surface_manager());
+
+  gfx::Rect rect1(0, 0, 50, 50);
+  gfx::Rect rect2(0, 0, 100, 100);
+  gfx::Rect rect3(25, 25, 50, 50);
+
+  bool is_clipped = false;
+  bool opaque_content = true;
+  float opacity = 1.f;
+  {
+    //  rect1 & rect2
+    //   +----+----+
+    //   |    |    |
+    //   +----+    |
+    //   |         |
+    //   +---------+
+    CompositorFrame frame = MakeDefaultCompositorFrame();
+    RenderPass* pass = frame.render_pass_list.front().get();
+    SharedQuadState* shared_quad_state = pass->CreateAndAppendSharedQuadState();
+    auto* quad = pass->quad_list.AllocateAndConstruct<SolidColorDrawQuad>();
+    SharedQuadState* shared_quad_state2 =
+        pass->CreateAndAppendSharedQuadState();
+    auto* quad2 = pass->quad_list.AllocateAndConstruct<SolidColorDrawQuad>();
+    shared_quad_state->SetAll(gfx::Transform(), rect1, rect1, gfx::RRectF(),
+                              rect1, is_clipped, opaque_content, opacity,
+                              SkBlendMode::kSrcOver, 0);
+    shared_quad_state2->SetAll(gfx::Transform(), rect2, rect2, gfx::RRectF(),
+                               rect2, is_clipped, opaque_content, opacity,
+                               SkBlendMode::kSrcOver, 0);
+    quad->SetNew(shared_quad_state, rect1, rect1, SK_ColorBLACK, false);
+    quad2->SetNew(shared_quad_state2, rect2, rect2, SK_ColorRED, false);
+    display_->RemoveOverdrawQuads(&frame);
+    // The visible region of |quad2| is L-shaped, so it is drawn as two quads.
+    ASSERT_EQ(3u, pass->quad_list.size());
+    EXPECT_EQ(rect1.ToString(),
+              pass->quad_list.ElementAt(0)->visible_rect.ToString());
+    EXPECT_EQ(gfx::Rect(50, 0, 50, 50).ToString(),
+              pass->quad_list.ElementAt(1)->visible_rect.ToString());
+    EXPECT_EQ(gfx::Rect(0, 50, 100, 50).ToString(),
+              pass->quad_list.ElementAt(2)->visible_rect.ToString());
+    for (size_t i = 1; i < 3; ++i) {
+      const auto* piece =
+          SolidColorDrawQuad::MaterialCast(pass->quad_list.ElementAt(i));
+      EXPECT_EQ(rect2, piece->rect);
+      EXPECT_EQ(SK_ColorRED, piece->color);
+      EXPECT_EQ(shared_quad_state2, piece->shared_quad_state);
+    }
+  }
+
+  {
+    //  rect3 & rect2
+    //   +---------+
+    //   |  +---+  |
+    //   |  |   |  |
+    //   |  +---+  |
+    //   +---------+
+    CompositorFrame frame = MakeDefaultCompositorFrame();
+    RenderPass* pass = frame.render_pass_list.front().get();
+    SharedQuadState* shared_quad_state = pass->CreateAndAppendSharedQuadState();
+    auto* quad = pass->quad_list.AllocateAndConstruct<SolidColorDrawQuad>();
+    SharedQuadState* shared_quad_state2 =
+        pass->CreateAndAppendSharedQuadState();
+    auto* quad2 = pass->quad_list.AllocateAndConstruct<SolidColorDrawQuad>();
+    shared_quad_state->SetAll(gfx::Transform(), rect3, rect3, gfx::RRectF(),
+                              rect3, is_clipped, opaque_content, opacity,
+                              SkBlendMode::kSrcOver, 0);
+    shared_quad_state2->SetAll(gfx::Transform(), rect2, rect2, gfx::RRectF(),
+                               rect2, is_clipped, opaque_content, opacity,
+                               SkBlendMode::kSrcOver, 0);
+    quad->SetNew(shared_quad_state, rect3, rect3, SK_ColorBLACK, false);
+    quad2->SetNew(shared_quad_state2, rect2, rect2, SK_ColorRED, false);
+    display_->RemoveOverdrawQuads(&frame);
+    // The visible region of |quad2| has a hole, so it is drawn as four quads
+    // around it.
+    ASSERT_EQ(5u, pass->quad_list.size());
+    EXPECT_EQ(rect3.ToString(),
+              pass->quad_list.ElementAt(0)->visible_rect.ToString());
+    EXPECT_EQ(gfx::Rect(0, 0, 100, 25).ToString(),
+              pass->quad_list.ElementAt(1)->visible_rect.ToString());
+    EXPECT_EQ(gfx::Rect(0, 25, 25, 50).ToString(),
+              pass->quad_list.ElementAt(2)->visible_rect.ToString());
+    EXPECT_EQ(gfx::Rect(75, 25, 25, 50).ToString(),
+              pass->quad_list.ElementAt(3)->visible_rect.ToString());
+    EXPECT_EQ(gfx::Rect(0, 75, 100, 25).ToString(),
+              pass->quad_list.ElementAt(4)->visible_rect.ToString());
+  }
+  TearDownDisplay();
+}
+
 TEST_F(DisplayTest, CompositorFrameWithClip) {
   RendererSettings settings;
   settings.kMinimumDrawOcclusionSize.set_width(0);
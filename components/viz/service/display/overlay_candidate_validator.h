@@ -35,6 +35,15 @@ class VIZ_SERVICE_EXPORT OverlayCandidateValidator {
   // coordinates if necessary.
   virtual void CheckOverlaySupport(OverlayCandidateList* surfaces) = 0;
 
+  // Returns the number of overlay planes, besides the main plane, that
+  // OverlayStrategyMultiple may promote candidates to in a frame.
+  virtual size_t GetMaxOverlayPlanes() { return 1; }
+
+  // Returns the memory bandwidth, in bytes, that using an overlay plane costs
+  // on this output device. OverlayStrategyMultiple only promotes candidates
+  // that save more than this.
+  virtual size_t GetOverlayPlaneCostInBytes() { return 0; }
+
   virtual ~OverlayCandidateValidator() {}
 };
 
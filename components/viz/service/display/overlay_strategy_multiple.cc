@@ -0,0 +1,177 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "components/viz/service/display/overlay_strategy_multiple.h"
+
+#include <algorithm>
+
+#include "base/numerics/checked_math.h"
+#include "base/trace_event/trace_event.h"
+#include "components/viz/service/display/overlay_candidate_validator.h"
+#include "ui/gfx/buffer_format_util.h"
+#include "ui/gfx/geometry/rect_conversions.h"
+
+namespace viz {
+
+namespace {
+
+// The main plane is composited into a buffer with 4 bytes per pixel.
+constexpr size_t kMainPlaneBytesPerPixel = 4;
+
+struct ScoredCandidate {
+  OverlayCandidate candidate;
+  // The position of the candidate's quad in the quad list.
+  size_t quad_index;
+  size_t bytes_saved;
+};
+
+}  // namespace
+
+OverlayStrategyMultiple::OverlayStrategyMultiple(
+    OverlayCandidateValidator* capability_checker)
+    : capability_checker_(capability_checker) {
+  DCHECK(capability_checker);
+}
+
+OverlayStrategyMultiple::~OverlayStrategyMultiple() {}
+
+bool OverlayStrategyMultiple::Attempt(
+    const SkMatrix44& output_color_matrix,
+    const OverlayProcessor::FilterOperationsMap& render_pass_backdrop_filters,
+    DisplayResourceProvider* resource_provider,
+    RenderPassList* render_pass_list,
+    OverlayCandidateList* candidate_list,
+    std::vector<gfx::Rect>* content_bounds) {
+  TRACE_EVENT0(TRACE_DISABLED_BY_DEFAULT("viz.debug.overlay_planes"),
+               "OverlayStrategyMultiple::Attempt");
+  size_t max_overlay_planes = capability_checker_->GetMaxOverlayPlanes();
+  if (!max_overlay_planes)
+    return false;
+  size_t plane_cost = capability_checker_->GetOverlayPlaneCostInBytes();
+
+  RenderPass* render_pass = render_pass_list->back().get();
+  QuadList* quad_list = &render_pass->quad_list;
+
+  // Candidates are only promoted if nothing is drawn on top of them, which
+  // includes other candidates, so the order of their planes doesn't matter.
+  std::vector<ScoredCandidate> scored_candidates;
+  size_t quad_index = 0;
+  for (auto it = quad_list->begin(); it != quad_list->end();
+       ++it, ++quad_index) {
+    OverlayCandidate candidate;
+    if (!OverlayCandidate::FromDrawQuad(resource_provider, output_color_matrix,
+                                        *it, &candidate) ||
+        OverlayCandidate::IsOccluded(candidate, quad_list->cbegin(), it)) {
+      continue;
+    }
+    size_t bytes_saved = GetBytesSavedByOverlay(candidate);
+    TRACE_EVENT_INSTANT2(TRACE_DISABLED_BY_DEFAULT("viz.debug.overlay_planes"),
+                         "OverlayStrategyMultiple candidate",
+                         TRACE_EVENT_SCOPE_THREAD, "bytes_saved", bytes_saved,
+                         "plane_cost", plane_cost);
+    if (bytes_saved <= plane_cost)
+      continue;
+    scored_candidates.push_back({candidate, quad_index, bytes_saved});
+  }
+
+  std::stable_sort(scored_candidates.begin(), scored_candidates.end(),
+                   [](const ScoredCandidate& a, const ScoredCandidate& b) {
+                     return a.bytes_saved > b.bytes_saved;
+                   });
+
+  // Try the candidates that save the most that there are planes for. Until
+  // the validator accepts all of them, drop the one that saves the least of
+  // those it rejects, and try the next one instead.
+  while (!scored_candidates.empty()) {
+    auto planned_end =
+        scored_candidates.begin() +
+        std::min(scored_candidates.size(), max_overlay_planes);
+    OverlayCandidateList new_candidate_list = *candidate_list;
+    for (auto it = scored_candidates.begin(); it != planned_end; ++it) {
+      new_candidate_list.push_back(it->candidate);
+      // Quads nearer the front of the list are stacked on top.
+      size_t index = it->quad_index;
+      new_candidate_list.back().plane_z_order =
+          1 + static_cast<int>(std::count_if(
+                  scored_candidates.begin(), planned_end,
+                  [index](const ScoredCandidate& other) {
+                    return other.quad_index > index;
+                  }));
+    }
+
+    capability_checker_->CheckOverlaySupport(&new_candidate_list);
+
+    // |scored_candidates| are sorted by the bandwidth they save, so the last
+    // rejected one saves the least.
+    size_t first_new_candidate = candidate_list->size();
+    size_t planned_count = planned_end - scored_candidates.begin();
+    size_t rejected = planned_count;
+    for (size_t i = planned_count; i-- > 0;) {
+      if (!new_candidate_list[first_new_candidate + i].overlay_handled) {
+        rejected = i;
+        break;
+      }
+    }
+
+    if (rejected != planned_count) {
+      TRACE_EVENT_INSTANT1(
+          TRACE_DISABLED_BY_DEFAULT("viz.debug.overlay_planes"),
+          "OverlayStrategyMultiple rejected candidate",
+          TRACE_EVENT_SCOPE_THREAD, "bytes_saved",
+          scored_candidates[rejected].bytes_saved);
+      scored_candidates.erase(scored_candidates.begin() + rejected);
+      continue;
+    }
+
+    std::vector<size_t> promoted_quad_indices;
+    for (auto it = scored_candidates.begin(); it != planned_end; ++it)
+      promoted_quad_indices.push_back(it->quad_index);
+    std::sort(promoted_quad_indices.begin(), promoted_quad_indices.end());
+
+    auto promoted = promoted_quad_indices.begin();
+    quad_index = 0;
+    for (auto it = quad_list->begin();
+         it != quad_list->end() && promoted != promoted_quad_indices.end();
+         ++quad_index) {
+      if (quad_index == *promoted) {
+        it = quad_list->EraseAndInvalidateAllPointers(it);
+        ++promoted;
+      } else {
+        ++it;
+      }
+    }
+
+    TRACE_EVENT_INSTANT1(TRACE_DISABLED_BY_DEFAULT("viz.debug.overlay_planes"),
+                         "OverlayStrategyMultiple promoted candidates",
+                         TRACE_EVENT_SCOPE_THREAD, "count", planned_count);
+    candidate_list->swap(new_candidate_list);
+    return true;
+  }
+
+  return false;
+}
+
+OverlayStrategy OverlayStrategyMultiple::GetUMAEnum() const {
+  return OverlayStrategy::kMultiple;
+}
+
+// static
+size_t OverlayStrategyMultiple::GetBytesSavedByOverlay(
+    const OverlayCandidate& candidate) {
+  // Compositing the candidate reads its buffer and writes its display rect to
+  // the main plane. Scanning it out instead of the main plane's pixels under
+  // it costs about the same.
+  size_t buffer_size = 0;
+  if (!gfx::BufferSizeForBufferFormatChecked(candidate.resource_size_in_pixels,
+                                             candidate.format, &buffer_size)) {
+    return 0;
+  }
+  gfx::Size display_size = gfx::ToEnclosingRect(candidate.display_rect).size();
+  base::CheckedNumeric<size_t> bytes_saved = display_size.GetCheckedArea();
+  bytes_saved *= kMainPlaneBytesPerPixel;
+  bytes_saved += buffer_size;
+  return bytes_saved.ValueOrDefault(0);
+}
+
+}  // namespace viz
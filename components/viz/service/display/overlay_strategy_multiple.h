@@ -0,0 +1,52 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef COMPONENTS_VIZ_SERVICE_DISPLAY_OVERLAY_STRATEGY_MULTIPLE_H_
+#define COMPONENTS_VIZ_SERVICE_DISPLAY_OVERLAY_STRATEGY_MULTIPLE_H_
+
+#include <vector>
+
+#include "base/macros.h"
+#include "components/viz/service/display/overlay_processor.h"
+#include "components/viz/service/viz_service_export.h"
+
+namespace viz {
+
+class OverlayCandidateValidator;
+
+// Overlay strategy to promote several quads of the root render pass to
+// overlays on top of the main plane. The candidates are chosen by the memory
+// bandwidth that promoting them saves, up to the number of overlay planes the
+// OverlayCandidateValidator reports, and only if that is more than the cost
+// of using a plane on the platform.
+class VIZ_SERVICE_EXPORT OverlayStrategyMultiple
+    : public OverlayProcessor::Strategy {
+ public:
+  explicit OverlayStrategyMultiple(
+      OverlayCandidateValidator* capability_checker);
+  ~OverlayStrategyMultiple() override;
+
+  bool Attempt(
+      const SkMatrix44& output_color_matrix,
+      const OverlayProcessor::FilterOperationsMap& render_pass_backdrop_filters,
+      DisplayResourceProvider* resource_provider,
+      RenderPassList* render_pass,
+      OverlayCandidateList* candidate_list,
+      std::vector<gfx::Rect>* content_bounds) override;
+
+  OverlayStrategy GetUMAEnum() const override;
+
+  // Returns the memory bandwidth, in bytes, that compositing |candidate|
+  // into the main plane uses, and that promoting it to an overlay saves.
+  static size_t GetBytesSavedByOverlay(const OverlayCandidate& candidate);
+
+ private:
+  OverlayCandidateValidator* capability_checker_;  // Weak.
+
+  DISALLOW_COPY_AND_ASSIGN(OverlayStrategyMultiple);
+};
+
+}  // namespace viz
+
+#endif  // COMPONENTS_VIZ_SERVICE_DISPLAY_OVERLAY_STRATEGY_MULTIPLE_H_
@@ -31,6 +31,7 @@
 #include "components/viz/service/display/overlay_candidate_validator.h"
 #include "components/viz/service/display/overlay_processor.h"
 #include "components/viz/service/display/overlay_strategy_fullscreen.h"
+#include "components/viz/service/display/overlay_strategy_multiple.h"
 #include "components/viz/service/display/overlay_strategy_single_on_top.h"
 #include "components/viz/service/display/overlay_strategy_underlay.h"
 #include "components/viz/service/display/overlay_strategy_underlay_cast.h"
@@ -174,6 +175,30 @@ class UnderlayCastOverlayValidator : public SingleOverlayValidator {
   }
 };
 
+class MultipleOverlayValidator : public OverlayCandidateValidator {
+ public:
+  void GetStrategies(OverlayProcessor::StrategyList* strategies) override {
+    strategies->push_back(std::make_unique<OverlayStrategyMultiple>(this));
+  }
+  bool AllowCALayerOverlays() override { return false; }
+  bool AllowDCLayerOverlays() override { return false; }
+  void CheckOverlaySupport(OverlayCandidateList* surfaces) override {
+    for (auto& candidate : *surfaces) {
+      candidate.overlay_handled =
+          candidate.display_rect != gfx::RectF(rejected_rect_);
+    }
+  }
+  size_t GetMaxOverlayPlanes() override { return 2; }
+  size_t GetOverlayPlaneCostInBytes() override { return plane_cost_in_bytes_; }
+
+  void set_rejected_rect(const gfx::Rect& rect) { rejected_rect_ = rect; }
+  void set_plane_cost_in_bytes(size_t cost) { plane_cost_in_bytes_ = cost; }
+
+ private:
+  gfx::Rect rejected_rect_;
+  size_t plane_cost_in_bytes_ = 0;
+};
+
 class DefaultOverlayProcessor : public OverlayProcessor {
  public:
   explicit DefaultOverlayProcessor(OutputSurface* surface);
@@ -567,6 +592,7 @@ using UnderlayTest = OverlayTest<UnderlayOverlayValidator>;
 using TransparentUnderlayTest =
     OverlayTest<TransparentUnderlayOverlayValidator>;
 using UnderlayCastTest = OverlayTest<UnderlayCastOverlayValidator>;
+using MultipleOverlayTest = OverlayTest<MultipleOverlayValidator>;
 using CALayerOverlayTest = OverlayTest<CALayerValidator>;
 
 TEST(OverlayTest, NoOverlaysByDefault) {
@@ -2277,6 +2303,147 @@ TEST_F(UnderlayCastTest, NoOverlayPromotionWithoutProtectedContent) {
   EXPECT_TRUE(content_bounds_.empty());
 }
 
+TEST_F(MultipleOverlayTest, PromotesCandidatesThatSaveMost) {
+  std::unique_ptr<RenderPass> pass = CreateRenderPass();
+  const gfx::Rect kSmallCandidateRect(0, 128, 32, 32);
+  CreateCandidateQuadAt(resource_provider_.get(),
+                        child_resource_provider_.get(), child_provider_.get(),
+                        pass->shared_quad_state_list.back(), pass.get(),
+                        kOverlayTopLeftRect);
+  CreateCandidateQuadAt(resource_provider_.get(),
+                        child_resource_provider_.get(), child_provider_.get(),
+                        pass->shared_quad_state_list.back(), pass.get(),
+                        kSmallCandidateRect);
+  CreateCandidateQuadAt(resource_provider_.get(),
+                        child_resource_provider_.get(), child_provider_.get(),
+                        pass->shared_quad_state_list.back(), pass.get(),
+                        kOverlayBottomRightRect);
+  CreateFullscreenOpaqueQuad(resource_provider_.get(),
+                             pass->shared_quad_state_list.back(), pass.get());
+
+  OverlayCandidateList candidate_list;
+  OverlayProcessor::FilterOperationsMap render_pass_filters;
+  OverlayProcessor::FilterOperationsMap render_pass_backdrop_filters;
+  RenderPassList pass_list;
+  RenderPass* main_pass = pass.get();
+  pass_list.push_back(std::move(pass));
+  overlay_processor_->ProcessForOverlays(
+      resource_provider_.get(), &pass_list, GetIdentityColorMatrix(),
+      render_pass_filters, render_pass_backdrop_filters, &candidate_list,
+      nullptr, nullptr, &damage_rect_, &content_bounds_);
+
+  // There are two planes, which the two bigger candidates are promoted to.
+  // The one nearer the front of the quad list is stacked on top.
+  ASSERT_EQ(2U, candidate_list.size());
+  EXPECT_EQ(gfx::RectF(kOverlayTopLeftRect), candidate_list[0].display_rect);
+  EXPECT_EQ(2, candidate_list[0].plane_z_order);
+  EXPECT_EQ(gfx::RectF(kOverlayBottomRightRect),
+            candidate_list[1].display_rect);
+  EXPECT_EQ(1, candidate_list[1].plane_z_order);
+  ASSERT_EQ(2U, main_pass->quad_list.size());
+  EXPECT_EQ(kSmallCandidateRect, main_pass->quad_list.front()->rect);
+}
+
+TEST_F(MultipleOverlayTest, RejectedCandidateIsReplaced) {
+  std::unique_ptr<RenderPass> pass = CreateRenderPass();
+  const gfx::Rect kSmallCandidateRect(0, 128, 32, 32);
+  output_surface_->GetOverlayCandidateValidator()->set_rejected_rect(
+      kOverlayBottomRightRect);
+  CreateCandidateQuadAt(resource_provider_.get(),
+                        child_resource_provider_.get(), child_provider_.get(),
+                        pass->shared_quad_state_list.back(), pass.get(),
+                        kOverlayTopLeftRect);
+  CreateCandidateQuadAt(resource_provider_.get(),
+                        child_resource_provider_.get(), child_provider_.get(),
+                        pass->shared_quad_state_list.back(), pass.get(),
+                        kSmallCandidateRect);
+  CreateCandidateQuadAt(resource_provider_.get(),
+                        child_resource_provider_.get(), child_provider_.get(),
+                        pass->shared_quad_state_list.back(), pass.get(),
+                        kOverlayBottomRightRect);
+  CreateFullscreenOpaqueQuad(resource_provider_.get(),
+                             pass->shared_quad_state_list.back(), pass.get());
+
+  OverlayCandidateList candidate_list;
+  OverlayProcessor::FilterOperationsMap render_pass_filters;
+  OverlayProcessor::FilterOperationsMap render_pass_backdrop_filters;
+  RenderPassList pass_list;
+  RenderPass* main_pass = pass.get();
+  pass_list.push_back(std::move(pass));
+  overlay_processor_->ProcessForOverlays(
+      resource_provider_.get(), &pass_list, GetIdentityColorMatrix(),
+      render_pass_filters, render_pass_backdrop_filters, &candidate_list,
+      nullptr, nullptr, &damage_rect_, &content_bounds_);
+
+  // The small candidate takes the plane of the one the validator rejects.
+  ASSERT_EQ(2U, candidate_list.size());
+  EXPECT_EQ(gfx::RectF(kOverlayTopLeftRect), candidate_list[0].display_rect);
+  EXPECT_EQ(gfx::RectF(kSmallCandidateRect), candidate_list[1].display_rect);
+  ASSERT_EQ(2U, main_pass->quad_list.size());
+  EXPECT_EQ(kOverlayBottomRightRect, main_pass->quad_list.front()->rect);
+}
+
+TEST_F(MultipleOverlayTest, OccludedCandidateNotPromoted) {
+  std::unique_ptr<RenderPass> pass = CreateRenderPass();
+  CreateOpaqueQuadAt(resource_provider_.get(),
+                     pass->shared_quad_state_list.back(), pass.get(),
+                     kOverlayTopLeftRect);
+  CreateCandidateQuadAt(resource_provider_.get(),
+                        child_resource_provider_.get(), child_provider_.get(),
+                        pass->shared_quad_state_list.back(), pass.get(),
+                        kOverlayTopLeftRect);
+  CreateCandidateQuadAt(resource_provider_.get(),
+                        child_resource_provider_.get(), child_provider_.get(),
+                        pass->shared_quad_state_list.back(), pass.get(),
+                        kOverlayBottomRightRect);
+
+  OverlayCandidateList candidate_list;
+  OverlayProcessor::FilterOperationsMap render_pass_filters;
+  OverlayProcessor::FilterOperationsMap render_pass_backdrop_filters;
+  RenderPassList pass_list;
+  RenderPass* main_pass = pass.get();
+  pass_list.push_back(std::move(pass));
+  overlay_processor_->ProcessForOverlays(
+      resource_provider_.get(), &pass_list, GetIdentityColorMatrix(),
+      render_pass_filters, render_pass_backdrop_filters, &candidate_list,
+      nullptr, nullptr, &damage_rect_, &content_bounds_);
+
+  ASSERT_EQ(1U, candidate_list.size());
+  EXPECT_EQ(gfx::RectF(kOverlayBottomRightRect),
+            candidate_list[0].display_rect);
+  EXPECT_EQ(2U, main_pass->quad_list.size());
+}
+
+TEST_F(MultipleOverlayTest, CandidatesNotWorthAPlane) {
+  std::unique_ptr<RenderPass> pass = CreateRenderPass();
+  // Compositing a candidate reads its buffer and writes its display rect,
+  // both with 4 bytes per pixel.
+  output_surface_->GetOverlayCandidateValidator()->set_plane_cost_in_bytes(
+      kOverlayTopLeftRect.size().GetArea() * 8);
+  CreateCandidateQuadAt(resource_provider_.get(),
+                        child_resource_provider_.get(), child_provider_.get(),
+                        pass->shared_quad_state_list.back(), pass.get(),
+                        kOverlayTopLeftRect);
+  CreateCandidateQuadAt(resource_provider_.get(),
+                        child_resource_provider_.get(), child_provider_.get(),
+                        pass->shared_quad_state_list.back(), pass.get(),
+                        kOverlayBottomRightRect);
+
+  OverlayCandidateList candidate_list;
+  OverlayProcessor::FilterOperationsMap render_pass_filters;
+  OverlayProcessor::FilterOperationsMap render_pass_backdrop_filters;
+  RenderPassList pass_list;
+  RenderPass* main_pass = pass.get();
+  pass_list.push_back(std::move(pass));
+  overlay_processor_->ProcessForOverlays(
+      resource_provider_.get(), &pass_list, GetIdentityColorMatrix(),
+      render_pass_filters, render_pass_backdrop_filters, &candidate_list,
+      nullptr, nullptr, &damage_rect_, &content_bounds_);
+
+  EXPECT_TRUE(candidate_list.empty());
+  EXPECT_EQ(2U, main_pass->quad_list.size());
+}
+
 OverlayCandidateList BackbufferOverlayList(const RenderPass* root_render_pass) {
   OverlayCandidateList list;
   OverlayCandidate output_surface_plane;
@@ -1290,14 +1290,19 @@ void SkiaRenderer::DrawTextureQuad(const TextureDrawQuad* quad,
 
   // There are two scenarios where a texture quad cannot be put into a batch:
   // 1. It needs to be blended with a constant background color.
-  // 2. The vertex opacities are not all 1s.
+  // 2. The vertex opacities are not all the same.
   bool blend_background =
       quad->background_color != SK_ColorTRANSPARENT && !image->isOpaque();
-  bool vertex_alpha =
-      quad->vertex_opacity[0] < 1.f || quad->vertex_opacity[1] < 1.f ||
-      quad->vertex_opacity[2] < 1.f || quad->vertex_opacity[3] < 1.f;
-
-  if (!blend_background && !vertex_alpha) {
+  bool uniform_vertex_alpha =
+      quad->vertex_opacity[0] == quad->vertex_opacity[1] &&
+      quad->vertex_opacity[0] == quad->vertex_opacity[2] &&
+      quad->vertex_opacity[0] == quad->vertex_opacity[3];
+  // A uniform vertex opacity is the same as the quad's opacity, which each
+  // entry of the batch has, so fading quads of an atlas are drawn together.
+  if (uniform_vertex_alpha)
+    params->opacity *= quad->vertex_opacity[0];
+
+  if (!blend_background && uniform_vertex_alpha) {
     // This is a simple texture draw and can go into the batching system
     DCHECK(!MustFlushBatchedQuads(quad, *params));
     AddQuadToBatch(image, valid_texel_bounds, params);
@@ -1312,50 +1317,42 @@ void SkiaRenderer::DrawTextureQuad(const TextureDrawQuad* quad,
   SkPaint paint = params->paint();
   float quad_alpha = params->opacity;
   params->opacity = 1.f;
-  if (vertex_alpha) {
-    // If they are all the same value, combine it with the overall opacity,
-    // otherwise use a mask filter to emulate vertex opacity interpolation
+  if (!uniform_vertex_alpha) {
+    // The only occurrences of non-constant vertex opacities come from unit
+    // tests and src/chrome/browser/android/compositor/decoration_title.cc,
+    // but they always produce the effect of a linear alpha gradient.
+    // All signs indicate point order is [BL, TL, TR, BR]
+    SkPoint gradient_pts[2];
     if (quad->vertex_opacity[0] == quad->vertex_opacity[1] &&
-        quad->vertex_opacity[0] == quad->vertex_opacity[2] &&
-        quad->vertex_opacity[0] == quad->vertex_opacity[3]) {
-      quad_alpha *= quad->vertex_opacity[0];
+        quad->vertex_opacity[2] == quad->vertex_opacity[3]) {
+      // Left to right gradient
+      float y =
+          params->visible_rect.y() + 0.5f * params->visible_rect.height();
+      gradient_pts[0] = {params->visible_rect.x(), y};
+      gradient_pts[1] = {params->visible_rect.right(), y};
+    } else if (quad->vertex_opacity[0] == quad->vertex_opacity[3] &&
+               quad->vertex_opacity[1] == quad->vertex_opacity[2]) {
+      // Top to bottom gradient
+      float x =
+          params->visible_rect.x() + 0.5f * params->visible_rect.width();
+      gradient_pts[0] = {x, params->visible_rect.y()};
+      gradient_pts[1] = {x, params->visible_rect.bottom()};
     } else {
-      // The only occurrences of non-constant vertex opacities come from unit
-      // tests and src/chrome/browser/android/compositor/decoration_title.cc,
-      // but they always produce the effect of a linear alpha gradient.
-      // All signs indicate point order is [BL, TL, TR, BR]
-      SkPoint gradient_pts[2];
-      if (quad->vertex_opacity[0] == quad->vertex_opacity[1] &&
-          quad->vertex_opacity[2] == quad->vertex_opacity[3]) {
-        // Left to right gradient
-        float y =
-            params->visible_rect.y() + 0.5f * params->visible_rect.height();
-        gradient_pts[0] = {params->visible_rect.x(), y};
-        gradient_pts[1] = {params->visible_rect.right(), y};
-      } else if (quad->vertex_opacity[0] == quad->vertex_opacity[3] &&
-                 quad->vertex_opacity[1] == quad->vertex_opacity[2]) {
-        // Top to bottom gradient
-        float x =
-            params->visible_rect.x() + 0.5f * params->visible_rect.width();
-        gradient_pts[0] = {x, params->visible_rect.y()};
-        gradient_pts[1] = {x, params->visible_rect.bottom()};
-      } else {
-        // Not sure how to emulate
-        NOTIMPLEMENTED();
-        return;
-      }
-
-      float a1 = quad->vertex_opacity[0] * quad_alpha;
-      float a2 = quad->vertex_opacity[2] * quad_alpha;
-      SkColor gradient_colors[2] = {SkColor4f({a1, a1, a1, a1}).toSkColor(),
-                                    SkColor4f({a2, a2, a2, a2}).toSkColor()};
-      sk_sp<SkShader> gradient = SkGradientShader::MakeLinear(
-          gradient_pts, gradient_colors, nullptr, 2, SkTileMode::kClamp);
-      paint.setMaskFilter(SkShaderMaskFilter::Make(std::move(gradient)));
-      // shared quad opacity was folded into the gradient, so this will shorten
-      // any color filter chain needed for background blending
-      quad_alpha = 1.f;
+      // Not sure how to emulate
+      NOTIMPLEMENTED();
+      return;
     }
+
+    float a1 = quad->vertex_opacity[0] * quad_alpha;
+    float a2 = quad->vertex_opacity[2] * quad_alpha;
+    SkColor gradient_colors[2] = {SkColor4f({a1, a1, a1, a1}).toSkColor(),
+                                  SkColor4f({a2, a2, a2, a2}).toSkColor()};
+    sk_sp<SkShader> gradient = SkGradientShader::MakeLinear(
+        gradient_pts, gradient_colors, nullptr, 2, SkTileMode::kClamp);
+    paint.setMaskFilter(SkShaderMaskFilter::Make(std::move(gradient)));
+    // shared quad opacity was folded into the gradient, so this will shorten
+    // any color filter chain needed for background blending
+    quad_alpha = 1.f;
   }
 
   // From gl_renderer, the final src color will be
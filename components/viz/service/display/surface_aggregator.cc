@@ -100,6 +100,17 @@ SurfaceAggregator::PrewalkResult::PrewalkResult() {}
 
 SurfaceAggregator::PrewalkResult::~PrewalkResult() {}
 
+SurfaceAggregator::CachedSurfaceContent::CachedSurfaceContent() = default;
+
+SurfaceAggregator::CachedSurfaceContent::CachedSurfaceContent(
+    CachedSurfaceContent&& other) = default;
+
+SurfaceAggregator::CachedSurfaceContent::~CachedSurfaceContent() = default;
+
+SurfaceAggregator::CachedSurfaceContent&
+SurfaceAggregator::CachedSurfaceContent::operator=(
+    CachedSurfaceContent&& other) = default;
+
 // Create a clip rect for an aggregated quad from the original clip rect and
 // the clip rect from the surface it's on.
 SurfaceAggregator::ClipData SurfaceAggregator::CalculateClipRect(
@@ -273,6 +284,68 @@ bool SurfaceAggregator::ProcessSurfaceOccludingDamage(
   return occluding_damage_rect_valid;
 }
 
+bool SurfaceAggregator::CanUseCachedSurfaceContent(
+    const CachedSurfaceContent& cached_content,
+    const Surface* surface,
+    const gfx::Transform& transform_to_root_target) {
+  if (cached_content.frame_index != surface->GetActiveFrameIndex() ||
+      !IsSurfaceFrameIndexSameAsPrevious(surface) ||
+      cached_content.output_is_secure != output_is_secure_ ||
+      cached_content.transform_to_root_target != transform_to_root_target) {
+    return false;
+  }
+
+  // Every embedded surface must still resolve to the same undamaged frame, or
+  // the cached quads would be stale.
+  for (const auto& embedded : cached_content.embedded_surfaces) {
+    Surface* embedded_surface =
+        manager_->GetLatestInFlightSurface(embedded.surface_range);
+    if (!embedded_surface || !embedded_surface->HasActiveFrame()) {
+      if (embedded.surface_id.is_valid())
+        return false;
+      continue;
+    }
+    if (embedded_surface->surface_id() != embedded.surface_id ||
+        embedded_surface->GetActiveFrameIndex() != embedded.frame_index ||
+        !IsSurfaceFrameIndexSameAsPrevious(embedded_surface) ||
+        base::ContainsKey(valid_surfaces_, embedded.surface_id) !=
+            embedded.is_valid) {
+      return false;
+    }
+  }
+
+  // The passes, and the RenderPassDrawQuads that refer to them, must keep
+  // their remapped ids.
+  DCHECK_EQ(cached_content.source_pass_ids.size(),
+            cached_content.render_passes.size());
+  for (size_t i = 0; i < cached_content.render_passes.size(); ++i) {
+    const auto& source_pass_id = cached_content.source_pass_ids[i];
+    if (RemapPassId(source_pass_id.second, source_pass_id.first) !=
+        cached_content.render_passes[i]->id) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void SurfaceAggregator::ClipDamageToRootDamage(RenderPass* pass) const {
+  // If the render pass has copy requests, or should be cached, or has
+  // moving-pixel filters, or in a moving-pixel surface, we should damage the
+  // whole output rect so that we always drawn the full content. Otherwise, we
+  // might have incompleted copy request, or cached patially drawn render
+  // pass.
+  if (RenderPassNeedsFullDamage(pass))
+    return;
+
+  gfx::Transform inverse_transform(gfx::Transform::kSkipInitialization);
+  if (pass->transform_to_root_target.GetInverse(&inverse_transform)) {
+    gfx::Rect damage_rect_in_render_pass_space =
+        cc::MathUtil::ProjectEnclosingClippedRect(inverse_transform,
+                                                  root_damage_rect_);
+    pass->damage_rect.Intersect(damage_rect_in_render_pass_space);
+  }
+}
+
 bool SurfaceAggregator::RenderPassNeedsFullDamage(
     const RenderPass* pass) const {
   if (copy_request_passes_.count(pass->id) || pass->cache_render_pass ||
@@ -308,6 +381,23 @@ void SurfaceAggregator::HandleSurfaceQuad(
   // can happen after a Viz process crash.
   Surface* latest_surface =
       manager_->GetLatestInFlightSurface(surface_quad->surface_range);
+
+  if (!cached_content_being_recorded_.empty()) {
+    CachedSurfaceContent* recorded_content =
+        cached_content_being_recorded_.back();
+    EmbeddedSurfaceInfo embedded;
+    embedded.surface_range = surface_quad->surface_range;
+    if (latest_surface && latest_surface->HasActiveFrame()) {
+      embedded.surface_id = latest_surface->surface_id();
+      embedded.frame_index = latest_surface->GetActiveFrameIndex();
+      embedded.is_valid =
+          base::ContainsKey(valid_surfaces_, embedded.surface_id);
+      if (!IsSurfaceFrameIndexSameAsPrevious(latest_surface))
+        recorded_content->can_be_cached = false;
+    }
+    recorded_content->embedded_surfaces.push_back(std::move(embedded));
+  }
+
   if (!latest_surface || !latest_surface->HasActiveFrame()) {
     EmitDefaultBackgroundColorQuad(surface_quad, target_transform, clip_rect,
                                    dest_pass, rounded_corner_info);
@@ -433,10 +523,61 @@ void SurfaceAggregator::EmitSurfaceContent(
       surface, render_pass_list, combined_transform, dest_pass,
       &occluding_damage_rect);
 
+  // When aggregating incrementally, the passes of a surface that isn't merged
+  // are either copied from what was aggregated for it before, or recorded so
+  // that they can be next time.
+  const size_t first_copied_pass_index = dest_pass_list_->size();
+  bool use_cached_content = false;
+  bool record_content = false;
+  CachedSurfaceContent recorded_content;
+  if (incremental_aggregation_ && !merge_pass && !has_copy_requests_ &&
+      copy_requests.empty() && !needs_surface_occluding_damage_rect_) {
+    gfx::Transform transform_to_root_target = combined_transform;
+    transform_to_root_target.ConcatTransform(
+        dest_pass->transform_to_root_target);
+
+    auto it = cached_surface_content_.find(surface_id);
+    if (it != cached_surface_content_.end() &&
+        CanUseCachedSurfaceContent(it->second, surface,
+                                   transform_to_root_target)) {
+      use_cached_content = true;
+      CachedSurfaceContent& cached_content = it->second;
+      cached_content.in_use = true;
+      for (const auto& cached_pass : cached_content.render_passes) {
+        std::unique_ptr<RenderPass> copy_pass = cached_pass->DeepCopy();
+        if (copy_pass->has_damage_from_contributing_content)
+          contributing_content_damaged_passes_.insert(copy_pass->id);
+        dest_pass_list_->push_back(std::move(copy_pass));
+      }
+      if (!cached_content_being_recorded_.empty()) {
+        CachedSurfaceContent* embedding_content =
+            cached_content_being_recorded_.back();
+        embedding_content->embedded_surfaces.insert(
+            embedding_content->embedded_surfaces.end(),
+            cached_content.embedded_surfaces.begin(),
+            cached_content.embedded_surfaces.end());
+        embedding_content->source_pass_ids.insert(
+            embedding_content->source_pass_ids.end(),
+            cached_content.source_pass_ids.begin(),
+            cached_content.source_pass_ids.end());
+      }
+    } else {
+      record_content = true;
+      recorded_content.frame_index = surface->GetActiveFrameIndex();
+      recorded_content.output_is_secure = output_is_secure_;
+      recorded_content.transform_to_root_target = transform_to_root_target;
+      recorded_content.can_be_cached = !has_surface_damage;
+      cached_content_being_recorded_.push_back(&recorded_content);
+    }
+  }
+
   const RenderPassList& referenced_passes = render_pass_list;
   // TODO(fsamuel): Move this to a separate helper function.
-  size_t passes_to_copy =
-      merge_pass ? referenced_passes.size() - 1 : referenced_passes.size();
+  size_t passes_to_copy = 0;
+  if (!use_cached_content) {
+    passes_to_copy =
+        merge_pass ? referenced_passes.size() - 1 : referenced_passes.size();
+  }
   for (size_t j = 0; j < passes_to_copy; ++j) {
     const RenderPass& source = *referenced_passes[j];
 
@@ -473,19 +614,16 @@ void SurfaceAggregator::EmitSurfaceContent(
                     RoundedCornerInfo(), occluding_damage_rect,
                     occluding_damage_rect_valid);
 
-    // If the render pass has copy requests, or should be cached, or has
-    // moving-pixel filters, or in a moving-pixel surface, we should damage the
-    // whole output rect so that we always drawn the full content. Otherwise, we
-    // might have incompleted copy request, or cached patially drawn render
-    // pass.
-    if (!RenderPassNeedsFullDamage(copy_pass.get())) {
-      gfx::Transform inverse_transform(gfx::Transform::kSkipInitialization);
-      if (copy_pass->transform_to_root_target.GetInverse(&inverse_transform)) {
-        gfx::Rect damage_rect_in_render_pass_space =
-            cc::MathUtil::ProjectEnclosingClippedRect(inverse_transform,
-                                                      root_damage_rect_);
-        copy_pass->damage_rect.Intersect(damage_rect_in_render_pass_space);
-      }
+    // The damage of recorded passes is clipped once the outermost recorded
+    // surface is done, so that the recorded copies keep their full damage.
+    if (cached_content_being_recorded_.empty()) {
+      ClipDamageToRootDamage(copy_pass.get());
+    } else {
+      CachedSurfaceContent* recording_content =
+          cached_content_being_recorded_.back();
+      recording_content->source_pass_ids.emplace_back(surface_id, source.id);
+      if (!copy_pass->copy_requests.empty())
+        recording_content->can_be_cached = false;
     }
 
     if (copy_pass->has_damage_from_contributing_content)
@@ -493,6 +631,42 @@ void SurfaceAggregator::EmitSurfaceContent(
     dest_pass_list_->push_back(std::move(copy_pass));
   }
 
+  if (record_content) {
+    DCHECK_EQ(cached_content_being_recorded_.back(), &recorded_content);
+    cached_content_being_recorded_.pop_back();
+    DCHECK_EQ(recorded_content.source_pass_ids.size(),
+              dest_pass_list_->size() - first_copied_pass_index);
+    if (!cached_content_being_recorded_.empty()) {
+      CachedSurfaceContent* embedding_content =
+          cached_content_being_recorded_.back();
+      embedding_content->embedded_surfaces.insert(
+          embedding_content->embedded_surfaces.end(),
+          recorded_content.embedded_surfaces.begin(),
+          recorded_content.embedded_surfaces.end());
+      embedding_content->source_pass_ids.insert(
+          embedding_content->source_pass_ids.end(),
+          recorded_content.source_pass_ids.begin(),
+          recorded_content.source_pass_ids.end());
+      embedding_content->can_be_cached &= recorded_content.can_be_cached;
+    }
+    if (recorded_content.can_be_cached) {
+      for (size_t i = first_copied_pass_index; i < dest_pass_list_->size();
+           ++i) {
+        recorded_content.render_passes.push_back(
+            (*dest_pass_list_)[i]->DeepCopy());
+      }
+      cached_surface_content_[surface_id] = std::move(recorded_content);
+    } else {
+      cached_surface_content_.erase(surface_id);
+    }
+  }
+
+  if ((use_cached_content || record_content) &&
+      cached_content_being_recorded_.empty()) {
+    for (size_t i = first_copied_pass_index; i < dest_pass_list_->size(); ++i)
+      ClipDamageToRootDamage((*dest_pass_list_)[i].get());
+  }
+
   gfx::Transform surface_transform = scaled_quad_to_target_transform;
   surface_transform.ConcatTransform(target_transform);
 
@@ -759,10 +933,12 @@ void SurfaceAggregator::CopyQuadsToPass(
   const SharedQuadState* last_copied_source_shared_quad_state = nullptr;
   // If the current frame has copy requests or cached render passes, then
   // aggregate the entire thing, as otherwise parts of the copy requests may be
-  // ignored and we could cache partially drawn render pass.
+  // ignored and we could cache partially drawn render pass. The same goes for
+  // surface content that is being recorded to be reused by later frames.
   const bool ignore_undamaged =
       aggregate_only_damaged_ && !has_copy_requests_ &&
-      !has_cached_render_passes_ && !moved_pixel_passes_.count(dest_pass->id);
+      !has_cached_render_passes_ && !moved_pixel_passes_.count(dest_pass->id) &&
+      cached_content_being_recorded_.empty();
   // Damage rect in the quad space of the current shared quad state.
   // TODO(jbauman): This rect may contain unnecessary area if
   // transform isn't axis-aligned.
@@ -935,20 +1111,7 @@ void SurfaceAggregator::CopyPasses(const CompositorFrame& frame,
                     RoundedCornerInfo(), occluding_damage_rect,
                     occluding_damage_rect_valid);
 
-    // If the render pass has copy requests, or should be cached, or has
-    // moving-pixel filters, or in a moving-pixel surface, we should damage the
-    // whole output rect so that we always drawn the full content. Otherwise, we
-    // might have incompleted copy request, or cached patially drawn render
-    // pass.
-    if (!RenderPassNeedsFullDamage(copy_pass.get())) {
-      gfx::Transform inverse_transform(gfx::Transform::kSkipInitialization);
-      if (copy_pass->transform_to_root_target.GetInverse(&inverse_transform)) {
-        gfx::Rect damage_rect_in_render_pass_space =
-            cc::MathUtil::ProjectEnclosingClippedRect(inverse_transform,
-                                                      root_damage_rect_);
-        copy_pass->damage_rect.Intersect(damage_rect_in_render_pass_space);
-      }
-    }
+    ClipDamageToRootDamage(copy_pass.get());
 
     if (copy_pass->has_damage_from_contributing_content)
       contributing_content_damaged_passes_.insert(copy_pass->id);
@@ -1378,6 +1541,17 @@ CompositorFrame SurfaceAggregator::Aggregate(
   contributing_content_damaged_passes_.clear();
   render_pass_dependencies_.clear();
 
+  // Remove all cached surface content that wasn't used in the current frame.
+  for (auto it = cached_surface_content_.begin();
+       it != cached_surface_content_.end();) {
+    if (it->second.in_use) {
+      it->second.in_use = false;
+      it++;
+    } else {
+      it = cached_surface_content_.erase(it);
+    }
+  }
+
   // Remove all render pass mappings that weren't used in the current frame.
   for (auto it = render_pass_allocator_map_.begin();
        it != render_pass_allocator_map_.end();) {
@@ -1419,6 +1593,8 @@ CompositorFrame SurfaceAggregator::Aggregate(
 void SurfaceAggregator::ReleaseResources(const SurfaceId& surface_id) {
   auto it = surface_id_to_resource_child_id_.find(surface_id);
   if (it != surface_id_to_resource_child_id_.end()) {
+    // Cached quads may refer to the resources' ids in the parent.
+    cached_surface_content_.clear();
     provider_->DestroyChild(it->second);
     surface_id_to_resource_child_id_.erase(it);
   }
@@ -1441,6 +1617,8 @@ void SurfaceAggregator::SetOutputColorSpace(
   output_color_space_ = output_color_space.IsValid()
                             ? output_color_space
                             : gfx::ColorSpace::CreateSRGB();
+  // Cached render passes are in the previous blending color space.
+  cached_surface_content_.clear();
 }
 
 bool SurfaceAggregator::NotifySurfaceDamageAndCheckForDisplayDamage(
@@ -8,6 +8,8 @@
 #include <memory>
 #include <string>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 #include "base/containers/flat_map.h"
 #include "base/containers/flat_set.h"
@@ -53,6 +55,15 @@ class VIZ_SERVICE_EXPORT SurfaceAggregator {
   void SetFullDamageForSurface(const SurfaceId& surface_id);
   void set_output_is_secure(bool secure) { output_is_secure_ = secure; }
 
+  // When enabled, the render passes that are aggregated for an embedded
+  // surface that is drawn into its own render pass are kept across
+  // aggregations. If neither the surface nor any surface it embeds has a new
+  // frame, and the surface is embedded with the same transform, the kept passes
+  // are reused instead of walking and copying the surface's quads again.
+  void set_incremental_aggregation(bool enabled) {
+    incremental_aggregation_ = enabled;
+  }
+
   // Set the color spaces for the created RenderPasses, which is propagated
   // to the output surface.
   void SetOutputColorSpace(const gfx::ColorSpace& blending_color_space,
@@ -88,6 +99,43 @@ class VIZ_SERVICE_EXPORT SurfaceAggregator {
     bool in_use = true;
   };
 
+  // A surface that was embedded by a SurfaceDrawQuad while aggregating the
+  // content of a CachedSurfaceContent, along with what it resolved to.
+  struct EmbeddedSurfaceInfo {
+    SurfaceRange surface_range;
+    // Invalid if |surface_range| didn't resolve to a surface with an active
+    // frame.
+    SurfaceId surface_id;
+    uint64_t frame_index = 0;
+    bool is_valid = false;
+  };
+
+  // The aggregated render passes of a surface that's not merged into its
+  // embedder, including the passes of the surfaces it embeds.
+  struct CachedSurfaceContent {
+    CachedSurfaceContent();
+    CachedSurfaceContent(CachedSurfaceContent&& other);
+    ~CachedSurfaceContent();
+    CachedSurfaceContent& operator=(CachedSurfaceContent&& other);
+
+    uint64_t frame_index = 0;
+    bool output_is_secure = false;
+    // The transform from the surface's root render pass to the root target,
+    // which all the aggregated passes' |transform_to_root_target| include.
+    gfx::Transform transform_to_root_target;
+    std::vector<EmbeddedSurfaceInfo> embedded_surfaces;
+    // The surface and source id each of the |render_passes| was remapped from.
+    std::vector<std::pair<SurfaceId, RenderPassId>> source_pass_ids;
+    // The passes, with their damage rects not yet clipped to the root damage.
+    RenderPassList render_passes;
+    // False if any of the surfaces had damage while this was aggregated.
+    bool can_be_cached = true;
+    // True if this was used in the last aggregated frame.
+    bool in_use = true;
+
+    DISALLOW_COPY_AND_ASSIGN(CachedSurfaceContent);
+  };
+
   struct RoundedCornerInfo {
     RoundedCornerInfo() : bounds(nullptr), is_fast_rounded_corner(false) {}
     RoundedCornerInfo(const gfx::RRectF* bounds, bool is_fast_rounded_corner)
@@ -189,6 +237,11 @@ class VIZ_SERVICE_EXPORT SurfaceAggregator {
                         bool will_draw,
                         PrewalkResult* result);
   void CopyUndrawnSurfaces(PrewalkResult* prewalk);
+  bool CanUseCachedSurfaceContent(
+      const CachedSurfaceContent& cached_content,
+      const Surface* surface,
+      const gfx::Transform& transform_to_root_target);
+  void ClipDamageToRootDamage(RenderPass* pass) const;
   void CopyPasses(const CompositorFrame& frame, Surface* surface);
   void AddColorConversionPass();
 
@@ -238,6 +291,7 @@ class VIZ_SERVICE_EXPORT SurfaceAggregator {
   RenderPassId next_render_pass_id_;
   const bool aggregate_only_damaged_;
   bool output_is_secure_;
+  bool incremental_aggregation_ = false;
 
   // The color space for the root render pass. If this is different from
   // |blending_color_space_|, then a final render pass to convert between
@@ -251,10 +305,19 @@ class VIZ_SERVICE_EXPORT SurfaceAggregator {
 
   base::flat_map<SurfaceId, int> surface_id_to_resource_child_id_;
 
+  // The aggregated content of undamaged surfaces when aggregating
+  // incrementally. An entry is removed if it's not used for one output frame.
+  base::flat_map<SurfaceId, CachedSurfaceContent> cached_surface_content_;
+
   // The following state is only valid for the duration of one Aggregate call
   // and is only stored on the class to avoid having to pass through every
   // function call.
 
+  // The content of the surfaces that are being aggregated while incrementally
+  // aggregating, innermost last. Surfaces embedded in these are recorded in
+  // the last one.
+  std::vector<CachedSurfaceContent*> cached_content_being_recorded_;
+
   // This is the set of surfaces referenced in the aggregation so far, used to
   // detect cycles.
   base::flat_set<SurfaceId> referenced_surfaces_;
@@ -42,6 +42,7 @@ class SurfaceAggregatorPerfTest : public testing::Test {
                float opacity,
                bool optimize_damage,
                bool full_damage,
+               bool incremental,
                const std::string& name) {
     std::vector<std::unique_ptr<CompositorFrameSinkSupport>> child_supports(
         num_surfaces);
@@ -55,6 +56,7 @@ class SurfaceAggregatorPerfTest : public testing::Test {
     aggregator_ = std::make_unique<SurfaceAggregator>(
         manager_.surface_manager(), resource_provider_.get(), optimize_damage,
         true);
+    aggregator_->set_incremental_aggregation(incremental);
     for (int i = 0; i < num_surfaces; i++) {
       LocalSurfaceId local_surface_id(i + 1, child_tokens[i]);
 
@@ -166,47 +168,64 @@ class SurfaceAggregatorPerfTest : public testing::Test {
 };
 
 TEST_F(SurfaceAggregatorPerfTest, ManySurfacesOpaque) {
-  RunTest(20, 100, 1.f, false, true, "many_surfaces_opaque");
+  RunTest(20, 100, 1.f, false, true, false, "many_surfaces_opaque");
 }
 
 TEST_F(SurfaceAggregatorPerfTest, ManySurfacesOpaque_100) {
-  RunTest(100, 1, 1.f, true, false, "(100 Surfaces, 1 quad each)");
+  RunTest(100, 1, 1.f, true, false, false, "(100 Surfaces, 1 quad each)");
 }
 
 TEST_F(SurfaceAggregatorPerfTest, ManySurfacesOpaque_300) {
-  RunTest(300, 1, 1.f, true, false, "(300 Surfaces, 1 quad each)");
+  RunTest(300, 1, 1.f, true, false, false, "(300 Surfaces, 1 quad each)");
 }
 
 TEST_F(SurfaceAggregatorPerfTest, ManySurfacesManyQuadsOpaque_100) {
-  RunTest(100, 100, 1.f, true, false, "(100 Surfaces, 100 quads each)");
+  RunTest(100, 100, 1.f, true, false, false, "(100 Surfaces, 100 quads each)");
 }
 
 TEST_F(SurfaceAggregatorPerfTest, ManySurfacesManyQuadsOpaque_300) {
-  RunTest(300, 100, 1.f, true, false, "(300 Surfaces, 100 quads each)");
+  RunTest(300, 100, 1.f, true, false, false, "(300 Surfaces, 100 quads each)");
 }
 
 TEST_F(SurfaceAggregatorPerfTest, ManySurfacesTransparent) {
-  RunTest(20, 100, .5f, false, true, "many_surfaces_transparent");
+  RunTest(20, 100, .5f, false, true, false, "many_surfaces_transparent");
 }
 
 TEST_F(SurfaceAggregatorPerfTest, FewSurfaces) {
-  RunTest(3, 1000, 1.f, false, true, "few_surfaces");
+  RunTest(3, 1000, 1.f, false, true, false, "few_surfaces");
 }
 
 TEST_F(SurfaceAggregatorPerfTest, ManySurfacesOpaqueDamageCalc) {
-  RunTest(20, 100, 1.f, true, true, "many_surfaces_opaque_damage_calc");
+  RunTest(20, 100, 1.f, true, true, false, "many_surfaces_opaque_damage_calc");
 }
 
 TEST_F(SurfaceAggregatorPerfTest, ManySurfacesTransparentDamageCalc) {
-  RunTest(20, 100, .5f, true, true, "many_surfaces_transparent_damage_calc");
+  RunTest(20, 100, .5f, true, true, false,
+          "many_surfaces_transparent_damage_calc");
 }
 
 TEST_F(SurfaceAggregatorPerfTest, FewSurfacesDamageCalc) {
-  RunTest(3, 1000, 1.f, true, true, "few_surfaces_damage_calc");
+  RunTest(3, 1000, 1.f, true, true, false, "few_surfaces_damage_calc");
 }
 
 TEST_F(SurfaceAggregatorPerfTest, FewSurfacesAggregateDamaged) {
-  RunTest(3, 1000, 1.f, true, false, "few_surfaces_aggregate_damaged");
+  RunTest(3, 1000, 1.f, true, false, false, "few_surfaces_aggregate_damaged");
+}
+
+TEST_F(SurfaceAggregatorPerfTest, ManySurfacesTransparentIncremental) {
+  RunTest(20, 100, .5f, false, true, true,
+          "many_surfaces_transparent_incremental");
+}
+
+TEST_F(SurfaceAggregatorPerfTest, ManySurfacesTransparentAggregateDamaged) {
+  RunTest(100, 100, .5f, true, false, false,
+          "(100 Surfaces, 100 quads each, transparent)");
+}
+
+TEST_F(SurfaceAggregatorPerfTest,
+       ManySurfacesTransparentAggregateDamagedIncremental) {
+  RunTest(100, 100, .5f, true, false, true,
+          "(100 Surfaces, 100 quads each, transparent, incremental)");
 }
 
 }  // namespace
@@ -631,6 +631,80 @@ TEST_F(SurfaceAggregatorValidSurfaceTest, OpacityCopied) {
   }
 }
 
+// Test that when aggregating incrementally, the render pass of a surface that
+// has no new frame is reused, and is aggregated again once it does.
+TEST_F(SurfaceAggregatorValidSurfaceTest, IncrementalAggregation) {
+  aggregator_.set_incremental_aggregation(true);
+
+  auto embedded_support = std::make_unique<CompositorFrameSinkSupport>(
+      nullptr, &manager_, kArbitraryFrameSinkId1, kRootIsRoot,
+      kNeedsSyncPoints);
+  ParentLocalSurfaceIdAllocator embedded_allocator;
+  embedded_allocator.GenerateId();
+  LocalSurfaceId embedded_local_surface_id =
+      embedded_allocator.GetCurrentLocalSurfaceIdAllocation()
+          .local_surface_id();
+  SurfaceId embedded_surface_id(embedded_support->frame_sink_id(),
+                                embedded_local_surface_id);
+
+  std::vector<Quad> embedded_quads = {
+      Quad::SolidColorQuad(SK_ColorGREEN, gfx::Rect(5, 5)),
+      Quad::SolidColorQuad(SK_ColorBLUE, gfx::Rect(5, 5))};
+  std::vector<Pass> embedded_passes = {Pass(embedded_quads, SurfaceSize())};
+
+  constexpr float device_scale_factor = 1.0f;
+  SubmitCompositorFrame(embedded_support.get(), embedded_passes,
+                        embedded_local_surface_id, device_scale_factor);
+  SurfaceId root_surface_id(root_sink_->frame_sink_id(),
+                            root_local_surface_id_);
+  std::vector<Quad> quads = {
+      Quad::SurfaceQuad(SurfaceRange(base::nullopt, embedded_surface_id),
+                        SK_ColorWHITE, gfx::Rect(5, 5), .5f, gfx::Transform(),
+                        /*stretch_content_to_fill_bounds=*/false,
+                        /*ignores_input_event=*/false)};
+  std::vector<Pass> passes = {Pass(quads, SurfaceSize())};
+
+  // The first frame of the embedded surface is damaged so it isn't kept, the
+  // second is kept, and the third reuses it.
+  RenderPassId embedded_pass_id = 0;
+  for (int i = 0; i < 3; ++i) {
+    SCOPED_TRACE(i);
+    SubmitCompositorFrame(root_sink_.get(), passes, root_local_surface_id_,
+                          device_scale_factor);
+
+    CompositorFrame aggregated_frame = aggregator_.Aggregate(
+        root_surface_id, GetNextDisplayTimeAndIncrement());
+
+    auto& render_pass_list = aggregated_frame.render_pass_list;
+    ASSERT_EQ(2u, render_pass_list.size());
+    if (i == 0)
+      embedded_pass_id = render_pass_list[0]->id;
+    std::vector<Quad> expected_quads = {
+        Quad::RenderPassQuad(embedded_pass_id)};
+    TestPassesMatchExpectations(
+        {Pass(embedded_quads, SurfaceSize()),
+         Pass(expected_quads, SurfaceSize())},
+        &render_pass_list);
+  }
+
+  std::vector<Quad> new_embedded_quads = {
+      Quad::SolidColorQuad(SK_ColorRED, gfx::Rect(5, 5))};
+  std::vector<Pass> new_embedded_passes = {
+      Pass(new_embedded_quads, SurfaceSize())};
+  SubmitCompositorFrame(embedded_support.get(), new_embedded_passes,
+                        embedded_local_surface_id, device_scale_factor);
+  SubmitCompositorFrame(root_sink_.get(), passes, root_local_surface_id_,
+                        device_scale_factor);
+
+  CompositorFrame aggregated_frame =
+      aggregator_.Aggregate(root_surface_id, GetNextDisplayTimeAndIncrement());
+
+  std::vector<Quad> expected_quads = {Quad::RenderPassQuad(embedded_pass_id)};
+  TestPassesMatchExpectations({Pass(new_embedded_quads, SurfaceSize()),
+                               Pass(expected_quads, SurfaceSize())},
+                              &aggregated_frame.render_pass_list);
+}
+
 // Test that when surface is rotated and we need the render surface to apply the
 // clip, we would keep the render surface.
 TEST_F(SurfaceAggregatorValidSurfaceTest, RotatedClip) {
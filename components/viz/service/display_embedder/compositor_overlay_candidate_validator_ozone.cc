@@ -9,6 +9,7 @@
 #include <utility>
 
 #include "components/viz/service/display/overlay_strategy_fullscreen.h"
+#include "components/viz/service/display/overlay_strategy_multiple.h"
 #include "components/viz/service/display/overlay_strategy_single_on_top.h"
 #include "components/viz/service/display/overlay_strategy_underlay.h"
 #include "components/viz/service/display/overlay_strategy_underlay_cast.h"
@@ -49,6 +50,9 @@ void CompositorOverlayCandidateValidatorOzone::GetStrategies(
         strategies->push_back(
             std::make_unique<OverlayStrategyUnderlayCast>(this));
         break;
+      case OverlayStrategy::kMultiple:
+        strategies->push_back(std::make_unique<OverlayStrategyMultiple>(this));
+        break;
       default:
         NOTREACHED();
     }
@@ -74,7 +78,7 @@ void CompositorOverlayCandidateValidatorOzone::CheckOverlaySupport(
     return;
   }
 
-  DCHECK_GE(2U, surfaces->size());
+  DCHECK_GE(GetMaxOverlayPlanes() + 1, surfaces->size());
   ui::OverlayCandidatesOzone::OverlaySurfaceCandidateList ozone_surface_list;
   ozone_surface_list.resize(surfaces->size());
 
@@ -99,6 +103,18 @@ void CompositorOverlayCandidateValidatorOzone::CheckOverlaySupport(
   }
 }
 
+size_t CompositorOverlayCandidateValidatorOzone::GetMaxOverlayPlanes() {
+  // Display controllers commonly have up to 4 planes. Configurations that
+  // the hardware can't scan out are rejected by CheckOverlaySupport().
+  return 3;
+}
+
+size_t CompositorOverlayCandidateValidatorOzone::GetOverlayPlaneCostInBytes() {
+  // Using a plane costs little bandwidth, but candidates smaller than this
+  // aren't worth the power of an extra plane.
+  return 256 * 256 * 4;
+}
+
 void CompositorOverlayCandidateValidatorOzone::SetSoftwareMirrorMode(
     bool enabled) {
   software_mirror_active_ = enabled;
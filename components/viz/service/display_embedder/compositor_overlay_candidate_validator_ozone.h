@@ -33,6 +33,8 @@ class VIZ_SERVICE_EXPORT CompositorOverlayCandidateValidatorOzone
   bool AllowCALayerOverlays() override;
   bool AllowDCLayerOverlays() override;
   void CheckOverlaySupport(OverlayCandidateList* surfaces) override;
+  size_t GetMaxOverlayPlanes() override;
+  size_t GetOverlayPlaneCostInBytes() override;
 
   // CompositorOverlayCandidateValidator implementation.
   void SetSoftwareMirrorMode(bool enabled) override;
@@ -30,11 +30,15 @@ std::array<uint32_t, 256> MakeCrc32Table() {
 // Minimalistic CRC-32 implementation for Zucchini usage. Adapted from LZMA SDK
 // (found at third_party/lzma_sdk/7zCrc.c), which is public domain.
 uint32_t CalculateCrc32(const uint8_t* first, const uint8_t* last) {
+  return UpdateCrc32(0, first, last);
+}
+
+uint32_t UpdateCrc32(uint32_t crc, const uint8_t* first, const uint8_t* last) {
   DCHECK_GE(last, first);
 
   static const std::array<uint32_t, 256> kCrc32Table = MakeCrc32Table();
 
-  uint32_t ret = 0xFFFFFFFF;
+  uint32_t ret = crc ^ 0xFFFFFFFF;
   for (; first != last; ++first)
     ret = kCrc32Table[(ret ^ *first) & 0xFF] ^ (ret >> 8);
   return ret ^ 0xFFFFFFFF;
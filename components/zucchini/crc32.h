@@ -12,6 +12,10 @@ namespace zucchini {
 // Calculates CRC-32 of the given range [|first|, |last|).
 uint32_t CalculateCrc32(const uint8_t* first, const uint8_t* last);
 
+// Extends |crc|, the CRC-32 of some data, to the CRC-32 of that data followed
+// by the range [|first|, |last|).
+uint32_t UpdateCrc32(uint32_t crc, const uint8_t* first, const uint8_t* last);
+
 }  // namespace zucchini
 
 #endif  // COMPONENTS_ZUCCHINI_CRC32_H_
@@ -44,4 +44,19 @@ TEST(Crc32Test, All) {
   EXPECT_DCHECK_DEATH(CalculateCrc32(std::begin(bytes) + 1, std::begin(bytes)));
 }
 
+TEST(Crc32Test, Update) {
+  // Extending by an empty region does not change the result.
+  EXPECT_EQ(0x00000000U, UpdateCrc32(0, std::begin(bytes), std::begin(bytes)));
+  EXPECT_EQ(0xCFB5FFE9U,
+            UpdateCrc32(0xCFB5FFE9U, std::begin(bytes), std::begin(bytes)));
+
+  // Any split of the whole region gives the same result.
+  for (const uint8_t* split = std::begin(bytes); split != std::end(bytes);
+       ++split) {
+    EXPECT_EQ(0xA86FD7D6U,
+              UpdateCrc32(CalculateCrc32(std::begin(bytes), split), split,
+                          std::end(bytes)));
+  }
+}
+
 }  // namespace zucchini
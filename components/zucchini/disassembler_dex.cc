@@ -8,6 +8,7 @@
 #include <stdlib.h>
 
 #include <algorithm>
+#include <array>
 #include <cctype>
 #include <cmath>
 #include <iterator>
@@ -229,6 +230,19 @@ class CodeItemParser {
 
 /******** InstructionParser ********/
 
+// Returns a table that maps each opcode to its DEX Instruction data, or to null
+// if the opcode is unknown.
+std::array<const dex::Instruction*, 256> MakeDalvikInstructionTable() {
+  std::array<const dex::Instruction*, 256> instruction_table;
+  instruction_table.fill(nullptr);
+  for (const dex::Instruction& instr : dex::kByteCode) {
+    std::fill(instruction_table.begin() + instr.opcode,
+              instruction_table.begin() + instr.opcode + instr.variant,
+              &instr);
+  }
+  return instruction_table;
+}
+
 // A class that successively reads |code_item| for Dalvik instructions, which
 // are found at |insns|, spanning |insns_size| uint16_t "units". These units
 // store instructions followed by optional non-instruction "payload". Finding
@@ -243,19 +257,11 @@ class InstructionParser {
 
   // Returns pointer to DEX Instruction data for |opcode|, or null if |opcode|
   // is unknown. An internal initialize-on-first-use table is used for fast
-  // lookup.
+  // lookup. Its initialization is thread-safe, since patch elements may be
+  // generated on several threads.
   const dex::Instruction* FindDalvikInstruction(uint8_t opcode) {
-    static bool is_init = false;
-    static const dex::Instruction* instruction_table[256];
-    if (!is_init) {
-      is_init = true;
-      std::fill(std::begin(instruction_table), std::end(instruction_table),
-                nullptr);
-      for (const dex::Instruction& instr : dex::kByteCode) {
-        std::fill(instruction_table + instr.opcode,
-                  instruction_table + instr.opcode + instr.variant, &instr);
-      }
-    }
+    static const std::array<const dex::Instruction*, 256> instruction_table =
+        MakeDalvikInstructionTable();
     return instruction_table[opcode];
   }
 
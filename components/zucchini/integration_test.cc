@@ -8,10 +8,13 @@
 #include <string>
 #include <vector>
 
+#include "base/bind.h"
 #include "base/files/file_path.h"
 #include "base/files/memory_mapped_file.h"
+#include "base/logging.h"
 #include "base/optional.h"
 #include "base/path_service.h"
+#include "base/timer/elapsed_timer.h"
 #include "components/zucchini/buffer_view.h"
 #include "components/zucchini/patch_reader.h"
 #include "components/zucchini/patch_writer.h"
@@ -29,6 +32,16 @@ base::FilePath MakeTestPath(const std::string& filename) {
       .AppendASCII(filename);
 }
 
+// Window size used to test streaming patch application. This is deliberately
+// small to exercise window boundaries.
+constexpr size_t kTestStreamingWindowSize = 4096;
+
+bool AppendChunk(std::vector<uint8_t>* buffer, ConstBufferView chunk) {
+  EXPECT_LE(chunk.size(), kTestStreamingWindowSize);
+  buffer->insert(buffer->end(), chunk.begin(), chunk.end());
+  return true;
+}
+
 void TestGenApply(const std::string& old_filename,
                   const std::string& new_filename,
                   bool raw) {
@@ -47,9 +60,13 @@ void TestGenApply(const std::string& old_filename,
   EnsemblePatchWriter patch_writer(old_region, new_region);
 
   // Generate patch from "old" to "new".
+  base::ElapsedTimer gen_timer;
   ASSERT_EQ(status::kStatusSuccess,
             raw ? GenerateBufferRaw(old_region, new_region, &patch_writer)
                 : GenerateBuffer(old_region, new_region, &patch_writer));
+  LOG(INFO) << "Generated " << (raw ? "raw " : "") << "patch from "
+            << old_filename << " to " << new_filename << " in "
+            << gen_timer.Elapsed().InMillisecondsF() << " ms";
 
   size_t patch_size = patch_writer.SerializedSize();
   EXPECT_GE(patch_size, 80U);  // Minimum size is empty patch.
@@ -79,6 +96,33 @@ void TestGenApply(const std::string& old_filename,
   // Note that |new_region| and |patched_new_buffer| are the same size.
   EXPECT_TRUE(std::equal(new_region.begin(), new_region.end(),
                          patched_new_buffer.begin()));
+
+  // Apply patch again, streaming "patched new" in windows.
+  std::vector<uint8_t> streamed_new_buffer;
+  ASSERT_EQ(status::kStatusSuccess,
+            ApplyBufferStreaming(
+                old_region, *patch_reader, kTestStreamingWindowSize,
+                base::BindRepeating(&AppendChunk, &streamed_new_buffer)));
+  EXPECT_EQ(patched_new_buffer, streamed_new_buffer);
+}
+
+// Returns the serialized patch from |old_filename| to |new_filename|.
+std::vector<uint8_t> GenerateSerializedPatch(const std::string& old_filename,
+                                             const std::string& new_filename) {
+  base::MemoryMappedFile old_file;
+  EXPECT_TRUE(old_file.Initialize(MakeTestPath(old_filename)));
+  base::MemoryMappedFile new_file;
+  EXPECT_TRUE(new_file.Initialize(MakeTestPath(new_filename)));
+
+  ConstBufferView old_region(old_file.data(), old_file.length());
+  ConstBufferView new_region(new_file.data(), new_file.length());
+  EnsemblePatchWriter patch_writer(old_region, new_region);
+  EXPECT_EQ(status::kStatusSuccess,
+            GenerateBuffer(old_region, new_region, &patch_writer));
+
+  std::vector<uint8_t> patch_buffer(patch_writer.SerializedSize());
+  patch_writer.SerializeInto({patch_buffer.data(), patch_buffer.size()});
+  return patch_buffer;
 }
 
 TEST(EndToEndTest, GenApplyRaw) {
@@ -100,4 +144,15 @@ TEST(EndToEndTest, GenApplyCross) {
   TestGenApply("setup1.exe", "chrome64_1.exe", false);
 }
 
+// Patch elements are generated on several threads, but the patch must not
+// depend on how they are scheduled.
+TEST(EndToEndTest, GenDeterministic) {
+  std::vector<uint8_t> patch =
+      GenerateSerializedPatch("chrome64_1.exe", "chrome64_2.exe");
+  for (int i = 0; i < 2; ++i) {
+    EXPECT_EQ(patch,
+              GenerateSerializedPatch("chrome64_1.exe", "chrome64_2.exe"));
+  }
+}
+
 }  // namespace zucchini
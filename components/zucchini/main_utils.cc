@@ -67,7 +67,7 @@ constexpr Command kCommands[] = {
      "-gen <old_file> <new_file> <patch_file> [-raw] [-keep]"
      " [-impose=#+#=#+#,#+#=#+#,...]",
      3, &MainGen},
-    {"apply", "-apply <old_file> <patch_file> <new_file> [-keep]", 3,
+    {"apply", "-apply <old_file> <patch_file> <new_file> [-keep] [-stream]", 3,
      &MainApply},
     {"read", "-read <exe> [-dump]", 1, &MainRead},
     {"detect", "-detect <archive_file>", 1, &MainDetect},
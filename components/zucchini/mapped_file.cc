@@ -4,6 +4,9 @@
 
 #include "components/zucchini/mapped_file.h"
 
+#include <limits.h>
+
+#include <algorithm>
 #include <utility>
 
 #include "base/files/file_util.h"
@@ -67,4 +70,62 @@ bool MappedFileWriter::Keep() {
   return true;
 }
 
+SequentialFileWriter::SequentialFileWriter(const base::FilePath& file_path,
+                                           base::File file)
+    : file_path_(file_path),
+      file_(std::move(file)),
+      delete_behavior_(kManualDeleteOnClose) {
+  if (!file_.IsValid()) {
+    error_ = "Invalid file.";
+    return;
+  }
+
+#if defined(OS_WIN)
+  // Tell the OS to delete the file when all handles are closed.
+  if (file_.DeleteOnClose(true)) {
+    delete_behavior_ = kAutoDeleteOnClose;
+  } else {
+    error_ = "Failed to mark file for delete-on-close.";
+  }
+#endif  // defined(OS_WIN)
+
+  // The file may be reused, so drop any previous content.
+  if (error_.empty() && !file_.SetLength(0))
+    error_ = "Can't truncate file.";
+}
+
+SequentialFileWriter::~SequentialFileWriter() {
+  // Close the file before deleting it, since deleting an open file fails on
+  // some systems.
+  file_.Close();
+  if (delete_behavior_ == kManualDeleteOnClose && !file_path_.empty())
+    base::DeleteFile(file_path_, false);
+}
+
+bool SequentialFileWriter::Write(ConstBufferView data) {
+  while (!data.empty()) {
+    int chunk_size =
+        static_cast<int>(std::min<size_t>(data.size(), INT_MAX));
+    int written = file_.WriteAtCurrentPos(
+        reinterpret_cast<const char*>(data.begin()), chunk_size);
+    if (written <= 0) {
+      error_ = "Can't write to file.";
+      return false;
+    }
+    data.remove_prefix(written);
+  }
+  return true;
+}
+
+bool SequentialFileWriter::Keep() {
+#if defined(OS_WIN)
+  if (delete_behavior_ == kAutoDeleteOnClose && !file_.DeleteOnClose(false)) {
+    error_ = "Failed to prevent deletion of file.";
+    return false;
+  }
+#endif  // defined(OS_WIN)
+  delete_behavior_ = kKeep;
+  return true;
+}
+
 }  // namespace zucchini
@@ -78,6 +78,42 @@ class MappedFileWriter {
   DISALLOW_COPY_AND_ASSIGN(MappedFileWriter);
 };
 
+// A file writer wrapper that writes data sequentially instead of mapping the
+// whole file to memory. Like MappedFileWriter, the target file is deleted on
+// destruction unless Keep() is called.
+class SequentialFileWriter {
+ public:
+  // Takes ownership of |file| for writing. |file_path| is needed for auto
+  // delete on UNIX systems, but can be empty if auto delete is not needed.
+  // Errors are available via HasError() and error().
+  SequentialFileWriter(const base::FilePath& file_path, base::File file);
+  ~SequentialFileWriter();
+
+  // Appends |data| to the file. Returns true iff the operation succeeds.
+  bool Write(ConstBufferView data);
+
+  bool HasError() { return !error_.empty() || !file_.IsValid(); }
+  const std::string& error() { return error_; }
+
+  // Indicates that the file should not be deleted on destruction. Returns true
+  // iff the operation succeeds.
+  bool Keep();
+
+ private:
+  enum OnCloseDeleteBehavior {
+    kKeep,
+    kAutoDeleteOnClose,
+    kManualDeleteOnClose
+  };
+
+  std::string error_;
+  base::FilePath file_path_;
+  base::File file_;
+  OnCloseDeleteBehavior delete_behavior_;
+
+  DISALLOW_COPY_AND_ASSIGN(SequentialFileWriter);
+};
+
 }  // namespace zucchini
 
 #endif  // COMPONENTS_ZUCCHINI_MAPPED_FILE_H_
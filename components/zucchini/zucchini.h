@@ -5,8 +5,11 @@
 #ifndef COMPONENTS_ZUCCHINI_ZUCCHINI_H_
 #define COMPONENTS_ZUCCHINI_ZUCCHINI_H_
 
+#include <stddef.h>
+
 #include <string>
 
+#include "base/callback.h"
 #include "components/zucchini/buffer_view.h"
 #include "components/zucchini/patch_reader.h"
 #include "components/zucchini/patch_writer.h"
@@ -37,6 +40,10 @@ enum Code {
 
 }  // namespace status
 
+// Receives consecutive chunks of an image being built, and returns true iff
+// the chunk is successfully consumed.
+using ChunkWriter = base::RepeatingCallback<bool(ConstBufferView)>;
+
 // Generates ensemble patch from |old_image| to |new_image| using the default
 // element detection and matching heuristics, writes the results to
 // |patch_writer|, and returns a status::Code.
@@ -67,6 +74,18 @@ status::Code ApplyBuffer(ConstBufferView old_image,
                          const EnsemblePatchReader& patch_reader,
                          MutableBufferView new_image);
 
+// Same as ApplyBuffer(), but instead of writing to preallocated memory, passes
+// the new image in order to |write_chunk|, in chunks of at most |window_size|
+// bytes. Raw (kExeTypeNoOp) elements are built directly into the window, and
+// other elements are built one at a time into a temporary buffer, since
+// reference correction needs random access to the element. Therefore memory
+// use is bounded by |window_size| plus the size of the largest executable
+// element, rather than by the size of the new image.
+status::Code ApplyBufferStreaming(ConstBufferView old_image,
+                                  const EnsemblePatchReader& patch_reader,
+                                  size_t window_size,
+                                  const ChunkWriter& write_chunk);
+
 }  // namespace zucchini
 
 #endif  // COMPONENTS_ZUCCHINI_ZUCCHINI_H_
@@ -8,9 +8,11 @@
 #include <map>
 #include <memory>
 #include <utility>
+#include <vector>
 
 #include "base/logging.h"
 #include "base/numerics/safe_conversions.h"
+#include "components/zucchini/crc32.h"
 #include "components/zucchini/disassembler.h"
 #include "components/zucchini/element_detection.h"
 #include "components/zucchini/equivalence_map.h"
@@ -190,6 +192,104 @@ bool ApplyElement(ExecutableType exe_type,
                                    new_image);
 }
 
+WindowedChunkWriter::WindowedChunkWriter(size_t window_size,
+                                         ChunkWriter write_chunk)
+    : write_chunk_(std::move(write_chunk)),
+      window_(window_size),
+      sink_(window_.data(), window_.size()) {
+  DCHECK_GT(window_size, 0U);
+}
+
+WindowedChunkWriter::~WindowedChunkWriter() = default;
+
+bool WindowedChunkWriter::Put(ConstBufferView data) {
+  size_ += data.size();
+  crc32_ = UpdateCrc32(crc32_, data.begin(), data.end());
+  while (!data.empty()) {
+    if (sink_.Remaining() == 0 && !Flush())
+      return false;
+    size_t length = std::min(data.size(), sink_.Remaining());
+    bool ok = sink_.PutRange(data.begin(), data.begin() + length);
+    DCHECK(ok);
+    data.remove_prefix(length);
+  }
+  return true;
+}
+
+bool WindowedChunkWriter::Flush() {
+  size_t length = window_.size() - sink_.Remaining();
+  sink_ = BufferSink(window_.data(), window_.size());
+  return length == 0 || write_chunk_.Run({window_.data(), length});
+}
+
+bool ApplyRawElementStreaming(ConstBufferView old_image,
+                              const PatchElementReader& patch_reader,
+                              offset_t new_size,
+                              WindowedChunkWriter* writer) {
+  EquivalenceSource equiv_source = patch_reader.GetEquivalenceSource();
+  ExtraDataSource extra_data_source = patch_reader.GetExtraDataSource();
+  RawDeltaSource raw_delta_source = patch_reader.GetRawDeltaSource();
+  // Traverse |equiv_source| and |raw_delta_source| in lockstep, writing each
+  // byte corrected by raw delta separately.
+  auto delta = raw_delta_source.GetNext();
+  offset_t base_copy_offset = 0;
+  offset_t dst_offset = 0;
+
+  for (auto equivalence = equiv_source.GetNext(); equivalence.has_value();
+       equivalence = equiv_source.GetNext()) {
+    CHECK_GE(equivalence->dst_offset, dst_offset);
+    CHECK_LE(equivalence->dst_end(), new_size);
+
+    offset_t gap = equivalence->dst_offset - dst_offset;
+    base::Optional<ConstBufferView> extra_data = extra_data_source.GetNext(gap);
+    if (!extra_data) {
+      LOG(ERROR) << "Error reading extra_data";
+      return false;
+    }
+    if (!writer->Put(*extra_data))
+      return false;
+
+    ConstBufferView src =
+        old_image[{equivalence->src_offset, equivalence->length}];
+    offset_t copied = 0;
+    for (; delta.has_value() &&
+           delta->copy_offset < base_copy_offset + equivalence->length;
+         delta = raw_delta_source.GetNext()) {
+      CHECK_GE(delta->copy_offset, base_copy_offset + copied);
+      offset_t delta_offset = delta->copy_offset - base_copy_offset;
+      // Invert byte diff.
+      const uint8_t corrected_byte =
+          static_cast<uint8_t>(src[delta_offset] + delta->diff);
+      if (!writer->Put(src[{copied, delta_offset - copied}]) ||
+          !writer->Put({&corrected_byte, 1})) {
+        return false;
+      }
+      copied = delta_offset + 1;
+    }
+    if (!writer->Put(src[{copied, equivalence->length - copied}]))
+      return false;
+    base_copy_offset += equivalence->length;
+    dst_offset = equivalence->dst_end();
+  }
+  offset_t gap = new_size - dst_offset;
+  base::Optional<ConstBufferView> extra_data = extra_data_source.GetNext(gap);
+  if (!extra_data) {
+    LOG(ERROR) << "Error reading extra_data";
+    return false;
+  }
+  if (!writer->Put(*extra_data))
+    return false;
+  if (!equiv_source.Done() || !extra_data_source.Done()) {
+    LOG(ERROR) << "Found trailing equivalence and extra_data";
+    return false;
+  }
+  if (delta.has_value() || !raw_delta_source.Done()) {
+    LOG(ERROR) << "Found trailing raw_delta";
+    return false;
+  }
+  return true;
+}
+
 /******** Exported Functions ********/
 
 status::Code ApplyBuffer(ConstBufferView old_image,
@@ -214,4 +314,47 @@ status::Code ApplyBuffer(ConstBufferView old_image,
   return status::kStatusSuccess;
 }
 
+status::Code ApplyBufferStreaming(ConstBufferView old_image,
+                                  const EnsemblePatchReader& patch_reader,
+                                  size_t window_size,
+                                  const ChunkWriter& write_chunk) {
+  if (!patch_reader.CheckOldFile(old_image)) {
+    LOG(ERROR) << "Invalid old_image.";
+    return status::kStatusInvalidOldImage;
+  }
+
+  WindowedChunkWriter writer(window_size, write_chunk);
+  std::vector<uint8_t> element_buffer;
+  for (const auto& element_patch : patch_reader.elements()) {
+    ElementMatch match = element_patch.element_match();
+    ConstBufferView old_element = old_image[match.old_element.region()];
+    if (match.exe_type() == kExeTypeNoOp) {
+      if (!ApplyRawElementStreaming(old_element, element_patch,
+                                    match.new_element.size, &writer)) {
+        return status::kStatusFatal;
+      }
+      continue;
+    }
+    // Elements are visited in order of their location in "new", so
+    // |element_buffer| is reused, and only grows to fit the largest element.
+    element_buffer.resize(match.new_element.size);
+    MutableBufferView new_element(element_buffer.data(),
+                                  element_buffer.size());
+    if (!ApplyElement(match.exe_type(), old_element, element_patch,
+                      new_element) ||
+        !writer.Put(ConstBufferView(new_element))) {
+      return status::kStatusFatal;
+    }
+  }
+  if (!writer.Flush())
+    return status::kStatusFatal;
+
+  const PatchHeader& header = patch_reader.header();
+  if (writer.size() != header.new_size || writer.crc32() != header.new_crc) {
+    LOG(ERROR) << "Invalid new_image.";
+    return status::kStatusInvalidNewImage;
+  }
+  return status::kStatusSuccess;
+}
+
 }  // namespace zucchini
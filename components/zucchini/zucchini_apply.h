@@ -5,8 +5,13 @@
 #ifndef COMPONENTS_ZUCCHINI_ZUCCHINI_APPLY_H_
 #define COMPONENTS_ZUCCHINI_ZUCCHINI_APPLY_H_
 
+#include <stddef.h>
+#include <stdint.h>
+
 #include <vector>
 
+#include "base/macros.h"
+#include "components/zucchini/buffer_sink.h"
 #include "components/zucchini/image_utils.h"
 #include "components/zucchini/patch_reader.h"
 #include "components/zucchini/zucchini.h"
@@ -38,6 +43,48 @@ bool ApplyElement(ExecutableType exe_type,
                   const PatchElementReader& patch_reader,
                   MutableBufferView new_image);
 
+// Collects bytes into a window of fixed size through a BufferSink, and passes
+// each full window to a ChunkWriter. Also keeps track of the CRC-32 of all
+// bytes written.
+class WindowedChunkWriter {
+ public:
+  WindowedChunkWriter(size_t window_size, ChunkWriter write_chunk);
+  ~WindowedChunkWriter();
+
+  // Appends |data|, passing each window to |write_chunk_| as it fills up.
+  // Returns false iff |write_chunk_| fails.
+  bool Put(ConstBufferView data);
+
+  // Passes bytes remaining in the window to |write_chunk_|. Returns false iff
+  // |write_chunk_| fails.
+  bool Flush();
+
+  // Returns the number of bytes written so far, including buffered bytes.
+  size_t size() const { return size_; }
+
+  // Returns the CRC-32 of all bytes written so far, including buffered bytes.
+  uint32_t crc32() const { return crc32_; }
+
+ private:
+  ChunkWriter write_chunk_;
+  std::vector<uint8_t> window_;
+  BufferSink sink_;
+  size_t size_ = 0;
+  uint32_t crc32_ = 0;
+
+  DISALLOW_COPY_AND_ASSIGN(WindowedChunkWriter);
+};
+
+// Applies equivalences, extra data and raw delta from |patch_reader| on
+// |old_image| to produce a new element of |new_size| bytes in order, and
+// writes the result to |writer|. This is equivalent to
+// ApplyEquivalenceAndExtraData() followed by ApplyRawDelta(), but does not need
+// the new element in memory, and is sufficient for elements without references.
+bool ApplyRawElementStreaming(ConstBufferView old_image,
+                              const PatchElementReader& patch_reader,
+                              offset_t new_size,
+                              WindowedChunkWriter* writer);
+
 }  // namespace zucchini
 
 #endif  // COMPONENTS_ZUCCHINI_ZUCCHINI_APPLY_H_
@@ -4,11 +4,66 @@
 
 #include "components/zucchini/zucchini_apply.h"
 
+#include <stdint.h>
+
+#include <vector>
+
+#include "base/bind.h"
+#include "components/zucchini/crc32.h"
 #include "components/zucchini/image_utils.h"
 #include "testing/gtest/include/gtest/gtest.h"
 
 namespace zucchini {
 
-// TODO(huangs): Add tests.
+namespace {
+
+bool AppendChunk(std::vector<std::vector<uint8_t>>* chunks,
+                 ConstBufferView chunk) {
+  chunks->emplace_back(chunk.begin(), chunk.end());
+  return true;
+}
+
+bool FailChunk(ConstBufferView chunk) {
+  return false;
+}
+
+}  // namespace
+
+TEST(WindowedChunkWriterTest, Put) {
+  const std::vector<uint8_t> bytes = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+  std::vector<std::vector<uint8_t>> chunks;
+  WindowedChunkWriter writer(4, base::BindRepeating(&AppendChunk, &chunks));
+
+  EXPECT_TRUE(writer.Put({bytes.data(), 3}));
+  EXPECT_TRUE(chunks.empty());
+  EXPECT_TRUE(writer.Put({bytes.data() + 3, 0}));
+  EXPECT_TRUE(chunks.empty());
+  EXPECT_TRUE(writer.Put({bytes.data() + 3, 7}));
+  EXPECT_EQ(10U, writer.size());
+  // The last window is only passed on once the next byte arrives, or on
+  // Flush().
+  EXPECT_EQ(std::vector<std::vector<uint8_t>>({{0, 1, 2, 3}, {4, 5, 6, 7}}),
+            chunks);
+
+  EXPECT_TRUE(writer.Flush());
+  EXPECT_EQ(3U, chunks.size());
+  EXPECT_EQ(std::vector<uint8_t>({8, 9}), chunks.back());
+  // Flushing an empty window does nothing.
+  EXPECT_TRUE(writer.Flush());
+  EXPECT_EQ(3U, chunks.size());
+
+  EXPECT_EQ(CalculateCrc32(bytes.data(), bytes.data() + bytes.size()),
+            writer.crc32());
+}
+
+TEST(WindowedChunkWriterTest, Fail) {
+  const std::vector<uint8_t> bytes = {0, 1, 2, 3, 4, 5};
+  WindowedChunkWriter writer1(4, base::BindRepeating(&FailChunk));
+  EXPECT_FALSE(writer1.Put({bytes.data(), bytes.size()}));
+
+  WindowedChunkWriter writer2(4, base::BindRepeating(&FailChunk));
+  EXPECT_TRUE(writer2.Put({bytes.data(), 2}));
+  EXPECT_FALSE(writer2.Flush());
+}
 
 }  // namespace zucchini
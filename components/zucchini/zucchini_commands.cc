@@ -33,6 +33,7 @@ constexpr char kSwitchDump[] = "dump";
 constexpr char kSwitchImpose[] = "impose";
 constexpr char kSwitchKeep[] = "keep";
 constexpr char kSwitchRaw[] = "raw";
+constexpr char kSwitchStream[] = "stream";
 
 }  // namespace
 
@@ -49,7 +50,8 @@ zucchini::status::Code MainApply(MainParams params) {
   CHECK_EQ(3U, params.file_paths.size());
   return zucchini::Apply(params.file_paths[0], params.file_paths[1],
                          params.file_paths[2],
-                         params.command_line.HasSwitch(kSwitchKeep));
+                         params.command_line.HasSwitch(kSwitchKeep),
+                         params.command_line.HasSwitch(kSwitchStream));
 }
 
 zucchini::status::Code MainRead(MainParams params) {
@@ -8,13 +8,19 @@
 #include <stdint.h>
 
 #include <algorithm>
+#include <functional>
 #include <map>
 #include <memory>
 #include <string>
 #include <utility>
 
+#include "base/bind.h"
+#include "base/callback.h"
 #include "base/logging.h"
+#include "base/macros.h"
 #include "base/numerics/safe_conversions.h"
+#include "base/system/sys_info.h"
+#include "base/threading/simple_thread.h"
 #include "components/zucchini/disassembler.h"
 #include "components/zucchini/element_detection.h"
 #include "components/zucchini/encoded_view.h"
@@ -36,6 +42,52 @@ namespace {
 constexpr double kMinEquivalenceSimilarity = 12.0;
 constexpr double kMinLabelAffinity = 64.0;
 
+// Upper bound on the number of threads that generate patch elements. Every
+// element in progress holds its own suffix array and ImageIndexes, so this also
+// bounds peak memory usage.
+constexpr int kMaxGenerationThreads = 4;
+
+// Generates one patch element, possibly on a worker thread of a
+// base::DelegateSimpleThreadPool. Each element is written to its own
+// PatchElementWriter, so the patch doesn't depend on scheduling.
+class ElementGenerationTask : public base::DelegateSimpleThread::Delegate {
+ public:
+  explicit ElementGenerationTask(base::OnceCallback<bool()> generate)
+      : generate_(std::move(generate)) {}
+  ~ElementGenerationTask() override = default;
+
+  // base::DelegateSimpleThread::Delegate:
+  void Run() override { success_ = std::move(generate_).Run(); }
+
+  bool success() const { return success_; }
+
+ private:
+  base::OnceCallback<bool()> generate_;
+  bool success_ = false;
+
+  DISALLOW_COPY_AND_ASSIGN(ElementGenerationTask);
+};
+
+// Runs all |tasks|, on up to kMaxGenerationThreads threads, and returns once
+// they are done.
+void RunElementGenerationTasks(
+    const std::vector<std::unique_ptr<ElementGenerationTask>>& tasks) {
+  int num_threads =
+      std::min({base::SysInfo::NumberOfProcessors(), kMaxGenerationThreads,
+                base::checked_cast<int>(tasks.size())});
+  if (num_threads <= 1) {
+    for (const auto& task : tasks)
+      task->Run();
+    return;
+  }
+
+  base::DelegateSimpleThreadPool pool("ZucchiniGen", num_threads);
+  for (const auto& task : tasks)
+    pool.AddWork(task.get());
+  pool.Start();
+  pool.JoinAll();
+}
+
 }  // namespace
 
 std::vector<offset_t> FindExtraTargets(const TargetPool& projected_old_targets,
@@ -353,11 +405,10 @@ status::Code GenerateBufferCommon(ConstBufferView old_image,
   size_t covered_new_bytes = 0;
 
   // Process elements first, since non-fatal failures may turn some into gaps.
+  // Elements are independent of each other, so they are generated in parallel.
+  std::vector<std::unique_ptr<ElementGenerationTask>> element_tasks;
   for (const ElementMatch& match : matches) {
     BufferRegion new_region = match.new_element.region();
-    LOG(INFO) << "--- Match [" << new_region.lo() << "," << new_region.hi()
-              << ")";
-
     auto it_and_success = patch_element_map.emplace(
         base::checked_cast<offset_t>(new_region.lo()), match);
     DCHECK(it_and_success.second);
@@ -365,13 +416,22 @@ status::Code GenerateBufferCommon(ConstBufferView old_image,
 
     ConstBufferView old_sub_image = old_image[match.old_element.region()];
     ConstBufferView new_sub_image = new_image[new_region];
-    if (GenerateExecutableElement(match.exe_type(), old_sub_image,
-                                  new_sub_image, &patch_element)) {
+    element_tasks.push_back(std::make_unique<ElementGenerationTask>(
+        base::BindOnce(&GenerateExecutableElement, match.exe_type(),
+                       old_sub_image, new_sub_image, &patch_element)));
+  }
+  RunElementGenerationTasks(element_tasks);
+
+  for (size_t i = 0; i < matches.size(); ++i) {
+    BufferRegion new_region = matches[i].new_element.region();
+    LOG(INFO) << "--- Match [" << new_region.lo() << "," << new_region.hi()
+              << ")";
+    if (element_tasks[i]->success()) {
       covered_new_regions.push_back(new_region);
       covered_new_bytes += new_region.size;
     } else {
       LOG(INFO) << "Fall back to raw patching.";
-      patch_element_map.erase(it_and_success.first);
+      patch_element_map.erase(base::checked_cast<offset_t>(new_region.lo()));
     }
   }
 
@@ -390,6 +450,8 @@ status::Code GenerateBufferCommon(ConstBufferView old_image,
     // Add sentinel that points to end of "new" file, to simplify gap iteration.
     covered_new_regions.emplace_back(BufferRegion{new_image.size(), 0});
 
+    // Gaps only read |old_sa_raw|, so they are also generated in parallel.
+    std::vector<std::unique_ptr<ElementGenerationTask>> gap_tasks;
     for (const BufferRegion& covered : covered_new_regions) {
       offset_t gap_hi = base::checked_cast<offset_t>(covered.lo());
       DCHECK_GE(gap_hi, gap_lo);
@@ -404,13 +466,18 @@ status::Code GenerateBufferCommon(ConstBufferView old_image,
         PatchElementWriter& patch_element = it_and_success.first->second;
 
         ConstBufferView new_sub_image = new_image[{gap_lo, gap_size}];
-        if (!GenerateRawElement(old_sa_raw, old_image, new_sub_image,
-                                &patch_element)) {
-          return status::kStatusFatal;
-        }
+        gap_tasks.push_back(std::make_unique<ElementGenerationTask>(
+            base::BindOnce(&GenerateRawElement, std::cref(old_sa_raw),
+                           old_image, new_sub_image, &patch_element)));
       }
       gap_lo = base::checked_cast<offset_t>(covered.hi());
     }
+    RunElementGenerationTasks(gap_tasks);
+
+    for (const auto& task : gap_tasks) {
+      if (!task->success())
+        return status::kStatusFatal;
+    }
   }
 
   // Write all PatchElementWriter sorted by "new" offset.
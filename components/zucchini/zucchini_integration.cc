@@ -6,6 +6,7 @@
 
 #include <utility>
 
+#include "base/bind.h"
 #include "base/logging.h"
 #include "components/zucchini/buffer_view.h"
 #include "components/zucchini/mapped_file.h"
@@ -15,6 +16,9 @@ namespace zucchini {
 
 namespace {
 
+// Window size for streaming patch application.
+constexpr size_t kStreamingWindowSize = 1 << 20;
+
 struct FileNames {
   FileNames() : is_dummy(true) {
     // Use fake names.
@@ -95,11 +99,48 @@ status::Code GenerateCommon(base::File old_file,
   return status::kStatusSuccess;
 }
 
+status::Code ApplyStreamingCommon(ConstBufferView old_image,
+                                  const EnsemblePatchReader& patch_reader,
+                                  base::File new_file,
+                                  const FileNames& names,
+                                  bool force_keep) {
+  // By default, delete output on destruction, to avoid having lingering files
+  // in case of a failure. On Windows deletion can be done by the OS.
+  SequentialFileWriter new_writer(names.new_name, std::move(new_file));
+  if (new_writer.HasError()) {
+    LOG(ERROR) << "Error with file " << names.new_name.value() << ": "
+               << new_writer.error();
+    return status::kStatusFileWriteError;
+  }
+  if (force_keep)
+    new_writer.Keep();
+
+  status::Code result = ApplyBufferStreaming(
+      old_image, patch_reader, kStreamingWindowSize,
+      base::BindRepeating(&SequentialFileWriter::Write,
+                          base::Unretained(&new_writer)));
+  if (new_writer.HasError()) {
+    LOG(ERROR) << "Error with file " << names.new_name.value() << ": "
+               << new_writer.error();
+    return status::kStatusFileWriteError;
+  }
+  if (result != status::kStatusSuccess) {
+    LOG(ERROR) << "Fatal error encountered while applying patch.";
+    return result;
+  }
+
+  // Successfully patch |new_writer|. Explicitly request file to be kept.
+  if (!new_writer.Keep())
+    return status::kStatusFileWriteError;
+  return status::kStatusSuccess;
+}
+
 status::Code ApplyCommon(base::File old_file,
                          base::File patch_file,
                          base::File new_file,
                          const FileNames& names,
-                         bool force_keep) {
+                         bool force_keep,
+                         bool streaming) {
   MappedFileReader mapped_patch(std::move(patch_file));
   if (mapped_patch.HasError()) {
     LOG(ERROR) << "Error with file " << names.patch_name.value() << ": "
@@ -120,6 +161,11 @@ status::Code ApplyCommon(base::File old_file,
     return status::kStatusFileReadError;
   }
 
+  if (streaming) {
+    return ApplyStreamingCommon(mapped_old.region(), *patch_reader,
+                                std::move(new_file), names, force_keep);
+  }
+
   PatchHeader header = patch_reader->header();
   // By default, delete output on destruction, to avoid having lingering files
   // in case of a failure. On Windows deletion can be done by the OS.
@@ -181,16 +227,18 @@ status::Code Generate(const base::FilePath& old_path,
 status::Code Apply(base::File old_file,
                    base::File patch_file,
                    base::File new_file,
-                   bool force_keep) {
+                   bool force_keep,
+                   bool streaming) {
   const FileNames file_names;
   return ApplyCommon(std::move(old_file), std::move(patch_file),
-                     std::move(new_file), file_names, force_keep);
+                     std::move(new_file), file_names, force_keep, streaming);
 }
 
 status::Code Apply(const base::FilePath& old_path,
                    const base::FilePath& patch_path,
                    const base::FilePath& new_path,
-                   bool force_keep) {
+                   bool force_keep,
+                   bool streaming) {
   using base::File;
   File old_file(old_path, File::FLAG_OPEN | File::FLAG_READ);
   File patch_file(patch_path, File::FLAG_OPEN | File::FLAG_READ);
@@ -199,7 +247,7 @@ status::Code Apply(const base::FilePath& old_path,
                               File::FLAG_CAN_DELETE_ON_CLOSE);
   const FileNames file_names(old_path, new_path, patch_path);
   return ApplyCommon(std::move(old_file), std::move(patch_file),
-                     std::move(new_file), file_names, force_keep);
+                     std::move(new_file), file_names, force_keep, streaming);
 }
 
 }  // namespace zucchini
@@ -50,18 +50,22 @@ status::Code Generate(const base::FilePath& old_path,
 // kStatusSuccess or if |force_keep == true|, and is deleted otherwise. For UNIX
 // systems the caller needs to do cleanup since it has ownership of the
 // base::File params, and Zucchini has no knowledge of which base::FilePath to
-// delete.
+// delete. If |streaming == true| then |new_file| is written sequentially
+// instead of being mapped to memory, so that memory use does not scale with the
+// size of |new_file| (see ApplyBufferStreaming()).
 status::Code Apply(base::File old_file,
                    base::File patch_file,
                    base::File new_file,
-                   bool force_keep = false);
+                   bool force_keep = false,
+                   bool streaming = false);
 
 // Alternative Apply() interface that takes base::FilePath as arguments.
 // Performs proper cleanup in Windows and UNIX if failure occurs.
 status::Code Apply(const base::FilePath& old_path,
                    const base::FilePath& patch_path,
                    const base::FilePath& new_path,
-                   bool force_keep = false);
+                   bool force_keep = false,
+                   bool streaming = false);
 
 }  // namespace zucchini
 
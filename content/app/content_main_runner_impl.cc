@@ -316,6 +316,11 @@ void InitializeZygoteSandboxForBrowserProcess(
   // conditions.
   service_manager::ZygoteHostImpl::GetInstance()->SetRendererSandboxStatus(
       generic_zygote->GetSandboxStatus());
+
+  if (parsed_command_line.HasSwitch(switches::kEnableUtilityZygote)) {
+    service_manager::CreateUnsandboxedZygote(
+        base::BindOnce(LaunchZygoteHelper));
+  }
 }
 #endif  // BUILDFLAG(USE_ZYGOTE_HANDLE)
 
@@ -100,6 +100,7 @@ class SaveFileManager;
 class ScreenlockMonitor;
 class ServiceManagerContext;
 class SpeechRecognitionManagerImpl;
+class StartupTaskGraph;
 class StartupTaskRunner;
 class SwapMetricsDriver;
 class TracingControllerImpl;
@@ -348,6 +349,8 @@ class CONTENT_EXPORT BrowserMainLoop {
 
   // Members initialized in |BrowserThreadsStarted()| --------------------------
   std::unique_ptr<mojo::core::ScopedIPCSupport> mojo_ipc_support_;
+  // Startup work that isn't needed to show the first page.
+  std::unique_ptr<StartupTaskGraph> deferred_startup_tasks_;
   std::unique_ptr<MediaKeysListenerManagerImpl> media_keys_listener_manager_;
 #if defined(OS_MACOSX)
   std::unique_ptr<now_playing::RemoteCommandCenterDelegate>
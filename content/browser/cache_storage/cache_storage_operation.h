@@ -22,7 +22,9 @@ class CONTENT_EXPORT CacheStorageOperation {
  public:
   CacheStorageOperation(
       base::OnceClosure closure,
+      CacheStorageSchedulerId id,
       CacheStorageSchedulerClient client_type,
+      CacheStorageSchedulerMode mode,
       CacheStorageSchedulerOp op_type,
       scoped_refptr<base::SingleThreadTaskRunner> task_runner);
 
@@ -32,6 +34,8 @@ class CONTENT_EXPORT CacheStorageOperation {
   void Run();
 
   base::TimeTicks creation_ticks() const { return creation_ticks_; }
+  CacheStorageSchedulerId id() const { return id_; }
+  CacheStorageSchedulerMode mode() const { return mode_; }
   CacheStorageSchedulerOp op_type() const { return op_type_; }
   base::WeakPtr<CacheStorageOperation> AsWeakPtr() {
     return weak_ptr_factory_.GetWeakPtr();
@@ -52,7 +56,9 @@ class CONTENT_EXPORT CacheStorageOperation {
   // If the operation took a long time to run.
   bool was_slow_ = false;
 
+  const CacheStorageSchedulerId id_;
   const CacheStorageSchedulerClient client_type_;
+  const CacheStorageSchedulerMode mode_;
   const CacheStorageSchedulerOp op_type_;
   scoped_refptr<base::SingleThreadTaskRunner> task_runner_;
   base::WeakPtrFactory<CacheStorageOperation> weak_ptr_factory_;
@@ -38,8 +38,9 @@ class CacheStorageOperationTest : public testing::Test {
   CacheStorageOperationTest()
       : mock_task_runner_(new base::TestMockTimeTaskRunner()) {
     operation_ = std::make_unique<CacheStorageOperation>(
-        base::BindOnce(&TestTask::Run, base::Unretained(&task_)),
-        CacheStorageSchedulerClient::kStorage, CacheStorageSchedulerOp::kTest,
+        base::BindOnce(&TestTask::Run, base::Unretained(&task_)), 0 /* id */,
+        CacheStorageSchedulerClient::kStorage,
+        CacheStorageSchedulerMode::kExclusive, CacheStorageSchedulerOp::kTest,
         mock_task_runner_);
   }
 
@@ -11,6 +11,7 @@
 #include "base/logging.h"
 #include "base/metrics/histogram_macros.h"
 #include "base/single_thread_task_runner.h"
+#include "base/stl_util.h"
 #include "base/threading/thread_task_runner_handle.h"
 #include "content/browser/cache_storage/cache_storage_histogram_utils.h"
 #include "content/browser/cache_storage/cache_storage_operation.h"
@@ -23,43 +24,81 @@ CacheStorageScheduler::CacheStorageScheduler(
 
 CacheStorageScheduler::~CacheStorageScheduler() {}
 
-void CacheStorageScheduler::ScheduleOperation(CacheStorageSchedulerOp op_type,
+CacheStorageSchedulerId CacheStorageScheduler::CreateId() {
+  return next_id_++;
+}
+
+void CacheStorageScheduler::ScheduleOperation(CacheStorageSchedulerId id,
+                                              CacheStorageSchedulerMode mode,
+                                              CacheStorageSchedulerOp op_type,
                                               base::OnceClosure closure) {
   RecordCacheStorageSchedulerUMA(CacheStorageSchedulerUMA::kQueueLength,
                                  client_type_, op_type,
                                  pending_operations_.size());
 
   pending_operations_.push_back(std::make_unique<CacheStorageOperation>(
-      std::move(closure), client_type_, op_type,
+      std::move(closure), id, client_type_, mode, op_type,
       base::ThreadTaskRunnerHandle::Get()));
-  RunOperationIfIdle();
+  MaybeRunOperation();
 }
 
-void CacheStorageScheduler::CompleteOperationAndRunNext() {
-  DCHECK(running_operation_);
-  running_operation_.reset();
+void CacheStorageScheduler::ScheduleOperation(CacheStorageSchedulerOp op_type,
+                                              base::OnceClosure closure) {
+  ScheduleOperation(CreateId(), CacheStorageSchedulerMode::kExclusive, op_type,
+                    std::move(closure));
+}
 
-  RunOperationIfIdle();
+void CacheStorageScheduler::CompleteOperationAndRunNext(
+    CacheStorageSchedulerId id) {
+  auto it = running_operations_.find(id);
+  DCHECK(it != running_operations_.end());
+  if (it->second->mode() == CacheStorageSchedulerMode::kShared) {
+    DCHECK_GT(num_running_shared_, 0);
+    --num_running_shared_;
+  }
+  running_operations_.erase(it);
+
+  MaybeRunOperation();
+}
+
+void CacheStorageScheduler::CompleteOperationAndRunNext() {
+  DCHECK_EQ(1u, running_operations_.size());
+  DCHECK_EQ(0, num_running_shared_);
+  CompleteOperationAndRunNext(running_operations_.begin()->first);
 }
 
 bool CacheStorageScheduler::ScheduledOperations() const {
-  return running_operation_ || !pending_operations_.empty();
+  return !running_operations_.empty() || !pending_operations_.empty();
 }
 
-void CacheStorageScheduler::RunOperationIfIdle() {
-  if (!running_operation_ && !pending_operations_.empty()) {
-    // TODO(jkarlin): Run multiple operations in parallel where allowed.
-    running_operation_ = std::move(pending_operations_.front());
+void CacheStorageScheduler::MaybeRunOperation() {
+  // Operations start in order. A shared operation can start while only shared
+  // operations are running, and an exclusive one only when nothing is.
+  while (!pending_operations_.empty()) {
+    CacheStorageOperation* next = pending_operations_.front().get();
+    if (next->mode() == CacheStorageSchedulerMode::kExclusive) {
+      if (!running_operations_.empty())
+        return;
+    } else {
+      // An exclusive operation is running if not every running one is shared.
+      if (running_operations_.size() !=
+          static_cast<size_t>(num_running_shared_)) {
+        return;
+      }
+      ++num_running_shared_;
+    }
+
+    DCHECK(!base::ContainsKey(running_operations_, next->id()));
+    running_operations_[next->id()] = std::move(pending_operations_.front());
     pending_operations_.pop_front();
 
     RecordCacheStorageSchedulerUMA(
         CacheStorageSchedulerUMA::kQueueDuration, client_type_,
-        running_operation_->op_type(),
-        base::TimeTicks::Now() - running_operation_->creation_ticks());
+        next->op_type(), base::TimeTicks::Now() - next->creation_ticks());
 
     base::ThreadTaskRunnerHandle::Get()->PostTask(
-        FROM_HERE, base::BindOnce(&CacheStorageOperation::Run,
-                                  running_operation_->AsWeakPtr()));
+        FROM_HERE,
+        base::BindOnce(&CacheStorageOperation::Run, next->AsWeakPtr()));
   }
 }
 
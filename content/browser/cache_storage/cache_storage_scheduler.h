@@ -6,6 +6,8 @@
 #define CONTENT_BROWSER_CACHE_STORAGE_CACHE_STORAGE_SCHEDULER_H_
 
 #include <list>
+#include <map>
+#include <memory>
 
 #include "base/bind.h"
 #include "base/callback.h"
@@ -19,57 +21,101 @@ namespace content {
 
 class CacheStorageOperation;
 
-// TODO(jkarlin): Support readers and writers so operations can run in parallel.
 // TODO(jkarlin): Support operation identification so that ops can be checked in
 // DCHECKs.
 
-// CacheStorageScheduler runs the scheduled callbacks sequentially. Add an
+// CacheStorageScheduler runs the scheduled callbacks in order. Add an
 // operation by calling ScheduleOperation() with your callback. Once your
 // operation is done be sure to call CompleteOperationAndRunNext() to schedule
 // the next operation.
+//
+// Exclusive operations run one at a time. Consecutive shared operations, such
+// as reads, run in parallel once every earlier operation has started, and an
+// exclusive operation waits for all of them to complete. Shared operations
+// must be scheduled with an id from CreateId() so that they can be completed
+// individually.
 class CONTENT_EXPORT CacheStorageScheduler {
  public:
   explicit CacheStorageScheduler(CacheStorageSchedulerClient client_type);
   virtual ~CacheStorageScheduler();
 
+  // Returns a new id for ScheduleOperation().
+  CacheStorageSchedulerId CreateId();
+
   // Adds the operation to the tail of the queue and starts it if the scheduler
-  // is idle.
+  // is idle, or if it is shared and only shared operations are running.
+  void ScheduleOperation(CacheStorageSchedulerId id,
+                         CacheStorageSchedulerMode mode,
+                         CacheStorageSchedulerOp op_type,
+                         base::OnceClosure closure);
+
+  // Schedules an exclusive operation with a new id.
   void ScheduleOperation(CacheStorageSchedulerOp op_type,
                          base::OnceClosure closure);
 
-  // Call this after each operation completes. It cleans up the current
-  // operation and starts the next.
+  // Call this after each operation completes. It cleans up the operation and
+  // starts the next ones that can run.
+  void CompleteOperationAndRunNext(CacheStorageSchedulerId id);
+
+  // Completes the running operation, which must be exclusive.
   void CompleteOperationAndRunNext();
 
   // Returns true if there are any running or pending operations.
   bool ScheduledOperations() const;
 
-  // Wraps |callback| to also call CompleteOperationAndRunNext.
+  // Wraps |callback| to also call CompleteOperationAndRunNext(id).
   template <typename... Args>
   base::OnceCallback<void(Args...)> WrapCallbackToRunNext(
+      CacheStorageSchedulerId id,
       base::OnceCallback<void(Args...)> callback) {
     return base::BindOnce(&CacheStorageScheduler::RunNextContinuation<Args...>,
-                          weak_ptr_factory_.GetWeakPtr(), std::move(callback));
+                          weak_ptr_factory_.GetWeakPtr(), id,
+                          std::move(callback));
+  }
+
+  // Wraps |callback| to also complete the running exclusive operation.
+  template <typename... Args>
+  base::OnceCallback<void(Args...)> WrapCallbackToRunNext(
+      base::OnceCallback<void(Args...)> callback) {
+    return base::BindOnce(
+        &CacheStorageScheduler::RunNextExclusiveContinuation<Args...>,
+        weak_ptr_factory_.GetWeakPtr(), std::move(callback));
   }
 
  private:
-  void RunOperationIfIdle();
+  void MaybeRunOperation();
 
   template <typename... Args>
-  void RunNextContinuation(base::OnceCallback<void(Args...)> callback,
+  void RunNextContinuation(CacheStorageSchedulerId id,
+                           base::OnceCallback<void(Args...)> callback,
                            Args... args) {
     // Grab a weak ptr to guard against the scheduler being deleted during the
     // callback.
     base::WeakPtr<CacheStorageScheduler> scheduler =
         weak_ptr_factory_.GetWeakPtr();
 
+    std::move(callback).Run(std::forward<Args>(args)...);
+    if (scheduler)
+      CompleteOperationAndRunNext(id);
+  }
+
+  template <typename... Args>
+  void RunNextExclusiveContinuation(base::OnceCallback<void(Args...)> callback,
+                                    Args... args) {
+    base::WeakPtr<CacheStorageScheduler> scheduler =
+        weak_ptr_factory_.GetWeakPtr();
+
     std::move(callback).Run(std::forward<Args>(args)...);
     if (scheduler)
       CompleteOperationAndRunNext();
   }
 
   std::list<std::unique_ptr<CacheStorageOperation>> pending_operations_;
-  std::unique_ptr<CacheStorageOperation> running_operation_;
+  std::map<CacheStorageSchedulerId, std::unique_ptr<CacheStorageOperation>>
+      running_operations_;
+  // The number of shared operations in |running_operations_|.
+  int num_running_shared_ = 0;
+  CacheStorageSchedulerId next_id_ = 0;
   CacheStorageSchedulerClient client_type_;
 
   base::WeakPtrFactory<CacheStorageScheduler> weak_ptr_factory_;
@@ -0,0 +1,91 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "content/browser/cache_storage/cache_storage_scheduler.h"
+
+#include <string>
+
+#include "base/bind.h"
+#include "base/run_loop.h"
+#include "base/task/post_task.h"
+#include "base/test/scoped_task_environment.h"
+#include "base/threading/platform_thread.h"
+#include "base/time/time.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "testing/perf/perf_test.h"
+
+namespace content {
+
+namespace {
+
+constexpr int kOperationCount = 200;
+
+// Roughly the time a disk_cache backend takes to read a small entry from disk.
+constexpr base::TimeDelta kOperationIOTime =
+    base::TimeDelta::FromMilliseconds(1);
+
+// Measures a burst of operations that each block on I/O, like cache.match()
+// calls from a service worker at startup, scheduled as exclusive or shared.
+class CacheStorageSchedulerPerfTest : public testing::Test {
+ protected:
+  CacheStorageSchedulerPerfTest()
+      : scheduler_(CacheStorageSchedulerClient::kCache) {}
+
+  void RunTest(const std::string& trace, CacheStorageSchedulerMode mode) {
+    base::RunLoop loop;
+    int completed = 0;
+    const base::TimeTicks start = base::TimeTicks::Now();
+    for (int i = 0; i < kOperationCount; ++i) {
+      CacheStorageSchedulerId id = scheduler_.CreateId();
+      scheduler_.ScheduleOperation(
+          id, mode, CacheStorageSchedulerOp::kMatch,
+          base::BindOnce(&CacheStorageSchedulerPerfTest::DoIO,
+                         base::Unretained(this), id, &completed,
+                         loop.QuitClosure()));
+    }
+    loop.Run();
+    const base::TimeDelta elapsed = base::TimeTicks::Now() - start;
+    EXPECT_EQ(kOperationCount, completed);
+
+    perf_test::PrintResult(
+        "CacheStorageScheduler_match", "", trace,
+        elapsed.InMicroseconds() / static_cast<double>(kOperationCount),
+        "us/operation", true);
+  }
+
+ private:
+  void DoIO(CacheStorageSchedulerId id,
+            int* completed,
+            base::OnceClosure done) {
+    base::PostTaskWithTraitsAndReply(
+        FROM_HERE, {base::MayBlock()},
+        base::BindOnce(&base::PlatformThread::Sleep, kOperationIOTime),
+        base::BindOnce(&CacheStorageSchedulerPerfTest::OnIOComplete,
+                       base::Unretained(this), id, completed,
+                       std::move(done)));
+  }
+
+  void OnIOComplete(CacheStorageSchedulerId id,
+                    int* completed,
+                    base::OnceClosure done) {
+    scheduler_.CompleteOperationAndRunNext(id);
+    if (++*completed == kOperationCount)
+      std::move(done).Run();
+  }
+
+  base::test::ScopedTaskEnvironment task_environment_;
+  CacheStorageScheduler scheduler_;
+};
+
+}  // namespace
+
+TEST_F(CacheStorageSchedulerPerfTest, Exclusive) {
+  RunTest("exclusive", CacheStorageSchedulerMode::kExclusive);
+}
+
+TEST_F(CacheStorageSchedulerPerfTest, Shared) {
+  RunTest("shared", CacheStorageSchedulerMode::kShared);
+}
+
+}  // namespace content
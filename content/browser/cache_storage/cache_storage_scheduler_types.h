@@ -5,8 +5,20 @@
 #ifndef CONTENT_BROWSER_CACHE_STORAGE_CACHE_STORAGE_SCHEDULER_TYPES_H_
 #define CONTENT_BROWSER_CACHE_STORAGE_CACHE_STORAGE_SCHEDULER_TYPES_H_
 
+#include <stdint.h>
+
 namespace content {
 
+// Identifies an operation within a CacheStorageScheduler.
+using CacheStorageSchedulerId = int64_t;
+
+// Exclusive operations run alone and in order. Shared operations may run in
+// parallel with each other, but never with an exclusive operation.
+enum class CacheStorageSchedulerMode {
+  kExclusive,
+  kShared,
+};
+
 // Define the types of clients that might own a scheduler.  This enum is used
 // to populate histogram names and must be kept in sync with the function
 // in cache_storage_histogram_utils.cc.  Please keep this list sorted.  It is
@@ -80,5 +80,57 @@ TEST_F(CacheStorageSchedulerTest, ScheduledOperations) {
   EXPECT_FALSE(scheduler_.ScheduledOperations());
 }
 
+TEST_F(CacheStorageSchedulerTest, SharedOperationsRunInParallel) {
+  CacheStorageSchedulerId id1 = scheduler_.CreateId();
+  CacheStorageSchedulerId id2 = scheduler_.CreateId();
+  scheduler_.ScheduleOperation(
+      id1, CacheStorageSchedulerMode::kShared, CacheStorageSchedulerOp::kTest,
+      base::BindOnce(&TestTask::Run, base::Unretained(&task1_)));
+  scheduler_.ScheduleOperation(
+      id2, CacheStorageSchedulerMode::kShared, CacheStorageSchedulerOp::kTest,
+      base::BindOnce(&TestTask::Run, base::Unretained(&task2_)));
+  base::RunLoop().RunUntilIdle();
+  EXPECT_EQ(1, task1_.callback_count());
+  EXPECT_EQ(1, task2_.callback_count());
+
+  // Shared operations can complete in any order.
+  scheduler_.CompleteOperationAndRunNext(id2);
+  EXPECT_TRUE(scheduler_.ScheduledOperations());
+  scheduler_.CompleteOperationAndRunNext(id1);
+  EXPECT_FALSE(scheduler_.ScheduledOperations());
+}
+
+TEST_F(CacheStorageSchedulerTest, ExclusiveWaitsForShared) {
+  TestTask task3(&scheduler_);
+  CacheStorageSchedulerId shared_id = scheduler_.CreateId();
+  CacheStorageSchedulerId exclusive_id = scheduler_.CreateId();
+  scheduler_.ScheduleOperation(
+      shared_id, CacheStorageSchedulerMode::kShared,
+      CacheStorageSchedulerOp::kTest,
+      base::BindOnce(&TestTask::Run, base::Unretained(&task1_)));
+  scheduler_.ScheduleOperation(
+      exclusive_id, CacheStorageSchedulerMode::kExclusive,
+      CacheStorageSchedulerOp::kTest,
+      base::BindOnce(&TestTask::Run, base::Unretained(&task2_)));
+  // A shared operation behind an exclusive one doesn't jump the queue.
+  scheduler_.ScheduleOperation(
+      scheduler_.CreateId(), CacheStorageSchedulerMode::kShared,
+      CacheStorageSchedulerOp::kTest,
+      base::BindOnce(&TestTask::Run, base::Unretained(&task3)));
+  base::RunLoop().RunUntilIdle();
+  EXPECT_EQ(1, task1_.callback_count());
+  EXPECT_EQ(0, task2_.callback_count());
+  EXPECT_EQ(0, task3.callback_count());
+
+  scheduler_.CompleteOperationAndRunNext(shared_id);
+  base::RunLoop().RunUntilIdle();
+  EXPECT_EQ(1, task2_.callback_count());
+  EXPECT_EQ(0, task3.callback_count());
+
+  scheduler_.CompleteOperationAndRunNext(exclusive_id);
+  base::RunLoop().RunUntilIdle();
+  EXPECT_EQ(1, task3.callback_count());
+}
+
 }  // namespace cache_storage_scheduler_unittest
 }  // namespace content
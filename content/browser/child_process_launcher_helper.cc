@@ -29,7 +29,9 @@ namespace internal {
 
 namespace {
 
-void RecordHistogramsOnLauncherThread(base::TimeDelta launch_time) {
+void RecordHistogramsOnLauncherThread(base::TimeDelta launch_time,
+                                      const std::string& process_type,
+                                      bool forked_from_zygote) {
   DCHECK(CurrentlyOnProcessLauncherTaskRunner());
   // Log the launch time, separating out the first one (which will likely be
   // slower due to the rest of the browser initializing at the same time).
@@ -40,6 +42,14 @@ void RecordHistogramsOnLauncherThread(base::TimeDelta launch_time) {
     UMA_HISTOGRAM_TIMES("MPArch.ChildProcessLaunchFirst", launch_time);
     done_first_launch = true;
   }
+
+  // Utility processes may either be forked from a zygote or launched.
+  if (process_type == switches::kUtilityProcess) {
+    if (forked_from_zygote)
+      UMA_HISTOGRAM_TIMES("MPArch.UtilityProcessLaunch.Zygote", launch_time);
+    else
+      UMA_HISTOGRAM_TIMES("MPArch.UtilityProcessLaunch.Exec", launch_time);
+  }
 }
 
 }  // namespace
@@ -147,8 +157,13 @@ void ChildProcessLauncherHelper::PostLaunchOnLauncherThread(
     mojo_channel_->RemoteProcessLaunchAttempted();
 
   if (process.process.IsValid()) {
-    RecordHistogramsOnLauncherThread(base::TimeTicks::Now() -
-                                     begin_launch_time_);
+    bool forked_from_zygote = false;
+#if BUILDFLAG(USE_ZYGOTE_HANDLE)
+    forked_from_zygote = process.zygote != nullptr;
+#endif
+    RecordHistogramsOnLauncherThread(
+        base::TimeTicks::Now() - begin_launch_time_, GetProcessType(),
+        forked_from_zygote);
   }
 
   // Take ownership of the broker client invitation here so it's destroyed when
@@ -83,7 +83,7 @@ ChildProcessLauncherHelper::LaunchProcessOnLauncherThread(
     *launch_result = LAUNCH_RESULT_SUCCESS;
 
 #if !defined(OS_OPENBSD)
-    if (handle) {
+    if (handle && zygote_handle == service_manager::GetGenericZygote()) {
       // This is just a starting score for a renderer or extension (the
       // only types of processes that will be started this way).  It will
       // get adjusted as time goes on.  (This is the same value as
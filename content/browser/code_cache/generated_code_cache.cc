@@ -3,9 +3,16 @@
 // found in the LICENSE file.
 
 #include "content/browser/code_cache/generated_code_cache.h"
+
+#include <algorithm>
+#include <iterator>
+
 #include "base/bind.h"
+#include "base/hash/hash.h"
 #include "base/memory/ptr_util.h"
+#include "base/memory/ref_counted.h"
 #include "base/metrics/histogram_macros.h"
+#include "base/system/sys_info.h"
 #include "content/public/common/url_constants.h"
 #include "net/base/completion_once_callback.h"
 #include "net/base/url_util.h"
@@ -17,6 +24,11 @@ namespace {
 constexpr char kPrefix[] = "_key";
 constexpr char kSeparator[] = " \n";
 
+// Bytes of code kept in memory. Entries larger than a quarter of this are
+// only kept on disk, so that one large entry can't flush all the others.
+constexpr size_t kMaxInMemoryCacheSizeInBytes = 8 * 1024 * 1024;
+constexpr size_t kMaxInMemoryCacheSizeInBytesLowEnd = 2 * 1024 * 1024;
+
 // We always expect to receive valid URLs that can be used as keys to the code
 // cache. The relevant checks (for ex: resource_url is valid, origin_lock is
 // not opque etc.,) must be done prior to requesting the code cache.
@@ -177,6 +189,34 @@ GeneratedCodeCache::PendingOperation::PendingOperation(
 
 GeneratedCodeCache::PendingOperation::~PendingOperation() = default;
 
+// Code held by one or more in-memory entries.
+class GeneratedCodeCache::CodeBlob : public base::RefCounted<CodeBlob> {
+ public:
+  CodeBlob(uint32_t hash, std::vector<uint8_t> data)
+      : hash_(hash), data_(std::move(data)) {}
+
+  uint32_t hash() const { return hash_; }
+  const std::vector<uint8_t>& data() const { return data_; }
+
+ private:
+  friend class base::RefCounted<CodeBlob>;
+  ~CodeBlob() = default;
+
+  const uint32_t hash_;
+  const std::vector<uint8_t> data_;
+
+  DISALLOW_COPY_AND_ASSIGN(CodeBlob);
+};
+
+GeneratedCodeCache::InMemoryEntry::InMemoryEntry(base::Time response_time,
+                                                 scoped_refptr<CodeBlob> code)
+    : response_time(response_time), code(std::move(code)) {}
+
+GeneratedCodeCache::InMemoryEntry::InMemoryEntry(InMemoryEntry&& other) =
+    default;
+
+GeneratedCodeCache::InMemoryEntry::~InMemoryEntry() = default;
+
 GeneratedCodeCache::GeneratedCodeCache(const base::FilePath& path,
                                        int max_size_bytes,
                                        CodeCacheType cache_type)
@@ -184,6 +224,14 @@ GeneratedCodeCache::GeneratedCodeCache(const base::FilePath& path,
       path_(path),
       max_size_bytes_(max_size_bytes),
       cache_type_(cache_type),
+      in_memory_entries_(InMemoryEntries::NO_AUTO_EVICT),
+      in_memory_bytes_(0),
+      max_in_memory_bytes_(base::SysInfo::IsLowEndDevice()
+                               ? kMaxInMemoryCacheSizeInBytesLowEnd
+                               : kMaxInMemoryCacheSizeInBytes),
+      memory_pressure_listener_(std::make_unique<base::MemoryPressureListener>(
+          base::BindRepeating(&GeneratedCodeCache::OnMemoryPressure,
+                              base::Unretained(this)))),
       weak_ptr_factory_(this) {
   CreateBackend();
 }
@@ -229,6 +277,8 @@ void GeneratedCodeCache::WriteData(const GURL& url,
            data.size());
 
   std::string key = GetCacheKey(url, origin_lock);
+  // The in-memory entry is added back once the new data is on disk.
+  RemoveFromInMemoryCache(key);
   // If there is an in progress operation corresponding to this key. Enqueue it
   // so we can issue once the in-progress operation finishes.
   if (EnqueueAsPendingOperation(
@@ -260,6 +310,16 @@ void GeneratedCodeCache::FetchEntry(const GURL& url,
   }
 
   std::string key = GetCacheKey(url, origin_lock);
+  // The in-memory entry, if any, holds what the disk cache will return once
+  // the in-progress operations for this key finish.
+  auto in_memory_it = in_memory_entries_.Get(key);
+  if (in_memory_it != in_memory_entries_.end()) {
+    CollectStatistics(CacheEntryStatus::kHit);
+    read_data_callback.Run(in_memory_it->second.response_time,
+                           in_memory_it->second.code->data());
+    return;
+  }
+
   // If there is an in progress operation corresponding to this key. Enqueue it
   // so we can issue once the in-progress operation finishes.
   if (EnqueueAsPendingOperation(
@@ -288,6 +348,15 @@ void GeneratedCodeCache::DeleteEntry(const GURL& url, const GURL& origin_lock) {
   }
 
   std::string key = GetCacheKey(url, origin_lock);
+  RemoveFromInMemoryCache(key);
+  // Order the deletion after the in-progress operations for this key, so that
+  // none of them adds the entry back to the in-memory cache.
+  if (EnqueueAsPendingOperation(
+          key, GeneratedCodeCache::PendingOperation::CreateDeletePendingOp(
+                   key))) {
+    return;
+  }
+
   if (backend_state_ != kInitialized) {
     // Insert it into the list of pending operations while the backend is
     // still being opened.
@@ -298,6 +367,7 @@ void GeneratedCodeCache::DeleteEntry(const GURL& url, const GURL& origin_lock) {
   }
 
   DeleteEntryImpl(key);
+  IssueQueuedOperationForEntry(key);
 }
 
 void GeneratedCodeCache::CreateBackend() {
@@ -356,6 +426,7 @@ void GeneratedCodeCache::IssueOperation(PendingOperation* op) {
       break;
     case kDelete:
       DeleteEntryImpl(op->key());
+      IssueQueuedOperationForEntry(op->key());
       break;
     case kGetBackend:
       DoPendingGetBackend(op->ReleaseCallback());
@@ -412,19 +483,24 @@ void GeneratedCodeCache::CompleteForWriteData(
     result = disk_entry->WriteData(
         kDataIndex, 0, buffer.get(), buffer->size(),
         base::BindOnce(&GeneratedCodeCache::WriteDataCompleted,
-                       weak_ptr_factory_.GetWeakPtr(), key),
+                       weak_ptr_factory_.GetWeakPtr(), key, buffer),
         true);
   }
   if (result != net::ERR_IO_PENDING) {
-    WriteDataCompleted(key, result);
+    WriteDataCompleted(key, buffer, result);
   }
 }
 
-void GeneratedCodeCache::WriteDataCompleted(const std::string& key, int rv) {
+void GeneratedCodeCache::WriteDataCompleted(
+    const std::string& key,
+    scoped_refptr<net::IOBufferWithSize> buffer,
+    int rv) {
   if (rv < 0) {
     CollectStatistics(CacheEntryStatus::kWriteFailed);
     // The write failed; we should delete the entry.
     DeleteEntryImpl(key);
+  } else {
+    AddToInMemoryCache(key, std::move(buffer));
   }
   IssueQueuedOperationForEntry(key);
 }
@@ -507,6 +583,7 @@ void GeneratedCodeCache::ReadDataComplete(
     base::Time response_time = base::Time::FromDeltaSinceWindowsEpoch(
         base::TimeDelta::FromMicroseconds(raw_response_time));
     std::move(callback).Run(response_time, data);
+    AddToInMemoryCache(key, std::move(buffer));
   }
   IssueQueuedOperationForEntry(key);
 }
@@ -562,6 +639,93 @@ void GeneratedCodeCache::DoPendingGetBackend(GetBackendCallback user_callback) {
   return;
 }
 
+void GeneratedCodeCache::AddToInMemoryCache(
+    const std::string& key,
+    scoped_refptr<net::IOBufferWithSize> buffer) {
+  // Operations queued for this key may change its data.
+  auto active_it = active_entries_map_.find(key);
+  if (active_it != active_entries_map_.end() && !active_it->second.empty())
+    return;
+
+  // Entries with empty data are misses, just like incomplete ones.
+  if (buffer->size() <= kResponseTimeSizeInBytes)
+    return;
+  size_t size = buffer->size() - kResponseTimeSizeInBytes;
+  if (size > max_in_memory_bytes_ / 4)
+    return;
+
+  RemoveFromInMemoryCache(key);
+
+  int64_t raw_response_time = 0;
+  memcpy(&raw_response_time, buffer->data(), kResponseTimeSizeInBytes);
+  base::Time response_time = base::Time::FromDeltaSinceWindowsEpoch(
+      base::TimeDelta::FromMicroseconds(raw_response_time));
+  const uint8_t* data =
+      reinterpret_cast<const uint8_t*>(buffer->data()) +
+      kResponseTimeSizeInBytes;
+
+  // Share the code with the entries that already hold the same code.
+  uint32_t hash = base::Hash(data, size);
+  scoped_refptr<CodeBlob> code;
+  auto code_it = in_memory_code_.find(hash);
+  if (code_it != in_memory_code_.end() &&
+      std::equal(data, data + size, code_it->second->data().begin(),
+                 code_it->second->data().end())) {
+    code = code_it->second;
+  } else {
+    code = base::MakeRefCounted<CodeBlob>(
+        hash, std::vector<uint8_t>(data, data + size));
+    in_memory_code_.emplace(hash, code.get());
+    in_memory_bytes_ += size;
+  }
+
+  in_memory_entries_.Put(key, InMemoryEntry(response_time, std::move(code)));
+  ShrinkInMemoryCache(max_in_memory_bytes_);
+}
+
+void GeneratedCodeCache::RemoveFromInMemoryCache(const std::string& key) {
+  auto it = in_memory_entries_.Peek(key);
+  if (it != in_memory_entries_.end())
+    EraseInMemoryEntry(it);
+}
+
+GeneratedCodeCache::InMemoryEntries::iterator
+GeneratedCodeCache::EraseInMemoryEntry(InMemoryEntries::iterator it) {
+  const CodeBlob* code = it->second.code.get();
+  if (code->HasOneRef()) {
+    in_memory_bytes_ -= code->data().size();
+    auto code_it = in_memory_code_.find(code->hash());
+    if (code_it != in_memory_code_.end() && code_it->second == code)
+      in_memory_code_.erase(code_it);
+  }
+  return in_memory_entries_.Erase(it);
+}
+
+void GeneratedCodeCache::ShrinkInMemoryCache(size_t max_size_bytes) {
+  while (in_memory_bytes_ > max_size_bytes && !in_memory_entries_.empty())
+    EraseInMemoryEntry(std::prev(in_memory_entries_.end()));
+}
+
+void GeneratedCodeCache::OnMemoryPressure(
+    base::MemoryPressureListener::MemoryPressureLevel memory_pressure_level) {
+  switch (memory_pressure_level) {
+    case base::MemoryPressureListener::MEMORY_PRESSURE_LEVEL_NONE:
+      return;
+    case base::MemoryPressureListener::MEMORY_PRESSURE_LEVEL_MODERATE:
+      ShrinkInMemoryCache(max_in_memory_bytes_ / 2);
+      return;
+    case base::MemoryPressureListener::MEMORY_PRESSURE_LEVEL_CRITICAL:
+      ShrinkInMemoryCache(0);
+      return;
+  }
+}
+
+void GeneratedCodeCache::SetInMemoryCacheSizeForTesting(
+    size_t max_size_bytes) {
+  max_in_memory_bytes_ = max_size_bytes;
+  ShrinkInMemoryCache(max_in_memory_bytes_);
+}
+
 void GeneratedCodeCache::SetLastUsedTimeForTest(
     const GURL& resource_url,
     const GURL& origin_lock,
@@ -6,10 +6,14 @@
 #define CONTENT_BROWSER_CODE_CACHE_GENERATED_CODE_CACHE_H_
 
 #include <queue>
+#include <unordered_map>
 
+#include "base/containers/mru_cache.h"
 #include "base/containers/queue.h"
 #include "base/files/file_path.h"
 #include "base/macros.h"
+#include "base/memory/memory_pressure_listener.h"
+#include "base/memory/scoped_refptr.h"
 #include "base/memory/weak_ptr.h"
 #include "content/common/content_export.h"
 #include "net/base/io_buffer.h"
@@ -36,6 +40,11 @@ namespace content {
 // This uses a simple disk_cache backend. It just stores one data stream and
 // stores response_time + generated code as one data blob.
 //
+// The most recently used entries are also kept in memory, so that fetching the
+// code of scripts that many pages load doesn't wait for the disk cache. Entries
+// for different keys that hold the same code share one copy of it in memory.
+// The in-memory entries are shrunk or dropped under memory pressure.
+//
 // There exists one cache per storage partition and is owned by the storage
 // partition. This cache is created, accessed and destroyed on the I/O
 // thread.
@@ -101,6 +110,11 @@ class CONTENT_EXPORT GeneratedCodeCache {
   // Delete the entry corresponding to <resource_url, origin_lock>
   void DeleteEntry(const GURL& resource_url, const GURL& origin_lock);
 
+  // Sets the number of bytes of code kept in memory, evicting the least
+  // recently used entries if needed. Zero disables the in-memory entries.
+  void SetInMemoryCacheSizeForTesting(size_t max_size_bytes);
+  size_t GetInMemoryCacheSizeForTesting() const { return in_memory_bytes_; }
+
   // Should be only used for tests. Sets the last accessed timestamp of an
   // entry.
   void SetLastUsedTimeForTest(const GURL& resource_url,
@@ -112,8 +126,20 @@ class CONTENT_EXPORT GeneratedCodeCache {
 
  private:
   class PendingOperation;
+  class CodeBlob;
   using ScopedBackendPtr = std::unique_ptr<disk_cache::Backend>;
 
+  // An entry of the in-memory cache.
+  struct InMemoryEntry {
+    InMemoryEntry(base::Time response_time, scoped_refptr<CodeBlob> code);
+    InMemoryEntry(InMemoryEntry&& other);
+    ~InMemoryEntry();
+
+    base::Time response_time;
+    scoped_refptr<CodeBlob> code;
+  };
+  using InMemoryEntries = base::MRUCache<std::string, InMemoryEntry>;
+
   // State of the backend.
   enum BackendState { kInitializing, kInitialized, kFailed };
 
@@ -143,7 +169,9 @@ class CONTENT_EXPORT GeneratedCodeCache {
       scoped_refptr<base::RefCountedData<disk_cache::EntryWithOpened>>
           entry_struct,
       int rv);
-  void WriteDataCompleted(const std::string& key, int rv);
+  void WriteDataCompleted(const std::string& key,
+                          scoped_refptr<net::IOBufferWithSize> buffer,
+                          int rv);
 
   // Fetch entry from cache
   void FetchEntryImpl(const std::string& key, ReadDataCallback);
@@ -178,6 +206,17 @@ class CONTENT_EXPORT GeneratedCodeCache {
 
   void CollectStatistics(GeneratedCodeCache::CacheEntryStatus status);
 
+  // Adds the response time and code serialized in |buffer| to the in-memory
+  // cache, unless more operations are queued for |key|, which could change
+  // what is stored for it.
+  void AddToInMemoryCache(const std::string& key,
+                          scoped_refptr<net::IOBufferWithSize> buffer);
+  void RemoveFromInMemoryCache(const std::string& key);
+  InMemoryEntries::iterator EraseInMemoryEntry(InMemoryEntries::iterator it);
+  void ShrinkInMemoryCache(size_t max_size_bytes);
+  void OnMemoryPressure(
+      base::MemoryPressureListener::MemoryPressureLevel memory_pressure_level);
+
   std::unique_ptr<disk_cache::Backend> backend_;
   BackendState backend_state_;
 
@@ -191,6 +230,15 @@ class CONTENT_EXPORT GeneratedCodeCache {
   int max_size_bytes_;
   CodeCacheType cache_type_;
 
+  // The most recently used entries, and the code they hold keyed by its hash.
+  // Code is only shared between entries when it is identical, not just when
+  // the hashes match. |in_memory_bytes_| counts each shared copy once.
+  InMemoryEntries in_memory_entries_;
+  std::unordered_map<uint32_t, CodeBlob*> in_memory_code_;
+  size_t in_memory_bytes_;
+  size_t max_in_memory_bytes_;
+  std::unique_ptr<base::MemoryPressureListener> memory_pressure_listener_;
+
   base::WeakPtrFactory<GeneratedCodeCache> weak_ptr_factory_;
 
   DISALLOW_COPY_AND_ASSIGN(GeneratedCodeCache);
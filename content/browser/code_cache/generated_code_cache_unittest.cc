@@ -367,4 +367,98 @@ TEST_F(GeneratedCodeCacheTest, WasmCache) {
   ASSERT_TRUE(received_);
   EXPECT_EQ(kInitialData, received_data_);
 }
+
+TEST_F(GeneratedCodeCacheTest, FetchFromMemory) {
+  GURL url(kInitialUrl);
+  GURL origin_lock = GURL(kInitialOrigin);
+
+  InitializeCache(GeneratedCodeCache::CodeCacheType::kJavaScript);
+  std::string data = "SerializedCodeForScript";
+  base::Time response_time = base::Time::Now();
+  WriteToCache(url, origin_lock, data, response_time);
+  scoped_task_environment_.RunUntilIdle();
+
+  // The entry written last is fetched without waiting for the disk cache.
+  FetchFromCache(url, origin_lock);
+  ASSERT_TRUE(received_);
+  EXPECT_EQ(data, received_data_);
+  EXPECT_EQ(response_time, received_response_time_);
+
+  // Deleted entries are not fetched from memory.
+  DeleteFromCache(url, origin_lock);
+  FetchFromCache(url, origin_lock);
+  EXPECT_FALSE(received_);
+  scoped_task_environment_.RunUntilIdle();
+  ASSERT_TRUE(received_);
+  ASSERT_TRUE(received_null_);
+}
+
+TEST_F(GeneratedCodeCacheTest, FetchFromMemoryAfterPendingWrite) {
+  GURL url(kInitialUrl);
+  GURL origin_lock = GURL(kInitialOrigin);
+
+  InitializeCache(GeneratedCodeCache::CodeCacheType::kJavaScript);
+  std::string data = "SerializedCodeForScriptOverwrite";
+  base::Time response_time = base::Time::Now();
+  WriteToCache(url, origin_lock, data, response_time);
+
+  // The in-memory entry of the initial data must not be used while the new
+  // data is being written.
+  FetchFromCache(url, origin_lock);
+  EXPECT_FALSE(received_);
+  scoped_task_environment_.RunUntilIdle();
+  ASSERT_TRUE(received_);
+  EXPECT_EQ(data, received_data_);
+  EXPECT_EQ(response_time, received_response_time_);
+}
+
+TEST_F(GeneratedCodeCacheTest, IdenticalCodeSharedInMemory) {
+  GURL url(kInitialUrl);
+  GURL origin_lock1 = GURL("http://example1.com");
+  GURL origin_lock2 = GURL("http://example2.com");
+
+  InitializeCache(GeneratedCodeCache::CodeCacheType::kJavaScript);
+  size_t initial_size = generated_code_cache_->GetInMemoryCacheSizeForTesting();
+  std::string data = "SerializedCodeForScript";
+  WriteToCache(url, origin_lock1, data, base::Time::Now());
+  WriteToCache(url, origin_lock2, data, base::Time::Now());
+  scoped_task_environment_.RunUntilIdle();
+
+  EXPECT_EQ(initial_size + data.size(),
+            generated_code_cache_->GetInMemoryCacheSizeForTesting());
+  FetchFromCache(url, origin_lock1);
+  ASSERT_TRUE(received_);
+  EXPECT_EQ(data, received_data_);
+  FetchFromCache(url, origin_lock2);
+  ASSERT_TRUE(received_);
+  EXPECT_EQ(data, received_data_);
+}
+
+TEST_F(GeneratedCodeCacheTest, EvictFromMemory) {
+  GURL url(kInitialUrl);
+  GURL origin_lock = GURL(kInitialOrigin);
+  const size_t kEntrySize = 64;
+
+  InitializeCache(GeneratedCodeCache::CodeCacheType::kJavaScript);
+  generated_code_cache_->SetInMemoryCacheSizeForTesting(4 * kEntrySize);
+  for (char c : {'a', 'b', 'c', 'd'}) {
+    GURL new_url("http://example.com/script_" + std::string(1, c) + ".js");
+    WriteToCache(new_url, origin_lock, std::string(kEntrySize, c),
+                 base::Time::Now());
+  }
+  scoped_task_environment_.RunUntilIdle();
+
+  // The least recently used entry was evicted from memory, but it is still
+  // fetched from disk.
+  EXPECT_EQ(4 * kEntrySize,
+            generated_code_cache_->GetInMemoryCacheSizeForTesting());
+  FetchFromCache(url, origin_lock);
+  EXPECT_FALSE(received_);
+  scoped_task_environment_.RunUntilIdle();
+  ASSERT_TRUE(received_);
+  EXPECT_EQ(kInitialData, received_data_);
+
+  generated_code_cache_->SetInMemoryCacheSizeForTesting(0);
+  EXPECT_EQ(0u, generated_code_cache_->GetInMemoryCacheSizeForTesting());
+}
 }  // namespace content
@@ -14,6 +14,7 @@
 #include "base/location.h"
 #include "base/memory/ref_counted.h"
 #include "base/memory/ref_counted_memory.h"
+#include "base/metrics/histogram_macros.h"
 #include "base/process/process_handle.h"
 #include "base/single_thread_task_runner.h"
 #include "base/strings/string16.h"
@@ -21,6 +22,7 @@
 #include "base/strings/utf_string_conversions.h"
 #include "base/task/post_task.h"
 #include "base/threading/thread_task_runner_handle.h"
+#include "base/time/time.h"
 #include "build/build_config.h"
 #include "content/browser/devtools/devtools_agent_host_impl.h"
 #include "content/browser/devtools/protocol/devtools_download_manager_delegate.h"
@@ -101,6 +103,33 @@ Binary EncodeSkBitmap(const SkBitmap& image,
   return EncodeImage(gfx::Image::CreateFrom1xBitmap(image), format, quality);
 }
 
+// Crops |bitmap| to |requested_image_size|, if set, and encodes it. Runs on
+// the thread pool, since encoding large screenshots as PNG takes long enough
+// to jank the UI thread.
+Binary EncodeScreenshot(const SkBitmap& bitmap,
+                        const gfx::Size& requested_image_size,
+                        const std::string& format,
+                        int quality) {
+  if (!requested_image_size.IsEmpty() &&
+      (bitmap.width() != requested_image_size.width() ||
+       bitmap.height() != requested_image_size.height())) {
+    SkBitmap cropped = SkBitmapOperations::CreateTiledBitmap(
+        bitmap, 0, 0, requested_image_size.width(),
+        requested_image_size.height());
+    return EncodeSkBitmap(cropped, format, quality);
+  }
+  return EncodeSkBitmap(bitmap, format, quality);
+}
+
+void SendScreenshot(
+    std::unique_ptr<Page::Backend::CaptureScreenshotCallback> callback,
+    base::TimeTicks capture_start_time,
+    const Binary& data) {
+  UMA_HISTOGRAM_TIMES("DevTools.CaptureScreenshotTime",
+                      base::TimeTicks::Now() - capture_start_time);
+  callback->sendSuccess(data);
+}
+
 std::unique_ptr<Page::ScreencastFrameMetadata> BuildScreencastFrameMetadata(
     const gfx::Size& surface_size,
     float device_scale_factor,
@@ -640,6 +669,7 @@ void PageHandler::CaptureScreenshot(
     }
   }
 
+  base::TimeTicks capture_start_time = base::TimeTicks::Now();
   RenderWidgetHostImpl* widget_host = host_->GetRenderWidgetHost();
   std::string screenshot_format = format.fromMaybe(kPng);
   int screenshot_quality = quality.fromMaybe(kDefaultScreenshotQuality);
@@ -648,9 +678,9 @@ void PageHandler::CaptureScreenshot(
   if (!from_surface.fromMaybe(true)) {
     widget_host->GetSnapshotFromBrowser(
         base::Bind(&PageHandler::ScreenshotCaptured, weak_factory_.GetWeakPtr(),
-                   base::Passed(std::move(callback)), screenshot_format,
-                   screenshot_quality, gfx::Size(), gfx::Size(),
-                   blink::WebDeviceEmulationParams()),
+                   base::Passed(std::move(callback)), capture_start_time,
+                   screenshot_format, screenshot_quality, gfx::Size(),
+                   gfx::Size(), blink::WebDeviceEmulationParams()),
         false);
     return;
   }
@@ -748,9 +778,9 @@ void PageHandler::CaptureScreenshot(
 
   widget_host->GetSnapshotFromBrowser(
       base::Bind(&PageHandler::ScreenshotCaptured, weak_factory_.GetWeakPtr(),
-                 base::Passed(std::move(callback)), screenshot_format,
-                 screenshot_quality, original_view_size, requested_image_size,
-                 original_params),
+                 base::Passed(std::move(callback)), capture_start_time,
+                 screenshot_format, screenshot_quality, original_view_size,
+                 requested_image_size, original_params),
       true);
 }
 
@@ -1074,6 +1104,7 @@ void PageHandler::ScreencastFrameEncoded(
 
 void PageHandler::ScreenshotCaptured(
     std::unique_ptr<CaptureScreenshotCallback> callback,
+    base::TimeTicks capture_start_time,
     const std::string& format,
     int quality,
     const gfx::Size& original_view_size,
@@ -1091,18 +1122,14 @@ void PageHandler::ScreenshotCaptured(
     return;
   }
 
-  if (!requested_image_size.IsEmpty() &&
-      (image.Width() != requested_image_size.width() ||
-       image.Height() != requested_image_size.height())) {
-    const SkBitmap* bitmap = image.ToSkBitmap();
-    SkBitmap cropped = SkBitmapOperations::CreateTiledBitmap(
-        *bitmap, 0, 0, requested_image_size.width(),
-        requested_image_size.height());
-    gfx::Image croppedImage = gfx::Image::CreateFrom1xBitmap(cropped);
-    callback->sendSuccess(EncodeImage(croppedImage, format, quality));
-  } else {
-    callback->sendSuccess(EncodeImage(image, format, quality));
-  }
+  base::PostTaskWithTraitsAndReplyWithResult(
+      FROM_HERE,
+      {base::TaskPriority::USER_VISIBLE,
+       base::TaskShutdownBehavior::CONTINUE_ON_SHUTDOWN},
+      base::BindOnce(&EncodeScreenshot, *image.ToSkBitmap(),
+                     requested_image_size, format, quality),
+      base::BindOnce(&SendScreenshot, std::move(callback),
+                     capture_start_time));
 }
 
 void PageHandler::GotManifest(std::unique_ptr<GetAppManifestCallback> callback,
@@ -173,6 +173,7 @@ class PageHandler : public DevToolsDomainHandler,
 
   void ScreenshotCaptured(
       std::unique_ptr<CaptureScreenshotCallback> callback,
+      base::TimeTicks capture_start_time,
       const std::string& format,
       int quality,
       const gfx::Size& original_view_size,
@@ -196,6 +196,8 @@ class LocalStorageContextMojo::StorageAreaHolder final
     options.default_commit_delay = kCommitDefaultDelaySecs;
     options.max_bytes_per_hour = kMaxBytesPerHour;
     options.max_commits_per_hour = kMaxCommitsPerHour;
+    // FixUpData() only re-encodes keys, so items read one at a time are fine.
+    options.get_loads_single_item = true;
 #if defined(OS_ANDROID)
     options.cache_mode = StorageAreaImpl::CacheMode::KEYS_ONLY_WHEN_POSSIBLE;
 #else
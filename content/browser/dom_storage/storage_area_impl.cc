@@ -74,6 +74,7 @@ StorageAreaImpl::StorageAreaImpl(leveldb::mojom::LevelDBDatabase* database,
       delegate_(delegate),
       database_(database),
       cache_mode_(database ? options.cache_mode : CacheMode::KEYS_AND_VALUES),
+      get_loads_single_item_(options.get_loads_single_item),
       storage_used_(0),
       max_size_(options.max_size),
       memory_used_(0),
@@ -480,6 +481,19 @@ void StorageAreaImpl::Get(const std::vector<uint8_t>& key,
     NOTREACHED();
     return;
   }
+  // Reading one item doesn't need the whole map. Any changes already sent to
+  // the database are ordered before this read on the database pipe.
+  if (get_loads_single_item_ && map_state_ == MapState::UNLOADED &&
+      database_ && !commit_batch_) {
+    std::vector<uint8_t> db_key;
+    db_key.reserve(prefix_.size() + key.size());
+    db_key.insert(db_key.end(), prefix_.begin(), prefix_.end());
+    db_key.insert(db_key.end(), key.begin(), key.end());
+    database_->Get(db_key, base::BindOnce(&StorageAreaImpl::OnGotSingleItem,
+                                          weak_ptr_factory_.GetWeakPtr(), key,
+                                          std::move(callback)));
+    return;
+  }
   if (!IsMapLoaded() || IsMapUpgradeNeeded()) {
     LoadMap(base::BindOnce(&StorageAreaImpl::Get,
                            weak_ptr_factory_.GetWeakPtr(), key,
@@ -495,6 +509,25 @@ void StorageAreaImpl::Get(const std::vector<uint8_t>& key,
   std::move(callback).Run(true, found->second);
 }
 
+void StorageAreaImpl::OnGotSingleItem(const std::vector<uint8_t>& key,
+                                      GetCallback callback,
+                                      DatabaseError status,
+                                      const std::vector<uint8_t>& value) {
+  if (status == DatabaseError::OK) {
+    std::move(callback).Run(true, value);
+    return;
+  }
+  // The item may still come from migration, or the map may have been loaded
+  // in the meantime.
+  if (!IsMapLoaded() || IsMapUpgradeNeeded()) {
+    LoadMap(base::BindOnce(&StorageAreaImpl::Get,
+                           weak_ptr_factory_.GetWeakPtr(), key,
+                           std::move(callback)));
+    return;
+  }
+  Get(key, std::move(callback));
+}
+
 void StorageAreaImpl::GetAll(
     blink::mojom::StorageAreaGetAllCallbackAssociatedPtrInfo complete_callback,
     GetAllCallback callback) {
@@ -85,6 +85,11 @@ class CONTENT_EXPORT StorageAreaImpl : public blink::mojom::StorageArea {
     int max_bytes_per_hour = 0;
     // Maximum number of disk write batches in one hour.
     int max_commits_per_hour = 0;
+    // If true, Get() on an unloaded map reads the single item from the
+    // database instead of loading every item for the prefix. Only set this if
+    // Delegate::FixUpData() never changes the value stored for an existing
+    // key, as items read this way are not fixed up.
+    bool get_loads_single_item = false;
   };
 
   // |Delegate::OnNoBindings| will be called when this object has no more
@@ -284,6 +289,13 @@ class CONTENT_EXPORT StorageAreaImpl : public blink::mojom::StorageArea {
   void OnMapLoaded(leveldb::mojom::DatabaseError status,
                    std::vector<leveldb::mojom::KeyValuePtr> data);
   void OnGotMigrationData(std::unique_ptr<ValueMap> data);
+  // Called with the result of reading |key| directly from the database for
+  // Get() while the map is unloaded. Falls back to loading the map if the item
+  // wasn't found, so that migration and fix-ups still apply.
+  void OnGotSingleItem(const std::vector<uint8_t>& key,
+                       GetCallback callback,
+                       leveldb::mojom::DatabaseError status,
+                       const std::vector<uint8_t>& value);
   void CalculateStorageAndMemoryUsed();
   void OnLoadComplete();
 
@@ -328,6 +340,7 @@ class CONTENT_EXPORT StorageAreaImpl : public blink::mojom::StorageArea {
   // must stay consistent for a given commit batch.
   MapState map_state_ = MapState::UNLOADED;
   CacheMode cache_mode_;
+  const bool get_loads_single_item_;
   ValueMap keys_values_map_;
   KeysOnlyMap keys_only_map_;
   // These are always consumed & cleared when the map is loaded.
@@ -343,6 +343,29 @@ TEST_F(StorageAreaImplTest, NoDataCallsOnMapLoaded) {
   EXPECT_EQ(1, delegate()->map_load_count());
 }
 
+TEST_F(StorageAreaImplTest, GetSingleItemWithoutLoadingMap) {
+  StorageAreaImpl::Options options =
+      GetDefaultTestingOptions(CacheMode::KEYS_AND_VALUES);
+  options.get_loads_single_item = true;
+  auto area = std::make_unique<StorageAreaImpl>(database(), test_prefix_,
+                                                delegate(), options);
+
+  // Items in the database are read one at a time.
+  std::vector<uint8_t> result;
+  EXPECT_TRUE(GetSync(area.get(), test_key2_bytes_, &result));
+  EXPECT_EQ(test_value2_bytes_, result);
+  EXPECT_FALSE(area->initialized());
+  EXPECT_EQ(0, delegate()->map_load_count());
+
+  // A missing item falls back to loading the map, which is then used.
+  EXPECT_FALSE(GetSync(area.get(), ToBytes("x"), &result));
+  EXPECT_TRUE(area->initialized());
+  EXPECT_EQ(1, delegate()->map_load_count());
+  EXPECT_TRUE(GetSync(area.get(), test_key1_bytes_, &result));
+  EXPECT_EQ(test_value1_bytes_, result);
+  EXPECT_EQ(1, delegate()->map_load_count());
+}
+
 TEST_F(StorageAreaImplTest, GetFromPutOverwrite) {
   storage_area_impl()->SetCacheModeForTesting(CacheMode::KEYS_AND_VALUES);
   std::vector<uint8_t> key = test_key2_bytes_;
@@ -4,6 +4,8 @@
 
 #include "content/browser/file_url_loader_factory.h"
 
+#include <string.h>
+
 #include <memory>
 #include <string>
 #include <utility>
@@ -535,7 +537,20 @@ class FileURLLoader : public network::mojom::URLLoader {
       MaybeDeleteSelf();
       return;
     }
-    char initial_read_buffer[net::kMaxBytesToSniff];
+
+    // Read the data for MIME sniffing straight into the pipe, which is empty
+    // and large enough (see assertion near |kDefaultFileUrlPipeSize|
+    // definition), so that it doesn't have to be copied into it afterwards.
+    void* pipe_buffer = nullptr;
+    uint32_t pipe_buffer_size = 0;
+    MojoResult begin_write_result = pipe.producer_handle->BeginWriteData(
+        &pipe_buffer, &pipe_buffer_size, MOJO_WRITE_DATA_FLAG_NONE);
+    if (begin_write_result != MOJO_RESULT_OK) {
+      OnClientComplete(net::ERR_FAILED, std::move(observer));
+      return;
+    }
+    DCHECK_GE(pipe_buffer_size, net::kMaxBytesToSniff);
+    char* initial_read_buffer = static_cast<char*>(pipe_buffer);
     int initial_read_result =
         file.ReadAtCurrentPos(initial_read_buffer, net::kMaxBytesToSniff);
     if (initial_read_result < 0) {
@@ -597,27 +612,6 @@ class FileURLLoader : public network::mojom::URLLoader {
 
     head.content_length = base::saturated_cast<int64_t>(total_bytes_to_send);
 
-    if (first_byte_to_send < initial_read_size) {
-      // Write any data we read for MIME sniffing, constraining by range where
-      // applicable. This will always fit in the pipe (see assertion near
-      // |kDefaultFileUrlPipeSize| definition).
-      uint32_t write_size = std::min(
-          static_cast<uint32_t>(initial_read_size - first_byte_to_send),
-          static_cast<uint32_t>(total_bytes_to_send));
-      const uint32_t expected_write_size = write_size;
-      MojoResult result = pipe.producer_handle->WriteData(
-          &initial_read_buffer[first_byte_to_send], &write_size,
-          MOJO_WRITE_DATA_FLAG_NONE);
-      if (result != MOJO_RESULT_OK || write_size != expected_write_size) {
-        OnFileWritten(std::move(observer), result);
-        return;
-      }
-
-      // Discount the bytes we just sent from the total range.
-      first_byte_to_send = initial_read_size;
-      total_bytes_to_send -= write_size;
-    }
-
     if (!net::GetMimeTypeFromFile(path, &head.mime_type)) {
       std::string new_type;
       net::SniffMimeType(
@@ -629,6 +623,32 @@ class FileURLLoader : public network::mojom::URLLoader {
       head.mime_type.assign(new_type);
       head.did_mime_sniff = true;
     }
+
+    // Commit any data we read for MIME sniffing, constraining by range where
+    // applicable. This has to happen after sniffing, since the range may not
+    // start at the beginning of the file.
+    uint32_t write_size = 0;
+    if (first_byte_to_send < initial_read_size) {
+      write_size = std::min(
+          static_cast<uint32_t>(initial_read_size - first_byte_to_send),
+          static_cast<uint32_t>(total_bytes_to_send));
+      if (first_byte_to_send > 0) {
+        memmove(initial_read_buffer, &initial_read_buffer[first_byte_to_send],
+                write_size);
+      }
+    }
+    MojoResult end_write_result =
+        pipe.producer_handle->EndWriteData(write_size);
+    if (end_write_result != MOJO_RESULT_OK) {
+      OnFileWritten(std::move(observer), end_write_result);
+      return;
+    }
+    if (write_size > 0) {
+      // Discount the bytes we just sent from the total range.
+      first_byte_to_send = initial_read_size;
+      total_bytes_to_send -= write_size;
+    }
+
     if (head.headers) {
       head.headers->AddHeader(
           base::StringPrintf("%s: %s", net::HttpRequestHeaders::kContentType,
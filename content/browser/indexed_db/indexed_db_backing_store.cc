@@ -1796,10 +1796,16 @@ Status IndexedDBBackingStore::Transaction::GetBlobInfoForRecord(
     NOTREACHED();
     return InternalInconsistencyStatus();
   }
+  bool has_blob_entries = false;
+  Status s = ObjectStoreHasBlobEntries(blob_entry_key.database_id(),
+                                       blob_entry_key.object_store_id(),
+                                       &has_blob_entries);
+  if (!s.ok() || !has_blob_entries)
+    return s;
   std::string encoded_key = blob_entry_key.Encode();
   bool found;
   std::string encoded_value;
-  Status s = transaction()->Get(encoded_key, &encoded_value, &found);
+  s = transaction()->Get(encoded_key, &encoded_value, &found);
   if (!s.ok())
     return s;
   if (found) {
@@ -2032,6 +2038,30 @@ Status IndexedDBBackingStore::KeyExistsInIndex(
     return InvalidDBKeyStatus();
 }
 
+Status IndexedDBBackingStore::Transaction::ObjectStoreHasBlobEntries(
+    int64_t database_id,
+    int64_t object_store_id,
+    bool* has_blob_entries) {
+  const auto ids = std::make_pair(database_id, object_store_id);
+  auto it = object_store_has_blob_entries_.find(ids);
+  if (it != object_store_has_blob_entries_.end()) {
+    *has_blob_entries = it->second;
+    return Status::OK();
+  }
+
+  std::unique_ptr<LevelDBIterator> iterator = transaction()->CreateIterator();
+  Status s = iterator->Seek(
+      BlobEntryKey::EncodeMinKeyForObjectStore(database_id, object_store_id));
+  if (!s.ok())
+    return s;
+  *has_blob_entries =
+      iterator->IsValid() &&
+      CompareKeys(iterator->Key(), BlobEntryKey::EncodeStopKeyForObjectStore(
+                                       database_id, object_store_id)) < 0;
+  object_store_has_blob_entries_[ids] = *has_blob_entries;
+  return s;
+}
+
 IndexedDBBackingStore::Cursor::Cursor(
     const IndexedDBBackingStore::Cursor* other)
     : backing_store_(other->backing_store_),
@@ -3094,6 +3124,31 @@ Status IndexedDBBackingStore::Transaction::CommitPhaseTwo() {
 }
 
 
+void IndexedDBBackingStore::Transaction::CommitPhaseTwoGrouped(
+    base::OnceCallback<void(Status)> callback) {
+  // Blob journal updates and blob file deletion depend on the transaction
+  // being durable as soon as it is written, so those commit on their own.
+  if (!blob_change_map_.empty()) {
+    std::move(callback).Run(CommitPhaseTwo());
+    return;
+  }
+
+  IDB_TRACE("IndexedDBBackingStore::Transaction::CommitPhaseTwoGrouped");
+  DCHECK(committing_);
+  committing_ = false;
+
+  backing_store_->DidCommitTransaction();
+
+  scoped_refptr<LevelDBTransaction> transaction = std::move(transaction_);
+  transaction->CommitGrouped(base::BindOnce(
+      [](base::OnceCallback<void(Status)> callback, Status s) {
+        if (!s.ok())
+          INTERNAL_WRITE_ERROR(TRANSACTION_COMMIT_METHOD);
+        std::move(callback).Run(s);
+      },
+      std::move(callback)));
+}
+
 class IndexedDBBackingStore::Transaction::BlobWriteCallbackWrapper
     : public IndexedDBBackingStore::BlobWriteCallback {
  public:
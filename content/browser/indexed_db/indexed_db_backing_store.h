@@ -15,6 +15,7 @@
 #include <utility>
 #include <vector>
 
+#include "base/callback.h"
 #include "base/files/file_path.h"
 #include "base/gtest_prod_util.h"
 #include "base/macros.h"
@@ -158,6 +159,14 @@ class CONTENT_EXPORT IndexedDBBackingStore
     // by the transaction and not referenced by running scripts.
     virtual leveldb::Status CommitPhaseTwo();
 
+    // Like CommitPhaseTwo, but if the transaction changed no blobs its write
+    // is grouped with those of other transactions committing on the backing
+    // store into one synced write (see LevelDBDatabase::WriteGrouped).
+    // |callback| runs with the result once the write is durable, which for
+    // transactions with blob changes is before this returns.
+    void CommitPhaseTwoGrouped(
+        base::OnceCallback<void(leveldb::Status)> callback);
+
     virtual void Rollback();
     void Reset() {
       backing_store_ = NULL;
@@ -272,6 +281,15 @@ class CONTENT_EXPORT IndexedDBBackingStore
     void PartitionBlobsToRemove(BlobJournalType* dead_blobs,
                                 BlobJournalType* live_blobs) const;
 
+    // Called by GetBlobInfoForRecord: Sets |has_blob_entries| to whether the
+    // object store has any blob entries, so that records in stores without
+    // blobs are read without a lookup in the blob entry key space each.
+    // Blob entries are only written while committing, so the answer is
+    // cached for the lifetime of the transaction.
+    leveldb::Status ObjectStoreHasBlobEntries(int64_t database_id,
+                                              int64_t object_store_id,
+                                              bool* has_blob_entries);
+
     IndexedDBBackingStore* backing_store_;
     scoped_refptr<LevelDBTransaction> transaction_;
     std::map<std::string, std::unique_ptr<BlobChangeRecord>> blob_change_map_;
@@ -279,6 +297,10 @@ class CONTENT_EXPORT IndexedDBBackingStore
         incognito_blob_map_;
     int64_t database_id_;
 
+    // Maps (database id, object store id) to whether the object store had any
+    // blob entries when first read in this transaction.
+    std::map<std::pair<int64_t, int64_t>, bool> object_store_has_blob_entries_;
+
     // List of blob files being newly written as part of this transaction.
     // These will be added to the primary blob journal prior to commit, then
     // removed after a successful commit.
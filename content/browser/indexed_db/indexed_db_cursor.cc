@@ -337,10 +337,9 @@ leveldb::Status IndexedDBCursor::CursorPrefetchIterationOperation(
         found_values.push_back(IndexedDBValue());
         break;
       case indexed_db::CURSOR_KEY_AND_VALUE: {
-        IndexedDBValue value;
-        value.swap(*cursor_->value());
-        size_estimate += value.SizeEstimate();
-        found_values.push_back(value);
+        found_values.emplace_back();
+        found_values.back().swap(*cursor_->value());
+        size_estimate += found_values.back().SizeEstimate();
         break;
       }
       default:
@@ -24,6 +24,9 @@
 
 namespace content {
 
+const base::Feature kIDBGroupCommit{"IDBGroupCommit",
+                                    base::FEATURE_DISABLED_BY_DEFAULT};
+
 namespace {
 
 const int64_t kInactivityTimeoutPeriodSeconds = 60;
@@ -405,10 +408,7 @@ leveldb::Status IndexedDBTransaction::CommitPhaseTwo() {
   state_ = FINISHED;
 
   leveldb::Status s;
-  bool committed;
-  if (!used_) {
-    committed = true;
-  } else {
+  if (used_) {
     base::TimeDelta active_time = base::Time::Now() - diagnostics_.start_time;
     uint64_t size_kb = transaction_->GetTransactionSize() / 1024;
     // All histograms record 1KB to 1GB.
@@ -437,9 +437,28 @@ leveldb::Status IndexedDBTransaction::CommitPhaseTwo() {
         NOTREACHED();
     }
 
+    if (base::FeatureList::IsEnabled(kIDBGroupCommit)) {
+      transaction_->CommitPhaseTwoGrouped(
+          base::BindOnce(&IndexedDBTransaction::OnGroupCommitComplete,
+                         ptr_factory_.GetWeakPtr()));
+      return leveldb::Status::OK();
+    }
     s = transaction_->CommitPhaseTwo();
-    committed = s.ok();
   }
+  return FinishCommit(s);
+}
+
+void IndexedDBTransaction::OnGroupCommitComplete(leveldb::Status status) {
+  // Save the database as |this| can be destroyed in the next line.
+  scoped_refptr<IndexedDBDatabase> database = database_;
+  leveldb::Status s = FinishCommit(status);
+  if (!s.ok())
+    database->ReportError(s);
+}
+
+leveldb::Status IndexedDBTransaction::FinishCommit(leveldb::Status s) {
+  DCHECK_EQ(state_, FINISHED);
+  const bool committed = s.ok();
 
   // Backing store resources (held via cursors) must be released
   // before script callbacks are fired, as the script callbacks may
@@ -12,6 +12,7 @@
 
 #include "base/containers/queue.h"
 #include "base/containers/stack.h"
+#include "base/feature_list.h"
 #include "base/gtest_prod_util.h"
 #include "base/macros.h"
 #include "base/memory/ref_counted.h"
@@ -29,6 +30,11 @@
 
 namespace content {
 
+// When enabled, transactions that changed no blobs are committed in one
+// synced LevelDB write together with other transactions committing on the
+// same backing store.
+CONTENT_EXPORT extern const base::Feature kIDBGroupCommit;
+
 class BlobWriteCallbackImpl;
 class IndexedDBCursor;
 class IndexedDBDatabaseCallbacks;
@@ -192,6 +198,11 @@ class CONTENT_EXPORT IndexedDBTransaction {
   void CloseOpenCursorBindings();
   void CloseOpenCursors();
   leveldb::Status CommitPhaseTwo();
+  // Called once the backing store transaction's write has completed with
+  // |status|, to release the transaction's resources and notify the front
+  // end.
+  leveldb::Status FinishCommit(leveldb::Status status);
+  void OnGroupCommitComplete(leveldb::Status status);
   void Timeout();
 
   const int64_t id_;
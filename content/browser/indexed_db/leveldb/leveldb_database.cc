@@ -12,7 +12,9 @@
 #include <memory>
 #include <utility>
 
+#include "base/bind.h"
 #include "base/files/file.h"
+#include "base/location.h"
 #include "base/logging.h"
 #include "base/macros.h"
 #include "base/memory/ptr_util.h"
@@ -78,18 +80,23 @@ LevelDBDatabase::LevelDBDatabase(
     scoped_refptr<base::SequencedTaskRunner> task_runner,
     size_t max_open_iterators)
     : level_db_state_(std::move(level_db_state)),
+      task_runner_(std::move(task_runner)),
       clock_(new base::DefaultClock()),
-      iterator_lru_(max_open_iterators) {
-  if (task_runner) {
+      iterator_lru_(max_open_iterators),
+      weak_factory_(this) {
+  if (task_runner_) {
     base::trace_event::MemoryDumpManager::GetInstance()
         ->RegisterDumpProviderWithSequencedTaskRunner(
-            this, "IndexedDBBackingStore", std::move(task_runner),
+            this, "IndexedDBBackingStore", task_runner_,
             base::trace_event::MemoryDumpProvider::Options());
   }
   DCHECK(max_open_iterators);
 }
 
 LevelDBDatabase::~LevelDBDatabase() {
+  // Queued batches belong to transactions that have already committed.
+  if (!pending_group_.empty())
+    WritePendingGroup();
   LOCAL_HISTOGRAM_COUNTS_10000("Storage.IndexedDB.LevelDB.MaxIterators",
                                max_iterators_);
   base::trace_event::MemoryDumpManager::GetInstance()->UnregisterDumpProvider(
@@ -168,6 +175,39 @@ leveldb::Status LevelDBDatabase::Write(const LevelDBWriteBatch& write_batch) {
   return s;
 }
 
+void LevelDBDatabase::WriteGrouped(
+    std::unique_ptr<LevelDBWriteBatch> write_batch,
+    WriteCallback callback) {
+  if (!task_runner_) {
+    std::move(callback).Run(Write(*write_batch));
+    return;
+  }
+  if (pending_group_.empty()) {
+    task_runner_->PostTask(FROM_HERE,
+                           base::BindOnce(&LevelDBDatabase::WritePendingGroup,
+                                          weak_factory_.GetWeakPtr()));
+  }
+  pending_group_.emplace_back(std::move(write_batch), std::move(callback));
+}
+
+void LevelDBDatabase::WritePendingGroup() {
+  IDB_TRACE1("LevelDBDatabase::WritePendingGroup", "batches",
+             pending_group_.size());
+  // Callbacks may queue further batches; those go in the next group.
+  std::vector<std::pair<std::unique_ptr<LevelDBWriteBatch>, WriteCallback>>
+      group;
+  group.swap(pending_group_);
+  if (group.empty())
+    return;
+
+  LevelDBWriteBatch* combined = group.front().first.get();
+  for (size_t i = 1; i < group.size(); ++i)
+    combined->Append(*group[i].first);
+  const leveldb::Status s = Write(*combined);
+  for (auto& batch_and_callback : group)
+    std::move(batch_and_callback.second).Run(s);
+}
+
 std::unique_ptr<LevelDBIterator> LevelDBDatabase::CreateIterator(
     const leveldb::ReadOptions& options) {
   num_iterators_++;
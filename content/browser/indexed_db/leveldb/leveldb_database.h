@@ -7,11 +7,15 @@
 
 #include <memory>
 #include <string>
+#include <utility>
+#include <vector>
 
+#include "base/callback.h"
 #include "base/containers/mru_cache.h"
 #include "base/files/file_path.h"
 #include "base/gtest_prod_util.h"
 #include "base/macros.h"
+#include "base/memory/weak_ptr.h"
 #include "base/sequenced_task_runner.h"
 #include "base/strings/string16.h"
 #include "base/strings/string_piece.h"
@@ -74,6 +78,14 @@ class CONTENT_EXPORT LevelDBDatabase
                               bool* found,
                               const LevelDBSnapshot* = 0);
   leveldb::Status Write(const LevelDBWriteBatch& write_batch);
+  // Queues |write_batch| to be written by a task posted to the database's
+  // task runner, in one synced write together with every other batch queued
+  // before that task runs. Batches are applied in the order they were queued,
+  // and |callback| runs with the status of the combined write. Without a task
+  // runner, the batch is written immediately.
+  using WriteCallback = base::OnceCallback<void(leveldb::Status)>;
+  void WriteGrouped(std::unique_ptr<LevelDBWriteBatch> write_batch,
+                    WriteCallback callback);
   // Note: Use DefaultReadOptions() and then adjust any values afterwards.
   std::unique_ptr<LevelDBIterator> CreateIterator(
       const leveldb::ReadOptions& options);
@@ -109,7 +121,11 @@ class CONTENT_EXPORT LevelDBDatabase
 
   void CloseDatabase();
 
+  // Writes every batch queued by WriteGrouped() since the last group write.
+  void WritePendingGroup();
+
   scoped_refptr<LevelDBState> level_db_state_;
+  scoped_refptr<base::SequencedTaskRunner> task_runner_;
   base::Time last_modified_;
   std::unique_ptr<base::Clock> clock_;
 
@@ -137,6 +153,11 @@ class CONTENT_EXPORT LevelDBDatabase
   uint32_t max_iterators_ = 0;
 
   std::string file_name_for_tracing;
+
+  std::vector<std::pair<std::unique_ptr<LevelDBWriteBatch>, WriteCallback>>
+      pending_group_;
+
+  base::WeakPtrFactory<LevelDBDatabase> weak_factory_;
 };
 
 }  // namespace content
@@ -0,0 +1,106 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <memory>
+#include <string>
+#include <tuple>
+#include <utility>
+
+#include "base/files/scoped_temp_dir.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/test/bind_test_util.h"
+#include "base/test/scoped_task_environment.h"
+#include "base/threading/sequenced_task_runner_handle.h"
+#include "base/time/time.h"
+#include "content/browser/indexed_db/leveldb/leveldb_comparator.h"
+#include "content/browser/indexed_db/leveldb/leveldb_database.h"
+#include "content/browser/indexed_db/leveldb/leveldb_env.h"
+#include "content/browser/indexed_db/leveldb/leveldb_transaction.h"
+#include "content/browser/indexed_db/scopes/leveldb_state.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "testing/perf/perf_test.h"
+#include "third_party/leveldatabase/src/include/leveldb/comparator.h"
+
+namespace content {
+
+namespace {
+
+constexpr int kTransactionCount = 1000;
+constexpr size_t kMaxOpenIterators = 50;
+
+// A LevelDBTransaction can only be created through IndexedDBClassFactory or
+// a friend, so subclass it for the test.
+class TestTransaction : public LevelDBTransaction {
+ public:
+  explicit TestTransaction(LevelDBDatabase* db) : LevelDBTransaction(db) {}
+
+ private:
+  ~TestTransaction() override {}
+};
+
+// Measures committing many tiny transactions to an on-disk database, each
+// with its own synced write or grouped into one synced write per task.
+class LevelDBDatabasePerfTest : public testing::Test {
+ public:
+  void SetUp() override {
+    ASSERT_TRUE(temp_directory_.CreateUniqueTempDir());
+    scoped_refptr<LevelDBState> ldb_state;
+    leveldb::Status status;
+    std::tie(ldb_state, status, std::ignore) =
+        indexed_db::GetDefaultLevelDBFactory()->OpenLevelDBState(
+            temp_directory_.GetPath(), LevelDBComparator::BytewiseComparator(),
+            leveldb::BytewiseComparator());
+    ASSERT_TRUE(status.ok());
+    leveldb_ = std::make_unique<LevelDBDatabase>(
+        std::move(ldb_state), base::SequencedTaskRunnerHandle::Get(),
+        kMaxOpenIterators);
+  }
+
+  void TearDown() override { leveldb_.reset(); }
+
+ protected:
+  scoped_refptr<LevelDBTransaction> CreateTransaction(int i) {
+    auto transaction = base::MakeRefCounted<TestTransaction>(leveldb_.get());
+    std::string value = base::NumberToString(i);
+    transaction->Put("key" + value, &value);
+    return transaction;
+  }
+
+  void PrintResult(const std::string& trace, base::TimeDelta elapsed) {
+    perf_test::PrintResult("LevelDBDatabase_commit", "", trace,
+                           elapsed.InMicroseconds() /
+                               static_cast<double>(kTransactionCount),
+                           "us/transaction", true);
+  }
+
+  base::test::ScopedTaskEnvironment task_environment_;
+  base::ScopedTempDir temp_directory_;
+  std::unique_ptr<LevelDBDatabase> leveldb_;
+};
+
+}  // namespace
+
+TEST_F(LevelDBDatabasePerfTest, TinyTransactions) {
+  const base::TimeTicks start = base::TimeTicks::Now();
+  for (int i = 0; i < kTransactionCount; ++i)
+    ASSERT_TRUE(CreateTransaction(i)->Commit().ok());
+  PrintResult("separate", base::TimeTicks::Now() - start);
+}
+
+TEST_F(LevelDBDatabasePerfTest, TinyTransactionsGrouped) {
+  int committed = 0;
+  const base::TimeTicks start = base::TimeTicks::Now();
+  for (int i = 0; i < kTransactionCount; ++i) {
+    CreateTransaction(i)->CommitGrouped(
+        base::BindLambdaForTesting([&committed](leveldb::Status s) {
+          EXPECT_TRUE(s.ok());
+          ++committed;
+        }));
+  }
+  task_environment_.RunUntilIdle();
+  PrintResult("grouped", base::TimeTicks::Now() - start);
+  EXPECT_EQ(kTransactionCount, committed);
+}
+
+}  // namespace content
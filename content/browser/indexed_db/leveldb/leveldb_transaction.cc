@@ -125,6 +125,26 @@ leveldb::Status LevelDBTransaction::Commit() {
     return leveldb::Status::OK();
   }
 
+  leveldb::Status s = db_->Write(*TakeWriteBatch());
+  if (s.ok())
+    finished_ = true;
+  return s;
+}
+
+void LevelDBTransaction::CommitGrouped(
+    base::OnceCallback<void(leveldb::Status)> callback) {
+  DCHECK(!finished_);
+  IDB_TRACE("LevelDBTransaction::CommitGrouped");
+
+  finished_ = true;
+  if (data_.empty()) {
+    std::move(callback).Run(leveldb::Status::OK());
+    return;
+  }
+  db_->WriteGrouped(TakeWriteBatch(), std::move(callback));
+}
+
+std::unique_ptr<LevelDBWriteBatch> LevelDBTransaction::TakeWriteBatch() {
   std::unique_ptr<LevelDBWriteBatch> write_batch = LevelDBWriteBatch::Create();
 
   auto it = data_.begin();
@@ -137,11 +157,7 @@ leveldb::Status LevelDBTransaction::Commit() {
   }
 
   DCHECK(data_.empty());
-
-  leveldb::Status s = db_->Write(*write_batch);
-  if (s.ok())
-    finished_ = true;
-  return s;
+  return write_batch;
 }
 
 void LevelDBTransaction::Rollback() {
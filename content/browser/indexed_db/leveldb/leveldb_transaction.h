@@ -10,6 +10,7 @@
 #include <set>
 #include <string>
 
+#include "base/callback.h"
 #include "base/gtest_prod_util.h"
 #include "base/macros.h"
 #include "base/memory/ref_counted.h"
@@ -36,6 +37,11 @@ class CONTENT_EXPORT LevelDBTransaction
                               std::string* value,
                               bool* found);
   virtual leveldb::Status Commit();
+  // Like Commit(), but the write is grouped with those of other transactions
+  // on the same database; see LevelDBDatabase::WriteGrouped(). The
+  // transaction is finished once this returns, and |callback| runs with the
+  // status of the write.
+  void CommitGrouped(base::OnceCallback<void(leveldb::Status)> callback);
   void Rollback();
 
   std::unique_ptr<LevelDBIterator> CreateIterator();
@@ -161,6 +167,8 @@ class CONTENT_EXPORT LevelDBTransaction
   void RegisterIterator(TransactionIterator* iterator);
   void UnregisterIterator(TransactionIterator* iterator);
   void NotifyIterators();
+  // Moves the pending writes into a batch, leaving the transaction empty.
+  std::unique_ptr<LevelDBWriteBatch> TakeWriteBatch();
 
   LevelDBDatabase* db_;
   const LevelDBSnapshot snapshot_;
@@ -17,7 +17,10 @@
 #include "base/memory/scoped_refptr.h"
 #include "base/no_destructor.h"
 #include "base/strings/string_piece.h"
+#include "base/test/bind_test_util.h"
+#include "base/test/scoped_task_environment.h"
 #include "base/test/simple_test_clock.h"
+#include "base/threading/sequenced_task_runner_handle.h"
 #include "content/browser/indexed_db/leveldb/leveldb_comparator.h"
 #include "content/browser/indexed_db/leveldb/leveldb_database.h"
 #include "content/browser/indexed_db/leveldb/leveldb_env.h"
@@ -195,5 +198,46 @@ TEST(LevelDBDatabaseTest, LastModified) {
   EXPECT_EQ(now_time, leveldb->LastModified());
 }
 
+TEST(LevelDBDatabaseTest, WriteGrouped) {
+  base::test::ScopedTaskEnvironment task_environment;
+  leveldb::Status status;
+  scoped_refptr<LevelDBState> ldb_state;
+  std::tie(ldb_state, status, std::ignore) = OpenLevelDB(base::FilePath());
+  ASSERT_TRUE(status.ok());
+  auto leveldb = std::make_unique<LevelDBDatabase>(
+      std::move(ldb_state), base::SequencedTaskRunnerHandle::Get(),
+      kDefaultMaxOpenIteratorsPerDatabase);
+
+  int written = 0;
+  auto write = [&](const std::string& key, const std::string& value) {
+    auto batch = LevelDBWriteBatch::Create();
+    batch->Put(key, value);
+    leveldb->WriteGrouped(std::move(batch),
+                          base::BindLambdaForTesting([&](leveldb::Status s) {
+                            EXPECT_TRUE(s.ok());
+                            ++written;
+                          }));
+  };
+  write("a", "1");
+  write("b", "2");
+  write("a", "3");
+
+  // Nothing is written until the group write runs.
+  std::string value;
+  bool found = false;
+  EXPECT_TRUE(leveldb->Get("a", &value, &found).ok());
+  EXPECT_FALSE(found);
+
+  task_environment.RunUntilIdle();
+  EXPECT_EQ(3, written);
+  // Batches are applied in the order they were queued.
+  EXPECT_TRUE(leveldb->Get("a", &value, &found).ok());
+  EXPECT_TRUE(found);
+  EXPECT_EQ("3", value);
+  EXPECT_TRUE(leveldb->Get("b", &value, &found).ok());
+  EXPECT_TRUE(found);
+  EXPECT_EQ("2", value);
+}
+
 }  // namespace leveldb_unittest
 }  // namespace content
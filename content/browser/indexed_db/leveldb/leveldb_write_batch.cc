@@ -32,4 +32,8 @@ void LevelDBWriteBatch::Remove(const base::StringPiece& key) {
 
 void LevelDBWriteBatch::Clear() { write_batch_->Clear(); }
 
+void LevelDBWriteBatch::Append(const LevelDBWriteBatch& other) {
+  write_batch_->Append(*other.write_batch_);
+}
+
 }  // namespace content
@@ -27,6 +27,8 @@ class CONTENT_EXPORT LevelDBWriteBatch {
   void Remove(const base::StringPiece& key);  // Add remove operation to the
                                               // batch.
   void Clear();
+  // Appends the operations of |other| to this batch, after its own.
+  void Append(const LevelDBWriteBatch& other);
 
  private:
   friend class LevelDBDatabase;
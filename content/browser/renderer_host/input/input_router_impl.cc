@@ -23,6 +23,7 @@
 #include "content/common/input_messages.h"
 #include "content/public/browser/notification_service.h"
 #include "content/public/browser/notification_types.h"
+#include "content/public/common/content_features.h"
 #include "content/public/common/content_switches.h"
 #include "content/public/common/input_event_ack_state.h"
 #include "ipc/ipc_sender.h"
@@ -91,6 +92,8 @@ InputRouterImpl::InputRouterImpl(
       device_scale_factor_(1.f),
       compositor_touch_action_enabled_(
           base::FeatureList::IsEnabled(features::kCompositorTouchAction)),
+      coalesce_mouse_moves_(
+          base::FeatureList::IsEnabled(features::kBrowserSideInputCoalescing)),
       host_binding_(this),
       frame_host_binding_(this),
       weak_ptr_factory_(this) {
@@ -119,17 +122,26 @@ void InputRouterImpl::SendMouseEvent(
     return;
   }
 
+  if (coalesce_mouse_moves_ &&
+      mouse_event.event.GetType() == WebInputEvent::kMouseMove) {
+    QueueMouseMove(mouse_event, std::move(event_result_callback));
+    return;
+  }
+
+  FlushCoalescedMouseMoves();
   SendMouseEventImmediately(mouse_event, std::move(event_result_callback));
 }
 
 void InputRouterImpl::SendWheelEvent(
     const MouseWheelEventWithLatencyInfo& wheel_event) {
+  FlushCoalescedMouseMoves();
   wheel_event_queue_.QueueEvent(wheel_event);
 }
 
 void InputRouterImpl::SendKeyboardEvent(
     const NativeWebKeyboardEventWithLatencyInfo& key_event,
     KeyboardEventCallback event_result_callback) {
+  FlushCoalescedMouseMoves();
   gesture_event_queue_.StopFling();
   mojom::WidgetInputHandler::DispatchEventCallback callback =
       base::BindOnce(&InputRouterImpl::KeyboardEventHandled, weak_this_,
@@ -140,6 +152,7 @@ void InputRouterImpl::SendKeyboardEvent(
 
 void InputRouterImpl::SendGestureEvent(
     const GestureEventWithLatencyInfo& original_gesture_event) {
+  FlushCoalescedMouseMoves();
   input_stream_validator_.Validate(original_gesture_event.event,
                                    FlingCancellationIsDeferred());
 
@@ -210,6 +223,7 @@ void InputRouterImpl::SendGestureEventWithoutQueueing(
 
 void InputRouterImpl::SendTouchEvent(
     const TouchEventWithLatencyInfo& touch_event) {
+  FlushCoalescedMouseMoves();
   TouchEventWithLatencyInfo updated_touch_event = touch_event;
   SetMovementXYForTouchPoints(&updated_touch_event.event);
   input_stream_validator_.Validate(updated_touch_event.event);
@@ -223,7 +237,8 @@ void InputRouterImpl::NotifySiteIsMobileOptimized(bool is_mobile_optimized) {
 bool InputRouterImpl::HasPendingEvents() const {
   return !touch_event_queue_.Empty() || !gesture_event_queue_.empty() ||
          wheel_event_queue_.has_pending() ||
-         touchpad_pinch_event_queue_.has_pending();
+         touchpad_pinch_event_queue_.has_pending() ||
+         !pending_mouse_moves_.empty();
 }
 
 void InputRouterImpl::SetDeviceScaleFactor(float device_scale_factor) {
@@ -377,6 +392,50 @@ void InputRouterImpl::SendMouseEventImmediately(
                              std::move(callback));
 }
 
+void InputRouterImpl::QueueMouseMove(
+    const MouseEventWithLatencyInfo& mouse_event,
+    MouseEventCallback event_result_callback) {
+  if (!pending_mouse_moves_.empty() &&
+      !pending_mouse_moves_.back().CanCoalesceWith(mouse_event)) {
+    FlushCoalescedMouseMoves();
+  }
+  pending_mouse_moves_.push_back(mouse_event);
+  pending_mouse_move_callbacks_.push_back(std::move(event_result_callback));
+
+  // Otherwise the queued moves are sent once the renderer acks the one in
+  // flight, which it does when it dispatches it at the next frame.
+  if (!mouse_moves_in_flight_)
+    FlushCoalescedMouseMoves();
+}
+
+void InputRouterImpl::FlushCoalescedMouseMoves() {
+  if (pending_mouse_moves_.empty())
+    return;
+
+  std::vector<MouseEventWithLatencyInfo> events;
+  events.swap(pending_mouse_moves_);
+  std::vector<MouseEventCallback> callbacks;
+  callbacks.swap(pending_mouse_move_callbacks_);
+  UMA_HISTOGRAM_COUNTS_100("Event.BrowserSideCoalescing.MouseMovesPerDispatch",
+                           events.size());
+
+  MouseEventWithLatencyInfo coalesced_event = events.front();
+  std::vector<ui::WebScopedInputEvent> coalesced_events;
+  if (events.size() > 1) {
+    for (size_t i = 1; i < events.size(); ++i)
+      coalesced_event.CoalesceWith(events[i]);
+    for (const MouseEventWithLatencyInfo& event : events)
+      coalesced_events.push_back(WebInputEventTraits::Clone(event.event));
+  }
+
+  ++mouse_moves_in_flight_;
+  mojom::WidgetInputHandler::DispatchEventCallback callback = base::BindOnce(
+      &InputRouterImpl::CoalescedMouseMovesHandled, weak_this_,
+      std::move(events), std::move(callbacks));
+  FilterAndSendWebInputEvent(coalesced_event.event, std::move(coalesced_events),
+                             coalesced_event.latency, std::move(callback));
+}
+
 void InputRouterImpl::SendTouchEventImmediately(
     const TouchEventWithLatencyInfo& touch_event) {
   mojom::WidgetInputHandler::DispatchEventCallback callback = base::BindOnce(
@@ -506,6 +565,16 @@ void InputRouterImpl::FilterAndSendWebInputEvent(
     const WebInputEvent& input_event,
     const ui::LatencyInfo& latency_info,
     mojom::WidgetInputHandler::DispatchEventCallback callback) {
+  FilterAndSendWebInputEvent(input_event,
+                             std::vector<ui::WebScopedInputEvent>(),
+                             latency_info, std::move(callback));
+}
+
+void InputRouterImpl::FilterAndSendWebInputEvent(
+    const WebInputEvent& input_event,
+    std::vector<ui::WebScopedInputEvent> coalesced_events,
+    const ui::LatencyInfo& latency_info,
+    mojom::WidgetInputHandler::DispatchEventCallback callback) {
   TRACE_EVENT1("input", "InputRouterImpl::FilterAndSendWebInputEvent", "type",
                WebInputEvent::GetName(input_event.GetType()));
   TRACE_EVENT_WITH_FLOW2(
@@ -529,6 +598,11 @@ void InputRouterImpl::FilterAndSendWebInputEvent(
 
   std::unique_ptr<InputEvent> event =
       ScaleEvent(input_event, device_scale_factor_, latency_info);
+  for (const ui::WebScopedInputEvent& coalesced_event : coalesced_events) {
+    event->coalesced_events.push_back(std::move(
+        ScaleEvent(*coalesced_event, device_scale_factor_, latency_info)
+            ->web_event));
+  }
   if (WebInputEventTraits::ShouldBlockEventStream(input_event)) {
     TRACE_EVENT_INSTANT0("input", "InputEventSentBlocking",
                          TRACE_EVENT_SCOPE_THREAD);
@@ -587,6 +661,33 @@ void InputRouterImpl::MouseEventHandled(
   std::move(event_result_callback).Run(event, source, state);
 }
 
+void InputRouterImpl::CoalescedMouseMovesHandled(
+    std::vector<MouseEventWithLatencyInfo> events,
+    std::vector<MouseEventCallback> event_result_callbacks,
+    InputEventAckSource source,
+    const ui::LatencyInfo& latency,
+    InputEventAckState state,
+    const base::Optional<ui::DidOverscrollParams>& overscroll,
+    const base::Optional<cc::TouchAction>& touch_action) {
+  TRACE_EVENT2("input", "InputRouterImpl::CoalescedMouseMovesHandled",
+               "count", events.size(), "ack",
+               InputEventAckStateToString(state));
+
+  if (source != InputEventAckSource::BROWSER)
+    client_->DecrementInFlightEventCount(source);
+  DCHECK_GT(mouse_moves_in_flight_, 0);
+  --mouse_moves_in_flight_;
+
+  // The callbacks may destroy |this|.
+  base::WeakPtr<InputRouterImpl> weak_this = weak_this_;
+  for (size_t i = 0; i < events.size(); ++i) {
+    events[i].latency.AddNewLatencyFrom(latency);
+    std::move(event_result_callbacks[i]).Run(events[i], source, state);
+  }
+  if (weak_this && !mouse_moves_in_flight_)
+    FlushCoalescedMouseMoves();
+}
+
 void InputRouterImpl::TouchEventHandled(
     const TouchEventWithLatencyInfo& touch_event,
     InputEventAckSource source,
@@ -9,6 +9,7 @@
 
 #include <memory>
 #include <queue>
+#include <vector>
 
 #include "base/containers/flat_map.h"
 #include "base/gtest_prod_util.h"
@@ -30,6 +31,7 @@
 #include "content/public/browser/native_web_keyboard_event.h"
 #include "content/public/common/input_event_ack_source.h"
 #include "mojo/public/cpp/bindings/binding.h"
+#include "ui/events/blink/web_input_event_traits.h"
 
 namespace ui {
 class LatencyInfo;
@@ -132,6 +134,14 @@ class CONTENT_EXPORT InputRouterImpl : public InputRouter,
   void SendMouseEventImmediately(const MouseEventWithLatencyInfo& mouse_event,
                                  MouseEventCallback event_result_callback);
 
+  // Holds |mouse_event| back while a mouse move is awaiting its ack from the
+  // renderer, to be coalesced with later moves.
+  void QueueMouseMove(const MouseEventWithLatencyInfo& mouse_event,
+                      MouseEventCallback event_result_callback);
+  // Sends the queued mouse moves as a single event, along with the original
+  // events for getCoalescedEvents().
+  void FlushCoalescedMouseMoves();
+
   // PassthroughTouchEventQueueClient
   void SendTouchEventImmediately(
       const TouchEventWithLatencyInfo& touch_event) override;
@@ -177,6 +187,11 @@ class CONTENT_EXPORT InputRouterImpl : public InputRouter,
       const blink::WebInputEvent& input_event,
       const ui::LatencyInfo& latency_info,
       mojom::WidgetInputHandler::DispatchEventCallback callback);
+  void FilterAndSendWebInputEvent(
+      const blink::WebInputEvent& input_event,
+      std::vector<ui::WebScopedInputEvent> coalesced_events,
+      const ui::LatencyInfo& latency_info,
+      mojom::WidgetInputHandler::DispatchEventCallback callback);
 
   void KeyboardEventHandled(
       const NativeWebKeyboardEventWithLatencyInfo& event,
@@ -194,6 +209,14 @@ class CONTENT_EXPORT InputRouterImpl : public InputRouter,
       InputEventAckState state,
       const base::Optional<ui::DidOverscrollParams>& overscroll,
       const base::Optional<cc::TouchAction>& touch_action);
+  void CoalescedMouseMovesHandled(
+      std::vector<MouseEventWithLatencyInfo> events,
+      std::vector<MouseEventCallback> event_result_callbacks,
+      InputEventAckSource source,
+      const ui::LatencyInfo& latency,
+      InputEventAckState state,
+      const base::Optional<ui::DidOverscrollParams>& overscroll,
+      const base::Optional<cc::TouchAction>& touch_action);
   void TouchEventHandled(
       const TouchEventWithLatencyInfo& touch_event,
       InputEventAckSource source,
@@ -249,6 +272,13 @@ class CONTENT_EXPORT InputRouterImpl : public InputRouter,
 
   bool compositor_touch_action_enabled_;
 
+  // Whether mouse moves are coalesced while one is awaiting its ack, per
+  // features::kBrowserSideInputCoalescing.
+  const bool coalesce_mouse_moves_;
+  int mouse_moves_in_flight_ = 0;
+  std::vector<MouseEventWithLatencyInfo> pending_mouse_moves_;
+  std::vector<MouseEventCallback> pending_mouse_move_callbacks_;
+
   // Last touch position relative to screen. Used to compute movementX/Y.
   base::flat_map<int, gfx::Point> global_touch_position_;
 
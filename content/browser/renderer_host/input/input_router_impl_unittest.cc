@@ -2596,4 +2596,74 @@ TEST_F(InputRouterImplScaleGestureEventTest, GestureTwoFingerTap) {
                        WebInputEvent::kGestureTwoFingerTap});
 }
 
+class InputRouterImplCoalescingTest : public InputRouterImplTestBase {
+ public:
+  InputRouterImplCoalescingTest() {
+    feature_list_.InitAndEnableFeature(features::kBrowserSideInputCoalescing);
+  }
+
+ private:
+  base::test::ScopedFeatureList feature_list_;
+
+  DISALLOW_COPY_AND_ASSIGN(InputRouterImplCoalescingTest);
+};
+
+// Mouse moves are held back while one is awaiting its ack, and then sent as
+// a single event carrying the moves that were coalesced into it.
+TEST_F(InputRouterImplCoalescingTest, CoalescesMouseMovesUntilAck) {
+  SimulateMouseEvent(WebInputEvent::kMouseMove, 1, 1);
+  DispatchedMessages dispatched_messages = GetAndResetDispatchedMessages();
+  ASSERT_EQ(1u, dispatched_messages.size());
+  ASSERT_TRUE(dispatched_messages[0]->ToEvent());
+  EXPECT_TRUE(
+      dispatched_messages[0]->ToEvent()->Event()->coalesced_events.empty());
+
+  SimulateMouseEvent(WebInputEvent::kMouseMove, 2, 2);
+  SimulateMouseEvent(WebInputEvent::kMouseMove, 3, 3);
+  EXPECT_EQ(0u, GetAndResetDispatchedMessages().size());
+  EXPECT_TRUE(input_router_->HasPendingEvents());
+
+  dispatched_messages[0]->ToEvent()->CallCallback(
+      INPUT_EVENT_ACK_STATE_NOT_CONSUMED);
+  EXPECT_EQ(1u, disposition_handler_->GetAndResetAckCount());
+  dispatched_messages = GetAndResetDispatchedMessages();
+  ASSERT_EQ(1u, dispatched_messages.size());
+  ASSERT_TRUE(dispatched_messages[0]->ToEvent());
+  const InputEvent* event = dispatched_messages[0]->ToEvent()->Event();
+  EXPECT_EQ(3, static_cast<const WebMouseEvent&>(*event->web_event)
+                   .PositionInWidget()
+                   .x);
+  ASSERT_EQ(2u, event->coalesced_events.size());
+  EXPECT_EQ(2, static_cast<const WebMouseEvent&>(*event->coalesced_events[0])
+                   .PositionInWidget()
+                   .x);
+  EXPECT_EQ(3, static_cast<const WebMouseEvent&>(*event->coalesced_events[1])
+                   .PositionInWidget()
+                   .x);
+
+  // Each of the coalesced moves is acked.
+  dispatched_messages[0]->ToEvent()->CallCallback(
+      INPUT_EVENT_ACK_STATE_NOT_CONSUMED);
+  EXPECT_EQ(2u, disposition_handler_->GetAndResetAckCount());
+  EXPECT_FALSE(input_router_->HasPendingEvents());
+}
+
+// Other events flush the pending mouse moves so they stay in order.
+TEST_F(InputRouterImplCoalescingTest, OtherEventsFlushMouseMoves) {
+  SimulateMouseEvent(WebInputEvent::kMouseMove, 1, 1);
+  EXPECT_EQ(1u, GetAndResetDispatchedMessages().size());
+  SimulateMouseEvent(WebInputEvent::kMouseMove, 2, 2);
+  EXPECT_EQ(0u, GetAndResetDispatchedMessages().size());
+
+  SimulateMouseEvent(WebInputEvent::kMouseDown, 2, 2);
+  DispatchedMessages dispatched_messages = GetAndResetDispatchedMessages();
+  ASSERT_EQ(2u, dispatched_messages.size());
+  ASSERT_TRUE(dispatched_messages[0]->ToEvent());
+  ASSERT_TRUE(dispatched_messages[1]->ToEvent());
+  EXPECT_EQ(WebInputEvent::kMouseMove,
+            dispatched_messages[0]->ToEvent()->Event()->web_event->GetType());
+  EXPECT_EQ(WebInputEvent::kMouseDown,
+            dispatched_messages[1]->ToEvent()->Event()->web_event->GetType());
+}
+
 }  // namespace content
@@ -29,6 +29,7 @@
 #include "base/lazy_instance.h"
 #include "base/location.h"
 #include "base/logging.h"
+#include "base/memory/memory_pressure_listener.h"
 #include "base/memory/memory_pressure_monitor.h"
 #include "base/memory/ptr_util.h"
 #include "base/memory/ref_counted.h"
@@ -36,6 +37,7 @@
 #include "base/memory/writable_shared_memory_region.h"
 #include "base/message_loop/message_loop.h"
 #include "base/metrics/field_trial.h"
+#include "base/metrics/field_trial_params.h"
 #include "base/metrics/histogram_base.h"
 #include "base/metrics/histogram_macros.h"
 #include "base/metrics/persistent_histogram_allocator.h"
@@ -490,20 +492,26 @@ class SessionStorageHolder : public base::SupportsUserData::Data {
 
 // This class manages spare RenderProcessHosts.
 //
-// There is a singleton instance of this class which manages a single spare
-// renderer (g_spare_render_process_host_manager, below). This class
+// There is a singleton instance of this class which manages the spare
+// renderers (g_spare_render_process_host_manager, below). This class
 // encapsulates the implementation of
 // RenderProcessHost::WarmupSpareRenderProcessHost()
 //
 // RenderProcessHostImpl should call
 // SpareRenderProcessHostManager::MaybeTakeSpareRenderProcessHost when creating
-// a new RPH. In this implementation, the spare renderer is bound to a
+// a new RPH. In this implementation, the spare renderers are bound to a
 // BrowserContext and its default StoragePartition. If
 // MaybeTakeSpareRenderProcessHost is called with a BrowserContext that does not
-// match, the spare renderer is discarded. Only the default StoragePartition
+// match, the spare renderers are discarded. Only the default StoragePartition
 // will be able to use a spare renderer. The spare renderer will also not be
 // used as a guest renderer (is_for_guests_ == true).
 //
+// Usually there is at most one spare renderer. With
+// features::kSpareRendererPool the manager keeps a pool of them instead, whose
+// target size grows (up to the "pool_size" param) each time a navigation finds
+// the pool empty, and shrinks back when spares get discarded unused or under
+// memory pressure.
+//
 // It is safe to call WarmupSpareRenderProcessHost multiple times, although if
 // called in a context where the spare renderer is not likely to be used
 // performance may suffer due to the unnecessary RPH creation.
@@ -512,37 +520,55 @@ class SpareRenderProcessHostManager : public RenderProcessHostObserver {
   SpareRenderProcessHostManager() {}
 
   void WarmupSpareRenderProcessHost(BrowserContext* browser_context) {
-    if (spare_render_process_host_ &&
-        spare_render_process_host_->GetBrowserContext() == browser_context) {
+    if (!spare_render_process_hosts_.empty() &&
+        spare_render_process_hosts_.front().host->GetBrowserContext() !=
+            browser_context) {
+      CleanupSpareRenderProcessHosts();
+    }
+    for (const SpareProcess& spare : spare_render_process_hosts_) {
       DCHECK_EQ(BrowserContext::GetDefaultStoragePartition(browser_context),
-                spare_render_process_host_->GetStoragePartition());
-      return;  // Nothing to warm up.
+                spare.host->GetStoragePartition());
     }
 
-    CleanupSpareRenderProcessHost();
-
-    // Don't create a spare renderer if we're using --single-process or if we've
-    // got too many processes. See also ShouldTryToUseExistingProcessHost in
-    // this file.
-    if (RenderProcessHost::run_renderer_in_process() ||
-        g_all_hosts.Get().size() >=
-            RenderProcessHostImpl::GetMaxRendererProcessCount())
-      return;
-
-    // Don't create a spare renderer when the system is under load.  This is
-    // currently approximated by only looking at the memory pressure.  See also
-    // https://crbug.com/852905.
-    auto* memory_monitor = base::MemoryPressureMonitor::Get();
-    if (memory_monitor &&
-        memory_monitor->GetCurrentPressureLevel() >=
-            base::MemoryPressureListener::MEMORY_PRESSURE_LEVEL_MODERATE)
-      return;
+    target_pool_size_ = std::min(target_pool_size_, GetMaxPoolSize());
+    while (spare_render_process_hosts_.size() > target_pool_size_)
+      CleanupSpareRenderProcessHost(spare_render_process_hosts_.back().host);
+
+    while (spare_render_process_hosts_.size() < target_pool_size_) {
+      // Don't create a spare renderer if we're using --single-process or if
+      // we've got too many processes. See also
+      // ShouldTryToUseExistingProcessHost in this file.
+      if (RenderProcessHost::run_renderer_in_process() ||
+          g_all_hosts.Get().size() >=
+              RenderProcessHostImpl::GetMaxRendererProcessCount())
+        return;
+
+      // Don't create a spare renderer when the system is under load.  This is
+      // currently approximated by only looking at the memory pressure.  See
+      // also https://crbug.com/852905.
+      auto* memory_monitor = base::MemoryPressureMonitor::Get();
+      if (memory_monitor &&
+          memory_monitor->GetCurrentPressureLevel() >=
+              base::MemoryPressureListener::MEMORY_PRESSURE_LEVEL_MODERATE)
+        return;
+
+      // Launching the process also gets the renderer through its startup
+      // (V8 snapshot, ICU data, Blink and font initialization) before any
+      // navigation is assigned to it.
+      RenderProcessHost* host = RenderProcessHostImpl::CreateRenderProcessHost(
+          browser_context, nullptr /* storage_partition_impl */,
+          nullptr /* site_instance */, false /* is_for_guests_only */);
+      host->AddObserver(this);
+      host->Init();
+      spare_render_process_hosts_.push_back({host, base::TimeTicks::Now()});
+    }
 
-    spare_render_process_host_ = RenderProcessHostImpl::CreateRenderProcessHost(
-        browser_context, nullptr /* storage_partition_impl */,
-        nullptr /* site_instance */, false /* is_for_guests_only */);
-    spare_render_process_host_->AddObserver(this);
-    spare_render_process_host_->Init();
+    if (GetMaxPoolSize() > 1 && !memory_pressure_listener_) {
+      memory_pressure_listener_ =
+          std::make_unique<base::MemoryPressureListener>(base::BindRepeating(
+              &SpareRenderProcessHostManager::OnMemoryPressure,
+              base::Unretained(this)));
+    }
   }
 
   RenderProcessHost* MaybeTakeSpareRenderProcessHost(
@@ -567,16 +593,20 @@ class SpareRenderProcessHostManager : public RenderProcessHostObserver {
     StoragePartition* site_storage =
         BrowserContext::GetStoragePartition(browser_context, site_instance);
 
+    // All the spares share a BrowserContext and StoragePartition, so checking
+    // the first one is enough.
+    RenderProcessHost* spare = spare_render_process_host();
+
     // Log UMA metrics.
     using SpareProcessMaybeTakeAction =
         RenderProcessHostImpl::SpareProcessMaybeTakeAction;
     SpareProcessMaybeTakeAction action =
         SpareProcessMaybeTakeAction::kNoSparePresent;
-    if (!spare_render_process_host_)
+    if (!spare)
       action = SpareProcessMaybeTakeAction::kNoSparePresent;
-    else if (browser_context != spare_render_process_host_->GetBrowserContext())
+    else if (browser_context != spare->GetBrowserContext())
       action = SpareProcessMaybeTakeAction::kMismatchedBrowserContext;
-    else if (site_storage != spare_render_process_host_->GetStoragePartition())
+    else if (site_storage != spare->GetStoragePartition())
       action = SpareProcessMaybeTakeAction::kMismatchedStoragePartition;
     else if (!embedder_allows_spare_usage)
       action = SpareProcessMaybeTakeAction::kRefusedByEmbedder;
@@ -589,29 +619,46 @@ class SpareRenderProcessHostManager : public RenderProcessHostObserver {
 
     // Decide whether to take or drop the spare process.
     RenderProcessHost* returned_process = nullptr;
-    if (spare_render_process_host_ &&
-        browser_context == spare_render_process_host_->GetBrowserContext() &&
-        site_storage == spare_render_process_host_->GetStoragePartition() &&
-        !is_for_guests_only && embedder_allows_spare_usage &&
-        site_instance_allows_spare_usage) {
-      CHECK(spare_render_process_host_->HostHasNotBeenUsed());
+    if (spare && browser_context == spare->GetBrowserContext() &&
+        site_storage == spare->GetStoragePartition() && !is_for_guests_only &&
+        embedder_allows_spare_usage && site_instance_allows_spare_usage) {
+      CHECK(spare->HostHasNotBeenUsed());
 
       // If the spare process ends up getting killed, the spare manager should
       // discard the spare RPH, so if one exists, it should always be live here.
-      CHECK(spare_render_process_host_->IsInitializedAndNotDead());
+      CHECK(spare->IsInitializedAndNotDead());
 
       DCHECK_EQ(SpareProcessMaybeTakeAction::kSpareTaken, action);
-      returned_process = spare_render_process_host_;
-      ReleaseSpareRenderProcessHost(spare_render_process_host_);
-    } else if (!RenderProcessHostImpl::IsSpareProcessKeptAtAllTimes()) {
-      // If the spare shouldn't be kept around, then discard it as soon as we
-      // find that the current spare was mismatched.
-      CleanupSpareRenderProcessHost();
-    } else if (g_all_hosts.Get().size() >=
-               RenderProcessHostImpl::GetMaxRendererProcessCount()) {
-      // Drop the spare if we are at a process limit and the spare wasn't taken.
-      // This helps avoid process reuse.
-      CleanupSpareRenderProcessHost();
+      // The time the spare spent warming up is roughly the process launch and
+      // renderer initialization time saved on the way to the first paint.
+      UMA_HISTOGRAM_MEDIUM_TIMES(
+          "BrowserRenderProcessHost.SpareProcessWarmupTimeWhenTaken",
+          base::TimeTicks::Now() -
+              spare_render_process_hosts_.front().warmup_time);
+      returned_process = spare;
+      ReleaseSpareRenderProcessHost(spare);
+
+      // Running out of spares means the next new process has to be launched
+      // from scratch, so keep more of them around.
+      if (spare_render_process_hosts_.empty())
+        GrowPool();
+    } else {
+      if (action == SpareProcessMaybeTakeAction::kNoSparePresent &&
+          !is_for_guests_only && embedder_allows_spare_usage &&
+          site_instance_allows_spare_usage) {
+        GrowPool();
+      }
+
+      if (!RenderProcessHostImpl::IsSpareProcessKeptAtAllTimes()) {
+        // If the spare shouldn't be kept around, then discard it as soon as we
+        // find that the current spare was mismatched.
+        CleanupSpareRenderProcessHosts();
+      } else if (g_all_hosts.Get().size() >=
+                 RenderProcessHostImpl::GetMaxRendererProcessCount()) {
+        // Drop the spares if we are at a process limit and the spare wasn't
+        // taken. This helps avoid process reuse.
+        CleanupSpareRenderProcessHosts();
+      }
     }
 
     return returned_process;
@@ -621,65 +668,125 @@ class SpareRenderProcessHostManager : public RenderProcessHostObserver {
   // might require a new process for |browser_context|).
   //
   // Note that depending on the caller PrepareForFutureRequests can be called
-  // after the spare_render_process_host_ has either been 1) matched and taken
+  // after the spare render process hosts have either been 1) matched and taken
   // or 2) mismatched and ignored or 3) matched and ignored.
   void PrepareForFutureRequests(BrowserContext* browser_context) {
     if (RenderProcessHostImpl::IsSpareProcessKeptAtAllTimes()) {
-      // Always keep around a spare process for the most recently requested
+      // Always keep around spare processes for the most recently requested
       // |browser_context|.
       WarmupSpareRenderProcessHost(browser_context);
     } else {
-      // Discard the ignored (probably non-matching) spare so as not to waste
+      // Discard the ignored (probably non-matching) spares so as not to waste
       // resources.
-      CleanupSpareRenderProcessHost();
+      CleanupSpareRenderProcessHosts();
     }
   }
 
-  // Gracefully remove and cleanup a spare RenderProcessHost if it exists.
-  void CleanupSpareRenderProcessHost() {
-    if (spare_render_process_host_) {
-      // Stop observing the process, to avoid getting notifications as a
-      // consequence of the Cleanup call below - such notification could call
-      // back into CleanupSpareRenderProcessHost leading to stack overflow.
-      spare_render_process_host_->RemoveObserver(this);
-
-      // Make sure the RenderProcessHost object gets destroyed.
-      if (!spare_render_process_host_->IsKeepAliveRefCountDisabled())
-        spare_render_process_host_->Cleanup();
-
-      // Drop reference to the RenderProcessHost object.
-      spare_render_process_host_ = nullptr;
-    }
+  // Gracefully remove and cleanup all the spare RenderProcessHosts.
+  void CleanupSpareRenderProcessHosts() {
+    // Spares that were never used were a waste, so keep fewer of them.
+    if (!spare_render_process_hosts_.empty())
+      ShrinkPool();
+    while (!spare_render_process_hosts_.empty())
+      CleanupSpareRenderProcessHost(spare_render_process_hosts_.back().host);
   }
 
+  // Returns the spare RenderProcessHost to be taken next, if any.
   RenderProcessHost* spare_render_process_host() {
-    return spare_render_process_host_;
+    return spare_render_process_hosts_.empty()
+               ? nullptr
+               : spare_render_process_hosts_.front().host;
+  }
+
+  bool IsSpareRenderProcessHost(RenderProcessHost* host) const {
+    return std::any_of(
+        spare_render_process_hosts_.begin(), spare_render_process_hosts_.end(),
+        [host](const SpareProcess& spare) { return spare.host == host; });
   }
 
  private:
+  struct SpareProcess {
+    // This is a bare pointer, because RenderProcessHost manages the lifetime
+    // of all its instances; see g_all_hosts, above.
+    RenderProcessHost* host;
+    base::TimeTicks warmup_time;
+  };
+
+  static size_t GetMaxPoolSize() {
+    if (!base::FeatureList::IsEnabled(features::kSpareRendererPool))
+      return 1;
+    return base::ClampToRange(
+        base::GetFieldTrialParamByFeatureAsInt(
+            features::kSpareRendererPool,
+            features::kSpareRendererPoolSizeParamName, 3),
+        1, 16);
+  }
+
+  void GrowPool() {
+    target_pool_size_ = std::min(target_pool_size_ + 1, GetMaxPoolSize());
+  }
+
+  void ShrinkPool() {
+    target_pool_size_ = std::max<size_t>(target_pool_size_ - 1, 1);
+  }
+
+  void OnMemoryPressure(
+      base::MemoryPressureListener::MemoryPressureLevel memory_pressure_level) {
+    if (memory_pressure_level ==
+        base::MemoryPressureListener::MEMORY_PRESSURE_LEVEL_NONE) {
+      return;
+    }
+    // Keep a single spare, which the existing behavior tolerates, and don't
+    // grow the pool back until spares run out again.
+    target_pool_size_ = 1;
+    while (spare_render_process_hosts_.size() > target_pool_size_)
+      CleanupSpareRenderProcessHost(spare_render_process_hosts_.back().host);
+  }
+
+  // Gracefully remove and cleanup the spare |host|.
+  void CleanupSpareRenderProcessHost(RenderProcessHost* host) {
+    // Stop observing the process, to avoid getting notifications as a
+    // consequence of the Cleanup call below - such notification could call
+    // back into CleanupSpareRenderProcessHost leading to stack overflow.
+    ReleaseSpareRenderProcessHost(host);
+
+    // Make sure the RenderProcessHost object gets destroyed.
+    if (!host->IsKeepAliveRefCountDisabled())
+      host->Cleanup();
+  }
+
   // Release ownership of |host| as a possible spare renderer.  Called when
   // |host| has either been 1) claimed to be used in a navigation or 2) shutdown
   // somewhere else.
   void ReleaseSpareRenderProcessHost(RenderProcessHost* host) {
-    if (spare_render_process_host_ && spare_render_process_host_ == host) {
-      spare_render_process_host_->RemoveObserver(this);
-      spare_render_process_host_ = nullptr;
-    }
+    auto it = std::find_if(
+        spare_render_process_hosts_.begin(), spare_render_process_hosts_.end(),
+        [host](const SpareProcess& spare) { return spare.host == host; });
+    if (it == spare_render_process_hosts_.end())
+      return;
+    host->RemoveObserver(this);
+    spare_render_process_hosts_.erase(it);
   }
 
   void RenderProcessExited(RenderProcessHost* host,
                            const ChildProcessTerminationInfo& info) override {
-    if (host == spare_render_process_host_)
-      CleanupSpareRenderProcessHost();
+    if (IsSpareRenderProcessHost(host))
+      CleanupSpareRenderProcessHost(host);
   }
 
   void RenderProcessHostDestroyed(RenderProcessHost* host) override {
     ReleaseSpareRenderProcessHost(host);
   }
 
-  // This is a bare pointer, because RenderProcessHost manages the lifetime of
-  // all its instances; see g_all_hosts, above.
-  RenderProcessHost* spare_render_process_host_ = nullptr;
+  // Spares in the order they will be taken. They all belong to the same
+  // BrowserContext.
+  std::vector<SpareProcess> spare_render_process_hosts_;
+
+  // How many spares WarmupSpareRenderProcessHost keeps around.
+  size_t target_pool_size_ = 1;
+
+  // Only set when a pool of spares is allowed.
+  std::unique_ptr<base::MemoryPressureListener> memory_pressure_listener_;
 
   DISALLOW_COPY_AND_ASSIGN(SpareRenderProcessHostManager);
 };
@@ -1412,7 +1519,7 @@ size_t RenderProcessHost::GetMaxRendererProcessCount() {
 void RenderProcessHost::SetMaxRendererProcessCount(size_t count) {
   g_max_renderer_count_override = count;
   if (g_all_hosts.Get().size() > count)
-    g_spare_render_process_host_manager.Get().CleanupSpareRenderProcessHost();
+    g_spare_render_process_host_manager.Get().CleanupSpareRenderProcessHosts();
 }
 
 // static
@@ -1422,7 +1529,8 @@ int RenderProcessHost::GetCurrentRenderProcessCountForTesting() {
   while (!it.IsAtEnd()) {
     RenderProcessHost* host = it.GetCurrentValue();
     if (host->IsInitializedAndNotDead() &&
-        host != RenderProcessHostImpl::GetSpareRenderProcessHostForTesting()) {
+        !g_spare_render_process_host_manager.Get().IsSpareRenderProcessHost(
+            host)) {
       count++;
     }
     it.Advance();
@@ -2776,7 +2884,7 @@ RenderProcessHostImpl::GetSpareRenderProcessHostForTesting() {
 
 // static
 void RenderProcessHostImpl::DiscardSpareRenderProcessHostForTesting() {
-  g_spare_render_process_host_manager.Get().CleanupSpareRenderProcessHost();
+  g_spare_render_process_host_manager.Get().CleanupSpareRenderProcessHosts();
 }
 
 // static
@@ -2975,6 +3083,7 @@ void RenderProcessHostImpl::PropagateBrowserCommandLineToRenderer(
     switches::kDomAutomationController,
     switches::kEnableAccessibilityObjectModel,
     switches::kEnableAutomation,
+    switches::kEnableCompressedTileTextures,
     switches::kEnableExperimentalAccessibilityLanguageDetection,
     switches::kEnableExperimentalAccessibilityLabelsDebugging,
     switches::kEnableExperimentalWebPlatformFeatures,
@@ -3842,10 +3951,9 @@ RenderProcessHost* RenderProcessHostImpl::GetExistingProcessHost(
             iter.GetCurrentValue(), site_instance->GetBrowserContext(),
             site_instance->GetIsolationContext(), site_instance->GetSiteURL(),
             site_instance->lock_url())) {
-      // The spare is always considered before process reuse.
-      DCHECK_NE(iter.GetCurrentValue(),
-                g_spare_render_process_host_manager.Get()
-                    .spare_render_process_host());
+      // The spares are always considered before process reuse.
+      DCHECK(!g_spare_render_process_host_manager.Get()
+                  .IsSpareRenderProcessHost(iter.GetCurrentValue()));
 
       suitable_renderers.push_back(iter.GetCurrentValue());
     }
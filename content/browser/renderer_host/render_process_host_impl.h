@@ -452,11 +452,12 @@ class CONTENT_EXPORT RenderProcessHostImpl
       RenderProcessHost* render_process_host,
       const GURL& site_url);
 
-  // Return the spare RenderProcessHost, if it exists. There is at most one
-  // globally-used spare RenderProcessHost at any time.
+  // Return the spare RenderProcessHost to be taken next, if it exists. There
+  // is at most one globally-used spare RenderProcessHost at any time, unless
+  // features::kSpareRendererPool is enabled.
   static RenderProcessHost* GetSpareRenderProcessHostForTesting();
 
-  // Discards the spare RenderProcessHost.  After this call,
+  // Discards the spare RenderProcessHosts.  After this call,
   // GetSpareRenderProcessHostForTesting will return nullptr.
   static void DiscardSpareRenderProcessHostForTesting();
 
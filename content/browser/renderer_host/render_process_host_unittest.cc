@@ -12,12 +12,14 @@
 #include "base/macros.h"
 #include "base/run_loop.h"
 #include "base/test/metrics/histogram_tester.h"
+#include "base/test/scoped_feature_list.h"
 #include "build/build_config.h"
 #include "content/common/frame_messages.h"
 #include "content/common/frame_owner_properties.h"
 #include "content/public/browser/browser_context.h"
 #include "content/public/browser/content_browser_client.h"
 #include "content/public/common/content_constants.h"
+#include "content/public/common/content_features.h"
 #include "content/public/common/content_switches.h"
 #include "content/public/test/mock_render_process_host.h"
 #include "content/public/test/navigation_simulator.h"
@@ -982,6 +984,36 @@ TEST_F(SpareRenderProcessHostUnitTest, TestRendererTaken) {
   }
 }
 
+TEST_F(SpareRenderProcessHostUnitTest, PoolGrowsWhenSparesRunOut) {
+  base::test::ScopedFeatureList feature_list;
+  feature_list.InitAndEnableFeatureWithParameters(
+      features::kSpareRendererPool,
+      {{features::kSpareRendererPoolSizeParamName, "2"}});
+
+  RenderProcessHost::WarmupSpareRenderProcessHost(browser_context());
+  ASSERT_EQ(1U, rph_factory_.GetProcesses()->size());
+  RenderProcessHost* spare_rph =
+      RenderProcessHostImpl::GetSpareRenderProcessHostForTesting();
+
+  base::HistogramTester histograms;
+  SetContents(CreateTestWebContents());
+  NavigateAndCommit(GURL("http://foo.com"));
+  EXPECT_EQ(spare_rph, main_test_rfh()->GetProcess());
+  histograms.ExpectTotalCount(
+      "BrowserRenderProcessHost.SpareProcessWarmupTimeWhenTaken", 1);
+
+  // Taking the only spare makes the pool grow.
+  RenderProcessHost::WarmupSpareRenderProcessHost(browser_context());
+  EXPECT_EQ(3U, rph_factory_.GetProcesses()->size());
+
+  // Discarding unused spares makes it shrink back.
+  RenderProcessHostImpl::DiscardSpareRenderProcessHostForTesting();
+  base::RunLoop().RunUntilIdle();
+  EXPECT_EQ(1U, rph_factory_.GetProcesses()->size());
+  RenderProcessHost::WarmupSpareRenderProcessHost(browser_context());
+  EXPECT_EQ(2U, rph_factory_.GetProcesses()->size());
+}
+
 TEST_F(SpareRenderProcessHostUnitTest, TestRendererNotTaken) {
   std::unique_ptr<BrowserContext> alternate_context(new TestBrowserContext());
   RenderProcessHost::WarmupSpareRenderProcessHost(alternate_context.get());
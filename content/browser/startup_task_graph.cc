@@ -0,0 +1,185 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "content/browser/startup_task_graph.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "base/bind.h"
+#include "base/location.h"
+#include "base/metrics/histogram_macros.h"
+#include "base/sequenced_task_runner.h"
+#include "base/task/post_task.h"
+#include "base/threading/sequenced_task_runner_handle.h"
+#include "base/trace_event/trace_event.h"
+#include "content/public/browser/browser_thread.h"
+
+namespace content {
+
+namespace {
+
+void RunTask(
+    const std::string& name,
+    base::OnceClosure task,
+    scoped_refptr<base::SequencedTaskRunner> reply_task_runner,
+    base::OnceCallback<void(base::TimeTicks, base::TimeTicks)> reply) {
+  TRACE_EVENT1("startup", "StartupTaskGraph::RunTask", "name", name);
+  base::TimeTicks start = base::TimeTicks::Now();
+  std::move(task).Run();
+  reply_task_runner->PostTask(
+      FROM_HERE,
+      base::BindOnce(std::move(reply), start, base::TimeTicks::Now()));
+}
+
+}  // namespace
+
+struct StartupTaskGraph::Task {
+  std::string name;
+  std::vector<std::string> dependency_names;
+  base::TaskTraits traits;
+  base::OnceClosure closure;
+
+  std::vector<Task*> dependents;
+  size_t pending_dependency_count = 0;
+
+  base::TimeTicks ready_time;
+  base::TimeTicks start_time;
+  base::TimeTicks end_time;
+
+  // The dependency that finished last, which made this task ready.
+  Task* critical_dependency = nullptr;
+};
+
+StartupTaskGraph::StartupTaskGraph() : weak_factory_(this) {}
+
+StartupTaskGraph::~StartupTaskGraph() {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+}
+
+void StartupTaskGraph::AddTask(const std::string& name,
+                               std::vector<std::string> dependencies,
+                               const base::TaskTraits& traits,
+                               base::OnceClosure task) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  DCHECK(!started_);
+  DCHECK(!tasks_by_name_.count(name)) << "Duplicate startup task " << name;
+
+  auto new_task = std::make_unique<Task>();
+  new_task->name = name;
+  new_task->dependency_names = std::move(dependencies);
+  new_task->traits = traits;
+  new_task->closure = std::move(task);
+  tasks_by_name_[name] = new_task.get();
+  tasks_.push_back(std::move(new_task));
+}
+
+void StartupTaskGraph::Start(base::OnceClosure done_callback) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  DCHECK(!started_);
+  started_ = true;
+  done_callback_ = std::move(done_callback);
+  start_time_ = base::TimeTicks::Now();
+  pending_task_count_ = tasks_.size();
+
+  for (const auto& task : tasks_) {
+    for (const std::string& dependency_name : task->dependency_names) {
+      auto it = tasks_by_name_.find(dependency_name);
+      CHECK(it != tasks_by_name_.end())
+          << task->name << " depends on unknown startup task "
+          << dependency_name;
+      it->second->dependents.push_back(task.get());
+      ++task->pending_dependency_count;
+    }
+  }
+
+  if (tasks_.empty()) {
+    std::move(done_callback_).Run();
+    return;
+  }
+
+  std::vector<Task*> ready_tasks;
+  for (const auto& task : tasks_) {
+    if (!task->pending_dependency_count)
+      ready_tasks.push_back(task.get());
+  }
+  DCHECK(!ready_tasks.empty()) << "Startup task dependencies form a cycle";
+  for (Task* task : ready_tasks) {
+    task->ready_time = start_time_;
+    PostTask(task);
+  }
+}
+
+std::vector<std::string> StartupTaskGraph::GetCriticalPath() const {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  std::vector<std::string> path;
+  for (Task* task = last_task_; task; task = task->critical_dependency)
+    path.push_back(task->name);
+  std::reverse(path.begin(), path.end());
+  return path;
+}
+
+void StartupTaskGraph::PostTask(Task* task) {
+  base::OnceClosure closure = base::BindOnce(
+      &RunTask, task->name, std::move(task->closure),
+      base::SequencedTaskRunnerHandle::Get(),
+      base::BindOnce(&StartupTaskGraph::OnTaskDone, weak_factory_.GetWeakPtr(),
+                     task));
+
+  if (task->traits.priority() == base::TaskPriority::BEST_EFFORT) {
+    BrowserThread::PostAfterStartupTask(
+        FROM_HERE, base::CreateTaskRunnerWithTraits(task->traits),
+        std::move(closure));
+  } else {
+    base::PostTaskWithTraits(FROM_HERE, task->traits, std::move(closure));
+  }
+}
+
+void StartupTaskGraph::OnTaskDone(Task* task,
+                                  base::TimeTicks start,
+                                  base::TimeTicks end) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  task->start_time = start;
+  task->end_time = end;
+
+  for (Task* dependent : task->dependents) {
+    if (!dependent->critical_dependency ||
+        dependent->critical_dependency->end_time < end) {
+      dependent->critical_dependency = task;
+    }
+    if (--dependent->pending_dependency_count == 0) {
+      dependent->ready_time = end;
+      PostTask(dependent);
+    }
+  }
+
+  if (--pending_task_count_)
+    return;
+
+  last_task_ = task;
+  ReportCriticalPath();
+  std::move(done_callback_).Run();
+}
+
+void StartupTaskGraph::ReportCriticalPath() {
+  // Time spent running the tasks on the critical path, as opposed to waiting
+  // for their thread, e.g. behind other startup work.
+  base::TimeDelta run_time;
+  for (Task* task = last_task_; task; task = task->critical_dependency) {
+    run_time += task->end_time - task->start_time;
+    TRACE_EVENT_ASYNC_BEGIN_WITH_TIMESTAMP1(
+        "startup", "StartupTaskGraph::CriticalPathTask", task,
+        task->ready_time, "name", task->name);
+    TRACE_EVENT_ASYNC_END_WITH_TIMESTAMP0(
+        "startup", "StartupTaskGraph::CriticalPathTask", task, task->end_time);
+  }
+
+  base::TimeDelta duration = last_task_->end_time - start_time_;
+  UMA_HISTOGRAM_MEDIUM_TIMES("Startup.TaskGraph.CriticalPathDuration",
+                             duration);
+  UMA_HISTOGRAM_MEDIUM_TIMES("Startup.TaskGraph.CriticalPathWaitTime",
+                             duration - run_time);
+}
+
+}  // namespace content
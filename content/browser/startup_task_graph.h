@@ -0,0 +1,81 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef CONTENT_BROWSER_STARTUP_TASK_GRAPH_H_
+#define CONTENT_BROWSER_STARTUP_TASK_GRAPH_H_
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base/callback.h"
+#include "base/macros.h"
+#include "base/memory/weak_ptr.h"
+#include "base/sequence_checker.h"
+#include "base/task/task_traits.h"
+#include "base/time/time.h"
+#include "content/common/content_export.h"
+
+namespace content {
+
+// Runs startup tasks as soon as the tasks they depend on have run, rather than
+// in an ad hoc order. Each task has a name, the names of the tasks it depends
+// on, and the TaskTraits it is posted with, which select its thread (e.g.
+// BrowserThread::UI or the ThreadPool) and priority. Tasks with BEST_EFFORT
+// priority are deferred with BrowserThread::PostAfterStartupTask() once ready,
+// so that they don't contend with loading the first page.
+//
+// Once all the tasks have run, the critical path (the chain of dependencies
+// that determined when the last task finished) is emitted as trace events in
+// the "startup" category and recorded in the Startup.TaskGraph.* histograms.
+//
+// The graph must be used on a single sequence; its tasks may run anywhere.
+class CONTENT_EXPORT StartupTaskGraph {
+ public:
+  StartupTaskGraph();
+  ~StartupTaskGraph();
+
+  // Adds a task named |name|, which runs after the tasks named in
+  // |dependencies|. These must all be added before Start().
+  void AddTask(const std::string& name,
+               std::vector<std::string> dependencies,
+               const base::TaskTraits& traits,
+               base::OnceClosure task);
+
+  // Starts posting the tasks. |done_callback| runs on the current sequence once
+  // all the tasks have run.
+  void Start(base::OnceClosure done_callback);
+
+  // Returns the names of the tasks on the critical path, in the order they
+  // ran. Empty until all the tasks have run.
+  std::vector<std::string> GetCriticalPath() const;
+
+ private:
+  struct Task;
+
+  void PostTask(Task* task);
+  void OnTaskDone(Task* task, base::TimeTicks start, base::TimeTicks end);
+  void ReportCriticalPath();
+
+  std::vector<std::unique_ptr<Task>> tasks_;
+  std::map<std::string, Task*> tasks_by_name_;
+  base::OnceClosure done_callback_;
+  base::TimeTicks start_time_;
+  size_t pending_task_count_ = 0;
+  bool started_ = false;
+
+  // The last task to finish, once all the tasks have run.
+  Task* last_task_ = nullptr;
+
+  SEQUENCE_CHECKER(sequence_checker_);
+
+  base::WeakPtrFactory<StartupTaskGraph> weak_factory_;
+
+  DISALLOW_COPY_AND_ASSIGN(StartupTaskGraph);
+};
+
+}  // namespace content
+
+#endif  // CONTENT_BROWSER_STARTUP_TASK_GRAPH_H_
@@ -0,0 +1,88 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "content/browser/startup_task_graph.h"
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "base/bind.h"
+#include "base/run_loop.h"
+#include "base/synchronization/lock.h"
+#include "base/test/metrics/histogram_tester.h"
+#include "content/public/browser/browser_task_traits.h"
+#include "content/public/browser/browser_thread.h"
+#include "content/public/test/test_browser_thread_bundle.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace content {
+
+namespace {
+
+class StartupTaskGraphTest : public testing::Test {
+ protected:
+  base::OnceClosure RecordTask(const std::string& name) {
+    return base::BindOnce(&StartupTaskGraphTest::OnTaskRun,
+                          base::Unretained(this), name);
+  }
+
+  std::vector<std::string> run_tasks() {
+    base::AutoLock lock(lock_);
+    return run_tasks_;
+  }
+
+ private:
+  void OnTaskRun(const std::string& name) {
+    base::AutoLock lock(lock_);
+    run_tasks_.push_back(name);
+  }
+
+  TestBrowserThreadBundle thread_bundle_;
+  base::Lock lock_;
+  std::vector<std::string> run_tasks_;
+};
+
+}  // namespace
+
+TEST_F(StartupTaskGraphTest, RunsTasksAfterDependencies) {
+  base::HistogramTester histograms;
+  StartupTaskGraph graph;
+  graph.AddTask("Last", {"UI", "Pool"}, {BrowserThread::UI},
+                RecordTask("Last"));
+  graph.AddTask("UI", {"First"}, {BrowserThread::UI}, RecordTask("UI"));
+  graph.AddTask("Pool", {"First"}, {base::TaskPriority::USER_VISIBLE},
+                RecordTask("Pool"));
+  graph.AddTask("Deferred", {"First"},
+                {BrowserThread::UI, base::TaskPriority::BEST_EFFORT},
+                RecordTask("Deferred"));
+  graph.AddTask("First", {}, {base::MayBlock()}, RecordTask("First"));
+
+  base::RunLoop run_loop;
+  graph.Start(run_loop.QuitClosure());
+  run_loop.Run();
+
+  std::vector<std::string> tasks = run_tasks();
+  ASSERT_EQ(5u, tasks.size());
+  EXPECT_EQ("First", tasks.front());
+  auto last = std::find(tasks.begin(), tasks.end(), "Last");
+  EXPECT_NE(tasks.end(), std::find(tasks.begin(), last, "UI"));
+  EXPECT_NE(tasks.end(), std::find(tasks.begin(), last, "Pool"));
+
+  std::vector<std::string> critical_path = graph.GetCriticalPath();
+  ASSERT_FALSE(critical_path.empty());
+  EXPECT_EQ("First", critical_path.front());
+  histograms.ExpectTotalCount("Startup.TaskGraph.CriticalPathDuration", 1);
+  histograms.ExpectTotalCount("Startup.TaskGraph.CriticalPathWaitTime", 1);
+}
+
+TEST_F(StartupTaskGraphTest, Empty) {
+  StartupTaskGraph graph;
+  bool done = false;
+  graph.Start(base::BindOnce([](bool* done) { *done = true; }, &done));
+  EXPECT_TRUE(done);
+  EXPECT_TRUE(graph.GetCriticalPath().empty());
+}
+
+}  // namespace content
@@ -174,7 +174,13 @@ class UtilitySandboxedProcessLauncherDelegate
         sandbox_type_ == service_manager::SANDBOX_TYPE_IME ||
 #endif  // OS_CHROMEOS
         sandbox_type_ == service_manager::SANDBOX_TYPE_AUDIO) {
-      return nullptr;
+      // These processes don't use the sandbox, so they can only be forked from
+      // the unsandboxed zygote, if there is one. Zygote forks don't support a
+      // custom environment, so processes that need one are always launched.
+      // Any sandbox policy is still applied by the process itself after fork.
+      if (!env_.empty())
+        return nullptr;
+      return service_manager::GetUnsandboxedZygote();
     }
     return service_manager::GetGenericZygote();
   }
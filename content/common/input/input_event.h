@@ -6,6 +6,7 @@
 #define CONTENT_COMMON_INPUT_INPUT_EVENT_H_
 
 #include <memory>
+#include <vector>
 
 #include "base/macros.h"
 #include "content/common/content_export.h"
@@ -31,6 +32,10 @@ class CONTENT_EXPORT InputEvent {
   ui::WebScopedInputEvent web_event;
   ui::LatencyInfo latency_info;
 
+  // The events that were coalesced into |web_event| by the browser, oldest
+  // first, for getCoalescedEvents(). Empty if it wasn't coalesced.
+  std::vector<ui::WebScopedInputEvent> coalesced_events;
+
  private:
   DISALLOW_COPY_AND_ASSIGN(InputEvent);
 };
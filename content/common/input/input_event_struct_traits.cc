@@ -336,7 +336,20 @@ bool StructTraits<content::mojom::EventDataView, InputEventUniquePtr>::Read(
     return false;
   }
 
-  return event.ReadLatency(&((*out)->latency_info));
+  if (!event.ReadLatency(&((*out)->latency_info)))
+    return false;
+
+  std::vector<InputEventUniquePtr> coalesced_events;
+  if (!event.ReadCoalescedEvents(&coalesced_events))
+    return false;
+  for (InputEventUniquePtr& coalesced_event : coalesced_events) {
+    if (coalesced_event->web_event->GetType() != type ||
+        !coalesced_event->coalesced_events.empty()) {
+      return false;
+    }
+    (*out)->coalesced_events.push_back(std::move(coalesced_event->web_event));
+  }
+  return true;
 }
 
 // static
@@ -511,4 +524,17 @@ StructTraits<content::mojom::EventDataView, InputEventUniquePtr>::touch_data(
   return touch_data;
 }
 
+// static
+std::vector<InputEventUniquePtr> StructTraits<
+    content::mojom::EventDataView,
+    InputEventUniquePtr>::coalesced_events(const InputEventUniquePtr& event) {
+  std::vector<InputEventUniquePtr> coalesced_events;
+  for (const ui::WebScopedInputEvent& coalesced_event :
+       event->coalesced_events) {
+    coalesced_events.push_back(std::make_unique<content::InputEvent>(
+        *coalesced_event, event->latency_info));
+  }
+  return coalesced_events;
+}
+
 }  // namespace mojo
@@ -40,6 +40,8 @@ struct StructTraits<content::mojom::EventDataView, InputEventUniquePtr> {
       const InputEventUniquePtr& event);
   static content::mojom::TouchDataPtr touch_data(
       const InputEventUniquePtr& event);
+  static std::vector<InputEventUniquePtr> coalesced_events(
+      const InputEventUniquePtr& event);
 
   static bool Read(content::mojom::EventDataView r, InputEventUniquePtr* out);
 };
@@ -89,6 +89,13 @@ const base::Feature kBlockCredentialedSubresources{
 const base::Feature kBrotliEncoding{"brotli-encoding",
                                     base::FEATURE_ENABLED_BY_DEFAULT};
 
+// Coalesces mouse and pen moves in the browser while the renderer has yet to
+// ack the previous one, so that high-frequency input is sent to the renderer
+// about once per frame. The coalesced events are still sent along for
+// getCoalescedEvents().
+const base::Feature kBrowserSideInputCoalescing{
+    "BrowserSideInputCoalescing", base::FEATURE_DISABLED_BY_DEFAULT};
+
 // Enables code caching for inline scripts.
 const base::Feature kCacheInlineScriptCode{"CacheInlineScriptCode",
                                            base::FEATURE_ENABLED_BY_DEFAULT};
@@ -167,6 +174,12 @@ const base::Feature kFontSrcLocalMatching{"FontSrcLocalMatching",
 const base::Feature kFreezeFramesOnVisibility{
     "FreezeFramesOnVisibility", base::FEATURE_DISABLED_BY_DEFAULT};
 
+// Purges memory in a renderer once all of its pages are frozen, so that the
+// heaps left behind are as small and dense as possible while the tabs sit in
+// the background.
+const base::Feature kFreezePurgeMemoryAllPagesFrozen{
+    "FreezePurgeMemoryAllPagesFrozen", base::FEATURE_DISABLED_BY_DEFAULT};
+
 // Puts network quality estimate related Web APIs in the holdback mode. When the
 // holdback is enabled the related Web APIs return network quality estimate
 // set by the experiment (regardless of the actual quality).
@@ -462,6 +475,14 @@ const base::Feature kSignedExchangeSubresourcePrefetch{
 const base::Feature kSignedHTTPExchange{"SignedHTTPExchange",
                                         base::FEATURE_ENABLED_BY_DEFAULT};
 
+// Lets SpareRenderProcessHostManager keep a pool of spare renderer processes
+// rather than a single one, for BrowserContexts that open many new site
+// processes in a row. The pool grows up to the "pool_size" param while spares
+// keep running out, and shrinks when spares go unused or under memory pressure.
+const base::Feature kSpareRendererPool{"SpareRendererPool",
+                                       base::FEATURE_DISABLED_BY_DEFAULT};
+const char kSpareRendererPoolSizeParamName[] = "pool_size";
+
 // Controls whether SpareRenderProcessHostManager tries to always have a warm
 // spare renderer process around for the most recently requested BrowserContext.
 // This feature is only consulted in site-per-process mode.
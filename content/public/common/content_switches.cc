@@ -398,6 +398,9 @@ const char kEnablePrintBrowser[] = "enable-print-browser";
 // Enables RGBA_4444 textures.
 const char kEnableRGBA4444Textures[] = "enable-rgba-4444-textures";
 
+// Enables compressing opaque tiles into ETC1 textures, to save memory.
+const char kEnableCompressedTileTextures[] = "enable-compressed-tile-textures";
+
 // Set options to cache V8 data. (off, preparse data, or code)
 const char kV8CacheOptions[] = "v8-cache-options";
 
@@ -441,6 +444,11 @@ const char kEnableUserMediaScreenCapturing[] =
 // Enable the mode that uses zooming to implment device scale factor behavior.
 const char kEnableUseZoomForDSF[]            = "enable-use-zoom-for-dsf";
 
+// On Linux, forks utility processes that run unsandboxed (e.g. the network and
+// audio services) from a dedicated zygote rather than launching them with a
+// full exec.
+const char kEnableUtilityZygote[]           = "enable-utility-zygote";
+
 // Enables the use of the @viewport CSS rule, which allows
 // pages to control aspects of their own layout. This also turns on touch-screen
 // pinch gestures.
@@ -54,7 +54,23 @@ class QueuedWebInputEvent : public ScopedWebInputEventWithLatencyInfo,
                       bool originally_cancelable,
                       HandledEventCallback callback,
                       bool known_by_scheduler)
-      : ScopedWebInputEventWithLatencyInfo(std::move(event), latency),
+      : QueuedWebInputEvent(std::move(event),
+                            std::vector<ui::WebScopedInputEvent>(),
+                            latency,
+                            originally_cancelable,
+                            std::move(callback),
+                            known_by_scheduler) {}
+
+  QueuedWebInputEvent(
+      ui::WebScopedInputEvent event,
+      const std::vector<ui::WebScopedInputEvent>& coalesced_events,
+      const ui::LatencyInfo& latency,
+      bool originally_cancelable,
+      HandledEventCallback callback,
+      bool known_by_scheduler)
+      : ScopedWebInputEventWithLatencyInfo(std::move(event),
+                                           coalesced_events,
+                                           latency),
         non_blocking_coalesced_count_(0),
         creation_timestamp_(base::TimeTicks::Now()),
         last_coalesced_timestamp_(creation_timestamp_),
@@ -253,6 +269,7 @@ MainThreadEventQueue::~MainThreadEventQueue() {}
 
 void MainThreadEventQueue::HandleEvent(
     ui::WebScopedInputEvent event,
+    std::vector<ui::WebScopedInputEvent> coalesced_events,
     const ui::LatencyInfo& latency,
     InputEventDispatchType original_dispatch_type,
     InputEventAckState ack_result,
@@ -325,14 +342,22 @@ void MainThreadEventQueue::HandleEvent(
 
   if (has_pointerrawmove_handlers_) {
     if (event->GetType() == WebInputEvent::kMouseMove) {
-      ui::WebScopedInputEvent raw_event(new blink::WebPointerEvent(
-          WebInputEvent::kPointerRawMove,
-          *(static_cast<blink::WebMouseEvent*>(event.get()))));
-      std::unique_ptr<QueuedWebInputEvent> raw_queued_event(
-          new QueuedWebInputEvent(std::move(raw_event), latency, false,
-                                  HandledEventCallback(), false));
-
-      QueueEvent(std::move(raw_queued_event));
+      // Dispatch a pointerrawmove for each of the moves the browser coalesced.
+      std::vector<const WebInputEvent*> mouse_events;
+      for (const ui::WebScopedInputEvent& coalesced_event : coalesced_events)
+        mouse_events.push_back(coalesced_event.get());
+      if (mouse_events.empty())
+        mouse_events.push_back(event.get());
+      for (const WebInputEvent* mouse_event : mouse_events) {
+        ui::WebScopedInputEvent raw_event(new blink::WebPointerEvent(
+            WebInputEvent::kPointerRawMove,
+            *static_cast<const blink::WebMouseEvent*>(mouse_event)));
+        std::unique_ptr<QueuedWebInputEvent> raw_queued_event(
+            new QueuedWebInputEvent(std::move(raw_event), latency, false,
+                                    HandledEventCallback(), false));
+
+        QueueEvent(std::move(raw_queued_event));
+      }
     } else if (event->GetType() == WebInputEvent::kTouchMove) {
       const blink::WebTouchEvent& touch_event =
           *static_cast<const blink::WebTouchEvent*>(event.get());
@@ -352,7 +377,7 @@ void MainThreadEventQueue::HandleEvent(
   }
 
   std::unique_ptr<QueuedWebInputEvent> queued_event(new QueuedWebInputEvent(
-      std::move(event), latency, originally_cancelable,
+      std::move(event), coalesced_events, latency, originally_cancelable,
       std::move(event_callback), IsForwardedAndSchedulerKnown(ack_result)));
 
   QueueEvent(std::move(queued_event));
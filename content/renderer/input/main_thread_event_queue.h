@@ -5,6 +5,8 @@
 #ifndef CONTENT_RENDERER_INPUT_MAIN_THREAD_EVENT_QUEUE_H_
 #define CONTENT_RENDERER_INPUT_MAIN_THREAD_EVENT_QUEUE_H_
 
+#include <vector>
+
 #include "base/feature_list.h"
 #include "base/memory/weak_ptr.h"
 #include "base/single_thread_task_runner.h"
@@ -91,8 +93,10 @@ class CONTENT_EXPORT MainThreadEventQueue
       bool allow_raf_aligned_input);
 
   // Called once the compositor has handled |event| and indicated that it is
-  // a non-blocking event to be queued to the main thread.
+  // a non-blocking event to be queued to the main thread. |coalesced_events|
+  // are the events the browser coalesced into |event|, if any.
   void HandleEvent(ui::WebScopedInputEvent event,
+                   std::vector<ui::WebScopedInputEvent> coalesced_events,
                    const ui::LatencyInfo& latency,
                    InputEventDispatchType dispatch_type,
                    InputEventAckState ack_result,
@@ -14,6 +14,22 @@ ScopedWebInputEventWithLatencyInfo::ScopedWebInputEventWithLatencyInfo(
     : event_(new blink::WebCoalescedInputEvent(*(event.get()))),
       latency_(latency_info) {}
 
+ScopedWebInputEventWithLatencyInfo::ScopedWebInputEventWithLatencyInfo(
+    ui::WebScopedInputEvent event,
+    const std::vector<ui::WebScopedInputEvent>& coalesced_events,
+    const ui::LatencyInfo& latency_info)
+    : latency_(latency_info) {
+  if (coalesced_events.empty()) {
+    event_.reset(new blink::WebCoalescedInputEvent(*event));
+    return;
+  }
+  std::vector<const WebInputEvent*> coalesced_event_pointers;
+  for (const ui::WebScopedInputEvent& coalesced_event : coalesced_events)
+    coalesced_event_pointers.push_back(coalesced_event.get());
+  event_.reset(new blink::WebCoalescedInputEvent(
+      *event, coalesced_event_pointers, std::vector<const WebInputEvent*>()));
+}
+
 ScopedWebInputEventWithLatencyInfo::~ScopedWebInputEventWithLatencyInfo() {}
 
 bool ScopedWebInputEventWithLatencyInfo::CanCoalesceWith(
@@ -32,7 +48,9 @@ void ScopedWebInputEventWithLatencyInfo::CoalesceWith(
   const base::TimeTicks time_stamp = other.event().TimeStamp();
   ui::Coalesce(other.event(), event_->EventPointer());
   event_->EventPointer()->SetTimeStamp(time_stamp);
-  event_->AddCoalescedEvent(other.event());
+  // Keep any events the browser coalesced into |other| too.
+  for (size_t i = 0; i < other.coalesced_event().CoalescedEventSize(); ++i)
+    event_->AddCoalescedEvent(other.coalesced_event().CoalescedEvent(i));
 
   // When coalescing two input events, we keep the oldest LatencyInfo
   // since it will represent the longest latency. If it's a GestureScrollUpdate
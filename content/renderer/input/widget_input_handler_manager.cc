@@ -11,6 +11,7 @@
 #include "content/common/input_messages.h"
 #include "content/renderer/compositor/layer_tree_view.h"
 #include "content/renderer/ime_event_guard.h"
+#include "content/renderer/input/scoped_web_input_event_with_latency_info.h"
 #include "content/renderer/input/widget_input_handler_impl.h"
 #include "content/renderer/render_thread_impl.h"
 #include "content/renderer/render_widget.h"
@@ -221,8 +222,9 @@ void WidgetInputHandlerManager::DispatchNonBlockingEventToMainThread(
     const ui::LatencyInfo& latency_info) {
   DCHECK(input_event_queue_);
   input_event_queue_->HandleEvent(
-      std::move(event), latency_info, DISPATCH_TYPE_NON_BLOCKING,
-      INPUT_EVENT_ACK_STATE_SET_NON_BLOCKING, HandledEventCallback());
+      std::move(event), std::vector<ui::WebScopedInputEvent>(), latency_info,
+      DISPATCH_TYPE_NON_BLOCKING, INPUT_EVENT_ACK_STATE_SET_NON_BLOCKING,
+      HandledEventCallback());
 }
 
 void WidgetInputHandlerManager::DidOverscroll(
@@ -359,10 +361,10 @@ void WidgetInputHandlerManager::DispatchEvent(
         std::move(event->web_event), event->latency_info,
         base::BindOnce(
             &WidgetInputHandlerManager::DidHandleInputEventAndOverscroll, this,
-            std::move(callback)));
+            std::move(callback), std::move(event->coalesced_events)));
   } else {
-    HandleInputEvent(std::move(event->web_event), event->latency_info,
-                     std::move(callback));
+    HandleInputEvent(std::move(event->web_event), event->coalesced_events,
+                     event->latency_info, std::move(callback));
   }
 }
 
@@ -503,6 +505,7 @@ void WidgetInputHandlerManager::BindChannel(
 
 void WidgetInputHandlerManager::HandleInputEvent(
     const ui::WebScopedInputEvent& event,
+    const std::vector<ui::WebScopedInputEvent>& coalesced_events,
     const ui::LatencyInfo& latency,
     mojom::WidgetInputHandler::DispatchEventCallback callback) {
   if (!render_widget_ || render_widget_->is_frozen() ||
@@ -517,13 +520,15 @@ void WidgetInputHandlerManager::HandleInputEvent(
   auto send_callback = base::BindOnce(
       &WidgetInputHandlerManager::HandledInputEvent, this, std::move(callback));
 
-  blink::WebCoalescedInputEvent coalesced_event(*event);
-  render_widget_->HandleInputEvent(coalesced_event, latency,
-                                   std::move(send_callback));
+  ScopedWebInputEventWithLatencyInfo event_with_latency(
+      ui::WebInputEventTraits::Clone(*event), coalesced_events, latency);
+  render_widget_->HandleInputEvent(event_with_latency.coalesced_event(),
+                                   latency, std::move(send_callback));
 }
 
 void WidgetInputHandlerManager::DidHandleInputEventAndOverscroll(
     mojom::WidgetInputHandler::DispatchEventCallback callback,
+    std::vector<ui::WebScopedInputEvent> coalesced_events,
     ui::InputHandlerProxy::EventDisposition event_disposition,
     ui::WebScopedInputEvent input_event,
     const ui::LatencyInfo& latency_info,
@@ -550,9 +555,9 @@ void WidgetInputHandlerManager::DidHandleInputEventAndOverscroll(
     HandledEventCallback handled_event =
         base::BindOnce(&WidgetInputHandlerManager::HandledInputEvent, this,
                        std::move(callback));
-    input_event_queue_->HandleEvent(std::move(input_event), latency_info,
-                                    dispatch_type, ack_state,
-                                    std::move(handled_event));
+    input_event_queue_->HandleEvent(
+        std::move(input_event), std::move(coalesced_events), latency_info,
+        dispatch_type, ack_state, std::move(handled_event));
     return;
   }
   if (callback) {
@@ -5,6 +5,8 @@
 #ifndef CONTENT_RENDERER_INPUT_WIDGET_INPUT_HANDLER_MANAGER_H_
 #define CONTENT_RENDERER_INPUT_WIDGET_INPUT_HANDLER_MANAGER_H_
 
+#include <vector>
+
 #include "base/single_thread_task_runner.h"
 #include "build/build_config.h"
 #include "content/common/content_export.h"
@@ -117,10 +119,12 @@ class CONTENT_EXPORT WidgetInputHandlerManager final
   void BindChannel(mojom::WidgetInputHandlerRequest request);
   void HandleInputEvent(
       const ui::WebScopedInputEvent& event,
+      const std::vector<ui::WebScopedInputEvent>& coalesced_events,
       const ui::LatencyInfo& latency,
       mojom::WidgetInputHandler::DispatchEventCallback callback);
   void DidHandleInputEventAndOverscroll(
       mojom::WidgetInputHandler::DispatchEventCallback callback,
+      std::vector<ui::WebScopedInputEvent> coalesced_events,
       ui::InputHandlerProxy::EventDisposition event_disposition,
       ui::WebScopedInputEvent input_event,
       const ui::LatencyInfo& latency_info,
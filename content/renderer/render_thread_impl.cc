@@ -522,6 +522,22 @@ void CreateResourceUsageReporter(base::WeakPtr<RenderThread> thread,
                           std::move(request));
 }
 
+// Checks whether the pages of all the RenderViews are frozen.
+class AllPagesFrozenVisitor : public RenderViewVisitor {
+ public:
+  bool Visit(RenderView* render_view) override {
+    if (static_cast<RenderViewImpl*>(render_view)->is_page_frozen())
+      return true;
+    all_pages_frozen_ = false;
+    return false;
+  }
+
+  bool all_pages_frozen() const { return all_pages_frozen_; }
+
+ private:
+  bool all_pages_frozen_ = true;
+};
+
 }  // namespace
 
 RenderThreadImpl::HistogramCustomizer::HistogramCustomizer() {
@@ -2218,6 +2234,61 @@ void RenderThreadImpl::OnMemoryPressure(
     ReleaseFreeMemory();
 }
 
+void RenderThreadImpl::OnPageFrozen() {
+  if (!base::FeatureList::IsEnabled(
+          features::kFreezePurgeMemoryAllPagesFrozen)) {
+    return;
+  }
+
+  // Nothing was allocated since the last purge if no page unfroze since.
+  if (purged_all_pages_frozen_)
+    return;
+
+  AllPagesFrozenVisitor visitor;
+  RenderView::ForEach(&visitor);
+  if (!visitor.all_pages_frozen())
+    return;
+
+  TRACE_EVENT0("memory", "RenderThreadImpl::OnPageFrozen");
+  // Nothing runs in frozen pages, so this is a good time for a full purge:
+  // the critical pressure signal has V8 collect garbage and Blink drop its
+  // caches, and ReleaseFreeMemory() returns the freed pages to the system.
+  RendererMemoryMetrics before;
+  bool has_metrics = GetRendererMemoryMetrics(&before);
+  OnMemoryPressure(
+      base::MemoryPressureListener::MEMORY_PRESSURE_LEVEL_CRITICAL);
+  purged_all_pages_frozen_ = true;
+  RendererMemoryMetrics after;
+  if (!has_metrics || !GetRendererMemoryMetrics(&after))
+    return;
+
+  // Recorded apart from Memory.Experimental.Renderer.PurgedMemory, which
+  // covers purge-and-suspend.
+  int64_t mbytes = static_cast<int64_t>(before.total_allocated_mb) -
+                   static_cast<int64_t>(after.total_allocated_mb);
+  UMA_HISTOGRAM_MEMORY_LARGE_MB(
+      "Memory.Experimental.Renderer.AllPagesFrozenPurge.PurgedMemory",
+      std::max<int64_t>(mbytes, 0));
+  if (before.total_allocated_mb) {
+    UMA_HISTOGRAM_PERCENTAGE(
+        "Memory.Experimental.Renderer.AllPagesFrozenPurge.RemainingPercent",
+        std::min<size_t>(
+            100, after.total_allocated_mb * 100 / before.total_allocated_mb));
+  }
+}
+
+void RenderThreadImpl::OnPageUnfrozen() {
+  EndAllPagesFrozenPurge();
+}
+
+void RenderThreadImpl::EndAllPagesFrozenPurge() {
+  if (!purged_all_pages_frozen_)
+    return;
+  // The first paint after the pages thaw shows the cost of the purge.
+  purged_all_pages_frozen_ = false;
+  needs_to_record_first_active_paint_after_frozen_purge_ = true;
+}
+
 void RenderThreadImpl::RecordPurgeMemory(RendererMemoryMetrics before) {
   RendererMemoryMetrics after;
   if (!GetRendererMemoryMetrics(&after))
@@ -2358,6 +2429,8 @@ bool RenderThreadImpl::RendererIsBackgrounded() const {
 void RenderThreadImpl::OnRendererBackgrounded() {
   main_thread_scheduler_->SetRendererBackgrounded(true);
   needs_to_record_first_active_paint_ = false;
+  purged_all_pages_frozen_ = false;
+  needs_to_record_first_active_paint_after_frozen_purge_ = false;
   GetWebMainThreadScheduler()->DefaultTaskRunner()->PostDelayedTask(
       FROM_HERE,
       base::BindOnce(&RenderThreadImpl::RecordMemoryUsageAfterBackgrounded,
@@ -2382,6 +2455,7 @@ void RenderThreadImpl::OnRendererBackgrounded() {
 void RenderThreadImpl::OnRendererForegrounded() {
   main_thread_scheduler_->SetRendererBackgrounded(false);
   process_foregrounded_count_++;
+  EndAllPagesFrozenPurge();
 }
 
 void RenderThreadImpl::ReleaseFreeMemory() {
@@ -2446,6 +2520,8 @@ bool RenderThreadImpl::NeedsToRecordFirstActivePaint(
     int ttfap_metric_type) const {
   if (ttfap_metric_type == RenderWidget::TTFAP_AFTER_PURGED)
     return needs_to_record_first_active_paint_;
+  if (ttfap_metric_type == RenderWidget::TTFAP_AFTER_ALL_PAGES_FROZEN_PURGE)
+    return needs_to_record_first_active_paint_after_frozen_purge_;
 
   if (was_backgrounded_time_.is_min())
     return false;
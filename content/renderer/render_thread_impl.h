@@ -455,6 +455,13 @@ class CONTENT_EXPORT RenderThreadImpl
 
   bool NeedsToRecordFirstActivePaint(int metric_type) const;
 
+  // Called when one of the RenderViews' pages was frozen. Purges memory once
+  // all of them are frozen, behind features::kFreezePurgeMemoryAllPagesFrozen.
+  void OnPageFrozen();
+
+  // Called when one of the RenderViews' pages was unfrozen.
+  void OnPageUnfrozen();
+
   void RecordMetricsForBackgroundedRendererPurge();
 
   // Sets the current pipeline rendering color space.
@@ -541,6 +548,9 @@ class CONTENT_EXPORT RenderThreadImpl
   void OnRendererBackgrounded();
   void OnRendererForegrounded();
 
+  // Ends the state left by an all-pages-frozen purge once a page thaws.
+  void EndAllPagesFrozenPurge();
+
   void RecordMemoryUsageAfterBackgrounded(const char* suffix,
                                           int foregrounded_count);
   void OnRecordMetricsForBackgroundedRendererPurgeTimerExpired(
@@ -713,6 +723,12 @@ class CONTENT_EXPORT RenderThreadImpl
 
   RendererMemoryMetrics purge_and_suspend_memory_metrics_;
   bool needs_to_record_first_active_paint_;
+  // Whether memory was purged because all pages were frozen, and none of them
+  // has been unfrozen nor the renderer foregrounded since.
+  bool purged_all_pages_frozen_ = false;
+  // Whether pages thawed after such a purge since the renderer was last
+  // backgrounded.
+  bool needs_to_record_first_active_paint_after_frozen_purge_ = false;
   base::TimeTicks was_backgrounded_time_;
   int process_foregrounded_count_;
   bool online_status_ = true;
@@ -21,6 +21,8 @@
 #include "base/run_loop.h"
 #include "base/single_thread_task_runner.h"
 #include "base/strings/string_number_conversions.h"
+#include "base/test/metrics/histogram_tester.h"
+#include "base/test/scoped_feature_list.h"
 #include "base/task/post_task.h"
 #include "base/task/thread_pool/thread_pool.h"
 #include "base/threading/sequenced_task_runner_handle.h"
@@ -44,6 +46,7 @@
 #include "content/public/test/test_launcher.h"
 #include "content/public/test/test_service_manager_context.h"
 #include "content/renderer/render_process_impl.h"
+#include "content/renderer/render_widget.h"
 #include "content/test/mock_render_process.h"
 #include "gpu/GLES2/gl2extchromium.h"
 #include "gpu/command_buffer/client/gpu_memory_buffer_manager.h"
@@ -424,6 +427,54 @@ TEST_F(RenderThreadImplBrowserTest, RendererStateTransitionBackgrounded) {
   testing::Mock::AllowLeak(main_thread_scheduler_);
 }
 
+TEST_F(RenderThreadImplBrowserTest, PurgeMemoryWhenAllPagesFrozen) {
+  base::test::ScopedFeatureList feature_list;
+  feature_list.InitAndEnableFeature(
+      features::kFreezePurgeMemoryAllPagesFrozen);
+  base::HistogramTester histograms;
+  SetProcessState(mojom::RenderProcessState::kBackgrounded);
+
+  // There are no RenderViews, so all pages are frozen.
+  thread_->OnPageFrozen();
+  EXPECT_FALSE(thread_->NeedsToRecordFirstActivePaint(
+      RenderWidget::TTFAP_AFTER_ALL_PAGES_FROZEN_PURGE));
+
+  // The first paint after a page unfreezes is recorded.
+  thread_->OnPageUnfrozen();
+  EXPECT_TRUE(thread_->NeedsToRecordFirstActivePaint(
+      RenderWidget::TTFAP_AFTER_ALL_PAGES_FROZEN_PURGE));
+
+  // Until the renderer is backgrounded again.
+  SetProcessState(mojom::RenderProcessState::kBackgrounded);
+  EXPECT_FALSE(thread_->NeedsToRecordFirstActivePaint(
+      RenderWidget::TTFAP_AFTER_ALL_PAGES_FROZEN_PURGE));
+
+  // Foregrounding the renderer ends the purge too.
+  thread_->OnPageFrozen();
+  SetProcessState(mojom::RenderProcessState::kVisible);
+  EXPECT_TRUE(thread_->NeedsToRecordFirstActivePaint(
+      RenderWidget::TTFAP_AFTER_ALL_PAGES_FROZEN_PURGE));
+
+  // The purge-and-suspend histogram isn't mixed with this purge.
+  histograms.ExpectTotalCount("Memory.Experimental.Renderer.PurgedMemory", 0);
+
+  testing::Mock::AllowLeak(main_thread_scheduler_);
+}
+
+TEST_F(RenderThreadImplBrowserTest, NoPurgeWhenAllPagesFrozenIsDisabled) {
+  base::test::ScopedFeatureList feature_list;
+  feature_list.InitAndDisableFeature(
+      features::kFreezePurgeMemoryAllPagesFrozen);
+  SetProcessState(mojom::RenderProcessState::kBackgrounded);
+
+  thread_->OnPageFrozen();
+  thread_->OnPageUnfrozen();
+  EXPECT_FALSE(thread_->NeedsToRecordFirstActivePaint(
+      RenderWidget::TTFAP_AFTER_ALL_PAGES_FROZEN_PURGE));
+
+  testing::Mock::AllowLeak(main_thread_scheduler_);
+}
+
 enum NativeBufferFlag { kDisableNativeBuffers, kEnableNativeBuffers };
 
 class RenderThreadImplGpuMemoryBufferBrowserTest
@@ -2070,6 +2070,17 @@ void RenderViewImpl::OnUpdateScreenInfo(const ScreenInfo& screen_info) {
 void RenderViewImpl::SetPageFrozen(bool frozen) {
   if (webview())
     webview()->SetPageFrozen(frozen);
+
+  if (frozen == page_frozen_)
+    return;
+  page_frozen_ = frozen;
+  RenderThreadImpl* render_thread = RenderThreadImpl::current();
+  if (!render_thread)
+    return;
+  if (frozen)
+    render_thread->OnPageFrozen();
+  else
+    render_thread->OnPageUnfrozen();
 }
 
 void RenderViewImpl::SetFocus(bool enable) {
@@ -158,6 +158,8 @@ class CONTENT_EXPORT RenderViewImpl : public blink::WebViewClient,
     send_content_state_immediately_ = value;
   }
 
+  bool is_page_frozen() const { return page_frozen_; }
+
   // Functions to add and remove observers for this object.
   void AddObserver(RenderViewObserver* observer);
   void RemoveObserver(RenderViewObserver* observer);
@@ -573,6 +575,9 @@ class CONTENT_EXPORT RenderViewImpl : public blink::WebViewClient,
   // to be called.
   bool needs_preferred_size_update_ = true;
 
+  // Whether the page was frozen with PageMsg_SetPageFrozen.
+  bool page_frozen_ = false;
+
   // Loading state -------------------------------------------------------------
 
   // Timer used to delay the updating of nav state (see
@@ -1320,6 +1320,13 @@ void RenderWidget::RecordTimeToFirstActivePaint() {
         "AfterBackgrounded.5min",
         sample);
   }
+  if (render_thread_impl->NeedsToRecordFirstActivePaint(
+          TTFAP_AFTER_ALL_PAGES_FROZEN_PURGE)) {
+    UMA_HISTOGRAM_TIMES(
+        "Memory.Experimental.Renderer.TimeToFirstActivePaint."
+        "AfterAllPagesFrozenPurge",
+        sample);
+  }
 }
 
 void RenderWidget::RecordStartOfFrameMetrics() {
@@ -3113,6 +3120,9 @@ cc::LayerTreeSettings RenderWidget::GenerateLayerTreeSettings(
     settings.use_rgba_4444 = true;
   }
 
+  if (cmd.HasSwitch(switches::kEnableCompressedTileTextures))
+    settings.use_compressed_tile_resources = true;
+
   settings.max_staging_buffer_usage_in_bytes = 32 * 1024 * 1024;  // 32MB
   // Use 1/4th of staging buffers on low-end devices.
   if (base::SysInfo::IsLowEndDevice())
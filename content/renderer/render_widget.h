@@ -160,6 +160,7 @@ class CONTENT_EXPORT RenderWidget
   enum {
     TTFAP_AFTER_PURGED,
     TTFAP_5MIN_AFTER_BACKGROUNDED,
+    TTFAP_AFTER_ALL_PAGES_FROZEN_PURGE,
   };
 
   // Convenience type for creation method taken by InstallCreateForFrameHook().
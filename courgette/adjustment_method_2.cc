@@ -8,11 +8,13 @@
 #include <stdint.h>
 
 #include <algorithm>
+#include <deque>
 #include <limits>
 #include <list>
 #include <map>
 #include <set>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "base/format_macros.h"
@@ -167,7 +169,7 @@ class ShinglePattern;
 class LabelInfo {
  public:
   // Just a no-argument constructor and copy constructor.  Actual LabelInfo
-  // objects are allocated in std::pair structs in a std::map.
+  // objects are allocated in bulk in a std::deque owned by LabelInfoMaker.
   LabelInfo()
       : label_(nullptr),
         is_model_(false),
@@ -197,9 +199,7 @@ class LabelInfo {
   AssignmentCandidates* candidates_;
 
   void operator=(const LabelInfo*);  // Disallow assignment only.
-  // Public compiler generated copy constructor is needed to constuct
-  // std::pair<Label*, LabelInfo> so that fresh LabelInfos can be allocated
-  // inside a std::map.
+  // Public compiler generated copy constructor is needed by std::deque.
 };
 
 typedef std::vector<LabelInfo*> Trace;
@@ -220,15 +220,17 @@ class LabelInfoMaker {
   LabelInfoMaker() : debug_label_index_gen_(0) {}
 
   LabelInfo* MakeLabelInfo(Label* label, bool is_model, uint32_t position) {
-    LabelInfo& slot = label_infos_[label];
-    if (slot.label_ == nullptr) {
-      slot.label_ = label;
-      slot.is_model_ = is_model;
-      slot.debug_index_ = ++debug_label_index_gen_;
+    LabelInfo*& slot = label_infos_[label];
+    if (slot == nullptr) {
+      label_info_arena_.emplace_back();
+      slot = &label_info_arena_.back();
+      slot->label_ = label;
+      slot->is_model_ = is_model;
+      slot->debug_index_ = ++debug_label_index_gen_;
     }
-    slot.positions_.push_back(position);
-    ++slot.refs_;
-    return &slot;
+    slot->positions_.push_back(position);
+    ++slot->refs_;
+    return slot;
   }
 
   void ResetDebugLabel() { debug_label_index_gen_ = 0; }
@@ -236,9 +238,11 @@ class LabelInfoMaker {
  private:
   int debug_label_index_gen_;
 
-  // Note LabelInfo is allocated 'flat' inside map::value_type, so the LabelInfo
-  // lifetimes are managed by the map.
-  std::map<Label*, LabelInfo> label_infos_;
+  // LabelInfo instances are allocated in chunks by |label_info_arena_|, which
+  // manages their lifetimes and never moves them. |label_infos_| only does the
+  // lookup, avoiding a tree node allocation per Label.
+  std::deque<LabelInfo> label_info_arena_;
+  std::unordered_map<Label*, LabelInfo*> label_infos_;
 
   DISALLOW_COPY_AND_ASSIGN(LabelInfoMaker);
 };
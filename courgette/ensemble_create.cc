@@ -16,10 +16,15 @@
 
 #include <stddef.h>
 
+#include <algorithm>
 #include <limits>
+#include <memory>
 #include <vector>
 
 #include "base/logging.h"
+#include "base/macros.h"
+#include "base/system/sys_info.h"
+#include "base/threading/simple_thread.h"
 #include "base/time/time.h"
 
 #include "courgette/crc.h"
@@ -231,6 +236,62 @@ Status FindGenerators(Ensemble* old_ensemble, Ensemble* new_ensemble,
   return C_OK;
 }
 
+// Transforms one element, possibly on a worker thread of a
+// base::DelegateSimpleThreadPool.
+class TransformTask : public base::DelegateSimpleThread::Delegate {
+ public:
+  explicit TransformTask(TransformationPatchGenerator* generator)
+      : generator_(generator), status_(C_GENERAL_ERROR) {}
+  ~TransformTask() override = default;
+
+  // base::DelegateSimpleThread::Delegate:
+  void Run() override {
+    status_ = generator_->Transform(&parameters_,
+                                    &predicted_transformed_element_,
+                                    &corrected_transformed_element_);
+  }
+
+  SourceStreamSet* parameters() { return &parameters_; }
+  SinkStreamSet* predicted_transformed_element() {
+    return &predicted_transformed_element_;
+  }
+  SinkStreamSet* corrected_transformed_element() {
+    return &corrected_transformed_element_;
+  }
+  Status status() const { return status_; }
+
+ private:
+  TransformationPatchGenerator* generator_;  // Owned by caller.
+  SourceStreamSet parameters_;
+  SinkStreamSet predicted_transformed_element_;
+  SinkStreamSet corrected_transformed_element_;
+  Status status_;
+
+  DISALLOW_COPY_AND_ASSIGN(TransformTask);
+};
+
+// Runs all |tasks|, on up to kMaxTransformThreads threads, and returns once
+// they are done. Each transformation holds two disassembled programs, so the
+// number of threads is capped to bound peak memory.
+void RunTransformTasks(
+    const std::vector<std::unique_ptr<TransformTask>>& tasks) {
+  const int kMaxTransformThreads = 4;
+  int num_threads =
+      std::min({base::SysInfo::NumberOfProcessors(), kMaxTransformThreads,
+                static_cast<int>(tasks.size())});
+  if (num_threads <= 1) {
+    for (const auto& task : tasks)
+      task->Run();
+    return;
+  }
+
+  base::DelegateSimpleThreadPool pool("CourgetteTransform", num_threads);
+  for (const auto& task : tasks)
+    pool.AddWork(task.get());
+  pool.Start();
+  pool.JoinAll();
+}
+
 void FreeGenerators(std::vector<TransformationPatchGenerator*>* generators) {
   for (size_t i = 0;  i < generators->size();  ++i) {
     delete (*generators)[i];
@@ -335,31 +396,42 @@ Status GenerateEnsemblePatch(SourceStream* base,
   SinkStreamSet predicted_transformed_elements;
   SinkStreamSet corrected_transformed_elements;
 
+  // Transforming an element (disassembly, label adjustment and encoding) only
+  // reads the old and new elements, so elements are transformed in parallel.
+  // The results are then gathered in order, so the patch doesn't depend on
+  // scheduling.
+  std::vector<std::unique_ptr<TransformTask>> transform_tasks;
   for (size_t i = 0;  i < number_of_transformations;  ++i) {
-    SourceStreamSet single_parameters;
-    if (!corrected_parameters_source_set.ReadSet(&single_parameters))
+    transform_tasks.push_back(std::make_unique<TransformTask>(generators[i]));
+    if (!corrected_parameters_source_set.ReadSet(
+            transform_tasks.back()->parameters())) {
       return C_STREAM_ERROR;
-    SinkStreamSet single_predicted_transformed_element;
-    SinkStreamSet single_corrected_transformed_element;
-    Status status = generators[i]->Transform(
-        &single_parameters,
-        &single_predicted_transformed_element,
-        &single_corrected_transformed_element);
-    if (status != C_OK)
-      return status;
-    if (!single_parameters.Empty())
+    }
+  }
+
+  if (!corrected_parameters_source_set.Empty())
+    return C_STREAM_NOT_CONSUMED;
+
+  base::Time start_transform_time = base::Time::Now();
+  RunTransformTasks(transform_tasks);
+  VLOG(1) << "done Transform "
+          << (base::Time::Now() - start_transform_time).InSecondsF() << "s";
+
+  for (auto& task : transform_tasks) {
+    if (task->status() != C_OK)
+      return task->status();
+    if (!task->parameters()->Empty())
       return C_STREAM_NOT_CONSUMED;
     if (!predicted_transformed_elements.WriteSet(
-            &single_predicted_transformed_element))
+            task->predicted_transformed_element()))
       return C_STREAM_ERROR;
     if (!corrected_transformed_elements.WriteSet(
-            &single_corrected_transformed_element))
+            task->corrected_transformed_element()))
       return C_STREAM_ERROR;
+    // Free storage as soon as the results are copied.
+    task.reset();
   }
 
-  if (!corrected_parameters_source_set.Empty())
-    return C_STREAM_NOT_CONSUMED;
-
   SinkStream linearized_predicted_transformed_elements;
   SinkStream linearized_corrected_transformed_elements;
 
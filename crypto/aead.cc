@@ -10,12 +10,13 @@
 
 #include "base/strings/string_util.h"
 #include "crypto/openssl_util.h"
+#include "third_party/boringssl/src/include/openssl/aead.h"
 #include "third_party/boringssl/src/include/openssl/aes.h"
 #include "third_party/boringssl/src/include/openssl/evp.h"
 
 namespace crypto {
 
-Aead::Aead(AeadAlgorithm algorithm) : key_(nullptr) {
+Aead::Aead(AeadAlgorithm algorithm) {
   EnsureOpenSSLInit();
   switch (algorithm) {
     case AES_128_CTR_HMAC_SHA256:
@@ -30,27 +31,29 @@ Aead::Aead(AeadAlgorithm algorithm) : key_(nullptr) {
   }
 }
 
+Aead::Aead(Aead&& other) = default;
+
+Aead& Aead::operator=(Aead&& other) = default;
+
 Aead::~Aead() = default;
 
 void Aead::Init(const std::string* key) {
-  DCHECK(!key_);
+  DCHECK(!initialized_);
   DCHECK_EQ(KeyLength(), key->size());
-  key_ = key;
+  initialized_ = true;
+  ctx_.reset(EVP_AEAD_CTX_new(aead_,
+                              reinterpret_cast<const uint8_t*>(key->data()),
+                              key->size(), EVP_AEAD_DEFAULT_TAG_LENGTH));
 }
 
 bool Aead::Seal(base::StringPiece plaintext,
                 base::StringPiece nonce,
                 base::StringPiece additional_data,
                 std::string* ciphertext) const {
-  DCHECK(key_);
+  DCHECK(initialized_);
   DCHECK_EQ(NonceLength(), nonce.size());
-  EVP_AEAD_CTX ctx;
-
-  if (!EVP_AEAD_CTX_init(&ctx, aead_,
-                         reinterpret_cast<const uint8_t*>(key_->data()),
-                         key_->size(), EVP_AEAD_DEFAULT_TAG_LENGTH, nullptr)) {
+  if (!ctx_)
     return false;
-  }
 
   std::string result;
   const size_t max_output_length =
@@ -60,12 +63,11 @@ bool Aead::Seal(base::StringPiece plaintext,
       base::WriteInto(&result, max_output_length + 1));
 
   if (!EVP_AEAD_CTX_seal(
-          &ctx, out_ptr, &output_length, max_output_length,
+          ctx_.get(), out_ptr, &output_length, max_output_length,
           reinterpret_cast<const uint8_t*>(nonce.data()), nonce.size(),
           reinterpret_cast<const uint8_t*>(plaintext.data()), plaintext.size(),
           reinterpret_cast<const uint8_t*>(additional_data.data()),
           additional_data.size())) {
-    EVP_AEAD_CTX_cleanup(&ctx);
     return false;
   }
 
@@ -73,7 +75,6 @@ bool Aead::Seal(base::StringPiece plaintext,
   result.resize(output_length);
 
   ciphertext->swap(result);
-  EVP_AEAD_CTX_cleanup(&ctx);
 
   return true;
 }
@@ -82,14 +83,9 @@ bool Aead::Open(base::StringPiece ciphertext,
                 base::StringPiece nonce,
                 base::StringPiece additional_data,
                 std::string* plaintext) const {
-  DCHECK(key_);
-  EVP_AEAD_CTX ctx;
-
-  if (!EVP_AEAD_CTX_init(&ctx, aead_,
-                         reinterpret_cast<const uint8_t*>(key_->data()),
-                         key_->size(), EVP_AEAD_DEFAULT_TAG_LENGTH, nullptr)) {
+  DCHECK(initialized_);
+  if (!ctx_)
     return false;
-  }
 
   std::string result;
   const size_t max_output_length = ciphertext.size();
@@ -98,13 +94,12 @@ bool Aead::Open(base::StringPiece ciphertext,
       base::WriteInto(&result, max_output_length + 1));
 
   if (!EVP_AEAD_CTX_open(
-          &ctx, out_ptr, &output_length, max_output_length,
+          ctx_.get(), out_ptr, &output_length, max_output_length,
           reinterpret_cast<const uint8_t*>(nonce.data()), nonce.size(),
           reinterpret_cast<const uint8_t*>(ciphertext.data()),
           ciphertext.size(),
           reinterpret_cast<const uint8_t*>(additional_data.data()),
           additional_data.size())) {
-    EVP_AEAD_CTX_cleanup(&ctx);
     return false;
   }
 
@@ -112,7 +107,6 @@ bool Aead::Open(base::StringPiece ciphertext,
   result.resize(output_length);
 
   plaintext->swap(result);
-  EVP_AEAD_CTX_cleanup(&ctx);
 
   return true;
 }
@@ -11,8 +11,7 @@
 
 #include "base/strings/string_piece.h"
 #include "crypto/crypto_export.h"
-
-struct evp_aead_st;
+#include "third_party/boringssl/src/include/openssl/base.h"
 
 namespace crypto {
 
@@ -22,9 +21,14 @@ class CRYPTO_EXPORT Aead {
   enum AeadAlgorithm { AES_128_CTR_HMAC_SHA256, AES_256_GCM, AES_256_GCM_SIV };
 
   explicit Aead(AeadAlgorithm algorithm);
+  Aead(Aead&& other);
+  Aead& operator=(Aead&& other);
 
   ~Aead();
 
+  // Sets up the cipher context for |key|, which is reused by every Seal() and
+  // Open() call, so that many small messages don't each pay for expanding the
+  // key.
   void Init(const std::string* key);
 
   bool Seal(base::StringPiece plaintext,
@@ -42,8 +46,10 @@ class CRYPTO_EXPORT Aead {
   size_t NonceLength() const;
 
  private:
-  const std::string* key_;
-  const evp_aead_st* aead_;
+  const EVP_AEAD* aead_;
+  // Null until Init(), or if the context could not be initialized.
+  bssl::UniquePtr<EVP_AEAD_CTX> ctx_;
+  bool initialized_ = false;
 };
 
 }  // namespace crypto
@@ -5,6 +5,7 @@
 #include "crypto/aead.h"
 
 #include <string>
+#include <utility>
 
 #include "testing/gtest/include/gtest/gtest.h"
 
@@ -37,6 +38,28 @@ TEST_P(AeadTest, SealOpen) {
   EXPECT_EQ(plaintext, decrypted);
 }
 
+TEST_P(AeadTest, SealOpenManyMessages) {
+  crypto::Aead::AeadAlgorithm alg = GetParam();
+  crypto::Aead aead(alg);
+  std::string key(aead.KeyLength(), 0);
+  aead.Init(&key);
+  std::string ad("this is the additional data");
+
+  // The context set up by Init() is reused for every message, including
+  // after the Aead is moved.
+  crypto::Aead moved_aead = std::move(aead);
+  for (int i = 0; i < 10; ++i) {
+    std::string nonce(moved_aead.NonceLength(), static_cast<char>(i));
+    std::string plaintext(i * 7, 'a' + i);
+    std::string ciphertext;
+    EXPECT_TRUE(moved_aead.Seal(plaintext, nonce, ad, &ciphertext));
+
+    std::string decrypted;
+    EXPECT_TRUE(moved_aead.Open(ciphertext, nonce, ad, &decrypted));
+    EXPECT_EQ(plaintext, decrypted);
+  }
+}
+
 TEST_P(AeadTest, SealOpenWrongKey) {
   crypto::Aead::AeadAlgorithm alg = GetParam();
   crypto::Aead aead(alg);
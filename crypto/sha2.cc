@@ -5,23 +5,28 @@
 #include "crypto/sha2.h"
 
 #include <stddef.h>
+#include <stdint.h>
+#include <string.h>
 
-#include <memory>
+#include <algorithm>
 
 #include "base/stl_util.h"
-#include "crypto/secure_hash.h"
+#include "third_party/boringssl/src/include/openssl/sha.h"
 
 namespace crypto {
 
+// Hashes on the stack rather than through SecureHash, which allocates a
+// context per call; this is hot for callers hashing many small strings.
 void SHA256HashString(base::StringPiece str, void* output, size_t len) {
-  std::unique_ptr<SecureHash> ctx(SecureHash::Create(SecureHash::SHA256));
-  ctx->Update(str.data(), str.length());
-  ctx->Finish(output, len);
+  uint8_t hash[kSHA256Length];
+  SHA256(reinterpret_cast<const uint8_t*>(str.data()), str.size(), hash);
+  memcpy(output, hash, std::min(len, kSHA256Length));
 }
 
 std::string SHA256HashString(base::StringPiece str) {
   std::string output(kSHA256Length, 0);
-  SHA256HashString(str, base::data(output), output.size());
+  SHA256(reinterpret_cast<const uint8_t*>(str.data()), str.size(),
+         reinterpret_cast<uint8_t*>(base::data(output)));
   return output;
 }
 
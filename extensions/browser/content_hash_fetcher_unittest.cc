@@ -3,10 +3,13 @@
 // found in the LICENSE file.
 
 #include <memory>
+#include <string>
+#include <vector>
 
 #include "base/bind.h"
 #include "base/callback.h"
 #include "base/callback_helpers.h"
+#include "base/files/file_enumerator.h"
 #include "base/files/file_path.h"
 #include "base/files/file_util.h"
 #include "base/files/scoped_temp_dir.h"
@@ -17,6 +20,7 @@
 #include "base/version.h"
 #include "content/public/browser/browser_thread.h"
 #include "content/public/test/test_browser_thread_bundle.h"
+#include "extensions/browser/computed_hashes.h"
 #include "extensions/browser/content_hash_fetcher.h"
 #include "extensions/browser/content_verifier/test_utils.h"
 #include "extensions/browser/extension_file_task_runner.h"
@@ -314,4 +318,48 @@ TEST_F(ContentHashFetcherTest, MissingVerifiedContentsAndCorrupt) {
   EXPECT_TRUE(VerifiedContentsFileExists());
 }
 
+// Tests that hashing the extension's files on several threads writes the same
+// block hashes to computed_hashes.json as hashing each file in turn would.
+TEST_F(ContentHashFetcherTest, ComputedHashesMatchSequentialHashing) {
+  ASSERT_TRUE(LoadTestExtension());
+
+  RegisterInterception(fetch_url(), GetResourcePath("verified_contents.json"));
+
+  std::unique_ptr<ContentHashFetcherResult> result = DoHashFetch();
+  ASSERT_TRUE(result.get());
+  EXPECT_TRUE(result->success);
+  EXPECT_FALSE(result->was_cancelled);
+  EXPECT_TRUE(result->mismatch_paths.empty());
+
+  ComputedHashes::Reader reader;
+  ASSERT_TRUE(reader.InitFromFile(
+      file_util::GetComputedHashesPath(extension_root())));
+
+  base::FileEnumerator enumerator(extension_root(), true /* recursive */,
+                                  base::FileEnumerator::FILES);
+  size_t hashed_files = 0;
+  for (base::FilePath full_path = enumerator.Next(); !full_path.empty();
+       full_path = enumerator.Next()) {
+    base::FilePath relative_unix_path;
+    ASSERT_TRUE(
+        extension_root().AppendRelativePath(full_path, &relative_unix_path));
+    relative_unix_path = relative_unix_path.NormalizePathSeparatorsTo('/');
+
+    int block_size = 0;
+    std::vector<std::string> hashes;
+    if (!reader.GetHashes(relative_unix_path, &block_size, &hashes))
+      continue;
+    ++hashed_files;
+
+    std::string contents;
+    ASSERT_TRUE(base::ReadFileToString(full_path, &contents));
+    std::vector<std::string> expected_hashes;
+    ComputedHashes::ComputeHashesForContent(contents, block_size,
+                                            &expected_hashes);
+    EXPECT_EQ(expected_hashes, hashes) << relative_unix_path.value();
+  }
+  // More than one file has to be hashed for the work to be shared.
+  EXPECT_GT(hashed_files, 1u);
+}
+
 }  // namespace extensions
@@ -4,12 +4,21 @@
 
 #include "extensions/browser/content_verifier/content_hash.h"
 
+#include <algorithm>
+#include <atomic>
+#include <utility>
+#include <vector>
+
+#include "base/barrier_closure.h"
 #include "base/bind.h"
 #include "base/files/file_enumerator.h"
 #include "base/files/file_util.h"
 #include "base/json/json_reader.h"
+#include "base/memory/ref_counted.h"
 #include "base/metrics/histogram_macros.h"
 #include "base/sequence_checker.h"
+#include "base/synchronization/atomic_flag.h"
+#include "base/system/sys_info.h"
 #include "base/task/post_task.h"
 #include "base/timer/elapsed_timer.h"
 #include "content/public/browser/browser_thread.h"
@@ -28,6 +37,9 @@ namespace {
 
 using SortedFilePathSet = std::set<base::FilePath>;
 
+// The maximum number of thread pool tasks that help hash an extension's files.
+const int kMaxHashingHelperTasks = 3;
+
 bool CreateDirAndWriteFile(const base::FilePath& destination,
                            const std::string& content) {
   DCHECK(GetExtensionFileTaskRunner()->RunsTasksInCurrentSequence());
@@ -61,6 +73,67 @@ std::unique_ptr<VerifiedContents> GetVerifiedContents(
 
 }  // namespace
 
+// Reads and hashes a list of files. The files are handed out one at a time to
+// HashFiles(), which any number of threads can run at once. Every file has been
+// hashed or skipped once all HashFiles() calls have returned.
+class ContentHash::FileHasher
+    : public base::RefCountedThreadSafe<FileHasher> {
+ public:
+  struct Result {
+    bool read = false;
+    std::vector<std::string> hashes;
+    std::string root;
+  };
+
+  FileHasher(std::vector<base::FilePath> paths, int block_size)
+      : paths_(std::move(paths)),
+        block_size_(block_size),
+        results_(paths_.size()) {}
+
+  // Hashes files until there are none left. Once |is_cancelled| returns true,
+  // the remaining files are skipped, here and on the other threads. Only the
+  // sequence that created |this| may pass |is_cancelled|.
+  void HashFiles(const ContentHash::IsCancelledCallback& is_cancelled) {
+    for (size_t i = next_index_++; i < paths_.size(); i = next_index_++) {
+      if (is_cancelled && is_cancelled.Run())
+        cancelled_.Set();
+      if (!cancelled_.IsSet())
+        HashFile(paths_[i], &results_[i]);
+    }
+  }
+
+  // Returns whether the remaining files were skipped.
+  bool cancelled() const { return cancelled_.IsSet(); }
+
+  const std::vector<base::FilePath>& paths() const { return paths_; }
+  const std::vector<Result>& results() const { return results_; }
+
+ private:
+  friend class base::RefCountedThreadSafe<FileHasher>;
+  ~FileHasher() = default;
+
+  void HashFile(const base::FilePath& path, Result* result) {
+    std::string contents;
+    if (!base::ReadFileToString(path, &contents))
+      return;
+    result->read = true;
+    // Iterate through taking the hash of each block of size (block_size_) of
+    // the file.
+    ComputedHashes::ComputeHashesForContent(contents, block_size_,
+                                            &result->hashes);
+    result->root = ComputeTreeHashRoot(result->hashes,
+                                       block_size_ / crypto::kSHA256Length);
+  }
+
+  const std::vector<base::FilePath> paths_;
+  const int block_size_;
+  std::vector<Result> results_;
+  std::atomic<size_t> next_index_{0};
+  base::AtomicFlag cancelled_;
+
+  DISALLOW_COPY_AND_ASSIGN(FileHasher);
+};
+
 ContentHash::ExtensionKey::ExtensionKey(const ExtensionId& extension_id,
                                         const base::FilePath& extension_root,
                                         const base::Version& extension_version,
@@ -112,16 +185,16 @@ void ContentHash::Create(const ExtensionKey& key,
       new ContentHash(key, std::move(verified_contents), nullptr);
   const bool did_fetch_verified_contents = false;
   hash->BuildComputedHashes(did_fetch_verified_contents,
-                            false /* force_build */, is_cancelled);
-  std::move(created_callback).Run(hash, is_cancelled && is_cancelled.Run());
+                            false /* force_build */, is_cancelled,
+                            std::move(created_callback));
 }
 
 void ContentHash::ForceBuildComputedHashes(
     const IsCancelledCallback& is_cancelled,
     CreatedCallback created_callback) {
   BuildComputedHashes(false /* did_fetch_verified_contents */,
-                      true /* force_build */, is_cancelled);
-  std::move(created_callback).Run(this, is_cancelled && is_cancelled.Run());
+                      true /* force_build */, is_cancelled,
+                      std::move(created_callback));
 }
 
 const VerifiedContents& ContentHash::verified_contents() const {
@@ -221,8 +294,8 @@ void ContentHash::DidFetchVerifiedContents(
       new ContentHash(key, std::move(verified_contents), nullptr);
   const bool did_fetch_verified_contents = true;
   hash->BuildComputedHashes(did_fetch_verified_contents,
-                            false /* force_build */, is_cancelled);
-  std::move(created_callback).Run(hash, is_cancelled && is_cancelled.Run());
+                            false /* force_build */, is_cancelled,
+                            std::move(created_callback));
 }
 
 // static
@@ -243,21 +316,26 @@ void ContentHash::RecordFetchResult(bool success) {
   UMA_HISTOGRAM_BOOLEAN("Extensions.ContentVerification.FetchResult", success);
 }
 
-bool ContentHash::CreateHashes(const base::FilePath& hashes_file,
-                               const IsCancelledCallback& is_cancelled) {
+void ContentHash::CreateHashes(const base::FilePath& hashes_file,
+                               const IsCancelledCallback& is_cancelled,
+                               CreateHashesCallback created_hashes_callback) {
   base::ElapsedTimer timer;
   did_attempt_creating_computed_hashes_ = true;
   // Make sure the directory exists.
-  if (!base::CreateDirectoryAndGetError(hashes_file.DirName(), nullptr))
-    return false;
+  if (!base::CreateDirectoryAndGetError(hashes_file.DirName(), nullptr)) {
+    std::move(created_hashes_callback).Run(false);
+    return;
+  }
 
   base::FileEnumerator enumerator(key_.extension_root, true, /* recursive */
                                   base::FileEnumerator::FILES);
   // First discover all the file paths and put them in a sorted set.
   SortedFilePathSet paths;
   for (;;) {
-    if (is_cancelled && is_cancelled.Run())
-      return false;
+    if (is_cancelled && is_cancelled.Run()) {
+      std::move(created_hashes_callback).Run(false);
+      return;
+    }
 
     base::FilePath full_path = enumerator.Next();
     if (full_path.empty())
@@ -265,40 +343,76 @@ bool ContentHash::CreateHashes(const base::FilePath& hashes_file,
     paths.insert(full_path);
   }
 
-  // Now iterate over all the paths in sorted order and compute the block hashes
-  // for each one.
-  ComputedHashes::Writer writer;
-  for (auto i = paths.begin(); i != paths.end(); ++i) {
-    if (is_cancelled && is_cancelled.Run())
-      return false;
-
-    const base::FilePath& full_path = *i;
+  // Now pick the paths that have a tree hash root in sorted order, and compute
+  // the block hashes for each one. Files are read and hashed on this sequence
+  // and on as many thread pool tasks as is useful. Nothing waits for the
+  // helpers: each of them replies to this sequence when it runs out of files,
+  // and the hashes are written once every reply has arrived.
+  std::vector<base::FilePath> full_paths;
+  std::vector<base::FilePath> relative_unix_paths;
+  for (const base::FilePath& full_path : paths) {
     base::FilePath relative_unix_path;
     key_.extension_root.AppendRelativePath(full_path, &relative_unix_path);
     relative_unix_path = relative_unix_path.NormalizePathSeparatorsTo('/');
 
     if (!verified_contents_->HasTreeHashRoot(relative_unix_path))
       continue;
+    full_paths.push_back(full_path);
+    relative_unix_paths.push_back(relative_unix_path);
+  }
 
-    std::string contents;
-    if (!base::ReadFileToString(full_path, &contents)) {
-      LOG(ERROR) << "Could not read " << full_path.MaybeAsASCII();
+  auto hasher =
+      base::MakeRefCounted<FileHasher>(std::move(full_paths), block_size_);
+  int helper_tasks = std::max(
+      0, std::min({kMaxHashingHelperTasks,
+                   base::SysInfo::NumberOfProcessors() - 1,
+                   static_cast<int>(hasher->paths().size()) - 1}));
+  base::RepeatingClosure barrier = base::BarrierClosure(
+      helper_tasks + 1,
+      base::BindOnce(&ContentHash::DidHashFiles, base::WrapRefCounted(this),
+                     hashes_file, hasher, std::move(relative_unix_paths),
+                     std::move(timer), std::move(created_hashes_callback)));
+  for (int i = 0; i < helper_tasks; ++i) {
+    base::PostTaskWithTraitsAndReply(
+        FROM_HERE,
+        {base::MayBlock(), base::TaskPriority::USER_VISIBLE,
+         base::TaskShutdownBehavior::SKIP_ON_SHUTDOWN},
+        base::BindOnce(&FileHasher::HashFiles, hasher,
+                       ContentHash::IsCancelledCallback()),
+        barrier);
+  }
+  hasher->HashFiles(is_cancelled);
+  barrier.Run();
+}
+
+void ContentHash::DidHashFiles(
+    const base::FilePath& hashes_file,
+    scoped_refptr<FileHasher> hasher,
+    std::vector<base::FilePath> relative_unix_paths,
+    base::ElapsedTimer timer,
+    CreateHashesCallback created_hashes_callback) {
+  if (hasher->cancelled()) {
+    std::move(created_hashes_callback).Run(false);
+    return;
+  }
+
+  ComputedHashes::Writer writer;
+  for (size_t i = 0; i < relative_unix_paths.size(); ++i) {
+    const base::FilePath& relative_unix_path = relative_unix_paths[i];
+    const FileHasher::Result& file_result = hasher->results()[i];
+    if (!file_result.read) {
+      LOG(ERROR) << "Could not read " << hasher->paths()[i].MaybeAsASCII();
       continue;
     }
 
-    // Iterate through taking the hash of each block of size (block_size_) of
-    // the file.
-    std::vector<std::string> hashes;
-    ComputedHashes::ComputeHashesForContent(contents, block_size_, &hashes);
-    std::string root =
-        ComputeTreeHashRoot(hashes, block_size_ / crypto::kSHA256Length);
-    if (!verified_contents_->TreeHashRootEquals(relative_unix_path, root)) {
+    if (!verified_contents_->TreeHashRootEquals(relative_unix_path,
+                                                file_result.root)) {
       VLOG(1) << "content mismatch for " << relative_unix_path.AsUTF8Unsafe();
       hash_mismatch_unix_paths_.insert(relative_unix_path);
       continue;
     }
 
-    writer.AddHashes(relative_unix_path, block_size_, hashes);
+    writer.AddHashes(relative_unix_path, block_size_, file_result.hashes);
   }
   bool result = writer.WriteToFile(hashes_file);
   UMA_HISTOGRAM_TIMES("ExtensionContentHashFetcher.CreateHashesTime",
@@ -307,12 +421,13 @@ bool ContentHash::CreateHashes(const base::FilePath& hashes_file,
   if (result)
     status_ = Status::kSucceeded;
 
-  return result;
+  std::move(created_hashes_callback).Run(result);
 }
 
 void ContentHash::BuildComputedHashes(bool attempted_fetching_verified_contents,
                                       bool force_build,
-                                      const IsCancelledCallback& is_cancelled) {
+                                      const IsCancelledCallback& is_cancelled,
+                                      CreatedCallback created_callback) {
   base::FilePath computed_hashes_path =
       file_util::GetComputedHashesPath(key_.extension_root);
 
@@ -342,26 +457,45 @@ void ContentHash::BuildComputedHashes(bool attempted_fetching_verified_contents,
       // Read successful.
       status_ = Status::kSucceeded;
       computed_hashes_ = std::move(computed_hashes);
+      DidBuildComputedHashes(is_cancelled, std::move(created_callback));
       return;
     }
   }
 
-  if (will_create && !CreateHashes(computed_hashes_path, is_cancelled)) {
-    // Failed creating computed_hashes.json.
+  if (will_create) {
+    CreateHashes(computed_hashes_path, is_cancelled,
+                 base::BindOnce(&ContentHash::DidCreateHashes,
+                                base::WrapRefCounted(this),
+                                computed_hashes_path, is_cancelled,
+                                std::move(created_callback)));
     return;
   }
 
-  // Read computed_hashes.json:
-  if (!base::PathExists(computed_hashes_path))
-    return;
+  // Nothing was created, read whatever computed_hashes.json is there.
+  DidCreateHashes(computed_hashes_path, is_cancelled,
+                  std::move(created_callback), true /* success */);
+}
 
-  auto computed_hashes = std::make_unique<ComputedHashes::Reader>();
-  if (!computed_hashes->InitFromFile(computed_hashes_path))
-    return;
+void ContentHash::DidCreateHashes(const base::FilePath& computed_hashes_path,
+                                  const IsCancelledCallback& is_cancelled,
+                                  CreatedCallback created_callback,
+                                  bool success) {
+  // Read computed_hashes.json, unless creating it failed.
+  if (success && base::PathExists(computed_hashes_path)) {
+    auto computed_hashes = std::make_unique<ComputedHashes::Reader>();
+    if (computed_hashes->InitFromFile(computed_hashes_path)) {
+      // Read successful.
+      status_ = Status::kSucceeded;
+      computed_hashes_ = std::move(computed_hashes);
+    }
+  }
+  DidBuildComputedHashes(is_cancelled, std::move(created_callback));
+}
 
-  // Read successful.
-  status_ = Status::kSucceeded;
-  computed_hashes_ = std::move(computed_hashes);
+void ContentHash::DidBuildComputedHashes(
+    const IsCancelledCallback& is_cancelled,
+    CreatedCallback created_callback) {
+  std::move(created_callback).Run(this, is_cancelled && is_cancelled.Run());
 }
 
 }  // namespace extensions
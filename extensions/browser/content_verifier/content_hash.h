@@ -6,9 +6,12 @@
 #define EXTENSIONS_BROWSER_CONTENT_VERIFIER_CONTENT_HASH_H_
 
 #include <set>
+#include <vector>
 
 #include "base/callback_helpers.h"
 #include "base/files/file_path.h"
+#include "base/memory/ref_counted.h"
+#include "base/timer/elapsed_timer.h"
 #include "base/version.h"
 #include "extensions/browser/computed_hashes.h"
 #include "extensions/browser/content_verifier/content_verifier_key.h"
@@ -159,23 +162,45 @@ class ContentHash : public base::RefCountedThreadSafe<ContentHash> {
 
   static void RecordFetchResult(bool success);
 
+  class FileHasher;
+
+  // Called with whether computed_hashes.json was written.
+  using CreateHashesCallback = base::OnceCallback<void(bool success)>;
+
   // Computes hashes for all files in |key_.extension_root|, and uses
   // a ComputedHashes::Writer to write that information into |hashes_file|.
-  // Returns true on success.
+  // Runs |created_hashes_callback| on this sequence when done, which happens
+  // asynchronously if any file needs hashing.
   // The verified contents file from the webstore only contains the treehash
   // root hash, but for performance we want to cache the individual block level
   // hashes. This function will create that cache with block-level hashes for
   // each file in the extension if needed (the treehash root hash for each of
   // these should equal what is in the verified contents file from the
   // webstore).
-  bool CreateHashes(const base::FilePath& hashes_file,
-                    const IsCancelledCallback& is_cancelled);
+  void CreateHashes(const base::FilePath& hashes_file,
+                    const IsCancelledCallback& is_cancelled,
+                    CreateHashesCallback created_hashes_callback);
+
+  // Checks the hashes computed by |hasher| against verified_contents.json and
+  // writes them to |hashes_file|, once every file was hashed.
+  void DidHashFiles(const base::FilePath& hashes_file,
+                    scoped_refptr<FileHasher> hasher,
+                    std::vector<base::FilePath> relative_unix_paths,
+                    base::ElapsedTimer timer,
+                    CreateHashesCallback created_hashes_callback);
 
   // Builds computed_hashes. Possibly after creating computed_hashes.json file
-  // if necessary.
+  // if necessary. Runs |created_callback| with |this| when done.
   void BuildComputedHashes(bool attempted_fetching_verified_contents,
                            bool force_build,
-                           const IsCancelledCallback& is_cancelled);
+                           const IsCancelledCallback& is_cancelled,
+                           CreatedCallback created_callback);
+  void DidCreateHashes(const base::FilePath& computed_hashes_path,
+                       const IsCancelledCallback& is_cancelled,
+                       CreatedCallback created_callback,
+                       bool success);
+  void DidBuildComputedHashes(const IsCancelledCallback& is_cancelled,
+                              CreatedCallback created_callback);
 
   ExtensionKey key_;
 
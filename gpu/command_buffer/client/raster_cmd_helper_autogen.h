@@ -164,6 +164,17 @@ void DeletePaintCachePathsINTERNALImmediate(GLsizei n, const GLuint* ids) {
   }
 }
 
+void DeletePaintCacheRecordsINTERNALImmediate(GLsizei n, const GLuint* ids) {
+  const uint32_t size =
+      raster::cmds::DeletePaintCacheRecordsINTERNALImmediate::ComputeSize(n);
+  raster::cmds::DeletePaintCacheRecordsINTERNALImmediate* c =
+      GetImmediateCmdSpaceTotalSize<
+          raster::cmds::DeletePaintCacheRecordsINTERNALImmediate>(size);
+  if (c) {
+    c->Init(n, ids);
+  }
+}
+
 void ClearPaintCacheINTERNAL() {
   raster::cmds::ClearPaintCacheINTERNAL* c =
       GetCmdSpace<raster::cmds::ClearPaintCacheINTERNAL>();
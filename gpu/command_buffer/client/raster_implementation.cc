@@ -1277,6 +1277,10 @@ void RasterImplementation::FlushPaintCachePurgedEntries() {
       case cc::PaintCacheDataType::kPath:
         helper_->DeletePaintCachePathsINTERNALImmediate(ids.size(), ids.data());
         break;
+      case cc::PaintCacheDataType::kRecord:
+        helper_->DeletePaintCacheRecordsINTERNALImmediate(ids.size(),
+                                                          ids.data());
+        break;
     }
     ids.clear();
   }
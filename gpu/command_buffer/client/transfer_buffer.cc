@@ -9,12 +9,31 @@
 #include <stddef.h>
 #include <stdint.h>
 
+#include <atomic>
+
 #include "base/bits.h"
 #include "base/logging.h"
 #include "base/trace_event/trace_event.h"
 #include "gpu/command_buffer/client/cmd_buffer_helper.h"
 
 namespace gpu {
+namespace {
+
+std::atomic<size_t> g_process_wide_allocated_size{0};
+std::atomic<size_t> g_process_wide_size_limit{
+    TransferBuffer::kDefaultProcessWideSizeLimit};
+
+}  // namespace
+
+// static
+void TransferBuffer::SetProcessWideSizeLimit(size_t limit) {
+  g_process_wide_size_limit = limit;
+}
+
+// static
+size_t TransferBuffer::GetProcessWideAllocatedSize() {
+  return g_process_wide_allocated_size;
+}
 
 TransferBuffer::TransferBuffer(CommandBufferHelper* helper)
     : helper_(helper),
@@ -60,6 +79,7 @@ void TransferBuffer::Free() {
     TRACE_EVENT0("gpu", "TransferBuffer::Free");
     helper_->OrderingBarrier();
     helper_->command_buffer()->DestroyTransferBuffer(buffer_id_);
+    g_process_wide_allocated_size -= buffer_->size();
     buffer_id_ = -1;
     buffer_ = nullptr;
     result_buffer_ = nullptr;
@@ -118,6 +138,7 @@ void TransferBuffer::AllocateRingBuffer(unsigned int size) {
       last_allocated_size_ = size;
       DCHECK(buffer.get());
       buffer_ = buffer;
+      g_process_wide_allocated_size += buffer_->size();
       ring_buffer_ = std::make_unique<RingBuffer>(
           alignment_, result_size_, buffer_->size() - result_size_, helper_,
           static_cast<char*>(buffer_->memory()) + result_size_);
@@ -192,10 +213,16 @@ void TransferBuffer::ShrinkOrExpandRingBufferIfNecessary(
       std::max(high_water_mark_, last_allocated_size_ - available_size +
                                      size_to_allocate +
                                      GetPreviousRingBufferUsedBytes());
+  // Shrink eagerly while the process uses too much memory for transfer
+  // buffers, to reclaim it from contexts that only needed it for a while.
+  unsigned int shrink_threshold =
+      g_process_wide_allocated_size > g_process_wide_size_limit
+          ? 1
+          : kShrinkThreshold;
   if (size_to_allocate > available_size) {
     // Try to expand the ring buffer.
     ReallocateRingBuffer(high_water_mark_);
-  } else if (bytes_since_last_shrink_ > high_water_mark_ * kShrinkThreshold) {
+  } else if (bytes_since_last_shrink_ > high_water_mark_ * shrink_threshold) {
     // The intent of the above check is to limit the frequency of buffer shrink
     // attempts. Unfortunately if an application uploads a large amount of data
     // once and from then on uploads only a small amount per frame, it will be a
@@ -118,6 +118,17 @@ class GPU_EXPORT TransferBuffer : public TransferBufferInterface {
   // allocated reaches this threshold times the high water mark.
   static const int kShrinkThreshold = 120;
 
+  // While the transfer buffers of all contexts in the process take more than
+  // this limit, each ring buffer is shrunk to its working set as soon as the
+  // number of bytes allocated reaches its high water mark, rather than
+  // kShrinkThreshold times that. Growing is not limited, so that large uploads
+  // stay fast.
+  static const size_t kDefaultProcessWideSizeLimit = 32 * 1024 * 1024;
+  static void SetProcessWideSizeLimit(size_t limit);
+
+  // Returns the size of the transfer buffers of all contexts in the process.
+  static size_t GetProcessWideAllocatedSize();
+
  private:
   // Tries to reallocate the ring buffer if it's not large enough for size.
   void ReallocateRingBuffer(unsigned int size, bool shrink = false);
@@ -515,6 +515,61 @@ TEST_F(TransferBufferExpandContractTest, ShrinkRingBuffer) {
   transfer_buffer_->FreePendingToken(ptr, token);
 }
 
+TEST_F(TransferBufferExpandContractTest, ShrinkWhenOverProcessWideLimit) {
+  int32_t token = helper_->InsertToken();
+  // For this test we want all allocations to be freed immediately.
+  command_buffer_->SetToken(token);
+  EXPECT_TRUE(helper_->HasTokenPassed(token));
+
+  size_t initial_size = TransferBuffer::GetProcessWideAllocatedSize();
+  TransferBuffer::SetProcessWideSizeLimit(initial_size);
+
+  // Expand the ring buffer to the maximum size, which takes the process over
+  // the limit.
+  EXPECT_CALL(*command_buffer(), DestroyTransferBuffer(_))
+      .Times(1)
+      .RetiresOnSaturation();
+  EXPECT_CALL(*command_buffer(), OrderingBarrier(_))
+      .Times(1)
+      .RetiresOnSaturation();
+  EXPECT_CALL(*command_buffer(),
+              CreateTransferBuffer(kMaxTransferBufferSize, _))
+      .WillOnce(
+          Invoke(command_buffer(),
+                 &MockClientCommandBufferCanFail::RealCreateTransferBuffer))
+      .RetiresOnSaturation();
+  void* ptr = transfer_buffer_->Alloc(kMaxTransferBufferSize - kStartingOffset);
+  EXPECT_TRUE(ptr != nullptr);
+  transfer_buffer_->FreePendingToken(ptr, token);
+  EXPECT_EQ(initial_size - kStartTransferBufferSize + kMaxTransferBufferSize,
+            TransferBuffer::GetProcessWideAllocatedSize());
+
+  // The ring buffer shrinks long before kShrinkThreshold times its high water
+  // mark is allocated.
+  EXPECT_CALL(*command_buffer(), DestroyTransferBuffer(_))
+      .Times(1)
+      .RetiresOnSaturation();
+  EXPECT_CALL(*command_buffer(), OrderingBarrier(_))
+      .Times(1)
+      .RetiresOnSaturation();
+  EXPECT_CALL(*command_buffer(),
+              CreateTransferBuffer(testing::Lt(kMaxTransferBufferSize), _))
+      .WillOnce(
+          Invoke(command_buffer(),
+                 &MockClientCommandBufferCanFail::RealCreateTransferBuffer))
+      .RetiresOnSaturation();
+  for (int i = 0; i < 10; ++i) {
+    ptr = transfer_buffer_->Alloc(kStartTransferBufferSize);
+    EXPECT_TRUE(ptr != nullptr);
+    transfer_buffer_->FreePendingToken(ptr, token);
+  }
+  EXPECT_LT(TransferBuffer::GetProcessWideAllocatedSize(),
+            initial_size - kStartTransferBufferSize + kMaxTransferBufferSize);
+
+  TransferBuffer::SetProcessWideSizeLimit(
+      TransferBuffer::kDefaultProcessWideSizeLimit);
+}
+
 TEST_F(TransferBufferExpandContractTest, Contract) {
   // Check it starts at starting size.
   EXPECT_EQ(
@@ -708,6 +708,50 @@ static_assert(
 static_assert(offsetof(DeletePaintCachePathsINTERNALImmediate, n) == 4,
               "offset of DeletePaintCachePathsINTERNALImmediate n should be 4");
 
+struct DeletePaintCacheRecordsINTERNALImmediate {
+  typedef DeletePaintCacheRecordsINTERNALImmediate ValueType;
+  static const CommandId kCmdId = kDeletePaintCacheRecordsINTERNALImmediate;
+  static const cmd::ArgFlags kArgFlags = cmd::kAtLeastN;
+  static const uint8_t cmd_flags = CMD_FLAG_SET_TRACE_LEVEL(3);
+
+  static uint32_t ComputeDataSize(GLsizei _n) {
+    return static_cast<uint32_t>(sizeof(GLuint) * _n);  // NOLINT
+  }
+
+  static uint32_t ComputeSize(GLsizei _n) {
+    return static_cast<uint32_t>(sizeof(ValueType) +
+                                 ComputeDataSize(_n));  // NOLINT
+  }
+
+  void SetHeader(GLsizei _n) {
+    header.SetCmdByTotalSize<ValueType>(ComputeSize(_n));
+  }
+
+  void Init(GLsizei _n, const GLuint* _ids) {
+    SetHeader(_n);
+    n = _n;
+    memcpy(ImmediateDataAddress(this), _ids, ComputeDataSize(_n));
+  }
+
+  void* Set(void* cmd, GLsizei _n, const GLuint* _ids) {
+    static_cast<ValueType*>(cmd)->Init(_n, _ids);
+    const uint32_t size = ComputeSize(_n);
+    return NextImmediateCmdAddressTotalSize<ValueType>(cmd, size);
+  }
+
+  gpu::CommandHeader header;
+  int32_t n;
+};
+
+static_assert(sizeof(DeletePaintCacheRecordsINTERNALImmediate) == 8,
+              "size of DeletePaintCacheRecordsINTERNALImmediate should be 8");
+static_assert(
+    offsetof(DeletePaintCacheRecordsINTERNALImmediate, header) == 0,
+    "offset of DeletePaintCacheRecordsINTERNALImmediate header should be 0");
+static_assert(
+    offsetof(DeletePaintCacheRecordsINTERNALImmediate, n) == 4,
+    "offset of DeletePaintCacheRecordsINTERNALImmediate n should be 4");
+
 struct ClearPaintCacheINTERNAL {
   typedef ClearPaintCacheINTERNAL ValueType;
   static const CommandId kCmdId = kClearPaintCacheINTERNAL;
@@ -274,6 +274,27 @@ TEST_F(RasterFormatTest, DeletePaintCachePathsINTERNALImmediate) {
   EXPECT_EQ(0, memcmp(ids, ImmediateDataAddress(&cmd), sizeof(ids)));
 }
 
+TEST_F(RasterFormatTest, DeletePaintCacheRecordsINTERNALImmediate) {
+  static GLuint ids[] = {
+      12,
+      23,
+      34,
+  };
+  cmds::DeletePaintCacheRecordsINTERNALImmediate& cmd =
+      *GetBufferAs<cmds::DeletePaintCacheRecordsINTERNALImmediate>();
+  void* next_cmd = cmd.Set(&cmd, static_cast<GLsizei>(base::size(ids)), ids);
+  EXPECT_EQ(static_cast<uint32_t>(
+                cmds::DeletePaintCacheRecordsINTERNALImmediate::kCmdId),
+            cmd.header.command);
+  EXPECT_EQ(sizeof(cmd) + RoundSizeToMultipleOfEntries(cmd.n * 4u),
+            cmd.header.size * 4u);
+  EXPECT_EQ(static_cast<GLsizei>(base::size(ids)), cmd.n);
+  CheckBytesWrittenMatchesExpectedSize(
+      next_cmd,
+      sizeof(cmd) + RoundSizeToMultipleOfEntries(base::size(ids) * 4u));
+  EXPECT_EQ(0, memcmp(ids, ImmediateDataAddress(&cmd), sizeof(ids)));
+}
+
 TEST_F(RasterFormatTest, ClearPaintCacheINTERNAL) {
   cmds::ClearPaintCacheINTERNAL& cmd =
       *GetBufferAs<cmds::ClearPaintCacheINTERNAL>();
@@ -28,11 +28,12 @@
   OP(UnlockTransferCacheEntryINTERNAL)           /* 269 */ \
   OP(DeletePaintCacheTextBlobsINTERNALImmediate) /* 270 */ \
   OP(DeletePaintCachePathsINTERNALImmediate)     /* 271 */ \
-  OP(ClearPaintCacheINTERNAL)                    /* 272 */ \
-  OP(CopySubTextureINTERNALImmediate)            /* 273 */ \
-  OP(TraceBeginCHROMIUM)                         /* 274 */ \
-  OP(TraceEndCHROMIUM)                           /* 275 */ \
-  OP(SetActiveURLCHROMIUM)                       /* 276 */
+  OP(DeletePaintCacheRecordsINTERNALImmediate)   /* 272 */ \
+  OP(ClearPaintCacheINTERNAL)                    /* 273 */ \
+  OP(CopySubTextureINTERNALImmediate)            /* 274 */ \
+  OP(TraceBeginCHROMIUM)                         /* 275 */ \
+  OP(TraceEndCHROMIUM)                           /* 276 */ \
+  OP(SetActiveURLCHROMIUM)                       /* 277 */
 
 enum CommandId {
   kOneBeforeStartPoint =
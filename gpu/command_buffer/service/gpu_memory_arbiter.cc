@@ -0,0 +1,128 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "gpu/command_buffer/service/gpu_memory_arbiter.h"
+
+#include <algorithm>
+#include <string>
+
+#include "base/logging.h"
+#include "base/stl_util.h"
+#include "base/threading/thread_task_runner_handle.h"
+#include "base/time/default_tick_clock.h"
+#include "base/trace_event/memory_dump_manager.h"
+#include "base/trace_event/process_memory_dump.h"
+#include "base/trace_event/trace_event.h"
+#include "gpu/command_buffer/service/service_discardable_manager.h"
+
+namespace gpu {
+namespace {
+
+// The ages, in seconds, of the resources that are evicted in each step of
+// EvictToLimit(). All pools are trimmed to the same age before moving on to a
+// younger one, so that resources go in the same order no matter which pool
+// holds them.
+constexpr int kEvictionAgesInSeconds[] = {60, 30, 10, 5, 2, 1, 0};
+
+}  // namespace
+
+size_t GpuMemoryArbiterBudget() {
+  // The pools also keep themselves within their own limits, which for
+  // discardable textures and the transfer cache is DiscardableCacheSizeLimit().
+  // Allow about that much for each of them and for Skia.
+  return 3 * DiscardableCacheSizeLimit();
+}
+
+GpuMemoryArbiter::GpuMemoryArbiter(size_t budget)
+    : budget_(budget), tick_clock_(base::DefaultTickClock::GetInstance()) {
+  if (base::ThreadTaskRunnerHandle::IsSet()) {
+    base::trace_event::MemoryDumpManager::GetInstance()->RegisterDumpProvider(
+        this, "GpuMemoryArbiter", base::ThreadTaskRunnerHandle::Get());
+  }
+}
+
+GpuMemoryArbiter::~GpuMemoryArbiter() {
+  base::trace_event::MemoryDumpManager::GetInstance()->UnregisterDumpProvider(
+      this);
+}
+
+void GpuMemoryArbiter::AddPool(const char* category, Pool* pool) {
+  DCHECK(std::none_of(
+      pools_.begin(), pools_.end(),
+      [pool](const PoolInfo& info) { return info.pool == pool; }));
+  pools_.push_back({category, pool});
+}
+
+void GpuMemoryArbiter::RemovePool(Pool* pool) {
+  base::EraseIf(pools_,
+                [pool](const PoolInfo& info) { return info.pool == pool; });
+}
+
+size_t GpuMemoryArbiter::GetTotalCacheSize() const {
+  size_t total_size = 0;
+  for (const auto& info : pools_)
+    total_size += info.pool->GetCacheSize();
+  return total_size;
+}
+
+void GpuMemoryArbiter::EnforceBudget() {
+  EvictToLimit(budget_);
+}
+
+void GpuMemoryArbiter::HandleMemoryPressure(
+    base::MemoryPressureListener::MemoryPressureLevel memory_pressure_level) {
+  switch (memory_pressure_level) {
+    case base::MemoryPressureListener::MEMORY_PRESSURE_LEVEL_NONE:
+      // This function is only called with moderate or critical pressure.
+      NOTREACHED();
+      return;
+    case base::MemoryPressureListener::MEMORY_PRESSURE_LEVEL_MODERATE:
+      // With moderate pressure, shrink to 1/4 of the budget.
+      EvictToLimit(budget_ / 4);
+      return;
+    case base::MemoryPressureListener::MEMORY_PRESSURE_LEVEL_CRITICAL:
+      // With critical pressure, evict as much as possible.
+      EvictToLimit(0);
+      return;
+  }
+}
+
+void GpuMemoryArbiter::EvictToLimit(size_t limit) {
+  if (GetTotalCacheSize() <= limit)
+    return;
+
+  TRACE_EVENT1("gpu", "GpuMemoryArbiter::EvictToLimit", "limit", limit);
+  base::TimeTicks now = tick_clock_->NowTicks();
+  for (int age : kEvictionAgesInSeconds) {
+    base::TimeTicks not_used_since = now - base::TimeDelta::FromSeconds(age);
+    for (const auto& info : pools_)
+      info.pool->EvictResourcesNotUsedSince(not_used_since);
+    if (GetTotalCacheSize() <= limit)
+      return;
+  }
+}
+
+bool GpuMemoryArbiter::OnMemoryDump(
+    const base::trace_event::MemoryDumpArgs& args,
+    base::trace_event::ProcessMemoryDump* pmd) {
+  using base::trace_event::MemoryAllocatorDump;
+
+  // The memory of the pools is reported by their own dumps, so only report
+  // it here as "cache_size" rather than as size, which would count it twice.
+  std::string dump_name = "gpu/memory_arbiter";
+  MemoryAllocatorDump* dump = pmd->CreateAllocatorDump(dump_name);
+  dump->AddScalar("cache_size", MemoryAllocatorDump::kUnitsBytes,
+                  GetTotalCacheSize());
+  dump->AddScalar("budget", MemoryAllocatorDump::kUnitsBytes, budget_);
+
+  for (const auto& info : pools_) {
+    MemoryAllocatorDump* pool_dump =
+        pmd->CreateAllocatorDump(dump_name + "/" + info.category);
+    pool_dump->AddScalar("cache_size", MemoryAllocatorDump::kUnitsBytes,
+                         info.pool->GetCacheSize());
+  }
+  return true;
+}
+
+}  // namespace gpu
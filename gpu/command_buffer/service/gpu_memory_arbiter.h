@@ -0,0 +1,92 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef GPU_COMMAND_BUFFER_SERVICE_GPU_MEMORY_ARBITER_H_
+#define GPU_COMMAND_BUFFER_SERVICE_GPU_MEMORY_ARBITER_H_
+
+#include <vector>
+
+#include "base/macros.h"
+#include "base/memory/memory_pressure_listener.h"
+#include "base/time/time.h"
+#include "base/trace_event/memory_dump_provider.h"
+#include "gpu/gpu_gles2_export.h"
+
+namespace base {
+class TickClock;
+}  // namespace base
+
+namespace gpu {
+
+// The default budget for all pools of a GpuMemoryArbiter together.
+GPU_GLES2_EXPORT size_t GpuMemoryArbiterBudget();
+
+// Keeps the caches of the GPU service that can drop resources on demand,
+// such as discardable textures, transfer cache entries and Skia's scratch
+// resources, within a single budget. Each cache has its own limit as well,
+// but when the caches are together over budget, or under memory pressure,
+// resources are evicted from all of them in a single least recently used
+// order rather than by each cache independently.
+class GPU_GLES2_EXPORT GpuMemoryArbiter
+    : public base::trace_event::MemoryDumpProvider {
+ public:
+  // A cache whose resources the arbiter can evict.
+  class GPU_GLES2_EXPORT Pool {
+   public:
+    virtual ~Pool() = default;
+
+    // Returns the size of the resources held by the pool, in bytes.
+    virtual size_t GetCacheSize() const = 0;
+
+    // Evicts every resource that can be evicted and that hasn't been used
+    // since |time|.
+    virtual void EvictResourcesNotUsedSince(base::TimeTicks time) = 0;
+  };
+
+  explicit GpuMemoryArbiter(size_t budget);
+  ~GpuMemoryArbiter() override;
+
+  // Adds |pool|, which must outlive the arbiter or be removed first.
+  // |category| names the pool in memory dumps and must be a string literal.
+  void AddPool(const char* category, Pool* pool);
+  void RemovePool(Pool* pool);
+
+  // Returns the size of all pools together, in bytes.
+  size_t GetTotalCacheSize() const;
+
+  // Evicts the least recently used resources of all pools until they are
+  // together within the budget.
+  void EnforceBudget();
+
+  void HandleMemoryPressure(
+      base::MemoryPressureListener::MemoryPressureLevel memory_pressure_level);
+
+  // base::trace_event::MemoryDumpProvider implementation.
+  bool OnMemoryDump(const base::trace_event::MemoryDumpArgs& args,
+                    base::trace_event::ProcessMemoryDump* pmd) override;
+
+  size_t budget() const { return budget_; }
+  void SetBudgetForTesting(size_t budget) { budget_ = budget; }
+  void SetTickClockForTesting(const base::TickClock* tick_clock) {
+    tick_clock_ = tick_clock;
+  }
+
+ private:
+  struct PoolInfo {
+    const char* category;
+    Pool* pool;
+  };
+
+  void EvictToLimit(size_t limit);
+
+  std::vector<PoolInfo> pools_;
+  size_t budget_;
+  const base::TickClock* tick_clock_;
+
+  DISALLOW_COPY_AND_ASSIGN(GpuMemoryArbiter);
+};
+
+}  // namespace gpu
+
+#endif  // GPU_COMMAND_BUFFER_SERVICE_GPU_MEMORY_ARBITER_H_
@@ -0,0 +1,133 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "gpu/command_buffer/service/gpu_memory_arbiter.h"
+
+#include <map>
+#include <string>
+
+#include "base/test/simple_test_tick_clock.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace gpu {
+namespace {
+
+// A pool of named resources that remembers when each was last used.
+class FakePool : public GpuMemoryArbiter::Pool {
+ public:
+  explicit FakePool(const base::TickClock* tick_clock)
+      : tick_clock_(tick_clock) {}
+  ~FakePool() override = default;
+
+  void Use(const std::string& name, size_t size) {
+    resources_[name] = {size, tick_clock_->NowTicks()};
+  }
+  bool Contains(const std::string& name) const {
+    return resources_.count(name);
+  }
+
+  // GpuMemoryArbiter::Pool implementation.
+  size_t GetCacheSize() const override {
+    size_t size = 0;
+    for (const auto& resource : resources_)
+      size += resource.second.size;
+    return size;
+  }
+  void EvictResourcesNotUsedSince(base::TimeTicks time) override {
+    for (auto it = resources_.begin(); it != resources_.end();) {
+      if (it->second.last_used < time)
+        it = resources_.erase(it);
+      else
+        ++it;
+    }
+  }
+
+ private:
+  struct Resource {
+    size_t size;
+    base::TimeTicks last_used;
+  };
+
+  const base::TickClock* tick_clock_;
+  std::map<std::string, Resource> resources_;
+};
+
+class GpuMemoryArbiterTest : public testing::Test {
+ public:
+  GpuMemoryArbiterTest()
+      : arbiter_(1000u),
+        first_pool_(&tick_clock_),
+        second_pool_(&tick_clock_) {
+    arbiter_.SetTickClockForTesting(&tick_clock_);
+    arbiter_.AddPool("first", &first_pool_);
+    arbiter_.AddPool("second", &second_pool_);
+  }
+
+ protected:
+  base::SimpleTestTickClock tick_clock_;
+  GpuMemoryArbiter arbiter_;
+  FakePool first_pool_;
+  FakePool second_pool_;
+};
+
+TEST_F(GpuMemoryArbiterTest, EnforceBudgetEvictsOldestAcrossPools) {
+  first_pool_.Use("a", 400u);
+  tick_clock_.Advance(base::TimeDelta::FromSeconds(20));
+  second_pool_.Use("b", 400u);
+  tick_clock_.Advance(base::TimeDelta::FromSeconds(20));
+  first_pool_.Use("c", 400u);
+  EXPECT_EQ(arbiter_.GetTotalCacheSize(), 1200u);
+
+  // Only the least recently used resource goes, even though it is in the same
+  // pool as the most recently used one.
+  arbiter_.EnforceBudget();
+  EXPECT_FALSE(first_pool_.Contains("a"));
+  EXPECT_TRUE(second_pool_.Contains("b"));
+  EXPECT_TRUE(first_pool_.Contains("c"));
+  EXPECT_EQ(arbiter_.GetTotalCacheSize(), 800u);
+}
+
+TEST_F(GpuMemoryArbiterTest, EnforceBudgetWithinBudget) {
+  first_pool_.Use("a", 500u);
+  tick_clock_.Advance(base::TimeDelta::FromMinutes(5));
+  second_pool_.Use("b", 500u);
+
+  arbiter_.EnforceBudget();
+  EXPECT_TRUE(first_pool_.Contains("a"));
+  EXPECT_TRUE(second_pool_.Contains("b"));
+}
+
+TEST_F(GpuMemoryArbiterTest, HandleMemoryPressure) {
+  first_pool_.Use("a", 200u);
+  tick_clock_.Advance(base::TimeDelta::FromSeconds(20));
+  second_pool_.Use("b", 200u);
+  tick_clock_.Advance(base::TimeDelta::FromSeconds(20));
+  first_pool_.Use("c", 200u);
+  tick_clock_.Advance(base::TimeDelta::FromSeconds(1));
+
+  // Moderate pressure shrinks to a quarter of the budget.
+  arbiter_.HandleMemoryPressure(
+      base::MemoryPressureListener::MEMORY_PRESSURE_LEVEL_MODERATE);
+  EXPECT_FALSE(first_pool_.Contains("a"));
+  EXPECT_FALSE(second_pool_.Contains("b"));
+  EXPECT_TRUE(first_pool_.Contains("c"));
+
+  // Critical pressure evicts everything that hasn't just been used.
+  arbiter_.HandleMemoryPressure(
+      base::MemoryPressureListener::MEMORY_PRESSURE_LEVEL_CRITICAL);
+  EXPECT_EQ(arbiter_.GetTotalCacheSize(), 0u);
+}
+
+TEST_F(GpuMemoryArbiterTest, RemovePool) {
+  first_pool_.Use("a", 2000u);
+  tick_clock_.Advance(base::TimeDelta::FromMinutes(5));
+  arbiter_.RemovePool(&first_pool_);
+
+  EXPECT_EQ(arbiter_.GetTotalCacheSize(), 0u);
+  arbiter_.EnforceBudget();
+  EXPECT_TRUE(first_pool_.Contains("a"));
+}
+
+}  // namespace
+}  // namespace gpu
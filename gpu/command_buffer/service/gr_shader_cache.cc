@@ -5,8 +5,12 @@
 #include "gpu/command_buffer/service/gr_shader_cache.h"
 
 #include <inttypes.h>
+#include <string.h>
 
 #include "base/base64.h"
+#include "base/bits.h"
+#include "base/metrics/histogram_macros.h"
+#include "base/strings/string_piece.h"
 #include "base/strings/stringprintf.h"
 #include "base/threading/thread_task_runner_handle.h"
 #include "base/trace_event/memory_dump_manager.h"
@@ -24,6 +28,36 @@ sk_sp<SkData> MakeData(const std::string& str) {
   return SkData::MakeWithCopy(str.c_str(), str.length());
 }
 
+// Shaders are stored on disk after a header with their use count. Shaders
+// stored without one are loaded with a use count of 0.
+constexpr uint32_t kDiskHeaderMagic = 0x47535543;  // "GSUC"
+
+struct DiskHeader {
+  uint32_t magic;
+  uint32_t use_count;
+};
+
+std::string AddDiskHeader(const SkData* data, uint32_t use_count) {
+  DiskHeader header = {kDiskHeaderMagic, use_count};
+  std::string disk_data(reinterpret_cast<const char*>(&header), sizeof(header));
+  disk_data.append(static_cast<const char*>(data->data()), data->size());
+  return disk_data;
+}
+
+base::StringPiece RemoveDiskHeader(const std::string& disk_data,
+                                   uint32_t* use_count) {
+  DiskHeader header;
+  if (disk_data.size() >= sizeof(header)) {
+    memcpy(&header, disk_data.data(), sizeof(header));
+    if (header.magic == kDiskHeaderMagic) {
+      *use_count = header.use_count;
+      return base::StringPiece(disk_data).substr(sizeof(header));
+    }
+  }
+  *use_count = 0u;
+  return disk_data;
+}
+
 }  // namespace
 
 GrShaderCache::GrShaderCache(size_t max_cache_size_bytes, Client* client)
@@ -47,11 +81,25 @@ sk_sp<SkData> GrShaderCache::load(const SkData& key) {
 
   CacheKey cache_key(SkData::MakeWithoutCopy(key.data(), key.size()));
   auto it = store_.Get(cache_key);
-  if (it == store_.end())
+  UMA_HISTOGRAM_BOOLEAN("GPU.GrShaderCache.CacheHit", it != store_.end());
+  if (it == store_.end()) {
+    last_miss_hash_ = cache_key.hash;
+    last_miss_time_ = base::TimeTicks::Now();
     return nullptr;
+  }
 
-  WriteToDisk(it->first, &it->second);
-  return it->second.data;
+  // Rewrite the shader with its use count each time the count doubles, so
+  // that the ranking on disk stays current without a write for every use.
+  CacheData& cache_data = it->second;
+  cache_data.unused_from_disk = false;
+  cache_data.use_count++;
+  if (cache_data.use_count > 1u &&
+      base::bits::IsPowerOfTwo(cache_data.use_count)) {
+    cache_data.pending_disk_write = true;
+  }
+
+  WriteToDisk(it->first, &cache_data);
+  return cache_data.data;
 }
 
 void GrShaderCache::store(const SkData& key, const SkData& data) {
@@ -63,14 +111,24 @@ void GrShaderCache::store(const SkData& key, const SkData& data) {
   EnforceLimits(data.size());
 
   CacheKey cache_key(SkData::MakeWithCopy(key.data(), key.size()));
+  if (!last_miss_time_.is_null() && last_miss_hash_ == cache_key.hash) {
+    UMA_HISTOGRAM_CUSTOM_MICROSECONDS_TIMES(
+        "GPU.GrShaderCache.CompileTime",
+        base::TimeTicks::Now() - last_miss_time_,
+        base::TimeDelta::FromMicroseconds(10), base::TimeDelta::FromSeconds(1),
+        50);
+    last_miss_time_ = base::TimeTicks();
+  }
+
+  CacheData cache_data(SkData::MakeWithCopy(data.data(), data.size()));
   auto existing_it = store_.Get(cache_key);
   if (existing_it != store_.end()) {
     // Skia may ignore the cached entry and regenerate a shader if it fails to
     // link, in which case replace the current version with the latest one.
+    cache_data.use_count = existing_it->second.use_count;
     EraseFromCache(existing_it);
   }
 
-  CacheData cache_data(SkData::MakeWithCopy(data.data(), data.size()));
   auto it = AddToCache(cache_key, std::move(cache_data));
 
   WriteToDisk(it->first, &it->second);
@@ -79,11 +137,11 @@ void GrShaderCache::store(const SkData& key, const SkData& data) {
 void GrShaderCache::PopulateCache(const std::string& key,
                                   const std::string& data) {
   TRACE_EVENT0("gpu", "GrShaderCache::PopulateCache");
-  if (data.length() > cache_size_limit_)
+  uint32_t use_count;
+  base::StringPiece shader = RemoveDiskHeader(data, &use_count);
+  if (shader.length() > cache_size_limit_)
     return;
 
-  EnforceLimits(data.size());
-
   // If we already have this in the cache, skia may have populated it before it
   // was loaded off the disk cache. Its better to keep the latest version
   // generated version than overwriting it here.
@@ -93,7 +151,12 @@ void GrShaderCache::PopulateCache(const std::string& key,
   if (store_.Get(cache_key) != store_.end())
     return;
 
-  CacheData cache_data(MakeData(data));
+  if (!EnforceLimitsForShaderFromDisk(shader.length(), use_count))
+    return;
+
+  CacheData cache_data(SkData::MakeWithCopy(shader.data(), shader.length()));
+  cache_data.use_count = use_count;
+  cache_data.unused_from_disk = true;
   auto it = AddToCache(cache_key, std::move(cache_data));
 
   // This was loaded off the disk cache, no need to push this back for disk
@@ -168,7 +231,8 @@ void GrShaderCache::WriteToDisk(const CacheKey& key, CacheData* data) {
 
   std::string encoded_key;
   base::Base64Encode(MakeString(key.data.get()), &encoded_key);
-  client_->StoreShader(encoded_key, MakeString(data->data.get()));
+  client_->StoreShader(encoded_key,
+                       AddDiskHeader(data->data.get(), data->use_count));
 }
 
 void GrShaderCache::EnforceLimits(size_t size_needed) {
@@ -178,6 +242,33 @@ void GrShaderCache::EnforceLimits(size_t size_needed) {
     EraseFromCache(store_.rbegin());
 }
 
+bool GrShaderCache::EnforceLimitsForShaderFromDisk(size_t size_needed,
+                                                   uint32_t use_count) {
+  DCHECK_LE(size_needed, cache_size_limit_);
+
+  while (size_needed + curr_size_bytes_ > cache_size_limit_) {
+    // Shaders that were used in this session are more relevant than any from
+    // disk, which otherwise replace each other in the order of their use
+    // counts.
+    auto least_used_it = store_.rend();
+    for (auto it = store_.rbegin(); it != store_.rend(); ++it) {
+      if (it->second.unused_from_disk &&
+          (least_used_it == store_.rend() ||
+           it->second.use_count < least_used_it->second.use_count)) {
+        least_used_it = it;
+      }
+    }
+    if (least_used_it == store_.rend()) {
+      EraseFromCache(store_.rbegin());
+      continue;
+    }
+    if (least_used_it->second.use_count >= use_count)
+      return false;
+    EraseFromCache(least_used_it);
+  }
+  return true;
+}
+
 GrShaderCache::ScopedCacheUse::ScopedCacheUse(GrShaderCache* cache,
                                               int32_t client_id)
     : cache_(cache) {
@@ -9,6 +9,7 @@
 #include "base/containers/mru_cache.h"
 #include "base/hash/hash.h"
 #include "base/memory/memory_pressure_listener.h"
+#include "base/time/time.h"
 #include "base/trace_event/memory_dump_provider.h"
 #include "gpu/gpu_gles2_export.h"
 #include "third_party/skia/include/gpu/GrContextOptions.h"
@@ -44,6 +45,9 @@ class GPU_GLES2_EXPORT GrShaderCache
   sk_sp<SkData> load(const SkData& key) override;
   void store(const SkData& key, const SkData& data) override;
 
+  // Adds a shader loaded from the disk cache. When the cache is full, the
+  // shaders that were used the most in previous sessions are kept, so that
+  // they don't need to be compiled again for the first frames.
   void PopulateCache(const std::string& key, const std::string& data);
   void CacheClientIdOnDisk(int32_t client_id);
   void PurgeMemory(
@@ -84,6 +88,13 @@ class GPU_GLES2_EXPORT GrShaderCache
 
     sk_sp<SkData> data;
     bool pending_disk_write = true;
+
+    // The number of times this shader was used, including previous sessions.
+    // It is stored on disk with the shader.
+    uint32_t use_count = 1u;
+
+    // Whether this was loaded from disk and hasn't been used since.
+    bool unused_from_disk = false;
   };
 
   struct CacheKeyHash {
@@ -100,6 +111,11 @@ class GPU_GLES2_EXPORT GrShaderCache
 
   void WriteToDisk(const CacheKey& key, CacheData* data);
 
+  // Makes room for a shader of |size_needed| bytes loaded from disk with
+  // |use_count|, by evicting shaders from disk that were used less. Returns
+  // false if the shader shouldn't be added.
+  bool EnforceLimitsForShaderFromDisk(size_t size_needed, uint32_t use_count);
+
   size_t cache_size_limit_;
   size_t curr_size_bytes_ = 0u;
   Store store_;
@@ -109,6 +125,11 @@ class GPU_GLES2_EXPORT GrShaderCache
 
   int32_t current_client_id_ = kInvalidClientId;
 
+  // The hash of the key and the time of the last load that missed the cache,
+  // to measure the time Skia takes to compile the shader before storing it.
+  size_t last_miss_hash_ = 0u;
+  base::TimeTicks last_miss_time_;
+
   DISALLOW_COPY_AND_ASSIGN(GrShaderCache);
 };
 
@@ -183,5 +183,80 @@ TEST_F(GrShaderCacheTest, PopulateFromDiskAfterStoring) {
   EXPECT_EQ(disk_cache_.size(), 1u);
 }
 
+TEST_F(GrShaderCacheTest, UseCountStoredOnDisk) {
+  int32_t regular_client_id = 3;
+  cache_.CacheClientIdOnDisk(regular_client_id);
+
+  auto key = SkData::MakeWithCopy(kShaderKey, strlen(kShaderKey));
+  auto shader = SkData::MakeWithCString(kShader);
+  {
+    GrShaderCache::ScopedCacheUse cache_use(&cache_, regular_client_id);
+    EXPECT_EQ(cache_.load(*key), nullptr);
+    cache_.store(*key, *shader);
+  }
+  ASSERT_EQ(disk_cache_.size(), 1u);
+  std::string first_write = disk_cache_.begin()->second;
+  EXPECT_GT(first_write.size(), shader->size());
+
+  // The shader is written again once its use count doubles.
+  {
+    GrShaderCache::ScopedCacheUse cache_use(&cache_, regular_client_id);
+    EXPECT_NE(cache_.load(*key), nullptr);
+  }
+  std::string second_write = disk_cache_.begin()->second;
+  EXPECT_NE(first_write, second_write);
+
+  // Loading the written shader in a new session keeps its use count and
+  // doesn't count it as part of the cache size.
+  GrShaderCache new_cache(kCacheLimit, this);
+  new_cache.PopulateCache(disk_cache_.begin()->first, second_write);
+  EXPECT_EQ(new_cache.curr_size_bytes_for_testing(), shader->size());
+  new_cache.CacheClientIdOnDisk(regular_client_id);
+  {
+    GrShaderCache::ScopedCacheUse cache_use(&new_cache, regular_client_id);
+    auto cached_shader = new_cache.load(*key);
+    ASSERT_TRUE(cached_shader);
+    EXPECT_TRUE(cached_shader->equals(shader.get()));
+    EXPECT_NE(new_cache.load(*key), nullptr);
+  }
+  EXPECT_NE(disk_cache_.begin()->second, second_write);
+}
+
+TEST_F(GrShaderCacheTest, PopulateKeepsMostUsedShaders) {
+  int32_t regular_client_id = 3;
+  cache_.CacheClientIdOnDisk(regular_client_id);
+
+  // Store the same shader under three keys with use counts of 1, 2 and 4.
+  auto shader = SkData::MakeUninitialized(kCacheLimit / 2);
+  const char* keys[] = {"key1", "key2", "key4"};
+  for (int i = 0; i < 3; ++i) {
+    auto key = SkData::MakeWithCString(keys[i]);
+    GrShaderCache::ScopedCacheUse cache_use(&cache_, regular_client_id);
+    EXPECT_EQ(cache_.load(*key), nullptr);
+    cache_.store(*key, *shader);
+    for (int use = 1; use < 1 << i; ++use)
+      EXPECT_NE(cache_.load(*key), nullptr);
+  }
+  ASSERT_EQ(disk_cache_.size(), 3u);
+
+  // Only two shaders fit in a new session, so the least used one is dropped
+  // regardless of the order the shaders are loaded in.
+  auto encode_key = [](const char* key) {
+    // Keys made with SkData::MakeWithCString() include the terminator.
+    std::string encoded_key;
+    base::Base64Encode(std::string(key, strlen(key) + 1), &encoded_key);
+    return encoded_key;
+  };
+  GrShaderCache new_cache(kCacheLimit, this);
+  for (const char* key : {"key2", "key4", "key1"})
+    new_cache.PopulateCache(encode_key(key), disk_cache_[encode_key(key)]);
+  EXPECT_EQ(new_cache.num_cache_entries(), 2u);
+
+  GrShaderCache::ScopedCacheUse cache_use(&new_cache, regular_client_id);
+  EXPECT_EQ(new_cache.load(*SkData::MakeWithCString("key1")), nullptr);
+  EXPECT_NE(new_cache.load(*SkData::MakeWithCString("key2")), nullptr);
+  EXPECT_NE(new_cache.load(*SkData::MakeWithCString("key4")), nullptr);
+}
+
 }  // namespace raster
 }  // namespace gpu
@@ -449,6 +449,9 @@ class RasterDecoderImpl final : public RasterDecoder,
   void DeletePaintCachePathsINTERNALHelper(
       GLsizei n,
       const volatile GLuint* paint_cache_ids);
+  void DeletePaintCacheRecordsINTERNALHelper(
+      GLsizei n,
+      const volatile GLuint* paint_cache_ids);
   void DoClearPaintCacheINTERNAL();
 
 #if defined(NDEBUG)
@@ -1974,6 +1977,19 @@ void RasterDecoderImpl::DeletePaintCachePathsINTERNALHelper(
   paint_cache_->Purge(cc::PaintCacheDataType::kPath, n, paint_cache_ids);
 }
 
+void RasterDecoderImpl::DeletePaintCacheRecordsINTERNALHelper(
+    GLsizei n,
+    const volatile GLuint* paint_cache_ids) {
+  if (!supports_oop_raster_) {
+    LOCAL_SET_GL_ERROR(GL_INVALID_OPERATION,
+                       "glDeletePaintCacheEntriesINTERNAL",
+                       "No chromium raster support");
+    return;
+  }
+
+  paint_cache_->Purge(cc::PaintCacheDataType::kRecord, n, paint_cache_ids);
+}
+
 void RasterDecoderImpl::DoClearPaintCacheINTERNAL() {
   if (!supports_oop_raster_) {
     LOCAL_SET_GL_ERROR(GL_INVALID_OPERATION, "glClearPaintCacheINTERNAL",
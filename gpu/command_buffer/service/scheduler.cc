@@ -59,12 +59,21 @@ Scheduler::Sequence::WaitFence::~WaitFence() = default;
 Scheduler::Sequence::WaitFence& Scheduler::Sequence::WaitFence::operator=(
     WaitFence&& other) = default;
 
-Scheduler::Sequence::Sequence(Scheduler* scheduler,
-                              SequenceId sequence_id,
-                              SchedulingPriority priority,
-                              scoped_refptr<SyncPointOrderData> order_data)
+Scheduler::PerThreadState::PerThreadState() = default;
+Scheduler::PerThreadState::PerThreadState(PerThreadState&& other) = default;
+Scheduler::PerThreadState::~PerThreadState() = default;
+Scheduler::PerThreadState& Scheduler::PerThreadState::operator=(
+    PerThreadState&& other) = default;
+
+Scheduler::Sequence::Sequence(
+    Scheduler* scheduler,
+    SequenceId sequence_id,
+    scoped_refptr<base::SingleThreadTaskRunner> task_runner,
+    SchedulingPriority priority,
+    scoped_refptr<SyncPointOrderData> order_data)
     : scheduler_(scheduler),
       sequence_id_(sequence_id),
+      task_runner_(std::move(task_runner)),
       default_priority_(priority),
       current_priority_(priority),
       order_data_(std::move(order_data)) {}
@@ -300,16 +309,34 @@ Scheduler::Scheduler(scoped_refptr<base::SingleThreadTaskRunner> task_runner,
 
 Scheduler::~Scheduler() {
   DCHECK(thread_checker_.CalledOnValidThread());
+#if DCHECK_IS_ON()
+  // RunNextTask() is bound to |weak_ptr_| only on |task_runner_|. Tasks posted
+  // to other task runners would run on a destroyed scheduler.
+  base::AutoLock auto_lock(lock_);
+  for (const auto& kv : per_thread_state_map_) {
+    DCHECK(kv.first == task_runner_.get() || !kv.second.running)
+        << "Scheduler destroyed with a pending task on another task runner";
+  }
+#endif
 }
 
 SequenceId Scheduler::CreateSequence(SchedulingPriority priority) {
+  return CreateSequence(priority, task_runner_);
+}
+
+SequenceId Scheduler::CreateSequence(
+    SchedulingPriority priority,
+    scoped_refptr<base::SingleThreadTaskRunner> task_runner) {
   DCHECK(thread_checker_.CalledOnValidThread());
+  DCHECK(task_runner);
   base::AutoLock auto_lock(lock_);
   scoped_refptr<SyncPointOrderData> order_data =
       sync_point_manager_->CreateSyncPointOrderData();
   SequenceId sequence_id = order_data->sequence_id();
-  auto sequence = std::make_unique<Sequence>(this, sequence_id, priority,
-                                             std::move(order_data));
+  per_thread_state_map_[task_runner.get()].sequence_count++;
+  auto sequence =
+      std::make_unique<Sequence>(this, sequence_id, std::move(task_runner),
+                                 priority, std::move(order_data));
   sequences_.emplace(sequence_id, std::move(sequence));
   return sequence_id;
 }
@@ -320,10 +347,17 @@ void Scheduler::DestroySequence(SequenceId sequence_id) {
 
   Sequence* sequence = GetSequence(sequence_id);
   DCHECK(sequence);
+  // The key stays valid for the lookup below even if the sequence held the
+  // last reference to the task runner.
+  base::SingleThreadTaskRunner* task_runner = sequence->task_runner().get();
+  PerThreadState& thread_state = GetPerThreadState(task_runner);
   if (sequence->scheduled())
-    rebuild_scheduling_queue_ = true;
+    thread_state.rebuild_scheduling_queue = true;
+  DCHECK_GT(thread_state.sequence_count, 0);
+  thread_state.sequence_count--;
 
   sequences_.erase(sequence_id);
+  MaybeErasePerThreadState(task_runner);
 }
 
 Scheduler::Sequence* Scheduler::GetSequence(SequenceId sequence_id) {
@@ -334,6 +368,25 @@ Scheduler::Sequence* Scheduler::GetSequence(SequenceId sequence_id) {
   return nullptr;
 }
 
+Scheduler::PerThreadState& Scheduler::GetPerThreadState(
+    base::SingleThreadTaskRunner* task_runner) {
+  lock_.AssertAcquired();
+  auto it = per_thread_state_map_.find(task_runner);
+  DCHECK(it != per_thread_state_map_.end());
+  return it->second;
+}
+
+void Scheduler::MaybeErasePerThreadState(
+    base::SingleThreadTaskRunner* task_runner) {
+  lock_.AssertAcquired();
+  auto it = per_thread_state_map_.find(task_runner);
+  DCHECK(it != per_thread_state_map_.end());
+  // A pending RunNextTask() still needs the state. It calls this again when it
+  // finds nothing to run.
+  if (it->second.sequence_count == 0 && !it->second.running)
+    per_thread_state_map_.erase(it);
+}
+
 void Scheduler::EnableSequence(SequenceId sequence_id) {
   base::AutoLock auto_lock(lock_);
   Sequence* sequence = GetSequence(sequence_id);
@@ -406,33 +459,43 @@ void Scheduler::ScheduleTaskHelper(Task task) {
 
 void Scheduler::ContinueTask(SequenceId sequence_id,
                              base::OnceClosure closure) {
-  DCHECK(thread_checker_.CalledOnValidThread());
   base::AutoLock auto_lock(lock_);
   Sequence* sequence = GetSequence(sequence_id);
   DCHECK(sequence);
+  DCHECK(sequence->task_runner()->BelongsToCurrentThread());
   sequence->ContinueTask(std::move(closure));
 }
 
 bool Scheduler::ShouldYield(SequenceId sequence_id) {
-  DCHECK(thread_checker_.CalledOnValidThread());
   base::AutoLock auto_lock(lock_);
 
-  RebuildSchedulingQueue();
-
-  if (scheduling_queue_.empty())
-    return false;
-
   Sequence* running_sequence = GetSequence(sequence_id);
   DCHECK(running_sequence);
   DCHECK(running_sequence->running());
 
-  Sequence* next_sequence = GetSequence(scheduling_queue_.front().sequence_id);
+  // Only sequences of the same task runner compete for a thread.
+  base::SingleThreadTaskRunner* task_runner =
+      running_sequence->task_runner().get();
+  RebuildSchedulingQueue(task_runner);
+
+  const std::vector<SchedulingState>& scheduling_queue =
+      GetPerThreadState(task_runner).scheduling_queue;
+  if (scheduling_queue.empty())
+    return false;
+
+  Sequence* next_sequence = GetSequence(scheduling_queue.front().sequence_id);
   DCHECK(next_sequence);
   DCHECK(next_sequence->scheduled());
 
   return running_sequence->ShouldYieldTo(next_sequence);
 }
 
+bool Scheduler::HasPerThreadStateForTesting(
+    base::SingleThreadTaskRunner* task_runner) const {
+  base::AutoLock auto_lock(lock_);
+  return per_thread_state_map_.find(task_runner) != per_thread_state_map_.end();
+}
+
 void Scheduler::SyncTokenFenceReleased(const SyncToken& sync_token,
                                        uint32_t order_num,
                                        SequenceId release_sequence_id,
@@ -446,68 +509,97 @@ void Scheduler::SyncTokenFenceReleased(const SyncToken& sync_token,
 
 void Scheduler::TryScheduleSequence(Sequence* sequence) {
   lock_.AssertAcquired();
+  base::SingleThreadTaskRunner* task_runner = sequence->task_runner().get();
+  PerThreadState& thread_state = GetPerThreadState(task_runner);
 
   if (sequence->running()) {
     // Update priority of running sequence because of sync token releases.
-    DCHECK(running_);
+    DCHECK(thread_state.running);
     sequence->UpdateRunningPriority();
   } else if (sequence->NeedsRescheduling()) {
     // Rebuild scheduling queue if priority changed for a scheduled sequence.
-    DCHECK(running_);
+    DCHECK(thread_state.running);
     DCHECK(sequence->IsRunnable());
-    rebuild_scheduling_queue_ = true;
+    thread_state.rebuild_scheduling_queue = true;
   } else if (!sequence->scheduled() && sequence->IsRunnable()) {
     // Insert into scheduling queue if sequence isn't already scheduled.
     SchedulingState scheduling_state = sequence->SetScheduled();
-    scheduling_queue_.push_back(scheduling_state);
-    std::push_heap(scheduling_queue_.begin(), scheduling_queue_.end(),
+    thread_state.scheduling_queue.push_back(scheduling_state);
+    std::push_heap(thread_state.scheduling_queue.begin(),
+                   thread_state.scheduling_queue.end(),
                    &SchedulingState::Comparator);
-    if (!running_) {
-      TRACE_EVENT_ASYNC_BEGIN0("gpu", "Scheduler::Running", this);
-      running_ = true;
-      task_runner_->PostTask(
-          FROM_HERE, base::BindOnce(&Scheduler::RunNextTask, weak_ptr_));
+    if (!thread_state.running) {
+      TRACE_EVENT_ASYNC_BEGIN0("gpu", "Scheduler::Running", task_runner);
+      thread_state.running = true;
+      PostRunNextTask(task_runner);
     }
   }
 }
 
-void Scheduler::RebuildSchedulingQueue() {
-  DCHECK(thread_checker_.CalledOnValidThread());
+void Scheduler::RebuildSchedulingQueue(
+    base::SingleThreadTaskRunner* task_runner) {
+  DCHECK(task_runner->BelongsToCurrentThread());
   lock_.AssertAcquired();
 
-  if (!rebuild_scheduling_queue_)
+  PerThreadState& thread_state = GetPerThreadState(task_runner);
+  if (!thread_state.rebuild_scheduling_queue)
     return;
-  rebuild_scheduling_queue_ = false;
+  thread_state.rebuild_scheduling_queue = false;
 
-  scheduling_queue_.clear();
+  std::vector<SchedulingState>& scheduling_queue =
+      thread_state.scheduling_queue;
+  scheduling_queue.clear();
   for (const auto& kv : sequences_) {
     Sequence* sequence = kv.second.get();
-    if (!sequence->IsRunnable() || sequence->running())
+    if (sequence->task_runner() != task_runner || !sequence->IsRunnable() ||
+        sequence->running()) {
       continue;
+    }
     SchedulingState scheduling_state = sequence->SetScheduled();
-    scheduling_queue_.push_back(scheduling_state);
+    scheduling_queue.push_back(scheduling_state);
   }
 
-  std::make_heap(scheduling_queue_.begin(), scheduling_queue_.end(),
+  std::make_heap(scheduling_queue.begin(), scheduling_queue.end(),
                  &SchedulingState::Comparator);
 }
 
-void Scheduler::RunNextTask() {
-  DCHECK(thread_checker_.CalledOnValidThread());
+void Scheduler::PostRunNextTask(base::SingleThreadTaskRunner* task_runner) {
+  lock_.AssertAcquired();
+  if (task_runner == task_runner_.get()) {
+    task_runner->PostTask(FROM_HERE,
+                          base::BindOnce(&Scheduler::RunNextTask, weak_ptr_,
+                                         base::WrapRefCounted(task_runner)));
+  } else {
+    // |weak_ptr_| can only be dereferenced on the thread of |task_runner_|.
+    // The scheduler outlives the threads of other task runners instead.
+    task_runner->PostTask(FROM_HERE,
+                          base::BindOnce(&Scheduler::RunNextTask,
+                                         base::Unretained(this),
+                                         base::WrapRefCounted(task_runner)));
+  }
+}
+
+void Scheduler::RunNextTask(
+    scoped_refptr<base::SingleThreadTaskRunner> task_runner) {
+  DCHECK(task_runner->BelongsToCurrentThread());
   base::AutoLock auto_lock(lock_);
 
-  RebuildSchedulingQueue();
+  RebuildSchedulingQueue(task_runner.get());
 
-  if (scheduling_queue_.empty()) {
-    TRACE_EVENT_ASYNC_END0("gpu", "Scheduler::Running", this);
-    running_ = false;
+  PerThreadState& thread_state = GetPerThreadState(task_runner.get());
+  std::vector<SchedulingState>& scheduling_queue =
+      thread_state.scheduling_queue;
+  if (scheduling_queue.empty()) {
+    TRACE_EVENT_ASYNC_END0("gpu", "Scheduler::Running", task_runner.get());
+    thread_state.running = false;
+    MaybeErasePerThreadState(task_runner.get());
     return;
   }
 
-  std::pop_heap(scheduling_queue_.begin(), scheduling_queue_.end(),
+  std::pop_heap(scheduling_queue.begin(), scheduling_queue.end(),
                 &SchedulingState::Comparator);
-  SchedulingState state = scheduling_queue_.back();
-  scheduling_queue_.pop_back();
+  SchedulingState state = scheduling_queue.back();
+  scheduling_queue.pop_back();
 
   TRACE_EVENT1("gpu", "Scheduler::RunNextTask", "state", state.AsValue());
 
@@ -529,20 +621,21 @@ void Scheduler::RunNextTask() {
       order_data->FinishProcessingOrderNumber(order_num);
   }
 
-  // Check if sequence hasn't been destroyed.
+  // Check if sequence hasn't been destroyed. The scheduling state of the
+  // thread may have been reallocated while the lock was released.
   sequence = GetSequence(state.sequence_id);
   if (sequence) {
     sequence->FinishTask();
     if (sequence->IsRunnable()) {
+      std::vector<SchedulingState>& queue =
+          GetPerThreadState(task_runner.get()).scheduling_queue;
       SchedulingState scheduling_state = sequence->SetScheduled();
-      scheduling_queue_.push_back(scheduling_state);
-      std::push_heap(scheduling_queue_.begin(), scheduling_queue_.end(),
-                     &SchedulingState::Comparator);
+      queue.push_back(scheduling_state);
+      std::push_heap(queue.begin(), queue.end(), &SchedulingState::Comparator);
     }
   }
 
-  task_runner_->PostTask(FROM_HERE,
-                         base::BindOnce(&Scheduler::RunNextTask, weak_ptr_));
+  PostRunNextTask(task_runner.get());
 }
 
 }  // namespace gpu
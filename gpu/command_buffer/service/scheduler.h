@@ -58,6 +58,17 @@ class GPU_EXPORT Scheduler {
   // release clients. Sequences start off as enabled (see |EnableSequence|).
   SequenceId CreateSequence(SchedulingPriority priority);
 
+  // Create a sequence whose tasks run on |task_runner| instead of the task
+  // runner of the scheduler. Sequences of different task runners run in
+  // parallel, ordered only by the sync token fences of their tasks, so they
+  // must not share state that isn't thread safe, such as a GL context or a
+  // GrContext. The scheduler must not be destroyed while it has a task posted
+  // to |task_runner|, so the sequences must be destroyed first, and the
+  // pending tasks of |task_runner| run.
+  SequenceId CreateSequence(
+      SchedulingPriority priority,
+      scoped_refptr<base::SingleThreadTaskRunner> task_runner);
+
   // Destroy the sequence and run any scheduled tasks immediately.
   void DestroySequence(SequenceId sequence_id);
 
@@ -90,6 +101,11 @@ class GPU_EXPORT Scheduler {
   // If the sequence should yield so that a higher priority sequence may run.
   bool ShouldYield(SequenceId sequence_id);
 
+  // Returns whether scheduling state is kept for |task_runner|, which is only
+  // the case while it has sequences or a pending task of the scheduler.
+  bool HasPerThreadStateForTesting(
+      base::SingleThreadTaskRunner* task_runner) const;
+
  private:
 
   struct SchedulingState {
@@ -119,6 +135,7 @@ class GPU_EXPORT Scheduler {
    public:
     Sequence(Scheduler* scheduler,
              SequenceId sequence_id,
+             scoped_refptr<base::SingleThreadTaskRunner> task_runner,
              SchedulingPriority priority,
              scoped_refptr<SyncPointOrderData> order_data);
 
@@ -126,6 +143,10 @@ class GPU_EXPORT Scheduler {
 
     SequenceId sequence_id() const { return sequence_id_; }
 
+    const scoped_refptr<base::SingleThreadTaskRunner>& task_runner() const {
+      return task_runner_;
+    }
+
     const scoped_refptr<SyncPointOrderData>& order_data() const {
       return order_data_;
     }
@@ -271,6 +292,7 @@ class GPU_EXPORT Scheduler {
 
     Scheduler* const scheduler_;
     const SequenceId sequence_id_;
+    scoped_refptr<base::SingleThreadTaskRunner> task_runner_;
 
     const SchedulingPriority default_priority_;
     SchedulingPriority current_priority_;
@@ -297,6 +319,28 @@ class GPU_EXPORT Scheduler {
     DISALLOW_COPY_AND_ASSIGN(Sequence);
   };
 
+  // The scheduling state of the sequences of a task runner.
+  struct PerThreadState {
+    PerThreadState();
+    PerThreadState(PerThreadState&& other);
+    ~PerThreadState();
+    PerThreadState& operator=(PerThreadState&& other);
+
+    // If a task to run the next task of the sequences is posted.
+    bool running = false;
+
+    // Used as a priority queue for scheduling sequences. Min heap of
+    // SchedulingState with highest priority (lowest order) in front.
+    std::vector<SchedulingState> scheduling_queue;
+
+    // If the scheduling queue needs to be rebuild because a sequence changed
+    // priority.
+    bool rebuild_scheduling_queue = false;
+
+    // Number of sequences of the task runner.
+    int sequence_count = 0;
+  };
+
   void SyncTokenFenceReleased(const SyncToken& sync_token,
                               uint32_t order_num,
                               SequenceId release_sequence_id,
@@ -306,11 +350,19 @@ class GPU_EXPORT Scheduler {
 
   void TryScheduleSequence(Sequence* sequence);
 
-  void RebuildSchedulingQueue();
+  void RebuildSchedulingQueue(base::SingleThreadTaskRunner* task_runner);
 
   Sequence* GetSequence(SequenceId sequence_id);
 
-  void RunNextTask();
+  PerThreadState& GetPerThreadState(base::SingleThreadTaskRunner* task_runner);
+
+  // Erases the state of |task_runner| once it has neither sequences nor a
+  // pending RunNextTask().
+  void MaybeErasePerThreadState(base::SingleThreadTaskRunner* task_runner);
+
+  void PostRunNextTask(base::SingleThreadTaskRunner* task_runner);
+
+  void RunNextTask(scoped_refptr<base::SingleThreadTaskRunner> task_runner);
 
   scoped_refptr<base::SingleThreadTaskRunner> task_runner_;
 
@@ -319,17 +371,10 @@ class GPU_EXPORT Scheduler {
   mutable base::Lock lock_;
 
   // The following are protected by |lock_|.
-  bool running_ = false;
-
   base::flat_map<SequenceId, std::unique_ptr<Sequence>> sequences_;
 
-  // Used as a priority queue for scheduling sequences. Min heap of
-  // SchedulingState with highest priority (lowest order) in front.
-  std::vector<SchedulingState> scheduling_queue_;
-
-  // If the scheduling queue needs to be rebuild because a sequence changed
-  // priority.
-  bool rebuild_scheduling_queue_ = false;
+  base::flat_map<base::SingleThreadTaskRunner*, PerThreadState>
+      per_thread_state_map_;
 
   base::ThreadChecker thread_checker_;
 
@@ -514,6 +514,112 @@ TEST_F(SchedulerTest, ClientWaitIsPrioritized) {
   EXPECT_TRUE(ran2);
 }
 
+TEST_F(SchedulerTest, SequencesOnDifferentTaskRunners) {
+  auto worker_task_runner = base::MakeRefCounted<base::TestSimpleTaskRunner>();
+
+  SequenceId sequence_id1 =
+      scheduler()->CreateSequence(SchedulingPriority::kNormal);
+  CommandBufferNamespace namespace_id = CommandBufferNamespace::GPU_IO;
+  CommandBufferId command_buffer_id = CommandBufferId::FromUnsafeValue(1);
+  scoped_refptr<SyncPointClientState> release_state =
+      sync_point_manager()->CreateSyncPointClientState(
+          namespace_id, command_buffer_id, sequence_id1);
+
+  SequenceId sequence_id2 = scheduler()->CreateSequence(
+      SchedulingPriority::kNormal, worker_task_runner);
+  SequenceId sequence_id3 = scheduler()->CreateSequence(
+      SchedulingPriority::kNormal, worker_task_runner);
+
+  // Independent sequences are scheduled on their own task runners.
+  bool ran1 = false;
+  scheduler()->ScheduleTask(
+      Scheduler::Task(sequence_id1, GetClosure([&] {
+                        release_state->ReleaseFenceSync(1);
+                        ran1 = true;
+                      }),
+                      std::vector<SyncToken>()));
+  bool ran2 = false;
+  scheduler()->ScheduleTask(Scheduler::Task(
+      sequence_id2, GetClosure([&] {
+        // Sequences of other task runners don't compete for this thread.
+        EXPECT_FALSE(scheduler()->ShouldYield(sequence_id2));
+        ran2 = true;
+      }),
+      std::vector<SyncToken>()));
+
+  // A dependency on another task runner is ordered by the sync token.
+  bool ran3 = false;
+  SyncToken sync_token(namespace_id, command_buffer_id, 1);
+  scheduler()->ScheduleTask(Scheduler::Task(
+      sequence_id3, GetClosure([&] { ran3 = true; }), {sync_token}));
+
+  worker_task_runner->RunPendingTasks();
+  EXPECT_FALSE(ran1);
+  EXPECT_TRUE(ran2);
+  EXPECT_FALSE(ran3);
+
+  task_runner()->RunPendingTasks();
+  EXPECT_TRUE(ran1);
+  EXPECT_TRUE(sync_point_manager()->IsSyncTokenReleased(sync_token));
+
+  // The release is handled on the scheduler's task runner, but the waiting
+  // sequence runs on its own.
+  task_runner()->RunPendingTasks();
+  EXPECT_FALSE(ran3);
+  worker_task_runner->RunPendingTasks();
+  EXPECT_TRUE(ran3);
+
+  release_state->Destroy();
+  scheduler()->DestroySequence(sequence_id1);
+  scheduler()->DestroySequence(sequence_id2);
+  scheduler()->DestroySequence(sequence_id3);
+
+  // The scheduler must not be destroyed with a task pending on another task
+  // runner.
+  worker_task_runner->RunPendingTasks();
+}
+
+TEST_F(SchedulerTest, PerThreadStateErasedWithLastSequence) {
+  auto worker_task_runner = base::MakeRefCounted<base::TestSimpleTaskRunner>();
+  EXPECT_FALSE(
+      scheduler()->HasPerThreadStateForTesting(worker_task_runner.get()));
+
+  SequenceId sequence_id1 = scheduler()->CreateSequence(
+      SchedulingPriority::kNormal, worker_task_runner);
+  SequenceId sequence_id2 = scheduler()->CreateSequence(
+      SchedulingPriority::kNormal, worker_task_runner);
+  EXPECT_TRUE(
+      scheduler()->HasPerThreadStateForTesting(worker_task_runner.get()));
+
+  // The state is kept while the task runner has a sequence.
+  scheduler()->DestroySequence(sequence_id1);
+  EXPECT_TRUE(
+      scheduler()->HasPerThreadStateForTesting(worker_task_runner.get()));
+
+  // Without a pending task, destroying the last sequence erases the state.
+  scheduler()->DestroySequence(sequence_id2);
+  EXPECT_FALSE(
+      scheduler()->HasPerThreadStateForTesting(worker_task_runner.get()));
+
+  // With a pending task, the state is erased when the task finds nothing more
+  // to run.
+  SequenceId sequence_id3 = scheduler()->CreateSequence(
+      SchedulingPriority::kNormal, worker_task_runner);
+  bool ran = false;
+  scheduler()->ScheduleTask(Scheduler::Task(
+      sequence_id3, GetClosure([&] { ran = true; }), std::vector<SyncToken>()));
+  EXPECT_TRUE(worker_task_runner->HasPendingTask());
+  scheduler()->DestroySequence(sequence_id3);
+  EXPECT_TRUE(
+      scheduler()->HasPerThreadStateForTesting(worker_task_runner.get()));
+
+  worker_task_runner->RunPendingTasks();
+  EXPECT_FALSE(ran);
+  EXPECT_FALSE(worker_task_runner->HasPendingTask());
+  EXPECT_FALSE(
+      scheduler()->HasPerThreadStateForTesting(worker_task_runner.get()));
+}
+
 TEST_F(SchedulerTest, StreamPriorities) {
   SequenceId seq_id1 = scheduler()->CreateSequence(SchedulingPriority::kLow);
   SequenceId seq_id2 = scheduler()->CreateSequence(SchedulingPriority::kNormal);
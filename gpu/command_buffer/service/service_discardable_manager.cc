@@ -106,8 +106,9 @@ void ServiceDiscardableManager::InsertLockedTexture(
   }
 
   total_size_ += texture_size;
-  entries_.Put({texture_id, texture_manager},
-               GpuDiscardableEntry{handle, texture_size});
+  auto it = entries_.Put({texture_id, texture_manager},
+                         GpuDiscardableEntry{handle, texture_size});
+  it->second.last_used = base::TimeTicks::Now();
   EnforceCacheSizeLimit(cache_size_limit_);
 }
 
@@ -121,6 +122,7 @@ bool ServiceDiscardableManager::UnlockTexture(
   if (found == entries_.end())
     return false;
 
+  found->second.last_used = base::TimeTicks::Now();
   found->second.handle.Unlock();
   if (--found->second.service_ref_count_ == 0) {
     found->second.unlocked_texture_ref =
@@ -181,6 +183,7 @@ void ServiceDiscardableManager::OnTextureSizeChanged(
   total_size_ -= found->second.size;
   found->second.size = new_size;
   total_size_ += found->second.size;
+  found->second.last_used = base::TimeTicks::Now();
 
   EnforceCacheSizeLimit(cache_size_limit_);
 }
@@ -192,9 +195,23 @@ void ServiceDiscardableManager::HandleMemoryPressure(
   EnforceCacheSizeLimit(limit);
 }
 
+size_t ServiceDiscardableManager::GetCacheSize() const {
+  return total_size_;
+}
+
+void ServiceDiscardableManager::EvictResourcesNotUsedSince(
+    base::TimeTicks time) {
+  EvictEntries(0u, time);
+}
+
 void ServiceDiscardableManager::EnforceCacheSizeLimit(size_t limit) {
+  EvictEntries(limit, base::TimeTicks::Max());
+}
+
+void ServiceDiscardableManager::EvictEntries(size_t limit,
+                                             base::TimeTicks not_used_since) {
   for (auto it = entries_.rbegin(); it != entries_.rend();) {
-    if (total_size_ <= limit) {
+    if (total_size_ <= limit || it->second.last_used >= not_used_since) {
       return;
     }
     if (!it->second.handle.Delete()) {
@@ -11,6 +11,7 @@
 #include "base/memory/memory_pressure_listener.h"
 #include "gpu/command_buffer/common/discardable_handle.h"
 #include "gpu/command_buffer/service/context_group.h"
+#include "gpu/command_buffer/service/gpu_memory_arbiter.h"
 #include "gpu/gpu_gles2_export.h"
 
 namespace gpu {
@@ -24,10 +25,11 @@ GPU_GLES2_EXPORT size_t DiscardableCacheSizeLimitForPressure(
     size_t base_cache_limit,
     base::MemoryPressureListener::MemoryPressureLevel memory_pressure_level);
 
-class GPU_GLES2_EXPORT ServiceDiscardableManager {
+class GPU_GLES2_EXPORT ServiceDiscardableManager
+    : public GpuMemoryArbiter::Pool {
  public:
   ServiceDiscardableManager();
-  ~ServiceDiscardableManager();
+  ~ServiceDiscardableManager() override;
 
   void InsertLockedTexture(uint32_t texture_id,
                            size_t texture_size,
@@ -77,8 +79,15 @@ class GPU_GLES2_EXPORT ServiceDiscardableManager {
   void HandleMemoryPressure(
       base::MemoryPressureListener::MemoryPressureLevel memory_pressure_level);
 
+  // GpuMemoryArbiter::Pool implementation.
+  size_t GetCacheSize() const override;
+  void EvictResourcesNotUsedSince(base::TimeTicks time) override;
+
  private:
   void EnforceCacheSizeLimit(size_t limit);
+  // Evicts unlocked entries, least recently used first, until the cache is
+  // within |limit| or the next entry has been used since |not_used_since|.
+  void EvictEntries(size_t limit, base::TimeTicks not_used_since);
 
   struct GpuDiscardableEntry {
    public:
@@ -94,6 +103,9 @@ class GPU_GLES2_EXPORT ServiceDiscardableManager {
     // can be locked out of band with the command buffer.
     uint32_t service_ref_count_ = 1;
     size_t size;
+    // Updated whenever the entry moves to the front of |entries_|, so that
+    // the entries are also ordered by this.
+    base::TimeTicks last_used;
   };
   struct GpuDiscardableEntryKey {
     uint32_t texture_id;
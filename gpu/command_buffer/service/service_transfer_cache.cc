@@ -59,7 +59,9 @@ void DumpMemoryForImageTransferCacheEntry(
 ServiceTransferCache::CacheEntryInternal::CacheEntryInternal(
     base::Optional<ServiceDiscardableHandle> handle,
     std::unique_ptr<cc::ServiceTransferCacheEntry> entry)
-    : handle(handle), entry(std::move(entry)) {}
+    : handle(handle),
+      entry(std::move(entry)),
+      last_used(base::TimeTicks::Now()) {}
 
 ServiceTransferCache::CacheEntryInternal::~CacheEntryInternal() {}
 
@@ -159,6 +161,7 @@ cc::ServiceTransferCacheEntry* ServiceTransferCache::GetEntry(
   auto found = entries_.Get(key);
   if (found == entries_.end())
     return nullptr;
+  found->second.last_used = base::TimeTicks::Now();
   return found->second.entry.get();
 }
 
@@ -197,6 +200,24 @@ void ServiceTransferCache::PurgeMemory(
   cache_size_limit_ = DiscardableCacheSizeLimit();
 }
 
+size_t ServiceTransferCache::GetCacheSize() const {
+  return total_size_;
+}
+
+void ServiceTransferCache::EvictResourcesNotUsedSince(base::TimeTicks time) {
+  for (auto it = entries_.rbegin(); it != entries_.rend();) {
+    if (it->second.last_used >= time)
+      return;
+    if (it->second.handle && !it->second.handle->Delete()) {
+      ++it;
+      continue;
+    }
+
+    total_size_ -= it->second.entry->CachedSize();
+    it = entries_.Erase(it);
+  }
+}
+
 void ServiceTransferCache::DeleteAllEntriesForDecoder(int decoder_id) {
   for (auto it = entries_.rbegin(); it != entries_.rend();) {
     if (it->first.decoder_id != decoder_id) {
@@ -16,6 +16,7 @@
 #include "cc/paint/transfer_cache_entry.h"
 #include "gpu/command_buffer/common/discardable_handle.h"
 #include "gpu/command_buffer/service/context_group.h"
+#include "gpu/command_buffer/service/gpu_memory_arbiter.h"
 #include "gpu/gpu_gles2_export.h"
 #include "third_party/skia/include/core/SkRefCnt.h"
 
@@ -35,7 +36,8 @@ namespace gpu {
 // cache limits. If the cache exceeds its specified limits, unlocked transfer
 // cache entries may be deleted.
 class GPU_GLES2_EXPORT ServiceTransferCache
-    : public base::trace_event::MemoryDumpProvider {
+    : public base::trace_event::MemoryDumpProvider,
+      public GpuMemoryArbiter::Pool {
  public:
   struct GPU_GLES2_EXPORT EntryKey {
     EntryKey(int decoder_id,
@@ -84,6 +86,10 @@ class GPU_GLES2_EXPORT ServiceTransferCache
   bool OnMemoryDump(const base::trace_event::MemoryDumpArgs& args,
                     base::trace_event::ProcessMemoryDump* pmd) override;
 
+  // GpuMemoryArbiter::Pool implementation.
+  size_t GetCacheSize() const override;
+  void EvictResourcesNotUsedSince(base::TimeTicks time) override;
+
   // Test-only functions:
   void SetCacheSizeLimitForTesting(size_t cache_size_limit) {
     cache_size_limit_ = cache_size_limit;
@@ -105,6 +111,9 @@ class GPU_GLES2_EXPORT ServiceTransferCache
     ~CacheEntryInternal();
     base::Optional<ServiceDiscardableHandle> handle;
     std::unique_ptr<cc::ServiceTransferCacheEntry> entry;
+    // Updated whenever the entry moves to the front of |entries_|, so that
+    // the entries are also ordered by this.
+    base::TimeTicks last_used;
   };
 
   struct EntryKeyComp {
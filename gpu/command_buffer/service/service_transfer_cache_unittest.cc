@@ -56,6 +56,24 @@ TEST(ServiceTransferCacheTest, EnforcesOnPurgeMemory) {
   EXPECT_EQ(cache.cache_size_for_testing(), entry_size);
 }
 
+TEST(ServiceTransferCacheTest, EvictResourcesNotUsedSince) {
+  ServiceTransferCache cache;
+  size_t entry_size = 1024u;
+  cache.CreateLocalEntry(
+      ServiceTransferCache::EntryKey(kDecoderId, kEntryType, 1u),
+      CreateEntry(entry_size));
+  EXPECT_EQ(cache.GetCacheSize(), entry_size);
+
+  // The entry has been used since the start of time.
+  cache.EvictResourcesNotUsedSince(base::TimeTicks());
+  EXPECT_EQ(cache.GetCacheSize(), entry_size);
+
+  cache.EvictResourcesNotUsedSince(base::TimeTicks::Now() +
+                                   base::TimeDelta::FromSeconds(1));
+  EXPECT_EQ(cache.GetCacheSize(), 0u);
+  EXPECT_EQ(cache.entries_count_for_testing(), 0u);
+}
+
 TEST(ServiceTransferCache, MultipleDecoderUse) {
   ServiceTransferCache cache;
   const uint32_t entry_id = 0u;
@@ -4,6 +4,9 @@
 
 #include "gpu/command_buffer/service/shared_context_state.h"
 
+#include <algorithm>
+#include <chrono>
+
 #include "base/threading/thread_task_runner_handle.h"
 #include "base/trace_event/memory_dump_manager.h"
 #include "gpu/command_buffer/common/activity_flags.h"
@@ -236,6 +239,27 @@ bool SharedContextState::OnMemoryDump(
   return true;
 }
 
+size_t SharedContextState::GetCacheSize() const {
+  if (!gr_context_)
+    return 0u;
+  return gr_context_->getResourceCachePurgeableBytes();
+}
+
+void SharedContextState::EvictResourcesNotUsedSince(base::TimeTicks time) {
+  if (!gr_context_ || !GetCacheSize())
+    return;
+
+  // Ensure the context is current before doing any GPU cleanup.
+  if (!MakeCurrent(nullptr))
+    return;
+
+  base::TimeDelta age =
+      std::max(base::TimeTicks::Now() - time, base::TimeDelta());
+  set_need_context_state_reset(true);
+  gr_context_->performDeferredCleanup(
+      std::chrono::milliseconds(age.InMilliseconds()));
+}
+
 void SharedContextState::AddContextLostObserver(ContextLostObserver* obs) {
   context_lost_observers_.AddObserver(obs);
 }
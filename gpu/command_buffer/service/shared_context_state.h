@@ -16,6 +16,7 @@
 #include "build/build_config.h"
 #include "gpu/command_buffer/common/skia_utils.h"
 #include "gpu/command_buffer/service/gl_context_virtual_delegate.h"
+#include "gpu/command_buffer/service/gpu_memory_arbiter.h"
 #include "gpu/gpu_gles2_export.h"
 #include "third_party/skia/include/gpu/GrContext.h"
 #include "ui/gl/progress_reporter.h"
@@ -44,6 +45,7 @@ struct ContextState;
 class GPU_GLES2_EXPORT SharedContextState
     : public base::trace_event::MemoryDumpProvider,
       public gpu::GLContextVirtualDelegate,
+      public GpuMemoryArbiter::Pool,
       public base::RefCounted<SharedContextState> {
  public:
   // TODO: Refactor code to have seperate constructor for GL and Vulkan and not
@@ -106,6 +108,11 @@ class GPU_GLES2_EXPORT SharedContextState
   bool OnMemoryDump(const base::trace_event::MemoryDumpArgs& args,
                     base::trace_event::ProcessMemoryDump* pmd) override;
 
+  // GpuMemoryArbiter::Pool implementation. Only the resources that Skia may
+  // purge are counted, the rest are in use by its clients.
+  size_t GetCacheSize() const override;
+  void EvictResourcesNotUsedSince(base::TimeTicks time) override;
+
   // Observer class which is notified when the context is lost.
   class ContextLostObserver {
    public:
@@ -83,6 +83,7 @@ GpuChannelManager::GpuChannelManager(
       default_offscreen_surface_(std::move(default_offscreen_surface)),
       gpu_memory_buffer_factory_(gpu_memory_buffer_factory),
       gpu_feature_info_(gpu_feature_info),
+      memory_arbiter_(GpuMemoryArbiterBudget()),
       image_decode_accelerator_worker_(image_decode_accelerator_worker),
       activity_flags_(std::move(activity_flags)),
       memory_pressure_listener_(
@@ -94,6 +95,8 @@ GpuChannelManager::GpuChannelManager(
   DCHECK(io_task_runner);
   DCHECK(scheduler);
 
+  memory_arbiter_.AddPool("discardable_textures", &discardable_manager_);
+
   const bool enable_gr_shader_cache =
       (gpu_feature_info_.status_values[GPU_FEATURE_TYPE_OOP_RASTERIZATION] ==
        gpu::kGpuFeatureStatusEnabled) ||
@@ -310,6 +313,7 @@ void GpuChannelManager::OnBackgroundCleanup() {
     program_cache_->Trim(0u);
 
   if (shared_context_state_) {
+    RemoveSharedContextStatePools();
     gr_cache_controller_.reset();
     shared_context_state_->MarkContextLost();
     shared_context_state_.reset();
@@ -334,10 +338,17 @@ void GpuChannelManager::HandleMemoryPressure(
     base::MemoryPressureListener::MemoryPressureLevel memory_pressure_level) {
   if (program_cache_)
     program_cache_->HandleMemoryPressure(memory_pressure_level);
-  discardable_manager_.HandleMemoryPressure(memory_pressure_level);
   passthrough_discardable_manager_.HandleMemoryPressure(memory_pressure_level);
-  if (shared_context_state_)
-    shared_context_state_->PurgeMemory(memory_pressure_level);
+  if (memory_pressure_level ==
+      base::MemoryPressureListener::MEMORY_PRESSURE_LEVEL_CRITICAL) {
+    discardable_manager_.HandleMemoryPressure(memory_pressure_level);
+    if (shared_context_state_)
+      shared_context_state_->PurgeMemory(memory_pressure_level);
+  } else {
+    // With moderate pressure, evict the least recently used resources of all
+    // caches rather than trimming each one of them.
+    memory_arbiter_.HandleMemoryPressure(memory_pressure_level);
+  }
   if (gr_shader_cache_)
     gr_shader_cache_->PurgeMemory(memory_pressure_level);
 }
@@ -348,6 +359,7 @@ scoped_refptr<SharedContextState> GpuChannelManager::GetSharedContextState(
     *result = ContextResult::kSuccess;
     return shared_context_state_;
   }
+  RemoveSharedContextStatePools();
 
   scoped_refptr<gl::GLSurface> surface = default_offscreen_surface();
   bool use_virtualized_gl_contexts = false;
@@ -448,6 +460,11 @@ scoped_refptr<SharedContextState> GpuChannelManager::GetSharedContextState(
   }
 
   gr_cache_controller_.emplace(shared_context_state_.get(), task_runner_);
+  memory_arbiter_.AddPool("skia", shared_context_state_.get());
+  if (shared_context_state_->transfer_cache()) {
+    memory_arbiter_.AddPool("transfer_cache",
+                            shared_context_state_->transfer_cache());
+  }
 
   *result = ContextResult::kSuccess;
   return shared_context_state_;
@@ -472,6 +489,15 @@ void GpuChannelManager::OnContextLost(bool synthetic_loss) {
 void GpuChannelManager::ScheduleGrContextCleanup() {
   if (gr_cache_controller_)
     gr_cache_controller_->ScheduleGrContextCleanup();
+  memory_arbiter_.EnforceBudget();
+}
+
+void GpuChannelManager::RemoveSharedContextStatePools() {
+  if (!shared_context_state_)
+    return;
+  memory_arbiter_.RemovePool(shared_context_state_.get());
+  if (shared_context_state_->transfer_cache())
+    memory_arbiter_.RemovePool(shared_context_state_->transfer_cache());
 }
 
 void GpuChannelManager::StoreShader(const std::string& key,
@@ -268,7 +268,8 @@ class SyncChannel::ReceivedSyncMsgQueue :
   void DispatchReplies() {
     for (size_t i = 0; i < received_replies_.size(); ++i) {
       Message* message = received_replies_[i].message;
-      if (received_replies_[i].context->TryToUnblockListener(message)) {
+      if (received_replies_[i].context->TryToUnblockListenerWithQueuedReply(
+              message)) {
         delete message;
         received_replies_.erase(received_replies_.begin() + i);
         return;
@@ -400,6 +401,7 @@ bool SyncChannel::SyncContext::Push(SyncMessage* sync_msg) {
 
 bool SyncChannel::SyncContext::Pop() {
   bool result;
+  bool has_queued_replies;
   {
     base::AutoLock auto_lock(deserializers_lock_);
     PendingSyncMsg msg = deserializers_.back();
@@ -408,16 +410,22 @@ bool SyncChannel::SyncContext::Pop() {
     msg.done_event = nullptr;
     deserializers_.pop_back();
     result = msg.send_result;
+    has_queued_replies = num_queued_replies_ > 0;
   }
 
   // We got a reply to a synchronous Send() call that's blocking the listener
   // thread.  However, further down the call stack there could be another
   // blocking Send() call, whose reply we received after we made this last
   // Send() call.  So check if we have any queued replies available that
-  // can now unblock the listener thread.
-  ipc_task_runner()->PostTask(
-      FROM_HERE, base::BindOnce(&ReceivedSyncMsgQueue::DispatchReplies,
-                                received_sync_msgs_));
+  // can now unblock the listener thread. Replies are counted under
+  // |deserializers_lock_|, so any reply not counted yet will find the outer
+  // Send() on top of |deserializers_| and unblock it directly. This saves a
+  // hop to the IPC thread for the common, non-nested Send().
+  if (has_queued_replies) {
+    ipc_task_runner()->PostTask(
+        FROM_HERE, base::BindOnce(&ReceivedSyncMsgQueue::DispatchReplies,
+                                  received_sync_msgs_));
+  }
 
   return result;
 }
@@ -435,8 +443,18 @@ void SyncChannel::SyncContext::DispatchMessages() {
   received_sync_msgs_->DispatchMessages(this);
 }
 
-bool SyncChannel::SyncContext::TryToUnblockListener(const Message* msg) {
+bool SyncChannel::SyncContext::TryToUnblockListenerWithQueuedReply(
+    const Message* msg) {
   base::AutoLock auto_lock(deserializers_lock_);
+  if (!TryToUnblockListenerLocked(msg))
+    return false;
+  DCHECK_GT(num_queued_replies_, 0u);
+  --num_queued_replies_;
+  return true;
+}
+
+bool SyncChannel::SyncContext::TryToUnblockListenerLocked(const Message* msg) {
+  deserializers_lock_.AssertAcquired();
   if (deserializers_.empty() ||
       !SyncMessage::IsMessageReplyTo(*msg, deserializers_.back().id)) {
     return false;
@@ -472,12 +490,16 @@ bool SyncChannel::SyncContext::OnMessageReceived(const Message& msg) {
   if (TryFilters(msg))
     return true;
 
-  if (TryToUnblockListener(&msg))
-    return true;
+  {
+    base::AutoLock auto_lock(deserializers_lock_);
+    if (TryToUnblockListenerLocked(&msg))
+      return true;
 
-  if (msg.is_reply()) {
-    received_sync_msgs_->QueueReply(msg, this);
-    return true;
+    if (msg.is_reply()) {
+      ++num_queued_replies_;
+      received_sync_msgs_->QueueReply(msg, this);
+      return true;
+    }
   }
 
   if (msg.should_unblock()) {
@@ -155,10 +155,11 @@ class COMPONENT_EXPORT(IPC) SyncChannel : public ChannelProxy {
 
     void DispatchMessages();
 
-    // Checks if the given message is blocking the listener thread because of a
-    // synchronous send.  If it is, the thread is unblocked and true is
-    // returned. Otherwise the function returns false.
-    bool TryToUnblockListener(const Message* msg);
+    // Checks if the given reply, queued by OnMessageReceived() because it
+    // didn't match the innermost Send() at the time, is blocking the listener
+    // thread. If it is, the thread is unblocked and true is returned.
+    // Otherwise the function returns false.
+    bool TryToUnblockListenerWithQueuedReply(const Message* msg);
 
     base::WaitableEvent* shutdown_event() { return shutdown_event_; }
 
@@ -195,11 +196,22 @@ class COMPONENT_EXPORT(IPC) SyncChannel : public ChannelProxy {
 
     void OnShutdownEventSignaled(base::WaitableEvent* event);
 
+    // Checks if the given message is blocking the listener thread because of a
+    // synchronous send.  If it is, the thread is unblocked and true is
+    // returned. Otherwise the function returns false. |deserializers_lock_|
+    // must be held.
+    bool TryToUnblockListenerLocked(const Message* msg);
+
     using PendingSyncMessageQueue = base::circular_deque<PendingSyncMsg>;
     PendingSyncMessageQueue deserializers_;
     bool reject_new_deserializers_ = false;
     base::Lock deserializers_lock_;
 
+    // The number of replies queued in |received_sync_msgs_| for this context.
+    // Guarded by |deserializers_lock_|, so that Pop() only has to ask the IPC
+    // thread to look at the queued replies when there are any.
+    size_t num_queued_replies_ = 0;
+
     scoped_refptr<ReceivedSyncMsgQueue> received_sync_msgs_;
 
     base::WaitableEvent* shutdown_event_;
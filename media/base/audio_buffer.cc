@@ -309,13 +309,8 @@ void AudioBuffer::ReadFrames(int frames_to_copy,
     // Format is interleaved float32. Copy the data into each channel.
     const float* source_data = reinterpret_cast<const float*>(data_.get()) +
                                source_frame_offset * channel_count_;
-    for (int ch = 0; ch < channel_count_; ++ch) {
-      float* dest_data = dest->channel(ch) + dest_frame_offset;
-      for (int i = 0, offset = ch; i < frames_to_copy;
-           ++i, offset += channel_count_) {
-        dest_data[i] = source_data[offset];
-      }
-    }
+    dest->FromInterleavedPartial<Float32SampleTypeTraits>(
+        source_data, dest_frame_offset, frames_to_copy);
     return;
   }
 
@@ -331,6 +326,24 @@ void AudioBuffer::ReadFrames(int frames_to_copy,
                                bytes_per_channel);
 }
 
+std::unique_ptr<AudioBus> AudioBuffer::WrapOrCopyToAudioBus() {
+  DCHECK(!end_of_stream());
+  DCHECK(!IsBitstreamFormat());
+
+  if (data_ && sample_format_ == kSampleFormatPlanarF32) {
+    std::unique_ptr<AudioBus> bus = AudioBus::CreateWrapper(channel_count_);
+    for (int ch = 0; ch < channel_count_; ++ch)
+      bus->SetChannelData(ch, reinterpret_cast<float*>(channel_data_[ch]));
+    bus->set_frames(adjusted_frame_count_);
+    return bus;
+  }
+
+  std::unique_ptr<AudioBus> bus =
+      AudioBus::Create(channel_count_, adjusted_frame_count_);
+  ReadFrames(adjusted_frame_count_, 0, 0, bus.get());
+  return bus;
+}
+
 void AudioBuffer::TrimStart(int frames_to_trim) {
   CHECK_GE(frames_to_trim, 0);
   CHECK_LE(frames_to_trim, adjusted_frame_count_);
@@ -131,6 +131,13 @@ class MEDIA_EXPORT AudioBuffer
                   int dest_frame_offset,
                   AudioBus* dest);
 
+  // Returns an AudioBus with all frames of the buffer. For planar float32
+  // buffers the bus refers to the buffer's data instead of copying it, so it
+  // must not outlive the buffer, and the buffer must not be trimmed while the
+  // bus is in use. Other formats are converted into a newly allocated bus, as
+  // with ReadFrames().
+  std::unique_ptr<AudioBus> WrapOrCopyToAudioBus();
+
   // Trim an AudioBuffer by removing |frames_to_trim| frames from the start.
   // Timestamp and duration are adjusted to reflect the fewer frames.
   // Note that repeated calls to TrimStart() may result in timestamp() and
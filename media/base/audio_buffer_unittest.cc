@@ -414,6 +414,33 @@ TEST(AudioBufferTest, ReadF32Planar) {
   VerifyBus(bus.get(), 20, 51, 1);
 }
 
+TEST(AudioBufferTest, WrapOrCopyToAudioBus) {
+  const ChannelLayout channel_layout = CHANNEL_LAYOUT_STEREO;
+  const int channels = ChannelLayoutToChannelCount(channel_layout);
+  const int frames = 100;
+  const base::TimeDelta start_time;
+
+  // Planar float32 data is wrapped rather than copied.
+  scoped_refptr<AudioBuffer> planar_buffer =
+      MakeAudioBuffer<float>(kSampleFormatPlanarF32, channel_layout, channels,
+                             kSampleRate, 1.0f, 1.0f, frames, start_time);
+  std::unique_ptr<AudioBus> bus = planar_buffer->WrapOrCopyToAudioBus();
+  EXPECT_EQ(frames, bus->frames());
+  for (int ch = 0; ch < channels; ++ch) {
+    EXPECT_EQ(reinterpret_cast<float*>(planar_buffer->channel_data()[ch]),
+              bus->channel(ch));
+  }
+  VerifyBus(bus.get(), frames, 1, 1);
+
+  // Interleaved data is converted into a new bus.
+  scoped_refptr<AudioBuffer> interleaved_buffer =
+      MakeAudioBuffer<float>(kSampleFormatF32, channel_layout, channels,
+                             kSampleRate, 1.0f, 1.0f, frames, start_time);
+  bus = interleaved_buffer->WrapOrCopyToAudioBus();
+  EXPECT_EQ(frames, bus->frames());
+  VerifyBus(bus.get(), frames, 1, 1);
+}
+
 TEST(AudioBufferTest, EmptyBuffer) {
   const ChannelLayout channel_layout = CHANNEL_LAYOUT_4_0;
   const int channels = ChannelLayoutToChannelCount(channel_layout);
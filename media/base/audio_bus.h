@@ -288,6 +288,19 @@ void AudioBus::CopyConvertFromInterleavedSourceToAudioBus(
     int num_frames_to_write,
     AudioBus* dest) {
   const int channels = dest->channels();
+  if (channels == 2) {
+    // Stereo is by far the most common layout. Converting both channels in a
+    // single pass reads the source only once, and the loop is simple enough
+    // for the compiler to vectorize.
+    float* left = dest->channel(0) + write_offset_in_frames;
+    float* right = dest->channel(1) + write_offset_in_frames;
+    for (int i = 0; i < num_frames_to_write; ++i) {
+      left[i] = SourceSampleTypeTraits::ToFloat(source_buffer[2 * i]);
+      right[i] = SourceSampleTypeTraits::ToFloat(source_buffer[2 * i + 1]);
+    }
+    return;
+  }
+
   for (int ch = 0; ch < channels; ++ch) {
     float* channel_data = dest->channel(ch);
     for (int target_frame_index = write_offset_in_frames,
@@ -310,6 +323,17 @@ void AudioBus::CopyConvertFromAudioBusToInterleavedTarget(
     int num_frames_to_read,
     typename TargetSampleTypeTraits::ValueType* dest_buffer) {
   const int channels = source->channels();
+  if (channels == 2) {
+    // See CopyConvertFromInterleavedSourceToAudioBus().
+    const float* left = source->channel(0) + read_offset_in_frames;
+    const float* right = source->channel(1) + read_offset_in_frames;
+    for (int i = 0; i < num_frames_to_read; ++i) {
+      dest_buffer[2 * i] = TargetSampleTypeTraits::FromFloat(left[i]);
+      dest_buffer[2 * i + 1] = TargetSampleTypeTraits::FromFloat(right[i]);
+    }
+    return;
+  }
+
   for (int ch = 0; ch < channels; ++ch) {
     const float* channel_data = source->channel(ch);
     for (int source_frame_index = read_offset_in_frames, write_pos_in_dest = ch;
@@ -6,9 +6,11 @@
 #include <memory>
 
 #include "base/time/time.h"
+#include "media/base/audio_buffer.h"
 #include "media/base/audio_bus.h"
 #include "media/base/audio_sample_types.h"
 #include "media/base/fake_audio_render_callback.h"
+#include "media/base/test_helpers.h"
 #include "testing/gtest/include/gtest/gtest.h"
 #include "testing/perf/perf_test.h"
 
@@ -49,7 +51,38 @@ TEST(AudioBusPerfTest, Interleave) {
   // Only benchmark these two types since they're the only commonly used ones.
   RunInterleaveBench<int16_t, SignedInt16SampleTypeTraits>(bus.get(),
                                                            "int16_t");
+  RunInterleaveBench<int32_t, SignedInt32SampleTypeTraits>(bus.get(),
+                                                           "int32_t");
   RunInterleaveBench<float, Float32SampleTypeTraits>(bus.get(), "float");
 }
 
+// Benchmark getting an AudioBus from a planar float AudioBuffer by copying and
+// by wrapping its data.
+TEST(AudioBusPerfTest, AudioBufferToAudioBus) {
+  const int kFrames = 1024;
+  const int kIterations = 100000;
+  scoped_refptr<AudioBuffer> buffer = MakeAudioBuffer<float>(
+      kSampleFormatPlanarF32, CHANNEL_LAYOUT_STEREO, 2, kSampleRate, 0.0f,
+      1.0f / kFrames, kFrames, base::TimeDelta());
+
+  base::TimeTicks start = base::TimeTicks::Now();
+  for (int i = 0; i < kIterations; ++i) {
+    std::unique_ptr<AudioBus> bus = AudioBus::Create(2, kFrames);
+    buffer->ReadFrames(kFrames, 0, 0, bus.get());
+  }
+  double total_time_milliseconds =
+      (base::TimeTicks::Now() - start).InMillisecondsF();
+  perf_test::PrintResult("audio_buffer_to_audio_bus", "", "copy",
+                         total_time_milliseconds * 1000 / kIterations, "us",
+                         true);
+
+  start = base::TimeTicks::Now();
+  for (int i = 0; i < kIterations; ++i)
+    buffer->WrapOrCopyToAudioBus();
+  total_time_milliseconds = (base::TimeTicks::Now() - start).InMillisecondsF();
+  perf_test::PrintResult("audio_buffer_to_audio_bus", "", "wrap",
+                         total_time_milliseconds * 1000 / kIterations, "us",
+                         true);
+}
+
 }  // namespace media
@@ -3,7 +3,9 @@
 // found in the LICENSE file.
 
 #include <memory>
+#include <vector>
 
+#include "base/strings/string_number_conversions.h"
 #include "base/time/time.h"
 #include "media/base/audio_converter.h"
 #include "media/base/fake_audio_render_callback.h"
@@ -50,6 +52,29 @@ void RunConvertBenchmark(const AudioParameters& in_params,
       "audio_converter", "", trace_name, runs_per_second, "runs/s", true);
 }
 
+// Mixes |input_count| inputs, as AudioRendererMixer does with the inputs of
+// all media elements and audio contexts that share an output device.
+void RunMixBenchmark(const AudioParameters& params,
+                     int input_count,
+                     int iterations) {
+  std::vector<NullInputProvider> fake_inputs(input_count);
+  std::unique_ptr<AudioBus> output_bus = AudioBus::Create(params);
+
+  AudioConverter converter(params, params, true);
+  for (auto& fake_input : fake_inputs)
+    converter.AddInput(&fake_input);
+
+  base::TimeTicks start = base::TimeTicks::Now();
+  for (int i = 0; i < iterations; ++i)
+    converter.Convert(output_bus.get());
+  double runs_per_second =
+      iterations / (base::TimeTicks::Now() - start).InSecondsF();
+  perf_test::PrintResult("audio_converter",
+                         "_mix_" + base::NumberToString(input_count) +
+                             "_inputs",
+                         "mix", runs_per_second, "runs/s", true);
+}
+
 TEST(AudioConverterPerfTest, ConvertBenchmark) {
   // Create input and output parameters to convert between the two most common
   // sets of parameters (as indicated via UMA data).
@@ -76,4 +101,13 @@ TEST(AudioConverterPerfTest, ConvertBenchmarkFIFO) {
                       "convert_pass_through");
 }
 
+TEST(AudioConverterPerfTest, MixBenchmark) {
+  AudioParameters params(AudioParameters::AUDIO_PCM_LINEAR,
+                         CHANNEL_LAYOUT_STEREO, 48000, 480);
+
+  // Keep the number of mixed buffers about the same for every input count.
+  for (int input_count : {1, 10, 100, 200})
+    RunMixBenchmark(params, input_count, kBenchmarkIterations / input_count);
+}
+
 } // namespace media
@@ -79,57 +79,93 @@ AudioRendererMixer::~AudioRendererMixer() {
 
 void AudioRendererMixer::AddMixerInput(const AudioParameters& input_params,
                                        AudioConverter::InputCallback* input) {
-  base::AutoLock auto_lock(lock_);
-  if (!playing_) {
-    playing_ = true;
-    last_play_time_ = base::TimeTicks::Now();
-    audio_sink_->Play();
+  // Render() holds |lock_| on the audio thread for the whole mix, so keep the
+  // expensive parts of adding an input, creating a resampling converter and
+  // starting the sink, out of it.
+  int input_sample_rate = input_params.sample_rate();
+  std::unique_ptr<LoopbackAudioConverter> new_converter;
+  if (!is_master_sample_rate(input_sample_rate)) {
+    bool has_converter;
+    {
+      base::AutoLock auto_lock(lock_);
+      has_converter = converters_.find(input_sample_rate) != converters_.end();
+    }
+    if (!has_converter) {
+      // We expect all InputCallbacks to be capable of handling arbitrary
+      // buffer size requests, disabling FIFO.
+      new_converter = std::make_unique<LoopbackAudioConverter>(
+          input_params, output_params_, true);
+    }
   }
 
-  int input_sample_rate = input_params.sample_rate();
-  if (is_master_sample_rate(input_sample_rate)) {
-    master_converter_.AddInput(input);
-  } else {
-    auto converter = converters_.find(input_sample_rate);
-    if (converter == converters_.end()) {
-      std::pair<AudioConvertersMap::iterator, bool> result =
-          converters_.insert(std::make_pair(
-              input_sample_rate, std::make_unique<LoopbackAudioConverter>(
-                                     // We expect all InputCallbacks to be
-                                     // capable of handling arbitrary buffer
-                                     // size requests, disabling FIFO.
-                                     input_params, output_params_, true)));
-      converter = result.first;
-
-      // Add newly-created resampler as an input to the master mixer.
-      master_converter_.AddInput(converter->second.get());
+  bool start_playing = false;
+  {
+    base::AutoLock auto_lock(lock_);
+    if (!playing_) {
+      playing_ = true;
+      last_play_time_ = base::TimeTicks::Now();
+      start_playing = true;
+    }
+
+    if (is_master_sample_rate(input_sample_rate)) {
+      master_converter_.AddInput(input);
+    } else {
+      auto converter = converters_.find(input_sample_rate);
+      if (converter == converters_.end()) {
+        // Another thread may have added and removed a converter for this
+        // sample rate since it was checked above.
+        if (!new_converter) {
+          new_converter = std::make_unique<LoopbackAudioConverter>(
+              input_params, output_params_, true);
+        }
+        converter =
+            converters_.emplace(input_sample_rate, std::move(new_converter))
+                .first;
+
+        // Add newly-created resampler as an input to the master mixer.
+        master_converter_.AddInput(converter->second.get());
+      }
+      converter->second->AddInput(input);
     }
-    converter->second->AddInput(input);
+
+    input_count_tracker_->Increment();
   }
 
-  input_count_tracker_->Increment();
+  // Render() can only pause the sink again once |pause_delay_| has passed
+  // without inputs, so it is safe to play it after releasing |lock_|.
+  if (start_playing)
+    audio_sink_->Play();
+
+  // If another thread created a converter for this sample rate first,
+  // |new_converter| is destroyed here, outside of |lock_|.
 }
 
 void AudioRendererMixer::RemoveMixerInput(
     const AudioParameters& input_params,
     AudioConverter::InputCallback* input) {
-  base::AutoLock auto_lock(lock_);
-
-  int input_sample_rate = input_params.sample_rate();
-  if (is_master_sample_rate(input_sample_rate)) {
-    master_converter_.RemoveInput(input);
-  } else {
-    auto converter = converters_.find(input_sample_rate);
-    DCHECK(converter != converters_.end());
-    converter->second->RemoveInput(input);
-    if (converter->second->empty()) {
-      // Remove converter when it's empty.
-      master_converter_.RemoveInput(converter->second.get());
-      converters_.erase(converter);
+  // An emptied converter is destroyed after |lock_| is released, so that
+  // Render() does not wait for it.
+  std::unique_ptr<LoopbackAudioConverter> removed_converter;
+  {
+    base::AutoLock auto_lock(lock_);
+
+    int input_sample_rate = input_params.sample_rate();
+    if (is_master_sample_rate(input_sample_rate)) {
+      master_converter_.RemoveInput(input);
+    } else {
+      auto converter = converters_.find(input_sample_rate);
+      DCHECK(converter != converters_.end());
+      converter->second->RemoveInput(input);
+      if (converter->second->empty()) {
+        // Remove converter when it's empty.
+        master_converter_.RemoveInput(converter->second.get());
+        removed_converter = std::move(converter->second);
+        converters_.erase(converter);
+      }
     }
-  }
 
-  input_count_tracker_->Decrement();
+    input_count_tracker_->Decrement();
+  }
 }
 
 void AudioRendererMixer::AddErrorCallback(AudioRendererMixerInput* input) {
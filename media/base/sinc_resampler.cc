@@ -84,6 +84,11 @@
 
 #if defined(ARCH_CPU_X86_FAMILY)
 #include <xmmintrin.h>
+#if !defined(OS_NACL)
+#include <immintrin.h>
+
+#include "base/cpu.h"
+#endif
 #define CONVOLVE_FUNC Convolve_SSE
 #elif defined(ARCH_CPU_ARM_FAMILY) && defined(USE_NEON)
 #include <arm_neon.h>
@@ -117,7 +122,8 @@ static int CalculateChunkSize(int block_size_, double io_ratio) {
 SincResampler::SincResampler(double io_sample_rate_ratio,
                              int request_frames,
                              const ReadCB& read_cb)
-    : io_sample_rate_ratio_(io_sample_rate_ratio),
+    : convolve_proc_(CONVOLVE_FUNC),
+      io_sample_rate_ratio_(io_sample_rate_ratio),
       read_cb_(read_cb),
       request_frames_(request_frames),
       input_buffer_size_(request_frames_ + kKernelSize),
@@ -133,6 +139,11 @@ SincResampler::SincResampler(double io_sample_rate_ratio,
       r1_(input_buffer_.get()),
       r2_(input_buffer_.get() + kKernelSize / 2) {
   CHECK_GT(request_frames_, 0);
+#if defined(ARCH_CPU_X86_FAMILY) && !defined(OS_NACL)
+  base::CPU cpu;
+  if (cpu.has_avx2() && cpu.has_fma3())
+    convolve_proc_ = Convolve_AVX2;
+#endif
   Flush();
   CHECK_GT(block_size_, kKernelSize)
       << "block_size must be greater than kKernelSize!";
@@ -268,7 +279,7 @@ void SincResampler::Resample(int frames, float* destination) {
         const double kernel_interpolation_factor =
             virtual_offset_idx - offset_idx;
         *destination++ =
-            CONVOLVE_FUNC(input_ptr, k1, k2, kernel_interpolation_factor);
+            convolve_proc_(input_ptr, k1, k2, kernel_interpolation_factor);
 
         // Advance the virtual index.
         virtual_source_idx_ += io_sample_rate_ratio_;
@@ -372,6 +383,41 @@ float SincResampler::Convolve_SSE(const float* input_ptr, const float* k1,
 
   return result;
 }
+
+#if !defined(OS_NACL)
+__attribute__((target("avx2,fma")))
+float SincResampler::Convolve_AVX2(const float* input_ptr,
+                                   const float* k1,
+                                   const float* k2,
+                                   double kernel_interpolation_factor) {
+  __m256 m_input;
+  __m256 m_sums1 = _mm256_setzero_ps();
+  __m256 m_sums2 = _mm256_setzero_ps();
+
+  // |k1| and |k2| are only 16-byte aligned, and |input_ptr| may not be aligned
+  // at all, so always use unaligned loads.  These are as fast as aligned loads
+  // on aligned data on CPUs that support AVX2.
+  for (int i = 0; i < kKernelSize; i += 8) {
+    m_input = _mm256_loadu_ps(input_ptr + i);
+    m_sums1 = _mm256_fmadd_ps(m_input, _mm256_loadu_ps(k1 + i), m_sums1);
+    m_sums2 = _mm256_fmadd_ps(m_input, _mm256_loadu_ps(k2 + i), m_sums2);
+  }
+
+  // Linearly interpolate the two "convolutions".
+  m_sums1 = _mm256_mul_ps(
+      m_sums1,
+      _mm256_set1_ps(static_cast<float>(1.0 - kernel_interpolation_factor)));
+  m_sums1 = _mm256_fmadd_ps(
+      m_sums2, _mm256_set1_ps(static_cast<float>(kernel_interpolation_factor)),
+      m_sums1);
+
+  // Sum components together.
+  __m128 m_sums = _mm_add_ps(_mm256_castps256_ps128(m_sums1),
+                             _mm256_extractf128_ps(m_sums1, 1));
+  m_sums = _mm_add_ps(_mm_movehl_ps(m_sums, m_sums), m_sums);
+  return _mm_cvtss_f32(_mm_add_ss(m_sums, _mm_shuffle_ps(m_sums, m_sums, 1)));
+}
+#endif
 #elif defined(ARCH_CPU_ARM_FAMILY) && defined(USE_NEON)
 float SincResampler::Convolve_NEON(const float* input_ptr, const float* k1,
                                    const float* k2,
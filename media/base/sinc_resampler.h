@@ -88,26 +88,43 @@ class MEDIA_EXPORT SincResampler {
   FRIEND_TEST_ALL_PREFIXES(SincResamplerPerfTest, Convolve_unoptimized_aligned);
   FRIEND_TEST_ALL_PREFIXES(SincResamplerPerfTest, Convolve_optimized_aligned);
   FRIEND_TEST_ALL_PREFIXES(SincResamplerPerfTest, Convolve_optimized_unaligned);
+  FRIEND_TEST_ALL_PREFIXES(SincResamplerPerfTest, Convolve_avx2_aligned);
+  FRIEND_TEST_ALL_PREFIXES(SincResamplerPerfTest, Convolve_avx2_unaligned);
 
   void InitializeKernel();
   void UpdateRegions(bool second_load);
 
   // Compute convolution of |k1| and |k2| over |input_ptr|, resultant sums are
   // linearly interpolated using |kernel_interpolation_factor|.  On x86, the
-  // underlying implementation is chosen at run time based on SSE support.  On
-  // ARM, NEON support is chosen at compile time based on compilation flags.
+  // underlying implementation is chosen at run time based on AVX2 and FMA3
+  // support.  On ARM, NEON support is chosen at compile time based on
+  // compilation flags.
+  using ConvolveProc = float (*)(const float* input_ptr,
+                                 const float* k1,
+                                 const float* k2,
+                                 double kernel_interpolation_factor);
   static float Convolve_C(const float* input_ptr, const float* k1,
                           const float* k2, double kernel_interpolation_factor);
 #if defined(ARCH_CPU_X86_FAMILY)
   static float Convolve_SSE(const float* input_ptr, const float* k1,
                             const float* k2,
                             double kernel_interpolation_factor);
+#if !defined(OS_NACL)
+  // Only use this if base::CPU reports AVX2 and FMA3 support.
+  static float Convolve_AVX2(const float* input_ptr,
+                             const float* k1,
+                             const float* k2,
+                             double kernel_interpolation_factor);
+#endif
 #elif defined(ARCH_CPU_ARM_FAMILY) && defined(USE_NEON)
   static float Convolve_NEON(const float* input_ptr, const float* k1,
                              const float* k2,
                              double kernel_interpolation_factor);
 #endif
 
+  // The Convolve_*() implementation used by Resample().
+  ConvolveProc convolve_proc_;
+
   // The ratio of input / output sample rates.
   double io_sample_rate_ratio_;
 
@@ -6,6 +6,7 @@
 
 #include "base/bind.h"
 #include "base/bind_helpers.h"
+#include "base/cpu.h"
 #include "base/macros.h"
 #include "base/numerics/math_constants.h"
 #include "base/strings/string_number_conversions.h"
@@ -191,6 +192,16 @@ TEST(SincResamplerTest, Convolve) {
       resampler.kernel_storage_.get() + 1, resampler.kernel_storage_.get(),
       resampler.kernel_storage_.get(), kKernelInterpolationFactor);
   EXPECT_NEAR(result2, result, kEpsilon);
+
+#if defined(ARCH_CPU_X86_FAMILY) && !defined(OS_NACL)
+  base::CPU cpu;
+  if (cpu.has_avx2() && cpu.has_fma3()) {
+    result2 = resampler.Convolve_AVX2(
+        resampler.kernel_storage_.get() + 1, resampler.kernel_storage_.get(),
+        resampler.kernel_storage_.get(), kKernelInterpolationFactor);
+    EXPECT_NEAR(result2, result, kEpsilon);
+  }
+#endif
 }
 #endif
 
@@ -4,6 +4,7 @@
 
 #include <memory>
 
+#include "base/cpu.h"
 #include "base/macros.h"
 #include "base/memory/aligned_memory.h"
 #include "base/time/time.h"
@@ -75,6 +76,11 @@ class VectorMathPerfTest : public testing::Test {
                            true);
   }
 
+  bool HasAVX2() const {
+    base::CPU cpu;
+    return cpu.has_avx2() && cpu.has_fma3();
+  }
+
  protected:
   std::unique_ptr<float, base::AlignedFreeDeleter> input_vector_;
   std::unique_ptr<float, base::AlignedFreeDeleter> output_vector_;
@@ -118,6 +124,24 @@ TEST_F(VectorMathPerfTest, FMAC_optimized_aligned) {
 }
 #endif
 
+#if defined(ARCH_CPU_X86_FAMILY) && !defined(OS_NACL)
+// Benchmark FMAC_AVX2() with unaligned size.
+TEST_F(VectorMathPerfTest, FMAC_avx2_unaligned) {
+  if (!HasAVX2())
+    return;
+  RunBenchmark(vector_math::FMAC_AVX2, false, "vector_math_fmac",
+               "avx2_unaligned");
+}
+
+// Benchmark FMAC_AVX2() with aligned size.
+TEST_F(VectorMathPerfTest, FMAC_avx2_aligned) {
+  if (!HasAVX2())
+    return;
+  RunBenchmark(vector_math::FMAC_AVX2, true, "vector_math_fmac",
+               "avx2_aligned");
+}
+#endif
+
 // Benchmarks for each optimized vector_math::FMUL() method.
 // Benchmark FMUL_C().
 TEST_F(VectorMathPerfTest, FMUL_unoptimized) {
@@ -143,6 +167,24 @@ TEST_F(VectorMathPerfTest, FMUL_optimized_aligned) {
 }
 #endif
 
+#if defined(ARCH_CPU_X86_FAMILY) && !defined(OS_NACL)
+// Benchmark FMUL_AVX2() with unaligned size.
+TEST_F(VectorMathPerfTest, FMUL_avx2_unaligned) {
+  if (!HasAVX2())
+    return;
+  RunBenchmark(vector_math::FMUL_AVX2, false, "vector_math_fmul",
+               "avx2_unaligned");
+}
+
+// Benchmark FMUL_AVX2() with aligned size.
+TEST_F(VectorMathPerfTest, FMUL_avx2_aligned) {
+  if (!HasAVX2())
+    return;
+  RunBenchmark(vector_math::FMUL_AVX2, true, "vector_math_fmul",
+               "avx2_aligned");
+}
+#endif
+
 // Benchmarks for each optimized vector_math::EWMAAndMaxPower() method.
 // Benchmark EWMAAndMaxPower_C().
 TEST_F(VectorMathPerfTest, EWMAAndMaxPower_unoptimized) {
@@ -174,4 +216,22 @@ TEST_F(VectorMathPerfTest, EWMAAndMaxPower_optimized_aligned) {
 }
 #endif
 
+#if defined(ARCH_CPU_X86_FAMILY) && !defined(OS_NACL)
+// Benchmark EWMAAndMaxPower_AVX2() with unaligned size.
+TEST_F(VectorMathPerfTest, EWMAAndMaxPower_avx2_unaligned) {
+  if (!HasAVX2())
+    return;
+  RunBenchmark(vector_math::EWMAAndMaxPower_AVX2, kVectorSize - 1,
+               "vector_math_ewma_and_max_power", "avx2_unaligned");
+}
+
+// Benchmark EWMAAndMaxPower_AVX2() with aligned size.
+TEST_F(VectorMathPerfTest, EWMAAndMaxPower_avx2_aligned) {
+  if (!HasAVX2())
+    return;
+  RunBenchmark(vector_math::EWMAAndMaxPower_AVX2, kVectorSize,
+               "vector_math_ewma_and_max_power", "avx2_aligned");
+}
+#endif
+
 } // namespace media
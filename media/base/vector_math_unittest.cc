@@ -7,6 +7,7 @@
 
 #include "base/macros.h"
 #include "base/memory/aligned_memory.h"
+#include "base/cpu.h"
 #include "base/strings/string_number_conversions.h"
 #include "base/strings/stringize_macros.h"
 #include "build/build_config.h"
@@ -83,6 +84,19 @@ TEST_F(VectorMathTest, FMAC) {
   }
 #endif
 
+#if defined(ARCH_CPU_X86_FAMILY) && !defined(OS_NACL)
+  {
+    base::CPU cpu;
+    if (cpu.has_avx2() && cpu.has_fma3()) {
+      SCOPED_TRACE("FMAC_AVX2");
+      FillTestVectors(kInputFillValue, kOutputFillValue);
+      vector_math::FMAC_AVX2(
+          input_vector_.get(), kScale, kVectorSize, output_vector_.get());
+      VerifyOutput(kResult);
+    }
+  }
+#endif
+
 #if defined(ARCH_CPU_ARM_FAMILY) && defined(USE_NEON)
   {
     SCOPED_TRACE("FMAC_NEON");
@@ -124,6 +138,19 @@ TEST_F(VectorMathTest, FMUL) {
   }
 #endif
 
+#if defined(ARCH_CPU_X86_FAMILY) && !defined(OS_NACL)
+  {
+    base::CPU cpu;
+    if (cpu.has_avx2() && cpu.has_fma3()) {
+      SCOPED_TRACE("FMUL_AVX2");
+      FillTestVectors(kInputFillValue, kOutputFillValue);
+      vector_math::FMUL_AVX2(
+          input_vector_.get(), kScale, kVectorSize, output_vector_.get());
+      VerifyOutput(kResult);
+    }
+  }
+#endif
+
 #if defined(ARCH_CPU_ARM_FAMILY) && defined(USE_NEON)
   {
     SCOPED_TRACE("FMUL_NEON");
@@ -232,6 +259,18 @@ class EWMATestScenario {
     }
 #endif
 
+#if defined(ARCH_CPU_X86_FAMILY) && !defined(OS_NACL)
+    base::CPU cpu;
+    if (cpu.has_avx2() && cpu.has_fma3()) {
+      SCOPED_TRACE("EWMAAndMaxPower_AVX2");
+      const std::pair<float, float>& result =
+          vector_math::EWMAAndMaxPower_AVX2(initial_value_, data_.get(),
+                                            data_len_, smoothing_factor_);
+      EXPECT_NEAR(expected_final_avg_, result.first, 0.0000001f);
+      EXPECT_NEAR(expected_max_, result.second, 0.0000001f);
+    }
+#endif
+
 #if defined(ARCH_CPU_ARM_FAMILY) && defined(USE_NEON)
     {
       SCOPED_TRACE("EWMAAndMaxPower_NEON");
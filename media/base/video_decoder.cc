@@ -4,8 +4,12 @@
 
 #include "media/base/video_decoder.h"
 
+#include <algorithm>
+
 #include "base/command_line.h"
+#include "base/no_destructor.h"
 #include "base/strings/string_number_conversions.h"
+#include "base/synchronization/lock.h"
 #include "base/system/sys_info.h"
 #include "media/base/limits.h"
 #include "media/base/media_switches.h"
@@ -13,6 +17,21 @@
 
 namespace media {
 
+namespace {
+
+// The number of threads reserved by all video decoders of the process.
+struct ThreadBudget {
+  base::Lock lock;
+  int reserved_threads = 0;
+};
+
+ThreadBudget& GetThreadBudget() {
+  static base::NoDestructor<ThreadBudget> budget;
+  return *budget;
+}
+
+}  // namespace
+
 VideoDecoder::VideoDecoder() = default;
 
 void VideoDecoder::Destroy() {
@@ -65,6 +84,31 @@ int VideoDecoder::GetRecommendedThreadCount(int desired_threads) {
                   static_cast<int>(limits::kMaxVideoDecodeThreads));
 }
 
+// static
+int VideoDecoder::ReserveThreads(int threads) {
+  const bool use_budget = !base::CommandLine::ForCurrentProcess()->HasSwitch(
+      switches::kVideoThreads);
+
+  ThreadBudget& budget = GetThreadBudget();
+  base::AutoLock auto_lock(budget.lock);
+  if (use_budget) {
+    const int available_threads =
+        base::SysInfo::NumberOfProcessors() - budget.reserved_threads;
+    threads = std::max(std::min(threads, available_threads),
+                       static_cast<int>(limits::kMinVideoDecodeThreads));
+  }
+  budget.reserved_threads += threads;
+  return threads;
+}
+
+// static
+void VideoDecoder::ReleaseThreads(int threads) {
+  ThreadBudget& budget = GetThreadBudget();
+  base::AutoLock auto_lock(budget.lock);
+  budget.reserved_threads -= threads;
+  DCHECK_GE(budget.reserved_threads, 0);
+}
+
 }  // namespace media
 
 namespace std {
@@ -133,6 +133,17 @@ class MEDIA_EXPORT VideoDecoder {
   // [|limits::kMinVideoDecodeThreads|, |limits::kMaxVideoDecodeThreads|].
   static int GetRecommendedThreadCount(int desired_threads);
 
+  // Reserves up to |threads| software decoding threads, as returned by
+  // GetRecommendedThreadCount(), from a budget shared by all video decoders of
+  // the process, and returns the number of threads the decoder should use.
+  // When many decoders run at once, later ones get fewer threads so that
+  // together they don't use many more threads than there are logical
+  // processors. Every decoder still gets |limits::kMinVideoDecodeThreads|, and
+  // the budget is not applied when --video-threads is specified. The returned
+  // number must be passed to ReleaseThreads() when the decoder is done.
+  static int ReserveThreads(int threads);
+  static void ReleaseThreads(int threads);
+
  protected:
   // Deletion is only allowed via Destroy().
   virtual ~VideoDecoder();
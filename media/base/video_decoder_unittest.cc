@@ -0,0 +1,37 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "media/base/video_decoder.h"
+
+#include <algorithm>
+
+#include "base/system/sys_info.h"
+#include "media/base/limits.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace media {
+
+TEST(VideoDecoderTest, ReserveThreads) {
+  const int processors = base::SysInfo::NumberOfProcessors();
+
+  // A single decoder gets the threads it asks for.
+  int first = VideoDecoder::ReserveThreads(processors);
+  EXPECT_EQ(processors, first);
+
+  // Once all processors are reserved, other decoders only get the minimum.
+  int second = VideoDecoder::ReserveThreads(processors);
+  EXPECT_EQ(static_cast<int>(limits::kMinVideoDecodeThreads), second);
+
+  // Released threads can be reserved again.
+  VideoDecoder::ReleaseThreads(first);
+  int third = VideoDecoder::ReserveThreads(processors);
+  EXPECT_EQ(std::max(processors - second,
+                     static_cast<int>(limits::kMinVideoDecodeThreads)),
+            third);
+
+  VideoDecoder::ReleaseThreads(second);
+  VideoDecoder::ReleaseThreads(third);
+}
+
+}  // namespace media
@@ -56,6 +56,12 @@ using base::TimeDelta;
 
 namespace {
 
+// The largest number of bytes that AppendData() parses while holding the
+// demuxer lock. Larger appends are parsed in chunks of this size, and the lock
+// is released between them so that the media thread is not blocked for the
+// whole parse of a large segment.
+constexpr size_t kAppendChunkSize = 128 * 1024;
+
 // Helper to attempt construction of a StreamParser specific to |content_type|
 // and |codecs|.
 // TODO(wolenetz): Consider relocating this to StreamParserFactory in
@@ -880,31 +886,54 @@ bool ChunkDemuxer::AppendData(const std::string& id,
   DCHECK(!id.empty());
   DCHECK(timestamp_offset);
 
-  Ranges<TimeDelta> ranges;
+  if (length == 0u)
+    return true;
 
   {
     base::AutoLock auto_lock(lock_);
     DCHECK_NE(state_, ENDED);
+    DCHECK(appending_id_.empty());
+    if (bytes_received_cb_)
+      bytes_received_cb_.Run(length);
+    appending_id_ = id;
+    appending_id_was_reset_ = false;
+  }
 
-    // Capture if any of the SourceBuffers are waiting for data before we start
-    // parsing.
-    bool old_waiting_for_data = IsSeekWaitingForData_Locked();
+  DCHECK(data);
 
-    if (length == 0u)
-      return true;
+  const size_t max_chunk_size = append_chunk_size_for_test_
+                                    ? append_chunk_size_for_test_
+                                    : kAppendChunkSize;
+  Ranges<TimeDelta> ranges;
+  for (size_t offset = 0; offset < length; offset += max_chunk_size) {
+    if (offset > 0 && append_chunk_parsed_cb_for_test_)
+      append_chunk_parsed_cb_for_test_.Run();
 
-    if (bytes_received_cb_)
-      bytes_received_cb_.Run(length);
+    const size_t chunk_size = std::min(max_chunk_size, length - offset);
+    base::AutoLock auto_lock(lock_);
 
-    DCHECK(data);
+    // The parser was reset between two chunks, so the rest of the append
+    // belongs to a segment that no longer exists.
+    if (appending_id_was_reset_) {
+      DVLOG(1) << "AppendData(): parser reset, dropping " << length - offset
+               << " bytes";
+      ranges = GetBufferedRanges_Locked();
+      break;
+    }
+
+    // Capture if any of the SourceBuffers are waiting for data before we start
+    // parsing.
+    bool old_waiting_for_data = IsSeekWaitingForData_Locked();
 
     switch (state_) {
       case INITIALIZING:
       case INITIALIZED:
         DCHECK(IsValidId(id));
-        if (!source_state_map_[id]->Append(data, length, append_window_start,
+        if (!source_state_map_[id]->Append(data + offset, chunk_size,
+                                           append_window_start,
                                            append_window_end,
                                            timestamp_offset)) {
+          appending_id_.clear();
           ReportError_Locked(CHUNK_DEMUXER_ERROR_APPEND_FAILED);
           return false;
         }
@@ -914,7 +943,10 @@ bool ChunkDemuxer::AppendData(const std::string& id,
       case WAITING_FOR_INIT:
       case ENDED:
       case SHUTDOWN:
+        // The state can change between chunks, e.g. if the pipeline shuts
+        // down while a large append is parsed.
         DVLOG(1) << "AppendData(): called in unexpected state " << state_;
+        appending_id_.clear();
         return false;
     }
 
@@ -924,7 +956,13 @@ bool ChunkDemuxer::AppendData(const std::string& id,
     if (old_waiting_for_data && !IsSeekWaitingForData_Locked() && seek_cb_)
       RunSeekCB_Locked(PIPELINE_OK);
 
-    ranges = GetBufferedRanges_Locked();
+    if (offset + chunk_size == length)
+      ranges = GetBufferedRanges_Locked();
+  }
+
+  {
+    base::AutoLock auto_lock(lock_);
+    appending_id_.clear();
   }
 
   host_->OnBufferedTimeRangesChanged(ranges);
@@ -940,6 +978,8 @@ void ChunkDemuxer::ResetParserState(const std::string& id,
   base::AutoLock auto_lock(lock_);
   DCHECK(!id.empty());
   CHECK(IsValidId(id));
+  if (id == appending_id_)
+    appending_id_was_reset_ = true;
   bool old_waiting_for_data = IsSeekWaitingForData_Locked();
   source_state_map_[id]->ResetParserState(append_window_start,
                                           append_window_end,
@@ -1204,6 +1244,14 @@ void ChunkDemuxer::SetMemoryLimitsForTest(DemuxerStream::Type type,
   }
 }
 
+void ChunkDemuxer::SetAppendChunkSizeForTest(size_t chunk_size) {
+  append_chunk_size_for_test_ = chunk_size;
+}
+
+void ChunkDemuxer::SetAppendChunkParsedCBForTest(base::RepeatingClosure cb) {
+  append_chunk_parsed_cb_for_test_ = std::move(cb);
+}
+
 void ChunkDemuxer::ChangeState_Locked(State new_state) {
   lock_.AssertAcquired();
   DVLOG(1) << "ChunkDemuxer::ChangeState_Locked() : "
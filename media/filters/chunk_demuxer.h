@@ -302,6 +302,8 @@ class MEDIA_EXPORT ChunkDemuxer : public Demuxer {
   // similarly named source buffer attributes that are used in coded frame
   // processing. Returns true on success, false if the caller needs to run the
   // append error algorithm with decode error parameter set to true.
+  // Large appends are parsed in several steps, and the media thread may run
+  // demuxer operations such as Seek() between them.
   bool AppendData(const std::string& id,
                   const uint8_t* data,
                   size_t length,
@@ -397,6 +399,14 @@ class MEDIA_EXPORT ChunkDemuxer : public Demuxer {
   // is allowed to hold in its buffer.
   void SetMemoryLimitsForTest(DemuxerStream::Type type, size_t memory_limit);
 
+  // Overrides the size of the chunks that AppendData() parses large appends
+  // in.
+  void SetAppendChunkSizeForTest(size_t chunk_size);
+
+  // Runs |cb| between two chunks of an append, with the lock released, to
+  // simulate calls that the media thread makes during a large append.
+  void SetAppendChunkParsedCBForTest(base::RepeatingClosure cb);
+
   // Returns the ranges representing the buffered data in the demuxer.
   // TODO(wolenetz): Remove this method once MediaSourceDelegate no longer
   // requires it for doing hack browser seeks to I-frame on Android. See
@@ -553,6 +563,15 @@ class MEDIA_EXPORT ChunkDemuxer : public Demuxer {
   // Callback for reporting the number of bytes appended to this ChunkDemuxer.
   BytesReceivedCB bytes_received_cb_;
 
+  // The id of the SourceBuffer whose append is being parsed, and whether
+  // ResetParserState() was called for it between two chunks of the append. The
+  // rest of the append is then dropped, as if it had been aborted.
+  std::string appending_id_;
+  bool appending_id_was_reset_ = false;
+
+  size_t append_chunk_size_for_test_ = 0;
+  base::RepeatingClosure append_chunk_parsed_cb_for_test_;
+
   std::map<MediaTrack::Id, ChunkDemuxerStream*> track_id_to_demux_stream_map_;
 
   DISALLOW_COPY_AND_ASSIGN(ChunkDemuxer);
@@ -8,6 +8,7 @@
 #include <stdint.h>
 
 #include <algorithm>
+#include <limits>
 #include <queue>
 #include <utility>
 
@@ -20,6 +21,7 @@
 #include "base/strings/string_split.h"
 #include "base/strings/string_util.h"
 #include "base/synchronization/waitable_event.h"
+#include "base/test/bind_test_util.h"
 #include "base/test/scoped_feature_list.h"
 #include "base/test/scoped_task_environment.h"
 #include "media/base/audio_decoder_config.h"
@@ -3861,6 +3863,147 @@ TEST_P(ChunkDemuxerTest, AppendWindow_Video) {
   CheckExpectedRanges("{ [120,270) [420,630) }");
 }
 
+// Verifies that an append larger than the chunk size AppendData() parses at a
+// time buffers and applies the append window the same way as an append that
+// is parsed in one step.
+TEST_P(ChunkDemuxerTest, AppendWindow_Video_LargeAppendInChunks) {
+  // 12 blocks of 16 KiB make each cluster larger than the default 128 KiB
+  // append chunk.
+  block_size_ = 16 * 1024;
+
+  for (bool single_shot : {false, true}) {
+    SCOPED_TRACE(single_shot ? "single shot" : "chunked");
+    CreateNewDemuxer();
+    ASSERT_TRUE(InitDemuxer(HAS_VIDEO));
+    DemuxerStream* stream = GetStream(DemuxerStream::VIDEO);
+
+    int chunks_parsed = 0;
+    if (single_shot)
+      demuxer_->SetAppendChunkSizeForTest(std::numeric_limits<size_t>::max());
+    demuxer_->SetAppendChunkParsedCBForTest(
+        base::BindRepeating([](int* count) { ++*count; }, &chunks_parsed));
+
+    append_window_start_for_next_append_ =
+        base::TimeDelta::FromMilliseconds(50);
+    append_window_end_for_next_append_ = base::TimeDelta::FromMilliseconds(280);
+
+    EXPECT_MEDIA_LOG(DroppedFrame("video", 0));
+    EXPECT_MEDIA_LOG(DroppedFrame("video", 30000));
+    EXPECT_MEDIA_LOG(DroppedFrame("video", 270000));
+    EXPECT_MEDIA_LOG(DroppedFrame("video", 300000));
+    EXPECT_MEDIA_LOG(DroppedFrame("video", 330000));
+    EXPECT_MEDIA_LOG(WebMSimpleBlockDurationEstimated(30));
+    AppendSingleStreamCluster(kSourceId, kVideoTrackNum,
+                              "0K 30 60 90 120K 150 180 210 240K 270 300 330K");
+    if (single_shot)
+      EXPECT_EQ(0, chunks_parsed);
+    else
+      EXPECT_LT(0, chunks_parsed);
+
+    CheckExpectedRanges("{ [120,270) }");
+    CheckExpectedBuffers(stream, "120K 150 180 210 240K");
+
+    // The frames dropped at the end of the window leave the append window
+    // state waiting for the next key frame in both cases.
+    append_window_end_for_next_append_ = base::TimeDelta::FromMilliseconds(650);
+    EXPECT_MEDIA_LOG(DroppedFrame("video", 630000));
+    EXPECT_MEDIA_LOG(WebMSimpleBlockDurationEstimated(30));
+    AppendSingleStreamCluster(kSourceId, kVideoTrackNum,
+                              "360 390 420K 450 480 510 540K 570 600 630K");
+    CheckExpectedRanges("{ [120,270) [420,630) }");
+
+    ShutdownDemuxer();
+  }
+}
+
+TEST_P(ChunkDemuxerTest, SeekBetweenAppendChunks) {
+  ASSERT_TRUE(InitDemuxer(HAS_VIDEO));
+  DemuxerStream* stream = GetStream(DemuxerStream::VIDEO);
+  block_size_ = 16 * 1024;
+
+  // Start a seek the first time the media thread gets the lock in the middle
+  // of the append. It completes once the append buffers the seek point.
+  const base::TimeDelta seek_time = base::TimeDelta::FromMilliseconds(120);
+  bool seek_started = false;
+  demuxer_->SetAppendChunkParsedCBForTest(base::BindLambdaForTesting([&]() {
+    if (seek_started)
+      return;
+    seek_started = true;
+    demuxer_->StartWaitingForSeek(seek_time);
+    demuxer_->Seek(seek_time, NewExpectedStatusCB(PIPELINE_OK));
+  }));
+
+  EXPECT_MEDIA_LOG(WebMSimpleBlockDurationEstimated(30));
+  AppendSingleStreamCluster(kSourceId, kVideoTrackNum,
+                            "0K 30 60 90 120K 150 180 210 240K 270 300 330K");
+  base::RunLoop().RunUntilIdle();
+  EXPECT_TRUE(seek_started);
+
+  CheckExpectedRanges("{ [0,360) }");
+  CheckExpectedBuffers(stream, "120K 150 180 210 240K 270 300 330K");
+}
+
+TEST_P(ChunkDemuxerTest, ResetParserStateBetweenAppendChunks) {
+  ASSERT_TRUE(InitDemuxer(HAS_VIDEO));
+  block_size_ = 16 * 1024;
+
+  // Abort the append after its first chunk. Whatever that chunk buffered
+  // stays, and the rest of the append is dropped.
+  Ranges<base::TimeDelta> ranges_at_reset;
+  bool reset = false;
+  demuxer_->SetAppendChunkParsedCBForTest(base::BindLambdaForTesting([&]() {
+    if (reset)
+      return;
+    reset = true;
+    ranges_at_reset = demuxer_->GetBufferedRanges();
+    demuxer_->ResetParserState(kSourceId, append_window_start_for_next_append_,
+                               append_window_end_for_next_append_,
+                               &timestamp_offset_map_[kSourceId]);
+  }));
+
+  std::vector<BlockInfo> blocks;
+  ParseBlockDescriptions(kVideoTrackNum,
+                         "0K 30 60 90 120K 150 180 210 240K 270 300 330K",
+                         &blocks);
+  EXPECT_TRUE(AppendCluster(GenerateCluster(blocks, false)));
+  EXPECT_TRUE(reset);
+  EXPECT_FALSE(demuxer_->IsParsingMediaSegment(kSourceId));
+
+  auto expect_ranges_eq = [](const Ranges<base::TimeDelta>& expected,
+                             const Ranges<base::TimeDelta>& actual) {
+    ASSERT_EQ(expected.size(), actual.size());
+    for (size_t i = 0; i < expected.size(); ++i) {
+      EXPECT_EQ(expected.start(i), actual.start(i));
+      EXPECT_EQ(expected.end(i), actual.end(i));
+    }
+  };
+  expect_ranges_eq(ranges_at_reset, demuxer_->GetBufferedRanges());
+
+  // The parser accepts a new media segment after the aborted one.
+  demuxer_->SetAppendChunkParsedCBForTest(base::RepeatingClosure());
+  block_size_ = kBlockSize;
+  EXPECT_MEDIA_LOG(WebMSimpleBlockDurationEstimated(30));
+  AppendSingleStreamCluster(kSourceId, kVideoTrackNum, "600K 630 660 690K");
+  Ranges<base::TimeDelta> expected = ranges_at_reset;
+  expected.Add(base::TimeDelta::FromMilliseconds(600),
+               base::TimeDelta::FromMilliseconds(720));
+  expect_ranges_eq(expected, demuxer_->GetBufferedRanges());
+}
+
+TEST_P(ChunkDemuxerTest, ShutdownBetweenAppendChunks) {
+  ASSERT_TRUE(InitDemuxer(HAS_VIDEO));
+  block_size_ = 16 * 1024;
+
+  demuxer_->SetAppendChunkParsedCBForTest(
+      base::BindLambdaForTesting([&]() { demuxer_->Shutdown(); }));
+
+  std::vector<BlockInfo> blocks;
+  ParseBlockDescriptions(kVideoTrackNum,
+                         "0K 30 60 90 120K 150 180 210 240K 270 300 330K",
+                         &blocks);
+  EXPECT_FALSE(AppendCluster(GenerateCluster(blocks, false)));
+}
+
 TEST_P(ChunkDemuxerTest, AppendWindow_Audio) {
   ASSERT_TRUE(InitDemuxer(HAS_AUDIO));
   DemuxerStream* stream = GetStream(DemuxerStream::AUDIO);
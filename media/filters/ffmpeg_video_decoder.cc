@@ -372,6 +372,10 @@ bool FFmpegVideoDecoder::OnNewFrame(AVFrame* frame) {
 void FFmpegVideoDecoder::ReleaseFFmpegResources() {
   decoding_loop_.reset();
   codec_context_.reset();
+  if (reserved_threads_) {
+    ReleaseThreads(reserved_threads_);
+    reserved_threads_ = 0;
+  }
 }
 
 bool FFmpegVideoDecoder::ConfigureDecoder(const VideoDecoderConfig& config,
@@ -386,7 +390,8 @@ bool FFmpegVideoDecoder::ConfigureDecoder(const VideoDecoderConfig& config,
   codec_context_.reset(avcodec_alloc_context3(NULL));
   VideoDecoderConfigToAVCodecContext(config, codec_context_.get());
 
-  codec_context_->thread_count = GetFFmpegVideoDecoderThreadCount(config);
+  reserved_threads_ = ReserveThreads(GetFFmpegVideoDecoderThreadCount(config));
+  codec_context_->thread_count = reserved_threads_;
   codec_context_->thread_type =
       FF_THREAD_SLICE | (low_delay ? 0 : FF_THREAD_FRAME);
   codec_context_->opaque = this;
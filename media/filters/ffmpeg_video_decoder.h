@@ -94,6 +94,10 @@ class MEDIA_EXPORT FFmpegVideoDecoder : public VideoDecoder {
 
   std::unique_ptr<FFmpegDecodingLoop> decoding_loop_;
 
+  // The number of decoding threads reserved with ReserveThreads() for
+  // |codec_context_|.
+  int reserved_threads_ = 0;
+
   DISALLOW_COPY_AND_ASSIGN(FFmpegVideoDecoder);
 };
 
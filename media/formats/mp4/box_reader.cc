@@ -120,7 +120,7 @@ ParseResult BoxReader::ReadTopLevelBox(const uint8_t* buf,
   DCHECK(out_reader);
   std::unique_ptr<BoxReader> reader(
       new BoxReader(buf, buf_size, media_log, false));
-  RCHECK_OK_PARSE_RESULT(reader->ReadHeader());
+  RCHECK_OK_PARSE_RESULT(reader->ReadHeader(true));
   if (!IsValidTopLevelBox(reader->type(), media_log))
     return ParseResult::kError;
   *out_reader = std::move(reader);
@@ -140,6 +140,21 @@ ParseResult BoxReader::StartTopLevelBox(const uint8_t* buf,
   return ParseResult::kOk;
 }
 
+// static
+ParseResult BoxReader::ReadTopLevelBoxHeader(const uint8_t* buf,
+                                             const size_t buf_size,
+                                             MediaLog* media_log,
+                                             FourCC* out_type,
+                                             size_t* out_box_size) {
+  BoxReader reader(buf, buf_size, media_log, false);
+  RCHECK_OK_PARSE_RESULT(reader.ReadHeader(false));
+  if (!IsValidTopLevelBox(reader.type(), media_log))
+    return ParseResult::kError;
+  *out_type = reader.type();
+  *out_box_size = reader.box_size();
+  return ParseResult::kOk;
+}
+
 // static
 BoxReader* BoxReader::ReadConcatentatedBoxes(const uint8_t* buf,
                                              const size_t buf_size,
@@ -194,7 +209,7 @@ bool BoxReader::ScanChildren() {
   DCHECK_LE(pos_, box_size_);
   while (pos_ < box_size_) {
     BoxReader child(&buf_[pos_], box_size_ - pos_, media_log_, is_EOS_);
-    if (child.ReadHeader() != ParseResult::kOk)
+    if (child.ReadHeader(true) != ParseResult::kOk)
       return false;
     children_.insert(std::pair<FourCC, BoxReader>(child.type(), child));
     pos_ += child.box_size();
@@ -243,7 +258,7 @@ bool BoxReader::ReadFullBoxHeader() {
   return true;
 }
 
-ParseResult BoxReader::ReadHeader() {
+ParseResult BoxReader::ReadHeader(bool require_complete_box) {
   uint64_t box_size = 0;
 
   if (!HasBytes(8))
@@ -279,7 +294,8 @@ ParseResult BoxReader::ReadHeader() {
 
   // Make sure the buffer contains at least the expected number of bytes.
   // Since the data may be appended in pieces, this is only an error if EOS.
-  if (box_size > base::strict_cast<uint64_t>(buf_size_))
+  if (require_complete_box &&
+      box_size > base::strict_cast<uint64_t>(buf_size_))
     return is_EOS_ ? ParseResult::kError : ParseResult::kNeedMoreData;
 
   // Note that the pos_ head has advanced to the byte immediately after the
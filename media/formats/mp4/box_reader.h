@@ -124,6 +124,18 @@ class MEDIA_EXPORT BoxReader : public BufferReader {
                                       FourCC* out_type,
                                       size_t* out_box_size) WARN_UNUSED_RESULT;
 
+  // Like StartTopLevelBox(), but returns kOk as soon as the box header is
+  // complete, so that callers can discard boxes they don't parse without
+  // buffering them.
+  //
+  // |buf| is not retained.
+  static ParseResult ReadTopLevelBoxHeader(const uint8_t* buf,
+                                           const size_t buf_size,
+                                           MediaLog* media_log,
+                                           FourCC* out_type,
+                                           size_t* out_box_size)
+      WARN_UNUSED_RESULT;
+
   // Create a BoxReader from a buffer. |buf| must be the complete buffer, as
   // errors are returned when sufficient data is not available. |buf| can start
   // with any type of box -- it does not have to be IsValidTopLevelBox().
@@ -204,8 +216,10 @@ class MEDIA_EXPORT BoxReader : public BufferReader {
             MediaLog* media_log,
             bool is_EOS);
 
-  // Must be called immediately after init.
-  ParseResult ReadHeader() WARN_UNUSED_RESULT;
+  // Must be called immediately after init. If |require_complete_box| is false,
+  // this succeeds once the header itself has been read, even if the rest of
+  // the box is not in the buffer yet.
+  ParseResult ReadHeader(bool require_complete_box) WARN_UNUSED_RESULT;
 
   // Read all children, optionally checking FourCC. Returns true if all
   // children are successfully parsed and, if |check_box_type|, have the
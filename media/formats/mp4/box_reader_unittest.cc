@@ -190,6 +190,23 @@ TEST_F(BoxReaderTest, OuterTooShortTest) {
   EXPECT_FALSE(r);
 }
 
+TEST_F(BoxReaderTest, ReadTopLevelBoxHeaderOfIncompleteBox) {
+  std::vector<uint8_t> buf = GetBuf();
+
+  // Only the header is needed to get the type and size of a box.
+  FourCC type;
+  size_t box_size;
+  EXPECT_EQ(ParseResult::kOk,
+            BoxReader::ReadTopLevelBoxHeader(&buf[0], 8, &media_log_, &type,
+                                             &box_size));
+  EXPECT_EQ(FOURCC_SKIP, type);
+  EXPECT_EQ(0x40u, box_size);
+
+  EXPECT_EQ(ParseResult::kNeedMoreData,
+            BoxReader::ReadTopLevelBoxHeader(&buf[0], 7, &media_log_, &type,
+                                             &box_size));
+}
+
 TEST_F(BoxReaderTest, InnerTooLongTest) {
   std::vector<uint8_t> buf = GetBuf();
 
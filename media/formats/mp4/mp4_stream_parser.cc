@@ -6,6 +6,7 @@
 
 #include <stddef.h>
 
+#include <algorithm>
 #include <limits>
 #include <memory>
 #include <utility>
@@ -85,6 +86,7 @@ MP4StreamParser::MP4StreamParser(const std::set<int>& audio_object_types,
     : state_(kWaitingForInit),
       moof_head_(0),
       mdat_tail_(0),
+      skip_bytes_remaining_(0),
       highest_end_offset_(0),
       has_audio_(false),
       has_video_(false),
@@ -130,6 +132,7 @@ void MP4StreamParser::Reset() {
   runs_.reset();
   moof_head_ = 0;
   mdat_tail_ = 0;
+  skip_bytes_remaining_ = 0;
 }
 
 void MP4StreamParser::Flush() {
@@ -211,9 +214,35 @@ ParseResult MP4StreamParser::ParseBox() {
   if (!size)
     return ParseResult::kNeedMoreData;
 
+  // Discard the rest of a box being skipped as it is appended.
+  if (skip_bytes_remaining_ > 0) {
+    int skip_size = static_cast<int>(
+        std::min(skip_bytes_remaining_, static_cast<size_t>(size)));
+    queue_.Pop(skip_size);
+    skip_bytes_remaining_ -= skip_size;
+    return skip_bytes_remaining_ > 0 ? ParseResult::kNeedMoreData
+                                     : ParseResult::kOk;
+  }
+
+  // Only 'moov' and 'moof' boxes are parsed. Other boxes can be large (for
+  // example 'mdat' boxes of non-fragmented files, or padding in 'free'
+  // boxes), so don't wait for them to be complete before dropping them.
+  FourCC type;
+  size_t box_size;
+  ParseResult result = BoxReader::ReadTopLevelBoxHeader(buf, size, media_log_,
+                                                        &type, &box_size);
+  if (result != ParseResult::kOk)
+    return result;
+  if (type != FOURCC_MOOV && type != FOURCC_MOOF) {
+    // TODO(wolenetz,chcunningham): Enforce more strict adherence to MSE byte
+    // stream spec for ftyp and styp. See http://crbug.com/504514.
+    DVLOG(2) << "Skipping unrecognized top-level box: " << FourCCToString(type);
+    skip_bytes_remaining_ = box_size;
+    return ParseResult::kOk;
+  }
+
   std::unique_ptr<BoxReader> reader;
-  ParseResult result =
-      BoxReader::ReadTopLevelBox(buf, size, media_log_, &reader);
+  result = BoxReader::ReadTopLevelBox(buf, size, media_log_, &reader);
   if (result != ParseResult::kOk)
     return result;
 
@@ -234,11 +263,6 @@ ParseResult MP4StreamParser::ParseBox() {
     // (Since 'default-base-is-moof' is mandated, no data references can come
     // before the head of the 'moof', so keeping this box around is sufficient.)
     return ParseResult::kOk;
-  } else {
-    // TODO(wolenetz,chcunningham): Enforce more strict adherence to MSE byte
-    // stream spec for ftyp and styp. See http://crbug.com/504514.
-    DVLOG(2) << "Skipping unrecognized top-level box: "
-             << FourCCToString(reader->type());
   }
 
   queue_.Pop(reader->box_size());
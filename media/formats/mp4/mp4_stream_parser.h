@@ -124,6 +124,10 @@ class MEDIA_EXPORT MP4StreamParser : public StreamParser {
   // Valid iff it is greater than the head of the queue.
   int64_t mdat_tail_;
 
+  // The number of bytes of the top-level box being skipped by ParseBox() that
+  // have not been appended yet.
+  size_t skip_bytes_remaining_;
+
   // The highest end offset in the current moof. This offset is
   // relative to |moof_head_|. This value is used to make sure we have collected
   // enough bytes to parse all samples and aux_info in the current moof.
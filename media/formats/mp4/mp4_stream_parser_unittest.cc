@@ -11,6 +11,7 @@
 #include <memory>
 #include <string>
 #include <tuple>
+#include <vector>
 
 #include "base/bind.h"
 #include "base/bind_helpers.h"
@@ -259,6 +260,19 @@ TEST_F(MP4StreamParserTest, UnalignedAppend) {
   ParseMP4File("bear-1280x720-av_frag.mp4", 512);
 }
 
+TEST_F(MP4StreamParserTest, LargeSkippedBoxBeforeInitSegment) {
+  // A 'free' box is dropped as it is appended rather than once it is complete.
+  InitializeParser();
+  std::vector<uint8_t> free_box(1024 * 1024);
+  free_box[1] = 0x10;  // 1 MiB box size.
+  free_box[4] = 'f';
+  free_box[5] = 'r';
+  free_box[6] = 'e';
+  free_box[7] = 'e';
+  EXPECT_TRUE(AppendDataInPieces(free_box.data(), free_box.size(), 4096));
+  ParseMP4File("bear-1280x720-av_frag.mp4", 512);
+}
+
 constexpr char kShakaPackagerUMA[] = "Media.MSE.DetectedShakaPackagerInMp4";
 
 TEST_F(MP4StreamParserTest, DidNotUseShakaPackager) {
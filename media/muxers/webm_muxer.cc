@@ -160,7 +160,9 @@ bool WebmMuxer::OnEncodedVideo(const VideoParameters& params,
   // Any saved encoded video frames must have been dumped in OnEncodedAudio();
   DCHECK(encoded_frames_queue_.empty());
 
-  return AddFrame(std::move(encoded_data), std::move(encoded_alpha),
+  return AddFrame(*encoded_data,
+                  encoded_alpha ? base::StringPiece(*encoded_alpha)
+                                : base::StringPiece(),
                   video_track_index_, timestamp - first_frame_timestamp_video_,
                   is_key_frame);
 }
@@ -184,22 +186,21 @@ bool WebmMuxer::OnEncodedAudio(const media::AudioParameters& params,
     return true;
   }
 
-  // Dump all saved encoded video frames if any.
+  // Dump all saved encoded video frames if any. A frame stays queued until it
+  // has been added, so that it is retried if libwebm fails.
   while (!encoded_frames_queue_.empty()) {
+    const EncodedVideoFrame& frame = *encoded_frames_queue_.front();
     const bool res = AddFrame(
-        std::make_unique<std::string>(*encoded_frames_queue_.front()->data),
-        encoded_frames_queue_.front()->alpha_data
-            ? std::make_unique<std::string>(
-                  *encoded_frames_queue_.front()->alpha_data)
-            : nullptr,
-        video_track_index_,
-        encoded_frames_queue_.front()->timestamp - first_frame_timestamp_video_,
-        encoded_frames_queue_.front()->is_keyframe);
+        *frame.data,
+        frame.alpha_data ? base::StringPiece(*frame.alpha_data)
+                         : base::StringPiece(),
+        video_track_index_, frame.timestamp - first_frame_timestamp_video_,
+        frame.is_keyframe);
     if (!res)
       return false;
     encoded_frames_queue_.pop_front();
   }
-  return AddFrame(std::move(encoded_data), nullptr, audio_track_index_,
+  return AddFrame(*encoded_data, base::StringPiece(), audio_track_index_,
                   timestamp - first_frame_timestamp_audio_,
                   true /* is_key_frame -- always true for audio */);
 }
@@ -220,6 +221,13 @@ void WebmMuxer::Resume() {
   }
 }
 
+void WebmMuxer::SetMaximumClusterDuration(base::TimeDelta duration) {
+  DCHECK(thread_checker_.CalledOnValidThread());
+  DCHECK_GT(duration, base::TimeDelta());
+  segment_.set_max_cluster_duration(duration.InMicroseconds() *
+                                    base::Time::kNanosecondsPerMicrosecond);
+}
+
 void WebmMuxer::AddVideoTrack(const gfx::Size& frame_size, double frame_rate) {
   DCHECK(thread_checker_.CalledOnValidThread());
   DCHECK_EQ(0u, video_track_index_)
@@ -330,8 +338,8 @@ void WebmMuxer::ElementStartNotify(mkvmuxer::uint64 element_id,
       << "Can't go back in a live WebM stream.";
 }
 
-bool WebmMuxer::AddFrame(std::unique_ptr<std::string> encoded_data,
-                         std::unique_ptr<std::string> encoded_alpha,
+bool WebmMuxer::AddFrame(base::StringPiece encoded_data,
+                         base::StringPiece encoded_alpha,
                          uint8_t track_index,
                          base::TimeDelta timestamp,
                          bool is_key_frame) {
@@ -348,22 +356,21 @@ bool WebmMuxer::AddFrame(std::unique_ptr<std::string> encoded_data,
     return false;
   }
 
-  DCHECK(encoded_data->data());
-  if (!encoded_alpha || encoded_alpha->empty()) {
+  DCHECK(encoded_data.data());
+  if (encoded_alpha.empty()) {
     return segment_.AddFrame(
-        reinterpret_cast<const uint8_t*>(encoded_data->data()),
-        encoded_data->size(), track_index,
+        reinterpret_cast<const uint8_t*>(encoded_data.data()),
+        encoded_data.size(), track_index,
         most_recent_timestamp_.InMicroseconds() *
             base::Time::kNanosecondsPerMicrosecond,
         is_key_frame);
   }
 
-  DCHECK(encoded_alpha->data());
   return segment_.AddFrameWithAdditional(
-      reinterpret_cast<const uint8_t*>(encoded_data->data()),
-      encoded_data->size(),
-      reinterpret_cast<const uint8_t*>(encoded_alpha->data()),
-      encoded_alpha->size(), 1 /* add_id */, track_index,
+      reinterpret_cast<const uint8_t*>(encoded_data.data()),
+      encoded_data.size(),
+      reinterpret_cast<const uint8_t*>(encoded_alpha.data()),
+      encoded_alpha.size(), 1 /* add_id */, track_index,
       most_recent_timestamp_.InMicroseconds() *
           base::Time::kNanosecondsPerMicrosecond,
       is_key_frame);
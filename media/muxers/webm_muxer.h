@@ -83,6 +83,12 @@ class MEDIA_EXPORT WebmMuxer : public mkvmuxer::IMkvWriter {
   void Pause();
   void Resume();
 
+  // Limits the duration of each WebM Cluster to |duration|. Otherwise a new
+  // Cluster is only started at video key frames, or when block timecodes
+  // relative to the Cluster would overflow. Short Clusters let a live consumer
+  // forward complete Clusters sooner, at the cost of some overhead.
+  void SetMaximumClusterDuration(base::TimeDelta duration);
+
   void ForceOneLibWebmErrorForTesting() { force_one_libwebm_error_ = true; }
 
  private:
@@ -104,9 +110,10 @@ class MEDIA_EXPORT WebmMuxer : public mkvmuxer::IMkvWriter {
   void ElementStartNotify(mkvmuxer::uint64 element_id,
                           mkvmuxer::int64 position) override;
 
-  // Helper to simplify saving frames. Returns true on success.
-  bool AddFrame(std::unique_ptr<std::string> encoded_data,
-                std::unique_ptr<std::string> encoded_alpha_data,
+  // Helper to simplify saving frames. Returns true on success. An empty
+  // |encoded_alpha_data| means the frame has no alpha.
+  bool AddFrame(base::StringPiece encoded_data,
+                base::StringPiece encoded_alpha_data,
                 uint8_t track_index,
                 base::TimeDelta timestamp,
                 bool is_key_frame);
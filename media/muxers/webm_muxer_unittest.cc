@@ -75,6 +75,10 @@ class WebmMuxerTest : public TestWithParam<TestParams> {
     return webm_muxer_.segment_.mode();
   }
 
+  mkvmuxer::uint64 GetWebmSegmentMaxClusterDuration() const {
+    return webm_muxer_.segment_.max_cluster_duration();
+  }
+
   mkvmuxer::int32 WebmMuxerWrite(const void* buf, mkvmuxer::uint32 len) {
     return webm_muxer_.Write(buf, len);
   }
@@ -313,6 +317,13 @@ TEST_P(WebmMuxerTest, VideoIsStoredWhileWaitingForAudio) {
       base::TimeTicks::Now()));
 }
 
+TEST_P(WebmMuxerTest, SetMaximumClusterDuration) {
+  EXPECT_EQ(0u, GetWebmSegmentMaxClusterDuration());
+  webm_muxer_.SetMaximumClusterDuration(
+      base::TimeDelta::FromMilliseconds(500));
+  EXPECT_EQ(500000000u, GetWebmSegmentMaxClusterDuration());
+}
+
 const TestParams kTestCases[] = {
     {kCodecVP8, kCodecOpus, 1 /* num_video_tracks */, 0 /*num_audio_tracks*/},
     {kCodecVP8, kCodecOpus, 0, 1},
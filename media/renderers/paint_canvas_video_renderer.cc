@@ -36,6 +36,8 @@
     SK_A32_SHIFT == 24
 #define LIBYUV_I420_TO_ARGB libyuv::I420ToARGB
 #define LIBYUV_I422_TO_ARGB libyuv::I422ToARGB
+#define LIBYUV_J422_TO_ARGB libyuv::J422ToARGB
+#define LIBYUV_H422_TO_ARGB libyuv::H422ToARGB
 #define LIBYUV_I444_TO_ARGB libyuv::I444ToARGB
 #define LIBYUV_I420ALPHA_TO_ARGB libyuv::I420AlphaToARGB
 #define LIBYUV_J420_TO_ARGB libyuv::J420ToARGB
@@ -47,6 +49,8 @@
     SK_A32_SHIFT == 24
 #define LIBYUV_I420_TO_ARGB libyuv::I420ToABGR
 #define LIBYUV_I422_TO_ARGB libyuv::I422ToABGR
+#define LIBYUV_J422_TO_ARGB libyuv::J422ToABGR
+#define LIBYUV_H422_TO_ARGB libyuv::H422ToABGR
 #define LIBYUV_I444_TO_ARGB libyuv::I444ToABGR
 #define LIBYUV_I420ALPHA_TO_ARGB libyuv::I420AlphaToABGR
 #define LIBYUV_J420_TO_ARGB libyuv::J420ToABGR
@@ -695,6 +699,7 @@ scoped_refptr<VideoFrame> DownShiftHighbitVideoFrame(
   VideoPixelFormat format;
   switch (video_frame->format()) {
     case PIXEL_FORMAT_YUV420P12:
+    case PIXEL_FORMAT_YUV420P10:
     case PIXEL_FORMAT_YUV420P9:
       format = PIXEL_FORMAT_I420;
       break;
@@ -716,6 +721,7 @@ scoped_refptr<VideoFrame> DownShiftHighbitVideoFrame(
       return nullptr;
   }
   const int shift = video_frame->BitDepth() - 8;
+  DCHECK_GT(shift, 0);
   scoped_refptr<VideoFrame> ret = VideoFrame::CreateFrame(
       format, video_frame->coded_size(), video_frame->visible_rect(),
       video_frame->natural_size(), video_frame->timestamp());
@@ -725,18 +731,14 @@ scoped_refptr<VideoFrame> DownShiftHighbitVideoFrame(
   // (May be enough to copy color space)
   ret->metadata()->MergeMetadataFrom(video_frame->metadata());
 
+  // Convert16To8Plane() multiplies by |scale| and keeps the upper 16 bits, so
+  // this is a vectorized right shift by |shift|.
+  const int scale = 0x10000 >> shift;
   for (int plane = VideoFrame::kYPlane; plane <= VideoFrame::kVPlane; ++plane) {
-    int width = ret->row_bytes(plane);
-    const uint16_t* src =
-        reinterpret_cast<const uint16_t*>(video_frame->data(plane));
-    uint8_t* dst = ret->data(plane);
-    for (int row = 0; row < video_frame->rows(plane); row++) {
-      for (int x = 0; x < width; x++) {
-        dst[x] = src[x] >> shift;
-      }
-      src += video_frame->stride(plane) / 2;
-      dst += ret->stride(plane);
-    }
+    libyuv::Convert16To8Plane(
+        reinterpret_cast<const uint16_t*>(video_frame->data(plane)),
+        video_frame->stride(plane) / 2, ret->data(plane), ret->stride(plane),
+        scale, ret->row_bytes(plane), video_frame->rows(plane));
   }
   return ret;
 }
@@ -926,15 +928,43 @@ void PaintCanvasVideoRenderer::ConvertVideoFrameToRGBPixels(
       }
       break;
     case PIXEL_FORMAT_I422:
-      LIBYUV_I422_TO_ARGB(video_frame->visible_data(VideoFrame::kYPlane),
-                          video_frame->stride(VideoFrame::kYPlane),
-                          video_frame->visible_data(VideoFrame::kUPlane),
-                          video_frame->stride(VideoFrame::kUPlane),
-                          video_frame->visible_data(VideoFrame::kVPlane),
-                          video_frame->stride(VideoFrame::kVPlane),
-                          static_cast<uint8_t*>(rgb_pixels), row_bytes,
-                          video_frame->visible_rect().width(),
-                          video_frame->visible_rect().height());
+      switch (color_space) {
+        case kJPEG_SkYUVColorSpace:
+          LIBYUV_J422_TO_ARGB(video_frame->visible_data(VideoFrame::kYPlane),
+                              video_frame->stride(VideoFrame::kYPlane),
+                              video_frame->visible_data(VideoFrame::kUPlane),
+                              video_frame->stride(VideoFrame::kUPlane),
+                              video_frame->visible_data(VideoFrame::kVPlane),
+                              video_frame->stride(VideoFrame::kVPlane),
+                              static_cast<uint8_t*>(rgb_pixels), row_bytes,
+                              video_frame->visible_rect().width(),
+                              video_frame->visible_rect().height());
+          break;
+        case kRec709_SkYUVColorSpace:
+          LIBYUV_H422_TO_ARGB(video_frame->visible_data(VideoFrame::kYPlane),
+                              video_frame->stride(VideoFrame::kYPlane),
+                              video_frame->visible_data(VideoFrame::kUPlane),
+                              video_frame->stride(VideoFrame::kUPlane),
+                              video_frame->visible_data(VideoFrame::kVPlane),
+                              video_frame->stride(VideoFrame::kVPlane),
+                              static_cast<uint8_t*>(rgb_pixels), row_bytes,
+                              video_frame->visible_rect().width(),
+                              video_frame->visible_rect().height());
+          break;
+        case kRec601_SkYUVColorSpace:
+          LIBYUV_I422_TO_ARGB(video_frame->visible_data(VideoFrame::kYPlane),
+                              video_frame->stride(VideoFrame::kYPlane),
+                              video_frame->visible_data(VideoFrame::kUPlane),
+                              video_frame->stride(VideoFrame::kUPlane),
+                              video_frame->visible_data(VideoFrame::kVPlane),
+                              video_frame->stride(VideoFrame::kVPlane),
+                              static_cast<uint8_t*>(rgb_pixels), row_bytes,
+                              video_frame->visible_rect().width(),
+                              video_frame->visible_rect().height());
+          break;
+        default:
+          NOTREACHED();
+      }
       break;
 
     case PIXEL_FORMAT_I420A:
@@ -966,7 +996,14 @@ void PaintCanvasVideoRenderer::ConvertVideoFrameToRGBPixels(
       break;
 
     case PIXEL_FORMAT_YUV420P10:
-      if (color_space == kRec709_SkYUVColorSpace) {
+      if (color_space == kJPEG_SkYUVColorSpace) {
+        // libyuv has no full range 10-bit conversion; shift down to 8 bits
+        // and use the J420 one.
+        scoped_refptr<VideoFrame> temporary_frame =
+            DownShiftHighbitVideoFrame(video_frame);
+        ConvertVideoFrameToRGBPixels(temporary_frame.get(), rgb_pixels,
+                                     row_bytes);
+      } else if (color_space == kRec709_SkYUVColorSpace) {
         LIBYUV_H010_TO_ARGB(reinterpret_cast<const uint16_t*>(
                                 video_frame->visible_data(VideoFrame::kYPlane)),
                             video_frame->stride(VideoFrame::kYPlane) / 2,
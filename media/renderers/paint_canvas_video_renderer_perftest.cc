@@ -0,0 +1,62 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <stdint.h>
+
+#include <vector>
+
+#include "base/time/time.h"
+#include "media/base/video_frame.h"
+#include "media/renderers/paint_canvas_video_renderer.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "testing/perf/perf_test.h"
+#include "ui/gfx/color_space.h"
+
+namespace media {
+
+static const int kBenchmarkIterations = 50;
+
+static void RunConvertBench(VideoPixelFormat format,
+                            const gfx::ColorSpace& color_space,
+                            const std::string& trace_name) {
+  const gfx::Size size(1920, 1080);
+  scoped_refptr<VideoFrame> frame = VideoFrame::CreateZeroInitializedFrame(
+      format, size, gfx::Rect(size), size, base::TimeDelta());
+  frame->set_color_space(color_space);
+
+  const size_t row_bytes = size.width() * 4;
+  std::vector<uint8_t> rgb_pixels(row_bytes * size.height());
+
+  base::TimeTicks start = base::TimeTicks::Now();
+  for (int i = 0; i < kBenchmarkIterations; ++i) {
+    PaintCanvasVideoRenderer::ConvertVideoFrameToRGBPixels(
+        frame.get(), rgb_pixels.data(), row_bytes);
+  }
+  double total_time_milliseconds =
+      (base::TimeTicks::Now() - start).InMillisecondsF();
+  perf_test::PrintResult("convert_video_frame_to_rgb_pixels", "", trace_name,
+                         total_time_milliseconds / kBenchmarkIterations, "ms",
+                         true);
+}
+
+// Benchmark ConvertVideoFrameToRGBPixels() for 1080p frames of the formats
+// that are converted directly and of those that are shifted down to 8 bits
+// first.
+TEST(PaintCanvasVideoRendererPerfTest, ConvertVideoFrameToRGBPixels) {
+  RunConvertBench(PIXEL_FORMAT_I420, gfx::ColorSpace::CreateREC601(), "i420");
+  RunConvertBench(PIXEL_FORMAT_I420, gfx::ColorSpace::CreateREC709(),
+                  "i420_rec709");
+  RunConvertBench(PIXEL_FORMAT_I422, gfx::ColorSpace::CreateJpeg(),
+                  "i422_jpeg");
+  RunConvertBench(PIXEL_FORMAT_YUV420P10, gfx::ColorSpace::CreateREC709(),
+                  "yuv420p10_rec709");
+  RunConvertBench(PIXEL_FORMAT_YUV420P10, gfx::ColorSpace::CreateJpeg(),
+                  "yuv420p10_jpeg");
+  RunConvertBench(PIXEL_FORMAT_YUV422P10, gfx::ColorSpace::CreateREC709(),
+                  "yuv422p10_rec709");
+  RunConvertBench(PIXEL_FORMAT_YUV444P12, gfx::ColorSpace::CreateREC601(),
+                  "yuv444p12");
+}
+
+}  // namespace media
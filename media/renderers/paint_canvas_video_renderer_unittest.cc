@@ -5,6 +5,8 @@
 #include <GLES3/gl3.h>
 #include <stdint.h>
 
+#include <vector>
+
 #include "base/bind.h"
 #include "base/macros.h"
 #include "base/memory/aligned_memory.h"
@@ -542,6 +544,39 @@ TEST_F(PaintCanvasVideoRendererTest, HighBitDepth) {
   }
 }
 
+TEST_F(PaintCanvasVideoRendererTest, HighBitDepthFullRange) {
+  // A 10-bit full range frame converts exactly like the 8-bit frame it was
+  // made from.
+  cropped_frame()->set_color_space(gfx::ColorSpace::CreateJpeg());
+  scoped_refptr<VideoFrame> frame(VideoFrame::CreateFrame(
+      PIXEL_FORMAT_YUV420P10, cropped_frame()->coded_size(),
+      cropped_frame()->visible_rect(), cropped_frame()->natural_size(),
+      cropped_frame()->timestamp()));
+  frame->set_color_space(gfx::ColorSpace::CreateJpeg());
+  for (int plane = VideoFrame::kYPlane; plane <= VideoFrame::kVPlane;
+       ++plane) {
+    int width = cropped_frame()->row_bytes(plane);
+    uint16_t* dst = reinterpret_cast<uint16_t*>(frame->data(plane));
+    uint8_t* src = cropped_frame()->data(plane);
+    for (int row = 0; row < cropped_frame()->rows(plane); row++) {
+      for (int col = 0; col < width; col++)
+        dst[col] = src[col] << 2;
+      src += cropped_frame()->stride(plane);
+      dst += frame->stride(plane) / 2;
+    }
+  }
+
+  const gfx::Size size = frame->visible_rect().size();
+  const size_t row_bytes = size.width() * 4;
+  std::vector<uint8_t> expected(row_bytes * size.height());
+  std::vector<uint8_t> actual(row_bytes * size.height());
+  PaintCanvasVideoRenderer::ConvertVideoFrameToRGBPixels(
+      cropped_frame().get(), expected.data(), row_bytes);
+  PaintCanvasVideoRenderer::ConvertVideoFrameToRGBPixels(
+      frame.get(), actual.data(), row_bytes);
+  EXPECT_EQ(expected, actual);
+}
+
 TEST_F(PaintCanvasVideoRendererTest, Y16) {
   SkBitmap bitmap;
   bitmap.allocPixels(SkImageInfo::MakeN32(16, 16, kPremul_SkAlphaType));
@@ -1102,11 +1102,22 @@ VideoFrameExternalResources VideoResourceUpdater::CreateForSoftwarePlanes(
         (bits_per_channel == resource_bit_depth) &&
         (upload_image_stride != static_cast<size_t>(video_stride_bytes));
 
+    // The strides can be reconciled during the upload with
+    // GL_UNPACK_ROW_LENGTH_EXT, which the command buffer supports even on ES2,
+    // rather than by a copy into |upload_pixels_|. This needs a positive source
+    // stride that is a multiple of both the unpack alignment and the pixel
+    // size.
+    const int bytes_per_pixel = static_cast<int>(resource_bit_depth / 8);
+    const bool use_unpack_row_length =
+        needs_stride_adaptation && video_stride_bytes > 0 &&
+        video_stride_bytes % 4 == 0 &&
+        video_stride_bytes % bytes_per_pixel == 0;
+
     // We need to convert the incoming data if we're transferring to half float,
     // if the need a bit downshift or if the strides need to be reconciled.
-    const bool needs_conversion = plane_resource_format == viz::LUMINANCE_F16 ||
-                                  needs_bit_downshifting ||
-                                  needs_stride_adaptation;
+    const bool needs_conversion =
+        plane_resource_format == viz::LUMINANCE_F16 || needs_bit_downshifting ||
+        (needs_stride_adaptation && !use_unpack_row_length);
 
     const uint8_t* pixels;
     if (!needs_conversion) {
@@ -1161,11 +1172,17 @@ VideoFrameExternalResources VideoResourceUpdater::CreateForSoftwarePlanes(
     {
       HardwarePlaneResource::ScopedTexture scope(gl, plane_resource);
       gl->BindTexture(plane_resource->texture_target(), scope.texture_id());
+      if (use_unpack_row_length) {
+        gl->PixelStorei(GL_UNPACK_ROW_LENGTH_EXT,
+                        video_stride_bytes / bytes_per_pixel);
+      }
       gl->TexSubImage2D(plane_resource->texture_target(), 0, 0, 0,
                         resource_size_pixels.width(),
                         resource_size_pixels.height(),
                         GLDataFormat(plane_resource_format),
                         GLDataType(plane_resource_format), pixels);
+      if (use_unpack_row_length)
+        gl->PixelStorei(GL_UNPACK_ROW_LENGTH_EXT, 0);
     }
 
     plane_resource->SetUniqueId(video_frame->unique_id(), i);
@@ -56,13 +56,28 @@ class UploadCounterGLES2Interface : public viz::TestGLES2Interface {
                      GLenum type,
                      const void* pixels) override {
     ++upload_count_;
+    last_upload_pixels_ = pixels;
+    last_upload_row_length_ = unpack_row_length_;
+  }
+
+  void PixelStorei(GLenum pname, GLint param) override {
+    if (pname == GL_UNPACK_ROW_LENGTH_EXT)
+      unpack_row_length_ = param;
+    viz::TestGLES2Interface::PixelStorei(pname, param);
   }
 
   int UploadCount() { return upload_count_; }
   void ResetUploadCount() { upload_count_ = 0; }
 
+  const void* last_upload_pixels() const { return last_upload_pixels_; }
+  GLint last_upload_row_length() const { return last_upload_row_length_; }
+  GLint unpack_row_length() const { return unpack_row_length_; }
+
  private:
   int upload_count_;
+  const void* last_upload_pixels_ = nullptr;
+  GLint last_upload_row_length_ = 0;
+  GLint unpack_row_length_ = 0;
 };
 
 class VideoResourceUpdaterTest : public testing::Test {
@@ -267,6 +282,30 @@ TEST_F(VideoResourceUpdaterTest, SoftwareFrame) {
   EXPECT_EQ(VideoFrameResourceType::YUV, resources.type);
 }
 
+TEST_F(VideoResourceUpdaterTest, SoftwareFrameWithPaddedStride) {
+  std::unique_ptr<VideoResourceUpdater> updater = CreateUpdaterForHardware();
+  const gfx::Size size(10, 10);
+  const int kStride = 16;
+  static uint8_t y_data[kStride * 10] = {0};
+  static uint8_t u_data[kStride * 10] = {0};
+  static uint8_t v_data[kStride * 10] = {0};
+  scoped_refptr<media::VideoFrame> video_frame =
+      media::VideoFrame::WrapExternalYuvData(
+          media::PIXEL_FORMAT_I422, size, gfx::Rect(size), size, kStride,
+          kStride, kStride, y_data, u_data, v_data, base::TimeDelta());
+  ASSERT_TRUE(video_frame);
+
+  // The planes are uploaded straight from the frame, with the row length set
+  // to the stride, rather than from a copy with the strides adjusted.
+  VideoFrameExternalResources resources =
+      updater->CreateExternalResourcesFromVideoFrame(video_frame);
+  EXPECT_EQ(VideoFrameResourceType::YUV, resources.type);
+  EXPECT_EQ(video_frame->data(media::VideoFrame::kVPlane),
+            gl_->last_upload_pixels());
+  EXPECT_EQ(kStride, gl_->last_upload_row_length());
+  EXPECT_EQ(0, gl_->unpack_row_length());
+}
+
 TEST_F(VideoResourceUpdaterTest, HighBitFrameNoF16) {
   std::unique_ptr<VideoResourceUpdater> updater = CreateUpdaterForHardware();
   scoped_refptr<media::VideoFrame> video_frame = CreateTestHighBitFrame();
@@ -74,6 +74,16 @@ class MOJO_SYSTEM_IMPL_EXPORT Channel
 #endif
       // A normal message that uses Header and can contain extra header values.
       NORMAL,
+#if defined(OS_LINUX) || defined(OS_ANDROID)
+      // Control messages setting up a shared memory ring to carry the data of
+      // the sender's subsequent messages. See channel_posix.cc.
+      RING_REQUEST,
+      RING_READY,
+      RING_OFFER,
+      // A control message asking the receiver to check the shared memory
+      // rings, optionally carrying the handles of a message sent through one.
+      RING_WAKE,
+#endif
     };
 
 #pragma pack(push, 1)
@@ -342,6 +352,7 @@ class MOJO_SYSTEM_IMPL_EXPORT Channel
   virtual ~Channel();
 
   Delegate* delegate() const { return delegate_; }
+  HandlePolicy handle_policy() const { return handle_policy_; }
 
   // Called by the implementation when it wants somewhere to stick data.
   // |*buffer_capacity| may be set by the caller to indicate the desired buffer
@@ -10,6 +10,8 @@
 #include <algorithm>
 #include <limits>
 #include <memory>
+#include <utility>
+#include <vector>
 
 #include "base/bind.h"
 #include "base/containers/queue.h"
@@ -25,6 +27,12 @@
 #include "mojo/public/cpp/platform/features.h"
 #include "mojo/public/cpp/platform/socket_utils_posix.h"
 
+#if defined(OS_LINUX) || defined(OS_ANDROID)
+#include "base/memory/unsafe_shared_memory_region.h"
+#include "mojo/core/platform_handle_utils.h"
+#include "mojo/core/shared_memory_ring.h"
+#endif
+
 #if !defined(OS_NACL)
 #include <sys/uio.h>
 #endif
@@ -40,6 +48,33 @@ namespace {
 
 const size_t kMaxBatchReadCapacity = 256 * 1024;
 
+#if defined(OS_LINUX) || defined(OS_ANDROID)
+// Once the peers of a channel have set up a shared memory ring, the data of
+// the messages written in that direction goes through the ring instead of the
+// socket, saving a write and a read syscall per message while the reader is
+// busy. The socket still carries the messages' handles, and RING_WAKE messages
+// to wake the reader up when it's idle or the writer when the ring was full.
+//
+// A channel writing through a ring sets it up with its peer as follows:
+//   1. It sends RING_REQUEST.
+//   2. The peer sends RING_READY back, unless it rejects handles.
+//   3. It sends RING_OFFER with the ring's region and from then on writes
+//      through the ring. The peer reads the ring once it has read RING_OFFER,
+//      hence after all the messages written to the socket before.
+const size_t kSharedMemoryRingCapacity = 256 * 1024;
+
+// Size of the reads from the incoming ring.
+const size_t kRingReadSize = 64 * 1024;
+
+// Payload of a RING_OFFER message, whose only handle is the ring's region.
+struct RingOfferData {
+  uint32_t capacity;
+  uint32_t region_size;
+  uint64_t guid_high;
+  uint64_t guid_low;
+};
+#endif
+
 // A view over a Channel::Message object. The write queue uses these since
 // large messages may need to be sent in chunks.
 class MessageView {
@@ -172,20 +207,11 @@ class ChannelPosix : public Channel,
       base::AutoLock lock(write_lock_);
       if (reject_writes_)
         return;
-      if (outgoing_messages_.empty()) {
-        if (!WriteNoLock(MessageView(std::move(message), 0)))
-          reject_writes_ = write_error = true;
-      } else {
-        outgoing_messages_.emplace_back(std::move(message), 0);
-      }
-    }
-    if (write_error) {
-      // Invoke OnWriteError() asynchronously on the IO thread, in case Write()
-      // was called by the delegate, in which case we should not re-enter it.
-      io_task_runner_->PostTask(
-          FROM_HERE, base::BindOnce(&ChannelPosix::OnWriteError, this,
-                                    Error::kDisconnected));
+      if (!WriteMessageNoLock(std::move(message)))
+        reject_writes_ = write_error = true;
     }
+    if (write_error)
+      PostWriteError();
   }
 
   void LeakHandle() override {
@@ -313,8 +339,16 @@ class ChannelPosix : public Channel,
       base::MessageLoopCurrentForIO::Get()->WatchFileDescriptor(
           socket_.get(), true /* persistent */,
           base::MessagePumpForIO::WATCH_READ, read_watcher_.get(), this);
-      base::AutoLock lock(write_lock_);
-      FlushOutgoingMessagesNoLock();
+      {
+        base::AutoLock lock(write_lock_);
+        FlushOutgoingMessagesNoLock();
+      }
+#if defined(OS_LINUX) || defined(OS_ANDROID)
+      if (base::FeatureList::IsEnabled(features::kMojoSharedMemoryChannel)) {
+        WriteToSocket(std::make_unique<Channel::Message>(
+            0, 0, Message::MessageType::RING_REQUEST));
+      }
+#endif
     }
   }
 
@@ -345,6 +379,14 @@ class ChannelPosix : public Channel,
 
     read_watcher_.reset();
     write_watcher_.reset();
+#if defined(OS_LINUX) || defined(OS_ANDROID)
+    incoming_ring_.reset();
+    {
+      base::AutoLock lock(write_lock_);
+      outgoing_ring_.reset();
+      ring_outgoing_messages_.clear();
+    }
+#endif
     if (leak_handle_) {
       ignore_result(socket_.release());
       server_.TakePlatformHandle().release();
@@ -482,10 +524,19 @@ class ChannelPosix : public Channel,
         // We expect more data but there is none to read. The
         // FileDescriptorWatcher will wake us up again once there is.
         DCHECK(errno == EAGAIN || errno == EWOULDBLOCK);
-        return;
+        break;
       }
     } while (bytes_read == buffer_capacity &&
              total_bytes_read < kMaxBatchReadCapacity && next_read_size > 0);
+#if defined(OS_LINUX) || defined(OS_ANDROID)
+    // Read the rings after the socket, whose messages came first. On
+    // disconnection, also read what the peer wrote to the ring before leaving.
+    if ((ring_wake_pending_ || read_error) && !validation_error &&
+        !(read_error ? ReadFromIncomingRing() : OnRingWake())) {
+      read_error = true;
+      validation_error = true;
+    }
+#endif
     if (read_error) {
       // Stop receiving read notifications.
       read_watcher_.reset();
@@ -508,6 +559,48 @@ class ChannelPosix : public Channel,
       OnWriteError(Error::kDisconnected);
   }
 
+  // Writes |message| through the outgoing ring if there is one, or else
+  // through the socket.
+  bool WriteMessageNoLock(MessagePtr message) {
+#if defined(OS_LINUX) || defined(OS_ANDROID)
+    if (outgoing_ring_)
+      return WriteToRingNoLock(std::move(message));
+#endif
+    return WriteToSocketNoLock(MessageView(std::move(message), 0));
+  }
+
+  // Writes |message| to the socket, even if the data of the other messages
+  // goes through a shared memory ring.
+  void WriteToSocket(MessagePtr message) {
+    bool write_error = false;
+    {
+      base::AutoLock lock(write_lock_);
+      if (reject_writes_)
+        return;
+      if (!WriteToSocketNoLock(MessageView(std::move(message), 0)))
+        reject_writes_ = write_error = true;
+    }
+    if (write_error)
+      PostWriteError();
+  }
+
+  // Writes |message_view| to the socket after the messages already queued.
+  bool WriteToSocketNoLock(MessageView message_view) {
+    if (!outgoing_messages_.empty()) {
+      outgoing_messages_.emplace_back(std::move(message_view));
+      return true;
+    }
+    return WriteNoLock(std::move(message_view));
+  }
+
+  void PostWriteError() {
+    // Invoke OnWriteError() asynchronously on the IO thread, in case the write
+    // was made by the delegate, in which case we should not re-enter it.
+    io_task_runner_->PostTask(
+        FROM_HERE, base::BindOnce(&ChannelPosix::OnWriteError, this,
+                                  Error::kDisconnected));
+  }
+
   // Attempts to write a message directly to the channel. If the full message
   // cannot be written, it's queued and a wait is initiated to write the message
   // ASAP on the I/O thread.
@@ -634,6 +727,270 @@ class ChannelPosix : public Channel,
     return true;
   }
 
+#if defined(OS_LINUX) || defined(OS_ANDROID)
+  bool OnControlMessage(Message::MessageType message_type,
+                        const void* payload,
+                        size_t payload_size,
+                        std::vector<PlatformHandle> handles) override {
+    switch (message_type) {
+      case Message::MessageType::RING_REQUEST:
+        // The ring's region is sent as a handle, so a channel rejecting
+        // handles keeps reading the socket.
+        if (handle_policy() == HandlePolicy::kAcceptHandles &&
+            !incoming_ring_) {
+          WriteToSocket(std::make_unique<Channel::Message>(
+              0, 0, Message::MessageType::RING_READY));
+        }
+        return true;
+
+      case Message::MessageType::RING_READY:
+        OfferOutgoingRing();
+        return true;
+
+      case Message::MessageType::RING_OFFER: {
+        if (incoming_ring_ || payload_size != sizeof(RingOfferData) ||
+            handles.size() != 1) {
+          break;
+        }
+        RingOfferData offer;
+        memcpy(&offer, payload, sizeof(offer));
+        auto region = base::subtle::PlatformSharedMemoryRegion::Take(
+            CreateSharedMemoryRegionHandleFromPlatformHandles(
+                std::move(handles[0]), PlatformHandle()),
+            base::subtle::PlatformSharedMemoryRegion::Mode::kUnsafe,
+            offer.region_size,
+            base::UnguessableToken::Deserialize(offer.guid_high,
+                                                offer.guid_low));
+        // The peer now writes through the ring, so failing to map it is fatal.
+        incoming_ring_ = SharedMemoryRing::Map(
+            base::UnsafeSharedMemoryRegion::Deserialize(std::move(region)),
+            offer.capacity);
+        if (!incoming_ring_) {
+          DLOG(ERROR) << "Failed to map shared memory ring";
+          break;
+        }
+        ring_wake_pending_ = true;
+        return true;
+      }
+
+      case Message::MessageType::RING_WAKE:
+        ring_wake_pending_ = true;
+        return true;
+
+      default:
+        break;
+    }
+
+    return false;
+  }
+
+  // Sets up a ring for the data of the messages written to the peer, once the
+  // peer is ready to read it.
+  void OfferOutgoingRing() {
+    if (ring_offered_)
+      return;
+    ring_offered_ = true;
+
+    std::unique_ptr<SharedMemoryRing> ring =
+        SharedMemoryRing::Create(kSharedMemoryRingCapacity);
+    if (!ring)
+      return;
+    auto region = base::UnsafeSharedMemoryRegion::TakeHandleForSerialization(
+        ring->DuplicateRegion());
+    RingOfferData offer = {};
+    offer.capacity = static_cast<uint32_t>(ring->capacity());
+    offer.region_size = static_cast<uint32_t>(region.GetSize());
+    offer.guid_high = region.GetGUID().GetHighForSerialization();
+    offer.guid_low = region.GetGUID().GetLowForSerialization();
+    PlatformHandle handle;
+    PlatformHandle ignored_handle;
+    ExtractPlatformHandlesFromSharedMemoryRegionHandle(
+        region.PassPlatformHandle(), &handle, &ignored_handle);
+    if (!handle.is_valid())
+      return;
+
+    auto message = std::make_unique<Channel::Message>(
+        sizeof(offer), 1, Message::MessageType::RING_OFFER);
+    memcpy(message->mutable_payload(), &offer, sizeof(offer));
+    std::vector<PlatformHandle> handles;
+    handles.push_back(std::move(handle));
+    message->SetHandles(std::move(handles));
+
+    bool write_error = false;
+    {
+      base::AutoLock lock(write_lock_);
+      if (reject_writes_)
+        return;
+      // The offer is the last message written to the socket, the ones written
+      // after it go through the ring.
+      if (WriteToSocketNoLock(MessageView(std::move(message), 0)))
+        outgoing_ring_ = std::move(ring);
+      else
+        reject_writes_ = write_error = true;
+    }
+    if (write_error)
+      PostWriteError();
+  }
+
+  // Queues |message| for the outgoing ring. Handles can't go through the ring,
+  // so they're sent ahead on the socket with a RING_WAKE message. The peer
+  // holds the message until they arrive.
+  bool WriteToRingNoLock(MessagePtr message) {
+    if (message->has_handles()) {
+      MessageView wake(std::make_unique<Channel::Message>(
+                           0, 0, Message::MessageType::RING_WAKE),
+                       0);
+      wake.SetHandles(message->TakeHandlesForTransport());
+      if (!WriteToSocketNoLock(std::move(wake)))
+        return false;
+    }
+    ring_outgoing_messages_.emplace_back(std::move(message), 0);
+    return FlushOutgoingRingNoLock();
+  }
+
+  // Writes the queued messages to the outgoing ring until it's full, and wakes
+  // the peer up if it's waiting for them. Returns false if the peer corrupted
+  // the ring.
+  bool FlushOutgoingRingNoLock() {
+    bool wrote = false;
+    while (!ring_outgoing_messages_.empty()) {
+      MessageView& message_view = ring_outgoing_messages_.front();
+      size_t bytes_written;
+      if (!outgoing_ring_->Write(message_view.data(),
+                                 message_view.data_num_bytes(),
+                                 &bytes_written)) {
+        return false;
+      }
+      wrote |= bytes_written > 0;
+      if (bytes_written == message_view.data_num_bytes()) {
+        ring_outgoing_messages_.pop_front();
+        continue;
+      }
+      message_view.advance_data_offset(bytes_written);
+      // The ring is full. Unless the peer read some of it meanwhile, it'll
+      // wake us up when it does.
+      if (outgoing_ring_->WaitForSpace())
+        break;
+    }
+    if (wrote && outgoing_ring_->ShouldWakeReader()) {
+      return WriteToSocketNoLock(
+          MessageView(std::make_unique<Channel::Message>(
+                          0, 0, Message::MessageType::RING_WAKE),
+                      0));
+    }
+    return true;
+  }
+
+  // Called after reading RING_OFFER or RING_WAKE from the socket, or on
+  // disconnection. Resumes writing to the outgoing ring and reads the incoming
+  // one. Returns false if the incoming data is malformed.
+  bool OnRingWake() {
+    ring_wake_pending_ = false;
+    bool write_error = false;
+    {
+      base::AutoLock lock(write_lock_);
+      if (outgoing_ring_ && !reject_writes_ && !FlushOutgoingRingNoLock())
+        reject_writes_ = write_error = true;
+    }
+    if (write_error)
+      PostWriteError();
+    return ReadFromIncomingRing();
+  }
+
+  // Reads and dispatches the messages in the incoming ring until it's empty.
+  // Returns false if the ring or the messages are malformed.
+  bool ReadFromIncomingRing() {
+    if (!incoming_ring_)
+      return true;
+
+    size_t total_bytes_read = 0;
+    for (;;) {
+      // Dispatch what was read before, which may have been waiting for its
+      // handles.
+      size_t next_read_size;
+      DispatchResult result = DispatchRingMessages(&next_read_size);
+      if (result == DispatchResult::kError)
+        return false;
+      if (result == DispatchResult::kMissingHandles) {
+        // The handles are on their way with a RING_WAKE message.
+        return true;
+      }
+
+      if (total_bytes_read >= kMaxBatchReadCapacity) {
+        // Let other tasks run before reading on.
+        io_task_runner_->PostTask(
+            FROM_HERE,
+            base::BindOnce(&ChannelPosix::ReadFromIncomingRingOnIOThread,
+                           this));
+        return true;
+      }
+
+      next_read_size = std::max(next_read_size, kRingReadSize);
+      if (ring_read_buffer_.size() < ring_read_size_ + next_read_size)
+        ring_read_buffer_.resize(ring_read_size_ + next_read_size);
+      size_t bytes_read;
+      if (!incoming_ring_->Read(&ring_read_buffer_[ring_read_size_],
+                                next_read_size, &bytes_read)) {
+        return false;
+      }
+      if (!bytes_read) {
+        // Unless data arrived meanwhile, the peer will wake us up when it
+        // writes more.
+        if (incoming_ring_->WaitForData())
+          return true;
+        continue;
+      }
+      ring_read_size_ += bytes_read;
+      total_bytes_read += bytes_read;
+      if (incoming_ring_->ShouldWakeWriter()) {
+        WriteToSocket(std::make_unique<Channel::Message>(
+            0, 0, Message::MessageType::RING_WAKE));
+      }
+    }
+  }
+
+  void ReadFromIncomingRingOnIOThread() {
+    if (!ReadFromIncomingRing()) {
+      read_watcher_.reset();
+      OnError(Error::kReceivedMalformedData);
+    }
+  }
+
+  // Dispatches the complete messages read from the incoming ring. Sets
+  // |*next_read_size| to the size of the rest of a partial message.
+  DispatchResult DispatchRingMessages(size_t* next_read_size) {
+    *next_read_size = 0;
+    DispatchResult result = DispatchResult::kOK;
+    size_t offset = 0;
+    while (ring_read_size_ - offset >= sizeof(Message::LegacyHeader)) {
+      // As in Channel::OnReadComplete(), avoid misaligned reads of messages.
+      if (!IsAlignedForChannelMessage(
+              reinterpret_cast<uintptr_t>(&ring_read_buffer_[offset]))) {
+        memmove(&ring_read_buffer_[0], &ring_read_buffer_[offset],
+                ring_read_size_ - offset);
+        ring_read_size_ -= offset;
+        offset = 0;
+      }
+      size_t size_hint = 0;
+      result = TryDispatchMessage(
+          base::make_span(&ring_read_buffer_[offset], ring_read_size_ - offset),
+          &size_hint);
+      if (result != DispatchResult::kOK) {
+        if (result == DispatchResult::kNotEnoughData)
+          *next_read_size = size_hint;
+        break;
+      }
+      offset += size_hint;
+    }
+    if (offset) {
+      memmove(&ring_read_buffer_[0], &ring_read_buffer_[offset],
+              ring_read_size_ - offset);
+      ring_read_size_ -= offset;
+    }
+    return result;
+  }
+#endif  // defined(OS_LINUX) || defined(OS_ANDROID)
+
 #if defined(OS_MACOSX)
   bool OnControlMessage(Message::MessageType message_type,
                         const void* payload,
@@ -746,6 +1103,22 @@ class ChannelPosix : public Channel,
 
   bool leak_handle_ = false;
 
+#if defined(OS_LINUX) || defined(OS_ANDROID)
+  // The ring the data of the written messages goes through once set up, and
+  // the messages waiting for space in it. Protected by |write_lock_|.
+  std::unique_ptr<SharedMemoryRing> outgoing_ring_;
+  base::circular_deque<MessageView> ring_outgoing_messages_;
+
+  // These must only be accessed on the IO thread.
+  bool ring_offered_ = false;
+  std::unique_ptr<SharedMemoryRing> incoming_ring_;
+  bool ring_wake_pending_ = false;
+  // Data read from |incoming_ring_| but not dispatched yet, in the first
+  // |ring_read_size_| bytes of |ring_read_buffer_|.
+  std::vector<char> ring_read_buffer_;
+  size_t ring_read_size_ = 0;
+#endif
+
 #if defined(OS_MACOSX)
   base::Lock fds_to_close_lock_;
   std::vector<base::ScopedFD> fds_to_close_;
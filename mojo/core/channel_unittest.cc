@@ -12,8 +12,11 @@
 #include "base/optional.h"
 #include "base/process/process_handle.h"
 #include "base/run_loop.h"
+#include "base/test/scoped_feature_list.h"
 #include "base/threading/thread.h"
+#include "build/build_config.h"
 #include "mojo/core/platform_handle_utils.h"
+#include "mojo/public/cpp/platform/features.h"
 #include "mojo/public/cpp/platform/platform_channel.h"
 #include "testing/gmock/include/gmock/gmock.h"
 #include "testing/gtest/include/gtest/gtest.h"
@@ -485,6 +488,101 @@ TEST(ChannelTest, PeerStressTest) {
   EXPECT_EQ(0u, delegate_b.error_count_);
 }
 
+#if defined(OS_LINUX) || defined(OS_ANDROID)
+class HandleCountingChannelDelegate : public Channel::Delegate {
+ public:
+  HandleCountingChannelDelegate(size_t expected_messages,
+                                base::OnceClosure on_all_received)
+      : expected_messages_(expected_messages),
+        on_all_received_(std::move(on_all_received)) {}
+  ~HandleCountingChannelDelegate() override = default;
+
+  void OnChannelMessage(const void* payload,
+                        size_t payload_size,
+                        std::vector<PlatformHandle> handles) override {
+    // Each message carries its index, so out of order messages are caught.
+    ASSERT_EQ(sizeof(uint32_t), payload_size);
+    EXPECT_EQ(message_count_, *static_cast<const uint32_t*>(payload));
+    handle_count_ += handles.size();
+    if (++message_count_ == expected_messages_)
+      std::move(on_all_received_).Run();
+  }
+
+  void OnChannelError(Channel::Error error) override { ++error_count_; }
+
+  size_t message_count_ = 0;
+  size_t handle_count_ = 0;
+  size_t error_count_ = 0;
+
+ private:
+  const size_t expected_messages_;
+  base::OnceClosure on_all_received_;
+};
+
+TEST(ChannelTest, SharedMemoryRing) {
+  // Enough messages to fill the ring several times over.
+  constexpr uint32_t kNumMessages = 100000;
+  constexpr uint32_t kHandleInterval = 1000;
+
+  base::test::ScopedFeatureList feature_list;
+  feature_list.InitAndEnableFeature(features::kMojoSharedMemoryChannel);
+
+  base::MessageLoop message_loop(base::MessageLoop::TYPE_IO);
+  base::RunLoop run_loop;
+  base::Thread::Options thread_options;
+  thread_options.message_loop_type = base::MessageLoop::TYPE_IO;
+  base::Thread peer_thread("peer_b_io");
+  peer_thread.StartWithOptions(thread_options);
+
+  PlatformChannel platform_channel;
+  HandleCountingChannelDelegate delegate_a(0, base::OnceClosure());
+  scoped_refptr<Channel> channel_a = Channel::Create(
+      &delegate_a, ConnectionParams(platform_channel.TakeLocalEndpoint()),
+      Channel::HandlePolicy::kAcceptHandles, message_loop.task_runner());
+  HandleCountingChannelDelegate delegate_b(
+      kNumMessages, base::BindOnce(
+                        [](scoped_refptr<base::TaskRunner> task_runner,
+                           base::OnceClosure quit_closure) {
+                          task_runner->PostTask(FROM_HERE,
+                                                std::move(quit_closure));
+                        },
+                        message_loop.task_runner(), run_loop.QuitClosure()));
+  scoped_refptr<Channel> channel_b = Channel::Create(
+      &delegate_b, ConnectionParams(platform_channel.TakeRemoteEndpoint()),
+      Channel::HandlePolicy::kAcceptHandles, peer_thread.task_runner());
+  channel_a->Start();
+  channel_b->Start();
+
+  // Messages written before and after the ring is set up, some of them with
+  // handles, are all received in order.
+  for (uint32_t i = 0; i < kNumMessages; ++i) {
+    const bool has_handle = i % kHandleInterval == 0;
+    auto message =
+        std::make_unique<Channel::Message>(sizeof(i), has_handle ? 1 : 0);
+    memcpy(message->mutable_payload(), &i, sizeof(i));
+    if (has_handle) {
+      std::vector<PlatformHandle> handles;
+      handles.push_back(
+          PlatformChannel().TakeLocalEndpoint().TakePlatformHandle());
+      message->SetHandles(std::move(handles));
+    }
+    channel_a->Write(std::move(message));
+  }
+
+  run_loop.Run();
+
+  channel_a->ShutDown();
+  channel_b->ShutDown();
+  peer_thread.StopSoon();
+  base::RunLoop().RunUntilIdle();
+
+  EXPECT_EQ(kNumMessages, delegate_b.message_count_);
+  EXPECT_EQ(kNumMessages / kHandleInterval, delegate_b.handle_count_);
+  EXPECT_EQ(0u, delegate_a.error_count_);
+  EXPECT_EQ(0u, delegate_b.error_count_);
+}
+#endif  // defined(OS_LINUX) || defined(OS_ANDROID)
+
 }  // namespace
 }  // namespace core
 }  // namespace mojo
@@ -141,6 +141,43 @@ TEST_F(MessagePipePerfTest, PingPong) {
   RunPingPongServer(server_handle);
 }
 
+// Writes bursts of messages without attached handles to a local pipe before
+// reading them back, which measures the cost of routing each message through
+// the ports layer without any thread hops.
+TEST_F(MessagePipePerfTest, WriteThenReadBurst) {
+  MojoHandle a, b;
+  CreateMessagePipe(&a, &b);
+
+  const size_t kMsgSize[3] = {12, 144, 1728};
+  const int kBurstSize = 1000;
+  const int kBurstCount = 100;
+  std::vector<uint8_t> buffer;
+  for (size_t size : kMsgSize) {
+    const std::string payload(size, '*');
+    std::string test_name = base::StringPrintf(
+        "IPC_Perf_Burst_%dx_%u", kBurstSize * kBurstCount,
+        static_cast<unsigned>(size));
+    base::PerfTimeLogger logger(test_name.c_str());
+    for (int i = 0; i < kBurstCount; ++i) {
+      for (int j = 0; j < kBurstSize; ++j) {
+        CHECK_EQ(WriteMessageRaw(MessagePipeHandle(a), payload.data(),
+                                 payload.size(), nullptr, 0,
+                                 MOJO_WRITE_MESSAGE_FLAG_NONE),
+                 MOJO_RESULT_OK);
+      }
+      for (int j = 0; j < kBurstSize; ++j) {
+        CHECK_EQ(ReadMessageRaw(MessagePipeHandle(b), &buffer, nullptr,
+                                MOJO_READ_MESSAGE_FLAG_NONE),
+                 MOJO_RESULT_OK);
+      }
+    }
+    logger.Done();
+  }
+
+  MojoClose(a);
+  MojoClose(b);
+}
+
 // For each message received, sends a reply message with the same contents
 // repeated twice, until the other end is closed or it receives "quitquitquit"
 // (which it doesn't reply to). It'll return the number of messages received,
@@ -1250,6 +1250,12 @@ int Node::PrepareToForwardUserMessage(const SlotRef& forwarding_slot_ref,
                                       bool for_proxy,
                                       UserMessageEvent* message,
                                       NodeName* forward_to_node) {
+  if (message->num_ports() == 0) {
+    return PrepareToForwardUserMessageWithoutPorts(
+        forwarding_slot_ref, expected_port_state, for_proxy, message,
+        forward_to_node);
+  }
+
   base::StackVector<PortRef, 4> ports_to_close;
   bool target_is_remote = false;
   for (;;) {
@@ -1411,6 +1417,65 @@ int Node::PrepareToForwardUserMessage(const SlotRef& forwarding_slot_ref,
   return OK;
 }
 
+int Node::PrepareToForwardUserMessageWithoutPorts(
+    const SlotRef& forwarding_slot_ref,
+    Port::State expected_port_state,
+    bool for_proxy,
+    UserMessageEvent* message,
+    NodeName* forward_to_node) {
+  DCHECK_EQ(0u, message->num_ports());
+
+  // With no attached ports there is nothing to convert to proxies, so
+  // |ports_lock_| isn't needed and only the forwarding port is locked. Local
+  // messages are prepared under a single lock acquisition.
+  bool will_be_routed_externally = false;
+  for (;;) {
+    {
+      SinglePortLocker locker(&forwarding_slot_ref.port());
+      auto* forwarding_port = locker.port();
+      const NodeName& target_node_name = forwarding_port->peer_node_name;
+
+      // Once the message is ready to be routed externally, it may also be
+      // routed locally if the peer has moved here in the meantime.
+      if (target_node_name == name_ || will_be_routed_externally) {
+        if (forwarding_port->state != expected_port_state)
+          return ERROR_PORT_STATE_UNEXPECTED;
+        if (forwarding_port->peer_closed && !for_proxy)
+          return ERROR_PORT_PEER_CLOSED;
+
+        if (message->sequence_num() == 0)
+          message->set_sequence_num(forwarding_port->next_sequence_num_to_send);
+
+        DVLOG(4) << "Sending message " << message->sequence_num() << " from "
+                 << forwarding_slot_ref.port().name() << "/"
+                 << forwarding_slot_ref.slot_id() << "@" << name_ << " to "
+                 << forwarding_port->peer_port_name << "@"
+                 << target_node_name;
+
+        Port::Slot* forwarding_slot =
+            forwarding_port->GetSlot(forwarding_slot_ref.slot_id());
+        if (forwarding_slot) {
+          forwarding_slot->last_sequence_num_sent =
+              forwarding_port->next_sequence_num_to_send;
+        }
+        ++forwarding_port->next_sequence_num_to_send;
+
+        *forward_to_node = target_node_name;
+        message->set_port_name(forwarding_port->peer_port_name);
+        return OK;
+      }
+    }
+
+    // NOTE: This may call out to arbitrary user code, so it's important to call
+    // it only while no port locks are held on the calling thread.
+    if (!message->NotifyWillBeRoutedExternally()) {
+      LOG(ERROR) << "NotifyWillBeRoutedExternally failed unexpectedly.";
+      return ERROR_PORT_STATE_UNEXPECTED;
+    }
+    will_be_routed_externally = true;
+  }
+}
+
 int Node::BeginProxying(const PortRef& port_ref) {
   {
     SinglePortLocker locker(&port_ref);
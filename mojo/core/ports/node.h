@@ -269,6 +269,14 @@ class COMPONENT_EXPORT(MOJO_CORE_PORTS) Node {
                                   bool for_proxy,
                                   UserMessageEvent* message,
                                   NodeName* forward_to_node);
+  // Fast path of PrepareToForwardUserMessage() for messages without attached
+  // ports, which only needs the forwarding port's lock.
+  int PrepareToForwardUserMessageWithoutPorts(
+      const SlotRef& forwarding_slot_ref,
+      Port::State expected_port_state,
+      bool for_proxy,
+      UserMessageEvent* message,
+      NodeName* forward_to_node);
   int BeginProxying(const PortRef& port_ref);
   int ForwardUserMessagesFromProxy(const PortRef& port_ref);
   void InitiateProxyRemoval(const PortRef& port_ref);
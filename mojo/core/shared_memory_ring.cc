@@ -0,0 +1,178 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "mojo/core/shared_memory_ring.h"
+
+#include <string.h>
+
+#include <algorithm>
+#include <atomic>
+#include <utility>
+
+#include "base/bits.h"
+#include "base/logging.h"
+#include "base/memory/ptr_util.h"
+
+namespace mojo {
+namespace core {
+
+// The shared state at the start of the region. The positions count bytes
+// written and read since the ring was created, modulo 2^32, so the ring holds
+// |write_position - read_position| bytes. Each position is written only by
+// its owner and sits on its own cache line.
+struct SharedMemoryRing::Header {
+  std::atomic<uint32_t> write_position;
+  char padding1[60];
+  std::atomic<uint32_t> read_position;
+  char padding2[60];
+  std::atomic<uint32_t> reader_waiting;
+  std::atomic<uint32_t> writer_waiting;
+};
+
+namespace {
+
+// Offset of the ring data in the region.
+constexpr size_t kDataOffset = 256;
+
+static_assert(SharedMemoryRing::kMaxCapacity <= (1u << 31),
+              "Ring sizes must fit in uint32_t positions");
+static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t),
+              "Shared memory atomics must be lock-free");
+
+bool IsValidCapacity(size_t capacity) {
+  return capacity >= SharedMemoryRing::kMinCapacity &&
+         capacity <= SharedMemoryRing::kMaxCapacity &&
+         base::bits::IsPowerOfTwo(capacity);
+}
+
+}  // namespace
+
+constexpr size_t SharedMemoryRing::kMinCapacity;
+constexpr size_t SharedMemoryRing::kMaxCapacity;
+
+SharedMemoryRing::SharedMemoryRing(base::UnsafeSharedMemoryRegion region,
+                                   base::WritableSharedMemoryMapping mapping,
+                                   size_t capacity)
+    : region_(std::move(region)),
+      mapping_(std::move(mapping)),
+      capacity_(capacity) {
+  static_assert(sizeof(Header) <= kDataOffset, "Header overlaps ring data");
+}
+
+SharedMemoryRing::~SharedMemoryRing() = default;
+
+// static
+std::unique_ptr<SharedMemoryRing> SharedMemoryRing::Create(size_t capacity) {
+  DCHECK(IsValidCapacity(capacity));
+  base::UnsafeSharedMemoryRegion region =
+      base::UnsafeSharedMemoryRegion::Create(kDataOffset + capacity);
+  if (!region.IsValid())
+    return nullptr;
+  base::WritableSharedMemoryMapping mapping = region.Map();
+  if (!mapping.IsValid())
+    return nullptr;
+
+  // New regions are zero-filled, which is the initial state of the header.
+  return base::WrapUnique(
+      new SharedMemoryRing(std::move(region), std::move(mapping), capacity));
+}
+
+// static
+std::unique_ptr<SharedMemoryRing> SharedMemoryRing::Map(
+    base::UnsafeSharedMemoryRegion region,
+    size_t capacity) {
+  if (!region.IsValid() || !IsValidCapacity(capacity))
+    return nullptr;
+  base::WritableSharedMemoryMapping mapping = region.Map();
+  if (!mapping.IsValid() || mapping.size() < kDataOffset + capacity)
+    return nullptr;
+
+  return base::WrapUnique(
+      new SharedMemoryRing(std::move(region), std::move(mapping), capacity));
+}
+
+base::UnsafeSharedMemoryRegion SharedMemoryRing::DuplicateRegion() const {
+  return region_.Duplicate();
+}
+
+bool SharedMemoryRing::Write(const void* data,
+                             size_t num_bytes,
+                             size_t* bytes_written) {
+  *bytes_written = 0;
+  const uint32_t used =
+      write_position_ - header()->read_position.load(std::memory_order_acquire);
+  if (used > capacity_)
+    return false;
+
+  const size_t length = std::min(num_bytes, capacity_ - used);
+  if (!length)
+    return true;
+
+  const size_t offset = write_position_ & (capacity_ - 1);
+  const size_t first_length = std::min(length, capacity_ - offset);
+  const char* bytes = static_cast<const char*>(data);
+  memcpy(this->data() + offset, bytes, first_length);
+  memcpy(this->data(), bytes + first_length, length - first_length);
+
+  write_position_ += static_cast<uint32_t>(length);
+  // Sequentially consistent so that the store is ordered before the load of
+  // |reader_waiting| in ShouldWakeReader().
+  header()->write_position.store(write_position_);
+  *bytes_written = length;
+  return true;
+}
+
+bool SharedMemoryRing::WaitForSpace() {
+  header()->writer_waiting.store(1);
+  return write_position_ - header()->read_position.load() >= capacity_;
+}
+
+bool SharedMemoryRing::ShouldWakeReader() {
+  return header()->reader_waiting.exchange(0) != 0;
+}
+
+bool SharedMemoryRing::Read(void* buffer,
+                            size_t max_bytes,
+                            size_t* bytes_read) {
+  *bytes_read = 0;
+  const uint32_t available =
+      header()->write_position.load(std::memory_order_acquire) - read_position_;
+  if (available > capacity_)
+    return false;
+
+  const size_t length = std::min(max_bytes, static_cast<size_t>(available));
+  if (!length)
+    return true;
+
+  const size_t offset = read_position_ & (capacity_ - 1);
+  const size_t first_length = std::min(length, capacity_ - offset);
+  char* bytes = static_cast<char*>(buffer);
+  memcpy(bytes, data() + offset, first_length);
+  memcpy(bytes + first_length, data(), length - first_length);
+
+  read_position_ += static_cast<uint32_t>(length);
+  header()->read_position.store(read_position_);
+  *bytes_read = length;
+  return true;
+}
+
+bool SharedMemoryRing::WaitForData() {
+  header()->reader_waiting.store(1);
+  return header()->write_position.load() == read_position_;
+}
+
+bool SharedMemoryRing::ShouldWakeWriter() {
+  return header()->writer_waiting.exchange(0) != 0;
+}
+
+SharedMemoryRing::Header* SharedMemoryRing::header() const {
+  return static_cast<Header*>(mapping_.memory());
+}
+
+char* SharedMemoryRing::data() const {
+  return static_cast<char*>(mapping_.memory()) + kDataOffset;
+}
+
+}  // namespace core
+}  // namespace mojo
@@ -0,0 +1,110 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef MOJO_CORE_SHARED_MEMORY_RING_H_
+#define MOJO_CORE_SHARED_MEMORY_RING_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <memory>
+
+#include "base/macros.h"
+#include "base/memory/shared_memory_mapping.h"
+#include "base/memory/unsafe_shared_memory_region.h"
+#include "mojo/core/system_impl_export.h"
+
+namespace mojo {
+namespace core {
+
+// A single-producer, single-consumer byte stream in shared memory, used by
+// ChannelPosix to carry message data to a peer process without a syscall per
+// message. The producer and consumer live in different processes, each with
+// its own SharedMemoryRing mapping the same region.
+//
+// The ring only moves bytes. Waking a waiting peer is left to the caller: the
+// producer calls ShouldWakeReader() after writing and the consumer calls
+// ShouldWakeWriter() after reading, and either signals the peer out of band
+// when they return true. WaitForData() and WaitForSpace() flag the caller as
+// waiting in a way that guarantees the peer sees the flag if it makes progress
+// afterwards, so no wakeup is lost.
+//
+// The peer is not trusted: positions read from shared memory are validated
+// and data is always copied out of the ring before it is parsed.
+class MOJO_SYSTEM_IMPL_EXPORT SharedMemoryRing {
+ public:
+  // Bounds on the capacity of a ring, which must be a power of two.
+  static constexpr size_t kMinCapacity = 4096;
+  static constexpr size_t kMaxCapacity = 16 * 1024 * 1024;
+
+  ~SharedMemoryRing();
+
+  // Creates a new, empty ring able to hold |capacity| bytes.
+  static std::unique_ptr<SharedMemoryRing> Create(size_t capacity);
+
+  // Maps a ring created by a peer with Create() and received as |region|.
+  // Returns null if |capacity| or |region| is invalid.
+  static std::unique_ptr<SharedMemoryRing> Map(
+      base::UnsafeSharedMemoryRegion region,
+      size_t capacity);
+
+  size_t capacity() const { return capacity_; }
+
+  // Returns a duplicate of the region backing this ring, to send to the peer.
+  base::UnsafeSharedMemoryRegion DuplicateRegion() const;
+
+  // Producer side. Copies as much of |data| as fits into the ring and sets
+  // |*bytes_written|. Returns false if the consumer corrupted the ring.
+  bool Write(const void* data, size_t num_bytes, size_t* bytes_written);
+
+  // Producer side. Flags the producer as waiting for space, and returns true
+  // if the ring is still full, in which case the producer must wait for the
+  // consumer to wake it. Returns false if space was freed in the meantime.
+  bool WaitForSpace();
+
+  // Producer side. Returns whether the consumer is waiting for data and must
+  // be woken up, clearing its flag. Must be called after each Write() that
+  // wrote something.
+  bool ShouldWakeReader();
+
+  // Consumer side. Copies up to |max_bytes| out of the ring into |buffer| and
+  // sets |*bytes_read|. Returns false if the producer corrupted the ring.
+  bool Read(void* buffer, size_t max_bytes, size_t* bytes_read);
+
+  // Consumer side. Flags the consumer as waiting for data, and returns true if
+  // the ring is still empty, in which case the consumer must wait for the
+  // producer to wake it. Returns false if data arrived in the meantime.
+  bool WaitForData();
+
+  // Consumer side. Returns whether the producer is waiting for space and must
+  // be woken up, clearing its flag. Must be called after each Read() that read
+  // something.
+  bool ShouldWakeWriter();
+
+ private:
+  struct Header;
+
+  SharedMemoryRing(base::UnsafeSharedMemoryRegion region,
+                   base::WritableSharedMemoryMapping mapping,
+                   size_t capacity);
+
+  Header* header() const;
+  char* data() const;
+
+  const base::UnsafeSharedMemoryRegion region_;
+  const base::WritableSharedMemoryMapping mapping_;
+  const size_t capacity_;
+
+  // Local copies of the positions this side owns. The copies in shared memory
+  // are only published for the peer, which may tamper with them.
+  uint32_t write_position_ = 0;
+  uint32_t read_position_ = 0;
+
+  DISALLOW_COPY_AND_ASSIGN(SharedMemoryRing);
+};
+
+}  // namespace core
+}  // namespace mojo
+
+#endif  // MOJO_CORE_SHARED_MEMORY_RING_H_
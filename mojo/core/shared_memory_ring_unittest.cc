@@ -0,0 +1,127 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "mojo/core/shared_memory_ring.h"
+
+#include <string.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace mojo {
+namespace core {
+namespace {
+
+constexpr size_t kCapacity = SharedMemoryRing::kMinCapacity;
+
+// Creates a ring and maps it again as the peer would.
+void CreateRingPair(std::unique_ptr<SharedMemoryRing>* writer,
+                    std::unique_ptr<SharedMemoryRing>* reader) {
+  *writer = SharedMemoryRing::Create(kCapacity);
+  ASSERT_TRUE(*writer);
+  *reader = SharedMemoryRing::Map((*writer)->DuplicateRegion(), kCapacity);
+  ASSERT_TRUE(*reader);
+}
+
+TEST(SharedMemoryRingTest, WriteAndRead) {
+  std::unique_ptr<SharedMemoryRing> writer;
+  std::unique_ptr<SharedMemoryRing> reader;
+  CreateRingPair(&writer, &reader);
+
+  const std::string data = "hello";
+  size_t bytes_written;
+  ASSERT_TRUE(writer->Write(data.data(), data.size(), &bytes_written));
+  EXPECT_EQ(data.size(), bytes_written);
+
+  std::vector<char> buffer(kCapacity);
+  size_t bytes_read;
+  ASSERT_TRUE(reader->Read(buffer.data(), buffer.size(), &bytes_read));
+  EXPECT_EQ(data, std::string(buffer.data(), bytes_read));
+
+  ASSERT_TRUE(reader->Read(buffer.data(), buffer.size(), &bytes_read));
+  EXPECT_EQ(0u, bytes_read);
+}
+
+TEST(SharedMemoryRingTest, WrapsAround) {
+  std::unique_ptr<SharedMemoryRing> writer;
+  std::unique_ptr<SharedMemoryRing> reader;
+  CreateRingPair(&writer, &reader);
+
+  // Each chunk is bigger than half the ring, so every other one wraps around.
+  std::vector<char> chunk(kCapacity / 2 + 100);
+  std::vector<char> buffer(kCapacity);
+  for (int i = 0; i < 10; ++i) {
+    for (size_t j = 0; j < chunk.size(); ++j)
+      chunk[j] = static_cast<char>(i + j);
+    size_t bytes_written;
+    ASSERT_TRUE(writer->Write(chunk.data(), chunk.size(), &bytes_written));
+    ASSERT_EQ(chunk.size(), bytes_written);
+    size_t bytes_read;
+    ASSERT_TRUE(reader->Read(buffer.data(), buffer.size(), &bytes_read));
+    ASSERT_EQ(chunk.size(), bytes_read);
+    EXPECT_EQ(0, memcmp(chunk.data(), buffer.data(), chunk.size()));
+  }
+}
+
+TEST(SharedMemoryRingTest, PartialWriteWhenFull) {
+  std::unique_ptr<SharedMemoryRing> writer;
+  std::unique_ptr<SharedMemoryRing> reader;
+  CreateRingPair(&writer, &reader);
+
+  std::vector<char> data(kCapacity + 10, 'x');
+  size_t bytes_written;
+  ASSERT_TRUE(writer->Write(data.data(), data.size(), &bytes_written));
+  EXPECT_EQ(kCapacity, bytes_written);
+  EXPECT_TRUE(writer->WaitForSpace());
+
+  // Reading asks for the waiting writer to be woken up, once.
+  std::vector<char> buffer(16);
+  size_t bytes_read;
+  ASSERT_TRUE(reader->Read(buffer.data(), buffer.size(), &bytes_read));
+  EXPECT_EQ(buffer.size(), bytes_read);
+  EXPECT_TRUE(reader->ShouldWakeWriter());
+  EXPECT_FALSE(reader->ShouldWakeWriter());
+
+  EXPECT_FALSE(writer->WaitForSpace());
+  ASSERT_TRUE(writer->Write(data.data(), 10, &bytes_written));
+  EXPECT_EQ(10u, bytes_written);
+}
+
+TEST(SharedMemoryRingTest, WakesWaitingReader) {
+  std::unique_ptr<SharedMemoryRing> writer;
+  std::unique_ptr<SharedMemoryRing> reader;
+  CreateRingPair(&writer, &reader);
+
+  // A busy reader doesn't need to be woken up.
+  size_t bytes_written;
+  ASSERT_TRUE(writer->Write("a", 1, &bytes_written));
+  EXPECT_FALSE(writer->ShouldWakeReader());
+
+  // The reader doesn't wait while there is data.
+  EXPECT_FALSE(reader->WaitForData());
+  char buffer[16];
+  size_t bytes_read;
+  ASSERT_TRUE(reader->Read(buffer, sizeof(buffer), &bytes_read));
+  EXPECT_EQ(1u, bytes_read);
+  EXPECT_TRUE(reader->WaitForData());
+
+  ASSERT_TRUE(writer->Write("b", 1, &bytes_written));
+  EXPECT_TRUE(writer->ShouldWakeReader());
+  EXPECT_FALSE(writer->ShouldWakeReader());
+}
+
+TEST(SharedMemoryRingTest, RejectsInvalidCapacity) {
+  std::unique_ptr<SharedMemoryRing> ring = SharedMemoryRing::Create(kCapacity);
+  ASSERT_TRUE(ring);
+  EXPECT_FALSE(SharedMemoryRing::Map(ring->DuplicateRegion(), kCapacity + 1));
+  EXPECT_FALSE(SharedMemoryRing::Map(ring->DuplicateRegion(), kCapacity * 2));
+  EXPECT_FALSE(SharedMemoryRing::Map(ring->DuplicateRegion(), 0));
+}
+
+}  // namespace
+}  // namespace core
+}  // namespace mojo
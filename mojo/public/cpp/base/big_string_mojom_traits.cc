@@ -9,10 +9,11 @@
 namespace mojo {
 
 // static
-mojo_base::BigBuffer StructTraits<mojo_base::mojom::BigStringDataView,
-                                  std::string>::data(const std::string& str) {
+mojo_base::BigBufferView
+StructTraits<mojo_base::mojom::BigStringDataView, std::string>::data(
+    const std::string& str) {
   const auto* bytes = reinterpret_cast<const uint8_t*>(str.data());
-  return mojo_base::BigBuffer(
+  return mojo_base::BigBufferView(
       base::make_span(bytes, str.size() * sizeof(char)));
 }
 
@@ -20,13 +21,16 @@ mojo_base::BigBuffer StructTraits<mojo_base::mojom::BigStringDataView,
 bool StructTraits<mojo_base::mojom::BigStringDataView, std::string>::Read(
     mojo_base::mojom::BigStringDataView data,
     std::string* out) {
-  mojo_base::BigBuffer buffer;
-  if (!data.ReadData(&buffer))
+  // Read into a view so that inline payloads are copied once, straight out
+  // of the message.
+  mojo_base::BigBufferView view;
+  if (!data.ReadData(&view))
     return false;
-  if (buffer.size() % sizeof(char))
+  base::span<const uint8_t> bytes = view.data();
+  if (bytes.size() % sizeof(char))
     return false;
-  *out = std::string(reinterpret_cast<const char*>(buffer.data()),
-                     buffer.size() / sizeof(char));
+  out->assign(reinterpret_cast<const char*>(bytes.data()),
+              bytes.size() / sizeof(char));
   return true;
 }
 
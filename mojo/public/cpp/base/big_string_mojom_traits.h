@@ -17,7 +17,9 @@ namespace mojo {
 template <>
 struct COMPONENT_EXPORT(MOJO_BASE_MOJOM)
     StructTraits<mojo_base::mojom::BigStringDataView, std::string> {
-  static mojo_base::BigBuffer data(const std::string& str);
+  // Returns a view of |str|, so that inline payloads are serialized straight
+  // from the string's storage.
+  static mojo_base::BigBufferView data(const std::string& str);
 
   static bool Read(mojo_base::mojom::BigStringDataView data, std::string* out);
 };
@@ -4,15 +4,41 @@
 
 #include "mojo/public/cpp/base/ref_counted_memory_mojom_traits.h"
 
+#include <utility>
+
 #include "mojo/public/cpp/base/big_buffer_mojom_traits.h"
 
 namespace mojo {
 
+namespace {
+
+// Exposes a received BigBuffer as RefCountedMemory without copying it. Large
+// payloads stay in the shared memory region they were sent in.
+class RefCountedBigBuffer : public base::RefCountedMemory {
+ public:
+  explicit RefCountedBigBuffer(mojo_base::BigBuffer buffer)
+      : buffer_(std::move(buffer)) {}
+
+  // base::RefCountedMemory:
+  const unsigned char* front() const override { return buffer_.data(); }
+  size_t size() const override { return buffer_.size(); }
+
+ private:
+  ~RefCountedBigBuffer() override = default;
+
+  const mojo_base::BigBuffer buffer_;
+
+  DISALLOW_COPY_AND_ASSIGN(RefCountedBigBuffer);
+};
+
+}  // namespace
+
 // static
-mojo_base::BigBuffer StructTraits<mojo_base::mojom::RefCountedMemoryDataView,
-                                  scoped_refptr<base::RefCountedMemory>>::
+mojo_base::BigBufferView
+StructTraits<mojo_base::mojom::RefCountedMemoryDataView,
+             scoped_refptr<base::RefCountedMemory>>::
     data(const scoped_refptr<base::RefCountedMemory>& in) {
-  return mojo_base::BigBuffer(base::make_span(in->front(), in->size()));
+  return mojo_base::BigBufferView(base::make_span(in->front(), in->size()));
 }
 
 // static
@@ -38,8 +64,7 @@ bool StructTraits<mojo_base::mojom::RefCountedMemoryDataView,
   if (!data.ReadData(&buffer))
     return false;
 
-  *out =
-      base::MakeRefCounted<base::RefCountedBytes>(buffer.data(), buffer.size());
+  *out = base::MakeRefCounted<RefCountedBigBuffer>(std::move(buffer));
   return true;
 }
 
@@ -19,7 +19,7 @@ template <>
 struct COMPONENT_EXPORT(MOJO_BASE_MOJOM)
     StructTraits<mojo_base::mojom::RefCountedMemoryDataView,
                  scoped_refptr<base::RefCountedMemory>> {
-  static mojo_base::BigBuffer data(
+  static mojo_base::BigBufferView data(
       const scoped_refptr<base::RefCountedMemory>& in);
 
   static bool IsNull(const scoped_refptr<base::RefCountedMemory>& input);
@@ -2,6 +2,8 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include <vector>
+
 #include "base/stl_util.h"
 #include "mojo/public/cpp/base/big_buffer_mojom_traits.h"
 #include "mojo/public/cpp/base/ref_counted_memory_mojom_traits.h"
@@ -25,6 +27,22 @@ TEST(RefCountedMemoryTest, Data) {
     EXPECT_EQ(in->front()[i], out->front()[i]);
 }
 
+TEST(RefCountedMemoryTest, Large) {
+  // Large enough to be sent in shared memory.
+  std::vector<uint8_t> data(BigBuffer::kMaxInlineBytes * 2);
+  for (size_t i = 0; i < data.size(); ++i)
+    data[i] = static_cast<uint8_t>(i);
+
+  scoped_refptr<base::RefCountedMemory> in =
+      base::RefCountedBytes::TakeVector(&data);
+
+  scoped_refptr<base::RefCountedMemory> out;
+  ASSERT_TRUE(
+      mojo::test::SerializeAndDeserialize<mojom::RefCountedMemory>(&in, &out));
+  ASSERT_EQ(out->size(), in->size());
+  EXPECT_TRUE(out->Equals(in));
+}
+
 TEST(RefCountedMemoryTest, Null) {
   // Stuff real data in out to ensure it gets overwritten with a null.
   uint8_t data[] = {'a', 'b', 'c', 'd', 'e'};
@@ -19,11 +19,11 @@ bool StructTraits<mojo_base::mojom::String16DataView, base::string16>::Read(
 }
 
 // static
-mojo_base::BigBuffer
+mojo_base::BigBufferView
 StructTraits<mojo_base::mojom::BigString16DataView, base::string16>::data(
     const base::string16& str) {
   const auto* bytes = reinterpret_cast<const uint8_t*>(str.data());
-  return mojo_base::BigBuffer(
+  return mojo_base::BigBufferView(
       base::make_span(bytes, str.size() * sizeof(base::char16)));
 }
 
@@ -31,13 +31,14 @@ StructTraits<mojo_base::mojom::BigString16DataView, base::string16>::data(
 bool StructTraits<mojo_base::mojom::BigString16DataView, base::string16>::Read(
     mojo_base::mojom::BigString16DataView data,
     base::string16* out) {
-  mojo_base::BigBuffer buffer;
-  if (!data.ReadData(&buffer))
+  mojo_base::BigBufferView view;
+  if (!data.ReadData(&view))
     return false;
-  if (buffer.size() % sizeof(base::char16))
+  base::span<const uint8_t> bytes = view.data();
+  if (bytes.size() % sizeof(base::char16))
     return false;
-  *out = base::string16(reinterpret_cast<const base::char16*>(buffer.data()),
-                        buffer.size() / sizeof(base::char16));
+  out->assign(reinterpret_cast<const base::char16*>(bytes.data()),
+              bytes.size() / sizeof(base::char16));
   return true;
 }
 
@@ -40,7 +40,9 @@ struct COMPONENT_EXPORT(MOJO_BASE_MOJOM)
 template <>
 struct COMPONENT_EXPORT(MOJO_BASE_MOJOM)
     StructTraits<mojo_base::mojom::BigString16DataView, base::string16> {
-  static mojo_base::BigBuffer data(const base::string16& str);
+  // Returns a view of |str|, so that inline payloads are serialized straight
+  // from the string's storage.
+  static mojo_base::BigBufferView data(const base::string16& str);
 
   static bool Read(mojo_base::mojom::BigString16DataView data,
                    base::string16* out);
@@ -250,6 +250,15 @@ class Binding {
   // where an unintended dependency on batch dispatch remains in production.
   void EnableBatchDispatch() { internal_state_.EnableBatchDispatch(); }
 
+  // Allows this Binding to dispatch up to |batch_size| queued messages within
+  // a single scheduled task, instead of one task per message. Unlike
+  // EnableBatchDispatch() this bounds how long each task runs, so it's suitable
+  // for interfaces receiving bursts of small calls, e.g. input events, where
+  // per-task overhead dominates.
+  void SetDispatchBatchSize(size_t batch_size) {
+    internal_state_.SetDispatchBatchSize(batch_size);
+  }
+
   // DO NOT USE. Exposed only for internal use and for testing.
   internal::BindingState<Interface, ImplRefTraits>* internal_state() {
     return &internal_state_;
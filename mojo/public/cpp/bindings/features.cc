@@ -22,5 +22,10 @@ namespace features {
 const base::Feature kTaskPerMessage{"MojoTaskPerMessage",
                                     base::FEATURE_ENABLED_BY_DEFAULT};
 
+// Records per-interface message counts, sizes and timings in every Connector.
+// See mojo/public/cpp/bindings/lib/interface_cost_stats.h.
+const base::Feature kInterfaceCostStats{"MojoInterfaceCostStats",
+                                        base::FEATURE_DISABLED_BY_DEFAULT};
+
 }  // namespace features
 }  // namespace mojo
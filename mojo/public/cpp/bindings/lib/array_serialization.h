@@ -146,6 +146,16 @@ struct ArraySerializer<
     }
   }
 
+  // Deserializes the element at |index| of |input| into |*output|.
+  template <typename UserElement>
+  static bool DeserializeElement(Data* input,
+                                 size_t index,
+                                 UserElement* output,
+                                 SerializationContext* context) {
+    *output = input->at(index);
+    return true;
+  }
+
   static bool DeserializeElements(Data* input,
                                   UserType* output,
                                   SerializationContext* context) {
@@ -201,6 +211,14 @@ struct ArraySerializer<
       Serialize<Element>(input->GetNext(), output->storage() + i);
   }
 
+  template <typename UserElement>
+  static bool DeserializeElement(Data* input,
+                                 size_t index,
+                                 UserElement* output,
+                                 SerializationContext* context) {
+    return Deserialize<Element>(input->at(index), output);
+  }
+
   static bool DeserializeElements(Data* input,
                                   UserType* output,
                                   SerializationContext* context) {
@@ -248,6 +266,16 @@ struct ArraySerializer<MojomType,
     for (size_t i = 0; i < size; ++i)
       output->at(i) = input->GetNext();
   }
+
+  template <typename UserElement>
+  static bool DeserializeElement(Data* input,
+                                 size_t index,
+                                 UserElement* output,
+                                 SerializationContext* context) {
+    *output = input->at(index);
+    return true;
+  }
+
   static bool DeserializeElements(Data* input,
                                   UserType* output,
                                   SerializationContext* context) {
@@ -309,6 +337,17 @@ struct ArraySerializer<
                                     size, i));
     }
   }
+
+  template <typename UserElement>
+  static bool DeserializeElement(Data* input,
+                                 size_t index,
+                                 UserElement* output,
+                                 SerializationContext* context) {
+    bool result = Deserialize<Element>(&input->at(index), output, context);
+    DCHECK(result);
+    return true;
+  }
+
   static bool DeserializeElements(Data* input,
                                   UserType* output,
                                   SerializationContext* context) {
@@ -366,6 +405,15 @@ struct ArraySerializer<MojomType,
                                     size, i));
     }
   }
+
+  template <typename UserElement>
+  static bool DeserializeElement(Data* input,
+                                 size_t index,
+                                 UserElement* output,
+                                 SerializationContext* context) {
+    return Deserialize<Element>(input->at(index).Get(), output, context);
+  }
+
   static bool DeserializeElements(Data* input,
                                   UserType* output,
                                   SerializationContext* context) {
@@ -447,6 +495,14 @@ struct ArraySerializer<
     }
   }
 
+  template <typename UserElement>
+  static bool DeserializeElement(Data* input,
+                                 size_t index,
+                                 UserElement* output,
+                                 SerializationContext* context) {
+    return Deserialize<Element>(&input->at(index), output, context);
+  }
+
   static bool DeserializeElements(Data* input,
                                   UserType* output,
                                   SerializationContext* context) {
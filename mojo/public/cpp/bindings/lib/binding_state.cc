@@ -80,6 +80,11 @@ void BindingStateBase::EnableBatchDispatch() {
   router_->EnableBatchDispatch();
 }
 
+void BindingStateBase::SetDispatchBatchSize(size_t batch_size) {
+  DCHECK(is_bound());
+  router_->SetDispatchBatchSize(batch_size);
+}
+
 void BindingStateBase::EnableTestingMode() {
   DCHECK(is_bound());
   router_->EnableTestingMode();
@@ -78,6 +78,8 @@ class COMPONENT_EXPORT(MOJO_CPP_BINDINGS) BindingStateBase {
 
   void EnableBatchDispatch();
 
+  void SetDispatchBatchSize(size_t batch_size);
+
   void EnableTestingMode();
 
   scoped_refptr<internal::MultiplexRouter> RouterForTesting();
@@ -18,6 +18,7 @@
 #include "base/threading/sequence_local_storage_slot.h"
 #include "base/trace_event/trace_event.h"
 #include "mojo/public/cpp/bindings/features.h"
+#include "mojo/public/cpp/bindings/lib/interface_cost_stats.h"
 #include "mojo/public/cpp/bindings/lib/may_auto_lock.h"
 #include "mojo/public/cpp/bindings/lib/tracing_helper.h"
 #include "mojo/public/cpp/bindings/mojo_buildflags.h"
@@ -161,6 +162,7 @@ Connector::Connector(ScopedMessagePipeHandle message_pipe,
       force_immediate_dispatch_(!EnableTaskPerMessage()),
       outgoing_serialization_mode_(g_default_outgoing_serialization_mode),
       incoming_serialization_mode_(g_default_incoming_serialization_mode),
+      record_cost_stats_(internal::InterfaceCostStats::IsEnabled()),
       nesting_observer_(RunLoopNestingObserver::GetForThread()),
       weak_factory_(this) {
   if (config == MULTI_THREADED_SEND)
@@ -263,7 +265,7 @@ bool Connector::WaitForIncomingMessage(MojoDeadline deadline) {
   }
 
   DCHECK(!message.IsNull());
-  return DispatchMessage(std::move(message));
+  return DispatchMessage(std::move(message), base::TimeDelta());
 }
 
 void Connector::PauseIncomingMethodCallProcessing() {
@@ -292,12 +294,10 @@ void Connector::ResumeIncomingMethodCallProcessing() {
     if (!weak_self)
       return;
   } else {
-    for (size_t i = 0; i < dispatch_queue_.size(); ++i) {
-      task_runner_->PostTask(
-          FROM_HERE, base::BindOnce(base::IgnoreResult(
-                                        &Connector::DispatchNextMessageInQueue),
-                                    weak_self_));
-    }
+    size_t num_batches = (dispatch_queue_.size() + dispatch_batch_size_ - 1) /
+                         dispatch_batch_size_;
+    for (size_t i = 0; i < num_batches; ++i)
+      ScheduleDispatchTask();
   }
 
   paused_ = false;
@@ -331,10 +331,23 @@ bool Connector::Accept(Message* message) {
   }
 #endif
 
+  base::TimeTicks send_start;
+  if (record_cost_stats_)
+    send_start = base::TimeTicks::Now();
+  const uint32_t method = message->name();
+  const size_t num_bytes =
+      message->is_serialized() ? message->data_num_bytes() : 0;
+
   MojoResult rv =
       WriteMessageNew(message_pipe_.get(), message->TakeMojoMessage(),
                       MOJO_WRITE_MESSAGE_FLAG_NONE);
 
+  if (record_cost_stats_) {
+    internal::InterfaceCostStats::Get()->RecordSentMessage(
+        heap_profiler_tag_, method, num_bytes,
+        base::TimeTicks::Now() - send_start);
+  }
+
   switch (rv) {
     case MOJO_RESULT_OK:
       break;
@@ -495,7 +508,8 @@ MojoResult Connector::ReadMessage(Message* message) {
   return MOJO_RESULT_OK;
 }
 
-bool Connector::DispatchMessage(Message message) {
+bool Connector::DispatchMessage(Message message,
+                                base::TimeDelta queueing_delay) {
   DCHECK(!paused_);
 
   base::WeakPtr<Connector> weak_self = weak_self_;
@@ -521,8 +535,24 @@ bool Connector::DispatchMessage(Message message) {
   TRACE_EVENT0("mojom", heap_profiler_tag_);
 #endif
 
+  // Copied since the receiver may delete |this|.
+  const char* const interface_name = heap_profiler_tag_;
+  const uint32_t method = message.name();
+  const size_t num_bytes =
+      message.is_serialized() ? message.data_num_bytes() : 0;
+  base::TimeTicks dispatch_start;
+  if (record_cost_stats_)
+    dispatch_start = base::TimeTicks::Now();
+
   bool receiver_result =
       incoming_receiver_ && incoming_receiver_->Accept(&message);
+
+  if (!dispatch_start.is_null()) {
+    internal::InterfaceCostStats::Get()->RecordDispatchedMessage(
+        interface_name, method, num_bytes, queueing_delay,
+        base::TimeTicks::Now() - dispatch_start);
+  }
+
   if (!weak_self)
     return receiver_result;
 
@@ -548,11 +578,16 @@ bool Connector::DispatchNextMessageInQueue() {
 
   Message message = std::move(dispatch_queue_.front());
   dispatch_queue_.pop();
+  base::TimeDelta queueing_delay;
+  if (record_cost_stats_) {
+    queueing_delay = base::TimeTicks::Now() - dispatch_queue_read_times_.front();
+    dispatch_queue_read_times_.pop();
+  }
 
   base::WeakPtr<Connector> weak_self = weak_self_;
 
   // NOTE: May delete |this|.
-  bool result = DispatchMessage(std::move(message));
+  bool result = DispatchMessage(std::move(message), queueing_delay);
   if (weak_self) {
     // If that was our last queued message and we've detected a pipe error, we
     // can propagate it now.
@@ -565,6 +600,25 @@ bool Connector::DispatchNextMessageInQueue() {
   return result;
 }
 
+bool Connector::DispatchNextMessageBatchInQueue() {
+  base::WeakPtr<Connector> weak_self = weak_self_;
+  for (size_t i = 0;
+       i < dispatch_batch_size_ && weak_self && !dispatch_queue_.empty(); ++i) {
+    if (!DispatchNextMessageInQueue())
+      return false;
+  }
+
+  return true;
+}
+
+void Connector::ScheduleDispatchTask() {
+  task_runner_->PostTask(
+      FROM_HERE,
+      base::BindOnce(
+          base::IgnoreResult(&Connector::DispatchNextMessageBatchInQueue),
+          weak_self_));
+}
+
 bool Connector::DispatchAllQueuedMessages() {
   base::WeakPtr<Connector> weak_self = weak_self_;
   while (weak_self && !dispatch_queue_.empty()) {
@@ -597,14 +651,18 @@ void Connector::ReadAllAvailableMessages() {
       // Dispatch immediately if this is the first available message or if
       // immediate dispatch is currently enabled for whatever reason.
       DCHECK(dispatch_queue_.empty());
-      if (!DispatchMessage(std::move(message)) || !weak_self || paused_)
+      if (!DispatchMessage(std::move(message), base::TimeDelta()) ||
+          !weak_self || paused_) {
         return;
+      }
     } else {
+      // Each scheduled task dispatches up to |dispatch_batch_size_| messages,
+      // so there is always a task for every message still queued.
       dispatch_queue_.push(std::move(message));
-      task_runner_->PostTask(
-          FROM_HERE, base::BindOnce(base::IgnoreResult(
-                                        &Connector::DispatchNextMessageInQueue),
-                                    weak_self_));
+      if (record_cost_stats_)
+        dispatch_queue_read_times_.push(base::TimeTicks::Now());
+      if ((dispatch_queue_.size() - 1) % dispatch_batch_size_ == 0)
+        ScheduleDispatchTask();
     }
 
     first_message_in_batch = false;
@@ -0,0 +1,132 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "mojo/public/cpp/bindings/lib/interface_cost_stats.h"
+
+#include "base/feature_list.h"
+#include "base/strings/stringprintf.h"
+#include "base/trace_event/memory_dump_manager.h"
+#include "base/trace_event/process_memory_dump.h"
+#include "base/trace_event/trace_event.h"
+#include "mojo/public/cpp/bindings/features.h"
+
+namespace mojo {
+namespace internal {
+
+namespace {
+
+bool g_enabled_for_testing = false;
+
+void AddCount(base::trace_event::MemoryAllocatorDump* dump,
+              const char* name,
+              uint64_t value) {
+  dump->AddScalar(name, base::trace_event::MemoryAllocatorDump::kUnitsObjects,
+                  value);
+}
+
+void AddBytes(base::trace_event::MemoryAllocatorDump* dump,
+              const char* name,
+              uint64_t value) {
+  dump->AddScalar(name, base::trace_event::MemoryAllocatorDump::kUnitsBytes,
+                  value);
+}
+
+}  // namespace
+
+// static
+bool InterfaceCostStats::IsEnabled() {
+  if (g_enabled_for_testing)
+    return true;
+
+  // Const since this may be called from any thread. See EnableTaskPerMessage()
+  // in connector.cc.
+  static const bool enabled =
+      base::FeatureList::IsEnabled(features::kInterfaceCostStats);
+  return enabled;
+}
+
+// static
+InterfaceCostStats* InterfaceCostStats::Get() {
+  static base::NoDestructor<InterfaceCostStats> stats;
+  return stats.get();
+}
+
+void InterfaceCostStats::RecordSentMessage(const char* interface_name,
+                                           uint32_t method,
+                                           size_t num_bytes,
+                                           base::TimeDelta send_time) {
+  base::AutoLock locker(lock_);
+  Counters& counters = counters_[Key(interface_name, method)];
+  counters.messages_sent++;
+  counters.bytes_sent += num_bytes;
+  counters.send_time += send_time;
+}
+
+void InterfaceCostStats::RecordDispatchedMessage(
+    const char* interface_name,
+    uint32_t method,
+    size_t num_bytes,
+    base::TimeDelta queueing_delay,
+    base::TimeDelta dispatch_time) {
+  uint64_t messages_dispatched;
+  int64_t dispatch_time_us;
+  {
+    base::AutoLock locker(lock_);
+    Counters& counters = counters_[Key(interface_name, method)];
+    counters.messages_dispatched++;
+    counters.bytes_dispatched += num_bytes;
+    counters.queueing_delay += queueing_delay;
+    counters.dispatch_time += dispatch_time;
+    messages_dispatched = counters.messages_dispatched;
+    dispatch_time_us = counters.dispatch_time.InMicroseconds();
+  }
+
+  // This is a no-op unless the category is enabled.
+  TRACE_COUNTER2(TRACE_DISABLED_BY_DEFAULT("mojom"), interface_name,
+                 "messages_dispatched", messages_dispatched,
+                 "dispatch_time_us", dispatch_time_us);
+}
+
+InterfaceCostStats::Counters InterfaceCostStats::GetCountersForTesting(
+    const char* interface_name,
+    uint32_t method) {
+  base::AutoLock locker(lock_);
+  auto it = counters_.find(Key(interface_name, method));
+  return it == counters_.end() ? Counters() : it->second;
+}
+
+// static
+void InterfaceCostStats::SetEnabledForTesting(bool enabled) {
+  g_enabled_for_testing = enabled;
+}
+
+InterfaceCostStats::InterfaceCostStats() {
+  base::trace_event::MemoryDumpManager::GetInstance()->RegisterDumpProvider(
+      this, "MojoInterfaceCost", nullptr);
+}
+
+InterfaceCostStats::~InterfaceCostStats() = default;
+
+bool InterfaceCostStats::OnMemoryDump(
+    const base::trace_event::MemoryDumpArgs& args,
+    base::trace_event::ProcessMemoryDump* pmd) {
+  base::AutoLock locker(lock_);
+  for (const auto& entry : counters_) {
+    const Counters& counters = entry.second;
+    auto* dump = pmd->CreateAllocatorDump(base::StringPrintf(
+        "mojo/interfaces/%s/%u", entry.first.first, entry.first.second));
+    AddCount(dump, "messages_sent", counters.messages_sent);
+    AddBytes(dump, "bytes_sent", counters.bytes_sent);
+    AddCount(dump, "send_time_us", counters.send_time.InMicroseconds());
+    AddCount(dump, "messages_dispatched", counters.messages_dispatched);
+    AddBytes(dump, "bytes_dispatched", counters.bytes_dispatched);
+    AddCount(dump, "dispatch_time_us", counters.dispatch_time.InMicroseconds());
+    AddCount(dump, "queueing_delay_us",
+             counters.queueing_delay.InMicroseconds());
+  }
+  return true;
+}
+
+}  // namespace internal
+}  // namespace mojo
@@ -0,0 +1,92 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef MOJO_PUBLIC_CPP_BINDINGS_LIB_INTERFACE_COST_STATS_H_
+#define MOJO_PUBLIC_CPP_BINDINGS_LIB_INTERFACE_COST_STATS_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <map>
+#include <utility>
+
+#include "base/component_export.h"
+#include "base/macros.h"
+#include "base/no_destructor.h"
+#include "base/synchronization/lock.h"
+#include "base/time/time.h"
+#include "base/trace_event/memory_dump_provider.h"
+
+namespace mojo {
+namespace internal {
+
+// Process-wide counters of the cost of mojom interfaces, keyed by interface
+// name and method ordinal. Connectors record every message they send and
+// dispatch while the kInterfaceCostStats feature is enabled.
+//
+// The counters are reported in memory-infra dumps under
+// "mojo/interfaces/<interface>/<method>", and as a counter track per interface
+// in the disabled-by-default "mojom" tracing category.
+class COMPONENT_EXPORT(MOJO_CPP_BINDINGS) InterfaceCostStats
+    : public base::trace_event::MemoryDumpProvider {
+ public:
+  struct Counters {
+    uint64_t messages_sent = 0;
+    uint64_t bytes_sent = 0;
+    // Time spent writing messages to the pipe, which includes serializing
+    // lazily serialized messages.
+    base::TimeDelta send_time;
+
+    uint64_t messages_dispatched = 0;
+    uint64_t bytes_dispatched = 0;
+    base::TimeDelta dispatch_time;
+    // Time messages spent in the Connector's dispatch queue after having been
+    // read off the pipe.
+    base::TimeDelta queueing_delay;
+  };
+
+  // Whether Connectors should record their messages. This is checked once per
+  // Connector.
+  static bool IsEnabled();
+
+  static InterfaceCostStats* Get();
+
+  // |interface_name| must be a string literal, such as the name passed to
+  // Connector::SetWatcherHeapProfilerTag().
+  void RecordSentMessage(const char* interface_name,
+                         uint32_t method,
+                         size_t num_bytes,
+                         base::TimeDelta send_time);
+  void RecordDispatchedMessage(const char* interface_name,
+                               uint32_t method,
+                               size_t num_bytes,
+                               base::TimeDelta queueing_delay,
+                               base::TimeDelta dispatch_time);
+
+  Counters GetCountersForTesting(const char* interface_name, uint32_t method);
+  static void SetEnabledForTesting(bool enabled);
+
+ private:
+  friend class base::NoDestructor<InterfaceCostStats>;
+
+  using Key = std::pair<const char*, uint32_t>;
+
+  InterfaceCostStats();
+  ~InterfaceCostStats() override;
+
+  // base::trace_event::MemoryDumpProvider:
+  bool OnMemoryDump(const base::trace_event::MemoryDumpArgs& args,
+                    base::trace_event::ProcessMemoryDump* pmd) override;
+
+  base::Lock lock_;
+  // Interface names are literals, so they are compared by address.
+  std::map<Key, Counters> counters_;
+
+  DISALLOW_COPY_AND_ASSIGN(InterfaceCostStats);
+};
+
+}  // namespace internal
+}  // namespace mojo
+
+#endif  // MOJO_PUBLIC_CPP_BINDINGS_LIB_INTERFACE_COST_STATS_H_
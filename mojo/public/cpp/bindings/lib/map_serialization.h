@@ -131,23 +131,24 @@ struct Serializer<MapDataView<Key, Value>, MaybeConstUserType> {
     if (!input)
       return CallSetToNullIfExists<Traits>(output);
 
-    std::vector<UserKey> keys;
-    std::vector<UserValue> values;
-
-    if (!KeyArraySerializer::DeserializeElements(input->keys.Get(), &keys,
-                                                 context) ||
-        !ValueArraySerializer::DeserializeElements(input->values.Get(), &values,
-                                                   context)) {
-      return false;
-    }
-
-    DCHECK_EQ(keys.size(), values.size());
-    size_t size = keys.size();
+    // Deserialize each entry straight into |output|, rather than deserializing
+    // all the keys and values into temporary vectors first. This saves two
+    // heap allocations per map.
+    auto* keys = input->keys.Get();
+    auto* values = input->values.Get();
+    DCHECK_EQ(keys->size(), values->size());
+    size_t size = keys->size();
     Traits::SetToEmpty(output);
 
     for (size_t i = 0; i < size; ++i) {
-      if (!Traits::Insert(*output, std::move(keys[i]), std::move(values[i])))
+      UserKey key;
+      UserValue value;
+      if (!KeyArraySerializer::DeserializeElement(keys, i, &key, context) ||
+          !ValueArraySerializer::DeserializeElement(values, i, &value,
+                                                    context) ||
+          !Traits::Insert(*output, std::move(key), std::move(value))) {
         return false;
+      }
     }
     return true;
   }
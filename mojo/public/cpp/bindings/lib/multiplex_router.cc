@@ -556,6 +556,11 @@ void MultiplexRouter::EnableBatchDispatch() {
   connector_.set_force_immediate_dispatch(true);
 }
 
+void MultiplexRouter::SetDispatchBatchSize(size_t batch_size) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  connector_.set_dispatch_batch_size(batch_size);
+}
+
 void MultiplexRouter::EnableTestingMode() {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
   MayAutoLock locker(&lock_);
@@ -139,6 +139,9 @@ class COMPONENT_EXPORT(MOJO_CPP_BINDINGS) MultiplexRouter
   // See comments on Binding::EnableBatchDispatch().
   void EnableBatchDispatch();
 
+  // See comments on Binding::SetDispatchBatchSize().
+  void SetDispatchBatchSize(size_t batch_size);
+
   // Sets this object to testing mode.
   // In testing mode, the object doesn't disconnect the underlying message pipe
   // when it receives unexpected or invalid messages.
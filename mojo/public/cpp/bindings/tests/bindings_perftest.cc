@@ -3,7 +3,12 @@
 // found in the LICENSE file.
 
 #include <stddef.h>
+#include <stdint.h>
+
+#include <map>
+#include <string>
 #include <utility>
+#include <vector>
 
 #include "base/bind.h"
 #include "base/message_loop/message_loop.h"
@@ -13,6 +18,8 @@
 #include "mojo/public/cpp/bindings/binding.h"
 #include "mojo/public/cpp/bindings/interface_endpoint_client.h"
 #include "mojo/public/cpp/bindings/lib/multiplex_router.h"
+#include "mojo/public/cpp/bindings/lib/serialization.h"
+#include "mojo/public/cpp/bindings/lib/validate_params.h"
 #include "mojo/public/cpp/bindings/message.h"
 #include "mojo/public/cpp/test_support/test_support.h"
 #include "mojo/public/cpp/test_support/test_utils.h"
@@ -280,5 +287,82 @@ TEST_F(MojoBindingsPerftest, MultiplexRouterDispatchCost) {
   }
 }
 
+// Serializes |input| as |MojomType| into a message and deserializes it back,
+// repeatedly. Logs the round trip rate, and the wire size of the encoding next
+// to |raw_size|, the size of the data itself, to track the overhead of the
+// wire format's alignment, pointers and headers.
+template <typename MojomType, typename UserType>
+void MeasureEncodeDecode(
+    const char* sub_test_name,
+    const UserType& input,
+    size_t raw_size,
+    const internal::ContainerValidateParams* validate_params) {
+  const int kIterations = 10000;
+  size_t wire_size = 0;
+  const base::TimeTicks start_time = base::TimeTicks::Now();
+  for (int i = 0; i < kIterations; ++i) {
+    Message message(0, 0, 0, 0, nullptr);
+    internal::SerializationContext context;
+    const size_t payload_start = message.payload_buffer()->cursor();
+    typename internal::MojomTypeTraits<MojomType>::Data::BufferWriter writer;
+    internal::Serialize<MojomType>(input, message.payload_buffer(), &writer,
+                                   validate_params, &context);
+    wire_size = message.payload_buffer()->cursor() - payload_start;
+
+    UserType output;
+    bool result =
+        internal::Deserialize<MojomType>(writer.data(), &output, &context);
+    CHECK(result);
+  }
+  const base::TimeDelta duration = base::TimeTicks::Now() - start_time;
+
+  test::LogPerfResult("EncodeDecode", sub_test_name,
+                      kIterations / duration.InSecondsF(), "times/second");
+  test::LogPerfResult("EncodeDecodeRawSize", sub_test_name, raw_size, "bytes");
+  test::LogPerfResult("EncodeDecodeWireSize", sub_test_name, wire_size,
+                      "bytes");
+}
+
+TEST_F(MojoBindingsPerftest, EncodeDecode) {
+  const size_t kCount = 256;
+
+  std::vector<bool> bools(kCount);
+  for (size_t i = 0; i < kCount; ++i)
+    bools[i] = i % 3 == 0;
+  internal::ContainerValidateParams bools_params(0, false, nullptr);
+  MeasureEncodeDecode<ArrayDataView<bool>>("BoolArray", bools, kCount / 8,
+                                           &bools_params);
+
+  std::vector<int32_t> ints(kCount);
+  for (size_t i = 0; i < kCount; ++i)
+    ints[i] = static_cast<int32_t>(i);
+  internal::ContainerValidateParams ints_params(0, false, nullptr);
+  MeasureEncodeDecode<ArrayDataView<int32_t>>(
+      "Int32Array", ints, kCount * sizeof(int32_t), &ints_params);
+
+  // Short strings, each of which gets its own pointer and array header.
+  std::vector<std::string> strings(kCount);
+  size_t strings_size = 0;
+  for (size_t i = 0; i < kCount; ++i) {
+    strings[i] = std::to_string(i);
+    strings_size += strings[i].size();
+  }
+  internal::ContainerValidateParams strings_params(
+      0, false, new internal::ContainerValidateParams(0, false, nullptr));
+  MeasureEncodeDecode<ArrayDataView<StringDataView>>(
+      "StringArray", strings, strings_size, &strings_params);
+
+  std::map<std::string, int32_t> map;
+  for (size_t i = 0; i < kCount; ++i)
+    map[strings[i]] = static_cast<int32_t>(i);
+  internal::ContainerValidateParams map_params(
+      new internal::ContainerValidateParams(
+          0, false, new internal::ContainerValidateParams(0, false, nullptr)),
+      new internal::ContainerValidateParams(0, false, nullptr));
+  MeasureEncodeDecode<MapDataView<StringDataView, int32_t>>(
+      "StringToInt32Map", map, strings_size + kCount * sizeof(int32_t),
+      &map_params);
+}
+
 }  // namespace
 }  // namespace mojo
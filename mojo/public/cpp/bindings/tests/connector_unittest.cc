@@ -17,6 +17,7 @@
 #include "base/stl_util.h"
 #include "base/threading/thread.h"
 #include "base/threading/thread_task_runner_handle.h"
+#include "mojo/public/cpp/bindings/lib/interface_cost_stats.h"
 #include "mojo/public/cpp/bindings/message.h"
 #include "mojo/public/cpp/bindings/tests/message_queue.h"
 #include "testing/gtest/include/gtest/gtest.h"
@@ -468,6 +469,70 @@ void PauseConnectorAndRunClosure(Connector* connector,
   closure.Run();
 }
 
+TEST_F(ConnectorTest, DispatchBatches) {
+  Connector connector0(std::move(handle0_), Connector::SINGLE_THREADED_SEND,
+                       base::ThreadTaskRunnerHandle::Get());
+  Connector connector1(std::move(handle1_), Connector::SINGLE_THREADED_SEND,
+                       base::ThreadTaskRunnerHandle::Get());
+  connector1.set_dispatch_batch_size(3);
+
+  const char* kText[] = {"a", "b", "c", "d", "e", "f", "g"};
+  for (size_t i = 0; i < base::size(kText); ++i) {
+    Message message = CreateMessage(kText[i]);
+    connector0.Accept(&message);
+  }
+
+  MessageAccumulator accumulator;
+  connector1.set_incoming_receiver(&accumulator);
+  base::RunLoop().RunUntilIdle();
+
+  // All the messages are dispatched, in order, even though the last batch is
+  // partial.
+  ASSERT_EQ(base::size(kText), accumulator.size());
+  for (size_t i = 0; i < base::size(kText); ++i) {
+    Message message_received;
+    accumulator.Pop(&message_received);
+    EXPECT_EQ(
+        std::string(kText[i]),
+        std::string(reinterpret_cast<const char*>(message_received.payload())));
+  }
+}
+
+TEST_F(ConnectorTest, RecordsCostStats) {
+  internal::InterfaceCostStats::SetEnabledForTesting(true);
+  Connector connector0(std::move(handle0_), Connector::SINGLE_THREADED_SEND,
+                       base::ThreadTaskRunnerHandle::Get());
+  Connector connector1(std::move(handle1_), Connector::SINGLE_THREADED_SEND,
+                       base::ThreadTaskRunnerHandle::Get());
+  internal::InterfaceCostStats::SetEnabledForTesting(false);
+
+  const char kInterfaceName[] = "mojo.test.CostStatsInterface";
+  connector0.SetWatcherHeapProfilerTag(kInterfaceName);
+  connector1.SetWatcherHeapProfilerTag(kInterfaceName);
+
+  const char kText[] = "hello world";
+  size_t num_bytes = 0;
+  for (int i = 0; i < 3; ++i) {
+    Message message = CreateMessage(kText);
+    num_bytes += message.data_num_bytes();
+    connector0.Accept(&message);
+  }
+
+  MessageAccumulator accumulator;
+  connector1.set_incoming_receiver(&accumulator);
+  base::RunLoop().RunUntilIdle();
+  ASSERT_EQ(3u, accumulator.size());
+
+  // CreateMessage() uses method ordinal 1.
+  internal::InterfaceCostStats::Counters counters =
+      internal::InterfaceCostStats::Get()->GetCountersForTesting(kInterfaceName,
+                                                                 1);
+  EXPECT_EQ(3u, counters.messages_sent);
+  EXPECT_EQ(num_bytes, counters.bytes_sent);
+  EXPECT_EQ(3u, counters.messages_dispatched);
+  EXPECT_EQ(num_bytes, counters.bytes_dispatched);
+}
+
 TEST_F(ConnectorTest, PauseWithQueuedMessages) {
   Connector connector0(std::move(handle0_), Connector::SINGLE_THREADED_SEND,
                        base::ThreadTaskRunnerHandle::Get());
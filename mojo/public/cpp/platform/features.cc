@@ -15,5 +15,12 @@ const base::Feature kMojoChannelMac{"MojoChannelMac",
                                     base::FEATURE_DISABLED_BY_DEFAULT};
 #endif
 
+#if defined(OS_LINUX) || defined(OS_ANDROID)
+// Makes ChannelPosix offer its peer a shared memory ring to carry its messages,
+// keeping the socket for handles and for waking the peer up when it's idle.
+const base::Feature kMojoSharedMemoryChannel{"MojoSharedMemoryChannel",
+                                             base::FEATURE_DISABLED_BY_DEFAULT};
+#endif
+
 }  // namespace features
 }  // namespace mojo
@@ -17,6 +17,11 @@ COMPONENT_EXPORT(MOJO_CPP_PLATFORM)
 extern const base::Feature kMojoChannelMac;
 #endif
 
+#if defined(OS_LINUX) || defined(OS_ANDROID)
+COMPONENT_EXPORT(MOJO_CPP_PLATFORM)
+extern const base::Feature kMojoSharedMemoryChannel;
+#endif
+
 }  // namespace features
 }  // namespace mojo
 
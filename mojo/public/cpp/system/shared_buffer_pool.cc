@@ -0,0 +1,160 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "mojo/public/cpp/system/shared_buffer_pool.h"
+
+#include <iterator>
+#include <utility>
+
+#include "base/logging.h"
+
+namespace mojo {
+
+namespace {
+
+// Allocations are rounded up to this size, so that they are all suitably
+// aligned for any type.
+constexpr uint32_t kAllocationAlignment = 16;
+
+uint32_t AlignSize(uint32_t size) {
+  return (size + kAllocationAlignment - 1) & ~(kAllocationAlignment - 1);
+}
+
+}  // namespace
+
+struct SharedBufferPool::Region {
+  ScopedSharedBufferHandle handle;
+  ScopedSharedBufferMapping mapping;
+
+  // Free ranges of the region, as offset to size. Adjacent ranges are always
+  // merged.
+  std::map<uint32_t, uint32_t> free_ranges;
+};
+
+SharedBufferPool::SharedBufferPool(uint32_t region_size)
+    : region_size_(AlignSize(region_size)) {
+  DCHECK_GT(region_size_, 0u);
+}
+
+SharedBufferPool::~SharedBufferPool() = default;
+
+bool SharedBufferPool::Allocate(uint32_t size,
+                                Allocation* allocation,
+                                ScopedSharedBufferHandle* new_region) {
+  if (size == 0 || size > region_size_)
+    return false;
+  const uint32_t aligned_size = AlignSize(size);
+
+  for (auto& entry : regions_) {
+    int64_t offset = AllocateFromRegion(entry.second.get(), aligned_size);
+    if (offset >= 0) {
+      allocation->region_id = entry.first;
+      allocation->offset = static_cast<uint32_t>(offset);
+      allocation->size = size;
+      return true;
+    }
+  }
+
+  auto region = std::make_unique<Region>();
+  region->handle = SharedBufferHandle::Create(region_size_);
+  if (!region->handle.is_valid())
+    return false;
+  region->mapping = region->handle->Map(region_size_);
+  if (!region->mapping)
+    return false;
+  ScopedSharedBufferHandle peer_handle =
+      region->handle->Clone(SharedBufferHandle::AccessMode::READ_ONLY);
+  if (!peer_handle.is_valid())
+    return false;
+  region->free_ranges[0] = region_size_;
+
+  int64_t offset = AllocateFromRegion(region.get(), aligned_size);
+  DCHECK_EQ(0, offset);
+  allocation->region_id = next_region_id_++;
+  allocation->offset = 0;
+  allocation->size = size;
+  regions_[allocation->region_id] = std::move(region);
+  *new_region = std::move(peer_handle);
+  return true;
+}
+
+void* SharedBufferPool::GetMemory(const Allocation& allocation) const {
+  auto it = regions_.find(allocation.region_id);
+  DCHECK(it != regions_.end());
+  return static_cast<uint8_t*>(it->second->mapping.get()) + allocation.offset;
+}
+
+void SharedBufferPool::Free(const Allocation& allocation) {
+  auto it = regions_.find(allocation.region_id);
+  DCHECK(it != regions_.end());
+  std::map<uint32_t, uint32_t>& free_ranges = it->second->free_ranges;
+
+  uint32_t offset = allocation.offset;
+  uint32_t size = AlignSize(allocation.size);
+
+  // Merge with the free ranges right after and right before the allocation.
+  auto next = free_ranges.lower_bound(offset);
+  DCHECK(next == free_ranges.end() || next->first >= offset + size);
+  if (next != free_ranges.end() && next->first == offset + size) {
+    size += next->second;
+    next = free_ranges.erase(next);
+  }
+  if (next != free_ranges.begin()) {
+    auto previous = std::prev(next);
+    DCHECK_LE(previous->first + previous->second, offset);
+    if (previous->first + previous->second == offset) {
+      previous->second += size;
+      return;
+    }
+  }
+  free_ranges.emplace_hint(next, offset, size);
+}
+
+// static
+int64_t SharedBufferPool::AllocateFromRegion(Region* region, uint32_t size) {
+  // First fit: regions are expected to hold many allocations of similar sizes.
+  for (auto it = region->free_ranges.begin(); it != region->free_ranges.end();
+       ++it) {
+    if (it->second < size)
+      continue;
+    const uint32_t offset = it->first;
+    const uint32_t remaining = it->second - size;
+    region->free_ranges.erase(it);
+    if (remaining)
+      region->free_ranges[offset + size] = remaining;
+    return offset;
+  }
+  return -1;
+}
+
+SharedBufferPoolReader::SharedBufferPoolReader() = default;
+
+SharedBufferPoolReader::~SharedBufferPoolReader() = default;
+
+bool SharedBufferPoolReader::AddRegion(uint32_t region_id,
+                                       ScopedSharedBufferHandle region) {
+  if (!region.is_valid() || regions_.count(region_id))
+    return false;
+  const uint64_t size = region->GetSize();
+  ScopedSharedBufferMapping mapping = region->Map(size);
+  if (!mapping)
+    return false;
+  regions_[region_id] = {std::move(mapping), size};
+  return true;
+}
+
+const void* SharedBufferPoolReader::GetMemory(
+    const SharedBufferPool::Allocation& allocation) const {
+  auto it = regions_.find(allocation.region_id);
+  if (it == regions_.end())
+    return nullptr;
+  const uint64_t end =
+      static_cast<uint64_t>(allocation.offset) + allocation.size;
+  if (end > it->second.size)
+    return nullptr;
+  return static_cast<const uint8_t*>(it->second.mapping.get()) +
+         allocation.offset;
+}
+
+}  // namespace mojo
@@ -0,0 +1,98 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef MOJO_PUBLIC_CPP_SYSTEM_SHARED_BUFFER_POOL_H_
+#define MOJO_PUBLIC_CPP_SYSTEM_SHARED_BUFFER_POOL_H_
+
+#include <stdint.h>
+
+#include <map>
+#include <memory>
+
+#include "base/macros.h"
+#include "mojo/public/cpp/system/buffer.h"
+#include "mojo/public/cpp/system/system_export.h"
+
+namespace mojo {
+
+// Hands out sub-allocations of a few large shared buffers, so that a sender of
+// many small, short-lived shared memory payloads doesn't have to create and
+// transfer a new shared buffer handle for each of them.
+//
+// The pool shares each of its regions with the receiver once, as Allocate()
+// returns a new region handle, which the receiver gives to its
+// SharedBufferPoolReader. From then on, allocations are sent to the receiver
+// as plain (region id, offset, size) triples and no handles are transferred.
+// It is up to the sender and receiver to agree on when an allocation can be
+// freed, e.g. with an acknowledgement message.
+class MOJO_CPP_SYSTEM_EXPORT SharedBufferPool {
+ public:
+  // The location of an allocation, in a form that can be sent to the receiver.
+  struct Allocation {
+    uint32_t region_id = 0;
+    uint32_t offset = 0;
+    uint32_t size = 0;
+  };
+
+  // Creates a pool allocating from regions of |region_size| bytes.
+  explicit SharedBufferPool(uint32_t region_size);
+  ~SharedBufferPool();
+
+  // Allocates |size| bytes, which must be no more than the region size. Returns
+  // false on failure. If a new region had to be created for the allocation,
+  // |*new_region| receives a handle to it, which must be sent to the receiver
+  // along with |allocation->region_id| before the allocation itself.
+  bool Allocate(uint32_t size,
+                Allocation* allocation,
+                ScopedSharedBufferHandle* new_region);
+
+  // Returns the memory of an allocation which hasn't been freed.
+  void* GetMemory(const Allocation& allocation) const;
+
+  // Returns the memory of |allocation| to the pool.
+  void Free(const Allocation& allocation);
+
+ private:
+  struct Region;
+
+  // Tries to allocate |size| bytes from |region|, returning the offset of the
+  // allocation or -1 if the region has no large enough free range.
+  static int64_t AllocateFromRegion(Region* region, uint32_t size);
+
+  const uint32_t region_size_;
+  std::map<uint32_t, std::unique_ptr<Region>> regions_;
+  uint32_t next_region_id_ = 1;
+
+  DISALLOW_COPY_AND_ASSIGN(SharedBufferPool);
+};
+
+// The receiving side of a SharedBufferPool: maps the regions shared by the pool
+// and resolves allocations to their memory.
+class MOJO_CPP_SYSTEM_EXPORT SharedBufferPoolReader {
+ public:
+  SharedBufferPoolReader();
+  ~SharedBufferPoolReader();
+
+  // Maps |region|, received from the pool with |region_id|. Returns false if
+  // the id is already known or the region can't be mapped.
+  bool AddRegion(uint32_t region_id, ScopedSharedBufferHandle region);
+
+  // Returns the memory of |allocation|, or null if it doesn't lie within a
+  // known region. The sender isn't trusted, so the result must be checked.
+  const void* GetMemory(const SharedBufferPool::Allocation& allocation) const;
+
+ private:
+  struct Region {
+    ScopedSharedBufferMapping mapping;
+    uint64_t size;
+  };
+
+  std::map<uint32_t, Region> regions_;
+
+  DISALLOW_COPY_AND_ASSIGN(SharedBufferPoolReader);
+};
+
+}  // namespace mojo
+
+#endif  // MOJO_PUBLIC_CPP_SYSTEM_SHARED_BUFFER_POOL_H_
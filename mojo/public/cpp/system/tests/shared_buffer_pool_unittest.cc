@@ -0,0 +1,97 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "mojo/public/cpp/system/shared_buffer_pool.h"
+
+#include <string.h>
+
+#include <utility>
+
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace mojo {
+namespace {
+
+constexpr uint32_t kRegionSize = 4096;
+
+TEST(SharedBufferPoolTest, SharesEachRegionOnce) {
+  SharedBufferPool pool(kRegionSize);
+  SharedBufferPoolReader reader;
+
+  SharedBufferPool::Allocation first;
+  ScopedSharedBufferHandle region;
+  ASSERT_TRUE(pool.Allocate(100, &first, &region));
+  ASSERT_TRUE(region.is_valid());
+  EXPECT_TRUE(reader.AddRegion(first.region_id, std::move(region)));
+
+  // The second allocation fits in the same region, so no handle is needed.
+  SharedBufferPool::Allocation second;
+  ASSERT_TRUE(pool.Allocate(100, &second, &region));
+  EXPECT_FALSE(region.is_valid());
+  EXPECT_EQ(first.region_id, second.region_id);
+  EXPECT_NE(first.offset, second.offset);
+
+  memcpy(pool.GetMemory(second), "hello", 6);
+  const void* memory = reader.GetMemory(second);
+  ASSERT_TRUE(memory);
+  EXPECT_STREQ("hello", static_cast<const char*>(memory));
+}
+
+TEST(SharedBufferPoolTest, ReusesFreedMemory) {
+  SharedBufferPool pool(kRegionSize);
+
+  SharedBufferPool::Allocation allocations[4];
+  ScopedSharedBufferHandle region;
+  for (auto& allocation : allocations)
+    ASSERT_TRUE(pool.Allocate(kRegionSize / 4, &allocation, &region));
+
+  // Freeing two adjacent allocations makes room for a larger one in the same
+  // region.
+  pool.Free(allocations[1]);
+  pool.Free(allocations[2]);
+  SharedBufferPool::Allocation large;
+  region.reset();
+  ASSERT_TRUE(pool.Allocate(kRegionSize / 2, &large, &region));
+  EXPECT_FALSE(region.is_valid());
+  EXPECT_EQ(allocations[0].region_id, large.region_id);
+  EXPECT_EQ(allocations[1].offset, large.offset);
+
+  // The region is full again, so the next allocation needs a new one.
+  SharedBufferPool::Allocation other;
+  ASSERT_TRUE(pool.Allocate(16, &other, &region));
+  EXPECT_TRUE(region.is_valid());
+  EXPECT_NE(allocations[0].region_id, other.region_id);
+}
+
+TEST(SharedBufferPoolTest, RejectsOversizedAllocations) {
+  SharedBufferPool pool(kRegionSize);
+  SharedBufferPool::Allocation allocation;
+  ScopedSharedBufferHandle region;
+  EXPECT_FALSE(pool.Allocate(kRegionSize + 1, &allocation, &region));
+  EXPECT_FALSE(pool.Allocate(0, &allocation, &region));
+}
+
+TEST(SharedBufferPoolTest, ReaderRejectsInvalidAllocations) {
+  SharedBufferPool pool(kRegionSize);
+  SharedBufferPoolReader reader;
+  SharedBufferPool::Allocation allocation;
+  ScopedSharedBufferHandle region;
+  ASSERT_TRUE(pool.Allocate(16, &allocation, &region));
+  ASSERT_TRUE(reader.AddRegion(allocation.region_id, std::move(region)));
+
+  SharedBufferPool::Allocation bad = allocation;
+  bad.region_id++;
+  EXPECT_FALSE(reader.GetMemory(bad));
+
+  bad = allocation;
+  bad.offset = kRegionSize - 8;
+  EXPECT_FALSE(reader.GetMemory(bad));
+
+  bad = allocation;
+  bad.offset = 0xffffffff;
+  EXPECT_FALSE(reader.GetMemory(bad));
+}
+
+}  // namespace
+}  // namespace mojo
@@ -37,5 +37,62 @@ const base::Feature kPostQuantumCECPQ2{"PostQuantumCECPQ2",
 const base::Feature kNetUnusedIdleSocketTimeout{
     "NetUnusedIdleSocketTimeout", base::FEATURE_DISABLED_BY_DEFAULT};
 
+const base::Feature kHttpCacheWritersPipelining{
+    "HttpCacheWritersPipelining", base::FEATURE_DISABLED_BY_DEFAULT};
+
+const base::Feature kQuicBatchedUdpIo{"QuicBatchedUdpIo",
+                                      base::FEATURE_DISABLED_BY_DEFAULT};
+
+const base::Feature kHappyEyeballsV2{"HappyEyeballsV2",
+                                     base::FEATURE_DISABLED_BY_DEFAULT};
+
+const base::Feature kRaceDnsOverHttpsWithSystemResolver{
+    "RaceDnsOverHttpsWithSystemResolver", base::FEATURE_DISABLED_BY_DEFAULT};
+
+const base::FeatureParam<int> kRaceDnsOverHttpsDelayMs{
+    &kRaceDnsOverHttpsWithSystemResolver, "delay_ms", 100};
+
+const base::Feature kSharedCertVerificationCache{
+    "SharedCertVerificationCache", base::FEATURE_DISABLED_BY_DEFAULT};
+
+const base::Feature kSpdyFairWriteScheduler{"SpdyFairWriteScheduler",
+                                            base::FEATURE_DISABLED_BY_DEFAULT};
+
+const base::Feature kPreconnectPredictor{"PreconnectPredictor",
+                                         base::FEATURE_DISABLED_BY_DEFAULT};
+
+const base::FeatureParam<int> kPreconnectPredictorMaxOrigins{
+    &kPreconnectPredictor, "max_origins", 8};
+
+const base::FeatureParam<int> kPreconnectPredictorSocketBudget{
+    &kPreconnectPredictor, "socket_budget", 24};
+
+const base::FeatureParam<int> kPreconnectPredictorWarmUpIntervalSeconds{
+    &kPreconnectPredictor, "warm_up_interval_seconds", 30};
+
+const base::Feature kFastContentDecoding{"FastContentDecoding",
+                                         base::FEATURE_DISABLED_BY_DEFAULT};
+
+const base::FeatureParam<int> kFastContentDecodingInputBufferSize{
+    &kFastContentDecoding, "input_buffer_size", 128 * 1024};
+
+const base::Feature kConnectionStats{"ConnectionStats",
+                                     base::FEATURE_DISABLED_BY_DEFAULT};
+
+const base::FeatureParam<int> kConnectionStatsRecorderCapacity{
+    &kConnectionStats, "recorder_capacity", 1024};
+
+const base::FeatureParam<int> kConnectionStatsSampleIntervalMs{
+    &kConnectionStats, "sample_interval_ms", 1000};
+
+const base::Feature kPacResultCache{"PacResultCache",
+                                    base::FEATURE_DISABLED_BY_DEFAULT};
+
+const base::FeatureParam<int> kPacResultCacheTtlSeconds{
+    &kPacResultCache, "ttl_seconds", 60};
+
+const base::Feature kReportingUploadCompression{
+    "ReportingUploadCompression", base::FEATURE_DISABLED_BY_DEFAULT};
+
 }  // namespace features
 }  // namespace net
@@ -6,6 +6,7 @@
 #define NET_BASE_FEATURES_H_
 
 #include "base/feature_list.h"
+#include "base/metrics/field_trial_params.h"
 #include "net/base/net_export.h"
 
 namespace net {
@@ -44,6 +45,69 @@ NET_EXPORT extern const base::Feature kPostQuantumCECPQ2;
 NET_EXPORT
 extern const base::Feature kNetUnusedIdleSocketTimeout;
 
+// Lets HttpCache::Writers read the next chunk of a response from the network
+// while the previous one is being written to the cache.
+NET_EXPORT extern const base::Feature kHttpCacheWritersPipelining;
+
+// Lets QUIC read and write several UDP datagrams per system call, with
+// recvmmsg(), sendmmsg() and UDP_SEGMENT where supported.
+NET_EXPORT extern const base::Feature kQuicBatchedUdpIo;
+
+// Lets TransportConnectJob start connecting to the addresses of one family as
+// soon as the host resolver has them, and paces its connection attempts as
+// described by Happy Eyeballs v2 (RFC 8305).
+NET_EXPORT extern const base::Feature kHappyEyeballsV2;
+
+// Starts a system resolver lookup in parallel with DNS lookups using
+// DNS-over-HTTPS that haven't completed after kRaceDnsOverHttpsDelayMs, and
+// uses the first successful results.
+NET_EXPORT extern const base::Feature kRaceDnsOverHttpsWithSystemResolver;
+NET_EXPORT extern const base::FeatureParam<int> kRaceDnsOverHttpsDelayMs;
+
+// Makes the default CertVerifiers of all URLRequestContexts share a
+// process-wide cache of verification results, and lets the builtin verifier
+// reuse the intermediates of the paths it built before.
+NET_EXPORT extern const base::Feature kSharedCertVerificationCache;
+
+// Makes SpdySession interleave the frames of streams of the same priority by
+// the number of bytes they've written, instead of in FIFO order.
+NET_EXPORT extern const base::Feature kSpdyFairWriteScheduler;
+
+// Makes HttpStreamFactory learn which origins are requested most, and how many
+// streams they need at once, and keep connections to them warm.
+NET_EXPORT extern const base::Feature kPreconnectPredictor;
+NET_EXPORT extern const base::FeatureParam<int> kPreconnectPredictorMaxOrigins;
+NET_EXPORT extern const base::FeatureParam<int>
+    kPreconnectPredictorSocketBudget;
+NET_EXPORT extern const base::FeatureParam<int>
+    kPreconnectPredictorWarmUpIntervalSeconds;
+
+// Makes FilterSourceStream read larger chunks of encoded data from upstream,
+// so that gzip and brotli decode longer runs at once, and lets brotli decoders
+// reuse the large buffers freed by previous decoders.
+NET_EXPORT extern const base::Feature kFastContentDecoding;
+NET_EXPORT extern const base::FeatureParam<int>
+    kFastContentDecodingInputBufferSize;
+
+// Makes the sockets watched by the NetworkQualityEstimator record snapshots of
+// their connection's stats (RTT, congestion window, retransmits, etc.) in a
+// ring buffer that can be exposed for live monitoring.
+NET_EXPORT extern const base::Feature kConnectionStats;
+NET_EXPORT extern const base::FeatureParam<int>
+    kConnectionStatsRecorderCapacity;
+NET_EXPORT extern const base::FeatureParam<int>
+    kConnectionStatsSampleIntervalMs;
+
+// Makes MultiThreadedProxyResolver cache the results of PAC scripts whose
+// FindProxyForURL() only depends on the host, by scheme and host, for
+// kPacResultCacheTtlSeconds.
+NET_EXPORT extern const base::Feature kPacResultCache;
+NET_EXPORT extern const base::FeatureParam<int> kPacResultCacheTtlSeconds;
+
+// Makes ReportingUploader gzip the reports it uploads, when the collector
+// accepts a Content-Encoding on the request.
+NET_EXPORT extern const base::Feature kReportingUploadCompression;
+
 }  // namespace features
 }  // namespace net
 
@@ -0,0 +1,74 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "net/base/request_arena.h"
+
+#include <stdint.h>
+
+#include <algorithm>
+#include <new>
+
+#include "base/bits.h"
+
+namespace net {
+
+namespace {
+
+// Most requests only need the first block. Later blocks are twice as large as
+// the previous one, up to |kMaxBlockSize|.
+constexpr size_t kInitialBlockSize = 2 * 1024;
+constexpr size_t kMaxBlockSize = 32 * 1024;
+
+}  // namespace
+
+struct alignas(alignof(std::max_align_t)) RequestArena::Block {
+  Block* previous;
+};
+
+RequestArena::RequestArena() : next_block_size_(kInitialBlockSize) {}
+
+RequestArena::~RequestArena() {
+  // Objects allocated from the arena are gone, so this may run on any
+  // sequence.
+  while (current_block_) {
+    Block* previous = current_block_->previous;
+    ::operator delete(current_block_);
+    current_block_ = previous;
+  }
+}
+
+void* RequestArena::Allocate(size_t size, size_t alignment) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  DCHECK(base::bits::IsPowerOfTwo(alignment));
+  DCHECK_LE(alignment, alignof(std::max_align_t));
+
+  uintptr_t start = base::bits::Align(reinterpret_cast<uintptr_t>(cursor_),
+                                      alignment);
+  uintptr_t end = reinterpret_cast<uintptr_t>(end_);
+  if (!cursor_ || start > end || size > end - start) {
+    // Blocks are aligned for any |alignment|.
+    AddBlock(size);
+    start = reinterpret_cast<uintptr_t>(cursor_);
+  }
+  cursor_ = reinterpret_cast<char*>(start + size);
+  used_bytes_ += size;
+  return reinterpret_cast<void*>(start);
+}
+
+void RequestArena::AddBlock(size_t min_size) {
+  CHECK_LE(min_size, std::numeric_limits<size_t>::max() - sizeof(Block));
+  // Allocations larger than a block get a block of their own.
+  size_t block_size = std::max(next_block_size_, min_size);
+  if (block_size == next_block_size_)
+    next_block_size_ = std::min(next_block_size_ * 2, kMaxBlockSize);
+
+  Block* block = new (::operator new(sizeof(Block) + block_size)) Block;
+  block->previous = current_block_;
+  current_block_ = block;
+  cursor_ = reinterpret_cast<char*>(block + 1);
+  end_ = cursor_ + block_size;
+  allocated_bytes_ += sizeof(Block) + block_size;
+}
+
+}  // namespace net
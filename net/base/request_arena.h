@@ -0,0 +1,135 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef NET_BASE_REQUEST_ARENA_H_
+#define NET_BASE_REQUEST_ARENA_H_
+
+#include <stddef.h>
+
+#include <limits>
+#include <memory>
+#include <type_traits>
+
+#include "base/logging.h"
+#include "base/macros.h"
+#include "base/memory/ref_counted.h"
+#include "base/sequence_checker.h"
+#include "net/base/net_export.h"
+
+namespace net {
+
+// A bump allocator for the small objects created while a URLRequest is
+// processed, see URLRequest::arena(). Memory is only released when the arena
+// is destroyed: objects allocating from the arena hold a reference to it, so
+// that it is released with the request unless they outlive it.
+//
+// The reference count is thread-safe, but memory must be allocated on the
+// sequence the arena was created on.
+class NET_EXPORT RequestArena
+    : public base::RefCountedThreadSafe<RequestArena> {
+ public:
+  RequestArena();
+
+  // Returns |size| bytes aligned to |alignment|, which must be a power of two
+  // no larger than alignof(std::max_align_t).
+  void* Allocate(size_t size, size_t alignment);
+
+  // Bytes obtained from the heap, including unused space at the end of the
+  // blocks.
+  size_t allocated_bytes() const { return allocated_bytes_; }
+
+  // Bytes handed out by Allocate().
+  size_t used_bytes() const { return used_bytes_; }
+
+ private:
+  friend class base::RefCountedThreadSafe<RequestArena>;
+
+  // A block of memory that objects are carved from. Blocks are linked to the
+  // previously allocated one, their memory follows the header.
+  struct Block;
+
+  ~RequestArena();
+
+  // Allocates a block with at least |min_size| usable bytes.
+  void AddBlock(size_t min_size);
+
+  Block* current_block_ = nullptr;
+  char* cursor_ = nullptr;
+  char* end_ = nullptr;
+  size_t next_block_size_;
+
+  size_t allocated_bytes_ = 0;
+  size_t used_bytes_ = 0;
+
+  SEQUENCE_CHECKER(sequence_checker_);
+
+  DISALLOW_COPY_AND_ASSIGN(RequestArena);
+};
+
+// An STL allocator which allocates from a RequestArena, or from the heap if
+// constructed without an arena.
+//
+// Copying a container switches the copy to the heap, so that copies don't
+// depend on the lifetime of the arena. Moving or swapping containers moves
+// the allocator along with the memory. The owner of a container using an
+// arena must keep a reference to the arena, and move or swap it with the
+// container.
+template <typename T>
+class RequestArenaAllocator {
+ public:
+  using value_type = T;
+  using propagate_on_container_copy_assignment = std::false_type;
+  using propagate_on_container_move_assignment = std::true_type;
+  using propagate_on_container_swap = std::true_type;
+
+  template <typename U>
+  struct rebind {
+    using other = RequestArenaAllocator<U>;
+  };
+
+  RequestArenaAllocator() = default;
+  explicit RequestArenaAllocator(RequestArena* arena) : arena_(arena) {}
+
+  template <typename U>
+  RequestArenaAllocator(const RequestArenaAllocator<U>& other)
+      : arena_(other.arena()) {}
+
+  T* allocate(size_t n) {
+    if (!arena_)
+      return std::allocator<T>().allocate(n);
+    CHECK_LE(n, std::numeric_limits<size_t>::max() / sizeof(T));
+    return static_cast<T*>(arena_->Allocate(n * sizeof(T), alignof(T)));
+  }
+
+  void deallocate(T* p, size_t n) {
+    // Arena memory is released with the arena.
+    if (!arena_)
+      std::allocator<T>().deallocate(p, n);
+  }
+
+  RequestArenaAllocator select_on_container_copy_construction() const {
+    return RequestArenaAllocator();
+  }
+
+  RequestArena* arena() const { return arena_; }
+
+ private:
+  RequestArena* arena_ = nullptr;
+};
+
+template <typename T, typename U>
+bool operator==(const RequestArenaAllocator<T>& a,
+                const RequestArenaAllocator<U>& b) {
+  return a.arena() == b.arena();
+}
+
+template <typename T, typename U>
+bool operator!=(const RequestArenaAllocator<T>& a,
+                const RequestArenaAllocator<U>& b) {
+  return !(a == b);
+}
+
+}  // namespace net
+
+#endif  // NET_BASE_REQUEST_ARENA_H_
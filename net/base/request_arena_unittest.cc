@@ -0,0 +1,74 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "net/base/request_arena.h"
+
+#include <stdint.h>
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace net {
+namespace {
+
+using ArenaVector =
+    std::vector<std::string, RequestArenaAllocator<std::string>>;
+
+TEST(RequestArenaTest, Allocate) {
+  auto arena = base::MakeRefCounted<RequestArena>();
+  EXPECT_EQ(0u, arena->allocated_bytes());
+  EXPECT_EQ(0u, arena->used_bytes());
+
+  char* a = static_cast<char*>(arena->Allocate(3, 1));
+  void* b = arena->Allocate(8, 8);
+  EXPECT_EQ(0u, reinterpret_cast<uintptr_t>(b) % 8);
+  // Both allocations come from the first block.
+  EXPECT_LT(a, b);
+  EXPECT_EQ(11u, arena->used_bytes());
+  EXPECT_GE(arena->allocated_bytes(), arena->used_bytes());
+}
+
+TEST(RequestArenaTest, LargeAllocations) {
+  auto arena = base::MakeRefCounted<RequestArena>();
+  for (size_t size = 1; size <= 1 << 20; size *= 2) {
+    char* allocation = static_cast<char*>(arena->Allocate(size, 16));
+    EXPECT_EQ(0u, reinterpret_cast<uintptr_t>(allocation) % 16);
+    // The allocation must be usable.
+    allocation[0] = 'a';
+    allocation[size - 1] = 'b';
+  }
+  EXPECT_GE(arena->allocated_bytes(), size_t{(1 << 21) - 1});
+}
+
+TEST(RequestArenaTest, Allocator) {
+  auto arena = base::MakeRefCounted<RequestArena>();
+  ArenaVector strings{RequestArenaAllocator<std::string>(arena.get())};
+  for (int i = 0; i < 100; ++i)
+    strings.push_back(std::string(i, 'a'));
+  EXPECT_GE(arena->used_bytes(), 100 * sizeof(std::string));
+
+  // Copies use the heap.
+  ArenaVector copy(strings);
+  EXPECT_EQ(nullptr, copy.get_allocator().arena());
+  EXPECT_EQ(strings, copy);
+
+  // Move assignment and swap take the allocator along.
+  ArenaVector moved;
+  moved = std::move(strings);
+  EXPECT_EQ(arena.get(), moved.get_allocator().arena());
+  EXPECT_EQ(copy, moved);
+  moved.swap(copy);
+  EXPECT_EQ(nullptr, moved.get_allocator().arena());
+  EXPECT_EQ(arena.get(), copy.get_allocator().arena());
+
+  // Copy assignment keeps the allocator of the destination.
+  moved = copy;
+  EXPECT_EQ(nullptr, moved.get_allocator().arena());
+}
+
+}  // namespace
+}  // namespace net
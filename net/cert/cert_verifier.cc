@@ -5,6 +5,7 @@
 #include "net/cert/cert_verifier.h"
 
 #include <algorithm>
+#include <utility>
 
 #include "base/strings/string_util.h"
 #include "build/build_config.h"
@@ -16,8 +17,11 @@
 #if defined(OS_NACL)
 #include "base/logging.h"
 #else
+#include "base/feature_list.h"
+#include "net/base/features.h"
 #include "net/cert/caching_cert_verifier.h"
 #include "net/cert/multi_threaded_cert_verifier.h"
+#include "net/cert/shared_cert_verification_cache.h"
 #endif
 
 namespace net {
@@ -77,9 +81,15 @@ std::unique_ptr<CertVerifier> CertVerifier::CreateDefault() {
   NOTIMPLEMENTED();
   return std::unique_ptr<CertVerifier>();
 #else
-  return std::make_unique<CachingCertVerifier>(
-      std::make_unique<MultiThreadedCertVerifier>(
-          CertVerifyProc::CreateDefault()));
+  auto verifier = std::make_unique<MultiThreadedCertVerifier>(
+      CertVerifyProc::CreateDefault());
+  // All the default verifiers use the same kind of CertVerifyProc, so they
+  // can share their results.
+  if (base::FeatureList::IsEnabled(features::kSharedCertVerificationCache)) {
+    verifier->SetSharedVerificationCache(
+        SharedCertVerificationCache::GetInstance());
+  }
+  return std::make_unique<CachingCertVerifier>(std::move(verifier));
 #endif
 }
 
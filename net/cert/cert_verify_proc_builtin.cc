@@ -8,9 +8,16 @@
 #include <string>
 #include <vector>
 
+#include "base/containers/mru_cache.h"
+#include "base/feature_list.h"
 #include "base/logging.h"
+#include "base/macros.h"
 #include "base/strings/string_piece.h"
+#include "base/synchronization/lock.h"
+#include "base/thread_annotations.h"
 #include "crypto/sha2.h"
+#include "net/base/features.h"
+#include "net/base/hash_value.h"
 #include "net/base/net_errors.h"
 #include "net/cert/cert_net_fetcher.h"
 #include "net/cert/cert_status_flags.h"
@@ -256,6 +263,35 @@ class PathBuilderDelegateImpl : public SimplePathBuilderDelegate {
   bool* checked_revocation_for_some_path_;
 };
 
+// The number of intermediates kept by an IntermediateCache.
+const size_t kMaxCachedIntermediates = 256;
+
+// Remembers the intermediates of the valid paths built by a
+// CertVerifyProcBuiltin, so that later verifications don't parse them again,
+// and can use them to build paths when a server omits them or when they had
+// to be fetched through AIA. This class is thread-safe.
+class IntermediateCache {
+ public:
+  IntermediateCache() : cache_(kMaxCachedIntermediates) {}
+
+  // Returns the cached ParsedCertificate for |cert_handle|, or parses it.
+  scoped_refptr<ParsedCertificate> GetOrParse(CRYPTO_BUFFER* cert_handle,
+                                              CertErrors* errors);
+
+  // Adds all the cached intermediates to |issuer_source|.
+  void AddToIssuerSource(CertIssuerSourceStatic* issuer_source);
+
+  // Caches the certificates of |path| other than its target and its root.
+  void AddIntermediatesOfPath(const CertPathBuilderResultPath& path);
+
+ private:
+  base::Lock lock_;
+  base::MRUCache<SHA256HashValue, scoped_refptr<ParsedCertificate>> cache_
+      GUARDED_BY(lock_);
+
+  DISALLOW_COPY_AND_ASSIGN(IntermediateCache);
+};
+
 class CertVerifyProcBuiltin : public CertVerifyProc {
  public:
   CertVerifyProcBuiltin();
@@ -273,6 +309,8 @@ class CertVerifyProcBuiltin : public CertVerifyProc {
                      CRLSet* crl_set,
                      const CertificateList& additional_trust_anchors,
                      CertVerifyResult* verify_result) override;
+
+  IntermediateCache intermediate_cache_;
 };
 
 CertVerifyProcBuiltin::CertVerifyProcBuiltin() = default;
@@ -291,12 +329,52 @@ scoped_refptr<ParsedCertificate> ParseCertificateFromBuffer(
                                    errors);
 }
 
+scoped_refptr<ParsedCertificate> IntermediateCache::GetOrParse(
+    CRYPTO_BUFFER* cert_handle,
+    CertErrors* errors) {
+  SHA256HashValue fingerprint =
+      X509Certificate::CalculateFingerprint256(cert_handle);
+  {
+    base::AutoLock lock(lock_);
+    auto it = cache_.Get(fingerprint);
+    if (it != cache_.end())
+      return it->second;
+  }
+  return ParseCertificateFromBuffer(cert_handle, errors);
+}
+
+void IntermediateCache::AddToIssuerSource(
+    CertIssuerSourceStatic* issuer_source) {
+  base::AutoLock lock(lock_);
+  for (const auto& entry : cache_)
+    issuer_source->AddCert(entry.second);
+}
+
+void IntermediateCache::AddIntermediatesOfPath(
+    const CertPathBuilderResultPath& path) {
+  if (path.certs.size() <= 2)
+    return;
+  base::AutoLock lock(lock_);
+  for (size_t i = 1; i + 1 < path.certs.size(); ++i) {
+    // The same fingerprint as X509Certificate::CalculateFingerprint256().
+    SHA256HashValue fingerprint;
+    crypto::SHA256HashString(path.certs[i]->der_cert().AsStringPiece(),
+                             fingerprint.data, sizeof(fingerprint.data));
+    cache_.Put(fingerprint, scoped_refptr<ParsedCertificate>(path.certs[i]));
+  }
+}
+
+// Parses the intermediates of |x509_cert| into |intermediates|, reusing the
+// ones in |intermediate_cache| if it is not null.
 void AddIntermediatesToIssuerSource(X509Certificate* x509_cert,
+                                    IntermediateCache* intermediate_cache,
                                     CertIssuerSourceStatic* intermediates) {
   CertErrors errors;
   for (const auto& intermediate : x509_cert->intermediate_buffers()) {
     scoped_refptr<ParsedCertificate> cert =
-        ParseCertificateFromBuffer(intermediate.get(), &errors);
+        intermediate_cache
+            ? intermediate_cache->GetOrParse(intermediate.get(), &errors)
+            : ParseCertificateFromBuffer(intermediate.get(), &errors);
     if (cert)
       intermediates->AddCert(std::move(cert));
     // TODO(crbug.com/634443): Surface these parsing errors?
@@ -406,6 +484,7 @@ struct BuildPathAttempt {
 
 void TryBuildPath(const scoped_refptr<ParsedCertificate>& target,
                   CertIssuerSourceStatic* intermediates,
+                  CertIssuerSourceStatic* cached_intermediates,
                   SystemTrustStore* ssl_trust_store,
                   base::Time verification_time,
                   VerificationType verification_type,
@@ -451,6 +530,10 @@ void TryBuildPath(const scoped_refptr<ParsedCertificate>& target,
   // |input_cert|.
   path_builder.AddCertIssuerSource(intermediates);
 
+  // Allow the path builder to discover the intermediates of earlier paths.
+  if (cached_intermediates)
+    path_builder.AddCertIssuerSource(cached_intermediates);
+
   // Allow the path builder to discover intermediates through AIA fetching.
   std::unique_ptr<CertIssuerSourceAia> aia_cert_issuer_source;
   if (net_fetcher) {
@@ -577,9 +660,17 @@ int CertVerifyProcBuiltin::VerifyInternal(
     return ERR_CERT_INVALID;
   }
 
+  IntermediateCache* intermediate_cache = nullptr;
+  CertIssuerSourceStatic cached_intermediates;
+  if (base::FeatureList::IsEnabled(features::kSharedCertVerificationCache)) {
+    intermediate_cache = &intermediate_cache_;
+    intermediate_cache->AddToIssuerSource(&cached_intermediates);
+  }
+
   // Parse the provided intermediates.
   CertIssuerSourceStatic intermediates;
-  AddIntermediatesToIssuerSource(input_cert, &intermediates);
+  AddIntermediatesToIssuerSource(input_cert, intermediate_cache,
+                                 &intermediates);
 
   // Parse the additional trust anchors and setup trust store.
   std::unique_ptr<SystemTrustStore> ssl_trust_store =
@@ -628,14 +719,18 @@ int CertVerifyProcBuiltin::VerifyInternal(
     verification_type = cur_attempt.verification_type;
 
     // Run the attempt through the path builder.
-    TryBuildPath(target, &intermediates, ssl_trust_store.get(),
-                 verification_time, cur_attempt.verification_type,
-                 cur_attempt.digest_policy, flags, ocsp_response, crl_set,
-                 net_fetcher, ev_metadata, &result,
-                 &checked_revocation_for_some_path);
-
-    if (result.HasValidPath())
+    TryBuildPath(target, &intermediates,
+                 intermediate_cache ? &cached_intermediates : nullptr,
+                 ssl_trust_store.get(), verification_time,
+                 cur_attempt.verification_type, cur_attempt.digest_policy,
+                 flags, ocsp_response, crl_set, net_fetcher, ev_metadata,
+                 &result, &checked_revocation_for_some_path);
+
+    if (result.HasValidPath()) {
+      if (intermediate_cache)
+        intermediate_cache->AddIntermediatesOfPath(*result.GetBestValidPath());
       break;
+    }
 
     // If this path building attempt (may have) failed due to the chain using a
     // weak signature algorithm, enqueue a similar attempt but with weaker
@@ -26,6 +26,7 @@
 #include "net/cert/cert_verify_proc.h"
 #include "net/cert/cert_verify_result.h"
 #include "net/cert/crl_set.h"
+#include "net/cert/shared_cert_verification_cache.h"
 #include "net/cert/x509_certificate.h"
 #include "net/cert/x509_certificate_net_log_param.h"
 #include "net/log/net_log_capture_mode.h"
@@ -246,6 +247,10 @@ class CertVerifierJob {
       flags &= ~CertVerifyProc::VERIFY_REV_CHECKING_REQUIRED_LOCAL_ANCHORS;
     }
     DCHECK(config.crl_set);
+    if (cert_verifier_->shared_cache_) {
+      shared_cache_generation_ = cert_verifier_->shared_cache_->generation();
+      verification_time_ = base::Time::Now();
+    }
     base::PostTaskWithTraitsAndReplyWithResult(
         FROM_HERE,
         {base::MayBlock(), base::TaskShutdownBehavior::CONTINUE_ON_SHUTDOWN},
@@ -317,6 +322,13 @@ class CertVerifierJob {
         cert_verifier_->RemoveJob(this);
 
     LogMetrics(*verify_result);
+    if (cert_verifier_->shared_cache_ &&
+        config_id == cert_verifier_->config_id_) {
+      cert_verifier_->shared_cache_->Put(
+          SharedCertVerificationCache::Key(key_, cert_verifier_->config_),
+          shared_cache_generation_, verification_time_, verify_result->error,
+          verify_result->result);
+    }
     if (cert_verifier_->verify_complete_callback_ &&
         config_id == cert_verifier_->config_id_) {
       cert_verifier_->verify_complete_callback_.Run(
@@ -340,6 +352,11 @@ class CertVerifierJob {
   // the job actually took to complete.
   const base::TimeTicks start_time_;
 
+  // When the verifier has a SharedCertVerificationCache, the generation of the
+  // cache and the time when the verification started.
+  uint64_t shared_cache_generation_ = 0;
+  base::Time verification_time_;
+
   RequestList requests_;  // Non-owned.
 
   const NetLogWithSource net_log_;
@@ -360,6 +377,8 @@ MultiThreadedCertVerifier::MultiThreadedCertVerifier(
 
 MultiThreadedCertVerifier::~MultiThreadedCertVerifier() {
   DCHECK_CALLED_ON_VALID_THREAD(thread_checker_);
+  if (shared_cache_)
+    CertDatabase::GetInstance()->RemoveObserver(this);
 }
 
 // static
@@ -387,6 +406,15 @@ int MultiThreadedCertVerifier::Verify(const RequestParams& params,
 
   requests_++;
 
+  if (shared_cache_) {
+    int error;
+    if (shared_cache_->Get(SharedCertVerificationCache::Key(params, config_),
+                           base::Time::Now(), &error, verify_result)) {
+      shared_cache_hits_++;
+      return error;
+    }
+  }
+
   // See if an identical request is currently in flight.
   CertVerifierJob* job = FindJob(params);
   if (job) {
@@ -426,6 +454,21 @@ void MultiThreadedCertVerifier::SetConfig(const CertVerifier::Config& config) {
   joinable_.clear();
 }
 
+void MultiThreadedCertVerifier::SetSharedVerificationCache(
+    SharedCertVerificationCache* cache) {
+  DCHECK_CALLED_ON_VALID_THREAD(thread_checker_);
+  DCHECK(cache);
+  DCHECK(!shared_cache_);
+  shared_cache_ = cache;
+  CertDatabase::GetInstance()->AddObserver(this);
+}
+
+void MultiThreadedCertVerifier::OnCertDBChanged() {
+  DCHECK_CALLED_ON_VALID_THREAD(thread_checker_);
+  // Every verifier sharing the cache clears it, which is harmless.
+  shared_cache_->Clear();
+}
+
 bool MultiThreadedCertVerifier::JobComparator::operator()(
     const CertVerifierJob* job1,
     const CertVerifierJob* job2) const {
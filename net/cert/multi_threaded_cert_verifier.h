@@ -19,6 +19,7 @@
 #include "base/threading/thread_checker.h"
 #include "net/base/completion_once_callback.h"
 #include "net/base/net_export.h"
+#include "net/cert/cert_database.h"
 #include "net/cert/cert_verifier.h"
 
 namespace net {
@@ -26,10 +27,13 @@ namespace net {
 class CertVerifierJob;
 class CertVerifierRequest;
 class CertVerifyProc;
+class SharedCertVerificationCache;
 
 // MultiThreadedCertVerifier is a CertVerifier implementation that runs
 // synchronous CertVerifier implementations on worker threads.
-class NET_EXPORT_PRIVATE MultiThreadedCertVerifier : public CertVerifier {
+class NET_EXPORT_PRIVATE MultiThreadedCertVerifier
+    : public CertVerifier,
+      public CertDatabase::Observer {
  public:
   using VerifyCompleteCallback =
       base::RepeatingCallback<void(const RequestParams&,
@@ -67,6 +71,12 @@ class NET_EXPORT_PRIVATE MultiThreadedCertVerifier : public CertVerifier {
              const NetLogWithSource& net_log) override;
   void SetConfig(const CertVerifier::Config& config) override;
 
+  // Makes the verifier reuse the results in |cache|, and add its own results
+  // to it. |cache| is cleared when the CertDatabase changes, and must outlive
+  // the verifier; it is usually SharedCertVerificationCache::GetInstance().
+  // All the verifiers sharing a cache must use equivalent CertVerifyProcs.
+  void SetSharedVerificationCache(SharedCertVerificationCache* cache);
+
  private:
   struct JobToRequestParamsComparator;
   friend class CertVerifierRequest;
@@ -75,6 +85,7 @@ class NET_EXPORT_PRIVATE MultiThreadedCertVerifier : public CertVerifier {
   FRIEND_TEST_ALL_PREFIXES(MultiThreadedCertVerifierTest, InflightJoin);
   FRIEND_TEST_ALL_PREFIXES(MultiThreadedCertVerifierTest, MultipleInflightJoin);
   FRIEND_TEST_ALL_PREFIXES(MultiThreadedCertVerifierTest, CancelRequest);
+  FRIEND_TEST_ALL_PREFIXES(MultiThreadedCertVerifierTest, SharedCache);
 
   struct JobComparator {
     bool operator()(const CertVerifierJob* job1,
@@ -95,9 +106,13 @@ class NET_EXPORT_PRIVATE MultiThreadedCertVerifier : public CertVerifier {
   // caller. |job| must already be |inflight_|.
   std::unique_ptr<CertVerifierJob> RemoveJob(CertVerifierJob* job);
 
+  // CertDatabase::Observer methods:
+  void OnCertDBChanged() override;
+
   // For unit testing.
   uint64_t requests() const { return requests_; }
   uint64_t inflight_joins() const { return inflight_joins_; }
+  uint64_t shared_cache_hits() const { return shared_cache_hits_; }
 
   // |joinable_| holds the jobs for which an active verification is taking
   // place and can be joined by new requests (e.g. the config is the same),
@@ -118,9 +133,12 @@ class NET_EXPORT_PRIVATE MultiThreadedCertVerifier : public CertVerifier {
 
   uint64_t requests_;
   uint64_t inflight_joins_;
+  uint64_t shared_cache_hits_ = 0;
 
   scoped_refptr<CertVerifyProc> verify_proc_;
 
+  SharedCertVerificationCache* shared_cache_ = nullptr;  // Non-owned.
+
   // Members for dual verification trial. TODO(mattm): Remove these.
   // (See https://crbug.com/649026.)
   VerifyCompleteCallback verify_complete_callback_;
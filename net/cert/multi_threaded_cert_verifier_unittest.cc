@@ -12,8 +12,11 @@
 #include "base/format_macros.h"
 #include "net/base/net_errors.h"
 #include "net/base/test_completion_callback.h"
+#include "net/cert/cert_database.h"
 #include "net/cert/cert_verify_proc.h"
 #include "net/cert/cert_verify_result.h"
+#include "net/cert/crl_set.h"
+#include "net/cert/shared_cert_verification_cache.h"
 #include "net/cert/x509_certificate.h"
 #include "net/log/net_log_with_source.h"
 #include "net/test/cert_test_util.h"
@@ -124,6 +127,58 @@ TEST_F(MultiThreadedCertVerifierTest, InflightJoin) {
   ASSERT_EQ(1u, verifier_.inflight_joins());
 }
 
+// Tests that verifiers sharing a SharedCertVerificationCache reuse each
+// other's results.
+TEST_F(MultiThreadedCertVerifierTest, SharedCache) {
+  scoped_refptr<X509Certificate> test_cert(
+      ImportCertFromFile(GetTestCertsDirectory(), "ok_cert.pem"));
+  ASSERT_TRUE(test_cert);
+  const CertVerifier::RequestParams params(test_cert, "www.example.com", 0,
+                                           std::string());
+
+  SharedCertVerificationCache shared_cache(16);
+  verifier_.SetSharedVerificationCache(&shared_cache);
+  MultiThreadedCertVerifier verifier2(mock_verify_proc_);
+  verifier2.SetSharedVerificationCache(&shared_cache);
+
+  CertVerifyResult verify_result;
+  TestCompletionCallback callback;
+  std::unique_ptr<CertVerifier::Request> request;
+  int error = verifier_.Verify(params, &verify_result, callback.callback(),
+                               &request, NetLogWithSource());
+  ASSERT_THAT(error, IsError(ERR_IO_PENDING));
+  EXPECT_THAT(callback.WaitForResult(), IsError(ERR_CERT_COMMON_NAME_INVALID));
+  EXPECT_EQ(1u, shared_cache.size());
+
+  // The result is reused synchronously by the other verifier.
+  CertVerifyResult verify_result2;
+  std::unique_ptr<CertVerifier::Request> request2;
+  error = verifier2.Verify(params, &verify_result2, base::BindOnce(&FailTest),
+                           &request2, NetLogWithSource());
+  EXPECT_THAT(error, IsError(ERR_CERT_COMMON_NAME_INVALID));
+  EXPECT_FALSE(request2);
+  EXPECT_EQ(CERT_STATUS_COMMON_NAME_INVALID, verify_result2.cert_status);
+  EXPECT_EQ(1u, verifier2.shared_cache_hits());
+
+  // But not with a different config.
+  CertVerifier::Config config;
+  config.crl_set = CRLSet::EmptyCRLSetForTesting();
+  verifier2.SetConfig(config);
+  TestCompletionCallback callback3;
+  error = verifier2.Verify(params, &verify_result2, callback3.callback(),
+                           &request2, NetLogWithSource());
+  ASSERT_THAT(error, IsError(ERR_IO_PENDING));
+  EXPECT_THAT(callback3.WaitForResult(),
+              IsError(ERR_CERT_COMMON_NAME_INVALID));
+  EXPECT_EQ(1u, verifier2.shared_cache_hits());
+  EXPECT_EQ(2u, shared_cache.size());
+
+  // Changes to the certificate database clear the cache.
+  CertDatabase::GetInstance()->NotifyObserversCertDBChanged();
+  RunUntilIdle();
+  EXPECT_EQ(0u, shared_cache.size());
+}
+
 // Tests that the callback of a canceled request is never made.
 TEST_F(MultiThreadedCertVerifierTest, CancelRequest) {
   base::FilePath certs_dir = GetTestCertsDirectory();
@@ -0,0 +1,142 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "net/cert/shared_cert_verification_cache.h"
+
+#include <tuple>
+#include <utility>
+
+#include "base/no_destructor.h"
+#include "net/base/hash_value.h"
+#include "net/base/net_errors.h"
+#include "net/cert/crl_set.h"
+#include "net/cert/x509_certificate.h"
+
+namespace net {
+
+namespace {
+
+// The maximum number of results in the process-wide cache.
+const size_t kMaxCacheEntries = 1024;
+
+// The number of seconds to cache results, as in CachingCertVerifier.
+const unsigned kTTLSecs = 1800;  // 30 minutes.
+
+int GetConfigFlags(const CertVerifier::Config& config) {
+  return (config.enable_rev_checking ? 1 << 0 : 0) |
+         (config.require_rev_checking_local_anchors ? 1 << 1 : 0) |
+         (config.enable_sha1_local_anchors ? 1 << 2 : 0) |
+         (config.disable_symantec_enforcement ? 1 << 3 : 0);
+}
+
+}  // namespace
+
+SharedCertVerificationCache::Key::Key(const CertVerifier::RequestParams& params,
+                                      const CertVerifier::Config& config)
+    : params_(params),
+      config_flags_(GetConfigFlags(config)),
+      crl_set_(config.crl_set) {
+  for (const auto& anchor : config.additional_trust_anchors) {
+    SHA256HashValue hash =
+        X509Certificate::CalculateFingerprint256(anchor->cert_buffer());
+    additional_trust_anchors_hash_.append(
+        reinterpret_cast<const char*>(hash.data), sizeof(hash.data));
+  }
+}
+
+SharedCertVerificationCache::Key::Key(const Key& other) = default;
+
+SharedCertVerificationCache::Key::~Key() = default;
+
+bool SharedCertVerificationCache::Key::operator<(const Key& other) const {
+  if (params_ < other.params_)
+    return true;
+  if (other.params_ < params_)
+    return false;
+  const CRLSet* crl_set = crl_set_.get();
+  const CRLSet* other_crl_set = other.crl_set_.get();
+  return std::tie(config_flags_, crl_set, additional_trust_anchors_hash_) <
+         std::tie(other.config_flags_, other_crl_set,
+                  other.additional_trust_anchors_hash_);
+}
+
+SharedCertVerificationCache::CachedResult::CachedResult() : error(ERR_FAILED) {}
+
+SharedCertVerificationCache::CachedResult::CachedResult(CachedResult&& other) =
+    default;
+
+SharedCertVerificationCache::CachedResult::~CachedResult() = default;
+
+SharedCertVerificationCache::SharedCertVerificationCache(size_t max_entries)
+    : cache_(max_entries), generation_(0u) {}
+
+SharedCertVerificationCache::~SharedCertVerificationCache() = default;
+
+// static
+SharedCertVerificationCache* SharedCertVerificationCache::GetInstance() {
+  static base::NoDestructor<SharedCertVerificationCache> instance(
+      kMaxCacheEntries);
+  return instance.get();
+}
+
+uint64_t SharedCertVerificationCache::generation() const {
+  base::AutoLock lock(lock_);
+  return generation_;
+}
+
+bool SharedCertVerificationCache::Get(const Key& key,
+                                      base::Time now,
+                                      int* error,
+                                      CertVerifyResult* verify_result) {
+  base::AutoLock lock(lock_);
+  auto it = cache_.Get(key);
+  if (it == cache_.end())
+    return false;
+
+  // See CachingCertVerifier::CacheExpirationFunctor for why the verification
+  // time also bounds the validity of the result.
+  const CachedResult& cached_result = it->second;
+  if (now < cached_result.verification_time ||
+      now >= cached_result.expiration_time) {
+    cache_.Erase(it);
+    return false;
+  }
+
+  *error = cached_result.error;
+  *verify_result = cached_result.verify_result;
+  return true;
+}
+
+void SharedCertVerificationCache::Put(const Key& key,
+                                      uint64_t generation,
+                                      base::Time start_time,
+                                      int error,
+                                      const CertVerifyResult& verify_result) {
+  base::AutoLock lock(lock_);
+  if (generation != generation_)
+    return;
+
+  // As in CachingCertVerifier, the validity of the result starts when the
+  // verification started.
+  CachedResult cached_result;
+  cached_result.error = error;
+  cached_result.verify_result = verify_result;
+  cached_result.verification_time = start_time;
+  cached_result.expiration_time =
+      start_time + base::TimeDelta::FromSeconds(kTTLSecs);
+  cache_.Put(key, std::move(cached_result));
+}
+
+void SharedCertVerificationCache::Clear() {
+  base::AutoLock lock(lock_);
+  ++generation_;
+  cache_.Clear();
+}
+
+size_t SharedCertVerificationCache::size() const {
+  base::AutoLock lock(lock_);
+  return cache_.size();
+}
+
+}  // namespace net
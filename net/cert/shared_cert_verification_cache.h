@@ -0,0 +1,114 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef NET_CERT_SHARED_CERT_VERIFICATION_CACHE_H_
+#define NET_CERT_SHARED_CERT_VERIFICATION_CACHE_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <string>
+
+#include "base/containers/mru_cache.h"
+#include "base/macros.h"
+#include "base/memory/ref_counted.h"
+#include "base/synchronization/lock.h"
+#include "base/thread_annotations.h"
+#include "base/time/time.h"
+#include "net/base/net_export.h"
+#include "net/cert/cert_verifier.h"
+#include "net/cert/cert_verify_result.h"
+
+namespace net {
+
+class CRLSet;
+
+// A process-wide, size-bounded cache of certificate verification results,
+// shared by the MultiThreadedCertVerifiers of all the URLRequestContexts that
+// enable it, so that the same chains aren't verified once per context.
+//
+// Results are keyed by the RequestParams of the verification (the hash of the
+// chain, the hostname, the flags and the OCSP response) and by the parts of
+// the CertVerifier::Config they depend on, so that a new CRLSet or a new set
+// of additional trust anchors doesn't reuse older results. As with
+// CachingCertVerifier, results expire after 30 minutes, or when the clock
+// moves backwards past their verification time. Since results also depend on
+// the CertVerifyProc, only verifiers using equivalent CertVerifyProcs may
+// share a cache.
+//
+// This class is thread-safe.
+class NET_EXPORT_PRIVATE SharedCertVerificationCache {
+ public:
+  // The key of a verification result.
+  class NET_EXPORT_PRIVATE Key {
+   public:
+    Key(const CertVerifier::RequestParams& params,
+        const CertVerifier::Config& config);
+    Key(const Key& other);
+    ~Key();
+
+    bool operator<(const Key& other) const;
+
+   private:
+    CertVerifier::RequestParams params_;
+    // The boolean fields of the config.
+    int config_flags_;
+    // Kept alive so that another CRLSet can't compare equal by reusing its
+    // address.
+    scoped_refptr<CRLSet> crl_set_;
+    // The SHA-256 hashes of the additional trust anchors, concatenated.
+    std::string additional_trust_anchors_hash_;
+  };
+
+  explicit SharedCertVerificationCache(size_t max_entries);
+  ~SharedCertVerificationCache();
+
+  static SharedCertVerificationCache* GetInstance();
+
+  // Returns the generation to pass to Put() for a verification that starts
+  // now.
+  uint64_t generation() const;
+
+  // Returns true and sets |*error| and |*verify_result| if there is an
+  // unexpired result for |key| at |now|.
+  bool Get(const Key& key,
+           base::Time now,
+           int* error,
+           CertVerifyResult* verify_result);
+
+  // Adds the result of the verification of |key| that started at |start_time|,
+  // unless the cache was cleared after |generation| was retrieved.
+  void Put(const Key& key,
+           uint64_t generation,
+           base::Time start_time,
+           int error,
+           const CertVerifyResult& verify_result);
+
+  // Drops all results, for instance because trust settings changed.
+  void Clear();
+
+  size_t size() const;
+
+ private:
+  struct CachedResult {
+    CachedResult();
+    CachedResult(CachedResult&& other);
+    ~CachedResult();
+
+    int error;
+    CertVerifyResult verify_result;
+    base::Time verification_time;
+    base::Time expiration_time;
+  };
+
+  mutable base::Lock lock_;
+  base::MRUCache<Key, CachedResult> cache_ GUARDED_BY(lock_);
+  uint64_t generation_ GUARDED_BY(lock_);
+
+  DISALLOW_COPY_AND_ASSIGN(SharedCertVerificationCache);
+};
+
+}  // namespace net
+
+#endif  // NET_CERT_SHARED_CERT_VERIFICATION_CACHE_H_
@@ -0,0 +1,172 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "net/cert/shared_cert_verification_cache.h"
+
+#include <string>
+
+#include "base/memory/ref_counted.h"
+#include "base/time/time.h"
+#include "net/base/net_errors.h"
+#include "net/cert/cert_status_flags.h"
+#include "net/cert/crl_set.h"
+#include "net/cert/x509_certificate.h"
+#include "net/test/cert_test_util.h"
+#include "net/test/test_data_directory.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace net {
+
+namespace {
+
+class SharedCertVerificationCacheTest : public testing::Test {
+ public:
+  void SetUp() override {
+    cert_ = ImportCertFromFile(GetTestCertsDirectory(), "ok_cert.pem");
+    ASSERT_TRUE(cert_);
+  }
+
+  CertVerifier::RequestParams MakeParams(const std::string& hostname) {
+    return CertVerifier::RequestParams(cert_, hostname, 0, std::string());
+  }
+
+  CertVerifyResult MakeResult(CertStatus cert_status) {
+    CertVerifyResult result;
+    result.cert_status = cert_status;
+    return result;
+  }
+
+ protected:
+  scoped_refptr<X509Certificate> cert_;
+};
+
+TEST_F(SharedCertVerificationCacheTest, GetAndPut) {
+  SharedCertVerificationCache cache(10);
+  const SharedCertVerificationCache::Key key(MakeParams("www.example.com"),
+                                             CertVerifier::Config());
+  const base::Time now = base::Time::Now();
+
+  int error = OK;
+  CertVerifyResult result;
+  EXPECT_FALSE(cache.Get(key, now, &error, &result));
+
+  cache.Put(key, cache.generation(), now, ERR_CERT_COMMON_NAME_INVALID,
+            MakeResult(CERT_STATUS_COMMON_NAME_INVALID));
+  EXPECT_EQ(1u, cache.size());
+  ASSERT_TRUE(cache.Get(key, now, &error, &result));
+  EXPECT_EQ(ERR_CERT_COMMON_NAME_INVALID, error);
+  EXPECT_EQ(CERT_STATUS_COMMON_NAME_INVALID, result.cert_status);
+
+  // An equivalent key finds the same result.
+  const SharedCertVerificationCache::Key same_key(
+      MakeParams("www.example.com"), CertVerifier::Config());
+  EXPECT_TRUE(cache.Get(same_key, now, &error, &result));
+
+  // But not another hostname.
+  const SharedCertVerificationCache::Key other_host(
+      MakeParams("mail.example.com"), CertVerifier::Config());
+  EXPECT_FALSE(cache.Get(other_host, now, &error, &result));
+}
+
+TEST_F(SharedCertVerificationCacheTest, ConfigIsPartOfTheKey) {
+  SharedCertVerificationCache cache(10);
+  const base::Time now = base::Time::Now();
+  const SharedCertVerificationCache::Key key(MakeParams("www.example.com"),
+                                             CertVerifier::Config());
+  cache.Put(key, cache.generation(), now, OK, MakeResult(0));
+
+  int error = OK;
+  CertVerifyResult result;
+
+  CertVerifier::Config rev_checking_config;
+  rev_checking_config.enable_rev_checking = true;
+  EXPECT_FALSE(cache.Get(SharedCertVerificationCache::Key(
+                             MakeParams("www.example.com"),
+                             rev_checking_config),
+                         now, &error, &result));
+
+  CertVerifier::Config crl_set_config;
+  crl_set_config.crl_set = CRLSet::EmptyCRLSetForTesting();
+  EXPECT_FALSE(cache.Get(
+      SharedCertVerificationCache::Key(MakeParams("www.example.com"),
+                                       crl_set_config),
+      now, &error, &result));
+
+  CertVerifier::Config anchors_config;
+  anchors_config.additional_trust_anchors.push_back(cert_);
+  EXPECT_FALSE(cache.Get(
+      SharedCertVerificationCache::Key(MakeParams("www.example.com"),
+                                       anchors_config),
+      now, &error, &result));
+
+  EXPECT_TRUE(cache.Get(key, now, &error, &result));
+}
+
+TEST_F(SharedCertVerificationCacheTest, Expiration) {
+  SharedCertVerificationCache cache(10);
+  const SharedCertVerificationCache::Key key(MakeParams("www.example.com"),
+                                             CertVerifier::Config());
+  const base::Time start_time = base::Time::Now();
+  int error = OK;
+  CertVerifyResult result;
+
+  cache.Put(key, cache.generation(), start_time, OK, MakeResult(0));
+  EXPECT_TRUE(cache.Get(key, start_time + base::TimeDelta::FromMinutes(29),
+                        &error, &result));
+  EXPECT_FALSE(cache.Get(key, start_time + base::TimeDelta::FromMinutes(30),
+                         &error, &result));
+  EXPECT_EQ(0u, cache.size());
+
+  // The result isn't used if the clock moved backwards.
+  cache.Put(key, cache.generation(), start_time, OK, MakeResult(0));
+  EXPECT_FALSE(cache.Get(key, start_time - base::TimeDelta::FromSeconds(1),
+                         &error, &result));
+  EXPECT_EQ(0u, cache.size());
+}
+
+TEST_F(SharedCertVerificationCacheTest, ClearInvalidatesPendingResults) {
+  SharedCertVerificationCache cache(10);
+  const SharedCertVerificationCache::Key key(MakeParams("www.example.com"),
+                                             CertVerifier::Config());
+  const base::Time now = base::Time::Now();
+
+  // A verification that started before the cache was cleared isn't added.
+  uint64_t generation = cache.generation();
+  cache.Clear();
+  cache.Put(key, generation, now, OK, MakeResult(0));
+  EXPECT_EQ(0u, cache.size());
+
+  cache.Put(key, cache.generation(), now, OK, MakeResult(0));
+  EXPECT_EQ(1u, cache.size());
+  cache.Clear();
+  EXPECT_EQ(0u, cache.size());
+}
+
+TEST_F(SharedCertVerificationCacheTest, SizeIsBounded) {
+  SharedCertVerificationCache cache(2);
+  const base::Time now = base::Time::Now();
+  const SharedCertVerificationCache::Key key1(MakeParams("a.example.com"),
+                                              CertVerifier::Config());
+  const SharedCertVerificationCache::Key key2(MakeParams("b.example.com"),
+                                              CertVerifier::Config());
+  const SharedCertVerificationCache::Key key3(MakeParams("c.example.com"),
+                                              CertVerifier::Config());
+  int error = OK;
+  CertVerifyResult result;
+
+  cache.Put(key1, cache.generation(), now, OK, MakeResult(0));
+  cache.Put(key2, cache.generation(), now, OK, MakeResult(0));
+  // Make |key1| the most recently used.
+  EXPECT_TRUE(cache.Get(key1, now, &error, &result));
+  cache.Put(key3, cache.generation(), now, OK, MakeResult(0));
+
+  EXPECT_EQ(2u, cache.size());
+  EXPECT_TRUE(cache.Get(key1, now, &error, &result));
+  EXPECT_FALSE(cache.Get(key2, now, &error, &result));
+  EXPECT_TRUE(cache.Get(key3, now, &error, &result));
+}
+
+}  // namespace
+
+}  // namespace net
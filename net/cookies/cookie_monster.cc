@@ -563,6 +563,10 @@ void CookieMonster::DumpMemoryStats(
                   total_pending_for_key);
 }
 
+CookieMonster::SortedCookies::SortedCookies() = default;
+
+CookieMonster::SortedCookies::~SortedCookies() = default;
+
 CookieMonster::~CookieMonster() {
   DCHECK(thread_checker_.CalledOnValidThread());
 
@@ -616,8 +620,7 @@ void CookieMonster::GetCookieListWithOptions(const GURL& url,
   CookieStatusList excluded_cookies;
   if (HasCookieableScheme(url)) {
     std::vector<CanonicalCookie*> cookie_ptrs;
-    FindCookiesForRegistryControlledHost(url, &cookie_ptrs);
-    std::sort(cookie_ptrs.begin(), cookie_ptrs.end(), CookieSorter);
+    FindSortedCookiesForRegistryControlledHost(url, &cookie_ptrs);
 
     cookies.reserve(cookie_ptrs.size());
     std::vector<CanonicalCookie*> included_cookie_ptrs;
@@ -1008,6 +1011,36 @@ void CookieMonster::FindCookiesForRegistryControlledHost(
   }
 }
 
+void CookieMonster::FindSortedCookiesForRegistryControlledHost(
+    const GURL& url,
+    std::vector<CanonicalCookie*>* cookies) {
+  DCHECK(thread_checker_.CalledOnValidThread());
+
+  const std::string key(GetKey(url.host_piece()));
+  auto it = sorted_cookies_.find(key);
+  if (it != sorted_cookies_.end() &&
+      Time::Now() < it->second.earliest_expiry_date) {
+    *cookies = it->second.cookies;
+    return;
+  }
+
+  // This deletes the expired cookies, which drops the stale snapshot.
+  FindCookiesForRegistryControlledHost(url, cookies);
+  if (cookies->empty())
+    return;
+  std::sort(cookies->begin(), cookies->end(), CookieSorter);
+
+  SortedCookies& sorted_cookies = sorted_cookies_[key];
+  sorted_cookies.cookies = *cookies;
+  sorted_cookies.earliest_expiry_date = Time::Max();
+  for (const CanonicalCookie* cookie : *cookies) {
+    if (cookie->IsPersistent()) {
+      sorted_cookies.earliest_expiry_date =
+          std::min(sorted_cookies.earliest_expiry_date, cookie->ExpiryDate());
+    }
+  }
+}
+
 void CookieMonster::FilterCookiesWithOptions(
     const GURL url,
     const CookieOptions options,
@@ -1164,6 +1197,7 @@ CookieMonster::CookieMap::iterator CookieMonster::InternalInsertCookie(
     store_->AddCookie(*cc_ptr);
   }
   auto inserted = cookies_.insert(CookieMap::value_type(key, std::move(cc)));
+  sorted_cookies_.erase(key);
 
   // See InitializeHistograms() for details.
   int32_t type_sample = cc_ptr->SameSite() != CookieSameSite::NO_RESTRICTION
@@ -1361,6 +1395,7 @@ void CookieMonster::InternalDeleteCookie(CookieMap::iterator it,
     store_->DeleteCookie(*cc);
   }
   change_dispatcher_.DispatchChange(*cc, mapping.cause, mapping.notify);
+  sorted_cookies_.erase(it->first);
   cookies_.erase(it);
 }
 
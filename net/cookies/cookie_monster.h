@@ -432,6 +432,14 @@ class NET_EXPORT CookieMonster : public CookieStore {
       const GURL& url,
       std::vector<CanonicalCookie*>* cookies);
 
+  // Like FindCookiesForRegistryControlledHost(), but sorts |cookies| by
+  // CookieSorter(). The result is kept in |sorted_cookies_|, so that repeated
+  // lookups for an eTLD+1 don't need to find and sort its cookies again until
+  // one of them is inserted, deleted or expires.
+  void FindSortedCookiesForRegistryControlledHost(
+      const GURL& url,
+      std::vector<CanonicalCookie*>* cookies);
+
   void FilterCookiesWithOptions(
       const GURL url,
       const CookieOptions options,
@@ -569,6 +577,23 @@ class NET_EXPORT CookieMonster : public CookieStore {
 
   CookieMap cookies_;
 
+  // A snapshot of the cookies stored under a CookieMap key, sorted by
+  // CookieSorter().
+  struct SortedCookies {
+    SortedCookies();
+    ~SortedCookies();
+
+    std::vector<CanonicalCookie*> cookies;
+    // The earliest expiry date of |cookies|, after which the snapshot must be
+    // rebuilt to skip the expired ones.
+    base::Time earliest_expiry_date;
+  };
+
+  // Snapshots of the cookies under each CookieMap key that has been looked up,
+  // see FindSortedCookiesForRegistryControlledHost(). A key's snapshot is
+  // dropped whenever a cookie is inserted under it or deleted from it.
+  std::map<std::string, SortedCookies> sorted_cookies_;
+
   CookieMonsterChangeDispatcher change_dispatcher_;
 
   // Indicates whether the cookie store has been initialized.
@@ -298,6 +298,40 @@ TEST_F(CookieMonsterTest, TestDomainLine) {
   timer2.Done();
 }
 
+// Queries one host with many cookies of different paths, while cookies are
+// set on other hosts, which must not make the sorted cookies of the queried
+// eTLD+1 be rebuilt.
+TEST_F(CookieMonsterTest, TestQueryWithWritesToOtherHosts) {
+  auto cm = std::make_unique<CookieMonster>(nullptr, nullptr);
+  SetCookieCallback setCookieCallback;
+  GetCookieListCallback getCookieListCallback;
+  GURL probe_gurl("https://www.top.com/a/b/c/d/");
+
+  const char path_cookie_format[] = "a%03d=b; path=%s";
+  const char* const kPaths[] = {"/", "/a", "/a/b", "/a/b/c", "/a/b/c/d"};
+  for (int i = 0; i < 30; i++) {
+    for (const char* path : kPaths) {
+      setCookieCallback.SetCookie(
+          cm.get(), probe_gurl,
+          base::StringPrintf(path_cookie_format, i, path));
+    }
+  }
+  EXPECT_EQ(150u,
+            getCookieListCallback.GetCookieList(cm.get(), probe_gurl).size());
+
+  std::vector<GURL> other_gurls;
+  for (int i = 0; i < kNumCookies / 10; ++i)
+    other_gurls.push_back(GURL(base::StringPrintf("https://a%04d.izzle", i)));
+
+  base::PerfTimeLogger timer("Cookie_monster_query_with_other_writes");
+  for (int i = 0; i < kNumCookies; i++) {
+    if (i % 10 == 0)
+      setCookieCallback.SetCookie(cm.get(), other_gurls[i / 10], kCookieLine);
+    getCookieListCallback.GetCookieList(cm.get(), probe_gurl);
+  }
+  timer.Done();
+}
+
 TEST_F(CookieMonsterTest, TestImport) {
   scoped_refptr<MockPersistentCookieStore> store(new MockPersistentCookieStore);
   std::vector<std::unique_ptr<CanonicalCookie>> initial_cookies;
@@ -1721,6 +1721,37 @@ TEST_F(CookieMonsterTest, CookieSorting) {
   EXPECT_EQ("A1", cookies[5].Value());
 }
 
+// Check that the sorted cookies kept for repeated lookups of a host follow
+// the insertions and deletions of its cookies.
+TEST_F(CookieMonsterTest, CookieSortingForURLAfterChanges) {
+  std::unique_ptr<CookieMonster> cm(new CookieMonster(nullptr, &net_log_));
+  GURL url("http://www.foo.com/foo/bar");
+
+  EXPECT_TRUE(SetCookie(cm.get(), url, "A=A1; path=/"));
+  EXPECT_TRUE(SetCookie(cm.get(), url, "B=B1; path=/foo"));
+  EXPECT_EQ("B=B1; A=A1", GetCookies(cm.get(), url));
+  EXPECT_EQ("B=B1; A=A1", GetCookies(cm.get(), url));
+
+  // An insertion for the same eTLD+1 is seen by the next lookup.
+  EXPECT_TRUE(SetCookie(cm.get(), url, "C=C1; path=/foo/bar"));
+  EXPECT_EQ("C=C1; B=B1; A=A1", GetCookies(cm.get(), url));
+
+  // Changes to other eTLD+1s don't affect it.
+  EXPECT_TRUE(SetCookie(cm.get(), http_bar_com_.url(), "D=D1; path=/"));
+  EXPECT_EQ("C=C1; B=B1; A=A1", GetCookies(cm.get(), url));
+
+  // Neither do lookups for other hosts with the same eTLD+1.
+  EXPECT_EQ("A=A1", GetCookies(cm.get(), GURL("http://foo.com/")));
+
+  // Deletions are seen too.
+  EXPECT_TRUE(SetCookie(cm.get(), url,
+                        "B=B1; path=/foo; "
+                        "expires=Thu, 01-Jan-1970 00:00:00 GMT"));
+  EXPECT_EQ("C=C1; A=A1", GetCookies(cm.get(), url));
+  EXPECT_EQ(3u, DeleteAll(cm.get()));
+  EXPECT_EQ("", GetCookies(cm.get(), url));
+}
+
 TEST_F(CookieMonsterTest, InheritCreationDate) {
   std::unique_ptr<CookieMonster> cm(new CookieMonster(nullptr, &net_log_));
 
@@ -26,10 +26,17 @@
 // size so that we have a chance to see an element again and move it to another
 // list.
 
+// With kBlockfileTinyLfuAdmission, the DELETED list is backed by a TinyLFU
+// frequency sketch of the recent uses of every key, including the keys whose
+// entries are long gone. A new entry for a key used at least
+// kTinyLfuAdmissionFrequency times recently starts on the LOW_USE list, so
+// that it outlives the one-time entries of the NO_USE list.
+
 #include "net/disk_cache/blockfile/eviction.h"
 
 #include <stdint.h>
 
+#include <algorithm>
 #include <limits>
 
 #include "base/bind.h"
@@ -48,6 +55,7 @@
 #include "net/disk_cache/blockfile/histogram_macros.h"
 #include "net/disk_cache/blockfile/trace.h"
 #include "net/disk_cache/blockfile/webfonts_histogram.h"
+#include "net/disk_cache/tiny_lfu_sketch.h"
 
 // Provide a BackendImpl object to macros from histogram_macros.h.
 #define CACHE_UMA_BACKEND_IMPL_OBJ backend_
@@ -62,6 +70,10 @@ const int kHighUse = 10;  // Reuse count to be on the HIGH_USE list.
 const int kTargetTime = 24 * 7;  // Time to be evicted (hours since last use).
 const int kMaxDelayedTrims = 60;
 
+// See kBlockfileTinyLfuAdmission.
+const int kTinyLfuAdmissionFrequency = 2;
+const int kMinTinyLfuExpectedKeys = 1 << 14;
+
 int LowWaterAdjust(int high_water) {
   if (high_water < kCleanUpMargin)
     return 0;
@@ -77,6 +89,9 @@ bool FallingBehind(int current_size, int max_size) {
 
 namespace disk_cache {
 
+const base::Feature kBlockfileTinyLfuAdmission = {
+    "BlockfileTinyLfuAdmission", base::FEATURE_DISABLED_BY_DEFAULT};
+
 // The real initialization happens during Init(), init_ is the only member that
 // has to be initialized here.
 Eviction::Eviction() : backend_(nullptr), init_(false), ptr_factory_(this) {}
@@ -98,6 +113,11 @@ void Eviction::Init(BackendImpl* backend) {
   trim_delays_ = 0;
   init_ = true;
   test_mode_ = false;
+  if (new_eviction_ &&
+      base::FeatureList::IsEnabled(kBlockfileTinyLfuAdmission)) {
+    admission_sketch_ = std::make_unique<TinyLfuSketch>(
+        std::max(header_->num_entries, kMinTinyLfuExpectedKeys));
+  }
 }
 
 void Eviction::Stop() {
@@ -403,6 +423,8 @@ void Eviction::UpdateRankV2(EntryImpl* entry, bool modified) {
 void Eviction::OnOpenEntryV2(EntryImpl* entry) {
   EntryStore* info = entry->entry()->Data();
   DCHECK_EQ(ENTRY_NORMAL, info->state);
+  if (admission_sketch_)
+    admission_sketch_->RecordUse(entry->GetHash());
 
   if (info->reuse_count < std::numeric_limits<int32_t>::max()) {
     info->reuse_count++;
@@ -427,6 +449,14 @@ void Eviction::OnCreateEntryV2(EntryImpl* entry) {
     case ENTRY_NORMAL: {
       DCHECK(!info->reuse_count);
       DCHECK(!info->refetch_count);
+      if (admission_sketch_) {
+        admission_sketch_->RecordUse(entry->GetHash());
+        if (admission_sketch_->EstimateFrequency(entry->GetHash()) >=
+            kTinyLfuAdmissionFrequency) {
+          info->reuse_count = 1;
+          entry->entry()->Store();
+        }
+      }
       break;
     };
     case ENTRY_EVICTED: {
@@ -5,16 +5,26 @@
 #ifndef NET_DISK_CACHE_BLOCKFILE_EVICTION_H_
 #define NET_DISK_CACHE_BLOCKFILE_EVICTION_H_
 
+#include <memory>
+
+#include "base/feature_list.h"
 #include "base/macros.h"
 #include "base/memory/weak_ptr.h"
+#include "net/base/net_export.h"
 #include "net/disk_cache/blockfile/rankings.h"
 
 namespace disk_cache {
 
 class BackendImpl;
 class EntryImpl;
+class TinyLfuSketch;
 struct IndexHeader;
 
+// With the new eviction algorithm, starts the entries created for keys which
+// were used recently, as estimated by a TinyLfuSketch, in the LOW_USE list
+// rather than the NO_USE one.
+NET_EXPORT_PRIVATE extern const base::Feature kBlockfileTinyLfuAdmission;
+
 // This class implements the eviction algorithm for the cache and it is tightly
 // integrated with BackendImpl.
 class Eviction {
@@ -81,6 +91,8 @@ class Eviction {
   bool delay_trim_;
   bool init_;
   bool test_mode_;
+  // Only with kBlockfileTinyLfuAdmission. Not persisted.
+  std::unique_ptr<TinyLfuSketch> admission_sketch_;
   base::WeakPtrFactory<Eviction> ptr_factory_;
 
   DISALLOW_COPY_AND_ASSIGN(Eviction);
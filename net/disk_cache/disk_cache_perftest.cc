@@ -625,4 +625,59 @@ TEST(SimpleIndexPerfTest, EvictionPerformance) {
              << "ms";
 }
 
+// Measures how quickly a SimpleIndex of a million entries, the most the index
+// file supports, is filled and queried.
+TEST(SimpleIndexPerfTest, LookupPerformance1M) {
+  const int kEntries = 1000000;
+
+  class NoOpDelegate : public disk_cache::SimpleIndexDelegate {
+    void DoomEntries(std::vector<uint64_t>* entry_hashes,
+                     net::CompletionOnceCallback callback) override {}
+  };
+
+  NoOpDelegate delegate;
+  disk_cache::SimpleIndex index(/* io_thread = */ nullptr,
+                                /* cleanup_tracker = */ nullptr, &delegate,
+                                net::DISK_CACHE,
+                                /* simple_index_file = */ nullptr);
+  // Make sure large enough to not evict on insertion.
+  index.SetMaxSize(std::numeric_limits<uint64_t>::max());
+
+  std::vector<uint64_t> hashes(kEntries);
+  for (uint64_t& hash : hashes)
+    hash = base::RandUint64();
+  base::Time start(base::Time::Now());
+
+  base::ElapsedTimer insert_timer;
+  for (uint64_t hash : hashes)
+    index.InsertEntryForTesting(hash, disk_cache::EntryMetadata(start, 1u));
+  const base::TimeDelta insert_elapsed = insert_timer.Elapsed();
+
+  // Hits, in a different order than the insertions.
+  base::ElapsedTimer hit_timer;
+  int found = 0;
+  for (int i = kEntries - 1; i >= 0; --i)
+    found += !index.GetLastUsedTime(hashes[i]).is_null();
+  const base::TimeDelta hit_elapsed = hit_timer.Elapsed();
+  EXPECT_EQ(kEntries, found);
+
+  // Misses, the most frequent case when fetching new resources.
+  base::ElapsedTimer miss_timer;
+  for (uint64_t hash : hashes)
+    found -= !index.GetLastUsedTime(~hash).is_null();
+  const base::TimeDelta miss_elapsed = miss_timer.Elapsed();
+
+  LOG(ERROR) << "Insertions: " << insert_elapsed.InMicroseconds() * 1000 /
+                                      kEntries
+             << " ns per entry";
+  LOG(ERROR) << "Lookup hits: " << hit_elapsed.InMicroseconds() * 1000 /
+                                       kEntries
+             << " ns per lookup";
+  LOG(ERROR) << "Lookup misses: " << miss_elapsed.InMicroseconds() * 1000 /
+                                         kEntries
+             << " ns per lookup";
+  LOG(ERROR) << "Memory: " << index.EstimateMemoryUsage() / kEntries
+             << " bytes per entry";
+}
+
 }  // namespace
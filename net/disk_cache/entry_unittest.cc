@@ -2832,6 +2832,47 @@ TEST_F(DiskCacheEntryTest, SimpleCacheBadChecksum) {
       disk_cache::READ_RESULT_SYNC_CHECKSUM_FAILURE, 1);
 }
 
+// Tests that stream 0 can be read back whichever kind of CRC it was written
+// with.
+TEST_F(DiskCacheEntryTest, SimpleCacheStream0Crc32c) {
+  SetSimpleCacheMode();
+  InitCache();
+
+  const char key[] = "the first key";
+  const int kSize = 200;
+  scoped_refptr<net::IOBuffer> buffer =
+      base::MakeRefCounted<net::IOBuffer>(kSize);
+  CacheTestFillBuffer(buffer->data(), kSize, false);
+  scoped_refptr<net::IOBuffer> read_buffer =
+      base::MakeRefCounted<net::IOBuffer>(kSize);
+
+  disk_cache::Entry* entry = nullptr;
+  {
+    base::test::ScopedFeatureList scoped_feature_list;
+    scoped_feature_list.InitAndEnableFeature(
+        disk_cache::kSimpleCacheStream0Crc32c);
+    ASSERT_THAT(CreateEntry(key, &entry), IsOk());
+    EXPECT_EQ(kSize, WriteData(entry, 0, 0, buffer.get(), kSize, false));
+    entry->Close();
+    FlushQueueForTest();
+  }
+
+  // The CRC-32C is checked when the entry is opened.
+  ASSERT_THAT(OpenEntry(key, &entry), IsOk());
+  EXPECT_EQ(kSize, ReadData(entry, 0, 0, read_buffer.get(), kSize));
+  EXPECT_EQ(0, memcmp(buffer->data(), read_buffer->data(), kSize));
+
+  // Rewriting the entry with the feature disabled goes back to a CRC-32.
+  EXPECT_EQ(kSize, WriteData(entry, 0, 0, buffer.get(), kSize, false));
+  entry->Close();
+  FlushQueueForTest();
+
+  ASSERT_THAT(OpenEntry(key, &entry), IsOk());
+  EXPECT_EQ(kSize, ReadData(entry, 0, 0, read_buffer.get(), kSize));
+  EXPECT_EQ(0, memcmp(buffer->data(), read_buffer->data(), kSize));
+  entry->Close();
+}
+
 // Tests that an entry that has had an IO error occur can still be Doomed().
 TEST_F(DiskCacheEntryTest, SimpleCacheErrorThenDoom) {
   base::HistogramTester histogram_tester;
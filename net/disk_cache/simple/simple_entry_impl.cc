@@ -58,7 +58,7 @@ enum SimpleEntryWriteResult {
 
 OpenEntryIndexEnum ComputeIndexState(SimpleBackendImpl* backend,
                                      uint64_t entry_hash) {
-  if (!backend->index()->initialized())
+  if (!backend->index()->CanAnswerLookups())
     return INDEX_NOEXIST;
   if (backend->index()->Has(entry_hash))
     return INDEX_HIT;
@@ -222,6 +222,8 @@ net::Error SimpleEntryImpl::OpenEntry(Entry** out_entry,
   OpenEntryIndexEnum index_state =
       ComputeIndexState(backend_.get(), entry_hash_);
   RecordOpenEntryIndexState(cache_type_, index_state);
+  if (index_state != INDEX_NOEXIST)
+    backend_->index()->RecordOpenLookup(index_state == INDEX_HIT);
 
   // If entry is not known to the index, initiate fast failover to the network.
   if (index_state == INDEX_MISS) {
@@ -0,0 +1,163 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "net/disk_cache/simple/simple_eviction_policy.h"
+
+#include <algorithm>
+#include <limits>
+#include <tuple>
+#include <utility>
+
+#include "base/time/time.h"
+
+namespace disk_cache {
+
+namespace {
+
+// This is added to the size of each entry before using the size
+// to determine which entries to evict first. It's basically an
+// estimate of the filesystem overhead, but it also serves to flatten
+// the curve so that 1-byte entries and 2-byte entries are basically
+// treated the same.
+const int kEstimatedEntryOverhead = 512;
+
+// The number of entries the sketch of SimpleTinyLfuEvictionPolicy is sized
+// for when created by SimpleEvictionPolicy::Create(). A larger cache makes
+// the frequency estimates coarser.
+const size_t kDefaultTinyLfuExpectedEntries = 1 << 15;
+
+uint32_t NowForSorting() {
+  return (base::Time::Now() - base::Time::UnixEpoch()).InSeconds();
+}
+
+}  // namespace
+
+const base::Feature kSimpleCacheTinyLfuEviction = {
+    "SimpleCacheTinyLfuEviction", base::FEATURE_DISABLED_BY_DEFAULT};
+
+// static
+std::unique_ptr<SimpleEvictionPolicy> SimpleEvictionPolicy::Create() {
+  if (base::FeatureList::IsEnabled(kSimpleCacheTinyLfuEviction)) {
+    return std::make_unique<SimpleTinyLfuEvictionPolicy>(
+        kDefaultTinyLfuExpectedEntries);
+  }
+  return std::make_unique<SimpleLruEvictionPolicy>();
+}
+
+size_t SimpleEvictionPolicy::EstimateMemoryUsage() const {
+  return 0;
+}
+
+SimpleLruEvictionPolicy::SimpleLruEvictionPolicy() = default;
+
+SimpleLruEvictionPolicy::~SimpleLruEvictionPolicy() = default;
+
+uint64_t SimpleLruEvictionPolicy::SelectEntriesToEvict(
+    const SimpleIndex::EntrySet& entries,
+    uint64_t amount_to_evict,
+    std::vector<uint64_t>* entry_hashes) {
+  // Flatten for sorting.
+  std::vector<std::pair<uint64_t, const SimpleIndex::EntrySet::value_type*>>
+      sorted_entries;
+  sorted_entries.reserve(entries.size());
+  const uint32_t now = NowForSorting();
+  bool use_size = base::FeatureList::IsEnabled(kSimpleCacheEvictionWithSize);
+  for (const auto& entry : entries) {
+    uint64_t sort_value = now - entry.second.RawTimeForSorting();
+    if (use_size) {
+      // Will not overflow since we're multiplying two 32-bit values and storing
+      // them in a 64-bit variable.
+      sort_value *= entry.second.GetEntrySize() + kEstimatedEntryOverhead;
+    }
+    // Subtract so we don't need a custom comparator.
+    sorted_entries.emplace_back(
+        std::numeric_limits<uint64_t>::max() - sort_value, &entry);
+  }
+
+  uint64_t evicted_so_far_size = 0;
+  std::sort(sorted_entries.begin(), sorted_entries.end());
+  for (const auto& score_metadata_pair : sorted_entries) {
+    if (evicted_so_far_size >= amount_to_evict)
+      break;
+    evicted_so_far_size += score_metadata_pair.second->second.GetEntrySize();
+    entry_hashes->push_back(score_metadata_pair.second->first);
+  }
+  return evicted_so_far_size;
+}
+
+SimpleTinyLfuEvictionPolicy::SimpleTinyLfuEvictionPolicy(
+    size_t expected_entries)
+    : sketch_(expected_entries) {}
+
+SimpleTinyLfuEvictionPolicy::~SimpleTinyLfuEvictionPolicy() = default;
+
+void SimpleTinyLfuEvictionPolicy::OnEntryUsed(uint64_t entry_hash) {
+  sketch_.RecordUse(entry_hash);
+}
+
+uint64_t SimpleTinyLfuEvictionPolicy::SelectEntriesToEvict(
+    const SimpleIndex::EntrySet& entries,
+    uint64_t amount_to_evict,
+    std::vector<uint64_t>* entry_hashes) {
+  struct Candidate {
+    uint32_t age;
+    int frequency;
+    uint32_t size;
+    uint64_t hash;
+  };
+  std::vector<Candidate> candidates;
+  candidates.reserve(entries.size());
+  const uint32_t now = NowForSorting();
+  uint64_t total_size = 0;
+  for (const auto& entry : entries) {
+    candidates.push_back({now - entry.second.RawTimeForSorting(), 0,
+                          entry.second.GetEntrySize(), entry.first});
+    total_size += entry.second.GetEntrySize();
+  }
+
+  // Most recently used first, to find the end of the window.
+  std::sort(
+      candidates.begin(), candidates.end(),
+      [](const Candidate& a, const Candidate& b) { return a.age < b.age; });
+  const uint64_t window_size = total_size * kWindowPercent / 100;
+  uint64_t size_so_far = 0;
+  auto main_begin = candidates.begin();
+  while (main_begin != candidates.end() && size_so_far < window_size) {
+    size_so_far += main_begin->size;
+    ++main_begin;
+  }
+
+  // The main region is evicted by increasing frequency, then from the least
+  // recently used.
+  for (auto it = main_begin; it != candidates.end(); ++it)
+    it->frequency = sketch_.EstimateFrequency(it->hash);
+  std::sort(main_begin, candidates.end(),
+            [](const Candidate& a, const Candidate& b) {
+              return std::tie(a.frequency, b.age) <
+                     std::tie(b.frequency, a.age);
+            });
+
+  uint64_t evicted_so_far_size = 0;
+  auto select = [&](std::vector<Candidate>::const_iterator it) {
+    evicted_so_far_size += it->size;
+    entry_hashes->push_back(it->hash);
+  };
+  for (auto it = main_begin;
+       it != candidates.end() && evicted_so_far_size < amount_to_evict; ++it) {
+    select(it);
+  }
+  // The window goes last, from the least recently used.
+  for (auto it = main_begin;
+       it != candidates.begin() && evicted_so_far_size < amount_to_evict;) {
+    --it;
+    select(it);
+  }
+  return evicted_so_far_size;
+}
+
+size_t SimpleTinyLfuEvictionPolicy::EstimateMemoryUsage() const {
+  return sketch_.EstimateMemoryUsage();
+}
+
+}  // namespace disk_cache
@@ -0,0 +1,96 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef NET_DISK_CACHE_SIMPLE_SIMPLE_EVICTION_POLICY_H_
+#define NET_DISK_CACHE_SIMPLE_SIMPLE_EVICTION_POLICY_H_
+
+#include <stdint.h>
+
+#include <memory>
+#include <vector>
+
+#include "base/feature_list.h"
+#include "base/macros.h"
+#include "net/base/net_export.h"
+#include "net/disk_cache/simple/simple_index.h"
+#include "net/disk_cache/tiny_lfu_sketch.h"
+
+namespace disk_cache {
+
+// Selects SimpleTinyLfuEvictionPolicy instead of SimpleLruEvictionPolicy.
+NET_EXPORT_PRIVATE extern const base::Feature kSimpleCacheTinyLfuEviction;
+
+// Chooses the entries the SimpleIndex evicts once the cache grows over its
+// high watermark. Runs on the IO thread.
+class NET_EXPORT_PRIVATE SimpleEvictionPolicy {
+ public:
+  virtual ~SimpleEvictionPolicy() = default;
+
+  // Returns the policy selected by the features.
+  static std::unique_ptr<SimpleEvictionPolicy> Create();
+
+  // Called when the entry of |entry_hash| is created or opened.
+  virtual void OnEntryUsed(uint64_t entry_hash) {}
+
+  // Appends to |entry_hashes| the entries of |entries| to evict in order to
+  // free at least |amount_to_evict| bytes, or all of them. Returns the sum of
+  // their sizes.
+  virtual uint64_t SelectEntriesToEvict(
+      const SimpleIndex::EntrySet& entries,
+      uint64_t amount_to_evict,
+      std::vector<uint64_t>* entry_hashes) = 0;
+
+  virtual size_t EstimateMemoryUsage() const;
+};
+
+// Evicts the least recently used entries first. With
+// kSimpleCacheEvictionWithSize, the time since the last use is weighted by the
+// size of the entry, so that large entries go earlier.
+class NET_EXPORT_PRIVATE SimpleLruEvictionPolicy : public SimpleEvictionPolicy {
+ public:
+  SimpleLruEvictionPolicy();
+  ~SimpleLruEvictionPolicy() override;
+
+  // SimpleEvictionPolicy:
+  uint64_t SelectEntriesToEvict(const SimpleIndex::EntrySet& entries,
+                                uint64_t amount_to_evict,
+                                std::vector<uint64_t>* entry_hashes) override;
+
+ private:
+  DISALLOW_COPY_AND_ASSIGN(SimpleLruEvictionPolicy);
+};
+
+// An adaptation of W-TinyLFU to the batched eviction of the index. The most
+// recently used entries, up to kWindowPercent of the cache size, form the
+// window and are only evicted last. The others are evicted by increasing
+// frequency of use, as estimated by a TinyLfuSketch, and then from the least
+// recently used. Since the sketch remembers uses across evictions, an entry
+// used once and leaving the window loses to any entry used repeatedly, which
+// is what the admission filter of W-TinyLFU decides. The sketch is not
+// persisted, uses before the last restart are forgotten.
+class NET_EXPORT_PRIVATE SimpleTinyLfuEvictionPolicy
+    : public SimpleEvictionPolicy {
+ public:
+  static const int kWindowPercent = 1;
+
+  // The sketch is sized for |expected_entries|.
+  explicit SimpleTinyLfuEvictionPolicy(size_t expected_entries);
+  ~SimpleTinyLfuEvictionPolicy() override;
+
+  // SimpleEvictionPolicy:
+  void OnEntryUsed(uint64_t entry_hash) override;
+  uint64_t SelectEntriesToEvict(const SimpleIndex::EntrySet& entries,
+                                uint64_t amount_to_evict,
+                                std::vector<uint64_t>* entry_hashes) override;
+  size_t EstimateMemoryUsage() const override;
+
+ private:
+  TinyLfuSketch sketch_;
+
+  DISALLOW_COPY_AND_ASSIGN(SimpleTinyLfuEvictionPolicy);
+};
+
+}  // namespace disk_cache
+
+#endif  // NET_DISK_CACHE_SIMPLE_SIMPLE_EVICTION_POLICY_H_
@@ -0,0 +1,69 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "net/disk_cache/simple/simple_eviction_policy.h"
+
+#include <vector>
+
+#include "base/test/scoped_feature_list.h"
+#include "base/time/time.h"
+#include "testing/gmock/include/gmock/gmock.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+using testing::ElementsAre;
+
+namespace disk_cache {
+namespace {
+
+void InsertEntry(uint64_t hash,
+                 base::TimeDelta age,
+                 uint32_t size,
+                 SimpleIndex::EntrySet* entries) {
+  SimpleIndex::InsertInEntrySet(
+      hash, EntryMetadata(base::Time::Now() - age, size), entries);
+}
+
+TEST(SimpleEvictionPolicyTest, LruEvictsLeastRecentlyUsedFirst) {
+  base::test::ScopedFeatureList features;
+  features.InitAndDisableFeature(kSimpleCacheEvictionWithSize);
+  SimpleIndex::EntrySet entries;
+  for (uint64_t hash = 1; hash <= 4; ++hash)
+    InsertEntry(hash, base::TimeDelta::FromDays(hash), 1024u, &entries);
+
+  SimpleLruEvictionPolicy policy;
+  std::vector<uint64_t> entry_hashes;
+  EXPECT_EQ(2048u, policy.SelectEntriesToEvict(entries, 1500, &entry_hashes));
+  EXPECT_THAT(entry_hashes, ElementsAre(4u, 3u));
+}
+
+// Entries used once are evicted before entries used repeatedly, whatever
+// their age, and the most recently used entries go last.
+TEST(SimpleEvictionPolicyTest, TinyLfuEvictsLeastFrequentlyUsedFirst) {
+  SimpleIndex::EntrySet entries;
+  InsertEntry(1, base::TimeDelta::FromDays(10), 1024u, &entries);
+  InsertEntry(2, base::TimeDelta::FromDays(5), 100352u, &entries);
+  InsertEntry(3, base::TimeDelta::FromDays(3), 1024u, &entries);
+  // The window holds 1% of the total size, that is this entry only.
+  InsertEntry(4, base::TimeDelta(), 5120u, &entries);
+
+  SimpleTinyLfuEvictionPolicy policy(100);
+  for (int i = 0; i < 5; ++i)
+    policy.OnEntryUsed(1);
+  policy.OnEntryUsed(2);
+  policy.OnEntryUsed(3);
+  policy.OnEntryUsed(3);
+  policy.OnEntryUsed(4);
+
+  std::vector<uint64_t> entry_hashes;
+  EXPECT_EQ(100352u, policy.SelectEntriesToEvict(entries, 1, &entry_hashes));
+  EXPECT_THAT(entry_hashes, ElementsAre(2u));
+
+  entry_hashes.clear();
+  EXPECT_EQ(107520u,
+            policy.SelectEntriesToEvict(entries, 107520u, &entry_hashes));
+  EXPECT_THAT(entry_hashes, ElementsAre(2u, 3u, 1u, 4u));
+}
+
+}  // namespace
+}  // namespace disk_cache
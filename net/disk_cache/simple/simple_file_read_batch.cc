@@ -0,0 +1,408 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "net/disk_cache/simple/simple_file_read_batch.h"
+
+#include "base/files/file.h"
+#include "base/logging.h"
+
+#if defined(OS_LINUX)
+#include <errno.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <memory>
+
+#include "base/atomicops.h"
+#include "base/no_destructor.h"
+#include "base/threading/thread_local_storage.h"
+#endif
+
+namespace disk_cache {
+
+const base::Feature kSimpleCacheIoUring = {"SimpleCacheIoUring",
+                                           base::FEATURE_DISABLED_BY_DEFAULT};
+
+#if defined(OS_LINUX)
+namespace {
+
+// The io_uring ABI, from linux/io_uring.h, which isn't available in all the
+// sysroots Chromium is built with.
+#if !defined(__NR_io_uring_setup) && !defined(ARCH_CPU_MIPS_FAMILY)
+#define __NR_io_uring_setup 425
+#define __NR_io_uring_enter 426
+#endif
+
+struct IoSqringOffsets {
+  uint32_t head;
+  uint32_t tail;
+  uint32_t ring_mask;
+  uint32_t ring_entries;
+  uint32_t flags;
+  uint32_t dropped;
+  uint32_t array;
+  uint32_t resv1;
+  uint64_t resv2;
+};
+
+struct IoCqringOffsets {
+  uint32_t head;
+  uint32_t tail;
+  uint32_t ring_mask;
+  uint32_t ring_entries;
+  uint32_t overflow;
+  uint32_t cqes;
+  uint64_t resv[2];
+};
+
+struct IoUringParams {
+  uint32_t sq_entries;
+  uint32_t cq_entries;
+  uint32_t flags;
+  uint32_t sq_thread_cpu;
+  uint32_t sq_thread_idle;
+  uint32_t resv[5];
+  IoSqringOffsets sq_off;
+  IoCqringOffsets cq_off;
+};
+
+struct IoUringSqe {
+  uint8_t opcode;
+  uint8_t flags;
+  uint16_t ioprio;
+  int32_t fd;
+  uint64_t off;
+  uint64_t addr;
+  uint32_t len;
+  uint32_t rw_flags;
+  uint64_t user_data;
+  uint64_t pad[3];
+};
+
+struct IoUringCqe {
+  uint64_t user_data;
+  int32_t res;
+  uint32_t flags;
+};
+
+static_assert(sizeof(IoUringParams) == 120, "Unexpected io_uring_params size");
+static_assert(sizeof(IoUringSqe) == 64, "Unexpected io_uring_sqe size");
+static_assert(sizeof(IoUringCqe) == 16, "Unexpected io_uring_cqe size");
+
+constexpr uint8_t kIoringOpReadv = 1;
+constexpr uint32_t kIoringEnterGetevents = 1;
+constexpr off_t kIoringOffSqRing = 0;
+constexpr off_t kIoringOffCqRing = 0x8000000;
+constexpr off_t kIoringOffSqes = 0x10000000;
+
+// Entries of a ring. The reads of an entry open fit in it, larger batches are
+// submitted in several rounds.
+constexpr unsigned kRingEntries = 8;
+
+// Set once io_uring_setup() failed, e.g. because the kernel is too old or the
+// system call is filtered, so that threads don't keep trying.
+std::atomic<bool> g_io_uring_unsupported{false};
+
+base::subtle::Atomic32* AtomicAt(void* ring, uint32_t offset) {
+  return reinterpret_cast<base::subtle::Atomic32*>(static_cast<char*>(ring) +
+                                                   offset);
+}
+
+// An io_uring owned by a thread, see GetIoUringForCurrentThread().
+class IoUring {
+ public:
+  static std::unique_ptr<IoUring> Create() {
+#if defined(__NR_io_uring_setup)
+    IoUringParams params;
+    memset(&params, 0, sizeof(params));
+    int fd = syscall(__NR_io_uring_setup, kRingEntries, &params);
+    if (fd < 0)
+      return nullptr;
+    std::unique_ptr<IoUring> ring(new IoUring(fd));
+    if (!ring->Map(params))
+      return nullptr;
+    return ring;
+#else
+    return nullptr;
+#endif
+  }
+
+  ~IoUring() {
+    if (sq_ring_ != MAP_FAILED)
+      munmap(sq_ring_, sq_ring_size_);
+    if (cq_ring_ != MAP_FAILED)
+      munmap(cq_ring_, cq_ring_size_);
+    if (sqes_ != MAP_FAILED)
+      munmap(sqes_, sqes_size_);
+    close(fd_);
+  }
+
+  unsigned entries() const { return sq_entries_; }
+
+  // Submits |count| reads, whose buffers are described by |iovecs|, and waits
+  // until they complete. Returns the number of reads which were submitted, or
+  // -1 if none could be. The result of the submitted reads is stored in
+  // |results|: the number of bytes read, or a negated errno.
+  int SubmitAndWait(const iovec* iovecs,
+                    const int* fds,
+                    const int64_t* offsets,
+                    size_t count,
+                    int* results) {
+#if defined(__NR_io_uring_enter)
+    DCHECK_LE(count, sq_entries_);
+    uint32_t tail = base::subtle::NoBarrier_Load(sq_tail_);
+    const uint32_t head = base::subtle::Acquire_Load(sq_head_);
+    DCHECK_EQ(head, tail);
+    for (size_t i = 0; i < count; ++i) {
+      uint32_t index = (tail + i) & sq_mask_;
+      IoUringSqe* sqe = &sqes_[index];
+      memset(sqe, 0, sizeof(*sqe));
+      sqe->opcode = kIoringOpReadv;
+      sqe->fd = fds[i];
+      sqe->off = offsets[i];
+      sqe->addr = reinterpret_cast<uintptr_t>(&iovecs[i]);
+      sqe->len = 1;
+      sqe->user_data = i;
+      sq_array_[index] = index;
+    }
+    base::subtle::Release_Store(sq_tail_, tail + count);
+
+    int submitted = -1;
+    while (true) {
+      int rv = syscall(__NR_io_uring_enter, fd_, count, count,
+                       kIoringEnterGetevents, nullptr, 0);
+      if (rv >= 0 || errno != EINTR) {
+        // The kernel consumes the submissions it accepted even if it fails
+        // to wait for their completion.
+        submitted = base::subtle::Acquire_Load(sq_head_) - head;
+        break;
+      }
+    }
+    if (static_cast<size_t>(submitted) < count) {
+      // Take back the reads which weren't submitted, the caller runs them.
+      base::subtle::Release_Store(sq_tail_, head + submitted);
+    }
+    if (submitted <= 0)
+      return -1;
+
+    int completed = 0;
+    while (completed < submitted) {
+      uint32_t cq_head = base::subtle::NoBarrier_Load(cq_head_);
+      uint32_t cq_tail = base::subtle::Acquire_Load(cq_tail_);
+      if (cq_head == cq_tail) {
+        int rv = syscall(__NR_io_uring_enter, fd_, 0, submitted - completed,
+                         kIoringEnterGetevents, nullptr, 0);
+        // The reads write to buffers of the caller, waiting for them is the
+        // only option.
+        PCHECK(rv >= 0 || errno == EINTR);
+        continue;
+      }
+      for (; cq_head != cq_tail; ++cq_head, ++completed) {
+        const IoUringCqe& cqe = cqes_[cq_head & cq_mask_];
+        DCHECK_LT(cqe.user_data, count);
+        results[cqe.user_data] = cqe.res;
+      }
+      base::subtle::Release_Store(cq_head_, cq_head);
+    }
+    return submitted;
+#else
+    return -1;
+#endif
+  }
+
+ private:
+  explicit IoUring(int fd) : fd_(fd) {}
+
+  bool Map(const IoUringParams& params) {
+    sq_entries_ = params.sq_entries;
+    sq_ring_size_ = params.sq_off.array + params.sq_entries * sizeof(uint32_t);
+    sq_ring_ = mmap(nullptr, sq_ring_size_, PROT_READ | PROT_WRITE,
+                    MAP_SHARED | MAP_POPULATE, fd_, kIoringOffSqRing);
+    cq_ring_size_ =
+        params.cq_off.cqes + params.cq_entries * sizeof(IoUringCqe);
+    cq_ring_ = mmap(nullptr, cq_ring_size_, PROT_READ | PROT_WRITE,
+                    MAP_SHARED | MAP_POPULATE, fd_, kIoringOffCqRing);
+    sqes_size_ = params.sq_entries * sizeof(IoUringSqe);
+    void* sqes = mmap(nullptr, sqes_size_, PROT_READ | PROT_WRITE,
+                      MAP_SHARED | MAP_POPULATE, fd_, kIoringOffSqes);
+    sqes_ = static_cast<IoUringSqe*>(sqes);
+    if (sq_ring_ == MAP_FAILED || cq_ring_ == MAP_FAILED || sqes == MAP_FAILED)
+      return false;
+
+    sq_head_ = AtomicAt(sq_ring_, params.sq_off.head);
+    sq_tail_ = AtomicAt(sq_ring_, params.sq_off.tail);
+    sq_mask_ = *reinterpret_cast<uint32_t*>(static_cast<char*>(sq_ring_) +
+                                            params.sq_off.ring_mask);
+    sq_array_ = reinterpret_cast<uint32_t*>(static_cast<char*>(sq_ring_) +
+                                            params.sq_off.array);
+    cq_head_ = AtomicAt(cq_ring_, params.cq_off.head);
+    cq_tail_ = AtomicAt(cq_ring_, params.cq_off.tail);
+    cq_mask_ = *reinterpret_cast<uint32_t*>(static_cast<char*>(cq_ring_) +
+                                            params.cq_off.ring_mask);
+    cqes_ = reinterpret_cast<IoUringCqe*>(static_cast<char*>(cq_ring_) +
+                                          params.cq_off.cqes);
+    return true;
+  }
+
+  const int fd_;
+  unsigned sq_entries_ = 0;
+
+  void* sq_ring_ = MAP_FAILED;
+  size_t sq_ring_size_ = 0;
+  void* cq_ring_ = MAP_FAILED;
+  size_t cq_ring_size_ = 0;
+  IoUringSqe* sqes_ = static_cast<IoUringSqe*>(MAP_FAILED);
+  size_t sqes_size_ = 0;
+
+  base::subtle::Atomic32* sq_head_ = nullptr;
+  base::subtle::Atomic32* sq_tail_ = nullptr;
+  uint32_t sq_mask_ = 0;
+  uint32_t* sq_array_ = nullptr;
+  base::subtle::Atomic32* cq_head_ = nullptr;
+  base::subtle::Atomic32* cq_tail_ = nullptr;
+  uint32_t cq_mask_ = 0;
+  IoUringCqe* cqes_ = nullptr;
+
+  DISALLOW_COPY_AND_ASSIGN(IoUring);
+};
+
+void DeleteIoUring(void* ring) {
+  delete static_cast<IoUring*>(ring);
+}
+
+// The simple cache runs its file operations on worker threads which don't
+// belong to a given entry, so each thread lazily creates its own ring.
+IoUring* GetIoUringForCurrentThread() {
+  if (!base::FeatureList::IsEnabled(kSimpleCacheIoUring) ||
+      g_io_uring_unsupported.load(std::memory_order_relaxed)) {
+    return nullptr;
+  }
+  static base::NoDestructor<base::ThreadLocalStorage::Slot> ring_slot(
+      &DeleteIoUring);
+  IoUring* ring = static_cast<IoUring*>(ring_slot->Get());
+  if (ring)
+    return ring;
+  std::unique_ptr<IoUring> new_ring = IoUring::Create();
+  if (!new_ring) {
+    g_io_uring_unsupported.store(true, std::memory_order_relaxed);
+    return nullptr;
+  }
+  ring = new_ring.release();
+  ring_slot->Set(ring);
+  return ring;
+}
+
+}  // namespace
+#endif  // defined(OS_LINUX)
+
+SimpleFileReadBatch::SimpleFileReadBatch() = default;
+
+SimpleFileReadBatch::~SimpleFileReadBatch() = default;
+
+size_t SimpleFileReadBatch::AddRead(base::File* file,
+                                    int64_t offset,
+                                    char* dest,
+                                    int size) {
+  DCHECK(file);
+  DCHECK_GE(offset, 0);
+  DCHECK_GE(size, 0);
+  reads_.push_back({file, offset, dest, size, -1, false});
+  return reads_.size() - 1;
+}
+
+void SimpleFileReadBatch::Run() {
+#if defined(OS_LINUX)
+  RunOnIoUring();
+#endif
+  RunSequentially();
+}
+
+int SimpleFileReadBatch::result(size_t index) const {
+  DCHECK_LT(index, reads_.size());
+  DCHECK(reads_[index].done);
+  return reads_[index].result;
+}
+
+// static
+bool SimpleFileReadBatch::IsIoUringAvailableForTesting() {
+#if defined(OS_LINUX)
+  return GetIoUringForCurrentThread() != nullptr;
+#else
+  return false;
+#endif
+}
+
+void SimpleFileReadBatch::RunSequentially() {
+  for (Read& read : reads_) {
+    if (read.done)
+      continue;
+    read.result = read.file->Read(read.offset, read.dest, read.size);
+    read.done = true;
+  }
+}
+
+#if defined(OS_LINUX)
+void SimpleFileReadBatch::RunOnIoUring() {
+  // Submitting a single read doesn't save a system call.
+  if (reads_.size() < 2)
+    return;
+  IoUring* ring = GetIoUringForCurrentThread();
+  if (!ring)
+    return;
+
+  iovec iovecs[kRingEntries];
+  int fds[kRingEntries];
+  int64_t offsets[kRingEntries];
+  int results[kRingEntries];
+  Read* round[kRingEntries];
+  size_t next = 0;
+  while (next < reads_.size()) {
+    size_t count = 0;
+    for (; next < reads_.size() && count < ring->entries() &&
+           count < kRingEntries;
+         ++next) {
+      Read& read = reads_[next];
+      if (read.done || read.size == 0)
+        continue;
+      iovecs[count].iov_base = read.dest;
+      iovecs[count].iov_len = read.size;
+      fds[count] = read.file->GetPlatformFile();
+      offsets[count] = read.offset;
+      round[count] = &read;
+      ++count;
+    }
+    if (!count)
+      break;
+
+    int submitted = ring->SubmitAndWait(iovecs, fds, offsets, count, results);
+    if (submitted < 0)
+      return;
+    for (int i = 0; i < submitted; ++i) {
+      Read* read = round[i];
+      if (results[i] < 0) {
+        read->result = -1;
+      } else if (results[i] == read->size) {
+        read->result = results[i];
+      } else {
+        // Short reads are finished with base::File::Read(), which stops at
+        // the end of the file.
+        int rest = read->file->Read(read->offset + results[i],
+                                    read->dest + results[i],
+                                    read->size - results[i]);
+        read->result = rest < 0 ? -1 : results[i] + rest;
+      }
+      read->done = true;
+    }
+    // The reads which weren't submitted are run by RunSequentially().
+    if (static_cast<size_t>(submitted) < count)
+      return;
+  }
+}
+#endif  // defined(OS_LINUX)
+
+}  // namespace disk_cache
@@ -0,0 +1,82 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef NET_DISK_CACHE_SIMPLE_SIMPLE_FILE_READ_BATCH_H_
+#define NET_DISK_CACHE_SIMPLE_SIMPLE_FILE_READ_BATCH_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <vector>
+
+#include "base/feature_list.h"
+#include "base/macros.h"
+#include "build/build_config.h"
+#include "net/base/net_export.h"
+
+namespace base {
+class File;
+}
+
+namespace disk_cache {
+
+// Submits the reads of a SimpleFileReadBatch to an io_uring on Linux.
+NET_EXPORT_PRIVATE extern const base::Feature kSimpleCacheIoUring;
+
+// A batch of independent positional reads from the files of an entry, e.g. the
+// trailers of its files when it is opened.
+//
+// If kSimpleCacheIoUring is enabled and the kernel supports it, all the reads
+// are submitted to a per-thread io_uring and waited for with a single system
+// call. Otherwise, or if the submission fails, they are run one after the
+// other with base::File::Read(), as before.
+class NET_EXPORT_PRIVATE SimpleFileReadBatch {
+ public:
+  SimpleFileReadBatch();
+  ~SimpleFileReadBatch();
+
+  // Adds a read of |size| bytes at |offset| of |file| into |dest|, which must
+  // stay valid until Run() returns. Returns the index of the read, to be
+  // passed to result().
+  size_t AddRead(base::File* file, int64_t offset, char* dest, int size);
+
+  // Runs the reads which didn't run yet.
+  void Run();
+
+  // Returns the result of the read at |index| after Run(): as for
+  // base::File::Read(), the number of bytes read, or -1 on error.
+  int result(size_t index) const;
+
+  size_t size() const { return reads_.size(); }
+
+  // Whether reads go through an io_uring on the current thread, for tests.
+  static bool IsIoUringAvailableForTesting();
+
+ private:
+  struct Read {
+    base::File* file;
+    int64_t offset;
+    char* dest;
+    int size;
+    int result;
+    bool done;
+  };
+
+  // Runs the reads which aren't |done| yet with base::File::Read().
+  void RunSequentially();
+
+#if defined(OS_LINUX)
+  // Runs as many reads as possible through the io_uring of the current
+  // thread. Reads which couldn't be submitted aren't |done|.
+  void RunOnIoUring();
+#endif
+
+  std::vector<Read> reads_;
+
+  DISALLOW_COPY_AND_ASSIGN(SimpleFileReadBatch);
+};
+
+}  // namespace disk_cache
+
+#endif  // NET_DISK_CACHE_SIMPLE_SIMPLE_FILE_READ_BATCH_H_
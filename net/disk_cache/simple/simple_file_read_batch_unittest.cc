@@ -0,0 +1,96 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "net/disk_cache/simple/simple_file_read_batch.h"
+
+#include <string>
+#include <vector>
+
+#include "base/files/file.h"
+#include "base/files/file_path.h"
+#include "base/files/file_util.h"
+#include "base/files/scoped_temp_dir.h"
+#include "base/test/scoped_feature_list.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace disk_cache {
+namespace {
+
+constexpr int kFileSize = 10000;
+
+// The parameter tells whether kSimpleCacheIoUring is enabled. The reads run
+// sequentially if the kernel doesn't support io_uring, the results must be
+// the same either way.
+class SimpleFileReadBatchTest : public testing::TestWithParam<bool> {
+ protected:
+  void SetUp() override {
+    if (GetParam())
+      scoped_feature_list_.InitAndEnableFeature(kSimpleCacheIoUring);
+    else
+      scoped_feature_list_.InitAndDisableFeature(kSimpleCacheIoUring);
+
+    for (int i = 0; i < kFileSize; ++i)
+      contents_.push_back(static_cast<char>(i * 7));
+    ASSERT_TRUE(temp_dir_.CreateUniqueTempDir());
+    base::FilePath path = temp_dir_.GetPath().AppendASCII("file");
+    ASSERT_EQ(kFileSize,
+              base::WriteFile(path, contents_.data(), contents_.size()));
+    file_.Initialize(path, base::File::FLAG_OPEN | base::File::FLAG_READ);
+    ASSERT_TRUE(file_.IsValid());
+  }
+
+  std::string contents_;
+  base::File file_;
+
+ private:
+  base::test::ScopedFeatureList scoped_feature_list_;
+  base::ScopedTempDir temp_dir_;
+};
+
+TEST_P(SimpleFileReadBatchTest, Reads) {
+  char header[16];
+  char trailer[100];
+  char straddling[50];
+  char past_end[10];
+  SimpleFileReadBatch batch;
+  size_t header_read = batch.AddRead(&file_, 0, header, sizeof(header));
+  size_t trailer_read = batch.AddRead(&file_, kFileSize - sizeof(trailer),
+                                      trailer, sizeof(trailer));
+  size_t straddling_read = batch.AddRead(&file_, kFileSize - 20, straddling,
+                                         sizeof(straddling));
+  size_t past_end_read =
+      batch.AddRead(&file_, kFileSize + 10, past_end, sizeof(past_end));
+  size_t empty_read = batch.AddRead(&file_, 0, nullptr, 0);
+  batch.Run();
+
+  EXPECT_EQ(static_cast<int>(sizeof(header)), batch.result(header_read));
+  EXPECT_EQ(contents_.substr(0, sizeof(header)),
+            std::string(header, sizeof(header)));
+  EXPECT_EQ(static_cast<int>(sizeof(trailer)), batch.result(trailer_read));
+  EXPECT_EQ(contents_.substr(kFileSize - sizeof(trailer)),
+            std::string(trailer, sizeof(trailer)));
+  EXPECT_EQ(20, batch.result(straddling_read));
+  EXPECT_EQ(contents_.substr(kFileSize - 20), std::string(straddling, 20));
+  EXPECT_EQ(0, batch.result(past_end_read));
+  EXPECT_EQ(0, batch.result(empty_read));
+}
+
+TEST_P(SimpleFileReadBatchTest, MoreReadsThanRingEntries) {
+  constexpr int kReadSize = 100;
+  std::vector<std::string> buffers(50, std::string(kReadSize, '\0'));
+  SimpleFileReadBatch batch;
+  for (size_t i = 0; i < buffers.size(); ++i)
+    batch.AddRead(&file_, i * kReadSize, &buffers[i][0], kReadSize);
+  batch.Run();
+
+  for (size_t i = 0; i < buffers.size(); ++i) {
+    EXPECT_EQ(kReadSize, batch.result(i));
+    EXPECT_EQ(contents_.substr(i * kReadSize, kReadSize), buffers[i]);
+  }
+}
+
+INSTANTIATE_TEST_SUITE_P(IoUring, SimpleFileReadBatchTest, testing::Bool());
+
+}  // namespace
+}  // namespace disk_cache
@@ -24,6 +24,7 @@
 #include "net/base/net_errors.h"
 #include "net/disk_cache/backend_cleanup_tracker.h"
 #include "net/disk_cache/simple/simple_entry_format.h"
+#include "net/disk_cache/simple/simple_eviction_policy.h"
 #include "net/disk_cache/simple/simple_histogram_macros.h"
 #include "net/disk_cache/simple/simple_index_delegate.h"
 #include "net/disk_cache/simple/simple_index_file.h"
@@ -46,14 +47,11 @@ const int kWriteToDiskOnBackgroundDelayMSecs = 100;
 // is left.
 const uint32_t kEvictionMarginDivisor = 20;
 
-const uint32_t kBytesInKb = 1024;
+// The index file is rewritten in full instead of appending to its journal once
+// the journal would hold changes to more than this fraction of the entries.
+const uint64_t kMaxJournaledEntriesDivisor = 8;
 
-// This is added to the size of each entry before using the size
-// to determine which entries to evict first. It's basically an
-// estimate of the filesystem overhead, but it also serves to flatten
-// the curve so that 1-byte entries and 2-byte entries are basically
-// treated the same.
-static const int kEstimatedEntryOverhead = 512;
+const uint32_t kBytesInKb = 1024;
 
 }  // namespace
 
@@ -62,6 +60,9 @@ namespace disk_cache {
 const base::Feature kSimpleCacheEvictionWithSize = {
     "SimpleCacheEvictionWithSize", base::FEATURE_ENABLED_BY_DEFAULT};
 
+const base::Feature kSimpleCacheIndexJournal = {
+    "SimpleCacheIndexJournal", base::FEATURE_DISABLED_BY_DEFAULT};
+
 EntryMetadata::EntryMetadata()
     : last_used_time_seconds_since_epoch_(0),
       entry_size_256b_chunks_(0),
@@ -127,6 +128,28 @@ void EntryMetadata::SetEntrySize(base::StrictNumeric<uint32_t> entry_size) {
   entry_size_256b_chunks_ = (static_cast<uint32_t>(entry_size) + 255) >> 8;
 }
 
+// static
+EntryMetadata EntryMetadata::FromFileEntry(
+    const SimpleIndexFileEntry& file_entry) {
+  EntryMetadata metadata;
+  metadata.last_used_time_seconds_since_epoch_ =
+      file_entry.last_used_time_or_trailer_prefetch_size;
+  metadata.entry_size_256b_chunks_ =
+      file_entry.size_and_in_memory_data & 0xFFFFFFu;
+  metadata.in_memory_data_ = file_entry.size_and_in_memory_data >> 24;
+  return metadata;
+}
+
+SimpleIndexFileEntry EntryMetadata::ToFileEntry(uint64_t entry_hash) const {
+  SimpleIndexFileEntry file_entry;
+  file_entry.hash = entry_hash;
+  file_entry.last_used_time_or_trailer_prefetch_size =
+      last_used_time_seconds_since_epoch_;
+  file_entry.size_and_in_memory_data =
+      entry_size_256b_chunks_ | (static_cast<uint32_t>(in_memory_data_) << 24);
+  return file_entry;
+}
+
 void EntryMetadata::Serialize(net::CacheType cache_type,
                               base::Pickle* pickle) const {
   DCHECK(pickle);
@@ -185,6 +208,8 @@ SimpleIndex::SimpleIndex(
     : cleanup_tracker_(std::move(cleanup_tracker)),
       delegate_(delegate),
       cache_type_(cache_type),
+      eviction_policy_(SimpleEvictionPolicy::Create()),
+      use_journal_(base::FeatureList::IsEnabled(kSimpleCacheIndexJournal)),
       index_file_(std::move(index_file)),
       io_thread_(io_thread),
       // Creating the callback once so it is reused every time
@@ -221,6 +246,15 @@ void SimpleIndex::Initialize(base::Time cache_mtime) {
 
   SimpleIndexLoadResult* load_result = new SimpleIndexLoadResult();
   std::unique_ptr<SimpleIndexLoadResult> load_result_scoped(load_result);
+  load_result->table_mapped_callback = base::BindOnce(
+      [](scoped_refptr<base::SingleThreadTaskRunner> io_thread,
+         base::WeakPtr<SimpleIndex> index,
+         scoped_refptr<SimpleIndexMappedTable> table) {
+        io_thread->PostTask(FROM_HERE,
+                            base::BindOnce(&SimpleIndex::UseMappedTable,
+                                           index, std::move(table)));
+      },
+      io_thread_, AsWeakPtr());
   base::Closure reply = base::Bind(
       &SimpleIndex::MergeInitializingSet,
       AsWeakPtr(),
@@ -312,12 +346,17 @@ uint64_t SimpleIndex::GetCacheSizeBetween(base::Time initial_time,
 
 size_t SimpleIndex::EstimateMemoryUsage() const {
   return base::trace_event::EstimateMemoryUsage(entries_set_) +
-         base::trace_event::EstimateMemoryUsage(removed_entries_);
+         base::trace_event::EstimateMemoryUsage(removed_entries_) +
+         base::trace_event::EstimateMemoryUsage(changed_entries_) +
+         eviction_policy_->EstimateMemoryUsage();
 }
 
 base::Time SimpleIndex::GetLastUsedTime(uint64_t entry_hash) {
   DCHECK(io_thread_checker_.CalledOnValidThread());
   DCHECK_NE(cache_type_, net::APP_CACHE);
+  EntryMetadata metadata;
+  if (!initialized_ && FindBeforeInitialization(entry_hash, &metadata))
+    return metadata.GetLastUsedTime();
   auto it = entries_set_.find(entry_hash);
   if (it == entries_set_.end())
     return base::Time();
@@ -350,8 +389,11 @@ void SimpleIndex::Insert(uint64_t entry_hash) {
   }
   if (!initialized_)
     removed_entries_.erase(entry_hash);
-  if (inserted)
+  eviction_policy_->OnEntryUsed(entry_hash);
+  if (inserted) {
+    EntryChanged(entry_hash);
     PostponeWritingToDisk();
+  }
 }
 
 void SimpleIndex::Remove(uint64_t entry_hash) {
@@ -364,21 +406,37 @@ void SimpleIndex::Remove(uint64_t entry_hash) {
     need_write = true;
   }
 
-  if (!initialized_)
+  if (!initialized_) {
     removed_entries_.insert(entry_hash);
+    // The entry may be in the index file being loaded.
+    EntryChanged(entry_hash);
+  }
 
-  if (need_write)
+  if (need_write) {
+    EntryChanged(entry_hash);
     PostponeWritingToDisk();
+  }
 }
 
 bool SimpleIndex::Has(uint64_t hash) const {
   DCHECK(io_thread_checker_.CalledOnValidThread());
-  // If not initialized, always return true, forcing it to go to the disk.
-  return !initialized_ || entries_set_.count(hash) > 0;
+  // If not initialized, return true unless the mapped index file tells
+  // otherwise, forcing it to go to the disk.
+  if (!initialized_)
+    return !mapped_table_ || FindBeforeInitialization(hash, nullptr);
+  return entries_set_.count(hash) > 0;
+}
+
+bool SimpleIndex::CanAnswerLookups() const {
+  DCHECK(io_thread_checker_.CalledOnValidThread());
+  return initialized_ || mapped_table_;
 }
 
 uint8_t SimpleIndex::GetEntryInMemoryData(uint64_t entry_hash) const {
   DCHECK(io_thread_checker_.CalledOnValidThread());
+  EntryMetadata metadata;
+  if (!initialized_ && FindBeforeInitialization(entry_hash, &metadata))
+    return metadata.GetInMemoryData();
   auto it = entries_set_.find(entry_hash);
   if (it == entries_set_.end())
     return 0;
@@ -390,6 +448,8 @@ void SimpleIndex::SetEntryInMemoryData(uint64_t entry_hash, uint8_t value) {
   auto it = entries_set_.find(entry_hash);
   if (it == entries_set_.end())
     return;
+  if (it->second.GetInMemoryData() != value)
+    EntryChanged(entry_hash);
   return it->second.SetInMemoryData(value);
 }
 
@@ -398,17 +458,29 @@ bool SimpleIndex::UseIfExists(uint64_t entry_hash) {
   // Always update the last used time, even if it is during initialization.
   // It will be merged later.
   auto it = entries_set_.find(entry_hash);
-  if (it == entries_set_.end())
-    // If not initialized, always return true, forcing it to go to the disk.
-    return !initialized_;
+  if (it == entries_set_.end()) {
+    // If not initialized, return true unless the mapped index file tells
+    // otherwise, forcing it to go to the disk.
+    return !initialized_ &&
+           (!mapped_table_ || FindBeforeInitialization(entry_hash, nullptr));
+  }
+  eviction_policy_->OnEntryUsed(entry_hash);
   // We do not need to track access times in APP_CACHE mode.
   if (cache_type_ == net::APP_CACHE)
     return true;
   it->second.SetLastUsedTime(base::Time::Now());
+  EntryChanged(entry_hash);
   PostponeWritingToDisk();
   return true;
 }
 
+void SimpleIndex::RecordOpenLookup(bool hit) {
+  DCHECK(io_thread_checker_.CalledOnValidThread());
+  ++open_lookups_since_eviction_;
+  if (hit)
+    ++open_hits_since_eviction_;
+}
+
 void SimpleIndex::StartEvictionIfNeeded() {
   DCHECK(io_thread_checker_.CalledOnValidThread());
   if (eviction_in_progress_ || cache_size_ <= high_watermark_)
@@ -423,34 +495,19 @@ void SimpleIndex::StartEvictionIfNeeded() {
       MEMORY_KB, "Eviction.MaxCacheSizeOnStart2", cache_type_,
       static_cast<base::HistogramBase::Sample>(max_size_ / kBytesInKb));
 
-  // Flatten for sorting.
-  std::vector<std::pair<uint64_t, const EntrySet::value_type*>> entries;
-  entries.reserve(entries_set_.size());
-  uint32_t now = (base::Time::Now() - base::Time::UnixEpoch()).InSeconds();
-  bool use_size = base::FeatureList::IsEnabled(kSimpleCacheEvictionWithSize);
-  for (EntrySet::const_iterator i = entries_set_.begin();
-       i != entries_set_.end(); ++i) {
-    uint64_t sort_value = now - i->second.RawTimeForSorting();
-    if (use_size) {
-      // Will not overflow since we're multiplying two 32-bit values and storing
-      // them in a 64-bit variable.
-      sort_value *= i->second.GetEntrySize() + kEstimatedEntryOverhead;
-    }
-    // Subtract so we don't need a custom comparator.
-    entries.emplace_back(std::numeric_limits<uint64_t>::max() - sort_value,
-                         &*i);
+  if (open_lookups_since_eviction_) {
+    SIMPLE_CACHE_UMA(PERCENTAGE, "Eviction.OpenHitRatioSinceLastEviction",
+                     cache_type_,
+                     static_cast<int>(100 * open_hits_since_eviction_ /
+                                      open_lookups_since_eviction_));
+    open_lookups_since_eviction_ = 0;
+    open_hits_since_eviction_ = 0;
   }
 
-  uint64_t evicted_so_far_size = 0;
   const uint64_t amount_to_evict = cache_size_ - low_watermark_;
   std::vector<uint64_t> entry_hashes;
-  std::sort(entries.begin(), entries.end());
-  for (const auto& score_metadata_pair : entries) {
-    if (evicted_so_far_size >= amount_to_evict)
-      break;
-    evicted_so_far_size += score_metadata_pair.second->second.GetEntrySize();
-    entry_hashes.push_back(score_metadata_pair.second->first);
-  }
+  const uint64_t evicted_so_far_size = eviction_policy_->SelectEntriesToEvict(
+      entries_set_, amount_to_evict, &entry_hashes);
 
   SIMPLE_CACHE_UMA(COUNTS_1M,
                    "Eviction.EntryCount", cache_type_, entry_hashes.size());
@@ -469,6 +526,9 @@ void SimpleIndex::StartEvictionIfNeeded() {
 int32_t SimpleIndex::GetTrailerPrefetchSize(uint64_t entry_hash) const {
   DCHECK(io_thread_checker_.CalledOnValidThread());
   DCHECK_EQ(cache_type_, net::APP_CACHE);
+  EntryMetadata metadata;
+  if (!initialized_ && FindBeforeInitialization(entry_hash, &metadata))
+    return metadata.GetTrailerPrefetchSize();
   auto it = entries_set_.find(entry_hash);
   if (it == entries_set_.end())
     return -1;
@@ -483,8 +543,10 @@ void SimpleIndex::SetTrailerPrefetchSize(uint64_t entry_hash, int32_t size) {
     return;
   int32_t original_size = it->second.GetTrailerPrefetchSize();
   it->second.SetTrailerPrefetchSize(size);
-  if (original_size != it->second.GetTrailerPrefetchSize())
+  if (original_size != it->second.GetTrailerPrefetchSize()) {
+    EntryChanged(entry_hash);
     PostponeWritingToDisk();
+  }
 }
 
 bool SimpleIndex::UpdateEntrySize(uint64_t entry_hash,
@@ -499,6 +561,7 @@ bool SimpleIndex::UpdateEntrySize(uint64_t entry_hash,
   if (!UpdateEntryIteratorSize(&it, entry_size))
     return true;
 
+  EntryChanged(entry_hash);
   PostponeWritingToDisk();
   StartEvictionIfNeeded();
   return true;
@@ -545,6 +608,11 @@ void SimpleIndex::PostponeWritingToDisk() {
       FROM_HERE, base::TimeDelta::FromMilliseconds(delay), write_to_disk_cb_);
 }
 
+void SimpleIndex::EntryChanged(uint64_t entry_hash) {
+  if (use_journal_)
+    changed_entries_.insert(entry_hash);
+}
+
 bool SimpleIndex::UpdateEntryIteratorSize(
     EntrySet::iterator* it,
     base::StrictNumeric<uint32_t> entry_size) {
@@ -591,7 +659,12 @@ void SimpleIndex::MergeInitializingSet(
   entries_set_.swap(*index_file_entries);
   cache_size_ = merged_cache_size;
   initialized_ = true;
+  mapped_table_ = nullptr;
   init_method_ = load_result->init_method;
+  if (init_method_ == INITIALIZE_METHOD_LOADED) {
+    index_on_disk_ = true;
+    journaled_entry_count_ = load_result->journal_entry_count;
+  }
 
   // The actual IO is asynchronous, so calling WriteToDisk() shouldn't slow the
   // merge down much.
@@ -624,6 +697,28 @@ void SimpleIndex::MergeInitializingSet(
   to_run_when_initialized_.clear();
 }
 
+void SimpleIndex::UseMappedTable(
+    scoped_refptr<SimpleIndexMappedTable> mapped_table) {
+  DCHECK(io_thread_checker_.CalledOnValidThread());
+  if (!initialized_)
+    mapped_table_ = std::move(mapped_table);
+}
+
+bool SimpleIndex::FindBeforeInitialization(uint64_t entry_hash,
+                                           EntryMetadata* out_metadata) const {
+  DCHECK(!initialized_);
+  // The entries used or created since startup are more recent than the file.
+  auto it = entries_set_.find(entry_hash);
+  if (it != entries_set_.end()) {
+    if (out_metadata)
+      *out_metadata = it->second;
+    return true;
+  }
+  if (!mapped_table_ || removed_entries_.count(entry_hash))
+    return false;
+  return mapped_table_->Find(entry_hash, out_metadata);
+}
+
 #if defined(OS_ANDROID)
 void SimpleIndex::OnApplicationStateChange(
     base::android::ApplicationState state) {
@@ -674,6 +769,31 @@ void SimpleIndex::WriteToDisk(IndexWriteToDiskReason reason) {
         cleanup_tracker_);
   }
 
+  // Changes to a small part of the entries are appended to the journal of
+  // the index file. They are replayed when loading it until it is rewritten.
+  if (use_journal_ && index_on_disk_ &&
+      reason != INDEX_WRITE_REASON_STARTUP_MERGE &&
+      journaled_entry_count_ + changed_entries_.size() <=
+          entries_set_.size() / kMaxJournaledEntriesDivisor) {
+    EntrySet changed_entries;
+    std::vector<uint64_t> removed_hashes;
+    for (uint64_t entry_hash : changed_entries_) {
+      auto it = entries_set_.find(entry_hash);
+      if (it == entries_set_.end())
+        removed_hashes.push_back(entry_hash);
+      else
+        changed_entries.insert(*it);
+    }
+    journaled_entry_count_ += changed_entries_.size();
+    changed_entries_.clear();
+    index_file_->WriteJournalToDisk(cache_type_, changed_entries,
+                                    removed_hashes, start, after_write);
+    return;
+  }
+
+  changed_entries_.clear();
+  journaled_entry_count_ = 0;
+  index_on_disk_ = true;
   index_file_->WriteToDisk(cache_type_, reason, entries_set_, cache_size_,
                            start, app_on_background_, after_write);
 }
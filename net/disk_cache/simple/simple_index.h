@@ -9,7 +9,6 @@
 
 #include <list>
 #include <memory>
-#include <unordered_map>
 #include <unordered_set>
 #include <vector>
 
@@ -29,6 +28,8 @@
 #include "net/base/completion_once_callback.h"
 #include "net/base/net_errors.h"
 #include "net/base/net_export.h"
+#include "net/disk_cache/simple/simple_index_format.h"
+#include "net/disk_cache/simple/simple_sharded_map.h"
 
 #if defined(OS_ANDROID)
 #include "base/android/application_status_listener.h"
@@ -43,11 +44,17 @@ namespace disk_cache {
 
 class BackendCleanupTracker;
 class SimpleIndexDelegate;
+class SimpleEvictionPolicy;
 class SimpleIndexFile;
+class SimpleIndexMappedTable;
 struct SimpleIndexLoadResult;
 
 NET_EXPORT_PRIVATE extern const base::Feature kSimpleCacheEvictionWithSize;
 
+// Appends the changes of small index writes to a journal instead of rewriting
+// the whole index file.
+NET_EXPORT_PRIVATE extern const base::Feature kSimpleCacheIndexJournal;
+
 class NET_EXPORT_PRIVATE EntryMetadata {
  public:
   EntryMetadata();
@@ -79,6 +86,10 @@ class NET_EXPORT_PRIVATE EntryMetadata {
                    bool has_entry_in_memory_data,
                    bool app_cache_has_trailer_prefetch_size);
 
+  // Conversions from and to the records of the index file.
+  static EntryMetadata FromFileEntry(const SimpleIndexFileEntry& file_entry);
+  SimpleIndexFileEntry ToFileEntry(uint64_t entry_hash) const;
+
   static base::TimeDelta GetLowerEpsilonForTimeComparisons() {
     return base::TimeDelta::FromSeconds(1);
   }
@@ -157,6 +168,10 @@ class NET_EXPORT_PRIVATE SimpleIndex
   // iff the entry exist in the index.
   bool UseIfExists(uint64_t entry_hash);
 
+  // Counts an open which the index answered, to report the hit ratio of the
+  // eviction policy.
+  void RecordOpenLookup(bool hit);
+
   uint8_t GetEntryInMemoryData(uint64_t entry_hash) const;
   void SetEntryInMemoryData(uint64_t entry_hash, uint8_t value);
 
@@ -171,7 +186,7 @@ class NET_EXPORT_PRIVATE SimpleIndex
   bool UpdateEntrySize(uint64_t entry_hash,
                        base::StrictNumeric<uint32_t> entry_size);
 
-  using EntrySet = std::unordered_map<uint64_t, EntryMetadata>;
+  using EntrySet = SimpleShardedMap<EntryMetadata>;
 
   // Insert an entry in the given set if there is not already entry present.
   // Returns true if the set was modified.
@@ -217,6 +232,11 @@ class NET_EXPORT_PRIVATE SimpleIndex
   // Returns whether the index has been initialized yet.
   bool initialized() const { return initialized_; }
 
+  // Returns whether Has() and the getters of the entry metadata are accurate,
+  // which is the case once the index is initialized, or before that while a
+  // fresh index file is mapped.
+  bool CanAnswerLookups() const;
+
   IndexInitMethod init_method() const { return init_method_; }
 
   // Returns the estimate of dynamically allocated memory in bytes.
@@ -250,6 +270,9 @@ class NET_EXPORT_PRIVATE SimpleIndex
 
   void PostponeWritingToDisk();
 
+  // Records a change of the entry to be persisted by the next journal write.
+  void EntryChanged(uint64_t entry_hash);
+
   // Update the size of the entry pointed to by the given iterator.  Return
   // true if the new size actually results in a change.
   bool UpdateEntryIteratorSize(EntrySet::iterator* it,
@@ -258,6 +281,15 @@ class NET_EXPORT_PRIVATE SimpleIndex
   // Must run on IO Thread.
   void MergeInitializingSet(std::unique_ptr<SimpleIndexLoadResult> load_result);
 
+  // Answers lookups from |mapped_table| until the index is initialized.
+  void UseMappedTable(scoped_refptr<SimpleIndexMappedTable> mapped_table);
+
+  // Before initialization, looks |entry_hash| up in the entries changed since
+  // startup and then in the mapped index file. Returns false if the entry is
+  // unknown or was removed, or if there is no mapped index file.
+  bool FindBeforeInitialization(uint64_t entry_hash,
+                                EntryMetadata* out_metadata) const;
+
 #if defined(OS_ANDROID)
   void OnApplicationStateChange(base::android::ApplicationState state);
 
@@ -280,10 +312,27 @@ class NET_EXPORT_PRIVATE SimpleIndex
   uint64_t low_watermark_ = 0;
   bool eviction_in_progress_ = false;
   base::TimeTicks eviction_start_time_;
+  const std::unique_ptr<SimpleEvictionPolicy> eviction_policy_;
+  // Reported and reset when an eviction starts.
+  uint64_t open_lookups_since_eviction_ = 0;
+  uint64_t open_hits_since_eviction_ = 0;
 
   // This stores all the entry_hash of entries that are removed during
   // initialization.
   std::unordered_set<uint64_t> removed_entries_;
+  // With kSimpleCacheIndexJournal, the entries changed or removed since the
+  // last write, and the number of changes appended to the journal since the
+  // index file was last written in full.
+  const bool use_journal_;
+  std::unordered_set<uint64_t> changed_entries_;
+  uint64_t journaled_entry_count_ = 0;
+  // Whether an index file was loaded or written, for the journal to extend.
+  bool index_on_disk_ = false;
+
+  // The index file being loaded, if it is fresh and mapped. Released once the
+  // index is initialized.
+  scoped_refptr<SimpleIndexMappedTable> mapped_table_;
+
   bool initialized_ = false;
   IndexInitMethod init_method_ = INITIALIZE_METHOD_MAX;
 
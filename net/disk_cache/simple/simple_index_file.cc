@@ -4,12 +4,16 @@
 
 #include "net/disk_cache/simple/simple_index_file.h"
 
+#include <stddef.h>
+
+#include <algorithm>
 #include <utility>
 #include <vector>
 
 #include "base/bind.h"
 #include "base/files/file.h"
 #include "base/files/file_util.h"
+#include "base/files/memory_mapped_file.h"
 #include "base/logging.h"
 #include "base/numerics/safe_conversions.h"
 #include "base/pickle.h"
@@ -35,10 +39,25 @@ const int kMaxEntriesInIndex = 1000000;
 const int64_t kMaxIndexFileSizeBytes =
     kMaxEntriesInIndex * (8 + EntryMetadata::kOnDiskSizeBytes);
 
+// Identifies the writes in the journal of the index.
+const uint64_t kSimpleIndexJournalMagicNumber = UINT64_C(0x6a6f75726e616c31);
+
 uint32_t CalculatePickleCRC(const base::Pickle& pickle) {
   return simple_util::Crc32(pickle.payload(), pickle.payload_size());
 }
 
+uint32_t CalculateHeaderCRC(const SimpleIndexFileHeader& header) {
+  return simple_util::Crc32(reinterpret_cast<const char*>(&header),
+                            offsetof(SimpleIndexFileHeader, header_crc));
+}
+
+uint32_t CalculateTableCRC(const SimpleIndexFileEntry* entries,
+                           uint64_t entry_count) {
+  return simple_util::Crc32(
+      reinterpret_cast<const char*>(entries),
+      base::checked_cast<int>(entry_count * sizeof(SimpleIndexFileEntry)));
+}
+
 // Used in histograms. Please only add new values at the end.
 enum IndexFileState {
   INDEX_STATE_CORRUPT = 0,
@@ -111,21 +130,64 @@ class SimpleIndexPickle : public base::Pickle {
       : base::Pickle(data, data_len) {}
 
   bool HeaderValid() const { return header_size() == sizeof(PickleHeader); }
+
+  // Returns the end of the pickle starting at |range_start|, or null if it
+  // doesn't fit before |range_end|.
+  static const char* FindEnd(const char* range_start, const char* range_end) {
+    return FindNext(sizeof(PickleHeader), range_start, range_end);
+  }
 };
 
-bool WritePickleFile(base::Pickle* pickle, const base::FilePath& file_name) {
+bool WriteTableFile(const SimpleIndexFileHeader& header,
+                    const std::vector<SimpleIndexFileEntry>& entries,
+                    const base::FilePath& file_name) {
   base::File file(file_name, base::File::FLAG_CREATE_ALWAYS |
                                  base::File::FLAG_WRITE |
                                  base::File::FLAG_SHARE_DELETE);
   if (!file.IsValid())
     return false;
 
-  int bytes_written =
-      file.Write(0, static_cast<const char*>(pickle->data()), pickle->size());
-  if (bytes_written != base::checked_cast<int>(pickle->size())) {
+  const int table_size =
+      base::checked_cast<int>(entries.size() * sizeof(SimpleIndexFileEntry));
+  if (file.Write(0, reinterpret_cast<const char*>(&header), sizeof(header)) !=
+          static_cast<int>(sizeof(header)) ||
+      file.Write(sizeof(header), reinterpret_cast<const char*>(entries.data()),
+                 table_size) != table_size) {
+    simple_util::SimpleCacheDeleteFile(file_name);
+    return false;
+  }
+  return true;
+}
+
+// Reads the whole of |file_name| into |buffer|, if it isn't larger than
+// kMaxIndexFileSizeBytes. Deletes the file if it can't be read.
+bool ReadIndexFile(const base::FilePath& file_name,
+                   std::unique_ptr<char[]>* buffer,
+                   int* buffer_size) {
+  base::File file(file_name, base::File::FLAG_OPEN | base::File::FLAG_READ |
+                                 base::File::FLAG_SHARE_DELETE |
+                                 base::File::FLAG_SEQUENTIAL_SCAN);
+  if (!file.IsValid())
+    return false;
+
+  // Sanity-check the length. We don't want to crash trying to read some corrupt
+  // 10GiB file or such.
+  int64_t file_length = file.GetLength();
+  if (file_length < 0 || file_length > kMaxIndexFileSizeBytes) {
+    simple_util::SimpleCacheDeleteFile(file_name);
+    return false;
+  }
+
+  // Make sure to preallocate in one chunk, so we don't induce fragmentation
+  // reallocating a growing buffer.
+  *buffer = std::make_unique<char[]>(file_length);
+
+  int read = file.Read(0, buffer->get(), file_length);
+  if (read < file_length) {
     simple_util::SimpleCacheDeleteFile(file_name);
     return false;
   }
+  *buffer_size = read;
   return true;
 }
 
@@ -226,10 +288,74 @@ void ProcessEntryFile(net::CacheType cache_type,
 
 }  // namespace
 
+// static
+scoped_refptr<SimpleIndexMappedTable> SimpleIndexMappedTable::Map(
+    const base::FilePath& index_filename) {
+  base::File file(index_filename, base::File::FLAG_OPEN |
+                                      base::File::FLAG_READ |
+                                      base::File::FLAG_SHARE_DELETE);
+  if (!file.IsValid() ||
+      file.GetLength() < static_cast<int64_t>(sizeof(SimpleIndexFileHeader))) {
+    return nullptr;
+  }
+  auto mapped_file = std::make_unique<base::MemoryMappedFile>();
+  if (!mapped_file->Initialize(std::move(file)))
+    return nullptr;
+
+  const auto* header =
+      reinterpret_cast<const SimpleIndexFileHeader*>(mapped_file->data());
+  if (header->magic_number != kSimpleIndexTableMagicNumber ||
+      header->version != kSimpleVersion ||
+      header->header_crc != CalculateHeaderCRC(*header) ||
+      header->reason >= SimpleIndex::INDEX_WRITE_REASON_MAX ||
+      header->entry_count > kMaxEntriesInIndex ||
+      mapped_file->length() !=
+          sizeof(SimpleIndexFileHeader) +
+              header->entry_count * sizeof(SimpleIndexFileEntry)) {
+    return nullptr;
+  }
+  const auto* entries = reinterpret_cast<const SimpleIndexFileEntry*>(
+      mapped_file->data() + sizeof(SimpleIndexFileHeader));
+  if (header->table_crc != CalculateTableCRC(entries, header->entry_count)) {
+    LOG(WARNING) << "Invalid CRC in Simple Index file.";
+    return nullptr;
+  }
+  return base::WrapRefCounted(
+      new SimpleIndexMappedTable(std::move(mapped_file)));
+}
+
+SimpleIndexMappedTable::SimpleIndexMappedTable(
+    std::unique_ptr<base::MemoryMappedFile> file)
+    : file_(std::move(file)),
+      header_(reinterpret_cast<const SimpleIndexFileHeader*>(file_->data())),
+      entries_(reinterpret_cast<const SimpleIndexFileEntry*>(
+          file_->data() + sizeof(SimpleIndexFileHeader))) {}
+
+SimpleIndexMappedTable::~SimpleIndexMappedTable() = default;
+
+base::Time SimpleIndexMappedTable::cache_last_modified() const {
+  return base::Time::FromInternalValue(header_->cache_last_modified);
+}
+
+bool SimpleIndexMappedTable::Find(uint64_t entry_hash,
+                                  EntryMetadata* out_metadata) const {
+  const SimpleIndexFileEntry* it = std::lower_bound(
+      begin(), end(), entry_hash,
+      [](const SimpleIndexFileEntry& entry, uint64_t hash) {
+        return entry.hash < hash;
+      });
+  if (it == end() || it->hash != entry_hash)
+    return false;
+  if (out_metadata)
+    *out_metadata = EntryMetadata::FromFileEntry(*it);
+  return true;
+}
+
 SimpleIndexLoadResult::SimpleIndexLoadResult()
     : did_load(false),
       index_write_reason(SimpleIndex::INDEX_WRITE_REASON_MAX),
-      flush_required(false) {}
+      flush_required(false),
+      journal_entry_count(0) {}
 
 SimpleIndexLoadResult::~SimpleIndexLoadResult() = default;
 
@@ -237,6 +363,7 @@ void SimpleIndexLoadResult::Reset() {
   did_load = false;
   index_write_reason = SimpleIndex::INDEX_WRITE_REASON_MAX;
   flush_required = false;
+  journal_entry_count = 0;
   entries.clear();
 }
 
@@ -246,6 +373,8 @@ const char SimpleIndexFile::kIndexFileName[] = "the-real-index";
 const char SimpleIndexFile::kIndexDirectory[] = "index-dir";
 // static
 const char SimpleIndexFile::kTempIndexFileName[] = "temp-index";
+// static
+const char SimpleIndexFile::kIndexJournalFileName[] = "journal";
 
 SimpleIndexFile::IndexMetadata::IndexMetadata()
     : reason_(SimpleIndex::INDEX_WRITE_REASON_MAX),
@@ -292,13 +421,15 @@ bool SimpleIndexFile::IndexMetadata::Deserialize(base::PickleIterator* it) {
   return true;
 }
 
-void SimpleIndexFile::SyncWriteToDisk(net::CacheType cache_type,
-                                      const base::FilePath& cache_directory,
-                                      const base::FilePath& index_filename,
-                                      const base::FilePath& temp_index_filename,
-                                      std::unique_ptr<base::Pickle> pickle,
-                                      const base::TimeTicks& start_time,
-                                      bool app_on_background) {
+void SimpleIndexFile::SyncWriteToDisk(
+    net::CacheType cache_type,
+    const base::FilePath& cache_directory,
+    const base::FilePath& index_filename,
+    const base::FilePath& temp_index_filename,
+    SimpleIndexFileHeader header,
+    std::unique_ptr<std::vector<SimpleIndexFileEntry>> entries,
+    const base::TimeTicks& start_time,
+    bool app_on_background) {
   DCHECK_EQ(index_filename.DirName().value(),
             temp_index_filename.DirName().value());
   base::FilePath index_file_directory = temp_index_filename.DirName();
@@ -308,6 +439,12 @@ void SimpleIndexFile::SyncWriteToDisk(net::CacheType cache_type,
     return;
   }
 
+  // The journal only applies to the index being replaced. If the new index
+  // can't be written, the old one is removed too: the writes appended to the
+  // journal afterwards would otherwise be replayed onto an index which misses
+  // some earlier changes.
+  simple_util::SimpleCacheDeleteFile(GetJournalPath(index_filename));
+
   // There is a chance that the index containing all the necessary data about
   // newly created entries will appear to be stale. This can happen if on-disk
   // part of a Create operation does not fit into the time budget for the index
@@ -316,17 +453,27 @@ void SimpleIndexFile::SyncWriteToDisk(net::CacheType cache_type,
   base::Time cache_dir_mtime;
   if (!simple_util::GetMTime(cache_directory, &cache_dir_mtime)) {
     LOG(ERROR) << "Could obtain information about cache age";
+    simple_util::SimpleCacheDeleteFile(index_filename);
     return;
   }
-  SerializeFinalData(cache_dir_mtime, pickle.get());
-  if (!WritePickleFile(pickle.get(), temp_index_filename)) {
+  std::sort(entries->begin(), entries->end(),
+            [](const SimpleIndexFileEntry& a, const SimpleIndexFileEntry& b) {
+              return a.hash < b.hash;
+            });
+  header.cache_last_modified = cache_dir_mtime.ToInternalValue();
+  header.table_crc = CalculateTableCRC(entries->data(), entries->size());
+  header.header_crc = CalculateHeaderCRC(header);
+  if (!WriteTableFile(header, *entries, temp_index_filename)) {
     LOG(ERROR) << "Failed to write the temporary index file";
+    simple_util::SimpleCacheDeleteFile(index_filename);
     return;
   }
 
   // Atomically rename the temporary index file to become the real one.
-  if (!base::ReplaceFile(temp_index_filename, index_filename, nullptr))
+  if (!base::ReplaceFile(temp_index_filename, index_filename, nullptr)) {
+    simple_util::SimpleCacheDeleteFile(index_filename);
     return;
+  }
 
   if (app_on_background) {
     SIMPLE_CACHE_UMA(TIMES,
@@ -345,10 +492,11 @@ bool SimpleIndexFile::IndexMetadata::CheckIndexMetadata() {
     return false;
   }
 
-  static_assert(kSimpleVersion == 9, "index metadata reader out of date");
+  static_assert(kSimpleVersion == 10, "index metadata reader out of date");
   // No |reason_| is saved in the version 6 file format.
   if (version_ == 6)
     return reason_ == SimpleIndex::INDEX_WRITE_REASON_MAX;
+  // Later versions aren't pickles, see SimpleIndexMappedTable.
   return (version_ == 7 || version_ == 8 || version_ == 9) &&
          reason_ < SimpleIndex::INDEX_WRITE_REASON_MAX;
 }
@@ -387,19 +535,86 @@ void SimpleIndexFile::WriteToDisk(net::CacheType cache_type,
                                   bool app_on_background,
                                   const base::Closure& callback) {
   UmaRecordIndexWriteReason(reason, cache_type_);
-  IndexMetadata index_metadata(reason, entry_set.size(), cache_size);
-  std::unique_ptr<base::Pickle> pickle =
-      Serialize(cache_type, index_metadata, entry_set);
+  SimpleIndexFileHeader header;
+  header.version = kSimpleVersion;
+  header.reason = reason;
+  header.entry_count = entry_set.size();
+  header.cache_size = cache_size;
+  // The entries are sorted on the cache thread.
+  auto entries = std::make_unique<std::vector<SimpleIndexFileEntry>>();
+  entries->reserve(entry_set.size());
+  for (const auto& entry : entry_set)
+    entries->push_back(entry.second.ToFileEntry(entry.first));
   base::Closure task =
       base::Bind(&SimpleIndexFile::SyncWriteToDisk,
                  cache_type_, cache_directory_, index_file_, temp_index_file_,
-                 base::Passed(&pickle), start, app_on_background);
+                 header, base::Passed(&entries), start, app_on_background);
+  if (callback.is_null())
+    cache_runner_->PostTask(FROM_HERE, task);
+  else
+    cache_runner_->PostTaskAndReply(FROM_HERE, task, callback);
+}
+
+void SimpleIndexFile::WriteJournalToDisk(
+    net::CacheType cache_type,
+    const SimpleIndex::EntrySet& changed_entries,
+    const std::vector<uint64_t>& removed_hashes,
+    const base::TimeTicks& start,
+    const base::Closure& callback) {
+  std::unique_ptr<base::Pickle> pickle =
+      SerializeJournal(cache_type, changed_entries, removed_hashes);
+  base::Closure task = base::Bind(
+      &SimpleIndexFile::SyncAppendToJournal, cache_type_, cache_directory_,
+      index_file_, GetJournalPath(index_file_), base::Passed(&pickle), start);
   if (callback.is_null())
     cache_runner_->PostTask(FROM_HERE, task);
   else
     cache_runner_->PostTaskAndReply(FROM_HERE, task, callback);
 }
 
+// static
+void SimpleIndexFile::SyncAppendToJournal(
+    net::CacheType cache_type,
+    const base::FilePath& cache_directory,
+    const base::FilePath& index_filename,
+    const base::FilePath& journal_filename,
+    std::unique_ptr<base::Pickle> pickle,
+    const base::TimeTicks& start_time) {
+  // Without the index this journal extends, the next load can't do better
+  // than rebuilding the index anyway.
+  if (!base::PathExists(index_filename)) {
+    simple_util::SimpleCacheDeleteFile(journal_filename);
+    return;
+  }
+
+  base::Time cache_dir_mtime;
+  if (!simple_util::GetMTime(cache_directory, &cache_dir_mtime)) {
+    LOG(ERROR) << "Could obtain information about cache age";
+    return;
+  }
+  SerializeFinalData(cache_dir_mtime, pickle.get());
+
+  base::File file(journal_filename, base::File::FLAG_OPEN_ALWAYS |
+                                        base::File::FLAG_APPEND |
+                                        base::File::FLAG_SHARE_DELETE);
+  if (!file.IsValid())
+    return;
+  int bytes_written = file.WriteAtCurrentPos(
+      static_cast<const char*>(pickle->data()), pickle->size());
+  if (bytes_written != base::checked_cast<int>(pickle->size())) {
+    // A torn write would hide all the following ones, start over from the
+    // index.
+    LOG(ERROR) << "Failed to append to the index journal";
+    file.Close();
+    simple_util::SimpleCacheDeleteFile(index_filename);
+    simple_util::SimpleCacheDeleteFile(journal_filename);
+    return;
+  }
+
+  SIMPLE_CACHE_UMA(TIMES, "IndexJournalWriteToDiskTime", cache_type,
+                   base::TimeTicks::Now() - start_time);
+}
+
 // static
 void SimpleIndexFile::SyncLoadIndexEntries(
     net::CacheType cache_type,
@@ -409,8 +624,19 @@ void SimpleIndexFile::SyncLoadIndexEntries(
     SimpleIndexLoadResult* out_result) {
   // Load the index and find its age.
   base::Time last_cache_seen_by_index;
-  SyncLoadFromDisk(cache_type, index_file_path, &last_cache_seen_by_index,
-                   out_result);
+  {
+    // A fresh index in the current format can answer lookups right away,
+    // unless a journal modifies it.
+    scoped_refptr<SimpleIndexMappedTable> table =
+        SimpleIndexMappedTable::Map(index_file_path);
+    if (table && cache_last_modified <= table->cache_last_modified() &&
+        out_result->table_mapped_callback &&
+        !base::PathExists(GetJournalPath(index_file_path))) {
+      std::move(out_result->table_mapped_callback).Run(table);
+    }
+    SyncLoadFromDisk(cache_type, index_file_path, table.get(),
+                     &last_cache_seen_by_index, out_result);
+  }
 
   // Consider the index loaded if it is fresh.
   const bool index_file_existed = base::PathExists(index_file_path);
@@ -475,40 +701,45 @@ void SimpleIndexFile::SyncLoadIndexEntries(
 // static
 void SimpleIndexFile::SyncLoadFromDisk(net::CacheType cache_type,
                                        const base::FilePath& index_filename,
+                                       const SimpleIndexMappedTable* table,
                                        base::Time* out_last_cache_seen_by_index,
                                        SimpleIndexLoadResult* out_result) {
   out_result->Reset();
 
-  base::File file(index_filename, base::File::FLAG_OPEN |
-                                      base::File::FLAG_READ |
-                                      base::File::FLAG_SHARE_DELETE |
-                                      base::File::FLAG_SEQUENTIAL_SCAN);
-  if (!file.IsValid())
-    return;
-
-  // Sanity-check the length. We don't want to crash trying to read some corrupt
-  // 10GiB file or such.
-  int64_t file_length = file.GetLength();
-  if (file_length < 0 || file_length > kMaxIndexFileSizeBytes) {
-    simple_util::SimpleCacheDeleteFile(index_filename);
-    return;
+  std::unique_ptr<char[]> buffer;
+  int buffer_size = 0;
+  if (table) {
+    SimpleIndex::EntrySet* entries = &out_result->entries;
+    entries->reserve(table->header().entry_count + kExtraSizeForMerge);
+    for (const SimpleIndexFileEntry& file_entry : *table) {
+      SimpleIndex::InsertInEntrySet(
+          file_entry.hash, EntryMetadata::FromFileEntry(file_entry), entries);
+    }
+    *out_last_cache_seen_by_index = table->cache_last_modified();
+    out_result->index_write_reason =
+        static_cast<SimpleIndex::IndexWriteToDiskReason>(
+            table->header().reason);
+    out_result->did_load = true;
+  } else {
+    // Maybe an index written before version 10.
+    if (!ReadIndexFile(index_filename, &buffer, &buffer_size))
+      return;
+    SimpleIndexFile::Deserialize(cache_type, buffer.get(), buffer_size,
+                                 out_last_cache_seen_by_index, out_result);
   }
 
-  // Make sure to preallocate in one chunk, so we don't induce fragmentation
-  // reallocating a growing buffer.
-  auto buffer = std::make_unique<char[]>(file_length);
-
-  int read = file.Read(0, buffer.get(), file_length);
-  if (read < file_length) {
+  if (!out_result->did_load) {
     simple_util::SimpleCacheDeleteFile(index_filename);
+    simple_util::SimpleCacheDeleteFile(GetJournalPath(index_filename));
     return;
   }
 
-  SimpleIndexFile::Deserialize(cache_type, buffer.get(), read,
-                               out_last_cache_seen_by_index, out_result);
-
-  if (!out_result->did_load)
-    simple_util::SimpleCacheDeleteFile(index_filename);
+  const base::FilePath journal_filename = GetJournalPath(index_filename);
+  if (ReadIndexFile(journal_filename, &buffer, &buffer_size)) {
+    SimpleIndexFile::DeserializeJournal(cache_type, buffer.get(), buffer_size,
+                                        out_last_cache_seen_by_index,
+                                        out_result);
+  }
 }
 
 // static
@@ -517,6 +748,13 @@ std::unique_ptr<base::Pickle> SimpleIndexFile::Serialize(
     const SimpleIndexFile::IndexMetadata& index_metadata,
     const SimpleIndex::EntrySet& entries) {
   std::unique_ptr<base::Pickle> pickle = std::make_unique<SimpleIndexPickle>();
+  // Size the pickle once rather than growing it while writing the entries.
+  // The metadata is three uint64_t and two uint32_t, and the last modified
+  // time follows the entries.
+  pickle->Reserve(3 * sizeof(uint64_t) + 2 * sizeof(uint32_t) +
+                  entries.size() * (sizeof(uint64_t) +
+                                    EntryMetadata::kOnDiskSizeBytes) +
+                  sizeof(int64_t));
 
   index_metadata.Serialize(pickle.get());
   for (auto it = entries.begin(); it != entries.end(); ++it) {
@@ -526,6 +764,34 @@ std::unique_ptr<base::Pickle> SimpleIndexFile::Serialize(
   return pickle;
 }
 
+// static
+std::unique_ptr<base::Pickle> SimpleIndexFile::SerializeJournal(
+    net::CacheType cache_type,
+    const SimpleIndex::EntrySet& changed_entries,
+    const std::vector<uint64_t>& removed_hashes) {
+  std::unique_ptr<base::Pickle> pickle = std::make_unique<SimpleIndexPickle>();
+  pickle->Reserve(
+      2 * sizeof(uint64_t) + sizeof(uint32_t) +
+      removed_hashes.size() * sizeof(uint64_t) + sizeof(uint64_t) +
+      changed_entries.size() *
+          (sizeof(uint64_t) + EntryMetadata::kOnDiskSizeBytes));
+
+  pickle->WriteUInt64(kSimpleIndexJournalMagicNumber);
+  pickle->WriteUInt32(kSimpleVersion);
+  pickle->WriteUInt64(removed_hashes.size());
+  // The hashes are 4-byte aligned, so writing them at once lays them out as
+  // writing them one by one would.
+  pickle->WriteBytes(
+      removed_hashes.data(),
+      static_cast<int>(removed_hashes.size() * sizeof(uint64_t)));
+  pickle->WriteUInt64(changed_entries.size());
+  for (const auto& entry : changed_entries) {
+    pickle->WriteUInt64(entry.first);
+    entry.second.Serialize(cache_type, pickle.get());
+  }
+  return pickle;
+}
+
 // static
 void SimpleIndexFile::Deserialize(net::CacheType cache_type,
                                   const char* data,
@@ -591,6 +857,94 @@ void SimpleIndexFile::Deserialize(net::CacheType cache_type,
   out_result->did_load = true;
 }
 
+// static
+void SimpleIndexFile::DeserializeJournal(net::CacheType cache_type,
+                                         const char* data,
+                                         int data_len,
+                                         base::Time* out_cache_last_modified,
+                                         SimpleIndexLoadResult* out_result) {
+  DCHECK(data);
+  DCHECK(out_result->did_load);
+
+  const char* const end = data + data_len;
+  std::vector<uint64_t> removed_hashes;
+  std::vector<std::pair<uint64_t, EntryMetadata>> changed_entries;
+  while (data < end) {
+    const char* next = SimpleIndexPickle::FindEnd(data, end);
+    if (!next) {
+      // Most likely the last write was interrupted.
+      LOG(WARNING) << "Truncated Simple Index journal.";
+      return;
+    }
+    SimpleIndexPickle pickle(data, next - data);
+    data = next;
+    if (!pickle.data() || !pickle.HeaderValid() ||
+        pickle.headerT<PickleHeader>()->crc != CalculatePickleCRC(pickle)) {
+      LOG(WARNING) << "Corrupt Simple Index journal.";
+      return;
+    }
+
+    // Parse the whole write before applying it.
+    base::PickleIterator pickle_it(pickle);
+    uint64_t magic_number;
+    uint32_t version;
+    uint64_t count;
+    if (!pickle_it.ReadUInt64(&magic_number) ||
+        magic_number != kSimpleIndexJournalMagicNumber ||
+        !pickle_it.ReadUInt32(&version) ||
+        version < kSimpleIndexLastPickledVersion || version > kSimpleVersion ||
+        !pickle_it.ReadUInt64(&count) || count > kMaxEntriesInIndex) {
+      LOG(WARNING) << "Invalid write in Simple Index journal.";
+      return;
+    }
+    removed_hashes.resize(count);
+    for (uint64_t& hash : removed_hashes) {
+      if (!pickle_it.ReadUInt64(&hash)) {
+        LOG(WARNING) << "Invalid removal in Simple Index journal.";
+        return;
+      }
+    }
+    if (!pickle_it.ReadUInt64(&count) || count > kMaxEntriesInIndex) {
+      LOG(WARNING) << "Invalid write in Simple Index journal.";
+      return;
+    }
+    changed_entries.resize(count);
+    for (auto& entry : changed_entries) {
+      if (!pickle_it.ReadUInt64(&entry.first) ||
+          !entry.second.Deserialize(
+              cache_type, &pickle_it, true /* has_entry_in_memory_data */,
+              true /* app_cache_has_trailer_prefetch_size */)) {
+        LOG(WARNING) << "Invalid EntryMetadata in Simple Index journal.";
+        return;
+      }
+    }
+    int64_t cache_last_modified;
+    if (!pickle_it.ReadInt64(&cache_last_modified)) {
+      LOG(WARNING) << "Invalid write in Simple Index journal.";
+      return;
+    }
+
+    SimpleIndex::EntrySet* entries = &out_result->entries;
+    for (uint64_t hash : removed_hashes)
+      entries->erase(hash);
+    for (const auto& entry : changed_entries) {
+      auto insert_result = entries->insert(entry);
+      if (!insert_result.second)
+        insert_result.first->second = entry.second;
+    }
+    out_result->journal_entry_count +=
+        removed_hashes.size() + changed_entries.size();
+    *out_cache_last_modified =
+        base::Time::FromInternalValue(cache_last_modified);
+  }
+}
+
+// static
+base::FilePath SimpleIndexFile::GetJournalPath(
+    const base::FilePath& index_filename) {
+  return index_filename.DirName().AppendASCII(kIndexJournalFileName);
+}
+
 // static
 void SimpleIndexFile::SyncRestoreFromDisk(net::CacheType cache_type,
                                           const base::FilePath& cache_directory,
@@ -598,6 +952,7 @@ void SimpleIndexFile::SyncRestoreFromDisk(net::CacheType cache_type,
                                           SimpleIndexLoadResult* out_result) {
   VLOG(1) << "Simple Cache Index is being restored from disk.";
   simple_util::SimpleCacheDeleteFile(index_file_path);
+  simple_util::SimpleCacheDeleteFile(GetJournalPath(index_file_path));
   out_result->Reset();
   SimpleIndex::EntrySet* entries = &out_result->entries;
 
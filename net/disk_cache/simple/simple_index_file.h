@@ -11,17 +11,21 @@
 #include <string>
 #include <vector>
 
+#include "base/callback.h"
 #include "base/files/file_path.h"
 #include "base/gtest_prod_util.h"
 #include "base/logging.h"
 #include "base/macros.h"
+#include "base/memory/ref_counted.h"
 #include "base/pickle.h"
 #include "net/base/cache_type.h"
 #include "net/base/net_export.h"
 #include "net/disk_cache/simple/simple_backend_version.h"
 #include "net/disk_cache/simple/simple_index.h"
+#include "net/disk_cache/simple/simple_index_format.h"
 
 namespace base {
+class MemoryMappedFile;
 class SequencedTaskRunner;
 class TaskRunner;
 }
@@ -30,6 +34,45 @@ namespace disk_cache {
 
 const uint64_t kSimpleIndexMagicNumber = UINT64_C(0x656e74657220796f);
 
+// The last version of the index file written as a pickle.
+const uint32_t kSimpleIndexLastPickledVersion = 9;
+
+// A read-only mapping of an index file in the format of
+// simple_index_format.h, used to answer lookups while the index is loading.
+class NET_EXPORT_PRIVATE SimpleIndexMappedTable
+    : public base::RefCountedThreadSafe<SimpleIndexMappedTable> {
+ public:
+  // Returns null if |index_filename| can't be mapped or isn't a valid index
+  // file of the current version.
+  static scoped_refptr<SimpleIndexMappedTable> Map(
+      const base::FilePath& index_filename);
+
+  const SimpleIndexFileHeader& header() const { return *header_; }
+  base::Time cache_last_modified() const;
+
+  // The records, sorted by hash.
+  const SimpleIndexFileEntry* begin() const { return entries_; }
+  const SimpleIndexFileEntry* end() const {
+    return entries_ + header_->entry_count;
+  }
+
+  // Returns whether |entry_hash| is in the table, and its metadata in
+  // |out_metadata| if it isn't null.
+  bool Find(uint64_t entry_hash, EntryMetadata* out_metadata) const;
+
+ private:
+  friend class base::RefCountedThreadSafe<SimpleIndexMappedTable>;
+
+  explicit SimpleIndexMappedTable(std::unique_ptr<base::MemoryMappedFile> file);
+  ~SimpleIndexMappedTable();
+
+  const std::unique_ptr<base::MemoryMappedFile> file_;
+  const SimpleIndexFileHeader* const header_;
+  const SimpleIndexFileEntry* const entries_;
+
+  DISALLOW_COPY_AND_ASSIGN(SimpleIndexMappedTable);
+};
+
 struct NET_EXPORT_PRIVATE SimpleIndexLoadResult {
   SimpleIndexLoadResult();
   ~SimpleIndexLoadResult();
@@ -40,13 +83,29 @@ struct NET_EXPORT_PRIVATE SimpleIndexLoadResult {
   SimpleIndex::IndexWriteToDiskReason index_write_reason;
   SimpleIndex::IndexInitMethod init_method;
   bool flush_required;
+  // Number of entry changes replayed from the journal of the index file.
+  uint64_t journal_entry_count;
+  // If set, run on the worker thread with the index file as soon as it is
+  // mapped and known to be fresh, before the entries are loaded. Not cleared
+  // by Reset().
+  base::OnceCallback<void(scoped_refptr<SimpleIndexMappedTable>)>
+      table_mapped_callback;
 };
 
-// Simple Index File format is a pickle of IndexMetadata and EntryMetadata
-// objects. The file format is as follows: one instance of |IndexMetadata|
-// followed by |EntryMetadata| repeated |entry_count| times. To learn more about
-// the format see |SimpleIndexFile::Serialize()| and
-// |SimpleIndexFile::LoadFromDisk()|.
+// Simple Index File format is a header followed by a table of the entries
+// sorted by hash, see simple_index_format.h. It can be mapped and looked up in
+// place, see SimpleIndexMappedTable. Up to version 9, the index file was a
+// pickle of IndexMetadata and EntryMetadata objects: one instance of
+// |IndexMetadata| followed by |EntryMetadata| repeated |entry_count| times,
+// see |SimpleIndexFile::Serialize()| and |SimpleIndexFile::Deserialize()|.
+// Such files are still loaded, and replaced on the next write.
+//
+// Changes made since the index file was written may be appended to a journal
+// next to it instead of rewriting the whole index, see WriteJournalToDisk().
+// The journal is a sequence of pickles, each holding the removed hashes and
+// the updated EntryMetadata of one write, followed by the cache modification
+// time like the index. Loading replays the valid pickles, and a full write
+// removes the journal before replacing the index.
 //
 // The non-static methods must run on the IO thread. All the real
 // work is done in the static methods, which are run on the cache thread
@@ -83,7 +142,7 @@ class NET_EXPORT_PRIVATE SimpleIndexFile {
     friend class V8IndexMetadataForTest;
 
     uint64_t magic_number_ = kSimpleIndexMagicNumber;
-    uint32_t version_ = kSimpleVersion;
+    uint32_t version_ = kSimpleIndexLastPickledVersion;
     SimpleIndex::IndexWriteToDiskReason reason_;
     uint64_t entry_count_;
     uint64_t cache_size_;  // Total cache storage size in bytes.
@@ -111,6 +170,16 @@ class NET_EXPORT_PRIVATE SimpleIndexFile {
                            bool app_on_background,
                            const base::Closure& callback);
 
+  // Appends the entries of |changed_entries| and the removal of
+  // |removed_hashes| to the journal of the index file last written with
+  // WriteToDisk(), or loaded. The journal is dropped if there is no such
+  // index file anymore, which makes the next load rebuild the index.
+  virtual void WriteJournalToDisk(net::CacheType cache_type,
+                                  const SimpleIndex::EntrySet& changed_entries,
+                                  const std::vector<uint64_t>& removed_hashes,
+                                  const base::TimeTicks& start,
+                                  const base::Closure& callback);
+
  private:
   friend class WrappedSimpleIndexFile;
 
@@ -131,15 +200,18 @@ class NET_EXPORT_PRIVATE SimpleIndexFile {
                                    const base::FilePath& index_file_path,
                                    SimpleIndexLoadResult* out_result);
 
-  // Load the index file from disk returning an EntrySet.
+  // Load the index file from disk returning an EntrySet. |table| is the
+  // mapping of |index_filename|, or null if it isn't in the current format.
   static void SyncLoadFromDisk(net::CacheType cache_type,
                                const base::FilePath& index_filename,
+                               const SimpleIndexMappedTable* table,
                                base::Time* out_last_cache_seen_by_index,
                                SimpleIndexLoadResult* out_result);
 
   // Returns a scoped_ptr for a newly allocated base::Pickle containing the
   // serialized
-  // data to be written to a file. Note: the pickle is not in a consistent state
+  // data to be written to a file in the format of version 9, which is only
+  // written by tests now. Note: the pickle is not in a consistent state
   // immediately after calling this menthod, one needs to call
   // SerializeFinalData to make it ready to write to a file.
   static std::unique_ptr<base::Pickle> Serialize(
@@ -147,6 +219,13 @@ class NET_EXPORT_PRIVATE SimpleIndexFile {
       const SimpleIndexFile::IndexMetadata& index_metadata,
       const SimpleIndex::EntrySet& entries);
 
+  // Returns the pickle of one journal write, to be finished with
+  // SerializeFinalData() like the index.
+  static std::unique_ptr<base::Pickle> SerializeJournal(
+      net::CacheType cache_type,
+      const SimpleIndex::EntrySet& changed_entries,
+      const std::vector<uint64_t>& removed_hashes);
+
   // Appends cache modification time data to the serialized format. This is
   // performed on a thread accessing the disk. It is not combined with the main
   // serialization path to avoid extra thread hops or copying the pickle to the
@@ -171,14 +250,39 @@ class NET_EXPORT_PRIVATE SimpleIndexFile {
       const base::FilePath& cache_path,
       const EntryFileCallback& entry_file_callback);
 
-  // Writes the index file to disk atomically.
-  static void SyncWriteToDisk(net::CacheType cache_type,
-                              const base::FilePath& cache_directory,
-                              const base::FilePath& index_filename,
-                              const base::FilePath& temp_index_filename,
-                              std::unique_ptr<base::Pickle> pickle,
-                              const base::TimeTicks& start_time,
-                              bool app_on_background);
+  // Writes the index file to disk atomically. Sorts |entries| and fills in
+  // the modification time and the checksums of |header|.
+  static void SyncWriteToDisk(
+      net::CacheType cache_type,
+      const base::FilePath& cache_directory,
+      const base::FilePath& index_filename,
+      const base::FilePath& temp_index_filename,
+      SimpleIndexFileHeader header,
+      std::unique_ptr<std::vector<SimpleIndexFileEntry>> entries,
+      const base::TimeTicks& start_time,
+      bool app_on_background);
+
+  // Appends a journal write to |journal_filename| if |index_filename|
+  // exists.
+  static void SyncAppendToJournal(net::CacheType cache_type,
+                                  const base::FilePath& cache_directory,
+                                  const base::FilePath& index_filename,
+                                  const base::FilePath& journal_filename,
+                                  std::unique_ptr<base::Pickle> pickle,
+                                  const base::TimeTicks& start_time);
+
+  // Replays the valid writes of the journal |data| onto the entries of
+  // |out_result|, which were just loaded from the index. Stops at the first
+  // truncated or corrupt write. |out_cache_last_modified| is updated to the
+  // cache modification time seen by the last replayed write.
+  static void DeserializeJournal(net::CacheType cache_type,
+                                 const char* data,
+                                 int data_len,
+                                 base::Time* out_cache_last_modified,
+                                 SimpleIndexLoadResult* out_result);
+
+  // Returns the path of the journal of |index_filename|.
+  static base::FilePath GetJournalPath(const base::FilePath& index_filename);
 
   // Scan the index directory for entries, returning an EntrySet of all entries
   // found.
@@ -204,6 +308,7 @@ class NET_EXPORT_PRIVATE SimpleIndexFile {
   static const char kIndexDirectory[];
   static const char kIndexFileName[];
   static const char kTempIndexFileName[];
+  static const char kIndexJournalFileName[];
 
   DISALLOW_COPY_AND_ASSIGN(SimpleIndexFile);
 };
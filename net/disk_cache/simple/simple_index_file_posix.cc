@@ -54,6 +54,10 @@ bool SimpleIndexFile::TraverseCacheDirectory(
     const std::string file_name(entry->d_name);
     if (file_name == "." || file_name == "..")
       continue;
+    // Directories, e.g. the one holding the index, are never entry files, so
+    // don't stat() them when the file system reports their type.
+    if (entry->d_type == DT_DIR)
+      continue;
     const base::FilePath file_path = cache_path.Append(
         base::FilePath(file_name));
     base::File::Info file_info;
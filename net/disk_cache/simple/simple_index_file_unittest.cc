@@ -4,8 +4,11 @@
 
 #include "net/disk_cache/simple/simple_index_file.h"
 
+#include <algorithm>
 #include <memory>
+#include <string>
 
+#include "base/bind.h"
 #include "base/files/file.h"
 #include "base/files/file_util.h"
 #include "base/files/scoped_temp_dir.h"
@@ -54,7 +57,8 @@ TEST(IndexMetadataTest, Basics) {
   SimpleIndexFile::IndexMetadata index_metadata;
 
   EXPECT_EQ(disk_cache::kSimpleIndexMagicNumber, index_metadata.magic_number_);
-  EXPECT_EQ(disk_cache::kSimpleVersion, index_metadata.version_);
+  EXPECT_EQ(disk_cache::kSimpleIndexLastPickledVersion,
+            index_metadata.version_);
   EXPECT_EQ(0U, index_metadata.entry_count());
   EXPECT_EQ(0U, index_metadata.cache_size_);
 
@@ -154,6 +158,7 @@ class WrappedSimpleIndexFile : public SimpleIndexFile {
   using SimpleIndexFile::Deserialize;
   using SimpleIndexFile::LegacyIsIndexFileStale;
   using SimpleIndexFile::Serialize;
+  using SimpleIndexFile::SerializeJournal;
   using SimpleIndexFile::SerializeFinalData;
 
   explicit WrappedSimpleIndexFile(const base::FilePath& index_file_directory)
@@ -171,6 +176,10 @@ class WrappedSimpleIndexFile : public SimpleIndexFile {
     return temp_index_file_;
   }
 
+  base::FilePath GetJournalFilePath() const {
+    return GetJournalPath(index_file_);
+  }
+
   bool CreateIndexFileDirectory() const {
     return base::CreateDirectory(index_file_.DirName());
   }
@@ -486,6 +495,204 @@ TEST_F(SimpleIndexFileTest, WriteThenLoadIndex) {
     EXPECT_EQ(1U, load_index_result.entries.count(kHashes[i]));
 }
 
+// The index file is a table sorted by hash which can be looked up in place,
+// and is rejected if it is corrupt.
+TEST_F(SimpleIndexFileTest, WriteThenMapIndex) {
+  base::ScopedTempDir cache_dir;
+  ASSERT_TRUE(cache_dir.CreateUniqueTempDir());
+
+  SimpleIndex::EntrySet entries;
+  static const uint64_t kHashes[] = {33, 11, 22};
+  static const size_t kNumHashes = base::size(kHashes);
+  EntryMetadata metadata_entries[kNumHashes];
+  for (size_t i = 0; i < kNumHashes; ++i) {
+    metadata_entries[i] =
+        EntryMetadata(Time::Now(), static_cast<uint32_t>(kHashes[i] * 100));
+    metadata_entries[i].SetInMemoryData(static_cast<uint8_t>(i + 1));
+    SimpleIndex::InsertInEntrySet(kHashes[i], metadata_entries[i], &entries);
+  }
+
+  WrappedSimpleIndexFile simple_index_file(cache_dir.GetPath());
+  net::TestClosure closure;
+  simple_index_file.WriteToDisk(
+      net::DISK_CACHE, SimpleIndex::INDEX_WRITE_REASON_IDLE, entries, 6600u,
+      base::TimeTicks(), false, closure.closure());
+  closure.WaitForResult();
+
+  const base::FilePath& index_path = simple_index_file.GetIndexFilePath();
+  scoped_refptr<SimpleIndexMappedTable> table =
+      SimpleIndexMappedTable::Map(index_path);
+  ASSERT_TRUE(table);
+  EXPECT_EQ(kSimpleVersion, table->header().version);
+  EXPECT_EQ(static_cast<uint32_t>(SimpleIndex::INDEX_WRITE_REASON_IDLE),
+            table->header().reason);
+  EXPECT_EQ(kNumHashes, table->header().entry_count);
+  EXPECT_EQ(6600u, table->header().cache_size);
+  base::Time cache_mtime;
+  ASSERT_TRUE(simple_util::GetMTime(cache_dir.GetPath(), &cache_mtime));
+  EXPECT_EQ(cache_mtime, table->cache_last_modified());
+  EXPECT_TRUE(std::is_sorted(table->begin(), table->end(),
+                             [](const SimpleIndexFileEntry& a,
+                                const SimpleIndexFileEntry& b) {
+                               return a.hash < b.hash;
+                             }));
+  for (size_t i = 0; i < kNumHashes; ++i) {
+    EntryMetadata metadata;
+    ASSERT_TRUE(table->Find(kHashes[i], &metadata));
+    EXPECT_TRUE(CompareTwoEntryMetadata(metadata, metadata_entries[i]));
+  }
+  EXPECT_FALSE(table->Find(44, nullptr));
+  table = nullptr;
+
+  std::string contents;
+  ASSERT_TRUE(base::ReadFileToString(index_path, &contents));
+  std::string corrupt_contents = contents;
+  corrupt_contents.back() ^= 1;
+  ASSERT_EQ(static_cast<int>(corrupt_contents.size()),
+            base::WriteFile(index_path, corrupt_contents.data(),
+                            corrupt_contents.size()));
+  EXPECT_FALSE(SimpleIndexMappedTable::Map(index_path));
+
+  ASSERT_EQ(static_cast<int>(contents.size() - 1),
+            base::WriteFile(index_path, contents.data(), contents.size() - 1));
+  EXPECT_FALSE(SimpleIndexMappedTable::Map(index_path));
+}
+
+// A fresh index file is handed out as soon as it is mapped, unless a journal
+// modifies it.
+TEST_F(SimpleIndexFileTest, LoadIndexEntriesMapsFreshIndex) {
+  base::ScopedTempDir cache_dir;
+  ASSERT_TRUE(cache_dir.CreateUniqueTempDir());
+
+  SimpleIndex::EntrySet entries;
+  SimpleIndex::InsertInEntrySet(11, EntryMetadata(Time(), 1000u), &entries);
+  WrappedSimpleIndexFile simple_index_file(cache_dir.GetPath());
+  net::TestClosure closure;
+  simple_index_file.WriteToDisk(
+      net::DISK_CACHE, SimpleIndex::INDEX_WRITE_REASON_IDLE, entries, 1000u,
+      base::TimeTicks(), false, closure.closure());
+  closure.WaitForResult();
+
+  base::Time fake_cache_mtime;
+  ASSERT_TRUE(simple_util::GetMTime(cache_dir.GetPath(), &fake_cache_mtime));
+  scoped_refptr<SimpleIndexMappedTable> table;
+  SimpleIndexLoadResult load_index_result;
+  load_index_result.table_mapped_callback = base::BindOnce(
+      [](scoped_refptr<SimpleIndexMappedTable>* out_table,
+         scoped_refptr<SimpleIndexMappedTable> table) {
+        *out_table = std::move(table);
+      },
+      &table);
+  simple_index_file.LoadIndexEntries(fake_cache_mtime, closure.closure(),
+                                     &load_index_result);
+  closure.WaitForResult();
+
+  EXPECT_TRUE(load_index_result.did_load);
+  EXPECT_EQ(1u, load_index_result.entries.count(11));
+  ASSERT_TRUE(table);
+  EXPECT_TRUE(table->Find(11, nullptr));
+  table = nullptr;
+
+  simple_index_file.WriteJournalToDisk(net::DISK_CACHE,
+                                       SimpleIndex::EntrySet(), {11},
+                                       base::TimeTicks(), closure.closure());
+  closure.WaitForResult();
+  ASSERT_TRUE(simple_util::GetMTime(cache_dir.GetPath(), &fake_cache_mtime));
+  SimpleIndexLoadResult journaled_load_result;
+  bool callback_ran = false;
+  journaled_load_result.table_mapped_callback = base::BindOnce(
+      [](bool* callback_ran, scoped_refptr<SimpleIndexMappedTable> table) {
+        *callback_ran = true;
+      },
+      &callback_ran);
+  simple_index_file.LoadIndexEntries(fake_cache_mtime, closure.closure(),
+                                     &journaled_load_result);
+  closure.WaitForResult();
+
+  EXPECT_TRUE(journaled_load_result.did_load);
+  EXPECT_EQ(0u, journaled_load_result.entries.count(11));
+  EXPECT_FALSE(callback_ran);
+}
+
+// Journal writes are replayed onto the index when loading it, up to the first
+// one which is truncated. A full write drops the journal.
+TEST_F(SimpleIndexFileTest, WriteJournalThenLoadIndex) {
+  base::ScopedTempDir cache_dir;
+  ASSERT_TRUE(cache_dir.CreateUniqueTempDir());
+
+  SimpleIndex::EntrySet entries;
+  for (uint64_t hash : {11, 22, 33})
+    SimpleIndex::InsertInEntrySet(hash, EntryMetadata(Time(), 1000u), &entries);
+  SimpleIndex::EntrySet changed_entries;
+  SimpleIndex::InsertInEntrySet(22, EntryMetadata(Time(), 2000u),
+                                &changed_entries);
+  SimpleIndex::InsertInEntrySet(44, EntryMetadata(Time(), 3000u),
+                                &changed_entries);
+
+  WrappedSimpleIndexFile simple_index_file(cache_dir.GetPath());
+  net::TestClosure closure;
+  simple_index_file.WriteToDisk(
+      net::DISK_CACHE, SimpleIndex::INDEX_WRITE_REASON_IDLE, entries, 3000u,
+      base::TimeTicks(), false, closure.closure());
+  closure.WaitForResult();
+  simple_index_file.WriteJournalToDisk(net::DISK_CACHE, changed_entries, {11},
+                                       base::TimeTicks(), closure.closure());
+  closure.WaitForResult();
+  ASSERT_TRUE(base::PathExists(simple_index_file.GetJournalFilePath()));
+
+  // Simulate an interrupted write.
+  SimpleIndex::EntrySet ignored_entries;
+  SimpleIndex::InsertInEntrySet(55, EntryMetadata(Time(), 1000u),
+                                &ignored_entries);
+  std::unique_ptr<base::Pickle> torn_write = WrappedSimpleIndexFile::
+      SerializeJournal(net::DISK_CACHE, ignored_entries, {33});
+  WrappedSimpleIndexFile::SerializeFinalData(Time::Now(), torn_write.get());
+  ASSERT_TRUE(base::AppendToFile(simple_index_file.GetJournalFilePath(),
+                                 static_cast<const char*>(torn_write->data()),
+                                 torn_write->size() - 1));
+
+  base::Time fake_cache_mtime;
+  ASSERT_TRUE(simple_util::GetMTime(cache_dir.GetPath(), &fake_cache_mtime));
+  SimpleIndexLoadResult load_index_result;
+  simple_index_file.LoadIndexEntries(fake_cache_mtime, closure.closure(),
+                                     &load_index_result);
+  closure.WaitForResult();
+
+  EXPECT_TRUE(load_index_result.did_load);
+  EXPECT_FALSE(load_index_result.flush_required);
+  EXPECT_EQ(3u, load_index_result.journal_entry_count);
+  const SimpleIndex::EntrySet& loaded = load_index_result.entries;
+  EXPECT_EQ(3u, loaded.size());
+  EXPECT_EQ(0u, loaded.count(11));
+  ASSERT_EQ(1u, loaded.count(22));
+  EXPECT_EQ(RoundSize(2000u), loaded.find(22)->second.GetEntrySize());
+  EXPECT_EQ(1u, loaded.count(33));
+  ASSERT_EQ(1u, loaded.count(44));
+  EXPECT_EQ(RoundSize(3000u), loaded.find(44)->second.GetEntrySize());
+
+  simple_index_file.WriteToDisk(
+      net::DISK_CACHE, SimpleIndex::INDEX_WRITE_REASON_IDLE, loaded, 6000u,
+      base::TimeTicks(), false, closure.closure());
+  closure.WaitForResult();
+  EXPECT_TRUE(base::PathExists(simple_index_file.GetIndexFilePath()));
+  EXPECT_FALSE(base::PathExists(simple_index_file.GetJournalFilePath()));
+}
+
+// Journal writes are dropped if there is no index file to extend.
+TEST_F(SimpleIndexFileTest, WriteJournalWithoutIndex) {
+  base::ScopedTempDir cache_dir;
+  ASSERT_TRUE(cache_dir.CreateUniqueTempDir());
+
+  WrappedSimpleIndexFile simple_index_file(cache_dir.GetPath());
+  ASSERT_TRUE(simple_index_file.CreateIndexFileDirectory());
+  net::TestClosure closure;
+  simple_index_file.WriteJournalToDisk(net::DISK_CACHE,
+                                       SimpleIndex::EntrySet(), {11},
+                                       base::TimeTicks(), closure.closure());
+  closure.WaitForResult();
+  EXPECT_FALSE(base::PathExists(simple_index_file.GetJournalFilePath()));
+}
+
 TEST_F(SimpleIndexFileTest, LoadCorruptIndex) {
   base::ScopedTempDir cache_dir;
   ASSERT_TRUE(cache_dir.CreateUniqueTempDir());
@@ -606,14 +813,10 @@ TEST_F(SimpleIndexFileTest, SimpleCacheUpgrade) {
   EXPECT_TRUE(base::PathExists(index_file_path));
 
   // Verify that the version of the index file is correct.
-  std::string contents;
-  EXPECT_TRUE(base::ReadFileToString(index_file_path, &contents));
-  base::Time when_index_last_saw_cache;
-  SimpleIndexLoadResult deserialize_result;
-  WrappedSimpleIndexFile::Deserialize(
-      net::DISK_CACHE, contents.data(), contents.size(),
-      &when_index_last_saw_cache, &deserialize_result);
-  EXPECT_TRUE(deserialize_result.did_load);
+  scoped_refptr<SimpleIndexMappedTable> table =
+      SimpleIndexMappedTable::Map(index_file_path);
+  ASSERT_TRUE(table);
+  EXPECT_EQ(kSimpleVersion, table->header().version);
 }
 
 TEST_F(SimpleIndexFileTest, OverwritesStaleTempFile) {
@@ -0,0 +1,54 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef NET_DISK_CACHE_SIMPLE_SIMPLE_INDEX_FORMAT_H_
+#define NET_DISK_CACHE_SIMPLE_SIMPLE_INDEX_FORMAT_H_
+
+#include <stdint.h>
+
+namespace disk_cache {
+
+// Since version 10, the index file is a SimpleIndexFileHeader followed by
+// |entry_count| SimpleIndexFileEntry records sorted by hash, so that entries
+// can be looked up in place once the file is mapped, see
+// SimpleIndexMappedTable. Both structures are written in the native byte
+// order and have no padding. Versions 6 to 9 used a pickle, still read by
+// SimpleIndexFile::Deserialize().
+
+const uint64_t kSimpleIndexTableMagicNumber = UINT64_C(0x656c626174786469);
+
+struct SimpleIndexFileHeader {
+  uint64_t magic_number = kSimpleIndexTableMagicNumber;
+  uint32_t version = 0;
+  // A SimpleIndex::IndexWriteToDiskReason.
+  uint32_t reason = 0;
+  uint64_t entry_count = 0;
+  // Total cache storage size in bytes.
+  uint64_t cache_size = 0;
+  // Internal value of the base::Time of the last modification of the cache
+  // directory seen by the writer.
+  int64_t cache_last_modified = 0;
+  // CRC-32 of the records.
+  uint32_t table_crc = 0;
+  // CRC-32 of the fields above.
+  uint32_t header_crc = 0;
+};
+static_assert(sizeof(SimpleIndexFileHeader) == 48,
+              "the index file header must have no padding");
+
+struct SimpleIndexFileEntry {
+  uint64_t hash = 0;
+  // Seconds since the epoch of the last use, or the trailer prefetch size in
+  // APP_CACHE mode, as in EntryMetadata.
+  uint32_t last_used_time_or_trailer_prefetch_size = 0;
+  // The size of the entry in 256-byte blocks in the lower 24 bits, and its
+  // in-memory data in the upper 8 bits.
+  uint32_t size_and_in_memory_data = 0;
+};
+static_assert(sizeof(SimpleIndexFileEntry) == 16,
+              "the index file records must have no padding");
+
+}  // namespace disk_cache
+
+#endif  // NET_DISK_CACHE_SIMPLE_SIMPLE_INDEX_FORMAT_H_
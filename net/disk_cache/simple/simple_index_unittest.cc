@@ -21,8 +21,10 @@
 #include "base/test/mock_entropy_provider.h"
 #include "base/test/scoped_feature_list.h"
 #include "base/threading/platform_thread.h"
+#include "base/threading/thread_task_runner_handle.h"
 #include "base/time/time.h"
 #include "net/base/cache_type.h"
+#include "net/base/test_completion_callback.h"
 #include "net/disk_cache/backend_cleanup_tracker.h"
 #include "net/disk_cache/simple/simple_index_delegate.h"
 #include "net/disk_cache/simple/simple_index_file.h"
@@ -88,6 +90,16 @@ class MockSimpleIndexFile : public SimpleIndexFile,
     disk_write_entry_set_ = entry_set;
   }
 
+  void WriteJournalToDisk(net::CacheType cache_type,
+                          const SimpleIndex::EntrySet& changed_entries,
+                          const std::vector<uint64_t>& removed_hashes,
+                          const base::TimeTicks& start,
+                          const base::Closure& callback) override {
+    journal_writes_++;
+    journal_changed_entries_ = changed_entries;
+    journal_removed_hashes_ = removed_hashes;
+  }
+
   void GetAndResetDiskWriteEntrySet(SimpleIndex::EntrySet* entry_set) {
     entry_set->swap(disk_write_entry_set_);
   }
@@ -96,6 +108,13 @@ class MockSimpleIndexFile : public SimpleIndexFile,
   SimpleIndexLoadResult* load_result() const { return load_result_; }
   int load_index_entries_calls() const { return load_index_entries_calls_; }
   int disk_writes() const { return disk_writes_; }
+  int journal_writes() const { return journal_writes_; }
+  const SimpleIndex::EntrySet& journal_changed_entries() const {
+    return journal_changed_entries_;
+  }
+  const std::vector<uint64_t>& journal_removed_hashes() const {
+    return journal_removed_hashes_;
+  }
 
  private:
   base::Closure load_callback_;
@@ -103,6 +122,9 @@ class MockSimpleIndexFile : public SimpleIndexFile,
   int load_index_entries_calls_ = 0;
   int disk_writes_ = 0;
   SimpleIndex::EntrySet disk_write_entry_set_;
+  int journal_writes_ = 0;
+  SimpleIndex::EntrySet journal_changed_entries_;
+  std::vector<uint64_t> journal_removed_hashes_;
 };
 
 class SimpleIndexTest : public net::TestWithScopedTaskEnvironment,
@@ -165,6 +187,10 @@ class SimpleIndexTest : public net::TestWithScopedTaskEnvironment,
     index_file_->load_callback().Run();
   }
 
+  void UseMappedTable(scoped_refptr<SimpleIndexMappedTable> table) {
+    index_->UseMappedTable(std::move(table));
+  }
+
   // Non-const for timer manipulation.
   SimpleIndex* index() { return index_.get(); }
   const MockSimpleIndexFile* index_file() const { return index_file_.get(); }
@@ -192,6 +218,14 @@ class SimpleIndexAppCacheTest : public SimpleIndexTest {
   net::CacheType CacheType() const override { return net::APP_CACHE; }
 };
 
+class SimpleIndexJournalTest : public SimpleIndexTest {
+ protected:
+  void SetUp() override {
+    scoped_feature_list_.InitAndEnableFeature(kSimpleCacheIndexJournal);
+    SimpleIndexTest::SetUp();
+  }
+};
+
 TEST_F(EntryMetadataTest, Basics) {
   EntryMetadata entry_metadata;
   EXPECT_EQ(base::Time(), entry_metadata.GetLastUsedTime());
@@ -468,6 +502,53 @@ TEST_F(SimpleIndexTest, RemoveBeforeInit) {
   EXPECT_FALSE(index()->Has(kHash1));
 }
 
+// Before the index is loaded, lookups are answered from the mapped index file
+// and the changes made since startup.
+TEST_F(SimpleIndexTest, LookupsBeforeInitFromMappedTable) {
+  base::ScopedTempDir cache_dir;
+  ASSERT_TRUE(cache_dir.CreateUniqueTempDir());
+  SimpleIndex::EntrySet entries;
+  for (uint64_t hash : {hashes_.at<1>(), hashes_.at<2>()}) {
+    SimpleIndex::InsertInEntrySet(
+        hash, EntryMetadata(kTestLastUsedTime, kTestEntrySize), &entries);
+  }
+  SimpleIndexFile index_file(base::ThreadTaskRunnerHandle::Get(),
+                             base::ThreadTaskRunnerHandle::Get(),
+                             net::DISK_CACHE, cache_dir.GetPath());
+  net::TestClosure closure;
+  index_file.WriteToDisk(net::DISK_CACHE, SimpleIndex::INDEX_WRITE_REASON_IDLE,
+                         entries, 2 * kTestEntrySize, base::TimeTicks(), false,
+                         closure.closure());
+  closure.WaitForResult();
+  scoped_refptr<SimpleIndexMappedTable> table = SimpleIndexMappedTable::Map(
+      cache_dir.GetPath().AppendASCII("index-dir").AppendASCII(
+          "the-real-index"));
+  ASSERT_TRUE(table);
+
+  EXPECT_FALSE(index()->CanAnswerLookups());
+  UseMappedTable(table);
+  EXPECT_TRUE(index()->CanAnswerLookups());
+  EXPECT_TRUE(index()->Has(hashes_.at<1>()));
+  EXPECT_TRUE(index()->Has(hashes_.at<2>()));
+  EXPECT_FALSE(index()->Has(hashes_.at<3>()));
+  EXPECT_FALSE(index()->UseIfExists(hashes_.at<3>()));
+  EXPECT_LT(kTestLastUsedTime - base::TimeDelta::FromSeconds(2),
+            index()->GetLastUsedTime(hashes_.at<1>()));
+  EXPECT_GT(kTestLastUsedTime + base::TimeDelta::FromSeconds(2),
+            index()->GetLastUsedTime(hashes_.at<1>()));
+
+  index()->Remove(hashes_.at<2>());
+  EXPECT_FALSE(index()->Has(hashes_.at<2>()));
+  index()->Insert(hashes_.at<3>());
+  EXPECT_TRUE(index()->Has(hashes_.at<3>()));
+
+  // The loaded entries replace the mapped index file.
+  ReturnIndexFile();
+  EXPECT_TRUE(index()->CanAnswerLookups());
+  EXPECT_FALSE(index()->Has(hashes_.at<1>()));
+  EXPECT_TRUE(index()->Has(hashes_.at<3>()));
+}
+
 // Insert something that's going to come in from the loaded index; correct
 // result?
 TEST_F(SimpleIndexTest, InsertBeforeInit) {
@@ -795,6 +876,59 @@ TEST_F(SimpleIndexTest, DiskWritePostponed) {
   index()->write_to_disk_timer_.Stop();
 }
 
+// Small sets of changes are appended to the journal of a loaded index, until
+// they add up to too large a part of the entries.
+TEST_F(SimpleIndexJournalTest, DiskWriteJournaled) {
+  const uint64_t kHash1 = hashes_.at<1>();
+  const uint64_t kHash2 = hashes_.at<2>();
+  const uint64_t kHash3 = hashes_.at<3>();
+  // 23 entries are left after the removal, which allows journaling changes to
+  // two of them.
+  for (size_t i = 0; i < 24; ++i)
+    InsertIntoIndexFileReturn(HashesInitializer(i), base::Time::Now(), 10);
+  index_file_->load_result()->init_method =
+      SimpleIndex::INITIALIZE_METHOD_LOADED;
+  ReturnIndexFile();
+
+  index()->UseIfExists(kHash1);
+  index()->Remove(kHash2);
+  index()->WriteToDisk(SimpleIndex::INDEX_WRITE_REASON_IDLE);
+  EXPECT_EQ(0, index_file_->disk_writes());
+  ASSERT_EQ(1, index_file_->journal_writes());
+  ASSERT_EQ(1u, index_file_->journal_changed_entries().size());
+  EXPECT_EQ(kHash1, index_file_->journal_changed_entries().begin()->first);
+  EXPECT_EQ(std::vector<uint64_t>({kHash2}),
+            index_file_->journal_removed_hashes());
+
+  // The journal would now hold changes to three entries out of 23.
+  index()->UseIfExists(kHash3);
+  index()->WriteToDisk(SimpleIndex::INDEX_WRITE_REASON_IDLE);
+  EXPECT_EQ(1, index_file_->disk_writes());
+  EXPECT_EQ(1, index_file_->journal_writes());
+
+  // The full write started a new journal.
+  index()->UseIfExists(kHash3);
+  index()->WriteToDisk(SimpleIndex::INDEX_WRITE_REASON_SHUTDOWN);
+  EXPECT_EQ(1, index_file_->disk_writes());
+  EXPECT_EQ(2, index_file_->journal_writes());
+  EXPECT_EQ(1u, index_file_->journal_changed_entries().count(kHash3));
+  EXPECT_TRUE(index_file_->journal_removed_hashes().empty());
+}
+
+// An index which wasn't loaded from disk is written in full first.
+TEST_F(SimpleIndexJournalTest, DiskWriteNotJournaledWithoutIndexFile) {
+  for (size_t i = 0; i < 24; ++i)
+    InsertIntoIndexFileReturn(HashesInitializer(i), base::Time::Now(), 10);
+  index_file_->load_result()->init_method =
+      SimpleIndex::INITIALIZE_METHOD_RECOVERED;
+  ReturnIndexFile();
+
+  index()->UseIfExists(hashes_.at<1>());
+  index()->WriteToDisk(SimpleIndex::INDEX_WRITE_REASON_IDLE);
+  EXPECT_EQ(1, index_file_->disk_writes());
+  EXPECT_EQ(0, index_file_->journal_writes());
+}
+
 // net::APP_CACHE mode should not need to queue disk writes in as many places
 // as the default net::DISK_CACHE mode.
 TEST_F(SimpleIndexAppCacheTest, DiskWriteQueued) {
@@ -0,0 +1,355 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef NET_DISK_CACHE_SIMPLE_SIMPLE_SHARDED_MAP_H_
+#define NET_DISK_CACHE_SIMPLE_SIMPLE_SHARDED_MAP_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <algorithm>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+#include "base/logging.h"
+
+namespace disk_cache {
+
+// A hash map from entry hashes to |T|, used for the entries of the simple
+// cache index. It is a drop-in replacement for the subset of
+// std::unordered_map<uint64_t, T> the index uses.
+//
+// The entries are split over kNumShards shards by the top bits of the mixed
+// hash, and each shard is an open-addressed table with linear probing. There
+// is no allocation per entry, and a lookup usually touches a single cache
+// line, which matters for indexes of a million entries.
+//
+// Like the index, the map is not thread-safe.
+//
+// As for std::unordered_map, insertions may invalidate iterators and pointers
+// to the values, and the iteration order is unspecified. Unlike it, erasing
+// invalidates iterators too, so erase() doesn't return one.
+template <typename T>
+class SimpleShardedMap {
+ public:
+  using key_type = uint64_t;
+  using mapped_type = T;
+  using value_type = std::pair<uint64_t, T>;
+  using size_type = size_t;
+
+  static constexpr size_t kNumShards = 16;
+
+  template <typename MapType, typename ValueType>
+  class IteratorImpl {
+   public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = typename SimpleShardedMap::value_type;
+    using difference_type = ptrdiff_t;
+    using pointer = ValueType*;
+    using reference = ValueType&;
+
+    IteratorImpl() = default;
+    // Allows converting an iterator to a const_iterator.
+    template <typename OtherMapType, typename OtherValueType>
+    IteratorImpl(const IteratorImpl<OtherMapType, OtherValueType>& other)
+        : map_(other.map_), shard_(other.shard_), slot_(other.slot_) {}
+
+    reference operator*() const {
+      return map_->shards_[shard_].slots[slot_];
+    }
+    pointer operator->() const { return &**this; }
+
+    IteratorImpl& operator++() {
+      ++slot_;
+      SkipEmptySlots();
+      return *this;
+    }
+    IteratorImpl operator++(int) {
+      IteratorImpl old = *this;
+      ++*this;
+      return old;
+    }
+
+    template <typename OtherMapType, typename OtherValueType>
+    bool operator==(
+        const IteratorImpl<OtherMapType, OtherValueType>& other) const {
+      return shard_ == other.shard_ && slot_ == other.slot_;
+    }
+    template <typename OtherMapType, typename OtherValueType>
+    bool operator!=(
+        const IteratorImpl<OtherMapType, OtherValueType>& other) const {
+      return !(*this == other);
+    }
+
+   private:
+    friend class SimpleShardedMap;
+    template <typename, typename>
+    friend class IteratorImpl;
+
+    IteratorImpl(MapType* map, size_t shard, size_t slot)
+        : map_(map), shard_(shard), slot_(slot) {}
+
+    // Moves forward to the next occupied slot, or to end().
+    void SkipEmptySlots() {
+      while (shard_ < kNumShards) {
+        const Shard& shard = map_->shards_[shard_];
+        while (slot_ < shard.occupied.size()) {
+          if (shard.occupied[slot_])
+            return;
+          ++slot_;
+        }
+        ++shard_;
+        slot_ = 0;
+      }
+    }
+
+    MapType* map_ = nullptr;
+    // end() is {kNumShards, 0}.
+    size_t shard_ = kNumShards;
+    size_t slot_ = 0;
+  };
+
+  using iterator = IteratorImpl<SimpleShardedMap, value_type>;
+  using const_iterator =
+      IteratorImpl<const SimpleShardedMap, const value_type>;
+
+  SimpleShardedMap() = default;
+
+  SimpleShardedMap(const SimpleShardedMap& other) { CopyFrom(other); }
+
+  SimpleShardedMap& operator=(const SimpleShardedMap& other) {
+    if (this != &other) {
+      SimpleShardedMap copy(other);
+      swap(copy);
+    }
+    return *this;
+  }
+
+  ~SimpleShardedMap() = default;
+
+  iterator begin() {
+    iterator it(this, 0, 0);
+    it.SkipEmptySlots();
+    return it;
+  }
+  const_iterator begin() const {
+    const_iterator it(this, 0, 0);
+    it.SkipEmptySlots();
+    return it;
+  }
+  iterator end() { return iterator(this, kNumShards, 0); }
+  const_iterator end() const { return const_iterator(this, kNumShards, 0); }
+
+  size_t size() const { return size_; }
+  bool empty() const { return size_ == 0; }
+
+  iterator find(uint64_t key) {
+    const uint64_t mixed = Mix(key);
+    const size_t shard_index = ShardIndex(mixed);
+    size_t slot;
+    if (!shards_[shard_index].Find(key, mixed, &slot))
+      return end();
+    return iterator(this, shard_index, slot);
+  }
+  const_iterator find(uint64_t key) const {
+    const uint64_t mixed = Mix(key);
+    const size_t shard_index = ShardIndex(mixed);
+    size_t slot;
+    if (!shards_[shard_index].Find(key, mixed, &slot))
+      return end();
+    return const_iterator(this, shard_index, slot);
+  }
+
+  size_t count(uint64_t key) const { return find(key) != end() ? 1 : 0; }
+
+  // Inserts |value| unless its key is already present. Returns an iterator to
+  // the entry with the key, and whether it was inserted.
+  std::pair<iterator, bool> insert(const value_type& value) {
+    const uint64_t mixed = Mix(value.first);
+    const size_t shard_index = ShardIndex(mixed);
+    Shard& shard = shards_[shard_index];
+    size_t slot;
+    if (shard.Find(value.first, mixed, &slot))
+      return std::make_pair(iterator(this, shard_index, slot), false);
+
+    if (NeedsGrowth(shard.size + 1, shard.occupied.size()))
+      shard.Rehash(std::max(kMinShardCapacity, shard.occupied.size() * 2));
+    slot = shard.EmptySlotFor(mixed);
+    shard.slots[slot] = value;
+    shard.occupied[slot] = 1;
+    ++shard.size;
+    ++size_;
+    return std::make_pair(iterator(this, shard_index, slot), true);
+  }
+
+  void erase(const_iterator it) {
+    DCHECK(it != end());
+    shards_[it.shard_].EraseSlot(it.slot_);
+    --size_;
+  }
+
+  size_t erase(uint64_t key) {
+    const_iterator it = find(key);
+    if (it == end())
+      return 0;
+    erase(it);
+    return 1;
+  }
+
+  void clear() {
+    for (Shard& shard : shards_) {
+      shard.slots.clear();
+      shard.slots.shrink_to_fit();
+      shard.occupied.clear();
+      shard.occupied.shrink_to_fit();
+      shard.size = 0;
+    }
+    size_ = 0;
+  }
+
+  // Makes room for |count| entries in total, assuming the keys are evenly
+  // distributed over the shards.
+  void reserve(size_t count) {
+    // Leave some headroom for the unevenness of the distribution.
+    const size_t per_shard = count / kNumShards + count / (kNumShards * 8) + 1;
+    for (Shard& shard : shards_) {
+      size_t capacity = std::max(kMinShardCapacity, shard.occupied.size());
+      while (NeedsGrowth(per_shard, capacity))
+        capacity *= 2;
+      if (capacity != shard.occupied.size())
+        shard.Rehash(capacity);
+    }
+  }
+
+  void swap(SimpleShardedMap& other) {
+    if (this == &other)
+      return;
+    for (size_t i = 0; i < kNumShards; ++i) {
+      shards_[i].slots.swap(other.shards_[i].slots);
+      shards_[i].occupied.swap(other.shards_[i].occupied);
+      std::swap(shards_[i].size, other.shards_[i].size);
+    }
+    std::swap(size_, other.size_);
+  }
+
+  // Returns the estimate of dynamically allocated memory in bytes.
+  size_t EstimateMemoryUsage() const {
+    size_t usage = 0;
+    for (const Shard& shard : shards_) {
+      usage += shard.slots.capacity() * sizeof(value_type) +
+               shard.occupied.capacity();
+    }
+    return usage;
+  }
+
+ private:
+  static constexpr size_t kMinShardCapacity = 16;
+
+  struct Shard {
+    // Returns whether |key| is present, and its slot in |slot| if so.
+    bool Find(uint64_t key, uint64_t mixed, size_t* slot) const {
+      if (occupied.empty())
+        return false;
+      const size_t mask = occupied.size() - 1;
+      for (size_t i = mixed & mask;; i = (i + 1) & mask) {
+        if (!occupied[i])
+          return false;
+        if (slots[i].first == key) {
+          *slot = i;
+          return true;
+        }
+      }
+    }
+
+    // Returns the first empty slot of the probe sequence of |mixed|.
+    size_t EmptySlotFor(uint64_t mixed) const {
+      const size_t mask = occupied.size() - 1;
+      size_t i = mixed & mask;
+      while (occupied[i])
+        i = (i + 1) & mask;
+      return i;
+    }
+
+    // Moves all the entries to a table of |capacity| slots, a power of two.
+    void Rehash(size_t capacity) {
+      DCHECK_EQ(0u, capacity & (capacity - 1));
+      DCHECK(!NeedsGrowth(size, capacity));
+      std::vector<value_type> old_slots(capacity);
+      std::vector<uint8_t> old_occupied(capacity, 0);
+      old_slots.swap(slots);
+      old_occupied.swap(occupied);
+      for (size_t i = 0; i < old_occupied.size(); ++i) {
+        if (!old_occupied[i])
+          continue;
+        const size_t slot = EmptySlotFor(Mix(old_slots[i].first));
+        slots[slot] = std::move(old_slots[i]);
+        occupied[slot] = 1;
+      }
+    }
+
+    // Empties |slot|, then shifts back the following entries of the cluster
+    // which would no longer be reachable from their home slot, so that no
+    // tombstones are needed.
+    void EraseSlot(size_t slot) {
+      const size_t mask = occupied.size() - 1;
+      size_t hole = slot;
+      for (size_t i = (slot + 1) & mask; occupied[i]; i = (i + 1) & mask) {
+        const size_t home = Mix(slots[i].first) & mask;
+        // The entry at |i| can move to |hole| unless its home slot is
+        // cyclically in (hole, i].
+        const bool home_after_hole =
+            hole <= i ? (hole < home && home <= i) : (hole < home || home <= i);
+        if (home_after_hole)
+          continue;
+        slots[hole] = std::move(slots[i]);
+        hole = i;
+      }
+      occupied[hole] = 0;
+      slots[hole] = value_type();
+      --size;
+    }
+
+    std::vector<value_type> slots;
+    std::vector<uint8_t> occupied;
+    size_t size = 0;
+  };
+
+  // Entry hashes are usually already well distributed, but tests and some
+  // callers use small consecutive values: the Fibonacci multiplier spreads
+  // them over the shards (top bits) and keeps them distinct in the low bits
+  // used for the slots.
+  static uint64_t Mix(uint64_t key) {
+    return key * UINT64_C(0x9e3779b97f4a7c15);
+  }
+  static size_t ShardIndex(uint64_t mixed) {
+    static_assert(kNumShards == 16, "ShardIndex() out of date");
+    return static_cast<size_t>(mixed >> 60);
+  }
+  // The load factor is kept under 3/4.
+  static bool NeedsGrowth(size_t size, size_t capacity) {
+    return size * 4 > capacity * 3;
+  }
+
+  void CopyFrom(const SimpleShardedMap& other) {
+    for (size_t i = 0; i < kNumShards; ++i) {
+      shards_[i].slots = other.shards_[i].slots;
+      shards_[i].occupied = other.shards_[i].occupied;
+      shards_[i].size = other.shards_[i].size;
+    }
+    size_ = other.size_;
+  }
+
+  Shard shards_[kNumShards];
+  size_t size_ = 0;
+};
+
+template <typename T>
+constexpr size_t SimpleShardedMap<T>::kNumShards;
+template <typename T>
+constexpr size_t SimpleShardedMap<T>::kMinShardCapacity;
+
+}  // namespace disk_cache
+
+#endif  // NET_DISK_CACHE_SIMPLE_SIMPLE_SHARDED_MAP_H_
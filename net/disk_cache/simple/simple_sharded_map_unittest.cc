@@ -0,0 +1,125 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "net/disk_cache/simple/simple_sharded_map.h"
+
+#include <stdint.h>
+
+#include <unordered_map>
+#include <vector>
+
+#include "base/rand_util.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace disk_cache {
+namespace {
+
+using TestMap = SimpleShardedMap<int>;
+
+// Checks that |map| has the same contents as |expected|, through both lookups
+// and iteration.
+void ExpectSameContents(const std::unordered_map<uint64_t, int>& expected,
+                        const TestMap& map) {
+  ASSERT_EQ(expected.size(), map.size());
+  for (const auto& entry : expected) {
+    auto it = map.find(entry.first);
+    ASSERT_TRUE(it != map.end());
+    EXPECT_EQ(entry.second, it->second);
+  }
+  size_t iterated = 0;
+  for (const auto& entry : map) {
+    ++iterated;
+    auto it = expected.find(entry.first);
+    ASSERT_TRUE(it != expected.end());
+    EXPECT_EQ(it->second, entry.second);
+  }
+  EXPECT_EQ(expected.size(), iterated);
+}
+
+TEST(SimpleShardedMapTest, Basics) {
+  TestMap map;
+  EXPECT_TRUE(map.empty());
+  EXPECT_TRUE(map.begin() == map.end());
+  EXPECT_TRUE(map.find(0) == map.end());
+
+  auto result = map.insert(TestMap::value_type(0, 10));
+  EXPECT_TRUE(result.second);
+  EXPECT_EQ(0u, result.first->first);
+  EXPECT_EQ(10, result.first->second);
+
+  // The existing value is kept.
+  result = map.insert(TestMap::value_type(0, 20));
+  EXPECT_FALSE(result.second);
+  EXPECT_EQ(10, result.first->second);
+  result.first->second = 30;
+  EXPECT_EQ(30, map.find(0)->second);
+  EXPECT_EQ(1u, map.size());
+  EXPECT_EQ(1u, map.count(0));
+  EXPECT_EQ(0u, map.count(1));
+
+  EXPECT_EQ(0u, map.erase(1));
+  EXPECT_EQ(1u, map.erase(0));
+  EXPECT_TRUE(map.empty());
+}
+
+// Runs random insertions and removals of consecutive and random keys, which
+// exercise long probe sequences and the backward shift on removal.
+TEST(SimpleShardedMapTest, MatchesUnorderedMap) {
+  std::unordered_map<uint64_t, int> expected;
+  TestMap map;
+  for (int i = 0; i < 20000; ++i) {
+    uint64_t key = base::RandInt(0, 3) ? base::RandInt(0, 2000)
+                                       : base::RandUint64();
+    if (base::RandInt(0, 2)) {
+      bool inserted = expected.insert(std::make_pair(key, i)).second;
+      EXPECT_EQ(inserted, map.insert(TestMap::value_type(key, i)).second);
+    } else {
+      EXPECT_EQ(expected.erase(key), map.erase(key));
+    }
+  }
+  ExpectSameContents(expected, map);
+
+  // Erase through iterators too.
+  for (uint64_t key = 0; key <= 2000; key += 3) {
+    auto it = map.find(key);
+    if (it != map.end())
+      map.erase(it);
+    expected.erase(key);
+  }
+  ExpectSameContents(expected, map);
+}
+
+TEST(SimpleShardedMapTest, CopySwapClear) {
+  std::unordered_map<uint64_t, int> expected;
+  TestMap map;
+  map.reserve(1000);
+  const size_t reserved_usage = map.EstimateMemoryUsage();
+  for (int i = 0; i < 1000; ++i) {
+    expected[i] = i;
+    map.insert(TestMap::value_type(i, i));
+  }
+  // No rehash with reasonably distributed keys.
+  EXPECT_EQ(reserved_usage, map.EstimateMemoryUsage());
+
+  TestMap copy(map);
+  ExpectSameContents(expected, copy);
+
+  TestMap other;
+  other.insert(TestMap::value_type(5000, 1));
+  other.swap(map);
+  ExpectSameContents(expected, other);
+  ExpectSameContents({{5000, 1}}, map);
+
+  map = other;
+  ExpectSameContents(expected, map);
+
+  map.clear();
+  EXPECT_TRUE(map.empty());
+  EXPECT_TRUE(map.begin() == map.end());
+  EXPECT_EQ(0u, map.EstimateMemoryUsage());
+  ExpectSameContents(expected, other);
+}
+
+}  // namespace
+}  // namespace disk_cache
@@ -11,7 +11,9 @@
 
 #include "base/compiler_specific.h"
 #include "base/containers/stack_container.h"
+#include "base/feature_list.h"
 #include "base/files/file_util.h"
+#include "base/hash/crc32c.h"
 #include "base/hash/hash.h"
 #include "base/location.h"
 #include "base/memory/ptr_util.h"
@@ -26,6 +28,7 @@
 #include "net/base/net_errors.h"
 #include "net/disk_cache/cache_util.h"
 #include "net/disk_cache/simple/simple_backend_version.h"
+#include "net/disk_cache/simple/simple_file_read_batch.h"
 #include "net/disk_cache/simple/simple_histogram_enums.h"
 #include "net/disk_cache/simple/simple_histogram_macros.h"
 #include "net/disk_cache/simple/simple_util.h"
@@ -150,22 +153,32 @@ class SimpleSynchronousEntry::PrefetchData final {
     return true;
   }
 
-  // Populate the prefetch buffer from the given file and range.  Returns
-  // true if the data is successfully read.
-  bool PrefetchFromFile(SimpleFileTracker::FileHandle* file,
-                        size_t offset,
-                        size_t length) {
+  // Adds to |batch| the read of the given range of |file| into the prefetch
+  // buffer. The range only counts as prefetched once FinishPrefetch() is
+  // called after |batch| ran.
+  void AddPrefetchToBatch(base::File* file,
+                          size_t offset,
+                          size_t length,
+                          SimpleFileReadBatch* batch) {
     DCHECK(file);
-    if (!buffer_->empty())
-      return false;
+    DCHECK(buffer_->empty());
     buffer_->resize(length);
-    if (file->get()->Read(offset, buffer_->data(), length) !=
-        static_cast<int>(length)) {
-      buffer_->resize(0);
-      return false;
-    }
     offset_in_file_ = offset;
-    return true;
+    read_index_ = batch->AddRead(file, offset, buffer_->data(), length);
+    has_pending_read_ = true;
+  }
+
+  // Returns true if the data added by AddPrefetchToBatch() was successfully
+  // read. Otherwise, nothing is prefetched.
+  bool FinishPrefetch(const SimpleFileReadBatch& batch) {
+    if (!has_pending_read_)
+      return false;
+    has_pending_read_ = false;
+    if (batch.result(read_index_) == static_cast<int>(buffer_->size()))
+      return true;
+    buffer_->resize(0);
+    offset_in_file_ = 0;
+    return false;
   }
 
   // Return how much trailing data has been requested via HasData() or
@@ -189,6 +202,8 @@ class SimpleSynchronousEntry::PrefetchData final {
   // memory pressure on the OS disk cache.
   base::StackVector<char, 1024> buffer_;
   size_t offset_in_file_;
+  size_t read_index_ = 0;
+  bool has_pending_read_ = false;
 
   size_t earliest_requested_offset_;
 };
@@ -219,6 +234,9 @@ constexpr base::FeatureParam<int> kSimpleCacheTrailerPrefetchSpeculativeBytes{
     &kSimpleCachePrefetchExperiment,
     kSimpleCacheTrailerPrefetchSpeculativeBytesParam, 0};
 
+const base::Feature kSimpleCacheStream0Crc32c = {
+    "SimpleCacheStream0Crc32c", base::FEATURE_DISABLED_BY_DEFAULT};
+
 int GetSimpleCacheFullPrefetchSize() {
   return kSimpleCacheFullPrefetchSize.Get();
 }
@@ -979,7 +997,10 @@ int SimpleSynchronousEntry::PreReadStreamPayload(
     return net::ERR_FAILED;
 
   // Check the CRC32.
-  uint32_t expected_crc32 = simple_util::Crc32(out->data->data(), stream_size);
+  uint32_t expected_crc32 =
+      (eof_record.flags & SimpleFileEOF::FLAG_CRC32C)
+          ? base::Crc32c(out->data->data(), stream_size)
+          : simple_util::Crc32(out->data->data(), stream_size);
   if ((eof_record.flags & SimpleFileEOF::FLAG_HAS_CRC32) &&
       eof_record.data_crc32 != expected_crc32) {
     DVLOG(1) << "EOF record had bad crc.";
@@ -1004,6 +1025,7 @@ void SimpleSynchronousEntry::Close(
     const int file_index = GetFileIndexFromStreamIndex(stream_index);
     if (empty_file_omitted_[file_index])
       continue;
+    bool stream_0_crc32c = false;
 
     SimpleFileTracker::FileHandle file =
         file_tracker_->Acquire(this, SubFileForFileIndex(file_index));
@@ -1032,14 +1054,17 @@ void SimpleSynchronousEntry::Close(
         Doom();
       }
 
-      // Re-compute stream 0 CRC if the data got changed (we may be here even
-      // if it didn't change if stream 0's position on disk got changed due to
-      // stream 1 write).
-      if (!it->has_crc32) {
-        it->data_crc32 =
-            simple_util::Crc32(stream_0_data->data(), entry_stat.data_size(0));
-        it->has_crc32 = true;
-      }
+      // Always re-compute stream 0 CRC, which is cheap since stream 0 is
+      // small. The data may have changed, or stream 0's position on disk may
+      // have changed due to a stream 1 write, and the CRC that was kept from
+      // opening the entry may not be of the kind that is written now.
+      stream_0_crc32c = base::FeatureList::IsEnabled(kSimpleCacheStream0Crc32c);
+      it->data_crc32 =
+          stream_0_crc32c
+              ? base::Crc32c(stream_0_data->data(), entry_stat.data_size(0))
+              : simple_util::Crc32(stream_0_data->data(),
+                                   entry_stat.data_size(0));
+      it->has_crc32 = true;
 
       out_results->estimated_trailer_prefetch_size =
           entry_stat.data_size(0) + sizeof(hash_value) + sizeof(SimpleFileEOF);
@@ -1053,6 +1078,8 @@ void SimpleSynchronousEntry::Close(
       eof_record.flags |= SimpleFileEOF::FLAG_HAS_CRC32;
     if (stream_index == 0)
       eof_record.flags |= SimpleFileEOF::FLAG_HAS_KEY_SHA256;
+    if (stream_index == 0 && stream_0_crc32c)
+      eof_record.flags |= SimpleFileEOF::FLAG_CRC32C;
     eof_record.data_crc32 = it->data_crc32;
     int eof_offset = entry_stat.GetEOFOffsetInFile(key_.size(), stream_index);
     // If stream 0 changed size, the file needs to be resized, otherwise the
@@ -1389,6 +1416,47 @@ int SimpleSynchronousEntry::InitializeForOpen(
     DLOG(WARNING) << "Could not open platform files for entry.";
     return net::ERR_FAILED;
   }
+
+  // The trailer of file 0, which stream 0 is read from, and the EOF record of
+  // stream 2 don't depend on each other, so they are read as a single batch.
+  // File sizes have been stored temporarily in data_size[1] and data_size[2].
+  const int file_0_size = out_entry_stat->data_size(1);
+  const int file_1_size = out_entry_stat->data_size(2);
+  PrefetchData file_0_prefetch(file_0_size);
+  PrefetchData file_1_prefetch(file_1_size);
+  int trailer_prefetch_size = 0;
+  OpenPrefetchMode prefetch_mode = OPEN_PREFETCH_NONE;
+  {
+    SimpleFileReadBatch batch;
+    SimpleFileTracker::FileHandle file_0 =
+        file_tracker_->Acquire(this, SubFileForFileIndex(0));
+    if (!file_0.IsOK())
+      return net::ERR_FAILED;
+    prefetch_mode = AddStream0PrefetchToBatch(
+        file_0.get(), file_0_size, &file_0_prefetch, &batch,
+        &trailer_prefetch_size);
+
+    SimpleFileTracker::FileHandle file_1;
+    if (!empty_file_omitted_[1]) {
+      file_1 = file_tracker_->Acquire(this, SubFileForFileIndex(1));
+      if (file_1.IsOK() &&
+          file_1_size >= static_cast<int>(sizeof(SimpleFileEOF))) {
+        file_1_prefetch.AddPrefetchToBatch(
+            file_1.get(), file_1_size - sizeof(SimpleFileEOF),
+            sizeof(SimpleFileEOF), &batch);
+      }
+    }
+
+    batch.Run();
+    if (!file_0_prefetch.FinishPrefetch(batch) &&
+        prefetch_mode != OPEN_PREFETCH_NONE) {
+      return net::ERR_FAILED;
+    }
+    // A failed read of stream 2's EOF record is reported when it is read
+    // again below.
+    file_1_prefetch.FinishPrefetch(batch);
+  }
+
   for (int i = 0; i < kSimpleEntryNormalFileCount; ++i) {
     if (empty_file_omitted_[i])
       continue;
@@ -1412,9 +1480,9 @@ int SimpleSynchronousEntry::InitializeForOpen(
     }
 
     if (i == 0) {
-      // File size for stream 0 has been stored temporarily in data_size[1].
       int ret_value_stream_0 = ReadAndValidateStream0AndMaybe1(
-          out_entry_stat->data_size(1), out_entry_stat, stream_prefetch_data);
+          file_0_size, prefetch_mode, trailer_prefetch_size, &file_0_prefetch,
+          out_entry_stat, stream_prefetch_data);
       if (ret_value_stream_0 != net::OK)
         return ret_value_stream_0;
     } else {
@@ -1432,8 +1500,8 @@ int SimpleSynchronousEntry::InitializeForOpen(
             file_tracker_->Acquire(this, SubFileForFileIndex(i));
         int file_offset =
             out_entry_stat->GetEOFOffsetInFile(key_.size(), 2 /*stream index*/);
-        int ret_value_stream_2 =
-            GetEOFRecordData(file.get(), nullptr, i, file_offset, &eof_record);
+        int ret_value_stream_2 = GetEOFRecordData(
+            file.get(), &file_1_prefetch, i, file_offset, &eof_record);
         if (ret_value_stream_2 != net::OK)
           return ret_value_stream_2;
       }
@@ -1523,15 +1591,12 @@ int SimpleSynchronousEntry::InitializeForCreate(
   return net::OK;
 }
 
-int SimpleSynchronousEntry::ReadAndValidateStream0AndMaybe1(
+OpenPrefetchMode SimpleSynchronousEntry::AddStream0PrefetchToBatch(
+    base::File* file,
     int file_size,
-    SimpleEntryStat* out_entry_stat,
-    SimpleStreamPrefetchData stream_prefetch_data[2]) {
-  SimpleFileTracker::FileHandle file =
-      file_tracker_->Acquire(this, SubFileForFileIndex(0));
-  if (!file.IsOK())
-    return net::ERR_FAILED;
-
+    PrefetchData* prefetch_data,
+    SimpleFileReadBatch* batch,
+    int* out_trailer_prefetch_size) {
   // We may prefetch data from file in a couple cases:
   //  1) If the file is small enough we may prefetch it entirely.
   //  2) We may also prefetch a block of trailer bytes from the end of
@@ -1541,7 +1606,6 @@ int SimpleSynchronousEntry::ReadAndValidateStream0AndMaybe1(
   // of what range within the file has been prefetched.  It will only
   // allow reads wholely within this range to be accessed via its
   // ReadData() method.
-  PrefetchData prefetch_data(file_size);
 
   // Determine a threshold for fully prefetching the entire entry file.  If
   // the entry file is less than or equal to this number of bytes it will
@@ -1554,34 +1618,51 @@ int SimpleSynchronousEntry::ReadAndValidateStream0AndMaybe1(
   // will contain at least stream 0 and its EOF record.
   int trailer_prefetch_size =
       GetSimpleCacheTrailerPrefetchSize(trailer_prefetch_size_);
+  *out_trailer_prefetch_size = trailer_prefetch_size;
 
   OpenPrefetchMode prefetch_mode = OPEN_PREFETCH_NONE;
   if (file_size <= full_prefetch_size || file_size <= trailer_prefetch_size) {
     // Prefetch the entire file.
     prefetch_mode = OPEN_PREFETCH_FULL;
     RecordOpenPrefetchMode(cache_type_, prefetch_mode);
-    if (!prefetch_data.PrefetchFromFile(&file, 0, file_size))
-      return net::ERR_FAILED;
+    prefetch_data->AddPrefetchToBatch(file, 0, file_size, batch);
   } else if (trailer_prefetch_size > 0) {
     // Prefetch trailer data from the end of the file.
     prefetch_mode = OPEN_PREFETCH_TRAILER;
     RecordOpenPrefetchMode(cache_type_, prefetch_mode);
     size_t length = std::min(trailer_prefetch_size, file_size);
     size_t offset = file_size - length;
-    if (!prefetch_data.PrefetchFromFile(&file, offset, length))
-      return net::ERR_FAILED;
+    prefetch_data->AddPrefetchToBatch(file, offset, length, batch);
     SIMPLE_CACHE_UMA(COUNTS_100000, "EntryTrailerPrefetchSize", cache_type_,
                      trailer_prefetch_size);
   } else {
-    // Do no prefetching.
+    // Do no prefetching, but the stream 0 EOF record is read first anyway.
     RecordOpenPrefetchMode(cache_type_, prefetch_mode);
+    if (file_size >= static_cast<int>(sizeof(SimpleFileEOF))) {
+      prefetch_data->AddPrefetchToBatch(file, file_size - sizeof(SimpleFileEOF),
+                                        sizeof(SimpleFileEOF), batch);
+    }
   }
+  return prefetch_mode;
+}
+
+int SimpleSynchronousEntry::ReadAndValidateStream0AndMaybe1(
+    int file_size,
+    OpenPrefetchMode prefetch_mode,
+    int trailer_prefetch_size,
+    PrefetchData* prefetch_data,
+    SimpleEntryStat* out_entry_stat,
+    SimpleStreamPrefetchData stream_prefetch_data[2]) {
+  SimpleFileTracker::FileHandle file =
+      file_tracker_->Acquire(this, SubFileForFileIndex(0));
+  if (!file.IsOK())
+    return net::ERR_FAILED;
 
   // Read stream 0 footer first --- it has size/feature info required to figure
   // out file 0's layout.
   SimpleFileEOF stream_0_eof;
   int rv = GetEOFRecordData(
-      file.get(), &prefetch_data, /* file_index = */ 0,
+      file.get(), prefetch_data, /* file_index = */ 0,
       /* file_offset = */ file_size - sizeof(SimpleFileEOF), &stream_0_eof);
   if (rv != net::OK)
     return rv;
@@ -1609,7 +1690,7 @@ int SimpleSynchronousEntry::ReadAndValidateStream0AndMaybe1(
   out_entry_stat->set_data_size(1, stream1_size);
 
   // Put stream 0 data in memory --- plus maybe the sha256(key) footer.
-  rv = PreReadStreamPayload(file.get(), &prefetch_data, /* stream_index = */ 0,
+  rv = PreReadStreamPayload(file.get(), prefetch_data, /* stream_index = */ 0,
                             extra_post_stream_0_read, *out_entry_stat,
                             stream_0_eof, &stream_prefetch_data[0]);
   if (rv != net::OK)
@@ -1620,7 +1701,7 @@ int SimpleSynchronousEntry::ReadAndValidateStream0AndMaybe1(
   // know exactly how much to read next time.  Its also reported in a histogram
   // so we can tune the speculative trailer prefetching experiment.
   computed_trailer_prefetch_size_ =
-      prefetch_data.GetDesiredTrailerPrefetchSize();
+      prefetch_data->GetDesiredTrailerPrefetchSize();
   SIMPLE_CACHE_UMA(COUNTS_100000, "EntryTrailerSize", cache_type_,
                    computed_trailer_prefetch_size_);
 
@@ -1638,16 +1719,16 @@ int SimpleSynchronousEntry::ReadAndValidateStream0AndMaybe1(
   int stream_1_read_size =
       sizeof(SimpleFileEOF) + out_entry_stat->data_size(/* stream_index = */ 1);
   if (has_key_sha256 &&
-      prefetch_data.HasData(stream_1_offset, stream_1_read_size)) {
+      prefetch_data->HasData(stream_1_offset, stream_1_read_size)) {
     SimpleFileEOF stream_1_eof;
     int stream_1_eof_offset =
         out_entry_stat->GetEOFOffsetInFile(key_.size(), /* stream_index = */ 1);
-    rv = GetEOFRecordData(file.get(), &prefetch_data, /* file_index = */ 0,
+    rv = GetEOFRecordData(file.get(), prefetch_data, /* file_index = */ 0,
                           stream_1_eof_offset, &stream_1_eof);
     if (rv != net::OK)
       return rv;
 
-    rv = PreReadStreamPayload(file.get(), &prefetch_data,
+    rv = PreReadStreamPayload(file.get(), prefetch_data,
                               /* stream_index = */ 1,
                               /* extra_size = */ 0, *out_entry_stat,
                               stream_1_eof, &stream_prefetch_data[1]);
@@ -1704,7 +1785,7 @@ bool SimpleSynchronousEntry::ReadFromFileOrPrefetched(
     return false;
 
   // First try to extract the desired range from the PrefetchData.
-  if (file_index == 0 && prefetch_data &&
+  if (prefetch_data &&
       prefetch_data->ReadData(start_numeric, length_numeric, dest)) {
     return true;
   }
@@ -42,10 +42,17 @@ NET_EXPORT_PRIVATE extern const char kSimpleCacheTrailerPrefetchHintParam[];
 NET_EXPORT_PRIVATE extern const char
     kSimpleCacheTrailerPrefetchSpeculativeBytesParam[];
 
+// When enabled, the checksum of stream 0 is written as a hardware accelerated
+// CRC-32C, which is marked by SimpleFileEOF::FLAG_CRC32C. Entries with either
+// checksum are read regardless, but versions that predate the flag see such
+// entries as corrupt, so this can't be enabled until rollback is unlikely.
+NET_EXPORT_PRIVATE extern const base::Feature kSimpleCacheStream0Crc32c;
+
 // Returns how large a file would get prefetched on reading the entry.
 // If the experiment is disabled, returns 0.
 NET_EXPORT_PRIVATE int GetSimpleCachePrefetchSize();
 
+class SimpleFileReadBatch;
 class SimpleSynchronousEntry;
 
 // This class handles the passing of data about the entry between
@@ -376,16 +383,30 @@ class SimpleSynchronousEntry {
   // when the entry already exists.
   int InitializeForCreate(SimpleEntryStat* out_entry_stat);
 
+  // Adds to |batch| the read of the data of file 0, of size |file_size|,
+  // which is prefetched into |prefetch_data| when opening the entry. Returns
+  // the prefetch mode, and the size of the speculative trailer prefetch in
+  // |*out_trailer_prefetch_size|.
+  OpenPrefetchMode AddStream0PrefetchToBatch(base::File* file,
+                                             int file_size,
+                                             PrefetchData* prefetch_data,
+                                             SimpleFileReadBatch* batch,
+                                             int* out_trailer_prefetch_size);
+
   // Allocates and fills a buffer with stream 0 data in |stream_0_data|, then
   // checks its crc32. May also optionally read in |stream_1_data| and its
-  // crc, but might decide not to.
+  // crc, but might decide not to. |prefetch_data| holds the data prefetched
+  // by AddStream0PrefetchToBatch().
   int ReadAndValidateStream0AndMaybe1(
       int file_size,
+      OpenPrefetchMode prefetch_mode,
+      int trailer_prefetch_size,
+      PrefetchData* prefetch_data,
       SimpleEntryStat* out_entry_stat,
       SimpleStreamPrefetchData stream_prefetch_data[2]);
 
   // Reads the EOF record located at |file_offset| in file |file_index|,
-  // with |file_0_prefetch| potentially having prefetched file 0 content.
+  // with |prefetch_data| potentially having prefetched content of the file.
   // Puts the result into |*eof_record| and sanity-checks it.
   // Returns net status, and records any failures to UMA.
   int GetEOFRecordData(base::File* file,
@@ -394,7 +415,7 @@ class SimpleSynchronousEntry {
                        int file_offset,
                        SimpleFileEOF* eof_record);
 
-  // Reads either from |file_0_prefetch| or |file|.
+  // Reads either from |prefetch_data| or |file|.
   // Range-checks all the in-memory reads.
   bool ReadFromFileOrPrefetched(base::File* file,
                                 PrefetchData* prefetch_data,
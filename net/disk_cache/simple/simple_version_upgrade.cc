@@ -216,6 +216,14 @@ SimpleCacheConsistencyResult UpgradeSimpleCacheOnDisk(
     version_from++;
   }
 
+  if (version_from == 9) {
+    // V9 -> V10 is handled by the index reader too: it still reads the pickled
+    // V9 index, and the next write replaces it with a table, see
+    // simple_index_format.h. Until then the index can't be mapped, so lookups
+    // go to the disk until the index is loaded, as before V10.
+    version_from++;
+  }
+
   DCHECK_EQ(kSimpleVersion, version_from);
 
   if (!new_fake_index_needed)
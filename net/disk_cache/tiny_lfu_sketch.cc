@@ -0,0 +1,100 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "net/disk_cache/tiny_lfu_sketch.h"
+
+#include <algorithm>
+
+#include "base/bits.h"
+#include "base/stl_util.h"
+#include "base/logging.h"
+#include "base/trace_event/memory_usage_estimator.h"
+
+namespace disk_cache {
+
+namespace {
+
+// One seed per row, so that keys colliding in a row rarely collide in the
+// others.
+const uint64_t kRowSeeds[] = {
+    UINT64_C(0x9e3779b97f4a7c15), UINT64_C(0xc2b2ae3d27d4eb4f),
+    UINT64_C(0x165667b19e3779f9), UINT64_C(0xd6e8feb86659fd93)};
+
+// Halves the 16 counters of |word| at once.
+const uint64_t kHalveMask = UINT64_C(0x7777777777777777);
+
+// Uses recorded between two agings, per expected key.
+const size_t kSampleSizeMultiplier = 10;
+
+// Up to 2^26 words, that is 512 MiB, which is beyond any expected use.
+const uint32_t kMaxTableWords = 1 << 26;
+
+// Returns a power of two number of words giving about eight counters per
+// expected key, shared by the rows.
+size_t TableSize(size_t expected_keys) {
+  const uint32_t words = static_cast<uint32_t>(
+      std::min<size_t>(std::max<size_t>(expected_keys / 2, 64),
+                       kMaxTableWords));
+  return size_t{1} << base::bits::Log2Ceiling(words);
+}
+
+}  // namespace
+
+constexpr int TinyLfuSketch::kMaxFrequency;
+constexpr int TinyLfuSketch::kDepth;
+
+TinyLfuSketch::TinyLfuSketch(size_t expected_keys)
+    : table_(TableSize(expected_keys)),
+      sample_size_(kSampleSizeMultiplier * std::max<size_t>(expected_keys, 1)) {
+  static_assert(base::size(kRowSeeds) == kDepth, "one seed per row");
+}
+
+TinyLfuSketch::~TinyLfuSketch() = default;
+
+void TinyLfuSketch::RecordUse(uint64_t hash) {
+  for (int row = 0; row < kDepth; ++row) {
+    size_t word;
+    int shift;
+    GetCounter(hash, row, &word, &shift);
+    if (((table_[word] >> shift) & 0xF) < kMaxFrequency)
+      table_[word] += UINT64_C(1) << shift;
+  }
+  if (++uses_since_aging_ >= sample_size_)
+    Age();
+}
+
+int TinyLfuSketch::EstimateFrequency(uint64_t hash) const {
+  int frequency = kMaxFrequency;
+  for (int row = 0; row < kDepth; ++row) {
+    size_t word;
+    int shift;
+    GetCounter(hash, row, &word, &shift);
+    frequency = std::min(frequency, static_cast<int>((table_[word] >> shift) &
+                                                     0xF));
+  }
+  return frequency;
+}
+
+size_t TinyLfuSketch::EstimateMemoryUsage() const {
+  return base::trace_event::EstimateMemoryUsage(table_);
+}
+
+void TinyLfuSketch::GetCounter(uint64_t hash,
+                               int row,
+                               size_t* word,
+                               int* shift) const {
+  uint64_t mixed = (hash ^ kRowSeeds[row]) * UINT64_C(0xff51afd7ed558ccd);
+  mixed ^= mixed >> 32;
+  // |table_| has a power of two size.
+  *word = static_cast<size_t>(mixed) & (table_.size() - 1);
+  *shift = static_cast<int>(mixed >> 60) * 4;
+}
+
+void TinyLfuSketch::Age() {
+  for (uint64_t& word : table_)
+    word = (word >> 1) & kHalveMask;
+  uses_since_aging_ /= 2;
+}
+
+}  // namespace disk_cache
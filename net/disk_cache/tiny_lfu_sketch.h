@@ -0,0 +1,59 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef NET_DISK_CACHE_TINY_LFU_SKETCH_H_
+#define NET_DISK_CACHE_TINY_LFU_SKETCH_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <vector>
+
+#include "base/macros.h"
+#include "net/base/net_export.h"
+
+namespace disk_cache {
+
+// A count-min sketch of 4-bit counters estimating how often keys were used
+// recently, which is the frequency filter of TinyLFU
+// (https://arxiv.org/abs/1512.00727). Once enough uses were recorded, all the
+// counters are halved, so that old popularity fades.
+class NET_EXPORT_PRIVATE TinyLfuSketch {
+ public:
+  static constexpr int kMaxFrequency = 15;
+
+  // The estimates get less accurate once many more than |expected_keys|
+  // distinct keys are used between two agings.
+  explicit TinyLfuSketch(size_t expected_keys);
+  ~TinyLfuSketch();
+
+  // Records one use of the key which hashes to |hash|.
+  void RecordUse(uint64_t hash);
+
+  // Returns an upper bound of the recent uses of the key which hashes to
+  // |hash|, at most kMaxFrequency.
+  int EstimateFrequency(uint64_t hash) const;
+
+  size_t EstimateMemoryUsage() const;
+
+ private:
+  static constexpr int kDepth = 4;
+
+  // Returns the word and the shift of the counter of |hash| in row |row|.
+  void GetCounter(uint64_t hash, int row, size_t* word, int* shift) const;
+
+  // Halves all the counters.
+  void Age();
+
+  // Each word holds 16 counters.
+  std::vector<uint64_t> table_;
+  const size_t sample_size_;
+  size_t uses_since_aging_ = 0;
+
+  DISALLOW_COPY_AND_ASSIGN(TinyLfuSketch);
+};
+
+}  // namespace disk_cache
+
+#endif  // NET_DISK_CACHE_TINY_LFU_SKETCH_H_
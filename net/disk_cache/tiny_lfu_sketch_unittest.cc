@@ -0,0 +1,53 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "net/disk_cache/tiny_lfu_sketch.h"
+
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace disk_cache {
+
+TEST(TinyLfuSketchTest, EstimatesFrequency) {
+  TinyLfuSketch sketch(1000);
+  for (uint64_t hash = 0; hash < 100; ++hash) {
+    for (uint64_t i = 0; i < hash % 10; ++i)
+      sketch.RecordUse(hash);
+  }
+
+  // Count-min sketches only overestimate.
+  int overestimated = 0;
+  for (uint64_t hash = 0; hash < 100; ++hash) {
+    const int frequency = sketch.EstimateFrequency(hash);
+    EXPECT_LE(static_cast<int>(hash % 10), frequency);
+    if (frequency != static_cast<int>(hash % 10))
+      ++overestimated;
+  }
+  EXPECT_GT(5, overestimated);
+  EXPECT_EQ(0, sketch.EstimateFrequency(12345));
+}
+
+TEST(TinyLfuSketchTest, Saturates) {
+  TinyLfuSketch sketch(1000);
+  for (int i = 0; i < 100; ++i)
+    sketch.RecordUse(1);
+  EXPECT_EQ(TinyLfuSketch::kMaxFrequency, sketch.EstimateFrequency(1));
+}
+
+// The counters are halved every ten uses per expected key.
+TEST(TinyLfuSketchTest, Ages) {
+  TinyLfuSketch sketch(100);
+  for (int i = 0; i < 8; ++i)
+    sketch.RecordUse(1);
+  EXPECT_EQ(8, sketch.EstimateFrequency(1));
+
+  // The 1000th use ages the counters.
+  for (uint64_t hash = 2; hash < 102; ++hash) {
+    for (int i = 0; i < 10; ++i)
+      sketch.RecordUse(hash);
+  }
+  EXPECT_GE(4, sketch.EstimateFrequency(1));
+  EXPECT_LE(3, sketch.EstimateFrequency(1));
+}
+
+}  // namespace disk_cache
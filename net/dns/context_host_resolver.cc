@@ -69,6 +69,15 @@ class ContextHostResolver::WrappedRequest
     inner_request_->ChangeRequestPriority(priority);
   }
 
+  void SetPartialResultsCallback(base::OnceClosure callback) override {
+    inner_request_->SetPartialResultsCallback(std::move(callback));
+  }
+
+  const base::Optional<AddressList>& GetPartialAddressResults()
+      const override {
+    return inner_request_->GetPartialAddressResults();
+  }
+
  private:
   std::unique_ptr<HostResolverManager::CancellableRequest> inner_request_;
 
@@ -10,6 +10,7 @@
 #include "base/metrics/field_trial.h"
 #include "base/metrics/histogram_macros.h"
 #include "base/numerics/safe_conversions.h"
+#include "base/pickle.h"
 #include "base/strings/string_number_conversions.h"
 #include "base/time/default_tick_clock.h"
 #include "base/trace_event/trace_event.h"
@@ -67,6 +68,16 @@ bool AddressListFromListValue(const base::ListValue* value,
   return true;
 }
 
+// Version of the SerializeSnapshot() format.
+const int kSnapshotVersion = 1;
+
+// Bounds the allocations made by RestoreFromSnapshot() for malformed input.
+const int kMaxSnapshotListSize = 1024;
+
+bool ReadSnapshotListSize(base::PickleIterator* iter, int* size) {
+  return iter->ReadInt(size) && *size >= 0 && *size <= kMaxSnapshotListSize;
+}
+
 template <typename T>
 void MergeLists(base::Optional<T>* target, const base::Optional<T>& source) {
   if (target->has_value() && source) {
@@ -96,6 +107,15 @@ enum HostCache::LookupOutcome : int {
   MAX_LOOKUP_OUTCOME
 };
 
+// Used in histograms; do not modify existing values.
+enum HostCache::RefreshLookupOutcome : int {
+  REFRESH_LOOKUP_MISS_STALE = 0,
+  REFRESH_LOOKUP_HIT_VALID = 1,
+  REFRESH_LOOKUP_HIT_VALID_REFRESH = 2,
+  REFRESH_LOOKUP_HIT_STALE_REFRESH = 3,
+  MAX_REFRESH_LOOKUP_OUTCOME
+};
+
 // Used in histograms; do not modify existing values.
 enum HostCache::EraseReason : int {
   ERASE_EVICT = 0,
@@ -403,6 +423,49 @@ const std::pair<const HostCache::Key, HostCache::Entry>* HostCache::LookupStale(
   return result;
 }
 
+const std::pair<const HostCache::Key, HostCache::Entry>*
+HostCache::LookupWithRefresh(const Key& key,
+                             base::TimeTicks now,
+                             const RefreshPolicy& policy,
+                             EntryStaleness* stale_out,
+                             bool* needs_refresh_out,
+                             bool ignore_secure) {
+  DCHECK_CALLED_ON_VALID_THREAD(thread_checker_);
+  DCHECK(stale_out);
+  DCHECK(needs_refresh_out);
+  *needs_refresh_out = false;
+  if (caching_is_disabled())
+    return nullptr;
+
+  auto* result = LookupInternalIgnoringFields(key, now, ignore_secure);
+  if (!result)
+    return nullptr;
+
+  auto* entry = &result->second;
+  RefreshLookupOutcome outcome;
+  if (!entry->IsStale(now, network_changes_)) {
+    entry->CountHit(/* hit_is_stale= */ false);
+    *needs_refresh_out = entry->total_hits() >= policy.min_hits &&
+                         entry->expires() - now <= policy.refresh_window;
+    outcome = *needs_refresh_out ? REFRESH_LOOKUP_HIT_VALID_REFRESH
+                                 : REFRESH_LOOKUP_HIT_VALID;
+  } else if (entry->error() == OK &&
+             entry->network_changes() == network_changes_ &&
+             now - entry->expires() < policy.max_stale) {
+    entry->CountHit(/* hit_is_stale= */ true);
+    *needs_refresh_out = true;
+    outcome = REFRESH_LOOKUP_HIT_STALE_REFRESH;
+  } else {
+    result = nullptr;
+    outcome = REFRESH_LOOKUP_MISS_STALE;
+  }
+  CACHE_HISTOGRAM_ENUM("RefreshLookupOutcome", outcome,
+                       MAX_REFRESH_LOOKUP_OUTCOME);
+  if (result)
+    entry->GetStaleness(now, network_changes_, stale_out);
+  return result;
+}
+
 // static
 std::pair<const HostCache::Key, HostCache::Entry>*
 HostCache::GetLessStaleMoreSecureResult(
@@ -760,6 +823,167 @@ bool HostCache::RestoreFromListValue(const base::ListValue& old_cache) {
   return true;
 }
 
+void HostCache::SerializeSnapshot(base::Pickle* pickle) const {
+  DCHECK_CALLED_ON_VALID_THREAD(thread_checker_);
+  const base::TimeTicks now_ticks = tick_clock_->NowTicks();
+  const base::Time now = base::Time::Now();
+
+  std::vector<const std::pair<const Key, Entry>*> snapshot_entries;
+  for (const auto& pair : entries_) {
+    if (pair.second.error() == OK &&
+        !pair.second.IsStale(now_ticks, network_changes_)) {
+      snapshot_entries.push_back(&pair);
+    }
+  }
+
+  pickle->WriteInt(kSnapshotVersion);
+  pickle->WriteInt(base::checked_cast<int>(snapshot_entries.size()));
+  for (const auto* pair : snapshot_entries) {
+    const Key& key = pair->first;
+    const Entry& entry = pair->second;
+    pickle->WriteString(key.hostname);
+    pickle->WriteInt(static_cast<int>(key.dns_query_type));
+    pickle->WriteInt(key.host_resolver_flags);
+    pickle->WriteInt(static_cast<int>(key.host_resolver_source));
+    pickle->WriteBool(key.secure);
+    base::Time expiration = now + (entry.expires() - now_ticks);
+    pickle->WriteInt64(expiration.ToDeltaSinceWindowsEpoch().InMicroseconds());
+
+    pickle->WriteBool(entry.addresses().has_value());
+    if (entry.addresses()) {
+      pickle->WriteInt(base::checked_cast<int>(entry.addresses()->size()));
+      for (const IPEndPoint& address : entry.addresses().value()) {
+        pickle->WriteData(
+            reinterpret_cast<const char*>(address.address().bytes().data()),
+            address.address().size());
+      }
+    }
+    pickle->WriteBool(entry.text_records().has_value());
+    if (entry.text_records()) {
+      pickle->WriteInt(base::checked_cast<int>(entry.text_records()->size()));
+      for (const std::string& text_record : entry.text_records().value())
+        pickle->WriteString(text_record);
+    }
+    pickle->WriteBool(entry.hostnames().has_value());
+    if (entry.hostnames()) {
+      pickle->WriteInt(base::checked_cast<int>(entry.hostnames()->size()));
+      for (const HostPortPair& hostname : entry.hostnames().value()) {
+        pickle->WriteString(hostname.host());
+        pickle->WriteUInt16(hostname.port());
+      }
+    }
+  }
+}
+
+bool HostCache::RestoreFromSnapshot(base::PickleIterator* iter,
+                                    bool valid_on_current_network) {
+  DCHECK_CALLED_ON_VALID_THREAD(thread_checker_);
+  restore_size_ = 0;
+
+  int version;
+  int num_entries;
+  if (!iter->ReadInt(&version) || version != kSnapshotVersion ||
+      !iter->ReadInt(&num_entries) || num_entries < 0) {
+    return false;
+  }
+
+  const base::TimeTicks now_ticks = tick_clock_->NowTicks();
+  const base::Time now = base::Time::Now();
+  for (int i = 0; i < num_entries; ++i) {
+    std::string hostname;
+    int dns_query_type;
+    HostResolverFlags flags;
+    int host_resolver_source;
+    bool secure;
+    int64_t expiration_us;
+    if (!iter->ReadString(&hostname) || !iter->ReadInt(&dns_query_type) ||
+        dns_query_type < 0 ||
+        dns_query_type > static_cast<int>(DnsQueryType::MAX) ||
+        !iter->ReadInt(&flags) || !iter->ReadInt(&host_resolver_source) ||
+        host_resolver_source < 0 ||
+        host_resolver_source > static_cast<int>(HostResolverSource::MAX) ||
+        !iter->ReadBool(&secure) || !iter->ReadInt64(&expiration_us)) {
+      return false;
+    }
+
+    bool has_list;
+    int list_size;
+    base::Optional<AddressList> addresses;
+    if (!iter->ReadBool(&has_list))
+      return false;
+    if (has_list) {
+      if (!ReadSnapshotListSize(iter, &list_size))
+        return false;
+      addresses.emplace();
+      for (int j = 0; j < list_size; ++j) {
+        const char* data;
+        int length;
+        if (!iter->ReadData(&data, &length))
+          return false;
+        IPAddress address(reinterpret_cast<const uint8_t*>(data), length);
+        if (!address.IsValid())
+          return false;
+        addresses->push_back(IPEndPoint(address, 0));
+      }
+    }
+
+    base::Optional<std::vector<std::string>> text_records;
+    if (!iter->ReadBool(&has_list))
+      return false;
+    if (has_list) {
+      if (!ReadSnapshotListSize(iter, &list_size))
+        return false;
+      text_records.emplace(list_size);
+      for (std::string& text_record : text_records.value()) {
+        if (!iter->ReadString(&text_record))
+          return false;
+      }
+    }
+
+    base::Optional<std::vector<HostPortPair>> hostnames;
+    if (!iter->ReadBool(&has_list))
+      return false;
+    if (has_list) {
+      if (!ReadSnapshotListSize(iter, &list_size))
+        return false;
+      hostnames.emplace();
+      for (int j = 0; j < list_size; ++j) {
+        std::string host;
+        uint16_t port;
+        if (!iter->ReadString(&host) || !iter->ReadUInt16(&port))
+          return false;
+        hostnames->push_back(HostPortPair(host, port));
+      }
+    }
+
+    // As in RestoreFromListValue(), don't bother prioritizing what to evict
+    // once the cache is full, but keep parsing to report malformed input.
+    if (size() == max_entries_)
+      continue;
+
+    base::Time expiration = base::Time::FromDeltaSinceWindowsEpoch(
+        base::TimeDelta::FromMicroseconds(expiration_us));
+    if (expiration <= now)
+      continue;
+
+    Key key(hostname, static_cast<DnsQueryType>(dns_query_type), flags,
+            static_cast<HostResolverSource>(host_resolver_source));
+    key.secure = secure;
+    // If the key is already in the cache, assume it's more recent and don't
+    // replace the entry.
+    if (entries_.count(key))
+      continue;
+
+    AddEntry(key, Entry(OK, addresses, std::move(text_records),
+                        std::move(hostnames), Entry::SOURCE_UNKNOWN,
+                        now_ticks + (expiration - now),
+                        valid_on_current_network ? network_changes_
+                                                 : network_changes_ - 1));
+    restore_size_++;
+  }
+  return true;
+}
+
 size_t HostCache::size() const {
   DCHECK_CALLED_ON_VALID_THREAD(thread_checker_);
   return entries_.size();
@@ -37,6 +37,8 @@
 
 namespace base {
 class ListValue;
+class Pickle;
+class PickleIterator;
 class TickClock;
 }  // namespace base
 
@@ -99,6 +101,25 @@ class NET_EXPORT HostCache {
     }
   };
 
+  // Policy for keeping popular entries usable across their expiration by
+  // re-resolving them in the background, see LookupWithRefresh(). The default
+  // values disable it.
+  struct NET_EXPORT RefreshPolicy {
+    bool enabled() const {
+      return max_stale > base::TimeDelta() ||
+             refresh_window > base::TimeDelta();
+    }
+
+    // Successful entries expired by less than |max_stale|, and not made stale
+    // by a network change, are still served while being refreshed.
+    base::TimeDelta max_stale;
+
+    // Valid entries expiring within |refresh_window| are refreshed once they
+    // have been hit |min_hits| times.
+    base::TimeDelta refresh_window;
+    int min_hits = 1;
+  };
+
   // Stores the latest address list that was looked up for a hostname.
   class NET_EXPORT Entry {
    public:
@@ -277,6 +298,20 @@ class NET_EXPORT HostCache {
                                                  EntryStaleness* stale_out,
                                                  bool ignore_secure = false);
 
+  // Returns a pointer to the matching (key, entry) pair if it is valid at time
+  // |now|, or if it is stale but may still be served according to |policy|.
+  // Fills in |stale_out| with information about how stale it is, and sets
+  // |*needs_refresh_out| to whether the entry should be re-resolved. If
+  // |ignore_secure| is true, ignores the secure field in |key| when looking
+  // for a match. If there is no such entry, returns NULL.
+  const std::pair<const Key, Entry>* LookupWithRefresh(
+      const Key& key,
+      base::TimeTicks now,
+      const RefreshPolicy& policy,
+      EntryStaleness* stale_out,
+      bool* needs_refresh_out,
+      bool ignore_secure = false);
+
   // Overwrites or creates an entry for |key|.
   // |entry| is the value to set, |now| is the current time
   // |ttl| is the "time to live".
@@ -321,8 +356,20 @@ class NET_EXPORT HostCache {
   // cache, skipping any that already have entries. Returns true on success,
   // false on failure.
   bool RestoreFromListValue(const base::ListValue& old_cache);
+  // Appends the successful entries that are valid now on the current network
+  // to |pickle|, in a compact binary format. Expiration times are stored as
+  // wall-clock times so that they can be restored after a restart.
+  void SerializeSnapshot(base::Pickle* pickle) const;
+  // Reads entries written by SerializeSnapshot() from |iter| and stores them
+  // in the cache, skipping any that have expired since or already have
+  // entries. If |valid_on_current_network| is false, the restored entries are
+  // stale on account of a network change, like those of
+  // RestoreFromListValue(). Returns false on malformed input, after restoring
+  // the entries before it.
+  bool RestoreFromSnapshot(base::PickleIterator* iter,
+                           bool valid_on_current_network);
   // Returns the number of entries that were restored in the last call to
-  // RestoreFromListValue().
+  // RestoreFromListValue() or RestoreFromSnapshot().
   size_t last_restore_size() const { return restore_size_; }
 
   // Returns the number of entries in the cache.
@@ -341,6 +388,7 @@ class NET_EXPORT HostCache {
 
   enum SetOutcome : int;
   enum LookupOutcome : int;
+  enum RefreshLookupOutcome : int;
   enum EraseReason : int;
 
   // Returns the result that is least stale, based on the number of network
@@ -0,0 +1,125 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "net/dns/host_cache_persister.h"
+
+#include <utility>
+
+#include "base/bind.h"
+#include "base/files/file_util.h"
+#include "base/location.h"
+#include "base/logging.h"
+#include "base/metrics/histogram_macros.h"
+#include "base/pickle.h"
+#include "base/sequenced_task_runner.h"
+#include "base/task_runner_util.h"
+#include "base/threading/thread_task_runner_handle.h"
+#include "base/time/time.h"
+
+namespace net {
+
+namespace {
+
+// Identifies the snapshot files, followed by the connection type at the time
+// of the write and by HostCache::SerializeSnapshot() data.
+const uint32_t kSnapshotMagic = 0x48435031;  // "HCP1"
+
+// Bounds the staleness of the snapshot on disk, while avoiding rewriting it
+// for each resolution.
+constexpr base::TimeDelta kCommitInterval = base::TimeDelta::FromMinutes(1);
+
+std::string LoadSnapshot(const base::FilePath& path) {
+  std::string result;
+  if (!base::ReadFileToString(path, &result))
+    return std::string();
+  return result;
+}
+
+}  // namespace
+
+HostCachePersister::HostCachePersister(
+    HostCache* cache,
+    const base::FilePath& path,
+    scoped_refptr<base::SequencedTaskRunner> background_runner)
+    : cache_(cache),
+      writer_(path, background_runner, kCommitInterval, "HostCache"),
+      foreground_runner_(base::ThreadTaskRunnerHandle::Get()),
+      weak_ptr_factory_(this) {
+  DCHECK(cache_);
+  cache_->set_persistence_delegate(this);
+  NetworkChangeNotifier::AddNetworkChangeObserver(this);
+  base::PostTaskAndReplyWithResult(
+      background_runner.get(), FROM_HERE,
+      base::BindOnce(&LoadSnapshot, writer_.path()),
+      base::BindOnce(&HostCachePersister::CompleteLoad,
+                     weak_ptr_factory_.GetWeakPtr()));
+}
+
+HostCachePersister::~HostCachePersister() {
+  DCHECK(foreground_runner_->RunsTasksInCurrentSequence());
+  if (writer_.HasPendingWrite())
+    writer_.DoScheduledWrite();
+  cache_->set_persistence_delegate(nullptr);
+  NetworkChangeNotifier::RemoveNetworkChangeObserver(this);
+}
+
+void HostCachePersister::ScheduleWrite() {
+  DCHECK(foreground_runner_->RunsTasksInCurrentSequence());
+  writer_.ScheduleWrite(this);
+}
+
+bool HostCachePersister::SerializeData(std::string* data) {
+  DCHECK(foreground_runner_->RunsTasksInCurrentSequence());
+  base::Pickle pickle;
+  pickle.WriteUInt32(kSnapshotMagic);
+  pickle.WriteInt(
+      static_cast<int>(NetworkChangeNotifier::GetConnectionType()));
+  cache_->SerializeSnapshot(&pickle);
+  data->assign(static_cast<const char*>(pickle.data()), pickle.size());
+  return true;
+}
+
+void HostCachePersister::OnNetworkChanged(
+    NetworkChangeNotifier::ConnectionType type) {
+  DCHECK(foreground_runner_->RunsTasksInCurrentSequence());
+  if (!loaded_) {
+    network_changed_ = true;
+    return;
+  }
+  // Drop the entries obtained on the previous network from the snapshot.
+  ScheduleWrite();
+}
+
+bool HostCachePersister::LoadEntries(const std::string& data) {
+  DCHECK(foreground_runner_->RunsTasksInCurrentSequence());
+  base::Pickle pickle(data.data(), data.size());
+  base::PickleIterator iter(pickle);
+  uint32_t magic;
+  int connection_type;
+  if (!iter.ReadUInt32(&magic) || magic != kSnapshotMagic ||
+      !iter.ReadInt(&connection_type)) {
+    return false;
+  }
+  bool valid_on_current_network =
+      !network_changed_ &&
+      connection_type ==
+          static_cast<int>(NetworkChangeNotifier::GetConnectionType());
+  return cache_->RestoreFromSnapshot(&iter, valid_on_current_network);
+}
+
+void HostCachePersister::CompleteLoad(const std::string& data) {
+  DCHECK(foreground_runner_->RunsTasksInCurrentSequence());
+  loaded_ = true;
+  if (data.empty())
+    return;
+
+  bool success = LoadEntries(data);
+  UMA_HISTOGRAM_BOOLEAN("DNS.HostCache.SnapshotLoadSuccess", success);
+  UMA_HISTOGRAM_COUNTS_1000("DNS.HostCache.SnapshotRestoreSize",
+                            cache_->last_restore_size());
+  if (!success)
+    LOG(WARNING) << "Failed to restore the host cache snapshot";
+}
+
+}  // namespace net
@@ -0,0 +1,84 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef NET_DNS_HOST_CACHE_PERSISTER_H_
+#define NET_DNS_HOST_CACHE_PERSISTER_H_
+
+#include <string>
+
+#include "base/files/file_path.h"
+#include "base/files/important_file_writer.h"
+#include "base/macros.h"
+#include "base/memory/ref_counted.h"
+#include "base/memory/weak_ptr.h"
+#include "net/base/net_export.h"
+#include "net/base/network_change_notifier.h"
+#include "net/dns/host_cache.h"
+
+namespace base {
+class SequencedTaskRunner;
+}
+
+namespace net {
+
+// Keeps a binary snapshot of the successful entries of a HostCache on disk, so
+// that the cache starts warm after a restart. The snapshot is loaded
+// asynchronously on construction, and rewritten at most once a minute while
+// the cache changes.
+//
+// Restored entries are only considered fresh if the connection type is the
+// same as when the snapshot was written and the network hasn't changed while
+// it was loading. Otherwise they are restored as stale, and only served to
+// requests that accept stale results.
+//
+// Clients of this class should create, destroy, and call into it from one
+// thread. |background_runner| is used to read and write the file.
+class NET_EXPORT HostCachePersister
+    : public HostCache::PersistenceDelegate,
+      public base::ImportantFileWriter::DataSerializer,
+      public NetworkChangeNotifier::NetworkChangeObserver {
+ public:
+  HostCachePersister(
+      HostCache* cache,
+      const base::FilePath& path,
+      scoped_refptr<base::SequencedTaskRunner> background_runner);
+  ~HostCachePersister() override;
+
+  // HostCache::PersistenceDelegate:
+  void ScheduleWrite() override;
+
+  // base::ImportantFileWriter::DataSerializer:
+  bool SerializeData(std::string* data) override;
+
+  // NetworkChangeNotifier::NetworkChangeObserver:
+  void OnNetworkChanged(NetworkChangeNotifier::ConnectionType type) override;
+
+  // Restores the entries of a snapshot in |data| to the cache. Returns false
+  // if |data| isn't a valid snapshot.
+  bool LoadEntries(const std::string& data);
+
+  bool loaded() const { return loaded_; }
+
+ private:
+  void CompleteLoad(const std::string& data);
+
+  HostCache* const cache_;
+
+  // Helper for safely writing the data.
+  base::ImportantFileWriter writer_;
+
+  scoped_refptr<base::SequencedTaskRunner> foreground_runner_;
+
+  bool loaded_ = false;
+  // Whether the network changed before the snapshot was loaded.
+  bool network_changed_ = false;
+
+  base::WeakPtrFactory<HostCachePersister> weak_ptr_factory_;
+
+  DISALLOW_COPY_AND_ASSIGN(HostCachePersister);
+};
+
+}  // namespace net
+
+#endif  // NET_DNS_HOST_CACHE_PERSISTER_H_
@@ -0,0 +1,102 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "net/dns/host_cache_persister.h"
+
+#include <memory>
+#include <string>
+
+#include "base/files/file_path.h"
+#include "base/files/file_util.h"
+#include "base/files/scoped_temp_dir.h"
+#include "base/run_loop.h"
+#include "base/threading/thread_task_runner_handle.h"
+#include "base/time/time.h"
+#include "net/base/address_list.h"
+#include "net/base/ip_address.h"
+#include "net/base/ip_endpoint.h"
+#include "net/dns/host_cache.h"
+#include "net/test/test_with_scoped_task_environment.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace net {
+
+namespace {
+
+const int kMaxCacheEntries = 10;
+
+class HostCachePersisterTest : public TestWithScopedTaskEnvironment {
+ public:
+  HostCachePersisterTest() = default;
+
+  void SetUp() override {
+    ASSERT_TRUE(temp_dir_.CreateUniqueTempDir());
+    path_ = temp_dir_.GetPath().AppendASCII("HostCache");
+  }
+
+ protected:
+  std::unique_ptr<HostCachePersister> CreatePersister(HostCache* cache) {
+    auto persister = std::make_unique<HostCachePersister>(
+        cache, path_, base::ThreadTaskRunnerHandle::Get());
+    base::RunLoop().RunUntilIdle();
+    EXPECT_TRUE(persister->loaded());
+    return persister;
+  }
+
+  base::ScopedTempDir temp_dir_;
+  base::FilePath path_;
+};
+
+TEST_F(HostCachePersisterTest, RestoresAfterRestart) {
+  HostCache::Key key("foobar.com", DnsQueryType::A, 0,
+                     HostResolverSource::ANY);
+  AddressList addresses(IPEndPoint(IPAddress(1, 2, 3, 4), 0));
+  {
+    HostCache cache(kMaxCacheEntries);
+    std::unique_ptr<HostCachePersister> persister = CreatePersister(&cache);
+    EXPECT_EQ(0u, cache.size());
+    cache.Set(key,
+              HostCache::Entry(OK, addresses, HostCache::Entry::SOURCE_DNS),
+              base::TimeTicks::Now(), base::TimeDelta::FromMinutes(10));
+    // Destroying the persister writes the pending changes.
+  }
+  base::RunLoop().RunUntilIdle();
+  EXPECT_TRUE(base::PathExists(path_));
+
+  HostCache cache(kMaxCacheEntries);
+  std::unique_ptr<HostCachePersister> persister = CreatePersister(&cache);
+  EXPECT_EQ(1u, cache.last_restore_size());
+  const std::pair<const HostCache::Key, HostCache::Entry>* result =
+      cache.Lookup(key, base::TimeTicks::Now());
+  ASSERT_TRUE(result);
+  ASSERT_TRUE(result->second.addresses());
+  EXPECT_EQ(addresses.endpoints(),
+            result->second.addresses().value().endpoints());
+}
+
+TEST_F(HostCachePersisterTest, LoadEntries) {
+  HostCache cache(kMaxCacheEntries);
+  std::unique_ptr<HostCachePersister> persister = CreatePersister(&cache);
+  cache.Set(HostCache::Key("foobar.com", DnsQueryType::A, 0,
+                           HostResolverSource::ANY),
+            HostCache::Entry(OK,
+                             AddressList(IPEndPoint(IPAddress(1, 2, 3, 4), 0)),
+                             HostCache::Entry::SOURCE_DNS),
+            base::TimeTicks::Now(), base::TimeDelta::FromMinutes(10));
+  std::string data;
+  ASSERT_TRUE(persister->SerializeData(&data));
+
+  HostCache restored_cache(kMaxCacheEntries);
+  std::unique_ptr<HostCachePersister> restored_persister =
+      CreatePersister(&restored_cache);
+  EXPECT_TRUE(restored_persister->LoadEntries(data));
+  EXPECT_EQ(1u, restored_cache.size());
+
+  EXPECT_FALSE(restored_persister->LoadEntries(std::string()));
+  EXPECT_FALSE(restored_persister->LoadEntries("not a host cache snapshot"));
+}
+
+}  // namespace
+
+}  // namespace net
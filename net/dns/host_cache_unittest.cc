@@ -10,9 +10,11 @@
 #include "base/bind.h"
 #include "base/callback.h"
 #include "base/format_macros.h"
+#include "base/pickle.h"
 #include "base/stl_util.h"
 #include "base/strings/string_util.h"
 #include "base/strings/stringprintf.h"
+#include "base/test/simple_test_tick_clock.h"
 #include "base/values.h"
 #include "testing/gmock/include/gmock/gmock.h"
 #include "testing/gtest/include/gtest/gtest.h"
@@ -607,6 +609,71 @@ TEST(HostCacheTest, Stale) {
   EXPECT_EQ(3, stale.stale_hits);
 }
 
+TEST(HostCacheTest, LookupWithRefresh) {
+  const base::TimeDelta kTTL = base::TimeDelta::FromSeconds(10);
+  HostCache::RefreshPolicy policy;
+  policy.max_stale = base::TimeDelta::FromSeconds(5);
+  policy.refresh_window = base::TimeDelta::FromSeconds(2);
+  policy.min_hits = 2;
+
+  HostCache cache(kMaxCacheEntries);
+
+  // Start at t=0.
+  base::TimeTicks now;
+  HostCache::EntryStaleness stale;
+  bool needs_refresh = true;
+
+  HostCache::Key key = Key("foobar.com");
+  HostCache::Entry entry =
+      HostCache::Entry(OK, AddressList(), HostCache::Entry::SOURCE_UNKNOWN);
+
+  EXPECT_FALSE(
+      cache.LookupWithRefresh(key, now, policy, &stale, &needs_refresh));
+  EXPECT_FALSE(needs_refresh);
+  cache.Set(key, entry, now, kTTL);
+
+  // Advance to t=9, within the refresh window. The first hit is not enough.
+  now += base::TimeDelta::FromSeconds(9);
+  EXPECT_TRUE(
+      cache.LookupWithRefresh(key, now, policy, &stale, &needs_refresh));
+  EXPECT_FALSE(stale.is_stale());
+  EXPECT_FALSE(needs_refresh);
+  EXPECT_TRUE(
+      cache.LookupWithRefresh(key, now, policy, &stale, &needs_refresh));
+  EXPECT_FALSE(stale.is_stale());
+  EXPECT_TRUE(needs_refresh);
+
+  // Advance to t=14, expired but within |max_stale|.
+  now += base::TimeDelta::FromSeconds(5);
+  EXPECT_FALSE(cache.Lookup(key, now));
+  EXPECT_TRUE(
+      cache.LookupWithRefresh(key, now, policy, &stale, &needs_refresh));
+  EXPECT_TRUE(stale.is_stale());
+  EXPECT_EQ(base::TimeDelta::FromSeconds(4), stale.expired_by);
+  EXPECT_EQ(1, stale.stale_hits);
+  EXPECT_TRUE(needs_refresh);
+
+  // Advance to t=15, too stale.
+  now += base::TimeDelta::FromSeconds(1);
+  EXPECT_FALSE(
+      cache.LookupWithRefresh(key, now, policy, &stale, &needs_refresh));
+  EXPECT_FALSE(needs_refresh);
+
+  // Entries made stale by a network change are not served.
+  cache.Set(key, entry, now, kTTL);
+  cache.OnNetworkChange();
+  EXPECT_FALSE(
+      cache.LookupWithRefresh(key, now, policy, &stale, &needs_refresh));
+
+  // Neither are expired errors.
+  cache.Set(key, HostCache::Entry(ERR_NAME_NOT_RESOLVED, AddressList(),
+                                  HostCache::Entry::SOURCE_UNKNOWN),
+            now, kTTL);
+  now += kTTL;
+  EXPECT_FALSE(
+      cache.LookupWithRefresh(key, now, policy, &stale, &needs_refresh));
+}
+
 TEST(HostCacheTest, EvictStale) {
   HostCache cache(2);
 
@@ -962,6 +1029,133 @@ TEST(HostCacheTest, SerializeAndDeserialize_Hostname) {
   EXPECT_EQ(hostnames, result->second.hostnames().value());
 }
 
+TEST(HostCacheTest, SerializeAndDeserializeSnapshot) {
+  const base::TimeDelta kTTL = base::TimeDelta::FromSeconds(10);
+  base::SimpleTestTickClock tick_clock;
+  tick_clock.Advance(base::TimeDelta::FromHours(1));
+
+  HostCache cache(kMaxCacheEntries);
+  cache.set_tick_clock_for_testing(&tick_clock);
+
+  HostCache::Key address_key = Key("foobar.com");
+  address_key.secure = true;
+  AddressList addresses(IPEndPoint(IPAddress(1, 2, 3, 4), 0));
+  addresses.push_back(IPEndPoint(
+      IPAddress(0x20, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1), 0));
+  cache.Set(address_key,
+            HostCache::Entry(OK, addresses, HostCache::Entry::SOURCE_DNS),
+            tick_clock.NowTicks(), kTTL);
+
+  HostCache::Key text_key("foobar.com", DnsQueryType::TXT, 0,
+                          HostResolverSource::DNS);
+  std::vector<std::string> text_records({"foo", "bar"});
+  cache.Set(text_key,
+            HostCache::Entry(OK, text_records, HostCache::Entry::SOURCE_DNS),
+            tick_clock.NowTicks(), kTTL);
+
+  HostCache::Key hostname_key("foobar.com", DnsQueryType::PTR,
+                              HOST_RESOLVER_CANONNAME,
+                              HostResolverSource::DNS);
+  std::vector<HostPortPair> hostnames({HostPortPair("example.com", 95)});
+  cache.Set(hostname_key,
+            HostCache::Entry(OK, hostnames, HostCache::Entry::SOURCE_DNS),
+            tick_clock.NowTicks(), kTTL);
+
+  // Errors and expired entries aren't part of snapshots.
+  HostCache::Key error_key = Key("error.com");
+  cache.Set(error_key,
+            HostCache::Entry(ERR_NAME_NOT_RESOLVED,
+                             HostCache::Entry::SOURCE_DNS),
+            tick_clock.NowTicks(), kTTL);
+  HostCache::Key expired_key = Key("expired.com");
+  cache.Set(expired_key,
+            HostCache::Entry(OK, addresses, HostCache::Entry::SOURCE_DNS),
+            tick_clock.NowTicks() - kTTL, kTTL);
+  EXPECT_EQ(5u, cache.size());
+
+  tick_clock.Advance(base::TimeDelta::FromSeconds(4));
+  base::Pickle pickle;
+  cache.SerializeSnapshot(&pickle);
+
+  HostCache restored_cache(kMaxCacheEntries);
+  restored_cache.set_tick_clock_for_testing(&tick_clock);
+  base::PickleIterator iter(pickle);
+  EXPECT_TRUE(restored_cache.RestoreFromSnapshot(
+      &iter, true /* valid_on_current_network */));
+  EXPECT_EQ(3u, restored_cache.last_restore_size());
+  EXPECT_EQ(3u, restored_cache.size());
+  EXPECT_FALSE(restored_cache.Lookup(error_key, tick_clock.NowTicks()));
+  EXPECT_FALSE(restored_cache.Lookup(expired_key, tick_clock.NowTicks()));
+
+  const std::pair<const HostCache::Key, HostCache::Entry>* result =
+      restored_cache.Lookup(address_key, tick_clock.NowTicks());
+  ASSERT_TRUE(result);
+  EXPECT_TRUE(result->first.secure);
+  ASSERT_TRUE(result->second.addresses());
+  EXPECT_EQ(addresses.endpoints(),
+            result->second.addresses().value().endpoints());
+  EXPECT_FALSE(result->second.text_records());
+  EXPECT_FALSE(result->second.hostnames());
+  // Time to TimeTicks conversion is fuzzy, so just check that expected and
+  // actual expiration times are close.
+  EXPECT_GT(base::TimeDelta::FromMilliseconds(100),
+            (tick_clock.NowTicks() + base::TimeDelta::FromSeconds(6) -
+             result->second.expires())
+                .magnitude());
+
+  result = restored_cache.Lookup(text_key, tick_clock.NowTicks());
+  ASSERT_TRUE(result);
+  ASSERT_TRUE(result->second.text_records());
+  EXPECT_EQ(text_records, result->second.text_records().value());
+
+  result = restored_cache.Lookup(hostname_key, tick_clock.NowTicks());
+  ASSERT_TRUE(result);
+  EXPECT_EQ(HOST_RESOLVER_CANONNAME, result->first.host_resolver_flags);
+  ASSERT_TRUE(result->second.hostnames());
+  EXPECT_EQ(hostnames, result->second.hostnames().value());
+
+  // Entries restored from another network are only usable as stale ones.
+  HostCache stale_cache(kMaxCacheEntries);
+  stale_cache.set_tick_clock_for_testing(&tick_clock);
+  base::PickleIterator stale_iter(pickle);
+  EXPECT_TRUE(stale_cache.RestoreFromSnapshot(
+      &stale_iter, false /* valid_on_current_network */));
+  EXPECT_EQ(3u, stale_cache.size());
+  EXPECT_FALSE(stale_cache.Lookup(address_key, tick_clock.NowTicks()));
+  HostCache::EntryStaleness stale;
+  EXPECT_TRUE(
+      stale_cache.LookupStale(address_key, tick_clock.NowTicks(), &stale));
+  EXPECT_EQ(1, stale.network_changes);
+}
+
+TEST(HostCacheTest, DeserializeTruncatedSnapshot) {
+  base::SimpleTestTickClock tick_clock;
+  tick_clock.Advance(base::TimeDelta::FromHours(1));
+  HostCache cache(kMaxCacheEntries);
+  cache.set_tick_clock_for_testing(&tick_clock);
+  cache.Set(Key("foobar.com"),
+            HostCache::Entry(OK,
+                             AddressList(IPEndPoint(IPAddress(1, 2, 3, 4), 0)),
+                             HostCache::Entry::SOURCE_DNS),
+            tick_clock.NowTicks(), base::TimeDelta::FromSeconds(10));
+  base::Pickle pickle;
+  cache.SerializeSnapshot(&pickle);
+
+  base::Pickle truncated;
+  truncated.WriteBytes(pickle.payload(), pickle.payload_size() - sizeof(int));
+  HostCache restored_cache(kMaxCacheEntries);
+  restored_cache.set_tick_clock_for_testing(&tick_clock);
+  base::PickleIterator iter(truncated);
+  EXPECT_FALSE(restored_cache.RestoreFromSnapshot(
+      &iter, true /* valid_on_current_network */));
+  EXPECT_EQ(0u, restored_cache.size());
+
+  base::Pickle empty;
+  base::PickleIterator empty_iter(empty);
+  EXPECT_FALSE(restored_cache.RestoreFromSnapshot(
+      &empty_iter, true /* valid_on_current_network */));
+}
+
 TEST(HostCacheTest, PersistenceDelegate) {
   const base::TimeDelta kTTL = base::TimeDelta::FromSeconds(10);
   HostCache cache(kMaxCacheEntries);
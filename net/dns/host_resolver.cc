@@ -10,6 +10,7 @@
 #include "base/logging.h"
 #include "base/macros.h"
 #include "base/metrics/field_trial.h"
+#include "base/no_destructor.h"
 #include "base/strings/string_number_conversions.h"
 #include "base/strings/string_split.h"
 #include "base/values.h"
@@ -35,6 +36,12 @@ const size_t kDefaultMaxProcTasks = 6u;
 
 }  // namespace
 
+const base::Optional<AddressList>&
+HostResolver::ResolveHostRequest::GetPartialAddressResults() const {
+  static const base::NoDestructor<base::Optional<AddressList>> nullopt_result;
+  return *nullopt_result;
+}
+
 PrioritizedDispatcher::Limits HostResolver::Options::GetDispatcherLimits()
     const {
   PrioritizedDispatcher::Limits limits(NUM_PRIORITIES, max_concurrent_resolves);
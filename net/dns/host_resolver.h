@@ -12,6 +12,7 @@
 #include <string>
 #include <vector>
 
+#include "base/callback.h"
 #include "base/macros.h"
 #include "base/optional.h"
 #include "base/strings/string_piece.h"
@@ -110,6 +111,22 @@ class NET_EXPORT HostResolver {
     // the request is running (after Start() returns |ERR_IO_PENDING| and before
     // the callback is invoked).
     virtual void ChangeRequestPriority(RequestPriority priority) {}
+
+    // Sets a callback to run, at most once, when the results for one address
+    // family of an address query (e.g. the A records of an UNSPECIFIED query)
+    // are available before those of the other one. They can then be read with
+    // GetPartialAddressResults() until the request completes, letting callers
+    // start connecting early. The callback must not destroy the request.
+    //
+    // Must be called before Start(). Implementations that can't provide
+    // partial results never run the callback.
+    virtual void SetPartialResultsCallback(base::OnceClosure callback) {}
+
+    // Partial address results of the request, only set once the partial
+    // results callback has run. Unlike GetAddressResults(), these may be read
+    // while the request is still running.
+    virtual const base::Optional<AddressList>& GetPartialAddressResults()
+        const;
   };
 
   // |max_concurrent_resolves| is how many resolve requests will be allowed to
@@ -119,6 +136,9 @@ class NET_EXPORT HostResolver {
   // resolution. Pass HostResolver::kDefaultRetryAttempts to choose a default
   // value.
   // |enable_caching| controls whether a HostCache is used.
+  // |cache_refresh_policy| controls which cache entries may be served to
+  // requests allowing non-stale cache results while they are re-resolved in
+  // the background. Disabled by default.
   struct NET_EXPORT Options {
     Options();
 
@@ -127,6 +147,7 @@ class NET_EXPORT HostResolver {
     size_t max_concurrent_resolves;
     size_t max_retry_attempts;
     bool enable_caching;
+    HostCache::RefreshPolicy cache_refresh_policy;
   };
 
   // Factory class. Useful for classes that need to inject and override resolver
@@ -55,6 +55,7 @@
 #include "build/build_config.h"
 #include "net/base/address_family.h"
 #include "net/base/address_list.h"
+#include "net/base/features.h"
 #include "net/base/host_port_pair.h"
 #include "net/base/ip_address.h"
 #include "net/base/ip_endpoint.h"
@@ -569,6 +570,18 @@ class HostResolverManager::RequestImpl
 
   void ChangeRequestPriority(RequestPriority priority) override;
 
+  void SetPartialResultsCallback(base::OnceClosure callback) override {
+    DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+    DCHECK(!job_);
+    DCHECK(!complete_);
+    partial_results_callback_ = std::move(callback);
+  }
+
+  const base::Optional<AddressList>& GetPartialAddressResults()
+      const override {
+    return partial_address_results_;
+  }
+
   void set_results(HostCache::Entry results) {
     // Should only be called at most once and before request is marked
     // completed.
@@ -608,6 +621,19 @@ class HostResolverManager::RequestImpl
     DCHECK(!results_);
   }
 
+  // Provides the addresses of the first family resolved by |job| to the
+  // request, if it asked for them.
+  void OnJobPartialResults(Job* job, const AddressList& addresses) {
+    DCHECK_EQ(job_, job);
+    DCHECK(!complete_);
+    if (!partial_results_callback_ || parameters_.is_speculative)
+      return;
+
+    partial_address_results_ =
+        AddressList::CopyWithPort(addresses, request_host_.port());
+    std::move(partial_results_callback_).Run();
+  }
+
   // Cleans up Job assignment, marks request completed, and calls the completion
   // callback.
   void OnJobCompleted(Job* job, int error) {
@@ -662,6 +688,8 @@ class HostResolverManager::RequestImpl
 
   // The user's callback to invoke when the request completes.
   CompletionOnceCallback callback_;
+  base::OnceClosure partial_results_callback_;
+  base::Optional<AddressList> partial_address_results_;
 
   bool complete_;
   base::Optional<HostCache::Entry> results_;
@@ -912,10 +940,11 @@ class HostResolverManager::DnsTask : public base::SupportsWeakPtr<DnsTask> {
                                    const HostCache::Entry& results,
                                    bool secure) = 0;
 
-    // Called when the first of two jobs succeeds.  If the first completed
-    // transaction fails, this is not called.  Also not called when the DnsTask
-    // only needs to run one transaction.
-    virtual void OnFirstDnsTransactionComplete() = 0;
+    // Called when the first of two jobs succeeds, with its |results|.  If the
+    // first completed transaction fails, this is not called.  Also not called
+    // when the DnsTask only needs to run one transaction.
+    virtual void OnFirstDnsTransactionComplete(
+        const HostCache::Entry& results) = 0;
 
     virtual URLRequestContext* url_request_context() = 0;
     virtual RequestPriority priority() const = 0;
@@ -1083,7 +1112,7 @@ class HostResolverManager::DnsTask : public base::SupportsWeakPtr<DnsTask> {
       saved_secure_ = secure;
       // No need to repeat the suffix search.
       key_.hostname = transaction->GetHostname();
-      delegate_->OnFirstDnsTransactionComplete();
+      delegate_->OnFirstDnsTransactionComplete(saved_results_.value());
       return;
     }
 
@@ -1421,6 +1450,7 @@ class HostResolverManager::Job : public PrioritizedDispatcher::Job,
         num_occupied_job_slots_(0),
         dns_task_error_(OK),
         tick_clock_(tick_clock),
+        proc_task_race_timer_(tick_clock),
         net_log_(
             NetLogWithSource::Make(source_net_log.net_log(),
                                    NetLogSourceType::HOST_RESOLVER_IMPL_JOB)),
@@ -1563,7 +1593,9 @@ class HostResolverManager::Job : public PrioritizedDispatcher::Job,
       if (dns_task_->allow_fallback_resolution()) {
         KillDnsTask();
         dns_task_error_ = OK;
-        StartProcTask();
+        // A ProcTask racing the DnsTask may already be running.
+        if (!is_proc_running())
+          StartProcTask();
       } else if (!fallback_only) {
         CompleteRequestsWithError(error);
       }
@@ -1622,6 +1654,7 @@ class HostResolverManager::Job : public PrioritizedDispatcher::Job,
 
  private:
   void KillDnsTask() {
+    proc_task_race_timer_.Stop();
     if (dns_task_) {
       ReduceToOneJobSlot();
       dns_task_.reset();
@@ -1711,7 +1744,9 @@ class HostResolverManager::Job : public PrioritizedDispatcher::Job,
   // ThreadPool threads low, we will need to use an "inner"
   // PrioritizedDispatcher with tighter limits.
   void StartProcTask() {
-    DCHECK(!is_running());
+    // A DnsTask may still be running if the ProcTask races it.
+    DCHECK(!is_proc_running());
+    DCHECK(!is_mdns_running());
     DCHECK(IsAddressType(key_.dns_query_type));
 
     proc_task_ = std::make_unique<ProcTask>(
@@ -1731,6 +1766,17 @@ class HostResolverManager::Job : public PrioritizedDispatcher::Job,
                           const AddressList& addr_list) {
     DCHECK(is_proc_running());
 
+    if (is_dns_running()) {
+      // This ProcTask raced a DnsTask using DNS-over-HTTPS. Keep waiting for
+      // the latter if the system resolver failed.
+      UMA_HISTOGRAM_BOOLEAN("Net.DNS.DnsOverHttpsRace.SystemResolverSuccess",
+                            net_error == OK);
+      if (net_error != OK) {
+        proc_task_ = nullptr;
+        return;
+      }
+    }
+
     if (dns_task_error_ != OK) {
       // This ProcTask was a fallback resolution after a failed DnsTask.
       if (net_error == OK) {
@@ -1778,6 +1824,7 @@ class HostResolverManager::Job : public PrioritizedDispatcher::Job,
       // Schedule a second transaction, if needed.
       if (dns_task_->needs_two_transactions())
         Schedule(true);
+      MaybeStartProcTaskRaceTimer();
     } else {
       // Cannot start a DNS task when DnsClient or config is not available.
       // Since we cannot complete synchronously from here, post a failure.
@@ -1796,6 +1843,35 @@ class HostResolverManager::Job : public PrioritizedDispatcher::Job,
     dns_task_->StartSecondTransaction();
   }
 
+  // DNS-over-HTTPS lookups can be much slower than the system resolver, e.g.
+  // when the server is far away or the connection to it is being set up.
+  // Unless fallback to ProcTask is disallowed, start a ProcTask racing the
+  // DnsTask if it hasn't completed after a delay.
+  void MaybeStartProcTaskRaceTimer() {
+    DCHECK(is_dns_running());
+    if (!base::FeatureList::IsEnabled(
+            features::kRaceDnsOverHttpsWithSystemResolver) ||
+        !dns_task_->allow_fallback_resolution() ||
+        !resolver_->allow_fallback_to_proctask_) {
+      return;
+    }
+    const DnsConfig* config = resolver_->dns_client_->GetConfig();
+    if (!config || config->dns_over_https_servers.empty())
+      return;
+
+    proc_task_race_timer_.Start(
+        FROM_HERE,
+        base::TimeDelta::FromMilliseconds(
+            features::kRaceDnsOverHttpsDelayMs.Get()),
+        base::BindOnce(&Job::StartProcTaskRace, base::Unretained(this)));
+  }
+
+  void StartProcTaskRace() {
+    DCHECK(is_dns_running());
+    DCHECK(!is_proc_running());
+    StartProcTask();
+  }
+
   // Called if DnsTask fails. It is posted from StartDnsTask, so Job may be
   // deleted before this callback. In this case dns_task is deleted as well,
   // so we use it as indicator whether Job is still valid.
@@ -1810,6 +1886,12 @@ class HostResolverManager::Job : public PrioritizedDispatcher::Job,
     if (!dns_task)
       return;
 
+    if (is_proc_running()) {
+      // A racing ProcTask is already running, so just wait for it.
+      KillDnsTask();
+      return;
+    }
+
     if (duration < base::TimeDelta::FromMilliseconds(10)) {
       base::UmaHistogramSparse("Net.DNS.DnsTask.ErrorBeforeFallback.Fast",
                                std::abs(failure_results.error()));
@@ -1850,6 +1932,12 @@ class HostResolverManager::Job : public PrioritizedDispatcher::Job,
     }
 
     UMA_HISTOGRAM_LONG_TIMES_100("Net.DNS.DnsTask.SuccessTime", duration);
+    if (is_proc_running()) {
+      // The DnsTask won a race against the system resolver, which is
+      // cancelled by CompleteRequests().
+      UMA_HISTOGRAM_LONG_TIMES_100("Net.DNS.DnsOverHttpsRace.DnsTaskWinTime",
+                                   duration);
+    }
 
     resolver_->OnDnsTaskResolve();
 
@@ -1865,7 +1953,8 @@ class HostResolverManager::Job : public PrioritizedDispatcher::Job,
     CompleteRequests(results, bounded_ttl, true /* allow_cache */, secure);
   }
 
-  void OnFirstDnsTransactionComplete() override {
+  void OnFirstDnsTransactionComplete(
+      const HostCache::Entry& results) override {
     DCHECK(dns_task_->needs_two_transactions());
     DCHECK_EQ(dns_task_->needs_another_transaction(), is_queued());
     // No longer need to occupy two dispatcher slots.
@@ -1876,6 +1965,17 @@ class HostResolverManager::Job : public PrioritizedDispatcher::Job,
     // for the second slot.
     if (dns_task_->needs_another_transaction())
       dns_task_->StartSecondTransaction();
+
+    // Let requests start connecting to the addresses of the first family.
+    if (results.error() != OK || !results.addresses() ||
+        results.addresses().value().empty() ||
+        ContainsIcannNameCollisionIp(results.addresses().value())) {
+      return;
+    }
+    for (auto* node = requests_.head(); node != requests_.end();
+         node = node->next()) {
+      node->value()->OnJobPartialResults(this, results.addresses().value());
+    }
   }
 
   void StartMdnsTask() {
@@ -2143,6 +2243,9 @@ class HostResolverManager::Job : public PrioritizedDispatcher::Job,
   const base::TickClock* tick_clock_;
   base::TimeTicks start_time_;
 
+  // Starts a ProcTask racing a slow DnsTask using DNS-over-HTTPS.
+  base::OneShotTimer proc_task_race_timer_;
+
   NetLogWithSource net_log_;
 
   // Resolves the host using a HostResolverProc.
@@ -2167,7 +2270,8 @@ class HostResolverManager::Job : public PrioritizedDispatcher::Job,
 
 HostResolverManager::HostResolverManager(const Options& options,
                                          NetLog* net_log)
-    : max_queued_jobs_(0),
+    : cache_refresh_policy_(options.cache_refresh_policy),
+      max_queued_jobs_(0),
       proc_params_(nullptr, options.max_retry_attempts),
       net_log_(net_log),
       received_dns_config_(false),
@@ -2448,11 +2552,12 @@ int HostResolverManager::Resolve(RequestImpl* request) {
 
   Key key;
   base::Optional<HostCache::EntryStaleness> stale_info;
+  bool needs_refresh = false;
   HostCache::Entry results = ResolveLocally(
       request->request_host().host(), request->parameters().dns_query_type,
       request->parameters().source, request->host_resolver_flags(),
       request->parameters().cache_usage, request->source_net_log(), &key,
-      &stale_info);
+      &stale_info, &needs_refresh);
   if (results.error() != ERR_DNS_CACHE_MISS ||
       request->parameters().source == HostResolverSource::LOCAL_ONLY) {
     if (results.error() == OK && !request->parameters().is_speculative) {
@@ -2464,6 +2569,10 @@ int HostResolverManager::Resolve(RequestImpl* request) {
     LogFinishRequest(request->source_net_log(), results.error());
     RecordTotalTime(request->parameters().is_speculative, true /* from_cache */,
                     base::TimeDelta());
+    if (needs_refresh) {
+      StartCacheRefresh(key, request->request_host().host(),
+                        request->parameters(), request->source_net_log());
+    }
     return results.error();
   }
 
@@ -2482,9 +2591,12 @@ HostCache::Entry HostResolverManager::ResolveLocally(
     ResolveHostParameters::CacheUsage cache_usage,
     const NetLogWithSource& source_net_log,
     Key* out_key,
-    base::Optional<HostCache::EntryStaleness>* out_stale_info) {
+    base::Optional<HostCache::EntryStaleness>* out_stale_info,
+    bool* out_needs_refresh) {
   DCHECK(out_stale_info);
+  DCHECK(out_needs_refresh);
   *out_stale_info = base::nullopt;
+  *out_needs_refresh = false;
 
   IPAddress ip_address;
   IPAddress* ip_address_ptr = nullptr;
@@ -2535,7 +2647,7 @@ HostCache::Entry HostResolverManager::ResolveLocally(
     resolved = ServeFromCache(
         *out_key,
         cache_usage == ResolveHostParameters::CacheUsage::STALE_ALLOWED,
-        out_stale_info);
+        out_stale_info, out_needs_refresh);
     if (resolved) {
       DCHECK(out_stale_info->has_value());
       source_net_log.AddEvent(NetLogEventType::HOST_RESOLVER_IMPL_CACHE_HIT,
@@ -2622,9 +2734,12 @@ base::Optional<HostCache::Entry> HostResolverManager::ResolveAsIP(
 base::Optional<HostCache::Entry> HostResolverManager::ServeFromCache(
     const Key& key,
     bool allow_stale,
-    base::Optional<HostCache::EntryStaleness>* out_stale_info) {
+    base::Optional<HostCache::EntryStaleness>* out_stale_info,
+    bool* out_needs_refresh) {
   DCHECK(out_stale_info);
+  DCHECK(out_needs_refresh);
   *out_stale_info = base::nullopt;
+  *out_needs_refresh = false;
 
   if (!cache_.get())
     return base::nullopt;
@@ -2639,6 +2754,10 @@ base::Optional<HostCache::Entry> HostResolverManager::ServeFromCache(
   if (allow_stale) {
     cache_result = cache_->LookupStale(effective_key, tick_clock_->NowTicks(),
                                        &staleness, true /* ignore_secure */);
+  } else if (cache_refresh_policy_.enabled()) {
+    cache_result = cache_->LookupWithRefresh(
+        effective_key, tick_clock_->NowTicks(), cache_refresh_policy_,
+        &staleness, out_needs_refresh, true /* ignore_secure */);
   } else {
     cache_result = cache_->Lookup(effective_key, tick_clock_->NowTicks(),
                                   true /* ignore_secure */);
@@ -2651,6 +2770,40 @@ base::Optional<HostCache::Entry> HostResolverManager::ServeFromCache(
   return cache_result->second;
 }
 
+void HostResolverManager::StartCacheRefresh(
+    const Key& key,
+    const std::string& hostname,
+    const ResolveHostParameters& parameters,
+    const NetLogWithSource& source_net_log) {
+  if (cache_refreshes_.count(key))
+    return;
+
+  ResolveHostParameters refresh_parameters = parameters;
+  refresh_parameters.initial_priority = LOWEST;
+  refresh_parameters.cache_usage =
+      ResolveHostParameters::CacheUsage::DISALLOWED;
+  refresh_parameters.is_speculative = true;
+  // Local-only requests are served non-local-only results, see
+  // ServeFromCache().
+  if (refresh_parameters.source == HostResolverSource::LOCAL_ONLY)
+    refresh_parameters.source = HostResolverSource::ANY;
+
+  std::unique_ptr<CancellableRequest> request =
+      CreateRequest(HostPortPair(hostname, 0), source_net_log,
+                    refresh_parameters);
+  int rv = request->Start(
+      base::BindOnce(&HostResolverManager::OnCacheRefreshComplete,
+                     weak_ptr_factory_.GetWeakPtr(), key));
+  UMA_HISTOGRAM_BOOLEAN("Net.DNS.CacheRefresh.Async", rv == ERR_IO_PENDING);
+  if (rv == ERR_IO_PENDING)
+    cache_refreshes_[key] = std::move(request);
+}
+
+void HostResolverManager::OnCacheRefreshComplete(const Key& key, int error) {
+  UMA_HISTOGRAM_BOOLEAN("Net.DNS.CacheRefresh.Success", error == OK);
+  cache_refreshes_.erase(key);
+}
+
 base::Optional<HostCache::Entry> HostResolverManager::ServeFromHosts(
     const Key& key) {
   if (!HaveDnsConfig() || !IsAddressType(key.dns_query_type))
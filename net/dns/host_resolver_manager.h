@@ -228,7 +228,9 @@ class NET_EXPORT HostResolverManager
   //
   // If results are returned from the host cache, |out_stale_info| will be
   // filled in with information on how stale or fresh the result is. Otherwise,
-  // |out_stale_info| will be set to |base::nullopt|.
+  // |out_stale_info| will be set to |base::nullopt|. |*out_needs_refresh| is
+  // set to whether the cache entry should be refreshed per
+  // |cache_refresh_policy_|.
   //
   // If |cache_usage == ResolveHostParameters::CacheUsage::STALE_ALLOWED|, then
   // stale cache entries can be returned.
@@ -240,7 +242,8 @@ class NET_EXPORT HostResolverManager
       ResolveHostParameters::CacheUsage cache_usage,
       const NetLogWithSource& request_net_log,
       Key* out_key,
-      base::Optional<HostCache::EntryStaleness>* out_stale_info);
+      base::Optional<HostCache::EntryStaleness>* out_stale_info,
+      bool* out_needs_refresh);
 
   // Attempts to create and start a Job to asynchronously attempt to resolve
   // |key|. On success, returns ERR_IO_PENDING and attaches the Job to
@@ -258,10 +261,22 @@ class NET_EXPORT HostResolverManager
   // |base::nullopt|.
   //
   // If |allow_stale| is true, then stale cache entries can be returned.
+  // Otherwise, the entries allowed by |cache_refresh_policy_| can be, and
+  // |*out_needs_refresh| is set to whether the entry should be refreshed.
   base::Optional<HostCache::Entry> ServeFromCache(
       const Key& key,
       bool allow_stale,
-      base::Optional<HostCache::EntryStaleness>* out_stale_info);
+      base::Optional<HostCache::EntryStaleness>* out_stale_info,
+      bool* out_needs_refresh);
+
+  // Re-resolves |key|, which was served from the cache to a request for
+  // |hostname| with |parameters|, in the background to refresh the cache
+  // entry. Does nothing if a refresh of |key| is already running.
+  void StartCacheRefresh(const Key& key,
+                         const std::string& hostname,
+                         const ResolveHostParameters& parameters,
+                         const NetLogWithSource& source_net_log);
+  void OnCacheRefreshComplete(const Key& key, int error);
 
   // Iff we have a DnsClient with a valid DnsConfig, and |key| can be resolved
   // from the HOSTS file, return the results.
@@ -363,6 +378,12 @@ class NET_EXPORT HostResolverManager
   // Map from HostCache::Key to a Job.
   JobMap jobs_;
 
+  // See HostResolver::Options.
+  const HostCache::RefreshPolicy cache_refresh_policy_;
+
+  // The speculative requests refreshing cache entries in the background.
+  std::map<Key, std::unique_ptr<CancellableRequest>> cache_refreshes_;
+
   // Starts Jobs according to their priority and the configured limits.
   std::unique_ptr<PrioritizedDispatcher> dispatcher_;
 
@@ -25,6 +25,7 @@
 #include "base/synchronization/lock.h"
 #include "base/test/bind_test_util.h"
 #include "base/test/simple_test_clock.h"
+#include "base/test/simple_test_tick_clock.h"
 #include "base/test/test_mock_time_task_runner.h"
 #include "base/test/test_timeouts.h"
 #include "base/threading/thread_restrictions.h"
@@ -1167,6 +1168,65 @@ TEST_F(HostResolverManagerTest, BypassCache) {
   EXPECT_EQ(2u, proc_->GetCaptureList().size());
 }
 
+// Test that popular entries are refreshed in the background near expiry, and
+// served while refreshing after expiry.
+TEST_F(HostResolverManagerTest, CacheRefresh) {
+  HostResolver::Options options = DefaultOptions();
+  options.cache_refresh_policy.max_stale = base::TimeDelta::FromSeconds(30);
+  options.cache_refresh_policy.refresh_window =
+      base::TimeDelta::FromSeconds(10);
+  resolver_ = std::make_unique<TestHostResolverManager>(options, nullptr);
+  resolver_->set_proc_params_for_test(DefaultParams(proc_.get()));
+  base::SimpleTestTickClock tick_clock;
+  resolver_->SetTickClockForTesting(&tick_clock);
+  proc_->AddRuleForAllFamilies("just.testing", "192.168.1.42");
+  proc_->SignalMultiple(3u);
+
+  ResolveHostResponseHelper initial_response(resolver_->CreateRequest(
+      HostPortPair("just.testing", 80), NetLogWithSource(), base::nullopt));
+  EXPECT_THAT(initial_response.result_error(), IsOk());
+  EXPECT_EQ(1u, proc_->GetCaptureList().size());
+
+  ResolveHostResponseHelper cached_response(resolver_->CreateRequest(
+      HostPortPair("just.testing", 80), NetLogWithSource(), base::nullopt));
+  EXPECT_TRUE(cached_response.complete());
+  EXPECT_THAT(cached_response.result_error(), IsOk());
+  RunUntilIdle();
+  EXPECT_EQ(1u, proc_->GetCaptureList().size());
+
+  // Within the refresh window of the 60s TTL of ProcTask results.
+  tick_clock.Advance(base::TimeDelta::FromSeconds(55));
+  ResolveHostResponseHelper refreshing_response(resolver_->CreateRequest(
+      HostPortPair("just.testing", 80), NetLogWithSource(), base::nullopt));
+  EXPECT_TRUE(refreshing_response.complete());
+  EXPECT_THAT(refreshing_response.result_error(), IsOk());
+  EXPECT_FALSE(
+      refreshing_response.request()->GetStaleInfo().value().is_stale());
+  RunUntilIdle();
+  EXPECT_EQ(2u, proc_->GetCaptureList().size());
+
+  // The refreshed entry expires at t=115.
+  tick_clock.Advance(base::TimeDelta::FromSeconds(70));
+  ResolveHostResponseHelper stale_response(resolver_->CreateRequest(
+      HostPortPair("just.testing", 80), NetLogWithSource(), base::nullopt));
+  EXPECT_TRUE(stale_response.complete());
+  EXPECT_THAT(stale_response.result_error(), IsOk());
+  EXPECT_THAT(stale_response.request()->GetAddressResults().value().endpoints(),
+              testing::ElementsAre(CreateExpected("192.168.1.42", 80)));
+  EXPECT_TRUE(stale_response.request()->GetStaleInfo().value().is_stale());
+  RunUntilIdle();
+  EXPECT_EQ(3u, proc_->GetCaptureList().size());
+
+  // Too stale.
+  tick_clock.Advance(base::TimeDelta::FromSeconds(100));
+  ResolveHostResponseHelper miss_response(resolver_->CreateRequest(
+      HostPortPair("just.testing", 80), NetLogWithSource(), base::nullopt));
+  EXPECT_FALSE(miss_response.complete());
+  proc_->SignalMultiple(1u);
+  EXPECT_THAT(miss_response.result_error(), IsOk());
+  EXPECT_EQ(4u, proc_->GetCaptureList().size());
+}
+
 // Test that IP address changes flush the cache but initial DNS config reads
 // do not.
 TEST_F(HostResolverManagerTest, FlushCacheOnIPAddressChange) {
@@ -4063,6 +4123,38 @@ TEST_F(HostResolverManagerDnsTest, CancelWithIPv6TransactionActive) {
   // Dispatcher state checked in TearDown.
 }
 
+// The results of the first completed transaction are made available before
+// the request completes.
+TEST_F(HostResolverManagerDnsTest, PartialResults) {
+  ChangeDnsConfig(CreateValidDnsConfig());
+
+  std::unique_ptr<HostResolverManager::CancellableRequest> request =
+      resolver_->CreateRequest(HostPortPair("6slow_ok", 80),
+                               NetLogWithSource(), base::nullopt);
+  int partial_results_count = 0;
+  request->SetPartialResultsCallback(base::BindOnce(
+      [](int* count) { ++*count; }, base::Unretained(&partial_results_count)));
+  ResolveHostResponseHelper response(std::move(request));
+  EXPECT_FALSE(response.request()->GetPartialAddressResults());
+
+  // The IPv4 request should complete, the IPv6 request is still pending.
+  base::RunLoop().RunUntilIdle();
+  EXPECT_FALSE(response.complete());
+  EXPECT_EQ(1, partial_results_count);
+  const base::Optional<AddressList>& partial_results =
+      response.request()->GetPartialAddressResults();
+  ASSERT_TRUE(partial_results);
+  EXPECT_THAT(partial_results.value().endpoints(),
+              testing::ElementsAre(CreateExpected("127.0.0.1", 80)));
+
+  dns_client_->CompleteDelayedTransactions();
+  EXPECT_THAT(response.result_error(), IsOk());
+  EXPECT_EQ(1, partial_results_count);
+  EXPECT_THAT(response.request()->GetAddressResults().value().endpoints(),
+              testing::UnorderedElementsAre(CreateExpected("127.0.0.1", 80),
+                                            CreateExpected("::1", 80)));
+}
+
 // Cancel a request with only the IPv4 transaction pending.
 TEST_F(HostResolverManagerDnsTest, CancelWithIPv4TransactionPending) {
   set_allow_fallback_to_proctask(false);
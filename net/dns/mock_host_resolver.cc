@@ -140,6 +140,17 @@ class MockHostResolverBase::RequestImpl
     priority_ = priority;
   }
 
+  void SetPartialResultsCallback(base::OnceClosure callback) override {
+    DCHECK_EQ(0u, id_);
+    DCHECK(!complete_);
+    partial_results_callback_ = std::move(callback);
+  }
+
+  const base::Optional<AddressList>& GetPartialAddressResults()
+      const override {
+    return partial_address_results_;
+  }
+
   void set_address_results(
       const AddressList& address_results,
       base::Optional<HostCache::EntryStaleness> staleness) {
@@ -153,6 +164,14 @@ class MockHostResolverBase::RequestImpl
     staleness_ = std::move(staleness);
   }
 
+  void OnPartialResults(const AddressList& address_results) {
+    DCHECK(!complete_);
+    if (!partial_results_callback_)
+      return;
+    partial_address_results_ = address_results;
+    std::move(partial_results_callback_).Run();
+  }
+
   void OnAsyncCompleted(size_t id, int error) {
     DCHECK_EQ(id_, id);
     id_ = 0;
@@ -191,6 +210,8 @@ class MockHostResolverBase::RequestImpl
 
   base::Optional<AddressList> address_results_;
   base::Optional<HostCache::EntryStaleness> staleness_;
+  base::OnceClosure partial_results_callback_;
+  base::Optional<AddressList> partial_address_results_;
 
   // Used while stored with the resolver for async resolution.  Otherwise 0.
   size_t id_;
@@ -368,6 +389,29 @@ void MockHostResolverBase::ResolveNow(size_t id) {
   req->OnAsyncCompleted(id, error);
 }
 
+void MockHostResolverBase::ResolvePartiallyNow(size_t id,
+                                               AddressFamily address_family) {
+  auto it = requests_.find(id);
+  if (it == requests_.end())
+    return;  // was canceled
+
+  RequestImpl* req = it->second;
+  AddressList addresses;
+  int error = ResolveProc(req->request_host(), address_family,
+                          req->host_resolver_flags(), req->parameters().source,
+                          &addresses);
+  if (error != OK || req->parameters().is_speculative)
+    return;
+
+  AddressList partial_addresses;
+  for (const IPEndPoint& endpoint : addresses) {
+    if (endpoint.GetFamily() == address_family)
+      partial_addresses.push_back(endpoint);
+  }
+  if (!partial_addresses.empty())
+    req->OnPartialResults(partial_addresses);
+}
+
 void MockHostResolverBase::DetachRequest(size_t id) {
   auto it = requests_.find(id);
   CHECK(it != requests_.end());
@@ -154,6 +154,10 @@ class MockHostResolverBase
   // Resolve request stored in |requests_|. Pass rv to callback.
   void ResolveNow(size_t id);
 
+  // Provides the |address_family| addresses request |id| would resolve to as
+  // its partial results, if it asked for them, without completing it.
+  void ResolvePartiallyNow(size_t id, AddressFamily address_family);
+
   // Detach cancelled request.
   void DetachRequest(size_t id);
 
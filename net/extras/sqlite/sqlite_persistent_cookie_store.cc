@@ -8,7 +8,9 @@
 #include <map>
 #include <memory>
 #include <set>
+#include <string>
 #include <tuple>
+#include <vector>
 
 #include "base/bind.h"
 #include "base/callback.h"
@@ -289,6 +291,7 @@ class SQLitePersistentCookieStore::Backend
   ~Backend() override {
     DCHECK_EQ(0u, num_pending_);
     DCHECK(pending_.empty());
+    DCHECK(pending_access_updates_.empty());
   }
 
   // Database upgrade statements.
@@ -308,6 +311,12 @@ class SQLitePersistentCookieStore::Backend
     OperationType op() const { return op_; }
     const CanonicalCookie& cc() const { return cc_; }
 
+    // Folds an access time update of the cookie into a pending add.
+    void SetLastAccessDate(const base::Time& date) {
+      DCHECK_EQ(COOKIE_ADD, op_);
+      cc_.SetLastAccessDate(date);
+    }
+
    private:
     OperationType op_;
     CanonicalCookie cc_;
@@ -363,7 +372,8 @@ class SQLitePersistentCookieStore::Backend
   // assumes |key| includes all related domains within an eTLD + 1.
   bool LoadCookiesForDomains(const std::set<std::string>& key);
 
-  // Batch a cookie operation (add or delete)
+  // Batch a cookie operation (add or delete). It replaces any pending operation
+  // on the same cookie.
   void BatchOperation(PendingOperation::OperationType op,
                       const CanonicalCookie& cc);
   // Commit our pending operations to the database.
@@ -385,13 +395,19 @@ class SQLitePersistentCookieStore::Backend
     RecordCookieLoadProblem(COOKIE_LOAD_PROBLEM_OPEN_DB);
   }
 
-  typedef std::list<std::unique_ptr<PendingOperation>> PendingOperationsForKey;
+  // The final state of each cookie since the last commit, keyed by
+  // CanonicalCookie::UniqueKey(), so that only that state is written.
   typedef std::map<std::tuple<std::string, std::string, std::string>,
-                   PendingOperationsForKey>
+                   std::unique_ptr<PendingOperation>>
       PendingOperationsMap;
   PendingOperationsMap pending_ GUARDED_BY(lock_);
   PendingOperationsMap::size_type num_pending_ GUARDED_BY(lock_);
-  // Guard |cookies_|, |pending_|, |num_pending_|.
+  // Access time updates of cookies without a pending add or delete. They are
+  // written by the next commit, but don't count towards the batch size of
+  // |num_pending_|, and only schedule a commit of their own after a longer
+  // delay, see UpdateCookieAccessTime().
+  PendingOperationsMap pending_access_updates_ GUARDED_BY(lock_);
+  // Guard |cookies_|, |pending_|, |num_pending_|, |pending_access_updates_|.
   base::Lock lock_;
 
   // Temporary buffer for cookies loaded from DB. Accumulates cookies to reduce
@@ -557,6 +573,87 @@ bool CreateV10Schema(sql::Database* db) {
   return true;
 }
 
+// Commits write the rows of large batches of adds and deletes with multi-row
+// statements of this many rows. An add binds kAddColumnCount parameters per
+// row, which keeps the statements under SQLite's default limit of 999.
+const size_t kRowsPerMultiRowStatement = 32;
+const int kAddColumnCount = 14;
+
+// The add statements replace any row of the same cookie, which also covers a
+// delete followed by an add since the last commit.
+const char kAddStatementPrefix[] =
+    "INSERT OR REPLACE INTO cookies (creation_utc, host_key, name, value, "
+    "encrypted_value, path, expires_utc, is_secure, is_httponly, "
+    "firstpartyonly, last_access_utc, has_expires, is_persistent, priority) "
+    "VALUES ";
+const char kAddStatementRow[] = "(?,?,?,?,?,?,?,?,?,?,?,?,?,?)";
+
+const char kDeleteStatementPrefix[] = "DELETE FROM cookies WHERE ";
+const char kDeleteStatementRow[] = "(name=? AND host_key=? AND path=?)";
+
+// Returns |prefix| followed by |row_count| times |row|, separated by
+// |separator|.
+std::string MakeMultiRowStatement(const char* prefix,
+                                  const char* row,
+                                  const char* separator,
+                                  size_t row_count) {
+  std::string sql(prefix);
+  for (size_t i = 0; i < row_count; ++i) {
+    if (i > 0)
+      sql += separator;
+    sql += row;
+  }
+  return sql;
+}
+
+// A cookie to add in a commit, with its value encrypted if the store
+// encrypts cookies.
+struct CookieToAdd {
+  const CanonicalCookie* cc;
+  base::Optional<std::string> encrypted_value;
+};
+
+// Binds the columns of kAddStatementRow for |cookie|, starting at parameter
+// |first|.
+void BindCookieToAdd(sql::Statement* statement,
+                     int first,
+                     const CookieToAdd& cookie) {
+  const CanonicalCookie& cc = *cookie.cc;
+  statement->BindInt64(first, cc.CreationDate().ToInternalValue());
+  statement->BindString(first + 1, cc.Domain());
+  statement->BindString(first + 2, cc.Name());
+  if (cookie.encrypted_value) {
+    statement->BindCString(first + 3, "");  // value
+    // BindBlob() immediately makes an internal copy of the data.
+    statement->BindBlob(first + 4, cookie.encrypted_value->data(),
+                        static_cast<int>(cookie.encrypted_value->length()));
+  } else {
+    statement->BindString(first + 3, cc.Value());
+    statement->BindBlob(first + 4, "", 0);  // encrypted_value
+  }
+  statement->BindString(first + 5, cc.Path());
+  statement->BindInt64(first + 6, cc.ExpiryDate().ToInternalValue());
+  statement->BindInt(first + 7, cc.IsSecure());
+  statement->BindInt(first + 8, cc.IsHttpOnly());
+  statement->BindInt(first + 9,
+                     CookieSameSiteToDBCookieSameSite(cc.SameSite()));
+  statement->BindInt64(first + 10, cc.LastAccessDate().ToInternalValue());
+  statement->BindInt(first + 11, cc.IsPersistent());
+  statement->BindInt(first + 12, cc.IsPersistent());
+  statement->BindInt(first + 13,
+                     CookiePriorityToDBCookiePriority(cc.Priority()));
+}
+
+// Binds the columns of kDeleteStatementRow for |cc|, starting at parameter
+// |first|.
+void BindCookieToDelete(sql::Statement* statement,
+                        int first,
+                        const CanonicalCookie& cc) {
+  statement->BindString(first, cc.Name());
+  statement->BindString(first + 1, cc.Domain());
+  statement->BindString(first + 2, cc.Path());
+}
+
 }  // namespace
 
 void SQLitePersistentCookieStore::Backend::Load(
@@ -972,7 +1069,34 @@ void SQLitePersistentCookieStore::Backend::AddCookie(
 
 void SQLitePersistentCookieStore::Backend::UpdateCookieAccessTime(
     const CanonicalCookie& cc) {
-  BatchOperation(PendingOperation::COOKIE_UPDATEACCESS, cc);
+  // Access times only matter for the eviction order, so commits for them alone
+  // are deferred for 5 minutes.
+  static const int kAccessTimeCommitIntervalMs = 5 * 60 * 1000;
+  DCHECK(!background_task_runner()->RunsTasksInCurrentSequence());
+
+  bool schedule_commit;
+  {
+    base::AutoLock locked(lock_);
+    auto key = cc.UniqueKey();
+    auto it = pending_.find(key);
+    if (it != pending_.end()) {
+      // A pending add writes the new access time with the rest of the cookie,
+      // and a pending delete makes it irrelevant.
+      if (it->second->op() == PendingOperation::COOKIE_ADD)
+        it->second->SetLastAccessDate(cc.LastAccessDate());
+      return;
+    }
+    schedule_commit = num_pending_ == 0 && pending_access_updates_.empty();
+    pending_access_updates_[key] = std::make_unique<PendingOperation>(
+        PendingOperation::COOKIE_UPDATEACCESS, cc);
+  }
+
+  if (schedule_commit &&
+      !background_task_runner()->PostDelayedTask(
+          FROM_HERE, base::BindOnce(&Backend::Commit, this),
+          base::TimeDelta::FromMilliseconds(kAccessTimeCommitIntervalMs))) {
+    NOTREACHED() << "background_task_runner() is not running.";
+  }
 }
 
 void SQLitePersistentCookieStore::Backend::DeleteCookie(
@@ -995,37 +1119,14 @@ void SQLitePersistentCookieStore::Backend::BatchOperation(
   PendingOperationsMap::size_type num_pending;
   {
     base::AutoLock locked(lock_);
-    // When queueing the operation, see if it overwrites any already pending
-    // ones for the same row.
+    // An add or a delete makes all the previous operations on the same row
+    // irrelevant: adds replace the row when they are written.
     auto key = cc.UniqueKey();
-    auto iter_and_result =
-        pending_.insert(std::make_pair(key, PendingOperationsForKey()));
-    PendingOperationsForKey& ops_for_key = iter_and_result.first->second;
-    if (!iter_and_result.second) {
-      // Insert failed -> already have ops.
-      if (po->op() == PendingOperation::COOKIE_DELETE) {
-        // A delete op makes all the previous ones irrelevant.
-        ops_for_key.clear();
-      } else if (po->op() == PendingOperation::COOKIE_UPDATEACCESS) {
-        if (!ops_for_key.empty() &&
-            ops_for_key.back()->op() == PendingOperation::COOKIE_UPDATEACCESS) {
-          // If access timestamp is updated twice in a row, can dump the earlier
-          // one.
-          ops_for_key.pop_back();
-        }
-        // At most delete + add before (and no access time updates after above
-        // conditional).
-        DCHECK_LE(ops_for_key.size(), 2u);
-      } else {
-        // Nothing special is done for adds, since if they're overwriting,
-        // they'll be preceded by deletes anyway.
-        DCHECK_LE(ops_for_key.size(), 1u);
-      }
-    }
-    ops_for_key.push_back(std::move(po));
+    pending_access_updates_.erase(key);
+    pending_[key] = std::move(po);
     // Note that num_pending_ counts number of calls to BatchOperation(), not
     // the current length of the queue; this is intentional to guarantee
-    // progress, as the length of the queue may decrease in some cases.
+    // progress, as the length of the queue may not grow in some cases.
     num_pending = ++num_pending_;
   }
 
@@ -1046,121 +1147,150 @@ void SQLitePersistentCookieStore::Backend::DoCommit() {
   DCHECK(background_task_runner()->RunsTasksInCurrentSequence());
 
   PendingOperationsMap ops;
+  PendingOperationsMap access_updates;
   {
     base::AutoLock locked(lock_);
     pending_.swap(ops);
+    pending_access_updates_.swap(access_updates);
     num_pending_ = 0;
   }
 
   // Maybe an old timer fired or we are already Close()'ed.
-  if (!db() || ops.empty())
-    return;
-
-  sql::Statement add_smt(db()->GetCachedStatement(
-      SQL_FROM_HERE,
-      "INSERT INTO cookies (creation_utc, host_key, name, value, "
-      "encrypted_value, path, expires_utc, is_secure, is_httponly, "
-      "firstpartyonly, last_access_utc, has_expires, is_persistent, priority) "
-      "VALUES (?,?,?,?,?,?,?,?,?,?,?,?,?,?)"));
-  if (!add_smt.is_valid())
-    return;
-
-  sql::Statement update_access_smt(
-      db()->GetCachedStatement(SQL_FROM_HERE,
-                               "UPDATE cookies SET last_access_utc=? WHERE "
-                               "name=? AND host_key=? AND path=?"));
-  if (!update_access_smt.is_valid())
+  if (!db() || (ops.empty() && access_updates.empty()))
     return;
 
-  sql::Statement del_smt(
-      db()->GetCachedStatement(SQL_FROM_HERE,
-                               "DELETE FROM cookies WHERE "
-                               "name=? AND host_key=? AND path=?"));
-  if (!del_smt.is_valid())
-    return;
+  bool trouble = false;
+  std::vector<const CanonicalCookie*> cookies_to_delete;
+  std::vector<CookieToAdd> cookies_to_add;
+  for (const auto& kv : ops) {
+    const CanonicalCookie& cc = kv.second->cc();
+    if (kv.second->op() == PendingOperation::COOKIE_DELETE) {
+      cookies_to_delete.push_back(&cc);
+      continue;
+    }
+    DCHECK_EQ(PendingOperation::COOKIE_ADD, kv.second->op());
+    CookieToAdd cookie = {&cc, base::nullopt};
+    if (crypto_ && crypto_->ShouldEncrypt()) {
+      cookie.encrypted_value.emplace();
+      if (!crypto_->EncryptString(cc.Value(), &*cookie.encrypted_value)) {
+        DLOG(WARNING) << "Could not encrypt a cookie, skipping add.";
+        RecordCookieCommitProblem(COOKIE_COMMIT_PROBLEM_ENCRYPT_FAILED);
+        trouble = true;
+        // The add would have replaced the stored cookie.
+        cookies_to_delete.push_back(&cc);
+        continue;
+      }
+    }
+    cookies_to_add.push_back(std::move(cookie));
+  }
 
   sql::Transaction transaction(db());
   if (!transaction.Begin())
     return;
 
-  bool trouble = false;
-  for (auto& kv : ops) {
-    for (std::unique_ptr<PendingOperation>& po_entry : kv.second) {
-      // Free the cookies as we commit them to the database.
-      std::unique_ptr<PendingOperation> po(std::move(po_entry));
-      switch (po->op()) {
-        case PendingOperation::COOKIE_ADD:
-          add_smt.Reset(true);
-          add_smt.BindInt64(0, po->cc().CreationDate().ToInternalValue());
-          add_smt.BindString(1, po->cc().Domain());
-          add_smt.BindString(2, po->cc().Name());
-          if (crypto_ && crypto_->ShouldEncrypt()) {
-            std::string encrypted_value;
-            if (!crypto_->EncryptString(po->cc().Value(), &encrypted_value)) {
-              DLOG(WARNING) << "Could not encrypt a cookie, skipping add.";
-              RecordCookieCommitProblem(COOKIE_COMMIT_PROBLEM_ENCRYPT_FAILED);
-              trouble = true;
-              continue;
-            }
-            add_smt.BindCString(3, "");  // value
-            // BindBlob() immediately makes an internal copy of the data.
-            add_smt.BindBlob(4, encrypted_value.data(),
-                             static_cast<int>(encrypted_value.length()));
-          } else {
-            add_smt.BindString(3, po->cc().Value());
-            add_smt.BindBlob(4, "", 0);  // encrypted_value
-          }
-          add_smt.BindString(5, po->cc().Path());
-          add_smt.BindInt64(6, po->cc().ExpiryDate().ToInternalValue());
-          add_smt.BindInt(7, po->cc().IsSecure());
-          add_smt.BindInt(8, po->cc().IsHttpOnly());
-          add_smt.BindInt(
-              9, CookieSameSiteToDBCookieSameSite(po->cc().SameSite()));
-          add_smt.BindInt64(10, po->cc().LastAccessDate().ToInternalValue());
-          add_smt.BindInt(11, po->cc().IsPersistent());
-          add_smt.BindInt(12, po->cc().IsPersistent());
-          add_smt.BindInt(
-              13, CookiePriorityToDBCookiePriority(po->cc().Priority()));
-          if (!add_smt.Run()) {
-            DLOG(WARNING) << "Could not add a cookie to the DB.";
-            RecordCookieCommitProblem(COOKIE_COMMIT_PROBLEM_ADD);
-            trouble = true;
-          }
-          break;
-
-        case PendingOperation::COOKIE_UPDATEACCESS:
-          update_access_smt.Reset(true);
-          update_access_smt.BindInt64(
-              0, po->cc().LastAccessDate().ToInternalValue());
-          update_access_smt.BindString(1, po->cc().Name());
-          update_access_smt.BindString(2, po->cc().Domain());
-          update_access_smt.BindString(3, po->cc().Path());
-          if (!update_access_smt.Run()) {
-            DLOG(WARNING)
-                << "Could not update cookie last access time in the DB.";
-            RecordCookieCommitProblem(COOKIE_COMMIT_PROBLEM_UPDATE_ACCESS);
-            trouble = true;
-          }
-          break;
-
-        case PendingOperation::COOKIE_DELETE:
-          del_smt.Reset(true);
-          del_smt.BindString(0, po->cc().Name());
-          del_smt.BindString(1, po->cc().Domain());
-          del_smt.BindString(2, po->cc().Path());
-          if (!del_smt.Run()) {
-            DLOG(WARNING) << "Could not delete a cookie from the DB.";
-            RecordCookieCommitProblem(COOKIE_COMMIT_PROBLEM_DELETE);
-            trouble = true;
-          }
-          break;
-
-        default:
-          NOTREACHED();
-          break;
+  size_t i = 0;
+  if (cookies_to_delete.size() >= kRowsPerMultiRowStatement) {
+    sql::Statement del_smt(db()->GetCachedStatement(
+        SQL_FROM_HERE,
+        MakeMultiRowStatement(kDeleteStatementPrefix, kDeleteStatementRow,
+                              " OR ", kRowsPerMultiRowStatement)
+            .c_str()));
+    if (!del_smt.is_valid())
+      return;
+    for (; cookies_to_delete.size() - i >= kRowsPerMultiRowStatement;
+         i += kRowsPerMultiRowStatement) {
+      del_smt.Reset(true);
+      for (size_t row = 0; row < kRowsPerMultiRowStatement; ++row)
+        BindCookieToDelete(&del_smt, row * 3, *cookies_to_delete[i + row]);
+      if (!del_smt.Run()) {
+        DLOG(WARNING) << "Could not delete cookies from the DB.";
+        RecordCookieCommitProblem(COOKIE_COMMIT_PROBLEM_DELETE);
+        trouble = true;
+      }
+    }
+  }
+  if (i < cookies_to_delete.size()) {
+    sql::Statement del_smt(db()->GetCachedStatement(
+        SQL_FROM_HERE,
+        MakeMultiRowStatement(kDeleteStatementPrefix, kDeleteStatementRow, "",
+                              1)
+            .c_str()));
+    if (!del_smt.is_valid())
+      return;
+    for (; i < cookies_to_delete.size(); ++i) {
+      del_smt.Reset(true);
+      BindCookieToDelete(&del_smt, 0, *cookies_to_delete[i]);
+      if (!del_smt.Run()) {
+        DLOG(WARNING) << "Could not delete a cookie from the DB.";
+        RecordCookieCommitProblem(COOKIE_COMMIT_PROBLEM_DELETE);
+        trouble = true;
+      }
+    }
+  }
+
+  i = 0;
+  if (cookies_to_add.size() >= kRowsPerMultiRowStatement) {
+    sql::Statement add_smt(db()->GetCachedStatement(
+        SQL_FROM_HERE,
+        MakeMultiRowStatement(kAddStatementPrefix, kAddStatementRow, ",",
+                              kRowsPerMultiRowStatement)
+            .c_str()));
+    if (!add_smt.is_valid())
+      return;
+    for (; cookies_to_add.size() - i >= kRowsPerMultiRowStatement;
+         i += kRowsPerMultiRowStatement) {
+      add_smt.Reset(true);
+      for (size_t row = 0; row < kRowsPerMultiRowStatement; ++row) {
+        BindCookieToAdd(&add_smt, row * kAddColumnCount,
+                        cookies_to_add[i + row]);
+      }
+      if (!add_smt.Run()) {
+        DLOG(WARNING) << "Could not add cookies to the DB.";
+        RecordCookieCommitProblem(COOKIE_COMMIT_PROBLEM_ADD);
+        trouble = true;
+      }
+    }
+  }
+  if (i < cookies_to_add.size()) {
+    sql::Statement add_smt(db()->GetCachedStatement(
+        SQL_FROM_HERE,
+        MakeMultiRowStatement(kAddStatementPrefix, kAddStatementRow, "", 1)
+            .c_str()));
+    if (!add_smt.is_valid())
+      return;
+    for (; i < cookies_to_add.size(); ++i) {
+      add_smt.Reset(true);
+      BindCookieToAdd(&add_smt, 0, cookies_to_add[i]);
+      if (!add_smt.Run()) {
+        DLOG(WARNING) << "Could not add a cookie to the DB.";
+        RecordCookieCommitProblem(COOKIE_COMMIT_PROBLEM_ADD);
+        trouble = true;
+      }
+    }
+  }
+
+  if (!access_updates.empty()) {
+    sql::Statement update_access_smt(
+        db()->GetCachedStatement(SQL_FROM_HERE,
+                                 "UPDATE cookies SET last_access_utc=? WHERE "
+                                 "name=? AND host_key=? AND path=?"));
+    if (!update_access_smt.is_valid())
+      return;
+    for (const auto& kv : access_updates) {
+      const CanonicalCookie& cc = kv.second->cc();
+      update_access_smt.Reset(true);
+      update_access_smt.BindInt64(0, cc.LastAccessDate().ToInternalValue());
+      update_access_smt.BindString(1, cc.Name());
+      update_access_smt.BindString(2, cc.Domain());
+      update_access_smt.BindString(3, cc.Path());
+      if (!update_access_smt.Run()) {
+        DLOG(WARNING) << "Could not update cookie last access time in the DB.";
+        RecordCookieCommitProblem(COOKIE_COMMIT_PROBLEM_UPDATE_ACCESS);
+        trouble = true;
       }
     }
   }
+
   bool succeeded = transaction.Commit();
   UMA_HISTOGRAM_ENUMERATION("Cookie.BackingStoreUpdateResults",
                             succeeded
@@ -1172,14 +1302,8 @@ void SQLitePersistentCookieStore::Backend::DoCommit() {
 
 size_t SQLitePersistentCookieStore::Backend::GetQueueLengthForTesting() {
   DCHECK(client_task_runner()->RunsTasksInCurrentSequence());
-  size_t total = 0u;
-  {
-    base::AutoLock locked(lock_);
-    for (const auto& key_val : pending_) {
-      total += key_val.second.size();
-    }
-  }
-  return total;
+  base::AutoLock locked(lock_);
+  return pending_.size() + pending_access_updates_.size();
 }
 
 void SQLitePersistentCookieStore::Backend::DeleteAllInList(
@@ -1324,18 +1324,21 @@ TEST_F(SQLitePersistentCookieStoreTest, Coalescing) {
     size_t expected_queue_length;
   };
 
+  // Only the final state of the cookie is queued: adds replace the row when
+  // they are written, and absorb later access time updates.
   std::vector<TestCase> testcases = {
       {{Op::kAdd, Op::kDelete}, 1u},
       {{Op::kUpdate, Op::kDelete}, 1u},
       {{Op::kAdd, Op::kUpdate, Op::kDelete}, 1u},
       {{Op::kUpdate, Op::kUpdate}, 1u},
-      {{Op::kAdd, Op::kUpdate, Op::kUpdate}, 2u},
-      {{Op::kDelete, Op::kAdd}, 2u},
-      {{Op::kDelete, Op::kAdd, Op::kUpdate}, 3u},
-      {{Op::kDelete, Op::kAdd, Op::kUpdate, Op::kUpdate}, 3u},
+      {{Op::kAdd, Op::kUpdate, Op::kUpdate}, 1u},
+      {{Op::kDelete, Op::kAdd}, 1u},
+      {{Op::kDelete, Op::kAdd, Op::kUpdate}, 1u},
+      {{Op::kDelete, Op::kAdd, Op::kUpdate, Op::kUpdate}, 1u},
       {{Op::kDelete, Op::kDelete}, 1u},
       {{Op::kDelete, Op::kAdd, Op::kDelete}, 1u},
-      {{Op::kDelete, Op::kAdd, Op::kUpdate, Op::kDelete}, 1u}};
+      {{Op::kDelete, Op::kAdd, Op::kUpdate, Op::kDelete}, 1u},
+      {{Op::kUpdate, Op::kAdd}, 1u}};
 
   std::unique_ptr<CanonicalCookie> cookie =
       CanonicalCookie::Create(GURL("http://www.example.com/path"), "Tasty=Yes",
@@ -1412,4 +1415,84 @@ TEST_F(SQLitePersistentCookieStoreTest, NoCoalesceUnrelated) {
   db_thread_event_.Signal();
 }
 
+// Check that an access time update folded into a pending add is written.
+TEST_F(SQLitePersistentCookieStoreTest, CoalescedAddKeepsAccessTime) {
+  InitializeStore(false, false);
+  base::Time creation = base::Time::Now() - base::TimeDelta::FromMinutes(1);
+  base::Time last_access = base::Time::Now();
+  CanonicalCookie cookie("A", "B", "foo.bar", "/", creation,
+                         creation + base::TimeDelta::FromDays(1), creation,
+                         false, false, CookieSameSite::DEFAULT_MODE,
+                         COOKIE_PRIORITY_DEFAULT);
+  store_->AddCookie(cookie);
+  cookie.SetLastAccessDate(last_access);
+  store_->UpdateCookieAccessTime(cookie);
+  DestroyStore();
+
+  CanonicalCookieVector cookies;
+  CreateAndLoad(false, false, &cookies);
+  ASSERT_EQ(1U, cookies.size());
+  EXPECT_EQ(creation, cookies[0]->CreationDate());
+  EXPECT_EQ(last_access, cookies[0]->LastAccessDate());
+}
+
+// Check that adding a cookie replaces the stored one, with or without a
+// delete in the same commit.
+TEST_F(SQLitePersistentCookieStoreTest, AddReplacesStoredCookie) {
+  InitializeStore(false, false);
+  AddCookie("A", "B", "foo.bar", "/", base::Time::Now());
+  DestroyStore();
+
+  CanonicalCookieVector cookies;
+  CreateAndLoad(false, false, &cookies);
+  ASSERT_EQ(1U, cookies.size());
+  store_->DeleteCookie(*cookies[0]);
+  AddCookie("A", "C", "foo.bar", "/", base::Time::Now());
+  DestroyStore();
+
+  cookies.clear();
+  CreateAndLoad(false, false, &cookies);
+  ASSERT_EQ(1U, cookies.size());
+  EXPECT_EQ("C", cookies[0]->Value());
+  AddCookie("A", "D", "foo.bar", "/", base::Time::Now());
+  DestroyStore();
+
+  cookies.clear();
+  CreateAndLoad(false, false, &cookies);
+  ASSERT_EQ(1U, cookies.size());
+  EXPECT_EQ("D", cookies[0]->Value());
+}
+
+// Check that batches large enough for multi-row statements, and their
+// remainders, are written.
+TEST_F(SQLitePersistentCookieStoreTest, LargeBatches) {
+  const int kNumCookies = 100;
+  const int kNumToDelete = 70;
+  InitializeStore(true, false);
+  base::Time creation = base::Time::Now();
+  for (int i = 0; i < kNumCookies; ++i) {
+    AddCookie(base::StringPrintf("A%d", i), "B", "foo.bar", "/",
+              creation + base::TimeDelta::FromMicroseconds(i));
+  }
+  Flush();
+  for (int i = 0; i < kNumToDelete; ++i) {
+    store_->DeleteCookie(CanonicalCookie(
+        base::StringPrintf("A%d", i), "B", "foo.bar", "/", creation, creation,
+        base::Time(), false, false, CookieSameSite::DEFAULT_MODE,
+        COOKIE_PRIORITY_DEFAULT));
+  }
+  DestroyStore();
+
+  CanonicalCookieVector cookies;
+  CreateAndLoad(true, false, &cookies);
+  ASSERT_EQ(static_cast<size_t>(kNumCookies - kNumToDelete), cookies.size());
+  std::set<std::string> names;
+  for (const auto& cookie : cookies) {
+    EXPECT_EQ("B", cookie->Value());
+    names.insert(cookie->Name());
+  }
+  for (int i = kNumToDelete; i < kNumCookies; ++i)
+    EXPECT_EQ(1u, names.count(base::StringPrintf("A%d", i)));
+}
+
 }  // namespace net
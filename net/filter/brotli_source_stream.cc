@@ -4,11 +4,16 @@
 
 #include "net/filter/brotli_source_stream.h"
 
+#include <vector>
+
 #include "base/bind.h"
 #include "base/bit_cast.h"
 #include "base/logging.h"
 #include "base/macros.h"
 #include "base/metrics/histogram_macros.h"
+#include "base/no_destructor.h"
+#include "base/synchronization/lock.h"
+#include "net/base/features.h"
 #include "net/base/io_buffer.h"
 #include "third_party/brotli/include/brotli/decode.h"
 
@@ -19,6 +24,70 @@ namespace {
 const char kBrotli[] = "BROTLI";
 const uint8_t kGzipHeader[] = {0x1f, 0x8b, 0x08};
 
+// Limits of the BrotliBlockPool.
+const size_t kMinPooledSize = 64 * 1024;
+const size_t kMaxPooledBlocks = 4;
+const size_t kMaxPooledBytes = 4 * 1024 * 1024;
+
+// Header in front of each block handed to the brotli decoder: the capacity of
+// the block, and the size the decoder asked for.
+struct BlockHeader {
+  size_t capacity;
+  size_t size;
+};
+
+// Keeps a few of the large blocks freed by brotli decoders, mostly their ring
+// buffers, so that the next decoders reuse them instead of getting fresh pages
+// from the system for every response.
+class BrotliBlockPool {
+ public:
+  BrotliBlockPool() = default;
+
+  static BrotliBlockPool* GetInstance() {
+    static base::NoDestructor<BrotliBlockPool> instance;
+    return instance.get();
+  }
+
+  // Returns a pooled block that can hold |size| bytes without wasting more
+  // than half of it, or nullptr.
+  BlockHeader* Take(size_t size) {
+    if (size < kMinPooledSize)
+      return nullptr;
+    base::AutoLock lock(lock_);
+    for (auto it = blocks_.begin(); it != blocks_.end(); ++it) {
+      BlockHeader* block = *it;
+      if (block->capacity >= size && block->capacity / 2 <= size) {
+        blocks_.erase(it);
+        pooled_bytes_ -= block->capacity;
+        return block;
+      }
+    }
+    return nullptr;
+  }
+
+  // Takes ownership of |block| if it's worth pooling and there is room for it.
+  // Returns false otherwise.
+  bool Put(BlockHeader* block) {
+    if (block->capacity < kMinPooledSize)
+      return false;
+    base::AutoLock lock(lock_);
+    if (blocks_.size() >= kMaxPooledBlocks ||
+        pooled_bytes_ + block->capacity > kMaxPooledBytes) {
+      return false;
+    }
+    blocks_.push_back(block);
+    pooled_bytes_ += block->capacity;
+    return true;
+  }
+
+ private:
+  base::Lock lock_;
+  std::vector<BlockHeader*> blocks_;
+  size_t pooled_bytes_ = 0;
+
+  DISALLOW_COPY_AND_ASSIGN(BrotliBlockPool);
+};
+
 // BrotliSourceStream applies Brotli content decoding to a data stream.
 // Brotli format specification: http://www.ietf.org/id/draft-alakuijala-brotli.
 class BrotliSourceStream : public FilterSourceStream {
@@ -30,7 +99,9 @@ class BrotliSourceStream : public FilterSourceStream {
         used_memory_maximum_(0),
         consumed_bytes_(0),
         produced_bytes_(0),
-        gzip_header_detected_(true) {
+        gzip_header_detected_(true),
+        use_block_pool_(
+            base::FeatureList::IsEnabled(features::kFastContentDecoding)) {
     brotli_state_ =
         BrotliDecoderCreateInstance(AllocateMemory, FreeMemory, this);
     CHECK(brotli_state_);
@@ -160,22 +231,31 @@ class BrotliSourceStream : public FilterSourceStream {
   }
 
   void* AllocateMemoryInternal(size_t size) {
-    size_t* array = reinterpret_cast<size_t*>(malloc(size + sizeof(size_t)));
-    if (!array)
-      return nullptr;
+    BlockHeader* block = nullptr;
+    if (use_block_pool_)
+      block = BrotliBlockPool::GetInstance()->Take(size);
+    if (!block) {
+      block =
+          reinterpret_cast<BlockHeader*>(malloc(size + sizeof(BlockHeader)));
+      if (!block)
+        return nullptr;
+      block->capacity = size;
+    }
     used_memory_ += size;
     if (used_memory_maximum_ < used_memory_)
       used_memory_maximum_ = used_memory_;
-    array[0] = size;
-    return &array[1];
+    block->size = size;
+    return &block[1];
   }
 
   void FreeMemoryInternal(void* address) {
     if (!address)
       return;
-    size_t* array = reinterpret_cast<size_t*>(address);
-    used_memory_ -= array[-1];
-    free(&array[-1]);
+    BlockHeader* block = &reinterpret_cast<BlockHeader*>(address)[-1];
+    used_memory_ -= block->size;
+    if (use_block_pool_ && BrotliBlockPool::GetInstance()->Put(block))
+      return;
+    free(block);
   }
 
   BrotliDecoderState* brotli_state_;
@@ -189,6 +269,9 @@ class BrotliSourceStream : public FilterSourceStream {
 
   bool gzip_header_detected_;
 
+  // Whether blocks are taken from and returned to the BrotliBlockPool.
+  const bool use_block_pool_;
+
   DISALLOW_COPY_AND_ASSIGN(BrotliSourceStream);
 };
 
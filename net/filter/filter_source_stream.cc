@@ -4,6 +4,7 @@
 
 #include "net/filter/filter_source_stream.h"
 
+#include <algorithm>
 #include <utility>
 
 #include "base/bind.h"
@@ -12,6 +13,7 @@
 #include "base/metrics/histogram_macros.h"
 #include "base/numerics/safe_conversions.h"
 #include "base/strings/string_util.h"
+#include "net/base/features.h"
 #include "net/base/io_buffer.h"
 #include "net/base/net_errors.h"
 
@@ -24,7 +26,18 @@ const char kGZip[] = "gzip";
 const char kXGZip[] = "x-gzip";
 const char kBrotli[] = "br";
 
-const size_t kBufferSize = 32 * 1024;
+const int kBufferSize = 32 * 1024;
+
+// Bounds of the input buffer size set by the kFastContentDecoding feature.
+const int kMinFastBufferSize = 32 * 1024;
+const int kMaxFastBufferSize = 1024 * 1024;
+
+int GetInputBufferSize() {
+  if (!base::FeatureList::IsEnabled(features::kFastContentDecoding))
+    return kBufferSize;
+  int size = features::kFastContentDecodingInputBufferSize.Get();
+  return std::max(kMinFastBufferSize, std::min(size, kMaxFastBufferSize));
+}
 
 }  // namespace
 
@@ -33,6 +46,7 @@ FilterSourceStream::FilterSourceStream(SourceType type,
     : SourceStream(type),
       upstream_(std::move(upstream)),
       next_state_(STATE_NONE),
+      input_buffer_size_(GetInputBufferSize()),
       output_buffer_size_(0),
       upstream_end_reached_(false) {
   DCHECK(upstream_);
@@ -49,7 +63,7 @@ int FilterSourceStream::Read(IOBuffer* read_buffer,
 
   // Allocate a BlockBuffer during first Read().
   if (!input_buffer_) {
-    input_buffer_ = base::MakeRefCounted<IOBufferWithSize>(kBufferSize);
+    input_buffer_ = base::MakeRefCounted<IOBufferWithSize>(input_buffer_size_);
     // This is first Read(), start with reading data from |upstream_|.
     next_state_ = STATE_READ_DATA;
   } else {
@@ -130,7 +144,7 @@ int FilterSourceStream::DoReadData() {
   next_state_ = STATE_READ_DATA_COMPLETE;
   // Use base::Unretained here is safe because |this| owns |upstream_|.
   int rv = upstream_->Read(
-      input_buffer_.get(), kBufferSize,
+      input_buffer_.get(), input_buffer_size_,
       base::Bind(&FilterSourceStream::OnIOComplete, base::Unretained(this)));
 
   return rv;
@@ -98,6 +98,10 @@ class NET_EXPORT_PRIVATE FilterSourceStream : public SourceStream {
 
   State next_state_;
 
+  // Size of |input_buffer_|. Larger with the kFastContentDecoding feature, so
+  // that each FilterData() call decodes a longer run of input.
+  const int input_buffer_size_;
+
   // Buffer for reading data out of |upstream_| and then for use by |this|
   // before the filtered data is returned through Read().
   scoped_refptr<IOBuffer> input_buffer_;
@@ -0,0 +1,175 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "base/files/file_path.h"
+#include "base/files/file_util.h"
+#include "base/macros.h"
+#include "base/path_service.h"
+#include "base/strings/stringprintf.h"
+#include "base/test/perf_time_logger.h"
+#include "base/test/scoped_feature_list.h"
+#include "net/base/completion_once_callback.h"
+#include "net/base/features.h"
+#include "net/base/io_buffer.h"
+#include "net/filter/brotli_source_stream.h"
+#include "net/filter/filter_source_stream_test_util.h"
+#include "net/filter/gzip_source_stream.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace net {
+
+namespace {
+
+const int kNumIterations = 200;
+// Size of the buffers the consumer reads decoded data into, as URLRequestJob
+// does.
+const int kReadBufferSize = 64 * 1024;
+
+// A SourceStream that returns as much of |data| as fits in each Read(),
+// synchronously, like a socket with the whole response already received.
+class StringSourceStream : public SourceStream {
+ public:
+  explicit StringSourceStream(const std::string& data)
+      : SourceStream(TYPE_NONE), data_(data), offset_(0) {}
+  ~StringSourceStream() override = default;
+
+  int Read(IOBuffer* dest_buffer,
+           int buffer_size,
+           CompletionOnceCallback callback) override {
+    int len = std::min(buffer_size, static_cast<int>(data_.size() - offset_));
+    memcpy(dest_buffer->data(), data_.data() + offset_, len);
+    offset_ += len;
+    return len;
+  }
+
+  std::string Description() const override { return ""; }
+
+ private:
+  const std::string& data_;
+  size_t offset_;
+
+  DISALLOW_COPY_AND_ASSIGN(StringSourceStream);
+};
+
+// Returns about |size| bytes of HTML, repetitive the way real markup is.
+std::string MakeHtmlBody(size_t size) {
+  std::string body = "<!DOCTYPE html><html><head><title>Test</title></head>";
+  for (int i = 0; body.size() < size; ++i) {
+    body += base::StringPrintf(
+        "<div class=\"item item-%d\"><a href=\"/articles/%d\">Article %d</a>"
+        "<p>Lorem ipsum dolor sit amet, consectetur adipiscing elit.</p>"
+        "</div>\n",
+        i % 7, i, i);
+  }
+  return body + "</html>";
+}
+
+// Returns about |size| bytes of minified-looking JavaScript.
+std::string MakeJsBody(size_t size) {
+  std::string body;
+  for (int i = 0; body.size() < size; ++i) {
+    body += base::StringPrintf(
+        "function f%d(a,b){var c=a.length|0;for(var d=0;d<c;d++)"
+        "b.push(a[d]*%d+\"%x\");return b}",
+        i, i % 13, i * 2654435761u);
+  }
+  return body;
+}
+
+std::string Gzip(const std::string& data) {
+  size_t compressed_size = data.size() + 1024;
+  std::string compressed(compressed_size, '\0');
+  CompressGzip(data.data(), data.size(), &compressed[0], &compressed_size,
+               true);
+  compressed.resize(compressed_size);
+  return compressed;
+}
+
+// Decodes |encoded| with the streams made by |create_stream|, |kNumIterations|
+// times, and logs the time spent.
+template <typename CreateStream>
+void RunDecode(const std::string& name,
+               const std::string& encoded,
+               size_t decoded_size,
+               CreateStream create_stream) {
+  scoped_refptr<IOBuffer> read_buffer =
+      base::MakeRefCounted<IOBuffer>(kReadBufferSize);
+  base::PerfTimeLogger timer(name.c_str());
+  for (int i = 0; i < kNumIterations; ++i) {
+    std::unique_ptr<SourceStream> stream =
+        create_stream(std::make_unique<StringSourceStream>(encoded));
+    ASSERT_TRUE(stream);
+    size_t total = 0;
+    int rv;
+    while ((rv = stream->Read(read_buffer.get(), kReadBufferSize,
+                              CompletionOnceCallback())) > 0) {
+      total += rv;
+    }
+    ASSERT_EQ(0, rv);
+    ASSERT_EQ(decoded_size, total);
+  }
+  timer.Done();
+}
+
+class FilterSourceStreamPerfTest : public testing::TestWithParam<bool> {
+ protected:
+  void SetUp() override {
+    if (GetParam()) {
+      feature_list_.InitAndEnableFeature(features::kFastContentDecoding);
+    } else {
+      feature_list_.InitAndDisableFeature(features::kFastContentDecoding);
+    }
+  }
+
+  std::string GetName(const std::string& body) const {
+    return base::StringPrintf("Filter_%s_%s", body.c_str(),
+                              GetParam() ? "fast" : "default");
+  }
+
+ private:
+  base::test::ScopedFeatureList feature_list_;
+};
+
+INSTANTIATE_TEST_CASE_P(, FilterSourceStreamPerfTest, testing::Bool());
+
+TEST_P(FilterSourceStreamPerfTest, Gzip) {
+  const std::string html = MakeHtmlBody(512 * 1024);
+  const std::string js = MakeJsBody(1024 * 1024);
+  const std::string gzipped_html = Gzip(html);
+  const std::string gzipped_js = Gzip(js);
+  auto create_stream = [](std::unique_ptr<SourceStream> upstream) {
+    return GzipSourceStream::Create(std::move(upstream),
+                                    SourceStream::TYPE_GZIP);
+  };
+  RunDecode(GetName("gzip_html"), gzipped_html, html.size(), create_stream);
+  RunDecode(GetName("gzip_js"), gzipped_js, js.size(), create_stream);
+}
+
+TEST_P(FilterSourceStreamPerfTest, Brotli) {
+  base::FilePath data_dir;
+  base::PathService::Get(base::DIR_SOURCE_ROOT, &data_dir);
+  data_dir = data_dir.AppendASCII("net")
+                 .AppendASCII("data")
+                 .AppendASCII("filter_unittests");
+  std::string decoded;
+  std::string encoded;
+  ASSERT_TRUE(
+      base::ReadFileToString(data_dir.AppendASCII("google.txt"), &decoded));
+  ASSERT_TRUE(
+      base::ReadFileToString(data_dir.AppendASCII("google.br"), &encoded));
+  RunDecode(GetName("brotli_html"), encoded, decoded.size(),
+            [](std::unique_ptr<SourceStream> upstream) {
+              return CreateBrotliSourceStream(std::move(upstream));
+            });
+}
+
+}  // namespace
+
+}  // namespace net
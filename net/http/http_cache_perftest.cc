@@ -0,0 +1,100 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "net/http/http_cache.h"
+
+#include <memory>
+#include <string>
+
+#include "base/memory/ref_counted.h"
+#include "base/run_loop.h"
+#include "base/test/scoped_feature_list.h"
+#include "base/timer/elapsed_timer.h"
+#include "net/base/features.h"
+#include "net/base/io_buffer.h"
+#include "net/base/net_errors.h"
+#include "net/base/test_completion_callback.h"
+#include "net/http/http_transaction.h"
+#include "net/http/http_transaction_test_util.h"
+#include "net/http/mock_http_cache.h"
+#include "net/log/net_log_with_source.h"
+#include "net/test/test_with_scoped_task_environment.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "testing/perf/perf_test.h"
+
+namespace net {
+namespace {
+
+const int kBodySize = 100 * 1024 * 1024;
+
+// The buffer size used by URLRequestJob consumers.
+const int kReadBufferSize = 64 * 1024;
+
+void LargeBodyHandler(const HttpRequestInfo* request,
+                      std::string* response_status,
+                      std::string* response_headers,
+                      std::string* response_data) {
+  response_data->assign(kBodySize, 'x');
+}
+
+class HttpCachePerfTest : public TestWithScopedTaskEnvironment {
+ protected:
+  // Fetches a |kBodySize| response through the mock network layer and the
+  // mock disk cache, which writes it to the cache entry as it is read.
+  void RunLargeBodyPerfTest(bool pipelined) {
+    base::test::ScopedFeatureList scoped_feature_list;
+    if (pipelined) {
+      scoped_feature_list.InitAndEnableFeature(
+          features::kHttpCacheWritersPipelining);
+    } else {
+      scoped_feature_list.InitAndDisableFeature(
+          features::kHttpCacheWritersPipelining);
+    }
+
+    MockHttpCache cache;
+    ScopedMockTransaction mock_transaction(kSimpleGET_Transaction);
+    mock_transaction.handler = &LargeBodyHandler;
+    MockHttpRequest request(mock_transaction);
+
+    base::ElapsedTimer elapsed_timer;
+    std::unique_ptr<HttpTransaction> transaction;
+    ASSERT_EQ(OK, cache.CreateTransaction(&transaction));
+    TestCompletionCallback start_callback;
+    int rv = transaction->Start(&request, start_callback.callback(),
+                                NetLogWithSource());
+    ASSERT_EQ(OK, start_callback.GetResult(rv));
+
+    int64_t total_read = 0;
+    scoped_refptr<IOBuffer> buf =
+        base::MakeRefCounted<IOBuffer>(kReadBufferSize);
+    do {
+      TestCompletionCallback read_callback;
+      rv = read_callback.GetResult(
+          transaction->Read(buf.get(), kReadBufferSize,
+                            read_callback.callback()));
+      if (rv > 0)
+        total_read += rv;
+    } while (rv > 0);
+    ASSERT_EQ(OK, rv);
+    transaction.reset();
+    base::RunLoop().RunUntilIdle();
+
+    ASSERT_EQ(kBodySize, total_read);
+    perf_test::PrintResult("HttpCache", ".write_large_body",
+                           pipelined ? "pipelined" : "serial",
+                           elapsed_timer.Elapsed().InMillisecondsF(), "ms",
+                           true /* important */);
+  }
+};
+
+TEST_F(HttpCachePerfTest, WriteLargeBody) {
+  RunLargeBodyPerfTest(false /* pipelined */);
+}
+
+TEST_F(HttpCachePerfTest, WriteLargeBodyPipelined) {
+  RunLargeBodyPerfTest(true /* pipelined */);
+}
+
+}  // namespace
+}  // namespace net
@@ -4,14 +4,18 @@
 
 #include "net/http/http_cache_writers.h"
 
+#include <string.h>
+
 #include <algorithm>
 #include <utility>
 
 #include "base/auto_reset.h"
 #include "base/bind.h"
 #include "base/bind_helpers.h"
+#include "base/feature_list.h"
 #include "base/logging.h"
 #include "base/threading/thread_task_runner_handle.h"
+#include "net/base/features.h"
 #include "net/base/net_errors.h"
 #include "net/disk_cache/disk_cache.h"
 #include "net/http/http_cache_transaction.h"
@@ -50,7 +54,11 @@ HttpCache::Writers::TransactionInfo::TransactionInfo(const TransactionInfo&) =
     default;
 
 HttpCache::Writers::Writers(HttpCache* cache, HttpCache::ActiveEntry* entry)
-    : cache_(cache), entry_(entry), weak_factory_(this) {}
+    : cache_(cache),
+      entry_(entry),
+      pipelining_enabled_(
+          base::FeatureList::IsEnabled(features::kHttpCacheWritersPipelining)),
+      weak_factory_(this) {}
 
 HttpCache::Writers::~Writers() = default;
 
@@ -158,6 +166,7 @@ void HttpCache::Writers::ResetNetworkTransaction() {
   DCHECK(is_exclusive_);
   DCHECK_EQ(1u, all_writers_.size());
   DCHECK(all_writers_.begin()->second.partial);
+  ResetPrefetch();
   network_transaction_.reset();
 }
 
@@ -196,6 +205,7 @@ HttpCache::Writers::EraseTransaction(TransactionMap::iterator it, int result) {
     // network_transaction_ will still have a valid request info and so it
     // should be destroyed before its consumer is destroyed (request info
     // is a raw pointer owned by its consumer).
+    ResetPrefetch();
     network_transaction_.reset();
   } else {
     UpdatePriority();
@@ -374,6 +384,13 @@ int HttpCache::Writers::DoLoop(int result) {
 int HttpCache::Writers::DoNetworkRead() {
   DCHECK(network_transaction_);
   next_state_ = State::NETWORK_READ_COMPLETE;
+  if (prefetch_buf_) {
+    if (prefetch_result_ == ERR_IO_PENDING) {
+      waiting_for_prefetch_ = true;
+      return ERR_IO_PENDING;
+    }
+    return ConsumePrefetchedData();
+  }
   CompletionOnceCallback io_callback = base::BindOnce(
       &HttpCache::Writers::OnIOComplete, weak_factory_.GetWeakPtr());
   return network_transaction_->Read(read_buf_.get(), io_buf_len_,
@@ -410,6 +427,11 @@ int HttpCache::Writers::DoCacheWriteData(int num_bytes) {
   if (!num_bytes || network_read_only_)
     return num_bytes;
 
+  // A full buffer suggests that more data follows, so read it while this chunk
+  // is being written.
+  if (num_bytes == io_buf_len_)
+    StartPrefetch();
+
   int current_size = entry_->disk_entry->GetDataSize(kResponseContentIndex);
   CompletionOnceCallback io_callback = base::BindOnce(
       &HttpCache::Writers::OnIOComplete, weak_factory_.GetWeakPtr());
@@ -562,6 +584,61 @@ void HttpCache::Writers::RemoveIdleWriters(int result) {
   }
 }
 
+void HttpCache::Writers::StartPrefetch() {
+  if (!pipelining_enabled_ || prefetch_buf_ || !network_transaction_)
+    return;
+
+  // Partial requests may have to go back to the headers phase for the next
+  // range, see OnDataReceived().
+  if (active_transaction_ &&
+      all_writers_.find(active_transaction_)->second.partial) {
+    return;
+  }
+
+  prefetch_buf_ = base::MakeRefCounted<IOBuffer>(io_buf_len_);
+  prefetch_offset_ = 0;
+  prefetch_result_ = network_transaction_->Read(
+      prefetch_buf_.get(), io_buf_len_,
+      base::BindOnce(&HttpCache::Writers::OnPrefetchComplete,
+                     weak_factory_.GetWeakPtr()));
+}
+
+void HttpCache::Writers::OnPrefetchComplete(int result) {
+  DCHECK(prefetch_buf_);
+  DCHECK_EQ(ERR_IO_PENDING, prefetch_result_);
+  prefetch_result_ = result;
+  if (!waiting_for_prefetch_)
+    return;
+
+  waiting_for_prefetch_ = false;
+  OnIOComplete(ConsumePrefetchedData());
+}
+
+int HttpCache::Writers::ConsumePrefetchedData() {
+  DCHECK(prefetch_buf_);
+  DCHECK_NE(ERR_IO_PENDING, prefetch_result_);
+  int result = prefetch_result_;
+  if (result > 0) {
+    result = std::min(prefetch_result_ - prefetch_offset_, io_buf_len_);
+    memcpy(read_buf_->data(), prefetch_buf_->data() + prefetch_offset_,
+           result);
+    prefetch_offset_ += result;
+    if (prefetch_offset_ < prefetch_result_)
+      return result;
+  }
+  ResetPrefetch();
+  return result;
+}
+
+void HttpCache::Writers::ResetPrefetch() {
+  // The pending read, if any, is cancelled along with |network_transaction_|
+  // by the caller.
+  prefetch_buf_ = nullptr;
+  prefetch_result_ = 0;
+  prefetch_offset_ = 0;
+  waiting_for_prefetch_ = false;
+}
+
 void HttpCache::Writers::SetCacheCallback(bool success,
                                           const TransactionSet& make_readers) {
   DCHECK(!cache_callback_);
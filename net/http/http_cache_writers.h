@@ -223,6 +223,17 @@ class NET_EXPORT_PRIVATE HttpCache::Writers {
   // IO Completion callback function.
   void OnIOComplete(int result);
 
+  // Pipelining: while the data of a network read is being written to the
+  // cache, the next chunk is read from the network into |prefetch_buf_|, so
+  // that at most one chunk is buffered. DoNetworkRead() then takes its data
+  // from there.
+  void StartPrefetch();
+  void OnPrefetchComplete(int result);
+  // Copies the prefetched data to |read_buf_| and returns the number of bytes
+  // copied, or the error of the prefetch.
+  int ConsumePrefetchedData();
+  void ResetPrefetch();
+
   State next_state_ = State::NONE;
 
   // True if only reading from network and not writing to cache.
@@ -240,6 +251,19 @@ class NET_EXPORT_PRIVATE HttpCache::Writers {
   int io_buf_len_ = 0;
   int write_len_ = 0;
 
+  // True if kHttpCacheWritersPipelining is enabled.
+  const bool pipelining_enabled_;
+
+  // Buffer of the network read issued ahead of the consumers, if any.
+  // |prefetch_result_| is ERR_IO_PENDING until it completes, and
+  // |prefetch_offset_| is the number of bytes already handed out, since the
+  // next consumer buffer may be smaller.
+  scoped_refptr<IOBuffer> prefetch_buf_;
+  int prefetch_result_ = 0;
+  int prefetch_offset_ = 0;
+  // True if DoNetworkRead() is waiting for the prefetch to complete.
+  bool waiting_for_prefetch_ = false;
+
   // The cache transaction that is the current consumer of network_transaction_
   // ::Read or writing to the entry and is waiting for the operation to be
   // completed. This is used to ensure there is at most one consumer of
@@ -12,6 +12,8 @@
 
 #include "base/bind.h"
 #include "base/run_loop.h"
+#include "base/test/scoped_feature_list.h"
+#include "net/base/features.h"
 #include "net/http/http_cache.h"
 #include "net/http/http_cache_transaction.h"
 #include "net/http/http_response_info.h"
@@ -194,6 +196,37 @@ class WritersTest : public TestWithScopedTaskEnvironment {
     return OK;
   }
 
+  // Reads the whole response with |buffer_length| reads from all the
+  // transactions in turn, and checks that they all get the same data.
+  void ReadAllWithBufferLength(int buffer_length) {
+    std::vector<std::string> results(transactions_.size());
+    int rv = 0;
+    do {
+      std::vector<scoped_refptr<IOBuffer>> bufs;
+      std::vector<TestCompletionCallback> callbacks(transactions_.size());
+      for (size_t i = 0; i < transactions_.size(); i++) {
+        bufs.push_back(base::MakeRefCounted<IOBuffer>(buffer_length));
+        rv = writers_->Read(bufs[i].get(), buffer_length,
+                            callbacks[i].callback(), transactions_[i].get());
+        EXPECT_EQ(ERR_IO_PENDING, rv);  // Since the default is asynchronous.
+      }
+
+      std::vector<int> rvs;
+      for (auto& callback : callbacks)
+        rvs.push_back(callback.WaitForResult());
+      rv = rvs[0];
+      for (size_t i = 0; i < rvs.size(); i++) {
+        ASSERT_EQ(rv, rvs[i]);
+        if (rv > 0)
+          results[i].append(bufs[i]->data(), rv);
+      }
+    } while (rv > 0);
+
+    EXPECT_EQ(OK, rv);
+    for (const auto& result : results)
+      EXPECT_EQ(kSimpleGET_Transaction.data, result);
+  }
+
   int ReadFewBytes(std::string* result) {
     EXPECT_TRUE(transactions_.size() >= (size_t)1);
     TestHttpCacheTransaction* transaction = transactions_.begin()->get();
@@ -826,4 +859,81 @@ TEST_F(WritersTest, ContentEncodingShouldNotTruncate) {
   EXPECT_FALSE(ShouldKeepEntry());
 }
 
+class WritersPipeliningTest : public WritersTest {
+ public:
+  WritersPipeliningTest() {
+    scoped_feature_list_.InitAndEnableFeature(
+        features::kHttpCacheWritersPipelining);
+  }
+
+  int EntryContentSize() const {
+    const int kResponseContentIndex = 1;  // Keep updated with HttpCache.
+    return entry_->disk_entry->GetDataSize(kResponseContentIndex);
+  }
+
+ private:
+  base::test::ScopedFeatureList scoped_feature_list_;
+};
+
+// Tests that reading ahead of the consumer still delivers and caches the
+// whole response in order.
+TEST_F(WritersPipeliningTest, Read) {
+  CreateWritersAddTransaction();
+
+  ReadAllWithBufferLength(10);
+
+  std::string expected(kSimpleGET_Transaction.data);
+  EXPECT_EQ(static_cast<int>(expected.size()), EntryContentSize());
+  EXPECT_EQ(1, test_cache_.WritersDoneWritingToEntryCount());
+}
+
+// Tests that the prefetched data is handed out to all the transactions.
+TEST_F(WritersPipeliningTest, ReadMultiple) {
+  CreateWritersAddTransaction();
+  AddTransactionToExistingWriters();
+  AddTransactionToExistingWriters();
+
+  ReadAllWithBufferLength(10);
+
+  EXPECT_EQ(1, test_cache_.WritersDoneWritingToEntryCount());
+  EXPECT_EQ(3u, test_cache_.MakeReadersSize());
+}
+
+// Tests that a consumer buffer smaller than the prefetched chunk gets the
+// rest of the chunk on the next read.
+TEST_F(WritersPipeliningTest, ReadSmallerBufferAfterPrefetch) {
+  CreateWritersAddTransaction();
+  TestHttpCacheTransaction* transaction = transactions_[0].get();
+
+  std::string content;
+  int buffer_length = 10;
+  int rv = 0;
+  do {
+    TestCompletionCallback callback;
+    scoped_refptr<IOBuffer> buf =
+        base::MakeRefCounted<IOBuffer>(buffer_length);
+    rv = callback.GetResult(writers_->Read(buf.get(), buffer_length,
+                                           callback.callback(), transaction));
+    if (rv > 0)
+      content.append(buf->data(), rv);
+    buffer_length = 3;
+  } while (rv > 0);
+
+  EXPECT_EQ(OK, rv);
+  EXPECT_EQ(kSimpleGET_Transaction.data, content);
+  EXPECT_EQ(static_cast<int>(content.size()), EntryContentSize());
+}
+
+// Tests that removing the only transaction while the read is waiting for the
+// prefetch truncates the entry to the data written so far.
+TEST_F(WritersPipeliningTest, MidReadDeleteActiveTransaction) {
+  StopMidRead();
+
+  RemoveFirstTransaction();
+
+  EXPECT_EQ(1, test_cache_.WritersDoneWritingToEntryCount());
+  EXPECT_TRUE(Truncated());
+  EXPECT_TRUE(writers_->IsEmpty());
+}
+
 }  // namespace net
@@ -32,6 +32,7 @@
 #include "net/socket/next_proto.h"
 #include "net/socket/ssl_client_socket.h"
 #include "net/spdy/spdy_session_pool.h"
+#include "net/ssl/ssl_config_service.h"
 #include "net/third_party/quiche/src/quic/core/crypto/quic_random.h"
 #include "net/third_party/quiche/src/quic/core/quic_packets.h"
 #include "net/third_party/quiche/src/quic/core/quic_tag.h"
@@ -50,6 +51,19 @@ SSLClientSocketContext CreateClientSocketContext(
       ssl_client_session_cache);
 }
 
+// Returns a new session cache, unless |ssl_config_service| provides a shared
+// one for |privacy_mode|.
+std::unique_ptr<SSLClientSessionCache> CreateSessionCacheIfNotShared(
+    SSLConfigService* ssl_config_service,
+    PrivacyMode privacy_mode) {
+  if (ssl_config_service &&
+      ssl_config_service->shared_session_cache(privacy_mode)) {
+    return nullptr;
+  }
+  return std::make_unique<SSLClientSessionCache>(
+      SSLClientSessionCache::Config());
+}
+
 }  // unnamed namespace
 
 // The maximum receive window sizes for HTTP/2 sessions and streams.
@@ -186,8 +200,22 @@ HttpNetworkSession::HttpNetworkSession(const Params& params,
 #endif
       proxy_resolution_service_(context.proxy_resolution_service),
       ssl_config_service_(context.ssl_config_service),
-      ssl_client_session_cache_(SSLClientSessionCache::Config()),
-      ssl_client_session_cache_privacy_mode_(SSLClientSessionCache::Config()),
+      owned_ssl_client_session_cache_(
+          CreateSessionCacheIfNotShared(context.ssl_config_service,
+                                        PRIVACY_MODE_DISABLED)),
+      owned_ssl_client_session_cache_privacy_mode_(
+          CreateSessionCacheIfNotShared(context.ssl_config_service,
+                                        PRIVACY_MODE_ENABLED)),
+      ssl_client_session_cache_(
+          owned_ssl_client_session_cache_
+              ? owned_ssl_client_session_cache_.get()
+              : context.ssl_config_service->shared_session_cache(
+                    PRIVACY_MODE_DISABLED)),
+      ssl_client_session_cache_privacy_mode_(
+          owned_ssl_client_session_cache_privacy_mode_
+              ? owned_ssl_client_session_cache_privacy_mode_.get()
+              : context.ssl_config_service->shared_session_cache(
+                    PRIVACY_MODE_ENABLED)),
       push_delegate_(nullptr),
       quic_stream_factory_(
           context.net_log,
@@ -461,7 +489,9 @@ void HttpNetworkSession::DumpMemoryStats(
     }
     quic_stream_factory_.DumpMemoryStats(
         pmd, http_network_session_dump->absolute_name());
-    ssl_client_session_cache_.DumpMemoryStats(pmd, name);
+    // Shared session caches aren't attributed to any one session.
+    if (owned_ssl_client_session_cache_)
+      owned_ssl_client_session_cache_->DumpMemoryStats(pmd, name);
   }
 
   // Create an empty row under parent's dump so size can be attributed correctly
@@ -482,8 +512,10 @@ void HttpNetworkSession::DisableQuic() {
 }
 
 void HttpNetworkSession::ClearSSLSessionCache() {
-  ssl_client_session_cache_.Flush();
-  ssl_client_session_cache_privacy_mode_.Flush();
+  // This also flushes the shared session caches, if any, since they may hold
+  // sessions established through this session.
+  ssl_client_session_cache_->Flush();
+  ssl_client_session_cache_privacy_mode_->Flush();
 }
 
 CommonConnectJobParams HttpNetworkSession::CreateCommonConnectJobParams(
@@ -497,9 +529,9 @@ CommonConnectJobParams HttpNetworkSession::CreateCommonConnectJobParams(
       context_.http_auth_handler_factory, &spdy_session_pool_,
       &params_.quic_supported_versions, &quic_stream_factory_,
       context_.proxy_delegate, context_.http_user_agent_settings,
-      CreateClientSocketContext(context_, &ssl_client_session_cache_),
+      CreateClientSocketContext(context_, ssl_client_session_cache_),
       CreateClientSocketContext(context_,
-                                &ssl_client_session_cache_privacy_mode_),
+                                ssl_client_session_cache_privacy_mode_),
       context_.socket_performance_watcher_factory,
       context_.network_quality_estimator, context_.net_log,
       for_websockets ? &websocket_endpoint_lock_manager_ : nullptr);
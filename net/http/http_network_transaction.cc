@@ -1081,6 +1081,7 @@ int HttpNetworkTransaction::DoBuildRequest() {
   // This is constructed lazily (instead of within our Start method), so that
   // we have proxy info available.
   if (request_headers_.IsEmpty()) {
+    request_headers_.UseArena(request_->arena);
     bool using_http_proxy_without_tunnel = UsingHttpProxyWithoutTunnel();
     return BuildRequestHeaders(using_http_proxy_without_tunnel);
   }
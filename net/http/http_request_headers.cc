@@ -75,15 +75,35 @@ bool HttpRequestHeaders::Iterator::GetNext() {
 }
 
 HttpRequestHeaders::HttpRequestHeaders() = default;
-HttpRequestHeaders::HttpRequestHeaders(const HttpRequestHeaders& other) =
-    default;
+
+// The copy of |other.headers_| is on the heap, see RequestArenaAllocator.
+HttpRequestHeaders::HttpRequestHeaders(const HttpRequestHeaders& other)
+    : headers_(other.headers_) {}
+
 HttpRequestHeaders::HttpRequestHeaders(HttpRequestHeaders&& other) = default;
 HttpRequestHeaders::~HttpRequestHeaders() = default;
 
 HttpRequestHeaders& HttpRequestHeaders::operator=(
-    const HttpRequestHeaders& other) = default;
-HttpRequestHeaders& HttpRequestHeaders::operator=(HttpRequestHeaders&& other) =
-    default;
+    const HttpRequestHeaders& other) {
+  // Keeps the allocator of |headers_|.
+  headers_ = other.headers_;
+  return *this;
+}
+
+HttpRequestHeaders& HttpRequestHeaders::operator=(HttpRequestHeaders&& other) {
+  // Takes the allocator of |other.headers_|. The previous arena must outlive
+  // the previous headers.
+  headers_ = std::move(other.headers_);
+  arena_ = std::move(other.arena_);
+  return *this;
+}
+
+void HttpRequestHeaders::UseArena(scoped_refptr<RequestArena> arena) {
+  DCHECK(headers_.empty());
+  headers_ =
+      HeaderVector(RequestArenaAllocator<HeaderKeyValuePair>(arena.get()));
+  arena_ = std::move(arena);
+}
 
 bool HttpRequestHeaders::GetHeader(const base::StringPiece& key,
                                    std::string* out) const {
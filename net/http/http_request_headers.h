@@ -15,8 +15,10 @@
 #include <vector>
 
 #include "base/macros.h"
+#include "base/memory/scoped_refptr.h"
 #include "base/strings/string_piece.h"
 #include "net/base/net_export.h"
+#include "net/base/request_arena.h"
 
 namespace base {
 class Value;
@@ -37,7 +39,9 @@ class NET_EXPORT HttpRequestHeaders {
     std::string value;
   };
 
-  typedef std::vector<HeaderKeyValuePair> HeaderVector;
+  typedef std::vector<HeaderKeyValuePair,
+                      RequestArenaAllocator<HeaderKeyValuePair>>
+      HeaderVector;
 
   class NET_EXPORT Iterator {
    public:
@@ -98,6 +102,10 @@ class NET_EXPORT HttpRequestHeaders {
 
   bool IsEmpty() const { return headers_.empty(); }
 
+  // Makes the header list allocate from |arena|, which may be null. Must be
+  // called while there are no headers. Copies of these headers use the heap.
+  void UseArena(scoped_refptr<RequestArena> arena);
+
   bool HasHeader(const base::StringPiece& key) const {
     return FindHeader(key) != headers_.end();
   }
@@ -164,6 +172,7 @@ class NET_EXPORT HttpRequestHeaders {
 
   void Swap(HttpRequestHeaders* other) {
     headers_.swap(other->headers_);
+    arena_.swap(other->arena_);
   }
 
   // Serializes HttpRequestHeaders to a string representation.  Joins all the
@@ -186,6 +195,10 @@ class NET_EXPORT HttpRequestHeaders {
   void SetHeaderInternal(const base::StringPiece& key,
                          const base::StringPiece& value);
 
+  // Keeps alive the memory of |headers_| if it uses an arena. Declared first
+  // so that it is destroyed last.
+  scoped_refptr<RequestArena> arena_;
+
   HeaderVector headers_;
 
   // Allow the copy construction and operator= to facilitate copying in
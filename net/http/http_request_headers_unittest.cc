@@ -5,6 +5,7 @@
 #include "net/http/http_request_headers.h"
 
 #include <memory>
+#include <utility>
 
 #include "base/values.h"
 #include "net/log/net_log_capture_mode.h"
@@ -167,6 +168,35 @@ TEST(HttpRequestHeaders, CopyFrom) {
   EXPECT_EQ("B: b\r\nC: c\r\n\r\n", headers.ToString());
 }
 
+TEST(HttpRequestHeaders, Arena) {
+  auto arena = base::MakeRefCounted<RequestArena>();
+  HttpRequestHeaders headers;
+  headers.UseArena(arena);
+  headers.SetHeader("A", "A");
+  headers.SetHeader("B", "B");
+  EXPECT_GT(arena->used_bytes(), 0u);
+  EXPECT_EQ(arena.get(), headers.GetHeaderVector().get_allocator().arena());
+
+  // Copies don't depend on the arena.
+  HttpRequestHeaders copy(headers);
+  EXPECT_EQ(nullptr, copy.GetHeaderVector().get_allocator().arena());
+  HttpRequestHeaders assigned;
+  assigned = headers;
+  EXPECT_EQ(nullptr, assigned.GetHeaderVector().get_allocator().arena());
+
+  // Moved headers keep the arena alive.
+  HttpRequestHeaders moved;
+  moved = std::move(headers);
+  arena = nullptr;
+  EXPECT_EQ("A: A\r\nB: B\r\n\r\n", moved.ToString());
+
+  // Swapped headers as well.
+  copy.Swap(&moved);
+  moved.SetHeader("C", "C");
+  EXPECT_EQ("A: A\r\nB: B\r\n\r\n", copy.ToString());
+  EXPECT_EQ("A: A\r\nB: B\r\nC: C\r\n\r\n", moved.ToString());
+}
+
 }  // namespace
 
 }  // namespace net
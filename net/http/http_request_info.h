@@ -7,9 +7,11 @@
 
 #include <string>
 
+#include "base/memory/scoped_refptr.h"
 #include "base/optional.h"
 #include "net/base/net_export.h"
 #include "net/base/privacy_mode.h"
+#include "net/base/request_arena.h"
 #include "net/http/http_request_headers.h"
 #include "net/socket/socket_tag.h"
 #include "net/traffic_annotation/network_traffic_annotation.h"
@@ -60,6 +62,10 @@ struct NET_EXPORT HttpRequestInfo {
   // If the request is a Reporting upload, the depth is the max of the depth
   // of the requests reported within it plus 1.
   int reporting_upload_depth;
+
+  // Arena of the URLRequest, which objects created for this request may
+  // allocate from. May be null.
+  scoped_refptr<RequestArena> arena;
 };
 
 }  // namespace net
@@ -9,12 +9,15 @@
 
 #include "net/http/http_response_headers.h"
 
+#include <string.h>
+
 #include <algorithm>
 #include <limits>
 #include <memory>
 #include <unordered_map>
 #include <utility>
 
+#include "base/bits.h"
 #include "base/format_macros.h"
 #include "base/logging.h"
 #include "base/metrics/histogram_macros.h"
@@ -25,8 +28,10 @@
 #include "base/strings/string_piece.h"
 #include "base/strings/string_util.h"
 #include "base/strings/stringprintf.h"
+#include "base/synchronization/lock.h"
 #include "base/time/time.h"
 #include "base/values.h"
+#include "build/build_config.h"
 #include "net/base/escape.h"
 #include "net/base/parse_number.h"
 #include "net/http/http_byte_range.h"
@@ -35,6 +40,10 @@
 #include "net/log/net_log.h"
 #include "net/log/net_log_capture_mode.h"
 
+#if defined(ARCH_CPU_X86_FAMILY) && !defined(OS_NACL)
+#include <emmintrin.h>
+#endif
+
 using base::StringPiece;
 using base::Time;
 using base::TimeDelta;
@@ -138,6 +147,33 @@ void CheckDoesNotHaveEmbeddedNulls(base::StringPiece str) {
   CHECK(!HasEmbeddedNulls(str));
 }
 
+// Returns the first ':' or '\0' in [begin, end). The range must contain a
+// null, it is usually the terminator of the line starting at |begin|.
+const char* FindColonOrNull(const char* begin, const char* end) {
+  const char* p = begin;
+#if defined(ARCH_CPU_X86_FAMILY) && !defined(OS_NACL)
+  // Header lines are mostly a few dozen bytes long, so checking 16 of them at
+  // once pays off despite the cost of locating the match in the mask.
+  const __m128i colons = _mm_set1_epi8(':');
+  const __m128i nulls = _mm_setzero_si128();
+  for (; end - p >= 16; p += 16) {
+    __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+    int mask = _mm_movemask_epi8(_mm_or_si128(
+        _mm_cmpeq_epi8(chunk, colons), _mm_cmpeq_epi8(chunk, nulls)));
+    if (mask) {
+      return p +
+             base::bits::CountTrailingZeroBits(static_cast<uint32_t>(mask));
+    }
+  }
+#endif
+  for (; p < end; ++p) {
+    if (*p == ':' || *p == '\0')
+      return p;
+  }
+  NOTREACHED();
+  return end - 1;
+}
+
 }  // namespace
 
 const char HttpResponseHeaders::kContentRange[] = "Content-Range";
@@ -155,9 +191,23 @@ struct HttpResponseHeaders::ParsedHeader {
 
 //-----------------------------------------------------------------------------
 
-HttpResponseHeaders::HttpResponseHeaders(const std::string& raw_input)
-    : response_code_(-1) {
-  Parse(raw_input);
+HttpResponseHeaders::HttpResponseHeaders(std::string raw_input)
+    : HttpResponseHeaders(std::move(raw_input), nullptr) {}
+
+HttpResponseHeaders::HttpResponseHeaders(std::string raw_input,
+                                         scoped_refptr<RequestArena> arena)
+    : HttpResponseHeaders(std::move(raw_input),
+                          std::move(arena),
+                          false /* index_lazily */) {}
+
+HttpResponseHeaders::HttpResponseHeaders(std::string raw_input,
+                                         scoped_refptr<RequestArena> arena,
+                                         bool index_lazily)
+    : arena_(std::move(arena)),
+      parsed_(RequestArenaAllocator<ParsedHeader>(arena_.get())),
+      index_lazily_(index_lazily),
+      response_code_(-1) {
+  Parse(std::move(raw_input));
 
   // The most important thing to do with this histogram is find out
   // the existence of unusual HTTP status codes.  As it happens
@@ -182,11 +232,19 @@ HttpResponseHeaders::HttpResponseHeaders(base::PickleIterator* iter)
     : response_code_(-1) {
   std::string raw_input;
   if (iter->ReadString(&raw_input))
-    Parse(raw_input);
+    Parse(std::move(raw_input));
+}
+
+// static
+scoped_refptr<HttpResponseHeaders> HttpResponseHeaders::CreateLazily(
+    std::string raw_headers) {
+  return base::WrapRefCounted(new HttpResponseHeaders(
+      std::move(raw_headers), nullptr, true /* index_lazily */));
 }
 
 scoped_refptr<HttpResponseHeaders> HttpResponseHeaders::TryToCreate(
-    base::StringPiece headers) {
+    base::StringPiece headers,
+    scoped_refptr<RequestArena> arena) {
   // Reject strings with nulls.
   if (HasEmbeddedNulls(headers) ||
       headers.size() > std::numeric_limits<int>::max()) {
@@ -194,7 +252,8 @@ scoped_refptr<HttpResponseHeaders> HttpResponseHeaders::TryToCreate(
   }
 
   return base::MakeRefCounted<HttpResponseHeaders>(
-      HttpUtil::AssembleRawHeaders(headers.data(), headers.size()));
+      HttpUtil::AssembleRawHeaders(headers.data(), headers.size()),
+      std::move(arena));
 }
 
 void HttpResponseHeaders::Persist(base::Pickle* pickle,
@@ -233,19 +292,20 @@ void HttpResponseHeaders::Persist(base::Pickle* pickle,
   // so this just copies the first header line.
   blob.assign(raw_headers_.c_str(), strlen(raw_headers_.c_str()) + 1);
 
-  for (size_t i = 0; i < parsed_.size(); ++i) {
-    DCHECK(!parsed_[i].is_continuation());
+  const HeaderList& parsed = GetParsedHeaders();
+  for (size_t i = 0; i < parsed.size(); ++i) {
+    DCHECK(!parsed[i].is_continuation());
 
     // Locate the start of the next header.
     size_t k = i;
-    while (++k < parsed_.size() && parsed_[k].is_continuation()) {}
+    while (++k < parsed.size() && parsed[k].is_continuation()) {}
     --k;
 
     std::string header_name = base::ToLowerASCII(
-        base::StringPiece(parsed_[i].name_begin, parsed_[i].name_end));
+        base::StringPiece(parsed[i].name_begin, parsed[i].name_end));
     if (filter_headers.find(header_name) == filter_headers.end()) {
       // Make sure there is a null after the value.
-      blob.append(parsed_[i].name_begin, parsed_[k].value_end);
+      blob.append(parsed[i].name_begin, parsed[k].value_end);
       blob.push_back('\0');
     }
 
@@ -270,9 +330,8 @@ void HttpResponseHeaders::Update(const HttpResponseHeaders& new_headers) {
   // order should not matter.
 
   // Figure out which headers we want to take from new_headers:
-  for (size_t i = 0; i < new_headers.parsed_.size(); ++i) {
-    const HeaderList& new_parsed = new_headers.parsed_;
-
+  const HeaderList& new_parsed = new_headers.GetParsedHeaders();
+  for (size_t i = 0; i < new_parsed.size(); ++i) {
     DCHECK(!new_parsed[i].is_continuation());
 
     // Locate the start of the next header.
@@ -301,19 +360,20 @@ void HttpResponseHeaders::Update(const HttpResponseHeaders& new_headers) {
 void HttpResponseHeaders::MergeWithHeaders(const std::string& raw_headers,
                                            const HeaderSet& headers_to_remove) {
   std::string new_raw_headers(raw_headers);
-  for (size_t i = 0; i < parsed_.size(); ++i) {
-    DCHECK(!parsed_[i].is_continuation());
+  const HeaderList& parsed = GetParsedHeaders();
+  for (size_t i = 0; i < parsed.size(); ++i) {
+    DCHECK(!parsed[i].is_continuation());
 
     // Locate the start of the next header.
     size_t k = i;
-    while (++k < parsed_.size() && parsed_[k].is_continuation()) {}
+    while (++k < parsed.size() && parsed[k].is_continuation()) {}
     --k;
 
     std::string name = base::ToLowerASCII(
-        base::StringPiece(parsed_[i].name_begin, parsed_[i].name_end));
+        base::StringPiece(parsed[i].name_begin, parsed[i].name_end));
     if (headers_to_remove.find(name) == headers_to_remove.end()) {
       // It's ok to preserve this header in the final result.
-      new_raw_headers.append(parsed_[i].name_begin, parsed_[k].value_end);
+      new_raw_headers.append(parsed[i].name_begin, parsed[k].value_end);
       new_raw_headers.push_back('\0');
     }
 
@@ -322,9 +382,8 @@ void HttpResponseHeaders::MergeWithHeaders(const std::string& raw_headers,
   new_raw_headers.push_back('\0');
 
   // Make this object hold the new data.
-  raw_headers_.clear();
-  parsed_.clear();
-  Parse(new_raw_headers);
+  ClearHeaders();
+  Parse(std::move(new_raw_headers));
 }
 
 void HttpResponseHeaders::RemoveHeader(const std::string& name) {
@@ -378,9 +437,8 @@ void HttpResponseHeaders::RemoveHeaderLine(const std::string& name,
   new_raw_headers.push_back('\0');
 
   // Make this object hold the new data.
-  raw_headers_.clear();
-  parsed_.clear();
-  Parse(new_raw_headers);
+  ClearHeaders();
+  Parse(std::move(new_raw_headers));
 }
 
 void HttpResponseHeaders::AddHeader(const std::string& header) {
@@ -394,9 +452,8 @@ void HttpResponseHeaders::AddHeader(const std::string& header) {
   new_raw_headers.push_back('\0');
 
   // Make this object hold the new data.
-  raw_headers_.clear();
-  parsed_.clear();
-  Parse(new_raw_headers);
+  ClearHeaders();
+  Parse(std::move(new_raw_headers));
 }
 
 void HttpResponseHeaders::AddCookie(const std::string& cookie_string) {
@@ -438,35 +495,46 @@ void HttpResponseHeaders::UpdateWithNewRange(const HttpByteRange& byte_range,
   AddHeader(base::StringPrintf("%s: %" PRId64, kLengthHeader, range_len));
 }
 
-void HttpResponseHeaders::Parse(const std::string& raw_input) {
-  raw_headers_.reserve(raw_input.size());
+void HttpResponseHeaders::ClearHeaders() {
+  raw_headers_.clear();
+  // Headers may be modified on any sequence, which can't allocate from the
+  // arena. Move assignment takes the heap allocator of the new list.
+  parsed_ = HeaderList();
+  indexed_.store(false, std::memory_order_relaxed);
+  arena_ = nullptr;
+}
+
+void HttpResponseHeaders::Parse(std::string raw_input) {
+  DCHECK(raw_headers_.empty());
+  DCHECK(parsed_.empty());
 
   // ParseStatusLine adds a normalized status line to raw_headers_
-  std::string::const_iterator line_begin = raw_input.begin();
+  std::string::const_iterator line_begin = raw_input.cbegin();
   std::string::const_iterator line_end =
-      std::find(line_begin, raw_input.end(), '\0');
+      std::find(line_begin, raw_input.cend(), '\0');
   // has_headers = true, if there is any data following the status line.
   // Used by ParseStatusLine() to decide if a HTTP/0.9 is really a HTTP/1.0.
   bool has_headers = (line_end != raw_input.end() &&
                       (line_end + 1) != raw_input.end() &&
                       *(line_end + 1) != '\0');
   ParseStatusLine(line_begin, line_end, has_headers);
-  raw_headers_.push_back('\0');  // Terminate status line with a null.
 
   if (line_end == raw_input.end()) {
+    raw_headers_.push_back('\0');  // Terminate status line with a null.
     raw_headers_.push_back('\0');  // Ensure the headers end with a double null.
 
     DCHECK_EQ('\0', raw_headers_[raw_headers_.size() - 2]);
     DCHECK_EQ('\0', raw_headers_[raw_headers_.size() - 1]);
+    indexed_.store(true, std::memory_order_release);
     return;
   }
 
-  // Including a terminating null byte.
-  size_t status_line_len = raw_headers_.size();
-
-  // Now, we add the rest of the raw headers to raw_headers_, and begin parsing
-  // it (to populate our parsed_ vector).
-  raw_headers_.append(line_end + 1, raw_input.end());
+  // The rest of the headers is kept in the buffer of the input, which only
+  // needs to be touched if the status line was normalized.
+  size_t input_status_line_len = line_end - line_begin;
+  if (raw_input.compare(0, input_status_line_len, raw_headers_) != 0)
+    raw_input.replace(0, input_status_line_len, raw_headers_);
+  raw_headers_ = std::move(raw_input);
 
   // Ensure the headers end with a double null.
   while (raw_headers_.size() < 2 ||
@@ -475,20 +543,77 @@ void HttpResponseHeaders::Parse(const std::string& raw_input) {
     raw_headers_.push_back('\0');
   }
 
-  // Adjust to point at the null byte following the status line
-  line_end = raw_headers_.begin() + status_line_len - 1;
+  DCHECK_EQ('\0', raw_headers_[raw_headers_.size() - 2]);
+  DCHECK_EQ('\0', raw_headers_[raw_headers_.size() - 1]);
+
+  if (!index_lazily_)
+    BuildIndex();
+}
 
-  HttpUtil::HeadersIterator headers(line_end + 1, raw_headers_.end(),
-                                    std::string(1, '\0'));
-  while (headers.GetNext()) {
-    AddHeader(headers.name_begin(),
-              headers.name_end(),
-              headers.values_begin(),
-              headers.values_end());
+const HttpResponseHeaders::HeaderList& HttpResponseHeaders::GetParsedHeaders()
+    const {
+  if (!indexed_.load(std::memory_order_acquire)) {
+    base::AutoLock lock(index_lock_);
+    if (!indexed_.load(std::memory_order_relaxed))
+      BuildIndex();
   }
+  return parsed_;
+}
 
-  DCHECK_EQ('\0', raw_headers_[raw_headers_.size() - 2]);
-  DCHECK_EQ('\0', raw_headers_[raw_headers_.size() - 1]);
+void HttpResponseHeaders::BuildIndex() const {
+  DCHECK(parsed_.empty());
+
+  // Skip the status line. raw_headers_ ends with two nulls, so the loop below
+  // always finds the end of a line. It is only empty if the headers couldn't
+  // be read from a pickle.
+  const char* begin = raw_headers_.data();
+  const char* end = begin + raw_headers_.size();
+  const char* status_line_end =
+      static_cast<const char*>(memchr(begin, '\0', raw_headers_.size()));
+  const char* line = status_line_end ? status_line_end + 1 : end;
+
+  // Same rules as HttpUtil::HeadersIterator.
+  while (line < end) {
+    // Empty lines are skipped.
+    if (*line == '\0') {
+      ++line;
+      continue;
+    }
+
+    const char* colon = FindColonOrNull(line, end);
+    if (*colon == '\0') {
+      // Skip malformed header.
+      line = colon + 1;
+      continue;
+    }
+    const char* line_end =
+        static_cast<const char*>(memchr(colon, '\0', end - colon));
+
+    std::string::const_iterator name_begin = raw_headers_.begin() +
+                                             (line - begin);
+    std::string::const_iterator name_end = raw_headers_.begin() +
+                                           (colon - begin);
+    std::string::const_iterator values_begin = name_end + 1;
+    std::string::const_iterator values_end = raw_headers_.begin() +
+                                             (line_end - begin);
+    line = line_end + 1;
+
+    // If the name starts with LWS, it is an invalid line.
+    // Leading LWS implies a line continuation, and these should have
+    // already been joined by AssembleRawHeaders().
+    if (name_begin == name_end || HttpUtil::IsLWS(*name_begin))
+      continue;
+
+    HttpUtil::TrimLWS(&name_begin, &name_end);
+    DCHECK(name_begin < name_end);
+    if (!HttpUtil::IsToken(base::StringPiece(name_begin, name_end)))
+      continue;  // Skip malformed header.
+
+    HttpUtil::TrimLWS(&values_begin, &values_end);
+    AddHeader(name_begin, name_end, values_begin, values_end);
+  }
+
+  indexed_.store(true, std::memory_order_release);
 }
 
 bool HttpResponseHeaders::GetNormalizedHeader(const std::string& name,
@@ -498,9 +623,10 @@ bool HttpResponseHeaders::GetNormalizedHeader(const std::string& name,
 
   value->clear();
 
+  const HeaderList& parsed = GetParsedHeaders();
   bool found = false;
   size_t i = 0;
-  while (i < parsed_.size()) {
+  while (i < parsed.size()) {
     i = FindHeader(i, name);
     if (i == std::string::npos)
       break;
@@ -510,10 +636,10 @@ bool HttpResponseHeaders::GetNormalizedHeader(const std::string& name,
 
     found = true;
 
-    std::string::const_iterator value_begin = parsed_[i].value_begin;
-    std::string::const_iterator value_end = parsed_[i].value_end;
-    while (++i < parsed_.size() && parsed_[i].is_continuation())
-      value_end = parsed_[i].value_end;
+    std::string::const_iterator value_begin = parsed[i].value_begin;
+    std::string::const_iterator value_end = parsed[i].value_end;
+    while (++i < parsed.size() && parsed[i].is_continuation())
+      value_end = parsed[i].value_end;
     value->append(value_begin, value_end);
   }
 
@@ -549,18 +675,19 @@ std::string HttpResponseHeaders::GetStatusText() const {
 bool HttpResponseHeaders::EnumerateHeaderLines(size_t* iter,
                                                std::string* name,
                                                std::string* value) const {
+  const HeaderList& parsed = GetParsedHeaders();
   size_t i = *iter;
-  if (i == parsed_.size())
+  if (i == parsed.size())
     return false;
 
-  DCHECK(!parsed_[i].is_continuation());
+  DCHECK(!parsed[i].is_continuation());
 
-  name->assign(parsed_[i].name_begin, parsed_[i].name_end);
+  name->assign(parsed[i].name_begin, parsed[i].name_end);
 
-  std::string::const_iterator value_begin = parsed_[i].value_begin;
-  std::string::const_iterator value_end = parsed_[i].value_end;
-  while (++i < parsed_.size() && parsed_[i].is_continuation())
-    value_end = parsed_[i].value_end;
+  std::string::const_iterator value_begin = parsed[i].value_begin;
+  std::string::const_iterator value_end = parsed[i].value_end;
+  while (++i < parsed.size() && parsed[i].is_continuation())
+    value_end = parsed[i].value_end;
 
   value->assign(value_begin, value_end);
 
@@ -571,14 +698,15 @@ bool HttpResponseHeaders::EnumerateHeaderLines(size_t* iter,
 bool HttpResponseHeaders::EnumerateHeader(size_t* iter,
                                           const base::StringPiece& name,
                                           std::string* value) const {
+  const HeaderList& parsed = GetParsedHeaders();
   size_t i;
   if (!iter || !*iter) {
     i = FindHeader(0, name);
   } else {
     i = *iter;
-    if (i >= parsed_.size()) {
+    if (i >= parsed.size()) {
       i = std::string::npos;
-    } else if (!parsed_[i].is_continuation()) {
+    } else if (!parsed[i].is_continuation()) {
       i = FindHeader(i, name);
     }
   }
@@ -590,7 +718,7 @@ bool HttpResponseHeaders::EnumerateHeader(size_t* iter,
 
   if (iter)
     *iter = i + 1;
-  value->assign(parsed_[i].value_begin, parsed_[i].value_end);
+  value->assign(parsed[i].value_begin, parsed[i].value_end);
   return true;
 }
 
@@ -732,10 +860,11 @@ void HttpResponseHeaders::ParseStatusLine(
 
 size_t HttpResponseHeaders::FindHeader(size_t from,
                                        const base::StringPiece& search) const {
-  for (size_t i = from; i < parsed_.size(); ++i) {
-    if (parsed_[i].is_continuation())
+  const HeaderList& parsed = GetParsedHeaders();
+  for (size_t i = from; i < parsed.size(); ++i) {
+    if (parsed[i].is_continuation())
       continue;
-    base::StringPiece name(parsed_[i].name_begin, parsed_[i].name_end);
+    base::StringPiece name(parsed[i].name_begin, parsed[i].name_end);
     if (base::EqualsCaseInsensitiveASCII(search, name))
       return i;
   }
@@ -771,7 +900,8 @@ bool HttpResponseHeaders::GetCacheControlDirective(const StringPiece& directive,
 void HttpResponseHeaders::AddHeader(std::string::const_iterator name_begin,
                                     std::string::const_iterator name_end,
                                     std::string::const_iterator values_begin,
-                                    std::string::const_iterator values_end) {
+                                    std::string::const_iterator values_end)
+    const {
   // If the header can be coalesced, then we should split it up.
   if (values_begin == values_end ||
       HttpUtil::IsNonCoalescingHeader(name_begin, name_end)) {
@@ -790,7 +920,8 @@ void HttpResponseHeaders::AddHeader(std::string::const_iterator name_begin,
 void HttpResponseHeaders::AddToParsed(std::string::const_iterator name_begin,
                                       std::string::const_iterator name_end,
                                       std::string::const_iterator value_begin,
-                                      std::string::const_iterator value_end) {
+                                      std::string::const_iterator value_end)
+    const {
   ParsedHeader header;
   header.name_begin = name_begin;
   header.name_end = name_end;
@@ -908,17 +1039,18 @@ bool HttpResponseHeaders::IsRedirect(std::string* location) const {
   // If we lack a Location header, then we can't treat this as a redirect.
   // We assume that the first non-empty location value is the target URL that
   // we want to follow.  TODO(darin): Is this consistent with other browsers?
+  const HeaderList& parsed = GetParsedHeaders();
   size_t i = std::string::npos;
   do {
     i = FindHeader(++i, "location");
     if (i == std::string::npos)
       return false;
     // If the location value is empty, then it doesn't count.
-  } while (parsed_[i].value_begin == parsed_[i].value_end);
+  } while (parsed[i].value_begin == parsed[i].value_end);
 
   if (location) {
-    base::StringPiece location_strpiece(parsed_[i].value_begin,
-                                        parsed_[i].value_end);
+    base::StringPiece location_strpiece(parsed[i].value_begin,
+                                        parsed[i].value_end);
     // Escape any non-ASCII characters to preserve them.  The server should
     // only be returning ASCII here, but for compat we need to do this.
     //
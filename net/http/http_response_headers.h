@@ -8,6 +8,7 @@
 #include <stddef.h>
 #include <stdint.h>
 
+#include <atomic>
 #include <string>
 #include <unordered_set>
 #include <vector>
@@ -15,8 +16,10 @@
 #include "base/macros.h"
 #include "base/memory/ref_counted.h"
 #include "base/strings/string_piece.h"
+#include "base/synchronization/lock.h"
 #include "base/time/time.h"
 #include "net/base/net_export.h"
+#include "net/base/request_arena.h"
 #include "net/http/http_version.h"
 
 namespace base {
@@ -73,7 +76,15 @@ class NET_EXPORT HttpResponseHeaders
   //
   // HttpResponseHeaders does not perform any encoding changes on the input.
   //
-  explicit HttpResponseHeaders(const std::string& raw_headers);
+  // The headers are stored in the buffer of |raw_headers|, so moving it in
+  // avoids copying the whole block.
+  explicit HttpResponseHeaders(std::string raw_headers);
+
+  // Same as above, but the parsed headers are allocated from |arena| if it
+  // isn't null. Modifying the headers moves them back to the heap, so the
+  // arena is only used on the sequence of its request.
+  HttpResponseHeaders(std::string raw_headers,
+                      scoped_refptr<RequestArena> arena);
 
   // Initializes from the representation stored in the given pickle.  The data
   // for this object is found relative to the given pickle_iter, which should
@@ -84,8 +95,17 @@ class NET_EXPORT HttpResponseHeaders
   // headers. returns nullptr on failure. Unlike the HttpResponseHeaders
   // constructor that takes a std::string, HttpUtil::AssembleRawHeaders should
   // not be called on |headers| before calling this method.
+  // |arena| is as in the constructor above.
   static scoped_refptr<HttpResponseHeaders> TryToCreate(
-      base::StringPiece headers);
+      base::StringPiece headers,
+      scoped_refptr<RequestArena> arena = nullptr);
+
+  // Same as the constructor taking |raw_headers|, but only the status line is
+  // parsed upfront. The other headers are indexed the first time they are
+  // looked up, which is cheaper for responses whose headers are mostly
+  // forwarded as a block, see raw_headers(). Lookups may happen on any thread.
+  static scoped_refptr<HttpResponseHeaders> CreateLazily(
+      std::string raw_headers);
 
   // Appends a representation of this object to the given pickle.
   // The options argument can be a combination of PersistOptions.
@@ -317,12 +337,29 @@ class NET_EXPORT HttpResponseHeaders
 
   // The members of this structure point into raw_headers_.
   struct ParsedHeader;
-  typedef std::vector<ParsedHeader> HeaderList;
+  typedef std::vector<ParsedHeader, RequestArenaAllocator<ParsedHeader>>
+      HeaderList;
 
+  HttpResponseHeaders(std::string raw_headers,
+                      scoped_refptr<RequestArena> arena,
+                      bool index_lazily);
   ~HttpResponseHeaders();
 
-  // Initializes from the given raw headers.
-  void Parse(const std::string& raw_input);
+  // Initializes from the given raw headers. Unless |index_lazily_|, the
+  // headers are indexed as well.
+  void Parse(std::string raw_input);
+
+  // Returns |parsed_|, indexing the headers first if needed. All the reads of
+  // the parsed headers go through this.
+  const HeaderList& GetParsedHeaders() const;
+
+  // Fills |parsed_| from the headers following the status line in
+  // |raw_headers_|.
+  void BuildIndex() const;
+
+  // Clears the raw and parsed headers before they are replaced. |parsed_|
+  // switches to the heap, see the constructor taking an arena.
+  void ClearHeaders();
 
   // Helper function for ParseStatusLine.
   // Tries to extract the "HTTP/X.Y" from a status line formatted like:
@@ -357,13 +394,13 @@ class NET_EXPORT HttpResponseHeaders
   void AddHeader(std::string::const_iterator name_begin,
                  std::string::const_iterator name_end,
                  std::string::const_iterator value_begin,
-                 std::string::const_iterator value_end);
+                 std::string::const_iterator value_end) const;
 
   // Add to parsed_ given the fields of a ParsedHeader object.
   void AddToParsed(std::string::const_iterator name_begin,
                    std::string::const_iterator name_end,
                    std::string::const_iterator value_begin,
-                   std::string::const_iterator value_end);
+                   std::string::const_iterator value_end) const;
 
   // Replaces the current headers with the merged version of |raw_headers| and
   // the current headers without the headers in |headers_to_remove|. Note that
@@ -393,9 +430,21 @@ class NET_EXPORT HttpResponseHeaders
   // Adds the set of transport security state headers.
   static void AddSecurityStateHeaders(HeaderSet* header_names);
 
+  // Keeps alive the memory of |parsed_| if it uses an arena. Declared first so
+  // that it is destroyed last.
+  scoped_refptr<RequestArena> arena_;
+
   // We keep a list of ParsedHeader objects.  These tell us where to locate the
-  // header-value pairs within raw_headers_.
-  HeaderList parsed_;
+  // header-value pairs within raw_headers_. Built lazily by
+  // GetParsedHeaders() if |index_lazily_|.
+  mutable HeaderList parsed_;
+
+  // Whether |parsed_| is up to date with |raw_headers_|. Set with release
+  // semantics once |parsed_| is built, so that lookups only take
+  // |index_lock_| until then.
+  mutable std::atomic<bool> indexed_{false};
+  mutable base::Lock index_lock_;
+  const bool index_lazily_ = false;
 
   // The raw_headers_ consists of the normalized status line (terminated with a
   // null byte) and then followed by the raw null-terminated headers from the
@@ -0,0 +1,82 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "net/http/http_response_headers.h"
+
+#include <string>
+
+#include "base/logging.h"
+#include "base/memory/ref_counted.h"
+#include "base/timer/elapsed_timer.h"
+#include "net/http/http_util.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "testing/perf/perf_test.h"
+
+namespace net {
+namespace {
+
+// Headers of a typical image response served by a CDN. Most of them are only
+// forwarded to the renderer, a few are looked up by the network stack.
+const char kRepresentativeCdnHeaders[] =
+    "HTTP/1.1 200 OK\r\n"
+    "Content-Type: image/jpeg\r\n"
+    "Content-Length: 48213\r\n"
+    "Connection: keep-alive\r\n"
+    "Date: Tue, 08 Oct 2019 12:12:04 GMT\r\n"
+    "Last-Modified: Mon, 23 Sep 2019 08:41:27 GMT\r\n"
+    "ETag: \"8c3c1e9d6a8f1b6e0d0c7e6f9b7a3f21\"\r\n"
+    "Cache-Control: public, max-age=31536000, immutable\r\n"
+    "Expires: Wed, 07 Oct 2020 12:12:04 GMT\r\n"
+    "Accept-Ranges: bytes\r\n"
+    "Access-Control-Allow-Origin: *\r\n"
+    "Timing-Allow-Origin: *\r\n"
+    "Vary: Accept-Encoding, Origin\r\n"
+    "Server: ECS (dcb/7F84)\r\n"
+    "X-Cache: HIT\r\n"
+    "X-Amz-Cf-Pop: FRA2-C1\r\n"
+    "X-Amz-Cf-Id: 5WQh0cOqT6cDO6lK0v1o8hE2s5ZrPJ3TYVmVt5yWm6Qx9GfE2oT1pA==\r\n"
+    "Via: 1.1 7d3c0e1f2a9b8c4d5e6f.cloudfront.net (CloudFront)\r\n"
+    "Age: 86123\r\n"
+    "Strict-Transport-Security: max-age=31536000; includeSubDomains\r\n"
+    "X-Content-Type-Options: nosniff\r\n"
+    "Alt-Svc: h3-23=\":443\"; ma=86400, quic=\":443\"; v=\"46,43\"\r\n"
+    "\r\n";
+
+// Parses the headers and looks up the ones the network stack usually needs
+// for an image response.
+bool ParseAndLookUp(const std::string& raw_headers, bool lazily) {
+  scoped_refptr<HttpResponseHeaders> headers =
+      lazily ? HttpResponseHeaders::CreateLazily(raw_headers)
+             : base::MakeRefCounted<HttpResponseHeaders>(raw_headers);
+  return headers->GetContentLength() > 0 &&
+         headers->HasHeaderValue("connection", "keep-alive");
+}
+
+void RunParsePerfTest(bool lazily) {
+  const size_t kWarmupIterations = 1 << 10;
+  const size_t kMeasuredIterations = 1 << 17;
+  std::string raw_headers = HttpUtil::AssembleRawHeaders(
+      kRepresentativeCdnHeaders, sizeof(kRepresentativeCdnHeaders) - 1);
+  for (size_t i = 0; i < kWarmupIterations; ++i)
+    CHECK(ParseAndLookUp(raw_headers, lazily));
+  base::ElapsedTimer elapsed_timer;
+  for (size_t i = 0; i < kMeasuredIterations; ++i)
+    CHECK(ParseAndLookUp(raw_headers, lazily));
+  perf_test::PrintResult(
+      "HttpResponseHeaders", ".parse_cdn_headers", lazily ? "lazy" : "eager",
+      elapsed_timer.Elapsed().InNanoseconds() /
+          static_cast<double>(kMeasuredIterations),
+      "ns/response", true /* important */);
+}
+
+TEST(HttpResponseHeadersPerfTest, ParseCdnHeaders) {
+  RunParsePerfTest(false /* lazily */);
+}
+
+TEST(HttpResponseHeadersPerfTest, ParseCdnHeadersLazily) {
+  RunParsePerfTest(true /* lazily */);
+}
+
+}  // namespace
+}  // namespace net
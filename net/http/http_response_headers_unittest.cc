@@ -11,8 +11,10 @@
 #include <limits>
 #include <memory>
 #include <unordered_set>
+#include <vector>
 
 #include "base/pickle.h"
+#include "base/strings/string_util.h"
 #include "base/time/time.h"
 #include "base/values.h"
 #include "net/http/http_byte_range.h"
@@ -151,6 +153,15 @@ TEST_P(CommonHttpResponseHeadersTest, TestCommon) {
   EXPECT_TRUE(test.expected_version == parsed->GetHttpVersion());
   EXPECT_EQ(test.expected_response_code, parsed->response_code());
   EXPECT_EQ(test.expected_status_text, parsed->GetStatusText());
+
+  // Headers indexed lazily are normalized the same way.
+  scoped_refptr<HttpResponseHeaders> lazy =
+      HttpResponseHeaders::CreateLazily(raw_headers);
+  EXPECT_EQ(parsed->raw_headers(), lazy->raw_headers());
+  EXPECT_EQ(ToSimpleString(parsed), ToSimpleString(lazy));
+  EXPECT_TRUE(test.expected_version == lazy->GetHttpVersion());
+  EXPECT_EQ(test.expected_response_code, lazy->response_code());
+  EXPECT_EQ(test.expected_status_text, lazy->GetStatusText());
 }
 
 TestData response_headers_tests[] = {
@@ -1766,6 +1777,104 @@ TEST(HttpResponseHeadersTest, GetNormalizedHeaderWithCommas) {
   EXPECT_FALSE(parsed->GetNormalizedHeader("f", &value));
 }
 
+TEST(HttpResponseHeadersTest, Arena) {
+  auto arena = base::MakeRefCounted<RequestArena>();
+  std::string headers(
+      "HTTP/1.1 200 OK\n"
+      "Cache-Control: private\n"
+      "Content-Type: text/html\n");
+  HeadersToRaw(&headers);
+  auto parsed = base::MakeRefCounted<HttpResponseHeaders>(headers, arena);
+  size_t used_bytes = arena->used_bytes();
+  EXPECT_GT(used_bytes, 0u);
+  EXPECT_TRUE(parsed->HasHeaderValue("cache-control", "private"));
+
+  // The parsed headers outlive the request which owned the arena.
+  arena = nullptr;
+  std::string value;
+  EXPECT_TRUE(parsed->GetNormalizedHeader("content-type", &value));
+  EXPECT_EQ("text/html", value);
+
+  // Modified headers are parsed on the heap.
+  parsed->AddHeader("Foo: bar");
+  EXPECT_TRUE(parsed->HasHeaderValue("foo", "bar"));
+  EXPECT_TRUE(parsed->HasHeaderValue("cache-control", "private"));
+}
+
+std::string EnumerateAllHeaderLines(const HttpResponseHeaders& headers) {
+  std::string result = headers.GetStatusLine() + "\n";
+  size_t iter = 0;
+  std::string name;
+  std::string value;
+  while (headers.EnumerateHeaderLines(&iter, &name, &value))
+    result += name + ": " + value + "\n";
+  return result;
+}
+
+TEST(HttpResponseHeadersTest, CreateLazily) {
+  const char* const kHeaders[] = {
+      "HTTP/1.1 200 OK\n",
+      "HTTP/1.1 200 OK\n"
+      "Cache-Control: private, max-age=3600\n"
+      "Content-Type: text/html; charset=utf-8\n"
+      "Set-Cookie: a=b, c=d\n",
+      // A status line which gets normalized.
+      "hTtP/1.1   404\n"
+      "Content-Length: 10\n",
+      // Malformed lines, and lines longer than a vector register.
+      "HTTP/1.1 200 OK\n"
+      "no colon in this rather long line\n"
+      ": no name\n"
+      "   leading-space: value\n"
+      "in valid: name\n"
+      "X-A-Very-Long-Header-Name-Indeed:   value with spaces   \n"
+      "Empty:\n"
+      "Foo:bar:baz\n",
+  };
+  for (const char* raw : kHeaders) {
+    SCOPED_TRACE(raw);
+    std::string headers(raw);
+    HeadersToRaw(&headers);
+    auto eager = base::MakeRefCounted<HttpResponseHeaders>(headers);
+    auto lazy = HttpResponseHeaders::CreateLazily(headers);
+    EXPECT_EQ(eager->raw_headers(), lazy->raw_headers());
+    EXPECT_EQ(eager->response_code(), lazy->response_code());
+    EXPECT_EQ(EnumerateAllHeaderLines(*eager), EnumerateAllHeaderLines(*lazy));
+
+    // Every header, looked up by a name of another case, and one which is
+    // missing. |lazy| is indexed by the first lookup.
+    size_t iter = 0;
+    std::string name;
+    std::string value;
+    std::vector<std::string> names = {"missing"};
+    while (eager->EnumerateHeaderLines(&iter, &name, &value))
+      names.push_back(base::ToUpperASCII(name));
+    for (const std::string& lookup_name : names) {
+      SCOPED_TRACE(lookup_name);
+      std::string eager_value;
+      std::string lazy_value;
+      EXPECT_EQ(eager->GetNormalizedHeader(lookup_name, &eager_value),
+                lazy->GetNormalizedHeader(lookup_name, &lazy_value));
+      EXPECT_EQ(eager_value, lazy_value);
+    }
+  }
+}
+
+TEST(HttpResponseHeadersTest, CreateLazilyThenModify) {
+  std::string headers(
+      "HTTP/1.1 200 OK\n"
+      "Cache-Control: private\n");
+  HeadersToRaw(&headers);
+  auto lazy = HttpResponseHeaders::CreateLazily(headers);
+  // Modifying the headers before they were indexed.
+  lazy->AddHeader("Foo: bar");
+  EXPECT_TRUE(lazy->HasHeaderValue("foo", "bar"));
+  EXPECT_TRUE(lazy->HasHeaderValue("cache-control", "private"));
+  lazy->RemoveHeader("Cache-Control");
+  EXPECT_FALSE(lazy->HasHeader("cache-control"));
+  EXPECT_EQ("HTTP/1.1 200 OK\nFoo: bar\n", EnumerateAllHeaderLines(*lazy));
+}
+
 struct AddHeaderTestData {
   const char* orig_headers;
   const char* new_header;
@@ -7,6 +7,8 @@
 #include <tuple>
 #include <utility>
 
+#include "base/bind.h"
+#include "base/feature_list.h"
 #include "base/logging.h"
 #include "base/metrics/histogram_macros.h"
 #include "base/stl_util.h"
@@ -14,10 +16,12 @@
 #include "base/strings/string_split.h"
 #include "base/strings/string_util.h"
 #include "base/strings/stringprintf.h"
+#include "base/time/default_tick_clock.h"
 #include "base/time/time.h"
 #include "base/trace_event/memory_allocator_dump.h"
 #include "base/trace_event/memory_usage_estimator.h"
 #include "base/trace_event/process_memory_dump.h"
+#include "net/base/features.h"
 #include "net/base/host_mapping_rules.h"
 #include "net/base/host_port_pair.h"
 #include "net/base/parse_number.h"
@@ -27,6 +31,7 @@
 #include "net/http/http_server_properties.h"
 #include "net/http/http_stream_factory_job.h"
 #include "net/http/http_stream_factory_job_controller.h"
+#include "net/http/http_stream_preconnect_predictor.h"
 #include "net/http/transport_security_state.h"
 #include "net/quic/quic_http_utils.h"
 #include "net/spdy/bidirectional_stream_spdy_impl.h"
@@ -41,7 +46,18 @@
 namespace net {
 
 HttpStreamFactory::HttpStreamFactory(HttpNetworkSession* session)
-    : session_(session), job_factory_(std::make_unique<JobFactory>()) {}
+    : session_(session), job_factory_(std::make_unique<JobFactory>()) {
+  if (base::FeatureList::IsEnabled(features::kPreconnectPredictor)) {
+    // |preconnect_predictor_| is owned by |this|, so base::Unretained() is
+    // safe.
+    preconnect_predictor_ = std::make_unique<HttpStreamPreconnectPredictor>(
+        HttpStreamPreconnectPredictor::Params::FromFeature(),
+        session_->http_server_properties(),
+        base::BindRepeating(&HttpStreamFactory::PreconnectStreams,
+                            base::Unretained(this)),
+        base::DefaultTickClock::GetInstance());
+  }
+}
 
 HttpStreamFactory::~HttpStreamFactory() {}
 
@@ -181,6 +197,9 @@ std::unique_ptr<HttpStreamRequest> HttpStreamFactory::RequestStreamInternal(
     bool enable_ip_based_pooling,
     bool enable_alternative_services,
     const NetLogWithSource& net_log) {
+  if (preconnect_predictor_ && !is_websocket)
+    preconnect_predictor_->OnStreamRequested(request_info, net_log);
+
   auto job_controller = std::make_unique<JobController>(
       this, delegate, session_, job_factory_.get(), request_info,
       /* is_preconnect = */ false, is_websocket, enable_ip_based_pooling,
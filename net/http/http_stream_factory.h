@@ -47,6 +47,7 @@ namespace net {
 class HostMappingRules;
 class HttpNetworkSession;
 class HttpResponseHeaders;
+class HttpStreamPreconnectPredictor;
 
 class NET_EXPORT HttpStreamFactory {
  public:
@@ -205,6 +206,10 @@ class NET_EXPORT HttpStreamFactory {
   // Factory used by job controllers for creating jobs.
   std::unique_ptr<JobFactory> job_factory_;
 
+  // Keeps connections to the busiest origins warm. Null unless the
+  // PreconnectPredictor feature is enabled.
+  std::unique_ptr<HttpStreamPreconnectPredictor> preconnect_predictor_;
+
   // Set of proxy servers that support request priorities to which subsequent
   // preconnects should be skipped.
   std::set<PreconnectingProxyServer> preconnecting_proxy_servers_;
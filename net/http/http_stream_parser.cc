@@ -991,7 +991,8 @@ int HttpStreamParser::ParseResponseHeaders(int end_offset) {
   if (response_header_start_offset_ != std::string::npos) {
     received_bytes_ += end_offset;
     headers = HttpResponseHeaders::TryToCreate(
-        base::StringPiece(read_buf_->StartOfBuffer(), end_offset));
+        base::StringPiece(read_buf_->StartOfBuffer(), end_offset),
+        request_->arena);
     if (!headers)
       return net::ERR_INVALID_HTTP_RESPONSE;
   } else {
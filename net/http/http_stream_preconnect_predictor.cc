@@ -0,0 +1,198 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "net/http/http_stream_preconnect_predictor.h"
+
+#include <algorithm>
+#include <cmath>
+#include <string>
+#include <vector>
+
+#include "base/bind.h"
+#include "base/time/tick_clock.h"
+#include "net/base/features.h"
+#include "net/http/http_request_info.h"
+#include "net/http/http_server_properties.h"
+#include "net/log/net_log.h"
+#include "net/log/net_log_event_type.h"
+#include "net/log/net_log_with_source.h"
+#include "net/traffic_annotation/network_traffic_annotation.h"
+
+namespace net {
+
+namespace {
+
+// Requests started within this window count as concurrent.
+constexpr base::TimeDelta kConcurrencyWindow = base::TimeDelta::FromSeconds(1);
+
+// Origins with a lower score are forgotten.
+const double kMinScore = 0.1;
+
+// Bound on the number of origins tracked, to bound memory use.
+const size_t kMaxTrackedOrigins = 256;
+
+constexpr NetworkTrafficAnnotationTag kTrafficAnnotation =
+    DefineNetworkTrafficAnnotation("http_stream_preconnect_predictor", R"(
+        semantics {
+          sender: "HTTP Stream Preconnect Predictor"
+          description:
+            "Opens connections ahead of time to the origins the network stack "
+            "recently sent the most requests to, so that the next requests to "
+            "them don't wait for a connection to be set up."
+          trigger:
+            "Periodically, while recent requests were made to an origin."
+          data: "None, only the connection is set up."
+          destination: WEBSITE
+        }
+        policy {
+          cookies_allowed: NO
+          setting: "This feature cannot be disabled by settings."
+          policy_exception_justification:
+            "Disabled unless the PreconnectPredictor feature is enabled."
+        })");
+
+}  // namespace
+
+HttpStreamPreconnectPredictor::Params::Params()
+    : max_origins(8),
+      socket_budget(24),
+      max_streams_per_origin(6),
+      warm_up_interval(base::TimeDelta::FromSeconds(30)),
+      score_half_life(base::TimeDelta::FromMinutes(10)) {}
+
+// static
+HttpStreamPreconnectPredictor::Params
+HttpStreamPreconnectPredictor::Params::FromFeature() {
+  Params params;
+  params.max_origins = features::kPreconnectPredictorMaxOrigins.Get();
+  params.socket_budget = features::kPreconnectPredictorSocketBudget.Get();
+  params.warm_up_interval = base::TimeDelta::FromSeconds(
+      features::kPreconnectPredictorWarmUpIntervalSeconds.Get());
+  return params;
+}
+
+HttpStreamPreconnectPredictor::OriginStats::OriginStats() = default;
+
+HttpStreamPreconnectPredictor::OriginStats::~OriginStats() = default;
+
+HttpStreamPreconnectPredictor::HttpStreamPreconnectPredictor(
+    const Params& params,
+    HttpServerProperties* http_server_properties,
+    const PreconnectCallback& preconnect_callback,
+    const base::TickClock* tick_clock)
+    : params_(params),
+      http_server_properties_(http_server_properties),
+      preconnect_callback_(preconnect_callback),
+      tick_clock_(tick_clock),
+      warm_up_timer_(tick_clock) {
+  DCHECK(http_server_properties_);
+  warm_up_timer_.Start(FROM_HERE, params_.warm_up_interval,
+                       base::BindRepeating(
+                           &HttpStreamPreconnectPredictor::WarmUp,
+                           base::Unretained(this)));
+}
+
+HttpStreamPreconnectPredictor::~HttpStreamPreconnectPredictor() = default;
+
+void HttpStreamPreconnectPredictor::OnStreamRequested(
+    const HttpRequestInfo& request_info,
+    const NetLogWithSource& net_log) {
+  if (!request_info.url.SchemeIsHTTPOrHTTPS())
+    return;
+
+  base::TimeTicks now = tick_clock_->NowTicks();
+  OriginKey key(url::SchemeHostPort(request_info.url),
+                request_info.privacy_mode);
+  OriginStats& stats = origins_[key];
+
+  stats.score = GetDecayedScore(stats, now) + 1;
+  stats.score_time = now;
+
+  while (!stats.recent_requests.empty() &&
+         now - stats.recent_requests.front() >= kConcurrencyWindow) {
+    stats.recent_requests.pop_front();
+  }
+  stats.recent_requests.push_back(now);
+  int concurrency = std::min(static_cast<int>(stats.recent_requests.size()),
+                             params_.max_streams_per_origin);
+  if (concurrency >= stats.concurrency) {
+    stats.concurrency = concurrency;
+    stats.concurrency_reached = true;
+  }
+
+  bool hit = stats.warmed_streams > 0;
+  if (hit)
+    --stats.warmed_streams;
+  if (net_log.IsCapturing()) {
+    std::string origin = key.first.Serialize();
+    net_log.AddEvent(
+        hit ? NetLogEventType::HTTP_STREAM_PRECONNECT_PREDICTOR_HIT
+            : NetLogEventType::HTTP_STREAM_PRECONNECT_PREDICTOR_MISS,
+        NetLog::StringCallback("origin", &origin));
+  }
+}
+
+void HttpStreamPreconnectPredictor::WarmUp() {
+  base::TimeTicks now = tick_clock_->NowTicks();
+
+  std::vector<std::pair<double, std::map<OriginKey, OriginStats>::iterator>>
+      ranked;
+  for (auto it = origins_.begin(); it != origins_.end();) {
+    double score = GetDecayedScore(it->second, now);
+    if (score < kMinScore) {
+      it = origins_.erase(it);
+      continue;
+    }
+    ranked.emplace_back(score, it);
+    ++it;
+  }
+  std::sort(ranked.begin(), ranked.end(),
+            [](const auto& a, const auto& b) { return a.first > b.first; });
+
+  while (ranked.size() > kMaxTrackedOrigins) {
+    origins_.erase(ranked.back().second);
+    ranked.pop_back();
+  }
+
+  int budget = params_.socket_budget;
+  for (size_t i = 0; i < ranked.size(); ++i) {
+    OriginStats& stats = ranked[i].second->second;
+    if (!stats.concurrency_reached && stats.concurrency > 1)
+      --stats.concurrency;
+    stats.concurrency_reached = false;
+    stats.warmed_streams = 0;
+
+    if (i >= params_.max_origins || budget <= 0)
+      continue;
+
+    const url::SchemeHostPort& origin = ranked[i].second->first.first;
+    int num_streams =
+        http_server_properties_->SupportsRequestPriority(origin)
+            ? 1
+            : std::max(1, stats.concurrency);
+    num_streams = std::min(num_streams, budget);
+    budget -= num_streams;
+    stats.warmed_streams = num_streams;
+
+    HttpRequestInfo request_info;
+    request_info.url = GURL(origin.Serialize());
+    request_info.method = "GET";
+    request_info.privacy_mode = ranked[i].second->first.second;
+    request_info.traffic_annotation =
+        MutableNetworkTrafficAnnotationTag(kTrafficAnnotation);
+    preconnect_callback_.Run(num_streams, request_info);
+  }
+}
+
+double HttpStreamPreconnectPredictor::GetDecayedScore(
+    const OriginStats& stats,
+    base::TimeTicks now) const {
+  if (stats.score == 0)
+    return 0;
+  double half_lives = (now - stats.score_time).InSecondsF() /
+                      params_.score_half_life.InSecondsF();
+  return stats.score * std::pow(0.5, half_lives);
+}
+
+}  // namespace net
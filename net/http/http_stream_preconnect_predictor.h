@@ -0,0 +1,117 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef NET_HTTP_HTTP_STREAM_PRECONNECT_PREDICTOR_H_
+#define NET_HTTP_HTTP_STREAM_PRECONNECT_PREDICTOR_H_
+
+#include <map>
+#include <utility>
+
+#include "base/callback.h"
+#include "base/containers/circular_deque.h"
+#include "base/macros.h"
+#include "base/time/time.h"
+#include "base/timer/timer.h"
+#include "net/base/net_export.h"
+#include "net/base/privacy_mode.h"
+#include "url/scheme_host_port.h"
+
+namespace base {
+class TickClock;
+}  // namespace base
+
+namespace net {
+
+class HttpServerProperties;
+class NetLogWithSource;
+struct HttpRequestInfo;
+
+// Learns which origins the HttpStreamFactory requests streams to, and how many
+// at once, and periodically preconnects to the busiest ones so that their
+// next requests find warm idle sockets or sessions.
+//
+// Each origin has a score, the number of stream requests to it decayed over
+// time, and a concurrency, the largest number of requests to it started
+// within one second, decayed by one each time it isn't reached again before
+// the next warm-up. Every warm-up preconnects the top |max_origins| origins by
+// score, one stream each if they support HTTP/2 or QUIC and |concurrency|
+// streams otherwise, until |socket_budget| streams have been requested.
+//
+// Whether a request uses a warmed socket isn't plumbed back, so hits and misses
+// are estimated: a request is a hit if fewer requests to its origin than were
+// preconnected by the last warm-up have arrived since.
+class NET_EXPORT_PRIVATE HttpStreamPreconnectPredictor {
+ public:
+  // Called to preconnect |num_streams| streams for the request.
+  using PreconnectCallback =
+      base::RepeatingCallback<void(int num_streams,
+                                   const HttpRequestInfo& request_info)>;
+
+  struct NET_EXPORT_PRIVATE Params {
+    Params();
+
+    // Reads the params of the kPreconnectPredictor feature.
+    static Params FromFeature();
+
+    size_t max_origins;
+    int socket_budget;
+    int max_streams_per_origin;
+    base::TimeDelta warm_up_interval;
+    // The time after which the score of an origin is halved.
+    base::TimeDelta score_half_life;
+  };
+
+  // |http_server_properties| must outlive |this|.
+  HttpStreamPreconnectPredictor(const Params& params,
+                                HttpServerProperties* http_server_properties,
+                                const PreconnectCallback& preconnect_callback,
+                                const base::TickClock* tick_clock);
+  ~HttpStreamPreconnectPredictor();
+
+  // Records a stream request, and logs whether it was predicted to |net_log|.
+  void OnStreamRequested(const HttpRequestInfo& request_info,
+                         const NetLogWithSource& net_log);
+
+  // Preconnects to the busiest origins. Called periodically; exposed for
+  // tests.
+  void WarmUp();
+
+  size_t GetOriginCountForTesting() const { return origins_.size(); }
+
+ private:
+  using OriginKey = std::pair<url::SchemeHostPort, PrivacyMode>;
+
+  struct OriginStats {
+    OriginStats();
+    ~OriginStats();
+
+    double score = 0;
+    base::TimeTicks score_time;
+    // Start times of the requests in the last second.
+    base::circular_deque<base::TimeTicks> recent_requests;
+    int concurrency = 0;
+    // Whether |concurrency| was reached since the last warm-up.
+    bool concurrency_reached = false;
+    // Preconnected streams not yet matched to a request.
+    int warmed_streams = 0;
+  };
+
+  // Returns the score of |stats| decayed to |now|.
+  double GetDecayedScore(const OriginStats& stats, base::TimeTicks now) const;
+
+  const Params params_;
+  HttpServerProperties* const http_server_properties_;
+  const PreconnectCallback preconnect_callback_;
+  const base::TickClock* const tick_clock_;
+
+  std::map<OriginKey, OriginStats> origins_;
+
+  base::RepeatingTimer warm_up_timer_;
+
+  DISALLOW_COPY_AND_ASSIGN(HttpStreamPreconnectPredictor);
+};
+
+}  // namespace net
+
+#endif  // NET_HTTP_HTTP_STREAM_PRECONNECT_PREDICTOR_H_
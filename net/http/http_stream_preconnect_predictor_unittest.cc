@@ -0,0 +1,154 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "net/http/http_stream_preconnect_predictor.h"
+
+#include <map>
+#include <string>
+
+#include "base/bind.h"
+#include "net/http/http_request_info.h"
+#include "net/http/http_server_properties_impl.h"
+#include "net/log/net_log_with_source.h"
+#include "net/log/test_net_log.h"
+#include "net/log/test_net_log_entry.h"
+#include "net/test/test_with_scoped_task_environment.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "url/gurl.h"
+
+namespace net {
+
+namespace {
+
+class HttpStreamPreconnectPredictorTest : public TestWithScopedTaskEnvironment {
+ protected:
+  HttpStreamPreconnectPredictorTest()
+      : TestWithScopedTaskEnvironment(
+            base::test::ScopedTaskEnvironment::MainThreadType::MOCK_TIME) {
+    params_.max_origins = 2;
+    params_.socket_budget = 5;
+  }
+
+  void CreatePredictor() {
+    predictor_ = std::make_unique<HttpStreamPreconnectPredictor>(
+        params_, &http_server_properties_,
+        base::BindRepeating(&HttpStreamPreconnectPredictorTest::OnPreconnect,
+                            base::Unretained(this)),
+        GetMockTickClock());
+  }
+
+  void Request(const std::string& url) {
+    HttpRequestInfo request_info;
+    request_info.url = GURL(url);
+    request_info.method = "GET";
+    predictor_->OnStreamRequested(
+        request_info,
+        NetLogWithSource::Make(&net_log_, NetLogSourceType::NONE));
+  }
+
+  void OnPreconnect(int num_streams, const HttpRequestInfo& request_info) {
+    preconnects_[request_info.url.spec()] += num_streams;
+  }
+
+  HttpStreamPreconnectPredictor::Params params_;
+  HttpServerPropertiesImpl http_server_properties_;
+  TestNetLog net_log_;
+  std::unique_ptr<HttpStreamPreconnectPredictor> predictor_;
+  std::map<std::string, int> preconnects_;
+};
+
+TEST_F(HttpStreamPreconnectPredictorTest, PreconnectsBusiestOrigins) {
+  CreatePredictor();
+  for (int i = 0; i < 3; ++i)
+    Request("https://a.test/");
+  for (int i = 0; i < 2; ++i)
+    Request("https://b.test/");
+  Request("https://c.test/");
+
+  FastForwardBy(params_.warm_up_interval);
+
+  // Only the two busiest origins are preconnected, with as many streams as
+  // they had concurrent requests.
+  EXPECT_EQ(2u, preconnects_.size());
+  EXPECT_EQ(3, preconnects_["https://a.test/"]);
+  EXPECT_EQ(2, preconnects_["https://b.test/"]);
+}
+
+TEST_F(HttpStreamPreconnectPredictorTest, RespectsSocketBudget) {
+  params_.socket_budget = 4;
+  CreatePredictor();
+  for (int i = 0; i < 3; ++i) {
+    Request("https://a.test/");
+    Request("https://b.test/");
+  }
+  Request("https://a.test/");
+
+  predictor_->WarmUp();
+
+  EXPECT_EQ(4, preconnects_["https://a.test/"]);
+  EXPECT_EQ(0, preconnects_["https://b.test/"]);
+}
+
+TEST_F(HttpStreamPreconnectPredictorTest, OneStreamForMultiplexedOrigins) {
+  CreatePredictor();
+  http_server_properties_.SetSupportsSpdy(
+      url::SchemeHostPort(GURL("https://a.test/")), true);
+  for (int i = 0; i < 3; ++i)
+    Request("https://a.test/");
+
+  predictor_->WarmUp();
+
+  EXPECT_EQ(1, preconnects_["https://a.test/"]);
+}
+
+TEST_F(HttpStreamPreconnectPredictorTest, ConcurrencyDecays) {
+  CreatePredictor();
+  for (int i = 0; i < 3; ++i)
+    Request("https://a.test/");
+  predictor_->WarmUp();
+  EXPECT_EQ(3, preconnects_["https://a.test/"]);
+
+  // Requests more than a second apart aren't concurrent, so the concurrency
+  // goes down by one at each warm-up.
+  FastForwardBy(base::TimeDelta::FromSeconds(2));
+  Request("https://a.test/");
+  preconnects_.clear();
+  predictor_->WarmUp();
+  EXPECT_EQ(2, preconnects_["https://a.test/"]);
+}
+
+TEST_F(HttpStreamPreconnectPredictorTest, ForgetsIdleOrigins) {
+  CreatePredictor();
+  Request("https://a.test/");
+  EXPECT_EQ(1u, predictor_->GetOriginCountForTesting());
+
+  FastForwardBy(params_.score_half_life * 4);
+  preconnects_.clear();
+  predictor_->WarmUp();
+
+  EXPECT_EQ(0u, predictor_->GetOriginCountForTesting());
+  EXPECT_TRUE(preconnects_.empty());
+}
+
+TEST_F(HttpStreamPreconnectPredictorTest, LogsHitsAndMisses) {
+  CreatePredictor();
+  Request("https://a.test/");
+  predictor_->WarmUp();
+  Request("https://a.test/");
+  Request("https://a.test/");
+
+  TestNetLogEntry::List entries;
+  net_log_.GetEntries(&entries);
+  ASSERT_EQ(3u, entries.size());
+  EXPECT_EQ(NetLogEventType::HTTP_STREAM_PRECONNECT_PREDICTOR_MISS,
+            entries[0].type);
+  EXPECT_EQ(NetLogEventType::HTTP_STREAM_PRECONNECT_PREDICTOR_HIT,
+            entries[1].type);
+  EXPECT_EQ(NetLogEventType::HTTP_STREAM_PRECONNECT_PREDICTOR_MISS,
+            entries[2].type);
+}
+
+}  // namespace
+
+}  // namespace net
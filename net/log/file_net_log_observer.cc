@@ -20,6 +20,7 @@
 #include "base/synchronization/lock.h"
 #include "base/task/post_task.h"
 #include "base/values.h"
+#include "net/log/net_log_binary_encoding.h"
 #include "net/log/net_log_capture_mode.h"
 #include "net/log/net_log_entry.h"
 #include "net/log/net_log_util.h"
@@ -201,6 +202,7 @@ class FileNetLogObserver::FileWriter {
              base::Optional<base::File> pre_existing_log_file,
              uint64_t max_event_file_size,
              size_t total_num_event_files,
+             Format format,
              scoped_refptr<base::SequencedTaskRunner> task_runner);
 
   ~FileWriter();
@@ -262,12 +264,12 @@ class FileNetLogObserver::FileWriter {
   size_t FileNumberToIndex(size_t file_number) const;
 
   // Writes |constants_value| to a file.
-  static void WriteConstantsToFile(std::unique_ptr<base::Value> constants_value,
-                                   base::File* file);
+  void WriteConstantsToFile(std::unique_ptr<base::Value> constants_value,
+                            base::File* file) const;
 
   // Writes |polled_data| to a file.
-  static void WritePolledDataToFile(std::unique_ptr<base::Value> polled_data,
-                                    base::File* file);
+  void WritePolledDataToFile(std::unique_ptr<base::Value> polled_data,
+                             base::File* file) const;
 
   // If any events were written (wrote_event_bytes_), rewinds |file| by 2 bytes
   // in order to overwrite the trailing ",\n" that was written by the last event
@@ -321,6 +323,10 @@ class FileNetLogObserver::FileWriter {
   // JSON (events list shouldn't end with a comma).
   bool wrote_event_bytes_;
 
+  // Format of the log. Binary events are written without separators, and the
+  // constants and polled data are written as binary records.
+  const Format format_;
+
   // Task runner for doing file operations.
   const scoped_refptr<base::SequencedTaskRunner> task_runner_;
 
@@ -333,14 +339,14 @@ std::unique_ptr<FileNetLogObserver> FileNetLogObserver::CreateBounded(
     std::unique_ptr<base::Value> constants) {
   return CreateInternal(log_path, SiblingInprogressDirectory(log_path),
                         base::nullopt, max_total_size, kDefaultNumFiles,
-                        std::move(constants));
+                        Format::kJson, std::move(constants));
 }
 
 std::unique_ptr<FileNetLogObserver> FileNetLogObserver::CreateUnbounded(
     const base::FilePath& log_path,
     std::unique_ptr<base::Value> constants) {
   return CreateInternal(log_path, base::FilePath(), base::nullopt, kNoLimit,
-                        kDefaultNumFiles, std::move(constants));
+                        kDefaultNumFiles, Format::kJson, std::move(constants));
 }
 
 std::unique_ptr<FileNetLogObserver>
@@ -351,7 +357,8 @@ FileNetLogObserver::CreateBoundedPreExisting(
     std::unique_ptr<base::Value> constants) {
   return CreateInternal(base::FilePath(), inprogress_dir_path,
                         base::make_optional<base::File>(std::move(output_file)),
-                        max_total_size, kDefaultNumFiles, std::move(constants));
+                        max_total_size, kDefaultNumFiles, Format::kJson,
+                        std::move(constants));
 }
 
 std::unique_ptr<FileNetLogObserver>
@@ -360,7 +367,25 @@ FileNetLogObserver::CreateUnboundedPreExisting(
     std::unique_ptr<base::Value> constants) {
   return CreateInternal(base::FilePath(), base::FilePath(),
                         base::make_optional<base::File>(std::move(output_file)),
-                        kNoLimit, kDefaultNumFiles, std::move(constants));
+                        kNoLimit, kDefaultNumFiles, Format::kJson,
+                        std::move(constants));
+}
+
+std::unique_ptr<FileNetLogObserver> FileNetLogObserver::CreateBinaryBounded(
+    const base::FilePath& log_path,
+    uint64_t max_total_size,
+    std::unique_ptr<base::Value> constants) {
+  return CreateInternal(log_path, SiblingInprogressDirectory(log_path),
+                        base::nullopt, max_total_size, kDefaultNumFiles,
+                        Format::kBinary, std::move(constants));
+}
+
+std::unique_ptr<FileNetLogObserver> FileNetLogObserver::CreateBinaryUnbounded(
+    const base::FilePath& log_path,
+    std::unique_ptr<base::Value> constants) {
+  return CreateInternal(log_path, base::FilePath(), base::nullopt, kNoLimit,
+                        kDefaultNumFiles, Format::kBinary,
+                        std::move(constants));
 }
 
 FileNetLogObserver::~FileNetLogObserver() {
@@ -384,6 +409,13 @@ void FileNetLogObserver::StopObserving(std::unique_ptr<base::Value> polled_data,
                                        base::OnceClosure optional_callback) {
   net_log()->RemoveObserver(this);
 
+  // The keys of binary events are only written once no more can be interned.
+  // As the newest entry, the key table is never dropped from |write_queue_|.
+  if (binary_encoder_) {
+    write_queue_->AddEntryToQueue(
+        std::make_unique<std::string>(binary_encoder_->EncodeKeyTable()));
+  }
+
   base::OnceClosure bound_flush_then_stop =
       base::Bind(&FileNetLogObserver::FileWriter::FlushThenStop,
                  base::Unretained(file_writer_.get()), write_queue_,
@@ -400,11 +432,14 @@ void FileNetLogObserver::StopObserving(std::unique_ptr<base::Value> polled_data,
 }
 
 void FileNetLogObserver::OnAddEntry(const NetLogEntry& entry) {
-  std::unique_ptr<std::string> json(new std::string);
+  std::unique_ptr<std::string> event(new std::string);
 
-  *json = SerializeNetLogValueToJson(*entry.ToValue());
+  if (binary_encoder_)
+    *event = binary_encoder_->EncodeEntry(entry);
+  else
+    *event = SerializeNetLogValueToJson(*entry.ToValue());
 
-  size_t queue_size = write_queue_->AddEntryToQueue(std::move(json));
+  size_t queue_size = write_queue_->AddEntryToQueue(std::move(event));
 
   // If events build up in |write_queue_|, trigger the file task runner to drain
   // the queue. Because only 1 item is added to the queue at a time, if
@@ -425,7 +460,7 @@ std::unique_ptr<FileNetLogObserver> FileNetLogObserver::CreateBoundedForTests(
     std::unique_ptr<base::Value> constants) {
   return CreateInternal(log_path, SiblingInprogressDirectory(log_path),
                         base::nullopt, max_total_size, total_num_event_files,
-                        std::move(constants));
+                        Format::kJson, std::move(constants));
 }
 
 std::unique_ptr<FileNetLogObserver> FileNetLogObserver::CreateInternal(
@@ -434,6 +469,7 @@ std::unique_ptr<FileNetLogObserver> FileNetLogObserver::CreateInternal(
     base::Optional<base::File> pre_existing_log_file,
     uint64_t max_total_size,
     size_t total_num_event_files,
+    Format format,
     std::unique_ptr<base::Value> constants) {
   DCHECK_GT(total_num_event_files, 0u);
 
@@ -458,23 +494,27 @@ std::unique_ptr<FileNetLogObserver> FileNetLogObserver::CreateInternal(
   // relative to file size.
   std::unique_ptr<FileWriter> file_writer(new FileWriter(
       log_path, inprogress_dir_path, std::move(pre_existing_log_file),
-      max_event_file_size, total_num_event_files, file_task_runner));
+      max_event_file_size, total_num_event_files, format, file_task_runner));
 
   scoped_refptr<WriteQueue> write_queue(new WriteQueue(max_total_size * 2));
 
   return std::unique_ptr<FileNetLogObserver>(
       new FileNetLogObserver(file_task_runner, std::move(file_writer),
-                             std::move(write_queue), std::move(constants)));
+                             std::move(write_queue), format,
+                             std::move(constants)));
 }
 
 FileNetLogObserver::FileNetLogObserver(
     scoped_refptr<base::SequencedTaskRunner> file_task_runner,
     std::unique_ptr<FileWriter> file_writer,
     scoped_refptr<WriteQueue> write_queue,
+    Format format,
     std::unique_ptr<base::Value> constants)
     : file_task_runner_(std::move(file_task_runner)),
       write_queue_(std::move(write_queue)),
       file_writer_(std::move(file_writer)) {
+  if (format == Format::kBinary)
+    binary_encoder_ = std::make_unique<NetLogBinaryEncoder>();
   if (!constants)
     constants = GetNetConstants();
   file_task_runner_->PostTask(
@@ -518,6 +558,7 @@ FileNetLogObserver::FileWriter::FileWriter(
     base::Optional<base::File> pre_existing_log_file,
     uint64_t max_event_file_size,
     size_t total_num_event_files,
+    Format format,
     scoped_refptr<base::SequencedTaskRunner> task_runner)
     : final_log_path_(log_path),
       inprogress_dir_path_(inprogress_dir_path),
@@ -525,6 +566,7 @@ FileNetLogObserver::FileWriter::FileWriter(
       current_event_file_number_(0),
       max_event_file_size_(max_event_file_size),
       wrote_event_bytes_(false),
+      format_(format),
       task_runner_(std::move(task_runner)) {
   DCHECK_EQ(pre_existing_log_file.has_value(), log_path.empty());
   DCHECK_EQ(IsBounded(), !inprogress_dir_path.empty());
@@ -603,7 +645,8 @@ void FileNetLogObserver::FileWriter::Flush(
     }
 
     size_t bytes_written =
-        WriteToFile(output_file, *local_file_queue.front(), ",\n");
+        WriteToFile(output_file, *local_file_queue.front(),
+                    format_ == Format::kJson ? ",\n" : "");
 
     wrote_event_bytes_ |= bytes_written > 0;
 
@@ -681,7 +724,12 @@ size_t FileNetLogObserver::FileWriter::FileNumberToIndex(
 
 void FileNetLogObserver::FileWriter::WriteConstantsToFile(
     std::unique_ptr<base::Value> constants_value,
-    base::File* file) {
+    base::File* file) const {
+  if (format_ == Format::kBinary) {
+    WriteToFile(file, NetLogBinaryEncoder::EncodeHeader(*constants_value));
+    return;
+  }
+
   // Print constants to file and open events array.
   std::string json = SerializeNetLogValueToJson(*constants_value);
   WriteToFile(file, "{\"constants\":", json, ",\n\"events\": [\n");
@@ -689,7 +737,13 @@ void FileNetLogObserver::FileWriter::WriteConstantsToFile(
 
 void FileNetLogObserver::FileWriter::WritePolledDataToFile(
     std::unique_ptr<base::Value> polled_data,
-    base::File* file) {
+    base::File* file) const {
+  if (format_ == Format::kBinary) {
+    if (polled_data)
+      WriteToFile(file, NetLogBinaryEncoder::EncodePolledData(*polled_data));
+    return;
+  }
+
   // Close the events array.
   WriteToFile(file, "]");
 
@@ -707,7 +761,7 @@ void FileNetLogObserver::FileWriter::WritePolledDataToFile(
 
 void FileNetLogObserver::FileWriter::RewindIfWroteEventBytes(
     base::File* file) const {
-  if (file->IsValid() && wrote_event_bytes_) {
+  if (format_ == Format::kJson && file->IsValid() && wrote_event_bytes_) {
     // To be valid JSON the events array should not end with a comma. If events
     // were written though, they will have been terminated with "\n," so strip
     // it before closing the events array.
@@ -23,6 +23,7 @@ class SequencedTaskRunner;
 
 namespace net {
 
+class NetLogBinaryEncoder;
 class NetLogCaptureMode;
 
 // FileNetLogObserver watches the NetLog event stream and sends all entries to
@@ -41,6 +42,16 @@ class NET_EXPORT FileNetLogObserver : public NetLog::ThreadSafeObserver {
   // Special value meaning "can use an unlimited number of bytes".
   static constexpr uint64_t kNoLimit = std::numeric_limits<uint64_t>::max();
 
+  // Formats of the log file.
+  enum class Format {
+    // The JSON format read by the NetLog viewer.
+    kJson,
+    // The binary format described in net_log_binary_encoding.h. It is several
+    // times cheaper to write, and net/tools/net_log_binary_to_json converts
+    // it to JSON.
+    kBinary,
+  };
+
   // Creates an instance of FileNetLogObserver that writes observed netlog
   // events to |log_path|.
   //
@@ -82,6 +93,16 @@ class NET_EXPORT FileNetLogObserver : public NetLog::ThreadSafeObserver {
       base::File output_file,
       std::unique_ptr<base::Value> constants);
 
+  // Same as CreateBounded() and CreateUnbounded(), but write the log in
+  // Format::kBinary.
+  static std::unique_ptr<FileNetLogObserver> CreateBinaryBounded(
+      const base::FilePath& log_path,
+      uint64_t max_total_size,
+      std::unique_ptr<base::Value> constants);
+  static std::unique_ptr<FileNetLogObserver> CreateBinaryUnbounded(
+      const base::FilePath& log_path,
+      std::unique_ptr<base::Value> constants);
+
   ~FileNetLogObserver() override;
 
   // Attaches this observer to |net_log| and begins observing events.
@@ -125,11 +146,13 @@ class NET_EXPORT FileNetLogObserver : public NetLog::ThreadSafeObserver {
       base::Optional<base::File> pre_existing_out_file,
       uint64_t max_total_size,
       size_t total_num_event_files,
+      Format format,
       std::unique_ptr<base::Value> constants);
 
   FileNetLogObserver(scoped_refptr<base::SequencedTaskRunner> file_task_runner,
                      std::unique_ptr<FileWriter> file_writer,
                      scoped_refptr<WriteQueue> write_queue,
+                     Format format,
                      std::unique_ptr<base::Value> constants);
 
   scoped_refptr<base::SequencedTaskRunner> file_task_runner_;
@@ -148,6 +171,11 @@ class NET_EXPORT FileNetLogObserver : public NetLog::ThreadSafeObserver {
   // finished (since it is posted using base::Unretained()).
   std::unique_ptr<FileWriter> file_writer_;
 
+  // Encodes events in Format::kBinary. Null in Format::kJson. Only used in
+  // OnAddEntry(), which NetLog never calls concurrently, and in
+  // StopObserving() once observing has stopped.
+  std::unique_ptr<NetLogBinaryEncoder> binary_encoder_;
+
   DISALLOW_COPY_AND_ASSIGN(FileNetLogObserver);
 };
 
@@ -21,6 +21,7 @@
 #include "base/threading/thread.h"
 #include "base/values.h"
 #include "net/base/test_completion_callback.h"
+#include "net/log/net_log_binary_encoding.h"
 #include "net/log/net_log_entry.h"
 #include "net/log/net_log_event_type.h"
 #include "net/log/net_log_parameters_callback.h"
@@ -557,6 +558,47 @@ TEST_P(FileNetLogObserverTest, GeneratesValidJSONWithPolledData) {
                                    kDummyPolledDataString);
 }
 
+// Writes a binary log and checks that converting it gives the JSON log.
+TEST_P(FileNetLogObserverTest, BinaryFormatConvertsToJson) {
+  TestClosure closure;
+  const int kNumEvents = 10;
+
+  if (IsBounded()) {
+    logger_ = FileNetLogObserver::CreateBinaryBounded(log_path_,
+                                                      kLargeFileSize, nullptr);
+  } else {
+    logger_ = FileNetLogObserver::CreateBinaryUnbounded(log_path_, nullptr);
+  }
+  logger_->StartObserving(&net_log_, NetLogCaptureMode::Default());
+  AddEntries(logger_.get(), kNumEvents, kDummyEventSize);
+
+  auto polled_data = std::make_unique<base::DictionaryValue>();
+  polled_data->SetString("dummy_path", "dummy_info");
+  logger_->StopObserving(std::move(polled_data), closure.closure());
+  closure.WaitForResult();
+
+  std::string binary;
+  ASSERT_TRUE(base::ReadFileToString(log_path_, &binary));
+  std::string json;
+  ASSERT_TRUE(ConvertBinaryNetLogToJson(binary, &json));
+  EXPECT_LT(binary.size(), json.size());
+
+  ParsedNetLog log;
+  ASSERT_TRUE(log.InitFromFileContents(json));
+  VerifyEventsInLog(&log, kNumEvents, kNumEvents);
+  ExpectDictionaryContainsProperty(log.polled_data, "dummy_path",
+                                   "dummy_info");
+
+  // The parameters survive the round trip.
+  std::string message;
+  ASSERT_TRUE(log.GetEvent(0)->GetString("params.message", &message));
+  EXPECT_EQ(std::string::npos, message.find_first_not_of('x'));
+  EXPECT_FALSE(message.empty());
+  int type;
+  ASSERT_TRUE(log.GetEvent(0)->GetInteger("type", &type));
+  EXPECT_EQ(static_cast<int>(NetLogEventType::PAC_JAVASCRIPT_ERROR), type);
+}
+
 // Adds events concurrently from several different threads. The exact order of
 // events seen by this test is non-deterministic.
 TEST_P(FileNetLogObserverTest, AddEventsFromMultipleThreads) {
@@ -0,0 +1,417 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "net/log/net_log_binary_encoding.h"
+
+#include <stdint.h>
+#include <string.h>
+
+#include <memory>
+#include <utility>
+
+#include "base/json/json_writer.h"
+#include "base/logging.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/values.h"
+#include "net/log/file_net_log_observer.h"
+#include "net/log/net_log_entry.h"
+
+namespace net {
+
+const char kNetLogBinaryMagic[] = "NETLOGB1";
+const size_t kNetLogBinaryMagicLength = sizeof(kNetLogBinaryMagic) - 1;
+
+namespace {
+
+const char kConstantsTag = 'C';
+const char kEventTag = 'E';
+const char kKeyTableTag = 'K';
+const char kPolledDataTag = 'P';
+
+// Types of encoded values. kNoValue is used for events without parameters.
+enum ValueType : uint8_t {
+  kNoValue = 0,
+  kNull = 1,
+  kFalse = 2,
+  kTrue = 3,
+  kInteger = 4,
+  kDouble = 5,
+  kString = 6,
+  kList = 7,
+  kDictionary = 8,
+};
+
+// Bound on the nesting of decoded values, so that corrupt files can't
+// overflow the stack.
+const int kMaxDepth = 64;
+
+void AppendVarint(uint64_t value, std::string* out) {
+  while (value >= 0x80) {
+    out->push_back(static_cast<char>((value & 0x7f) | 0x80));
+    value >>= 7;
+  }
+  out->push_back(static_cast<char>(value));
+}
+
+void AppendSignedVarint(int64_t value, std::string* out) {
+  AppendVarint((static_cast<uint64_t>(value) << 1) ^ (value >> 63), out);
+}
+
+void AppendString(base::StringPiece value, std::string* out) {
+  AppendVarint(value.size(), out);
+  value.AppendToString(out);
+}
+
+std::string MakeRecord(char tag, base::StringPiece payload) {
+  std::string record(1, tag);
+  AppendString(payload, &record);
+  return record;
+}
+
+std::string ToJson(const base::Value& value) {
+  std::string json;
+  base::JSONWriter::Write(value, &json);
+  return json;
+}
+
+// Reads the pieces of a binary NetLog from the front of |data_|.
+class Reader {
+ public:
+  explicit Reader(base::StringPiece data) : data_(data) {}
+
+  bool empty() const { return data_.empty(); }
+
+  bool ReadByte(uint8_t* value) {
+    if (data_.empty())
+      return false;
+    *value = static_cast<uint8_t>(data_[0]);
+    data_.remove_prefix(1);
+    return true;
+  }
+
+  bool ReadVarint(uint64_t* value) {
+    *value = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+      uint8_t byte;
+      if (!ReadByte(&byte))
+        return false;
+      *value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+      if (!(byte & 0x80))
+        return true;
+    }
+    return false;
+  }
+
+  bool ReadSignedVarint(int64_t* value) {
+    uint64_t zigzag;
+    if (!ReadVarint(&zigzag))
+      return false;
+    *value = static_cast<int64_t>(zigzag >> 1) ^
+             -static_cast<int64_t>(zigzag & 1);
+    return true;
+  }
+
+  bool ReadBytes(size_t length, base::StringPiece* value) {
+    if (data_.size() < length)
+      return false;
+    *value = data_.substr(0, length);
+    data_.remove_prefix(length);
+    return true;
+  }
+
+  bool ReadString(base::StringPiece* value) {
+    uint64_t length;
+    return ReadVarint(&length) && ReadBytes(length, value);
+  }
+
+ private:
+  base::StringPiece data_;
+};
+
+bool DecodeValue(Reader* reader,
+                 const std::vector<std::string>& keys,
+                 int depth,
+                 base::Value* value) {
+  if (depth > kMaxDepth)
+    return false;
+  uint8_t type;
+  if (!reader->ReadByte(&type))
+    return false;
+  switch (type) {
+    case kNull:
+      *value = base::Value();
+      return true;
+    case kFalse:
+    case kTrue:
+      *value = base::Value(type == kTrue);
+      return true;
+    case kInteger: {
+      int64_t integer;
+      if (!reader->ReadSignedVarint(&integer))
+        return false;
+      *value = base::Value(static_cast<int>(integer));
+      return true;
+    }
+    case kDouble: {
+      base::StringPiece bytes;
+      if (!reader->ReadBytes(sizeof(double), &bytes))
+        return false;
+      double number;
+      memcpy(&number, bytes.data(), sizeof(number));
+      *value = base::Value(number);
+      return true;
+    }
+    case kString: {
+      base::StringPiece string;
+      if (!reader->ReadString(&string))
+        return false;
+      *value = base::Value(string);
+      return true;
+    }
+    case kList: {
+      uint64_t count;
+      if (!reader->ReadVarint(&count))
+        return false;
+      base::Value list(base::Value::Type::LIST);
+      for (uint64_t i = 0; i < count; ++i) {
+        base::Value element;
+        if (!DecodeValue(reader, keys, depth + 1, &element))
+          return false;
+        list.GetList().push_back(std::move(element));
+      }
+      *value = std::move(list);
+      return true;
+    }
+    case kDictionary: {
+      uint64_t count;
+      if (!reader->ReadVarint(&count))
+        return false;
+      base::Value dict(base::Value::Type::DICTIONARY);
+      for (uint64_t i = 0; i < count; ++i) {
+        uint64_t key_index;
+        base::Value element;
+        if (!reader->ReadVarint(&key_index) || key_index >= keys.size() ||
+            !DecodeValue(reader, keys, depth + 1, &element)) {
+          return false;
+        }
+        dict.SetKey(keys[key_index], std::move(element));
+      }
+      *value = std::move(dict);
+      return true;
+    }
+    default:
+      return false;
+  }
+}
+
+// Decodes the payload of an 'E' record into the JSON written for the event by
+// FileNetLogObserver.
+bool DecodeEvent(base::StringPiece payload,
+                 const std::vector<std::string>& keys,
+                 std::string* json) {
+  Reader reader(payload);
+  int64_t time;
+  uint64_t type;
+  uint64_t source_type;
+  uint64_t source_id;
+  uint64_t phase;
+  uint8_t params_type;
+  if (!reader.ReadSignedVarint(&time) || !reader.ReadVarint(&type) ||
+      !reader.ReadVarint(&source_type) || !reader.ReadVarint(&source_id) ||
+      !reader.ReadVarint(&phase)) {
+    return false;
+  }
+
+  base::DictionaryValue event;
+  event.SetString("time", base::NumberToString(time));
+  auto source = std::make_unique<base::DictionaryValue>();
+  source->SetInteger("id", static_cast<int>(source_id));
+  source->SetInteger("type", static_cast<int>(source_type));
+  event.Set("source", std::move(source));
+  event.SetInteger("type", static_cast<int>(type));
+  event.SetInteger("phase", static_cast<int>(phase));
+
+  // DecodeValue() reads the type byte again.
+  Reader params_reader = reader;
+  if (!reader.ReadByte(&params_type))
+    return false;
+  if (params_type != kNoValue) {
+    base::Value params;
+    if (!DecodeValue(&params_reader, keys, 0, &params))
+      return false;
+    event.SetKey("params", std::move(params));
+  }
+
+  *json = SerializeNetLogValueToJson(event);
+  return true;
+}
+
+}  // namespace
+
+NetLogBinaryEncoder::NetLogBinaryEncoder() = default;
+
+NetLogBinaryEncoder::~NetLogBinaryEncoder() = default;
+
+std::string NetLogBinaryEncoder::EncodeEntry(const NetLogEntry& entry) {
+  std::string payload;
+  AppendSignedVarint(entry.time().since_origin().InMilliseconds(), &payload);
+  AppendVarint(static_cast<uint64_t>(entry.type()), &payload);
+  AppendVarint(static_cast<uint64_t>(entry.source().type), &payload);
+  AppendVarint(entry.source().id, &payload);
+  AppendVarint(static_cast<uint64_t>(entry.phase()), &payload);
+
+  std::unique_ptr<base::Value> params = entry.ParametersToValue();
+  if (params) {
+    EncodeValue(*params, &payload);
+  } else {
+    payload.push_back(kNoValue);
+  }
+  return MakeRecord(kEventTag, payload);
+}
+
+std::string NetLogBinaryEncoder::EncodeKeyTable() const {
+  std::string payload;
+  AppendVarint(keys_.size(), &payload);
+  for (const std::string* key : keys_)
+    AppendString(*key, &payload);
+  return MakeRecord(kKeyTableTag, payload);
+}
+
+// static
+std::string NetLogBinaryEncoder::EncodeHeader(const base::Value& constants) {
+  return std::string(kNetLogBinaryMagic, kNetLogBinaryMagicLength) +
+         MakeRecord(kConstantsTag, SerializeNetLogValueToJson(constants));
+}
+
+// static
+std::string NetLogBinaryEncoder::EncodePolledData(
+    const base::Value& polled_data) {
+  return MakeRecord(kPolledDataTag, ToJson(polled_data));
+}
+
+void NetLogBinaryEncoder::EncodeValue(const base::Value& value,
+                                      std::string* out) {
+  switch (value.type()) {
+    case base::Value::Type::BOOLEAN:
+      out->push_back(value.GetBool() ? kTrue : kFalse);
+      return;
+    case base::Value::Type::INTEGER:
+      out->push_back(kInteger);
+      AppendSignedVarint(value.GetInt(), out);
+      return;
+    case base::Value::Type::DOUBLE: {
+      double number = value.GetDouble();
+      out->push_back(kDouble);
+      out->append(reinterpret_cast<const char*>(&number), sizeof(number));
+      return;
+    }
+    case base::Value::Type::STRING:
+      out->push_back(kString);
+      AppendString(value.GetString(), out);
+      return;
+    case base::Value::Type::LIST:
+      out->push_back(kList);
+      AppendVarint(value.GetList().size(), out);
+      for (const base::Value& element : value.GetList())
+        EncodeValue(element, out);
+      return;
+    case base::Value::Type::DICTIONARY:
+      out->push_back(kDictionary);
+      AppendVarint(value.DictSize(), out);
+      for (const auto& item : value.DictItems()) {
+        AppendVarint(InternKey(item.first), out);
+        EncodeValue(item.second, out);
+      }
+      return;
+    case base::Value::Type::NONE:
+    case base::Value::Type::BINARY:
+      // Binary values can't be written to JSON either.
+      out->push_back(kNull);
+      return;
+  }
+  NOTREACHED();
+}
+
+size_t NetLogBinaryEncoder::InternKey(const std::string& key) {
+  auto result = key_ids_.emplace(key, keys_.size());
+  if (result.second)
+    keys_.push_back(&result.first->first);
+  return result.first->second;
+}
+
+bool ConvertBinaryNetLogToJson(base::StringPiece binary, std::string* json) {
+  if (!binary.starts_with(
+          base::StringPiece(kNetLogBinaryMagic, kNetLogBinaryMagicLength))) {
+    return false;
+  }
+  Reader reader(binary.substr(kNetLogBinaryMagicLength));
+
+  // The key table comes last, so find all the records before decoding events.
+  base::StringPiece constants;
+  base::StringPiece polled_data;
+  std::vector<base::StringPiece> events;
+  std::vector<std::string> keys;
+  while (!reader.empty()) {
+    uint8_t tag;
+    base::StringPiece payload;
+    if (!reader.ReadByte(&tag) || !reader.ReadString(&payload)) {
+      DLOG(WARNING) << "Truncated binary NetLog";
+      break;
+    }
+    switch (tag) {
+      case kConstantsTag:
+        constants = payload;
+        break;
+      case kEventTag:
+        events.push_back(payload);
+        break;
+      case kKeyTableTag: {
+        Reader key_reader(payload);
+        uint64_t count;
+        if (!key_reader.ReadVarint(&count))
+          break;
+        keys.clear();
+        base::StringPiece key;
+        for (uint64_t i = 0; i < count && key_reader.ReadString(&key); ++i)
+          keys.push_back(key.as_string());
+        break;
+      }
+      case kPolledDataTag:
+        polled_data = payload;
+        break;
+      default:
+        // Skip records added by later versions.
+        break;
+    }
+  }
+
+  json->clear();
+  json->append("{\"constants\":");
+  if (constants.empty()) {
+    json->append("{}");
+  } else {
+    constants.AppendToString(json);
+  }
+  json->append(",\n\"events\": [\n");
+  bool first_event = true;
+  std::string event_json;
+  for (base::StringPiece event : events) {
+    if (!DecodeEvent(event, keys, &event_json))
+      continue;
+    if (!first_event)
+      json->append(",\n");
+    json->append(event_json);
+    first_event = false;
+  }
+  json->append("]");
+  if (!polled_data.empty()) {
+    json->append(",\n\"polledData\": ");
+    polled_data.AppendToString(json);
+    json->append("\n");
+  }
+  json->append("}\n");
+  return true;
+}
+
+}  // namespace net
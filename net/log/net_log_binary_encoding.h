@@ -0,0 +1,87 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef NET_LOG_NET_LOG_BINARY_ENCODING_H_
+#define NET_LOG_NET_LOG_BINARY_ENCODING_H_
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "base/macros.h"
+#include "base/strings/string_piece.h"
+#include "net/base/net_export.h"
+
+namespace base {
+class Value;
+}  // namespace base
+
+namespace net {
+
+class NetLogEntry;
+
+// A compact binary encoding of NetLog files, much cheaper to write than JSON.
+// ConvertBinaryNetLogToJson() turns it back into the JSON format read by the
+// NetLog viewer.
+//
+// A binary NetLog is |kNetLogBinaryMagic| followed by records. Each record is
+// a tag byte, the varint length of its payload, then the payload:
+//
+//   'C'  The constants, as JSON.
+//   'E'  An event: its time, type, source type, source id and phase as
+//        varints, then its parameters encoded as described below.
+//   'K'  The table of interned dictionary keys: their count, then each key
+//        as a varint length and the key. Written when logging stops; keys are
+//        referred to by their index in the table.
+//   'P'  The polled data, as JSON.
+//
+// Values are a type byte followed by, for integers, a zigzag varint; for
+// doubles, 8 little-endian bytes; for strings, a varint length and the bytes;
+// for lists, the varint count then the values; and for dictionaries, the
+// varint count then each varint key index and value.
+NET_EXPORT extern const char kNetLogBinaryMagic[];
+NET_EXPORT extern const size_t kNetLogBinaryMagicLength;
+
+// Encodes NetLog events into records, interning the keys of their parameters.
+// Not thread safe; FileNetLogObserver relies on NetLog serializing calls to
+// its observers.
+class NET_EXPORT NetLogBinaryEncoder {
+ public:
+  NetLogBinaryEncoder();
+  ~NetLogBinaryEncoder();
+
+  // Returns the 'E' record for |entry|. Its parameters are still built as a
+  // base::Value by their callback, but encoding them skips the event envelope
+  // dictionary and all JSON formatting and escaping.
+  std::string EncodeEntry(const NetLogEntry& entry);
+
+  // Returns the 'K' record of the keys interned so far.
+  std::string EncodeKeyTable() const;
+
+  // Returns the file header followed by the 'C' record of |constants|.
+  static std::string EncodeHeader(const base::Value& constants);
+
+  // Returns the 'P' record of |polled_data|.
+  static std::string EncodePolledData(const base::Value& polled_data);
+
+ private:
+  void EncodeValue(const base::Value& value, std::string* out);
+  size_t InternKey(const std::string& key);
+
+  std::map<std::string, size_t> key_ids_;
+  std::vector<const std::string*> keys_;
+
+  DISALLOW_COPY_AND_ASSIGN(NetLogBinaryEncoder);
+};
+
+// Converts the binary NetLog |binary| to the JSON NetLog format written by
+// FileNetLogObserver, in |json|. Events that can't be decoded, for instance
+// because logging didn't stop cleanly and the key table is missing, are
+// skipped. Returns false if |binary| isn't a binary NetLog.
+NET_EXPORT bool ConvertBinaryNetLogToJson(base::StringPiece binary,
+                                          std::string* json);
+
+}  // namespace net
+
+#endif  // NET_LOG_NET_LOG_BINARY_ENCODING_H_
@@ -47,6 +47,7 @@ class NET_EXPORT NetLogEntry {
   NetLogEventType type() const { return data_->type; }
   NetLogSource source() const { return data_->source; }
   NetLogEventPhase phase() const { return data_->phase; }
+  base::TimeTicks time() const { return data_->time; }
 
   // Serializes the specified event to a Value.  The Value also includes the
   // current time.  Takes in a time to allow back-dating entries.
@@ -345,6 +345,11 @@ EVENT_TYPE(WAITING_FOR_PROXY_RESOLVER_THREAD)
 //   }
 EVENT_TYPE(SUBMITTED_TO_RESOLVER_THREAD)
 
+// This event is emitted when a proxy resolve request is answered from the
+// results cached for a PAC script whose results only depend on the host,
+// without running the script.
+EVENT_TYPE(PROXY_RESOLVER_RESULT_CACHE_HIT)
+
 // ------------------------------------------------------------------------
 // Socket (Shared by stream and datagram sockets)
 // ------------------------------------------------------------------------
@@ -1137,6 +1142,15 @@ EVENT_TYPE(HTTP_STREAM_JOB_RESUMED)
 //   }
 EVENT_TYPE(HTTP_STREAM_JOB_CONTROLLER)
 
+// Emitted when a stream is requested to an origin that
+// HttpStreamPreconnectPredictor preconnected to, or didn't, respectively.
+// The event parameters are:
+//   {
+//      "origin": <The origin of the request>,
+//   }
+EVENT_TYPE(HTTP_STREAM_PRECONNECT_PREDICTOR_HIT)
+EVENT_TYPE(HTTP_STREAM_PRECONNECT_PREDICTOR_MISS)
+
 // Links a JobController with its user (a URL_REQUEST).
 // The event parameters are:
 //   {
@@ -3163,3 +3177,35 @@ EVENT_TYPE(COOKIE_GET_BLOCKED_BY_NETWORK_DELEGATE)
 //  {
 //  }
 EVENT_TYPE(COOKIE_SET_BLOCKED_BY_NETWORK_DELEGATE)
+
+// -----------------------------------------------------------------------------
+// CORS-preflight cache persistence related events
+// -----------------------------------------------------------------------------
+
+// The start/end of restoring the persisted CORS-preflight cache. The END phase
+// contains the following parameters:
+//  {
+//    "restored_entries": <Number of unexpired entries that were restored>,
+//  }
+EVENT_TYPE(CORS_PREFLIGHT_CACHE_PREF_READ)
+
+// This event is created when the CORS-preflight cache contents are written to
+// prefs. It contains the following parameters:
+//  {
+//    "hits": <Number of requests that skipped a CORS-preflight so far>,
+//    "misses": <Number of requests that needed a CORS-preflight so far>,
+//  }
+EVENT_TYPE(CORS_PREFLIGHT_CACHE_PREF_WRITE)
+
+// -----------------------------------------------------------------------------
+// Reporting API related events
+// -----------------------------------------------------------------------------
+
+// This event is logged on the URLRequest that uploads a batch of reports, when
+// the payload is attached to it. It contains the following parameters:
+//  {
+//    "size": <Size of the serialized reports, in bytes>,
+//    "encoded_size": <Size of the request body as sent, in bytes>,
+//    "content_encoding": <Content-Encoding of the request body, if any>,
+//  }
+EVENT_TYPE(REPORTING_UPLOAD_PAYLOAD)
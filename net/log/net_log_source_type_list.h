@@ -41,3 +41,4 @@ SOURCE_TYPE(HTTP_SERVER_PROPERTIES)
 SOURCE_TYPE(HOST_CACHE_PERSISTENCE_MANAGER)
 SOURCE_TYPE(TRIAL_CERT_VERIFIER_JOB)
 SOURCE_TYPE(COOKIE_STORE)
+SOURCE_TYPE(CORS_PREFLIGHT_CACHE_PERSISTENCE_MANAGER)
@@ -27,6 +27,7 @@
 #include "base/time/default_tick_clock.h"
 #include "base/trace_event/trace_event.h"
 #include "build/build_config.h"
+#include "net/base/features.h"
 #include "net/base/host_port_pair.h"
 #include "net/base/load_flags.h"
 #include "net/base/load_timing_info.h"
@@ -205,6 +206,14 @@ NetworkQualityEstimator::NetworkQualityEstimator(
                  base::Unretained(this)),
       tick_clock_));
 
+  if (base::FeatureList::IsEnabled(features::kConnectionStats)) {
+    connection_stats_recorder_ = base::MakeRefCounted<ConnectionStatsRecorder>(
+        features::kConnectionStatsRecorderCapacity.Get(),
+        base::TimeDelta::FromMilliseconds(
+            features::kConnectionStatsSampleIntervalMs.Get()));
+    watcher_factory_->SetConnectionStatsRecorder(connection_stats_recorder_);
+  }
+
   GatherEstimatesForNextConnectionType();
 }
 
@@ -428,6 +437,13 @@ NetworkQualityEstimator::GetSocketPerformanceWatcherFactory() {
   return watcher_factory_.get();
 }
 
+scoped_refptr<ConnectionStatsRecorder>
+NetworkQualityEstimator::GetConnectionStatsRecorder() const {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+
+  return connection_stats_recorder_;
+}
+
 void NetworkQualityEstimator::SetUseLocalHostRequestsForTesting(
     bool use_localhost_requests) {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
@@ -203,6 +203,11 @@ class NET_EXPORT_PRIVATE NetworkQualityEstimator
 
   SocketPerformanceWatcherFactory* GetSocketPerformanceWatcherFactory();
 
+  // Returns the recorder of the recent stats snapshots of the connections
+  // watched through GetSocketPerformanceWatcherFactory(), or null unless the
+  // kConnectionStats feature is enabled. It can be read from any thread.
+  scoped_refptr<ConnectionStatsRecorder> GetConnectionStatsRecorder() const;
+
   // |use_localhost_requests| should only be true when testing against local
   // HTTP server and allows the requests to local host to be used for network
   // quality estimation.
@@ -569,6 +574,9 @@ class NET_EXPORT_PRIVATE NetworkQualityEstimator
 
   std::unique_ptr<nqe::internal::SocketWatcherFactory> watcher_factory_;
 
+  // Snapshots of the stats of the watched connections. May be null.
+  scoped_refptr<ConnectionStatsRecorder> connection_stats_recorder_;
+
   // Takes throughput measurements, and passes them back to |this| through the
   // provided callback. |this| stores the throughput observations in
   // |downstream_throughput_kbps_observations_|, which are later used for
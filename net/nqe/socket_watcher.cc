@@ -127,6 +127,30 @@ void SocketWatcher::OnConnectionChanged() {
   DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
 }
 
+bool SocketWatcher::ShouldNotifyConnectionStats() const {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+
+  if (!connection_stats_recorder_)
+    return false;
+  return tick_clock_->NowTicks() - last_connection_stats_notification_ >=
+         connection_stats_recorder_->min_sample_interval();
+}
+
+void SocketWatcher::OnConnectionStatsAvailable(const ConnectionStats& stats) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+
+  if (!connection_stats_recorder_)
+    return;
+  last_connection_stats_notification_ = tick_clock_->NowTicks();
+  connection_stats_recorder_->Record(stats);
+}
+
+void SocketWatcher::SetConnectionStatsRecorder(
+    scoped_refptr<ConnectionStatsRecorder> recorder) {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  connection_stats_recorder_ = std::move(recorder);
+}
+
 }  // namespace internal
 
 }  // namespace nqe
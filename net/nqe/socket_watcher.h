@@ -15,6 +15,7 @@
 #include "base/time/time.h"
 #include "net/base/net_export.h"
 #include "net/nqe/network_quality_estimator_util.h"
+#include "net/socket/connection_stats.h"
 #include "net/socket/socket_performance_watcher.h"
 #include "net/socket/socket_performance_watcher_factory.h"
 
@@ -73,6 +74,13 @@ class NET_EXPORT_PRIVATE SocketWatcher : public SocketPerformanceWatcher {
   bool ShouldNotifyUpdatedRTT() const override;
   void OnUpdatedRTTAvailable(const base::TimeDelta& rtt) override;
   void OnConnectionChanged() override;
+  bool ShouldNotifyConnectionStats() const override;
+  void OnConnectionStatsAvailable(const ConnectionStats& stats) override;
+
+  // Makes |this| record a snapshot of the watched connection's stats in
+  // |recorder| at most once per |recorder->min_sample_interval()|.
+  void SetConnectionStatsRecorder(
+      scoped_refptr<ConnectionStatsRecorder> recorder);
 
  private:
   // Transport layer protocol used by the socket that |this| is watching.
@@ -108,6 +116,12 @@ class NET_EXPORT_PRIVATE SocketWatcher : public SocketPerformanceWatcher {
   // A unique identifier for the remote host that this socket connects to.
   const base::Optional<IPHash> host_;
 
+  // Where connection stats snapshots are recorded. May be null.
+  scoped_refptr<ConnectionStatsRecorder> connection_stats_recorder_;
+
+  // Time when the last connection stats snapshot was recorded.
+  base::TimeTicks last_connection_stats_notification_;
+
   DISALLOW_COPY_AND_ASSIGN(SocketWatcher);
 };
 
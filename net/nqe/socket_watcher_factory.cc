@@ -34,11 +34,14 @@ std::unique_ptr<SocketPerformanceWatcher>
 SocketWatcherFactory::CreateSocketPerformanceWatcher(
     const Protocol protocol,
     const AddressList& address_list) {
-  return std::make_unique<SocketWatcher>(
+  auto watcher = std::make_unique<SocketWatcher>(
       protocol, address_list, min_notification_interval_,
       allow_rtt_private_address_, task_runner_,
       updated_rtt_observation_callback_, should_notify_rtt_callback_,
       tick_clock_);
+  if (connection_stats_recorder_)
+    watcher->SetConnectionStatsRecorder(connection_stats_recorder_);
+  return watcher;
 }
 
 void SocketWatcherFactory::SetTickClockForTesting(
@@ -46,6 +49,11 @@ void SocketWatcherFactory::SetTickClockForTesting(
   tick_clock_ = tick_clock;
 }
 
+void SocketWatcherFactory::SetConnectionStatsRecorder(
+    scoped_refptr<ConnectionStatsRecorder> recorder) {
+  connection_stats_recorder_ = std::move(recorder);
+}
+
 }  // namespace internal
 
 }  // namespace nqe
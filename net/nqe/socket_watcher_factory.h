@@ -15,6 +15,7 @@
 #include "base/single_thread_task_runner.h"
 #include "base/time/time.h"
 #include "net/nqe/network_quality_estimator_util.h"
+#include "net/socket/connection_stats.h"
 #include "net/socket/socket_performance_watcher.h"
 #include "net/socket/socket_performance_watcher_factory.h"
 
@@ -73,6 +74,11 @@ class SocketWatcherFactory : public SocketPerformanceWatcherFactory {
   // Overrides the tick clock used by |this| for testing.
   void SetTickClockForTesting(const base::TickClock* tick_clock);
 
+  // Makes the socket watchers created from now on record snapshots of their
+  // connection's stats in |recorder|.
+  void SetConnectionStatsRecorder(
+      scoped_refptr<ConnectionStatsRecorder> recorder);
+
  private:
   scoped_refptr<base::SingleThreadTaskRunner> task_runner_;
 
@@ -93,6 +99,9 @@ class SocketWatcherFactory : public SocketPerformanceWatcherFactory {
 
   const base::TickClock* tick_clock_;
 
+  // Passed to the socket watchers created by this factory. May be null.
+  scoped_refptr<ConnectionStatsRecorder> connection_stats_recorder_;
+
   DISALLOW_COPY_AND_ASSIGN(SocketWatcherFactory);
 };
 
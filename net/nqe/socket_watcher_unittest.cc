@@ -11,6 +11,7 @@
 #include "base/time/time.h"
 #include "net/base/address_list.h"
 #include "net/base/ip_address.h"
+#include "net/socket/connection_stats.h"
 #include "net/socket/socket_performance_watcher.h"
 #include "net/socket/socket_performance_watcher_factory.h"
 #include "net/test/test_with_scoped_task_environment.h"
@@ -261,6 +262,43 @@ TEST_F(NetworkQualitySocketWatcherTest, RemoteHostIPHashComputedCorrectly) {
   }
 }
 
+TEST_F(NetworkQualitySocketWatcherTest, ConnectionStatsThrottled) {
+  base::SimpleTestTickClock tick_clock;
+  tick_clock.SetNowTicks(base::TimeTicks::Now());
+
+  IPAddressList ip_list;
+  IPAddress ip_address;
+  ASSERT_TRUE(ip_address.AssignFromIPLiteral("157.0.0.1"));
+  ip_list.push_back(ip_address);
+  AddressList address_list =
+      AddressList::CreateFromIPAddressList(ip_list, "canonical.example.com");
+
+  SocketWatcher socket_watcher(
+      SocketPerformanceWatcherFactory::PROTOCOL_TCP, address_list,
+      base::TimeDelta::FromMilliseconds(2000), false,
+      base::ThreadTaskRunnerHandle::Get(), base::Bind(OnUpdatedRTTAvailable),
+      base::Bind(ShouldNotifyRTTCallback), &tick_clock);
+
+  // Stats aren't wanted without a recorder.
+  EXPECT_FALSE(socket_watcher.ShouldNotifyConnectionStats());
+
+  auto recorder = base::MakeRefCounted<ConnectionStatsRecorder>(
+      10, base::TimeDelta::FromSeconds(1));
+  socket_watcher.SetConnectionStatsRecorder(recorder);
+  EXPECT_TRUE(socket_watcher.ShouldNotifyConnectionStats());
+
+  ConnectionStats stats;
+  stats.smoothed_rtt = base::TimeDelta::FromMilliseconds(50);
+  socket_watcher.OnConnectionStatsAvailable(stats);
+  EXPECT_EQ(1u, recorder->num_recorded());
+  EXPECT_FALSE(socket_watcher.ShouldNotifyConnectionStats());
+
+  tick_clock.Advance(base::TimeDelta::FromMilliseconds(999));
+  EXPECT_FALSE(socket_watcher.ShouldNotifyConnectionStats());
+  tick_clock.Advance(base::TimeDelta::FromMilliseconds(1));
+  EXPECT_TRUE(socket_watcher.ShouldNotifyConnectionStats());
+}
+
 }  // namespace
 
 }  // namespace internal
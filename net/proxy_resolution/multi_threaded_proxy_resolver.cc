@@ -4,6 +4,8 @@
 
 #include "net/proxy_resolution/multi_threaded_proxy_resolver.h"
 
+#include <algorithm>
+#include <string>
 #include <utility>
 #include <vector>
 
@@ -11,21 +13,30 @@
 #include "base/bind_helpers.h"
 #include "base/callback_helpers.h"
 #include "base/containers/circular_deque.h"
+#include "base/containers/mru_cache.h"
+#include "base/feature_list.h"
 #include "base/location.h"
 #include "base/single_thread_task_runner.h"
 #include "base/stl_util.h"
+#include "base/strings/string_piece.h"
+#include "base/strings/string_split.h"
 #include "base/strings/string_util.h"
 #include "base/strings/stringprintf.h"
+#include "base/strings/utf_string_conversions.h"
 #include "base/threading/thread.h"
 #include "base/threading/thread_checker.h"
 #include "base/threading/thread_restrictions.h"
 #include "base/threading/thread_task_runner_handle.h"
+#include "base/time/time.h"
+#include "net/base/features.h"
 #include "net/base/net_errors.h"
 #include "net/log/net_log.h"
 #include "net/log/net_log_event_type.h"
 #include "net/log/net_log_with_source.h"
 #include "net/proxy_resolution/proxy_info.h"
+#include "net/proxy_resolution/pac_file_data.h"
 #include "net/proxy_resolution/proxy_resolver.h"
+#include "url/gurl.h"
 
 namespace net {
 
@@ -36,6 +47,72 @@ class MultiThreadedProxyResolverScopedAllowJoinOnIO
 namespace {
 class Job;
 
+// The maximum number of hosts whose results are cached for a host-only script.
+const size_t kMaxCachedResults = 256;
+
+bool IsIdentifierChar(char c) {
+  return base::IsAsciiAlpha(c) || base::IsAsciiDigit(c) || c == '_' ||
+         c == '$';
+}
+
+// Returns the number of times |identifier| appears in |script| as a whole
+// token. Strings and comments are not skipped, which only overcounts.
+size_t CountIdentifier(base::StringPiece script, base::StringPiece identifier) {
+  size_t count = 0;
+  for (size_t pos = script.find(identifier); pos != base::StringPiece::npos;
+       pos = script.find(identifier, pos + identifier.size())) {
+    size_t end = pos + identifier.size();
+    if ((pos == 0 || !IsIdentifierChar(script[pos - 1])) &&
+        (end == script.size() || !IsIdentifierChar(script[end]))) {
+      ++count;
+    }
+  }
+  return count;
+}
+
+// Returns true if |script_data| is a PAC script whose FindProxyForURL() never
+// reads its |url| argument, so that its results only depend on the host (and
+// on DNS, which the cache's TTL bounds). This is deliberately conservative:
+// scripts that mention the argument anywhere else, could reach it indirectly,
+// or depend on the time are not host-only.
+bool IsHostOnlyPacScript(const PacFileData& script_data) {
+  if (script_data.type() != PacFileData::TYPE_SCRIPT_CONTENTS)
+    return false;
+  std::string script = base::UTF16ToUTF8(script_data.utf16());
+
+  for (const char* identifier :
+       {"FindProxyForURLEx", "arguments", "eval", "Function", "Date",
+        "dateRange", "timeRange", "weekdayRange"}) {
+    if (CountIdentifier(script, identifier))
+      return false;
+  }
+
+  // Expect the only mention of FindProxyForURL to be its definition, and find
+  // the name of its first parameter.
+  if (CountIdentifier(script, "FindProxyForURL") != 1)
+    return false;
+  size_t params_begin = script.find('(', script.find("FindProxyForURL"));
+  if (params_begin == std::string::npos)
+    return false;
+  size_t params_end = script.find(')', params_begin);
+  if (params_end == std::string::npos)
+    return false;
+  std::vector<std::string> params = base::SplitString(
+      base::StringPiece(script).substr(params_begin + 1,
+                                       params_end - params_begin - 1),
+      ",", base::TRIM_WHITESPACE, base::SPLIT_WANT_ALL);
+  if (params.size() != 2 || params[0].empty() ||
+      !std::all_of(params[0].begin(), params[0].end(), &IsIdentifierChar)) {
+    return false;
+  }
+  return CountIdentifier(script, params[0]) == 1;
+}
+
+// Returns the key that results of host-only scripts are cached with.
+std::string GetResultCacheKey(const GURL& url) {
+  return url.scheme() + "://" + url.host();
+}
+
 // An "executor" is a job-runner for PAC requests. It encapsulates a worker
 // thread and a synchronous ProxyResolver (which will be operated on said
 // thread.)
@@ -145,12 +222,30 @@ class MultiThreadedProxyResolver : public ProxyResolver,
   // Starts the next job from |pending_jobs_| if possible.
   void OnExecutorReady(Executor* executor) override;
 
+  // Sets |results| to the unexpired cached result for |url|'s scheme and host,
+  // if any. Returns false otherwise.
+  bool GetCachedResult(const GURL& url, ProxyInfo* results);
+
+  // Caches |results| of a successful query for |url|, if the script is
+  // host-only.
+  void CacheResult(const GURL& url, const ProxyInfo& results);
+
   const std::unique_ptr<ProxyResolverFactory> resolver_factory_;
   const size_t max_num_threads_;
   PendingJobsQueue pending_jobs_;
   ExecutorList executors_;
   scoped_refptr<PacFileData> script_data_;
 
+  struct CachedResult {
+    ProxyInfo results;
+    base::TimeTicks expiration;
+  };
+
+  // Results of a host-only script, keyed by scheme and host. Null unless the
+  // script is host-only and features::kPacResultCache is enabled.
+  std::unique_ptr<base::MRUCache<std::string, CachedResult>> result_cache_;
+  base::TimeDelta result_cache_ttl_;
+
   THREAD_CHECKER(thread_checker_);
 };
 
@@ -266,13 +361,17 @@ class CreateResolverJob : public Job {
 
 class MultiThreadedProxyResolver::GetProxyForURLJob : public Job {
  public:
+  // |resolver|    -- the resolver that started the query, which outlives it
+  //                  unless it is cancelled.
   // |url|         -- the URL of the query.
   // |results|     -- the structure to fill with proxy resolve results.
-  GetProxyForURLJob(const GURL& url,
+  GetProxyForURLJob(MultiThreadedProxyResolver* resolver,
+                    const GURL& url,
                     ProxyInfo* results,
                     CompletionOnceCallback callback,
                     const NetLogWithSource& net_log)
-      : callback_(std::move(callback)),
+      : resolver_(resolver),
+        callback_(std::move(callback)),
         results_(results),
         net_log_(net_log),
         url_(url),
@@ -322,11 +421,14 @@ class MultiThreadedProxyResolver::GetProxyForURLJob : public Job {
       if (result_code >= OK) {  // Note: unit-tests use values > 0.
         results_->Use(results_buf_);
       }
+      if (result_code == OK)
+        resolver_->CacheResult(url_, results_buf_);
       std::move(callback_).Run(result_code);
     }
     OnJobCompleted();
   }
 
+  MultiThreadedProxyResolver* const resolver_;
   CompletionOnceCallback callback_;
 
   // Must only be used on the "origin" thread.
@@ -422,6 +524,15 @@ MultiThreadedProxyResolver::MultiThreadedProxyResolver(
   DCHECK(script_data_);
   executor->set_coordinator(this);
   executors_.push_back(executor);
+
+  if (base::FeatureList::IsEnabled(features::kPacResultCache) &&
+      IsHostOnlyPacScript(*script_data_)) {
+    result_cache_ =
+        std::make_unique<base::MRUCache<std::string, CachedResult>>(
+            kMaxCachedResults);
+    result_cache_ttl_ = base::TimeDelta::FromSeconds(
+        features::kPacResultCacheTtlSeconds.Get());
+  }
 }
 
 MultiThreadedProxyResolver::~MultiThreadedProxyResolver() {
@@ -443,8 +554,13 @@ int MultiThreadedProxyResolver::GetProxyForURL(
   DCHECK_CALLED_ON_VALID_THREAD(thread_checker_);
   DCHECK(!callback.is_null());
 
-  scoped_refptr<GetProxyForURLJob> job(
-      new GetProxyForURLJob(url, results, std::move(callback), net_log));
+  if (GetCachedResult(url, results)) {
+    net_log.AddEvent(NetLogEventType::PROXY_RESOLVER_RESULT_CACHE_HIT);
+    return OK;
+  }
+
+  scoped_refptr<GetProxyForURLJob> job(new GetProxyForURLJob(
+      this, url, results, std::move(callback), net_log));
 
   // Completion will be notified through |callback|, unless the caller cancels
   // the request using |request|.
@@ -505,6 +621,33 @@ void MultiThreadedProxyResolver::OnExecutorReady(Executor* executor) {
   }
 }
 
+bool MultiThreadedProxyResolver::GetCachedResult(const GURL& url,
+                                                 ProxyInfo* results) {
+  DCHECK_CALLED_ON_VALID_THREAD(thread_checker_);
+  if (!result_cache_)
+    return false;
+  auto it = result_cache_->Get(GetResultCacheKey(url));
+  if (it == result_cache_->end())
+    return false;
+  if (it->second.expiration <= base::TimeTicks::Now()) {
+    result_cache_->Erase(it);
+    return false;
+  }
+  results->Use(it->second.results);
+  return true;
+}
+
+void MultiThreadedProxyResolver::CacheResult(const GURL& url,
+                                             const ProxyInfo& results) {
+  DCHECK_CALLED_ON_VALID_THREAD(thread_checker_);
+  if (!result_cache_)
+    return;
+  CachedResult cached_result;
+  cached_result.results.Use(results);
+  cached_result.expiration = base::TimeTicks::Now() + result_cache_ttl_;
+  result_cache_->Put(GetResultCacheKey(url), std::move(cached_result));
+}
+
 }  // namespace
 
 class MultiThreadedProxyResolverFactory::Job
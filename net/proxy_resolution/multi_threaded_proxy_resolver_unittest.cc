@@ -15,8 +15,10 @@
 #include "base/strings/utf_string_conversions.h"
 #include "base/synchronization/condition_variable.h"
 #include "base/synchronization/lock.h"
+#include "base/test/scoped_feature_list.h"
 #include "base/threading/platform_thread.h"
 #include "base/threading/thread_checker_impl.h"
+#include "net/base/features.h"
 #include "net/base/net_errors.h"
 #include "net/base/test_completion_callback.h"
 #include "net/log/net_log_event_type.h"
@@ -213,7 +215,8 @@ class SingleShotMultiThreadedProxyResolverFactory
 
 class MultiThreadedProxyResolverTest : public TestWithScopedTaskEnvironment {
  public:
-  void Init(size_t num_threads) {
+  void Init(size_t num_threads,
+            const std::string& script = "pac script bytes") {
     std::unique_ptr<BlockableProxyResolverFactory> factory_owner(
         new BlockableProxyResolverFactory);
     factory_ = factory_owner.get();
@@ -222,15 +225,14 @@ class MultiThreadedProxyResolverTest : public TestWithScopedTaskEnvironment {
     TestCompletionCallback ready_callback;
     std::unique_ptr<ProxyResolverFactory::Request> request;
     resolver_factory_->CreateProxyResolver(
-        PacFileData::FromUTF8("pac script bytes"), &resolver_,
+        PacFileData::FromUTF8(script), &resolver_,
         ready_callback.callback(), &request);
     EXPECT_TRUE(request);
     ASSERT_THAT(ready_callback.WaitForResult(), IsOk());
 
     // Verify that the script data reaches the synchronous resolver factory.
     ASSERT_EQ(1u, factory_->script_data().size());
-    EXPECT_EQ(ASCIIToUTF16("pac script bytes"),
-              factory_->script_data()[0]->utf16());
+    EXPECT_EQ(ASCIIToUTF16(script), factory_->script_data()[0]->utf16());
   }
 
   void ClearResolver() { resolver_.reset(); }
@@ -796,6 +798,75 @@ TEST_F(MultiThreadedProxyResolverTest, DestroyFactoryWithRequestsInProgress) {
   base::RunLoop().RunUntilIdle();
 }
 
+// Tests that the results of a script that only looks at the host are cached
+// by scheme and host.
+TEST_F(MultiThreadedProxyResolverTest, CachesHostOnlyScriptResults) {
+  base::test::ScopedFeatureList feature_list;
+  feature_list.InitAndEnableFeature(features::kPacResultCache);
+  ASSERT_NO_FATAL_FAILURE(
+      Init(1u,
+           "function FindProxyForURL(url, host) {\n"
+           "  return isInNet(dnsResolve(host), \"10.0.0.0\", \"255.0.0.0\") ?\n"
+           "      \"DIRECT\" : \"PROXY proxy:8080\";\n"
+           "}\n"));
+
+  TestCompletionCallback callback0;
+  ProxyInfo results0;
+  int rv = resolver().GetProxyForURL(GURL("http://request0/a"), &results0,
+                                     callback0.callback(), nullptr,
+                                     NetLogWithSource());
+  EXPECT_THAT(rv, IsError(ERR_IO_PENDING));
+  EXPECT_THAT(callback0.WaitForResult(), IsOk());
+  EXPECT_EQ("PROXY request0:80", results0.ToPacString());
+
+  // Another path on the same host completes synchronously from the cache.
+  TestCompletionCallback callback1;
+  BoundTestNetLog log1;
+  ProxyInfo results1;
+  rv = resolver().GetProxyForURL(GURL("http://request0/b?c"), &results1,
+                                 callback1.callback(), nullptr, log1.bound());
+  EXPECT_THAT(rv, IsOk());
+  EXPECT_EQ("PROXY request0:80", results1.ToPacString());
+  TestNetLogEntry::List entries1;
+  log1.GetEntries(&entries1);
+  ASSERT_EQ(1u, entries1.size());
+  EXPECT_EQ(NetLogEventType::PROXY_RESOLVER_RESULT_CACHE_HIT,
+            entries1[0].type);
+
+  // Other schemes and hosts run the script.
+  TestCompletionCallback callback2;
+  ProxyInfo results2;
+  rv = resolver().GetProxyForURL(GURL("https://request0/a"), &results2,
+                                 callback2.callback(), nullptr,
+                                 NetLogWithSource());
+  EXPECT_THAT(rv, IsError(ERR_IO_PENDING));
+  EXPECT_EQ(1, callback2.WaitForResult());
+  ASSERT_EQ(1u, factory().resolvers().size());
+  EXPECT_EQ(2, factory().resolvers()[0]->request_count());
+}
+
+// Tests that the results of scripts that may look at the URL aren't cached.
+TEST_F(MultiThreadedProxyResolverTest, DoesNotCacheUrlDependentScriptResults) {
+  base::test::ScopedFeatureList feature_list;
+  feature_list.InitAndEnableFeature(features::kPacResultCache);
+  ASSERT_NO_FATAL_FAILURE(
+      Init(1u,
+           "function FindProxyForURL(url, host) {\n"
+           "  return shExpMatch(url, \"*/direct/*\") ?\n"
+           "      \"DIRECT\" : \"PROXY proxy:8080\";\n"
+           "}\n"));
+
+  for (int i = 0; i < 2; ++i) {
+    TestCompletionCallback callback;
+    ProxyInfo results;
+    int rv = resolver().GetProxyForURL(GURL("http://request0/a"), &results,
+                                       callback.callback(), nullptr,
+                                       NetLogWithSource());
+    EXPECT_THAT(rv, IsError(ERR_IO_PENDING));
+    EXPECT_EQ(i, callback.WaitForResult());
+  }
+}
+
 }  // namespace
 
 }  // namespace net
@@ -764,9 +764,10 @@ QuicChromiumClientSession::QuicChromiumClientSession(
   default_network_ = default_network;
   auto* socket_raw = socket.get();
   sockets_.push_back(std::move(socket));
+  packet_buffer_pool_ = QuicChromiumPacketReader::CreateBufferPool();
   packet_readers_.push_back(std::make_unique<QuicChromiumPacketReader>(
       sockets_.back().get(), clock, this, yield_after_packets,
-      yield_after_duration, net_log_));
+      yield_after_duration, net_log_, packet_buffer_pool_));
   crypto_stream_.reset(
       crypto_client_stream_factory->CreateQuicCryptoClientStream(
           session_key.server_id(), this,
@@ -1147,6 +1148,10 @@ bool QuicChromiumClientSession::GetRemoteEndpoint(IPEndPoint* endpoint) {
   return true;
 }
 
+void QuicChromiumClientSession::GetConnectionStats(ConnectionStats* stats) {
+  GetQuicConnectionStats(connection(), stats);
+}
+
 // TODO(rtenneti): Add unittests for GetSSLInfo which exercise the various ways
 // we learn about SSL info (sync vs async vs cached).
 bool QuicChromiumClientSession::GetSSLInfo(SSLInfo* ssl_info) const {
@@ -2507,7 +2512,7 @@ ProbingResult QuicChromiumClientSession::StartProbeNetwork(
   std::unique_ptr<QuicChromiumPacketReader> probing_reader(
       new QuicChromiumPacketReader(probing_socket.get(), clock_, this,
                                    yield_after_packets_, yield_after_duration_,
-                                   net_log_));
+                                   net_log_, packet_buffer_pool_));
 
   int rtt_ms = connection()
                    ->sent_packet_manager()
@@ -2910,7 +2915,7 @@ MigrationResult QuicChromiumClientSession::Migrate(
   std::unique_ptr<QuicChromiumPacketReader> new_reader(
       new QuicChromiumPacketReader(socket.get(), clock_, this,
                                    yield_after_packets_, yield_after_duration_,
-                                   net_log_));
+                                   net_log_, packet_buffer_pool_));
   new_reader->StartReading();
   std::unique_ptr<QuicChromiumPacketWriter> new_writer(
       new QuicChromiumPacketWriter(socket.get(), task_runner_));
@@ -3082,7 +3087,8 @@ size_t QuicChromiumClientSession::EstimateMemoryUsage() const {
   // TODO(xunjieli): Estimate |crypto_stream_|, quic::QuicSpdySession's
   // quic::QuicHeaderList, quic::QuicSession's QuiCWriteBlockedList, open
   // streams and unacked packet map.
-  return base::trace_event::EstimateMemoryUsage(packet_readers_);
+  return base::trace_event::EstimateMemoryUsage(packet_readers_) +
+         packet_buffer_pool_->EstimateMemoryUsage();
 }
 
 }  // namespace net
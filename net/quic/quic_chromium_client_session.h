@@ -521,6 +521,10 @@ class NET_EXPORT_PRIVATE QuicChromiumClientSession
   // and passing the data along to the quic::QuicConnection.
   void StartReading();
 
+  // Fills |stats| with a snapshot of the state of the QUIC connection, such as
+  // its RTT, congestion window, bandwidth estimate and losses.
+  void GetConnectionStats(ConnectionStats* stats);
+
   // Close the session because of |net_error| and notifies the factory
   // that this session has been closed, which will delete the session.
   // |behavior| will suggest whether we should send connection close packets
@@ -796,6 +800,9 @@ class NET_EXPORT_PRIVATE QuicChromiumClientSession
   size_t num_total_streams_;
   base::SequencedTaskRunner* task_runner_;
   NetLogWithSource net_log_;
+  // Shared by |packet_readers_|, so that the readers of a migration or a
+  // probe reuse the buffers of the previous ones.
+  scoped_refptr<QuicChromiumPacketBufferPool> packet_buffer_pool_;
   std::vector<std::unique_ptr<QuicChromiumPacketReader>> packet_readers_;
   LoadTimingInfo::ConnectTiming connect_timing_;
   std::unique_ptr<QuicConnectionLogger> logger_;
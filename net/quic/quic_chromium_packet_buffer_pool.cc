@@ -0,0 +1,57 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "net/quic/quic_chromium_packet_buffer_pool.h"
+
+#include <utility>
+
+#include "base/logging.h"
+
+namespace net {
+
+QuicChromiumPacketBufferPool::QuicChromiumPacketBufferPool(
+    size_t buffer_size,
+    size_t max_free_buffers)
+    : buffer_size_(buffer_size), max_free_buffers_(max_free_buffers) {
+  DCHECK_GT(buffer_size_, 0u);
+}
+
+QuicChromiumPacketBufferPool::~QuicChromiumPacketBufferPool() = default;
+
+scoped_refptr<QuicChromiumPacketBuffer>
+QuicChromiumPacketBufferPool::Acquire() {
+  std::unique_ptr<char[]> storage;
+  if (free_buffers_.empty()) {
+    storage.reset(new char[buffer_size_]);
+  } else {
+    storage = std::move(free_buffers_.back());
+    free_buffers_.pop_back();
+  }
+  return base::WrapRefCounted(
+      new QuicChromiumPacketBuffer(this, std::move(storage)));
+}
+
+size_t QuicChromiumPacketBufferPool::EstimateMemoryUsage() const {
+  return free_buffers_.size() * buffer_size_;
+}
+
+void QuicChromiumPacketBufferPool::ReturnStorage(
+    std::unique_ptr<char[]> storage) {
+  if (free_buffers_.size() < max_free_buffers_)
+    free_buffers_.push_back(std::move(storage));
+}
+
+QuicChromiumPacketBuffer::QuicChromiumPacketBuffer(
+    scoped_refptr<QuicChromiumPacketBufferPool> pool,
+    std::unique_ptr<char[]> storage)
+    : IOBufferWithSize(storage.release(), pool->buffer_size()),
+      pool_(std::move(pool)) {}
+
+QuicChromiumPacketBuffer::~QuicChromiumPacketBuffer() {
+  pool_->ReturnStorage(std::unique_ptr<char[]>(data_));
+  // The storage is owned by the pool now.
+  data_ = nullptr;
+}
+
+}  // namespace net
@@ -0,0 +1,78 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef NET_QUIC_QUIC_CHROMIUM_PACKET_BUFFER_POOL_H_
+#define NET_QUIC_QUIC_CHROMIUM_PACKET_BUFFER_POOL_H_
+
+#include <stddef.h>
+
+#include <memory>
+#include <vector>
+
+#include "base/macros.h"
+#include "base/memory/ref_counted.h"
+#include "net/base/io_buffer.h"
+#include "net/base/net_export.h"
+
+namespace net {
+
+class QuicChromiumPacketBuffer;
+
+// Hands out the fixed-size buffers that QuicChromiumPacketReader reads packets
+// into, and keeps the storage of released ones for reuse. Buffers keep their
+// pool alive. The pool and its buffers must be used on a single sequence.
+class NET_EXPORT_PRIVATE QuicChromiumPacketBufferPool
+    : public base::RefCounted<QuicChromiumPacketBufferPool> {
+ public:
+  // Buffers are |buffer_size| bytes long. At most |max_free_buffers| released
+  // buffers are kept.
+  QuicChromiumPacketBufferPool(size_t buffer_size, size_t max_free_buffers);
+
+  // Returns a buffer of buffer_size() bytes, reusing released storage if any.
+  // Its contents are not initialized.
+  scoped_refptr<QuicChromiumPacketBuffer> Acquire();
+
+  size_t buffer_size() const { return buffer_size_; }
+  size_t free_buffer_count() const { return free_buffers_.size(); }
+
+  // Returns the estimate of dynamically allocated memory in bytes, not
+  // counting the buffers in use.
+  size_t EstimateMemoryUsage() const;
+
+ private:
+  friend class base::RefCounted<QuicChromiumPacketBufferPool>;
+  friend class QuicChromiumPacketBuffer;
+
+  ~QuicChromiumPacketBufferPool();
+
+  // Called when the last reference to a buffer using |storage| goes away.
+  void ReturnStorage(std::unique_ptr<char[]> storage);
+
+  const size_t buffer_size_;
+  const size_t max_free_buffers_;
+  std::vector<std::unique_ptr<char[]>> free_buffers_;
+
+  DISALLOW_COPY_AND_ASSIGN(QuicChromiumPacketBufferPool);
+};
+
+// A buffer from a QuicChromiumPacketBufferPool. Received packets stay in it
+// until the last reference is released, so code that needs packet data after
+// it has been processed can keep a reference to the buffer rather than copy
+// the data.
+class NET_EXPORT_PRIVATE QuicChromiumPacketBuffer : public IOBufferWithSize {
+ private:
+  friend class QuicChromiumPacketBufferPool;
+
+  QuicChromiumPacketBuffer(scoped_refptr<QuicChromiumPacketBufferPool> pool,
+                           std::unique_ptr<char[]> storage);
+  ~QuicChromiumPacketBuffer() override;
+
+  scoped_refptr<QuicChromiumPacketBufferPool> pool_;
+
+  DISALLOW_COPY_AND_ASSIGN(QuicChromiumPacketBuffer);
+};
+
+}  // namespace net
+
+#endif  // NET_QUIC_QUIC_CHROMIUM_PACKET_BUFFER_POOL_H_
@@ -0,0 +1,53 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "net/quic/quic_chromium_packet_buffer_pool.h"
+
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace net {
+namespace test {
+namespace {
+
+const size_t kBufferSize = 1350;
+
+TEST(QuicChromiumPacketBufferPoolTest, ReusesReleasedStorage) {
+  auto pool = base::MakeRefCounted<QuicChromiumPacketBufferPool>(
+      kBufferSize, 1 /* max_free_buffers */);
+  scoped_refptr<QuicChromiumPacketBuffer> buffer1 = pool->Acquire();
+  scoped_refptr<QuicChromiumPacketBuffer> buffer2 = pool->Acquire();
+  EXPECT_EQ(static_cast<int>(kBufferSize), buffer1->size());
+  EXPECT_NE(buffer1->data(), buffer2->data());
+  EXPECT_EQ(0u, pool->free_buffer_count());
+
+  char* data1 = buffer1->data();
+  buffer1 = nullptr;
+  EXPECT_EQ(1u, pool->free_buffer_count());
+  EXPECT_EQ(kBufferSize, pool->EstimateMemoryUsage());
+
+  // Only one released buffer is kept.
+  buffer2 = nullptr;
+  EXPECT_EQ(1u, pool->free_buffer_count());
+
+  buffer1 = pool->Acquire();
+  EXPECT_EQ(data1, buffer1->data());
+  EXPECT_EQ(0u, pool->free_buffer_count());
+}
+
+TEST(QuicChromiumPacketBufferPoolTest, BufferOutlivesPoolReference) {
+  auto pool = base::MakeRefCounted<QuicChromiumPacketBufferPool>(
+      kBufferSize, 4 /* max_free_buffers */);
+  scoped_refptr<QuicChromiumPacketBuffer> buffer = pool->Acquire();
+  QuicChromiumPacketBufferPool* raw_pool = pool.get();
+  pool = nullptr;
+
+  // |buffer| keeps the pool alive.
+  buffer->data()[kBufferSize - 1] = 'a';
+  EXPECT_EQ(0u, raw_pool->free_buffer_count());
+  buffer = nullptr;
+}
+
+}  // namespace
+}  // namespace test
+}  // namespace net
@@ -4,16 +4,29 @@
 
 #include "net/quic/quic_chromium_packet_reader.h"
 
+#include <utility>
+
 #include "base/bind.h"
+#include "base/feature_list.h"
 #include "base/location.h"
 #include "base/metrics/histogram_macros.h"
 #include "base/single_thread_task_runner.h"
 #include "base/threading/thread_task_runner_handle.h"
+#include "net/base/features.h"
 #include "net/base/net_errors.h"
 #include "net/third_party/quiche/src/quic/platform/api/quic_clock.h"
 
 namespace net {
 
+namespace {
+
+// Released buffers kept by the pool of CreateBufferPool(), enough for a
+// reader whose current buffer is retained by its visitor, and the readers
+// created during a connection migration.
+const size_t kMaxFreeReadBuffers = 2;
+
+}  // namespace
+
 QuicChromiumPacketReader::QuicChromiumPacketReader(
     DatagramClientSocket* socket,
     quic::QuicClock* clock,
@@ -21,6 +34,22 @@ QuicChromiumPacketReader::QuicChromiumPacketReader(
     int yield_after_packets,
     quic::QuicTime::Delta yield_after_duration,
     const NetLogWithSource& net_log)
+    : QuicChromiumPacketReader(socket,
+                               clock,
+                               visitor,
+                               yield_after_packets,
+                               yield_after_duration,
+                               net_log,
+                               CreateBufferPool()) {}
+
+QuicChromiumPacketReader::QuicChromiumPacketReader(
+    DatagramClientSocket* socket,
+    quic::QuicClock* clock,
+    Visitor* visitor,
+    int yield_after_packets,
+    quic::QuicTime::Delta yield_after_duration,
+    const NetLogWithSource& net_log,
+    scoped_refptr<QuicChromiumPacketBufferPool> buffer_pool)
     : socket_(socket),
       visitor_(visitor),
       read_pending_(false),
@@ -29,13 +58,28 @@ QuicChromiumPacketReader::QuicChromiumPacketReader(
       yield_after_packets_(yield_after_packets),
       yield_after_duration_(yield_after_duration),
       yield_after_(quic::QuicTime::Infinite()),
-      read_buffer_(base::MakeRefCounted<IOBufferWithSize>(
-          static_cast<size_t>(quic::kMaxOutgoingPacketSize))),
+      read_multiple_(buffer_pool->buffer_size() >=
+                     static_cast<size_t>(quic::kMaxOutgoingPacketSize) *
+                         kQuicReadBatchSize),
+      buffer_pool_(std::move(buffer_pool)),
+      read_buffer_(buffer_pool_->Acquire()),
       net_log_(net_log),
       weak_factory_(this) {}
 
 QuicChromiumPacketReader::~QuicChromiumPacketReader() {}
 
+// static
+scoped_refptr<QuicChromiumPacketBufferPool>
+QuicChromiumPacketReader::CreateBufferPool() {
+  size_t packets =
+      base::FeatureList::IsEnabled(features::kQuicBatchedUdpIo)
+          ? kQuicReadBatchSize
+          : 1;
+  return base::MakeRefCounted<QuicChromiumPacketBufferPool>(
+      static_cast<size_t>(quic::kMaxOutgoingPacketSize) * packets,
+      kMaxFreeReadBuffers);
+}
+
 void QuicChromiumPacketReader::StartReading() {
   for (;;) {
     if (read_pending_)
@@ -45,18 +89,37 @@ void QuicChromiumPacketReader::StartReading() {
       yield_after_ = clock_->Now() + yield_after_duration_;
 
     DCHECK(socket_);
+    // Leave the packets in the buffer to whoever still references it.
+    if (!read_buffer_->HasOneRef())
+      read_buffer_ = buffer_pool_->Acquire();
     read_pending_ = true;
-    int rv =
-        socket_->Read(read_buffer_.get(), read_buffer_->size(),
-                      base::BindOnce(&QuicChromiumPacketReader::OnReadComplete,
-                                     weak_factory_.GetWeakPtr()));
+    int rv;
+    if (read_multiple_) {
+      rv = socket_->ReadMultiple(
+          read_buffer_.get(), quic::kMaxOutgoingPacketSize, kQuicReadBatchSize,
+          &packet_lengths_,
+          base::BindOnce(&QuicChromiumPacketReader::OnReadComplete,
+                         weak_factory_.GetWeakPtr()));
+      if (rv == ERR_NOT_IMPLEMENTED) {
+        // Keep reading into the same buffers, one packet at a time.
+        read_multiple_ = false;
+        read_pending_ = false;
+        continue;
+      }
+    } else {
+      rv = socket_->Read(
+          read_buffer_.get(), quic::kMaxOutgoingPacketSize,
+          base::BindOnce(&QuicChromiumPacketReader::OnReadComplete,
+                         weak_factory_.GetWeakPtr()));
+    }
     UMA_HISTOGRAM_BOOLEAN("Net.QuicSession.AsyncRead", rv == ERR_IO_PENDING);
     if (rv == ERR_IO_PENDING) {
       num_packets_read_ = 0;
       return;
     }
 
-    if (++num_packets_read_ > yield_after_packets_ ||
+    num_packets_read_ += read_multiple_ && rv > 0 ? rv : 1;
+    if (num_packets_read_ > yield_after_packets_ ||
         clock_->Now() > yield_after_) {
       num_packets_read_ = 0;
       // Data was read, process it.
@@ -75,11 +138,25 @@ void QuicChromiumPacketReader::StartReading() {
 
 size_t QuicChromiumPacketReader::EstimateMemoryUsage() const {
   // Return the size of |read_buffer_|.
-  return quic::kMaxOutgoingPacketSize;
+  return read_buffer_->size();
 }
 
 bool QuicChromiumPacketReader::ProcessReadResult(int result) {
   read_pending_ = false;
+  if (!read_multiple_ || result <= 0)
+    return ProcessPacket(read_buffer_->data(), result);
+
+  DCHECK_EQ(static_cast<size_t>(result), packet_lengths_.size());
+  for (int i = 0; i < result; ++i) {
+    if (!ProcessPacket(read_buffer_->data() + i * quic::kMaxOutgoingPacketSize,
+                       packet_lengths_[i])) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool QuicChromiumPacketReader::ProcessPacket(const char* data, int result) {
   if (result == 0)
     result = ERR_CONNECTION_CLOSED;
 
@@ -88,7 +165,7 @@ bool QuicChromiumPacketReader::ProcessReadResult(int result) {
     return false;
   }
 
-  quic::QuicReceivedPacket packet(read_buffer_->data(), result, clock_->Now());
+  quic::QuicReceivedPacket packet(data, result, clock_->Now());
   IPEndPoint local_address;
   IPEndPoint peer_address;
   socket_->GetLocalAddress(&local_address);
@@ -6,11 +6,14 @@
 #ifndef NET_QUIC_QUIC_CHROMIUM_PACKET_READER_H_
 #define NET_QUIC_QUIC_CHROMIUM_PACKET_READER_H_
 
+#include <vector>
+
 #include "base/macros.h"
 #include "base/memory/weak_ptr.h"
 #include "net/base/io_buffer.h"
 #include "net/base/net_export.h"
 #include "net/log/net_log_with_source.h"
+#include "net/quic/quic_chromium_packet_buffer_pool.h"
 #include "net/socket/datagram_client_socket.h"
 #include "net/third_party/quiche/src/quic/core/quic_packets.h"
 #include "net/third_party/quiche/src/quic/core/quic_time.h"
@@ -26,6 +29,10 @@ namespace net {
 const int kQuicYieldAfterPacketsRead = 32;
 const int kQuicYieldAfterDurationMilliseconds = 2;
 
+// Maximum number of packets read from the socket at once when
+// features::kQuicBatchedUdpIo is enabled.
+const int kQuicReadBatchSize = 16;
+
 class NET_EXPORT_PRIVATE QuicChromiumPacketReader {
  public:
   class NET_EXPORT_PRIVATE Visitor {
@@ -44,12 +51,33 @@ class NET_EXPORT_PRIVATE QuicChromiumPacketReader {
                            int yield_after_packets,
                            quic::QuicTime::Delta yield_after_duration,
                            const NetLogWithSource& net_log);
+  // Reads into buffers from |buffer_pool|, which may be shared with other
+  // readers on the same sequence. It must come from CreateBufferPool().
+  QuicChromiumPacketReader(
+      DatagramClientSocket* socket,
+      quic::QuicClock* clock,
+      Visitor* visitor,
+      int yield_after_packets,
+      quic::QuicTime::Delta yield_after_duration,
+      const NetLogWithSource& net_log,
+      scoped_refptr<QuicChromiumPacketBufferPool> buffer_pool);
   virtual ~QuicChromiumPacketReader();
 
+  // Returns a pool of buffers suitable for readers.
+  static scoped_refptr<QuicChromiumPacketBufferPool> CreateBufferPool();
+
   // Causes the QuicConnectionHelper to start reading from the socket
   // and passing the data along to the quic::QuicConnection.
   void StartReading();
 
+  // Returns the buffer holding the packet passed to Visitor::OnPacket(), and
+  // possibly the other packets read with it. A visitor that needs the packet
+  // data after OnPacket() returns can keep a reference to the buffer instead
+  // of copying the data, the next packets are then read into another buffer.
+  QuicChromiumPacketBuffer* current_buffer() const {
+    return read_buffer_.get();
+  }
+
   // Returns the estimate of dynamically allocated memory in bytes.
   size_t EstimateMemoryUsage() const;
 
@@ -58,6 +86,9 @@ class NET_EXPORT_PRIVATE QuicChromiumPacketReader {
   void OnReadComplete(int result);
   // Return true if reading should continue.
   bool ProcessReadResult(int result);
+  // Passes a packet of |result| bytes at |data|, or the read error |result|,
+  // to the visitor. Returns true if reading should continue.
+  bool ProcessPacket(const char* data, int result);
 
   DatagramClientSocket* socket_;
   Visitor* visitor_;
@@ -67,7 +98,12 @@ class NET_EXPORT_PRIVATE QuicChromiumPacketReader {
   int yield_after_packets_;
   quic::QuicTime::Delta yield_after_duration_;
   quic::QuicTime yield_after_;
-  scoped_refptr<IOBufferWithSize> read_buffer_;
+  // True if |socket_| supports ReadMultiple(), in which case |read_buffer_|
+  // holds kQuicReadBatchSize packets whose sizes are in |packet_lengths_|.
+  bool read_multiple_;
+  scoped_refptr<QuicChromiumPacketBufferPool> buffer_pool_;
+  scoped_refptr<QuicChromiumPacketBuffer> read_buffer_;
+  std::vector<int> packet_lengths_;
   NetLogWithSource net_log_;
 
   base::WeakPtrFactory<QuicChromiumPacketReader> weak_factory_;
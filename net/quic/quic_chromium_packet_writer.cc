@@ -30,6 +30,10 @@ enum NotReusableReason {
 
 const int kMaxRetries = 12;  // 2^12 = 4 seconds, which should be a LOT.
 
+// In batch mode, packets are handed to the socket at least this often, which
+// matches the number of writes UDPSocketPosix allows to be in flight.
+const size_t kMaxBatchedPackets = 16;
+
 void RecordNotReusableReason(NotReusableReason reason) {
   UMA_HISTOGRAM_ENUMERATION("Net.QuicSession.WritePacketNotReusable", reason,
                             NUM_NOT_REUSABLE_REASONS);
@@ -81,7 +85,8 @@ void QuicChromiumPacketWriter::ReusableIOBuffer::Set(const char* buffer,
   std::memcpy(data(), buffer, buf_len);
 }
 
-QuicChromiumPacketWriter::QuicChromiumPacketWriter() : weak_factory_(this) {}
+QuicChromiumPacketWriter::QuicChromiumPacketWriter()
+    : batch_mode_(false), weak_factory_(this) {}
 
 QuicChromiumPacketWriter::QuicChromiumPacketWriter(
     DatagramClientSocket* socket,
@@ -93,8 +98,13 @@ QuicChromiumPacketWriter::QuicChromiumPacketWriter(
       write_in_progress_(false),
       force_write_blocked_(false),
       retry_count_(0),
+      batch_mode_(socket->WriteAsyncEnabled()),
       weak_factory_(this) {
   retry_timer_.SetTaskRunner(task_runner);
+  if (batch_mode_) {
+    datagram_buffer_pool_ =
+        std::make_unique<DatagramBufferPool>(quic::kMaxOutgoingPacketSize);
+  }
   write_callback_ = base::BindRepeating(
       &QuicChromiumPacketWriter::OnWriteComplete, weak_factory_.GetWeakPtr());
 }
@@ -133,6 +143,12 @@ quic::WriteResult QuicChromiumPacketWriter::WritePacket(
     const quic::QuicSocketAddress& peer_address,
     quic::PerPacketOptions* /*options*/) {
   DCHECK(!IsWriteBlocked());
+  if (batch_mode_) {
+    datagram_buffer_pool_->Enqueue(buffer, buf_len, &pending_packets_);
+    if (pending_packets_.size() < kMaxBatchedPackets)
+      return quic::WriteResult(quic::WRITE_STATUS_OK, 0);
+    return WritePendingPacketsToSocket();
+  }
   SetPacket(buffer, buf_len);
   return WritePacketToSocketImpl();
 }
@@ -184,6 +200,23 @@ quic::WriteResult QuicChromiumPacketWriter::WritePacketToSocketImpl() {
   return quic::WriteResult(status, rv);
 }
 
+quic::WriteResult QuicChromiumPacketWriter::WritePendingPacketsToSocket() {
+  DCHECK(batch_mode_);
+  if (pending_packets_.empty())
+    return quic::WriteResult(quic::WRITE_STATUS_OK, 0);
+
+  int rv = socket_->WriteAsync(std::move(pending_packets_), write_callback_,
+                               kTrafficAnnotation);
+  pending_packets_.clear();
+  if (rv == ERR_IO_PENDING) {
+    write_in_progress_ = true;
+    return quic::WriteResult(quic::WRITE_STATUS_BLOCKED_DATA_BUFFERED, rv);
+  }
+  if (rv < 0)
+    return quic::WriteResult(quic::WRITE_STATUS_ERROR, rv);
+  return quic::WriteResult(quic::WRITE_STATUS_OK, rv);
+}
+
 void QuicChromiumPacketWriter::RetryPacketAfterNoBuffers() {
   DCHECK_GT(retry_count_, 0);
   quic::WriteResult result = WritePacketToSocketImpl();
@@ -205,6 +238,14 @@ void QuicChromiumPacketWriter::OnWriteComplete(int rv) {
   if (delegate_ == nullptr)
     return;
 
+  if (batch_mode_) {
+    if (rv < 0)
+      delegate_->OnWriteError(rv);
+    else if (!force_write_blocked_)
+      delegate_->OnWriteUnblocked();
+    return;
+  }
+
   if (rv < 0) {
     if (MaybeRetryAfterWriteError(rv))
       return;
@@ -261,7 +302,7 @@ bool QuicChromiumPacketWriter::SupportsReleaseTime() const {
 }
 
 bool QuicChromiumPacketWriter::IsBatchMode() const {
-  return false;
+  return batch_mode_;
 }
 
 char* QuicChromiumPacketWriter::GetNextWriteLocation(
@@ -271,7 +312,9 @@ char* QuicChromiumPacketWriter::GetNextWriteLocation(
 }
 
 quic::WriteResult QuicChromiumPacketWriter::Flush() {
-  return quic::WriteResult(quic::WRITE_STATUS_OK, 0);
+  if (!batch_mode_)
+    return quic::WriteResult(quic::WRITE_STATUS_OK, 0);
+  return WritePendingPacketsToSocket();
 }
 
 }  // namespace net
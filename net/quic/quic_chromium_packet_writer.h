@@ -7,10 +7,13 @@
 
 #include <stddef.h>
 
+#include <memory>
+
 #include "base/macros.h"
 #include "base/memory/weak_ptr.h"
 #include "base/timer/timer.h"
 #include "net/base/completion_repeating_callback.h"
+#include "net/base/datagram_buffer.h"
 #include "net/base/io_buffer.h"
 #include "net/base/net_export.h"
 #include "net/socket/datagram_client_socket.h"
@@ -66,7 +69,11 @@ class NET_EXPORT_PRIVATE QuicChromiumPacketWriter
   };
 
   QuicChromiumPacketWriter();
-  // |socket| and |task_runner| must outlive writer.
+  // |socket| and |task_runner| must outlive writer. If WriteAsync() is enabled
+  // on |socket|, the writer is in batch mode: packets are buffered until
+  // Flush() and handed to the socket together, which writes them with
+  // sendmmsg() or UDP_SEGMENT where supported. Write errors are then final,
+  // as the packets they concern are no longer known to the writer.
   QuicChromiumPacketWriter(DatagramClientSocket* socket,
                            base::SequencedTaskRunner* task_runner);
   ~QuicChromiumPacketWriter() override;
@@ -106,6 +113,8 @@ class NET_EXPORT_PRIVATE QuicChromiumPacketWriter
   bool MaybeRetryAfterWriteError(int rv);
   void RetryPacketAfterNoBuffers();
   quic::WriteResult WritePacketToSocketImpl();
+  // Hands |pending_packets_| to the socket.
+  quic::WriteResult WritePendingPacketsToSocket();
   DatagramClientSocket* socket_;  // Unowned.
   Delegate* delegate_;            // Unowned.
   // Reused for every packet write for the lifetime of the writer.  Is
@@ -122,6 +131,13 @@ class NET_EXPORT_PRIVATE QuicChromiumPacketWriter
   bool force_write_blocked_;
 
   int retry_count_;
+
+  // True in batch mode, see the constructor.
+  bool batch_mode_;
+  std::unique_ptr<DatagramBufferPool> datagram_buffer_pool_;
+  // Packets written since the last Flush().
+  DatagramBuffers pending_packets_;
+
   // Timer set when a packet should be retried after ENOBUFS.
   base::OneShotTimer retry_timer_;
 
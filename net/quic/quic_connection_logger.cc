@@ -23,6 +23,7 @@
 #include "net/log/net_log_capture_mode.h"
 #include "net/log/net_log_event_type.h"
 #include "net/quic/quic_address_mismatch.h"
+#include "net/socket/connection_stats.h"
 #include "net/third_party/quiche/src/quic/core/crypto/crypto_handshake_message.h"
 #include "net/third_party/quiche/src/quic/core/crypto/crypto_protocol.h"
 #include "net/third_party/quiche/src/quic/core/quic_connection_id.h"
@@ -295,6 +296,24 @@ AddressFamily GetRealAddressFamily(const IPAddress& address) {
 
 }  // namespace
 
+void GetQuicConnectionStats(quic::QuicConnection* connection,
+                            ConnectionStats* stats) {
+  const quic::QuicConnectionStats& quic_stats = connection->GetStats();
+  stats->transport = ConnectionStats::Transport::kQuic;
+  stats->time = base::TimeTicks::Now();
+  stats->peer_address = connection->peer_address().impl().socket_address();
+  stats->bytes_sent = quic_stats.bytes_sent;
+  stats->bytes_received = quic_stats.bytes_received;
+  stats->retransmits = quic_stats.packets_retransmitted;
+  stats->packets_lost = quic_stats.packets_lost;
+  stats->smoothed_rtt = base::TimeDelta::FromMicroseconds(quic_stats.srtt_us);
+  stats->min_rtt = base::TimeDelta::FromMicroseconds(quic_stats.min_rtt_us);
+  stats->congestion_window_bytes =
+      connection->sent_packet_manager().GetCongestionWindowInBytes();
+  stats->bandwidth_estimate_bps =
+      quic_stats.estimated_bandwidth.ToBitsPerSecond();
+}
+
 QuicConnectionLogger::QuicConnectionLogger(
     quic::QuicSpdySession* session,
     const char* const connection_description,
@@ -857,6 +876,12 @@ void QuicConnectionLogger::OnRttChanged(quic::QuicTime::Delta rtt) const {
   if (!socket_performance_watcher_)
     return;
 
+  if (socket_performance_watcher_->ShouldNotifyConnectionStats()) {
+    ConnectionStats stats;
+    GetQuicConnectionStats(session_->connection(), &stats);
+    socket_performance_watcher_->OnConnectionStatsAvailable(stats);
+  }
+
   int64_t microseconds = rtt.ToMicroseconds();
   if (microseconds != 0 &&
       socket_performance_watcher_->ShouldNotifyUpdatedRTT()) {
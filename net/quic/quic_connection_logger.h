@@ -28,6 +28,12 @@ class HistogramBase;
 
 namespace net {
 
+struct ConnectionStats;
+
+// Fills |stats| with a snapshot of the state of |connection|.
+NET_EXPORT_PRIVATE void GetQuicConnectionStats(quic::QuicConnection* connection,
+                                               ConnectionStats* stats);
+
 // This class is a debug visitor of a quic::QuicConnection which logs
 // events to |net_log|.
 class NET_EXPORT_PRIVATE QuicConnectionLogger
@@ -11,6 +11,7 @@
 
 #include "base/bind.h"
 #include "base/callback_helpers.h"
+#include "base/feature_list.h"
 #include "base/location.h"
 #include "base/metrics/field_trial.h"
 #include "base/metrics/histogram_functions.h"
@@ -27,6 +28,7 @@
 #include "base/trace_event/trace_event.h"
 #include "base/values.h"
 #include "crypto/openssl_util.h"
+#include "net/base/features.h"
 #include "net/base/ip_address.h"
 #include "net/base/net_errors.h"
 #include "net/base/trace_constants.h"
@@ -1647,6 +1649,13 @@ std::unique_ptr<DatagramClientSocket> QuicStreamFactory::CreateSocket(
     const NetLogSource& source) {
   auto socket = client_socket_factory_->CreateDatagramClientSocket(
       DatagramSocket::DEFAULT_BIND, net_log, source);
+  if (base::FeatureList::IsEnabled(features::kQuicBatchedUdpIo)) {
+    // Lets QuicChromiumPacketWriter batch its writes, see its constructor.
+    socket->SetWriteAsyncEnabled(true);
+    socket->SetMaxPacketSize(quic::kMaxOutgoingPacketSize);
+    socket->SetSendmmsgEnabled(true);
+    socket->SetUdpGsoEnabled(true);
+  }
   if (enable_socket_recv_optimization_)
     socket->EnableRecvOptimization();
   return socket;
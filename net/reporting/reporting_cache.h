@@ -91,6 +91,14 @@ class NET_EXPORT ReportingCache {
   virtual void GetNonpendingReports(
       std::vector<const ReportingReport*>* reports_out) const = 0;
 
+  // Returns the number of reports that |GetReports| would return, without
+  // copying them out.
+  virtual size_t GetReportCount() const = 0;
+
+  // Returns the number of reports that |GetNonpendingReports| would return,
+  // without copying them out.
+  virtual size_t GetNonpendingReportCount() const = 0;
+
   // Marks a set of reports as pending. |reports| must not already be marked as
   // pending.
   virtual void SetReportsPending(
@@ -139,6 +139,7 @@ base::Value ReportingCacheImpl::GetReportsAsValue() const {
 void ReportingCacheImpl::GetNonpendingReports(
     std::vector<const ReportingReport*>* reports_out) const {
   reports_out->clear();
+  reports_out->reserve(GetNonpendingReportCount());
   for (const auto& it : reports_) {
     if (!base::ContainsKey(pending_reports_, it.first) &&
         !base::ContainsKey(doomed_reports_, it.first)) {
@@ -147,6 +148,16 @@ void ReportingCacheImpl::GetNonpendingReports(
   }
 }
 
+size_t ReportingCacheImpl::GetReportCount() const {
+  // Doomed reports are always pending, so both counts are exact.
+  DCHECK_LE(doomed_reports_.size(), pending_reports_.size());
+  return reports_.size() - doomed_reports_.size();
+}
+
+size_t ReportingCacheImpl::GetNonpendingReportCount() const {
+  return reports_.size() - pending_reports_.size();
+}
+
 void ReportingCacheImpl::SetReportsPending(
     const std::vector<const ReportingReport*>& reports) {
   for (const ReportingReport* report : reports) {
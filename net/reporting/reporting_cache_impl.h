@@ -45,6 +45,8 @@ class ReportingCacheImpl : public ReportingCache {
   base::Value GetReportsAsValue() const override;
   void GetNonpendingReports(
       std::vector<const ReportingReport*>* reports_out) const override;
+  size_t GetReportCount() const override;
+  size_t GetNonpendingReportCount() const override;
   void SetReportsPending(
       const std::vector<const ReportingReport*>& reports) override;
   void ClearReportsPending(
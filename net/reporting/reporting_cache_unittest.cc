@@ -264,6 +264,33 @@ TEST_F(ReportingCacheTest, RemoveAllPendingReports) {
   EXPECT_EQ(0u, cache()->GetFullReportCountForTesting());
 }
 
+TEST_F(ReportingCacheTest, ReportCounts) {
+  cache()->AddReport(kUrl1_, kUserAgent_, kGroup1_, kType_,
+                     std::make_unique<base::DictionaryValue>(), 0, kNow_, 0);
+  cache()->AddReport(kUrl1_, kUserAgent_, kGroup2, kType_,
+                     std::make_unique<base::DictionaryValue>(), 0, kNow_, 0);
+  EXPECT_EQ(2u, cache()->GetReportCount());
+  EXPECT_EQ(2u, cache()->GetNonpendingReportCount());
+
+  std::vector<const ReportingReport*> reports;
+  cache()->GetReports(&reports);
+  ASSERT_EQ(2u, reports.size());
+  std::vector<const ReportingReport*> pending = {reports[0]};
+
+  cache()->SetReportsPending(pending);
+  EXPECT_EQ(2u, cache()->GetReportCount());
+  EXPECT_EQ(1u, cache()->GetNonpendingReportCount());
+
+  // Doomed reports no longer count, even before they are deleted.
+  cache()->RemoveReports(pending, ReportingReport::Outcome::UNKNOWN);
+  EXPECT_EQ(1u, cache()->GetReportCount());
+  EXPECT_EQ(1u, cache()->GetNonpendingReportCount());
+
+  cache()->ClearReportsPending(pending);
+  EXPECT_EQ(1u, cache()->GetReportCount());
+  EXPECT_EQ(1u, cache()->GetNonpendingReportCount());
+}
+
 TEST_F(ReportingCacheTest, GetReportsAsValue) {
   // We need a reproducible expiry timestamp for this test case.
   const base::TimeTicks now = base::TimeTicks();
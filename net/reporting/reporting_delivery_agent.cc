@@ -74,10 +74,27 @@ class ReportingDeliveryAgentImpl : public ReportingDeliveryAgent,
 
   // ReportingCacheObserver implementation:
   void OnReportsUpdated() override {
-    if (CacheHasReports() && !timer_->IsRunning()) {
+    if (timer_->IsRunning()) {
+      // Deliver a batch early once it is large enough, rather than holding
+      // more reports for the rest of the batching delay.
+      if (batching_ && cache()->GetNonpendingReportCount() >=
+                           policy().delivery_batching_max_reports) {
+        timer_->Stop();
+        OnTimerFired();
+      }
+      return;
+    }
+    if (!CacheHasReports())
+      return;
+    if (policy().delivery_batching_delay.is_zero()) {
       SendReports();
       StartTimer();
+      return;
     }
+    batching_ = true;
+    timer_->Start(FROM_HERE, policy().delivery_batching_delay,
+                  base::BindRepeating(&ReportingDeliveryAgentImpl::OnTimerFired,
+                                      base::Unretained(this)));
   }
 
  private:
@@ -104,11 +121,7 @@ class ReportingDeliveryAgentImpl : public ReportingDeliveryAgent,
     std::map<url::Origin, std::map<GURL, int>> reports_per_client;
   };
 
-  bool CacheHasReports() {
-    std::vector<const ReportingReport*> reports;
-    context_->cache()->GetReports(&reports);
-    return !reports.empty();
-  }
+  bool CacheHasReports() { return cache()->GetReportCount() > 0; }
 
   void StartTimer() {
     timer_->Start(FROM_HERE, policy().delivery_interval,
@@ -117,6 +130,7 @@ class ReportingDeliveryAgentImpl : public ReportingDeliveryAgent,
   }
 
   void OnTimerFired() {
+    batching_ = false;
     if (CacheHasReports()) {
       SendReports();
       StartTimer();
@@ -270,6 +284,10 @@ class ReportingDeliveryAgentImpl : public ReportingDeliveryAgent,
 
   std::unique_ptr<base::OneShotTimer> timer_;
 
+  // Whether |timer_| is running for ReportingPolicy::delivery_batching_delay,
+  // rather than for the delivery interval between two batches.
+  bool batching_ = false;
+
   // Tracks OriginGroup tuples for which there is a pending delivery running.
   // (Would be an unordered_set, but there's no hash on pair.)
   std::set<OriginGroup> pending_origin_groups_;
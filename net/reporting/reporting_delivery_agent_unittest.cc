@@ -569,5 +569,67 @@ TEST_F(ReportingDeliveryAgentTest, ParallelizeUploadsAcrossGroups) {
   EXPECT_EQ(0u, pending_uploads().size());
 }
 
+// Tests that reports queued during the batching delay are uploaded together.
+TEST_F(ReportingDeliveryAgentTest, BatchingDelay) {
+  ReportingPolicy batching_policy = policy();
+  batching_policy.delivery_batching_delay = base::TimeDelta::FromSeconds(5);
+  batching_policy.delivery_batching_max_reports = 3u;
+  UsePolicy(batching_policy);
+
+  SetClient(kOrigin_, kEndpoint_, kGroup_);
+  cache()->AddReport(kUrl_, kUserAgent_, kGroup_, kType_,
+                     std::make_unique<base::DictionaryValue>(), 0,
+                     tick_clock()->NowTicks(), 0);
+  cache()->AddReport(kUrl_, kUserAgent_, kGroup_, kType_,
+                     std::make_unique<base::DictionaryValue>(), 0,
+                     tick_clock()->NowTicks(), 0);
+  EXPECT_TRUE(pending_uploads().empty());
+
+  EXPECT_TRUE(delivery_timer()->IsRunning());
+  EXPECT_EQ(batching_policy.delivery_batching_delay,
+            delivery_timer()->GetCurrentDelay());
+  delivery_timer()->Fire();
+
+  ASSERT_EQ(1u, pending_uploads().size());
+  base::ListValue* list;
+  auto value = pending_uploads()[0]->GetValue();
+  ASSERT_TRUE(value->GetAsList(&list));
+  EXPECT_EQ(2u, list->GetSize());
+
+  // Later reports wait for the delivery interval, as without batching.
+  EXPECT_TRUE(delivery_timer()->IsRunning());
+  EXPECT_EQ(batching_policy.delivery_interval,
+            delivery_timer()->GetCurrentDelay());
+  pending_uploads()[0]->Complete(ReportingUploader::Outcome::SUCCESS);
+  EXPECT_EQ(0u, cache()->GetReportCount());
+}
+
+// Tests that the batching delay ends early once enough reports are queued.
+TEST_F(ReportingDeliveryAgentTest, BatchingDelayCutShort) {
+  ReportingPolicy batching_policy = policy();
+  batching_policy.delivery_batching_delay = base::TimeDelta::FromSeconds(5);
+  batching_policy.delivery_batching_max_reports = 3u;
+  UsePolicy(batching_policy);
+
+  SetClient(kOrigin_, kEndpoint_, kGroup_);
+  for (int i = 0; i < 3; ++i) {
+    EXPECT_TRUE(pending_uploads().empty());
+    cache()->AddReport(kUrl_, kUserAgent_, kGroup_, kType_,
+                       std::make_unique<base::DictionaryValue>(), 0,
+                       tick_clock()->NowTicks(), 0);
+  }
+
+  ASSERT_EQ(1u, pending_uploads().size());
+  base::ListValue* list;
+  auto value = pending_uploads()[0]->GetValue();
+  ASSERT_TRUE(value->GetAsList(&list));
+  EXPECT_EQ(3u, list->GetSize());
+
+  EXPECT_TRUE(delivery_timer()->IsRunning());
+  EXPECT_EQ(batching_policy.delivery_interval,
+            delivery_timer()->GetCurrentDelay());
+  pending_uploads()[0]->Complete(ReportingUploader::Outcome::SUCCESS);
+}
+
 }  // namespace
 }  // namespace net
@@ -34,6 +34,8 @@ ReportingPolicy::ReportingPolicy()
     : max_report_count(100u),
       max_client_count(1000u),
       delivery_interval(base::TimeDelta::FromMinutes(1)),
+      delivery_batching_delay(base::TimeDelta()),
+      delivery_batching_max_reports(50u),
       persistence_interval(base::TimeDelta::FromMinutes(1)),
       persist_reports_across_restarts(false),
       persist_clients_across_restarts(true),
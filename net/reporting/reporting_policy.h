@@ -36,6 +36,15 @@ struct NET_EXPORT ReportingPolicy {
   // Minimum interval at which to attempt delivery of queued reports.
   base::TimeDelta delivery_interval;
 
+  // How long to hold reports queued while no delivery is scheduled, so that a
+  // burst of reports is uploaded in one batch. Zero delivers the first report
+  // right away.
+  base::TimeDelta delivery_batching_delay;
+
+  // Number of undelivered reports at which |delivery_batching_delay| is cut
+  // short and the batch is delivered.
+  size_t delivery_batching_max_reports;
+
   // Backoff policy for failing endpoints.
   BackoffEntry::Policy endpoint_backoff_policy;
 
@@ -8,18 +8,26 @@
 #include <utility>
 #include <vector>
 
+#include "base/bind.h"
 #include "base/callback_helpers.h"
+#include "base/feature_list.h"
 #include "base/metrics/histogram_functions.h"
 #include "base/metrics/histogram_macros.h"
 #include "base/strings/string_split.h"
 #include "base/strings/string_util.h"
+#include "base/values.h"
 #include "net/base/elements_upload_data_stream.h"
+#include "net/base/features.h"
 #include "net/base/load_flags.h"
 #include "net/base/upload_bytes_element_reader.h"
 #include "net/http/http_response_headers.h"
+#include "net/log/net_log_capture_mode.h"
+#include "net/log/net_log_event_type.h"
+#include "net/log/net_log_with_source.h"
 #include "net/traffic_annotation/network_traffic_annotation.h"
 #include "net/url_request/redirect_info.h"
 #include "net/url_request/url_request_context.h"
+#include "third_party/zlib/zlib.h"
 #include "url/gurl.h"
 #include "url/origin.h"
 
@@ -28,6 +36,7 @@ namespace net {
 namespace {
 
 constexpr char kUploadContentType[] = "application/reports+json";
+constexpr char kUploadContentEncoding[] = "gzip";
 
 constexpr net::NetworkTrafficAnnotationTag kReportUploadTrafficAnnotation =
     net::DefineNetworkTrafficAnnotation("reporting", R"(
@@ -95,6 +104,48 @@ void RecordUploadOutcome(UploadOutcome outcome) {
                             UploadOutcome::MAX);
 }
 
+// Compresses |input| into a gzip stream in |*output|. Returns false, leaving
+// |*output| empty, if that fails or doesn't make |input| any smaller.
+bool GzipCompress(const std::string& input, std::string* output) {
+  output->clear();
+
+  z_stream stream = {};
+  if (deflateInit2(&stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED,
+                   MAX_WBITS + 16 /* gzip wrapper */, 8,
+                   Z_DEFAULT_STRATEGY) != Z_OK) {
+    return false;
+  }
+
+  output->resize(deflateBound(&stream, input.size()));
+  stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(input.data()));
+  stream.avail_in = input.size();
+  stream.next_out = reinterpret_cast<Bytef*>(&(*output)[0]);
+  stream.avail_out = output->size();
+  int result = deflate(&stream, Z_FINISH);
+  size_t compressed_size = stream.total_out;
+  deflateEnd(&stream);
+
+  if (result != Z_STREAM_END || compressed_size >= input.size()) {
+    output->clear();
+    return false;
+  }
+  output->resize(compressed_size);
+  return true;
+}
+
+std::unique_ptr<base::Value> NetLogUploadPayloadCallback(
+    size_t size,
+    size_t encoded_size,
+    bool compressed,
+    NetLogCaptureMode /* capture_mode */) {
+  auto dict = std::make_unique<base::DictionaryValue>();
+  dict->SetInteger("size", static_cast<int>(size));
+  dict->SetInteger("encoded_size", static_cast<int>(encoded_size));
+  if (compressed)
+    dict->SetString("content_encoding", kUploadContentEncoding);
+  return std::move(dict);
+}
+
 // TODO: Record net and HTTP error.
 
 struct PendingUpload {
@@ -108,7 +159,7 @@ struct PendingUpload {
       : state(CREATED),
         report_origin(report_origin),
         url(url),
-        payload_reader(UploadOwnedBytesElementReader::CreateWithString(json)),
+        payload(json),
         max_depth(max_depth),
         callback(std::move(callback)) {}
 
@@ -119,7 +170,9 @@ struct PendingUpload {
   State state;
   const url::Origin report_origin;
   const GURL url;
-  std::unique_ptr<UploadElementReader> payload_reader;
+  const std::string payload;
+  // |payload| compressed with gzip, if the collector accepts that.
+  std::string compressed_payload;
   int max_depth;
   ReportingUploader::UploadCallback callback;
   std::unique_ptr<URLRequest> request;
@@ -178,7 +231,11 @@ class ReportingUploaderImpl : public ReportingUploader, URLRequest::Delegate {
     upload->request->SetExtraRequestHeaderByName(
         "Access-Control-Request-Method", "POST", true);
     upload->request->SetExtraRequestHeaderByName(
-        "Access-Control-Request-Headers", "content-type", true);
+        "Access-Control-Request-Headers",
+        base::FeatureList::IsEnabled(features::kReportingUploadCompression)
+            ? "content-type, content-encoding"
+            : "content-type",
+        true);
 
     // Set the max_depth for this request, to cap how deep a stack of "reports
     // about reports" can get.  (Without this, a Reporting policy that uploads
@@ -208,8 +265,19 @@ class ReportingUploaderImpl : public ReportingUploader, URLRequest::Delegate {
     upload->request->SetExtraRequestHeaderByName(
         HttpRequestHeaders::kContentType, kUploadContentType, true);
 
+    const bool compressed = !upload->compressed_payload.empty();
+    const std::string& body =
+        compressed ? upload->compressed_payload : upload->payload;
+    if (compressed) {
+      upload->request->SetExtraRequestHeaderByName(
+          "Content-Encoding", kUploadContentEncoding, true);
+    }
+    upload->request->net_log().AddEvent(
+        NetLogEventType::REPORTING_UPLOAD_PAYLOAD,
+        base::Bind(&NetLogUploadPayloadCallback, upload->payload.size(),
+                   body.size(), compressed));
     upload->request->set_upload(ElementsUploadDataStream::CreateWithReader(
-        std::move(upload->payload_reader), 0));
+        UploadOwnedBytesElementReader::CreateWithString(body), 0));
 
     // Set the max_depth for this request, to cap how deep a stack of "reports
     // about reports" can get.  (Without this, a Reporting policy that uploads
@@ -304,6 +372,14 @@ class ReportingUploaderImpl : public ReportingUploader, URLRequest::Delegate {
       return;
     }
 
+    // Only collectors that allow a Content-Encoding get compressed reports.
+    // (Same-origin uploads skip the preflight, so they are never compressed.)
+    if (base::FeatureList::IsEnabled(features::kReportingUploadCompression) &&
+        HasHeaderValues(request, "Access-Control-Allow-Headers",
+                        {"content-encoding"})) {
+      GzipCompress(upload->payload, &upload->compressed_payload);
+    }
+
     StartPayloadRequest(std::move(upload));
   }
 
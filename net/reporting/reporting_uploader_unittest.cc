@@ -11,6 +11,8 @@
 #include "base/bind.h"
 #include "base/callback.h"
 #include "base/run_loop.h"
+#include "base/test/scoped_feature_list.h"
+#include "net/base/features.h"
 #include "net/cookies/cookie_store.h"
 #include "net/cookies/cookie_store_test_callbacks.h"
 #include "net/http/http_status_code.h"
@@ -347,6 +349,93 @@ TEST_F(ReportingUploaderTest, CorsPreflightWithoutHeaders) {
   EXPECT_EQ(ReportingUploader::Outcome::FAILURE, callback.outcome());
 }
 
+std::unique_ptr<test_server::HttpResponse> AllowPreflightWithContentEncoding(
+    const test_server::HttpRequest& request) {
+  if (request.method_string != "OPTIONS") {
+    return std::unique_ptr<test_server::HttpResponse>();
+  }
+  auto it = request.headers.find("Access-Control-Request-Headers");
+  EXPECT_TRUE(it != request.headers.end());
+  EXPECT_EQ("content-type, content-encoding", it->second);
+  it = request.headers.find("Origin");
+  EXPECT_TRUE(it != request.headers.end());
+  auto response = std::make_unique<test_server::BasicHttpResponse>();
+  response->AddCustomHeader("Access-Control-Allow-Origin", it->second);
+  response->AddCustomHeader("Access-Control-Allow-Methods", "POST");
+  response->AddCustomHeader("Access-Control-Allow-Headers",
+                            "Content-Type, Content-Encoding");
+  response->set_code(HTTP_OK);
+  response->set_content("");
+  response->set_content_type("text/plain");
+  return std::move(response);
+}
+
+void CheckCompressedUpload(const std::string& expected_body,
+                           bool expect_compressed,
+                           const test_server::HttpRequest& request) {
+  if (request.method_string != "POST") {
+    return;
+  }
+  ASSERT_TRUE(request.has_content);
+  auto it = request.headers.find("Content-Encoding");
+  if (!expect_compressed) {
+    EXPECT_TRUE(it == request.headers.end());
+    EXPECT_EQ(expected_body, request.content);
+    return;
+  }
+  ASSERT_TRUE(it != request.headers.end());
+  EXPECT_EQ("gzip", it->second);
+  EXPECT_LT(request.content.size(), expected_body.size());
+  ASSERT_LE(2u, request.content.size());
+  EXPECT_EQ('\x1f', request.content[0]);
+  EXPECT_EQ('\x8b', request.content[1]);
+}
+
+TEST_F(ReportingUploaderTest, CompressedUpload) {
+  base::test::ScopedFeatureList feature_list;
+  feature_list.InitAndEnableFeature(features::kReportingUploadCompression);
+
+  std::string body = "[";
+  for (int i = 0; i < 100; ++i)
+    body += "{\"type\":\"csp-violation\",\"url\":\"https://origin/\"},";
+  body.back() = ']';
+
+  server_.RegisterRequestMonitor(
+      base::BindRepeating(&CheckCompressedUpload, body, true));
+  server_.RegisterRequestHandler(
+      base::BindRepeating(&AllowPreflightWithContentEncoding));
+  server_.RegisterRequestHandler(base::BindRepeating(&ReturnResponse, HTTP_OK));
+  ASSERT_TRUE(server_.Start());
+
+  TestUploadCallback callback;
+  uploader_->StartUpload(kOrigin, server_.GetURL("/"), body, 0,
+                         callback.callback());
+  callback.WaitForCall();
+
+  EXPECT_EQ(ReportingUploader::Outcome::SUCCESS, callback.outcome());
+}
+
+TEST_F(ReportingUploaderTest, CompressionNotAllowedByPreflight) {
+  base::test::ScopedFeatureList feature_list;
+  feature_list.InitAndEnableFeature(features::kReportingUploadCompression);
+
+  std::string body(4096, 'x');
+  body = "\"" + body + "\"";
+
+  server_.RegisterRequestMonitor(
+      base::BindRepeating(&CheckCompressedUpload, body, false));
+  server_.RegisterRequestHandler(base::BindRepeating(&AllowPreflight));
+  server_.RegisterRequestHandler(base::BindRepeating(&ReturnResponse, HTTP_OK));
+  ASSERT_TRUE(server_.Start());
+
+  TestUploadCallback callback;
+  uploader_->StartUpload(kOrigin, server_.GetURL("/"), body, 0,
+                         callback.callback());
+  callback.WaitForCall();
+
+  EXPECT_EQ(ReportingUploader::Outcome::SUCCESS, callback.outcome());
+}
+
 TEST_F(ReportingUploaderTest, RemoveEndpoint) {
   server_.RegisterRequestHandler(base::BindRepeating(&AllowPreflight));
   server_.RegisterRequestHandler(
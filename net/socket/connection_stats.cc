@@ -0,0 +1,46 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "net/socket/connection_stats.h"
+
+#include "base/logging.h"
+
+namespace net {
+
+ConnectionStats::ConnectionStats() = default;
+
+ConnectionStats::ConnectionStats(const ConnectionStats& other) = default;
+
+ConnectionStats::~ConnectionStats() = default;
+
+ConnectionStatsRecorder::ConnectionStatsRecorder(
+    size_t capacity,
+    base::TimeDelta min_sample_interval)
+    : capacity_(capacity),
+      min_sample_interval_(min_sample_interval),
+      num_recorded_(0) {
+  DCHECK_GT(capacity_, 0u);
+}
+
+void ConnectionStatsRecorder::Record(const ConnectionStats& stats) {
+  base::AutoLock lock(lock_);
+  if (snapshots_.size() == capacity_)
+    snapshots_.pop_front();
+  snapshots_.push_back(stats);
+  ++num_recorded_;
+}
+
+std::vector<ConnectionStats> ConnectionStatsRecorder::GetSnapshots() const {
+  base::AutoLock lock(lock_);
+  return std::vector<ConnectionStats>(snapshots_.begin(), snapshots_.end());
+}
+
+uint64_t ConnectionStatsRecorder::num_recorded() const {
+  base::AutoLock lock(lock_);
+  return num_recorded_;
+}
+
+ConnectionStatsRecorder::~ConnectionStatsRecorder() = default;
+
+}  // namespace net
@@ -0,0 +1,94 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef NET_SOCKET_CONNECTION_STATS_H_
+#define NET_SOCKET_CONNECTION_STATS_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <vector>
+
+#include "base/containers/circular_deque.h"
+#include "base/macros.h"
+#include "base/memory/ref_counted.h"
+#include "base/synchronization/lock.h"
+#include "base/time/time.h"
+#include "net/base/ip_endpoint.h"
+#include "net/base/net_export.h"
+
+namespace net {
+
+// A snapshot of the transport-level state of a connection: a TCP connection,
+// read from TCP_INFO, or a QUIC connection. Fields that aren't known for a
+// connection are left at zero.
+struct NET_EXPORT ConnectionStats {
+  enum class Transport {
+    kTcp,
+    kQuic,
+  };
+
+  ConnectionStats();
+  ConnectionStats(const ConnectionStats& other);
+  ~ConnectionStats();
+
+  Transport transport = Transport::kTcp;
+  // When the snapshot was taken.
+  base::TimeTicks time;
+  IPEndPoint peer_address;
+
+  uint64_t bytes_sent = 0;
+  uint64_t bytes_received = 0;
+  // Segments or packets sent again, over the lifetime of the connection.
+  uint64_t retransmits = 0;
+  // QUIC packets declared lost.
+  uint64_t packets_lost = 0;
+
+  base::TimeDelta smoothed_rtt;
+  base::TimeDelta rtt_variance;
+  base::TimeDelta min_rtt;
+  uint64_t congestion_window_bytes = 0;
+  // The sender's estimate of the bandwidth, in bits per second.
+  uint64_t bandwidth_estimate_bps = 0;
+};
+
+// Keeps the last |capacity| ConnectionStats snapshots of all the connections it
+// is given, for live monitoring. Snapshots are recorded by the sockets on their
+// own sequence, and can be read from any thread.
+class NET_EXPORT ConnectionStatsRecorder
+    : public base::RefCountedThreadSafe<ConnectionStatsRecorder> {
+ public:
+  ConnectionStatsRecorder(size_t capacity,
+                          base::TimeDelta min_sample_interval);
+
+  // Minimum interval between two snapshots of the same connection.
+  base::TimeDelta min_sample_interval() const { return min_sample_interval_; }
+
+  // Adds |stats|, dropping the oldest snapshot if full.
+  void Record(const ConnectionStats& stats);
+
+  // Returns the recorded snapshots, oldest first.
+  std::vector<ConnectionStats> GetSnapshots() const;
+
+  // Total number of snapshots recorded, including the dropped ones.
+  uint64_t num_recorded() const;
+
+ private:
+  friend class base::RefCountedThreadSafe<ConnectionStatsRecorder>;
+
+  ~ConnectionStatsRecorder();
+
+  const size_t capacity_;
+  const base::TimeDelta min_sample_interval_;
+
+  mutable base::Lock lock_;
+  base::circular_deque<ConnectionStats> snapshots_;
+  uint64_t num_recorded_;
+
+  DISALLOW_COPY_AND_ASSIGN(ConnectionStatsRecorder);
+};
+
+}  // namespace net
+
+#endif  // NET_SOCKET_CONNECTION_STATS_H_
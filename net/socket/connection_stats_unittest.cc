@@ -0,0 +1,52 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "net/socket/connection_stats.h"
+
+#include <vector>
+
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace net {
+
+namespace {
+
+ConnectionStats MakeStats(uint64_t bytes_sent) {
+  ConnectionStats stats;
+  stats.bytes_sent = bytes_sent;
+  return stats;
+}
+
+TEST(ConnectionStatsRecorderTest, KeepsSnapshotsInOrder) {
+  auto recorder = base::MakeRefCounted<ConnectionStatsRecorder>(
+      3, base::TimeDelta::FromSeconds(1));
+  EXPECT_TRUE(recorder->GetSnapshots().empty());
+
+  recorder->Record(MakeStats(1));
+  recorder->Record(MakeStats(2));
+
+  std::vector<ConnectionStats> snapshots = recorder->GetSnapshots();
+  ASSERT_EQ(2u, snapshots.size());
+  EXPECT_EQ(1u, snapshots[0].bytes_sent);
+  EXPECT_EQ(2u, snapshots[1].bytes_sent);
+  EXPECT_EQ(2u, recorder->num_recorded());
+}
+
+TEST(ConnectionStatsRecorderTest, DropsOldestSnapshotsWhenFull) {
+  auto recorder = base::MakeRefCounted<ConnectionStatsRecorder>(
+      3, base::TimeDelta::FromSeconds(1));
+  for (uint64_t i = 1; i <= 5; ++i)
+    recorder->Record(MakeStats(i));
+
+  std::vector<ConnectionStats> snapshots = recorder->GetSnapshots();
+  ASSERT_EQ(3u, snapshots.size());
+  EXPECT_EQ(3u, snapshots[0].bytes_sent);
+  EXPECT_EQ(4u, snapshots[1].bytes_sent);
+  EXPECT_EQ(5u, snapshots[2].bytes_sent);
+  EXPECT_EQ(5u, recorder->num_recorded());
+}
+
+}  // namespace
+
+}  // namespace net
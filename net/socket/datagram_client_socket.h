@@ -5,7 +5,10 @@
 #ifndef NET_SOCKET_DATAGRAM_CLIENT_SOCKET_H_
 #define NET_SOCKET_DATAGRAM_CLIENT_SOCKET_H_
 
+#include <vector>
+
 #include "net/base/datagram_buffer.h"
+#include "net/base/net_errors.h"
 #include "net/base/net_export.h"
 #include "net/base/network_change_notifier.h"
 #include "net/socket/datagram_socket.h"
@@ -50,6 +53,20 @@ class NET_EXPORT_PRIVATE DatagramClientSocket : public DatagramSocket,
   // By default, this method is no-op.
   virtual void EnableRecvOptimization() {}
 
+  // Reads up to |max_packets| datagrams at once, datagram i at offset
+  // i * |packet_len| of |buf| with its size or error in
+  // (*packet_lengths)[i]. Returns the number of datagrams read or a net error
+  // code. If ERR_IO_PENDING is returned, |packet_lengths| must be kept alive
+  // until |callback| is called with the result. By default, returns
+  // ERR_NOT_IMPLEMENTED, in which case the caller should use Read().
+  virtual int ReadMultiple(IOBuffer* buf,
+                           int packet_len,
+                           int max_packets,
+                           std::vector<int>* packet_lengths,
+                           CompletionOnceCallback callback) {
+    return ERR_NOT_IMPLEMENTED;
+  }
+
   // As Write, but internally this can delay writes and batch them up
   // for writing in a separate task.  This is to increase throughput
   // in bulk transfer scenarios (in QUIC) where a substantial
@@ -121,6 +138,12 @@ class NET_EXPORT_PRIVATE DatagramClientSocket : public DatagramSocket,
   // connection option.
   virtual void SetSendmmsgEnabled(bool enabled) = 0;
 
+  // In |WriteAsync()|, send runs of packets of the same size with a single
+  // UDP_SEGMENT (GSO) write on platforms that support it. By default, this
+  // method is no-op. Must be called right after construction and before other
+  // calls.
+  virtual void SetUdpGsoEnabled(bool enabled) {}
+
   // This is to (de-)activate batching in |WriteAsync|, e.g. in
   // |QuicChromiumClientSession| based on whether there are large
   // upload stream(s) active.
@@ -13,6 +13,8 @@ class TimeDelta;
 
 namespace net {
 
+struct ConnectionStats;
+
 // SocketPerformanceWatcher is the base class for recording and aggregating
 // per-socket statistics. SocketPerformanceWatcher must be used on a single
 // thread.
@@ -36,6 +38,15 @@ class NET_EXPORT_PRIVATE SocketPerformanceWatcher {
   // to a different transport layer connection. Note: The new connection shares
   // the same protocol as the previously watched socket.
   virtual void OnConnectionChanged() = 0;
+
+  // Returns true if |this| SocketPerformanceWatcher wants a new snapshot of
+  // the connection's stats (via OnConnectionStatsAvailable). Checked after
+  // reads and writes, so implementations should throttle.
+  virtual bool ShouldNotifyConnectionStats() const { return false; }
+
+  // Notifies |this| SocketPerformanceWatcher of a snapshot of the stats of the
+  // watched connection, taken on the socket's sequence.
+  virtual void OnConnectionStatsAvailable(const ConnectionStats& stats) {}
 };
 
 }  // namespace net
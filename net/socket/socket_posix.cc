@@ -7,6 +7,7 @@
 #include <errno.h>
 #include <netinet/in.h>
 #include <sys/socket.h>
+#include <sys/uio.h>
 #include <utility>
 
 #include "base/bind.h"
@@ -73,6 +74,7 @@ SocketPosix::SocketPosix()
       read_buf_len_(0),
       write_socket_watcher_(FROM_HERE),
       write_buf_len_(0),
+      write_payload_buf_len_(0),
       waiting_connect_(false) {}
 
 SocketPosix::~SocketPosix() {
@@ -385,6 +387,34 @@ int SocketPosix::Write(
   return rv;
 }
 
+int SocketPosix::WriteV(
+    IOBuffer* header,
+    int header_len,
+    IOBuffer* payload,
+    int payload_len,
+    CompletionOnceCallback callback,
+    const NetworkTrafficAnnotationTag& /* traffic_annotation */) {
+  DCHECK(thread_checker_.CalledOnValidThread());
+  DCHECK_NE(kInvalidSocket, socket_fd_);
+  DCHECK(!waiting_connect_);
+  CHECK(write_callback_.is_null());
+  // Synchronous operation not supported
+  DCHECK(!callback.is_null());
+  DCHECK_LT(0, header_len);
+  DCHECK_LT(0, payload_len);
+
+  int rv = DoWriteV(header, header_len, payload, payload_len);
+  if (rv != ERR_IO_PENDING)
+    return rv;
+
+  rv = WaitForWrite(header, header_len, std::move(callback));
+  if (rv == ERR_IO_PENDING) {
+    write_payload_buf_ = payload;
+    write_payload_buf_len_ = payload_len;
+  }
+  return rv;
+}
+
 int SocketPosix::WaitForWrite(IOBuffer* buf,
                               int buf_len,
                               CompletionOnceCallback callback) {
@@ -581,8 +611,32 @@ int SocketPosix::DoWrite(IOBuffer* buf, int buf_len) {
   return rv >= 0 ? rv : MapSystemError(errno);
 }
 
+int SocketPosix::DoWriteV(IOBuffer* header,
+                          int header_len,
+                          IOBuffer* payload,
+                          int payload_len) {
+  struct iovec iov[2];
+  iov[0].iov_base = header->data();
+  iov[0].iov_len = header_len;
+  iov[1].iov_base = payload->data();
+  iov[1].iov_len = payload_len;
+  struct msghdr msg = {};
+  msg.msg_iov = iov;
+  msg.msg_iovlen = 2;
+#if defined(OS_LINUX) || defined(OS_ANDROID)
+  // See DoWrite() for MSG_NOSIGNAL.
+  int rv = HANDLE_EINTR(sendmsg(socket_fd_, &msg, MSG_NOSIGNAL));
+#else
+  int rv = HANDLE_EINTR(sendmsg(socket_fd_, &msg, 0));
+#endif
+  return rv >= 0 ? rv : MapSystemError(errno);
+}
+
 void SocketPosix::WriteCompleted() {
-  int rv = DoWrite(write_buf_.get(), write_buf_len_);
+  int rv = write_payload_buf_
+               ? DoWriteV(write_buf_.get(), write_buf_len_,
+                          write_payload_buf_.get(), write_payload_buf_len_)
+               : DoWrite(write_buf_.get(), write_buf_len_);
   if (rv == ERR_IO_PENDING)
     return;
 
@@ -590,6 +644,8 @@ void SocketPosix::WriteCompleted() {
   DCHECK(ok);
   write_buf_ = NULL;
   write_buf_len_ = 0;
+  write_payload_buf_ = NULL;
+  write_payload_buf_len_ = 0;
   std::move(write_callback_).Run(rv);
 }
 
@@ -617,6 +673,8 @@ void SocketPosix::StopWatchingAndCleanUp() {
   if (!write_callback_.is_null()) {
     write_buf_ = NULL;
     write_buf_len_ = 0;
+    write_payload_buf_ = NULL;
+    write_payload_buf_len_ = 0;
     write_callback_.Reset();
   }
 
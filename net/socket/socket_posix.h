@@ -80,6 +80,16 @@ class NET_EXPORT_PRIVATE SocketPosix
             CompletionOnceCallback callback,
             const NetworkTrafficAnnotationTag& traffic_annotation);
 
+  // Like Write(), but writes |header_len| bytes of |header| followed by
+  // |payload_len| bytes of |payload| with a single gather write, as if they
+  // were one buffer. The returned byte count may end in either buffer.
+  int WriteV(IOBuffer* header,
+             int header_len,
+             IOBuffer* payload,
+             int payload_len,
+             CompletionOnceCallback callback,
+             const NetworkTrafficAnnotationTag& traffic_annotation);
+
   // Waits for next write event. This is called by TCPSocketPosix for TCP
   // fastopen after sending first data. Returns ERR_IO_PENDING if it starts
   // waiting for write event successfully. Otherwise, returns a net error code.
@@ -117,6 +127,10 @@ class NET_EXPORT_PRIVATE SocketPosix
   void ReadCompleted();
 
   int DoWrite(IOBuffer* buf, int buf_len);
+  int DoWriteV(IOBuffer* header,
+               int header_len,
+               IOBuffer* payload,
+               int payload_len);
   void WriteCompleted();
 
   void StopWatchingAndCleanUp();
@@ -140,6 +154,10 @@ class NET_EXPORT_PRIVATE SocketPosix
   base::MessagePumpForIO::FdWatchController write_socket_watcher_;
   scoped_refptr<IOBuffer> write_buf_;
   int write_buf_len_;
+  // Non-null when a WriteV() is in progress. |write_buf_| then holds the
+  // header.
+  scoped_refptr<IOBuffer> write_payload_buf_;
+  int write_payload_buf_len_;
   // External callback; called when write or connect is complete.
   CompletionOnceCallback write_callback_;
 
@@ -779,6 +779,8 @@ MockClientSocketFactory::CreateTransportClientSocket(
       new MockTCPClientSocket(addresses, net_log, data_provider));
   if (enable_read_if_ready_)
     socket->set_enable_read_if_ready(enable_read_if_ready_);
+  if (enable_write_v_)
+    socket->set_enable_write_v(enable_write_v_);
   return std::move(socket);
 }
 
@@ -1049,6 +1051,32 @@ void MockTCPClientSocket::AddConnectionAttempts(
                               attempts.end());
 }
 
+bool MockTCPClientSocket::SupportsWriteV() const {
+  return enable_write_v_;
+}
+
+int MockTCPClientSocket::WriteV(
+    IOBuffer* header,
+    int header_len,
+    IOBuffer* payload,
+    int payload_len,
+    CompletionOnceCallback callback,
+    const NetworkTrafficAnnotationTag& traffic_annotation) {
+  DCHECK(enable_write_v_);
+  DCHECK_GT(header_len, 0);
+  DCHECK_GT(payload_len, 0);
+
+  if (!connected_ || !data_)
+    return ERR_UNEXPECTED;
+
+  data_->add_write_v_header_size(header_len);
+  auto buf = base::MakeRefCounted<IOBuffer>(header_len + payload_len);
+  memcpy(buf->data(), header->data(), header_len);
+  memcpy(buf->data() + header_len, payload->data(), payload_len);
+  return Write(buf.get(), header_len + payload_len, std::move(callback),
+               traffic_annotation);
+}
+
 void MockTCPClientSocket::SetBeforeConnectCallback(
     const BeforeConnectCallback& before_connect_callback) {
   DCHECK(!before_connect_callback_);
@@ -1568,6 +1596,23 @@ int64_t MockSSLClientSocket::GetTotalReceivedBytes() const {
   return 0;
 }
 
+bool MockSSLClientSocket::SupportsWriteV() const {
+  return stream_socket_->SupportsWriteV();
+}
+
+int MockSSLClientSocket::WriteV(
+    IOBuffer* header,
+    int header_len,
+    IOBuffer* payload,
+    int payload_len,
+    CompletionOnceCallback callback,
+    const NetworkTrafficAnnotationTag& traffic_annotation) {
+  if (!data_->is_confirm_data_consumed)
+    data_->write_called_before_confirm = true;
+  return stream_socket_->WriteV(header, header_len, payload, payload_len,
+                                std::move(callback), traffic_annotation);
+}
+
 int64_t MockClientSocket::GetTotalReceivedBytes() const {
   NOTIMPLEMENTED();
   return 0;
@@ -247,6 +247,14 @@ class SocketDataProvider {
     send_buffer_size_ = send_buffer_size;
   }
 
+  // Returns the header size of each StreamSocket::WriteV() call, in order.
+  const std::vector<int>& write_v_header_sizes() const {
+    return write_v_header_sizes_;
+  }
+  void add_write_v_header_size(int header_size) {
+    write_v_header_sizes_.push_back(header_size);
+  }
+
   // Returns the last set value of TCP no delay, or false if never set.
   bool no_delay() const { return no_delay_; }
   void set_no_delay(bool no_delay) { no_delay_ = no_delay; }
@@ -316,6 +324,7 @@ class SocketDataProvider {
 
   int receive_buffer_size_ = -1;
   int send_buffer_size_ = -1;
+  std::vector<int> write_v_header_sizes_;
   // This reflects the default state of TCPClientSockets.
   bool no_delay_ = true;
   // Default varies by platform. Just pretend it's disabled.
@@ -631,6 +640,11 @@ class MockClientSocketFactory : public ClientSocketFactory {
     enable_read_if_ready_ = enable_read_if_ready;
   }
 
+  // Makes the transport sockets created from now on support WriteV().
+  void set_enable_write_v(bool enable_write_v) {
+    enable_write_v_ = enable_write_v;
+  }
+
   // Uses mock ProxyClientSocket instead of the default ProxyClientSocket.
   void UseMockProxyClientSockets() { use_mock_proxy_client_sockets_ = true; }
 
@@ -674,6 +688,8 @@ class MockClientSocketFactory : public ClientSocketFactory {
   // If true, ReadIfReady() is enabled; otherwise ReadIfReady() returns
   // ERR_READ_IF_READY_NOT_IMPLEMENTED.
   bool enable_read_if_ready_;
+  // If true, transport sockets support WriteV().
+  bool enable_write_v_ = false;
   bool use_mock_proxy_client_sockets_ = false;
 
   DISALLOW_COPY_AND_ASSIGN(MockClientSocketFactory);
@@ -778,6 +794,15 @@ class MockTCPClientSocket : public MockClientSocket, public AsyncSocket {
   void GetConnectionAttempts(ConnectionAttempts* out) const override;
   void ClearConnectionAttempts() override;
   void AddConnectionAttempts(const ConnectionAttempts& attempts) override;
+  bool SupportsWriteV() const override;
+  // Writes |header| and |payload| as one buffer, and records |header_len|
+  // with the SocketDataProvider.
+  int WriteV(IOBuffer* header,
+             int header_len,
+             IOBuffer* payload,
+             int payload_len,
+             CompletionOnceCallback callback,
+             const NetworkTrafficAnnotationTag& traffic_annotation) override;
 
   // AsyncSocket:
   void OnReadComplete(const MockRead& data) override;
@@ -789,6 +814,10 @@ class MockTCPClientSocket : public MockClientSocket, public AsyncSocket {
     enable_read_if_ready_ = enable_read_if_ready;
   }
 
+  void set_enable_write_v(bool enable_write_v) {
+    enable_write_v_ = enable_write_v;
+  }
+
  private:
   void RetryRead(int rv);
   int ReadIfReadyImpl(IOBuffer* buf,
@@ -826,6 +855,9 @@ class MockTCPClientSocket : public MockClientSocket, public AsyncSocket {
   // ERR_READ_IF_READY_NOT_IMPLEMENTED.
   bool enable_read_if_ready_;
 
+  // If true, SupportsWriteV() returns true.
+  bool enable_write_v_ = false;
+
   BeforeConnectCallback before_connect_callback_;
 
   ConnectionAttempts connection_attempts_;
@@ -939,6 +971,15 @@ class MockSSLClientSocket : public AsyncSocket, public SSLClientSocket {
   void ClearConnectionAttempts() override {}
   void AddConnectionAttempts(const ConnectionAttempts& attempts) override {}
   int64_t GetTotalReceivedBytes() const override;
+  // WriteV() is forwarded to the transport socket, so that the code above
+  // the mock can be tested with sockets that support it.
+  bool SupportsWriteV() const override;
+  int WriteV(IOBuffer* header,
+             int header_len,
+             IOBuffer* payload,
+             int payload_len,
+             CompletionOnceCallback callback,
+             const NetworkTrafficAnnotationTag& traffic_annotation) override;
   int SetReceiveBufferSize(int32_t size) override;
   int SetSendBufferSize(int32_t size) override;
 
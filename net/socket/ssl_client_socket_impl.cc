@@ -648,6 +648,10 @@ int64_t SSLClientSocketImpl::GetTotalReceivedBytes() const {
   return stream_socket_->GetTotalReceivedBytes();
 }
 
+bool SSLClientSocketImpl::GetConnectionStats(ConnectionStats* stats) const {
+  return stream_socket_->GetConnectionStats(stats);
+}
+
 void SSLClientSocketImpl::DumpMemoryStats(SocketMemoryStats* stats) const {
   if (transport_adapter_)
     stats->buffer_size = transport_adapter_->GetAllocationSize();
@@ -27,4 +27,23 @@ int StreamSocket::ConfirmHandshake(CompletionOnceCallback callback) {
   return OK;
 }
 
+bool StreamSocket::SupportsWriteV() const {
+  return false;
+}
+
+int StreamSocket::WriteV(
+    IOBuffer* header,
+    int header_len,
+    IOBuffer* payload,
+    int payload_len,
+    CompletionOnceCallback callback,
+    const NetworkTrafficAnnotationTag& traffic_annotation) {
+  NOTREACHED();
+  return ERR_NOT_IMPLEMENTED;
+}
+
+bool StreamSocket::GetConnectionStats(ConnectionStats* stats) const {
+  return false;
+}
+
 }  // namespace net
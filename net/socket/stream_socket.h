@@ -18,6 +18,7 @@
 namespace net {
 
 class IPEndPoint;
+struct ConnectionStats;
 class NetLogWithSource;
 class SSLCertRequestInfo;
 class SSLInfo;
@@ -161,6 +162,27 @@ class NET_EXPORT StreamSocket : public Socket {
   // Disconnect() is called.
   virtual int64_t GetTotalReceivedBytes() const = 0;
 
+  // Returns true if the socket implements WriteV().
+  virtual bool SupportsWriteV() const;
+
+  // Like Write(), but writes |header_len| bytes of |header| followed by
+  // |payload_len| bytes of |payload| as if they were one buffer, without
+  // copying them together first. Both lengths must be positive. The number of
+  // bytes written may end in either buffer. Must only be called if
+  // SupportsWriteV() returns true.
+  virtual int WriteV(IOBuffer* header,
+                     int header_len,
+                     IOBuffer* payload,
+                     int payload_len,
+                     CompletionOnceCallback callback,
+                     const NetworkTrafficAnnotationTag& traffic_annotation);
+
+  // Fills |stats| with a snapshot of the transport-level state of the
+  // connection, such as its RTT, congestion window and retransmits. Returns
+  // false if the socket isn't connected or the platform doesn't expose them.
+  // The default implementation returns false.
+  virtual bool GetConnectionStats(ConnectionStats* stats) const;
+
   // Dumps memory allocation stats into |stats|. |stats| can be assumed as being
   // default initialized upon entry. Implementations should override fields in
   // |stats|. Default implementation does nothing.
@@ -12,6 +12,7 @@
 #include "base/memory/ptr_util.h"
 #include "base/metrics/histogram_macros.h"
 #include "base/time/time.h"
+#include "build/build_config.h"
 #include "net/base/io_buffer.h"
 #include "net/base/ip_endpoint.h"
 #include "net/base/net_errors.h"
@@ -381,6 +382,45 @@ void TCPClientSocket::ApplySocketTag(const SocketTag& tag) {
   socket_->ApplySocketTag(tag);
 }
 
+bool TCPClientSocket::SupportsWriteV() const {
+#if defined(OS_WIN)
+  return false;
+#else
+  return true;
+#endif
+}
+
+int TCPClientSocket::WriteV(
+    IOBuffer* header,
+    int header_len,
+    IOBuffer* payload,
+    int payload_len,
+    CompletionOnceCallback callback,
+    const NetworkTrafficAnnotationTag& traffic_annotation) {
+  DCHECK(!callback.is_null());
+#if defined(OS_WIN)
+  NOTREACHED();
+  return ERR_NOT_IMPLEMENTED;
+#else
+  // See Write() for why base::Unretained() is safe.
+  CompletionOnceCallback write_callback =
+      base::BindOnce(&TCPClientSocket::DidCompleteWrite, base::Unretained(this),
+                     std::move(callback));
+  int result = socket_->WriteV(header, header_len, payload, payload_len,
+                               std::move(write_callback), traffic_annotation);
+  if (result > 0)
+    was_ever_used_ = true;
+
+  return result;
+#endif
+}
+
+bool TCPClientSocket::GetConnectionStats(ConnectionStats* stats) const {
+  if (!IsConnected())
+    return false;
+  return socket_->GetConnectionStats(stats);
+}
+
 void TCPClientSocket::DidCompleteConnect(int result) {
   DCHECK_EQ(next_connect_state_, CONNECT_STATE_CONNECT_COMPLETE);
   DCHECK_NE(result, ERR_IO_PENDING);
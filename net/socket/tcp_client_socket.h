@@ -76,6 +76,14 @@ class NET_EXPORT TCPClientSocket : public TransportClientSocket {
   void AddConnectionAttempts(const ConnectionAttempts& attempts) override;
   int64_t GetTotalReceivedBytes() const override;
   void ApplySocketTag(const SocketTag& tag) override;
+  bool SupportsWriteV() const override;
+  int WriteV(IOBuffer* header,
+             int header_len,
+             IOBuffer* payload,
+             int payload_len,
+             CompletionOnceCallback callback,
+             const NetworkTrafficAnnotationTag& traffic_annotation) override;
+  bool GetConnectionStats(ConnectionStats* stats) const override;
 
   // Socket implementation.
   // Multiple outstanding requests are not supported.
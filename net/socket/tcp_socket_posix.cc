@@ -35,6 +35,7 @@
 #include "net/log/net_log_event_type.h"
 #include "net/log/net_log_source.h"
 #include "net/log/net_log_source_type.h"
+#include "net/socket/connection_stats.h"
 #include "net/socket/socket_net_log_params.h"
 #include "net/socket/socket_options.h"
 #include "net/socket/socket_posix.h"
@@ -137,6 +138,8 @@ TCPSocketPosix::TCPSocketPosix(
     NetLog* net_log,
     const NetLogSource& source)
     : socket_performance_watcher_(std::move(socket_performance_watcher)),
+      total_bytes_read_(0),
+      total_bytes_written_(0),
       logging_multiple_connect_attempts_(false),
       net_log_(NetLogWithSource::Make(net_log, NetLogSourceType::SOCKET)) {
   net_log_.BeginEvent(NetLogEventType::SOCKET_ALIVE,
@@ -323,6 +326,27 @@ int TCPSocketPosix::Write(
   return rv;
 }
 
+int TCPSocketPosix::WriteV(
+    IOBuffer* header,
+    int header_len,
+    IOBuffer* payload,
+    int payload_len,
+    CompletionOnceCallback callback,
+    const NetworkTrafficAnnotationTag& traffic_annotation) {
+  DCHECK(socket_);
+  DCHECK(!callback.is_null());
+
+  CompletionOnceCallback write_callback = base::BindOnce(
+      &TCPSocketPosix::WriteVCompleted, base::Unretained(this),
+      base::WrapRefCounted(header), header_len, base::WrapRefCounted(payload),
+      std::move(callback));
+  int rv = socket_->WriteV(header, header_len, payload, payload_len,
+                           std::move(write_callback), traffic_annotation);
+  if (rv != ERR_IO_PENDING)
+    rv = HandleWriteVCompleted(header, header_len, payload, rv);
+  return rv;
+}
+
 int TCPSocketPosix::GetLocalAddress(IPEndPoint* address) const {
   DCHECK(address);
 
@@ -586,8 +610,10 @@ int TCPSocketPosix::HandleReadCompleted(IOBuffer* buf, int rv) {
     return rv;
 
   // Notify the watcher only if at least 1 byte was read.
-  if (rv > 0)
+  if (rv > 0) {
+    total_bytes_read_ += rv;
     NotifySocketPerformanceWatcher();
+  }
 
   net_log_.AddByteTransferEvent(NetLogEventType::SOCKET_BYTES_RECEIVED, rv,
                                 buf->data());
@@ -618,8 +644,10 @@ int TCPSocketPosix::HandleWriteCompleted(IOBuffer* buf, int rv) {
   }
 
   // Notify the watcher only if at least 1 byte was written.
-  if (rv > 0)
+  if (rv > 0) {
+    total_bytes_written_ += rv;
     NotifySocketPerformanceWatcher();
+  }
 
   net_log_.AddByteTransferEvent(NetLogEventType::SOCKET_BYTES_SENT, rv,
                                 buf->data());
@@ -627,14 +655,45 @@ int TCPSocketPosix::HandleWriteCompleted(IOBuffer* buf, int rv) {
   return rv;
 }
 
+void TCPSocketPosix::WriteVCompleted(const scoped_refptr<IOBuffer>& header,
+                                     int header_len,
+                                     const scoped_refptr<IOBuffer>& payload,
+                                     CompletionOnceCallback callback,
+                                     int rv) {
+  DCHECK_NE(ERR_IO_PENDING, rv);
+  std::move(callback).Run(
+      HandleWriteVCompleted(header.get(), header_len, payload.get(), rv));
+}
+
+int TCPSocketPosix::HandleWriteVCompleted(IOBuffer* header,
+                                          int header_len,
+                                          IOBuffer* payload,
+                                          int rv) {
+  if (rv <= header_len)
+    return HandleWriteCompleted(header, rv);
+
+  // Log the bytes of each buffer separately, so that the NetLog shows them as
+  // if they were written by two writes.
+  HandleWriteCompleted(header, header_len);
+  HandleWriteCompleted(payload, rv - header_len);
+  return rv;
+}
+
 void TCPSocketPosix::NotifySocketPerformanceWatcher() {
 #if defined(HAVE_TCP_INFO)
+  if (!socket_performance_watcher_)
+    return;
+
+  if (socket_performance_watcher_->ShouldNotifyConnectionStats()) {
+    ConnectionStats stats;
+    if (GetConnectionStats(&stats))
+      socket_performance_watcher_->OnConnectionStatsAvailable(stats);
+  }
+
   // Check if |socket_performance_watcher_| is interested in receiving a RTT
   // update notification.
-  if (!socket_performance_watcher_ ||
-      !socket_performance_watcher_->ShouldNotifyUpdatedRTT()) {
+  if (!socket_performance_watcher_->ShouldNotifyUpdatedRTT())
     return;
-  }
 
   base::TimeDelta rtt = GetTransportRtt(socket_->socket_fd());
   if (rtt.is_zero())
@@ -659,4 +718,35 @@ bool TCPSocketPosix::GetEstimatedRoundTripTime(base::TimeDelta* out_rtt) const {
   return false;
 }
 
+bool TCPSocketPosix::GetConnectionStats(ConnectionStats* stats) const {
+  DCHECK(stats);
+  if (!socket_)
+    return false;
+
+#if defined(HAVE_TCP_INFO)
+  tcp_info info;
+  socklen_t info_len = sizeof(tcp_info);
+  if (getsockopt(socket_->socket_fd(), IPPROTO_TCP, TCP_INFO, &info,
+                 &info_len) != 0 ||
+      info_len < static_cast<socklen_t>(sizeof(tcp_info))) {
+    return false;
+  }
+
+  stats->transport = ConnectionStats::Transport::kTcp;
+  stats->time = base::TimeTicks::Now();
+  GetPeerAddress(&stats->peer_address);
+  stats->bytes_sent = total_bytes_written_;
+  stats->bytes_received = total_bytes_read_;
+  stats->smoothed_rtt = base::TimeDelta::FromMicroseconds(info.tcpi_rtt);
+  stats->rtt_variance = base::TimeDelta::FromMicroseconds(info.tcpi_rttvar);
+  stats->congestion_window_bytes =
+      static_cast<uint64_t>(info.tcpi_snd_cwnd) * info.tcpi_snd_mss;
+#if defined(OS_LINUX) || defined(OS_ANDROID)
+  stats->retransmits = info.tcpi_total_retrans;
+#endif
+  return true;
+#endif  // defined(TCP_INFO)
+  return false;
+}
+
 }  // namespace net
@@ -28,6 +28,7 @@ class TimeDelta;
 namespace net {
 
 class AddressList;
+struct ConnectionStats;
 class IOBuffer;
 class IPEndPoint;
 class SocketPosix;
@@ -97,6 +98,14 @@ class NET_EXPORT TCPSocketPosix {
             int buf_len,
             CompletionOnceCallback callback,
             const NetworkTrafficAnnotationTag& traffic_annotation);
+  // Writes |header| followed by |payload| with a single gather write.
+  // Returns a net error code.
+  int WriteV(IOBuffer* header,
+             int header_len,
+             IOBuffer* payload,
+             int payload_len,
+             CompletionOnceCallback callback,
+             const NetworkTrafficAnnotationTag& traffic_annotation);
 
   // Copies the local tcp address into |address| and returns a net error code.
   int GetLocalAddress(IPEndPoint* address) const;
@@ -123,6 +132,9 @@ class NET_EXPORT TCPSocketPosix {
   bool GetEstimatedRoundTripTime(base::TimeDelta* out_rtt) const
       WARN_UNUSED_RESULT;
 
+  // Fills |stats| from TCP_INFO. Returns false if TCP_INFO is unavailable.
+  bool GetConnectionStats(ConnectionStats* stats) const;
+
   // Closes the socket.
   void Close();
 
@@ -192,6 +204,15 @@ class NET_EXPORT TCPSocketPosix {
                       CompletionOnceCallback callback,
                       int rv);
   int HandleWriteCompleted(IOBuffer* buf, int rv);
+  void WriteVCompleted(const scoped_refptr<IOBuffer>& header,
+                       int header_len,
+                       const scoped_refptr<IOBuffer>& payload,
+                       CompletionOnceCallback callback,
+                       int rv);
+  int HandleWriteVCompleted(IOBuffer* header,
+                            int header_len,
+                            IOBuffer* payload,
+                            int rv);
 
   // Notifies |socket_performance_watcher_| of the latest RTT estimate available
   // from the tcp_info struct for this TCP socket.
@@ -204,6 +225,10 @@ class NET_EXPORT TCPSocketPosix {
   // |socket_performance_watcher_|. May be nullptr.
   std::unique_ptr<SocketPerformanceWatcher> socket_performance_watcher_;
 
+  // Bytes read and written over the lifetime of |this|, for ConnectionStats.
+  uint64_t total_bytes_read_;
+  uint64_t total_bytes_written_;
+
   bool logging_multiple_connect_attempts_;
 
   NetLogWithSource net_log_;
@@ -7,6 +7,7 @@
 #include <stddef.h>
 #include <string.h>
 
+#include <algorithm>
 #include <memory>
 #include <string>
 #include <vector>
@@ -538,6 +539,107 @@ TEST_F(TCPSocketTest, DestroyWithPendingWrite) {
   run_loop.Run();
 }
 
+#if !defined(OS_WIN)
+// Writes a header and a payload with WriteV() through small socket buffers, so
+// that writes come up short and the socket fills up. Makes sure that every
+// byte arrives once and in order, whether a write ends in the header or in the
+// payload.
+TEST_F(TCPSocketTest, WriteVPartialWrites) {
+  ASSERT_NO_FATAL_FAILURE(SetUpListenIPv4());
+
+  TestCompletionCallback connect_callback;
+  TCPSocket connecting_socket(nullptr, nullptr, NetLogSource());
+  int result = connecting_socket.Open(ADDRESS_FAMILY_IPV4);
+  ASSERT_THAT(result, IsOk());
+  int connect_result =
+      connecting_socket.Connect(local_address_, connect_callback.callback());
+
+  TestCompletionCallback accept_callback;
+  std::unique_ptr<TCPSocket> accepted_socket;
+  IPEndPoint accepted_address;
+  result = socket_.Accept(&accepted_socket, &accepted_address,
+                          accept_callback.callback());
+  ASSERT_THAT(accept_callback.GetResult(result), IsOk());
+  ASSERT_TRUE(accepted_socket.get());
+  ASSERT_THAT(connect_callback.GetResult(connect_result), IsOk());
+
+  ASSERT_THAT(connecting_socket.SetSendBufferSize(4096), IsOk());
+  ASSERT_THAT(accepted_socket->SetReceiveBufferSize(4096), IsOk());
+
+  // Both parts are much larger than the socket buffers, so the first write
+  // ends in the header.
+  const int kHeaderSize = 256 * 1024;
+  const int kPayloadSize = 256 * 1024;
+  std::string expected;
+  for (int i = 0; i < kHeaderSize + kPayloadSize; ++i)
+    expected.push_back(static_cast<char>('a' + i % 26));
+  auto header = base::MakeRefCounted<DrainableIOBuffer>(
+      base::MakeRefCounted<StringIOBuffer>(expected.substr(0, kHeaderSize)),
+      kHeaderSize);
+  auto payload = base::MakeRefCounted<DrainableIOBuffer>(
+      base::MakeRefCounted<StringIOBuffer>(expected.substr(kHeaderSize)),
+      kPayloadSize);
+
+  std::string received;
+  const int kReadBufferSize = 16 * 1024;
+  auto read_buffer = base::MakeRefCounted<IOBufferWithSize>(kReadBufferSize);
+  bool saw_short_write = false;
+  bool saw_pending_write_v = false;
+  while (payload->BytesRemaining() > 0) {
+    TestCompletionCallback write_callback;
+    int remaining = header->BytesRemaining() + payload->BytesRemaining();
+    int write_result;
+    if (header->BytesRemaining() > 0) {
+      write_result = connecting_socket.WriteV(
+          header.get(), header->BytesRemaining(), payload.get(),
+          payload->BytesRemaining(), write_callback.callback(),
+          TRAFFIC_ANNOTATION_FOR_TESTS);
+      if (write_result == ERR_IO_PENDING)
+        saw_pending_write_v = true;
+    } else {
+      write_result = connecting_socket.Write(
+          payload.get(), payload->BytesRemaining(), write_callback.callback(),
+          TRAFFIC_ANNOTATION_FOR_TESTS);
+    }
+
+    // Nothing is read until the socket is full, then the other end drains it
+    // until the write completes.
+    if (write_result == ERR_IO_PENDING) {
+      while (!write_callback.have_result()) {
+        TestCompletionCallback read_callback;
+        int read_result =
+            accepted_socket->Read(read_buffer.get(), kReadBufferSize,
+                                  read_callback.callback());
+        read_result = read_callback.GetResult(read_result);
+        ASSERT_LT(0, read_result);
+        received.append(read_buffer->data(), read_result);
+      }
+      write_result = write_callback.WaitForResult();
+    }
+    ASSERT_LT(0, write_result);
+    ASSERT_LE(write_result, remaining);
+    if (write_result < remaining)
+      saw_short_write = true;
+
+    int header_bytes = std::min(write_result, header->BytesRemaining());
+    header->DidConsume(header_bytes);
+    payload->DidConsume(write_result - header_bytes);
+  }
+  EXPECT_TRUE(saw_short_write);
+  EXPECT_TRUE(saw_pending_write_v);
+
+  while (received.size() < expected.size()) {
+    TestCompletionCallback read_callback;
+    int read_result = accepted_socket->Read(
+        read_buffer.get(), kReadBufferSize, read_callback.callback());
+    read_result = read_callback.GetResult(read_result);
+    ASSERT_LT(0, read_result);
+    received.append(read_buffer->data(), read_result);
+  }
+  EXPECT_EQ(expected, received);
+}
+#endif  // !defined(OS_WIN)
+
 // If a ReadIfReady is pending, it's legal to cancel it and start reading later.
 TEST_F(TCPSocketTest, CancelPendingReadIfReady) {
   ASSERT_NO_FATAL_FAILURE(SetUpListenIPv4());
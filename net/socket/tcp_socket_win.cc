@@ -1045,6 +1045,11 @@ bool TCPSocketWin::GetEstimatedRoundTripTime(base::TimeDelta* out_rtt) const {
   return false;
 }
 
+bool TCPSocketWin::GetConnectionStats(ConnectionStats* stats) const {
+  DCHECK(stats);
+  return false;
+}
+
 void TCPSocketWin::ApplySocketTag(const SocketTag& tag) {
   // Windows does not support any specific SocketTags so fail if any non-default
   // tag is applied.
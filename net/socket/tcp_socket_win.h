@@ -26,6 +26,7 @@
 namespace net {
 
 class AddressList;
+struct ConnectionStats;
 class IOBuffer;
 class IPEndPoint;
 class NetLog;
@@ -96,6 +97,9 @@ class NET_EXPORT TCPSocketWin : public base::win::ObjectWatcher::Delegate {
   bool GetEstimatedRoundTripTime(base::TimeDelta* out_rtt) const
       WARN_UNUSED_RESULT;
 
+  // Not implemented on Windows, always returns false.
+  bool GetConnectionStats(ConnectionStats* stats) const;
+
   void Close();
 
   bool IsValid() const { return socket_ != INVALID_SOCKET; }
@@ -9,11 +9,15 @@
 
 #include "base/bind.h"
 #include "base/compiler_specific.h"
+#include "base/feature_list.h"
+#include "base/location.h"
 #include "base/logging.h"
 #include "base/metrics/histogram_macros.h"
 #include "base/strings/string_util.h"
+#include "base/threading/thread_task_runner_handle.h"
 #include "base/trace_event/trace_event.h"
 #include "base/values.h"
+#include "net/base/features.h"
 #include "net/base/ip_endpoint.h"
 #include "net/base/net_errors.h"
 #include "net/base/trace_constants.h"
@@ -21,6 +25,7 @@
 #include "net/log/net_log_event_type.h"
 #include "net/log/net_log_source_type.h"
 #include "net/log/net_log_with_source.h"
+#include "net/nqe/network_quality_estimator.h"
 #include "net/socket/client_socket_factory.h"
 #include "net/socket/client_socket_handle.h"
 #include "net/socket/socket_performance_watcher.h"
@@ -32,16 +37,28 @@ namespace net {
 
 namespace {
 
-// Returns true iff all addresses in |list| are in the IPv6 family.
-bool AddressListOnlyContainsIPv6(const AddressList& list) {
+// Bounds of the Connection Attempt Delay, from RFC 8305.
+constexpr base::TimeDelta kMinConnectionAttemptDelay =
+    base::TimeDelta::FromMilliseconds(100);
+constexpr base::TimeDelta kMaxConnectionAttemptDelay =
+    base::TimeDelta::FromSeconds(2);
+
+// Returns true iff all addresses in |list| are in the |family| family.
+bool AddressListOnlyContainsFamily(const AddressList& list,
+                                   AddressFamily family) {
   DCHECK(!list.empty());
   for (auto iter = list.begin(); iter != list.end(); ++iter) {
-    if (iter->GetFamily() != ADDRESS_FAMILY_IPV6)
+    if (iter->GetFamily() != family)
       return false;
   }
   return true;
 }
 
+// Returns true iff all addresses in |list| are in the IPv6 family.
+bool AddressListOnlyContainsIPv6(const AddressList& list) {
+  return AddressListOnlyContainsFamily(list, ADDRESS_FAMILY_IPV6);
+}
+
 }  // namespace
 
 TransportSocketParams::TransportSocketParams(
@@ -65,6 +82,10 @@ const int TransportConnectJob::kTimeoutInSeconds = 240;  // 4 minutes.
 // don't synchronize.
 const int TransportConnectJob::kIPv6FallbackTimerInMs = 300;
 
+const int TransportConnectJob::kConnectionAttemptDelayInMs = 250;
+
+const int TransportConnectJob::kResolutionDelayInMs = 50;
+
 std::unique_ptr<ConnectJob> TransportConnectJob::CreateTransportConnectJob(
     scoped_refptr<TransportSocketParams> transport_client_params,
     RequestPriority priority,
@@ -100,7 +121,9 @@ TransportConnectJob::TransportConnectJob(
                  NetLogEventType::TRANSPORT_CONNECT_JOB_CONNECT),
       params_(params),
       next_state_(STATE_NONE),
-      resolve_result_(OK) {
+      fallback_is_partial_(false),
+      resolve_result_(OK),
+      weak_ptr_factory_(this) {
   // This is only set for WebSockets.
   DCHECK(!common_connect_job_params->websocket_endpoint_lock_manager);
 }
@@ -143,6 +166,8 @@ ConnectionAttempts TransportConnectJob::GetConnectionAttempts() const {
                   connection_attempts_.end());
   attempts.insert(attempts.begin(), fallback_connection_attempts_.begin(),
                   fallback_connection_attempts_.end());
+  attempts.insert(attempts.begin(), partial_connection_attempts_.begin(),
+                  partial_connection_attempts_.end());
   return attempts;
 }
 
@@ -260,6 +285,14 @@ int TransportConnectJob::DoResolveHost() {
   parameters.initial_priority = priority();
   request_ = host_resolver()->CreateRequest(params_->destination(), net_log(),
                                             parameters);
+  // The resolution callback needs the complete results, so partial ones can
+  // only be used without it.
+  if (base::FeatureList::IsEnabled(features::kHappyEyeballsV2) &&
+      params_->host_resolution_callback().is_null()) {
+    request_->SetPartialResultsCallback(
+        base::BindOnce(&TransportConnectJob::OnPartialResolveResults,
+                       base::Unretained(this)));
+  }
 
   return request_->Start(base::BindOnce(&TransportConnectJob::OnIOComplete,
                                         base::Unretained(this)));
@@ -272,8 +305,37 @@ int TransportConnectJob::DoResolveHostComplete(int result) {
   // Overwrite connection start time, since for connections that do not go
   // through proxies, |connect_start| should not include dns lookup time.
   connect_timing_.connect_start = connect_timing_.dns_end;
-  resolve_result_ = result;
+  resolution_delay_timer_.Stop();
 
+  if (fallback_transport_socket_) {
+    // Already connecting to partial results. Keep doing so if there are no
+    // addresses of another family to try.
+    DCHECK(fallback_is_partial_);
+    AddressFamily partial_family = fallback_addresses_->front().GetFamily();
+    if (result != OK ||
+        AddressListOnlyContainsFamily(request_->GetAddressResults().value(),
+                                      partial_family)) {
+      next_state_ = STATE_TRANSPORT_CONNECT_COMPLETE;
+      return ERR_IO_PENDING;
+    }
+
+    // Per RFC 8305, wait for the Connection Attempt Delay after starting the
+    // previous attempt before starting the next one.
+    next_state_ = STATE_TRANSPORT_CONNECT;
+    base::TimeDelta delay = fallback_connect_start_time_ +
+                            GetConnectionAttemptDelay() -
+                            base::TimeTicks::Now();
+    if (delay > base::TimeDelta()) {
+      connection_attempt_delay_timer_.Start(
+          FROM_HERE, delay,
+          base::BindOnce(&TransportConnectJob::OnIOComplete,
+                         base::Unretained(this), OK));
+      return ERR_IO_PENDING;
+    }
+    return OK;
+  }
+
+  resolve_result_ = result;
   if (result != OK)
     return result;
   DCHECK(request_->GetAddressResults());
@@ -292,35 +354,29 @@ int TransportConnectJob::DoResolveHostComplete(int result) {
 
 int TransportConnectJob::DoTransportConnect() {
   next_state_ = STATE_TRANSPORT_CONNECT_COMPLETE;
-  // Create a |SocketPerformanceWatcher|, and pass the ownership.
-  std::unique_ptr<SocketPerformanceWatcher> socket_performance_watcher;
-  if (socket_performance_watcher_factory()) {
-    socket_performance_watcher =
-        socket_performance_watcher_factory()->CreateSocketPerformanceWatcher(
-            SocketPerformanceWatcherFactory::PROTOCOL_TCP,
-            request_->GetAddressResults().value());
+  AddressList addresses = request_->GetAddressResults().value();
+  // When already connecting to the partial results of one family, try the
+  // other family first.
+  if (fallback_transport_socket_ &&
+      fallback_addresses_->front().GetFamily() == ADDRESS_FAMILY_IPV6) {
+    MakeAddressListStartWithIPv4(&addresses);
   }
-  transport_socket_ = client_socket_factory()->CreateTransportClientSocket(
-      request_->GetAddressResults().value(),
-      std::move(socket_performance_watcher), net_log().net_log(),
-      net_log().source());
+  transport_socket_ = CreateTransportSocket(addresses);
 
   // If the list contains IPv6 and IPv4 addresses, and the first address
   // is IPv6, the IPv4 addresses will be tried as fallback addresses, per
   // "Happy Eyeballs" (RFC 6555).
   bool try_ipv6_connect_with_ipv4_fallback =
-      request_->GetAddressResults().value().front().GetFamily() ==
-          ADDRESS_FAMILY_IPV6 &&
-      !AddressListOnlyContainsIPv6(request_->GetAddressResults().value());
-
-  transport_socket_->ApplySocketTag(socket_tag());
+      !fallback_transport_socket_ &&
+      addresses.front().GetFamily() == ADDRESS_FAMILY_IPV6 &&
+      !AddressListOnlyContainsIPv6(addresses);
 
   int rv = transport_socket_->Connect(base::BindOnce(
       &TransportConnectJob::OnIOComplete, base::Unretained(this)));
   if (rv == ERR_IO_PENDING && try_ipv6_connect_with_ipv4_fallback) {
     fallback_timer_.Start(
-        FROM_HERE, base::TimeDelta::FromMilliseconds(kIPv6FallbackTimerInMs),
-        this, &TransportConnectJob::DoIPv6FallbackTransportConnect);
+        FROM_HERE, GetConnectionAttemptDelay(), this,
+        &TransportConnectJob::DoIPv6FallbackTransportConnect);
   }
   return rv;
 }
@@ -336,6 +392,8 @@ int TransportConnectJob::DoTransportConnectComplete(int result) {
       fallback_transport_socket_->GetConnectionAttempts(&fallback_attempts);
       transport_socket_->AddConnectionAttempts(fallback_attempts);
     }
+    if (!partial_connection_attempts_.empty())
+      transport_socket_->AddConnectionAttempts(partial_connection_attempts_);
 
     bool is_ipv4 = request_->GetAddressResults().value().front().GetFamily() ==
                    ADDRESS_FAMILY_IPV4;
@@ -360,6 +418,7 @@ int TransportConnectJob::DoTransportConnectComplete(int result) {
   fallback_timer_.Stop();
   fallback_transport_socket_.reset();
   fallback_addresses_.reset();
+  fallback_is_partial_ = false;
 
   return result;
 }
@@ -379,19 +438,7 @@ void TransportConnectJob::DoIPv6FallbackTransportConnect() {
       new AddressList(request_->GetAddressResults().value()));
   MakeAddressListStartWithIPv4(fallback_addresses_.get());
 
-  // Create a |SocketPerformanceWatcher|, and pass the ownership.
-  std::unique_ptr<SocketPerformanceWatcher> socket_performance_watcher;
-  if (socket_performance_watcher_factory()) {
-    socket_performance_watcher =
-        socket_performance_watcher_factory()->CreateSocketPerformanceWatcher(
-            SocketPerformanceWatcherFactory::PROTOCOL_TCP,
-            *fallback_addresses_);
-  }
-
-  fallback_transport_socket_ =
-      client_socket_factory()->CreateTransportClientSocket(
-          *fallback_addresses_, std::move(socket_performance_watcher),
-          net_log().net_log(), net_log().source());
+  fallback_transport_socket_ = CreateTransportSocket(*fallback_addresses_);
   fallback_connect_start_time_ = base::TimeTicks::Now();
   int rv = fallback_transport_socket_->Connect(base::BindOnce(
       &TransportConnectJob::DoIPv6FallbackTransportConnectComplete,
@@ -401,8 +448,10 @@ void TransportConnectJob::DoIPv6FallbackTransportConnect() {
 }
 
 void TransportConnectJob::DoIPv6FallbackTransportConnectComplete(int result) {
-  // This should only happen when we're waiting for the main connect to succeed.
-  if (next_state_ != STATE_TRANSPORT_CONNECT_COMPLETE) {
+  // This should only happen when we're waiting for the main connect to succeed,
+  // or for the Connection Attempt Delay before starting it.
+  if (next_state_ != STATE_TRANSPORT_CONNECT_COMPLETE &&
+      !(fallback_is_partial_ && next_state_ == STATE_TRANSPORT_CONNECT)) {
     NOTREACHED();
     return;
   }
@@ -423,11 +472,25 @@ void TransportConnectJob::DoIPv6FallbackTransportConnectComplete(int result) {
       transport_socket_->GetConnectionAttempts(&attempts);
       fallback_transport_socket_->AddConnectionAttempts(attempts);
     }
+    if (!partial_connection_attempts_.empty()) {
+      fallback_transport_socket_->AddConnectionAttempts(
+          partial_connection_attempts_);
+    }
 
     connect_timing_.connect_start = fallback_connect_start_time_;
-    HistogramDuration(connect_timing_, RACE_IPV4_WINS);
+    HistogramDuration(connect_timing_,
+                      fallback_addresses_->front().GetFamily() ==
+                              ADDRESS_FAMILY_IPV4
+                          ? RACE_IPV4_WINS
+                          : RACE_IPV6_WINS);
     SetSocket(std::move(fallback_transport_socket_));
     next_state_ = STATE_NONE;
+  } else if (fallback_is_partial_ &&
+             (transport_socket_ || next_state_ == STATE_TRANSPORT_CONNECT)) {
+    // Partial results only cover one address family, so keep waiting for the
+    // main connect, which tries all addresses.
+    SavePartialConnectionAttempts();
+    return;
   } else {
     // Failure will be returned via |GetAdditionalErrorState|, so save
     // connection attempts from both sockets for use there.
@@ -442,6 +505,130 @@ void TransportConnectJob::DoIPv6FallbackTransportConnectComplete(int result) {
   NotifyDelegateOfCompletion(result);  // Deletes |this|
 }
 
+void TransportConnectJob::OnPartialResolveResults() {
+  DCHECK_EQ(STATE_RESOLVE_HOST_COMPLETE, next_state_);
+  const base::Optional<AddressList>& addresses =
+      request_->GetPartialAddressResults();
+  if (!addresses || addresses->empty())
+    return;
+
+  // Per RFC 8305, if the IPv4 addresses are available first, give the IPv6
+  // ones a short Resolution Delay to arrive, since they are preferred.
+  if (addresses->front().GetFamily() == ADDRESS_FAMILY_IPV4) {
+    resolution_delay_timer_.Start(
+        FROM_HERE, base::TimeDelta::FromMilliseconds(kResolutionDelayInMs),
+        this, &TransportConnectJob::StartPartialTransportConnect);
+    return;
+  }
+  StartPartialTransportConnect();
+}
+
+void TransportConnectJob::StartPartialTransportConnect() {
+  DCHECK_EQ(STATE_RESOLVE_HOST_COMPLETE, next_state_);
+  DCHECK(!fallback_transport_socket_);
+  DCHECK(request_->GetPartialAddressResults());
+
+  // The partial connect uses the fallback socket, so that it can race the
+  // main connect once host resolution completes.
+  fallback_is_partial_ = true;
+  fallback_addresses_ = std::make_unique<AddressList>(
+      request_->GetPartialAddressResults().value());
+  fallback_transport_socket_ = CreateTransportSocket(*fallback_addresses_);
+  fallback_connect_start_time_ = base::TimeTicks::Now();
+  int rv = fallback_transport_socket_->Connect(
+      base::BindOnce(&TransportConnectJob::OnPartialTransportConnectComplete,
+                     base::Unretained(this)));
+  if (rv != ERR_IO_PENDING) {
+    // This may be called by the host resolver, which must not be destroyed
+    // synchronously.
+    base::ThreadTaskRunnerHandle::Get()->PostTask(
+        FROM_HERE,
+        base::BindOnce(&TransportConnectJob::OnPartialTransportConnectComplete,
+                       weak_ptr_factory_.GetWeakPtr(), rv));
+  }
+}
+
+void TransportConnectJob::OnPartialTransportConnectComplete(int result) {
+  DCHECK_NE(ERR_IO_PENDING, result);
+  DCHECK(fallback_is_partial_);
+  if (next_state_ != STATE_RESOLVE_HOST_COMPLETE) {
+    // Host resolution has completed, so this is now a fallback connect.
+    DoIPv6FallbackTransportConnectComplete(result);
+    return;
+  }
+
+  if (result != OK) {
+    // Keep waiting for the complete results.
+    SavePartialConnectionAttempts();
+    return;
+  }
+
+  // Connected before host resolution completed. The partial results are all
+  // that was used of it.
+  connect_timing_.dns_end = fallback_connect_start_time_;
+  connect_timing_.connect_start = fallback_connect_start_time_;
+  HistogramDuration(connect_timing_,
+                    fallback_addresses_->front().GetFamily() ==
+                            ADDRESS_FAMILY_IPV4
+                        ? RACE_IPV4_SOLO
+                        : RACE_IPV6_SOLO);
+  if (!partial_connection_attempts_.empty()) {
+    fallback_transport_socket_->AddConnectionAttempts(
+        partial_connection_attempts_);
+  }
+  SetSocket(std::move(fallback_transport_socket_));
+  fallback_addresses_.reset();
+  next_state_ = STATE_NONE;
+
+  NotifyDelegateOfCompletion(OK);  // Deletes |this|
+}
+
+void TransportConnectJob::SavePartialConnectionAttempts() {
+  DCHECK(fallback_is_partial_);
+  ConnectionAttempts attempts;
+  fallback_transport_socket_->GetConnectionAttempts(&attempts);
+  partial_connection_attempts_.insert(partial_connection_attempts_.end(),
+                                      attempts.begin(), attempts.end());
+  fallback_transport_socket_.reset();
+  fallback_addresses_.reset();
+  fallback_is_partial_ = false;
+}
+
+std::unique_ptr<StreamSocket> TransportConnectJob::CreateTransportSocket(
+    const AddressList& addresses) {
+  // Create a |SocketPerformanceWatcher|, and pass the ownership.
+  std::unique_ptr<SocketPerformanceWatcher> socket_performance_watcher;
+  if (socket_performance_watcher_factory()) {
+    socket_performance_watcher =
+        socket_performance_watcher_factory()->CreateSocketPerformanceWatcher(
+            SocketPerformanceWatcherFactory::PROTOCOL_TCP, addresses);
+  }
+  std::unique_ptr<StreamSocket> socket =
+      client_socket_factory()->CreateTransportClientSocket(
+          addresses, std::move(socket_performance_watcher),
+          net_log().net_log(), net_log().source());
+  socket->ApplySocketTag(socket_tag());
+  return socket;
+}
+
+base::TimeDelta TransportConnectJob::GetConnectionAttemptDelay() {
+  if (!base::FeatureList::IsEnabled(features::kHappyEyeballsV2))
+    return base::TimeDelta::FromMilliseconds(kIPv6FallbackTimerInMs);
+
+  // RFC 8305 recommends a default Connection Attempt Delay of 250ms, or
+  // deriving it from the RTT when known.
+  base::TimeDelta delay =
+      base::TimeDelta::FromMilliseconds(kConnectionAttemptDelayInMs);
+  if (network_quality_estimator()) {
+    base::Optional<base::TimeDelta> rtt =
+        network_quality_estimator()->GetTransportRTT();
+    if (rtt)
+      delay = rtt.value() * 2;
+  }
+  return std::min(std::max(delay, kMinConnectionAttemptDelay),
+                  kMaxConnectionAttemptDelay);
+}
+
 int TransportConnectJob::ConnectInternal() {
   next_state_ = STATE_RESOLVE_HOST;
   return DoLoop(OK);
@@ -10,6 +10,7 @@
 
 #include "base/macros.h"
 #include "base/memory/ref_counted.h"
+#include "base/memory/weak_ptr.h"
 #include "base/time/time.h"
 #include "base/timer/timer.h"
 #include "net/base/host_port_pair.h"
@@ -61,6 +62,11 @@ class NET_EXPORT_PRIVATE TransportSocketParams
 // (kIPv6FallbackTimerInMs) and start a connect() to a IPv4 address if the timer
 // fires. Then we race the IPv4 connect() against the IPv6 connect() (which has
 // a headstart) and return the one that completes first to the socket pool.
+//
+// With features::kHappyEyeballsV2, this follows Happy Eyeballs v2 (RFC 8305)
+// instead: connecting starts as soon as the host resolver has the addresses
+// of one family, after a short Resolution Delay for IPv4 ones, and the
+// fallback connect() starts after the RTT-based Connection Attempt Delay.
 class NET_EXPORT_PRIVATE TransportConnectJob : public ConnectJob {
  public:
   // For recording the connection time in the appropriate bucket.
@@ -81,6 +87,14 @@ class NET_EXPORT_PRIVATE TransportConnectJob : public ConnectJob {
   // IPv4 addresses after this many milliseconds. (This is "Happy Eyeballs".)
   static const int kIPv6FallbackTimerInMs;
 
+  // The default Connection Attempt Delay of Happy Eyeballs v2, used instead of
+  // kIPv6FallbackTimerInMs when the RTT is unknown.
+  static const int kConnectionAttemptDelayInMs;
+
+  // With Happy Eyeballs v2, how long to wait for IPv6 addresses when the IPv4
+  // ones are resolved first, before connecting to the latter.
+  static const int kResolutionDelayInMs;
+
   // Creates a TransportConnectJob or WebSocketTransportConnectJob, depending on
   // whether or not |common_connect_job_params.web_socket_endpoint_lock_manager|
   // is nullptr.
@@ -139,6 +153,21 @@ class NET_EXPORT_PRIVATE TransportConnectJob : public ConnectJob {
   void DoIPv6FallbackTransportConnect();
   void DoIPv6FallbackTransportConnectComplete(int result);
 
+  // Called when the host resolver has the addresses of one family, to start
+  // connecting to them on the fallback socket while resolution continues.
+  void OnPartialResolveResults();
+  void StartPartialTransportConnect();
+  void OnPartialTransportConnectComplete(int result);
+  // Saves the attempts of a failed partial connect and discards its socket.
+  void SavePartialConnectionAttempts();
+
+  std::unique_ptr<StreamSocket> CreateTransportSocket(
+      const AddressList& addresses);
+
+  // Returns how long to wait for a connect() before starting the next one to
+  // another address family.
+  base::TimeDelta GetConnectionAttemptDelay();
+
   // Begins the host resolution and the TCP connect.  Returns OK on success
   // and ERR_IO_PENDING if it cannot immediately service the request.
   // Otherwise, it returns a net error code.
@@ -161,6 +190,14 @@ class NET_EXPORT_PRIVATE TransportConnectJob : public ConnectJob {
   std::unique_ptr<AddressList> fallback_addresses_;
   base::TimeTicks fallback_connect_start_time_;
   base::OneShotTimer fallback_timer_;
+  // Whether the fallback socket connects to partial host resolution results,
+  // which only have the addresses of one family.
+  bool fallback_is_partial_;
+
+  // Happy Eyeballs v2 timers, see kResolutionDelayInMs and
+  // GetConnectionAttemptDelay().
+  base::OneShotTimer resolution_delay_timer_;
+  base::OneShotTimer connection_attempt_delay_timer_;
 
   int resolve_result_;
 
@@ -171,6 +208,10 @@ class NET_EXPORT_PRIVATE TransportConnectJob : public ConnectJob {
   // it is returned.)
   ConnectionAttempts connection_attempts_;
   ConnectionAttempts fallback_connection_attempts_;
+  // Attempts of failed partial connects, which don't end the ConnectJob.
+  ConnectionAttempts partial_connection_attempts_;
+
+  base::WeakPtrFactory<TransportConnectJob> weak_ptr_factory_;
 
   DISALLOW_COPY_AND_ASSIGN(TransportConnectJob);
 };
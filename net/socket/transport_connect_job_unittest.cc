@@ -8,9 +8,11 @@
 
 #include "base/macros.h"
 #include "base/memory/ref_counted.h"
+#include "base/test/scoped_feature_list.h"
 #include "base/test/scoped_task_environment.h"
 #include "net/base/address_family.h"
 #include "net/base/address_list.h"
+#include "net/base/features.h"
 #include "net/base/ip_address.h"
 #include "net/base/ip_endpoint.h"
 #include "net/base/net_errors.h"
@@ -389,5 +391,112 @@ TEST_F(TransportConnectJobTest, IPv4HasNoFallback) {
   EXPECT_EQ(1, client_socket_factory_.allocation_count());
 }
 
+// With Happy Eyeballs v2, connecting starts with the IPv6 addresses when they
+// are resolved first, without waiting for the IPv4 ones.
+TEST_F(TransportConnectJobTest, HappyEyeballsV2ConnectsToPartialResults) {
+  base::test::ScopedFeatureList feature_list;
+  feature_list.InitAndEnableFeature(features::kHappyEyeballsV2);
+  client_socket_factory_.set_default_client_socket_type(
+      MockTransportClientSocketFactory::MOCK_PENDING_CLIENT_SOCKET);
+  host_resolver_.set_ondemand_mode(true);
+  host_resolver_.rules()->AddIPLiteralRule(kHostName, "2:abcd::3:4:ff,2.2.2.2",
+                                           std::string());
+
+  TestConnectJobDelegate test_delegate;
+  TransportConnectJob transport_connect_job(
+      DEFAULT_PRIORITY, SocketTag(), &common_connect_job_params_,
+      DefaultParams(), &test_delegate, nullptr /* net_log */);
+  ASSERT_THAT(transport_connect_job.Connect(), test::IsError(ERR_IO_PENDING));
+
+  host_resolver_.ResolvePartiallyNow(host_resolver_.last_id(),
+                                     ADDRESS_FAMILY_IPV6);
+  EXPECT_EQ(1, client_socket_factory_.allocation_count());
+  EXPECT_THAT(test_delegate.WaitForResult(), test::IsOk());
+
+  IPEndPoint endpoint;
+  test_delegate.socket()->GetLocalAddress(&endpoint);
+  EXPECT_TRUE(endpoint.address().IsIPv6());
+  EXPECT_EQ(1, client_socket_factory_.allocation_count());
+}
+
+// When the IPv4 addresses are resolved first, the IPv6 ones are given the
+// Resolution Delay to arrive, and preferred if they do.
+TEST_F(TransportConnectJobTest, HappyEyeballsV2ResolutionDelay) {
+  base::test::ScopedFeatureList feature_list;
+  feature_list.InitAndEnableFeature(features::kHappyEyeballsV2);
+  client_socket_factory_.set_default_client_socket_type(
+      MockTransportClientSocketFactory::MOCK_PENDING_CLIENT_SOCKET);
+  host_resolver_.set_ondemand_mode(true);
+  host_resolver_.rules()->AddIPLiteralRule(kHostName, "2:abcd::3:4:ff,2.2.2.2",
+                                           std::string());
+
+  TestConnectJobDelegate test_delegate;
+  TransportConnectJob transport_connect_job(
+      DEFAULT_PRIORITY, SocketTag(), &common_connect_job_params_,
+      DefaultParams(), &test_delegate, nullptr /* net_log */);
+  ASSERT_THAT(transport_connect_job.Connect(), test::IsError(ERR_IO_PENDING));
+
+  host_resolver_.ResolvePartiallyNow(host_resolver_.last_id(),
+                                     ADDRESS_FAMILY_IPV4);
+  FastForwardBy(base::TimeDelta::FromMilliseconds(
+                    TransportConnectJob::kResolutionDelayInMs) -
+                base::TimeDelta::FromMicroseconds(1));
+  EXPECT_EQ(0, client_socket_factory_.allocation_count());
+
+  host_resolver_.ResolveOnlyRequestNow();
+  EXPECT_THAT(test_delegate.WaitForResult(), test::IsOk());
+  IPEndPoint endpoint;
+  test_delegate.socket()->GetLocalAddress(&endpoint);
+  EXPECT_TRUE(endpoint.address().IsIPv6());
+  EXPECT_EQ(1, client_socket_factory_.allocation_count());
+}
+
+// If the connect to the partial results is slow, the other family is tried
+// after the Connection Attempt Delay once resolution completes.
+TEST_F(TransportConnectJobTest, HappyEyeballsV2ConnectionAttemptDelay) {
+  base::test::ScopedFeatureList feature_list;
+  feature_list.InitAndEnableFeature(features::kHappyEyeballsV2);
+  MockTransportClientSocketFactory::ClientSocketType case_types[] = {
+      // This is the IPv6 socket, connecting to the partial results. It stalls,
+      // but presents one failed connection attempt on GetConnectionAttempts.
+      MockTransportClientSocketFactory::MOCK_STALLED_FAILING_CLIENT_SOCKET,
+      // This is the socket for all addresses, IPv4 first.
+      MockTransportClientSocketFactory::MOCK_PENDING_CLIENT_SOCKET};
+  client_socket_factory_.set_client_socket_types(case_types, 2);
+  host_resolver_.set_ondemand_mode(true);
+  host_resolver_.rules()->AddIPLiteralRule(kHostName, "2:abcd::3:4:ff,2.2.2.2",
+                                           std::string());
+
+  TestConnectJobDelegate test_delegate;
+  TransportConnectJob transport_connect_job(
+      DEFAULT_PRIORITY, SocketTag(), &common_connect_job_params_,
+      DefaultParams(), &test_delegate, nullptr /* net_log */);
+  ASSERT_THAT(transport_connect_job.Connect(), test::IsError(ERR_IO_PENDING));
+
+  host_resolver_.ResolvePartiallyNow(host_resolver_.last_id(),
+                                     ADDRESS_FAMILY_IPV6);
+  EXPECT_EQ(1, client_socket_factory_.allocation_count());
+  host_resolver_.ResolveOnlyRequestNow();
+  FastForwardBy(base::TimeDelta::FromMilliseconds(
+                    TransportConnectJob::kConnectionAttemptDelayInMs) -
+                base::TimeDelta::FromMicroseconds(1));
+  EXPECT_EQ(1, client_socket_factory_.allocation_count());
+  EXPECT_FALSE(test_delegate.has_result());
+
+  FastForwardBy(base::TimeDelta::FromMicroseconds(1));
+  EXPECT_EQ(2, client_socket_factory_.allocation_count());
+  EXPECT_THAT(test_delegate.WaitForResult(), test::IsOk());
+  IPEndPoint endpoint;
+  test_delegate.socket()->GetLocalAddress(&endpoint);
+  EXPECT_TRUE(endpoint.address().IsIPv4());
+
+  // The failed attempt on the partial results' socket is collected.
+  ConnectionAttempts attempts;
+  test_delegate.socket()->GetConnectionAttempts(&attempts);
+  ASSERT_EQ(1u, attempts.size());
+  EXPECT_THAT(attempts[0].result, test::IsError(ERR_CONNECTION_FAILED));
+  EXPECT_TRUE(attempts[0].endpoint.address().IsIPv6());
+}
+
 }  // namespace
 }  // namespace net
@@ -86,6 +86,19 @@ int UDPClientSocket::Read(IOBuffer* buf,
   return socket_.Read(buf, buf_len, std::move(callback));
 }
 
+int UDPClientSocket::ReadMultiple(IOBuffer* buf,
+                                  int packet_len,
+                                  int max_packets,
+                                  std::vector<int>* packet_lengths,
+                                  CompletionOnceCallback callback) {
+#if defined(OS_POSIX)
+  return socket_.ReadMultiple(buf, packet_len, max_packets, packet_lengths,
+                              std::move(callback));
+#else
+  return ERR_NOT_IMPLEMENTED;
+#endif
+}
+
 int UDPClientSocket::Write(
     IOBuffer* buf,
     int buf_len,
@@ -175,6 +188,12 @@ void UDPClientSocket::SetSendmmsgEnabled(bool enabled) {
   socket_.SetSendmmsgEnabled(enabled);
 }
 
+void UDPClientSocket::SetUdpGsoEnabled(bool enabled) {
+#if defined(OS_POSIX)
+  socket_.SetUdpGsoEnabled(enabled);
+#endif
+}
+
 void UDPClientSocket::SetWriteBatchingActive(bool active) {
   socket_.SetWriteBatchingActive(active);
 }
@@ -36,6 +36,11 @@ class NET_EXPORT_PRIVATE UDPClientSocket : public DatagramClientSocket {
   int Read(IOBuffer* buf,
            int buf_len,
            CompletionOnceCallback callback) override;
+  int ReadMultiple(IOBuffer* buf,
+                   int packet_len,
+                   int max_packets,
+                   std::vector<int>* packet_lengths,
+                   CompletionOnceCallback callback) override;
   int Write(IOBuffer* buf,
             int buf_len,
             CompletionOnceCallback callback,
@@ -71,6 +76,7 @@ class NET_EXPORT_PRIVATE UDPClientSocket : public DatagramClientSocket {
   void SetMaxPacketSize(size_t max_packet_size) override;
   void SetWriteMultiCoreEnabled(bool enabled) override;
   void SetSendmmsgEnabled(bool enabled) override;
+  void SetUdpGsoEnabled(bool enabled) override;
   void SetWriteBatchingActive(bool active) override;
   int SetMulticastInterface(uint32_t interface_index) override;
 
@@ -2,11 +2,14 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include <vector>
+
 #include "base/bind.h"
 #include "base/memory/weak_ptr.h"
 #include "base/message_loop/message_loop.h"
 #include "base/run_loop.h"
 #include "base/test/perf_time_logger.h"
+#include "build/build_config.h"
 #include "net/base/io_buffer.h"
 #include "net/base/ip_endpoint.h"
 #include "net/base/net_errors.h"
@@ -49,6 +52,10 @@ class UDPSocketPerfTest : public PlatformTest {
   // has effect on Windows.
   void WriteBenchmark(bool use_nonblocking_io);
 
+  // Reads bursts of packets sent by a server with ReadMultiple() if
+  // |read_multiple| is true, one Read() per packet otherwise.
+  void ReadBenchmark(bool read_multiple);
+
  protected:
   static const int kPacketSize = 1024;
   scoped_refptr<IOBufferWithSize> buffer_;
@@ -126,6 +133,64 @@ void UDPSocketPerfTest::WriteBenchmark(bool use_nonblocking_io) {
   LOG(INFO) << "Write speed: " << packets / 1024 / elapsed << " MB/s";
 }
 
+void UDPSocketPerfTest::ReadBenchmark(bool read_multiple) {
+  base::MessageLoopForIO message_loop;
+  const int kBurstSize = 64;
+  const int kReadBatchSize = 16;
+  const int kBursts = 2000;
+
+  IPEndPoint bind_address;
+  CreateUDPAddress("127.0.0.1", 0, &bind_address);
+  UDPServerSocket server(nullptr, NetLogSource());
+  ASSERT_THAT(server.Listen(bind_address), IsOk());
+  IPEndPoint server_address;
+  ASSERT_THAT(server.GetLocalAddress(&server_address), IsOk());
+
+  UDPClientSocket client(DatagramSocket::DEFAULT_BIND, nullptr,
+                         NetLogSource());
+  ASSERT_THAT(client.Connect(server_address), IsOk());
+  ASSERT_THAT(client.SetReceiveBufferSize(kBurstSize * kPacketSize * 4),
+              IsOk());
+  IPEndPoint client_address;
+  ASSERT_THAT(client.GetLocalAddress(&client_address), IsOk());
+
+  memset(buffer_->data(), 'R', kPacketSize);
+  scoped_refptr<IOBufferWithSize> read_buffer =
+      base::MakeRefCounted<IOBufferWithSize>(kPacketSize * kReadBatchSize);
+  std::vector<int> packet_lengths;
+  base::TimeDelta elapsed;
+  for (int burst = 0; burst < kBursts; ++burst) {
+    for (int i = 0; i < kBurstSize; ++i) {
+      TestCompletionCallback callback;
+      int rv = server.SendTo(buffer_.get(), kPacketSize, client_address,
+                             callback.callback());
+      ASSERT_EQ(kPacketSize, callback.GetResult(rv));
+    }
+
+    base::TimeTicks start_ticks = base::TimeTicks::Now();
+    int packets_read = 0;
+    while (packets_read < kBurstSize) {
+      TestCompletionCallback callback;
+      if (read_multiple) {
+        int rv = callback.GetResult(client.ReadMultiple(
+            read_buffer.get(), kPacketSize, kReadBatchSize, &packet_lengths,
+            callback.callback()));
+        ASSERT_GT(rv, 0);
+        packets_read += rv;
+      } else {
+        int rv = callback.GetResult(
+            client.Read(read_buffer.get(), kPacketSize, callback.callback()));
+        ASSERT_EQ(kPacketSize, rv);
+        ++packets_read;
+      }
+    }
+    elapsed += base::TimeTicks::Now() - start_ticks;
+  }
+
+  LOG(INFO) << "Read speed: " << kBursts * kBurstSize / elapsed.InSecondsF()
+            << " packets/s";
+}
+
 TEST_F(UDPSocketPerfTest, Write) {
   base::PerfTimeLogger timer("UDP_socket_write");
   WriteBenchmark(false);
@@ -136,6 +201,18 @@ TEST_F(UDPSocketPerfTest, WriteNonBlocking) {
   WriteBenchmark(true);
 }
 
+TEST_F(UDPSocketPerfTest, Read) {
+  base::PerfTimeLogger timer("UDP_socket_read");
+  ReadBenchmark(false);
+}
+
+#if defined(OS_POSIX)
+TEST_F(UDPSocketPerfTest, ReadMultiple) {
+  base::PerfTimeLogger timer("UDP_socket_read_multiple");
+  ReadBenchmark(true);
+}
+#endif
+
 }  // namespace
 
 }  // namespace net
@@ -11,6 +11,10 @@
 #include <netinet/in.h>
 #include <sys/ioctl.h>
 
+#if HAVE_SENDMMSG
+#include <netinet/udp.h>
+#endif
+
 #include "base/bind.h"
 #include "base/callback.h"
 #include "base/callback_helpers.h"
@@ -69,6 +73,18 @@ const int kActivityMonitorMinimumSamplesForThroughputEstimate = 2;
 const base::TimeDelta kActivityMonitorMsThreshold =
     base::TimeDelta::FromMilliseconds(100);
 
+#if HAVE_SENDMMSG
+#if !defined(UDP_SEGMENT)
+// From linux/udp.h, missing from older headers.
+#define UDP_SEGMENT 103
+#endif
+
+// Limits of the kernel for a single UDP_SEGMENT send: UDP_MAX_SEGMENTS, and
+// the maximum payload of a UDP datagram, minus some room for headers.
+const size_t kMaxGsoSegments = 64;
+const size_t kMaxGsoBytes = 65000;
+#endif  // HAVE_SENDMMSG
+
 #if defined(OS_MACOSX)
 // When enabling multicast using setsockopt(IP_MULTICAST_IF) MacOS
 // requires passing IPv4 address instead of interface index. This function
@@ -197,6 +213,8 @@ UDPSocketPosix::UDPSocketPosix(DatagramSocket::BindType bind_type,
       write_async_outstanding_(0),
       read_buf_len_(0),
       recv_from_address_(NULL),
+      read_max_packets_(0),
+      read_packet_lengths_(nullptr),
       write_buf_len_(0),
       net_log_(NetLogWithSource::Make(net_log, NetLogSourceType::UDP_SOCKET)),
       bound_network_(NetworkChangeNotifier::kInvalidNetworkHandle),
@@ -301,6 +319,8 @@ void UDPSocketPosix::Close() {
   read_buf_len_ = 0;
   read_callback_.Reset();
   recv_from_address_ = NULL;
+  read_max_packets_ = 0;
+  read_packet_lengths_ = nullptr;
   write_buf_ = NULL;
   write_buf_len_ = 0;
   write_callback_.Reset();
@@ -379,6 +399,43 @@ int UDPSocketPosix::Read(IOBuffer* buf,
   return RecvFrom(buf, buf_len, NULL, std::move(callback));
 }
 
+int UDPSocketPosix::ReadMultiple(IOBuffer* buf,
+                                 int packet_len,
+                                 int max_packets,
+                                 std::vector<int>* packet_lengths,
+                                 CompletionOnceCallback callback) {
+  DCHECK_CALLED_ON_VALID_THREAD(thread_checker_);
+  DCHECK_NE(kInvalidSocket, socket_);
+  CHECK(read_callback_.is_null());
+  DCHECK(is_connected_);
+  DCHECK(!callback.is_null());  // Synchronous operation not supported
+  DCHECK_GT(packet_len, 0);
+  DCHECK_GT(max_packets, 0);
+  DCHECK_LE(max_packets, kReadMultipleMaxPackets);
+  DCHECK(packet_lengths);
+
+  int result =
+      InternalReadMultiple(buf, packet_len, max_packets, packet_lengths);
+  if (result != ERR_IO_PENDING)
+    return result;
+
+  if (!base::MessageLoopCurrentForIO::Get()->WatchFileDescriptor(
+          socket_, true, base::MessagePumpForIO::WATCH_READ,
+          &read_socket_watcher_, &read_watcher_)) {
+    PLOG(ERROR) << "WatchFileDescriptor failed on read";
+    result = MapSystemError(errno);
+    LogRead(result, NULL, 0, NULL);
+    return result;
+  }
+
+  read_buf_ = buf;
+  read_buf_len_ = packet_len;
+  read_max_packets_ = max_packets;
+  read_packet_lengths_ = packet_lengths;
+  read_callback_ = std::move(callback);
+  return ERR_IO_PENDING;
+}
+
 int UDPSocketPosix::RecvFrom(IOBuffer* buf,
                              int buf_len,
                              IPEndPoint* address,
@@ -738,11 +795,17 @@ void UDPSocketPosix::DoWriteCallback(int rv) {
 
 void UDPSocketPosix::DidCompleteRead() {
   int result =
-      InternalRecvFrom(read_buf_.get(), read_buf_len_, recv_from_address_);
+      read_packet_lengths_
+          ? InternalReadMultiple(read_buf_.get(), read_buf_len_,
+                                 read_max_packets_, read_packet_lengths_)
+          : InternalRecvFrom(read_buf_.get(), read_buf_len_,
+                             recv_from_address_);
   if (result != ERR_IO_PENDING) {
     read_buf_ = NULL;
     read_buf_len_ = 0;
     recv_from_address_ = NULL;
+    read_max_packets_ = 0;
+    read_packet_lengths_ = nullptr;
     bool ok = read_socket_watcher_.StopWatchingFileDescriptor();
     DCHECK(ok);
     DoReadCallback(result);
@@ -880,6 +943,75 @@ int UDPSocketPosix::InternalRecvFromNonConnectedSocket(IOBuffer* buf,
   return result;
 }
 
+int UDPSocketPosix::InternalReadMultiple(IOBuffer* buf,
+                                         int packet_len,
+                                         int max_packets,
+                                         std::vector<int>* packet_lengths) {
+  DCHECK(remote_address_);
+  packet_lengths->clear();
+#if HAVE_RECVMMSG
+  base::StackVector<struct iovec, kReadMultipleMaxPackets> msg_iov;
+  base::StackVector<struct mmsghdr, kReadMultipleMaxPackets> msgvec;
+  for (int i = 0; i < max_packets; i++) {
+    msg_iov->push_back(
+        {buf->data() + i * packet_len, static_cast<size_t>(packet_len)});
+  }
+  for (int i = 0; i < max_packets; i++)
+    msgvec->push_back({{nullptr, 0, &msg_iov[i], 1, nullptr, 0, 0}, 0});
+
+  int count =
+      HANDLE_EINTR(recvmmsg(socket_, &msgvec[0], max_packets, 0, nullptr));
+  if (count < 0) {
+    if (errno == ENOSYS) {
+      return InternalReadMultipleWithRecvFrom(buf, packet_len, max_packets,
+                                              packet_lengths);
+    }
+    int result = MapSystemError(errno);
+    if (result != ERR_IO_PENDING)
+      LogRead(result, NULL, 0, NULL);
+    return result;
+  }
+
+  SockaddrStorage sock_addr;
+  bool success =
+      remote_address_->ToSockAddr(sock_addr.addr, &sock_addr.addr_len);
+  DCHECK(success);
+  for (int i = 0; i < count; i++) {
+    int result = (msgvec[i].msg_hdr.msg_flags & MSG_TRUNC)
+                     ? ERR_MSG_TOO_BIG
+                     : static_cast<int>(msgvec[i].msg_len);
+    LogRead(result, buf->data() + i * packet_len, sock_addr.addr_len,
+            sock_addr.addr);
+    packet_lengths->push_back(result);
+  }
+  return count;
+#else
+  return InternalReadMultipleWithRecvFrom(buf, packet_len, max_packets,
+                                          packet_lengths);
+#endif  // HAVE_RECVMMSG
+}
+
+int UDPSocketPosix::InternalReadMultipleWithRecvFrom(
+    IOBuffer* buf,
+    int packet_len,
+    int max_packets,
+    std::vector<int>* packet_lengths) {
+  for (int i = 0; i < max_packets; i++) {
+    auto packet =
+        base::MakeRefCounted<WrappedIOBuffer>(buf->data() + i * packet_len);
+    int result = InternalRecvFrom(packet.get(), packet_len, nullptr);
+    // Errors after the first datagram are reported in |packet_lengths|.
+    if (i == 0 && result < 0)
+      return result;
+    if (result == ERR_IO_PENDING)
+      break;
+    packet_lengths->push_back(result);
+    if (result < 0)
+      break;
+  }
+  return packet_lengths->size();
+}
+
 int UDPSocketPosix::InternalSendTo(IOBuffer* buf,
                                    int buf_len,
                                    const IPEndPoint* address) {
@@ -1158,7 +1290,8 @@ void UDPSocketPosix::ApplySocketTag(const SocketTag& tag) {
   tag_ = tag;
 }
 
-UDPSocketPosixSender::UDPSocketPosixSender() : sendmmsg_enabled_(false) {}
+UDPSocketPosixSender::UDPSocketPosixSender()
+    : sendmmsg_enabled_(false), udp_gso_enabled_(false) {}
 UDPSocketPosixSender::~UDPSocketPosixSender() {}
 
 SendResult::SendResult() : rv(0), write_count(0) {}
@@ -1204,10 +1337,75 @@ SendResult UDPSocketPosixSender::InternalSendmmsgBuffers(
   }
   return send_result;
 }
+
+SendResult UDPSocketPosixSender::InternalSendGsoBuffers(
+    int fd,
+    DatagramBuffers buffers) const {
+  SendResult send_result(0, 0, std::move(buffers));
+  auto it = send_result.buffers.cbegin();
+  while (it != send_result.buffers.cend()) {
+    // Send a run of buffers of the size of the first one, the last of which
+    // may be shorter, as the segments of one UDP_SEGMENT datagram.
+    const size_t segment_size = (*it)->length();
+    base::StackVector<struct iovec, kMaxGsoSegments> msg_iov;
+    size_t total_size = 0;
+    for (; it != send_result.buffers.cend() &&
+           msg_iov->size() < kMaxGsoSegments;
+         ++it) {
+      size_t length = (*it)->length();
+      if (length > segment_size || total_size + length > kMaxGsoBytes)
+        break;
+      msg_iov->push_back({(*it)->data(), length});
+      total_size += length;
+      if (length < segment_size) {
+        ++it;
+        break;
+      }
+    }
+
+    struct msghdr msg = {};
+    msg.msg_iov = &msg_iov[0];
+    msg.msg_iovlen = msg_iov->size();
+    char control[CMSG_SPACE(sizeof(uint16_t))] = {};
+    if (msg_iov->size() > 1) {
+      msg.msg_control = control;
+      msg.msg_controllen = sizeof(control);
+      struct cmsghdr* cmsg = CMSG_FIRSTHDR(&msg);
+      cmsg->cmsg_level = IPPROTO_UDP;
+      cmsg->cmsg_type = UDP_SEGMENT;
+      cmsg->cmsg_len = CMSG_LEN(sizeof(uint16_t));
+      uint16_t gso_size = static_cast<uint16_t>(segment_size);
+      memcpy(CMSG_DATA(cmsg), &gso_size, sizeof(gso_size));
+    }
+    ssize_t result = HANDLE_EINTR(Sendmsg(fd, &msg, 0));
+    if (result < 0) {
+      // The kernel doesn't know UDP_SEGMENT, or the device can't offload the
+      // checksums (EIO).
+      bool unsupported = errno == EINVAL || errno == ENOPROTOOPT ||
+                         errno == EIO;
+      send_result.rv = send_result.write_count == 0 && msg_iov->size() > 1 &&
+                               unsupported
+                           ? ERR_NOT_IMPLEMENTED
+                           : MapSystemError(errno);
+      return send_result;
+    }
+    send_result.write_count += msg_iov->size();
+  }
+  return send_result;
+}
 #endif
 
 SendResult UDPSocketPosixSender::SendBuffers(int fd, DatagramBuffers buffers) {
 #if HAVE_SENDMMSG
+  if (udp_gso_enabled_) {
+    auto result = InternalSendGsoBuffers(fd, std::move(buffers));
+    if (LIKELY(result.rv != ERR_NOT_IMPLEMENTED)) {
+      return result;
+    }
+    DLOG(WARNING) << "UDP_SEGMENT not supported, falling back to sendmmsg()";
+    udp_gso_enabled_ = false;
+    buffers = std::move(result.buffers);
+  }
   if (sendmmsg_enabled_) {
     auto result = InternalSendmmsgBuffers(fd, std::move(buffers));
     if (LIKELY(result.rv != ERR_NOT_IMPLEMENTED)) {
@@ -1235,6 +1433,12 @@ int UDPSocketPosixSender::Sendmmsg(int sockfd,
                                    unsigned int flags) const {
   return sendmmsg(sockfd, msgvec, vlen, flags);
 }
+
+ssize_t UDPSocketPosixSender::Sendmsg(int sockfd,
+                                      const struct msghdr* msg,
+                                      int flags) const {
+  return sendmsg(sockfd, msg, flags);
+}
 #endif
 
 int UDPSocketPosix::WriteAsync(
@@ -10,6 +10,7 @@
 #include <sys/types.h>
 
 #include <memory>
+#include <vector>
 
 #include "base/macros.h"
 #include "base/memory/ref_counted.h"
@@ -39,6 +40,9 @@
 #define HAVE_SENDMMSG 0
 #endif
 
+// recvmmsg() is available wherever sendmmsg() is.
+#define HAVE_RECVMMSG HAVE_SENDMMSG
+
 namespace net {
 
 class IPAddress;
@@ -70,6 +74,8 @@ const base::TimeDelta kWriteAsyncMsThreshold =
 const int kWriteAsyncMinBuffersThreshold = 2;
 // Don't allow more than this many outstanding async writes.
 const int kWriteAsyncMaxBuffersThreshold = 16;
+// Maximum number of datagrams read by a single ReadMultiple().
+const int kReadMultipleMaxPackets = 64;
 // PostTask immediately when unwritten buffers reaches this.
 const int kWriteAsyncPostBuffersThreshold = kWriteAsyncMaxBuffersThreshold / 2;
 // Don't unblock writer unless pending async writes are less than this.
@@ -91,6 +97,14 @@ class NET_EXPORT UDPSocketPosixSender
 #endif
   }
 
+  // Sends runs of equally sized buffers as a single UDP_SEGMENT (GSO)
+  // sendmsg() on kernels that support it, before trying sendmmsg().
+  void SetUdpGsoEnabled(bool enabled) {
+#if HAVE_SENDMMSG
+    udp_gso_enabled_ = enabled;
+#endif
+  }
+
  protected:
   friend class base::RefCountedThreadSafe<UDPSocketPosixSender>;
 
@@ -104,17 +118,24 @@ class NET_EXPORT UDPSocketPosixSender
                        struct mmsghdr* msgvec,
                        unsigned int vlen,
                        unsigned int flags) const;
+  virtual ssize_t Sendmsg(int sockfd,
+                          const struct msghdr* msg,
+                          int flags) const;
 #endif
 
   SendResult InternalSendBuffers(int fd, DatagramBuffers buffers) const;
 #if HAVE_SENDMMSG
   SendResult InternalSendmmsgBuffers(int fd, DatagramBuffers buffers) const;
+  // Returns ERR_NOT_IMPLEMENTED without writing anything if the kernel or the
+  // device doesn't support UDP_SEGMENT.
+  SendResult InternalSendGsoBuffers(int fd, DatagramBuffers buffers) const;
 #endif
 
  private:
   UDPSocketPosixSender(const UDPSocketPosixSender&) = delete;
   UDPSocketPosixSender& operator=(const UDPSocketPosixSender&) = delete;
   bool sendmmsg_enabled_;
+  bool udp_gso_enabled_;
 };
 
 class NET_EXPORT UDPSocketPosix {
@@ -207,6 +228,21 @@ class NET_EXPORT UDPSocketPosix {
   // has been connected.
   int Read(IOBuffer* buf, int buf_len, CompletionOnceCallback callback);
 
+  // Reads up to |max_packets| datagrams from the socket, with a single
+  // recvmmsg() where available. Datagram i is read at offset i * |packet_len|
+  // of |buf|, and its size, or a net error code such as ERR_MSG_TOO_BIG, is
+  // stored in (*packet_lengths)[i]. Returns the number of datagrams read or a
+  // net error code. If ERR_IO_PENDING is returned, the caller must keep
+  // |packet_lengths| alive until |callback| is called with the result.
+  // |max_packets| must not be more than kReadMultipleMaxPackets.
+  // Only usable from the client-side of a UDP socket, after the socket
+  // has been connected.
+  int ReadMultiple(IOBuffer* buf,
+                   int packet_len,
+                   int max_packets,
+                   std::vector<int>* packet_lengths,
+                   CompletionOnceCallback callback);
+
   // Writes to the socket.
   // Only usable from the client-side of a UDP socket, after the socket
   // has been connected.
@@ -372,6 +408,11 @@ class NET_EXPORT UDPSocketPosix {
     sender_->SetSendmmsgEnabled(enabled);
   }
 
+  void SetUdpGsoEnabled(bool enabled) {
+    DCHECK(sender_ != nullptr);
+    sender_->SetUdpGsoEnabled(enabled);
+  }
+
   void SetWriteBatchingActive(bool active) { write_batching_active_ = active; }
 
   void SetWriteAsyncMaxBuffers(int value) {
@@ -521,6 +562,17 @@ class NET_EXPORT UDPSocketPosix {
   int InternalRecvFromNonConnectedSocket(IOBuffer* buf,
                                          int buf_len,
                                          IPEndPoint* address);
+
+  // Implements ReadMultiple() with recvmmsg(), or with one
+  // InternalRecvFrom() per datagram where recvmmsg() isn't available.
+  int InternalReadMultiple(IOBuffer* buf,
+                           int packet_len,
+                           int max_packets,
+                           std::vector<int>* packet_lengths);
+  int InternalReadMultipleWithRecvFrom(IOBuffer* buf,
+                                       int packet_len,
+                                       int max_packets,
+                                       std::vector<int>* packet_lengths);
   int InternalSendTo(IOBuffer* buf, int buf_len, const IPEndPoint* address);
 
   // Applies |socket_options_| to |socket_|. Should be called before
@@ -598,6 +650,10 @@ class NET_EXPORT UDPSocketPosix {
   scoped_refptr<IOBuffer> read_buf_;
   int read_buf_len_;
   IPEndPoint* recv_from_address_;
+  // Set while a ReadMultiple() is pending, in which case |read_buf_len_| is
+  // the size of each datagram.
+  int read_max_packets_;
+  std::vector<int>* read_packet_lengths_;
 
   // The buffer used by InternalWrite() to retry Write requests
   scoped_refptr<IOBuffer> write_buf_;
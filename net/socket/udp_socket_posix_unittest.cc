@@ -4,6 +4,10 @@
 
 #include "net/socket/udp_socket_posix.h"
 
+#include <netinet/in.h>
+#include <string.h>
+#include <sys/socket.h>
+
 #include "base/bind.h"
 #include "net/base/completion_repeating_callback.h"
 #include "net/base/net_errors.h"
@@ -44,6 +48,25 @@ int SetNotImplemented() {
   errno = ENOSYS;
   return -1;
 }
+
+int SetGsoNotSupported() {
+  errno = EIO;
+  return -1;
+}
+
+// Returns the UDP_SEGMENT size of |msg|, the only IPPROTO_UDP control message
+// the sender sets, or 0 if it has none.
+uint16_t GetGsoSize(const struct msghdr* msg) {
+  for (struct cmsghdr* cmsg = CMSG_FIRSTHDR(msg); cmsg;
+       cmsg = CMSG_NXTHDR(const_cast<struct msghdr*>(msg), cmsg)) {
+    if (cmsg->cmsg_level == IPPROTO_UDP) {
+      uint16_t gso_size;
+      memcpy(&gso_size, CMSG_DATA(cmsg), sizeof(gso_size));
+      return gso_size;
+    }
+  }
+  return 0;
+}
 #endif
 
 bool WatcherSetInvalidHandle() {
@@ -68,6 +91,10 @@ class MockUDPSocketPosixSender : public UDPSocketPosixSender {
                          struct mmsghdr* msgvec,
                          unsigned int vlen,
                          unsigned int flags));
+#if HAVE_SENDMMSG
+  MOCK_CONST_METHOD3(Sendmsg,
+                     ssize_t(int sockfd, const struct msghdr* msg, int flags));
+#endif
 
  public:
   SendResult InternalSendBuffers(int fd, DatagramBuffers buffers) const {
@@ -78,6 +105,9 @@ class MockUDPSocketPosixSender : public UDPSocketPosixSender {
     return UDPSocketPosixSender::InternalSendmmsgBuffers(fd,
                                                          std::move(buffers));
   }
+  SendResult InternalSendGsoBuffers(int fd, DatagramBuffers buffers) const {
+    return UDPSocketPosixSender::InternalSendGsoBuffers(fd, std::move(buffers));
+  }
 #endif
 
  private:
@@ -321,6 +351,76 @@ TEST_F(UDPSocketPosixTest, SendInternalSendmmsg) {
   EXPECT_EQ(kNumMsgs, result.buffers.size());
 }
 
+// Buffers of the same size are sent as the segments of one datagram, the last
+// of which may be shorter.
+TEST_F(UDPSocketPosixTest, InternalSendGsoBuffers) {
+  AddBuffer(kSecondMsg);
+  AddBuffer(kSecondMsg);
+  AddBuffer(kHelloMsg);
+  AddBuffer(kSecondMsg);
+  {
+    InSequence dummy;
+    EXPECT_CALL(*socket_.sender(), Sendmsg(_, _, _))
+        .WillOnce(Invoke([](int, const struct msghdr* msg, int) {
+          EXPECT_EQ(3u, static_cast<size_t>(msg->msg_iovlen));
+          EXPECT_EQ(kSecondMsg.length(), GetGsoSize(msg));
+          return 2 * kSecondMsg.length() + kHelloMsg.length();
+        }));
+    EXPECT_CALL(*socket_.sender(), Sendmsg(_, _, _))
+        .WillOnce(Invoke([](int, const struct msghdr* msg, int) {
+          EXPECT_EQ(1u, static_cast<size_t>(msg->msg_iovlen));
+          EXPECT_EQ(0u, GetGsoSize(msg));
+          return kSecondMsg.length();
+        }));
+  }
+  SendResult result =
+      socket_.sender()->InternalSendGsoBuffers(1, std::move(buffers_));
+  EXPECT_EQ(0, result.rv);
+  EXPECT_EQ(4, result.write_count);
+  EXPECT_EQ(4u, result.buffers.size());
+}
+
+TEST_F(UDPSocketPosixTest, InternalSendGsoBuffersWriteError) {
+  AddBuffer(kHelloMsg);
+  AddBuffer(kSecondMsg);
+  {
+    InSequence dummy;
+    EXPECT_CALL(*socket_.sender(), Sendmsg(_, _, _))
+        .WillOnce(Return(kHelloMsg.length()));
+    EXPECT_CALL(*socket_.sender(), Sendmsg(_, _, _))
+        .WillOnce(InvokeWithoutArgs(SetWouldBlock));
+  }
+  SendResult result =
+      socket_.sender()->InternalSendGsoBuffers(1, std::move(buffers_));
+  EXPECT_EQ(ERR_IO_PENDING, result.rv);
+  EXPECT_EQ(1, result.write_count);
+  EXPECT_EQ(2u, result.buffers.size());
+}
+
+TEST_F(UDPSocketPosixTest, SendInternalGsoFallback) {
+  socket_.sender()->SetUdpGsoEnabled(true);
+  socket_.sender()->SetSendmmsgEnabled(true);
+  AddBuffer(kThirdMsg);
+  AddBuffer(kThirdMsg);
+  {
+    InSequence dummy;
+    EXPECT_CALL(*socket_.sender(), Sendmsg(_, _, _))
+        .WillOnce(InvokeWithoutArgs(SetGsoNotSupported));
+    EXPECT_CALL(*socket_.sender(), Sendmmsg(_, _, 2, _)).WillOnce(Return(2));
+  }
+  SendResult result = socket_.sender()->SendBuffers(1, std::move(buffers_));
+  EXPECT_EQ(0, result.rv);
+  EXPECT_EQ(2, result.write_count);
+
+  // GSO stays disabled.
+  buffers_ = std::move(result.buffers);
+  EXPECT_CALL(*socket_.sender(), Sendmsg(_, _, _)).Times(0);
+  EXPECT_CALL(*socket_.sender(), Sendmmsg(_, _, 2, _)).WillOnce(Return(2));
+  result = socket_.sender()->SendBuffers(1, std::move(buffers_));
+  EXPECT_EQ(0, result.rv);
+  EXPECT_EQ(2, result.write_count);
+}
+
 TEST_F(UDPSocketPosixTest, SendInternalSendmmsgFallback) {
   socket_.sender()->SetSendmmsgEnabled(true);
   AddBuffers();
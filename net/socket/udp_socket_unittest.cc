@@ -640,6 +640,58 @@ TEST_F(UDPSocketTest, CloseWithPendingRead) {
   EXPECT_FALSE(callback.have_result());
 }
 
+#if defined(OS_POSIX)
+// Reads several datagrams with a single ReadMultiple(), both when they are
+// already queued and when the read has to wait for them.
+TEST_F(UDPSocketTest, ReadMultiple) {
+  const int kMaxPackets = 4;
+  IPEndPoint bind_address(IPAddress::IPv4Localhost(), 0);
+  UDPServerSocket server(nullptr, NetLogSource());
+  ASSERT_THAT(server.Listen(bind_address), IsOk());
+  IPEndPoint server_address;
+  ASSERT_THAT(server.GetLocalAddress(&server_address), IsOk());
+
+  UDPClientSocket client(DatagramSocket::DEFAULT_BIND, nullptr, NetLogSource());
+  ASSERT_THAT(client.Connect(server_address), IsOk());
+  IPEndPoint client_address;
+  ASSERT_THAT(client.GetLocalAddress(&client_address), IsOk());
+
+  scoped_refptr<IOBuffer> buffer =
+      base::MakeRefCounted<IOBuffer>(kMaxPackets * kMaxRead);
+  std::vector<int> packet_lengths;
+  TestCompletionCallback callback;
+  int rv = client.ReadMultiple(buffer.get(), kMaxRead, kMaxPackets,
+                               &packet_lengths, callback.callback());
+  ASSERT_EQ(ERR_IO_PENDING, rv);
+  EXPECT_EQ(5, SendToSocket(&server, "first", client_address));
+  ASSERT_EQ(1, callback.WaitForResult());
+  ASSERT_EQ(1u, packet_lengths.size());
+  EXPECT_EQ("first", std::string(buffer->data(), packet_lengths[0]));
+
+  const std::string kMessages[] = {"second", "third", "fourth", "fifth",
+                                   "sixth"};
+  for (const std::string& message : kMessages) {
+    EXPECT_EQ(static_cast<int>(message.size()),
+              SendToSocket(&server, message, client_address));
+  }
+  size_t received = 0;
+  while (received < base::size(kMessages)) {
+    TestCompletionCallback read_callback;
+    rv = read_callback.GetResult(
+        client.ReadMultiple(buffer.get(), kMaxRead, kMaxPackets,
+                            &packet_lengths, read_callback.callback()));
+    ASSERT_GT(rv, 0);
+    ASSERT_LE(rv, kMaxPackets);
+    ASSERT_EQ(static_cast<size_t>(rv), packet_lengths.size());
+    for (int i = 0; i < rv; ++i) {
+      ASSERT_LT(received, base::size(kMessages));
+      EXPECT_EQ(kMessages[received++],
+                std::string(buffer->data() + i * kMaxRead, packet_lengths[i]));
+    }
+  }
+}
+#endif  // defined(OS_POSIX)
+
 // Some Android devices do not support multicast.
 // The ones supporting multicast need WifiManager.MulitcastLock to enable it.
 // http://goo.gl/jjAk9
@@ -304,6 +304,18 @@ std::unique_ptr<spdy::SpdySerializedFrame> BufferedSpdyFramer::CreateDataFrame(
       spdy_framer_.SerializeData(data_ir));
 }
 
+std::unique_ptr<spdy::SpdySerializedFrame>
+BufferedSpdyFramer::CreateDataFrameHeader(spdy::SpdyStreamId stream_id,
+                                          uint32_t len,
+                                          spdy::SpdyDataFlags flags) {
+  spdy::SpdyDataIR data_ir(stream_id);
+  data_ir.SetDataShallow(len);
+  data_ir.set_fin((flags & spdy::DATA_FLAG_FIN) != 0);
+  return std::make_unique<spdy::SpdySerializedFrame>(
+      spdy::SpdyFramer::SerializeDataFrameHeaderWithPaddingLengthField(
+          data_ir));
+}
+
 // TODO(jgraettinger): Eliminate uses of this method (prefer
 // spdy::SpdyPriorityIR).
 std::unique_ptr<spdy::SpdySerializedFrame> BufferedSpdyFramer::CreatePriority(
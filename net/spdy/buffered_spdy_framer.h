@@ -219,6 +219,12 @@ class NET_EXPORT_PRIVATE BufferedSpdyFramer
       const char* data,
       uint32_t len,
       spdy::SpdyDataFlags flags);
+  // Serializes only the frame header of a DATA frame with a |len| byte
+  // payload, for the payload to be written separately.
+  std::unique_ptr<spdy::SpdySerializedFrame> CreateDataFrameHeader(
+      spdy::SpdyStreamId stream_id,
+      uint32_t len,
+      spdy::SpdyDataFlags flags);
   std::unique_ptr<spdy::SpdySerializedFrame> CreatePriority(
       spdy::SpdyStreamId stream_id,
       spdy::SpdyStreamId dependency_id,
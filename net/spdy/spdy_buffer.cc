@@ -59,30 +59,87 @@ class SpdyBuffer::SharedFrameIOBuffer : public IOBuffer {
   DISALLOW_COPY_AND_ASSIGN(SharedFrameIOBuffer);
 };
 
+// An IOBuffer pointing into a separate payload, which it keeps alive. Used by
+// SpdyBuffer::GetIOBuffersForRemainingData().
+class SpdyBuffer::PayloadIOBuffer : public IOBuffer {
+ public:
+  PayloadIOBuffer(const scoped_refptr<IOBuffer>& payload, size_t offset)
+      : IOBuffer(payload->data() + offset), payload_(payload) {}
+
+ private:
+  ~PayloadIOBuffer() override {
+    // Prevent ~IOBuffer() from trying to delete |data_|.
+    data_ = nullptr;
+  }
+
+  const scoped_refptr<IOBuffer> payload_;
+
+  DISALLOW_COPY_AND_ASSIGN(PayloadIOBuffer);
+};
+
 SpdyBuffer::SpdyBuffer(std::unique_ptr<spdy::SpdySerializedFrame> frame)
-    : shared_frame_(new SharedFrame(std::move(frame))), offset_(0) {}
+    : shared_frame_(new SharedFrame(std::move(frame))),
+      payload_size_(0),
+      offset_(0) {}
 
 // The given data may not be strictly a SPDY frame; we (ab)use
 // |frame_| just as a container.
 SpdyBuffer::SpdyBuffer(const char* data, size_t size) :
     shared_frame_(new SharedFrame()),
+    payload_size_(0),
     offset_(0) {
   CHECK_GT(size, 0u);
   CHECK_LE(size, kMaxSpdyFrameSize);
   shared_frame_->data = MakeSpdySerializedFrame(data, size);
 }
 
+SpdyBuffer::SpdyBuffer(std::unique_ptr<spdy::SpdySerializedFrame> header,
+                       scoped_refptr<IOBuffer> payload,
+                       size_t payload_size)
+    : shared_frame_(new SharedFrame(std::move(header))),
+      // Snapshot |payload->data()|, which moves if |payload| is a
+      // DrainableIOBuffer that is consumed later on.
+      payload_(base::MakeRefCounted<PayloadIOBuffer>(payload, 0)),
+      payload_size_(payload_size),
+      offset_(0) {
+  CHECK_GT(payload_size_, 0u);
+  CHECK_LE(GetHeaderSize() + payload_size_, kMaxSpdyFrameSize);
+}
+
 SpdyBuffer::~SpdyBuffer() {
   if (GetRemainingSize() > 0)
     ConsumeHelper(GetRemainingSize(), DISCARD);
 }
 
 const char* SpdyBuffer::GetRemainingData() const {
+  DCHECK(!payload_);
   return shared_frame_->data->data() + offset_;
 }
 
 size_t SpdyBuffer::GetRemainingSize() const {
-  return shared_frame_->data->size() - offset_;
+  return GetHeaderSize() + payload_size_ - offset_;
+}
+
+void SpdyBuffer::GetIOBuffersForRemainingData(
+    scoped_refptr<IOBuffer>* header,
+    size_t* header_size,
+    scoped_refptr<IOBuffer>* payload,
+    size_t* payload_size) {
+  DCHECK(payload_);
+  DCHECK_GT(GetRemainingSize(), 0u);
+  size_t frame_header_size = GetHeaderSize();
+  if (offset_ < frame_header_size) {
+    *header = base::MakeRefCounted<SharedFrameIOBuffer>(shared_frame_, offset_);
+    *header_size = frame_header_size - offset_;
+    *payload = base::MakeRefCounted<PayloadIOBuffer>(payload_, 0);
+    *payload_size = payload_size_;
+    return;
+  }
+  *header = nullptr;
+  *header_size = 0;
+  *payload = base::MakeRefCounted<PayloadIOBuffer>(
+      payload_, offset_ - frame_header_size);
+  *payload_size = payload_size_ - (offset_ - frame_header_size);
 }
 
 void SpdyBuffer::AddConsumeCallback(const ConsumeCallback& consume_callback) {
@@ -94,12 +151,19 @@ void SpdyBuffer::Consume(size_t consume_size) {
 }
 
 scoped_refptr<IOBuffer> SpdyBuffer::GetIOBufferForRemainingData() {
+  DCHECK(!payload_);
   return base::MakeRefCounted<SharedFrameIOBuffer>(shared_frame_, offset_);
 }
 
 size_t SpdyBuffer::EstimateMemoryUsage() const {
   // TODO(xunjieli): Estimate |consume_callbacks_|. https://crbug.com/669108.
-  return base::trace_event::EstimateMemoryUsage(shared_frame_->data);
+  // A separate payload is kept alive by |payload_|, so it is counted too.
+  return base::trace_event::EstimateMemoryUsage(shared_frame_->data) +
+         payload_size_;
+}
+
+size_t SpdyBuffer::GetHeaderSize() const {
+  return shared_frame_->data->size();
 }
 
 void SpdyBuffer::ConsumeHelper(size_t consume_size,
@@ -56,16 +56,39 @@ class NET_EXPORT_PRIVATE SpdyBuffer {
   // non-NULL and |size| must be non-zero.
   SpdyBuffer(const char* data, size_t size);
 
+  // Construct with the data in |header| followed by the first |payload_size|
+  // bytes of |payload|, starting at its data() at the time of the call. The
+  // payload is referenced rather than copied, so its
+  // data must not change until the buffer is fully consumed or destroyed. Such
+  // a buffer is written with StreamSocket::WriteV().
+  SpdyBuffer(std::unique_ptr<spdy::SpdySerializedFrame> header,
+             scoped_refptr<IOBuffer> payload,
+             size_t payload_size);
+
   // If there are bytes remaining in the buffer, triggers a call to
   // any consume callbacks with a DISCARD source.
   ~SpdyBuffer();
 
-  // Returns the remaining (unconsumed) data.
+  // Returns the remaining (unconsumed) data. Must not be called on a buffer
+  // with a separate payload.
   const char* GetRemainingData() const;
 
-  // Returns the number of remaining (unconsumed) bytes.
+  // Returns the number of remaining (unconsumed) bytes, including those of a
+  // separate payload.
   size_t GetRemainingSize() const;
 
+  // Returns whether the buffer was constructed with a separate payload.
+  bool has_separate_payload() const { return !!payload_; }
+
+  // For a buffer with a separate payload, returns the remaining parts of the
+  // header and of the payload. |*header| is null and |*header_size| is 0 once
+  // the header is consumed. The returned IOBuffers may be used past the
+  // lifetime of this object, like GetIOBufferForRemainingData().
+  void GetIOBuffersForRemainingData(scoped_refptr<IOBuffer>* header,
+                                    size_t* header_size,
+                                    scoped_refptr<IOBuffer>* payload,
+                                    size_t* payload_size);
+
   // Add a callback to be called when bytes are consumed. The
   // ConsumeCallback should not do anything complicated; ideally it
   // should only update a counter. In particular, it must *not* cause
@@ -79,7 +102,8 @@ class NET_EXPORT_PRIVATE SpdyBuffer {
   // Returns an IOBuffer pointing to the data starting at
   // GetRemainingData(). Use with care; the returned IOBuffer is not
   // updated when Consume() is called. However, it may still be used
-  // past the lifetime of this object.
+  // past the lifetime of this object. Must not be called on a buffer with a
+  // separate payload.
   //
   // This is used with Socket::Write(), which takes an IOBuffer* that
   // may be written to even after the socket itself is destroyed. (See
@@ -98,8 +122,14 @@ class NET_EXPORT_PRIVATE SpdyBuffer {
       SharedFrame;
 
   class SharedFrameIOBuffer;
+  class PayloadIOBuffer;
+
+  size_t GetHeaderSize() const;
 
   const scoped_refptr<SharedFrame> shared_frame_;
+  // The separate payload, if any, which follows |shared_frame_|.
+  const scoped_refptr<IOBuffer> payload_;
+  const size_t payload_size_;
   std::vector<ConsumeCallback> consume_callbacks_;
   size_t offset_;
 
@@ -130,6 +130,47 @@ TEST_F(SpdyBufferTest, IOBufferForRemainingDataOutlivesBuffer) {
   std::memcpy(io_buffer->data(), kData, kDataSize);
 }
 
+// Construct a SpdyBuffer with a separate payload and make sure the payload
+// isn't copied, and that the IOBuffers for its remaining data follow
+// Consume() across the header and the payload.
+TEST_F(SpdyBufferTest, SeparatePayload) {
+  const char kHeader[] = "head";
+  const size_t kHeaderSize = 4;
+  auto payload = base::MakeRefCounted<DrainableIOBuffer>(
+      base::MakeRefCounted<StringIOBuffer>(std::string(kData, kDataSize)),
+      kDataSize);
+  const char* payload_data = payload->data();
+  SpdyBuffer buffer(
+      std::make_unique<spdy::SpdySerializedFrame>(
+          const_cast<char*>(kHeader), kHeaderSize, false /* owns_buffer */),
+      payload, kDataSize);
+  // Consuming |payload| itself doesn't move the payload of |buffer|.
+  payload->DidConsume(2);
+
+  EXPECT_TRUE(buffer.has_separate_payload());
+  EXPECT_EQ(kHeaderSize + kDataSize, buffer.GetRemainingSize());
+
+  scoped_refptr<IOBuffer> header_io_buffer;
+  size_t header_size = 0;
+  scoped_refptr<IOBuffer> payload_io_buffer;
+  size_t payload_size = 0;
+  buffer.GetIOBuffersForRemainingData(&header_io_buffer, &header_size,
+                                      &payload_io_buffer, &payload_size);
+  EXPECT_EQ(std::string(kHeader, kHeaderSize),
+            std::string(header_io_buffer->data(), header_size));
+  EXPECT_EQ(payload_data, payload_io_buffer->data());
+  EXPECT_EQ(kDataSize, payload_size);
+
+  buffer.Consume(kHeaderSize + 5);
+  buffer.GetIOBuffersForRemainingData(&header_io_buffer, &header_size,
+                                      &payload_io_buffer, &payload_size);
+  EXPECT_FALSE(header_io_buffer);
+  EXPECT_EQ(0u, header_size);
+  EXPECT_EQ(payload_data + 5, payload_io_buffer->data());
+  EXPECT_EQ(kDataSize - 5, payload_size);
+  EXPECT_EQ(kDataSize - 5, buffer.GetRemainingSize());
+}
+
 }  // namespace
 
 }  // namespace net
@@ -0,0 +1,241 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "net/spdy/spdy_fair_write_scheduler.h"
+
+#include <algorithm>
+#include <vector>
+
+#include "base/logging.h"
+#include "base/trace_event/memory_usage_estimator.h"
+#include "net/spdy/spdy_buffer_producer.h"
+#include "net/spdy/spdy_stream.h"
+
+namespace net {
+
+namespace {
+
+// Returns the cost of |frame_producer| in virtual time. Producers don't know
+// the size of their frame before producing it, but the memory they hold is
+// dominated by the frame for DATA frames, the ones that matter here.
+uint64_t GetCost(const SpdyBufferProducer& frame_producer) {
+  return std::max<uint64_t>(1u, frame_producer.EstimateMemoryUsage());
+}
+
+}  // namespace
+
+SpdyFairWriteScheduler::StreamState::StreamState() = default;
+
+SpdyFairWriteScheduler::StreamState::~StreamState() = default;
+
+size_t SpdyFairWriteScheduler::StreamState::EstimateMemoryUsage() const {
+  return base::trace_event::EstimateMemoryUsage(writes);
+}
+
+SpdyFairWriteScheduler::SpdyFairWriteScheduler()
+    : removing_writes_(false), virtual_time_(), next_sequence_number_(0) {}
+
+SpdyFairWriteScheduler::~SpdyFairWriteScheduler() {
+  Clear();
+}
+
+bool SpdyFairWriteScheduler::IsEmpty() const {
+  for (int i = MINIMUM_PRIORITY; i <= MAXIMUM_PRIORITY; i++) {
+    if (!session_writes_[i].empty() || !ready_streams_[i].empty())
+      return false;
+  }
+  return true;
+}
+
+void SpdyFairWriteScheduler::Enqueue(
+    RequestPriority priority,
+    spdy::SpdyFrameType frame_type,
+    std::unique_ptr<SpdyBufferProducer> frame_producer,
+    const base::WeakPtr<SpdyStream>& stream,
+    const NetworkTrafficAnnotationTag& traffic_annotation) {
+  CHECK(!removing_writes_);
+  CHECK_GE(priority, MINIMUM_PRIORITY);
+  CHECK_LE(priority, MAXIMUM_PRIORITY);
+  PendingWrite pending_write(
+      frame_type, std::move(frame_producer), stream,
+      MutableNetworkTrafficAnnotationTag(traffic_annotation));
+  if (!stream.get()) {
+    session_writes_[priority].push_back(std::move(pending_write));
+    return;
+  }
+
+  DCHECK_EQ(stream->priority(), priority);
+  StreamState& state = streams_[stream.get()];
+  if (!state.writes.empty()) {
+    DCHECK_EQ(state.priority, priority);
+    state.writes.push_back(std::move(pending_write));
+    return;
+  }
+
+  if (state.priority != priority) {
+    state.priority = priority;
+    state.virtual_time = virtual_time_[priority];
+  } else {
+    state.virtual_time =
+        std::max(state.virtual_time, virtual_time_[priority]);
+  }
+  state.writes.push_back(std::move(pending_write));
+  AddReadyStream(stream.get(), &state);
+}
+
+bool SpdyFairWriteScheduler::Dequeue(
+    spdy::SpdyFrameType* frame_type,
+    std::unique_ptr<SpdyBufferProducer>* frame_producer,
+    base::WeakPtr<SpdyStream>* stream,
+    MutableNetworkTrafficAnnotationTag* traffic_annotation) {
+  CHECK(!removing_writes_);
+  for (int i = MAXIMUM_PRIORITY; i >= MINIMUM_PRIORITY; --i) {
+    if (!session_writes_[i].empty()) {
+      PendingWrite pending_write = std::move(session_writes_[i].front());
+      session_writes_[i].pop_front();
+      TakePendingWrite(std::move(pending_write), frame_type, frame_producer,
+                       stream, traffic_annotation);
+      return true;
+    }
+
+    if (ready_streams_[i].empty())
+      continue;
+
+    auto ready_it = ready_streams_[i].begin();
+    SpdyStream* ready_stream = ready_it->second;
+    ready_streams_[i].erase(ready_it);
+    auto it = streams_.find(ready_stream);
+    DCHECK(it != streams_.end());
+    StreamState& state = it->second;
+
+    PendingWrite pending_write = std::move(state.writes.front());
+    state.writes.pop_front();
+    virtual_time_[i] = state.virtual_time;
+    state.virtual_time += GetCost(*pending_write.frame_producer);
+    if (!state.writes.empty())
+      AddReadyStream(ready_stream, &state);
+
+    TakePendingWrite(std::move(pending_write), frame_type, frame_producer,
+                     stream, traffic_annotation);
+    return true;
+  }
+  return false;
+}
+
+void SpdyFairWriteScheduler::RemovePendingWritesForStream(SpdyStream* stream) {
+  CHECK(!removing_writes_);
+  auto it = streams_.find(stream);
+  if (it == streams_.end())
+    return;
+
+  removing_writes_ = true;
+  // Defer deletion until the queue is updated, as SpdyBuffer::~SpdyBuffer()
+  // can result in callbacks into the scheduler.
+  std::vector<std::unique_ptr<SpdyBufferProducer>> erased_buffer_producers;
+  if (!it->second.writes.empty())
+    RemoveReadyStream(it->second);
+  for (auto& pending_write : it->second.writes)
+    erased_buffer_producers.push_back(std::move(pending_write.frame_producer));
+  streams_.erase(it);
+  removing_writes_ = false;
+}
+
+void SpdyFairWriteScheduler::RemovePendingWritesForStreamsAfter(
+    spdy::SpdyStreamId last_good_stream_id) {
+  CHECK(!removing_writes_);
+  removing_writes_ = true;
+
+  std::vector<std::unique_ptr<SpdyBufferProducer>> erased_buffer_producers;
+  for (auto& entry : streams_) {
+    StreamState& state = entry.second;
+    if (state.writes.empty())
+      continue;
+    SpdyStream* stream = state.writes.front().stream.get();
+    if (!stream || (stream->stream_id() <= last_good_stream_id &&
+                    stream->stream_id() != 0)) {
+      continue;
+    }
+    RemoveReadyStream(state);
+    for (auto& pending_write : state.writes) {
+      erased_buffer_producers.push_back(
+          std::move(pending_write.frame_producer));
+    }
+    state.writes.clear();
+  }
+  removing_writes_ = false;
+}
+
+void SpdyFairWriteScheduler::ChangePriorityOfWritesForStream(
+    SpdyStream* stream,
+    RequestPriority old_priority,
+    RequestPriority new_priority) {
+  CHECK(!removing_writes_);
+  DCHECK(stream);
+  auto it = streams_.find(stream);
+  if (it == streams_.end())
+    return;
+
+  StreamState& state = it->second;
+  // Virtual times of different priorities aren't comparable, so the stream
+  // starts at the current virtual time of its new priority.
+  if (state.writes.empty()) {
+    state.priority = new_priority;
+    state.virtual_time = virtual_time_[new_priority];
+    return;
+  }
+  DCHECK_EQ(old_priority, state.priority);
+  RemoveReadyStream(state);
+  state.priority = new_priority;
+  state.virtual_time = virtual_time_[new_priority];
+  AddReadyStream(stream, &state);
+}
+
+void SpdyFairWriteScheduler::Clear() {
+  CHECK(!removing_writes_);
+  removing_writes_ = true;
+  std::vector<std::unique_ptr<SpdyBufferProducer>> erased_buffer_producers;
+
+  for (int i = MINIMUM_PRIORITY; i <= MAXIMUM_PRIORITY; ++i) {
+    for (auto& pending_write : session_writes_[i]) {
+      erased_buffer_producers.push_back(
+          std::move(pending_write.frame_producer));
+    }
+    session_writes_[i].clear();
+    ready_streams_[i].clear();
+  }
+  for (auto& entry : streams_) {
+    for (auto& pending_write : entry.second.writes) {
+      erased_buffer_producers.push_back(
+          std::move(pending_write.frame_producer));
+    }
+  }
+  streams_.clear();
+  removing_writes_ = false;
+}
+
+size_t SpdyFairWriteScheduler::EstimateMemoryUsage() const {
+  return base::trace_event::EstimateMemoryUsage(session_writes_) +
+         base::trace_event::EstimateMemoryUsage(streams_) +
+         base::trace_event::EstimateMemoryUsage(ready_streams_);
+}
+
+void SpdyFairWriteScheduler::AddReadyStream(SpdyStream* stream,
+                                            StreamState* state) {
+  DCHECK(!state->writes.empty());
+  state->sequence_number = next_sequence_number_++;
+  bool inserted =
+      ready_streams_[state->priority]
+          .insert(std::make_pair(
+              ReadyKey(state->virtual_time, state->sequence_number), stream))
+          .second;
+  DCHECK(inserted);
+}
+
+void SpdyFairWriteScheduler::RemoveReadyStream(const StreamState& state) {
+  size_t erased = ready_streams_[state.priority].erase(
+      ReadyKey(state.virtual_time, state.sequence_number));
+  DCHECK_EQ(1u, erased);
+}
+
+}  // namespace net
@@ -0,0 +1,117 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef NET_SPDY_SPDY_FAIR_WRITE_SCHEDULER_H_
+#define NET_SPDY_SPDY_FAIR_WRITE_SCHEDULER_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <map>
+#include <memory>
+#include <utility>
+
+#include "base/containers/circular_deque.h"
+#include "base/macros.h"
+#include "base/memory/weak_ptr.h"
+#include "net/base/net_export.h"
+#include "net/base/request_priority.h"
+#include "net/spdy/spdy_write_scheduler.h"
+#include "net/third_party/quiche/src/spdy/core/spdy_protocol.h"
+#include "net/traffic_annotation/network_traffic_annotation.h"
+
+namespace net {
+
+class SpdyBufferProducer;
+class SpdyStream;
+
+// A SpdyWriteScheduler that shares the connection between the streams of each
+// priority by the number of bytes they write.
+//
+// Http2PriorityDependencies makes each new stream depend exclusively on the
+// last stream with the same or a higher priority, so the dependency tree
+// SpdySession sends is a chain in which the streams of each priority form a
+// consecutive run, with the same weight. As in SpdyWriteQueue, the runs are
+// served in the order of the chain, and frames not associated with a stream
+// are written before those of the streams of their priority. But within a run,
+// the streams are served as siblings of equal weight, through start-time fair
+// queueing: each stream has a virtual time, advanced by the size of each of
+// its frames, and the stream with the lowest virtual time writes the next
+// frame. The virtual time of a stream that had nothing to write catches up
+// with that of the run when it enqueues a frame, so that idle streams don't
+// accumulate credit.
+class NET_EXPORT_PRIVATE SpdyFairWriteScheduler : public SpdyWriteScheduler {
+ public:
+  SpdyFairWriteScheduler();
+  ~SpdyFairWriteScheduler() override;
+
+  // SpdyWriteScheduler implementation:
+  bool IsEmpty() const override;
+  void Enqueue(RequestPriority priority,
+               spdy::SpdyFrameType frame_type,
+               std::unique_ptr<SpdyBufferProducer> frame_producer,
+               const base::WeakPtr<SpdyStream>& stream,
+               const NetworkTrafficAnnotationTag& traffic_annotation) override;
+  bool Dequeue(spdy::SpdyFrameType* frame_type,
+               std::unique_ptr<SpdyBufferProducer>* frame_producer,
+               base::WeakPtr<SpdyStream>* stream,
+               MutableNetworkTrafficAnnotationTag* traffic_annotation) override;
+  void RemovePendingWritesForStream(SpdyStream* stream) override;
+  void RemovePendingWritesForStreamsAfter(
+      spdy::SpdyStreamId last_good_stream_id) override;
+  void ChangePriorityOfWritesForStream(SpdyStream* stream,
+                                       RequestPriority old_priority,
+                                       RequestPriority new_priority) override;
+  void Clear() override;
+  size_t EstimateMemoryUsage() const override;
+
+ private:
+  struct StreamState {
+    StreamState();
+    ~StreamState();
+
+    size_t EstimateMemoryUsage() const;
+
+    RequestPriority priority = IDLE;
+    base::circular_deque<PendingWrite> writes;
+    // The virtual time at which the next frame of the stream starts.
+    uint64_t virtual_time = 0;
+    // Orders streams with the same virtual time by when they became ready.
+    uint64_t sequence_number = 0;
+
+   private:
+    DISALLOW_COPY_AND_ASSIGN(StreamState);
+  };
+
+  // The virtual time and sequence number of a stream with pending writes.
+  using ReadyKey = std::pair<uint64_t, uint64_t>;
+
+  // Adds |stream|, which must have pending writes, to |ready_streams_|.
+  void AddReadyStream(SpdyStream* stream, StreamState* state);
+
+  // Removes |state| from |ready_streams_|.
+  void RemoveReadyStream(const StreamState& state);
+
+  bool removing_writes_;
+
+  // The writes not associated with a stream, binned by priority.
+  base::circular_deque<PendingWrite> session_writes_[NUM_PRIORITIES];
+
+  // The streams that have or had pending writes, until they are removed.
+  std::map<SpdyStream*, StreamState> streams_;
+
+  // The streams with pending writes, binned by priority.
+  std::map<ReadyKey, SpdyStream*> ready_streams_[NUM_PRIORITIES];
+
+  // The virtual time of the last frame dequeued at each priority.
+  uint64_t virtual_time_[NUM_PRIORITIES];
+
+  uint64_t next_sequence_number_;
+
+  DISALLOW_COPY_AND_ASSIGN(SpdyFairWriteScheduler);
+};
+
+}  // namespace net
+
+#endif  // NET_SPDY_SPDY_FAIR_WRITE_SCHEDULER_H_
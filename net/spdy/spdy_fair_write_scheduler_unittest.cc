@@ -0,0 +1,192 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "net/spdy/spdy_fair_write_scheduler.h"
+
+#include <cstring>
+#include <string>
+#include <utility>
+
+#include "net/base/request_priority.h"
+#include "net/log/net_log_with_source.h"
+#include "net/spdy/spdy_buffer_producer.h"
+#include "net/spdy/spdy_stream.h"
+#include "net/traffic_annotation/network_traffic_annotation_test_helper.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "url/gurl.h"
+
+namespace net {
+
+namespace {
+
+// Makes a SpdyFrameProducer producing a frame with the data in the
+// given string.
+std::unique_ptr<SpdyBufferProducer> StringToProducer(const std::string& s) {
+  auto data = std::make_unique<char[]>(s.size());
+  std::memcpy(data.get(), s.data(), s.size());
+  auto frame = std::make_unique<spdy::SpdySerializedFrame>(data.release(),
+                                                           s.size(), true);
+  auto buffer = std::make_unique<SpdyBuffer>(std::move(frame));
+  return std::make_unique<SimpleBufferProducer>(std::move(buffer));
+}
+
+// Makes a SpdyStream with the given priority and a NULL SpdySession
+// -- be careful to not call any functions that expect the session to
+// be there.
+std::unique_ptr<SpdyStream> MakeTestStream(RequestPriority priority) {
+  return std::make_unique<SpdyStream>(
+      SPDY_BIDIRECTIONAL_STREAM, base::WeakPtr<SpdySession>(), GURL(), priority,
+      0, 0, NetLogWithSource(), TRAFFIC_ANNOTATION_FOR_TESTS);
+}
+
+class SpdyFairWriteSchedulerTest : public ::testing::Test {
+ protected:
+  void Enqueue(SpdyStream* stream, const std::string& data) {
+    scheduler_.Enqueue(
+        stream ? stream->priority() : DEFAULT_PRIORITY,
+        spdy::SpdyFrameType::DATA, StringToProducer(data),
+        stream ? stream->GetWeakPtr() : base::WeakPtr<SpdyStream>(),
+        TRAFFIC_ANNOTATION_FOR_TESTS);
+  }
+
+  // Dequeues the next frame and returns its data, or the empty string if
+  // there's nothing to dequeue.
+  std::string Dequeue() {
+    spdy::SpdyFrameType frame_type = spdy::SpdyFrameType::DATA;
+    std::unique_ptr<SpdyBufferProducer> frame_producer;
+    base::WeakPtr<SpdyStream> stream;
+    MutableNetworkTrafficAnnotationTag traffic_annotation;
+    if (!scheduler_.Dequeue(&frame_type, &frame_producer, &stream,
+                            &traffic_annotation)) {
+      return std::string();
+    }
+    std::unique_ptr<SpdyBuffer> buffer = frame_producer->ProduceBuffer();
+    return std::string(buffer->GetRemainingData(), buffer->GetRemainingSize());
+  }
+
+  SpdyFairWriteScheduler scheduler_;
+};
+
+TEST_F(SpdyFairWriteSchedulerTest, DequeuesByPriority) {
+  std::unique_ptr<SpdyStream> stream_low = MakeTestStream(LOW);
+  std::unique_ptr<SpdyStream> stream_highest = MakeTestStream(HIGHEST);
+
+  Enqueue(stream_low.get(), "L");
+  Enqueue(stream_highest.get(), "H");
+
+  EXPECT_EQ("H", Dequeue());
+  EXPECT_EQ("L", Dequeue());
+  EXPECT_EQ("", Dequeue());
+  EXPECT_TRUE(scheduler_.IsEmpty());
+}
+
+// Frames not associated with a stream go before the streams of their priority.
+TEST_F(SpdyFairWriteSchedulerTest, SessionFramesFirst) {
+  std::unique_ptr<SpdyStream> stream = MakeTestStream(DEFAULT_PRIORITY);
+
+  Enqueue(stream.get(), "stream");
+  Enqueue(nullptr, "session");
+
+  EXPECT_EQ("session", Dequeue());
+  EXPECT_EQ("stream", Dequeue());
+}
+
+// A stream with large frames doesn't starve a stream of the same priority with
+// small ones, and each stream's frames stay in order.
+TEST_F(SpdyFairWriteSchedulerTest, InterleavesByBytes) {
+  std::unique_ptr<SpdyStream> big_stream = MakeTestStream(DEFAULT_PRIORITY);
+  std::unique_ptr<SpdyStream> small_stream = MakeTestStream(DEFAULT_PRIORITY);
+
+  const std::string big1(4000, 'a');
+  const std::string big2(4000, 'b');
+  Enqueue(big_stream.get(), big1);
+  Enqueue(big_stream.get(), big2);
+  for (int i = 0; i < 4; ++i)
+    Enqueue(small_stream.get(), std::string(1000, '0' + i));
+
+  EXPECT_EQ(big1, Dequeue());
+  // |small_stream| has written nothing yet, so it catches up with the 4000
+  // bytes of |big_stream| before |big_stream| writes again.
+  for (int i = 0; i < 4; ++i)
+    EXPECT_EQ(std::string(1000, '0' + i), Dequeue());
+  EXPECT_EQ(big2, Dequeue());
+  EXPECT_TRUE(scheduler_.IsEmpty());
+}
+
+// A stream that was idle doesn't get credit for the time it didn't write.
+TEST_F(SpdyFairWriteSchedulerTest, IdleStreamDoesNotAccumulateCredit) {
+  std::unique_ptr<SpdyStream> stream1 = MakeTestStream(DEFAULT_PRIORITY);
+  std::unique_ptr<SpdyStream> stream2 = MakeTestStream(DEFAULT_PRIORITY);
+
+  for (int i = 0; i < 10; ++i) {
+    Enqueue(stream1.get(), "1");
+    EXPECT_EQ("1", Dequeue());
+  }
+
+  Enqueue(stream1.get(), "1");
+  Enqueue(stream1.get(), "1");
+  Enqueue(stream2.get(), "2");
+  Enqueue(stream2.get(), "2");
+  EXPECT_EQ("1", Dequeue());
+  EXPECT_EQ("2", Dequeue());
+  EXPECT_EQ("1", Dequeue());
+  EXPECT_EQ("2", Dequeue());
+}
+
+TEST_F(SpdyFairWriteSchedulerTest, RemovePendingWritesForStream) {
+  std::unique_ptr<SpdyStream> stream1 = MakeTestStream(DEFAULT_PRIORITY);
+  std::unique_ptr<SpdyStream> stream2 = MakeTestStream(DEFAULT_PRIORITY);
+
+  Enqueue(stream1.get(), "1");
+  Enqueue(stream2.get(), "2");
+  Enqueue(stream1.get(), "1");
+  scheduler_.RemovePendingWritesForStream(stream1.get());
+
+  EXPECT_EQ("2", Dequeue());
+  EXPECT_EQ("", Dequeue());
+}
+
+TEST_F(SpdyFairWriteSchedulerTest, RemovePendingWritesForStreamsAfter) {
+  std::unique_ptr<SpdyStream> stream1 = MakeTestStream(DEFAULT_PRIORITY);
+  stream1->set_stream_id(1);
+  std::unique_ptr<SpdyStream> stream3 = MakeTestStream(DEFAULT_PRIORITY);
+  stream3->set_stream_id(3);
+  // No stream id assigned.
+  std::unique_ptr<SpdyStream> stream_no_id = MakeTestStream(DEFAULT_PRIORITY);
+
+  Enqueue(stream1.get(), "1");
+  Enqueue(stream3.get(), "3");
+  Enqueue(stream_no_id.get(), "0");
+  scheduler_.RemovePendingWritesForStreamsAfter(1);
+
+  EXPECT_EQ("1", Dequeue());
+  EXPECT_EQ("", Dequeue());
+}
+
+TEST_F(SpdyFairWriteSchedulerTest, ChangePriorityOfWritesForStream) {
+  std::unique_ptr<SpdyStream> stream1 = MakeTestStream(LOW);
+  std::unique_ptr<SpdyStream> stream2 = MakeTestStream(MEDIUM);
+
+  Enqueue(stream1.get(), "1");
+  Enqueue(stream2.get(), "2");
+  scheduler_.ChangePriorityOfWritesForStream(stream1.get(), LOW, HIGHEST);
+
+  EXPECT_EQ("1", Dequeue());
+  EXPECT_EQ("2", Dequeue());
+}
+
+TEST_F(SpdyFairWriteSchedulerTest, Clear) {
+  std::unique_ptr<SpdyStream> stream = MakeTestStream(DEFAULT_PRIORITY);
+
+  Enqueue(stream.get(), "stream");
+  Enqueue(nullptr, "session");
+  scheduler_.Clear();
+
+  EXPECT_TRUE(scheduler_.IsEmpty());
+  EXPECT_EQ("", Dequeue());
+}
+
+}  // namespace
+
+}  // namespace net
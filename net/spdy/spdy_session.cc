@@ -28,6 +28,7 @@
 #include "base/trace_event/memory_usage_estimator.h"
 #include "base/trace_event/trace_event.h"
 #include "base/values.h"
+#include "net/base/features.h"
 #include "net/base/url_util.h"
 #include "net/cert/asn1_util.h"
 #include "net/cert/cert_verify_result.h"
@@ -49,10 +50,12 @@
 #include "net/socket/ssl_client_socket.h"
 #include "net/spdy/header_coalescer.h"
 #include "net/spdy/spdy_buffer_producer.h"
+#include "net/spdy/spdy_fair_write_scheduler.h"
 #include "net/spdy/spdy_http_utils.h"
 #include "net/spdy/spdy_log_util.h"
 #include "net/spdy/spdy_session_pool.h"
 #include "net/spdy/spdy_stream.h"
+#include "net/spdy/spdy_write_queue.h"
 #include "net/ssl/ssl_cipher_suite_names.h"
 #include "net/ssl/ssl_connection_status_flags.h"
 #include "net/third_party/quiche/src/quic/core/http/spdy_utils.h"
@@ -509,6 +512,12 @@ class SpdyServerPushHelper : public ServerPushDelegate::ServerPushHelper {
   const GURL request_url_;
 };
 
+std::unique_ptr<SpdyWriteScheduler> CreateWriteScheduler() {
+  if (base::FeatureList::IsEnabled(features::kSpdyFairWriteScheduler))
+    return std::make_unique<SpdyFairWriteScheduler>();
+  return std::make_unique<SpdyWriteQueue>();
+}
+
 }  // namespace
 
 SpdyProtocolErrorDetails MapFramerErrorToProtocolError(
@@ -917,6 +926,7 @@ SpdySession::SpdySession(
       num_active_pushed_streams_(0u),
       bytes_pushed_count_(0u),
       bytes_pushed_and_unclaimed_count_(0u),
+      write_queue_(CreateWriteScheduler()),
       in_flight_write_frame_type_(spdy::SpdyFrameType::DATA),
       in_flight_write_frame_size_(0),
       availability_state_(STATE_AVAILABLE),
@@ -1258,14 +1268,21 @@ std::unique_ptr<SpdyBuffer> SpdySession::CreateDataBuffer(
   if (effective_len > 0)
     MaybeSendPrefacePing();
 
-  // TODO(mbelshe): reduce memory copies here.
   DCHECK(buffered_spdy_framer_.get());
-  std::unique_ptr<spdy::SpdySerializedFrame> frame(
-      buffered_spdy_framer_->CreateDataFrame(
-          stream_id, data->data(), static_cast<uint32_t>(effective_len),
-          flags));
-
-  auto data_buffer = std::make_unique<SpdyBuffer>(std::move(frame));
+  std::unique_ptr<SpdyBuffer> data_buffer;
+  if (effective_len > 0 && socket_->SupportsWriteV()) {
+    // Write the payload straight from |data| rather than copying it into the
+    // frame.
+    data_buffer = std::make_unique<SpdyBuffer>(
+        buffered_spdy_framer_->CreateDataFrameHeader(
+            stream_id, static_cast<uint32_t>(effective_len), flags),
+        data, static_cast<size_t>(effective_len));
+  } else {
+    data_buffer = std::make_unique<SpdyBuffer>(
+        buffered_spdy_framer_->CreateDataFrame(
+            stream_id, data->data(), static_cast<uint32_t>(effective_len),
+            flags));
+  }
 
   // Send window size is based on payload size, so nothing to do if this is
   // just a FIN with no payload.
@@ -1285,8 +1302,8 @@ void SpdySession::UpdateStreamPriority(SpdyStream* stream,
   // There might be write frames enqueued for |stream| regardless of whether it
   // is active (stream_id != 0) or inactive (no HEADERS frame has been sent out
   // yet and stream_id == 0).
-  write_queue_.ChangePriorityOfWritesForStream(stream, old_priority,
-                                               new_priority);
+  write_queue_->ChangePriorityOfWritesForStream(stream, old_priority,
+                                                new_priority);
 
   // PRIORITY frames only need to be sent if |stream| is active.
   const spdy::SpdyStreamId stream_id = stream->stream_id();
@@ -1429,7 +1446,7 @@ void SpdySession::StartGoingAway(spdy::SpdyStreamId last_good_stream_id,
     DCHECK_GT(old_size, created_streams_.size());
   }
 
-  write_queue_.RemovePendingWritesForStreamsAfter(last_good_stream_id);
+  write_queue_->RemovePendingWritesForStreamsAfter(last_good_stream_id);
 
   DcheckGoingAway();
   MaybeFinishGoingAway();
@@ -2320,7 +2337,7 @@ void SpdySession::PumpWriteLoop(WriteState expected_write_state, int result) {
   DoWriteLoop(expected_write_state, result);
 
   if (availability_state_ == STATE_DRAINING && !in_flight_write_ &&
-      write_queue_.IsEmpty()) {
+      write_queue_->IsEmpty()) {
     pool_->RemoveUnavailableSession(GetWeakPtr());  // Destroys |this|.
     return;
   }
@@ -2386,8 +2403,8 @@ int SpdySession::DoWrite() {
     spdy::SpdyFrameType frame_type = spdy::SpdyFrameType::DATA;
     std::unique_ptr<SpdyBufferProducer> producer;
     base::WeakPtr<SpdyStream> stream;
-    if (!write_queue_.Dequeue(&frame_type, &producer, &stream,
-                              &in_flight_write_traffic_annotation)) {
+    if (!write_queue_->Dequeue(&frame_type, &producer, &stream,
+                               &in_flight_write_traffic_annotation)) {
       write_state_ = WRITE_STATE_IDLE;
       return ERR_IO_PENDING;
     }
@@ -2426,6 +2443,27 @@ int SpdySession::DoWrite() {
 
   write_state_ = WRITE_STATE_DO_WRITE_COMPLETE;
 
+  if (in_flight_write_->has_separate_payload()) {
+    scoped_refptr<IOBuffer> header;
+    size_t header_size;
+    scoped_refptr<IOBuffer> payload;
+    size_t payload_size;
+    in_flight_write_->GetIOBuffersForRemainingData(&header, &header_size,
+                                                   &payload, &payload_size);
+    if (header_size > 0) {
+      return socket_->WriteV(
+          header.get(), header_size, payload.get(), payload_size,
+          base::Bind(&SpdySession::PumpWriteLoop, weak_factory_.GetWeakPtr(),
+                     WRITE_STATE_DO_WRITE_COMPLETE),
+          NetworkTrafficAnnotationTag(in_flight_write_traffic_annotation));
+    }
+    return socket_->Write(
+        payload.get(), payload_size,
+        base::Bind(&SpdySession::PumpWriteLoop, weak_factory_.GetWeakPtr(),
+                   WRITE_STATE_DO_WRITE_COMPLETE),
+        NetworkTrafficAnnotationTag(in_flight_write_traffic_annotation));
+  }
+
   scoped_refptr<IOBuffer> write_io_buffer =
       in_flight_write_->GetIOBufferForRemainingData();
   return socket_->Write(
@@ -2758,11 +2796,11 @@ void SpdySession::EnqueueWrite(
   if (availability_state_ == STATE_DRAINING)
     return;
 
-  write_queue_.Enqueue(priority, frame_type, std::move(producer), stream,
-                       traffic_annotation);
+  write_queue_->Enqueue(priority, frame_type, std::move(producer), stream,
+                        traffic_annotation);
   if (greased_http2_frame_ && (frame_type == spdy::SpdyFrameType::SETTINGS ||
                                frame_type == spdy::SpdyFrameType::HEADERS)) {
-    write_queue_.Enqueue(
+    write_queue_->Enqueue(
         priority,
         static_cast<spdy::SpdyFrameType>(greased_http2_frame_.value().type),
         std::make_unique<GreasedBufferProducer>(
@@ -2808,7 +2846,7 @@ void SpdySession::DeleteStream(std::unique_ptr<SpdyStream> stream, int status) {
     in_flight_write_stream_.reset();
   }
 
-  write_queue_.RemovePendingWritesForStream(stream.get());
+  write_queue_->RemovePendingWritesForStream(stream.get());
   stream->OnClose(status);
 
   if (availability_state_ == STATE_AVAILABLE) {
@@ -44,7 +44,7 @@
 #include "net/spdy/spdy_buffer.h"
 #include "net/spdy/spdy_session_pool.h"
 #include "net/spdy/spdy_stream.h"
-#include "net/spdy/spdy_write_queue.h"
+#include "net/spdy/spdy_write_scheduler.h"
 #include "net/ssl/ssl_config_service.h"
 #include "net/third_party/quiche/src/spdy/core/spdy_alt_svc_wire_format.h"
 #include "net/third_party/quiche/src/spdy/core/spdy_framer.h"
@@ -1035,8 +1035,9 @@ class NET_EXPORT SpdySession : public BufferedSpdyFramerVisitorInterface,
   // Number of bytes that has been pushed by the server but never claimed.
   uint64_t bytes_pushed_and_unclaimed_count_;
 
-  // The write queue.
-  SpdyWriteQueue write_queue_;
+  // The write queue. A SpdyWriteQueue unless the SpdyFairWriteScheduler
+  // feature is enabled.
+  std::unique_ptr<SpdyWriteScheduler> write_queue_;
 
   // Data for the frame we are currently sending.
 
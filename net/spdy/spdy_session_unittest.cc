@@ -4522,6 +4522,88 @@ TEST_F(SpdySessionTest, SessionFlowControlEndToEnd) {
   EXPECT_FALSE(session_);
 }
 
+// Sends a DATA frame over a socket that supports WriteV(), with writes that
+// end inside the frame header and inside the payload. The header must be
+// written with the payload right behind it, and each write must consume
+// exactly the bytes the socket accepted.
+TEST_F(SpdySessionTest, SendDataWithWriteVAndPartialWrites) {
+  session_deps_.socket_factory->set_enable_write_v(true);
+
+  spdy::SpdySerializedFrame req(spdy_util_.ConstructSpdyPost(
+      kDefaultUrl, 1, kBodyDataSize, LOWEST, nullptr, 0));
+  spdy::SpdySerializedFrame body(
+      spdy_util_.ConstructSpdyDataFrame(1, kBodyDataStringPiece, true));
+  ASSERT_EQ(spdy::kFrameHeaderSize + kBodyDataSize, body.size());
+  // The first write ends 5 bytes into the header, the second 4 bytes into the
+  // payload, and the third writes the rest of the payload.
+  const size_t kFirstWriteSize = 5;
+  const size_t kSecondWriteSize = spdy::kFrameHeaderSize - kFirstWriteSize + 4;
+  const size_t kThirdWriteSize = body.size() - kFirstWriteSize -
+                                 kSecondWriteSize;
+  MockWrite writes[] = {
+      CreateMockWrite(req, 0),
+      MockWrite(SYNCHRONOUS, body.data(), kFirstWriteSize, 1),
+      MockWrite(ASYNC, body.data() + kFirstWriteSize, kSecondWriteSize, 2),
+      MockWrite(ASYNC, body.data() + kFirstWriteSize + kSecondWriteSize,
+                kThirdWriteSize, 3),
+  };
+
+  spdy::SpdySerializedFrame resp(
+      spdy_util_.ConstructSpdyGetReply(nullptr, 0, 1));
+  MockRead reads[] = {
+      MockRead(ASYNC, ERR_IO_PENDING, 4), CreateMockRead(resp, 5),
+      MockRead(ASYNC, 0, 6)  // EOF
+  };
+
+  SequencedSocketData data(reads, writes);
+  session_deps_.socket_factory->AddSocketDataProvider(&data);
+
+  AddSSLSocketData();
+
+  CreateNetworkSession();
+  CreateSpdySession();
+
+  base::WeakPtr<SpdyStream> stream =
+      CreateStreamSynchronously(SPDY_REQUEST_RESPONSE_STREAM, session_,
+                                test_url_, LOWEST, NetLogWithSource());
+  ASSERT_TRUE(stream);
+
+  test::StreamDelegateWithBody delegate(stream, kBodyDataStringPiece);
+  stream->SetDelegate(&delegate);
+
+  spdy::SpdyHeaderBlock headers(
+      spdy_util_.ConstructPostHeaderBlock(kDefaultUrl, kBodyDataSize));
+  EXPECT_EQ(ERR_IO_PENDING,
+            stream->SendRequestHeaders(std::move(headers), MORE_DATA_TO_SEND));
+
+  base::RunLoop().RunUntilIdle();
+  EXPECT_TRUE(data.AllWriteDataConsumed());
+
+  // Only the DATA frame was written with WriteV(): first with its whole
+  // header, then with what the first write left of it. The rest of the
+  // payload was written on its own.
+  EXPECT_THAT(data.write_v_header_sizes(),
+              testing::ElementsAre(
+                  static_cast<int>(spdy::kFrameHeaderSize),
+                  static_cast<int>(spdy::kFrameHeaderSize - kFirstWriteSize)));
+  ASSERT_TRUE(stream);
+  EXPECT_EQ(static_cast<int64_t>(req.size() + body.size()),
+            stream->raw_sent_bytes());
+  // The payload was consumed as written, so the send window stays reduced
+  // until a WINDOW_UPDATE arrives.
+  EXPECT_EQ(kDefaultInitialWindowSize - static_cast<int32_t>(kBodyDataSize),
+            session_send_window_size());
+
+  data.Resume();
+  EXPECT_THAT(delegate.WaitForClose(), IsError(ERR_CONNECTION_CLOSED));
+  EXPECT_TRUE(delegate.send_headers_completed());
+  EXPECT_EQ("200", delegate.GetResponseHeaderValue(":status"));
+
+  base::RunLoop().RunUntilIdle();
+  EXPECT_FALSE(session_);
+  EXPECT_TRUE(data.AllReadDataConsumed());
+}
+
 // Given a stall function and an unstall function, runs a test to make
 // sure that a stream resumes after unstall.
 void SpdySessionTest::RunResumeAfterUnstallTest(
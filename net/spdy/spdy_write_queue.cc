@@ -17,29 +17,6 @@
 
 namespace net {
 
-SpdyWriteQueue::PendingWrite::PendingWrite() = default;
-
-SpdyWriteQueue::PendingWrite::PendingWrite(
-    spdy::SpdyFrameType frame_type,
-    std::unique_ptr<SpdyBufferProducer> frame_producer,
-    const base::WeakPtr<SpdyStream>& stream,
-    const MutableNetworkTrafficAnnotationTag& traffic_annotation)
-    : frame_type(frame_type),
-      frame_producer(std::move(frame_producer)),
-      stream(stream),
-      traffic_annotation(traffic_annotation),
-      has_stream(stream.get() != nullptr) {}
-
-SpdyWriteQueue::PendingWrite::~PendingWrite() = default;
-
-SpdyWriteQueue::PendingWrite::PendingWrite(PendingWrite&& other) = default;
-SpdyWriteQueue::PendingWrite& SpdyWriteQueue::PendingWrite::operator=(
-    PendingWrite&& other) = default;
-
-size_t SpdyWriteQueue::PendingWrite::EstimateMemoryUsage() const {
-  return base::trace_event::EstimateMemoryUsage(frame_producer);
-}
-
 SpdyWriteQueue::SpdyWriteQueue() : removing_writes_(false) {}
 
 SpdyWriteQueue::~SpdyWriteQueue() {
@@ -80,12 +57,8 @@ bool SpdyWriteQueue::Dequeue(
     if (!queue_[i].empty()) {
       PendingWrite pending_write = std::move(queue_[i].front());
       queue_[i].pop_front();
-      *frame_type = pending_write.frame_type;
-      *frame_producer = std::move(pending_write.frame_producer);
-      *stream = pending_write.stream;
-      *traffic_annotation = pending_write.traffic_annotation;
-      if (pending_write.has_stream)
-        DCHECK(stream->get());
+      TakePendingWrite(std::move(pending_write), frame_type, frame_producer,
+                       stream, traffic_annotation);
       return true;
     }
   }
@@ -12,6 +12,7 @@
 #include "base/memory/weak_ptr.h"
 #include "net/base/net_export.h"
 #include "net/base/request_priority.h"
+#include "net/spdy/spdy_write_scheduler.h"
 #include "net/third_party/quiche/src/spdy/core/spdy_protocol.h"
 #include "net/traffic_annotation/network_traffic_annotation.h"
 
@@ -22,81 +23,35 @@ class SpdyStream;
 
 // A queue of SpdyBufferProducers to produce frames to write. Ordered
 // by priority, and then FIFO.
-class NET_EXPORT_PRIVATE SpdyWriteQueue {
+class NET_EXPORT_PRIVATE SpdyWriteQueue : public SpdyWriteScheduler {
  public:
   SpdyWriteQueue();
-  ~SpdyWriteQueue();
+  ~SpdyWriteQueue() override;
 
-  // Returns whether there is anything in the write queue,
-  // i.e. whether the next call to Dequeue will return true.
-  bool IsEmpty() const;
-
-  // Enqueues the given frame producer of the given type at the given
-  // priority associated with the given stream, which may be NULL if
-  // the frame producer is not associated with a stream. If |stream|
-  // is non-NULL, its priority must be equal to |priority|, and it
-  // must remain non-NULL until the write is dequeued or removed.
+  // SpdyWriteScheduler implementation:
+  bool IsEmpty() const override;
   void Enqueue(RequestPriority priority,
                spdy::SpdyFrameType frame_type,
                std::unique_ptr<SpdyBufferProducer> frame_producer,
                const base::WeakPtr<SpdyStream>& stream,
-               const NetworkTrafficAnnotationTag& traffic_annotation);
-
+               const NetworkTrafficAnnotationTag& traffic_annotation) override;
   // Dequeues the frame producer with the highest priority that was
-  // enqueued the earliest and its associated stream. Returns true and
-  // fills in |frame_type|, |frame_producer|, and |stream| if
-  // successful -- otherwise, just returns false.
+  // enqueued the earliest and its associated stream.
   bool Dequeue(spdy::SpdyFrameType* frame_type,
                std::unique_ptr<SpdyBufferProducer>* frame_producer,
                base::WeakPtr<SpdyStream>* stream,
-               MutableNetworkTrafficAnnotationTag* traffic_annotation);
-
-  // Removes all pending writes for the given stream, which must be
-  // non-NULL.
-  void RemovePendingWritesForStream(SpdyStream* stream);
-
-  // Removes all pending writes for streams after |last_good_stream_id|
-  // and streams with no stream id.
+               MutableNetworkTrafficAnnotationTag* traffic_annotation) override;
+  void RemovePendingWritesForStream(SpdyStream* stream) override;
   void RemovePendingWritesForStreamsAfter(
-      spdy::SpdyStreamId last_good_stream_id);
-
-  // Change priority of all pending writes for the given stream.  Frames will be
-  // queued after other writes with |new_priority|.
+      spdy::SpdyStreamId last_good_stream_id) override;
+  // Frames will be queued after other writes with |new_priority|.
   void ChangePriorityOfWritesForStream(SpdyStream* stream,
                                        RequestPriority old_priority,
-                                       RequestPriority new_priority);
-
-  // Removes all pending writes.
-  void Clear();
-
-  // Returns the estimate of dynamically allocated memory in bytes.
-  size_t EstimateMemoryUsage() const;
+                                       RequestPriority new_priority) override;
+  void Clear() override;
+  size_t EstimateMemoryUsage() const override;
 
  private:
-  // A struct holding a frame producer and its associated stream.
-  struct PendingWrite {
-    spdy::SpdyFrameType frame_type;
-    std::unique_ptr<SpdyBufferProducer> frame_producer;
-    base::WeakPtr<SpdyStream> stream;
-    MutableNetworkTrafficAnnotationTag traffic_annotation;
-    // Whether |stream| was non-NULL when enqueued.
-    bool has_stream;
-
-    PendingWrite();
-    PendingWrite(spdy::SpdyFrameType frame_type,
-                 std::unique_ptr<SpdyBufferProducer> frame_producer,
-                 const base::WeakPtr<SpdyStream>& stream,
-                 const MutableNetworkTrafficAnnotationTag& traffic_annotation);
-    ~PendingWrite();
-    PendingWrite(PendingWrite&& other);
-    PendingWrite& operator=(PendingWrite&& other);
-
-    size_t EstimateMemoryUsage() const;
-
-   private:
-    DISALLOW_COPY_AND_ASSIGN(PendingWrite);
-  };
-
   bool removing_writes_;
 
   // The actual write queue, binned by priority.
@@ -0,0 +1,59 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "net/spdy/spdy_write_scheduler.h"
+
+#include <utility>
+
+#include "base/logging.h"
+#include "base/trace_event/memory_usage_estimator.h"
+#include "net/spdy/spdy_buffer_producer.h"
+#include "net/spdy/spdy_stream.h"
+
+namespace net {
+
+SpdyWriteScheduler::PendingWrite::PendingWrite() = default;
+
+SpdyWriteScheduler::PendingWrite::PendingWrite(
+    spdy::SpdyFrameType frame_type,
+    std::unique_ptr<SpdyBufferProducer> frame_producer,
+    const base::WeakPtr<SpdyStream>& stream,
+    const MutableNetworkTrafficAnnotationTag& traffic_annotation)
+    : frame_type(frame_type),
+      frame_producer(std::move(frame_producer)),
+      stream(stream),
+      traffic_annotation(traffic_annotation),
+      has_stream(stream.get() != nullptr) {}
+
+SpdyWriteScheduler::PendingWrite::~PendingWrite() = default;
+
+SpdyWriteScheduler::PendingWrite::PendingWrite(PendingWrite&& other) =
+    default;
+SpdyWriteScheduler::PendingWrite& SpdyWriteScheduler::PendingWrite::operator=(
+    PendingWrite&& other) = default;
+
+size_t SpdyWriteScheduler::PendingWrite::EstimateMemoryUsage() const {
+  return base::trace_event::EstimateMemoryUsage(frame_producer);
+}
+
+SpdyWriteScheduler::SpdyWriteScheduler() = default;
+
+SpdyWriteScheduler::~SpdyWriteScheduler() = default;
+
+// static
+void SpdyWriteScheduler::TakePendingWrite(
+    PendingWrite pending_write,
+    spdy::SpdyFrameType* frame_type,
+    std::unique_ptr<SpdyBufferProducer>* frame_producer,
+    base::WeakPtr<SpdyStream>* stream,
+    MutableNetworkTrafficAnnotationTag* traffic_annotation) {
+  *frame_type = pending_write.frame_type;
+  *frame_producer = std::move(pending_write.frame_producer);
+  *stream = pending_write.stream;
+  *traffic_annotation = pending_write.traffic_annotation;
+  if (pending_write.has_stream)
+    DCHECK(stream->get());
+}
+
+}  // namespace net
@@ -0,0 +1,118 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef NET_SPDY_SPDY_WRITE_SCHEDULER_H_
+#define NET_SPDY_SPDY_WRITE_SCHEDULER_H_
+
+#include <stddef.h>
+
+#include <memory>
+
+#include "base/macros.h"
+#include "base/memory/weak_ptr.h"
+#include "net/base/net_export.h"
+#include "net/base/request_priority.h"
+#include "net/third_party/quiche/src/spdy/core/spdy_protocol.h"
+#include "net/traffic_annotation/network_traffic_annotation.h"
+
+namespace net {
+
+class SpdyBufferProducer;
+class SpdyStream;
+
+// The interface of the objects deciding in which order SpdySession writes its
+// frames. Frames of a given stream are always dequeued in the order they were
+// enqueued, implementations only decide how frames of different streams, and
+// frames not associated with any stream, are interleaved.
+class NET_EXPORT_PRIVATE SpdyWriteScheduler {
+ public:
+  SpdyWriteScheduler();
+  virtual ~SpdyWriteScheduler();
+
+  // Returns whether there is anything in the write queue,
+  // i.e. whether the next call to Dequeue will return true.
+  virtual bool IsEmpty() const = 0;
+
+  // Enqueues the given frame producer of the given type at the given
+  // priority associated with the given stream, which may be NULL if
+  // the frame producer is not associated with a stream. If |stream|
+  // is non-NULL, its priority must be equal to |priority|, and it
+  // must remain non-NULL until the write is dequeued or removed.
+  virtual void Enqueue(
+      RequestPriority priority,
+      spdy::SpdyFrameType frame_type,
+      std::unique_ptr<SpdyBufferProducer> frame_producer,
+      const base::WeakPtr<SpdyStream>& stream,
+      const NetworkTrafficAnnotationTag& traffic_annotation) = 0;
+
+  // Dequeues the next frame producer to write and its associated stream.
+  // Returns true and fills in |frame_type|, |frame_producer|, and |stream| if
+  // successful -- otherwise, just returns false.
+  virtual bool Dequeue(
+      spdy::SpdyFrameType* frame_type,
+      std::unique_ptr<SpdyBufferProducer>* frame_producer,
+      base::WeakPtr<SpdyStream>* stream,
+      MutableNetworkTrafficAnnotationTag* traffic_annotation) = 0;
+
+  // Removes all pending writes for the given stream, which must be
+  // non-NULL. Called before |stream| is destroyed.
+  virtual void RemovePendingWritesForStream(SpdyStream* stream) = 0;
+
+  // Removes all pending writes for streams after |last_good_stream_id|
+  // and streams with no stream id.
+  virtual void RemovePendingWritesForStreamsAfter(
+      spdy::SpdyStreamId last_good_stream_id) = 0;
+
+  // Change priority of all pending writes for the given stream.
+  virtual void ChangePriorityOfWritesForStream(
+      SpdyStream* stream,
+      RequestPriority old_priority,
+      RequestPriority new_priority) = 0;
+
+  // Removes all pending writes.
+  virtual void Clear() = 0;
+
+  // Returns the estimate of dynamically allocated memory in bytes.
+  virtual size_t EstimateMemoryUsage() const = 0;
+
+ protected:
+  // A struct holding a frame producer and its associated stream.
+  struct NET_EXPORT_PRIVATE PendingWrite {
+    spdy::SpdyFrameType frame_type;
+    std::unique_ptr<SpdyBufferProducer> frame_producer;
+    base::WeakPtr<SpdyStream> stream;
+    MutableNetworkTrafficAnnotationTag traffic_annotation;
+    // Whether |stream| was non-NULL when enqueued.
+    bool has_stream;
+
+    PendingWrite();
+    PendingWrite(spdy::SpdyFrameType frame_type,
+                 std::unique_ptr<SpdyBufferProducer> frame_producer,
+                 const base::WeakPtr<SpdyStream>& stream,
+                 const MutableNetworkTrafficAnnotationTag& traffic_annotation);
+    ~PendingWrite();
+    PendingWrite(PendingWrite&& other);
+    PendingWrite& operator=(PendingWrite&& other);
+
+    size_t EstimateMemoryUsage() const;
+
+   private:
+    DISALLOW_COPY_AND_ASSIGN(PendingWrite);
+  };
+
+  // Fills in the out parameters of Dequeue() from |pending_write|.
+  static void TakePendingWrite(
+      PendingWrite pending_write,
+      spdy::SpdyFrameType* frame_type,
+      std::unique_ptr<SpdyBufferProducer>* frame_producer,
+      base::WeakPtr<SpdyStream>* stream,
+      MutableNetworkTrafficAnnotationTag* traffic_annotation);
+
+ private:
+  DISALLOW_COPY_AND_ASSIGN(SpdyWriteScheduler);
+};
+
+}  // namespace net
+
+#endif  // NET_SPDY_SPDY_WRITE_SCHEDULER_H_
@@ -0,0 +1,100 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "base/logging.h"
+#include "base/stl_util.h"
+#include "base/test/perf_time_logger.h"
+#include "net/base/request_priority.h"
+#include "net/log/net_log_with_source.h"
+#include "net/spdy/spdy_buffer_producer.h"
+#include "net/spdy/spdy_fair_write_scheduler.h"
+#include "net/spdy/spdy_stream.h"
+#include "net/spdy/spdy_write_queue.h"
+#include "net/traffic_annotation/network_traffic_annotation_test_helper.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "url/gurl.h"
+
+namespace net {
+
+namespace {
+
+const int kNumStreams = 100;
+const int kNumRounds = 200;
+// Frame sizes of the streams, cycled through: mostly small responses, with a
+// few large downloads.
+const size_t kFrameSizes[] = {16, 256, 1024, 1024, 16384};
+
+std::unique_ptr<SpdyBufferProducer> MakeProducer(size_t size) {
+  return std::make_unique<SimpleBufferProducer>(
+      std::make_unique<SpdyBuffer>(std::string(size, 'x').data(), size));
+}
+
+// Enqueues frames of mixed sizes for |kNumStreams| streams of the same
+// priority and dequeues them all, |kNumRounds| times. Logs the time spent and
+// the average number of bytes written before the last frame of each small
+// stream.
+void RunMixedStreamSizes(SpdyWriteScheduler* scheduler,
+                         const std::string& name) {
+  std::vector<std::unique_ptr<SpdyStream>> streams;
+  for (int i = 0; i < kNumStreams; ++i) {
+    streams.push_back(std::make_unique<SpdyStream>(
+        SPDY_BIDIRECTIONAL_STREAM, base::WeakPtr<SpdySession>(), GURL(),
+        DEFAULT_PRIORITY, 0, 0, NetLogWithSource(),
+        TRAFFIC_ANNOTATION_FOR_TESTS));
+  }
+
+  uint64_t small_stream_latency = 0;
+  base::PerfTimeLogger timer(name.c_str());
+  for (int round = 0; round < kNumRounds; ++round) {
+    for (int i = 0; i < kNumStreams; ++i) {
+      size_t size = kFrameSizes[i % base::size(kFrameSizes)];
+      // Large streams write several frames per round.
+      int num_frames = size > 1024 ? 4 : 1;
+      for (int j = 0; j < num_frames; ++j) {
+        scheduler->Enqueue(DEFAULT_PRIORITY, spdy::SpdyFrameType::DATA,
+                           MakeProducer(size), streams[i]->GetWeakPtr(),
+                           TRAFFIC_ANNOTATION_FOR_TESTS);
+      }
+    }
+
+    uint64_t bytes_written = 0;
+    spdy::SpdyFrameType frame_type;
+    std::unique_ptr<SpdyBufferProducer> producer;
+    base::WeakPtr<SpdyStream> stream;
+    MutableNetworkTrafficAnnotationTag traffic_annotation;
+    while (scheduler->Dequeue(&frame_type, &producer, &stream,
+                              &traffic_annotation)) {
+      size_t size = producer->ProduceBuffer()->GetRemainingSize();
+      bytes_written += size;
+      if (size == kFrameSizes[0])
+        small_stream_latency += bytes_written;
+    }
+  }
+  timer.Done();
+
+  int small_streams_per_round =
+      (kNumStreams + base::size(kFrameSizes) - 1) / base::size(kFrameSizes);
+  LOG(INFO) << name << ": average bytes written before a small stream's frame: "
+            << small_stream_latency / (kNumRounds * small_streams_per_round);
+}
+
+TEST(SpdyWriteSchedulerPerfTest, MixedStreamSizesWriteQueue) {
+  SpdyWriteQueue write_queue;
+  RunMixedStreamSizes(&write_queue, "Spdy_write_queue_mixed_stream_sizes");
+}
+
+TEST(SpdyWriteSchedulerPerfTest, MixedStreamSizesFairWriteScheduler) {
+  SpdyFairWriteScheduler scheduler;
+  RunMixedStreamSizes(&scheduler,
+                      "Spdy_fair_write_scheduler_mixed_stream_sizes");
+}
+
+}  // namespace
+
+}  // namespace net
@@ -6,6 +6,7 @@
 
 #include <tuple>
 
+#include "base/logging.h"
 #include "net/ssl/ssl_config_service_defaults.h"
 
 namespace net {
@@ -30,6 +31,24 @@ SSLConfigService::SSLConfigService()
 
 SSLConfigService::~SSLConfigService() = default;
 
+void SSLConfigService::SetSharedSessionCaches(
+    SSLClientSessionCache* session_cache,
+    SSLClientSessionCache* privacy_mode_session_cache) {
+  // Sessions established in privacy mode must not be resumed by other
+  // requests.
+  DCHECK(!session_cache || session_cache != privacy_mode_session_cache);
+  DCHECK_EQ(!session_cache, !privacy_mode_session_cache);
+  shared_session_cache_ = session_cache;
+  shared_privacy_mode_session_cache_ = privacy_mode_session_cache;
+}
+
+SSLClientSessionCache* SSLConfigService::shared_session_cache(
+    PrivacyMode privacy_mode) const {
+  return privacy_mode == PRIVACY_MODE_ENABLED
+             ? shared_privacy_mode_session_cache_
+             : shared_session_cache_;
+}
+
 void SSLConfigService::AddObserver(Observer* observer) {
   observer_list_.AddObserver(observer);
 }
@@ -10,10 +10,13 @@
 #include "base/memory/ref_counted.h"
 #include "base/observer_list.h"
 #include "net/base/net_export.h"
+#include "net/base/privacy_mode.h"
 #include "net/ssl/ssl_config.h"
 
 namespace net {
 
+class SSLClientSessionCache;
+
 // The interface for retrieving the SSL configuration.  This interface
 // does not cover setting the SSL configuration, as on some systems, the
 // SSLConfigService objects may not have direct access to the configuration, or
@@ -69,6 +72,21 @@ class NET_EXPORT SSLConfigService {
   virtual bool CanShareConnectionWithClientCerts(
       const std::string& hostname) const = 0;
 
+  // Makes the HttpNetworkSessions created with this service afterwards share
+  // |session_cache| and |privacy_mode_session_cache| instead of using their
+  // own, so that connections from different sessions and socket pools resume
+  // each other's TLS sessions, including with early data where the server
+  // and SSLConfig::early_data_enabled allow it. Sessions of privacy mode
+  // requests stay in |privacy_mode_session_cache|. The caches must outlive
+  // the HttpNetworkSessions, and all of them must be used on the same thread.
+  void SetSharedSessionCaches(
+      SSLClientSessionCache* session_cache,
+      SSLClientSessionCache* privacy_mode_session_cache);
+
+  // Returns the shared session cache for |privacy_mode|, or nullptr if there
+  // are none.
+  SSLClientSessionCache* shared_session_cache(PrivacyMode privacy_mode) const;
+
   // Add an observer of this service.
   void AddObserver(Observer* observer);
 
@@ -93,6 +111,8 @@ class NET_EXPORT SSLConfigService {
 
  private:
   base::ObserverList<Observer>::Unchecked observer_list_;
+  SSLClientSessionCache* shared_session_cache_ = nullptr;
+  SSLClientSessionCache* shared_privacy_mode_session_cache_ = nullptr;
 };
 
 }  // namespace net
@@ -6,6 +6,7 @@
 
 #include <vector>
 
+#include "net/ssl/ssl_client_session_cache.h"
 #include "testing/gmock/include/gmock/gmock.h"
 #include "testing/gtest/include/gtest/gtest.h"
 
@@ -137,4 +138,24 @@ TEST(SSLConfigServiceTest, ConfigUpdatesNotifyObservers) {
   mock_service.RemoveObserver(&observer);
 }
 
+TEST(SSLConfigServiceTest, SharedSessionCaches) {
+  MockSSLConfigService mock_service((SSLConfig()));
+  EXPECT_FALSE(mock_service.shared_session_cache(PRIVACY_MODE_DISABLED));
+  EXPECT_FALSE(mock_service.shared_session_cache(PRIVACY_MODE_ENABLED));
+
+  SSLClientSessionCache session_cache((SSLClientSessionCache::Config()));
+  SSLClientSessionCache privacy_mode_session_cache(
+      (SSLClientSessionCache::Config()));
+  mock_service.SetSharedSessionCaches(&session_cache,
+                                      &privacy_mode_session_cache);
+  EXPECT_EQ(&session_cache,
+            mock_service.shared_session_cache(PRIVACY_MODE_DISABLED));
+  EXPECT_EQ(&privacy_mode_session_cache,
+            mock_service.shared_session_cache(PRIVACY_MODE_ENABLED));
+
+  mock_service.SetSharedSessionCaches(nullptr, nullptr);
+  EXPECT_FALSE(mock_service.shared_session_cache(PRIVACY_MODE_DISABLED));
+  EXPECT_FALSE(mock_service.shared_session_cache(PRIVACY_MODE_ENABLED));
+}
+
 }  // namespace net
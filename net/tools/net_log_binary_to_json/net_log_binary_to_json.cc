@@ -0,0 +1,61 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Converts a binary NetLog, written by FileNetLogObserver in
+// Format::kBinary, to the JSON format read by the NetLog viewer.
+
+#include <iostream>
+#include <string>
+
+#include "base/command_line.h"
+#include "base/files/file_path.h"
+#include "base/files/file_util.h"
+#include "net/log/net_log_binary_encoding.h"
+
+namespace {
+
+// Print the command line help.
+void PrintHelp(const char* command_line_name) {
+  std::cout << command_line_name << " <binary netlog> <json netlog>"
+            << std::endl
+            << std::endl;
+  std::cout << "Converts a binary NetLog file to the JSON NetLog format."
+            << std::endl;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  base::CommandLine::Init(argc, argv);
+  const base::CommandLine& command_line =
+      *base::CommandLine::ForCurrentProcess();
+
+  base::CommandLine::StringVector args = command_line.GetArgs();
+  if (args.size() != 2) {
+    PrintHelp(argv[0]);
+    return 1;
+  }
+
+  base::FilePath input_path(args[0]);
+  base::FilePath output_path(args[1]);
+
+  std::string binary;
+  if (!base::ReadFileToString(input_path, &binary)) {
+    std::cerr << "Failed reading " << input_path.value() << std::endl;
+    return 1;
+  }
+
+  std::string json;
+  if (!net::ConvertBinaryNetLogToJson(binary, &json)) {
+    std::cerr << input_path.value() << " isn't a binary NetLog" << std::endl;
+    return 1;
+  }
+
+  if (base::WriteFile(output_path, json.data(), json.size()) !=
+      static_cast<int>(json.size())) {
+    std::cerr << "Failed writing " << output_path.value() << std::endl;
+    return 1;
+  }
+  return 0;
+}
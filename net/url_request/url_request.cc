@@ -574,6 +574,7 @@ URLRequest::URLRequest(const GURL& url,
                                          : context->network_delegate()),
       net_log_(NetLogWithSource::Make(context->net_log(),
                                       NetLogSourceType::URL_REQUEST)),
+      arena_(base::MakeRefCounted<RequestArena>()),
       url_chain_(1, url),
       attach_same_site_cookies_(false),
       method_("GET"),
@@ -605,6 +606,7 @@ URLRequest::URLRequest(const GURL& url,
   // Sanity check out environment.
   DCHECK(base::ThreadTaskRunnerHandle::IsSet());
 
+  extra_request_headers_.UseArena(arena_);
   context->url_requests()->insert(this);
   net_log_.BeginEvent(
       NetLogEventType::REQUEST_ALIVE,
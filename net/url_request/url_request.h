@@ -29,6 +29,7 @@
 #include "net/base/network_delegate.h"
 #include "net/base/privacy_mode.h"
 #include "net/base/proxy_server.h"
+#include "net/base/request_arena.h"
 #include "net/base/request_priority.h"
 #include "net/base/upload_progress.h"
 #include "net/cookies/canonical_cookie.h"
@@ -661,6 +662,12 @@ class NET_EXPORT URLRequest : public base::SupportsUserData {
 
   const NetLogWithSource& net_log() const { return net_log_; }
 
+  // Returns the arena which short-lived objects created for this request, such
+  // as its request and response headers, can allocate from. Objects using the
+  // arena keep a reference to it: it is released with the request unless they
+  // outlive it.
+  RequestArena* arena() const { return arena_.get(); }
+
   // Returns the expected content size if available
   int64_t GetExpectedContentSize() const;
 
@@ -856,6 +863,8 @@ class NET_EXPORT URLRequest : public base::SupportsUserData {
   // Tracks the time spent in various load states throughout this request.
   NetLogWithSource net_log_;
 
+  scoped_refptr<RequestArena> arena_;
+
   std::unique_ptr<URLRequestJob> job_;
   std::unique_ptr<UploadDataStream> upload_data_stream_;
 
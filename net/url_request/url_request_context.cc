@@ -136,6 +136,24 @@ bool URLRequestContext::OnMemoryDump(
   dump->AddScalar(base::trace_event::MemoryAllocatorDump::kNameObjectCount,
                   base::trace_event::MemoryAllocatorDump::kUnitsObjects,
                   url_requests_->size());
+
+  // Arenas kept alive by objects which outlived their request aren't
+  // accounted.
+  size_t arena_allocated_bytes = 0;
+  size_t arena_used_bytes = 0;
+  for (const URLRequest* request : *url_requests_) {
+    arena_allocated_bytes += request->arena()->allocated_bytes();
+    arena_used_bytes += request->arena()->used_bytes();
+  }
+  base::trace_event::MemoryAllocatorDump* arena_dump =
+      pmd->CreateAllocatorDump(dump->absolute_name() + "/request_arenas");
+  arena_dump->AddScalar(base::trace_event::MemoryAllocatorDump::kNameSize,
+                        base::trace_event::MemoryAllocatorDump::kUnitsBytes,
+                        arena_allocated_bytes);
+  arena_dump->AddScalar("used_size",
+                        base::trace_event::MemoryAllocatorDump::kUnitsBytes,
+                        arena_used_bytes);
+
   HttpTransactionFactory* transaction_factory = http_transaction_factory();
   if (transaction_factory) {
     HttpNetworkSession* network_session = transaction_factory->GetSession();
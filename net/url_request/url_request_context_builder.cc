@@ -24,6 +24,7 @@
 #include "net/cert/ct_verifier.h"
 #include "net/cert/multi_log_ct_verifier.h"
 #include "net/cookies/cookie_monster.h"
+#include "net/dns/host_cache_persister.h"
 #include "net/dns/host_resolver.h"
 #include "net/dns/host_resolver_manager.h"
 #include "net/http/http_auth_handler_factory.h"
@@ -183,9 +184,15 @@ class ContainerURLRequestContext final : public URLRequestContext {
     transport_security_persister_ = std::move(transport_security_persister);
   }
 
+  void set_host_cache_persister(
+      std::unique_ptr<HostCachePersister> host_cache_persister) {
+    host_cache_persister_ = std::move(host_cache_persister);
+  }
+
  private:
   URLRequestContextStorage storage_;
   std::unique_ptr<TransportSecurityPersister> transport_security_persister_;
+  std::unique_ptr<HostCachePersister> host_cache_persister_;
 
   DISALLOW_COPY_AND_ASSIGN(ContainerURLRequestContext);
 };
@@ -452,6 +459,19 @@ std::unique_ptr<URLRequestContext> URLRequestContextBuilder::Build() {
   host_resolver_->SetRequestContext(context.get());
   storage->set_host_resolver(std::move(host_resolver_));
 
+  if (!host_cache_persister_path_.empty() &&
+      context->host_resolver()->GetHostCache()) {
+    // The cache is only a performance optimization, so losing the last
+    // writes on shutdown is fine.
+    scoped_refptr<base::SequencedTaskRunner> task_runner(
+        base::CreateSequencedTaskRunnerWithTraits(
+            {base::MayBlock(), base::TaskPriority::BEST_EFFORT,
+             base::TaskShutdownBehavior::SKIP_ON_SHUTDOWN}));
+    context->set_host_cache_persister(std::make_unique<HostCachePersister>(
+        context->host_resolver()->GetHostCache(), host_cache_persister_path_,
+        task_runner));
+  }
+
   if (ssl_config_service_) {
     storage->set_ssl_config_service(std::move(ssl_config_service_));
   } else {
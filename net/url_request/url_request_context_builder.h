@@ -317,6 +317,14 @@ class NET_EXPORT URLRequestContextBuilder {
     transport_security_persister_path_ = transport_security_persister_path;
   }
 
+  // Sets the file in which to keep a snapshot of the host cache across
+  // restarts. Only one context may persist the cache of a shared
+  // HostResolverManager.
+  void set_host_cache_persister_path(
+      const base::FilePath& host_cache_persister_path) {
+    host_cache_persister_path_ = host_cache_persister_path;
+  }
+
   void SetSpdyAndQuicEnabled(bool spdy_enabled,
                              bool quic_enabled);
 
@@ -415,6 +423,7 @@ class NET_EXPORT URLRequestContextBuilder {
   HttpNetworkSession::Params http_network_session_params_;
   CreateHttpTransactionFactoryCallback create_http_network_transaction_factory_;
   base::FilePath transport_security_persister_path_;
+  base::FilePath host_cache_persister_path_;
   NetLog* net_log_ = nullptr;
   std::unique_ptr<HostResolver> host_resolver_;
   std::string host_mapping_rules_;
@@ -292,6 +292,9 @@ URLRequestHttpJob::URLRequestHttpJob(
       total_received_bytes_from_previous_transactions_(0),
       total_sent_bytes_from_previous_transactions_(0),
       weak_factory_(this) {
+  request_info_.arena = request->arena();
+  request_info_.extra_headers.UseArena(request_info_.arena);
+
   URLRequestThrottlerManager* manager = request->context()->throttler_manager();
   if (manager)
     throttling_entry_ = manager->RegisterRequestUrl(request->url());
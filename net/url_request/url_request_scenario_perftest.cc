@@ -0,0 +1,615 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// End-to-end benchmarks of the request path: URLRequest, HttpCache,
+// HttpNetworkTransaction, socket pools and TLS or QUIC, against in-process
+// servers. Each scenario replays a page-load request graph, where a request
+// starts once the request it was discovered from completes, and several page
+// loads run concurrently.
+//
+// By default a built-in graph of a news article is replayed. Recorded graphs
+// in the same format can be supplied with --page-load-graph=<file>. Results
+// are printed in the perf_test format, and --perf-results-json=<file> also
+// merges them into a JSON dictionary keyed by scenario, for regression
+// tracking.
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "base/allocator/buildflags.h"
+#include "base/barrier_closure.h"
+#include "base/bind.h"
+#include "base/callback.h"
+#include "base/command_line.h"
+#include "base/files/file_path.h"
+#include "base/files/file_util.h"
+#include "base/json/json_reader.h"
+#include "base/json/json_writer.h"
+#include "base/logging.h"
+#include "base/macros.h"
+#include "base/optional.h"
+#include "base/process/process_metrics.h"
+#include "base/run_loop.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/time/time.h"
+#include "base/values.h"
+#include "net/base/host_port_pair.h"
+#include "net/base/ip_address.h"
+#include "net/base/ip_endpoint.h"
+#include "net/base/load_flags.h"
+#include "net/base/net_errors.h"
+#include "net/cert/mock_cert_verifier.h"
+#include "net/dns/mapped_host_resolver.h"
+#include "net/dns/mock_host_resolver.h"
+#include "net/http/http_network_session.h"
+#include "net/http/http_status_code.h"
+#include "net/test/embedded_test_server/embedded_test_server.h"
+#include "net/test/embedded_test_server/http_request.h"
+#include "net/test/embedded_test_server/http_response.h"
+#include "net/test/test_with_scoped_task_environment.h"
+#include "net/third_party/quiche/src/quic/test_tools/crypto_test_utils.h"
+#include "net/third_party/quiche/src/quic/tools/quic_memory_cache_backend.h"
+#include "net/tools/quic/quic_simple_server.h"
+#include "net/traffic_annotation/network_traffic_annotation_test_helper.h"
+#include "net/url_request/url_request.h"
+#include "net/url_request/url_request_test_util.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "testing/perf/perf_test.h"
+#include "url/gurl.h"
+
+#if BUILDFLAG(USE_ALLOCATOR_SHIM)
+#include "base/allocator/allocator_shim.h"
+#endif
+
+namespace net {
+
+namespace {
+
+const char kPageLoadGraphSwitch[] = "page-load-graph";
+const char kResultsJsonSwitch[] = "perf-results-json";
+
+// This must match the certificate served by the QUIC server.
+const char kQuicHost[] = "test.example.com";
+
+// Number of measured rounds, and of page loads running concurrently in each.
+const int kRounds = 20;
+const int kConcurrentPageLoads = 4;
+
+// A news article page load. Each request lists the index of the request it is
+// discovered from: the document, a stylesheet referencing fonts, or a script
+// fetching data and ads.
+const char kDefaultPageLoadGraph[] = R"({
+  "name": "news_article",
+  "requests": [
+    {"path": "/article.html", "size": 48000, "parent": -1},
+    {"path": "/css/site.css", "size": 62000, "parent": 0},
+    {"path": "/css/article.css", "size": 18000, "parent": 0},
+    {"path": "/js/vendor.js", "size": 240000, "parent": 0},
+    {"path": "/js/app.js", "size": 96000, "parent": 0},
+    {"path": "/js/ads.js", "size": 41000, "parent": 0},
+    {"path": "/img/hero.jpg", "size": 180000, "parent": 0},
+    {"path": "/img/thumb-1.jpg", "size": 12000, "parent": 0},
+    {"path": "/img/thumb-2.jpg", "size": 14000, "parent": 0},
+    {"path": "/img/thumb-3.jpg", "size": 11000, "parent": 0},
+    {"path": "/img/thumb-4.jpg", "size": 13000, "parent": 0},
+    {"path": "/img/thumb-5.jpg", "size": 12500, "parent": 0},
+    {"path": "/img/thumb-6.jpg", "size": 9000, "parent": 0},
+    {"path": "/fonts/sans-regular.woff2", "size": 28000, "parent": 1},
+    {"path": "/fonts/sans-bold.woff2", "size": 29000, "parent": 1},
+    {"path": "/img/logo.svg", "size": 4200, "parent": 1},
+    {"path": "/img/sprites.png", "size": 21000, "parent": 1},
+    {"path": "/fonts/serif-regular.woff2", "size": 34000, "parent": 2},
+    {"path": "/api/comments.json", "size": 22000, "parent": 4},
+    {"path": "/api/related.json", "size": 9000, "parent": 4},
+    {"path": "/api/beacon", "size": 40, "parent": 4},
+    {"path": "/img/avatar-1.png", "size": 3000, "parent": 18},
+    {"path": "/img/avatar-2.png", "size": 3200, "parent": 18},
+    {"path": "/img/avatar-3.png", "size": 2900, "parent": 18},
+    {"path": "/img/related-1.jpg", "size": 15000, "parent": 19},
+    {"path": "/img/related-2.jpg", "size": 16000, "parent": 19},
+    {"path": "/ads/slot.html", "size": 6000, "parent": 5},
+    {"path": "/ads/creative.jpg", "size": 55000, "parent": 26}
+  ]
+})";
+
+struct GraphRequest {
+  std::string path;
+  int size;
+  // Index of the request whose completion starts this one, or -1.
+  int parent;
+};
+
+struct PageLoadGraph {
+  std::string name;
+  // Ordered so that parents come before their children.
+  std::vector<GraphRequest> requests;
+};
+
+bool ParsePageLoadGraph(const std::string& json, PageLoadGraph* graph) {
+  base::Optional<base::Value> value = base::JSONReader::Read(json);
+  if (!value || !value->is_dict())
+    return false;
+  const std::string* name = value->FindStringKey("name");
+  const base::Value* requests = value->FindListKey("requests");
+  if (!name || !requests)
+    return false;
+
+  graph->name = *name;
+  for (const base::Value& request : requests->GetList()) {
+    if (!request.is_dict())
+      return false;
+    const std::string* path = request.FindStringKey("path");
+    base::Optional<int> size = request.FindIntKey("size");
+    base::Optional<int> parent = request.FindIntKey("parent");
+    if (!path || !size || !parent || *size < 0 || *parent < -1 ||
+        *parent >= static_cast<int>(graph->requests.size())) {
+      return false;
+    }
+    graph->requests.push_back({*path, *size, *parent});
+  }
+  return !graph->requests.empty();
+}
+
+std::unique_ptr<test_server::HttpResponse> HandleGraphRequest(
+    const std::map<std::string, int>& sizes,
+    const test_server::HttpRequest& request) {
+  auto it = sizes.find(request.relative_url);
+  if (it == sizes.end())
+    return nullptr;
+  auto response = std::make_unique<test_server::BasicHttpResponse>();
+  response->set_code(HTTP_OK);
+  response->set_content(std::string(it->second, 'x'));
+  response->set_content_type("application/octet-stream");
+  response->AddCustomHeader("Cache-Control", "max-age=3600");
+  return std::move(response);
+}
+
+#if BUILDFLAG(USE_ALLOCATOR_SHIM)
+
+// Counts allocations made by any thread of the process, which includes the
+// in-process servers.
+std::atomic<uint64_t> g_allocation_count{0};
+
+using base::allocator::AllocatorDispatch;
+
+void* CountingAlloc(const AllocatorDispatch* self, size_t size, void* context) {
+  g_allocation_count.fetch_add(1, std::memory_order_relaxed);
+  return self->next->alloc_function(self->next, size, context);
+}
+
+void* CountingAllocZeroInitialized(const AllocatorDispatch* self,
+                                   size_t n,
+                                   size_t size,
+                                   void* context) {
+  g_allocation_count.fetch_add(1, std::memory_order_relaxed);
+  return self->next->alloc_zero_initialized_function(self->next, n, size,
+                                                     context);
+}
+
+void* CountingAllocAligned(const AllocatorDispatch* self,
+                           size_t alignment,
+                           size_t size,
+                           void* context) {
+  g_allocation_count.fetch_add(1, std::memory_order_relaxed);
+  return self->next->alloc_aligned_function(self->next, alignment, size,
+                                            context);
+}
+
+void* CountingRealloc(const AllocatorDispatch* self,
+                      void* address,
+                      size_t size,
+                      void* context) {
+  g_allocation_count.fetch_add(1, std::memory_order_relaxed);
+  return self->next->realloc_function(self->next, address, size, context);
+}
+
+void CountingFree(const AllocatorDispatch* self,
+                  void* address,
+                  void* context) {
+  self->next->free_function(self->next, address, context);
+}
+
+size_t CountingGetSizeEstimate(const AllocatorDispatch* self,
+                               void* address,
+                               void* context) {
+  return self->next->get_size_estimate_function(self->next, address, context);
+}
+
+unsigned CountingBatchMalloc(const AllocatorDispatch* self,
+                             size_t size,
+                             void** results,
+                             unsigned num_requested,
+                             void* context) {
+  unsigned num_allocated = self->next->batch_malloc_function(
+      self->next, size, results, num_requested, context);
+  g_allocation_count.fetch_add(num_allocated, std::memory_order_relaxed);
+  return num_allocated;
+}
+
+void CountingBatchFree(const AllocatorDispatch* self,
+                       void** to_be_freed,
+                       unsigned num_to_be_freed,
+                       void* context) {
+  self->next->batch_free_function(self->next, to_be_freed, num_to_be_freed,
+                                  context);
+}
+
+void CountingFreeDefiniteSize(const AllocatorDispatch* self,
+                              void* address,
+                              size_t size,
+                              void* context) {
+  self->next->free_definite_size_function(self->next, address, size, context);
+}
+
+void* CountingAlignedMalloc(const AllocatorDispatch* self,
+                            size_t size,
+                            size_t alignment,
+                            void* context) {
+  g_allocation_count.fetch_add(1, std::memory_order_relaxed);
+  return self->next->aligned_malloc_function(self->next, size, alignment,
+                                             context);
+}
+
+void* CountingAlignedRealloc(const AllocatorDispatch* self,
+                             void* address,
+                             size_t size,
+                             size_t alignment,
+                             void* context) {
+  g_allocation_count.fetch_add(1, std::memory_order_relaxed);
+  return self->next->aligned_realloc_function(self->next, address, size,
+                                              alignment, context);
+}
+
+void CountingAlignedFree(const AllocatorDispatch* self,
+                         void* address,
+                         void* context) {
+  self->next->aligned_free_function(self->next, address, context);
+}
+
+AllocatorDispatch g_counting_dispatch = {&CountingAlloc,
+                                         &CountingAllocZeroInitialized,
+                                         &CountingAllocAligned,
+                                         &CountingRealloc,
+                                         &CountingFree,
+                                         &CountingGetSizeEstimate,
+                                         &CountingBatchMalloc,
+                                         &CountingBatchFree,
+                                         &CountingFreeDefiniteSize,
+                                         &CountingAlignedMalloc,
+                                         &CountingAlignedRealloc,
+                                         &CountingAlignedFree,
+                                         nullptr};
+
+// Returns the number of allocations so far. The shim can't be removed once
+// inserted, so it is inserted once and left counting.
+uint64_t GetAllocationCount() {
+  static bool inserted = false;
+  if (!inserted) {
+    base::allocator::InsertAllocatorDispatch(&g_counting_dispatch);
+    inserted = true;
+  }
+  return g_allocation_count.load(std::memory_order_relaxed);
+}
+
+#endif  // BUILDFLAG(USE_ALLOCATOR_SHIM)
+
+// Returns the |percentile| of |sorted_values| using the nearest-rank method.
+base::TimeDelta Percentile(const std::vector<base::TimeDelta>& sorted_values,
+                           double percentile) {
+  DCHECK(!sorted_values.empty());
+  size_t rank = static_cast<size_t>(
+      std::ceil(percentile / 100 * sorted_values.size()));
+  return sorted_values[std::max<size_t>(rank, 1) - 1];
+}
+
+// Replays one page load of a PageLoadGraph, recording the latency of each
+// request from start to completion.
+class PageLoadReplay {
+ public:
+  PageLoadReplay(URLRequestContext* context,
+                 const PageLoadGraph& graph,
+                 const GURL& origin,
+                 int load_flags,
+                 std::vector<base::TimeDelta>* latencies,
+                 base::OnceClosure on_done)
+      : context_(context),
+        graph_(graph),
+        origin_(origin),
+        load_flags_(load_flags),
+        latencies_(latencies),
+        on_done_(std::move(on_done)),
+        requests_(graph.requests.size()),
+        children_(graph.requests.size()) {
+    for (size_t i = 0; i < graph_.requests.size(); ++i) {
+      if (graph_.requests[i].parent >= 0)
+        children_[graph_.requests[i].parent].push_back(i);
+    }
+  }
+
+  void Start() {
+    for (size_t i = 0; i < graph_.requests.size(); ++i) {
+      if (graph_.requests[i].parent < 0)
+        StartRequest(i);
+    }
+  }
+
+ private:
+  struct InFlightRequest {
+    std::unique_ptr<TestDelegate> delegate;
+    std::unique_ptr<URLRequest> request;
+    base::TimeTicks start_time;
+  };
+
+  void StartRequest(size_t index) {
+    InFlightRequest& in_flight = requests_[index];
+    in_flight.delegate = std::make_unique<TestDelegate>();
+    in_flight.delegate->set_on_complete(
+        base::BindOnce(&PageLoadReplay::OnRequestComplete,
+                       base::Unretained(this), index));
+    in_flight.request = context_->CreateRequest(
+        origin_.Resolve(graph_.requests[index].path), DEFAULT_PRIORITY,
+        in_flight.delegate.get(), TRAFFIC_ANNOTATION_FOR_TESTS);
+    in_flight.request->SetLoadFlags(load_flags_);
+    in_flight.start_time = base::TimeTicks::Now();
+    ++pending_requests_;
+    in_flight.request->Start();
+  }
+
+  void OnRequestComplete(size_t index) {
+    const InFlightRequest& in_flight = requests_[index];
+    latencies_->push_back(base::TimeTicks::Now() - in_flight.start_time);
+    EXPECT_EQ(OK, in_flight.delegate->request_status());
+    EXPECT_EQ(graph_.requests[index].size,
+              in_flight.delegate->bytes_received());
+
+    // Children are started before this request stops counting as pending, so
+    // the page load is only done once the whole graph has been fetched.
+    for (size_t child : children_[index])
+      StartRequest(child);
+    if (--pending_requests_ == 0)
+      std::move(on_done_).Run();
+  }
+
+  URLRequestContext* const context_;
+  const PageLoadGraph& graph_;
+  const GURL origin_;
+  const int load_flags_;
+  std::vector<base::TimeDelta>* const latencies_;
+  base::OnceClosure on_done_;
+
+  std::vector<InFlightRequest> requests_;
+  std::vector<std::vector<size_t>> children_;
+  int pending_requests_ = 0;
+
+  DISALLOW_COPY_AND_ASSIGN(PageLoadReplay);
+};
+
+enum class Protocol {
+  kHttp1,
+  kQuic,
+};
+
+struct Scenario {
+  const char* name;
+  Protocol protocol;
+  // Whether responses may be served from the HttpCache. The cache is filled
+  // by the warm-up round.
+  bool use_http_cache;
+};
+
+class URLRequestScenarioPerfTest : public TestWithScopedTaskEnvironment {
+ protected:
+  URLRequestScenarioPerfTest()
+      : context_(std::make_unique<TestURLRequestContext>(true)) {
+    std::string json = kDefaultPageLoadGraph;
+    const base::CommandLine* command_line =
+        base::CommandLine::ForCurrentProcess();
+    if (command_line->HasSwitch(kPageLoadGraphSwitch)) {
+      base::FilePath path =
+          command_line->GetSwitchValuePath(kPageLoadGraphSwitch);
+      CHECK(base::ReadFileToString(path, &json)) << path.value();
+    }
+    CHECK(ParsePageLoadGraph(json, &graph_)) << "Invalid page load graph";
+    cert_verifier_.set_default_result(OK);
+  }
+
+  void TearDown() override {
+    if (quic_server_) {
+      quic_server_->Shutdown();
+      // If possible, deliver the connection close packet to the client before
+      // destroying the TestURLRequestContext.
+      base::RunLoop().RunUntilIdle();
+    }
+  }
+
+  void RunScenario(const Scenario& scenario) {
+    GURL origin;
+    auto params = std::make_unique<HttpNetworkSession::Params>();
+    auto resolver = std::make_unique<MockHostResolver>();
+    if (scenario.protocol == Protocol::kQuic) {
+      StartQuicServer();
+      resolver->rules()->AddRule(kQuicHost, "127.0.0.1");
+      params->enable_quic = true;
+      params->origins_to_force_quic_on.insert(HostPortPair(kQuicHost, 443));
+      origin = GURL(std::string("https://") + kQuicHost + "/");
+    } else {
+      StartHttpsServer();
+      origin = https_server_->GetURL("/");
+    }
+    host_resolver_ = std::make_unique<MappedHostResolver>(std::move(resolver));
+    if (quic_server_) {
+      ASSERT_TRUE(host_resolver_->AddRuleFromString(
+          std::string("MAP ") + kQuicHost + " " + kQuicHost + ":" +
+          base::NumberToString(quic_server_->server_address().port())));
+    }
+    context_->set_host_resolver(host_resolver_.get());
+    context_->set_cert_verifier(&cert_verifier_);
+    context_->set_http_network_session_params(std::move(params));
+    context_->Init();
+
+    const int load_flags =
+        scenario.use_http_cache ? LOAD_NORMAL : LOAD_DISABLE_CACHE;
+
+    // The warm-up round establishes connections and, if used, fills the cache.
+    std::vector<base::TimeDelta> latencies;
+    RunRound(origin, load_flags, &latencies);
+    latencies.clear();
+
+    std::unique_ptr<base::ProcessMetrics> process_metrics =
+        base::ProcessMetrics::CreateCurrentProcessMetrics();
+    const base::TimeDelta start_cpu = process_metrics->GetCumulativeCPUUsage();
+#if BUILDFLAG(USE_ALLOCATOR_SHIM)
+    const uint64_t start_allocations = GetAllocationCount();
+#endif
+    const base::TimeTicks start = base::TimeTicks::Now();
+
+    for (int i = 0; i < kRounds; ++i)
+      RunRound(origin, load_flags, &latencies);
+
+    const base::TimeDelta elapsed = base::TimeTicks::Now() - start;
+    const base::TimeDelta cpu =
+        process_metrics->GetCumulativeCPUUsage() - start_cpu;
+#if BUILDFLAG(USE_ALLOCATOR_SHIM)
+    const uint64_t allocations = GetAllocationCount() - start_allocations;
+#endif
+
+    const size_t num_requests = latencies.size();
+    ASSERT_EQ(graph_.requests.size() * kConcurrentPageLoads * kRounds,
+              num_requests);
+    std::sort(latencies.begin(), latencies.end());
+
+    base::Value results(base::Value::Type::DICTIONARY);
+    ReportResult(scenario, "requests_per_second",
+                 num_requests / elapsed.InSecondsF(), "requests/s", &results);
+    ReportResult(scenario, "latency_p50",
+                 Percentile(latencies, 50).InMillisecondsF(), "ms", &results);
+    ReportResult(scenario, "latency_p99",
+                 Percentile(latencies, 99).InMillisecondsF(), "ms", &results);
+    ReportResult(scenario, "cpu_per_request",
+                 cpu.InMicroseconds() / static_cast<double>(num_requests),
+                 "us", &results);
+#if BUILDFLAG(USE_ALLOCATOR_SHIM)
+    ReportResult(scenario, "allocations_per_request",
+                 allocations / static_cast<double>(num_requests), "count",
+                 &results);
+#endif
+    results.SetKey("page_load_graph", base::Value(graph_.name));
+    results.SetKey("requests", base::Value(static_cast<int>(num_requests)));
+    WriteResultsJson(scenario, std::move(results));
+  }
+
+ private:
+  // Runs |kConcurrentPageLoads| page loads at once and waits for all of them.
+  void RunRound(const GURL& origin,
+                int load_flags,
+                std::vector<base::TimeDelta>* latencies) {
+    base::RunLoop run_loop;
+    base::RepeatingClosure on_done =
+        base::BarrierClosure(kConcurrentPageLoads, run_loop.QuitClosure());
+    std::vector<std::unique_ptr<PageLoadReplay>> page_loads;
+    for (int i = 0; i < kConcurrentPageLoads; ++i) {
+      page_loads.push_back(std::make_unique<PageLoadReplay>(
+          context_.get(), graph_, origin, load_flags, latencies, on_done));
+      page_loads.back()->Start();
+    }
+    run_loop.Run();
+  }
+
+  void StartHttpsServer() {
+    std::map<std::string, int> sizes;
+    for (const GraphRequest& request : graph_.requests)
+      sizes[request.path] = request.size;
+    https_server_ =
+        std::make_unique<EmbeddedTestServer>(EmbeddedTestServer::TYPE_HTTPS);
+    https_server_->RegisterRequestHandler(
+        base::BindRepeating(&HandleGraphRequest, sizes));
+    ASSERT_TRUE(https_server_->Start()) << "HTTPS server fails to start";
+  }
+
+  void StartQuicServer() {
+    for (const GraphRequest& request : graph_.requests) {
+      memory_cache_backend_.AddSimpleResponse(
+          kQuicHost, request.path, HTTP_OK, std::string(request.size, 'x'));
+    }
+    quic_server_ = std::make_unique<QuicSimpleServer>(
+        quic::test::crypto_test_utils::ProofSourceForTesting(),
+        quic::QuicConfig(), quic::QuicCryptoServerConfig::ConfigOptions(),
+        quic::AllSupportedVersions(), &memory_cache_backend_);
+    int rv = quic_server_->Listen(IPEndPoint(IPAddress::IPv4AllZeros(), 0));
+    ASSERT_GE(rv, 0) << "QUIC server fails to start";
+  }
+
+  void ReportResult(const Scenario& scenario,
+                    const std::string& metric,
+                    double value,
+                    const std::string& units,
+                    base::Value* results) {
+    perf_test::PrintResult("URLRequestScenario", "." + graph_.name,
+                           std::string(scenario.name) + "_" + metric, value,
+                           units, true);
+    base::Value result(base::Value::Type::DICTIONARY);
+    result.SetKey("value", base::Value(value));
+    result.SetKey("units", base::Value(units));
+    results->SetKey(metric, std::move(result));
+  }
+
+  // Merges |results| into the --perf-results-json file under the scenario's
+  // name. Keys are sorted, so the output is stable across runs.
+  void WriteResultsJson(const Scenario& scenario, base::Value results) {
+    const base::CommandLine* command_line =
+        base::CommandLine::ForCurrentProcess();
+    if (!command_line->HasSwitch(kResultsJsonSwitch))
+      return;
+    base::FilePath path = command_line->GetSwitchValuePath(kResultsJsonSwitch);
+
+    base::Value all_results(base::Value::Type::DICTIONARY);
+    std::string json;
+    if (base::ReadFileToString(path, &json)) {
+      base::Optional<base::Value> existing = base::JSONReader::Read(json);
+      if (existing && existing->is_dict())
+        all_results = std::move(*existing);
+    }
+    all_results.SetKey(scenario.name, std::move(results));
+
+    ASSERT_TRUE(base::JSONWriter::WriteWithOptions(
+        all_results, base::JSONWriter::OPTIONS_PRETTY_PRINT, &json));
+    ASSERT_EQ(static_cast<int>(json.size()),
+              base::WriteFile(path, json.data(), json.size()));
+  }
+
+  PageLoadGraph graph_;
+  MockCertVerifier cert_verifier_;
+  std::unique_ptr<MappedHostResolver> host_resolver_;
+  std::unique_ptr<EmbeddedTestServer> https_server_;
+  quic::QuicMemoryCacheBackend memory_cache_backend_;
+  std::unique_ptr<QuicSimpleServer> quic_server_;
+  std::unique_ptr<TestURLRequestContext> context_;
+
+  DISALLOW_COPY_AND_ASSIGN(URLRequestScenarioPerfTest);
+};
+
+}  // namespace
+
+TEST_F(URLRequestScenarioPerfTest, Http1) {
+  RunScenario({"h1_tls", Protocol::kHttp1, /*use_http_cache=*/false});
+}
+
+TEST_F(URLRequestScenarioPerfTest, Http1WithHttpCache) {
+  RunScenario({"h1_tls_http_cache", Protocol::kHttp1, /*use_http_cache=*/true});
+}
+
+TEST_F(URLRequestScenarioPerfTest, Quic) {
+  RunScenario({"quic", Protocol::kQuic, /*use_http_cache=*/false});
+}
+
+}  // namespace net
@@ -54,8 +54,13 @@ WebSocketDeflateStream::WebSocketDeflateStream(
     DCHECK(params.has_client_max_window_bits_value());
     client_max_window_bits = params.client_max_window_bits();
   }
+  // The server won't use a larger window than it agreed to, so don't allocate
+  // one.
+  int server_max_window_bits = kWindowBits;
+  if (params.is_server_max_window_bits_specified())
+    server_max_window_bits = params.server_max_window_bits();
   deflater_.Initialize(client_max_window_bits);
-  inflater_.Initialize(kWindowBits);
+  inflater_.Initialize(server_max_window_bits);
 }
 
 WebSocketDeflateStream::~WebSocketDeflateStream() = default;
@@ -6,17 +6,69 @@
 
 #include <string.h>
 #include <algorithm>
+#include <utility>
 #include <vector>
 
 #include "base/containers/circular_deque.h"
 #include "base/logging.h"
+#include "base/no_destructor.h"
+#include "base/synchronization/lock.h"
 #include "net/base/io_buffer.h"
 #include "third_party/zlib/zlib.h"
 
 namespace net {
 
+namespace {
+
+// The zlib streams of DO_NOT_TAKE_OVER_CONTEXT deflaters are only needed while
+// a message is being compressed. Between messages they are kept here, where
+// any deflater with the same window size can reuse them, so that idle
+// connections don't each hold on to one.
+class DeflateStreamPool {
+ public:
+  static DeflateStreamPool* GetInstance() {
+    static base::NoDestructor<DeflateStreamPool> instance;
+    return instance.get();
+  }
+
+  // Returns a reset stream initialized with |window_bits|, or null if there is
+  // none.
+  std::unique_ptr<z_stream> Take(int window_bits) {
+    base::AutoLock lock(lock_);
+    for (auto it = streams_.begin(); it != streams_.end(); ++it) {
+      if (it->first == window_bits) {
+        std::unique_ptr<z_stream> stream = std::move(it->second);
+        streams_.erase(it);
+        return stream;
+      }
+    }
+    return nullptr;
+  }
+
+  // Keeps |stream|, which must have been reset, for reuse, or frees it if the
+  // pool is full.
+  void Return(int window_bits, std::unique_ptr<z_stream> stream) {
+    {
+      base::AutoLock lock(lock_);
+      if (streams_.size() < kMaxPooledStreams) {
+        streams_.emplace_back(window_bits, std::move(stream));
+        return;
+      }
+    }
+    deflateEnd(stream.get());
+  }
+
+ private:
+  static constexpr size_t kMaxPooledStreams = 4;
+
+  base::Lock lock_;
+  std::vector<std::pair<int, std::unique_ptr<z_stream>>> streams_;
+};
+
+}  // namespace
+
 WebSocketDeflater::WebSocketDeflater(ContextTakeOverMode mode)
-    : mode_(mode), are_bytes_added_(false) {}
+    : mode_(mode), window_bits_(0), are_bytes_added_(false) {}
 
 WebSocketDeflater::~WebSocketDeflater() {
   if (stream_) {
@@ -26,9 +78,7 @@ WebSocketDeflater::~WebSocketDeflater() {
 }
 
 bool WebSocketDeflater::Initialize(int window_bits) {
-  DCHECK(!stream_);
-  stream_ = std::make_unique<z_stream>();
-
+  DCHECK(!window_bits_);
   DCHECK_LE(8, window_bits);
   DCHECK_GE(15, window_bits);
 
@@ -51,22 +101,14 @@ bool WebSocketDeflater::Initialize(int window_bits) {
   // specific to any particular inflate implementation.
   //
   // See https://crbug.com/691074
-  window_bits = -std::max(window_bits, 9);
+  window_bits_ = -std::max(window_bits, 9);
 
-  memset(stream_.get(), 0, sizeof(*stream_));
-  int result = deflateInit2(stream_.get(),
-                            Z_DEFAULT_COMPRESSION,
-                            Z_DEFLATED,
-                            window_bits,
-                            8,  // default mem level
-                            Z_DEFAULT_STRATEGY);
-  if (result != Z_OK) {
-    deflateEnd(stream_.get());
-    stream_.reset();
+  if (!AcquireStream())
     return false;
-  }
   const size_t kFixedBufferSize = 4096;
   fixed_buffer_.resize(kFixedBufferSize);
+  if (mode_ == DO_NOT_TAKE_OVER_CONTEXT)
+    ReleaseStream();
   return true;
 }
 
@@ -74,6 +116,8 @@ bool WebSocketDeflater::AddBytes(const char* data, size_t size) {
   if (!size)
     return true;
 
+  if (!stream_ && !AcquireStream())
+    return false;
   are_bytes_added_ = true;
   stream_->next_in = reinterpret_cast<Bytef*>(const_cast<char*>(data));
   stream_->avail_in = size;
@@ -130,11 +174,46 @@ scoped_refptr<IOBufferWithSize> WebSocketDeflater::GetOutput(size_t size) {
 }
 
 void WebSocketDeflater::ResetContext() {
-  if (mode_ == DO_NOT_TAKE_OVER_CONTEXT)
-    deflateReset(stream_.get());
+  if (mode_ == DO_NOT_TAKE_OVER_CONTEXT && stream_)
+    ReleaseStream();
   are_bytes_added_ = false;
 }
 
+bool WebSocketDeflater::AcquireStream() {
+  DCHECK(!stream_);
+  if (mode_ == DO_NOT_TAKE_OVER_CONTEXT) {
+    stream_ = DeflateStreamPool::GetInstance()->Take(window_bits_);
+    if (stream_)
+      return true;
+  }
+
+  // zlib sizes its hash table and symbol buffer from the memory level
+  // independently of the window. Scale it down with small negotiated windows,
+  // where the default level's 128KB of tables can't be put to use.
+  int mem_level = std::min(8, -window_bits_ - 6);
+
+  stream_ = std::make_unique<z_stream>();
+  memset(stream_.get(), 0, sizeof(*stream_));
+  int result = deflateInit2(stream_.get(),
+                            Z_DEFAULT_COMPRESSION,
+                            Z_DEFLATED,
+                            window_bits_,
+                            mem_level,
+                            Z_DEFAULT_STRATEGY);
+  if (result != Z_OK) {
+    deflateEnd(stream_.get());
+    stream_.reset();
+    return false;
+  }
+  return true;
+}
+
+void WebSocketDeflater::ReleaseStream() {
+  DCHECK_EQ(DO_NOT_TAKE_OVER_CONTEXT, mode_);
+  deflateReset(stream_.get());
+  DeflateStreamPool::GetInstance()->Return(window_bits_, std::move(stream_));
+}
+
 int WebSocketDeflater::Deflate(int flush) {
   int result = Z_OK;
   do {
@@ -40,7 +40,7 @@ class NET_EXPORT_PRIVATE WebSocketDeflater {
   // |window_bits| must be between 8 and 15 (both inclusive).
   bool Initialize(int window_bits);
 
-  // Adds bytes to |stream_|.
+  // Adds bytes to the stream.
   // Returns true if there is no error and false otherwise.
   bool AddBytes(const char* data, size_t size);
 
@@ -65,8 +65,17 @@ class NET_EXPORT_PRIVATE WebSocketDeflater {
   void ResetContext();
   int Deflate(int flush);
 
+  // Sets |stream_|, reusing a pooled stream if the context is not taken over.
+  // Returns false if zlib fails to initialize a new stream.
+  bool AcquireStream();
+  // Resets |stream_| and returns it to the pool. Only used when the context is
+  // not taken over, where the stream is only held while a message is added.
+  void ReleaseStream();
+
   std::unique_ptr<z_stream_s> stream_;
   ContextTakeOverMode mode_;
+  // The window bits passed to zlib, i.e. negated for a raw deflate stream.
+  int window_bits_;
   base::circular_deque<char> buffer_;
   std::vector<char> fixed_buffer_;
   // true if bytes were added after last Finish().
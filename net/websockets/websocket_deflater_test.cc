@@ -132,6 +132,34 @@ TEST(WebSocketDeflaterTest, WindowBits10) {
       ToString(actual.get()));
 }
 
+TEST(WebSocketDeflaterTest, DoNotTakeOverContextStreamsAreShared) {
+  // Streams released by deflaters that don't take over the context are reused
+  // by others, which must neither see the previous context nor a stream with a
+  // different window size.
+  const std::string word = "Chromium";
+  std::string input = word + std::string(256, 'a') + word;
+  for (int i = 0; i < 3; ++i) {
+    WebSocketDeflater deflater15(WebSocketDeflater::DO_NOT_TAKE_OVER_CONTEXT);
+    WebSocketDeflater deflater10(WebSocketDeflater::DO_NOT_TAKE_OVER_CONTEXT);
+    ASSERT_TRUE(deflater15.Initialize(15));
+    ASSERT_TRUE(deflater10.Initialize(10));
+
+    ASSERT_TRUE(deflater15.AddBytes("Hello", 5));
+    ASSERT_TRUE(deflater15.Finish());
+    scoped_refptr<IOBufferWithSize> actual =
+        deflater15.GetOutput(deflater15.CurrentOutputSize());
+    EXPECT_EQ(std::string("\xf2\x48\xcd\xc9\xc9\x07\x00", 7),
+              ToString(actual.get()));
+
+    ASSERT_TRUE(deflater10.AddBytes(input.data(), input.size()));
+    ASSERT_TRUE(deflater10.Finish());
+    actual = deflater10.GetOutput(deflater10.CurrentOutputSize());
+    EXPECT_EQ(std::string(
+                  "r\xce(\xca\xcf\xcd,\xcdM\x1c\xe1\xc0\x19\x1a\x0e\0\0", 17),
+              ToString(actual.get()));
+  }
+}
+
 }  // namespace
 
 }  // namespace net
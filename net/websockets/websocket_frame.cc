@@ -5,6 +5,8 @@
 #include "net/websockets/websocket_frame.h"
 
 #include <stddef.h>
+#include <string.h>
+
 #include <algorithm>
 
 #include "base/big_endian.h"
@@ -55,6 +57,37 @@ inline void MaskWebSocketFramePayloadByBytes(
   }
 }
 
+// Masks a 32-bit word at a time, regardless of alignment. This is used for
+// payloads too small for the aligned vector loop, which are common when many
+// small messages are sent, and avoids masking them a byte at a time.
+inline void MaskWebSocketFramePayloadByWords(
+    const WebSocketMaskingKey& masking_key,
+    size_t masking_key_offset,
+    char* const begin,
+    char* const end) {
+  static_assert(sizeof(uint32_t) == WebSocketFrameHeader::kMaskingKeyLength,
+                "masking key must be one word");
+  // XORing 0 with the mask gives the mask rotated by |masking_key_offset|.
+  char realigned_mask[sizeof(uint32_t)] = {};
+  MaskWebSocketFramePayloadByBytes(masking_key, masking_key_offset,
+                                   realigned_mask,
+                                   realigned_mask + sizeof(uint32_t));
+  uint32_t packed_mask_key;
+  memcpy(&packed_mask_key, realigned_mask, sizeof(packed_mask_key));
+
+  char* masked = begin;
+  for (; end - masked >= static_cast<ptrdiff_t>(sizeof(uint32_t));
+       masked += sizeof(uint32_t)) {
+    uint32_t word;
+    memcpy(&word, masked, sizeof(word));
+    word ^= packed_mask_key;
+    memcpy(masked, &word, sizeof(word));
+  }
+  // Whole words were masked, so the key offset is unchanged for the tail.
+  MaskWebSocketFramePayloadByBytes(masking_key, masking_key_offset, masked,
+                                   end);
+}
+
 }  // namespace
 
 std::unique_ptr<WebSocketFrameHeader> WebSocketFrameHeader::Clone() const {
@@ -197,9 +230,9 @@ void MaskWebSocketFramePayload(const WebSocketMaskingKey& masking_key,
                 "PackedMaskType size is not a multiple of mask length");
   char* const end = data + data_size;
   // If the buffer is too small for the vectorised version to be useful, revert
-  // to the byte-at-a-time implementation early.
+  // to the word-at-a-time implementation early.
   if (data_size <= static_cast<int>(kPackedMaskKeySize * 2)) {
-    MaskWebSocketFramePayloadByBytes(
+    MaskWebSocketFramePayloadByWords(
         masking_key, frame_offset % kMaskingKeyLength, data, end);
     return;
   }
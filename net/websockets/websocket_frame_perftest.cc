@@ -55,12 +55,19 @@ TEST_F(WebSocketFrameTestMaskBenchmark, BenchmarkMaskLongPayload) {
 
 // A 31-byte payload is guaranteed to do 7 byte mask operations and 3 vector
 // mask operations with an 8-byte vector. With a 16-byte vector it will fall
-// back to the byte-only code path and do 31 byte mask operations.
+// back to the word-at-a-time code path and do 7 word and 3 byte mask
+// operations.
 TEST_F(WebSocketFrameTestMaskBenchmark, Benchmark31BytePayload) {
   std::vector<char> payload(31, 'a');
   Benchmark("Frame_mask_31_payload", &payload.front(), payload.size());
 }
 
+// Typical of the many small messages sent by e.g. live dashboards.
+TEST_F(WebSocketFrameTestMaskBenchmark, Benchmark24BytePayload) {
+  std::vector<char> payload(24, 'a');
+  Benchmark("Frame_mask_24_payload", &payload.front(), payload.size());
+}
+
 }  // namespace
 
 }  // namespace net
@@ -55,12 +55,17 @@ class DocumentLoader {
   // Data request interface.
   virtual void RequestData(uint32_t position, uint32_t size) {}
 
+  // Like RequestData(), but for data that is likely to be needed soon, e.g.
+  // pages next to the visible ones. It is only loaded once there are no
+  // outstanding RequestData() requests.
+  virtual void PrefetchData(uint32_t position, uint32_t size) {}
+
   virtual bool IsDocumentComplete() const = 0;
   virtual void SetDocumentSize(uint32_t size) {}
   virtual uint32_t GetDocumentSize() const = 0;
   virtual uint32_t BytesReceived() const = 0;
 
-  // Clear pending requests from the queue.
+  // Clear pending and prefetch requests from the queue.
   virtual void ClearPendingRequests() {}
 };
 
@@ -136,6 +136,7 @@ uint32_t DocumentLoaderImpl::BytesReceived() const {
 
 void DocumentLoaderImpl::ClearPendingRequests() {
   pending_requests_.Clear();
+  prefetch_requests_.Clear();
 }
 
 bool DocumentLoaderImpl::GetBlock(uint32_t position,
@@ -160,8 +161,23 @@ bool DocumentLoaderImpl::IsDataAvailable(uint32_t position,
 }
 
 void DocumentLoaderImpl::RequestData(uint32_t position, uint32_t size) {
-  if (size == 0 || IsDataAvailable(position, size))
+  RangeSet requested_chunks = GetChunksToRequest(position, size);
+  if (requested_chunks.IsEmpty())
     return;
+  prefetch_requests_.Subtract(requested_chunks);
+  pending_requests_.Union(requested_chunks);
+}
+
+void DocumentLoaderImpl::PrefetchData(uint32_t position, uint32_t size) {
+  RangeSet requested_chunks = GetChunksToRequest(position, size);
+  requested_chunks.Subtract(pending_requests_);
+  prefetch_requests_.Union(requested_chunks);
+}
+
+RangeSet DocumentLoaderImpl::GetChunksToRequest(uint32_t position,
+                                                uint32_t size) const {
+  if (size == 0 || IsDataAvailable(position, size))
+    return RangeSet();
 
   const uint32_t document_size = GetDocumentSize();
   if (document_size != 0) {
@@ -169,10 +185,10 @@ void DocumentLoaderImpl::RequestData(uint32_t position, uint32_t size) {
     base::CheckedNumeric<uint32_t> addition_result = position;
     addition_result += size;
     if (!addition_result.IsValid())
-      return;
+      return RangeSet();
 
     if (addition_result.ValueOrDie() > document_size)
-      return;
+      return RangeSet();
   }
 
   // We have some artifact request from
@@ -183,15 +199,16 @@ void DocumentLoaderImpl::RequestData(uint32_t position, uint32_t size) {
   // Test url:
   // http://www.icann.org/en/correspondence/holtzman-to-jeffrey-02mar11-en.pdf
   if (!loader_)
-    return;
+    return RangeSet();
 
   RangeSet requested_chunks(chunk_stream_.GetChunksRange(position, size));
   requested_chunks.Subtract(chunk_stream_.filled_chunks());
-  if (requested_chunks.IsEmpty()) {
-    NOTREACHED();
-    return;
-  }
-  pending_requests_.Union(requested_chunks);
+  DCHECK(!requested_chunks.IsEmpty());
+  return requested_chunks;
+}
+
+const RangeSet& DocumentLoaderImpl::NextRequests() const {
+  return pending_requests_.IsEmpty() ? prefetch_requests_ : pending_requests_;
 }
 
 void DocumentLoaderImpl::SetPartialLoadingEnabled(bool enabled) {
@@ -208,7 +225,8 @@ bool DocumentLoaderImpl::ShouldCancelLoading() const {
   if (!partial_loading_enabled_)
     return false;
 
-  if (pending_requests_.IsEmpty()) {
+  const RangeSet& next_requests = NextRequests();
+  if (next_requests.IsEmpty()) {
     // Cancel loading if this is unepected data from server.
     return !chunk_stream_.IsValidChunkIndex(chunk_.chunk_index) ||
            chunk_stream_.IsChunkAvailable(chunk_.chunk_index);
@@ -216,7 +234,7 @@ bool DocumentLoaderImpl::ShouldCancelLoading() const {
 
   const gfx::Range current_range(chunk_.chunk_index,
                                  chunk_.chunk_index + kChunkCloseDistance);
-  return !pending_requests_.Intersects(current_range);
+  return !next_requests.Intersects(current_range);
 }
 
 void DocumentLoaderImpl::ContinueDownload() {
@@ -227,8 +245,9 @@ void DocumentLoaderImpl::ContinueDownload() {
   DCHECK(!IsDocumentComplete());
   DCHECK_GT(GetDocumentSize(), 0U);
 
+  const RangeSet& next_requests = NextRequests();
   const uint32_t range_start =
-      pending_requests_.IsEmpty() ? 0 : pending_requests_.First().start();
+      next_requests.IsEmpty() ? 0 : next_requests.First().start();
   RangeSet candidates_for_request(
       gfx::Range(range_start, chunk_stream_.total_chunks_count()));
   candidates_for_request.Subtract(chunk_stream_.filled_chunks());
@@ -350,8 +369,9 @@ bool DocumentLoaderImpl::SaveBuffer(char* input, uint32_t input_size) {
     chunk_.data_size += new_chunk_data_len;
     if (chunk_.data_size == DataStream::kChunkSize ||
         (document_size > 0 && document_size <= EndOfCurrentChunk())) {
-      pending_requests_.Subtract(
-          gfx::Range(chunk_.chunk_index, chunk_.chunk_index + 1));
+      const gfx::Range saved_chunk(chunk_.chunk_index, chunk_.chunk_index + 1);
+      pending_requests_.Subtract(saved_chunk);
+      prefetch_requests_.Subtract(saved_chunk);
       SaveChunkData();
       chunk_saved = true;
     }
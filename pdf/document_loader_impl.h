@@ -29,6 +29,7 @@ class DocumentLoaderImpl : public DocumentLoader {
   bool GetBlock(uint32_t position, uint32_t size, void* buf) const override;
   bool IsDataAvailable(uint32_t position, uint32_t size) const override;
   void RequestData(uint32_t position, uint32_t size) override;
+  void PrefetchData(uint32_t position, uint32_t size) override;
   bool IsDocumentComplete() const override;
   void SetDocumentSize(uint32_t size) override;
   uint32_t GetDocumentSize() const override;
@@ -61,6 +62,14 @@ class DocumentLoaderImpl : public DocumentLoader {
   // Called by the completion callback of the document's URLLoader.
   void DidRead(int32_t result);
 
+  // Returns the chunks of [position, position + size) that still need to be
+  // requested, or an empty set if the range is invalid.
+  RangeSet GetChunksToRequest(uint32_t position, uint32_t size) const;
+
+  // Returns the requests to serve next: the pending requests, or the prefetch
+  // requests if there are none.
+  const RangeSet& NextRequests() const;
+
   bool ShouldCancelLoading() const;
   void ContinueDownload();
 
@@ -91,6 +100,9 @@ class DocumentLoaderImpl : public DocumentLoader {
   // In units of Chunks.
   RangeSet pending_requests_;
 
+  // In units of Chunks. Only served when |pending_requests_| is empty.
+  RangeSet prefetch_requests_;
+
   uint32_t bytes_received_ = 0;
 
   DISALLOW_COPY_AND_ASSIGN(DocumentLoaderImpl);
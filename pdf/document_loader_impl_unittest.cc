@@ -812,6 +812,53 @@ TEST_F(DocumentLoaderImplTest, MergePendingRequests) {
   EXPECT_TRUE(client.partial_loader_data()->closed());
 }
 
+TEST_F(DocumentLoaderImplTest, PrefetchAfterPendingRequests) {
+  TestClient client;
+  client.SetCanUsePartialLoading();
+  client.full_page_loader_data()->set_content_length(kDefaultRequestSize * 100 +
+                                                     58383);
+  DocumentLoaderImpl loader(&client);
+  loader.Init(client.CreateFullPageLoader(), "http://url.com");
+  loader.PrefetchData(10 * kDefaultRequestSize + 100, 10);
+  loader.RequestData(60 * kDefaultRequestSize + 100, 10);
+
+  // Send initial data from FullPageLoader.
+  client.full_page_loader_data()->CallReadCallback(kDefaultRequestSize);
+
+  // The pending request is loaded first, even though the prefetch request is
+  // closer.
+  EXPECT_TRUE(client.partial_loader_data()->IsWaitOpen());
+  EXPECT_EQ(60 * kDefaultRequestSize,
+            client.partial_loader_data()->open_byte_range().start());
+  client.partial_loader_data()->set_byte_range(
+      client.partial_loader_data()->open_byte_range());
+  client.partial_loader_data()->CallOpenCallback(0);
+  client.partial_loader_data()->CallReadCallback(kDefaultRequestSize);
+
+  // Once there are no pending requests left, loading restarts at the prefetch
+  // request.
+  EXPECT_TRUE(client.partial_loader_data()->IsWaitOpen());
+  EXPECT_EQ(10 * kDefaultRequestSize,
+            client.partial_loader_data()->open_byte_range().start());
+}
+
+TEST_F(DocumentLoaderImplTest, ClearPrefetchRequests) {
+  TestClient client;
+  client.SetCanUsePartialLoading();
+  client.full_page_loader_data()->set_content_length(kDefaultRequestSize * 100 +
+                                                     58383);
+  DocumentLoaderImpl loader(&client);
+  loader.Init(client.CreateFullPageLoader(), "http://url.com");
+  loader.PrefetchData(60 * kDefaultRequestSize + 100, 10);
+  loader.ClearPendingRequests();
+
+  // Send initial data from FullPageLoader.
+  client.full_page_loader_data()->CallReadCallback(kDefaultRequestSize);
+
+  // Nothing is requested, so the full page loader keeps loading.
+  EXPECT_FALSE(client.partial_loader_data()->IsWaitOpen());
+}
+
 TEST_F(DocumentLoaderImplTest, PartialStopOnStatusCodeError) {
   TestClient client;
   client.SetCanUsePartialLoading();
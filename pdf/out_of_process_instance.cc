@@ -440,6 +440,8 @@ OutOfProcessInstance::OutOfProcessInstance(PP_Instance instance)
       accessibility_state_(ACCESSIBILITY_STATE_OFF),
       is_print_preview_(false) {
   callback_factory_.Initialize(this);
+  paint_manager_.set_flush_ready_rects_early(
+      base::FeatureList::IsEnabled(features::kPdfIncrementalPaint));
   pp::Module::Get()->AddPluginInterface(kPPPPdfInterface, &ppp_private);
   AddPerInstanceObject(kPPPPdfInterface, this);
 
@@ -1206,6 +1208,19 @@ void OutOfProcessInstance::OnPaint(const std::vector<pp::Rect>& paint_rects,
   }
 
   engine_->PostPaint();
+
+  // Measure how long pages take to finish rendering progressively, from the
+  // first paint that leaves some of them pending.
+  if (!pending->empty()) {
+    if (progressive_paint_start_time_.is_null())
+      progressive_paint_start_time_ = base::TimeTicks::Now();
+  } else if (!progressive_paint_start_time_.is_null()) {
+    base::TimeDelta paint_time =
+        base::TimeTicks::Now() - progressive_paint_start_time_;
+    progressive_paint_start_time_ = base::TimeTicks();
+    HistogramCustomCounts("PDF.ProgressivePaintTime",
+                          paint_time.InMilliseconds(), 1, 60000, 50);
+  }
 }
 
 void OutOfProcessInstance::DidOpen(int32_t result) {
@@ -16,6 +16,7 @@
 
 #include "base/containers/queue.h"
 #include "base/macros.h"
+#include "base/time/time.h"
 #include "pdf/paint_manager.h"
 #include "pdf/pdf_engine.h"
 #include "pdf/preview_mode_client.h"
@@ -350,6 +351,10 @@ class OutOfProcessInstance : public pp::Instance,
   // True if we haven't painted the plugin viewport yet.
   bool first_paint_;
 
+  // When the current progressive paint started, or null if no page is being
+  // rendered progressively.
+  base::TimeTicks progressive_paint_start_time_;
+
   DocumentLoadState document_load_state_;
   DocumentLoadState preview_document_load_state_;
 
@@ -39,7 +39,8 @@ PaintManager::PaintManager(pp::Instance* instance,
       device_scale_(1.0),
       in_paint_(false),
       first_paint_(true),
-      view_size_changed_waiting_for_paint_(false) {
+      view_size_changed_waiting_for_paint_(false),
+      flush_ready_rects_early_(false) {
   // Set the callback object outside of the initializer list to avoid a
   // compiler warning about using "this" in an initializer list.
   callback_factory_.Initialize(this);
@@ -253,6 +254,9 @@ void PaintManager::DoPaint() {
 
     view_size_changed_waiting_for_paint_ = false;
   } else {
+    // Ready rects are painted in post-scroll coordinates, so they can only be
+    // flushed early if there is no scroll waiting for the pending rects.
+    bool flush_ready_rects_now = flush_ready_rects_early_ && !update.has_scroll;
     std::vector<PaintAggregator::ReadyRect> ready_later;
     for (const auto& ready_rect : ready_rects) {
       // Don't flush any part (i.e. scrollbars) if we're resizing the browser,
@@ -260,7 +264,7 @@ void PaintManager::DoPaint() {
       // previous image, but if we flush, it'll revert to using the blank image.
       // We make an exception for the first paint since we want to show the
       // default background color instead of the pepper default of black.
-      if (ready_rect.flush_now &&
+      if ((ready_rect.flush_now || flush_ready_rects_now) &&
           (!view_size_changed_waiting_for_paint_ || first_paint_)) {
         ready_now.push_back(ready_rect);
       } else {
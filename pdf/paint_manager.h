@@ -159,6 +159,13 @@ class PaintManager {
   // This does not schedule a flush.
   void ClearTransform();
 
+  // When true, ready rects are flushed as soon as they are painted, even while
+  // other rects are still pending, unless a scroll is pending. This shows
+  // finished pages sooner, at the cost of briefly mixing old and new content.
+  void set_flush_ready_rects_early(bool flush_ready_rects_early) {
+    flush_ready_rects_early_ = flush_ready_rects_early;
+  }
+
  private:
   // Disallow copy and assign (these are unimplemented).
   PaintManager(const PaintManager&);
@@ -221,6 +228,9 @@ class PaintManager {
 
   // True when the view size just changed and we're waiting for a paint.
   bool view_size_changed_waiting_for_paint_;
+
+  // See set_flush_ready_rects_early().
+  bool flush_ready_rects_early_;
 };
 
 #endif  // PDF_PAINT_MANAGER_H_
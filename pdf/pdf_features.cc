@@ -25,5 +25,8 @@ const base::Feature kPDFAnnotations {
 #endif  // defined(OS_CHROMEOS)
 };
 
+const base::Feature kPdfIncrementalPaint{"PdfIncrementalPaint",
+                                         base::FEATURE_DISABLED_BY_DEFAULT};
+
 }  // namespace features
 }  // namespace chrome_pdf
@@ -53,6 +53,27 @@ class DownloadHints : public FX_DOWNLOADHINTS {
   DocumentLoader* doc_loader_;
 };
 
+class PrefetchHints : public FX_DOWNLOADHINTS {
+ public:
+  explicit PrefetchHints(DocumentLoader* doc_loader) : doc_loader_(doc_loader) {
+    DCHECK(doc_loader);
+    version = 1;
+    AddSegment = &PrefetchHints::AddSegmentImpl;
+  }
+
+ private:
+  // PDFium interface to request download of the block of data, which is not
+  // needed yet.
+  static void AddSegmentImpl(FX_DOWNLOADHINTS* param,
+                             size_t offset,
+                             size_t size) {
+    auto* prefetch_hints = static_cast<PrefetchHints*>(param);
+    return prefetch_hints->doc_loader_->PrefetchData(offset, size);
+  }
+
+  DocumentLoader* doc_loader_;
+};
+
 class FileAccess : public FPDF_FILEACCESS {
  public:
   explicit FileAccess(DocumentLoader* doc_loader) : doc_loader_(doc_loader) {
@@ -81,7 +102,8 @@ PDFiumDocument::PDFiumDocument(DocumentLoader* doc_loader)
     : doc_loader_(doc_loader),
       file_access_(std::make_unique<FileAccess>(doc_loader)),
       file_availability_(std::make_unique<FileAvail>(doc_loader)),
-      download_hints_(std::make_unique<DownloadHints>(doc_loader)) {}
+      download_hints_(std::make_unique<DownloadHints>(doc_loader)),
+      prefetch_hints_(std::make_unique<PrefetchHints>(doc_loader)) {}
 
 PDFiumDocument::~PDFiumDocument() = default;
 
@@ -25,6 +25,7 @@ class PDFiumDocument {
   FPDF_FILEACCESS& file_access() { return *file_access_; }
   FX_FILEAVAIL& file_availability() { return *file_availability_; }
   FX_DOWNLOADHINTS& download_hints() { return *download_hints_; }
+  FX_DOWNLOADHINTS& prefetch_hints() { return *prefetch_hints_; }
 
   FPDF_AVAIL fpdf_availability() const { return fpdf_availability_.get(); }
   FPDF_DOCUMENT doc() const { return doc_handle_.get(); }
@@ -52,6 +53,9 @@ class PDFiumDocument {
   // Interface structure to request data chunks from the document stream.
   std::unique_ptr<FX_DOWNLOADHINTS> download_hints_;
 
+  // Interface structure to prefetch data chunks from the document stream.
+  std::unique_ptr<FX_DOWNLOADHINTS> prefetch_hints_;
+
   // Pointer to the document availability interface.
   ScopedFPDFAvail fpdf_availability_;
 
@@ -113,6 +113,11 @@ constexpr uint32_t kPDFPermissionCopyAccessibleMask = 1 << 9;
 
 constexpr int32_t kLoadingTextVerticalOffset = 50;
 
+// The number of pages before and after the visible ones to prefetch while a
+// linearized document is loading, since those are likely to be shown next.
+constexpr int kPrefetchPagesBefore = 1;
+constexpr int kPrefetchPagesAfter = 2;
+
 // The maximum amount of time we'll spend doing a paint before we give back
 // control of the thread.
 constexpr base::TimeDelta kMaxProgressivePaintTime =
@@ -2887,6 +2892,8 @@ void PDFiumEngine::CalculateVisiblePages() {
     }
   }
 
+  PrefetchPagesNearVisiblePages();
+
   // Any pending highlighting of form fields will be invalid since these are in
   // screen coordinates.
   form_highlights_.clear();
@@ -2906,6 +2913,27 @@ void PDFiumEngine::CalculateVisiblePages() {
   SetCurrentPage(most_visible_page);
 }
 
+void PDFiumEngine::PrefetchPagesNearVisiblePages() {
+  if (visible_pages_.empty() || !doc() || doc_loader_->IsDocumentComplete() ||
+      FPDFAvail_IsLinearized(fpdf_availability()) != PDF_LINEARIZED) {
+    return;
+  }
+
+  // PDFium uses the linearization hint tables to find the byte ranges of each
+  // page and reports them through the prefetch hints, so that the loader
+  // fetches them once the visible pages' data has arrived.
+  const int num_pages = static_cast<int>(pages_.size());
+  const int first_page =
+      std::max(0, visible_pages_.front() - kPrefetchPagesBefore);
+  const int last_page =
+      std::min(num_pages - 1, visible_pages_.back() + kPrefetchPagesAfter);
+  for (int i = first_page; i <= last_page; ++i) {
+    if (IsPageVisible(i) || pages_[i]->available())
+      continue;
+    FPDFAvail_IsPageAvail(fpdf_availability(), i, &document_->prefetch_hints());
+  }
+}
+
 bool PDFiumEngine::IsPageVisible(int index) const {
   return base::ContainsValue(visible_pages_, index);
 }
@@ -241,6 +241,10 @@ class PDFiumEngine : public PDFEngine,
   // Calculates which pages should be displayed right now.
   void CalculateVisiblePages();
 
+  // Asks the document loader to fetch the pages around the visible ones while a
+  // linearized document is loading.
+  void PrefetchPagesNearVisiblePages();
+
   // Returns true iff the given page index is visible.  CalculateVisiblePages
   // must have been called first.
   bool IsPageVisible(int index) const;
@@ -69,6 +69,12 @@ struct MetafileSkiaData {
 
   std::vector<Page> pages;
   std::unique_ptr<SkStreamAsset> data_stream;
+
+  // Only set in streaming mode, where each page is written into
+  // |streaming_doc| as soon as it is finished.
+  std::unique_ptr<SkDynamicMemoryWStream> streaming_output;
+  sk_sp<SkDocument> streaming_doc;
+
   ContentToProxyIdMap subframe_content_info;
   std::map<uint32_t, sk_sp<SkPicture>> subframe_pics;
   int document_cookie = 0;
@@ -162,6 +168,7 @@ bool MetafileSkia::FinishPage() {
     pic = data_->recorder.finishRecordingAsPicture();
   }
   data_->pages.emplace_back(data_->size, std::move(pic));
+  StreamLastPage();
   return true;
 }
 
@@ -173,36 +180,32 @@ bool MetafileSkia::FinishDocument() {
   if (data_->recorder.getRecordingCanvas())
     FinishPage();
 
-  SkDynamicMemoryWStream stream;
-  sk_sp<SkDocument> doc;
-  cc::PlaybackParams::CustomDataRasterCallback custom_callback;
-  switch (data_->type) {
-    case SkiaDocumentType::PDF:
-      doc = MakePdfDocument(printing::GetAgent(), &stream);
-      break;
-    case SkiaDocumentType::MSKP:
-      SkSerialProcs procs = SerializationProcs(&data_->subframe_content_info);
-      doc = SkMakeMultiPictureDocument(&stream, &procs);
-      // It is safe to use base::Unretained(this) because the callback
-      // is only used by |canvas| in the following loop which has shorter
-      // lifetime than |this|.
-      custom_callback = base::BindRepeating(
-          &MetafileSkia::CustomDataToSkPictureCallback, base::Unretained(this));
-      break;
+  if (data_->streaming_doc) {
+    data_->streaming_doc->close();
+    data_->streaming_doc.reset();
+    data_->data_stream = data_->streaming_output->detachAsStream();
+    data_->streaming_output.reset();
+    return true;
   }
 
-  for (const Page& page : data_->pages) {
-    cc::SkiaPaintCanvas canvas(
-        doc->beginPage(page.size.width(), page.size.height()));
-    canvas.drawPicture(page.content, custom_callback);
-    doc->endPage();
-  }
+  SkDynamicMemoryWStream stream;
+  sk_sp<SkDocument> doc = MakeDocument(&stream);
+  for (const Page& page : data_->pages)
+    WritePage(doc.get(), page.size, page.content);
   doc->close();
 
   data_->data_stream = stream.detachAsStream();
   return true;
 }
 
+void MetafileSkia::EnableStreaming() {
+  DCHECK(data_->pages.empty());
+  DCHECK(!data_->recorder.getRecordingCanvas());
+  DCHECK(!data_->data_stream);
+  data_->streaming_output = std::make_unique<SkDynamicMemoryWStream>();
+  data_->streaming_doc = MakeDocument(data_->streaming_output.get());
+}
+
 void MetafileSkia::FinishFrameContent() {
   // Sanity check to make sure we print the entire frame as a single page
   // content.
@@ -210,6 +213,7 @@ void MetafileSkia::FinishFrameContent() {
   // Also make sure it is in skia multi-picture document format.
   DCHECK_EQ(data_->type, SkiaDocumentType::MSKP);
   DCHECK(!data_->data_stream);
+  DCHECK(!data_->streaming_doc);
 
   cc::PlaybackParams::CustomDataRasterCallback custom_callback =
       base::BindRepeating(&MetafileSkia::CustomDataToSkPictureCallback,
@@ -362,6 +366,7 @@ const ContentToProxyIdMap& MetafileSkia::GetSubframeContentInfo() const {
 void MetafileSkia::AppendPage(const SkSize& page_size,
                               sk_sp<cc::PaintRecord> record) {
   data_->pages.emplace_back(page_size, std::move(record));
+  StreamLastPage();
 }
 
 void MetafileSkia::AppendSubframeInfo(uint32_t content_id,
@@ -375,6 +380,47 @@ SkStreamAsset* MetafileSkia::GetPdfData() const {
   return data_->data_stream.get();
 }
 
+sk_sp<SkDocument> MetafileSkia::MakeDocument(SkWStream* stream) {
+  switch (data_->type) {
+    case SkiaDocumentType::PDF:
+      return MakePdfDocument(printing::GetAgent(), stream);
+    case SkiaDocumentType::MSKP:
+      SkSerialProcs procs = SerializationProcs(&data_->subframe_content_info);
+      return SkMakeMultiPictureDocument(stream, &procs);
+  }
+  NOTREACHED();
+  return nullptr;
+}
+
+void MetafileSkia::WritePage(SkDocument* doc,
+                             const SkSize& page_size,
+                             sk_sp<cc::PaintRecord> record) {
+  cc::PlaybackParams::CustomDataRasterCallback custom_callback;
+  if (data_->type == SkiaDocumentType::MSKP) {
+    // It is safe to use base::Unretained(this) because the callback is only
+    // used by |canvas| below, which has a shorter lifetime than |this|.
+    custom_callback = base::BindRepeating(
+        &MetafileSkia::CustomDataToSkPictureCallback, base::Unretained(this));
+  }
+
+  cc::SkiaPaintCanvas canvas(
+      doc->beginPage(page_size.width(), page_size.height()));
+  canvas.drawPicture(std::move(record), custom_callback);
+  doc->endPage();
+}
+
+void MetafileSkia::StreamLastPage() {
+  if (!data_->streaming_doc)
+    return;
+
+  const Page& page = data_->pages.back();
+  WritePage(data_->streaming_doc.get(), page.size, page.content);
+
+  // Only the last page is needed for GetMetafileForCurrentPage().
+  if (data_->pages.size() > 1)
+    data_->pages[data_->pages.size() - 2].content = nullptr;
+}
+
 void MetafileSkia::CustomDataToSkPictureCallback(SkCanvas* canvas,
                                                  uint32_t content_id) {
   // Check whether this is the one we need to handle.
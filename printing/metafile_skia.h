@@ -66,6 +66,13 @@ class PRINTING_EXPORT MetafileSkia : public Metafile {
 
   bool SaveTo(base::File* file) const override;
 
+  // Makes the metafile serialize each page into the document as soon as it is
+  // finished, instead of all at once in FinishDocument(), and only keep the
+  // recording of the last page. For PDF documents, which are written out page
+  // by page, this bounds the memory used while printing long documents. Must
+  // be called before the first page.
+  void EnableStreaming();
+
   // Unlike FinishPage() or FinishDocument(), this is for out-of-process
   // subframe printing. It will just serialize the content into SkPicture
   // format and store it as final data.
@@ -105,6 +112,17 @@ class PRINTING_EXPORT MetafileSkia : public Metafile {
                           sk_sp<SkPicture> subframe_pic_holder);
   SkStreamAsset* GetPdfData() const;
 
+  // Creates an empty document of this metafile's type, written into |stream|.
+  sk_sp<SkDocument> MakeDocument(SkWStream* stream);
+
+  // Draws a page with the given size and content into |doc|.
+  void WritePage(SkDocument* doc,
+                 const SkSize& page_size,
+                 sk_sp<cc::PaintRecord> record);
+
+  // In streaming mode, writes the page that was just added into the document.
+  void StreamLastPage();
+
   // Callback function used during page content drawing to replace a custom
   // data holder with corresponding place holder SkPicture.
   void CustomDataToSkPictureCallback(SkCanvas* canvas, uint32_t content_id);
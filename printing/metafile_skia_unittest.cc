@@ -4,6 +4,10 @@
 
 #include "printing/metafile_skia.h"
 
+#include <vector>
+
+#include "cc/paint/paint_canvas.h"
+#include "cc/paint/paint_flags.h"
 #include "cc/paint/paint_record.h"
 #include "printing/common/metafile_utils.h"
 #include "testing/gtest/include/gtest/gtest.h"
@@ -77,4 +81,37 @@ TEST(MetafileSkiaTest, TestFrameContent) {
   EXPECT_EQ(bitmap.getColor(kPictureSideLen, kPictureSideLen), SK_ColorWHITE);
 }
 
+TEST(MetafileSkiaTest, Streaming) {
+  constexpr int kPageCount = 3;
+  const gfx::Size page_size(200, 300);
+  const gfx::Rect content_area(10, 10, 180, 280);
+
+  MetafileSkia metafile(SkiaDocumentType::MSKP, 1);
+  MetafileSkia streaming_metafile(SkiaDocumentType::MSKP, 1);
+  streaming_metafile.EnableStreaming();
+  for (MetafileSkia* m : {&metafile, &streaming_metafile}) {
+    for (int i = 0; i < kPageCount; ++i) {
+      cc::PaintCanvas* canvas =
+          m->GetVectorCanvasForNewPage(page_size, content_area, 1.0f);
+      ASSERT_TRUE(canvas);
+      cc::PaintFlags flags;
+      flags.setColor(SK_ColorRED);
+      canvas->drawRect(SkRect::MakeXYWH(i, i, 50, 50), flags);
+    }
+    EXPECT_TRUE(m->FinishDocument());
+  }
+
+  // Streaming produces the same document.
+  EXPECT_EQ(static_cast<unsigned int>(kPageCount),
+            streaming_metafile.GetPageCount());
+  EXPECT_EQ(gfx::Rect(page_size), streaming_metafile.GetPageBounds(1));
+  ASSERT_EQ(metafile.GetDataSize(), streaming_metafile.GetDataSize());
+  std::vector<char> data(metafile.GetDataSize());
+  std::vector<char> streaming_data(streaming_metafile.GetDataSize());
+  ASSERT_TRUE(metafile.GetData(data.data(), data.size()));
+  ASSERT_TRUE(streaming_metafile.GetData(streaming_data.data(),
+                                         streaming_data.size()));
+  EXPECT_EQ(data, streaming_data);
+}
+
 }  // namespace printing
@@ -4,6 +4,7 @@
 
 #include "remoting/codec/video_decoder_vpx.h"
 
+#include "base/test/scoped_task_environment.h"
 #include "remoting/codec/codec_test.h"
 #include "remoting/codec/video_encoder_vpx.h"
 #include "testing/gtest/include/gtest/gtest.h"
@@ -15,6 +16,7 @@ namespace {
 
 class VideoDecoderVpxTest : public testing::Test {
  protected:
+  base::test::ScopedTaskEnvironment scoped_task_environment_;
   std::unique_ptr<VideoEncoderVpx> encoder_;
   std::unique_ptr<VideoDecoderVpx> decoder_;
 
@@ -64,6 +66,11 @@ TEST_F(VideoDecoderVp8Test, Gradient) {
   TestGradient(320, 240, 0.04, 0.02);
 }
 
+// Frames this large are converted to YUV on several threads.
+TEST_F(VideoDecoderVp8Test, LargeGradient) {
+  TestGradient(1920, 1080, 0.04, 0.02);
+}
+
 //
 // Test the VP9 codec.
 //
@@ -79,4 +86,9 @@ TEST_F(VideoDecoderVp9Test, Gradient) {
   TestGradient(320, 240, 0.04, 0.02);
 }
 
+// Frames this large are converted to YUV on several threads.
+TEST_F(VideoDecoderVp9Test, LargeGradient) {
+  TestGradient(1920, 1080, 0.04, 0.02);
+}
+
 }  // namespace remoting
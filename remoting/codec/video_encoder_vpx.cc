@@ -4,12 +4,18 @@
 
 #include "remoting/codec/video_encoder_vpx.h"
 
+#include <algorithm>
 #include <utility>
+#include <vector>
 
+#include "base/barrier_closure.h"
 #include "base/bind.h"
+#include "base/callback_helpers.h"
 #include "base/logging.h"
 #include "base/memory/ptr_util.h"
+#include "base/synchronization/waitable_event.h"
 #include "base/system/sys_info.h"
+#include "base/task/post_task.h"
 #include "remoting/base/util.h"
 #include "remoting/proto/video.pb.h"
 #include "third_party/libvpx/source/libvpx/vpx/vp8cx.h"
@@ -30,6 +36,17 @@ const int kBytesPerRgbPixel = 4;
 // map for the encoder.
 const int kMacroBlockSize = 16;
 
+// Updates with fewer pixels than this per thread are converted from RGB to YUV
+// on the encode thread alone.
+const int kMinPixelsPerConversionThread = 256 * 1024;
+
+// Maximum number of threads to convert a frame from RGB to YUV on.
+const int kMaxConversionThreads = 4;
+
+// Height of the bands that large updates are split into for conversion. Must
+// be even, so that bands don't share I420 chroma rows.
+const int kConversionBandHeight = 4 * kMacroBlockSize;
+
 // Magic encoder profile numbers for I420 and I444 input formats.
 const int kVp9I420ProfileNumber = 0;
 const int kVp9I444ProfileNumber = 1;
@@ -225,6 +242,104 @@ void CreateImage(bool use_i444,
   *out_image_buffer = std::move(image_buffer);
 }
 
+// Converts |rects| of |frame| from RGB to YUV, into |image|.
+void ConvertRgbToYuv(const webrtc::DesktopFrame& frame,
+                     const std::vector<webrtc::DesktopRect>& rects,
+                     vpx_image_t* image) {
+  const uint8_t* rgb_data = frame.data();
+  const int rgb_stride = frame.stride();
+  const int y_stride = image->stride[0];
+  DCHECK_EQ(image->stride[1], image->stride[2]);
+  const int uv_stride = image->stride[1];
+  uint8_t* y_data = image->planes[0];
+  uint8_t* u_data = image->planes[1];
+  uint8_t* v_data = image->planes[2];
+
+  switch (image->fmt) {
+    case VPX_IMG_FMT_I444:
+      for (const webrtc::DesktopRect& rect : rects) {
+        int rgb_offset = rgb_stride * rect.top() +
+                         rect.left() * kBytesPerRgbPixel;
+        int yuv_offset = uv_stride * rect.top() + rect.left();
+        libyuv::ARGBToI444(rgb_data + rgb_offset, rgb_stride,
+                           y_data + yuv_offset, y_stride,
+                           u_data + yuv_offset, uv_stride,
+                           v_data + yuv_offset, uv_stride,
+                           rect.width(), rect.height());
+      }
+      break;
+    case VPX_IMG_FMT_YV12:
+      for (const webrtc::DesktopRect& rect : rects) {
+        int rgb_offset = rgb_stride * rect.top() +
+                         rect.left() * kBytesPerRgbPixel;
+        int y_offset = y_stride * rect.top() + rect.left();
+        int uv_offset = uv_stride * rect.top() / 2 + rect.left() / 2;
+        libyuv::ARGBToI420(rgb_data + rgb_offset, rgb_stride,
+                           y_data + y_offset, y_stride,
+                           u_data + uv_offset, uv_stride,
+                           v_data + uv_offset, uv_stride,
+                           rect.width(), rect.height());
+      }
+      break;
+    default:
+      NOTREACHED();
+      break;
+  }
+}
+
+// Runs ConvertRgbToYuv() on the thread pool. |done| runs when the conversion
+// has finished, or when the task is dropped at shutdown.
+void ConvertRgbToYuvOnThreadPool(const webrtc::DesktopFrame* frame,
+                                 std::vector<webrtc::DesktopRect> rects,
+                                 vpx_image_t* image,
+                                 base::ScopedClosureRunner done) {
+  ConvertRgbToYuv(*frame, rects, image);
+}
+
+// Splits |region| into groups of rects with roughly the same number of pixels,
+// one per conversion thread. Large updates are cut into horizontal bands to
+// balance the groups.
+std::vector<std::vector<webrtc::DesktopRect>> SplitRegionForConversion(
+    const webrtc::DesktopRegion& region) {
+  int64_t pixel_count = 0;
+  for (webrtc::DesktopRegion::Iterator r(region); !r.IsAtEnd(); r.Advance())
+    pixel_count += r.rect().width() * r.rect().height();
+
+  const int max_group_count =
+      std::min(kMaxConversionThreads, base::SysInfo::NumberOfProcessors());
+  const int group_count = static_cast<int>(std::max<int64_t>(
+      1, std::min<int64_t>(max_group_count,
+                           pixel_count / kMinPixelsPerConversionThread)));
+
+  std::vector<std::vector<webrtc::DesktopRect>> groups(1);
+  if (group_count == 1) {
+    for (webrtc::DesktopRegion::Iterator r(region); !r.IsAtEnd(); r.Advance())
+      groups.back().push_back(r.rect());
+    return groups;
+  }
+
+  const int64_t pixels_per_group =
+      (pixel_count + group_count - 1) / group_count;
+  int64_t group_pixel_count = 0;
+  for (webrtc::DesktopRegion::Iterator r(region); !r.IsAtEnd(); r.Advance()) {
+    const webrtc::DesktopRect& rect = r.rect();
+    for (int top = rect.top(); top < rect.bottom();
+         top += kConversionBandHeight) {
+      if (group_pixel_count >= pixels_per_group &&
+          static_cast<int>(groups.size()) < group_count) {
+        groups.emplace_back();
+        group_pixel_count = 0;
+      }
+      webrtc::DesktopRect band = webrtc::DesktopRect::MakeLTRB(
+          rect.left(), top, rect.right(),
+          std::min(top + kConversionBandHeight, rect.bottom()));
+      groups.back().push_back(band);
+      group_pixel_count += band.width() * band.height();
+    }
+  }
+  return groups;
+}
+
 }  // namespace
 
 // static
@@ -450,50 +565,32 @@ void VideoEncoderVpx::PrepareImage(const webrtc::DesktopFrame& frame,
     updated_region->AddRect(webrtc::DesktopRect::MakeWH(image_->w, image_->h));
   }
 
-  // Convert the updated region to YUV ready for encoding.
-  const uint8_t* rgb_data = frame.data();
-  const int rgb_stride = frame.stride();
-  const int y_stride = image_->stride[0];
-  DCHECK_EQ(image_->stride[1], image_->stride[2]);
-  const int uv_stride = image_->stride[1];
-  uint8_t* y_data = image_->planes[0];
-  uint8_t* u_data = image_->planes[1];
-  uint8_t* v_data = image_->planes[2];
-
-  switch (image_->fmt) {
-    case VPX_IMG_FMT_I444:
-      for (webrtc::DesktopRegion::Iterator r(*updated_region); !r.IsAtEnd();
-           r.Advance()) {
-        const webrtc::DesktopRect& rect = r.rect();
-        int rgb_offset = rgb_stride * rect.top() +
-                         rect.left() * kBytesPerRgbPixel;
-        int yuv_offset = uv_stride * rect.top() + rect.left();
-        libyuv::ARGBToI444(rgb_data + rgb_offset, rgb_stride,
-                           y_data + yuv_offset, y_stride,
-                           u_data + yuv_offset, uv_stride,
-                           v_data + yuv_offset, uv_stride,
-                           rect.width(), rect.height());
-      }
-      break;
-    case VPX_IMG_FMT_YV12:
-      for (webrtc::DesktopRegion::Iterator r(*updated_region); !r.IsAtEnd();
-           r.Advance()) {
-        const webrtc::DesktopRect& rect = r.rect();
-        int rgb_offset = rgb_stride * rect.top() +
-                         rect.left() * kBytesPerRgbPixel;
-        int y_offset = y_stride * rect.top() + rect.left();
-        int uv_offset = uv_stride * rect.top() / 2 + rect.left() / 2;
-        libyuv::ARGBToI420(rgb_data + rgb_offset, rgb_stride,
-                           y_data + y_offset, y_stride,
-                           u_data + uv_offset, uv_stride,
-                           v_data + uv_offset, uv_stride,
-                           rect.width(), rect.height());
-      }
-      break;
-    default:
-      NOTREACHED();
-      break;
+  // Convert the updated region to YUV ready for encoding, on several threads
+  // if it is large.
+  std::vector<std::vector<webrtc::DesktopRect>> rect_groups =
+      SplitRegionForConversion(*updated_region);
+  if (rect_groups.size() == 1) {
+    ConvertRgbToYuv(frame, rect_groups[0], image_.get());
+    return;
+  }
+
+  base::WaitableEvent conversions_done;
+  base::RepeatingClosure barrier = base::BarrierClosure(
+      rect_groups.size() - 1,
+      base::BindOnce(&base::WaitableEvent::Signal,
+                     base::Unretained(&conversions_done)));
+  for (size_t i = 1; i < rect_groups.size(); ++i) {
+    base::PostTaskWithTraits(
+        FROM_HERE, {base::TaskPriority::USER_BLOCKING},
+        base::BindOnce(&ConvertRgbToYuvOnThreadPool, &frame,
+                       std::move(rect_groups[i]), image_.get(),
+                       base::ScopedClosureRunner(barrier)));
   }
+  ConvertRgbToYuv(frame, rect_groups[0], image_.get());
+
+  // The other conversions read |frame| and write into |image_|, so wait for
+  // them before either is used again.
+  conversions_done.Wait();
 }
 
 void VideoEncoderVpx::SetActiveMapFromRegion(
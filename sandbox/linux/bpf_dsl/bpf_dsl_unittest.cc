@@ -8,6 +8,7 @@
 #include <fcntl.h>
 #include <netinet/in.h>
 #include <stdint.h>
+#include <string.h>
 #include <sys/socket.h>
 #include <sys/syscall.h>
 #include <sys/utsname.h>
@@ -26,6 +27,7 @@
 #include "sandbox/linux/bpf_dsl/policy.h"
 #include "sandbox/linux/bpf_dsl/policy_compiler.h"
 #include "sandbox/linux/bpf_dsl/seccomp_macros.h"
+#include "sandbox/linux/bpf_dsl/syscall_set.h"
 #include "sandbox/linux/bpf_dsl/test_trap_registry.h"
 #include "sandbox/linux/bpf_dsl/verifier.h"
 #include "sandbox/linux/system_headers/linux_filter.h"
@@ -473,6 +475,89 @@ TEST(BPFDSL, HasUnsafeTraps) {
   EXPECT_TRUE(maybe->HasUnsafeTraps());
 }
 
+class AlternatingPolicy : public Policy {
+ public:
+  AlternatingPolicy() {}
+  ~AlternatingPolicy() override {}
+  ResultExpr EvaluateSyscall(int sysno) const override {
+    return sysno % 2 ? Error(EPERM) : Allow();
+  }
+
+ private:
+  DISALLOW_COPY_AND_ASSIGN(AlternatingPolicy);
+};
+
+// Returns the number of BPF_JGE comparisons that |program| makes before it
+// returns a result for system call |nr|.
+size_t CountComparisons(const CodeGen::Program& program, int nr) {
+  const struct arch_seccomp_data data = FakeSyscall(nr);
+  uint32_t a = 0;
+  size_t comparisons = 0;
+  for (size_t pc = 0; pc < program.size(); ++pc) {
+    const struct sock_filter& insn = program[pc];
+    switch (BPF_CLASS(insn.code)) {
+      case BPF_LD:
+        memcpy(&a, reinterpret_cast<const char*>(&data) + insn.k, sizeof(a));
+        break;
+      case BPF_JMP: {
+        bool taken = false;
+        switch (BPF_OP(insn.code)) {
+          case BPF_JA:
+            pc += insn.k;
+            continue;
+          case BPF_JEQ:
+            taken = a == insn.k;
+            break;
+          case BPF_JGE:
+            taken = a >= insn.k;
+            ++comparisons;
+            break;
+          case BPF_JSET:
+            taken = (a & insn.k) != 0;
+            break;
+          default:
+            ADD_FAILURE() << "Unexpected jump";
+            return comparisons;
+        }
+        pc += taken ? insn.jt : insn.jf;
+        break;
+      }
+      case BPF_RET:
+        return comparisons;
+      default:
+        ADD_FAILURE() << "Unexpected instruction";
+        return comparisons;
+    }
+  }
+  ADD_FAILURE() << "Fell off the end of the program";
+  return comparisons;
+}
+
+TEST(BPFDSL, HotSyscalls) {
+  AlternatingPolicy policy;
+  TestTrapRegistry traps;
+  const CodeGen::Program plain = PolicyCompiler(&policy, &traps).Compile();
+
+  PolicyCompiler compiler(&policy, &traps);
+  compiler.SetHotSyscalls({__NR_futex, __NR_read});
+  const CodeGen::Program weighted = compiler.Compile();
+
+  // Hot system calls are dispatched in fewer comparisons.
+  for (int sysno : {__NR_futex, __NR_read})
+    EXPECT_LT(CountComparisons(weighted, sysno),
+              CountComparisons(plain, sysno));
+
+  // Without changing the result of any system call.
+  for (uint32_t sysnum : SyscallSet::All()) {
+    const struct arch_seccomp_data data = FakeSyscall(sysnum);
+    const char* err = nullptr;
+    const uint32_t expected = Verifier::EvaluateBPF(plain, data, &err);
+    ASSERT_FALSE(err);
+    EXPECT_EQ(expected, Verifier::EvaluateBPF(weighted, data, &err));
+    ASSERT_FALSE(err);
+  }
+}
+
 }  // namespace
 }  // namespace bpf_dsl
 }  // namespace sandbox
@@ -9,6 +9,7 @@
 #include <stdint.h>
 #include <sys/syscall.h>
 
+#include <algorithm>
 #include <limits>
 
 #include "base/logging.h"
@@ -85,6 +86,8 @@ bool HasUnsafeTraps(const Policy* policy) {
 struct PolicyCompiler::Range {
   uint32_t from;
   CodeGen::Node node;
+  // Relative frequency of the system calls in this range.
+  size_t weight;
 };
 
 PolicyCompiler::PolicyCompiler(const Policy* policy, TrapRegistry* registry)
@@ -130,6 +133,13 @@ void PolicyCompiler::SetPanicFunc(PanicFunc panic_func) {
   panic_func_ = panic_func;
 }
 
+void PolicyCompiler::SetHotSyscalls(std::vector<int> hot_syscalls) {
+  hot_syscalls_.assign(hot_syscalls.begin(), hot_syscalls.end());
+  std::sort(hot_syscalls_.begin(), hot_syscalls_.end());
+  hot_syscalls_.erase(std::unique(hot_syscalls_.begin(), hot_syscalls_.end()),
+                      hot_syscalls_.end());
+}
+
 CodeGen::Node PolicyCompiler::AssemblePolicy() {
   // A compiled policy consists of three logical parts:
   //   1. Check that the "arch" field matches the expected architecture.
@@ -240,12 +250,25 @@ void PolicyCompiler::FindRanges(Ranges* ranges) {
     // node value for) identical code sequences, otherwise our jump
     // table will blow up in size.
     if (node != old_node) {
-      ranges->push_back(Range{old_sysnum, old_node});
+      ranges->push_back(Range{old_sysnum, old_node, 1});
       old_sysnum = sysnum;
       old_node = node;
     }
   }
-  ranges->push_back(Range{old_sysnum, old_node});
+  ranges->push_back(Range{old_sysnum, old_node, 1});
+
+  // Each hot system call weighs as much as all the ranges together, so that
+  // it is reached in about log2(number of hot system calls) comparisons,
+  // while the other system calls need at most a few more comparisons than
+  // without hot system calls.
+  const size_t hot_weight = ranges->size();
+  auto range = ranges->begin();
+  for (uint32_t sysnum : hot_syscalls_) {
+    while (range + 1 != ranges->end() && (range + 1)->from <= sysnum)
+      ++range;
+    if (range->from <= sysnum)
+      range->weight += hot_weight;
+  }
 }
 
 CodeGen::Node PolicyCompiler::AssembleJumpTable(Ranges::const_iterator start,
@@ -262,11 +285,28 @@ CodeGen::Node PolicyCompiler::AssembleJumpTable(Ranges::const_iterator start,
     return start->node;
   }
 
-  // Pick the range object that is located at the mid point of our list.
-  // We compare our system call number against the lowest valid system call
-  // number in this range object. If our number is lower, it is outside of
-  // this range object. If it is greater or equal, it might be inside.
-  Ranges::const_iterator mid = start + n / 2;
+  // Pick the range object that splits our list into two halves of about the
+  // same weight; without hot system calls, this is the one located at the
+  // mid point of our list. We compare our system call number against the
+  // lowest valid system call number in this range object. If our number is
+  // lower, it is outside of this range object. If it is greater or equal, it
+  // might be inside.
+  size_t total_weight = 0;
+  for (auto it = start; it != stop; ++it)
+    total_weight += it->weight;
+  Ranges::const_iterator mid = start + 1;
+  size_t left_weight = start->weight;
+  size_t best_imbalance = std::numeric_limits<size_t>::max();
+  for (auto it = start + 1; it != stop; ++it) {
+    size_t right_weight = total_weight - left_weight;
+    size_t imbalance = left_weight > right_weight ? left_weight - right_weight
+                                                  : right_weight - left_weight;
+    if (imbalance < best_imbalance) {
+      best_imbalance = imbalance;
+      mid = it;
+    }
+    left_weight += it->weight;
+  }
 
   // Sub-divide the list of ranges and continue recursively.
   CodeGen::Node jf = AssembleJumpTable(start, mid);
@@ -30,6 +30,10 @@ namespace {
 // Time in seconds between two successive measurements of audio power levels.
 constexpr int kPowerMonitorLogIntervalSeconds = 15;
 
+// How often the callback stats of a playing stream are logged and traced.
+constexpr base::TimeDelta kStreamStatsReportInterval =
+    base::TimeDelta::FromSeconds(10);
+
 // Used to log the result of rendering startup.
 // Elements in this enum should not be deleted or rearranged; the only
 // permitted operation is to add new elements before
@@ -300,6 +304,9 @@ void OutputController::Play() {
   }
 
   stats_tracker_.emplace();
+  stream_stats_.emplace(params_.GetBufferDuration());
+  stream_stats_timer_.Start(FROM_HERE, kStreamStatsReportInterval, this,
+                            &OutputController::ReportStreamStats);
 
   stream_->Start(this);
 
@@ -312,6 +319,9 @@ void OutputController::StopStream() {
   if (state_ == kPlaying) {
     stream_->Stop();
     stats_tracker_.reset();
+    stream_stats_timer_.Stop();
+    ReportStreamStats();
+    stream_stats_.reset();
 
     if (will_monitor_audio_levels()) {
       LogAudioPowerLevel("StopStream");
@@ -396,7 +406,9 @@ int OutputController::OnMoreData(base::TimeDelta delay,
 
   stats_tracker_->OnMoreDataCalled();
 
-  sync_reader_->Read(dest);
+  const bool data_ready = sync_reader_->Read(dest);
+  stream_stats_->OnCallback(base::TimeTicks::Now(), delay,
+                            prior_frames_skipped, data_ready);
 
   const base::TimeTicks reference_time = delay_timestamp + delay;
 
@@ -469,6 +481,31 @@ void OutputController::LogAudioPowerLevel(const char* call_name) {
                          call_name, power_and_clip.first));
 }
 
+void OutputController::ReportStreamStats() {
+  DCHECK(task_runner_->BelongsToCurrentThread());
+  if (!stream_stats_)
+    return;
+
+  const OutputStreamStats::Interval interval = stream_stats_->TakeInterval();
+  if (!interval.callbacks)
+    return;
+
+  TRACE_EVENT_INSTANT2("audio", "OutputController::ReportStreamStats",
+                       TRACE_EVENT_SCOPE_THREAD, "missed deadlines",
+                       interval.missed_deadlines, "skipped frames",
+                       interval.skipped_frames);
+  TRACE_COUNTER_ID2("audio", "OutputStreamStats", this, "max jitter (us)",
+                    interval.max_jitter.InMicroseconds(), "max delay (us)",
+                    interval.max_delay.InMicroseconds());
+  handler_->OnLog(base::StringPrintf(
+      "OutputController: %d callbacks, %d missed deadlines, %d skipped "
+      "frames, max jitter=%.1f ms, delay average=%.1f ms max=%.1f ms",
+      interval.callbacks, interval.missed_deadlines, interval.skipped_frames,
+      interval.max_jitter.InMillisecondsF(),
+      interval.average_delay.InMillisecondsF(),
+      interval.max_delay.InMillisecondsF()));
+}
+
 void OutputController::OnError() {
   // Handle error on the audio controller thread.  We defer errors for one
   // second in case they are the result of a device change; delay chosen to
@@ -27,6 +27,7 @@
 #include "media/audio/audio_power_monitor.h"
 #include "media/audio/audio_source_diverter.h"
 #include "services/audio/loopback_group_member.h"
+#include "services/audio/output_stream_stats.h"
 #include "services/audio/stream_monitor_coordinator.h"
 
 // An OutputController controls an AudioOutputStream and provides data to this
@@ -96,8 +97,8 @@ class OutputController : public media::AudioOutputStream::AudioSourceCallback,
                                  int prior_frames_skipped) = 0;
 
     // Attempts to completely fill |dest|, zeroing |dest| if the request can not
-    // be fulfilled (due to timeout).
-    virtual void Read(media::AudioBus* dest) = 0;
+    // be fulfilled (due to timeout). Returns false in that case.
+    virtual bool Read(media::AudioBus* dest) = 0;
 
     // Close this synchronous reader.
     virtual void Close() = 0;
@@ -250,6 +251,10 @@ class OutputController : public media::AudioOutputStream::AudioSourceCallback,
   // Log the current average power level measured by power_monitor_.
   void LogAudioPowerLevel(const char* call_name);
 
+  // Logs and traces the callback stats collected in |stream_stats_| since the
+  // last report.
+  void ReportStreamStats();
+
   // Helper called by StartMuting() and StopMuting() to execute the stream
   // change.
   void ToggleLocalOutput();
@@ -307,6 +312,12 @@ class OutputController : public media::AudioOutputStream::AudioSourceCallback,
   // being created due to device changes.
   base::Optional<ErrorStatisticsTracker> stats_tracker_;
 
+  // Collects stats about the callbacks of a playing stream, which are reported
+  // periodically by |stream_stats_timer_|. Created and destroyed along with
+  // |stats_tracker_|.
+  base::Optional<OutputStreamStats> stream_stats_;
+  base::RepeatingTimer stream_stats_timer_;
+
   // WeakPtrFactory+WeakPtr that is used to post tasks that are canceled when a
   // stream is closed.
   base::WeakPtr<OutputController> weak_this_for_stream_;
@@ -90,7 +90,7 @@ class MockOutputControllerSyncReader : public OutputController::SyncReader {
                void(base::TimeDelta delay,
                     base::TimeTicks delay_timestamp,
                     int prior_frames_skipped));
-  MOCK_METHOD1(Read, void(AudioBus* dest));
+  MOCK_METHOD1(Read, bool(AudioBus* dest));
   MOCK_METHOD0(Close, void());
 
  private:
@@ -315,6 +315,7 @@ ACTION(PopulateBuffer) {
   // Note: To confirm the buffer will be populated in these tests, it's
   // sufficient that only the first float in channel 0 is set to the value.
   arg0->channel(0)[0] = kBufferNonZeroData;
+  return true;
 }
 
 class OutputControllerTest : public ::testing::Test {
@@ -363,6 +364,7 @@ class OutputControllerTest : public ::testing::Test {
           data->Zero();
           data->channel(0)[0] = kBufferNonZeroData;
           barrier.Run();
+          return true;
         }))
         .WillRepeatedly(PopulateBuffer());
 
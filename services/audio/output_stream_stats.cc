@@ -0,0 +1,71 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "services/audio/output_stream_stats.h"
+
+namespace audio {
+
+namespace {
+
+// Raises |max| to |value|. Only the callback thread raises it, and other
+// threads only reset it to zero, so a plain load and store can't lose a
+// larger value to another writer.
+void UpdateMax(std::atomic<int64_t>* max, int64_t value) {
+  if (value > max->load(std::memory_order_relaxed))
+    max->store(value, std::memory_order_relaxed);
+}
+
+}  // namespace
+
+OutputStreamStats::OutputStreamStats(base::TimeDelta buffer_duration)
+    : buffer_duration_(buffer_duration) {}
+
+OutputStreamStats::~OutputStreamStats() = default;
+
+void OutputStreamStats::OnCallback(base::TimeTicks now,
+                                   base::TimeDelta delay,
+                                   int prior_frames_skipped,
+                                   bool data_ready) {
+  callbacks_.fetch_add(1, std::memory_order_relaxed);
+  if (!data_ready)
+    missed_deadlines_.fetch_add(1, std::memory_order_relaxed);
+  if (prior_frames_skipped > 0) {
+    skipped_frames_.fetch_add(prior_frames_skipped,
+                              std::memory_order_relaxed);
+  }
+
+  if (!last_callback_time_.is_null()) {
+    UpdateMax(&max_jitter_us_,
+              (now - last_callback_time_ - buffer_duration_)
+                  .magnitude()
+                  .InMicroseconds());
+  }
+  last_callback_time_ = now;
+
+  const int64_t delay_us = delay.InMicroseconds();
+  total_delay_us_.fetch_add(delay_us, std::memory_order_relaxed);
+  UpdateMax(&max_delay_us_, delay_us);
+}
+
+OutputStreamStats::Interval OutputStreamStats::TakeInterval() {
+  Interval interval;
+  interval.callbacks = callbacks_.exchange(0, std::memory_order_relaxed);
+  interval.missed_deadlines =
+      missed_deadlines_.exchange(0, std::memory_order_relaxed);
+  interval.skipped_frames =
+      skipped_frames_.exchange(0, std::memory_order_relaxed);
+  interval.max_jitter = base::TimeDelta::FromMicroseconds(
+      max_jitter_us_.exchange(0, std::memory_order_relaxed));
+  const int64_t total_delay_us =
+      total_delay_us_.exchange(0, std::memory_order_relaxed);
+  if (interval.callbacks > 0) {
+    interval.average_delay =
+        base::TimeDelta::FromMicroseconds(total_delay_us / interval.callbacks);
+  }
+  interval.max_delay = base::TimeDelta::FromMicroseconds(
+      max_delay_us_.exchange(0, std::memory_order_relaxed));
+  return interval;
+}
+
+}  // namespace audio
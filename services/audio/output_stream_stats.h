@@ -0,0 +1,73 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef SERVICES_AUDIO_OUTPUT_STREAM_STATS_H_
+#define SERVICES_AUDIO_OUTPUT_STREAM_STATS_H_
+
+#include <stdint.h>
+
+#include <atomic>
+
+#include "base/macros.h"
+#include "base/time/time.h"
+
+namespace audio {
+
+// Accumulates measurements of the callbacks of an output stream: how many
+// there were, how many of them had no data from the renderer in time or
+// followed frames skipped by the device, how regularly they came, and the
+// output delay they reported. The callback thread records them with relaxed
+// atomic operations only, so it never blocks or allocates. Another thread
+// periodically takes the values accumulated since it last did.
+class OutputStreamStats {
+ public:
+  struct Interval {
+    int callbacks = 0;
+    // Callbacks for which the renderer didn't deliver data in time, so that
+    // silence was played instead.
+    int missed_deadlines = 0;
+    // Frames that the device reported as skipped, e.g. after an underrun.
+    int skipped_frames = 0;
+    // The largest difference between the time between two callbacks and the
+    // buffer duration.
+    base::TimeDelta max_jitter;
+    // The output delay, i.e. the time until the audio of a callback is played.
+    base::TimeDelta average_delay;
+    base::TimeDelta max_delay;
+  };
+
+  explicit OutputStreamStats(base::TimeDelta buffer_duration);
+  ~OutputStreamStats();
+
+  // Called on the stream callback thread for every callback, at |now|.
+  // |data_ready| is false if the renderer missed its deadline.
+  void OnCallback(base::TimeTicks now,
+                  base::TimeDelta delay,
+                  int prior_frames_skipped,
+                  bool data_ready);
+
+  // Returns the values accumulated since the previous call. May be called on
+  // any thread. The fields are taken one by one, so a callback that runs
+  // concurrently may be split between two intervals.
+  Interval TakeInterval();
+
+ private:
+  const base::TimeDelta buffer_duration_;
+
+  // Only used on the callback thread.
+  base::TimeTicks last_callback_time_;
+
+  std::atomic<int> callbacks_{0};
+  std::atomic<int> missed_deadlines_{0};
+  std::atomic<int> skipped_frames_{0};
+  std::atomic<int64_t> max_jitter_us_{0};
+  std::atomic<int64_t> total_delay_us_{0};
+  std::atomic<int64_t> max_delay_us_{0};
+
+  DISALLOW_COPY_AND_ASSIGN(OutputStreamStats);
+};
+
+}  // namespace audio
+
+#endif  // SERVICES_AUDIO_OUTPUT_STREAM_STATS_H_
@@ -0,0 +1,75 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "services/audio/output_stream_stats.h"
+
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace audio {
+
+namespace {
+
+constexpr base::TimeDelta kBufferDuration =
+    base::TimeDelta::FromMilliseconds(10);
+
+}  // namespace
+
+TEST(OutputStreamStatsTest, EmptyInterval) {
+  OutputStreamStats stats(kBufferDuration);
+  const OutputStreamStats::Interval interval = stats.TakeInterval();
+  EXPECT_EQ(0, interval.callbacks);
+  EXPECT_EQ(0, interval.missed_deadlines);
+  EXPECT_EQ(0, interval.skipped_frames);
+  EXPECT_EQ(base::TimeDelta(), interval.max_jitter);
+  EXPECT_EQ(base::TimeDelta(), interval.average_delay);
+  EXPECT_EQ(base::TimeDelta(), interval.max_delay);
+}
+
+TEST(OutputStreamStatsTest, AccumulatesCallbacks) {
+  OutputStreamStats stats(kBufferDuration);
+  base::TimeTicks now = base::TimeTicks() + base::TimeDelta::FromSeconds(1);
+
+  stats.OnCallback(now, base::TimeDelta::FromMilliseconds(20), 0, true);
+  // Late by 3 ms.
+  now += base::TimeDelta::FromMilliseconds(13);
+  stats.OnCallback(now, base::TimeDelta::FromMilliseconds(30), 128, false);
+  // Early by 2 ms.
+  now += base::TimeDelta::FromMilliseconds(8);
+  stats.OnCallback(now, base::TimeDelta::FromMilliseconds(10), 64, true);
+  now += base::TimeDelta::FromMilliseconds(10);
+  stats.OnCallback(now, base::TimeDelta::FromMilliseconds(20), 0, false);
+
+  const OutputStreamStats::Interval interval = stats.TakeInterval();
+  EXPECT_EQ(4, interval.callbacks);
+  EXPECT_EQ(2, interval.missed_deadlines);
+  EXPECT_EQ(192, interval.skipped_frames);
+  EXPECT_EQ(base::TimeDelta::FromMilliseconds(3), interval.max_jitter);
+  EXPECT_EQ(base::TimeDelta::FromMilliseconds(20), interval.average_delay);
+  EXPECT_EQ(base::TimeDelta::FromMilliseconds(30), interval.max_delay);
+}
+
+TEST(OutputStreamStatsTest, TakeIntervalResets) {
+  OutputStreamStats stats(kBufferDuration);
+  base::TimeTicks now = base::TimeTicks() + base::TimeDelta::FromSeconds(1);
+
+  stats.OnCallback(now, base::TimeDelta::FromMilliseconds(40), 256, false);
+  now += base::TimeDelta::FromMilliseconds(15);
+  stats.OnCallback(now, base::TimeDelta::FromMilliseconds(40), 0, true);
+  EXPECT_EQ(2, stats.TakeInterval().callbacks);
+
+  // Jitter is still measured against the last callback of the previous
+  // interval.
+  now += base::TimeDelta::FromMilliseconds(11);
+  stats.OnCallback(now, base::TimeDelta::FromMilliseconds(5), 0, true);
+
+  const OutputStreamStats::Interval interval = stats.TakeInterval();
+  EXPECT_EQ(1, interval.callbacks);
+  EXPECT_EQ(0, interval.missed_deadlines);
+  EXPECT_EQ(0, interval.skipped_frames);
+  EXPECT_EQ(base::TimeDelta::FromMilliseconds(1), interval.max_jitter);
+  EXPECT_EQ(base::TimeDelta::FromMilliseconds(5), interval.average_delay);
+  EXPECT_EQ(base::TimeDelta::FromMilliseconds(5), interval.max_delay);
+}
+
+}  // namespace audio
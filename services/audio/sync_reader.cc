@@ -178,7 +178,7 @@ void SyncReader::RequestMoreData(base::TimeDelta delay,
   ++buffer_index_;
 }
 
-void SyncReader::Read(media::AudioBus* dest) {
+bool SyncReader::Read(media::AudioBus* dest) {
   ++renderer_callback_count_;
   if (!WaitUntilDataIsReady()) {
     ++trailing_renderer_missed_callback_count_;
@@ -191,7 +191,7 @@ void SyncReader::Read(media::AudioBus* dest) {
         LOG(WARNING) << "(log cap reached, suppressing further logs)";
     }
     dest->Zero();
-    return;
+    return false;
   }
 
   trailing_renderer_missed_callback_count_ = 0;
@@ -200,7 +200,7 @@ void SyncReader::Read(media::AudioBus* dest) {
   // bitstream.
   if (mute_audio_for_testing_ && !output_bus_->is_bitstream_format()) {
     dest->Zero();
-    return;
+    return true;
   }
 
   if (output_bus_->is_bitstream_format()) {
@@ -214,12 +214,13 @@ void SyncReader::Read(media::AudioBus* dest) {
         !base::IsValueInRangeForNumericType<int>(bitstream_frames)) {
       // Received data doesn't fit in the buffer, shouldn't happen.
       dest->Zero();
-      return;
+      return true;
     }
     output_bus_->SetBitstreamDataSize(data_size);
     output_bus_->SetBitstreamFrames(bitstream_frames);
   }
   output_bus_->CopyTo(dest);
+  return true;
 }
 
 void SyncReader::Close() {
@@ -54,7 +54,7 @@ class SyncReader : public OutputController::SyncReader {
   void RequestMoreData(base::TimeDelta delay,
                        base::TimeTicks delay_timestamp,
                        int prior_frames_skipped) override;
-  void Read(media::AudioBus* dest) override;
+  bool Read(media::AudioBus* dest) override;
   void Close() override;
 
  private:
@@ -6,9 +6,13 @@
 
 #include <string.h>
 
+#include <memory>
 #include <utility>
+#include <vector>
 
+#include "base/bind.h"
 #include "base/logging.h"
+#include "base/task/post_task.h"
 #include "mojo/public/cpp/bindings/strong_binding.h"
 #include "skia/ext/image_operations.h"
 #include "third_party/blink/public/platform/web_data.h"
@@ -56,25 +60,11 @@ void ResizeImage(SkBitmap* decoded_image,
   }
 }
 
-}  // namespace
-
-ImageDecoderImpl::ImageDecoderImpl(
-    std::unique_ptr<service_manager::ServiceContextRef> service_ref)
-    : service_ref_(std::move(service_ref)) {}
-
-ImageDecoderImpl::~ImageDecoderImpl() = default;
-
-void ImageDecoderImpl::DecodeImage(const std::vector<uint8_t>& encoded_data,
-                                   mojom::ImageCodec codec,
-                                   bool shrink_to_fit,
-                                   int64_t max_size_in_bytes,
-                                   const gfx::Size& desired_image_frame_size,
-                                   DecodeImageCallback callback) {
-  if (encoded_data.size() == 0) {
-    std::move(callback).Run(SkBitmap());
-    return;
-  }
-
+SkBitmap DecodeImageOnThreadPool(const std::vector<uint8_t>& encoded_data,
+                                  mojom::ImageCodec codec,
+                                  bool shrink_to_fit,
+                                  int64_t max_size_in_bytes,
+                                  const gfx::Size& desired_image_frame_size) {
   SkBitmap decoded_image;
 #if defined(OS_CHROMEOS)
   if (codec == mojom::ImageCodec::ROBUST_JPEG) {
@@ -106,18 +96,13 @@ void ImageDecoderImpl::DecodeImage(const std::vector<uint8_t>& encoded_data,
   if (!decoded_image.isNull())
     ResizeImage(&decoded_image, shrink_to_fit, max_size_in_bytes);
 
-  std::move(callback).Run(decoded_image);
+  return decoded_image;
 }
 
-void ImageDecoderImpl::DecodeAnimation(const std::vector<uint8_t>& encoded_data,
-                                       bool shrink_to_fit,
-                                       int64_t max_size_in_bytes,
-                                       DecodeAnimationCallback callback) {
-  if (encoded_data.size() == 0) {
-    std::move(callback).Run(std::vector<mojom::AnimationFramePtr>());
-    return;
-  }
-
+std::vector<mojom::AnimationFramePtr> DecodeAnimationOnThreadPool(
+    const std::vector<uint8_t>& encoded_data,
+    bool shrink_to_fit,
+    int64_t max_size_in_bytes) {
   auto frames = blink::WebImage::AnimationFromData(blink::WebData(
       reinterpret_cast<const char*>(encoded_data.data()), encoded_data.size()));
 
@@ -140,7 +125,75 @@ void ImageDecoderImpl::DecodeAnimation(const std::vector<uint8_t>& encoded_data,
     decoded_images.push_back(std::move(image_frame));
   }
 
-  std::move(callback).Run(std::move(decoded_images));
+  return decoded_images;
+}
+
+// Replies with the decoded image. |service_ref| keeps the service alive while
+// the decode is in progress.
+template <typename Callback, typename Result>
+void ReplyWithDecodedImage(
+    std::unique_ptr<service_manager::ServiceContextRef> service_ref,
+    Callback callback,
+    Result result) {
+  std::move(callback).Run(std::move(result));
+}
+
+// Images are decoded on the thread pool, so that concurrent requests decode in
+// parallel rather than one after the other on the service's thread.
+constexpr base::TaskTraits kDecodeTaskTraits = {
+    base::TaskPriority::USER_VISIBLE,
+    base::TaskShutdownBehavior::SKIP_ON_SHUTDOWN};
+
+}  // namespace
+
+ImageDecoderImpl::ImageDecoderImpl(
+    std::unique_ptr<service_manager::ServiceContextRef> service_ref)
+    : service_ref_(std::move(service_ref)) {}
+
+ImageDecoderImpl::~ImageDecoderImpl() = default;
+
+void ImageDecoderImpl::DecodeImage(const std::vector<uint8_t>& encoded_data,
+                                   mojom::ImageCodec codec,
+                                   bool shrink_to_fit,
+                                   int64_t max_size_in_bytes,
+                                   const gfx::Size& desired_image_frame_size,
+                                   DecodeImageCallback callback) {
+  if (encoded_data.size() == 0) {
+    std::move(callback).Run(SkBitmap());
+    return;
+  }
+
+  base::PostTaskWithTraitsAndReplyWithResult(
+      FROM_HERE, kDecodeTaskTraits,
+      base::BindOnce(&DecodeImageOnThreadPool, encoded_data, codec,
+                     shrink_to_fit, max_size_in_bytes,
+                     desired_image_frame_size),
+      base::BindOnce(&ReplyWithDecodedImage<DecodeImageCallback, SkBitmap>,
+                     CloneServiceRef(), std::move(callback)));
+}
+
+void ImageDecoderImpl::DecodeAnimation(const std::vector<uint8_t>& encoded_data,
+                                       bool shrink_to_fit,
+                                       int64_t max_size_in_bytes,
+                                       DecodeAnimationCallback callback) {
+  if (encoded_data.size() == 0) {
+    std::move(callback).Run(std::vector<mojom::AnimationFramePtr>());
+    return;
+  }
+
+  base::PostTaskWithTraitsAndReplyWithResult(
+      FROM_HERE, kDecodeTaskTraits,
+      base::BindOnce(&DecodeAnimationOnThreadPool, encoded_data, shrink_to_fit,
+                     max_size_in_bytes),
+      base::BindOnce(
+          &ReplyWithDecodedImage<DecodeAnimationCallback,
+                                 std::vector<mojom::AnimationFramePtr>>,
+          CloneServiceRef(), std::move(callback)));
+}
+
+std::unique_ptr<service_manager::ServiceContextRef>
+ImageDecoderImpl::CloneServiceRef() {
+  return service_ref_ ? service_ref_->Clone() : nullptr;
 }
 
 }  // namespace data_decoder
@@ -33,6 +33,10 @@ class ImageDecoderImpl : public mojom::ImageDecoder {
                        DecodeAnimationCallback callback) override;
 
  private:
+  // Returns a ref that keeps the service alive until a decode completes, or
+  // null in tests.
+  std::unique_ptr<service_manager::ServiceContextRef> CloneServiceRef();
+
   const std::unique_ptr<service_manager::ServiceContextRef> service_ref_;
 
   DISALLOW_COPY_AND_ASSIGN(ImageDecoderImpl);
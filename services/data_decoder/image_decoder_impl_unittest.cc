@@ -5,10 +5,12 @@
 #include <memory>
 #include <vector>
 
+#include "base/barrier_closure.h"
 #include "base/bind.h"
 #include "base/lazy_instance.h"
-#include "base/message_loop/message_loop.h"
+#include "base/run_loop.h"
 #include "base/stl_util.h"
+#include "base/test/scoped_task_environment.h"
 #include "gin/array_buffer.h"
 #include "gin/public/isolate_holder.h"
 #include "services/data_decoder/image_decoder_impl.h"
@@ -58,17 +60,31 @@ class Request {
  public:
   explicit Request(ImageDecoderImpl* decoder) : decoder_(decoder) {}
 
-  void DecodeImage(const std::vector<unsigned char>& image, bool shrink) {
+  // Starts decoding |image|. The request is done once |done_closure| runs.
+  void StartDecodeImage(const std::vector<unsigned char>& image,
+                        bool shrink,
+                        base::OnceClosure done_closure) {
     decoder_->DecodeImage(
         image, mojom::ImageCodec::DEFAULT, shrink, kTestMaxImageSize,
         gfx::Size(),  // Take the smallest frame (there's only one frame).
-        base::Bind(&Request::OnRequestDone, base::Unretained(this)));
+        base::BindOnce(&Request::OnRequestDone, base::Unretained(this),
+                       std::move(done_closure)));
+  }
+
+  void DecodeImage(const std::vector<unsigned char>& image, bool shrink) {
+    base::RunLoop run_loop;
+    StartDecodeImage(image, shrink, run_loop.QuitClosure());
+    run_loop.Run();
   }
 
   const SkBitmap& bitmap() const { return bitmap_; }
 
  private:
-  void OnRequestDone(const SkBitmap& result_image) { bitmap_ = result_image; }
+  void OnRequestDone(base::OnceClosure done_closure,
+                     const SkBitmap& result_image) {
+    bitmap_ = result_image;
+    std::move(done_closure).Run();
+  }
 
   ImageDecoderImpl* decoder_;
   SkBitmap bitmap_;
@@ -108,7 +124,7 @@ class ImageDecoderImplTest : public testing::Test {
   ImageDecoderImpl* decoder() { return &decoder_; }
 
  private:
-  base::MessageLoop message_loop_;
+  base::test::ScopedTaskEnvironment scoped_task_environment_;
   ImageDecoderImpl decoder_;
 };
 
@@ -164,4 +180,26 @@ TEST_F(ImageDecoderImplTest, DecodeImageFailed) {
   EXPECT_TRUE(request.bitmap().isNull());
 }
 
+// Test that a burst of requests is decoded concurrently, and that each request
+// gets its own image back.
+TEST_F(ImageDecoderImplTest, DecodeImageBurst) {
+  constexpr int kRequestCount = 16;
+  std::vector<std::unique_ptr<Request>> requests;
+  base::RunLoop run_loop;
+  base::RepeatingClosure done_closure =
+      base::BarrierClosure(kRequestCount, run_loop.QuitClosure());
+  for (int i = 0; i < kRequestCount; ++i) {
+    std::vector<unsigned char> jpg;
+    ASSERT_TRUE(CreateJPEGImage(10 + i, 10, SK_ColorRED, &jpg));
+    requests.push_back(std::make_unique<Request>(decoder()));
+    requests.back()->StartDecodeImage(jpg, false, done_closure);
+  }
+  run_loop.Run();
+
+  for (int i = 0; i < kRequestCount; ++i) {
+    ASSERT_FALSE(requests[i]->bitmap().isNull());
+    EXPECT_EQ(10 + i, requests[i]->bitmap().width());
+  }
+}
+
 }  // namespace data_decoder
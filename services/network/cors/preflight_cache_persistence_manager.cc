@@ -0,0 +1,131 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "services/network/cors/preflight_cache_persistence_manager.h"
+
+#include <memory>
+
+#include "base/bind.h"
+#include "base/values.h"
+#include "components/prefs/pref_registry_simple.h"
+#include "components/prefs/pref_service.h"
+#include "net/log/net_log.h"
+#include "services/network/cors/preflight_controller.h"
+
+namespace network {
+
+namespace cors {
+
+namespace {
+
+const char kPreflightCachePref[] = "net.cors_preflight_cache";
+
+std::unique_ptr<base::Value> NetLogPrefWriteCallback(
+    size_t hits,
+    size_t misses,
+    net::NetLogCaptureMode /* capture_mode */) {
+  auto dict = std::make_unique<base::DictionaryValue>();
+  dict->SetInteger("hits", static_cast<int>(hits));
+  dict->SetInteger("misses", static_cast<int>(misses));
+  return std::move(dict);
+}
+
+}  // namespace
+
+constexpr base::TimeDelta PreflightCachePersistenceManager::kWriteDelay;
+
+PreflightCachePersistenceManager::PreflightCachePersistenceManager(
+    PreflightController* controller,
+    PrefService* pref_service,
+    net::NetLog* net_log)
+    : controller_(controller),
+      pref_service_(pref_service),
+      net_log_(net::NetLogWithSource::Make(
+          net_log,
+          net::NetLogSourceType::CORS_PREFLIGHT_CACHE_PERSISTENCE_MANAGER)),
+      weak_factory_(this) {
+  DCHECK(controller_);
+  DCHECK(pref_service_);
+
+  // Get the initial value of the pref if it's already initialized.
+  if (pref_service_->HasPrefPath(kPreflightCachePref))
+    ReadFromDisk();
+
+  registrar_.Init(pref_service_);
+  registrar_.Add(kPreflightCachePref,
+                 base::Bind(&PreflightCachePersistenceManager::ReadFromDisk,
+                            weak_factory_.GetWeakPtr()));
+  controller_->set_cache_updated_callback(
+      base::BindRepeating(&PreflightCachePersistenceManager::ScheduleWrite,
+                          weak_factory_.GetWeakPtr()));
+}
+
+PreflightCachePersistenceManager::~PreflightCachePersistenceManager() {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+
+  // Don't lose the entries added since the last write.
+  if (timer_.IsRunning()) {
+    timer_.Stop();
+    WriteToDisk();
+  }
+  registrar_.RemoveAll();
+  controller_->set_cache_updated_callback(base::RepeatingClosure());
+}
+
+// static
+void PreflightCachePersistenceManager::RegisterPrefs(
+    PrefRegistrySimple* registry) {
+  registry->RegisterDictionaryPref(kPreflightCachePref);
+}
+
+void PreflightCachePersistenceManager::Clear() {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+
+  timer_.Stop();
+  controller_->cache()->Clear();
+  writing_pref_ = true;
+  pref_service_->ClearPref(kPreflightCachePref);
+  writing_pref_ = false;
+}
+
+void PreflightCachePersistenceManager::ReadFromDisk() {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+
+  if (writing_pref_)
+    return;
+
+  net_log_.BeginEvent(net::NetLogEventType::CORS_PREFLIGHT_CACHE_PREF_READ);
+  size_t restored = controller_->cache()->RestoreFromValue(
+      *pref_service_->GetDictionary(kPreflightCachePref));
+  net_log_.EndEvent(
+      net::NetLogEventType::CORS_PREFLIGHT_CACHE_PREF_READ,
+      net::NetLog::IntCallback("restored_entries", static_cast<int>(restored)));
+}
+
+void PreflightCachePersistenceManager::ScheduleWrite() {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+
+  if (timer_.IsRunning())
+    return;
+
+  timer_.Start(FROM_HERE, kWriteDelay,
+               base::BindOnce(&PreflightCachePersistenceManager::WriteToDisk,
+                              weak_factory_.GetWeakPtr()));
+}
+
+void PreflightCachePersistenceManager::WriteToDisk() {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+
+  PreflightCache* cache = controller_->cache();
+  net_log_.AddEvent(net::NetLogEventType::CORS_PREFLIGHT_CACHE_PREF_WRITE,
+                    base::Bind(&NetLogPrefWriteCallback, cache->hit_count(),
+                               cache->miss_count()));
+  writing_pref_ = true;
+  pref_service_->Set(kPreflightCachePref, cache->ToValue());
+  writing_pref_ = false;
+}
+
+}  // namespace cors
+
+}  // namespace network
@@ -0,0 +1,81 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef SERVICES_NETWORK_CORS_PREFLIGHT_CACHE_PERSISTENCE_MANAGER_H_
+#define SERVICES_NETWORK_CORS_PREFLIGHT_CACHE_PERSISTENCE_MANAGER_H_
+
+#include "base/component_export.h"
+#include "base/macros.h"
+#include "base/memory/weak_ptr.h"
+#include "base/sequence_checker.h"
+#include "base/time/time.h"
+#include "base/timer/timer.h"
+#include "components/prefs/pref_change_registrar.h"
+#include "net/log/net_log_with_source.h"
+
+class PrefRegistrySimple;
+class PrefService;
+
+namespace net {
+class NetLog;
+}  // namespace net
+
+namespace network {
+
+namespace cors {
+
+class PreflightController;
+
+// Persists the CORS-preflight cache of a PreflightController in prefs, so that
+// cached results that haven't expired survive restarts. When the cache gets a
+// new entry, starts a timer, or ignores it if the timer is already running.
+// When that timer expires, writes the cache contents to prefs.
+//
+// Must be created after and destroyed before the PreflightController and the
+// PrefService.
+class COMPONENT_EXPORT(NETWORK_SERVICE) PreflightCachePersistenceManager {
+ public:
+  // The maximum time between a change in the cache and writing it to prefs.
+  static constexpr base::TimeDelta kWriteDelay =
+      base::TimeDelta::FromSeconds(10);
+
+  PreflightCachePersistenceManager(PreflightController* controller,
+                                   PrefService* pref_service,
+                                   net::NetLog* net_log);
+  ~PreflightCachePersistenceManager();
+
+  // Registers the pref holding the persisted cache.
+  static void RegisterPrefs(PrefRegistrySimple* registry);
+
+  // Clears the cache and the persisted cache.
+  void Clear();
+
+ private:
+  // Starts the timer that writes the cache to prefs.
+  void ScheduleWrite();
+  // Serializes the cache and writes it to prefs.
+  void WriteToDisk();
+  // Restores the persisted entries into the cache.
+  void ReadFromDisk();
+
+  PreflightController* const controller_;
+  PrefService* const pref_service_;
+  PrefChangeRegistrar registrar_;
+  bool writing_pref_ = false;
+
+  base::OneShotTimer timer_;
+
+  const net::NetLogWithSource net_log_;
+
+  SEQUENCE_CHECKER(sequence_checker_);
+  base::WeakPtrFactory<PreflightCachePersistenceManager> weak_factory_;
+
+  DISALLOW_COPY_AND_ASSIGN(PreflightCachePersistenceManager);
+};
+
+}  // namespace cors
+
+}  // namespace network
+
+#endif  // SERVICES_NETWORK_CORS_PREFLIGHT_CACHE_PERSISTENCE_MANAGER_H_
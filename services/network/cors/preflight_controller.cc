@@ -8,10 +8,12 @@
 #include <vector>
 
 #include "base/bind.h"
+#include "base/feature_list.h"
 #include "base/no_destructor.h"
 #include "base/strings/string_util.h"
 #include "base/strings/stringprintf.h"
 #include "base/time/time.h"
+#include "net/base/features.h"
 #include "net/base/load_flags.h"
 #include "net/http/http_request_headers.h"
 #include "services/network/public/cpp/cors/cors.h"
@@ -32,6 +34,22 @@ int RetrieveCacheFlags(int load_flags) {
                        net::LOAD_DISABLE_CACHE);
 }
 
+// Returns the key of the CORS-preflight cache entries for |request|. Like the
+// HTTP cache, entries are partitioned by the top frame origin when
+// kSplitCacheByTopFrameOrigin is enabled.
+std::string GetCacheOriginKey(const ResourceRequest& request) {
+  DCHECK(request.request_initiator);
+  std::string origin = request.request_initiator->Serialize();
+  if (request.top_frame_origin &&
+      base::FeatureList::IsEnabled(
+          net::features::kSplitCacheByTopFrameOrigin)) {
+    // The whitespace can't appear in a serialized origin, so partitioned keys
+    // don't collide with unpartitioned ones.
+    return request.top_frame_origin->Serialize() + " " + origin;
+  }
+  return origin;
+}
+
 base::Optional<std::string> GetHeaderString(
     const scoped_refptr<net::HttpResponseHeaders>& headers,
     const std::string& header_name) {
@@ -253,7 +271,7 @@ class PreflightController::PreflightLoader final {
 
     if (!(original_request_.load_flags & net::LOAD_DISABLE_CACHE) &&
         !detected_error_status) {
-      controller_->AppendToCache(*original_request_.request_initiator,
+      controller_->AppendToCache(GetCacheOriginKey(original_request_),
                                  original_request_.url, std::move(result));
     }
 
@@ -341,7 +359,7 @@ void PreflightController::PerformPreflightCheck(
 
   if (!RetrieveCacheFlags(request.load_flags) && !request.is_external_request &&
       cache_.CheckIfRequestCanSkipPreflight(
-          request.request_initiator->Serialize(), request.url,
+          GetCacheOriginKey(request), request.url,
           request.fetch_credentials_mode, request.method, request.headers,
           request.is_revalidating)) {
     std::move(callback).Run(net::OK, base::nullopt, base::nullopt);
@@ -360,10 +378,12 @@ void PreflightController::RemoveLoader(PreflightLoader* loader) {
 }
 
 void PreflightController::AppendToCache(
-    const url::Origin& origin,
+    const std::string& origin,
     const GURL& url,
     std::unique_ptr<PreflightResult> result) {
-  cache_.AppendEntry(origin.Serialize(), url, std::move(result));
+  cache_.AppendEntry(origin, url, std::move(result));
+  if (cache_updated_callback_)
+    cache_updated_callback_.Run();
 }
 
 }  // namespace cors
@@ -7,6 +7,7 @@
 
 #include <memory>
 #include <string>
+#include <utility>
 
 #include "base/callback.h"
 #include "base/component_export.h"
@@ -64,15 +65,23 @@ class COMPONENT_EXPORT(NETWORK_SERVICE) PreflightController final {
       const net::NetworkTrafficAnnotationTag& traffic_annotation,
       mojom::URLLoaderFactory* loader_factory);
 
+  PreflightCache* cache() { return &cache_; }
+
+  // Sets a callback that is run whenever an entry is added to the cache.
+  void set_cache_updated_callback(base::RepeatingClosure callback) {
+    cache_updated_callback_ = std::move(callback);
+  }
+
  private:
   class PreflightLoader;
 
   void RemoveLoader(PreflightLoader* loader);
-  void AppendToCache(const url::Origin& origin,
+  void AppendToCache(const std::string& origin,
                      const GURL& url,
                      std::unique_ptr<PreflightResult> result);
 
   PreflightCache cache_;
+  base::RepeatingClosure cache_updated_callback_;
   std::set<std::unique_ptr<PreflightLoader>, base::UniquePtrComparator>
       loaders_;
 
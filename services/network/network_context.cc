@@ -792,6 +792,8 @@ void NetworkContext::ClearNetworkingHistorySince(
   // May not be set in all tests.
   if (network_qualities_pref_delegate_)
     network_qualities_pref_delegate_->ClearPrefs();
+  if (cors_preflight_cache_persistence_manager_)
+    cors_preflight_cache_persistence_manager_->Clear();
 
   url_request_context_->http_server_properties()->Clear(barrier);
 }
@@ -1852,6 +1854,7 @@ URLRequestContextOwner NetworkContext::ApplyContextParamsToBuilder(
     scoped_refptr<PrefRegistrySimple> pref_registry(new PrefRegistrySimple());
     HttpServerPropertiesPrefDelegate::RegisterPrefs(pref_registry.get());
     NetworkQualitiesPrefDelegate::RegisterPrefs(pref_registry.get());
+    cors::PreflightCachePersistenceManager::RegisterPrefs(pref_registry.get());
     pref_service = pref_service_factory.Create(pref_registry.get());
 
     builder->SetHttpServerProperties(
@@ -1863,6 +1866,10 @@ URLRequestContextOwner NetworkContext::ApplyContextParamsToBuilder(
     network_qualities_pref_delegate_ =
         std::make_unique<NetworkQualitiesPrefDelegate>(
             pref_service.get(), network_service_->network_quality_estimator());
+
+    cors_preflight_cache_persistence_manager_ =
+        std::make_unique<cors::PreflightCachePersistenceManager>(
+            &cors_preflight_controller_, pref_service.get(), net_log);
   }
 
   if (params_->transport_security_persister_path) {
@@ -4,12 +4,18 @@
 
 #include "services/network/public/cpp/cors/preflight_cache.h"
 
+#include <utility>
+
+#include "base/stl_util.h"
+#include "base/values.h"
 #include "url/gurl.h"
 
 namespace network {
 
 namespace cors {
 
+constexpr size_t PreflightCache::kMaxEntries;
+
 PreflightCache::PreflightCache() = default;
 PreflightCache::~PreflightCache() = default;
 
@@ -18,6 +24,11 @@ void PreflightCache::AppendEntry(
     const GURL& url,
     std::unique_ptr<PreflightResult> preflight_result) {
   DCHECK(preflight_result);
+  auto cache_per_origin = cache_.find(origin);
+  if (cache_per_origin == cache_.end() ||
+      !base::ContainsKey(cache_per_origin->second, url.spec())) {
+    EvictEntriesIfNeeded();
+  }
   cache_[origin][url.spec()] = std::move(preflight_result);
 }
 
@@ -30,19 +41,25 @@ bool PreflightCache::CheckIfRequestCanSkipPreflight(
     bool is_revalidating) {
   // Either |origin| or |url| are not in cache.
   auto cache_per_origin = cache_.find(origin);
-  if (cache_per_origin == cache_.end())
+  if (cache_per_origin == cache_.end()) {
+    ++miss_count_;
     return false;
+  }
 
   auto cache_entry = cache_per_origin->second.find(url.spec());
-  if (cache_entry == cache_per_origin->second.end())
+  if (cache_entry == cache_per_origin->second.end()) {
+    ++miss_count_;
     return false;
+  }
 
   // Both |origin| and |url| are in cache. Check if the entry is still valid and
   // sufficient to skip CORS-preflight.
   if (cache_entry->second->EnsureAllowedRequest(
           credentials_mode, method, request_headers, is_revalidating)) {
+    ++hit_count_;
     return true;
   }
+  ++miss_count_;
 
   // The cache entry is either stale or not sufficient. Remove the item from the
   // cache.
@@ -53,11 +70,98 @@ bool PreflightCache::CheckIfRequestCanSkipPreflight(
   return false;
 }
 
+void PreflightCache::Clear() {
+  cache_.clear();
+}
+
+base::Value PreflightCache::ToValue() const {
+  base::Value value(base::Value::Type::DICTIONARY);
+  for (const auto& cache_per_origin : cache_) {
+    base::Value entries(base::Value::Type::DICTIONARY);
+    for (const auto& entry : cache_per_origin.second) {
+      if (!entry.second->IsExpired())
+        entries.SetKey(entry.first, entry.second->ToValue());
+    }
+    if (!entries.DictEmpty())
+      value.SetKey(cache_per_origin.first, std::move(entries));
+  }
+  return value;
+}
+
+size_t PreflightCache::RestoreFromValue(const base::Value& value) {
+  if (!value.is_dict())
+    return 0;
+
+  size_t restored = 0;
+  for (const auto& origin_item : value.DictItems()) {
+    if (!origin_item.second.is_dict())
+      continue;
+    for (const auto& url_item : origin_item.second.DictItems()) {
+      GURL url(url_item.first);
+      if (!url.is_valid())
+        continue;
+      auto cache_per_origin = cache_.find(origin_item.first);
+      if (cache_per_origin != cache_.end() &&
+          base::ContainsKey(cache_per_origin->second, url.spec())) {
+        continue;
+      }
+      std::unique_ptr<PreflightResult> result =
+          PreflightResult::CreateFromValue(url_item.second);
+      if (!result)
+        continue;
+      AppendEntry(origin_item.first, url, std::move(result));
+      ++restored;
+    }
+  }
+  return restored;
+}
+
 size_t PreflightCache::CountOriginsForTesting() const {
   return cache_.size();
 }
 
 size_t PreflightCache::CountEntriesForTesting() const {
+  return CountEntries();
+}
+
+void PreflightCache::EvictEntriesIfNeeded() {
+  if (CountEntries() < kMaxEntries)
+    return;
+
+  // Drop the expired entries first. If none has expired, drop the entry that
+  // expires first.
+  auto oldest_origin = cache_.end();
+  std::map<std::string, std::unique_ptr<PreflightResult>>::iterator oldest;
+  for (auto cache_per_origin = cache_.begin();
+       cache_per_origin != cache_.end();) {
+    auto& entries = cache_per_origin->second;
+    for (auto entry = entries.begin(); entry != entries.end();) {
+      if (entry->second->IsExpired()) {
+        entry = entries.erase(entry);
+        continue;
+      }
+      if (oldest_origin == cache_.end() ||
+          entry->second->absolute_expiry_time() <
+              oldest->second->absolute_expiry_time()) {
+        oldest_origin = cache_per_origin;
+        oldest = entry;
+      }
+      ++entry;
+    }
+    if (entries.empty())
+      cache_per_origin = cache_.erase(cache_per_origin);
+    else
+      ++cache_per_origin;
+  }
+
+  if (CountEntries() < kMaxEntries || oldest_origin == cache_.end())
+    return;
+  oldest_origin->second.erase(oldest);
+  if (oldest_origin->second.empty())
+    cache_.erase(oldest_origin);
+}
+
+size_t PreflightCache::CountEntries() const {
   size_t entries = 0;
   for (auto const& cache_per_origin : cache_)
     entries += cache_per_origin.second.size();
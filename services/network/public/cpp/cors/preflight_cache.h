@@ -17,22 +17,30 @@
 
 class GURL;
 
+namespace base {
+class Value;
+}  // namespace base
+
 namespace network {
 
 namespace cors {
 
 // A class to implement CORS-preflight cache that is defined in the fetch spec,
 // https://fetch.spec.whatwg.org/#concept-cache.
-// TODO(toyoshim): Consider to replace the oldest entry with the new one when
-// we have too much cached entries. Also, we want to clear all cached entries
-// when users' network configuration is changed.
+// The cache holds at most kMaxEntries entries. When it is full, expired entries
+// and then the entries expiring first are replaced.
+// TODO(toyoshim): We want to clear all cached entries when users' network
+// configuration is changed.
 class COMPONENT_EXPORT(NETWORK_CPP) PreflightCache final {
  public:
+  static constexpr size_t kMaxEntries = 1024;
+
   PreflightCache();
   ~PreflightCache();
 
   // Appends new |preflight_result| entry to the cache for a specified |origin|
-  // and |url|.
+  // and |url|. |origin| may also carry a partition key, see
+  // PreflightController.
   void AppendEntry(const std::string& origin,
                    const GURL& url,
                    std::unique_ptr<PreflightResult> preflight_result);
@@ -47,6 +55,22 @@ class COMPONENT_EXPORT(NETWORK_CPP) PreflightCache final {
       const net::HttpRequestHeaders& headers,
       bool is_revalidating);
 
+  // Removes all entries.
+  void Clear();
+
+  // Serializes the entries that haven't expired, so that they can be restored
+  // with RestoreFromValue() after a restart.
+  base::Value ToValue() const;
+
+  // Appends the valid entries of |value|, which was returned by ToValue(),
+  // without replacing existing ones. Returns the number of appended entries.
+  size_t RestoreFromValue(const base::Value& value);
+
+  // The number of CheckIfRequestCanSkipPreflight() calls that could and
+  // couldn't skip the CORS-preflight.
+  size_t hit_count() const { return hit_count_; }
+  size_t miss_count() const { return miss_count_; }
+
   // Counts cached origins for testing.
   size_t CountOriginsForTesting() const;
 
@@ -54,12 +78,20 @@ class COMPONENT_EXPORT(NETWORK_CPP) PreflightCache final {
   size_t CountEntriesForTesting() const;
 
  private:
+  // Makes room for a new entry if the cache is full.
+  void EvictEntriesIfNeeded();
+
+  size_t CountEntries() const;
+
   // A map for caching. The outer map takes an origin to find a per-origin
   // cache map, and the inner map takes an URL to find a cached entry.
   std::map<std::string /* origin */,
            std::map<std::string /* url */, std::unique_ptr<PreflightResult>>>
       cache_;
 
+  size_t hit_count_ = 0;
+  size_t miss_count_ = 0;
+
   DISALLOW_COPY_AND_ASSIGN(PreflightCache);
 };
 
@@ -4,8 +4,10 @@
 
 #include "services/network/public/cpp/cors/preflight_cache.h"
 
+#include "base/strings/string_number_conversions.h"
 #include "base/test/simple_test_tick_clock.h"
 #include "base/time/time.h"
+#include "base/values.h"
 #include "net/http/http_request_headers.h"
 #include "testing/gtest/include/gtest/gtest.h"
 #include "url/gurl.h"
@@ -109,6 +111,59 @@ TEST_F(PreflightCacheTest, CacheTimeout) {
   EXPECT_EQ(0u, CountEntries());
 }
 
+TEST_F(PreflightCacheTest, MaxEntries) {
+  const std::string origin("null");
+  const GURL first_url("http://www.test.com/first");
+
+  AppendEntry(origin, first_url);
+  Advance(1);
+  for (size_t i = 1; i < PreflightCache::kMaxEntries; ++i)
+    AppendEntry(origin, GURL("http://www.test.com/" + base::NumberToString(i)));
+  EXPECT_EQ(PreflightCache::kMaxEntries, CountEntries());
+
+  // The entry that expires first is replaced.
+  AppendEntry(origin, GURL("http://www.test.com/last"));
+  EXPECT_EQ(PreflightCache::kMaxEntries, CountEntries());
+  EXPECT_FALSE(CheckEntryAndRefreshCache(origin, first_url));
+  EXPECT_TRUE(
+      CheckEntryAndRefreshCache(origin, GURL("http://www.test.com/last")));
+
+  // Expired entries are replaced before any other.
+  Advance(5);
+  AppendEntry(origin, first_url);
+  EXPECT_EQ(1u, CountEntries());
+}
+
+TEST_F(PreflightCacheTest, Persistence) {
+  const std::string origin("null");
+  const std::string other_origin("http://www.other.com:80");
+  const GURL url("http://www.test.com/A");
+
+  AppendEntry(origin, url);
+  AppendEntry(other_origin, url);
+  EXPECT_TRUE(CheckEntryAndRefreshCache(origin, url));
+  EXPECT_FALSE(
+      CheckEntryAndRefreshCache(origin, GURL("http://www.test.com/B")));
+  EXPECT_EQ(1u, cache()->hit_count());
+  EXPECT_EQ(1u, cache()->miss_count());
+
+  base::Value value = cache()->ToValue();
+  cache()->Clear();
+  EXPECT_EQ(0u, CountEntries());
+
+  EXPECT_EQ(2u, cache()->RestoreFromValue(value));
+  EXPECT_EQ(2u, CountOrigins());
+  EXPECT_TRUE(CheckEntryAndRefreshCache(origin, url));
+  EXPECT_TRUE(CheckEntryAndRefreshCache(other_origin, url));
+
+  // Existing entries aren't replaced.
+  EXPECT_EQ(0u, cache()->RestoreFromValue(value));
+
+  // Expired entries aren't persisted.
+  Advance(10);
+  EXPECT_TRUE(cache()->ToValue().DictEmpty());
+}
+
 }  // namespace
 
 }  // namespace cors
@@ -4,12 +4,15 @@
 
 #include "services/network/public/cpp/cors/preflight_result.h"
 
+#include <algorithm>
+
 #include "base/memory/ptr_util.h"
 #include "base/strings/string_number_conversions.h"
 #include "base/strings/string_split.h"
 #include "base/time/default_tick_clock.h"
 #include "base/time/tick_clock.h"
 #include "base/time/time.h"
+#include "base/values.h"
 #include "net/http/http_request_headers.h"
 #include "services/network/public/cpp/cors/cors.h"
 
@@ -38,6 +41,12 @@ constexpr base::TimeDelta kMaxTimeout = base::TimeDelta::FromSeconds(600);
 // Holds TickClock instance to overwrite TimeTicks::Now() for testing.
 const base::TickClock* tick_clock_for_testing = nullptr;
 
+// Keys of the values created by ToValue().
+const char kCredentialsKey[] = "credentials";
+const char kMethodsKey[] = "methods";
+const char kHeadersKey[] = "headers";
+const char kExpiryKey[] = "expiry";
+
 base::TimeTicks Now() {
   if (tick_clock_for_testing)
     return tick_clock_for_testing->NowTicks();
@@ -106,6 +115,53 @@ std::unique_ptr<PreflightResult> PreflightResult::Create(
   return result;
 }
 
+// static
+std::unique_ptr<PreflightResult> PreflightResult::CreateFromValue(
+    const base::Value& value) {
+  if (!value.is_dict())
+    return nullptr;
+  const base::Value* credentials =
+      value.FindKeyOfType(kCredentialsKey, base::Value::Type::BOOLEAN);
+  const base::Value* methods =
+      value.FindKeyOfType(kMethodsKey, base::Value::Type::LIST);
+  const base::Value* headers =
+      value.FindKeyOfType(kHeadersKey, base::Value::Type::LIST);
+  const base::Value* expiry =
+      value.FindKeyOfType(kExpiryKey, base::Value::Type::STRING);
+  int64_t expiry_us;
+  if (!credentials || !methods || !headers || !expiry ||
+      !base::StringToInt64(expiry->GetString(), &expiry_us)) {
+    return nullptr;
+  }
+
+  // Entries written with a clock that was ahead are capped as if they were
+  // just received.
+  base::TimeDelta expiry_delta =
+      base::Time::FromDeltaSinceWindowsEpoch(
+          base::TimeDelta::FromMicroseconds(expiry_us)) -
+      base::Time::Now();
+  if (expiry_delta <= base::TimeDelta())
+    return nullptr;
+  expiry_delta = std::min(expiry_delta, kMaxTimeout);
+
+  std::unique_ptr<PreflightResult> result = base::WrapUnique(
+      new PreflightResult(credentials->GetBool()
+                              ? mojom::FetchCredentialsMode::kInclude
+                              : mojom::FetchCredentialsMode::kOmit));
+  for (const base::Value& method : methods->GetList()) {
+    if (!method.is_string())
+      return nullptr;
+    result->methods_.insert(method.GetString());
+  }
+  for (const base::Value& header : headers->GetList()) {
+    if (!header.is_string())
+      return nullptr;
+    result->headers_.insert(base::ToLowerASCII(header.GetString()));
+  }
+  result->absolute_expiry_time_ = Now() + expiry_delta;
+  return result;
+}
+
 PreflightResult::PreflightResult(
     const mojom::FetchCredentialsMode credentials_mode)
     : credentials_(credentials_mode == mojom::FetchCredentialsMode::kInclude) {}
@@ -153,12 +209,16 @@ PreflightResult::EnsureAllowedCrossOriginHeaders(
   return base::nullopt;
 }
 
+bool PreflightResult::IsExpired() const {
+  return absolute_expiry_time_ <= Now();
+}
+
 bool PreflightResult::EnsureAllowedRequest(
     mojom::FetchCredentialsMode credentials_mode,
     const std::string& method,
     const net::HttpRequestHeaders& headers,
     bool is_revalidating) const {
-  if (absolute_expiry_time_ <= Now())
+  if (IsExpired())
     return false;
 
   if (!credentials_ &&
@@ -175,6 +235,25 @@ bool PreflightResult::EnsureAllowedRequest(
   return true;
 }
 
+base::Value PreflightResult::ToValue() const {
+  base::Value::ListStorage methods;
+  for (const std::string& method : methods_)
+    methods.emplace_back(method);
+  base::Value::ListStorage headers;
+  for (const std::string& header : headers_)
+    headers.emplace_back(header);
+  base::Time expiry = base::Time::Now() + (absolute_expiry_time_ - Now());
+
+  base::Value value(base::Value::Type::DICTIONARY);
+  value.SetKey(kCredentialsKey, base::Value(credentials_));
+  value.SetKey(kMethodsKey, base::Value(std::move(methods)));
+  value.SetKey(kHeadersKey, base::Value(std::move(headers)));
+  value.SetKey(kExpiryKey,
+               base::Value(base::NumberToString(
+                   expiry.ToDeltaSinceWindowsEpoch().InMicroseconds())));
+  return value;
+}
+
 base::Optional<mojom::CorsError> PreflightResult::Parse(
     const base::Optional<std::string>& allow_methods_header,
     const base::Optional<std::string>& allow_headers_header,
@@ -17,6 +17,7 @@
 
 namespace base {
 class TickClock;
+class Value;
 }  // namespace base
 
 namespace net {
@@ -43,6 +44,12 @@ class COMPONENT_EXPORT(NETWORK_CPP) PreflightResult final {
       const base::Optional<std::string>& allow_headers_header,
       const base::Optional<std::string>& max_age_header,
       base::Optional<mojom::CorsError>* detected_error);
+
+  // Creates a PreflightResult instance from a value returned by ToValue().
+  // Returns nullptr if |value| is malformed or the result has expired.
+  static std::unique_ptr<PreflightResult> CreateFromValue(
+      const base::Value& value);
+
   ~PreflightResult();
 
   // Checks if the given |method| is allowed by the CORS-preflight response.
@@ -71,6 +78,13 @@ class COMPONENT_EXPORT(NETWORK_CPP) PreflightResult final {
   // Refers the cache expiry time.
   base::TimeTicks absolute_expiry_time() const { return absolute_expiry_time_; }
 
+  // Returns true if the result can't be used anymore.
+  bool IsExpired() const;
+
+  // Serializes the result so that it can be persisted across restarts. The
+  // expiry time is stored as a wall clock time.
+  base::Value ToValue() const;
+
  protected:
   explicit PreflightResult(const mojom::FetchCredentialsMode credentials_mode);
 
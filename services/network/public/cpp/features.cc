@@ -52,6 +52,12 @@ const base::Feature kThrottleDelayable{"ThrottleDelayable",
 const base::Feature kDelayRequestsOnMultiplexedConnections{
     "DelayRequestsOnMultiplexedConnections", base::FEATURE_ENABLED_BY_DEFAULT};
 
+// When enabled, the maximum number of delayable requests in flight is sized
+// to the bandwidth-delay product estimated by the NetworkQualityEstimator,
+// instead of being picked by effective connection type.
+const base::Feature kAdaptiveDelayableRequests{
+    "AdaptiveDelayableRequests", base::FEATURE_DISABLED_BY_DEFAULT};
+
 // Kill switch for enforcing
 // URLLoaderFactoryParams::request_initiator_origin_lock for Cross-Origin Read
 // Blocking.  When enabled, then CORB treats |request_initiator| as opaque
@@ -31,9 +31,12 @@ template <>
 struct COMPONENT_EXPORT(NETWORK_CPP_BASE)
     StructTraits<network::mojom::HttpRequestHeadersDataView,
                  net::HttpRequestHeaders> {
-  static net::HttpRequestHeaders::HeaderVector headers(
+  static std::vector<net::HttpRequestHeaders::HeaderKeyValuePair> headers(
       const net::HttpRequestHeaders& data) {
-    return data.GetHeaderVector();
+    // HeaderVector has a custom allocator, which mojo doesn't support.
+    const net::HttpRequestHeaders::HeaderVector& headers =
+        data.GetHeaderVector();
+    return {headers.begin(), headers.end()};
   }
   static bool Read(network::mojom::HttpRequestHeadersDataView data,
                    net::HttpRequestHeaders* headers);
@@ -13,8 +13,10 @@ scoped_refptr<ResourceResponse> ResourceResponse::DeepCopy() const {
   new_response->head.request_time = head.request_time;
   new_response->head.response_time = head.response_time;
   if (head.headers.get()) {
+    // The copy is mostly forwarded as is, so only index its headers if they
+    // are looked up.
     new_response->head.headers =
-        new net::HttpResponseHeaders(head.headers->raw_headers());
+        net::HttpResponseHeaders::CreateLazily(head.headers->raw_headers());
   }
   new_response->head.mime_type = head.mime_type;
   new_response->head.charset = head.charset;
@@ -31,6 +31,7 @@
 #include "net/log/net_log.h"
 #include "net/nqe/effective_connection_type_observer.h"
 #include "net/nqe/network_quality_estimator.h"
+#include "net/nqe/rtt_throughput_estimates_observer.h"
 #include "net/url_request/url_request.h"
 #include "net/url_request/url_request_context.h"
 #include "services/network/public/cpp/features.h"
@@ -60,6 +61,7 @@ enum class RequestStartTrigger {
   SPDY_PROXY_DETECTED,
   REQUEST_REPRIORITIZED,
   LONG_QUEUED_REQUESTS_TIMER_FIRED,
+  NETWORK_QUALITY_CHANGED,
 };
 
 const char* RequestStartTriggerString(RequestStartTrigger trigger) {
@@ -80,6 +82,8 @@ const char* RequestStartTriggerString(RequestStartTrigger trigger) {
       return "REQUEST_REPRIORITIZED";
     case RequestStartTrigger::LONG_QUEUED_REQUESTS_TIMER_FIRED:
       return "LONG_QUEUED_REQUESTS_TIMER_FIRED";
+    case RequestStartTrigger::NETWORK_QUALITY_CHANGED:
+      return "NETWORK_QUALITY_CHANGED";
   }
 }
 
@@ -360,7 +364,9 @@ void ResourceScheduler::RequestQueue::Insert(
 }
 
 // Each client represents a tab.
-class ResourceScheduler::Client : public net::EffectiveConnectionTypeObserver {
+class ResourceScheduler::Client
+    : public net::EffectiveConnectionTypeObserver,
+      public net::RTTAndThroughputEstimatesObserver {
  public:
   Client(net::NetworkQualityEstimator* network_quality_estimator,
          ResourceScheduler* resource_scheduler,
@@ -371,17 +377,25 @@ class ResourceScheduler::Client : public net::EffectiveConnectionTypeObserver {
         network_quality_estimator_(network_quality_estimator),
         resource_scheduler_(resource_scheduler),
         tick_clock_(tick_clock),
+        observes_rtt_and_throughput_(
+            network_quality_estimator_ &&
+            base::FeatureList::IsEnabled(
+                features::kAdaptiveDelayableRequests)),
         weak_ptr_factory_(this) {
     DCHECK(tick_clock_);
 
     UpdateParamsForNetworkQuality();
     if (network_quality_estimator_)
       network_quality_estimator_->AddEffectiveConnectionTypeObserver(this);
+    if (observes_rtt_and_throughput_)
+      network_quality_estimator_->AddRTTAndThroughputEstimatesObserver(this);
   }
 
   ~Client() override {
     if (network_quality_estimator_)
       network_quality_estimator_->RemoveEffectiveConnectionTypeObserver(this);
+    if (observes_rtt_and_throughput_)
+      network_quality_estimator_->RemoveRTTAndThroughputEstimatesObserver(this);
   }
 
   void ScheduleRequest(const net::URLRequest& url_request,
@@ -462,12 +476,24 @@ class ResourceScheduler::Client : public net::EffectiveConnectionTypeObserver {
 
   // Updates the params based on the current network quality estimate.
   void UpdateParamsForNetworkQuality() {
+    const ResourceSchedulerParamsManager& params_manager =
+        resource_scheduler_->resource_scheduler_params_manager_;
     params_for_network_quality_ =
-        resource_scheduler_->resource_scheduler_params_manager_
-            .GetParamsForEffectiveConnectionType(
-                network_quality_estimator_
-                    ? network_quality_estimator_->GetEffectiveConnectionType()
-                    : net::EFFECTIVE_CONNECTION_TYPE_UNKNOWN);
+        params_manager.GetParamsForEffectiveConnectionType(
+            network_quality_estimator_
+                ? network_quality_estimator_->GetEffectiveConnectionType()
+                : net::EFFECTIVE_CONNECTION_TYPE_UNKNOWN);
+    if (!observes_rtt_and_throughput_)
+      return;
+
+    base::Optional<size_t> max_delayable_requests =
+        params_manager.GetMaxDelayableRequestsForNetworkQuality(
+            network_quality_estimator_->GetHttpRTT(),
+            network_quality_estimator_->GetDownstreamThroughputKbps());
+    if (max_delayable_requests) {
+      params_for_network_quality_.max_delayable_requests =
+          max_delayable_requests.value();
+    }
   }
 
   void OnLongQueuedRequestsDispatchTimerFired() {
@@ -490,6 +516,22 @@ class ResourceScheduler::Client : public net::EffectiveConnectionTypeObserver {
     UpdateParamsForNetworkQuality();
   }
 
+  // net::RTTAndThroughputEstimatesObserver implementation:
+  void OnRTTOrThroughputEstimatesComputed(
+      base::TimeDelta http_rtt,
+      base::TimeDelta transport_rtt,
+      int32_t downstream_throughput_kbps) override {
+    size_t old_max_delayable_requests =
+        params_for_network_quality_.max_delayable_requests;
+    UpdateParamsForNetworkQuality();
+    // Requests held back by the old limit may be startable now.
+    if (params_for_network_quality_.max_delayable_requests >
+        old_max_delayable_requests) {
+      ScheduleLoadAnyStartablePendingRequests(
+          RequestStartTrigger::NETWORK_QUALITY_CHANGED);
+    }
+  }
+
   // Records the metrics related to number of requests in flight.
   void RecordRequestCountMetrics() const {
     UMA_HISTOGRAM_COUNTS_100("ResourceScheduler.RequestsCount.All",
@@ -1020,6 +1062,10 @@ class ResourceScheduler::Client : public net::EffectiveConnectionTypeObserver {
   // Time when the last non-delayble request ended in this client.
   base::Optional<base::TimeTicks> last_non_delayable_request_end_;
 
+  // True if |max_delayable_requests| of |params_for_network_quality_| follows
+  // the RTT and throughput estimates of |network_quality_estimator_|.
+  const bool observes_rtt_and_throughput_;
+
   base::WeakPtrFactory<ResourceScheduler::Client> weak_ptr_factory_;
 };
 
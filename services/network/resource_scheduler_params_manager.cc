@@ -4,6 +4,8 @@
 
 #include "services/network/resource_scheduler_params_manager.h"
 
+#include <algorithm>
+
 #include "base/feature_list.h"
 #include "base/metrics/field_trial.h"
 #include "base/metrics/field_trial_params.h"
@@ -25,6 +27,13 @@ constexpr size_t kDefaultMaxNumDelayableRequestsPerClient = 10;
 // duration.
 constexpr int kHttpRttMultiplierForQueuingDuration = 30;
 
+// Default values of the kAdaptiveDelayableRequests params: the bounds of the
+// number of delayable requests in flight, and the typical size of a delayable
+// resource.
+constexpr int kDefaultMinAdaptiveDelayableRequests = 2;
+constexpr int kDefaultMaxAdaptiveDelayableRequests = 32;
+constexpr int kDefaultTypicalDelayableResourceSizeKilobytes = 16;
+
 // Reads experiment parameters and returns them.
 ResourceSchedulerParamsManager::ParamsForNetworkQualityContainer
 GetParamsForNetworkQualityContainer() {
@@ -232,4 +241,39 @@ ResourceSchedulerParamsManager::GetParamsForEffectiveConnectionType(
                                  false, base::nullopt);
 }
 
+base::Optional<size_t>
+ResourceSchedulerParamsManager::GetMaxDelayableRequestsForNetworkQuality(
+    base::Optional<base::TimeDelta> http_rtt,
+    base::Optional<int32_t> downstream_throughput_kbps) const {
+  DCHECK_CALLED_ON_VALID_SEQUENCE(sequence_checker_);
+  if (!base::FeatureList::IsEnabled(features::kAdaptiveDelayableRequests))
+    return base::nullopt;
+  if (!http_rtt || *http_rtt <= base::TimeDelta() ||
+      !downstream_throughput_kbps || *downstream_throughput_kbps <= 0) {
+    return base::nullopt;
+  }
+
+  int min_requests = base::GetFieldTrialParamByFeatureAsInt(
+      features::kAdaptiveDelayableRequests, "MinDelayableRequests",
+      kDefaultMinAdaptiveDelayableRequests);
+  int max_requests = base::GetFieldTrialParamByFeatureAsInt(
+      features::kAdaptiveDelayableRequests, "MaxDelayableRequests",
+      kDefaultMaxAdaptiveDelayableRequests);
+  int typical_resource_size_kb = base::GetFieldTrialParamByFeatureAsInt(
+      features::kAdaptiveDelayableRequests, "TypicalResourceSizeKilobytes",
+      kDefaultTypicalDelayableResourceSizeKilobytes);
+  min_requests = std::max(min_requests, 1);
+  max_requests = std::max(max_requests, min_requests);
+  typical_resource_size_kb = std::max(typical_resource_size_kb, 1);
+
+  // Each request spends about one RTT before its response starts arriving, so
+  // keeping the link busy takes one request per resource that fits in the
+  // bandwidth-delay product, plus the one being received.
+  double bdp_kilobytes =
+      *downstream_throughput_kbps / 8.0 * http_rtt->InSecondsF();
+  double requests = bdp_kilobytes / typical_resource_size_kb + 1;
+  return static_cast<size_t>(
+      std::max<double>(min_requests, std::min<double>(max_requests, requests)));
+}
+
 }  // namespace network
@@ -13,6 +13,7 @@
 #include "base/component_export.h"
 #include "base/optional.h"
 #include "base/sequence_checker.h"
+#include "base/time/time.h"
 #include "net/nqe/effective_connection_type.h"
 
 namespace network {
@@ -70,6 +71,16 @@ class COMPONENT_EXPORT(NETWORK_SERVICE) ResourceSchedulerParamsManager {
   ParamsForNetworkQuality GetParamsForEffectiveConnectionType(
       net::EffectiveConnectionType effective_connection_type) const;
 
+  // Returns the maximum number of delayable requests that keeps a network with
+  // the given estimates busy, or null if kAdaptiveDelayableRequests is disabled
+  // or an estimate is unavailable. The limit is the bandwidth-delay product
+  // divided by the typical size of a delayable resource, so that fewer
+  // requests compete for slow links and more are allowed on fast, high
+  // latency ones.
+  base::Optional<size_t> GetMaxDelayableRequestsForNetworkQuality(
+      base::Optional<base::TimeDelta> http_rtt,
+      base::Optional<int32_t> downstream_throughput_kbps) const;
+
   // Resets the internal container with the given one.
   void Reset(const ParamsForNetworkQualityContainer&
                  params_for_network_quality_container) {
@@ -596,6 +596,44 @@ TEST_F(ResourceSchedulerParamsManagerTest,
                       net::EFFECTIVE_CONNECTION_TYPE_4G);
 }
 
+TEST_F(ResourceSchedulerParamsManagerTest, AdaptiveDelayableRequests) {
+  base::test::ScopedFeatureList scoped_feature_list;
+  ResourceSchedulerParamsManager params_manager;
+
+  // Disabled by default.
+  EXPECT_FALSE(params_manager.GetMaxDelayableRequestsForNetworkQuality(
+      base::TimeDelta::FromMilliseconds(100), 10000));
+
+  scoped_feature_list.InitAndEnableFeatureWithParameters(
+      features::kAdaptiveDelayableRequests,
+      {{"MinDelayableRequests", "2"},
+       {"MaxDelayableRequests", "20"},
+       {"TypicalResourceSizeKilobytes", "10"}});
+
+  // Both estimates are needed.
+  EXPECT_FALSE(params_manager.GetMaxDelayableRequestsForNetworkQuality(
+      base::nullopt, 10000));
+  EXPECT_FALSE(params_manager.GetMaxDelayableRequestsForNetworkQuality(
+      base::TimeDelta::FromMilliseconds(100), base::nullopt));
+
+  // 8000 kbps over a 100 ms RTT is a 100 KB bandwidth-delay product, which
+  // fits 10 typical resources.
+  EXPECT_EQ(11u, params_manager
+                     .GetMaxDelayableRequestsForNetworkQuality(
+                         base::TimeDelta::FromMilliseconds(100), 8000)
+                     .value());
+
+  // Slow links are limited to the minimum, fast ones to the maximum.
+  EXPECT_EQ(2u, params_manager
+                    .GetMaxDelayableRequestsForNetworkQuality(
+                        base::TimeDelta::FromMilliseconds(2000), 40)
+                    .value());
+  EXPECT_EQ(20u, params_manager
+                     .GetMaxDelayableRequestsForNetworkQuality(
+                         base::TimeDelta::FromMilliseconds(200), 100000)
+                     .value());
+}
+
 }  // unnamed namespace
 
 }  // namespace network
@@ -249,6 +249,11 @@ class COMPONENT_EXPORT(NETWORK_SERVICE) URLLoader
   int64_t total_written_bytes_ = 0;
 
   mojo::ScopedDataPipeProducerHandle response_body_stream_;
+  // The two-phase write region of |response_body_stream_| that the body is
+  // read into. URLRequest's source streams, including content decoding
+  // filters, write their output straight into it, and MIME and CORB sniffing
+  // inspect it in place, so body bytes aren't copied on their way to the
+  // consumer.
   scoped_refptr<NetToMojoPendingBuffer> pending_write_;
   uint32_t pending_write_buffer_size_ = 0;
   uint32_t pending_write_buffer_offset_ = 0;
@@ -31,6 +31,10 @@ const char kDisableInProcessStackTraces[] = "disable-in-process-stack-traces";
 // it's routed.
 const char kEnableLogging[] = "enable-logging";
 
+// Runs the zygote without entering the layer-one sandbox, so that processes
+// that are not sandboxed on Linux can be forked from it.
+const char kNoZygoteSandbox[] = "no-zygote-sandbox";
+
 // Indicates the type of process to run. This may be "service-manager",
 // "service-runner", or any other arbitrary value supported by the embedder.
 const char kProcessType[] = "type";
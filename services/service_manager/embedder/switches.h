@@ -22,6 +22,9 @@ extern const char kDisableInProcessStackTraces[];
 COMPONENT_EXPORT(SERVICE_MANAGER_EMBEDDER_SWITCHES)
 extern const char kEnableLogging[];
 
+COMPONENT_EXPORT(SERVICE_MANAGER_EMBEDDER_SWITCHES)
+extern const char kNoZygoteSandbox[];
+
 COMPONENT_EXPORT(SERVICE_MANAGER_EMBEDDER_SWITCHES)
 extern const char kProcessType[];
 
@@ -42,6 +42,19 @@ ZygoteHandle CreateGenericZygote(
 // http://crbug.com/569191
 COMPONENT_EXPORT(SERVICE_MANAGER_ZYGOTE) ZygoteHandle GetGenericZygote();
 
+// Like CreateGenericZygote(), but for a zygote that doesn't enter the sandbox,
+// from which processes that run unsandboxed on Linux (e.g. the network and
+// audio services) can be forked instead of launched through a full exec. They
+// skip dynamic linking and start with ICU and the allocator already set up.
+// Returns null if the zygote fails to start.
+COMPONENT_EXPORT(SERVICE_MANAGER_ZYGOTE)
+ZygoteHandle CreateUnsandboxedZygote(
+    base::OnceCallback<pid_t(base::CommandLine*, base::ScopedFD*)> launcher);
+
+// Returns a handle to the unsandboxed zygote, or null if it wasn't created or
+// failed to start.
+COMPONENT_EXPORT(SERVICE_MANAGER_ZYGOTE) ZygoteHandle GetUnsandboxedZygote();
+
 }  // namespace service_manager
 
 #endif  // SERVICES_SERVICE_MANAGER_ZYGOTE_COMMON_ZYGOTE_HANDLE_H_
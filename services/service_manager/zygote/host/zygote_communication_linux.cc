@@ -25,8 +25,9 @@
 
 namespace service_manager {
 
-ZygoteCommunication::ZygoteCommunication()
-    : control_fd_(),
+ZygoteCommunication::ZygoteCommunication(ZygoteType type)
+    : type_(type),
+      control_fd_(),
       control_lock_(),
       pid_(),
       list_of_running_zygote_children_(),
@@ -220,7 +221,7 @@ void ZygoteCommunication::ZygoteChildDied(pid_t process) {
   DCHECK_EQ(1U, num_erased);
 }
 
-void ZygoteCommunication::Init(
+bool ZygoteCommunication::Init(
     base::OnceCallback<pid_t(base::CommandLine*, base::ScopedFD*)> launcher) {
   CHECK(!init_);
 
@@ -246,15 +247,23 @@ void ZygoteCommunication::Init(
   };
   cmd_line.CopySwitchesFrom(browser_command_line, kForwardSwitches,
                             base::size(kForwardSwitches));
+  if (type_ == ZygoteType::kUnsandboxed)
+    cmd_line.AppendSwitch(switches::kNoZygoteSandbox);
 
   pid_ = std::move(launcher).Run(&cmd_line, &control_fd_);
 
   base::Pickle pickle;
   pickle.WriteInt(kZygoteCommandGetSandboxStatus);
-  if (!SendMessage(pickle, nullptr))
-    LOG(FATAL) << "Cannot communicate with zygote";
+  if (pid_ <= 0 || !control_fd_.is_valid() || !SendMessage(pickle, nullptr)) {
+    LOG_IF(FATAL, type_ == ZygoteType::kSandboxed)
+        << "Cannot communicate with zygote";
+    LOG(ERROR) << "Cannot communicate with unsandboxed zygote";
+    control_fd_.reset();
+    return false;
+  }
 
   init_ = true;
+  return true;
 }
 
 base::TerminationStatus ZygoteCommunication::GetTerminationStatus(
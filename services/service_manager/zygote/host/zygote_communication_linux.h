@@ -31,10 +31,22 @@ namespace service_manager {
 // https://chromium.googlesource.com/chromium/src/+/master/docs/linux_sandbox_ipc.md
 class COMPONENT_EXPORT(SERVICE_MANAGER_ZYGOTE) ZygoteCommunication {
  public:
-  ZygoteCommunication();
+  enum class ZygoteType {
+    // Forks processes that enable their own sandbox after fork, such as
+    // renderers.
+    kSandboxed,
+    // Forks processes that run unsandboxed, such as the network and audio
+    // services.
+    kUnsandboxed,
+  };
+
+  explicit ZygoteCommunication(ZygoteType type);
   ~ZygoteCommunication();
 
-  void Init(
+  // Launches the zygote with |launcher|. A sandboxed zygote that can't be
+  // launched is fatal. For an unsandboxed zygote, returns false instead, and
+  // the processes it would fork are launched.
+  bool Init(
       base::OnceCallback<pid_t(base::CommandLine*, base::ScopedFD*)> launcher);
 
   // Tries to start a process of type indicated by process_type.
@@ -81,6 +93,7 @@ class COMPONENT_EXPORT(SERVICE_MANAGER_ZYGOTE) ZygoteCommunication {
   // Get the sandbox status from the zygote.
   ssize_t ReadSandboxStatus();
 
+  const ZygoteType type_;
   base::ScopedFD control_fd_;  // the socket to the zygote.
   // A lock protecting all communication with the zygote. This lock must be
   // acquired before sending a command and released after the result has been
@@ -0,0 +1,137 @@
+// Copyright 2018 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "services/service_manager/zygote/host/zygote_communication_linux.h"
+
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <vector>
+
+#include "base/bind.h"
+#include "base/command_line.h"
+#include "base/files/scoped_file.h"
+#include "base/pickle.h"
+#include "base/posix/unix_domain_socket.h"
+#include "services/service_manager/embedder/switches.h"
+#include "services/service_manager/zygote/common/zygote_buildflags.h"
+#include "services/service_manager/zygote/common/zygote_commands_linux.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+#if BUILDFLAG(USE_ZYGOTE_HANDLE)
+#include "services/service_manager/zygote/common/zygote_handle.h"
+#endif
+
+namespace service_manager {
+
+namespace {
+
+// Stands in for ZygoteHostImpl::LaunchZygote(). Records the zygote's command
+// line and hands the browser end of a socket pair to the ZygoteCommunication,
+// keeping the zygote end in |zygote_fd|.
+pid_t FakeLaunchZygote(base::CommandLine* launched_cmd_line,
+                       base::ScopedFD* zygote_fd,
+                       base::CommandLine* cmd_line,
+                       base::ScopedFD* control_fd) {
+  *launched_cmd_line = *cmd_line;
+  int fds[2];
+  CHECK_EQ(0, socketpair(AF_UNIX, SOCK_SEQPACKET, 0, fds));
+  control_fd->reset(fds[0]);
+  zygote_fd->reset(fds[1]);
+  return getpid();
+}
+
+// Simulates a zygote that exits before the browser can talk to it.
+pid_t FakeLaunchZygoteThatDies(base::CommandLine* cmd_line,
+                               base::ScopedFD* control_fd) {
+  int fds[2];
+  CHECK_EQ(0, socketpair(AF_UNIX, SOCK_SEQPACKET, 0, fds));
+  control_fd->reset(fds[0]);
+  close(fds[1]);
+  return getpid();
+}
+
+// Simulates a zygote process that can't be launched.
+pid_t FakeLaunchZygoteThatFails(base::CommandLine* cmd_line,
+                                base::ScopedFD* control_fd) {
+  return base::kNullProcessId;
+}
+
+// Reads the next command that the zygote at |zygote_fd| received.
+int ReadZygoteCommand(int zygote_fd) {
+  char buf[kZygoteMaxMessageLength];
+  std::vector<base::ScopedFD> fds;
+  ssize_t len =
+      base::UnixDomainSocket::RecvMsg(zygote_fd, buf, sizeof(buf), &fds);
+  if (len <= 0)
+    return -1;
+  base::Pickle pickle(buf, len);
+  base::PickleIterator iter(pickle);
+  int command = -1;
+  EXPECT_TRUE(iter.ReadInt(&command));
+  return command;
+}
+
+}  // namespace
+
+TEST(ZygoteCommunicationTest, SandboxedZygoteEntersSandbox) {
+  base::CommandLine launched_cmd_line(base::CommandLine::NO_PROGRAM);
+  base::ScopedFD zygote_fd;
+  ZygoteCommunication zygote(ZygoteCommunication::ZygoteType::kSandboxed);
+  ASSERT_TRUE(zygote.Init(base::BindOnce(
+      &FakeLaunchZygote, &launched_cmd_line, &zygote_fd)));
+
+  EXPECT_EQ(switches::kZygoteProcess,
+            launched_cmd_line.GetSwitchValueASCII(switches::kProcessType));
+  EXPECT_FALSE(launched_cmd_line.HasSwitch(switches::kNoZygoteSandbox));
+  EXPECT_EQ(kZygoteCommandGetSandboxStatus,
+            ReadZygoteCommand(zygote_fd.get()));
+}
+
+TEST(ZygoteCommunicationTest, UnsandboxedZygoteSkipsSandbox) {
+  base::CommandLine launched_cmd_line(base::CommandLine::NO_PROGRAM);
+  base::ScopedFD zygote_fd;
+  ZygoteCommunication zygote(ZygoteCommunication::ZygoteType::kUnsandboxed);
+  ASSERT_TRUE(zygote.Init(base::BindOnce(
+      &FakeLaunchZygote, &launched_cmd_line, &zygote_fd)));
+
+  EXPECT_EQ(switches::kZygoteProcess,
+            launched_cmd_line.GetSwitchValueASCII(switches::kProcessType));
+  EXPECT_TRUE(launched_cmd_line.HasSwitch(switches::kNoZygoteSandbox));
+  EXPECT_EQ(kZygoteCommandGetSandboxStatus,
+            ReadZygoteCommand(zygote_fd.get()));
+
+  // The reply to the initial request is read with the first status query.
+  const int kStatus = 0;
+  ASSERT_EQ(static_cast<ssize_t>(sizeof(kStatus)),
+            write(zygote_fd.get(), &kStatus, sizeof(kStatus)));
+  EXPECT_EQ(kStatus, zygote.GetSandboxStatus());
+}
+
+TEST(ZygoteCommunicationTest, UnsandboxedZygoteLaunchFailureIsNotFatal) {
+  ZygoteCommunication zygote(ZygoteCommunication::ZygoteType::kUnsandboxed);
+  EXPECT_FALSE(zygote.Init(base::BindOnce(&FakeLaunchZygoteThatFails)));
+}
+
+TEST(ZygoteCommunicationTest, UnsandboxedZygoteThatDiesIsNotFatal) {
+  ZygoteCommunication zygote(ZygoteCommunication::ZygoteType::kUnsandboxed);
+  EXPECT_FALSE(zygote.Init(base::BindOnce(&FakeLaunchZygoteThatDies)));
+}
+
+TEST(ZygoteCommunicationDeathTest, SandboxedZygoteLaunchFailureIsFatal) {
+  ZygoteCommunication zygote(ZygoteCommunication::ZygoteType::kSandboxed);
+  EXPECT_DEATH(zygote.Init(base::BindOnce(&FakeLaunchZygoteThatFails)), "");
+}
+
+#if BUILDFLAG(USE_ZYGOTE_HANDLE)
+TEST(ZygoteCommunicationTest, NoUnsandboxedZygoteAfterLaunchFailure) {
+  // Utility processes are launched rather than forked when there is no
+  // unsandboxed zygote.
+  EXPECT_FALSE(
+      CreateUnsandboxedZygote(base::BindOnce(&FakeLaunchZygoteThatFails)));
+  EXPECT_FALSE(GetUnsandboxedZygote());
+}
+#endif  // BUILDFLAG(USE_ZYGOTE_HANDLE)
+
+}  // namespace service_manager
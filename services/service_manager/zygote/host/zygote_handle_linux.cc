@@ -4,6 +4,8 @@
 
 #include "services/service_manager/zygote/common/zygote_handle.h"
 
+#include <memory>
+
 #include "services/service_manager/zygote/host/zygote_communication_linux.h"
 
 namespace service_manager {
@@ -11,13 +13,15 @@ namespace {
 
 // Intentionally leaked.
 ZygoteHandle g_generic_zygote = nullptr;
+ZygoteHandle g_unsandboxed_zygote = nullptr;
 
 }  // namespace
 
 ZygoteHandle CreateGenericZygote(
     base::OnceCallback<pid_t(base::CommandLine*, base::ScopedFD*)> launcher) {
   CHECK(!g_generic_zygote);
-  g_generic_zygote = new ZygoteCommunication();
+  g_generic_zygote =
+      new ZygoteCommunication(ZygoteCommunication::ZygoteType::kSandboxed);
   g_generic_zygote->Init(std::move(launcher));
   return g_generic_zygote;
 }
@@ -27,4 +31,20 @@ ZygoteHandle GetGenericZygote() {
   return g_generic_zygote;
 }
 
+ZygoteHandle CreateUnsandboxedZygote(
+    base::OnceCallback<pid_t(base::CommandLine*, base::ScopedFD*)> launcher) {
+  CHECK(!g_unsandboxed_zygote);
+  auto zygote = std::make_unique<ZygoteCommunication>(
+      ZygoteCommunication::ZygoteType::kUnsandboxed);
+  // Processes that would be forked from the zygote are launched if it fails to
+  // start.
+  if (zygote->Init(std::move(launcher)))
+    g_unsandboxed_zygote = zygote.release();
+  return g_unsandboxed_zygote;
+}
+
+ZygoteHandle GetUnsandboxedZygote() {
+  return g_unsandboxed_zygote;
+}
+
 }  // namespace service_manager
@@ -19,6 +19,7 @@
 #include "sandbox/linux/services/namespace_sandbox.h"
 #include "sandbox/linux/suid/client/setuid_sandbox_host.h"
 #include "sandbox/linux/suid/common/sandbox.h"
+#include "services/service_manager/embedder/switches.h"
 #include "services/service_manager/sandbox/linux/sandbox_linux.h"
 #include "services/service_manager/sandbox/switches.h"
 #include "services/service_manager/zygote/common/zygote_commands_linux.h"
@@ -154,8 +155,15 @@ pid_t ZygoteHostImpl::LaunchZygote(
   options.fds_to_remap = std::move(additional_remapped_fds);
   options.fds_to_remap.emplace_back(fds[1], kZygoteSocketPairFd);
 
+  // The unsandboxed zygote is launched like a regular child process.
+  const bool is_sandboxed_zygote =
+      !cmd_line->HasSwitch(service_manager::switches::kNoZygoteSandbox);
+  const bool use_suid_sandbox = is_sandboxed_zygote && use_suid_sandbox_;
+  const bool use_namespace_sandbox =
+      is_sandboxed_zygote && use_namespace_sandbox_;
+
   base::ScopedFD dummy_fd;
-  if (use_suid_sandbox_) {
+  if (use_suid_sandbox) {
     std::unique_ptr<sandbox::SetuidSandboxHost> sandbox_host(
         sandbox::SetuidSandboxHost::Create());
     sandbox_host->PrependWrapper(cmd_line);
@@ -164,10 +172,17 @@ pid_t ZygoteHostImpl::LaunchZygote(
   }
 
   base::Process process =
-      use_namespace_sandbox_
+      use_namespace_sandbox
           ? sandbox::NamespaceSandbox::LaunchProcess(*cmd_line, options)
           : base::LaunchProcess(*cmd_line, options);
-  CHECK(process.IsValid()) << "Failed to launch zygote process";
+  if (!process.IsValid()) {
+    // Without the unsandboxed zygote, processes are launched instead.
+    CHECK(!is_sandboxed_zygote) << "Failed to launch zygote process";
+    LOG(ERROR) << "Failed to launch unsandboxed zygote process";
+    close(fds[0]);
+    close(fds[1]);
+    return base::kNullProcessId;
+  }
 
   dummy_fd.reset();
   close(fds[1]);
@@ -175,7 +190,7 @@ pid_t ZygoteHostImpl::LaunchZygote(
 
   pid_t pid = process.Pid();
 
-  if (use_namespace_sandbox_ || use_suid_sandbox_) {
+  if (use_namespace_sandbox || use_suid_sandbox) {
     // The namespace and SUID sandbox will execute the zygote in a new
     // PID namespace, and the main zygote process will then fork from
     // there. Watch now our elaborate dance to find and validate the
@@ -182,10 +182,13 @@ bool ZygoteMain(
 
   auto* linux_sandbox = service_manager::SandboxLinux::GetInstance();
 
-  // Skip pre-initializing sandbox when sandbox is disabled for
-  // https://crbug.com/444900.
-  if (!base::CommandLine::ForCurrentProcess()->HasSwitch(
-          service_manager::switches::kNoSandbox)) {
+  // The unsandboxed zygote only forks processes that don't use the sandbox, so
+  // it has no sandbox to pre-initialize. Also skip pre-initializing sandbox
+  // when sandbox is disabled for https://crbug.com/444900.
+  const base::CommandLine& command_line =
+      *base::CommandLine::ForCurrentProcess();
+  if (!command_line.HasSwitch(service_manager::switches::kNoZygoteSandbox) &&
+      !command_line.HasSwitch(service_manager::switches::kNoSandbox)) {
     // This will pre-initialize the various sandboxes that need it.
     linux_sandbox->PreinitializeSandbox();
   }
@@ -38,6 +38,20 @@ class COMPONENT_EXPORT(TRACING_CPP) ThreadLocalEventSink {
   virtual void AddTraceEvent(base::trace_event::TraceEvent* trace_event,
                              base::trace_event::TraceEventHandle* handle) = 0;
 
+  // Writes an event from the arguments of the TRACE_EVENT macros, without a
+  // TraceEvent. Returns false if the event should take the regular path.
+  virtual bool AddTraceEventDirect(
+      char phase,
+      const unsigned char* category_group_enabled,
+      const char* name,
+      const char* scope,
+      unsigned long long id,
+      unsigned long long bind_id,
+      const base::TimeTicks& timestamp,
+      base::trace_event::TraceArguments* args,
+      unsigned int flags,
+      base::trace_event::TraceEventHandle* handle) = 0;
+
   virtual void UpdateDuration(base::trace_event::TraceEventHandle handle,
                               const base::TimeTicks& now,
                               const base::ThreadTicks& thread_now) = 0;
@@ -214,11 +214,14 @@ void TraceEventDataSource::RegisterWithTraceLog() {
       &TraceEventDataSource::OnAddTraceEvent,
       &TraceEventDataSource::FlushCurrentThread,
       &TraceEventDataSource::OnUpdateDuration);
+  TraceLog::GetInstance()->SetAddTraceEventDirectOverride(
+      &TraceEventDataSource::OnAddTraceEventDirect);
 }
 
 void TraceEventDataSource::UnregisterFromTraceLog() {
   RegisterTracedValueProtoWriter(false);
   TraceLog::GetInstance()->SetAddTraceEventOverrides(nullptr, nullptr, nullptr);
+  TraceLog::GetInstance()->SetAddTraceEventDirectOverride(nullptr);
 }
 
 void TraceEventDataSource::SetupStartupTracing() {
@@ -478,6 +481,42 @@ void TraceEventDataSource::OnAddTraceEvent(
   }
 }
 
+// static
+bool TraceEventDataSource::OnAddTraceEventDirect(
+    char phase,
+    const unsigned char* category_group_enabled,
+    const char* name,
+    const char* scope,
+    unsigned long long id,
+    unsigned long long bind_id,
+    const base::TimeTicks& timestamp,
+    base::trace_event::TraceArguments* args,
+    unsigned int flags,
+    base::trace_event::TraceEventHandle* handle) {
+  if (GetThreadIsInTraceEventTLS()->Get()) {
+    return false;
+  }
+
+  // The sink is created, and replaced when a new session starts, on the
+  // regular path; see OnAddTraceEvent().
+  auto* thread_local_event_sink =
+      static_cast<ThreadLocalEventSink*>(ThreadLocalEventSinkSlot()->Get());
+  if (!thread_local_event_sink) {
+    return false;
+  }
+  uint32_t new_session_id =
+      GetInstance()->session_id_.load(std::memory_order_relaxed);
+  if (new_session_id > kFirstSessionID &&
+      new_session_id != thread_local_event_sink->session_id()) {
+    return false;
+  }
+
+  AutoThreadLocalBoolean thread_is_in_trace_event(GetThreadIsInTraceEventTLS());
+  return thread_local_event_sink->AddTraceEventDirect(
+      phase, category_group_enabled, name, scope, id, bind_id, timestamp, args,
+      flags, handle);
+}
+
 // static
 void TraceEventDataSource::OnUpdateDuration(
     base::trace_event::TraceEventHandle handle,
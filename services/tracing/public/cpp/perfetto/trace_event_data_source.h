@@ -119,6 +119,19 @@ class COMPONENT_EXPORT(TRACING_CPP) TraceEventDataSource
   static void OnAddTraceEvent(base::trace_event::TraceEvent* trace_event,
                               bool thread_will_flush,
                               base::trace_event::TraceEventHandle* handle);
+  // Callback from TraceLog for writing events straight into the current
+  // thread's sink, if it already has one for the current session.
+  static bool OnAddTraceEventDirect(
+      char phase,
+      const unsigned char* category_group_enabled,
+      const char* name,
+      const char* scope,
+      unsigned long long id,
+      unsigned long long bind_id,
+      const base::TimeTicks& timestamp,
+      base::trace_event::TraceArguments* args,
+      unsigned int flags,
+      base::trace_event::TraceEventHandle* handle);
   static void OnUpdateDuration(base::trace_event::TraceEventHandle handle,
                                const base::TimeTicks& now,
                                const base::ThreadTicks& thread_now);
@@ -0,0 +1,151 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "services/tracing/public/cpp/perfetto/trace_event_data_source.h"
+
+#include <memory>
+
+#include "base/bind.h"
+#include "base/callback.h"
+#include "base/run_loop.h"
+#include "base/test/scoped_task_environment.h"
+#include "base/time/time.h"
+#include "base/trace_event/trace_event.h"
+#include "services/tracing/public/cpp/perfetto/producer_client.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "testing/perf/perf_test.h"
+#include "third_party/perfetto/include/perfetto/protozero/scattered_stream_null_delegate.h"
+#include "third_party/perfetto/include/perfetto/protozero/scattered_stream_writer.h"
+#include "third_party/perfetto/include/perfetto/tracing/core/trace_writer.h"
+#include "third_party/perfetto/protos/perfetto/trace/trace_packet.pbzero.h"
+
+namespace tracing {
+
+namespace {
+
+constexpr const char kCategoryGroup[] = "foo";
+constexpr int kNumEvents = 100000;
+
+// Discards everything written into it, so that only the cost of emitting the
+// events is measured.
+class NullTraceWriter : public perfetto::TraceWriter {
+ public:
+  NullTraceWriter()
+      : delegate_(perfetto::base::kPageSize), stream_(&delegate_) {}
+
+  perfetto::TraceWriter::TracePacketHandle NewTracePacket() override {
+    stream_.Reset(delegate_.GetNewBuffer());
+    trace_packet_.Reset(&stream_);
+
+    return perfetto::TraceWriter::TracePacketHandle(&trace_packet_);
+  }
+
+  void Flush(std::function<void()> callback = {}) override {}
+
+  perfetto::WriterID writer_id() const override {
+    return perfetto::WriterID(0);
+  }
+
+  uint64_t written() const override { return 0u; }
+
+ private:
+  perfetto::protos::pbzero::TracePacket trace_packet_;
+  protozero::ScatteredStreamWriterNullDelegate delegate_;
+  protozero::ScatteredStreamWriter stream_;
+};
+
+class NullProducerClient : public ProducerClient {
+ public:
+  std::unique_ptr<perfetto::TraceWriter> CreateTraceWriter(
+      perfetto::BufferID target_buffer) override {
+    return std::make_unique<NullTraceWriter>();
+  }
+};
+
+class TraceEventDataSourcePerfTest : public testing::Test {
+ public:
+  void SetUp() override {
+    ProducerClient::ResetTaskRunnerForTesting();
+    producer_client_ = std::make_unique<NullProducerClient>();
+
+    TraceEventDataSource::ResetForTesting();
+    perfetto::DataSourceConfig config;
+    TraceEventDataSource::GetInstance()->StartTracing(producer_client_.get(),
+                                                      config);
+  }
+
+  void TearDown() override {
+    base::RunLoop wait_for_tracelog_flush;
+    TraceEventDataSource::GetInstance()->StopTracing(
+        wait_for_tracelog_flush.QuitClosure());
+    wait_for_tracelog_flush.Run();
+
+    TraceEventDataSource::GetInstance()->FlushCurrentThread();
+    producer_client_.reset();
+  }
+
+  // Reports the rate at which |emit_events| emits events, first through the
+  // direct path into the thread's sink and then through TraceLog's regular
+  // AddTraceEvent override.
+  void MeasureEventsPerSecond(const char* story,
+                              const base::RepeatingCallback<void(int)>&
+                                  emit_events) {
+    // The first event on a thread goes through the regular path to create the
+    // thread's sink.
+    emit_events.Run(1);
+
+    ReportEventsPerSecond("direct", story, emit_events);
+    base::trace_event::TraceLog::GetInstance()->SetAddTraceEventDirectOverride(
+        nullptr);
+    ReportEventsPerSecond("trace_log", story, emit_events);
+  }
+
+ private:
+  void ReportEventsPerSecond(
+      const char* path,
+      const char* story,
+      const base::RepeatingCallback<void(int)>& emit_events) {
+    base::TimeTicks start = base::TimeTicks::Now();
+    emit_events.Run(kNumEvents);
+    base::TimeDelta elapsed = base::TimeTicks::Now() - start;
+    perf_test::PrintResult("trace_event_data_source", path, story,
+                           kNumEvents / elapsed.InSecondsF(), "events/s",
+                           true);
+  }
+
+  base::test::ScopedTaskEnvironment scoped_task_environment_;
+  std::unique_ptr<NullProducerClient> producer_client_;
+};
+
+}  // namespace
+
+TEST_F(TraceEventDataSourcePerfTest, InstantEvents) {
+  MeasureEventsPerSecond("instant", base::BindRepeating([](int count) {
+                           for (int i = 0; i < count; ++i) {
+                             TRACE_EVENT_INSTANT0(kCategoryGroup, "bar",
+                                                  TRACE_EVENT_SCOPE_THREAD);
+                           }
+                         }));
+}
+
+TEST_F(TraceEventDataSourcePerfTest, InstantEventsWithArgs) {
+  MeasureEventsPerSecond("instant_with_args",
+                         base::BindRepeating([](int count) {
+                           for (int i = 0; i < count; ++i) {
+                             TRACE_EVENT_INSTANT2(
+                                 kCategoryGroup, "bar",
+                                 TRACE_EVENT_SCOPE_THREAD, "index", i,
+                                 "name", "baz");
+                           }
+                         }));
+}
+
+TEST_F(TraceEventDataSourcePerfTest, ScopedEvents) {
+  MeasureEventsPerSecond("scoped", base::BindRepeating([](int count) {
+                           for (int i = 0; i < count; ++i)
+                             TRACE_EVENT0(kCategoryGroup, "bar");
+                         }));
+}
+
+}  // namespace tracing
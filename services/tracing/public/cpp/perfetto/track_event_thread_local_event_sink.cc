@@ -66,8 +66,9 @@ void AddConvertableToTraceFormat(
   annotation->set_legacy_json_value(json.c_str());
 }
 
+template <typename TraceEventType>
 void WriteDebugAnnotations(
-    base::trace_event::TraceEvent* trace_event,
+    TraceEventType* trace_event,
     TrackEvent* track_event,
     InterningIndexEntry** current_packet_interning_entries) {
   for (size_t i = 0; i < trace_event->arg_size() && trace_event->arg_name(i);
@@ -113,6 +114,82 @@ void WriteDebugAnnotations(
   }
 }
 
+// The arguments of the TRACE_EVENT macros for an event on the current thread,
+// with the accessors of the TraceEvent they would otherwise be copied into.
+class DirectTraceEvent {
+ public:
+  DirectTraceEvent(char phase,
+                   const unsigned char* category_group_enabled,
+                   const char* name,
+                   const char* scope,
+                   unsigned long long id,
+                   unsigned long long bind_id,
+                   int thread_id,
+                   const base::TimeTicks& timestamp,
+                   const base::ThreadTicks& thread_timestamp,
+                   base::trace_event::TraceArguments* args,
+                   unsigned int flags)
+      : phase_(phase),
+        category_group_enabled_(category_group_enabled),
+        name_(name),
+        scope_(scope),
+        id_(id),
+        bind_id_(bind_id),
+        thread_id_(thread_id),
+        timestamp_(timestamp),
+        thread_timestamp_(thread_timestamp),
+        args_(args),
+        flags_(flags) {
+    // COMPLETE events are kept as TraceEvents until their duration is known.
+    DCHECK_NE(phase, TRACE_EVENT_PHASE_COMPLETE);
+    DCHECK(!(flags & TRACE_EVENT_FLAG_HAS_PROCESS_ID));
+  }
+
+  char phase() const { return phase_; }
+  const unsigned char* category_group_enabled() const {
+    return category_group_enabled_;
+  }
+  const char* name() const { return name_; }
+  const char* scope() const { return scope_; }
+  unsigned long long id() const { return id_; }
+  unsigned long long bind_id() const { return bind_id_; }
+  int thread_id() const { return thread_id_; }
+  int process_id() const { return base::kNullProcessId; }
+  base::TimeTicks timestamp() const { return timestamp_; }
+  base::ThreadTicks thread_timestamp() const { return thread_timestamp_; }
+  base::TimeDelta duration() const { return base::TimeDelta(); }
+  base::TimeDelta thread_duration() const { return base::TimeDelta(); }
+  unsigned int flags() const { return flags_; }
+
+  size_t arg_size() const { return args_ ? args_->size() : 0u; }
+  unsigned char arg_type(size_t index) const { return args_->types()[index]; }
+  const char* arg_name(size_t index) const { return args_->names()[index]; }
+  const base::trace_event::TraceValue& arg_value(size_t index) const {
+    return args_->values()[index];
+  }
+  base::trace_event::ConvertableToTraceFormat* arg_convertible_value(
+      size_t index) {
+    return arg_type(index) == TRACE_VALUE_TYPE_CONVERTABLE
+               ? arg_value(index).as_convertable
+               : nullptr;
+  }
+
+ private:
+  const char phase_;
+  const unsigned char* const category_group_enabled_;
+  const char* const name_;
+  const char* const scope_;
+  const unsigned long long id_;
+  const unsigned long long bind_id_;
+  const int thread_id_;
+  const base::TimeTicks timestamp_;
+  const base::ThreadTicks thread_timestamp_;
+  base::trace_event::TraceArguments* const args_;
+  const unsigned int flags_;
+
+  DISALLOW_COPY_AND_ASSIGN(DirectTraceEvent);
+};
+
 }  // namespace
 
 // static
@@ -159,18 +236,65 @@ void TrackEventThreadLocalEventSink::AddTraceEvent(
     // itself as that causes a lot more codegen in the callsites
     // and bloats the binary size too much (due to the increased
     // sizeof() of the scoped object itself).
-    DCHECK_LT(current_stack_depth_, kMaxCompleteEventDepth);
-    if (current_stack_depth_ >= kMaxCompleteEventDepth) {
-      return;
+    base::trace_event::TraceEvent* complete_event = PushCompleteEvent(handle);
+    if (complete_event) {
+      *complete_event = std::move(*trace_event);
     }
-
-    complete_event_stack_[current_stack_depth_] = std::move(*trace_event);
-    handle->event_index = ++current_stack_depth_;
-    handle->chunk_index = kMagicChunkIndex;
-    handle->chunk_seq = session_id_;
     return;
   }
 
+  WriteTraceEvent(trace_event);
+}
+
+bool TrackEventThreadLocalEventSink::AddTraceEventDirect(
+    char phase,
+    const unsigned char* category_group_enabled,
+    const char* name,
+    const char* scope,
+    unsigned long long id,
+    unsigned long long bind_id,
+    const base::TimeTicks& timestamp,
+    base::trace_event::TraceArguments* args,
+    unsigned int flags,
+    base::trace_event::TraceEventHandle* handle) {
+  if (phase == TRACE_EVENT_PHASE_COMPLETE) {
+    // Initialize the stack entry in place rather than moving a TraceEvent into
+    // it, see AddTraceEvent().
+    base::trace_event::TraceEvent* complete_event = PushCompleteEvent(handle);
+    if (complete_event) {
+      complete_event->Reset(thread_id_, timestamp, ThreadNow(), phase,
+                            category_group_enabled, name, scope, id, bind_id,
+                            args, flags);
+    }
+    return true;
+  }
+
+  DirectTraceEvent trace_event(phase, category_group_enabled, name, scope, id,
+                               bind_id, thread_id_, timestamp, ThreadNow(),
+                               args, flags);
+  WriteTraceEvent(&trace_event);
+  return true;
+}
+
+base::trace_event::TraceEvent*
+TrackEventThreadLocalEventSink::PushCompleteEvent(
+    base::trace_event::TraceEventHandle* handle) {
+  DCHECK_LT(current_stack_depth_, kMaxCompleteEventDepth);
+  if (current_stack_depth_ >= kMaxCompleteEventDepth) {
+    return nullptr;
+  }
+
+  base::trace_event::TraceEvent* complete_event =
+      &complete_event_stack_[current_stack_depth_];
+  handle->event_index = ++current_stack_depth_;
+  handle->chunk_index = kMagicChunkIndex;
+  handle->chunk_seq = session_id_;
+  return complete_event;
+}
+
+template <typename TraceEventType>
+void TrackEventThreadLocalEventSink::WriteTraceEvent(
+    TraceEventType* trace_event) {
   uint32_t flags = trace_event->flags();
   bool copy_strings = flags & TRACE_EVENT_FLAG_COPY;
   bool explicit_timestamp = flags & TRACE_EVENT_FLAG_EXPLICIT_TIMESTAMP;
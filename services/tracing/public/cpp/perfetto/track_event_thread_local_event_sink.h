@@ -38,6 +38,16 @@ class COMPONENT_EXPORT(TRACING_CPP) TrackEventThreadLocalEventSink
   void ResetIncrementalState() override;
   void AddTraceEvent(base::trace_event::TraceEvent* trace_event,
                      base::trace_event::TraceEventHandle* handle) override;
+  bool AddTraceEventDirect(char phase,
+                           const unsigned char* category_group_enabled,
+                           const char* name,
+                           const char* scope,
+                           unsigned long long id,
+                           unsigned long long bind_id,
+                           const base::TimeTicks& timestamp,
+                           base::trace_event::TraceArguments* args,
+                           unsigned int flags,
+                           base::trace_event::TraceEventHandle* handle) override;
   void UpdateDuration(base::trace_event::TraceEventHandle handle,
                       const base::TimeTicks& now,
                       const base::ThreadTicks& thread_now) override;
@@ -46,6 +56,16 @@ class COMPONENT_EXPORT(TRACING_CPP) TrackEventThreadLocalEventSink
  private:
   static constexpr size_t kMaxCompleteEventDepth = 30;
 
+  // Returns the slot on |complete_event_stack_| for a COMPLETE event that is
+  // written once its duration is known, or null if the stack is full.
+  base::trace_event::TraceEvent* PushCompleteEvent(
+      base::trace_event::TraceEventHandle* handle);
+
+  // Writes a TrackEvent packet for |trace_event|, which is either a TraceEvent
+  // or a view of the arguments passed to AddTraceEventDirect().
+  template <typename TraceEventType>
+  void WriteTraceEvent(TraceEventType* trace_event);
+
   // TODO(eseckler): Make it possible to register new indexes for use from
   // TRACE_EVENT macros.
   InterningIndex<const char*> interned_event_categories_;
@@ -9,6 +9,7 @@
 #include <stdint.h>
 #include <string.h>
 
+#include "base/bind.h"
 #include "base/files/file_path.h"
 #include "base/files/file_util.h"
 #include "base/format_macros.h"
@@ -26,6 +27,7 @@
 #include "base/strings/utf_string_conversions.h"
 #include "base/synchronization/lock.h"
 #include "base/threading/scoped_blocking_call.h"
+#include "base/threading/sequenced_task_runner_handle.h"
 #include "base/trace_event/memory_dump_manager.h"
 #include "build/build_config.h"
 #include "sql/database_memory_dump_provider.h"
@@ -234,12 +236,18 @@ static_assert(
     "Database::kDefaultPageSize must match the value configured into SQLite");
 
 constexpr int Database::kDefaultPageSize;
+constexpr int Database::kWALCheckpointPages;
+constexpr size_t Database::kMaxUniqueStatementCacheSize;
 
 Database::Database()
     : db_(nullptr),
       page_size_(kDefaultPageSize),
       cache_size_(0),
       exclusive_locking_(false),
+      wal_mode_(false),
+      wal_mode_enabled_(false),
+      checkpoint_scheduled_(false),
+      unique_statement_cache_(kMaxUniqueStatementCacheSize),
       transaction_nesting_(0),
       needs_rollback_(false),
       in_memory_(false),
@@ -248,7 +256,8 @@ Database::Database()
       mmap_disabled_(false),
       mmap_enabled_(false),
       total_changes_at_last_release_(0),
-      stats_histogram_(nullptr) {}
+      stats_histogram_(nullptr),
+      weak_factory_(this) {}
 
 Database::~Database() {
   Close();
@@ -303,6 +312,7 @@ void Database::CloseInternal(bool forced) {
 
   // Release cached statements.
   statement_cache_.clear();
+  unique_statement_cache_.Clear();
 
   // With cached statements released, in-use statements will remain.
   // Closing the database while statements are in use is an API
@@ -343,6 +353,9 @@ void Database::CloseInternal(bool forced) {
     }
   }
   db_ = nullptr;
+  wal_mode_enabled_ = false;
+  checkpoint_scheduled_ = false;
+  weak_factory_.InvalidateWeakPtrs();
 }
 
 void Database::Close() {
@@ -783,6 +796,57 @@ size_t Database::GetAppropriateMmapSize() {
   return mmap_ofs;
 }
 
+bool Database::CheckpointDatabase() {
+  base::Optional<base::ScopedBlockingCall> scoped_blocking_call;
+  InitScopedBlockingCall(&scoped_blocking_call);
+
+  if (!db_ || !wal_mode_enabled_)
+    return false;
+
+  int rc = sqlite3_wal_checkpoint_v2(db_, nullptr, SQLITE_CHECKPOINT_TRUNCATE,
+                                     nullptr, nullptr);
+  return rc == SQLITE_OK;
+}
+
+// static
+int Database::OnWALCommit(void* database,
+                          sqlite3* db,
+                          const char* db_name,
+                          int wal_pages) {
+  if (wal_pages < kWALCheckpointPages)
+    return SQLITE_OK;
+
+  if (!base::SequencedTaskRunnerHandle::IsSet()) {
+    // Checkpoint right away, as SQLite's own hook does.
+    sqlite3_wal_checkpoint_v2(db, db_name, SQLITE_CHECKPOINT_PASSIVE, nullptr,
+                              nullptr);
+    return SQLITE_OK;
+  }
+
+  Database* self = static_cast<Database*>(database);
+  if (!self->checkpoint_scheduled_) {
+    self->checkpoint_scheduled_ = true;
+    base::SequencedTaskRunnerHandle::Get()->PostTask(
+        FROM_HERE, base::BindOnce(&Database::RunScheduledCheckpoint,
+                                  self->weak_factory_.GetWeakPtr()));
+  }
+  return SQLITE_OK;
+}
+
+void Database::RunScheduledCheckpoint() {
+  checkpoint_scheduled_ = false;
+  if (!db_ || !wal_mode_enabled_)
+    return;
+
+  base::Optional<base::ScopedBlockingCall> scoped_blocking_call;
+  InitScopedBlockingCall(&scoped_blocking_call);
+
+  // A passive checkpoint does not wait for readers. Whatever it cannot copy
+  // is left for the checkpoint after the next commit.
+  sqlite3_wal_checkpoint_v2(db_, nullptr, SQLITE_CHECKPOINT_PASSIVE, nullptr,
+                            nullptr);
+}
+
 void Database::TrimMemory() {
   if (!db_)
     return;
@@ -1198,7 +1262,7 @@ scoped_refptr<Database::StatementRef> Database::GetCachedStatement(
     return it->second;
   }
 
-  scoped_refptr<StatementRef> statement = GetUniqueStatement(sql);
+  scoped_refptr<StatementRef> statement = GetStatementImpl(this, sql);
   if (statement->is_valid()) {
     statement_cache_[id] = statement;  // Only cache valid statements.
     DCHECK_EQ(std::string(sqlite3_sql(statement->stmt())), std::string(sql))
@@ -1209,7 +1273,24 @@ scoped_refptr<Database::StatementRef> Database::GetCachedStatement(
 
 scoped_refptr<Database::StatementRef> Database::GetUniqueStatement(
     const char* sql) {
-  return GetStatementImpl(this, sql);
+  auto it = unique_statement_cache_.Get(sql);
+  if (it != unique_statement_cache_.end()) {
+    if (it->second->HasOneRef()) {
+      // No Statement uses it. It is still valid, as only the Database
+      // invalidates statements, and clears this cache when it does.
+      DCHECK(it->second->is_valid());
+      sqlite3_reset(it->second->stmt());
+      return it->second;
+    }
+    // The statement is in use, for instance by an enclosing loop over the
+    // results of the same SQL. Prepare another one, which is not kept.
+    return GetStatementImpl(this, sql);
+  }
+
+  scoped_refptr<StatementRef> statement = GetStatementImpl(this, sql);
+  if (statement->is_valid())
+    unique_statement_cache_.Put(sql, statement);
+  return statement;
 }
 
 scoped_refptr<Database::StatementRef> Database::GetStatementImpl(
@@ -1242,6 +1323,19 @@ scoped_refptr<Database::StatementRef> Database::GetStatementImpl(
                                             true);
 }
 
+void Database::FlushStatementStats(StatementRef* ref) {
+  if (!ref->step_count_)
+    return;
+  if (memory_dump_provider_ && ref->is_valid()) {
+    memory_dump_provider_->RecordStatementStats(
+        sqlite3_sql(ref->stmt()), ref->step_count_, ref->row_count_,
+        ref->step_time_);
+  }
+  ref->step_count_ = 0;
+  ref->row_count_ = 0;
+  ref->step_time_ = base::TimeDelta();
+}
+
 scoped_refptr<Database::StatementRef> Database::GetUntrackedStatement(
     const char* sql) const {
   return GetStatementImpl(nullptr, sql);
@@ -1488,7 +1582,15 @@ bool Database::OpenInternal(const std::string& file_name,
   // TRUNCATE should be faster than DELETE because it won't need directory
   // changes for each transaction.  PERSIST may break the spirit of using
   // secure_delete.
-  ignore_result(Execute("PRAGMA journal_mode=TRUNCATE"));
+  //
+  // WAL mode needs shared memory, which the Fuchsia VFS does not support.
+#if defined(OS_FUCHSIA)
+  const bool want_wal_mode = false;
+#else
+  const bool want_wal_mode = wal_mode_;
+#endif
+  if (!want_wal_mode)
+    ignore_result(Execute("PRAGMA journal_mode=TRUNCATE"));
 
   const base::TimeDelta kBusyTimeout =
       base::TimeDelta::FromSeconds(kBusyTimeoutSeconds);
@@ -1503,6 +1605,22 @@ bool Database::OpenInternal(const std::string& file_name,
     ignore_result(ExecuteWithTimeout(cache_size_sql.c_str(), kBusyTimeout));
   }
 
+  // Switching to WAL writes the header of a new database, so this follows
+  // setting the page size. The mode in effect is returned, which stays
+  // "memory" for in-memory databases.
+  wal_mode_enabled_ = false;
+  if (want_wal_mode) {
+    Statement s(GetUniqueStatement("PRAGMA journal_mode=WAL"));
+    wal_mode_enabled_ = s.Step() && s.ColumnString(0) == "wal";
+  }
+  if (wal_mode_enabled_) {
+    // In WAL mode, NORMAL only syncs at checkpoints and is still safe from
+    // corruption.
+    ignore_result(Execute("PRAGMA synchronous=NORMAL"));
+    // This replaces SQLite's own hook, which checkpoints inside the commit.
+    sqlite3_wal_hook(db_, &Database::OnWALCommit, this);
+  }
+
   static_assert(SQLITE_SECURE_DELETE == 1,
                 "Chrome assumes secure_delete is on by default.");
 
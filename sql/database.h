@@ -17,12 +17,15 @@
 #include "base/compiler_specific.h"
 #include "base/component_export.h"
 #include "base/containers/flat_map.h"
+#include "base/containers/mru_cache.h"
 #include "base/gtest_prod_util.h"
 #include "base/macros.h"
 #include "base/memory/ref_counted.h"
+#include "base/memory/weak_ptr.h"
 #include "base/optional.h"
 #include "base/sequence_checker.h"
 #include "base/threading/scoped_blocking_call.h"
+#include "base/time/time.h"
 #include "sql/internal_api_token.h"
 #include "sql/statement_id.h"
 
@@ -100,6 +103,21 @@ class COMPONENT_EXPORT(SQL) Database {
   // This must be called before Open() to have an effect.
   void set_exclusive_locking() { exclusive_locking_ = true; }
 
+  // Call to use write-ahead logging (WAL) instead of a rollback journal, for
+  // databases that commit often. A commit then appends to the -wal file
+  // without syncing it (synchronous=NORMAL), and the log is copied back into
+  // the database by checkpoints, which are the only operations that sync. A
+  // power failure can lose the last commits, but does not corrupt the
+  // database.
+  //
+  // Checkpoints run once the log reaches kWALCheckpointPages pages. They are
+  // posted as tasks to the current sequence if it has a task runner, rather
+  // than being run by the commit that grew the log.
+  //
+  // This must be called before Open() to have an effect. WAL mode is not
+  // supported on Fuchsia, where this does nothing.
+  void set_wal_mode() { wal_mode_ = true; }
+
   // Call to use alternative status-tracking for mmap.  Usually this is tracked
   // in the meta table, but some databases have no meta table.
   // TODO(shess): Maybe just have all databases use the alt option?
@@ -238,6 +256,10 @@ class COMPONENT_EXPORT(SQL) Database {
   // everything else.
   void Preload();
 
+  // Copies the contents of the write-ahead log into the database and empties
+  // the log. Returns false if the database is not in WAL mode, or on error.
+  bool CheckpointDatabase();
+
   // Release all non-essential memory associated with this database connection.
   void TrimMemory();
 
@@ -389,9 +411,14 @@ class COMPONENT_EXPORT(SQL) Database {
   // valid SQL, returns true.
   bool IsSQLValid(const char* sql);
 
-  // Returns a non-cached statement for the given SQL. Use this for SQL that
-  // is only executed once or only rarely (there is overhead associated with
-  // keeping a statement cached).
+  // Returns a statement for the given SQL that is not kept in the cache used
+  // by GetCachedStatement(). Use this for SQL that is only executed once or
+  // only rarely.
+  //
+  // The last kMaxUniqueStatementCacheSize statements prepared by this method
+  // are kept, keyed by their SQL, and a statement that is not in use is reused
+  // rather than prepared again. This helps callers that run the same SQL in a
+  // loop without GetCachedStatement().
   //
   // See GetCachedStatement above for examples and error information.
   scoped_refptr<StatementRef> GetUniqueStatement(const char* sql);
@@ -486,6 +513,13 @@ class COMPONENT_EXPORT(SQL) Database {
   // Guaranteed to match SQLITE_DEFAULT_PAGE_SIZE.
   static constexpr int kDefaultPageSize = 4096;
 
+  // Number of statements kept by GetUniqueStatement() for reuse.
+  static constexpr size_t kMaxUniqueStatementCacheSize = 32;
+
+  // Size of the write-ahead log, in pages, at which a database opened with
+  // set_wal_mode() is checkpointed. Matches SQLite's default.
+  static constexpr int kWALCheckpointPages = 1000;
+
   // Internal state accessed by other classes in //sql.
   sqlite3* db(InternalApiToken) const { return db_; }
   bool poisoned(InternalApiToken) const { return poisoned_; }
@@ -503,6 +537,7 @@ class COMPONENT_EXPORT(SQL) Database {
   FRIEND_TEST_ALL_PREFIXES(SQLDatabaseTest, GetAppropriateMmapSize);
   FRIEND_TEST_ALL_PREFIXES(SQLDatabaseTest, GetAppropriateMmapSizeAltStatus);
   FRIEND_TEST_ALL_PREFIXES(SQLDatabaseTest, OnMemoryDump);
+  FRIEND_TEST_ALL_PREFIXES(SQLDatabaseTest, StatementStatsInMemoryDump);
   FRIEND_TEST_ALL_PREFIXES(SQLDatabaseTest, RegisterIntentToUpload);
   FRIEND_TEST_ALL_PREFIXES(SQLiteFeaturesTest, WALNoClose);
 
@@ -582,6 +617,15 @@ class COMPONENT_EXPORT(SQL) Database {
     // this will return nullptr.
     sqlite3_stmt* stmt() const { return stmt_; }
 
+    // Counts a call to sqlite3_step() that took |step_time|, for the
+    // statistics reported in memory dumps. See Database::FlushStatementStats().
+    void RecordStep(bool returned_row, base::TimeDelta step_time) {
+      ++step_count_;
+      if (returned_row)
+        ++row_count_;
+      step_time_ += step_time;
+    }
+
     // Destroys the compiled statement and sets it to nullptr. The statement
     // will no longer be active. |forced| is used to indicate if
     // orderly-shutdown checks should apply (see Database::RazeAndClose()).
@@ -597,6 +641,7 @@ class COMPONENT_EXPORT(SQL) Database {
 
    private:
     friend class base::RefCounted<StatementRef>;
+    friend class Database;
 
     ~StatementRef();
 
@@ -604,6 +649,11 @@ class COMPONENT_EXPORT(SQL) Database {
     sqlite3_stmt* stmt_;
     bool was_valid_;
 
+    // Counted by RecordStep() since the last FlushStatementStats().
+    int step_count_ = 0;
+    int row_count_ = 0;
+    base::TimeDelta step_time_;
+
     DISALLOW_COPY_AND_ASSIGN(StatementRef);
   };
   friend class StatementRef;
@@ -657,6 +707,11 @@ class COMPONENT_EXPORT(SQL) Database {
   // which do not participate in the total-rows-changed tracking.
   void ReleaseCacheMemoryIfNeeded(bool implicit_change_performed);
 
+  // Adds the steps counted by |ref| to the statistics of its SQL in
+  // |memory_dump_provider_|, and resets the counts. Called by Statement when
+  // it is reset.
+  void FlushStatementStats(StatementRef* ref);
+
   // Returns the results of sqlite3_db_filename(), which should match the path
   // passed to Open().
   base::FilePath DbPath() const;
@@ -677,6 +732,17 @@ class COMPONENT_EXPORT(SQL) Database {
   // the file should only be read through once.
   size_t GetAppropriateMmapSize();
 
+  // Installed with sqlite3_wal_hook() in WAL mode. Called by SQLite after
+  // each commit with the number of pages in the write-ahead log of the
+  // |db_name| database.
+  static int OnWALCommit(void* database,
+                         sqlite3* db,
+                         const char* db_name,
+                         int wal_pages);
+
+  // Runs a checkpoint that was posted by OnWALCommit().
+  void RunScheduledCheckpoint();
+
   // Helpers for GetAppropriateMmapSize().
   bool GetMmapAltStatus(int64_t* status);
   bool SetMmapAltStatus(int64_t status);
@@ -690,6 +756,13 @@ class COMPONENT_EXPORT(SQL) Database {
   int page_size_;
   int cache_size_;
   bool exclusive_locking_;
+  bool wal_mode_;
+
+  // |true| if the database was opened in WAL mode.
+  bool wal_mode_enabled_;
+
+  // |true| while a task posted by OnWALCommit() has not run yet.
+  bool checkpoint_scheduled_;
 
   // Holds references to all cached statements so they remain active.
   //
@@ -698,6 +771,11 @@ class COMPONENT_EXPORT(SQL) Database {
   // throughout a process' lifetime.
   base::flat_map<StatementID, scoped_refptr<StatementRef>> statement_cache_;
 
+  // Statements prepared by GetUniqueStatement(), keyed by their SQL. A
+  // statement is reused only if this holds its only reference.
+  base::MRUCache<std::string, scoped_refptr<StatementRef>>
+      unique_statement_cache_;
+
   // A list of all StatementRefs we've given out. Each ref must register with
   // us when it's created or destroyed. This allows us to potentially close
   // any open statements when we encounter an error.
@@ -746,6 +824,8 @@ class COMPONENT_EXPORT(SQL) Database {
   // Stores the dump provider object when db is open.
   std::unique_ptr<DatabaseMemoryDumpProvider> memory_dump_provider_;
 
+  base::WeakPtrFactory<Database> weak_factory_;
+
   DISALLOW_COPY_AND_ASSIGN(Database);
 };
 
@@ -6,6 +6,7 @@
 
 #include <inttypes.h>
 
+#include "base/hash/hash.h"
 #include "base/strings/stringprintf.h"
 #include "base/trace_event/process_memory_dump.h"
 #include "third_party/sqlite/sqlite3.h"
@@ -23,6 +24,8 @@ void DatabaseMemoryDumpProvider::ResetDatabase() {
   db_ = nullptr;
 }
 
+constexpr size_t DatabaseMemoryDumpProvider::kMaxStatementStats;
+
 bool DatabaseMemoryDumpProvider::OnMemoryDump(
     const base::trace_event::MemoryDumpArgs& args,
     base::trace_event::ProcessMemoryDump* pmd) {
@@ -50,6 +53,29 @@ bool DatabaseMemoryDumpProvider::OnMemoryDump(
   dump->AddScalar("statement_size",
                   base::trace_event::MemoryAllocatorDump::kUnitsBytes,
                   statement_size);
+
+  if (args.level_of_detail ==
+      base::trace_event::MemoryDumpLevelOfDetail::DETAILED) {
+    base::AutoLock lock(lock_);
+    for (const auto& sql_and_stats : statement_stats_) {
+      const std::string& sql = sql_and_stats.first;
+      const StatementStats& stats = sql_and_stats.second;
+      base::trace_event::MemoryAllocatorDump* statement_dump =
+          pmd->CreateAllocatorDump(
+              base::StringPrintf("%s/statement_0x%08X",
+                                 FormatDumpName().c_str(),
+                                 base::PersistentHash(sql)));
+      statement_dump->AddString("sql", "", sql);
+      statement_dump->AddScalar(
+          "step_count", base::trace_event::MemoryAllocatorDump::kUnitsObjects,
+          stats.step_count);
+      statement_dump->AddScalar(
+          "row_count", base::trace_event::MemoryAllocatorDump::kUnitsObjects,
+          stats.row_count);
+      statement_dump->AddScalar("step_time_us", "microseconds",
+                                stats.step_time.InMicroseconds());
+    }
+  }
   return true;
 }
 
@@ -71,6 +97,23 @@ bool DatabaseMemoryDumpProvider::ReportMemoryUsage(
   return true;
 }
 
+void DatabaseMemoryDumpProvider::RecordStatementStats(
+    const char* sql,
+    int step_count,
+    int row_count,
+    base::TimeDelta step_time) {
+  base::AutoLock lock(lock_);
+  auto it = statement_stats_.find(sql);
+  if (it == statement_stats_.end()) {
+    if (statement_stats_.size() >= kMaxStatementStats)
+      return;
+    it = statement_stats_.emplace(sql, StatementStats()).first;
+  }
+  it->second.step_count += step_count;
+  it->second.row_count += row_count;
+  it->second.step_time += step_time;
+}
+
 bool DatabaseMemoryDumpProvider::GetDbMemoryUsage(int* cache_size,
                                                   int* schema_size,
                                                   int* statement_size) {
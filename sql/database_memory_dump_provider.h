@@ -5,10 +5,14 @@
 #ifndef SQL_DATABASE_MEMORY_DUMP_PROVIDER_H_
 #define SQL_DATABASE_MEMORY_DUMP_PROVIDER_H_
 
+#include <stdint.h>
+
+#include <map>
 #include <string>
 
 #include "base/macros.h"
 #include "base/synchronization/lock.h"
+#include "base/time/time.h"
 #include "base/trace_event/memory_dump_provider.h"
 
 struct sqlite3;
@@ -39,7 +43,23 @@ class DatabaseMemoryDumpProvider
   bool ReportMemoryUsage(base::trace_event::ProcessMemoryDump* pmd,
                          const std::string& dump_name);
 
+  // Adds to the statistics of the statement with the text |sql|, which are
+  // reported in detailed memory dumps so that slow statements can be found.
+  // At most kMaxStatementStats statements are tracked.
+  void RecordStatementStats(const char* sql,
+                            int step_count,
+                            int row_count,
+                            base::TimeDelta step_time);
+
+  static constexpr size_t kMaxStatementStats = 256;
+
  private:
+  struct StatementStats {
+    uint64_t step_count = 0;
+    uint64_t row_count = 0;
+    base::TimeDelta step_time;
+  };
+
   bool GetDbMemoryUsage(int* cache_size, int* schema_size, int* statement_size);
 
   std::string FormatDumpName() const;
@@ -47,6 +67,8 @@ class DatabaseMemoryDumpProvider
   sqlite3* db_;  // not owned.
   base::Lock lock_;
   std::string connection_name_;
+  // Keyed by the SQL of the statement.
+  std::map<std::string, StatementStats> statement_stats_;
 
   DISALLOW_COPY_AND_ASSIGN(DatabaseMemoryDumpProvider);
 };
@@ -5,6 +5,8 @@
 #include <stddef.h>
 #include <stdint.h>
 
+#include <utility>
+
 #include "base/bind.h"
 #include "base/files/file_util.h"
 #include "base/files/scoped_file.h"
@@ -12,9 +14,11 @@
 #include "base/logging.h"
 #include "base/macros.h"
 #include "base/strings/string_number_conversions.h"
+#include "base/strings/stringprintf.h"
 #include "base/test/gtest_util.h"
 #include "base/test/metrics/histogram_tester.h"
 #include "base/test/scoped_feature_list.h"
+#include "base/test/scoped_task_environment.h"
 #include "base/trace_event/process_memory_dump.h"
 #include "build/build_config.h"
 #include "sql/database.h"
@@ -1047,6 +1051,62 @@ TEST_F(SQLDatabaseTest, OnMemoryDump) {
   EXPECT_GE(pmd.allocator_dumps().size(), 1u);
 }
 
+TEST_F(SQLDatabaseTest, StatementStatsInMemoryDump) {
+  ASSERT_TRUE(db().Execute("CREATE TABLE foo (a)"));
+  ASSERT_TRUE(db().Execute("INSERT INTO foo VALUES (1), (2), (3)"));
+  const char kSelectSql[] = "SELECT a FROM foo";
+  for (int i = 0; i < 2; ++i) {
+    Statement s(db().GetUniqueStatement(kSelectSql));
+    while (s.Step()) {
+    }
+  }
+
+  base::trace_event::MemoryDumpArgs args = {
+      base::trace_event::MemoryDumpLevelOfDetail::DETAILED};
+  base::trace_event::ProcessMemoryDump pmd(args);
+  ASSERT_TRUE(db().memory_dump_provider_->OnMemoryDump(args, &pmd));
+  const base::trace_event::MemoryAllocatorDump* statement_dump = nullptr;
+  for (const auto& name_and_dump : pmd.allocator_dumps()) {
+    for (const auto& entry : name_and_dump.second->entries()) {
+      if (entry.name == "sql" && entry.value_string == kSelectSql)
+        statement_dump = name_and_dump.second.get();
+    }
+  }
+  ASSERT_TRUE(statement_dump);
+  for (const auto& entry : statement_dump->entries()) {
+    // Each run steps over the 3 rows, then once more to reach the end.
+    if (entry.name == "step_count")
+      EXPECT_EQ(8u, entry.value_uint64);
+    if (entry.name == "row_count")
+      EXPECT_EQ(6u, entry.value_uint64);
+  }
+}
+
+TEST_F(SQLDatabaseTest, UniqueStatementReuse) {
+  const char kSql[] = "SELECT 1";
+  auto ref1 = db().GetUniqueStatement(kSql);
+  ASSERT_TRUE(ref1->is_valid());
+
+  // A statement that is in use is not handed out again.
+  auto ref2 = db().GetUniqueStatement(kSql);
+  ASSERT_TRUE(ref2->is_valid());
+  EXPECT_NE(ref1->stmt(), ref2->stmt());
+
+  // Once unused, the first statement is reused. The second was not kept.
+  sqlite3_stmt* stmt1 = ref1->stmt();
+  ref1 = nullptr;
+  ref2 = nullptr;
+  {
+    Statement s(db().GetUniqueStatement(kSql));
+    ASSERT_TRUE(s.Step());
+    EXPECT_EQ(1, s.ColumnInt(0));
+    auto ref3 = db().GetUniqueStatement(kSql);
+    EXPECT_NE(stmt1, ref3->stmt());
+  }
+  auto ref4 = db().GetUniqueStatement(kSql);
+  EXPECT_EQ(stmt1, ref4->stmt());
+}
+
 // Test that the functions to collect diagnostic data run to completion, without
 // worrying too much about what they generate (since that will change).
 TEST_F(SQLDatabaseTest, CollectDiagnosticInfo) {
@@ -1253,4 +1313,121 @@ TEST_F(SQLDatabaseTest, SqlTempMemoryFeatureFlagEnabled) {
       << "temp_store should be set by the feature flag SqlTempStoreMemory";
 }
 
+// WAL mode needs shared memory, which the Fuchsia VFS does not support.
+#if !defined(OS_FUCHSIA)
+TEST_F(SQLDatabaseTest, WALMode) {
+  db().Close();
+  db().set_wal_mode();
+  ASSERT_TRUE(db().Open(db_path()));
+  EXPECT_EQ("wal", ExecuteWithResult(&db(), "PRAGMA journal_mode"));
+  // NORMAL.
+  EXPECT_EQ("1", ExecuteWithResult(&db(), "PRAGMA synchronous"));
+
+  // Other databases keep using a rollback journal.
+  Database other_db;
+  ASSERT_TRUE(other_db.Open(db_path().AddExtension(FILE_PATH_LITERAL("2"))));
+  EXPECT_EQ("truncate", ExecuteWithResult(&other_db, "PRAGMA journal_mode"));
+  EXPECT_FALSE(other_db.CheckpointDatabase());
+}
+
+// The page size of a new database is kept in WAL mode.
+TEST_F(SQLDatabaseTest, WALModePageSize) {
+  db().Close();
+  sql::Database::Delete(db_path());
+  db().set_wal_mode();
+  db().set_page_size(1024);
+  ASSERT_TRUE(db().Open(db_path()));
+  ASSERT_TRUE(db().Execute("CREATE TABLE foo (a)"));
+  EXPECT_EQ("1024", ExecuteWithResult(&db(), "PRAGMA page_size"));
+  EXPECT_EQ("wal", ExecuteWithResult(&db(), "PRAGMA journal_mode"));
+}
+
+// Committed transactions survive a crash, and uncommitted ones are rolled
+// back, with and without WAL mode. A crash is simulated by copying the files
+// of a database that is still open.
+TEST_F(SQLDatabaseTest, CrashSafety) {
+  for (bool wal_mode : {false, true}) {
+    SCOPED_TRACE(wal_mode);
+    db().Close();
+    sql::Database::Delete(db_path());
+    if (wal_mode)
+      db().set_wal_mode();
+    ASSERT_TRUE(db().Open(db_path()));
+    ASSERT_TRUE(db().Execute("CREATE TABLE foo (a)"));
+
+    ASSERT_TRUE(db().BeginTransaction());
+    ASSERT_TRUE(db().Execute("INSERT INTO foo VALUES (1)"));
+    ASSERT_TRUE(db().CommitTransaction());
+    ASSERT_TRUE(db().BeginTransaction());
+    ASSERT_TRUE(db().Execute("INSERT INTO foo VALUES (2)"));
+
+    const base::FilePath crash_path =
+        db_path().DirName().AppendASCII("crash.sqlite");
+    sql::Database::Delete(crash_path);
+    ASSERT_TRUE(base::CopyFile(db_path(), crash_path));
+    for (const auto& paths :
+         {std::make_pair(Database::JournalPath(db_path()),
+                         Database::JournalPath(crash_path)),
+          std::make_pair(Database::WriteAheadLogPath(db_path()),
+                         Database::WriteAheadLogPath(crash_path))}) {
+      if (GetPathExists(paths.first))
+        ASSERT_TRUE(base::CopyFile(paths.first, paths.second));
+    }
+    db().RollbackTransaction();
+
+    Database crash_db;
+    ASSERT_TRUE(crash_db.Open(crash_path));
+    EXPECT_EQ("ok", ExecuteWithResult(&crash_db, "PRAGMA integrity_check"));
+    EXPECT_EQ("1", ExecuteWithResults(&crash_db, "SELECT a FROM foo", "|",
+                                      "\n"));
+    crash_db.Close();
+    sql::Database::Delete(crash_path);
+  }
+}
+
+TEST_F(SQLDatabaseTest, WALCheckpoint) {
+  db().Close();
+  db().set_wal_mode();
+  ASSERT_TRUE(db().Open(db_path()));
+  ASSERT_TRUE(db().Execute("CREATE TABLE foo (a)"));
+  ASSERT_TRUE(db().Execute("INSERT INTO foo VALUES (1)"));
+
+  const base::FilePath wal_path = Database::WriteAheadLogPath(db_path());
+  int64_t wal_size = 0;
+  ASSERT_TRUE(base::GetFileSize(wal_path, &wal_size));
+  EXPECT_GT(wal_size, 0);
+
+  EXPECT_TRUE(db().CheckpointDatabase());
+  ASSERT_TRUE(base::GetFileSize(wal_path, &wal_size));
+  EXPECT_EQ(0, wal_size);
+  EXPECT_EQ("1", ExecuteWithResult(&db(), "SELECT a FROM foo"));
+}
+
+// A write-ahead log that reaches kWALCheckpointPages is checkpointed by a task
+// posted to the current sequence, not by the commit.
+TEST_F(SQLDatabaseTest, WALScheduledCheckpoint) {
+  base::test::ScopedTaskEnvironment task_environment;
+  db().Close();
+  sql::Database::Delete(db_path());
+  db().set_wal_mode();
+  ASSERT_TRUE(db().Open(db_path()));
+  ASSERT_TRUE(db().Execute("CREATE TABLE foo (a)"));
+
+  const int kBlobSize =
+      Database::kWALCheckpointPages * Database::kDefaultPageSize;
+  const std::string insert_sql =
+      base::StringPrintf("INSERT INTO foo VALUES (zeroblob(%d))", kBlobSize);
+  ASSERT_TRUE(db().Execute(insert_sql.c_str()));
+
+  // The database file does not have the blob until the checkpoint.
+  int64_t db_size = 0;
+  ASSERT_TRUE(base::GetFileSize(db_path(), &db_size));
+  EXPECT_LT(db_size, kBlobSize);
+
+  task_environment.RunUntilIdle();
+  ASSERT_TRUE(base::GetFileSize(db_path(), &db_size));
+  EXPECT_GT(db_size, kBlobSize);
+}
+#endif  // !defined(OS_FUCHSIA)
+
 }  // namespace sql
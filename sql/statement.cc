@@ -11,6 +11,7 @@
 #include "base/numerics/safe_conversions.h"
 #include "base/strings/string_util.h"
 #include "base/strings/utf_string_conversions.h"
+#include "base/time/time.h"
 #include "third_party/sqlite/sqlite3.h"
 
 namespace sql {
@@ -61,7 +62,9 @@ int Statement::StepInternal() {
   ref_->InitScopedBlockingCall(&scoped_blocking_call);
 
   stepped_ = true;
+  const base::TimeTicks start = base::TimeTicks::Now();
   int ret = sqlite3_step(ref_->stmt());
+  ref_->RecordStep(ret == SQLITE_ROW, base::TimeTicks::Now() - start);
   return CheckError(ret);
 }
 
@@ -90,8 +93,10 @@ void Statement::Reset(bool clear_bound_vars) {
 
   // Potentially release dirty cache pages if an autocommit statement made
   // changes.
-  if (ref_->database())
+  if (ref_->database()) {
+    ref_->database()->FlushStatementStats(ref_.get());
     ref_->database()->ReleaseCacheMemoryIfNeeded(false);
+  }
 
   succeeded_ = false;
   stepped_ = false;
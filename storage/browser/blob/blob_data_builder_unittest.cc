@@ -4,9 +4,12 @@
 
 #include "storage/browser/blob/blob_data_builder.h"
 
+#include <algorithm>
 #include <string>
+#include <vector>
 
 #include "base/logging.h"
+#include "base/test/scoped_feature_list.h"
 #include "testing/gtest/include/gtest/gtest.h"
 
 namespace storage {
@@ -25,4 +28,29 @@ TEST(BlobDataBuilderTest, TestFutureFiles) {
   EXPECT_EQ(kFileId, builder.items()[0]->item()->GetFutureFileID());
 }
 
+TEST(BlobDataBuilderTest, LargeBytesInSharedMemory) {
+  base::test::ScopedFeatureList feature_list;
+  feature_list.InitAndEnableFeature(kBlobBytesInSharedMemory);
+
+  std::vector<char> data(2 * 1024 * 1024);
+  for (size_t i = 0; i < data.size(); ++i)
+    data[i] = static_cast<char>(i);
+
+  auto small_item = BlobDataItem::CreateBytes(base::make_span(data.data(), 10));
+  EXPECT_FALSE(small_item->DuplicateBytesRegion().IsValid());
+
+  auto item = BlobDataItem::CreateBytes(data);
+  ASSERT_EQ(data.size(), item->length());
+  EXPECT_TRUE(std::equal(data.begin(), data.end(), item->bytes().begin()));
+
+  // The region can be mapped to read the bytes without copying the item.
+  base::ReadOnlySharedMemoryRegion region = item->DuplicateBytesRegion();
+  ASSERT_TRUE(region.IsValid());
+  base::ReadOnlySharedMemoryMapping mapping = region.Map();
+  ASSERT_TRUE(mapping.IsValid());
+  ASSERT_GE(mapping.size(), data.size());
+  EXPECT_TRUE(std::equal(data.begin(), data.end(),
+                         mapping.GetMemoryAs<const char>()));
+}
+
 }  // namespace storage
@@ -14,9 +14,16 @@
 
 namespace storage {
 
+const base::Feature kBlobBytesInSharedMemory{"BlobBytesInSharedMemory",
+                                             base::FEATURE_DISABLED_BY_DEFAULT};
+
 namespace {
 const base::FilePath::CharType kFutureFileName[] =
     FILE_PATH_LITERAL("_future_name_");
+
+// Smaller items stay on the heap, as every shared memory region holds a file
+// descriptor or handle.
+constexpr uint64_t kMinSharedMemoryBytes = 1024 * 1024;
 }
 
 bool BlobDataItem::DataHandle::IsValid() {
@@ -29,7 +36,8 @@ scoped_refptr<BlobDataItem> BlobDataItem::CreateBytes(
     base::span<const char> bytes) {
   auto item =
       base::WrapRefCounted(new BlobDataItem(Type::kBytes, 0, bytes.size()));
-  item->bytes_.assign(bytes.begin(), bytes.end());
+  item->AllocateBytesStorage();
+  std::copy(bytes.begin(), bytes.end(), item->mutable_bytes().begin());
   return item;
 }
 
@@ -129,23 +137,48 @@ BlobDataItem::BlobDataItem(Type type, uint64_t offset, uint64_t length)
 
 BlobDataItem::~BlobDataItem() = default;
 
+base::ReadOnlySharedMemoryRegion BlobDataItem::DuplicateBytesRegion() const {
+  DCHECK_EQ(type_, Type::kBytes);
+  return shared_bytes_region_.Duplicate();
+}
+
+void BlobDataItem::AllocateBytesStorage() {
+  if (length_ >= kMinSharedMemoryBytes &&
+      base::FeatureList::IsEnabled(kBlobBytesInSharedMemory)) {
+    base::MappedReadOnlyRegion mapped =
+        base::ReadOnlySharedMemoryRegion::Create(static_cast<size_t>(length_));
+    if (mapped.IsValid()) {
+      shared_bytes_region_ = std::move(mapped.region);
+      shared_bytes_mapping_ = std::move(mapped.mapping);
+      return;
+    }
+    // Fall back to the heap if the region can't be created.
+  }
+  bytes_.resize(length_);
+}
+
 void BlobDataItem::AllocateBytes() {
   DCHECK_EQ(type_, Type::kBytesDescription);
-  bytes_.resize(length_);
   type_ = Type::kBytes;
+  AllocateBytesStorage();
 }
 
 void BlobDataItem::PopulateBytes(base::span<const char> data) {
   DCHECK_EQ(type_, Type::kBytesDescription);
   DCHECK_EQ(length_, data.size());
   type_ = Type::kBytes;
-  bytes_.assign(data.begin(), data.end());
+  AllocateBytesStorage();
+  std::copy(data.begin(), data.end(), mutable_bytes().begin());
 }
 
 void BlobDataItem::ShrinkBytes(size_t new_length) {
   DCHECK_EQ(type_, Type::kBytes);
+  DCHECK_LE(new_length, length_);
   length_ = new_length;
-  bytes_.resize(length_);
+  // A shared memory region keeps its size; only its first |length_| bytes
+  // belong to the item.
+  if (!shared_bytes_mapping_.IsValid())
+    bytes_.resize(length_);
 }
 
 void BlobDataItem::PopulateFile(base::FilePath path,
@@ -13,8 +13,11 @@
 
 #include "base/component_export.h"
 #include "base/containers/span.h"
+#include "base/feature_list.h"
 #include "base/files/file_path.h"
+#include "base/memory/read_only_shared_memory_region.h"
 #include "base/memory/ref_counted.h"
+#include "base/memory/shared_memory_mapping.h"
 #include "url/gurl.h"
 
 namespace disk_cache {
@@ -26,6 +29,11 @@ class BlobDataBuilder;
 class BlobStorageContext;
 class FileSystemContext;
 
+// When enabled, the bytes of large memory-backed items are kept in read-only
+// shared memory regions that readers can map instead of copying.
+COMPONENT_EXPORT(STORAGE_BROWSER)
+extern const base::Feature kBlobBytesInSharedMemory;
+
 // Ref counted blob item. This class owns the backing data of the blob item. The
 // backing data is immutable, and cannot change after creation. The purpose of
 // this class is to allow the resource to stick around in the snapshot even
@@ -91,9 +99,19 @@ class COMPONENT_EXPORT(STORAGE_BROWSER) BlobDataItem
 
   base::span<const char> bytes() const {
     DCHECK_EQ(type_, Type::kBytes);
+    if (shared_bytes_mapping_.IsValid()) {
+      return base::make_span(shared_bytes_mapping_.GetMemoryAs<const char>(),
+                             static_cast<size_t>(length_));
+    }
     return base::make_span(bytes_);
   }
 
+  // Returns a read-only region whose first length() bytes are bytes(), so
+  // that a reader in this or another process can map them instead of copying
+  // them out of the item. Returns an invalid region unless the bytes are kept
+  // in shared memory; see kBlobBytesInSharedMemory.
+  base::ReadOnlySharedMemoryRegion DuplicateBytesRegion() const;
+
   const base::FilePath& path() const {
     DCHECK_EQ(type_, Type::kFile);
     return path_;
@@ -158,9 +176,16 @@ class COMPONENT_EXPORT(STORAGE_BROWSER) BlobDataItem
 
   base::span<char> mutable_bytes() {
     DCHECK_EQ(type_, Type::kBytes);
+    if (shared_bytes_mapping_.IsValid()) {
+      return base::make_span(shared_bytes_mapping_.GetMemoryAs<char>(),
+                             static_cast<size_t>(length_));
+    }
     return base::make_span(bytes_);
   }
 
+  // Allocates zeroed storage for length() bytes, in shared memory if the item
+  // is large enough and kBlobBytesInSharedMemory is enabled.
+  void AllocateBytesStorage();
   void AllocateBytes();
   void PopulateBytes(base::span<const char> data);
   void ShrinkBytes(size_t new_length);
@@ -180,6 +205,10 @@ class COMPONENT_EXPORT(STORAGE_BROWSER) BlobDataItem
   uint64_t length_;
 
   std::vector<char> bytes_;  // For Type::kBytes.
+  // For Type::kBytes kept in shared memory, instead of |bytes_|. The mapping
+  // is the browser's writable view of the read-only |shared_bytes_region_|.
+  base::ReadOnlySharedMemoryRegion shared_bytes_region_;
+  base::WritableSharedMemoryMapping shared_bytes_mapping_;
   base::FilePath path_;      // For Type::kFile.
   GURL filesystem_url_;      // For Type::kFileFilesystem.
   base::Time
@@ -64,4 +64,39 @@ TEST_F(PendingInvalidationsTest, ScheduleOnDocumentNode) {
   EXPECT_EQ(2u, after_count - before_count);
 }
 
+TEST_F(PendingInvalidationsTest, SameSetOnNestedElements) {
+  GetDocument().body()->SetInnerHTMLFromString(
+      "<div id='outer'><div id='inner'><span></span><b></b></div>"
+      "<span></span></div><span></span>");
+  GetDocument().View()->UpdateAllLifecyclePhases(
+      DocumentLifecycle::LifecycleUpdateReason::kTest);
+
+  unsigned before_count = GetStyleEngine().StyleForElementCount();
+
+  scoped_refptr<DescendantInvalidationSet> set =
+      DescendantInvalidationSet::Create();
+  set->AddTagName("span");
+
+  // Schedule the same set on an element and on one of its descendants, like
+  // a class change on both of them would.
+  InvalidationLists lists;
+  lists.descendants.push_back(set);
+  Element* outer = GetDocument().getElementById("outer");
+  Element* inner = GetDocument().getElementById("inner");
+  GetPendingNodeInvalidations().ScheduleInvalidationSetsForNode(lists, *outer);
+  GetPendingNodeInvalidations().ScheduleInvalidationSetsForNode(lists, *inner);
+
+  GetStyleEngine().InvalidateStyle();
+
+  EXPECT_FALSE(outer->NeedsStyleInvalidation());
+  EXPECT_FALSE(inner->NeedsStyleInvalidation());
+  EXPECT_FALSE(GetDocument().ChildNeedsStyleInvalidation());
+
+  GetDocument().View()->UpdateAllLifecyclePhases(
+      DocumentLifecycle::LifecycleUpdateReason::kTest);
+  // Only the two spans inside #outer are recalculated.
+  unsigned after_count = GetStyleEngine().StyleForElementCount();
+  EXPECT_EQ(2u, after_count - before_count);
+}
+
 }  // namespace blink
@@ -70,6 +70,12 @@ void StyleInvalidator::PushInvalidationSet(
   DCHECK(!invalidation_flags_.WholeSubtreeInvalid());
   DCHECK(!invalidation_set.WholeSubtreeInvalid());
   DCHECK(!invalidation_set.IsEmpty());
+  // Class mutations on many elements of a subtree typically schedule the same
+  // shared set on each of them. If an ancestor already pushed it, matching
+  // descendants against it again cannot invalidate anything more, and the
+  // flags it sets are already set.
+  if (invalidation_sets_.Contains(&invalidation_set))
+    return;
   if (invalidation_set.CustomPseudoInvalid())
     invalidation_flags_.SetInvalidateCustomPseudo(true);
   if (invalidation_set.TreeBoundaryCrossing())
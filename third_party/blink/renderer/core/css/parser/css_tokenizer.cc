@@ -380,24 +380,22 @@ CSSParserToken CSSTokenizer::ConsumeIdentLikeToken() {
 // https://drafts.csswg.org/css-syntax/#consume-a-string-token
 CSSParserToken CSSTokenizer::ConsumeStringTokenUntil(UChar ending_code_point) {
   // Strings without escapes get handled without allocations
-  for (unsigned size = 0;; size++) {
-    UChar cc = input_.PeekWithoutReplacement(size);
-    if (cc == ending_code_point) {
-      unsigned start_offset = input_.Offset();
-      input_.Advance(size + 1);
-      return CSSParserToken(kStringToken, input_.RangeAt(start_offset, size));
-    }
-    if (IsCSSNewLine(cc)) {
-      input_.Advance(size);
-      return CSSParserToken(kBadStringToken);
-    }
-    if (cc == '\0' || cc == '\\')
-      break;
+  unsigned size = input_.SkipStringCharacters(ending_code_point);
+  UChar cc = input_.PeekWithoutReplacement(size);
+  if (cc == ending_code_point) {
+    unsigned start_offset = input_.Offset();
+    input_.Advance(size + 1);
+    return CSSParserToken(kStringToken, input_.RangeAt(start_offset, size));
+  }
+  if (IsCSSNewLine(cc)) {
+    input_.Advance(size);
+    return CSSParserToken(kBadStringToken);
   }
+  DCHECK(cc == '\0' || cc == '\\');
 
   StringBuilder output;
   while (true) {
-    UChar cc = Consume();
+    cc = Consume();
     if (cc == ending_code_point || cc == kEndOfFileMarker)
       return CSSParserToken(kStringToken, RegisterString(output.ToString()));
     if (IsCSSNewLine(cc)) {
@@ -521,18 +519,7 @@ void CSSTokenizer::ConsumeSingleWhitespaceIfNext() {
 }
 
 void CSSTokenizer::ConsumeUntilCommentEndFound() {
-  UChar c = Consume();
-  while (true) {
-    if (c == kEndOfFileMarker)
-      return;
-    if (c != '*') {
-      c = Consume();
-      continue;
-    }
-    c = Consume();
-    if (c == '/')
-      return;
-  }
+  input_.AdvancePastCommentEnd();
 }
 
 bool CSSTokenizer::ConsumeIfNext(UChar character) {
@@ -550,17 +537,13 @@ bool CSSTokenizer::ConsumeIfNext(UChar character) {
 // http://www.w3.org/TR/css3-syntax/#consume-a-name
 StringView CSSTokenizer::ConsumeName() {
   // Names without escapes get handled without allocations
-  for (unsigned size = 0;; ++size) {
-    UChar cc = input_.PeekWithoutReplacement(size);
-    if (IsNameCodePoint(cc))
-      continue;
-    // peekWithoutReplacement will return NUL when we hit the end of the
-    // input. In that case we want to still use the rangeAt() fast path
-    // below.
-    if (cc == '\0' && input_.Offset() + size < input_.length())
-      break;
-    if (cc == '\\')
-      break;
+  unsigned size = input_.SkipNameCodePoints(0);
+  UChar cc = input_.PeekWithoutReplacement(size);
+  // peekWithoutReplacement will return NUL when we hit the end of the
+  // input. In that case we want to still use the rangeAt() fast path
+  // below.
+  bool is_nul = cc == '\0' && input_.Offset() + size < input_.length();
+  if (!is_nul && cc != '\\') {
     unsigned start_offset = input_.Offset();
     input_.Advance(size);
     return input_.RangeAt(start_offset, size);
@@ -4,24 +4,235 @@
 
 #include "third_party/blink/renderer/core/css/parser/css_tokenizer_input_stream.h"
 
+#include "base/bits.h"
+#include "build/build_config.h"
+#include "third_party/blink/renderer/core/css/parser/css_parser_idioms.h"
 #include "third_party/blink/renderer/core/html/parser/html_parser_idioms.h"
 #include "third_party/blink/renderer/platform/wtf/text/string_to_number.h"
 
+#if defined(ARCH_CPU_X86_FAMILY)
+#include <emmintrin.h>
+#elif defined(ARCH_CPU_ARM64)
+#include <arm_neon.h>
+#endif
+
 namespace blink {
 
+namespace {
+
+// Long runs of whitespace, names, strings and comments in 8-bit style sheets
+// are scanned 16 characters at a time where SSE2 or NEON is available. Style
+// sheets are rarely 16-bit, so those are scanned one character at a time.
+#if defined(ARCH_CPU_X86_FAMILY) || defined(ARCH_CPU_ARM64)
+#define CSS_TOKENIZER_SCAN_BLOCKS 1
+constexpr wtf_size_t kBlockSize = 16;
+#endif
+
+#if defined(ARCH_CPU_X86_FAMILY)
+using Block = __m128i;
+
+inline Block LoadBlock(const LChar* characters) {
+  return _mm_loadu_si128(reinterpret_cast<const __m128i*>(characters));
+}
+inline Block Splat(LChar c) {
+  return _mm_set1_epi8(static_cast<char>(c));
+}
+inline Block Equal(Block block, LChar c) {
+  return _mm_cmpeq_epi8(block, Splat(c));
+}
+inline Block Or(Block a, Block b) {
+  return _mm_or_si128(a, b);
+}
+// |low| and |high| must be ASCII, which makes the signed comparisons correct.
+inline Block InRange(Block block, LChar low, LChar high) {
+  return _mm_and_si128(_mm_cmpgt_epi8(block, Splat(low - 1)),
+                       _mm_cmplt_epi8(block, Splat(high + 1)));
+}
+inline Block NonASCII(Block block) {
+  return _mm_cmplt_epi8(block, _mm_setzero_si128());
+}
+inline Block Not(Block mask) {
+  return _mm_cmpeq_epi8(mask, _mm_setzero_si128());
+}
+// Returns the index of the first character for which |mask| is not set, or
+// kBlockSize if there is none.
+inline wtf_size_t FirstUnset(Block mask) {
+  unsigned bits = _mm_movemask_epi8(mask) ^ 0xFFFF;
+  return bits ? base::bits::CountTrailingZeroBits(bits) : kBlockSize;
+}
+#elif defined(ARCH_CPU_ARM64)
+using Block = uint8x16_t;
+
+inline Block LoadBlock(const LChar* characters) {
+  return vld1q_u8(characters);
+}
+inline Block Splat(LChar c) {
+  return vdupq_n_u8(c);
+}
+inline Block Equal(Block block, LChar c) {
+  return vceqq_u8(block, Splat(c));
+}
+inline Block Or(Block a, Block b) {
+  return vorrq_u8(a, b);
+}
+inline Block InRange(Block block, LChar low, LChar high) {
+  return vandq_u8(vcgeq_u8(block, Splat(low)), vcleq_u8(block, Splat(high)));
+}
+inline Block NonASCII(Block block) {
+  return vcgeq_u8(block, Splat(0x80));
+}
+inline Block Not(Block mask) {
+  return vmvnq_u8(mask);
+}
+inline wtf_size_t FirstUnset(Block mask) {
+  Block unset = vmvnq_u8(mask);
+  if (!vmaxvq_u8(unset))
+    return kBlockSize;
+  // Narrow each character of the mask to four bits of a 64-bit word.
+  uint64_t bits = vget_lane_u64(
+      vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(unset), 4)), 0);
+  return base::bits::CountTrailingZeroBits(bits) / 4;
+}
+#endif
+
+// The predicates below test a single character, and, for 8-bit strings, all
+// characters of a block at once.
+struct IsWhitespace {
+  bool operator()(UChar c) const { return IsHTMLSpace<UChar>(c); }
+#if defined(CSS_TOKENIZER_SCAN_BLOCKS)
+  Block operator()(Block block) const {
+    return Or(Or(Or(Equal(block, ' '), Equal(block, '\t')),
+                 Or(Equal(block, '\n'), Equal(block, '\r'))),
+              Equal(block, '\f'));
+  }
+#endif
+};
+
+struct IsNameCharacter {
+  bool operator()(UChar c) const { return IsNameCodePoint(c); }
+#if defined(CSS_TOKENIZER_SCAN_BLOCKS)
+  Block operator()(Block block) const {
+    // Setting 0x20 maps upper case letters to lower case, and no other ASCII
+    // character to a letter.
+    Block letters = InRange(Or(block, Splat(0x20)), 'a', 'z');
+    Block digits = InRange(block, '0', '9');
+    return Or(Or(Or(letters, digits), NonASCII(block)),
+              Or(Equal(block, '_'), Equal(block, '-')));
+  }
+#endif
+};
+
+struct IsStringCharacter {
+  bool operator()(UChar c) const {
+    return c != ending_code_point && !IsCSSNewLine(c) && c != '\\' && c != '\0';
+  }
+#if defined(CSS_TOKENIZER_SCAN_BLOCKS)
+  Block operator()(Block block) const {
+    return Not(Or(Or(Or(Equal(block, static_cast<LChar>(ending_code_point)),
+                        Equal(block, '\\')),
+                     Or(Equal(block, '\n'), Equal(block, '\r'))),
+                  Or(Equal(block, '\f'), Equal(block, '\0'))));
+  }
+#endif
+
+  UChar ending_code_point;
+};
+
+struct IsNotAsterisk {
+  bool operator()(UChar c) const { return c != '*'; }
+#if defined(CSS_TOKENIZER_SCAN_BLOCKS)
+  Block operator()(Block block) const { return Not(Equal(block, '*')); }
+#endif
+};
+
+// Returns the offset of the first character at or after |offset| for which
+// |predicate| is false, or |length| if there is none.
+template <typename CharacterType, typename Predicate>
+wtf_size_t SkipWhile(const CharacterType* characters,
+                     wtf_size_t offset,
+                     wtf_size_t length,
+                     const Predicate& predicate) {
+  while (offset < length && predicate(characters[offset]))
+    ++offset;
+  return offset;
+}
+
+#if defined(CSS_TOKENIZER_SCAN_BLOCKS)
+template <typename Predicate>
+wtf_size_t SkipWhile(const LChar* characters,
+                     wtf_size_t offset,
+                     wtf_size_t length,
+                     const Predicate& predicate) {
+  for (; offset < length && length - offset >= kBlockSize;
+       offset += kBlockSize) {
+    wtf_size_t index = FirstUnset(predicate(LoadBlock(characters + offset)));
+    if (index < kBlockSize)
+      return offset + index;
+  }
+  return SkipWhile<LChar, Predicate>(characters, offset, length, predicate);
+}
+#endif
+
+}  // namespace
+
 CSSTokenizerInputStream::CSSTokenizerInputStream(const String& input)
     : offset_(0), string_length_(input.length()), string_(input.Impl()) {}
 
 void CSSTokenizerInputStream::AdvanceUntilNonWhitespace() {
   // Using HTML space here rather than CSS space since we don't do preprocessing
   if (string_->Is8Bit()) {
-    const LChar* characters = string_->Characters8();
-    while (offset_ < string_length_ && IsHTMLSpace(characters[offset_]))
-      ++offset_;
+    offset_ = SkipWhile(string_->Characters8(), offset_, string_length_,
+                        IsWhitespace());
   } else {
-    const UChar* characters = string_->Characters16();
-    while (offset_ < string_length_ && IsHTMLSpace(characters[offset_]))
+    offset_ = SkipWhile(string_->Characters16(), offset_, string_length_,
+                        IsWhitespace());
+  }
+}
+
+unsigned CSSTokenizerInputStream::SkipNameCodePoints(
+    unsigned lookahead_offset) const {
+  wtf_size_t offset = offset_ + lookahead_offset;
+  if (string_->Is8Bit()) {
+    offset = SkipWhile(string_->Characters8(), offset, string_length_,
+                       IsNameCharacter());
+  } else {
+    offset = SkipWhile(string_->Characters16(), offset, string_length_,
+                       IsNameCharacter());
+  }
+  return offset - offset_;
+}
+
+unsigned CSSTokenizerInputStream::SkipStringCharacters(
+    UChar ending_code_point) const {
+  DCHECK(IsASCII(ending_code_point));
+  wtf_size_t offset;
+  if (string_->Is8Bit()) {
+    offset = SkipWhile(string_->Characters8(), offset_, string_length_,
+                       IsStringCharacter{ending_code_point});
+  } else {
+    offset = SkipWhile(string_->Characters16(), offset_, string_length_,
+                       IsStringCharacter{ending_code_point});
+  }
+  return offset - offset_;
+}
+
+void CSSTokenizerInputStream::AdvancePastCommentEnd() {
+  while (offset_ < string_length_) {
+    if (string_->Is8Bit()) {
+      offset_ = SkipWhile(string_->Characters8(), offset_, string_length_,
+                          IsNotAsterisk());
+    } else {
+      offset_ = SkipWhile(string_->Characters16(), offset_, string_length_,
+                          IsNotAsterisk());
+    }
+    if (offset_ == string_length_)
+      return;
+    // Skip the '*', and the '/' if it follows.
+    ++offset_;
+    if (offset_ < string_length_ && (*string_)[offset_] == '/') {
       ++offset_;
+      return;
+    }
   }
 }
 
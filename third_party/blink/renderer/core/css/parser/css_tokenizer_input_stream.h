@@ -63,6 +63,16 @@ class CSSTokenizerInputStream {
 
   void AdvanceUntilNonWhitespace();
 
+  // Returns the lookahead offset of the first character at or after
+  // |lookahead_offset| which is not a name code point.
+  unsigned SkipNameCodePoints(unsigned lookahead_offset) const;
+  // Returns the lookahead offset of the first character which may end the
+  // body of a string ending with |ending_code_point|: the ending code point
+  // itself, a newline, an escape or NUL.
+  unsigned SkipStringCharacters(UChar ending_code_point) const;
+  // Advances past the next "*/", or to the end of the stream.
+  void AdvancePastCommentEnd();
+
   unsigned length() const { return string_length_; }
   unsigned Offset() const { return std::min(offset_, string_length_); }
 
@@ -461,6 +461,33 @@ TEST(CSSTokenizerTest, CommentToken) {
   TEST_TOKENS(";/******", Semicolon());
 }
 
+String Repeat(char c, unsigned count) {
+  StringBuilder builder;
+  for (unsigned i = 0; i < count; ++i)
+    builder.Append(c);
+  return builder.ToString();
+}
+
+TEST(CSSTokenizerTest, LongRuns) {
+  // Runs longer than the blocks which 8-bit input is scanned in, with the
+  // character ending them at different positions within a block.
+  for (unsigned length = 14; length < 50; ++length) {
+    String run = Repeat('a', length);
+    String name = "-" + run.UpperASCII() + "_9\xe9";
+    TEST_TOKENS(run + " b", Ident(run), Whitespace(), Ident("b"));
+    TEST_TOKENS(name + "(", Func(name));
+    TEST_TOKENS(run + "\\62 ", Ident(run + "b"));
+    TEST_TOKENS("'" + run + "'", GetString(run));
+    TEST_TOKENS("\"" + run + "'\"", GetString(run + "'"));
+    TEST_TOKENS("'" + run + "\\62 '", GetString(run + "b"));
+    TEST_TOKENS("'" + run + "\n'", BadString(), Whitespace(), GetString(""));
+    TEST_TOKENS("'" + run, GetString(run));
+    TEST_TOKENS("/*" + run + "*" + run + "**/a", Ident("a"));
+    TEST_TOKENS("a/*" + run, Ident("a"));
+    TEST_TOKENS(Repeat(' ', length) + "\t\r\n\fa", Whitespace(), Ident("a"));
+  }
+}
+
 typedef struct {
   const char* input;
   const unsigned max_level;
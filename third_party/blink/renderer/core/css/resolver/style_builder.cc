@@ -79,12 +79,19 @@ void StyleBuilder::ApplyProperty(const CSSProperty& property,
             id, value, omit_animation_tainted);
     ApplyProperty(property, state, *resolved_value);
 
-    if (!state.Style()->HasVariableReferenceFromNonInheritedProperty() &&
-        !is_inherited)
+    if (is_inherited) {
+      if (!state.Style()->HasVariableReferenceFromInheritedProperty())
+        state.Style()->SetHasVariableReferenceFromInheritedProperty();
+    } else if (!state.Style()->HasVariableReferenceFromNonInheritedProperty()) {
       state.Style()->SetHasVariableReferenceFromNonInheritedProperty();
+    }
     return;
   }
 
+  if (id == CSSPropertyID::kVariable &&
+      !state.Style()->HasVariableDeclaration())
+    state.Style()->SetHasVariableDeclaration();
+
   DCHECK(!property.IsShorthand())
       << "Shorthand property id = " << static_cast<int>(id)
       << " wasn't expanded at parsing time";
@@ -49,6 +49,7 @@ void StyleResolverStats::Reset() {
   pseudo_elements_styled = 0;
   base_styles_used = 0;
   independent_inherited_styles_propagated = 0;
+  inherited_variables_propagated = 0;
   custom_properties_applied = 0;
 }
 
@@ -72,6 +73,8 @@ std::unique_ptr<TracedValue> StyleResolverStats::ToTracedValue() const {
   traced_value->SetInteger("baseStylesUsed", base_styles_used);
   traced_value->SetInteger("independentInheritedStylesPropagated",
                            independent_inherited_styles_propagated);
+  traced_value->SetInteger("inheritedVariablesPropagated",
+                           inherited_variables_propagated);
   traced_value->SetInteger("customPropertiesApplied",
                            custom_properties_applied);
   return traced_value;
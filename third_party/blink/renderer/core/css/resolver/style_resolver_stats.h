@@ -62,6 +62,7 @@ class StyleResolverStats {
   unsigned pseudo_elements_styled;
   unsigned base_styles_used;
   unsigned independent_inherited_styles_propagated;
+  unsigned inherited_variables_propagated;
   unsigned custom_properties_applied;
 };
 
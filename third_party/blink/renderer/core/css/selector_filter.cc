@@ -32,12 +32,30 @@
 
 #include "third_party/blink/renderer/core/css/css_selector.h"
 #include "third_party/blink/renderer/core/dom/document.h"
+#include "third_party/blink/renderer/core/html_names.h"
 
 namespace blink {
 
 // Salt to separate otherwise identical string hashes so a class-selector like
 // .article won't match <article> elements.
-enum { kTagNameSalt = 13, kIdAttributeSalt = 17, kClassAttributeSalt = 19 };
+enum {
+  kTagNameSalt = 13,
+  kIdAttributeSalt = 17,
+  kClassAttributeSalt = 19,
+  kAttributeSalt = 29
+};
+
+// The style attribute is synchronized lazily, so an ancestor may have one which
+// is not in its attributes yet. Rules requiring it are never fast rejected.
+static inline bool IsExcludedAttribute(const AtomicString& name) {
+  return name == html_names::kStyleAttr.LocalName();
+}
+
+// Attribute selectors match names ASCII case-insensitively for non-HTML
+// attributes in HTML documents, so hash the lower-case name on both sides.
+static inline unsigned AttributeHash(const AtomicString& name) {
+  return name.LowerASCII().Impl()->ExistingHash() * kAttributeSalt;
+}
 
 static inline void CollectElementIdentifierHashes(
     const Element& element,
@@ -60,6 +78,15 @@ static inline void CollectElementIdentifierHashes(
                                     kClassAttributeSalt);
     }
   }
+  // Animated SVG attributes are synchronized lazily as well, so make sure they
+  // are all present.
+  AttributeCollection attributes = element.IsSVGElement()
+                                       ? element.Attributes()
+                                       : element.AttributesWithoutUpdate();
+  for (const Attribute& attribute : attributes) {
+    if (!IsExcludedAttribute(attribute.LocalName()))
+      identifier_hashes.push_back(AttributeHash(attribute.LocalName()));
+  }
 }
 
 void SelectorFilter::PushParentStackFrame(Element& parent) {
@@ -140,6 +167,16 @@ static inline void CollectDescendantSelectorIdentifierHashes(
         (*hash++) = selector.TagQName().LocalName().Impl()->ExistingHash() *
                     kTagNameSalt;
       break;
+    case CSSSelector::kAttributeExact:
+    case CSSSelector::kAttributeSet:
+    case CSSSelector::kAttributeHyphen:
+    case CSSSelector::kAttributeList:
+    case CSSSelector::kAttributeContain:
+    case CSSSelector::kAttributeBegin:
+    case CSSSelector::kAttributeEnd:
+      if (!IsExcludedAttribute(selector.Attribute().LocalName()))
+        (*hash++) = AttributeHash(selector.Attribute().LocalName());
+      break;
     default:
       break;
   }
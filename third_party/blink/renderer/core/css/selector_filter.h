@@ -83,9 +83,10 @@ class CORE_EXPORT SelectorFilter {
 
   HeapVector<ParentStackFrame> parent_stack_;
 
-  // With 100 unique strings in the filter, 2^12 slot table has false positive
-  // rate of ~0.2%.
-  using IdentifierFilter = BloomFilter<12>;
+  // With 300 unique strings in the filter, 2^14 slot table has false positive
+  // rate of ~0.1%. Markup styled with utility classes easily puts that many
+  // tag names, ids, classes and attribute names on the ancestor chain.
+  using IdentifierFilter = BloomFilter<14>;
   std::unique_ptr<IdentifierFilter> ancestor_identifier_filter_;
   DISALLOW_COPY_AND_ASSIGN(SelectorFilter);
 };
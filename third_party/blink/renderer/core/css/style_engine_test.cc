@@ -34,6 +34,7 @@
 #include "third_party/blink/renderer/core/testing/dummy_page_holder.h"
 #include "third_party/blink/renderer/platform/geometry/float_size.h"
 #include "third_party/blink/renderer/platform/heap/heap.h"
+#include "third_party/blink/renderer/platform/testing/runtime_enabled_features_test_helpers.h"
 
 namespace blink {
 
@@ -1625,6 +1626,36 @@ TEST_F(StyleEngineTest, RejectSelectorForPseudoElement) {
   EXPECT_EQ(2u, stats->rules_fast_rejected);
 }
 
+TEST_F(StyleEngineTest, RejectSelectorForAncestorAttribute) {
+  GetDocument().body()->SetInnerHTMLFromString(R"HTML(
+    <style>
+      [data-theme=dark] span { color: red }
+      [DATA-MODE] span { color: red }
+      [style] span { color: green }
+    </style>
+    <div data-mode><span></span></div>
+  )HTML");
+  UpdateAllLifecyclePhases();
+
+  StyleEngine& engine = GetStyleEngine();
+  engine.SetStatsEnabled(true);
+
+  StyleResolverStats* stats = engine.Stats();
+  ASSERT_TRUE(stats);
+
+  Element* span = GetDocument().QuerySelector("span");
+  ASSERT_TRUE(span);
+  span->SetInlineStyleProperty(CSSPropertyID::kColor, "blue");
+
+  GetDocument().Lifecycle().AdvanceTo(DocumentLifecycle::kInStyleRecalc);
+  GetStyleEngine().RecalcStyle({});
+
+  // Only the rule requiring a data-theme ancestor is fast rejected. The
+  // attribute names of [DATA-MODE] are compared case-insensitively, and rules
+  // requiring a style attribute are never fast rejected.
+  EXPECT_EQ(1u, stats->rules_fast_rejected);
+}
+
 TEST_F(StyleEngineTest, MarkForWhitespaceReattachment) {
   GetDocument().body()->SetInnerHTMLFromString(R"HTML(
     <div id=d1><span></span></div>
@@ -1887,4 +1918,44 @@ TEST_F(StyleEngineTest, EnsureCustomComputedStyle) {
   }
 }
 
+TEST_F(StyleEngineTest, PropagateInheritedVariables) {
+  ScopedCSSInheritedVariablesPropagationForTest scoped_feature(true);
+
+  GetDocument().body()->SetInnerHTMLFromString(R"HTML(
+    <style>
+      #root { --fg: red }
+      #root.dark { --fg: green }
+      .themed { color: var(--fg) }
+    </style>
+    <div id=root>
+      <div id=plain><span id=nested class=themed></span></div>
+      <div id=themed class=themed></div>
+    </div>
+  )HTML");
+  UpdateAllLifecyclePhases();
+
+  StyleEngine& engine = GetStyleEngine();
+  engine.SetStatsEnabled(true);
+  StyleResolverStats* stats = engine.Stats();
+  ASSERT_TRUE(stats);
+
+  GetDocument().getElementById("root")->setAttribute(
+      blink::html_names::kClassAttr, "dark");
+  UpdateAllLifecyclePhases();
+
+  // Only #plain neither declares nor references custom properties, so only its
+  // style is propagated, but the elements referencing --fg are updated.
+  EXPECT_EQ(1u, stats->inherited_variables_propagated);
+  EXPECT_EQ(MakeRGB(0, 128, 0), GetDocument()
+                                    .getElementById("nested")
+                                    ->GetComputedStyle()
+                                    ->VisitedDependentColor(
+                                        GetCSSPropertyColor()));
+  EXPECT_EQ(MakeRGB(0, 128, 0), GetDocument()
+                                    .getElementById("themed")
+                                    ->GetComputedStyle()
+                                    ->VisitedDependentColor(
+                                        GetCSSPropertyColor()));
+}
+
 }  // namespace blink
@@ -27,6 +27,11 @@ class StyleRecalcChange {
     // inherited properties can be propagated (PropagateInheritedProperties)
     // instead of a full rule matching.
     kIndependentInherit,
+    // Need to recalculate style for children because inherited custom
+    // properties changed. Children which neither declare nor reference custom
+    // properties can take the new variables from the parent
+    // (PropagateInheritedVariables) instead of a full rule matching.
+    kInheritedVariables,
     // Need to recalculate style for children, typically for inheritance.
     kRecalcChildren,
     // Need to recalculate style for all descendants.
@@ -61,6 +66,7 @@ class StyleRecalcChange {
   bool RecalcDescendants() const { return propagate_ == kRecalcDescendants; }
   bool UpdatePseudoElements() const { return propagate_ != kNo; }
   bool IndependentInherit() const { return propagate_ == kIndependentInherit; }
+  bool InheritedVariables() const { return propagate_ == kInheritedVariables; }
   bool TraverseChildren(const Node&) const;
   bool TraverseChild(const Node&) const;
   bool TraversePseudoElements(const Node&) const;
@@ -337,11 +337,7 @@ void StyleSheetContents::ParseAuthorStyleSheet(
   String sheet_text =
       cached_style_sheet->SheetText(parser_context_, mime_type_check);
 
-  source_map_url_ = response.HttpHeaderField(http_names::kSourceMap);
-  if (source_map_url_.IsEmpty()) {
-    // Try to get deprecated header.
-    source_map_url_ = response.HttpHeaderField(http_names::kXSourceMap);
-  }
+  source_map_url_ = cached_style_sheet->SourceMapURL();
 
   const CSSParserContext* context =
       CSSParserContext::CreateWithStyleSheetContents(ParserContext(), this);
@@ -2451,6 +2451,31 @@ scoped_refptr<ComputedStyle> Element::PropagateInheritedProperties() {
   return new_style;
 }
 
+scoped_refptr<ComputedStyle> Element::PropagateInheritedVariables() {
+  if (IsPseudoElement())
+    return nullptr;
+  if (NeedsStyleRecalc())
+    return nullptr;
+  if (HasAnimations())
+    return nullptr;
+  const ComputedStyle* parent_style = ParentComputedStyle();
+  DCHECK(parent_style);
+  const ComputedStyle* style = GetComputedStyle();
+  if (!style || style->Animations() || style->Transitions())
+    return nullptr;
+  // The computed values of declared custom properties and of properties with
+  // var() references may depend on the changed variables.
+  if (style->HasVariableDeclaration() ||
+      style->HasVariableReferenceFromInheritedProperty() ||
+      style->HasVariableReferenceFromNonInheritedProperty())
+    return nullptr;
+  scoped_refptr<ComputedStyle> new_style = ComputedStyle::Clone(*style);
+  new_style->PropagateInheritedVariables(*parent_style);
+  INCREMENT_STYLE_STATS_COUNTER(GetDocument().GetStyleEngine(),
+                                inherited_variables_propagated, 1);
+  return new_style;
+}
+
 static const StyleRecalcChange ApplyComputedStyleDiff(
     const StyleRecalcChange change,
     ComputedStyle::Difference diff) {
@@ -2463,6 +2488,8 @@ static const StyleRecalcChange ApplyComputedStyleDiff(
     return change.EnsureAtLeast(StyleRecalcChange::kRecalcChildren);
   if (diff == ComputedStyle::Difference::kIndependentInherited)
     return change.EnsureAtLeast(StyleRecalcChange::kIndependentInherit);
+  if (diff == ComputedStyle::Difference::kInheritedVariables)
+    return change.EnsureAtLeast(StyleRecalcChange::kInheritedVariables);
   DCHECK(diff == ComputedStyle::Difference::kPseudoStyle);
   return change.EnsureAtLeast(StyleRecalcChange::kUpdatePseudoElements);
 }
@@ -2508,6 +2535,10 @@ StyleRecalcChange Element::RecalcOwnStyle(const StyleRecalcChange change) {
       // recalc if the only changed properties are independent. In this case, we
       // can simply clone the old ComputedStyle and set these directly.
       new_style = PropagateInheritedProperties();
+    } else if (old_style && change.InheritedVariables()) {
+      // Likewise, when only inherited custom properties changed, elements
+      // which don't use custom properties keep the rest of their style.
+      new_style = PropagateInheritedVariables();
     }
     if (!new_style)
       new_style = StyleForLayoutObject(child_change.CalcInvisible());
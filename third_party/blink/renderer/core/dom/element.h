@@ -1011,6 +1011,12 @@ class CORE_EXPORT Element : public ContainerNode {
   // and returns the new style. Otherwise, returns null.
   scoped_refptr<ComputedStyle> PropagateInheritedProperties();
 
+  // Similarly, if the only inherited changes in the parent element are custom
+  // properties, and this element neither declares nor references custom
+  // properties, returns the current style with the parent's custom properties.
+  // Otherwise, returns null.
+  scoped_refptr<ComputedStyle> PropagateInheritedVariables();
+
   // Recalculate the ComputedStyle for this element and return a
   // StyleRecalcChange for propagation/traversal into child nodes.
   StyleRecalcChange RecalcOwnStyle(const StyleRecalcChange);
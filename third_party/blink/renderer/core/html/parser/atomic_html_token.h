@@ -152,19 +152,16 @@ class CORE_EXPORT AtomicHTMLToken {
       case HTMLToken::kEndOfFile:
         break;
       case HTMLToken::kStartTag:
+        // The background parser already dropped duplicate attributes.
         attributes_.ReserveInitialCapacity(token.Attributes().size());
         for (const CompactHTMLToken::Attribute& attribute :
              token.Attributes()) {
-          QualifiedName name(g_null_atom, AtomicString(attribute.GetName()),
-                             g_null_atom);
-          // FIXME: This is N^2 for the number of attributes.
-          if (!FindAttributeInVector(attributes_, name)) {
-            attributes_.push_back(
-                Attribute(name, AtomicString(attribute.Value())));
-          } else {
-            duplicate_attribute_ = true;
-          }
+          attributes_.push_back(Attribute(
+              QualifiedName(g_null_atom, AtomicString(attribute.GetName()),
+                            g_null_atom),
+              AtomicString(attribute.Value())));
         }
+        duplicate_attribute_ = token.HasDuplicateAttribute();
         FALLTHROUGH;
       case HTMLToken::kEndTag:
         self_closing_ = token.SelfClosing();
@@ -25,6 +25,8 @@
 
 #include "third_party/blink/renderer/core/html/parser/compact_html_token.h"
 
+#include <algorithm>
+
 #include "third_party/blink/renderer/core/dom/qualified_name.h"
 #include "third_party/blink/renderer/core/html/parser/html_parser_idioms.h"
 
@@ -40,11 +42,26 @@ struct SameSizeAsCompactHTMLToken {
 static_assert(sizeof(CompactHTMLToken) == sizeof(SameSizeAsCompactHTMLToken),
               "CompactHTMLToken should stay small");
 
+namespace {
+
+// Hashes |string| ahead of time, as tag and attribute names and values are
+// atomized when the tree is built on the main thread. The hash is cached in
+// the StringImpl, which then moves to the main thread along with the token.
+void PrecomputeHash(const String& string) {
+  StringImpl* impl = string.Impl();
+  // Static strings are shared by all threads and already hashed.
+  if (impl && impl->length() && !impl->IsStatic())
+    impl->GetHash();
+}
+
+}  // namespace
+
 CompactHTMLToken::CompactHTMLToken(const HTMLToken* token,
                                    const TextPosition& text_position)
     : type_(token->GetType()),
       is_all8_bit_data_(false),
       doctype_forces_quirks_(false),
+      has_duplicate_attribute_(false),
       text_position_(text_position) {
   switch (type_) {
     case HTMLToken::kUninitialized:
@@ -65,10 +82,20 @@ CompactHTMLToken::CompactHTMLToken(const HTMLToken* token,
       break;
     case HTMLToken::kStartTag:
       attributes_.ReserveInitialCapacity(token->Attributes().size());
-      for (const HTMLToken::Attribute& attribute : token->Attributes())
+      for (const HTMLToken::Attribute& attribute : token->Attributes()) {
+        String name = attribute.NameAttemptStaticStringCreation();
+        if (std::any_of(attributes_.begin(), attributes_.end(),
+                        [&name](const Attribute& existing) {
+                          return existing.GetName() == name;
+                        })) {
+          has_duplicate_attribute_ = true;
+          continue;
+        }
         attributes_.push_back(
-            Attribute(attribute.NameAttemptStaticStringCreation(),
-                      attribute.Value8BitIfNecessary()));
+            Attribute(name, attribute.Value8BitIfNecessary()));
+        PrecomputeHash(attributes_.back().GetName());
+        PrecomputeHash(attributes_.back().Value());
+      }
       FALLTHROUGH;
     case HTMLToken::kEndTag:
       self_closing_ = token->SelfClosing();
@@ -78,6 +105,8 @@ CompactHTMLToken::CompactHTMLToken(const HTMLToken* token,
       is_all8_bit_data_ = token->IsAll8BitData();
       data_ = AttemptStaticStringCreation(
           token->Data(), token->IsAll8BitData() ? kForce8Bit : kForce16Bit);
+      if (type_ == HTMLToken::kStartTag || type_ == HTMLToken::kEndTag)
+        PrecomputeHash(data_);
       break;
     }
     default:
@@ -66,7 +66,11 @@ class CORE_EXPORT CompactHTMLToken {
   const String& Data() const { return data_; }
   bool SelfClosing() const { return self_closing_; }
   bool IsAll8BitData() const { return is_all8_bit_data_; }
+  // Attributes whose names appear earlier in the tag are dropped, as the
+  // first one wins. This is done on the parser thread so that the main thread
+  // doesn't need to look for them when it builds the tree.
   const Vector<Attribute>& Attributes() const { return attributes_; }
+  bool HasDuplicateAttribute() const { return has_duplicate_attribute_; }
   const Attribute* GetAttributeItem(const QualifiedName&) const;
   const TextPosition& GetTextPosition() const { return text_position_; }
 
@@ -81,6 +85,7 @@ class CORE_EXPORT CompactHTMLToken {
   unsigned self_closing_ : 1;
   unsigned is_all8_bit_data_ : 1;
   unsigned doctype_forces_quirks_ : 1;
+  unsigned has_duplicate_attribute_ : 1;
 
   String data_;  // "name", "characters", or "data" depending on type_
   Vector<Attribute> attributes_;
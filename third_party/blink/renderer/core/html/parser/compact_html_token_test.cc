@@ -41,4 +41,28 @@ TEST(CompactHTMLTokenTest, EmptyAttributeValueFromHTMLToken) {
   EXPECT_FALSE(attribute_d);
 }
 
+TEST(CompactHTMLTokenTest, DuplicateAttributes) {
+  // <a b=1 c=2 b=3>
+  HTMLToken token;
+  token.BeginStartTag('a');
+  const char kAttributes[][2] = {{'b', '1'}, {'c', '2'}, {'b', '3'}};
+  for (const auto& attribute : kAttributes) {
+    token.AddNewAttribute();
+    token.BeginAttributeName(3);
+    token.AppendToAttributeName(attribute[0]);
+    token.EndAttributeName(4);
+    token.BeginAttributeValue(5);
+    token.AppendToAttributeValue(attribute[1]);
+    token.EndAttributeValue(6);
+  }
+
+  CompactHTMLToken ctoken(&token, TextPosition());
+  EXPECT_TRUE(ctoken.HasDuplicateAttribute());
+  ASSERT_EQ(2u, ctoken.Attributes().size());
+  EXPECT_EQ("b", ctoken.Attributes()[0].GetName());
+  EXPECT_EQ("1", ctoken.Attributes()[0].Value());
+  EXPECT_EQ("c", ctoken.Attributes()[1].GetName());
+  EXPECT_EQ("2", ctoken.Attributes()[1].Value());
+}
+
 }  // namespace blink
@@ -26,9 +26,15 @@
 
 #include "third_party/blink/renderer/core/loader/resource/css_style_sheet_resource.h"
 
+#include <utility>
+
+#include "base/single_thread_task_runner.h"
 #include "services/network/public/mojom/request_context_frame_type.mojom-blink.h"
 #include "third_party/blink/renderer/core/css/style_sheet_contents.h"
 #include "third_party/blink/renderer/core/frame/web_feature.h"
+#include "third_party/blink/renderer/platform/cross_thread_functional.h"
+#include "third_party/blink/renderer/platform/heap/heap.h"
+#include "third_party/blink/renderer/platform/heap/persistent.h"
 #include "third_party/blink/renderer/platform/loader/fetch/fetch_parameters.h"
 #include "third_party/blink/renderer/platform/loader/fetch/memory_cache.h"
 #include "third_party/blink/renderer/platform/loader/fetch/resource_fetcher.h"
@@ -36,12 +42,38 @@
 #include "third_party/blink/renderer/platform/loader/fetch/text_resource_decoder_options.h"
 #include "third_party/blink/renderer/platform/network/http_names.h"
 #include "third_party/blink/renderer/platform/network/mime/mime_type_registry.h"
+#include "third_party/blink/renderer/platform/instrumentation/tracing/trace_event.h"
 #include "third_party/blink/renderer/platform/runtime_enabled_features.h"
+#include "third_party/blink/renderer/platform/scheduler/public/post_cross_thread_task.h"
+#include "third_party/blink/renderer/platform/scheduler/public/thread.h"
+#include "third_party/blink/renderer/platform/scheduler/public/worker_pool.h"
 #include "third_party/blink/renderer/platform/weborigin/security_policy.h"
+#include "third_party/blink/renderer/platform/wtf/text/string_builder.h"
 #include "third_party/blink/renderer/platform/wtf/text/text_encoding.h"
 
 namespace blink {
 
+namespace {
+
+// Sheets at least this large are decoded on a worker thread. Smaller ones are
+// decoded faster than the round trip to the worker takes.
+constexpr size_t kMinimumSizeToDecodeInBackground = 64 * 1024;
+
+// Parsed sheets of all CSSStyleSheetResources in the process, keyed by their
+// text. This lets documents share the parse of an identical sheet even when it
+// was fetched as a different resource, e.g. because the first one was not
+// stored in the memory cache.
+using SheetTextCache = HeapHashMap<String, WeakMember<StyleSheetContents>>;
+
+SheetTextCache& GetSheetTextCache() {
+  DCHECK(IsMainThread());
+  DEFINE_STATIC_LOCAL(Persistent<SheetTextCache>, cache,
+                      (MakeGarbageCollected<SheetTextCache>()));
+  return *cache;
+}
+
+}  // namespace
+
 CSSStyleSheetResource* CSSStyleSheetResource::Fetch(FetchParameters& params,
                                                     ResourceFetcher* fetcher,
                                                     ResourceClient* client) {
@@ -131,17 +163,78 @@ const String CSSStyleSheetResource::SheetText(
     return decoded_sheet_text_;
   }
 
-  if (!Data() || Data()->IsEmpty())
+  // The text is not available until the worker has decoded it.
+  if (is_decoding_in_background_ || !Data() || Data()->IsEmpty())
     return String();
 
   return DecodedText();
 }
 
+bool CSSStyleSheetResource::IsFinishedInternal() const {
+  return IsLoaded() && !is_decoding_in_background_;
+}
+
+bool CSSStyleSheetResource::CanUseCacheValidator() const {
+  if (is_decoding_in_background_)
+    return false;
+  return TextResource::CanUseCacheValidator();
+}
+
 void CSSStyleSheetResource::NotifyFinished() {
+  DCHECK(!is_decoding_in_background_);
+
+  // Parsing needs the heap and the atomic strings of the main thread, but the
+  // text can be decoded elsewhere. The decoder goes to the worker along with
+  // the data, as decoding finds out the encoding, e.g. from @charset.
+  if (Data() && Data()->size() >= kMinimumSizeToDecodeInBackground &&
+      RuntimeEnabledFeatures::OffMainThreadCSSDecodingEnabled()) {
+    is_decoding_in_background_ = true;
+    worker_pool::PostTask(
+        FROM_HERE,
+        CrossThreadBind(&CSSStyleSheetResource::DecodeInBackground,
+                        WTF::Passed(TakeDecoder()),
+                        WTF::Passed(Data()->CopyAs<Vector<char>>()),
+                        Thread::Current()->GetTaskRunner(),
+                        WrapCrossThreadPersistent(this)));
+    return;
+  }
+
   // Decode the data to find out the encoding and cache the decoded sheet text.
   if (Data())
     SetDecodedSheetText(DecodedText());
 
+  NotifyClientsFinished();
+}
+
+// static
+void CSSStyleSheetResource::DecodeInBackground(
+    std::unique_ptr<TextResourceDecoder> decoder,
+    Vector<char> data,
+    scoped_refptr<base::SingleThreadTaskRunner> task_runner,
+    CrossThreadPersistent<CSSStyleSheetResource> resource) {
+  TRACE_EVENT1("blink", "CSSStyleSheetResource::DecodeInBackground", "size",
+               data.size());
+  StringBuilder builder;
+  builder.Append(decoder->Decode(data.data(), data.size()));
+  builder.Append(decoder->Flush());
+  PostCrossThreadTask(
+      *task_runner, FROM_HERE,
+      CrossThreadBind(&CSSStyleSheetResource::DidDecodeInBackground,
+                      std::move(resource), WTF::Passed(std::move(decoder)),
+                      builder.ToString()));
+}
+
+void CSSStyleSheetResource::DidDecodeInBackground(
+    std::unique_ptr<TextResourceDecoder> decoder,
+    const String& decoded_sheet_text) {
+  DCHECK(is_decoding_in_background_);
+  ReturnDecoder(std::move(decoder));
+  is_decoding_in_background_ = false;
+  SetDecodedSheetText(decoded_sheet_text);
+  NotifyClientsFinished();
+}
+
+void CSSStyleSheetResource::NotifyClientsFinished() {
   Resource::NotifyFinished();
 
   // Clear raw bytes as now we have the full decoded sheet text.
@@ -210,10 +303,19 @@ bool CSSStyleSheetResource::CanUseSheet(const CSSParserContext* parser_context,
                                      "application/x-unknown-content-type");
 }
 
+String CSSStyleSheetResource::SourceMapURL() const {
+  String source_map_url = GetResponse().HttpHeaderField(http_names::kSourceMap);
+  if (source_map_url.IsEmpty()) {
+    // Try to get deprecated header.
+    source_map_url = GetResponse().HttpHeaderField(http_names::kXSourceMap);
+  }
+  return source_map_url;
+}
+
 StyleSheetContents* CSSStyleSheetResource::CreateParsedStyleSheetFromCache(
     const CSSParserContext* context) {
   if (!parsed_style_sheet_cache_)
-    return nullptr;
+    return CreateParsedStyleSheetFromTextCache(context);
   if (parsed_style_sheet_cache_->HasFailedOrCanceledSubresources()) {
     SetParsedStyleSheetCache(nullptr);
     return nullptr;
@@ -237,10 +339,51 @@ StyleSheetContents* CSSStyleSheetResource::CreateParsedStyleSheetFromCache(
   return parsed_style_sheet_cache_;
 }
 
+StyleSheetContents* CSSStyleSheetResource::CreateParsedStyleSheetFromTextCache(
+    const CSSParserContext* context) {
+  // Cacheable sheets have a valid CSS header, so they were parsed from the
+  // text returned by the strict MIME type check.
+  String sheet_text = SheetText(context, MIMETypeCheck::kStrict);
+  if (sheet_text.IsEmpty())
+    return nullptr;
+  auto it = GetSheetTextCache().find(sheet_text);
+  if (it == GetSheetTextCache().end())
+    return nullptr;
+  StyleSheetContents* sheet = it->value;
+  if (!sheet)
+    return nullptr;
+  // A sheet stops being cacheable once it is mutated in place through CSSOM,
+  // which its only client may do until the sheet is shared.
+  if (sheet->HasFailedOrCanceledSubresources() ||
+      !sheet->IsCacheableForResource()) {
+    GetSheetTextCache().erase(it);
+    return nullptr;
+  }
+
+  // As above, the contexts must be identical. This includes the base URL, so
+  // the sheets must have come from the same URL.
+  if (*sheet->ParserContext() != *context ||
+      sheet->SourceMapURL() != SourceMapURL())
+    return nullptr;
+
+  DCHECK(!sheet->IsLoading());
+
+  if (sheet->HasMediaQueries())
+    return sheet->Copy();
+
+  // Clients sharing the sheet must copy it before mutating it, see
+  // CSSStyleSheet::WillMutateRules().
+  sheet->SetIsUsedFromTextCache();
+  return sheet;
+}
+
 void CSSStyleSheetResource::SaveParsedStyleSheet(StyleSheetContents* sheet) {
   DCHECK(sheet);
   DCHECK(sheet->IsCacheableForResource());
 
+  if (!decoded_sheet_text_.IsEmpty())
+    GetSheetTextCache().Set(decoded_sheet_text_, sheet);
+
   if (!GetMemoryCache()->Contains(this)) {
     // This stylesheet resource did conflict with another resource and was not
     // added to the cache.
@@ -26,11 +26,19 @@
 #ifndef THIRD_PARTY_BLINK_RENDERER_CORE_LOADER_RESOURCE_CSS_STYLE_SHEET_RESOURCE_H_
 #define THIRD_PARTY_BLINK_RENDERER_CORE_LOADER_RESOURCE_CSS_STYLE_SHEET_RESOURCE_H_
 
+#include <memory>
+
+#include "base/memory/scoped_refptr.h"
 #include "third_party/blink/renderer/core/core_export.h"
 #include "third_party/blink/renderer/core/loader/resource/text_resource.h"
 #include "third_party/blink/renderer/platform/heap/handle.h"
 #include "third_party/blink/renderer/platform/loader/fetch/text_resource_decoder_options.h"
 #include "third_party/blink/renderer/platform/wtf/text/text_encoding.h"
+#include "third_party/blink/renderer/platform/wtf/vector.h"
+
+namespace base {
+class SingleThreadTaskRunner;
+}  // namespace base
 
 namespace blink {
 
@@ -61,9 +69,17 @@ class CORE_EXPORT CSSStyleSheetResource final : public TextResource {
 
   const String SheetText(const CSSParserContext*,
                          MIMETypeCheck = MIMETypeCheck::kStrict) const;
+  // Returns the sheet parsed earlier from this resource, or from another
+  // resource in the process with identical text, if it was parsed with an
+  // identical context.
   StyleSheetContents* CreateParsedStyleSheetFromCache(const CSSParserContext*);
   void SaveParsedStyleSheet(StyleSheetContents*);
   network::mojom::ReferrerPolicy GetReferrerPolicy() const;
+  String SourceMapURL() const;
+
+  // A sheet being decoded on a worker thread can't be revalidated, as that
+  // would replace its data under the decode. It is reloaded instead.
+  bool CanUseCacheValidator() const override;
 
  private:
   class CSSStyleSheetResourceFactory : public ResourceFactory {
@@ -82,9 +98,23 @@ class CORE_EXPORT CSSStyleSheetResource final : public TextResource {
   };
 
   bool CanUseSheet(const CSSParserContext*, MIMETypeCheck) const;
+  bool IsFinishedInternal() const override;
   void NotifyFinished() override;
 
+  // Large sheets are decoded on a worker thread, and the clients are only
+  // notified that the resource finished once the text is back.
+  static void DecodeInBackground(
+      std::unique_ptr<TextResourceDecoder>,
+      Vector<char> data,
+      scoped_refptr<base::SingleThreadTaskRunner>,
+      CrossThreadPersistent<CSSStyleSheetResource>);
+  void DidDecodeInBackground(std::unique_ptr<TextResourceDecoder>,
+                             const String& decoded_sheet_text);
+  void NotifyClientsFinished();
+
   void SetParsedStyleSheetCache(StyleSheetContents*);
+  StyleSheetContents* CreateParsedStyleSheetFromTextCache(
+      const CSSParserContext*);
   void SetDecodedSheetText(const String&);
 
   void DestroyDecodedDataIfPossible() override;
@@ -94,6 +124,7 @@ class CORE_EXPORT CSSStyleSheetResource final : public TextResource {
   // Decoded sheet text cache is available iff loading this CSS resource is
   // successfully complete.
   String decoded_sheet_text_;
+  bool is_decoding_in_background_ = false;
 
   Member<StyleSheetContents> parsed_style_sheet_cache_;
 };
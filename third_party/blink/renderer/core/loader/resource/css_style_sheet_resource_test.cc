@@ -5,6 +5,7 @@
 #include "third_party/blink/renderer/core/loader/resource/css_style_sheet_resource.h"
 
 #include <memory>
+#include <string>
 #include "base/memory/scoped_refptr.h"
 #include "testing/gtest/include/gtest/gtest.h"
 #include "third_party/blink/public/platform/platform.h"
@@ -24,13 +25,17 @@
 #include "third_party/blink/renderer/core/dom/document.h"
 #include "third_party/blink/renderer/core/loader/resource/image_resource.h"
 #include "third_party/blink/renderer/core/testing/page_test_base.h"
+#include "third_party/blink/renderer/platform/bindings/exception_state.h"
 #include "third_party/blink/renderer/platform/heap/handle.h"
 #include "third_party/blink/renderer/platform/heap/heap.h"
 #include "third_party/blink/renderer/platform/loader/fetch/fetch_context.h"
 #include "third_party/blink/renderer/platform/loader/fetch/fetch_initiator_type_names.h"
 #include "third_party/blink/renderer/platform/loader/fetch/memory_cache.h"
 #include "third_party/blink/renderer/platform/loader/fetch/resource_fetcher.h"
+#include "third_party/blink/renderer/platform/loader/fetch/resource_client.h"
 #include "third_party/blink/renderer/platform/loader/fetch/resource_request.h"
+#include "third_party/blink/renderer/platform/network/http_names.h"
+#include "third_party/blink/renderer/platform/testing/runtime_enabled_features_test_helpers.h"
 #include "third_party/blink/renderer/platform/testing/unit_test_helpers.h"
 #include "third_party/blink/renderer/platform/testing/url_test_helpers.h"
 #include "third_party/blink/renderer/platform/weborigin/kurl.h"
@@ -43,6 +48,26 @@ class Document;
 
 namespace {
 
+// Leaves the run loop entered by test::EnterRunLoop() once the resource it
+// observes has finished, e.g. after decoding the sheet on a worker thread.
+class FinishedClient final : public GarbageCollectedFinalized<FinishedClient>,
+                             public ResourceClient {
+  USING_GARBAGE_COLLECTED_MIXIN(FinishedClient);
+
+ public:
+  bool Finished() const { return finished_; }
+
+  void NotifyFinished(Resource*) override {
+    finished_ = true;
+    test::ExitRunLoop();
+  }
+
+  String DebugName() const override { return "FinishedClient"; }
+
+ private:
+  bool finished_ = false;
+};
+
 class CSSStyleSheetResourceTest : public PageTestBase {
  protected:
   CSSStyleSheetResourceTest() {
@@ -74,6 +99,20 @@ class CSSStyleSheetResourceTest : public PageTestBase {
     return css_resource;
   }
 
+  // Returns a resource which has received a sheet large enough to be decoded
+  // on a worker thread, but has not finished loading yet.
+  CSSStyleSheetResource* CreateLargeStyleSheetResource(
+      const ResourceResponse& response) {
+    CSSStyleSheetResource* css_resource = CSSStyleSheetResource::CreateForTest(
+        response.CurrentRequestUrl(), UTF8Encoding());
+    css_resource->ResponseReceived(response);
+    std::string text;
+    while (text.size() < 128 * 1024)
+      text += ".a { color: red; }\n";
+    css_resource->AppendData(text.data(), text.size());
+    return css_resource;
+  }
+
   Persistent<MemoryCache> original_memory_cache_;
 };
 
@@ -137,6 +176,127 @@ TEST_F(CSSStyleSheetResourceTest, CreateFromCacheRestoresOriginalSheet) {
   ASSERT_EQ(contents, parsed_stylesheet);
 }
 
+TEST_F(CSSStyleSheetResourceTest, CreateFromCacheSharesSheetWithSameText) {
+  const KURL css_url("https://localhost/style.css");
+  ResourceResponse response(css_url);
+  response.SetMimeType("text/css");
+  const char kText[] = "div { color: red; }";
+
+  // Two resources for the same sheet, neither of which is in the memory cache.
+  CSSStyleSheetResource* css_resources[2];
+  for (auto*& css_resource : css_resources) {
+    css_resource =
+        CSSStyleSheetResource::CreateForTest(css_url, UTF8Encoding());
+    css_resource->ResponseReceived(response);
+    css_resource->AppendData(kText, sizeof(kText) - 1);
+    css_resource->FinishForTest();
+  }
+
+  CSSParserContext* parser_context = CSSParserContext::Create(
+      kHTMLStandardMode, SecureContextMode::kInsecureContext);
+  EXPECT_FALSE(
+      css_resources[0]->CreateParsedStyleSheetFromCache(parser_context));
+
+  StyleSheetContents* contents = StyleSheetContents::Create(parser_context);
+  CSSStyleSheet* sheet = CSSStyleSheet::Create(contents, GetDocument());
+  ASSERT_TRUE(sheet);
+
+  contents->ParseString(kText);
+  contents->NotifyLoadedSheet(css_resources[0]);
+  contents->CheckLoaded();
+  EXPECT_TRUE(contents->IsCacheableForResource());
+
+  css_resources[0]->SaveParsedStyleSheet(contents);
+  EXPECT_FALSE(contents->IsReferencedFromResource());
+
+  EXPECT_EQ(contents,
+            css_resources[1]->CreateParsedStyleSheetFromCache(parser_context));
+
+  // A different context would give a different result.
+  CSSParserContext* quirks_context = CSSParserContext::Create(
+      kHTMLQuirksMode, SecureContextMode::kInsecureContext);
+  EXPECT_FALSE(
+      css_resources[1]->CreateParsedStyleSheetFromCache(quirks_context));
+}
+
+TEST_F(CSSStyleSheetResourceTest, SheetSharedByTextIsCopiedOnWrite) {
+  const KURL css_url("https://localhost/shared.css");
+  ResourceResponse response(css_url);
+  response.SetMimeType("text/css");
+  const char kText[] = "span { color: green; }";
+
+  CSSStyleSheetResource* css_resources[2];
+  for (auto*& css_resource : css_resources) {
+    css_resource =
+        CSSStyleSheetResource::CreateForTest(css_url, UTF8Encoding());
+    css_resource->ResponseReceived(response);
+    css_resource->AppendData(kText, sizeof(kText) - 1);
+    css_resource->FinishForTest();
+  }
+
+  CSSParserContext* parser_context = CSSParserContext::Create(
+      kHTMLStandardMode, SecureContextMode::kInsecureContext);
+  StyleSheetContents* contents = StyleSheetContents::Create(parser_context);
+  CSSStyleSheet* sheet_a = CSSStyleSheet::Create(contents, GetDocument());
+  contents->ParseString(kText);
+  contents->NotifyLoadedSheet(css_resources[0]);
+  contents->CheckLoaded();
+  css_resources[0]->SaveParsedStyleSheet(contents);
+
+  // Another document adopts the contents through the text cache.
+  Document* document_b = Document::CreateForTest();
+  StyleSheetContents* shared_contents =
+      css_resources[1]->CreateParsedStyleSheetFromCache(parser_context);
+  ASSERT_EQ(contents, shared_contents);
+  EXPECT_TRUE(contents->IsUsedFromTextCache());
+  CSSStyleSheet* sheet_b = CSSStyleSheet::Create(shared_contents, *document_b);
+
+  // Mutating the first document's sheet copies the shared contents.
+  sheet_a->insertRule("p { color: blue; }", 0, ASSERT_NO_EXCEPTION);
+  EXPECT_NE(contents, sheet_a->Contents());
+  EXPECT_EQ(2u, sheet_a->length());
+  EXPECT_EQ(contents, sheet_b->Contents());
+  EXPECT_EQ(1u, sheet_b->length());
+  EXPECT_FALSE(contents->IsMutable());
+
+  // The untouched original is still handed out for the same text.
+  EXPECT_EQ(contents,
+            css_resources[1]->CreateParsedStyleSheetFromCache(parser_context));
+}
+
+TEST_F(CSSStyleSheetResourceTest, SheetMutatedInPlaceIsNotSharedByText) {
+  const KURL css_url("https://localhost/mutated.css");
+  ResourceResponse response(css_url);
+  response.SetMimeType("text/css");
+  const char kText[] = "b { color: blue; }";
+
+  CSSStyleSheetResource* css_resources[2];
+  for (auto*& css_resource : css_resources) {
+    css_resource =
+        CSSStyleSheetResource::CreateForTest(css_url, UTF8Encoding());
+    css_resource->ResponseReceived(response);
+    css_resource->AppendData(kText, sizeof(kText) - 1);
+    css_resource->FinishForTest();
+  }
+
+  CSSParserContext* parser_context = CSSParserContext::Create(
+      kHTMLStandardMode, SecureContextMode::kInsecureContext);
+  StyleSheetContents* contents = StyleSheetContents::Create(parser_context);
+  CSSStyleSheet* sheet = CSSStyleSheet::Create(contents, GetDocument());
+  contents->ParseString(kText);
+  contents->NotifyLoadedSheet(css_resources[0]);
+  contents->CheckLoaded();
+  css_resources[0]->SaveParsedStyleSheet(contents);
+
+  // The only client may mutate the contents in place, after which they no
+  // longer match the text they are cached under.
+  sheet->deleteRule(0, ASSERT_NO_EXCEPTION);
+  EXPECT_EQ(contents, sheet->Contents());
+  EXPECT_FALSE(contents->IsCacheableForResource());
+  EXPECT_FALSE(
+      css_resources[1]->CreateParsedStyleSheetFromCache(parser_context));
+}
+
 TEST_F(CSSStyleSheetResourceTest,
        CreateFromCacheWithMediaQueriesCopiesOriginalSheet) {
   CSSStyleSheetResource* css_resource = CreateAndSaveTestStyleSheetResource();
@@ -178,5 +338,73 @@ TEST_F(CSSStyleSheetResourceTest,
   EXPECT_FALSE(parsed_stylesheet->HasRuleSet());
 }
 
+TEST_F(CSSStyleSheetResourceTest, EncodingSetDuringBackgroundDecode) {
+  ScopedOffMainThreadCSSDecodingForTest off_main_thread_decoding(true);
+  ResourceResponse response(KURL("https://localhost/large.css"));
+  response.SetMimeType("text/css");
+  CSSStyleSheetResource* css_resource =
+      CreateLargeStyleSheetResource(response);
+  FinishedClient* client = MakeGarbageCollected<FinishedClient>();
+  css_resource->AddClient(
+      client, blink::scheduler::GetSingleThreadTaskRunnerForTesting().get());
+
+  css_resource->FinishForTest();
+  EXPECT_FALSE(client->Finished());
+
+  // The decoder is on the worker thread, e.g. when a response sets the
+  // encoding. It is applied once the decoder is back.
+  css_resource->SetEncodingForTest("windows-1252");
+  test::EnterRunLoop();
+  EXPECT_TRUE(client->Finished());
+  EXPECT_EQ(WTF::TextEncoding("windows-1252"), css_resource->Encoding());
+}
+
+TEST_F(CSSStyleSheetResourceTest, NoRevalidationDuringBackgroundDecode) {
+  ScopedOffMainThreadCSSDecodingForTest off_main_thread_decoding(true);
+  ResourceResponse response(KURL("https://localhost/large.css"));
+  response.SetMimeType("text/css");
+  response.SetHttpHeaderField(http_names::kETag, "\"etag\"");
+  CSSStyleSheetResource* css_resource =
+      CreateLargeStyleSheetResource(response);
+  FinishedClient* client = MakeGarbageCollected<FinishedClient>();
+  css_resource->AddClient(
+      client, blink::scheduler::GetSingleThreadTaskRunnerForTesting().get());
+
+  css_resource->FinishForTest();
+  EXPECT_FALSE(client->Finished());
+  EXPECT_FALSE(css_resource->CanUseCacheValidator());
+
+  test::EnterRunLoop();
+  EXPECT_TRUE(client->Finished());
+  EXPECT_TRUE(css_resource->CanUseCacheValidator());
+}
+
+TEST_F(CSSStyleSheetResourceTest, ClientRemovedDuringBackgroundDecode) {
+  ScopedOffMainThreadCSSDecodingForTest off_main_thread_decoding(true);
+  ResourceResponse response(KURL("https://localhost/large.css"));
+  response.SetMimeType("text/css");
+  CSSStyleSheetResource* css_resource =
+      CreateLargeStyleSheetResource(response);
+  FinishedClient* removed_client = MakeGarbageCollected<FinishedClient>();
+  FinishedClient* client = MakeGarbageCollected<FinishedClient>();
+  css_resource->AddClient(
+      removed_client,
+      blink::scheduler::GetSingleThreadTaskRunnerForTesting().get());
+  css_resource->AddClient(
+      client, blink::scheduler::GetSingleThreadTaskRunnerForTesting().get());
+
+  // The load of |removed_client| is cancelled while the sheet is decoded.
+  css_resource->FinishForTest();
+  css_resource->RemoveClient(removed_client);
+
+  test::EnterRunLoop();
+  EXPECT_TRUE(client->Finished());
+  EXPECT_FALSE(removed_client->Finished());
+
+  CSSParserContext* parser_context = CSSParserContext::Create(
+      kHTMLStandardMode, SecureContextMode::kInsecureContext);
+  EXPECT_TRUE(css_resource->SheetText(parser_context).StartsWith(".a {"));
+}
+
 }  // namespace
 }  // namespace blink
@@ -21,16 +21,39 @@ TextResource::TextResource(const ResourceRequest& resource_request,
 TextResource::~TextResource() = default;
 
 void TextResource::SetEncoding(const String& chs) {
+  if (!decoder_) {
+    pending_encoding_ = chs;
+    return;
+  }
   decoder_->SetEncoding(WTF::TextEncoding(chs),
                         TextResourceDecoder::kEncodingFromHTTPHeader);
 }
 
 WTF::TextEncoding TextResource::Encoding() const {
+  if (!decoder_)
+    return taken_decoder_encoding_;
   return decoder_->Encoding();
 }
 
+std::unique_ptr<TextResourceDecoder> TextResource::TakeDecoder() {
+  DCHECK(decoder_);
+  taken_decoder_encoding_ = decoder_->Encoding();
+  return std::move(decoder_);
+}
+
+void TextResource::ReturnDecoder(std::unique_ptr<TextResourceDecoder> decoder) {
+  DCHECK(!decoder_);
+  DCHECK(decoder);
+  decoder_ = std::move(decoder);
+  if (!pending_encoding_.IsNull()) {
+    SetEncoding(pending_encoding_);
+    pending_encoding_ = String();
+  }
+}
+
 String TextResource::DecodedText() const {
   DCHECK(Data());
+  DCHECK(decoder_);
 
   StringBuilder builder;
   for (const auto& span : *Data())
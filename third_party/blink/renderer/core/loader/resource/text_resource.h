@@ -32,8 +32,17 @@ class CORE_EXPORT TextResource : public Resource {
 
   void SetEncoding(const String&) override;
 
+  // Hands the decoder over, e.g. to decode the data on another thread. Until
+  // it is returned with ReturnDecoder(), DecodedText() must not be called and
+  // Encoding() returns the encoding the decoder had when it was taken. An
+  // encoding set in the meantime is applied when the decoder is returned.
+  std::unique_ptr<TextResourceDecoder> TakeDecoder();
+  void ReturnDecoder(std::unique_ptr<TextResourceDecoder>);
+
  private:
   std::unique_ptr<TextResourceDecoder> decoder_;
+  WTF::TextEncoding taken_decoder_encoding_;
+  String pending_encoding_;
 };
 
 }  // namespace blink
@@ -64,6 +64,7 @@
 #include "third_party/blink/renderer/platform/geometry/length_functions.h"
 #include "third_party/blink/renderer/platform/graphics/graphics_context.h"
 #include "third_party/blink/renderer/platform/graphics/path.h"
+#include "third_party/blink/renderer/platform/runtime_enabled_features.h"
 #include "third_party/blink/renderer/platform/text/capitalize.h"
 #include "third_party/blink/renderer/platform/text/character.h"
 #include "third_party/blink/renderer/platform/transforms/rotate_transform_operation.h"
@@ -250,6 +251,13 @@ ComputedStyle::Difference ComputedStyle::ComputeDifference(
   if (!independent_equal || !non_independent_equal) {
     if (non_independent_equal && !old_style->HasExplicitlyInheritedProperties())
       return Difference::kIndependentInherited;
+    if (independent_equal && !old_style->HasExplicitlyInheritedProperties() &&
+        RuntimeEnabledFeatures::CSSInheritedVariablesPropagationEnabled() &&
+        old_style->LoadingCustomFontsEqual(*new_style) &&
+        old_style->JustifyItems() == new_style->JustifyItems() &&
+        old_style->NonIndependentInheritedEqualExceptVariables(*new_style)) {
+      return Difference::kInheritedVariables;
+    }
     return Difference::kInherited;
   }
 
@@ -277,6 +285,15 @@ void ComputedStyle::PropagateIndependentInheritedProperties(
   ComputedStyleBase::PropagateIndependentInheritedProperties(parent_style);
 }
 
+void ComputedStyle::PropagateInheritedVariables(
+    const ComputedStyle& parent_style) {
+  DCHECK(!HasVariableDeclaration());
+  DCHECK(!HasVariableReferenceFromInheritedProperty());
+  DCHECK(!HasVariableReferenceFromNonInheritedProperty());
+  MutableInheritedVariablesInternal() =
+      parent_style.InheritedVariablesInternal();
+}
+
 StyleSelfAlignmentData ResolvedSelfAlignment(
     const StyleSelfAlignmentData& value,
     ItemPosition normal_value_behavior) {
@@ -440,6 +457,13 @@ void ComputedStyle::CopyNonInheritedFromCached(const ComputedStyle& other) {
   // m_affectedByDrag
   // m_isLink
 
+  // These flags depend only on the matched properties, which are the same as
+  // for |other|, and are not set again on an inherited cache hit:
+  if (other.HasVariableReferenceFromInheritedProperty())
+    SetHasVariableReferenceFromInheritedProperty();
+  if (other.HasVariableDeclaration())
+    SetHasVariableDeclaration();
+
   if (svg_style_ != other.svg_style_)
     svg_style_.Access()->CopyNonInheritedFromCached(*other.svg_style_);
 }
@@ -494,6 +518,16 @@ bool ComputedStyle::NonIndependentInheritedEqual(
          svg_style_->InheritedEqual(*other.svg_style_);
 }
 
+bool ComputedStyle::NonIndependentInheritedEqualExceptVariables(
+    const ComputedStyle& other) const {
+  if (DataEquivalent(InheritedVariables(), other.InheritedVariables()))
+    return NonIndependentInheritedEqual(other);
+  scoped_refptr<ComputedStyle> style = Clone(*this);
+  style->MutableInheritedVariablesInternal() =
+      other.InheritedVariablesInternal();
+  return style->NonIndependentInheritedEqual(other);
+}
+
 bool ComputedStyle::LoadingCustomFontsEqual(const ComputedStyle& other) const {
   return GetFont().LoadingCustomFonts() == other.GetFont().LoadingCustomFonts();
 }
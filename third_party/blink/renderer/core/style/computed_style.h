@@ -274,6 +274,12 @@ class ComputedStyle : public ComputedStyleBase,
     // properties directly without re-matching rules.
     kIndependentInherited,
     // Inherited properties are different which means we need to recalc style
+    // for children. Only inherited custom properties changed which means
+    // children which neither declare nor reference custom properties can
+    // inherit by cloning the existing ComputedStyle and replacing the inherited
+    // variables, without re-matching rules.
+    kInheritedVariables,
+    // Inherited properties are different which means we need to recalc style
     // for children.
     kInherited,
     // Display type changes for flex/grid/custom layout affects computed style
@@ -295,6 +301,10 @@ class ComputedStyle : public ComputedStyleBase,
   void PropagateIndependentInheritedProperties(
       const ComputedStyle& parent_style);
 
+  // Copies the inherited custom properties from the parent. Only valid for a
+  // style which neither declares nor references custom properties.
+  void PropagateInheritedVariables(const ComputedStyle& parent_style);
+
   ContentPosition ResolvedJustifyContentPosition(
       const StyleContentAlignmentData& normal_value_behavior) const;
   ContentDistributionType ResolvedJustifyContentDistribution(
@@ -1115,6 +1125,7 @@ class ComputedStyle : public ComputedStyleBase,
   bool NonInheritedEqual(const ComputedStyle&) const;
   inline bool IndependentInheritedEqual(const ComputedStyle&) const;
   inline bool NonIndependentInheritedEqual(const ComputedStyle&) const;
+  bool NonIndependentInheritedEqualExceptVariables(const ComputedStyle&) const;
   bool LoadingCustomFontsEqual(const ComputedStyle&) const;
   bool InheritedDataShared(const ComputedStyle&) const;
 
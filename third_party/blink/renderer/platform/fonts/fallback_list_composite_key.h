@@ -53,6 +53,9 @@ struct FallbackListCompositeKey {
   }
 
   unsigned GetHash() const { return hash_; }
+  const Vector<FontCacheKey>& FontCacheKeys() const {
+    return font_cache_keys_;
+  }
 
   bool operator==(const FallbackListCompositeKey& other) const {
     return hash_ == other.hash_ && computed_size_ == other.computed_size_ &&
@@ -343,6 +343,23 @@ void FontCache::PurgeFallbackListShaperCache() {
   shape_cache_histogram.Count(items);
 }
 
+void FontCache::PurgeShapeCachesOfPurgedFonts() {
+  TRACE_EVENT0("ui", "FontCache::PurgeShapeCachesOfPurgedFonts");
+  Vector<FallbackListCompositeKey> keys_to_remove;
+  for (const auto& shape_cache : fallback_list_shaper_cache_) {
+    for (FontCacheKey key : shape_cache.key.FontCacheKeys()) {
+      // See GetFontPlatformData().
+      if (RuntimeEnabledFeatures::FontCacheScalingEnabled())
+        key.ClearFontSize();
+      if (!font_platform_data_cache_.Contains(key)) {
+        keys_to_remove.push_back(shape_cache.key);
+        break;
+      }
+    }
+  }
+  fallback_list_shaper_cache_.RemoveAll(keys_to_remove);
+}
+
 void FontCache::InvalidateShapeCache() {
   PurgeFallbackListShaperCache();
 }
@@ -358,7 +375,12 @@ void FontCache::Purge(PurgeSeverity purge_severity) {
     return;
 
   PurgePlatformFontDataCache();
-  PurgeFallbackListShaperCache();
+  // Words are mostly shaped again with the fonts that are still in use, e.g.
+  // for UI strings, so only drop all shape results when forced to.
+  if (purge_severity == kForcePurge)
+    PurgeFallbackListShaperCache();
+  else
+    PurgeShapeCachesOfPurgedFonts();
 }
 
 void FontCache::AddClient(FontCacheClient* client) {
@@ -341,6 +341,7 @@ class PLATFORM_EXPORT FontCache {
 
   void PurgePlatformFontDataCache();
   void PurgeFallbackListShaperCache();
+  void PurgeShapeCachesOfPurgedFonts();
 
   friend class SimpleFontData;  // For fontDataFromFontPlatformData
   friend class FontFallbackList;
@@ -18,19 +18,27 @@ namespace blink {
 namespace {
 
 void DumpMemoryTotals(base::trace_event::ProcessMemoryDump* memory_dump) {
+  const size_t allocated_space = ProcessHeap::TotalAllocatedSpace();
   base::trace_event::MemoryAllocatorDump* allocator_dump =
       memory_dump->CreateAllocatorDump("blink_gc");
-  allocator_dump->AddScalar("size", "bytes",
-                            ProcessHeap::TotalAllocatedSpace());
+  allocator_dump->AddScalar("size", "bytes", allocated_space);
 
   base::trace_event::MemoryAllocatorDump* objects_dump =
       memory_dump->CreateAllocatorDump("blink_gc/allocated_objects");
 
   // ThreadHeap::markedObjectSize() can be underestimated if we're still in the
   // process of lazy sweeping.
-  objects_dump->AddScalar("size", "bytes",
-                          ProcessHeap::TotalAllocatedObjectSize() +
-                              ProcessHeap::TotalMarkedObjectSize());
+  const size_t object_size = ProcessHeap::TotalAllocatedObjectSize() +
+                             ProcessHeap::TotalMarkedObjectSize();
+  objects_dump->AddScalar("size", "bytes", object_size);
+
+  // The rest of the pages is free space, either in free lists or in blocks
+  // too small to be reused, and measures the fragmentation of the heap.
+  base::trace_event::MemoryAllocatorDump* free_space_dump =
+      memory_dump->CreateAllocatorDump("blink_gc/free_space");
+  free_space_dump->AddScalar(
+      "size", "bytes",
+      allocated_space > object_size ? allocated_space - object_size : 0);
 }
 
 }  // namespace
@@ -19,6 +19,7 @@ TEST(BlinkGCDumpProviderTest, MemoryDump) {
   BlinkGCMemoryDumpProvider::Instance()->OnMemoryDump(args, dump.get());
   DCHECK(dump->GetAllocatorDump("blink_gc"));
   DCHECK(dump->GetAllocatorDump("blink_gc/allocated_objects"));
+  DCHECK(dump->GetAllocatorDump("blink_gc/free_space"));
 }
 
 }  // namespace blink
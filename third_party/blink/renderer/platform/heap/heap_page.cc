@@ -32,6 +32,7 @@
 
 #include "base/allocator/partition_allocator/page_allocator.h"
 #include "base/auto_reset.h"
+#include "base/bits.h"
 #include "base/trace_event/process_memory_dump.h"
 #include "third_party/blink/public/platform/platform.h"
 #include "third_party/blink/renderer/platform/bindings/script_forbidden_scope.h"
@@ -941,29 +942,22 @@ Address NormalPageArena::AllocateFromFreeList(size_t allocation_size,
   // off as a large a free block as possible in one go; a block that will
   // service this block and let following allocations be serviced quickly
   // by bump allocation.
-  size_t bucket_size = static_cast<size_t>(1)
-                       << free_list_.biggest_free_list_index_;
-  int index = free_list_.biggest_free_list_index_;
-  for (; index > 0; --index, bucket_size >>= 1) {
-    FreeListEntry* entry = free_list_.free_lists_[index];
-    if (allocation_size > bucket_size) {
-      // Final bucket candidate; check initial entry if it is able
-      // to service this allocation. Do not perform a linear scan,
-      // as it is considered too costly.
-      if (!entry || entry->size() < allocation_size)
-        break;
-    }
-    if (entry) {
-      entry->Unlink(&free_list_.free_lists_[index]);
-      SetAllocationPoint(entry->GetAddress(), entry->size());
-      DCHECK(HasCurrentAllocationArea());
-      DCHECK_GE(RemainingAllocationSize(), allocation_size);
-      free_list_.biggest_free_list_index_ = index;
-      return AllocateObject(allocation_size, gc_info_index);
-    }
-  }
-  free_list_.biggest_free_list_index_ = index;
-  return nullptr;
+  if (!free_list_.non_empty_buckets_)
+    return nullptr;
+  int index = base::bits::Log2Floor(free_list_.non_empty_buckets_);
+  FreeListEntry* entry = free_list_.free_lists_[index];
+  // If the largest bin may hold blocks that are too small, only check its
+  // initial entry. Do not perform a linear scan, as it is considered too
+  // costly.
+  if (entry->size() < allocation_size)
+    return nullptr;
+  entry->Unlink(&free_list_.free_lists_[index]);
+  if (!free_list_.free_lists_[index])
+    free_list_.non_empty_buckets_ &= ~(1u << index);
+  SetAllocationPoint(entry->GetAddress(), entry->size());
+  DCHECK(HasCurrentAllocationArea());
+  DCHECK_GE(RemainingAllocationSize(), allocation_size);
+  return AllocateObject(allocation_size, gc_info_index);
 }
 
 LargeObjectArena::LargeObjectArena(ThreadState* state, int index)
@@ -1075,7 +1069,7 @@ Address LargeObjectArena::LazySweepPages(size_t allocation_size,
   return result;
 }
 
-FreeList::FreeList() : biggest_free_list_index_(0) {}
+FreeList::FreeList() : non_empty_buckets_(0) {}
 
 void FreeList::AddToFreeList(Address address, size_t size) {
   DCHECK_LT(size, BlinkPagePayloadSize());
@@ -1138,8 +1132,7 @@ void FreeList::AddToFreeList(Address address, size_t size) {
 
   int index = BucketIndexForSize(size);
   entry->Link(&free_lists_[index]);
-  if (index > biggest_free_list_index_)
-    biggest_free_list_index_ = index;
+  non_empty_buckets_ |= 1u << index;
 }
 
 #if DCHECK_IS_ON() || defined(LEAK_SANITIZER) || defined(ADDRESS_SANITIZER) || \
@@ -1210,7 +1203,7 @@ size_t FreeList::FreeListSize() const {
 }
 
 void FreeList::Clear() {
-  biggest_free_list_index_ = 0;
+  non_empty_buckets_ = 0;
   for (size_t i = 0; i < kBlinkPageSizeLog2; ++i)
     free_lists_[i] = nullptr;
 }
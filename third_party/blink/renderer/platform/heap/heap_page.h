@@ -698,7 +698,10 @@ class FreeList {
 #endif
 
  private:
-  int biggest_free_list_index_;
+  // Bit n is set iff the nth list is not empty, so that the largest entries
+  // can be found without scanning the lists.
+  uint32_t non_empty_buckets_;
+  static_assert(kBlinkPageSizeLog2 <= 32, "Bucket bitmap is too small");
 
   // All |FreeListEntry|s in the nth list have size >= 2^n.
   FreeListEntry* free_lists_[kBlinkPageSizeLog2];
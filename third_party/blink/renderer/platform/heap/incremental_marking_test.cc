@@ -1595,6 +1595,20 @@ TEST(IncrementalMarkingTest, TestDriver) {
   EXPECT_FALSE(ThreadState::Current()->IsIncrementalMarking());
 }
 
+TEST(IncrementalMarkingTest, StepMarksObjectsReachableFromNewRoots) {
+  IncrementalMarkingTestDriver driver(ThreadState::Current());
+  driver.Start();
+  // Neither the persistent handle nor the objects existed when the roots were
+  // first visited. They are marked by the steps rather than the atomic pause.
+  Persistent<Object> persistent(
+      MakeGarbageCollected<Object>(MakeGarbageCollected<Object>()));
+  EXPECT_FALSE(persistent->IsMarked());
+  driver.FinishSteps();
+  EXPECT_TRUE(persistent->IsMarked());
+  EXPECT_TRUE(persistent->next_ref()->IsMarked());
+  driver.FinishGC();
+}
+
 TEST(IncrementalMarkingTest, DropBackingStore) {
   // Regression test: https://crbug.com/828537
   using WeakStore = HeapHashCountedSet<WeakMember<Object>>;
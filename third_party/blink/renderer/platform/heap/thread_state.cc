@@ -1391,8 +1391,19 @@ void ThreadState::IncrementalMarkingStep(BlinkGC::StackState stack_state) {
   if (stack_state == BlinkGC::kNoHeapPointersOnStack) {
     Heap().FlushNotFullyConstructedObjects();
   }
-  const bool complete = MarkPhaseAdvanceMarking(
-      CurrentTimeTicks() + next_incremental_marking_step_duration_);
+  const TimeTicks deadline =
+      CurrentTimeTicks() + next_incremental_marking_step_duration_;
+  bool complete = MarkPhaseAdvanceMarking(deadline);
+  if (complete && !IsUnifiedGCMarkingInProgress()) {
+    // Objects allocated since marking started are not marked, and the ones
+    // only reachable from roots created since then, e.g. new persistent
+    // handles, would be marked in the atomic pause. Visit the roots again and
+    // mark what they reach here instead, where the mutator can still run in
+    // between steps. The atomic pause then only has to mark what became
+    // reachable after the last step.
+    MarkPhaseVisitRoots();
+    complete = MarkPhaseAdvanceMarking(deadline);
+  }
   if (complete) {
     if (IsUnifiedGCMarkingInProgress()) {
       // If there are no more objects to mark for unified garbage collections
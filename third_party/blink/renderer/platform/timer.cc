@@ -29,12 +29,39 @@
 #include <algorithm>
 #include "third_party/blink/public/platform/platform.h"
 #include "third_party/blink/renderer/platform/instrumentation/tracing/trace_event.h"
+#include "third_party/blink/renderer/platform/runtime_enabled_features.h"
 #include "third_party/blink/renderer/platform/scheduler/public/thread_scheduler.h"
 #include "third_party/blink/renderer/platform/wtf/sanitizers.h"
 #include "third_party/blink/renderer/platform/wtf/time.h"
 
 namespace blink {
 
+namespace {
+
+// With TimerAlignment, a timer is delayed by at most 1/kAlignmentSlackDivisor
+// of its delay, so that it fires on a multiple of the largest power of two
+// milliseconds that fits in that slack. Timers with similar delays thus share
+// wake-ups, and the boundaries of coarser alignments are boundaries of finer
+// ones too. Timers with less slack than kMinAlignment aren't aligned.
+constexpr int kAlignmentSlackDivisor = 10;
+constexpr TimeDelta kMinAlignment = TimeDelta::FromMilliseconds(4);
+constexpr TimeDelta kMaxAlignment = TimeDelta::FromMilliseconds(1024);
+
+// Returns the delay after which to run a timer that is due in |delay|.
+TimeDelta AlignedDelay(TimeTicks now, TimeDelta delay) {
+  if (!RuntimeEnabledFeatures::TimerAlignmentEnabled())
+    return delay;
+  TimeDelta slack = delay / kAlignmentSlackDivisor;
+  if (slack < kMinAlignment)
+    return delay;
+  TimeDelta alignment = kMinAlignment;
+  while (alignment * 2 <= std::min(slack, kMaxAlignment))
+    alignment *= 2;
+  return (now + delay).SnappedToNextTick(TimeTicks(), alignment) - now;
+}
+
+}  // namespace
+
 TimerBase::TimerBase(
     scoped_refptr<base::SingleThreadTaskRunner> web_task_runner)
     : web_task_runner_(std::move(web_task_runner)),
@@ -120,10 +147,12 @@ void TimerBase::SetNextFireTime(TimeTicks now, TimeDelta delay) {
     // Cancel any previously posted task.
     weak_ptr_factory_.InvalidateWeakPtrs();
 
+    // |next_fire_time_| stays unaligned, so that repeating timers don't
+    // drift.
     TimerTaskRunner()->PostDelayedTask(
         location_,
         WTF::Bind(&TimerBase::RunInternal, weak_ptr_factory_.GetWeakPtr()),
-        delay);
+        AlignedDelay(now, delay));
   }
 }
 
@@ -10,6 +10,7 @@
 #include "testing/gtest/include/gtest/gtest.h"
 #include "third_party/blink/public/platform/platform.h"
 #include "third_party/blink/public/platform/scheduler/test/renderer_scheduler_test_support.h"
+#include "third_party/blink/renderer/platform/testing/runtime_enabled_features_test_helpers.h"
 #include "third_party/blink/renderer/platform/testing/unit_test_helpers.h"
 #include "third_party/blink/renderer/platform/wtf/vector.h"
 
@@ -26,8 +27,45 @@ class TimerPerfTest : public testing::Test {
     base::RunLoop::QuitCurrentDeprecated();
   }
 
+  // Counts the timers that run more than a millisecond after the previous one
+  // as separate wake-ups.
+  void RecordWakeUp(TimerBase*) {
+    base::TimeTicks now = base::TimeTicks::Now();
+    if (now - last_run_ > base::TimeDelta::FromMilliseconds(1))
+      wake_ups_++;
+    last_run_ = now;
+  }
+
+  void QuitRunLoop(TimerBase*) { base::RunLoop::QuitCurrentDeprecated(); }
+
+  // Runs |kNumTimers| repeating timers with different intervals for
+  // |kDuration| and returns the number of wake-ups per second they needed.
+  double MeasureWakeUpsPerSecond() {
+    const int kNumTimers = 200;
+    const base::TimeDelta kDuration = base::TimeDelta::FromSeconds(2);
+    Vector<std::unique_ptr<TaskRunnerTimer<TimerPerfTest>>> timers(kNumTimers);
+    for (int i = 0; i < kNumTimers; i++) {
+      timers[i].reset(new TaskRunnerTimer<TimerPerfTest>(
+          scheduler::GetSingleThreadTaskRunnerForTesting(), this,
+          &TimerPerfTest::RecordWakeUp));
+      timers[i]->StartRepeating(TimeDelta::FromMilliseconds(100 + i),
+                                FROM_HERE);
+    }
+    TaskRunnerTimer<TimerPerfTest> quit(
+        scheduler::GetSingleThreadTaskRunnerForTesting(), this,
+        &TimerPerfTest::QuitRunLoop);
+    quit.StartOneShot(kDuration, FROM_HERE);
+
+    wake_ups_ = 0;
+    last_run_ = base::TimeTicks();
+    test::EnterRunLoop();
+    return wake_ups_ / kDuration.InSecondsF();
+  }
+
   base::ThreadTicks run_start_;
   base::ThreadTicks run_end_;
+  base::TimeTicks last_run_;
+  int wake_ups_ = 0;
 };
 
 TEST_F(TimerPerfTest, PostAndRunTimers) {
@@ -114,4 +152,15 @@ TEST_F(TimerPerfTest, PostThenCancelTenThousandTimers) {
             << (run_end_ - run_start_).InMicroseconds();
 }
 
+TEST_F(TimerPerfTest, WakeUpsPerSecond) {
+  double unaligned = MeasureWakeUpsPerSecond();
+  double aligned;
+  {
+    ScopedTimerAlignmentForTest timer_alignment(true);
+    aligned = MeasureWakeUpsPerSecond();
+  }
+  LOG(INFO) << "Wake-ups per second of 200 repeating timers: " << unaligned
+            << " unaligned, " << aligned << " aligned";
+}
+
 }  // namespace blink
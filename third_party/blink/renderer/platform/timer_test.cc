@@ -15,6 +15,7 @@
 #include "third_party/blink/renderer/platform/scheduler/main_thread/main_thread_task_queue.h"
 #include "third_party/blink/renderer/platform/scheduler/public/thread.h"
 #include "third_party/blink/renderer/platform/scheduler/public/thread_scheduler.h"
+#include "third_party/blink/renderer/platform/testing/runtime_enabled_features_test_helpers.h"
 #include "third_party/blink/renderer/platform/testing/testing_platform_support_with_mock_scheduler.h"
 #include "third_party/blink/renderer/platform/wtf/ref_counted.h"
 #include "third_party/blink/renderer/platform/wtf/time.h"
@@ -583,6 +584,58 @@ TEST_F(TimerTest, RepeatingTimerDoesNotDrift) {
                           start_time_ + TimeDelta::FromSeconds(28)));
 }
 
+TEST_F(TimerTest, AlignedTimersShareWakeUp) {
+  ScopedTimerAlignmentForTest timer_alignment(true);
+
+  TaskRunnerTimer<TimerTest> timer1(GetTaskRunner(), this,
+                                    &TimerTest::CountingTask);
+  TaskRunnerTimer<TimerTest> timer2(GetTaskRunner(), this,
+                                    &TimerTest::CountingTask);
+  timer1.StartOneShot(TimeDelta::FromSeconds(1), FROM_HERE);
+  platform_->AdvanceClock(TimeDelta::FromMilliseconds(3));
+  timer2.StartOneShot(TimeDelta::FromSeconds(1), FROM_HERE);
+
+  RunUntilDeadline(start_time_ + TimeDelta::FromSeconds(2));
+
+  // Both timers run on the same 64ms boundary, at most 100ms late.
+  ASSERT_EQ(2u, run_times_.size());
+  EXPECT_EQ(run_times_[0], run_times_[1]);
+  EXPECT_TRUE(((run_times_[0] - TimeTicks()) % TimeDelta::FromMilliseconds(64))
+                  .is_zero());
+  EXPECT_GE(run_times_[0],
+            start_time_ + TimeDelta::FromMilliseconds(1003));
+  EXPECT_LE(run_times_[0], start_time_ + TimeDelta::FromMilliseconds(1100));
+}
+
+TEST_F(TimerTest, AlignedRepeatingTimerDoesNotDrift) {
+  ScopedTimerAlignmentForTest timer_alignment(true);
+
+  TaskRunnerTimer<TimerTest> timer(GetTaskRunner(), this,
+                                   &TimerTest::CountingTask);
+  timer.StartRepeating(TimeDelta::FromMilliseconds(1000), FROM_HERE);
+
+  RunUntilDeadline(start_time_ + TimeDelta::FromMilliseconds(10500));
+
+  ASSERT_EQ(10u, run_times_.size());
+  for (size_t i = 0; i < run_times_.size(); ++i) {
+    TimeTicks due = start_time_ + TimeDelta::FromSeconds(i + 1);
+    EXPECT_GE(run_times_[i], due);
+    EXPECT_LT(run_times_[i], due + TimeDelta::FromMilliseconds(100));
+  }
+}
+
+TEST_F(TimerTest, ShortTimersAreNotAligned) {
+  ScopedTimerAlignmentForTest timer_alignment(true);
+
+  TaskRunnerTimer<TimerTest> timer(GetTaskRunner(), this,
+                                   &TimerTest::CountingTask);
+  timer.StartOneShot(TimeDelta::FromMilliseconds(30), FROM_HERE);
+
+  RunUntilDeadline(start_time_ + TimeDelta::FromSeconds(1));
+  EXPECT_THAT(run_times_,
+              ElementsAre(start_time_ + TimeDelta::FromMilliseconds(30)));
+}
+
 template <typename TimerFiredClass>
 class TimerForTest : public TaskRunnerTimer<TimerFiredClass> {
  public:
@@ -355,11 +355,53 @@ bool DataPack::LoadImpl(std::unique_ptr<DataPack::DataSource> data_source) {
     }
   }
 
+  BuildEntryIndex();
   data_source_ = std::move(data_source);
   return true;
 }
 
+void DataPack::BuildEntryIndex() {
+  entry_index_.clear();
+  // Index values are stored off by one in a uint16_t.
+  if (!resource_count_ || resource_count_ >= 0xFFFF)
+    return;
+
+  // Both tables are sorted by id.
+  uint16_t min_id = resource_table_[0].resource_id;
+  uint16_t max_id = resource_table_[resource_count_ - 1].resource_id;
+  if (alias_count_) {
+    min_id = std::min(min_id, alias_table_[0].resource_id);
+    max_id = std::max(max_id, alias_table_[alias_count_ - 1].resource_id);
+  }
+
+  // grit numbers resources mostly sequentially, so the index is usually small
+  // compared to the tables, which are already in memory after validation.
+  // Don't bother with packs whose ids are spread out.
+  size_t span = static_cast<size_t>(max_id) - min_id + 1;
+  if (span > 2 * (resource_count_ + alias_count_))
+    return;
+
+  entry_index_.assign(span, 0);
+  entry_index_base_ = min_id;
+  for (size_t i = 0; i < resource_count_; ++i) {
+    entry_index_[resource_table_[i].resource_id - min_id] =
+        static_cast<uint16_t>(i + 1);
+  }
+  for (size_t i = 0; i < alias_count_; ++i) {
+    entry_index_[alias_table_[i].resource_id - min_id] =
+        alias_table_[i].entry_index + 1;
+  }
+}
+
 const DataPack::Entry* DataPack::LookupEntryById(uint16_t resource_id) const {
+  if (!entry_index_.empty()) {
+    size_t offset = static_cast<size_t>(resource_id) - entry_index_base_;
+    if (resource_id < entry_index_base_ || offset >= entry_index_.size())
+      return nullptr;
+    uint16_t entry = entry_index_[offset];
+    return entry ? &resource_table_[entry - 1] : nullptr;
+  }
+
   // Search the resource table first as most resources will be in there.
   const Entry* ret = reinterpret_cast<const Entry*>(
       bsearch(&resource_id, resource_table_, resource_count_, sizeof(Entry),
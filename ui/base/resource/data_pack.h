@@ -91,6 +91,8 @@ class UI_DATA_PACK_EXPORT DataPack : public ResourceHandle {
   // Does the actual loading of a pack file.
   // Called by Load and LoadFromFile and LoadFromBuffer.
   bool LoadImpl(std::unique_ptr<DataSource> data_source);
+  // Fills |entry_index_| if the resource ids are dense enough.
+  void BuildEntryIndex();
   const Entry* LookupEntryById(uint16_t resource_id) const;
 
   std::unique_ptr<DataSource> data_source_;
@@ -100,6 +102,12 @@ class UI_DATA_PACK_EXPORT DataPack : public ResourceHandle {
   const Alias* alias_table_;
   size_t alias_count_;
 
+  // Maps |resource_id - entry_index_base_| to one more than the index of its
+  // entry in |resource_table_|, or to 0 if there is no such resource. Empty if
+  // the ids are too sparse, in which case the tables are binary searched.
+  std::vector<uint16_t> entry_index_;
+  uint16_t entry_index_base_ = 0;
+
   // Type of encoding for text resources.
   TextEncodingType text_encoding_type_;
 
@@ -302,6 +302,45 @@ TEST_P(DataPackTest, WriteWithAliases) {
   EXPECT_EQ(2U, pack.GetAliasTableSizeForTesting());
 }
 
+// Packs with dense resource ids are looked up through an index rather than by
+// binary search.
+TEST(DataPackTest, LookupDenseIds) {
+  base::ScopedTempDir dir;
+  ASSERT_TRUE(dir.CreateUniqueTempDir());
+  base::FilePath file = dir.GetPath().Append(FILE_PATH_LITERAL("data.pak"));
+
+  std::string one("one");
+  std::string two("two");
+  std::string four("four");
+
+  std::map<uint16_t, base::StringPiece> resources;
+  resources.insert(std::make_pair(100, base::StringPiece(one)));
+  resources.insert(std::make_pair(101, base::StringPiece(two)));
+  resources.insert(std::make_pair(102, base::StringPiece(one)));
+  resources.insert(std::make_pair(104, base::StringPiece(four)));
+  ASSERT_TRUE(DataPack::WritePack(file, resources, DataPack::BINARY));
+
+  DataPack pack(SCALE_FACTOR_100P);
+  ASSERT_TRUE(pack.LoadFromPath(file));
+  EXPECT_EQ(1U, pack.GetAliasTableSizeForTesting());
+
+  base::StringPiece data;
+  ASSERT_TRUE(pack.GetStringPiece(100, &data));
+  EXPECT_EQ(one, data);
+  ASSERT_TRUE(pack.GetStringPiece(101, &data));
+  EXPECT_EQ(two, data);
+  ASSERT_TRUE(pack.GetStringPiece(102, &data));
+  EXPECT_EQ(one, data);
+  ASSERT_TRUE(pack.GetStringPiece(104, &data));
+  EXPECT_EQ(four, data);
+
+  EXPECT_FALSE(pack.HasResource(0));
+  EXPECT_FALSE(pack.HasResource(99));
+  EXPECT_FALSE(pack.HasResource(103));
+  EXPECT_FALSE(pack.HasResource(105));
+  EXPECT_FALSE(pack.HasResource(0xFFFF));
+}
+
 #if defined(OS_POSIX)
 TEST(DataPackTest, ModifiedWhileUsed) {
   base::ScopedTempDir dir;
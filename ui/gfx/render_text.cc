@@ -465,7 +465,7 @@ void RenderText::SetMultiline(bool multiline) {
     multiline_ = multiline;
     cached_bounds_and_offset_valid_ = false;
     lines_.clear();
-    OnTextAttributeChanged();
+    OnLineBreakAttributeChanged();
   }
 }
 
@@ -485,7 +485,7 @@ void RenderText::SetWordWrapBehavior(WordWrapBehavior behavior) {
   if (multiline_) {
     cached_bounds_and_offset_valid_ = false;
     lines_.clear();
-    OnTextAttributeChanged();
+    OnLineBreakAttributeChanged();
   }
 }
 
@@ -494,7 +494,7 @@ void RenderText::SetReplaceNewlineCharsWithSymbols(bool replace) {
     return;
   replace_newline_chars_with_symbols_ = replace;
   cached_bounds_and_offset_valid_ = false;
-  OnTextAttributeChanged();
+  OnLineBreakAttributeChanged();
 }
 
 void RenderText::SetMinLineHeight(int line_height) {
@@ -1455,6 +1455,23 @@ gfx::Rect RenderText::ExpandToBeVerticallySymmetric(
 }
 
 void RenderText::OnTextAttributeChanged() {
+  UpdateLayoutText();
+  OnLayoutTextAttributeChanged(true);
+}
+
+void RenderText::OnLineBreakAttributeChanged() {
+  const base::string16 old_layout_text = layout_text_;
+  UpdateLayoutText();
+  // The shaped runs only depend on the layout text and its styles, so keep
+  // them unless the layout text changed, e.g. when newlines are now replaced
+  // with symbols.
+  if (layout_text_ == old_layout_text)
+    OnDisplayTextAttributeChanged();
+  else
+    OnLayoutTextAttributeChanged(true);
+}
+
+void RenderText::UpdateLayoutText() {
   layout_text_.clear();
   display_text_.clear();
   text_elided_ = false;
@@ -1511,8 +1528,6 @@ void RenderText::OnTextAttributeChanged() {
   static const base::char16 kNewlineSymbol[] = { 0x2424, 0 };
   if (!multiline_ && replace_newline_chars_with_symbols_)
     base::ReplaceChars(layout_text_, kNewline, kNewlineSymbol, &layout_text_);
-
-  OnLayoutTextAttributeChanged(true);
 }
 
 base::string16 RenderText::Elide(const base::string16& text,
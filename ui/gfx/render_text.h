@@ -730,6 +730,13 @@ class GFX_EXPORT RenderText {
   // Updates |layout_text_| and |display_text_| as needed (or marks them dirty).
   void OnTextAttributeChanged();
 
+  // Like OnTextAttributeChanged(), for attributes that affect how the text is
+  // broken into lines. Keeps the shaped runs if |layout_text_| is unchanged.
+  void OnLineBreakAttributeChanged();
+
+  // Recomputes |layout_text_| from |text_| and clears |display_text_|.
+  void UpdateLayoutText();
+
   // Elides |text| as needed to fit in the |available_width| using |behavior|.
   // |text_width| is the pre-calculated width of the text shaped by this render
   // text, or pass 0 if the width is unknown.
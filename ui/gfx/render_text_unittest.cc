@@ -3333,6 +3333,24 @@ TEST_F(RenderTextTest, Multiline_Newline) {
   }
 }
 
+// Changing only how the text is broken into lines should not reshape it.
+TEST_F(RenderTextTest, Multiline_KeepsShapedRuns) {
+  RenderText* render_text = GetRenderText();
+  render_text->SetText(ASCIIToUTF16("abc def ghi"));
+  render_text->SetDisplayRect(Rect(20, 1000));
+  render_text->Draw(canvas());
+  const internal::TextRunHarfBuzz* run = GetHarfBuzzRunList()->runs()[0].get();
+
+  render_text->SetMultiline(true);
+  render_text->Draw(canvas());
+  EXPECT_EQ(run, GetHarfBuzzRunList()->runs()[0].get());
+  EXPECT_LT(1u, test_api()->lines().size());
+
+  render_text->SetWordWrapBehavior(WRAP_LONG_WORDS);
+  render_text->Draw(canvas());
+  EXPECT_EQ(run, GetHarfBuzzRunList()->runs()[0].get());
+}
+
 // Make sure that multiline mode ignores elide behavior.
 TEST_F(RenderTextTest, Multiline_IgnoreElide) {
   const char kTestString[] =
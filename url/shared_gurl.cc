@@ -0,0 +1,342 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "url/shared_gurl.h"
+
+#include <stdint.h>
+
+#include <algorithm>
+#include <limits>
+#include <memory>
+#include <utility>
+
+#include "base/logging.h"
+#include "base/memory/ref_counted_memory.h"
+#include "base/strings/string_util.h"
+#include "url/url_constants.h"
+
+namespace url {
+
+namespace {
+
+// Components in the order of their appearance in a spec. The ones before
+// |kPath| are stored in the spec prefix, the others in the rest of the spec.
+enum ComponentIndex {
+  kScheme,
+  kUsername,
+  kPassword,
+  kHost,
+  kPort,
+  kPath,
+  kQuery,
+  kRef,
+  kNumComponents,
+};
+
+// Marks invalid components. Specs stored compactly are shorter than this, so
+// it can't be the length of a valid component.
+constexpr uint16_t kInvalidLength = std::numeric_limits<uint16_t>::max();
+
+struct CompactComponent {
+  uint16_t begin;
+  uint16_t len;
+};
+
+constexpr Component Parsed::*kComponents[kNumComponents] = {
+    &Parsed::scheme, &Parsed::username, &Parsed::password, &Parsed::host,
+    &Parsed::port,   &Parsed::path,     &Parsed::query,    &Parsed::ref};
+
+// Compares the concatenations of |a| and |b|, like std::string::compare().
+int CompareSplitStrings(const base::StringPiece (&a)[2],
+                        const base::StringPiece (&b)[2]) {
+  size_t a_index = 0;
+  size_t b_index = 0;
+  base::StringPiece a_piece = a[0];
+  base::StringPiece b_piece = b[0];
+  while (true) {
+    if (a_piece.empty() && a_index == 0)
+      a_piece = a[++a_index];
+    if (b_piece.empty() && b_index == 0)
+      b_piece = b[++b_index];
+    if (a_piece.empty() || b_piece.empty())
+      return b_piece.empty() ? !a_piece.empty() : -1;
+
+    size_t size = std::min(a_piece.size(), b_piece.size());
+    int result = a_piece.substr(0, size).compare(b_piece.substr(0, size));
+    if (result)
+      return result;
+    a_piece.remove_prefix(size);
+    b_piece.remove_prefix(size);
+  }
+}
+
+}  // namespace
+
+class SharedGURL::Rep : public base::RefCountedThreadSafe<Rep> {
+ public:
+  // Returns null if |url| can't be stored compactly.
+  static scoped_refptr<const Rep> CreateCompact(const GURL& url,
+                                                PrefixTable* prefixes) {
+    const std::string& spec = url.possibly_invalid_spec();
+    if (!url.is_valid() || url.SchemeIsFileSystem() ||
+        spec.size() >= kInvalidLength) {
+      return nullptr;
+    }
+
+    const Parsed& parsed = url.parsed_for_possibly_invalid_spec();
+    size_t prefix_size = parsed.CountCharactersBefore(Parsed::PATH, false);
+    base::StringPiece prefix = base::StringPiece(spec).substr(0, prefix_size);
+    base::StringPiece rest = base::StringPiece(spec).substr(prefix_size);
+
+    auto rep = base::WrapRefCounted(new Rep);
+    if (prefixes) {
+      rep->prefix_ = prefixes->Intern(prefix);
+    } else {
+      rep->prefix_ = base::MakeRefCounted<base::RefCountedString>();
+      rep->prefix_->data().assign(prefix.data(), prefix.size());
+    }
+    rep->rest_.reset(new char[rest.size()]);
+    std::copy(rest.begin(), rest.end(), rep->rest_.get());
+    rep->rest_size_ = static_cast<uint16_t>(rest.size());
+    rep->potentially_dangling_markup_ = parsed.potentially_dangling_markup;
+    for (int i = 0; i < kNumComponents; ++i) {
+      const Component& component = parsed.*kComponents[i];
+      rep->components_[i].begin = static_cast<uint16_t>(component.begin);
+      rep->components_[i].len = component.is_valid()
+                                    ? static_cast<uint16_t>(component.len)
+                                    : kInvalidLength;
+    }
+    return rep;
+  }
+
+  static scoped_refptr<const Rep> CreateFallback(const GURL& url) {
+    auto rep = base::WrapRefCounted(new Rep);
+    rep->url_ = std::make_unique<GURL>(url);
+    return rep;
+  }
+
+  GURL ToGURL() const {
+    if (url_)
+      return *url_;
+
+    std::string spec;
+    spec.reserve(prefix_->size() + rest_size_);
+    spec.append(prefix_->data());
+    spec.append(rest_.get(), rest_size_);
+    Parsed parsed;
+    for (int i = 0; i < kNumComponents; ++i) {
+      if (components_[i].len != kInvalidLength) {
+        parsed.*kComponents[i] =
+            Component(components_[i].begin, components_[i].len);
+      } else {
+        (parsed.*kComponents[i]).begin = components_[i].begin;
+      }
+    }
+    parsed.potentially_dangling_markup = potentially_dangling_markup_;
+    return GURL(std::move(spec), parsed, true);
+  }
+
+  bool is_valid() const { return url_ ? url_->is_valid() : true; }
+
+  void GetSpec(base::StringPiece (&spec)[2]) const {
+    if (url_) {
+      spec[0] = url_->possibly_invalid_spec();
+      spec[1] = base::StringPiece();
+    } else {
+      spec[0] = prefix_->data();
+      spec[1] = base::StringPiece(rest_.get(), rest_size_);
+    }
+  }
+
+  base::StringPiece GetComponentPiece(int index) const {
+    if (url_) {
+      const Component& component =
+          url_->parsed_for_possibly_invalid_spec().*kComponents[index];
+      if (component.len <= 0)
+        return base::StringPiece();
+      return base::StringPiece(url_->possibly_invalid_spec())
+          .substr(component.begin, component.len);
+    }
+
+    const CompactComponent& component = components_[index];
+    if (component.len == kInvalidLength)
+      return base::StringPiece();
+    if (index < kPath) {
+      return base::StringPiece(prefix_->data())
+          .substr(component.begin, component.len);
+    }
+    return base::StringPiece(rest_.get() + component.begin - prefix_->size(),
+                             component.len);
+  }
+
+  // Returns whether both URLs are stored compactly with the same prefix.
+  bool SharesPrefixWith(const Rep& other) const {
+    return !url_ && !other.url_ && prefix_ == other.prefix_;
+  }
+
+  base::StringPiece rest() const {
+    return base::StringPiece(rest_.get(), rest_size_);
+  }
+
+ private:
+  friend class base::RefCountedThreadSafe<Rep>;
+
+  Rep() = default;
+  ~Rep() = default;
+
+  // Set for URLs that can't be stored compactly, in which case the other
+  // members are unused.
+  std::unique_ptr<GURL> url_;
+
+  scoped_refptr<base::RefCountedString> prefix_;
+  std::unique_ptr<char[]> rest_;
+  uint16_t rest_size_ = 0;
+  bool potentially_dangling_markup_ = false;
+
+  // Offsets are relative to the start of the whole spec.
+  CompactComponent components_[kNumComponents];
+
+  DISALLOW_COPY_AND_ASSIGN(Rep);
+};
+
+SharedGURL::PrefixTable::PrefixTable() = default;
+
+SharedGURL::PrefixTable::~PrefixTable() = default;
+
+void SharedGURL::PrefixTable::Purge() {
+  for (auto it = prefixes_.begin(); it != prefixes_.end();) {
+    if (it->second->HasOneRef())
+      it = prefixes_.erase(it);
+    else
+      ++it;
+  }
+}
+
+scoped_refptr<base::RefCountedString> SharedGURL::PrefixTable::Intern(
+    base::StringPiece prefix) {
+  auto it = prefixes_.find(prefix);
+  if (it != prefixes_.end())
+    return it->second;
+
+  auto interned = base::MakeRefCounted<base::RefCountedString>();
+  interned->data().assign(prefix.data(), prefix.size());
+  prefixes_.emplace(interned->data(), interned);
+  return interned;
+}
+
+SharedGURL::SharedGURL() = default;
+
+SharedGURL::SharedGURL(const GURL& url, PrefixTable* prefixes) {
+  if (url.is_empty())
+    return;
+  rep_ = Rep::CreateCompact(url, prefixes);
+  if (!rep_)
+    rep_ = Rep::CreateFallback(url);
+}
+
+SharedGURL::SharedGURL(const SharedGURL& other) = default;
+
+SharedGURL::SharedGURL(SharedGURL&& other) noexcept = default;
+
+SharedGURL::~SharedGURL() = default;
+
+SharedGURL& SharedGURL::operator=(const SharedGURL& other) = default;
+
+SharedGURL& SharedGURL::operator=(SharedGURL&& other) noexcept = default;
+
+GURL SharedGURL::ToGURL() const {
+  return rep_ ? rep_->ToGURL() : GURL();
+}
+
+bool SharedGURL::is_valid() const {
+  return rep_ && rep_->is_valid();
+}
+
+bool SharedGURL::is_empty() const {
+  return !rep_;
+}
+
+std::string SharedGURL::possibly_invalid_spec() const {
+  if (!rep_)
+    return std::string();
+  base::StringPiece spec[2];
+  rep_->GetSpec(spec);
+  std::string result;
+  result.reserve(spec[0].size() + spec[1].size());
+  spec[0].AppendToString(&result);
+  spec[1].AppendToString(&result);
+  return result;
+}
+
+bool SharedGURL::SchemeIs(base::StringPiece lower_ascii_scheme) const {
+  DCHECK(base::IsStringASCII(lower_ascii_scheme));
+  DCHECK(base::ToLowerASCII(lower_ascii_scheme) == lower_ascii_scheme);
+  return scheme_piece() == lower_ascii_scheme;
+}
+
+bool SharedGURL::SchemeIsHTTPOrHTTPS() const {
+  return SchemeIs(kHttpScheme) || SchemeIs(kHttpsScheme);
+}
+
+base::StringPiece SharedGURL::scheme_piece() const {
+  return rep_ ? rep_->GetComponentPiece(kScheme) : base::StringPiece();
+}
+
+base::StringPiece SharedGURL::host_piece() const {
+  return rep_ ? rep_->GetComponentPiece(kHost) : base::StringPiece();
+}
+
+base::StringPiece SharedGURL::port_piece() const {
+  return rep_ ? rep_->GetComponentPiece(kPort) : base::StringPiece();
+}
+
+base::StringPiece SharedGURL::path_piece() const {
+  return rep_ ? rep_->GetComponentPiece(kPath) : base::StringPiece();
+}
+
+base::StringPiece SharedGURL::query_piece() const {
+  return rep_ ? rep_->GetComponentPiece(kQuery) : base::StringPiece();
+}
+
+base::StringPiece SharedGURL::ref_piece() const {
+  return rep_ ? rep_->GetComponentPiece(kRef) : base::StringPiece();
+}
+
+bool SharedGURL::operator==(const SharedGURL& other) const {
+  if (rep_ == other.rep_)
+    return true;
+  if (!rep_ || !other.rep_)
+    return false;
+  if (rep_->SharesPrefixWith(*other.rep_))
+    return rep_->rest() == other.rep_->rest();
+
+  base::StringPiece spec[2];
+  base::StringPiece other_spec[2];
+  rep_->GetSpec(spec);
+  other.rep_->GetSpec(other_spec);
+  return spec[0].size() + spec[1].size() ==
+             other_spec[0].size() + other_spec[1].size() &&
+         CompareSplitStrings(spec, other_spec) == 0;
+}
+
+bool SharedGURL::operator!=(const SharedGURL& other) const {
+  return !(*this == other);
+}
+
+bool SharedGURL::operator<(const SharedGURL& other) const {
+  if (rep_ == other.rep_ || !other.rep_)
+    return false;
+  if (!rep_)
+    return true;
+  if (rep_->SharesPrefixWith(*other.rep_))
+    return rep_->rest() < other.rep_->rest();
+
+  base::StringPiece spec[2];
+  base::StringPiece other_spec[2];
+  rep_->GetSpec(spec);
+  other.rep_->GetSpec(other_spec);
+  return CompareSplitStrings(spec, other_spec) < 0;
+}
+
+}  // namespace url
@@ -0,0 +1,113 @@
+// Copyright 2019 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef URL_SHARED_GURL_H_
+#define URL_SHARED_GURL_H_
+
+#include <stddef.h>
+
+#include <string>
+#include <unordered_map>
+
+#include "base/component_export.h"
+#include "base/macros.h"
+#include "base/memory/ref_counted.h"
+#include "base/strings/string_piece.h"
+#include "url/gurl.h"
+
+namespace base {
+class RefCountedString;
+}
+
+namespace url {
+
+// An immutable, refcounted and compact version of GURL, meant for code keeping
+// large collections of URLs around. Copying a SharedGURL only copies a pointer.
+//
+// The spec is stored in two parts split at the start of the path. The first
+// part holds the scheme, user info, host and port, and is shared between all
+// the SharedGURLs created with the same PrefixTable. Component offsets are
+// stored as 16-bit integers. URLs that can't be represented this way (invalid
+// URLs, filesystem URLs and very long URLs) are stored as a GURL instead.
+class COMPONENT_EXPORT(URL) SharedGURL {
+ public:
+  // Interns spec prefixes so that SharedGURLs with the same origin share their
+  // storage. A PrefixTable is not thread-safe, but the SharedGURLs created with
+  // it can be used and destroyed on any thread, and may outlive it.
+  class COMPONENT_EXPORT(URL) PrefixTable {
+   public:
+    PrefixTable();
+    ~PrefixTable();
+
+    // Drops the prefixes that are no longer used by any SharedGURL.
+    void Purge();
+
+    size_t size() const { return prefixes_.size(); }
+
+   private:
+    friend class SharedGURL;
+
+    scoped_refptr<base::RefCountedString> Intern(base::StringPiece prefix);
+
+    // Keys point to the data of their values.
+    std::unordered_map<base::StringPiece,
+                       scoped_refptr<base::RefCountedString>,
+                       base::StringPieceHash>
+        prefixes_;
+
+    DISALLOW_COPY_AND_ASSIGN(PrefixTable);
+  };
+
+  // Creates an empty, invalid URL.
+  SharedGURL();
+
+  // If |prefixes| is null, the spec prefix of |url| is not shared with other
+  // SharedGURLs.
+  explicit SharedGURL(const GURL& url, PrefixTable* prefixes = nullptr);
+
+  SharedGURL(const SharedGURL& other);
+  SharedGURL(SharedGURL&& other) noexcept;
+  ~SharedGURL();
+
+  SharedGURL& operator=(const SharedGURL& other);
+  SharedGURL& operator=(SharedGURL&& other) noexcept;
+
+  // Returns the equivalent GURL. This copies the spec but does not parse or
+  // canonicalize it again.
+  GURL ToGURL() const;
+
+  bool is_valid() const;
+  bool is_empty() const;
+
+  // Returns the spec, which is possibly invalid, like
+  // GURL::possibly_invalid_spec(). This has to concatenate the two parts of
+  // the spec, so prefer the component accessors below when possible.
+  std::string possibly_invalid_spec() const;
+
+  bool SchemeIs(base::StringPiece lower_ascii_scheme) const;
+  bool SchemeIsHTTPOrHTTPS() const;
+
+  // Same as the GURL accessors of the same name.
+  base::StringPiece scheme_piece() const;
+  base::StringPiece host_piece() const;
+  base::StringPiece port_piece() const;
+  base::StringPiece path_piece() const;
+  base::StringPiece query_piece() const;
+  base::StringPiece ref_piece() const;
+
+  // Compare the specs, without concatenating them.
+  bool operator==(const SharedGURL& other) const;
+  bool operator!=(const SharedGURL& other) const;
+  bool operator<(const SharedGURL& other) const;
+
+ private:
+  class Rep;
+
+  // Null for empty URLs.
+  scoped_refptr<const Rep> rep_;
+};
+
+}  // namespace url
+
+#endif  // URL_SHARED_GURL_H_
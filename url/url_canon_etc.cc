@@ -321,6 +321,15 @@ void DoCanonicalizeRef(const CHAR* spec,
 
 }  // namespace
 
+bool IsCanonicalRef(const char* spec, const Component& ref) {
+  int end = ref.end();
+  for (int i = ref.begin; i < end; i++) {
+    if (kShouldEscapeCharInRef[static_cast<unsigned char>(spec[i])])
+      return false;
+  }
+  return true;
+}
+
 const char* RemoveURLWhitespace(const char* input,
                                 int input_len,
                                 CanonOutputT<char>* buffer,
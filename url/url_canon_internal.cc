@@ -12,6 +12,11 @@
 #include <string>
 
 #include "base/strings/utf_string_conversion_utils.h"
+#include "build/build_config.h"
+
+#if defined(ARCH_CPU_X86_FAMILY)
+#include <emmintrin.h>
+#endif
 
 namespace url {
 
@@ -389,6 +394,29 @@ bool SetupUTF16OverrideComponents(const char* base,
   return success;
 }
 
+bool IsPrintableASCII(const char* spec, int spec_len) {
+  int i = 0;
+#if defined(ARCH_CPU_X86_FAMILY)
+  // Check 16 characters at a time. The comparisons are signed, so characters
+  // with the high bit set compare less than ' ' and are rejected as well.
+  const __m128i space = _mm_set1_epi8(' ');
+  const __m128i del = _mm_set1_epi8(0x7F);
+  for (; i + 16 <= spec_len; i += 16) {
+    __m128i chars =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(spec + i));
+    __m128i printable = _mm_and_si128(_mm_cmpgt_epi8(chars, space),
+                                      _mm_cmplt_epi8(chars, del));
+    if (_mm_movemask_epi8(printable) != 0xFFFF)
+      return false;
+  }
+#endif
+  for (; i < spec_len; i++) {
+    if (spec[i] <= ' ' || spec[i] >= 0x7F)
+      return false;
+  }
+  return true;
+}
+
 #ifndef WIN32
 
 int _itoa_s(int value, char* buffer, size_t size_in_chars, int radix) {
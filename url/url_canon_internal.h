@@ -413,6 +413,35 @@ bool CanonicalizePartialPath(const base::char16* spec,
                              int path_begin_in_output,
                              CanonOutput* output);
 
+// Fast path for already canonical input ---------------------------------------
+//
+// These checks return true only if the corresponding canonicalizer would copy
+// its input unchanged, so that the input can be copied instead. They may return
+// false for some canonical input, which then takes the regular path. They all
+// assume that the input has passed IsPrintableASCII().
+
+// Returns true if |spec| only has printable ASCII characters other than space,
+// i.e. characters in [0x21, 0x7E], which is a precondition for the fast path.
+// None of these are whitespace or control characters, which would otherwise be
+// trimmed or escaped.
+bool IsPrintableASCII(const char* spec, int spec_len);
+
+// Implemented in url_canon_path.cc. Returns true if CanonicalizePath() would
+// copy |path| unchanged.
+bool IsCanonicalPath(const char* spec, const Component& path);
+
+// Implemented in url_canon_etc.cc. Returns true if CanonicalizeRef() would copy
+// |ref| unchanged, following the '#'.
+bool IsCanonicalRef(const char* spec, const Component& ref);
+
+// Implemented in url_canon_stdurl.cc. Returns true if CanonicalizeStandardURL()
+// would copy |spec| unchanged, with |parsed| as the output components.
+COMPONENT_EXPORT(URL)
+bool IsCanonicalStandardURL(const char* spec,
+                            int spec_len,
+                            const Parsed& parsed,
+                            SchemeType scheme_type);
+
 #ifndef WIN32
 
 // Implementations of Windows' int-to-string conversions
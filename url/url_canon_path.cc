@@ -403,6 +403,42 @@ bool DoPath(const CHAR* spec,
 
 }  // namespace
 
+bool IsCanonicalPath(const char* spec, const Component& path) {
+  // Canonical paths of standard URLs always start with a slash.
+  if (!path.is_nonempty() || spec[path.begin] != '/')
+    return false;
+
+  int end = path.end();
+  for (int i = path.begin; i < end; i++) {
+    unsigned char flags = kPathCharLookup[static_cast<unsigned char>(spec[i])];
+    if (!(flags & SPECIAL))
+      continue;
+
+    if (spec[i] == '.') {
+      // Dots are copied, unless they make up a "." or ".." path segment. The
+      // path starts with a slash, so there is always a preceding character.
+      int consumed_len;
+      if (spec[i - 1] == '/' &&
+          ClassifyAfterDot<char>(spec, i + 1, end, &consumed_len) !=
+              NOT_A_DIRECTORY) {
+        return false;
+      }
+      continue;
+    }
+
+    // Other special characters are escaped, converted or rejected, except for
+    // valid escape sequences that are kept escaped. Note that escaped dots are
+    // unescaped.
+    unsigned char unescaped_value;
+    if (spec[i] != '%' || !DecodeEscaped(spec, &i, end, &unescaped_value) ||
+        unescaped_value == '.' ||
+        (kPathCharLookup[unescaped_value] & (UNESCAPE | INVALID_BIT))) {
+      return false;
+    }
+  }
+  return true;
+}
+
 bool CanonicalizePath(const char* spec,
                       const Component& path,
                       CanonOutput* output,
@@ -5,6 +5,7 @@
 // Functions to canonicalize "standard" URLs, which are ones that have an
 // authority section including a host name.
 
+#include "base/strings/string_util.h"
 #include "url/url_canon.h"
 #include "url/url_canon_internal.h"
 #include "url/url_constants.h"
@@ -106,8 +107,117 @@ bool DoCanonicalizeStandardURL(const URLComponentSource<CHAR>& source,
   return success;
 }
 
+// Returns true if |host| is a canonical host name, rather than an IP address or
+// a host name that would be lowercased, escaped or converted.
+bool IsCanonicalHostName(const char* spec, const Component& host) {
+  int end = host.end();
+  int last_label_begin = host.begin;
+  for (int i = host.begin; i < end; i++) {
+    char c = spec[i];
+    if (c == '.') {
+      // A trailing dot doesn't start a new label.
+      if (i + 1 < end)
+        last_label_begin = i + 1;
+    } else if (!base::IsAsciiLower(c) && !base::IsAsciiDigit(c) && c != '-') {
+      return false;
+    }
+  }
+  // IPv4 addresses are only detected when all labels are numbers, which always
+  // start with a digit.
+  return !base::IsAsciiDigit(spec[last_label_begin]);
+}
+
+// Returns true if |port| is canonical for a URL with the canonical scheme
+// |scheme|, i.e. it's a number without leading zeros that is a valid port, and
+// not the default port of the scheme.
+bool IsCanonicalPort(const char* spec,
+                     const Component& scheme,
+                     const Component& port) {
+  if (!port.is_nonempty() || port.len > 5 ||
+      (spec[port.begin] == '0' && port.len > 1)) {
+    return false;
+  }
+  int port_number = 0;
+  for (int i = port.begin; i < port.end(); i++) {
+    if (!base::IsAsciiDigit(spec[i]))
+      return false;
+    port_number = port_number * 10 + (spec[i] - '0');
+  }
+  return port_number <= 65535 &&
+         port_number != DefaultPortForScheme(&spec[scheme.begin], scheme.len);
+}
+
+// Returns |component| moved by |offset|, leaving it invalid if it is invalid.
+Component OffsetComponent(const Component& component, int offset) {
+  if (!component.is_valid())
+    return Component();
+  return Component(component.begin + offset, component.len);
+}
+
 }  // namespace
 
+bool IsCanonicalStandardURL(const char* spec,
+                            int spec_len,
+                            const Parsed& parsed,
+                            SchemeType scheme_type) {
+  // Only handle the layout "scheme://host[:port]/path[?query][#ref]", for
+  // schemes that allow all of it.
+  if (scheme_type != SCHEME_WITH_HOST_PORT_AND_USER_INFORMATION ||
+      !IsPrintableASCII(spec, spec_len)) {
+    return false;
+  }
+
+  // Scheme.
+  if (parsed.scheme.begin != 0 || !parsed.scheme.is_nonempty())
+    return false;
+  for (int i = 0; i < parsed.scheme.len; i++) {
+    if (CanonicalSchemeChar(spec[i]) != spec[i])
+      return false;
+  }
+  int cur = parsed.scheme.end();
+  if (cur + 3 > spec_len || spec[cur] != ':' || spec[cur + 1] != '/' ||
+      spec[cur + 2] != '/') {
+    return false;
+  }
+  cur += 3;
+
+  // Authority, without user info.
+  if (parsed.username.is_valid() || parsed.password.is_valid() ||
+      parsed.host.begin != cur || !parsed.host.is_nonempty() ||
+      !IsCanonicalHostName(spec, parsed.host)) {
+    return false;
+  }
+  cur = parsed.host.end();
+  if (parsed.port.is_valid()) {
+    if (parsed.port.begin != cur + 1 || spec[cur] != ':' ||
+        !IsCanonicalPort(spec, parsed.scheme, parsed.port)) {
+      return false;
+    }
+    cur = parsed.port.end();
+  }
+
+  // Path, query and ref.
+  if (parsed.path.begin != cur || !IsCanonicalPath(spec, parsed.path))
+    return false;
+  cur = parsed.path.end();
+  if (parsed.query.is_valid()) {
+    if (parsed.query.begin != cur + 1 || spec[cur] != '?')
+      return false;
+    for (int i = parsed.query.begin; i < parsed.query.end(); i++) {
+      if (!IsQueryChar(static_cast<unsigned char>(spec[i])))
+        return false;
+    }
+    cur = parsed.query.end();
+  }
+  if (parsed.ref.is_valid()) {
+    if (parsed.ref.begin != cur + 1 || spec[cur] != '#' ||
+        !IsCanonicalRef(spec, parsed.ref)) {
+      return false;
+    }
+    cur = parsed.ref.end();
+  }
+  return cur == spec_len;
+}
 
 // Returns the default port for the given canonical scheme, or PORT_UNSPECIFIED
 // if the scheme is unknown.
@@ -147,6 +257,20 @@ bool CanonicalizeStandardURL(const char* spec,
                              CharsetConverter* query_converter,
                              CanonOutput* output,
                              Parsed* new_parsed) {
+  // Most URLs are already canonical, and can be copied as they are.
+  if (IsCanonicalStandardURL(spec, spec_len, parsed, scheme_type)) {
+    int offset = output->length();
+    output->Append(spec, spec_len);
+    new_parsed->scheme = OffsetComponent(parsed.scheme, offset);
+    new_parsed->username.reset();
+    new_parsed->password.reset();
+    new_parsed->host = OffsetComponent(parsed.host, offset);
+    new_parsed->port = OffsetComponent(parsed.port, offset);
+    new_parsed->path = OffsetComponent(parsed.path, offset);
+    new_parsed->query = OffsetComponent(parsed.query, offset);
+    new_parsed->ref = OffsetComponent(parsed.ref, offset);
+    return true;
+  }
   return DoCanonicalizeStandardURL<char, unsigned char>(
       URLComponentSource<char>(spec), parsed, scheme_type, query_converter,
       output, new_parsed);
@@ -2,6 +2,7 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include "base/stl_util.h"
 #include "base/strings/string_piece.h"
 #include "base/test/perf_time_logger.h"
 #include "testing/gtest/include/gtest/gtest.h"
@@ -132,4 +133,45 @@ TEST(URLParse, GURL) {
   gurl_timer.Done();
 }
 
+// A sample of URLs as seen by the network stack and loaders. Most of them are
+// already canonical; a few need escaping, lowercasing or path resolution.
+constexpr base::StringPiece kUrlCorpus[] = {
+    "https://www.google.com/",
+    "https://www.google.com/search?q=chromium+url+canon&oq=chromium&sourceid="
+    "chrome&ie=UTF-8",
+    "https://fonts.gstatic.com/s/roboto/v18/KFOmCnqEu92Fr1Mu4mxK.woff2",
+    "https://www.youtube.com/watch?v=dQw4w9WgXcQ&list=PL1234567890#t=42",
+    "https://en.wikipedia.org/wiki/Uniform_Resource_Locator",
+    "https://en.wikipedia.org/wiki/Percent-encoding#Percent-encoding_"
+    "reserved_characters",
+    "https://static.xx.fbcdn.net/rsrc.php/v3/yT/r/abcdEFGH123.js?_nc_x=Ij3Wp8",
+    "https://ssl.gstatic.com/gb/images/i1_1967ca6a.png",
+    "https://www.amazon.com/dp/B07FZ8S74R/ref=sr_1_1?keywords=echo&qid="
+    "1558000000&s=gateway&sr=8-1",
+    "https://cdn.example.com:8443/assets/app.min.css?v=20190520",
+    "https://api.example.com/v1/users/1234/avatar.png?size=64%4032",
+    "https://news.ycombinator.com/item?id=19958361",
+    "https://github.com/chromium/chromium/blob/master/url/url_canon.h#L100",
+    "https://stackoverflow.com/questions/1547899/which-characters-make-a-url-"
+    "invalid",
+    "http://example.com/a/b/../c/./d.html",
+    "HTTPS://WWW.EXAMPLE.COM/Index.html",
+    "https://www.example.com/path with spaces/file.html",
+    "https://www.example.com:443/default/port",
+    "http://192.168.0.1/router/status.cgi",
+    "https://www.example.com/\xc3\xa9t\xc3\xa9?q=\xe2\x82\xac",
+};
+
+TEST(URLParse, GURLCorpus) {
+  constexpr int kIterations = 1000000 / base::size(kUrlCorpus);
+  size_t num_valid = 0;
+  base::PerfTimeLogger gurl_timer("Corpus_GURL_AMillion");
+  for (int i = 0; i < kIterations; i++) {
+    for (const base::StringPiece& url : kUrlCorpus)
+      num_valid += GURL(url).is_valid();
+  }
+  gurl_timer.Done();
+  EXPECT_EQ(kIterations * base::size(kUrlCorpus), num_valid);
+}
+
 }  // namespace